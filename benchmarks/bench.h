@@ -0,0 +1,117 @@
+/* Shared parts of the kernel benchmarks.
+ *
+ * Each benchmark program times the kernels of one module on the SIMD level
+ * picked by the PYGAME_SIMD environment variable (see pg_simd_max_level()),
+ * and prints one line of JSON per measurement on stdout:
+ *
+ *   {"group": "blit", "kernel": "alpha", "backend": "avx2",
+ *    "format": "ARGB8888->XRGB8888", "width": 256, "height": 256,
+ *    "iterations": 4095, "ns_per_call": 13452.1, "ns_per_pixel": 0.2053}
+ *
+ * "backend" is the level the kernels actually ran on, which is lower than
+ * the requested one if the CPU or the build doesn't support it.
+ */
+#ifndef PG_BENCH_H
+#define PG_BENCH_H
+
+#define NO_PYGAME_C_API
+#define SDL_MAIN_HANDLED
+#include "_surface.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+/* every measurement repeats its kernel for at least 1 / this seconds */
+#define BENCH_MIN_SECONDS_DIV 20
+
+static const int bench_sizes[] = {16, 64, 256, 1024};
+
+static const char *bench_backend = "scalar";
+
+typedef void (*bench_func)(void *arg);
+
+static void
+bench_set_backend(int has_avx2, int has_sse2_neon)
+{
+    if (has_avx2) {
+        bench_backend = "avx2";
+    }
+    else if (has_sse2_neon) {
+        bench_backend = "sse2_neon";
+    }
+    else {
+        bench_backend = "scalar";
+    }
+}
+
+static void
+bench_run(const char *group, const char *kernel, const char *format, int w,
+          int h, bench_func func, void *arg)
+{
+    const Uint64 freq = SDL_GetPerformanceFrequency();
+    Uint64 start, elapsed;
+    long iterations = 0, batch = 1, i;
+    double ns;
+
+    /* warm up the caches, and the lazy CPU feature checks */
+    func(arg);
+
+    start = SDL_GetPerformanceCounter();
+    do {
+        for (i = 0; i < batch; i++) {
+            func(arg);
+        }
+        iterations += batch;
+        batch *= 2;
+        elapsed = SDL_GetPerformanceCounter() - start;
+    } while (elapsed < freq / BENCH_MIN_SECONDS_DIV);
+
+    ns = (double)elapsed * 1e9 / (double)freq / (double)iterations;
+    printf(
+        "{\"group\": \"%s\", \"kernel\": \"%s\", \"backend\": \"%s\", "
+        "\"format\": \"%s\", \"width\": %d, \"height\": %d, "
+        "\"iterations\": %ld, \"ns_per_call\": %.1f, "
+        "\"ns_per_pixel\": %.4f}\n",
+        group, kernel, bench_backend, format, w, h, iterations, ns,
+        ns / ((double)w * h));
+    fflush(stdout);
+}
+
+/* Fills the surface with reproducible noise, so kernels with shortcuts for
+ * transparent or opaque pixels take all of their paths. */
+static void
+bench_noise(SDL_Surface *surf, Uint32 seed)
+{
+    Uint8 *row = (Uint8 *)surf->pixels;
+    int x, y;
+
+    for (y = 0; y < surf->h; y++, row += surf->pitch) {
+        for (x = 0; x < surf->pitch; x++) {
+            seed = seed * 1103515245 + 12345;
+            row[x] = (Uint8)(seed >> 16);
+        }
+    }
+}
+
+static SDL_Surface *
+bench_surface(int w, int h, Uint32 format, Uint32 seed)
+{
+    SDL_Surface *surf = PG_CreateSurface(w, h, format);
+
+    if (!surf) {
+        fprintf(stderr, "could not create a surface: %s\n", SDL_GetError());
+        exit(1);
+    }
+    bench_noise(surf, seed);
+    return surf;
+}
+
+static const char *
+bench_format_name(Uint32 format)
+{
+    const char *name = SDL_GetPixelFormatName(format);
+
+    return strncmp(name, "SDL_PIXELFORMAT_", 16) ? name : name + 16;
+}
+
+#endif /* PG_BENCH_H */
@@ -0,0 +1,195 @@
+/* Times pygame's blitters (pygame_Blit()), blend fills
+ * (surface_fill_blend()) and the span fills of the draw module. See bench.h
+ * for the output. */
+#include "bench.h"
+#include "simd_fill.h"
+
+typedef struct {
+    SDL_Surface *src;
+    SDL_Surface *dst;
+    int flags;
+} blit_args;
+
+typedef struct {
+    SDL_Surface *surf;
+    Uint32 color;
+    int flags;
+} fill_args;
+
+static const struct {
+    const char *name;
+    int flags;
+} blend_modes[] = {
+    {"default", 0},
+    {"add", PYGAME_BLEND_ADD},
+    {"sub", PYGAME_BLEND_SUB},
+    {"mult", PYGAME_BLEND_MULT},
+    {"min", PYGAME_BLEND_MIN},
+    {"max", PYGAME_BLEND_MAX},
+    {"rgba_add", PYGAME_BLEND_RGBA_ADD},
+    {"rgba_sub", PYGAME_BLEND_RGBA_SUB},
+    {"rgba_mult", PYGAME_BLEND_RGBA_MULT},
+    {"rgba_min", PYGAME_BLEND_RGBA_MIN},
+    {"rgba_max", PYGAME_BLEND_RGBA_MAX},
+    {"premultiplied", PYGAME_BLEND_PREMULTIPLIED},
+};
+
+/* source and destination formats, the first ones hit the SIMD blitters */
+static const Uint32 blit_formats[][2] = {
+    {SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_ARGB8888},
+    {SDL_PIXELFORMAT_ARGB8888, PG_PIXELFORMAT_XRGB8888},
+    {PG_PIXELFORMAT_XRGB8888, PG_PIXELFORMAT_XRGB8888},
+    {SDL_PIXELFORMAT_ABGR8888, PG_PIXELFORMAT_XRGB8888},
+    {SDL_PIXELFORMAT_RGB24, PG_PIXELFORMAT_XRGB8888},
+    {SDL_PIXELFORMAT_RGB565, SDL_PIXELFORMAT_RGB565},
+};
+
+static void
+run_blit(void *arg)
+{
+    blit_args *args = arg;
+    SDL_Rect dstrect = {0, 0, args->src->w, args->src->h};
+
+    if (pygame_Blit(args->src, NULL, args->dst, &dstrect, args->flags)) {
+        fprintf(stderr, "blit failed: %s\n", SDL_GetError());
+        exit(1);
+    }
+}
+
+static void
+run_fill(void *arg)
+{
+    fill_args *args = arg;
+    SDL_Rect rect = {0, 0, args->surf->w, args->surf->h};
+
+    if (surface_fill_blend(args->surf, &rect, args->color, args->flags)) {
+        fprintf(stderr, "fill failed: %s\n", SDL_GetError());
+        exit(1);
+    }
+}
+
+static void
+bench_blits(int size)
+{
+    char format[64];
+    blit_args args;
+    size_t i, j;
+
+    for (i = 0; i < SDL_arraysize(blit_formats); i++) {
+        args.src = bench_surface(size, size, blit_formats[i][0], 1);
+        args.dst = bench_surface(size, size, blit_formats[i][1], 2);
+        SDL_snprintf(format, sizeof(format), "%s->%s",
+                     bench_format_name(blit_formats[i][0]),
+                     bench_format_name(blit_formats[i][1]));
+
+        for (j = 0; j < SDL_arraysize(blend_modes); j++) {
+            args.flags = blend_modes[j].flags;
+            bench_run("blit", blend_modes[j].name, format, size, size,
+                      run_blit, &args);
+        }
+
+        /* the other two kinds of blits without blend flags */
+        args.flags = 0;
+        if (!SDL_ISPIXELFORMAT_ALPHA(blit_formats[i][0])) {
+            SDL_SetColorKey(args.src, SDL_TRUE, 0);
+            bench_run("blit", "colorkey", format, size, size, run_blit,
+                      &args);
+            SDL_SetColorKey(args.src, SDL_FALSE, 0);
+        }
+        SDL_SetSurfaceAlphaMod(args.src, 128);
+        bench_run("blit", "surface_alpha", format, size, size, run_blit,
+                  &args);
+
+        SDL_FreeSurface(args.src);
+        SDL_FreeSurface(args.dst);
+    }
+}
+
+static void
+bench_fills(int size)
+{
+    static const Uint32 formats[] = {PG_PIXELFORMAT_XRGB8888,
+                                     SDL_PIXELFORMAT_ARGB8888,
+                                     SDL_PIXELFORMAT_RGB565};
+    fill_args args;
+    size_t i, j;
+
+    for (i = 0; i < SDL_arraysize(formats); i++) {
+        args.surf = bench_surface(size, size, formats[i], 3);
+        args.color = 0x80402010;
+        /* the default mode isn't a blend fill, and premultiplied can't be
+         * used for fills */
+        for (j = 1; j < SDL_arraysize(blend_modes) - 1; j++) {
+            args.flags = blend_modes[j].flags;
+            bench_run("fill", blend_modes[j].name,
+                      bench_format_name(formats[i]), size, size, run_fill,
+                      &args);
+        }
+        SDL_FreeSurface(args.surf);
+    }
+}
+
+#if !defined(__EMSCRIPTEN__)
+typedef struct {
+    SDL_Surface *surf;
+    Uint8 pattern[PG_SPAN_PATTERN_SIZE];
+    void (*span)(Uint8 *dst, size_t nbytes, const Uint8 *pattern);
+} span_args;
+
+static void
+run_span(void *arg)
+{
+    span_args *args = arg;
+    Uint8 *row = args->surf->pixels;
+    int y;
+
+    for (y = 0; y < args->surf->h; y++, row += args->surf->pitch) {
+        args->span(row, (size_t)args->surf->w * 4, args->pattern);
+    }
+}
+
+/* The horizontal lines of pygame.draw, only the SIMD versions can be timed
+ * as the generic one lives inside of the draw module */
+static void
+bench_spans(int size)
+{
+    span_args args;
+    size_t i;
+
+    args.span = NULL;
+    if (_pg_has_avx2()) {
+        args.span = surface_fill_span_avx2;
+    }
+#if PG_ENABLE_SSE_NEON
+    else if (_pg_HasSSE_NEON()) {
+        args.span = surface_fill_span_sse2;
+    }
+#endif /* PG_ENABLE_SSE_NEON */
+    if (!args.span) {
+        return;
+    }
+
+    for (i = 0; i < PG_SPAN_PATTERN_SIZE; i += 4) {
+        *(Uint32 *)(args.pattern + i) = 0xFF804020;
+    }
+    args.surf = bench_surface(size, size, PG_PIXELFORMAT_XRGB8888, 4);
+    bench_run("draw", "span", "XRGB8888", size, size, run_span, &args);
+    SDL_FreeSurface(args.surf);
+}
+#endif /* __EMSCRIPTEN__ */
+
+int
+main(int argc, char *argv[])
+{
+    size_t i;
+
+    bench_set_backend(_pg_has_avx2(), _pg_HasSSE_NEON());
+    for (i = 0; i < SDL_arraysize(bench_sizes); i++) {
+        bench_blits(bench_sizes[i]);
+        bench_fills(bench_sizes[i]);
+#if !defined(__EMSCRIPTEN__)
+        bench_spans(bench_sizes[i]);
+#endif /* __EMSCRIPTEN__ */
+    }
+    return 0;
+}
@@ -0,0 +1,224 @@
+/* Times the bitmask word kernels, the overlap area kernel and the row
+ * kernels of Mask.from_surface() and from_threshold(). See bench.h for the
+ * output. */
+#include "bench.h"
+#include "simd_mask.h"
+
+/* The kernels mask.c would pick for the SIMD level */
+#if !defined(__EMSCRIPTEN__)
+#if PG_ENABLE_SSE_NEON
+#define _PICK_SSE2(name) (_pg_mask_HasSSE_NEON() ? name##_sse2 : name)
+#else
+#define _PICK_SSE2(name) (name)
+#endif /* PG_ENABLE_SSE_NEON */
+#define PICK_KERNEL(name) \
+    (_pg_mask_has_avx2() ? name##_avx2 : _PICK_SSE2(name))
+#else
+#define PICK_KERNEL(name) (name)
+#endif /* __EMSCRIPTEN__ */
+
+typedef struct {
+    bitmask_t *a;
+    bitmask_t *b;
+    bitmask_t *c;
+    SDL_Surface *surf;
+    union {
+        MASK_AND_COUNT_P and_count;
+        MASK_ALPHA_ROW_P alpha;
+        MASK_COLORKEY_ROW_P colorkey;
+        MASK_THRESHOLD_ROW_P threshold;
+    } kernel;
+} mask_args;
+
+/* the same as set_bitmask_kernels() of mask.c */
+static void
+set_kernels(void)
+{
+#if !defined(__EMSCRIPTEN__)
+    bitmask_kernels_t kernels;
+
+    if (_pg_mask_has_avx2()) {
+        kernels.count = mask_count_words_avx2;
+        kernels.invert = mask_invert_words_avx2;
+        kernels.draw = mask_draw_words_avx2;
+        kernels.erase = mask_erase_words_avx2;
+        kernels.overlap = mask_overlap_words_avx2;
+        bitmask_set_kernels(&kernels);
+    }
+#if PG_ENABLE_SSE_NEON
+    else if (_pg_mask_HasSSE_NEON()) {
+        kernels.count = mask_count_words_sse2;
+        kernels.invert = mask_invert_words_sse2;
+        kernels.draw = mask_draw_words_sse2;
+        kernels.erase = mask_erase_words_sse2;
+        kernels.overlap = mask_overlap_words_sse2;
+        bitmask_set_kernels(&kernels);
+    }
+#endif /* PG_ENABLE_SSE_NEON */
+#endif /* !__EMSCRIPTEN__ */
+}
+
+static bitmask_t *
+random_mask(int size, Uint32 seed)
+{
+    bitmask_t *m = bitmask_create(size, size);
+    int x, y;
+
+    if (!m) {
+        fprintf(stderr, "out of memory\n");
+        exit(1);
+    }
+    for (y = 0; y < size; y++) {
+        for (x = 0; x < size; x++) {
+            seed = seed * 1103515245 + 12345;
+            if (seed & 0x10000) {
+                bitmask_setbit(m, x, y);
+            }
+        }
+    }
+    return m;
+}
+
+static void
+run_count(void *arg)
+{
+    mask_args *args = arg;
+
+    bitmask_count(args->a);
+}
+
+static void
+run_invert(void *arg)
+{
+    mask_args *args = arg;
+
+    bitmask_invert(args->a);
+}
+
+/* the odd x offset makes the kernels shift every word */
+static void
+run_draw(void *arg)
+{
+    mask_args *args = arg;
+
+    bitmask_draw(args->c, args->b, 3, 1);
+}
+
+static void
+run_erase(void *arg)
+{
+    mask_args *args = arg;
+
+    bitmask_erase(args->c, args->b, 3, 1);
+}
+
+static void
+run_overlap_mask(void *arg)
+{
+    mask_args *args = arg;
+
+    bitmask_overlap_mask(args->a, args->b, args->c, 3, 1);
+}
+
+static void
+run_and_count(void *arg)
+{
+    mask_args *args = arg;
+
+    args->kernel.and_count(args->a->bits, args->b->bits,
+                           (args->a->w + BITMASK_W_MASK) / BITMASK_W_LEN *
+                               args->a->h);
+}
+
+#define ROW32(surf, y) \
+    ((Uint32 *)((Uint8 *)(surf)->pixels + (y) * (surf)->pitch))
+#define STRIDE(m) ((m)->h)
+
+static void
+run_alpha_row(void *arg)
+{
+    mask_args *args = arg;
+    int y;
+
+    for (y = 0; y < args->surf->h; y++) {
+        args->kernel.alpha(ROW32(args->surf, y), args->surf->w, 24, 127,
+                           args->c->bits + y, STRIDE(args->c));
+    }
+}
+
+static void
+run_colorkey_row(void *arg)
+{
+    mask_args *args = arg;
+    int y;
+
+    for (y = 0; y < args->surf->h; y++) {
+        args->kernel.colorkey(ROW32(args->surf, y), args->surf->w,
+                              0xFF000000, args->c->bits + y,
+                              STRIDE(args->c));
+    }
+}
+
+static void
+run_threshold_row(void *arg)
+{
+    mask_args *args = arg;
+    int y;
+
+    for (y = 0; y < args->surf->h; y++) {
+        args->kernel.threshold(ROW32(args->surf, y), NULL, args->surf->w,
+                               0xFF808080, 0x40404040, args->c->bits + y,
+                               STRIDE(args->c));
+    }
+}
+
+static void
+bench_masks(int size)
+{
+    mask_args args;
+    const char *format;
+
+    args.a = random_mask(size, 1);
+    args.b = random_mask(size, 2);
+    args.c = random_mask(size, 3);
+
+    bench_run("mask", "count", "bitmask", size, size, run_count, &args);
+    bench_run("mask", "invert", "bitmask", size, size, run_invert, &args);
+    bench_run("mask", "draw", "bitmask", size, size, run_draw, &args);
+    bench_run("mask", "erase", "bitmask", size, size, run_erase, &args);
+    bench_run("mask", "overlap_mask", "bitmask", size, size,
+              run_overlap_mask, &args);
+    args.kernel.and_count = PICK_KERNEL(mask_and_count);
+    bench_run("mask", "overlap_area", "bitmask", size, size, run_and_count,
+              &args);
+
+    args.surf = bench_surface(size, size, SDL_PIXELFORMAT_ARGB8888, 4);
+    format = bench_format_name(SDL_PIXELFORMAT_ARGB8888);
+    args.kernel.alpha = PICK_KERNEL(mask_alpha_row);
+    bench_run("mask", "from_surface_alpha", format, size, size,
+              run_alpha_row, &args);
+    args.kernel.colorkey = PICK_KERNEL(mask_colorkey_row);
+    bench_run("mask", "from_surface_colorkey", format, size, size,
+              run_colorkey_row, &args);
+    args.kernel.threshold = PICK_KERNEL(mask_threshold_row);
+    bench_run("mask", "from_threshold", format, size, size,
+              run_threshold_row, &args);
+    SDL_FreeSurface(args.surf);
+
+    bitmask_free(args.a);
+    bitmask_free(args.b);
+    bitmask_free(args.c);
+}
+
+int
+main(int argc, char *argv[])
+{
+    size_t i;
+
+    set_kernels();
+    bench_set_backend(_pg_mask_has_avx2(), _pg_mask_HasSSE_NEON());
+    for (i = 0; i < SDL_arraysize(bench_sizes); i++) {
+        bench_masks(bench_sizes[i]);
+    }
+    return 0;
+}
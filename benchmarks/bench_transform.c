@@ -0,0 +1,217 @@
+/* Times the row kernels of pygame.transform, and its whole surface SIMD
+ * kernels. See bench.h for the output. */
+#include "bench.h"
+#include "simd_transform.h"
+
+/* defined by simd_shared.h and simd_transform_avx2.c, simd_shared.h can
+ * only be included by one file of a program */
+int
+pg_has_avx2();
+int
+pg_HasSSE_NEON();
+
+/* The kernel transform.c would pick for the SIMD level */
+#if !defined(__EMSCRIPTEN__)
+#if PG_ENABLE_SSE_NEON
+#define _PICK_SSE2(name) (pg_HasSSE_NEON() ? name##_sse2 : name)
+#else
+#define _PICK_SSE2(name) (name)
+#endif /* PG_ENABLE_SSE_NEON */
+#define PICK_KERNEL(name) (pg_has_avx2() ? name##_avx2 : _PICK_SSE2(name))
+#else
+#define PICK_KERNEL(name) (name)
+#endif /* __EMSCRIPTEN__ */
+
+typedef struct {
+    SDL_Surface *src;
+    SDL_Surface *dst;
+    union {
+        SCALE2X_ROW_P scale2x;
+        SCALE3X_ROW_P scale3x;
+        ROTOZOOM_SMOOTH_RUN_P rotozoom;
+        COLOR_MATRIX_ROW_P color_matrix;
+        THRESHOLD_ROW_P threshold;
+        AVERAGE_COLOR_ROW_P average_color;
+        void (*surface)(SDL_Surface *src, SDL_Surface *newsurf);
+    } kernel;
+} transform_args;
+
+#define ROW(surf, y) \
+    ((Uint32 *)((Uint8 *)(surf)->pixels + (y) * (surf)->pitch))
+
+static void
+run_scale2x(void *arg)
+{
+    transform_args *args = arg;
+    int y, n = args->src->w - 2;
+
+    for (y = 1; y < args->src->h - 1; y++) {
+        args->kernel.scale2x(ROW(args->src, y - 1) + 1, ROW(args->src, y) + 1,
+                             ROW(args->src, y + 1) + 1,
+                             ROW(args->dst, 2 * y) + 2,
+                             ROW(args->dst, 2 * y + 1) + 2, n);
+    }
+}
+
+static void
+run_scale3x(void *arg)
+{
+    transform_args *args = arg;
+    int y, n = args->src->w - 2;
+
+    for (y = 1; y < args->src->h - 1; y++) {
+        args->kernel.scale3x(ROW(args->src, y - 1) + 1, ROW(args->src, y) + 1,
+                             ROW(args->src, y + 1) + 1,
+                             ROW(args->dst, 3 * y) + 3,
+                             ROW(args->dst, 3 * y + 1) + 3,
+                             ROW(args->dst, 3 * y + 2) + 3, n);
+    }
+}
+
+/* a 0.9 zoom, so every 2x2 neighbourhood is inside of the source */
+static void
+run_rotozoom(void *arg)
+{
+    transform_args *args = arg;
+    const int zoom = 58982;
+    int y;
+
+    for (y = 0; y < args->dst->h; y++) {
+        args->kernel.rotozoom((Uint8 *)args->src->pixels, args->src->pitch,
+                              ROW(args->dst, y), args->dst->w, 0, y * zoom,
+                              zoom, 0);
+    }
+}
+
+static void
+run_color_matrix(void *arg)
+{
+    /* sepia */
+    static const float matrix[20] = {
+        0.393f, 0.769f, 0.189f, 0.0f, 0.0f, /* red */
+        0.349f, 0.686f, 0.168f, 0.0f, 0.0f, /* green */
+        0.272f, 0.534f, 0.131f, 0.0f, 0.0f, /* blue */
+        0.0f,   0.0f,   0.0f,   1.0f, 0.0f, /* alpha */
+    };
+    transform_args *args = arg;
+    SDL_PixelFormat *fmt = args->src->format;
+    int shifts[4] = {fmt->Rshift, fmt->Gshift, fmt->Bshift, fmt->Ashift};
+    int y;
+
+    for (y = 0; y < args->src->h; y++) {
+        args->kernel.color_matrix(ROW(args->src, y), ROW(args->dst, y),
+                                  args->src->w, shifts, fmt->Amask, matrix);
+    }
+}
+
+static void
+run_threshold(void *arg)
+{
+    transform_args *args = arg;
+    int y;
+
+    for (y = 0; y < args->src->h; y++) {
+        args->kernel.threshold(ROW(args->src, y), NULL, args->src->w,
+                               0xFF808080, 0x40404040, NULL);
+    }
+}
+
+static void
+run_average_color(void *arg)
+{
+    transform_args *args = arg;
+    Uint64 sums[4] = {0, 0, 0, 0};
+    int y;
+
+    for (y = 0; y < args->src->h; y++) {
+        args->kernel.average_color((Uint8 *)ROW(args->src, y), args->src->w,
+                                   3, sums);
+    }
+}
+
+static void
+run_surface(void *arg)
+{
+    transform_args *args = arg;
+
+    args->kernel.surface(args->src, args->dst);
+}
+
+static void
+bench_surface_kernels(transform_args *args, const char *format,
+                      void (*grayscale)(SDL_Surface *, SDL_Surface *),
+                      void (*invert)(SDL_Surface *, SDL_Surface *))
+{
+    int w = args->src->w, h = args->src->h;
+
+    args->kernel.surface = grayscale;
+    bench_run("transform", "grayscale", format, w, h, run_surface, args);
+    args->kernel.surface = invert;
+    bench_run("transform", "invert", format, w, h, run_surface, args);
+}
+
+static void
+bench_transforms(int size)
+{
+    const Uint32 format = SDL_PIXELFORMAT_ARGB8888;
+    const char *name = bench_format_name(format);
+    transform_args args;
+
+    args.src = bench_surface(size, size, format, 1);
+
+    args.dst = bench_surface(2 * size, 2 * size, format, 2);
+    args.kernel.scale2x = PICK_KERNEL(scale2x_row);
+    bench_run("transform", "scale2x_row", name, size, size, run_scale2x,
+              &args);
+    SDL_FreeSurface(args.dst);
+
+    args.dst = bench_surface(3 * size, 3 * size, format, 2);
+    args.kernel.scale3x = PICK_KERNEL(scale3x_row);
+    bench_run("transform", "scale3x_row", name, size, size, run_scale3x,
+              &args);
+    SDL_FreeSurface(args.dst);
+
+    args.dst = bench_surface(size - 1, size - 1, format, 2);
+    args.kernel.rotozoom = PICK_KERNEL(rotozoom_smooth_run);
+    bench_run("transform", "rotozoom_smooth_run", name, size - 1, size - 1,
+              run_rotozoom, &args);
+    SDL_FreeSurface(args.dst);
+
+    args.dst = bench_surface(size, size, format, 2);
+    args.kernel.color_matrix = PICK_KERNEL(color_matrix_row);
+    bench_run("transform", "color_matrix_row", name, size, size,
+              run_color_matrix, &args);
+    args.kernel.threshold = PICK_KERNEL(threshold_row);
+    bench_run("transform", "threshold_row", name, size, size, run_threshold,
+              &args);
+    args.kernel.average_color = PICK_KERNEL(average_color_row);
+    bench_run("transform", "average_color_row", name, size, size,
+              run_average_color, &args);
+
+    /* the generic versions of these live inside of the transform module */
+#if !defined(__EMSCRIPTEN__)
+    if (pg_has_avx2()) {
+        bench_surface_kernels(&args, name, grayscale_avx2, invert_avx2);
+    }
+#if PG_ENABLE_SSE_NEON
+    else if (pg_HasSSE_NEON()) {
+        bench_surface_kernels(&args, name, grayscale_sse2, invert_sse2);
+    }
+#endif /* PG_ENABLE_SSE_NEON */
+#endif /* __EMSCRIPTEN__ */
+
+    SDL_FreeSurface(args.dst);
+    SDL_FreeSurface(args.src);
+}
+
+int
+main(int argc, char *argv[])
+{
+    size_t i;
+
+    bench_set_backend(pg_has_avx2(), pg_HasSSE_NEON());
+    for (i = 0; i < SDL_arraysize(bench_sizes); i++) {
+        bench_transforms(bench_sizes[i]);
+    }
+    return 0;
+}
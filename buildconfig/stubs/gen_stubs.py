@@ -49,6 +49,7 @@ PG_AUTOIMPORT_SUBMODS = [
     "sysfont",
     "_debug",
     "system",
+    "input",
     "geometry",
     "window",
 ]
@@ -36,17 +36,29 @@ from pygame import (
     sysfont as sysfont,
     _debug as _debug,
     system as system,
+    input as input,
     geometry as geometry,
     window as window,
 )
 
-from .rect import Rect as Rect, FRect as FRect
-from .surface import Surface as Surface, SurfaceType as SurfaceType
+from .rect import (
+    Rect as Rect,
+    FRect as FRect,
+    RectArray as RectArray,
+    FRectArray as FRectArray,
+)
+from .surface import (
+    Surface as Surface,
+    SurfaceType as SurfaceType,
+    BlitBatch as BlitBatch,
+    BlendMode as BlendMode,
+    SurfaceView as SurfaceView,
+)
 from .color import Color as Color
 from .pixelarray import PixelArray as PixelArray
 from .math import Vector2 as Vector2, Vector3 as Vector3
 from .cursors import Cursor as Cursor
-from .bufferproxy import BufferProxy as BufferProxy
+from .bufferproxy import BufferArray as BufferArray, BufferProxy as BufferProxy
 from .mask import Mask as Mask
 from ._debug import print_debug_info as print_debug_info
 from .event import Event as Event
@@ -78,6 +90,7 @@ from .rwobject import (
 
 from .version import SDL as SDL, rev as rev, ver as ver, vernum as vernum
 from .constants import (
+    ACCELERATED as ACCELERATED,
     ACTIVEEVENT as ACTIVEEVENT,
     ANYFORMAT as ANYFORMAT,
     APPACTIVE as APPACTIVE,
@@ -107,6 +120,21 @@ from .constants import (
     AUDIO_U16SYS as AUDIO_U16SYS,
     AUDIO_U8 as AUDIO_U8,
     BIG_ENDIAN as BIG_ENDIAN,
+    BLENDFACTOR_DST_ALPHA as BLENDFACTOR_DST_ALPHA,
+    BLENDFACTOR_DST_COLOR as BLENDFACTOR_DST_COLOR,
+    BLENDFACTOR_ONE as BLENDFACTOR_ONE,
+    BLENDFACTOR_ONE_MINUS_DST_ALPHA as BLENDFACTOR_ONE_MINUS_DST_ALPHA,
+    BLENDFACTOR_ONE_MINUS_DST_COLOR as BLENDFACTOR_ONE_MINUS_DST_COLOR,
+    BLENDFACTOR_ONE_MINUS_SRC_ALPHA as BLENDFACTOR_ONE_MINUS_SRC_ALPHA,
+    BLENDFACTOR_ONE_MINUS_SRC_COLOR as BLENDFACTOR_ONE_MINUS_SRC_COLOR,
+    BLENDFACTOR_SRC_ALPHA as BLENDFACTOR_SRC_ALPHA,
+    BLENDFACTOR_SRC_COLOR as BLENDFACTOR_SRC_COLOR,
+    BLENDFACTOR_ZERO as BLENDFACTOR_ZERO,
+    BLENDOPERATION_ADD as BLENDOPERATION_ADD,
+    BLENDOPERATION_MAXIMUM as BLENDOPERATION_MAXIMUM,
+    BLENDOPERATION_MINIMUM as BLENDOPERATION_MINIMUM,
+    BLENDOPERATION_REV_SUBTRACT as BLENDOPERATION_REV_SUBTRACT,
+    BLENDOPERATION_SUBTRACT as BLENDOPERATION_SUBTRACT,
     BLENDMODE_ADD as BLENDMODE_ADD,
     BLENDMODE_BLEND as BLENDMODE_BLEND,
     BLENDMODE_MOD as BLENDMODE_MOD,
@@ -587,6 +615,7 @@ from .constants import (
     NUMEVENTS as NUMEVENTS,
     OPENGL as OPENGL,
     OPENGLBLIT as OPENGLBLIT,
+    PIPELINED as PIPELINED,
     PREALLOC as PREALLOC,
     QUIT as QUIT,
     RENDER_DEVICE_RESET as RENDER_DEVICE_RESET,
@@ -604,6 +633,7 @@ from .constants import (
     SHOWN as SHOWN,
     SRCALPHA as SRCALPHA,
     SRCCOLORKEY as SRCCOLORKEY,
+    STREAMED as STREAMED,
     SWSURFACE as SWSURFACE,
     SYSTEM_CURSOR_ARROW as SYSTEM_CURSOR_ARROW,
     SYSTEM_CURSOR_CROSSHAIR as SYSTEM_CURSOR_CROSSHAIR,
@@ -1,7 +1,44 @@
-from typing import Tuple, Union, Optional, Callable
+from typing import (
+    ContextManager,
+    Dict,
+    List,
+    Tuple,
+    Union,
+    Optional,
+    Callable,
+    Sequence,
+)
+
+from pygame.rect import Rect
+from pygame.surface import Surface
+from pygame.time import Clock
+
+from ._common import Coordinate
 
 ImportResult = Tuple[str, bool, Optional[Callable]]
 
 def str_from_tuple(version_tuple: Union[Tuple[int, int, int], None]) -> str: ...
 def attempt_import(module: str, function_name: str, output_str: str = "") -> ImportResult: ...
 def print_debug_info(filename: Optional[str] = None) -> None: ...
+
+class FrameProfiler:
+    clock: Clock
+    history: int
+    fields: Tuple[str, ...]
+    def __init__(
+        self,
+        clock: Optional[Clock] = None,
+        history: int = 120,
+        sections: Sequence[str] = ("update", "draw"),
+    ) -> None: ...
+    def section(self, name: str) -> ContextManager[None]: ...
+    def tick(self, framerate: float = 0) -> int: ...
+    def get_frames(self) -> List[Dict[str, float]]: ...
+    def get_average(self) -> Dict[str, float]: ...
+    def draw(
+        self,
+        surface: Surface,
+        pos: Coordinate = (0, 0),
+        size: Coordinate = (120, 40),
+        scale: Optional[float] = None,
+    ) -> Rect: ...
@@ -1,4 +1,4 @@
-from typing import Any, Generator, Iterable, Optional, Tuple, Union
+from typing import Any, Generator, Iterable, List, Optional, Tuple, Union
 
 from pygame.color import Color
 from pygame.rect import Rect
@@ -18,6 +18,8 @@ SCALEQUALITY_NEAREST: int
 SCALEQUALITY_LINEAR: int
 SCALEQUALITY_BEST: int
 
+BATCH_RECORD_SIZE: int
+
 class RendererDriverInfo:
     name: str
     flags: int
@@ -100,6 +102,19 @@ class Texture:
         p4_mod: Iterable[int] = (255, 255, 255, 255),
     ) -> None: ...
     def update(self, surface: Surface, area: Optional[RectValue] = None) -> None: ...
+    def lock(self, area: Optional[RectValue] = None) -> TextureLock: ...
+    def update_from_buffer(
+        self, buffer: Any, area: Optional[RectValue] = None, pitch: int = 0
+    ) -> None: ...
+
+class TextureLock:
+    @property
+    def texture(self) -> Texture: ...
+    @property
+    def locked(self) -> bool: ...
+    def unlock(self) -> None: ...
+    def __enter__(self) -> TextureLock: ...
+    def __exit__(self, *args: Any) -> None: ...
 
 class Image:
     def __init__(
@@ -125,6 +140,27 @@ class Image:
     @color.setter
     def color(self, value: ColorValue) -> None: ...
 
+class TextureAtlas:
+    def __init__(
+        self,
+        renderer: Renderer,
+        size: Iterable[int] = (2048, 2048),
+        padding: int = 1,
+        scale_quality: Optional[int] = None,
+    ) -> None: ...
+    @property
+    def renderer(self) -> Renderer: ...
+    @property
+    def width(self) -> int: ...
+    @property
+    def height(self) -> int: ...
+    @property
+    def padding(self) -> int: ...
+    @property
+    def textures(self) -> List[Texture]: ...
+    def add(self, surface: Surface) -> Image: ...
+    def add_all(self, surfaces: Iterable[Surface]) -> List[Image]: ...
+
 class Renderer:
     def __init__(
         self,
@@ -143,6 +179,13 @@ class Renderer:
     def draw_color(self, value: ColorValue) -> None: ...
     def clear(self) -> None: ...
     def present(self) -> None: ...
+    upload_budget: float
+    @property
+    def pending_uploads(self) -> int: ...
+    def queue_update(
+        self, texture: Texture, surface: Surface, area: Optional[RectValue] = None
+    ) -> None: ...
+    def flush_uploads(self) -> None: ...
     def get_viewport(self) -> Rect: ...
     def set_viewport(self, area: Optional[RectValue]) -> None: ...
     logical_size: Iterable[int]
@@ -159,6 +202,10 @@ class Renderer:
     def draw_point(self, point: Coordinate) -> None: ...
     def draw_rect(self, rect: RectValue) -> None: ...
     def fill_rect(self, rect: RectValue) -> None: ...
+    def draw_points(self, buffer: Any) -> None: ...
+    def draw_lines(self, buffer: Any) -> None: ...
+    def draw_rects(self, buffer: Any) -> None: ...
+    def fill_rects(self, buffer: Any) -> None: ...
     def draw_triangle(
         self, p1: Coordinate, p2: Coordinate, p3: Coordinate
     ) -> None: ...
@@ -171,9 +218,13 @@ class Renderer:
     def fill_quad(
         self, p1: Coordinate, p2: Coordinate, p3: Coordinate, p4: Coordinate
     ) -> None: ...
+    def draw_batch(self, texture: Texture, buffer: Any) -> None: ...
     def to_surface(
         self, surface: Optional[Surface] = None, area: Optional[RectValue] = None
     ) -> Surface: ...
+    def read_pixels(
+        self, buffer: Optional[Any] = None, area: Optional[RectValue] = None
+    ) -> Any: ...
     @staticmethod
     def compose_custom_blend_mode(
         color_mode: Tuple[int, int, int], alpha_mode: Tuple[int, int, int]
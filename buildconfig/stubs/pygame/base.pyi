@@ -1,4 +1,4 @@
-from typing import Any, Tuple, Callable
+from typing import Any, Iterable, Optional, Tuple, Callable
 
 __version__: str
 
@@ -8,7 +8,7 @@ class BufferError(Exception): ...
 # Always defined
 HAVE_NEWBUF: int = 1
 
-def init() -> Tuple[int, int]: ...
+def init(subsystems: Optional[Iterable[str]] = None) -> Tuple[int, int]: ...
 def quit() -> None: ...
 def get_init() -> bool: ...
 def get_error() -> str: ...
@@ -1,4 +1,4 @@
-from typing import Any, Dict, overload
+from typing import Any, Dict, Tuple, Union, overload
 
 class BufferProxy:
     parent: Any
@@ -13,3 +13,45 @@ class BufferProxy:
     @overload
     def __init__(self, parent: Any) -> None: ...
     def write(self, buffer: bytes, offset: int = 0) -> None: ...
+
+_Index = Union[int, slice, Tuple[Union[int, slice], ...]]
+_Operand = Union[int, float, Any]
+
+class BufferArray:
+    @property
+    def shape(self) -> Tuple[int, ...]: ...
+    @property
+    def strides(self) -> Tuple[int, ...]: ...
+    @property
+    def ndim(self) -> int: ...
+    @property
+    def itemsize(self) -> int: ...
+    @property
+    def format(self) -> str: ...
+    @property
+    def readonly(self) -> bool: ...
+    @property
+    def parent(self) -> Any: ...
+    def __init__(self, obj: Any) -> None: ...
+    def __len__(self) -> int: ...
+    def __getitem__(self, key: _Index) -> Any: ...
+    def __setitem__(self, key: _Index, value: _Operand) -> None: ...
+    def copy(self) -> BufferArray: ...
+    def fill(self, value: _Operand) -> None: ...
+    def __add__(self, other: _Operand) -> BufferArray: ...
+    def __radd__(self, other: _Operand) -> BufferArray: ...
+    def __sub__(self, other: _Operand) -> BufferArray: ...
+    def __mul__(self, other: _Operand) -> BufferArray: ...
+    def __rmul__(self, other: _Operand) -> BufferArray: ...
+    def __and__(self, other: _Operand) -> BufferArray: ...
+    def __rand__(self, other: _Operand) -> BufferArray: ...
+    def __or__(self, other: _Operand) -> BufferArray: ...
+    def __ror__(self, other: _Operand) -> BufferArray: ...
+    def __xor__(self, other: _Operand) -> BufferArray: ...
+    def __rxor__(self, other: _Operand) -> BufferArray: ...
+    def __iadd__(self, other: _Operand) -> BufferArray: ...
+    def __isub__(self, other: _Operand) -> BufferArray: ...
+    def __imul__(self, other: _Operand) -> BufferArray: ...
+    def __iand__(self, other: _Operand) -> BufferArray: ...
+    def __ior__(self, other: _Operand) -> BufferArray: ...
+    def __ixor__(self, other: _Operand) -> BufferArray: ...
@@ -12,6 +12,8 @@ def list_cameras() -> List[str]: ...
 def colorspace(
     surface: Surface, color: Literal["YUV", "HSV"], dest_surface: Surface = ..., /
 ) -> Surface: ...
+def set_conversion_threads(num_threads: int, /) -> None: ...
+def get_conversion_threads() -> int: ...
 
 class AbstractCamera(ABC):
     @abstractmethod
@@ -39,7 +41,7 @@ class Camera(AbstractCamera):
         size: IntCoordinate = (640, 480),
         format: str = "RGB",
     ) -> None: ...
-    def start(self) -> None: ...
+    def start(self, threaded: bool = False) -> None: ...
     def stop(self) -> None: ...
     def get_controls(self) -> Tuple[bool, bool, int]: ...
     def set_controls(
@@ -52,3 +54,6 @@ class Camera(AbstractCamera):
     def query_image(self) -> bool: ...
     def get_image(self, surface: Optional[Surface] = None) -> Surface: ...
     def get_raw(self) -> bytes: ...
+    def get_raw_view(self) -> memoryview: ...
+    def get_image_view(self) -> Surface: ...
+    def get_frame_time(self) -> int: ...
@@ -1,5 +1,5 @@
 import sys
-from typing import Any, Dict, Iterator, Tuple, Union, overload
+from typing import Any, Dict, Iterator, List, Sequence, Tuple, Union, overload
 
 from ._common import ColorValue, SupportsIndex
 
@@ -81,6 +81,10 @@ class Color(Collection[int]):
     def correct_gamma(self, gamma: float, /) -> Color: ...
     def set_length(self, length: int, /) -> None: ...
     def lerp(self, color: ColorValue, amount: float) -> Color: ...
+    @classmethod
+    def lerp_many(
+        cls, colors: Sequence[ColorValue], color: ColorValue, amount: float
+    ) -> List[Color]: ...
     def premul_alpha(self) -> Color: ...
     def grayscale(self) -> Color: ...
     @overload
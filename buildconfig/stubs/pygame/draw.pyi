@@ -1,9 +1,13 @@
 from pygame.rect import Rect
 from pygame.surface import Surface
-from typing import overload
+from typing import Any, Literal, Union, overload
 
 from ._common import ColorValue, Coordinate, RectValue, Sequence
 
+# Buffer protocol is still not implemented in typing, buffers are Any
+_BatchColors = Union[ColorValue, Sequence[ColorValue], Any]
+_BatchNumbers = Union[Sequence[Sequence[float]], Any]
+
 def rect(
     surface: Surface,
     color: ColorValue,
@@ -21,6 +25,12 @@ def polygon(
     points: Sequence[Coordinate],
     width: int = 0,
 ) -> Rect: ...
+def aapolygon(
+    surface: Surface,
+    color: ColorValue,
+    points: Sequence[Coordinate],
+    filled: bool = True,
+) -> Rect: ...
 def circle(
     surface: Surface,
     color: ColorValue,
@@ -52,6 +62,9 @@ def aacircle(
     draw_bottom_left: bool = False,
     draw_bottom_right: bool = False,
 ) -> Rect: ...
+def circle_stamp(
+    radius: int, color: ColorValue, width: int = 0, aa: bool = False
+) -> Surface: ...
 def ellipse(
     surface: Surface, color: ColorValue, rect: RectValue, width: int = 0
 ) -> Rect: ...
@@ -82,10 +95,34 @@ def aaline(
     color: ColorValue,
     start_pos: Coordinate,
     end_pos: Coordinate,
+    *,
+    width: int = 1,
 ) -> Rect: ...
 def aalines(
     surface: Surface,
     color: ColorValue,
     closed: bool,
     points: Sequence[Coordinate],
+    *,
+    width: int = 1,
+    joint: Literal["miter", "round", "bevel"] = "miter",
+) -> Rect: ...
+def rects(
+    surface: Surface,
+    color: _BatchColors,
+    rects: _BatchNumbers,
+    width: int = 0,
+) -> Rect: ...
+def circles(
+    surface: Surface,
+    color: _BatchColors,
+    centers: _BatchNumbers,
+    radii: Union[float, Sequence[float], Any],
+    width: int = 0,
+) -> Rect: ...
+def lines_batch(
+    surface: Surface,
+    color: _BatchColors,
+    lines: _BatchNumbers,
+    width: int = 1,
 ) -> Rect: ...
@@ -3,11 +3,12 @@ from typing import (
     Dict,
     List,
     Optional,
+    Tuple,
     Union,
     final,
 )
 
-from ._common import Sequence
+from ._common import FileArg, Sequence
 
 @final
 class Event:
@@ -23,6 +24,18 @@ class Event:
     def __delattr__(self, name: str) -> None: ...
     def __bool__(self) -> bool: ...
 
+@final
+class Channel:
+    def __init__(
+        self,
+        capacity: int = 1024,
+        item_size: int = 64,
+        eventtype: Optional[int] = None,
+    ) -> None: ...
+    def __len__(self) -> int: ...
+    def push(self, data: Any, /) -> bool: ...
+    def drain(self, max: int = -1) -> List[bytes]: ...
+
 _EventTypes = Union[int, Sequence[int]]
 
 def pump() -> None: ...
@@ -31,6 +44,9 @@ def get(
     pump: Any = True,
     exclude: Optional[_EventTypes] = None,
 ) -> List[Event]: ...
+def get_into(
+    buffer: Any, pump: Any = True
+) -> int: ...  # Buffer protocol is still not implemented in typing
 def poll() -> Event: ...
 def wait(timeout: int = 0) -> Event: ...
 def peek(eventtype: Optional[_EventTypes] = None, pump: Any = True) -> bool: ...
@@ -43,5 +59,11 @@ def set_grab(grab: bool, /) -> None: ...
 def get_grab() -> bool: ...
 def post(event: Event, /) -> bool: ...
 def custom_type() -> int: ...
+def set_coalesce(
+    eventtype: int, coalesce: bool = True, keep_samples: bool = False
+) -> None: ...
+def get_samples() -> List[Tuple[int, int, float, float, float, float]]: ...
+def record(file: Optional[FileArg], /) -> None: ...
+def replay(file: Optional[FileArg], /) -> None: ...
 
 EventType = Event
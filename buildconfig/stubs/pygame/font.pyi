@@ -1,8 +1,21 @@
-from typing import Callable, Hashable, Iterable, List, Optional, Tuple, Union
+from concurrent.futures import Future
+from typing import (
+    Callable,
+    Hashable,
+    Iterable,
+    List,
+    Optional,
+    Sequence,
+    Tuple,
+    Union,
+)
 
+from typing_extensions import TypedDict
+
+from pygame.rect import Rect
 from pygame.surface import Surface
 
-from ._common import ColorValue, FileArg, Literal
+from ._common import ColorValue, Coordinate, FileArg, Literal, RectValue
 
 # TODO: Figure out a way to type this attribute such that mypy knows it's not
 # always defined at runtime
@@ -27,6 +40,15 @@ def SysFont(
     constructor: Optional[Callable[[Optional[str], int, bool, bool], Font]] = None,
 ) -> Font: ...
 
+# dict at runtime, TypedDict exists solely for the typechecking benefits
+class _CacheStats(TypedDict):
+    hits: int
+    misses: int
+    evictions: int
+    entries: int
+    bytes: int
+    max_bytes: int
+
 class Font:
     @property
     def name(self) -> str: ...
@@ -65,7 +87,24 @@ class Font:
         bgcolor: Optional[ColorValue] = None,
         wraplength: int = 0,
     ) -> Surface: ...
+    def render_to(
+        self,
+        surface: Surface,
+        dest: Union[Coordinate, RectValue],
+        text: Union[str, bytes, None],
+        antialias: bool,
+        color: ColorValue,
+    ) -> Rect: ...
+    def render_async(
+        self,
+        text: Union[str, bytes, None],
+        antialias: bool,
+        color: ColorValue,
+        bgcolor: Optional[ColorValue] = None,
+        wraplength: int = 0,
+    ) -> Future[Surface]: ...
     def size(self, text: Union[str, bytes], /) -> Tuple[int, int]: ...
+    def size_many(self, strings: Sequence[Union[str, bytes]], /) -> memoryview: ...
     def set_underline(self, value: bool, /) -> None: ...
     def get_underline(self) -> bool: ...
     def set_strikethrough(self, value: bool, /) -> None: ...
@@ -83,6 +122,10 @@ class Font:
     def get_descent(self) -> int: ...
     def set_script(self, script_code: str, /) -> None: ...
     def set_direction(self, direction: int) -> None: ...
+    def enable_cache(self, max_bytes: int, /) -> None: ...
+    def disable_cache(self) -> None: ...
+    def clear_cache(self) -> None: ...
+    def get_cache_stats(self) -> _CacheStats: ...
     def get_point_size(self) -> int: ...
     def set_point_size(self, val: int, /) -> None: ...
 
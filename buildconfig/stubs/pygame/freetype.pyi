@@ -1,4 +1,7 @@
-from typing import Any, Callable, Iterable, List, Optional, Tuple, Union
+from concurrent.futures import Future
+from typing import Any, Callable, Iterable, List, Optional, Sequence, Tuple, Union
+
+from typing_extensions import TypedDict
 
 from pygame.color import Color
 from pygame.rect import Rect
@@ -37,6 +40,18 @@ STYLE_STRONG: int
 STYLE_WIDE: int
 STYLE_DEFAULT: int
 
+# dict at runtime, TypedDict exists solely for the typechecking benefits
+class _CacheStats(TypedDict):
+    hits: int
+    misses: int
+    evictions: int
+    entries: int
+    bytes: int
+    max_bytes: int
+    fonts: int
+    sdf_glyphs: int
+    sdf_bytes: int
+
 class Font:
     @property
     def size(self) -> Union[float, Tuple[float, float]]: ...
@@ -113,6 +128,10 @@ class Font:
     @use_bitmap_strikes.setter
     def use_bitmap_strikes(self, value: bool) -> None: ...
     @property
+    def sdf(self) -> bool: ...
+    @sdf.setter
+    def sdf(self, value: bool) -> None: ...
+    @property
     def resolution(self) -> int: ...
     @property
     def rotation(self) -> int: ...
@@ -137,6 +156,7 @@ class Font:
         font_index: int = 0,
         resolution: int = 0,
         ucs4: int = False,
+        share_cache: bool = False,
     ) -> None: ...
     def get_rect(
         self,
@@ -173,6 +193,34 @@ class Font:
         rotation: int = 0,
         size: float = 0,
     ) -> Rect: ...
+    def render_many(
+        self,
+        surf: Surface,
+        items: Sequence[
+            Union[
+                Tuple[Union[str, bytes], RectValue],
+                Tuple[Union[str, bytes], RectValue, Optional[ColorValue]],
+                Tuple[
+                    Union[str, bytes],
+                    RectValue,
+                    Optional[ColorValue],
+                    Optional[ColorValue],
+                ],
+            ]
+        ],
+        style: int = STYLE_DEFAULT,
+        rotation: int = 0,
+        size: float = 0,
+    ) -> List[Rect]: ...
+    def render_async(
+        self,
+        text: str,
+        fgcolor: Optional[ColorValue] = None,
+        bgcolor: Optional[ColorValue] = None,
+        style: int = STYLE_DEFAULT,
+        rotation: int = 0,
+        size: float = 0,
+    ) -> Future[Tuple[Surface, Rect]]: ...
     def render_raw(
         self,
         text: str,
@@ -191,3 +239,5 @@ class Font:
         size: float = 0,
         invert: bool = False,
     ) -> Rect: ...
+    def get_cache_stats(self) -> _CacheStats: ...
+    def set_cache_budget(self, max_bytes: int, /) -> None: ...
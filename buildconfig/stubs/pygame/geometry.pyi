@@ -5,6 +5,10 @@ from typing import (
     Protocol,
     Tuple,
     Sequence,
+    Hashable,
+    List,
+    Any,
+    Optional,
 )
 
 from pygame import Rect, FRect
@@ -21,6 +25,8 @@ class _HasCirclettribute(Protocol):
 
 _CircleValue = Union[_CanBeCircle, _HasCirclettribute]
 _CanBeCollided = Union[Circle, Rect, FRect, Coordinate, Vector2]
+_LineValue = Union[Line, Tuple[Coordinate, Coordinate], Sequence[float]]
+_RaycastTarget = Union[Rect, FRect, Circle, Line, Polygon]
 
 class Circle:
     @property
@@ -94,6 +100,8 @@ class Circle:
     @overload
     def colliderect(self, topleft: Coordinate, size: Coordinate, /) -> bool: ...
     def collideswith(self, other: _CanBeCollided, /) -> bool: ...
+    def collidelist(self, shapes: Sequence[_CanBeCollided], /) -> int: ...
+    def collidelistall(self, shapes: Sequence[_CanBeCollided], /) -> List[int]: ...
     def contains(self, shape: _CanBeCollided) -> bool: ...
     @overload
     def update(self, circle: _CircleValue, /) -> None: ...
@@ -113,3 +121,104 @@ class Circle:
     def as_frect(self) -> FRect: ...
     def __copy__(self) -> Circle: ...
     copy = __copy__
+
+class Line:
+    @property
+    def ax(self) -> float: ...
+    @ax.setter
+    def ax(self, value: float) -> None: ...
+    @property
+    def ay(self) -> float: ...
+    @ay.setter
+    def ay(self, value: float) -> None: ...
+    @property
+    def bx(self) -> float: ...
+    @bx.setter
+    def bx(self, value: float) -> None: ...
+    @property
+    def by(self) -> float: ...
+    @by.setter
+    def by(self, value: float) -> None: ...
+    @property
+    def a(self) -> Tuple[float, float]: ...
+    @a.setter
+    def a(self, value: Coordinate) -> None: ...
+    @property
+    def b(self) -> Tuple[float, float]: ...
+    @b.setter
+    def b(self, value: Coordinate) -> None: ...
+    @property
+    def length(self) -> float: ...
+    @overload
+    def __init__(self, ax: float, ay: float, bx: float, by: float) -> None: ...
+    @overload
+    def __init__(self, a: Coordinate, b: Coordinate) -> None: ...
+    @overload
+    def __init__(self, line: _LineValue) -> None: ...
+    @overload
+    def move(self, x: float, y: float, /) -> Line: ...
+    @overload
+    def move(self, move_by: Coordinate, /) -> Line: ...
+    @overload
+    def move_ip(self, x: float, y: float, /) -> None: ...
+    @overload
+    def move_ip(self, move_by: Coordinate, /) -> None: ...
+    @overload
+    def update(self, line: _LineValue, /) -> None: ...
+    @overload
+    def update(self, ax: float, ay: float, bx: float, by: float, /) -> None: ...
+    @overload
+    def update(self, a: Coordinate, b: Coordinate, /) -> None: ...
+    def collideswith(self, shape: _RaycastTarget, /) -> bool: ...
+    def raycast(
+        self, shapes: Sequence[_RaycastTarget], /
+    ) -> Optional[Tuple[float, float]]: ...
+    def __copy__(self) -> Line: ...
+    copy = __copy__
+
+class Polygon:
+    @property
+    def vertices(self) -> List[Tuple[float, float]]: ...
+    @vertices.setter
+    def vertices(self, value: Sequence[Coordinate]) -> None: ...
+    @property
+    def verts_num(self) -> int: ...
+    @property
+    def center(self) -> Tuple[float, float]: ...
+    @center.setter
+    def center(self, value: Coordinate) -> None: ...
+    def __init__(self, vertices: Union[Polygon, Sequence[Coordinate]]) -> None: ...
+    @overload
+    def collidepoint(self, x: float, y: float, /) -> bool: ...
+    @overload
+    def collidepoint(self, point: Coordinate, /) -> bool: ...
+    @overload
+    def move(self, x: float, y: float, /) -> Polygon: ...
+    @overload
+    def move(self, move_by: Coordinate, /) -> Polygon: ...
+    @overload
+    def move_ip(self, x: float, y: float, /) -> None: ...
+    @overload
+    def move_ip(self, move_by: Coordinate, /) -> None: ...
+    def __copy__(self) -> Polygon: ...
+    copy = __copy__
+
+class RectIndex:
+    @property
+    def cell_size(self) -> float: ...
+    def __init__(self, cell_size: float = 64) -> None: ...
+    def __len__(self) -> int: ...
+    def __contains__(self, key: Hashable) -> bool: ...
+    def insert(self, key: Hashable, rect: RectValue, /) -> None: ...
+    def move(self, key: Hashable, rect: RectValue, /) -> None: ...
+    def remove(self, key: Hashable, /) -> None: ...
+    def clear(self) -> None: ...
+    def get_rect(self, key: Hashable, /) -> FRect: ...
+    @overload
+    def collidepoint(self, point: Coordinate, /) -> List[Any]: ...
+    @overload
+    def collidepoint(self, x: float, y: float, /) -> List[Any]: ...
+    def colliderect(self, rect: RectValue, /) -> List[Any]: ...
+    def collidepairs(self) -> List[Tuple[Any, Any]]: ...
+
+def circle_overlaps(centers: Any, radii: Any, query: _CanBeCollided) -> List[int]: ...
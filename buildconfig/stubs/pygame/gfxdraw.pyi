@@ -87,3 +87,90 @@ def textured_polygon(
 def bezier(
     surface: Surface, points: Sequence[Coordinate], steps: int, color: ColorValue, /
 ) -> None: ...
+
+class batch:
+    def __init__(self, surface: Surface) -> None: ...
+    def __enter__(self) -> batch: ...
+    def __exit__(self, *args, **kwargs) -> None: ...
+    @property
+    def queued(self) -> int: ...
+    def pixel(self, x: int, y: int, color: ColorValue, /) -> None: ...
+    def hline(self, x1: int, x2: int, y: int, color: ColorValue, /) -> None: ...
+    def vline(self, x: int, y1: int, y2: int, color: ColorValue, /) -> None: ...
+    def line(
+        self, x1: int, y1: int, x2: int, y2: int, color: ColorValue, /
+    ) -> None: ...
+    def rectangle(self, rect: RectValue, color: ColorValue, /) -> None: ...
+    def box(self, rect: RectValue, color: ColorValue, /) -> None: ...
+    def circle(self, x: int, y: int, r: int, color: ColorValue, /) -> None: ...
+    def aacircle(self, x: int, y: int, r: int, color: ColorValue, /) -> None: ...
+    def filled_circle(
+        self, x: int, y: int, r: int, color: ColorValue, /
+    ) -> None: ...
+    def ellipse(
+        self, x: int, y: int, rx: int, ry: int, color: ColorValue, /
+    ) -> None: ...
+    def aaellipse(
+        self, x: int, y: int, rx: int, ry: int, color: ColorValue, /
+    ) -> None: ...
+    def filled_ellipse(
+        self, x: int, y: int, rx: int, ry: int, color: ColorValue, /
+    ) -> None: ...
+    def arc(
+        self,
+        x: int,
+        y: int,
+        r: int,
+        start_angle: int,
+        stop_angle: int,
+        color: ColorValue, /
+    ) -> None: ...
+    def pie(
+        self,
+        x: int,
+        y: int,
+        r: int,
+        start_angle: int,
+        stop_angle: int,
+        color: ColorValue, /
+    ) -> None: ...
+    def trigon(
+        self,
+        x1: int,
+        y1: int,
+        x2: int,
+        y2: int,
+        x3: int,
+        y3: int,
+        color: ColorValue, /
+    ) -> None: ...
+    def aatrigon(
+        self,
+        x1: int,
+        y1: int,
+        x2: int,
+        y2: int,
+        x3: int,
+        y3: int,
+        color: ColorValue, /
+    ) -> None: ...
+    def filled_trigon(
+        self,
+        x1: int,
+        y1: int,
+        x2: int,
+        y2: int,
+        x3: int,
+        y3: int,
+        color: ColorValue, /
+    ) -> None: ...
+    def polygon(self, points: Sequence[Coordinate], color: ColorValue, /) -> None: ...
+    def aapolygon(
+        self, points: Sequence[Coordinate], color: ColorValue, /
+    ) -> None: ...
+    def filled_polygon(
+        self, points: Sequence[Coordinate], color: ColorValue, /
+    ) -> None: ...
+    def bezier(
+        self, points: Sequence[Coordinate], steps: int, color: ColorValue, /
+    ) -> None: ...
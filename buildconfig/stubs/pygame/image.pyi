@@ -1,9 +1,11 @@
-from typing import Optional, Tuple, Union
+from concurrent.futures import Future
+from typing import Dict, List, Optional, Sequence, Tuple, TypeVar, Union, overload
 
 from pygame.bufferproxy import BufferProxy
+from pygame.rect import Rect
 from pygame.surface import Surface
 
-from ._common import FileArg, Literal, IntCoordinate, Coordinate
+from ._common import AnyPath, FileArg, Literal, IntCoordinate, Coordinate
 
 _BufferStyle = Union[BufferProxy, bytes, bytearray, memoryview]
 _to_string_format = Literal[
@@ -11,10 +13,63 @@ _to_string_format = Literal[
 ]
 _from_buffer_format = Literal["P", "RGB", "BGR", "BGRA", "RGBX", "RGBA", "ARGB"]
 _from_string_format = Literal["P", "RGB", "RGBX", "RGBA", "ARGB", "BGRA", "ABGR"]
+_IntoBuffer = TypeVar("_IntoBuffer", bytearray, memoryview, BufferProxy)
 
 def load(file: FileArg, namehint: str = "") -> Surface: ...
+@overload
 def load_sized_svg(file: FileArg, size: Coordinate) -> Surface: ...
+@overload
+def load_sized_svg(file: FileArg, size: List[Coordinate]) -> List[Surface]: ...
+def set_svg_cache_limit(limit: int, /) -> None: ...
+@overload
+def load_animation(
+    file: FileArg, namehint: str = "", atlas: Literal[False] = False
+) -> List[Tuple[Surface, int]]: ...
+@overload
+def load_animation(
+    file: FileArg, namehint: str = "", *, atlas: Literal[True]
+) -> Tuple[Surface, List[Tuple[Rect, int]]]: ...
+@overload
+def load_animation(
+    file: FileArg, namehint: str, atlas: Literal[True]
+) -> Tuple[Surface, List[Tuple[Rect, int]]]: ...
+def load_many(
+    paths: Sequence[AnyPath], threads: int = 0
+) -> Tuple[List[Optional[Surface]], Dict[int, str]]: ...
+def load_async(
+    file: FileArg,
+    namehint: str = "",
+    *,
+    convert: bool = False,
+    convert_alpha: bool = False,
+) -> Future[Surface]: ...
 def save(surface: Surface, file: FileArg, namehint: str = "") -> None: ...
+def save_async(
+    surface: Surface, file: AnyPath, namehint: str = "", *, quality: int = 85
+) -> Future[None]: ...
+def save_raw(
+    surface: Surface, file: FileArg, compress: Optional[Literal["lz4"]] = "lz4"
+) -> None: ...
+def load_raw(file: FileArg) -> Surface: ...
+
+class Recorder:
+    def __init__(
+        self,
+        file: FileArg,
+        format: Optional[Literal["raw", "qoi", "tga"]] = None,
+        buffers: int = 4,
+    ) -> None: ...
+    def capture(self, surface: Optional[Surface] = None) -> bool: ...
+    def close(self) -> None: ...
+    def __enter__(self) -> Recorder: ...
+    def __exit__(self, *args: object) -> None: ...
+    @property
+    def captured(self) -> int: ...
+    @property
+    def dropped(self) -> int: ...
+    @property
+    def pending(self) -> int: ...
+
 def get_sdl_image_version(linked: bool = True) -> Optional[Tuple[int, int, int]]: ...
 def get_extended() -> bool: ...
 def tostring(
@@ -32,12 +87,23 @@ def fromstring(
 ) -> Surface: ...
 
 # the use of tobytes/frombytes is preferred over tostring/fromstring
+@overload
 def tobytes(
     surface: Surface,
     format: _to_string_format,
     flipped: bool = False,
     pitch: int = -1,
+    into: None = None,
 ) -> bytes: ...
+@overload
+def tobytes(
+    surface: Surface,
+    format: _to_string_format,
+    flipped: bool = False,
+    pitch: int = -1,
+    *,
+    into: _IntoBuffer,
+) -> _IntoBuffer: ...
 def frombytes(
     bytes: bytes,
     size: IntCoordinate,
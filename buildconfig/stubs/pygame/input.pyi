@@ -0,0 +1,17 @@
+from typing import Optional, Tuple, final
+
+@final
+class InputState:
+    def key_pressed(self, key: int, /) -> bool: ...
+    def mouse_pressed(self, button: int, /) -> bool: ...
+    def get_axis(self, instance_id: int, axis: int, /) -> float: ...
+    def get_button(self, instance_id: int, button: int, /) -> bool: ...
+    def get_hat(self, instance_id: int, hat: int, /) -> Tuple[int, int]: ...
+    @property
+    def mods(self) -> int: ...
+    @property
+    def mouse_pos(self) -> Tuple[int, int]: ...
+    @property
+    def joystick_ids(self) -> Tuple[int, ...]: ...
+
+def snapshot(into: Optional[InputState] = None) -> InputState: ...
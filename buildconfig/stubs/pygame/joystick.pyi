@@ -1,4 +1,4 @@
-from typing import Tuple, final
+from typing import List, Tuple, final
 
 def init() -> None: ...
 def quit() -> None: ...
@@ -27,6 +27,9 @@ class JoystickType:
         self, low_frequency: float, high_frequency: float, duration: int
     ) -> bool: ...
     def stop_rumble(self) -> None: ...
+    def start_sampling(self, rate: int = 1000, capacity: int = 4096) -> None: ...
+    def stop_sampling(self) -> None: ...
+    def get_samples(self) -> List[Tuple[float, Tuple[float, ...]]]: ...
 
 # according to the current implementation, Joystick is a function that returns
 # a JoystickType instance. In the future, when the C implementation is fixed to
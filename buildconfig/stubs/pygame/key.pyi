@@ -8,6 +8,9 @@ def get_focused() -> bool: ...
 def get_pressed() -> ScancodeWrapper: ...
 def get_just_pressed() -> ScancodeWrapper: ...
 def get_just_released() -> ScancodeWrapper: ...
+def get_pressed_view() -> memoryview: ...
+def get_just_pressed_view() -> memoryview: ...
+def get_just_released_view() -> memoryview: ...
 def get_mods() -> int: ...
 def set_mods(mods: int, /) -> None: ...
 def set_repeat(delay: int = 0, interval: int = 0, /) -> None: ...
@@ -2,6 +2,7 @@
 # A script to auto-generate locals.pyi, constants.pyi and __init__.pyi typestubs
 # IMPORTANT NOTE: Do not edit this file by hand!
 
+ACCELERATED: int
 ACTIVEEVENT: int
 ANYFORMAT: int
 APPACTIVE: int
@@ -31,6 +32,21 @@ AUDIO_U16MSB: int
 AUDIO_U16SYS: int
 AUDIO_U8: int
 BIG_ENDIAN: int
+BLENDFACTOR_DST_ALPHA: int
+BLENDFACTOR_DST_COLOR: int
+BLENDFACTOR_ONE: int
+BLENDFACTOR_ONE_MINUS_DST_ALPHA: int
+BLENDFACTOR_ONE_MINUS_DST_COLOR: int
+BLENDFACTOR_ONE_MINUS_SRC_ALPHA: int
+BLENDFACTOR_ONE_MINUS_SRC_COLOR: int
+BLENDFACTOR_SRC_ALPHA: int
+BLENDFACTOR_SRC_COLOR: int
+BLENDFACTOR_ZERO: int
+BLENDOPERATION_ADD: int
+BLENDOPERATION_MAXIMUM: int
+BLENDOPERATION_MINIMUM: int
+BLENDOPERATION_REV_SUBTRACT: int
+BLENDOPERATION_SUBTRACT: int
 BLENDMODE_ADD: int
 BLENDMODE_BLEND: int
 BLENDMODE_MOD: int
@@ -512,6 +528,7 @@ NULL_VIDEODRIVER: str
 NUMEVENTS: int
 OPENGL: int
 OPENGLBLIT: int
+PIPELINED: int
 PREALLOC: int
 QUIT: int
 RENDER_DEVICE_RESET: int
@@ -530,6 +547,7 @@ SCRAP_TEXT: str
 SHOWN: int
 SRCALPHA: int
 SRCCOLORKEY: int
+STREAMED: int
 SWSURFACE: int
 SYSTEM_CURSOR_ARROW: int
 SYSTEM_CURSOR_CROSSHAIR: int
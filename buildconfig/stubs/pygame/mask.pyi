@@ -1,11 +1,13 @@
-from typing import Any, List, Optional, Tuple, Union
+from typing import Any, List, Optional, Sequence, Tuple, Union
 
 from pygame.rect import Rect
 from pygame.surface import Surface
 
 from ._common import ColorValue, Coordinate, RectValue
 
-def from_surface(surface: Surface, threshold: int = 127) -> Mask: ...
+def from_surface(
+    surface: Surface, threshold: int = 127, rect: Optional[RectValue] = None
+) -> Mask: ...
 def from_threshold(
     surface: Surface,
     color: ColorValue,
@@ -13,6 +15,8 @@ def from_threshold(
     othersurface: Optional[Surface] = None,
     palette_colors: int = 1,
 ) -> Mask: ...
+def set_connected_components_threads(num_threads: int, /) -> None: ...
+def get_connected_components_threads() -> int: ...
 
 class Mask:
     def __init__(self, size: Coordinate, fill: bool = False) -> None: ...
@@ -25,16 +29,27 @@ class Mask:
     def overlap(self, other: Mask, offset: Coordinate) -> Optional[Tuple[int, int]]: ...
     def overlap_area(self, other: Mask, offset: Coordinate) -> int: ...
     def overlap_mask(self, other: Mask, offset: Coordinate) -> Mask: ...
+    def overlap_many(
+        self,
+        masks: Union[Mask, Sequence[Mask]],
+        offsets: Any,
+        area: bool = False,
+    ) -> memoryview: ...
     def fill(self) -> None: ...
     def clear(self) -> None: ...
     def invert(self) -> None: ...
+    def prepare_shifts(self) -> None: ...
     def scale(self, scale: Coordinate) -> Mask: ...
     def draw(self, other: Mask, offset: Coordinate) -> None: ...
     def erase(self, other: Mask, offset: Coordinate) -> None: ...
     def count(self) -> int: ...
     def centroid(self) -> Tuple[int, int]: ...
     def angle(self) -> float: ...
-    def outline(self, every: int = 1) -> List[Tuple[int, int]]: ...
+    def moments(self) -> Tuple[int, int, int, int, int, int]: ...
+    def outline(
+        self, every: int = 1, epsilon: float = 0
+    ) -> List[Tuple[int, int]]: ...
+    def outline_points(self, every: int = 1, epsilon: float = 0) -> memoryview: ...
     def convolve(
         self,
         other: Mask,
@@ -332,11 +332,84 @@ class Vector3(_GenericVector):
     @overload
     def update(self, x: int, y: int, z: int) -> None: ...
 
+_Vector2Like = Union[Vector2, Sequence[float]]
+
+class Vector2Array:
+    def __init__(
+        self, vectors: Union[int, Vector2Array, Sequence[_Vector2Like], Any] = 0
+    ) -> None: ...
+    def __len__(self) -> int: ...
+    def __iter__(self) -> Iterator[Vector2]: ...
+    @overload
+    def __getitem__(self, i: SupportsIndex) -> Vector2: ...
+    @overload
+    def __getitem__(self, s: slice) -> Vector2Array: ...
+    @overload
+    def __setitem__(self, i: SupportsIndex, value: _Vector2Like) -> None: ...
+    @overload
+    def __setitem__(
+        self, s: slice, value: Union[_Vector2Like, Vector2Array, Sequence[_Vector2Like]]
+    ) -> None: ...
+    def __add__(self, other: Union[Vector2Array, _Vector2Like]) -> Vector2Array: ...
+    def __radd__(self, other: _Vector2Like) -> Vector2Array: ...
+    def __sub__(self, other: Union[Vector2Array, _Vector2Like]) -> Vector2Array: ...
+    def __rsub__(self, other: _Vector2Like) -> Vector2Array: ...
+    def __mul__(self, other: float) -> Vector2Array: ...
+    def __rmul__(self, other: float) -> Vector2Array: ...
+    def __truediv__(self, other: float) -> Vector2Array: ...
+    def __neg__(self) -> Vector2Array: ...
+    def __pos__(self) -> Vector2Array: ...
+    def __iadd__(self, other: Union[Vector2Array, _Vector2Like]) -> Vector2Array: ...
+    def __isub__(self, other: Union[Vector2Array, _Vector2Like]) -> Vector2Array: ...
+    def __imul__(self, other: float) -> Vector2Array: ...
+    def __itruediv__(self, other: float) -> Vector2Array: ...
+    def __copy__(self) -> Vector2Array: ...
+    def copy(self) -> Vector2Array: ...
+    def length(self) -> List[float]: ...
+    def length_squared(self) -> List[float]: ...
+    def dot(self, other: Union[Vector2Array, _Vector2Like], /) -> List[float]: ...
+    def distance_to(self, other: Union[Vector2Array, _Vector2Like], /) -> List[float]: ...
+    def distance_squared_to(
+        self, other: Union[Vector2Array, _Vector2Like], /
+    ) -> List[float]: ...
+    def normalize(self) -> Vector2Array: ...
+    def normalize_ip(self) -> None: ...
+    def rotate(self, angle: float, /) -> Vector2Array: ...
+    def rotate_ip(self, angle: float, /) -> None: ...
+    def lerp(
+        self, other: Union[Vector2Array, _Vector2Like], value: float, /
+    ) -> Vector2Array: ...
+
 
 def lerp(a: float, b: float, value: float, do_clamp: bool = True, /) -> float: ...
 def invlerp(a: float, b: float, value: float, /) -> float: ...
 def remap(i_min: float, i_max: float, o_min: float, o_max: float, value: float, /) -> float: ...
 def smoothstep(a: float, b: float, weight: float, /) -> float: ...
+def noise(
+    x: float,
+    y: float,
+    /,
+    *,
+    kind: Literal["value", "perlin", "simplex"] = "perlin",
+    octaves: int = 1,
+    persistence: float = 0.5,
+    lacunarity: float = 2.0,
+    seed: int = 0,
+) -> float: ...
+def noise_fill(
+    dest: Any,
+    /,
+    *,
+    kind: Literal["value", "perlin", "simplex"] = "perlin",
+    frequency: float = 0.0625,
+    offset: Sequence[float] = (0, 0),
+    octaves: int = 1,
+    persistence: float = 0.5,
+    lacunarity: float = 2.0,
+    seed: int = 0,
+    channel: Optional[int] = None,
+    threads: int = 0,
+) -> None: ...
 
 
 # typehints for deprecated functions, to be removed in a future version
@@ -1,4 +1,4 @@
-from typing import List, Tuple, Union
+from typing import Any, List, Tuple, Union
 
 from pygame.event import Event
 from ._common import Sequence
@@ -30,6 +30,9 @@ class Input:
     def close(self) -> None: ...
     def poll(self) -> bool: ...
     def read(self, num_events: int) -> List[List[Union[List[int], int]]]: ...
+    def read_into(self, buffer: Any) -> int: ...
+    def start_posting(self, interval: int = 1) -> None: ...
+    def stop_posting(self) -> None: ...
 
 class Output:
     device_id: int
@@ -46,5 +49,6 @@ class Output:
     def set_instrument(self, instrument_id: int, channel: int = 0) -> None: ...
     def pitch_bend(self, value: int = 0, channel: int = 0) -> None: ...
     def write(self, data: List[List[Union[List[int], int]]]) -> None: ...
+    def write_from(self, buffer: Any) -> None: ...
     def write_short(self, status: int, data1: int = 0, data2: int = 0) -> None: ...
     def write_sys_ex(self, when: int, msg: Union[List[int], str]) -> None: ...
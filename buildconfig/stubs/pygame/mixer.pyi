@@ -1,4 +1,4 @@
-from typing import Any, Dict, Optional, Tuple, Union, overload
+from typing import Any, Callable, Dict, Literal, Optional, Tuple, Union, overload
 
 import numpy
 
@@ -30,12 +30,33 @@ def quit() -> None: ...
 def get_init() -> Tuple[int, int, int]: ...
 def get_driver() -> str: ...
 def stop() -> None: ...
+def set_dsp(
+    *,
+    gain: float = 1.0,
+    ramp_ms: float = 0.0,
+    filter: Optional[Literal["lowpass", "highpass"]] = None,
+    cutoff: float = 1000.0,
+    q: float = 0.7071,
+    threshold: Optional[float] = None,
+    ratio: float = 4.0,
+    attack_ms: float = 5.0,
+    release_ms: float = 100.0,
+    reverb: float = 0.0,
+    room_size: float = 0.5,
+    damping: float = 0.5,
+) -> None: ...
+def reset_dsp() -> None: ...
+def set_output_callback(
+    target: Union[None, Callable[[memoryview, int], Any], Any], /
+) -> None: ...  # Buffer protocol is still not implemented in typing
+def get_output_position() -> Tuple[int, float]: ...
 def pause() -> None: ...
 def unpause() -> None: ...
 def fadeout(time: int, /) -> None: ...
 def set_num_channels(count: int, /) -> None: ...
 def get_num_channels() -> int: ...
 def set_reserved(count: int, /) -> int: ...
+def set_cull_distance(distance: Optional[float], /) -> None: ...
 def find_channel(force: bool = False) -> Channel: ...
 def set_soundfont(paths: Optional[str] = None, /) -> None: ...
 def get_soundfont() -> Optional[str]: ...
@@ -44,10 +65,10 @@ def get_sdl_mixer_version(linked: bool = True) -> Tuple[int, int, int]: ...
 
 class Sound:
     @overload
-    def __init__(self, file: FileArg) -> None: ...
+    def __init__(self, file: FileArg, mmap: bool = False) -> None: ...
     @overload
     def __init__(
-        self, buffer: Any
+        self, buffer: Any, copy: bool = True
     ) -> None: ...  # Buffer protocol is still not implemented in typing
     @overload
     def __init__(
@@ -58,7 +79,9 @@ class Sound:
         loops: int = 0,
         maxtime: int = 0,
         fade_ms: int = 0,
-    ) -> Channel: ...
+        priority: int = 0,
+        distance: Optional[float] = None,
+    ) -> Optional[Channel]: ...
     # possibly going to be deprecated/removed soon, in which case these
     # typestubs must be removed too
     __array_interface__: Dict[str, Any]
@@ -68,6 +91,8 @@ class Sound:
     def set_volume(self, value: float, /) -> None: ...
     def get_volume(self) -> float: ...
     def get_num_channels(self) -> int: ...
+    def set_max_instances(self, count: int, /) -> None: ...
+    def get_max_instances(self) -> int: ...
     def get_length(self) -> float: ...
     def get_raw(self) -> bytes: ...
 
@@ -94,6 +119,23 @@ class Channel:
     @overload
     def set_volume(self, left: float, right: float, /) -> None: ...
     def get_volume(self) -> float: ...
+    def set_dsp(
+        self,
+        *,
+        gain: float = 1.0,
+        ramp_ms: float = 0.0,
+        filter: Optional[Literal["lowpass", "highpass"]] = None,
+        cutoff: float = 1000.0,
+        q: float = 0.7071,
+        threshold: Optional[float] = None,
+        ratio: float = 4.0,
+        attack_ms: float = 5.0,
+        release_ms: float = 100.0,
+        reverb: float = 0.0,
+        room_size: float = 0.5,
+        damping: float = 0.5,
+    ) -> None: ...
+    def reset_dsp(self) -> None: ...
     def get_busy(self) -> bool: ...
     def get_sound(self) -> Sound: ...
     def get_queue(self) -> Sound: ...
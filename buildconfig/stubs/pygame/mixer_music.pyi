@@ -15,7 +15,9 @@ def get_volume() -> float: ...
 def get_busy() -> bool: ...
 def set_pos(pos: float, /) -> None: ...
 def get_pos() -> int: ...
-def queue(filename: FileArg, namehint: str = "", loops: int = 0) -> None: ...
+def queue(
+    filename: FileArg, namehint: str = "", loops: int = 0, fade_ms: int = 0
+) -> None: ...
 def set_endevent(event_type: int, /) -> None: ...
 def get_endevent() -> int: ...
 def get_metadata(filename: Optional[FileArg] = None, namehint: str = "") -> Dict[str, str]: ...
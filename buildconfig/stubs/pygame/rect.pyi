@@ -7,6 +7,7 @@ from typing import (
     Union,
     overload,
     Callable,
+    Generic,
     Optional,
 )
 
@@ -18,9 +19,9 @@ else:
     from typing_extensions import Self
 
 if sys.version_info >= (3, 9):
-    from collections.abc import Collection, Iterator
+    from collections.abc import Collection, Iterable, Iterator
 else:
-    from typing import Collection, Iterator
+    from typing import Collection, Iterable, Iterator
 
 _N = TypeVar("_N", int, float)
 _K = TypeVar("_K")
@@ -273,6 +274,10 @@ class _GenericRect(Collection[_N]):
     def collidedictall(
         self, rect_dict: Dict[_K, _RectTypeCompatible_co], values: Literal[True]
     ) -> List[Tuple[_K, _RectTypeCompatible_co]]: ...
+    @staticmethod
+    def collide_all_pairs(
+        rects: Union[Sequence[RectValue], RectArray, FRectArray], /
+    ) -> List[Tuple[int, int]]: ...
 
 # Rect confirms to the Collection ABC, since it also confirms to
 # Sized, Iterable and Container ABCs
@@ -282,5 +287,34 @@ class Rect(_GenericRect[int]):
 class FRect(_GenericRect[float]):
     ...
 
+_R = TypeVar("_R", Rect, FRect)
+
+class _GenericRectArray(Generic[_R]):
+    def __init__(self, rects: Iterable[RectValue] = (), /) -> None: ...
+    def __len__(self) -> int: ...
+    def __getitem__(self, index: SupportsIndex) -> _R: ...
+    def __setitem__(self, index: SupportsIndex, value: RectValue) -> None: ...
+    def __iter__(self) -> Iterator[_R]: ...
+    def __copy__(self) -> Self: ...
+    def append(self, rect: RectValue, /) -> None: ...
+    def copy(self) -> Self: ...
+    @overload
+    def move_ip(self, x: float, y: float, /) -> None: ...
+    @overload
+    def move_ip(self, move_by: Coordinate, /) -> None: ...
+    def clamp_ip(self, rect: RectValue, /) -> None: ...
+    @overload
+    def collidepoint(self, x: float, y: float, /) -> bytes: ...
+    @overload
+    def collidepoint(self, x_y: Coordinate, /) -> bytes: ...
+    def colliderect(self, rect: RectValue, /) -> bytes: ...
+    def union(self) -> _R: ...
+
+class RectArray(_GenericRectArray[Rect]):
+    ...
+
+class FRectArray(_GenericRectArray[FRect]):
+    ...
+
 RectType = Rect
 FRectType = FRect
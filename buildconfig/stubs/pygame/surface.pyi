@@ -1,5 +1,8 @@
+from multiprocessing.shared_memory import SharedMemory
 from typing import Any, Iterable, List, Optional, Tuple, Union, overload
 
+from typing_extensions import TypedDict
+
 from pygame.bufferproxy import BufferProxy
 from pygame.color import Color
 from pygame.rect import FRect, Rect
@@ -13,6 +16,8 @@ from ._common import (
     Sequence,
 )
 
+_SharedMemoryFormat = Literal["RGBA", "RGBX", "ARGB", "BGRA", "RGB", "BGR"]
+
 _ViewKind = Literal[
     "0",
     "1",
@@ -48,6 +53,10 @@ class Surface:
     def height(self) -> int: ...
     @property
     def size(self) -> Tuple[int, int]: ...
+    @property
+    def premultiplied(self) -> bool: ...
+    @premultiplied.setter
+    def premultiplied(self, value: bool) -> None: ...
     @overload
     def __init__(
         self,
@@ -68,7 +77,7 @@ class Surface:
     copy = __copy__
     def blit(
         self,
-        source: Surface,
+        source: Union[Surface, SurfaceView],
         dest: Union[Coordinate, RectValue],
         area: Optional[RectValue] = None,
         special_flags: int = 0,
@@ -83,12 +92,60 @@ class Surface:
             ]
         ],
         doreturn: Union[int, bool] = 1,
+        parallel: bool = False,
     ) -> Union[List[Rect], None]: ...
     def fblits(
         self,
-        blit_sequence: Iterable[Tuple[Surface, Union[Coordinate, RectValue]]],
-        special_flags: int = 0, /
+        blit_sequence: Union[
+            Iterable[
+                Union[
+                    Tuple[Union[Surface, SurfaceView], Union[Coordinate, RectValue]],
+                    Tuple[
+                        Union[Surface, SurfaceView],
+                        Union[Coordinate, RectValue],
+                        Optional[int],
+                    ],
+                    Tuple[
+                        Union[Surface, SurfaceView],
+                        Union[Coordinate, RectValue],
+                        Optional[int],
+                        Optional[ColorValue],
+                    ],
+                ]
+            ],
+            BlitBatch,
+        ],
+        special_flags: int = 0,
+        parallel: bool = False,
+        /,
     ) -> None: ...
+    def blit_transformed(
+        self,
+        source: Surface,
+        pos: Coordinate,
+        angle: float = 0,
+        scale: Union[float, Coordinate] = 1,
+        flip_x: bool = False,
+        flip_y: bool = False,
+        origin: Optional[Coordinate] = None,
+        smooth: bool = False,
+        special_flags: int = 0,
+    ) -> Rect: ...
+    def blit_tiled(
+        self,
+        source: Surface,
+        rect: RectValue,
+        offset: Coordinate = (0, 0),
+        special_flags: int = 0,
+    ) -> Rect: ...
+    def blit_tilemap(
+        self,
+        tileset: Surface,
+        indices: Union[Sequence[Sequence[int]], Any],
+        tile_size: Coordinate,
+        origin: Coordinate = (0, 0),
+        special_flags: int = 0,
+    ) -> Rect: ...
     @overload
     def convert(self, surface: Surface, /) -> Surface: ...
     @overload
@@ -98,12 +155,23 @@ class Surface:
     @overload
     def convert(self) -> Surface: ...
     def convert_alpha(self) -> Surface: ...
+    @staticmethod
+    def convert_many(
+        surfaces: Sequence[Optional[Surface]], alpha: bool = True
+    ) -> List[Optional[Surface]]: ...
     def fill(
         self,
         color: ColorValue,
         rect: Optional[RectValue] = None,
         special_flags: int = 0,
     ) -> Rect: ...
+    def fill_many(
+        self,
+        # Buffer protocol is still not implemented in typing, buffers are Any
+        rects: Union[Sequence[RectValue], Any],
+        colors: Union[ColorValue, Sequence[ColorValue], Any],
+        special_flags: int = 0,
+    ) -> None: ...
     def scroll(self, dx: int = 0, dy: int = 0, /) -> None: ...
     @overload
     def set_colorkey(self, color: ColorValue, flags: int = 0, /) -> None: ...
@@ -123,6 +191,17 @@ class Surface:
     def get_at(self, x_y: Coordinate, /) -> Color: ...
     def set_at(self, x_y: Coordinate, color: ColorValue, /) -> None: ...
     def get_at_mapped(self, x_y: Coordinate, /) -> int: ...
+    def get_at_many(
+        self,
+        # buffers are Any, like for fill_many()
+        points: Union[Sequence[Coordinate], Any],
+        out: Any = None,
+    ) -> Any: ...
+    def set_at_many(
+        self,
+        points: Union[Sequence[Coordinate], Any],
+        colors: Union[ColorValue, Sequence[ColorValue], Any],
+    ) -> None: ...
     def get_palette(self) -> List[Color]: ...
     def get_palette_at(self, index: int, /) -> Color: ...
     def set_palette(self, palette: Sequence[ColorValue], /) -> None: ...
@@ -139,6 +218,18 @@ class Surface:
     def subsurface(
         self, left: float, top: float, width: float, height: float, /
     ) -> Surface: ...
+    @overload
+    def subsurfaces(
+        self, rects: Sequence[RectValue], views: Literal[False] = False
+    ) -> List[Surface]: ...
+    @overload
+    def subsurfaces(
+        self, rects: Sequence[RectValue], views: Literal[True]
+    ) -> List[SurfaceView]: ...
+    @overload
+    def subsurfaces(
+        self, rects: Sequence[RectValue], views: bool
+    ) -> Union[List[Surface], List[SurfaceView]]: ...
     def get_parent(self) -> Surface: ...
     def get_abs_parent(self) -> Surface: ...
     def get_offset(self) -> Tuple[int, int]: ...
@@ -160,7 +251,113 @@ class Surface:
     def get_bounding_rect(self, min_alpha: int = 1) -> Rect: ...
     def get_view(self, kind: _ViewKind = "2", /) -> BufferProxy: ...
     def get_buffer(self) -> BufferProxy: ...
+    @staticmethod
+    def from_buffer(
+        buffer: Any,
+        size: Coordinate,
+        pitch: int = 0,
+        masks: Optional[ColorValue] = None,
+        depth: int = 32,
+    ) -> Surface: ...
+    @staticmethod
+    def from_shared_memory(
+        name: str, size: Coordinate, format: _SharedMemoryFormat
+    ) -> Surface: ...
+    def to_shared_memory(
+        self, format: _SharedMemoryFormat = "RGBA"
+    ) -> SharedMemory: ...
     def get_blendmode(self) -> int: ...
     def premul_alpha(self) -> Surface: ...
+    def premul_alpha_ip(self) -> Surface: ...
+    def set_alpha_spans(self, enable: bool, /) -> None: ...
+    def set_dirty_tracking(self, enable: bool, /) -> None: ...
+    def get_dirty_rects(self, clear: bool = True) -> List[Rect]: ...
+    def get_version(self) -> int: ...
+    def snapshot(self) -> SurfaceSnapshot: ...
+    def restore(self, snapshot: SurfaceSnapshot, /) -> None: ...
 
 SurfaceType = Surface
+
+class SurfaceSnapshot: ...
+
+class BlitBatch:
+    def __init__(
+        self,
+        blit_sequence: Iterable[Tuple[Surface, Union[Coordinate, RectValue]]] = (),
+    ) -> None: ...
+    def __len__(self) -> int: ...
+    def __getitem__(self, index: int) -> Tuple[Surface, Tuple[int, int]]: ...
+    def __setitem__(
+        self, index: int, value: Tuple[Surface, Union[Coordinate, RectValue]]
+    ) -> None: ...
+    def append(self, source: Surface, dest: Union[Coordinate, RectValue], /) -> None: ...
+    def extend(
+        self,
+        blit_sequence: Iterable[Tuple[Surface, Union[Coordinate, RectValue]]],
+        /,
+    ) -> None: ...
+    def clear(self) -> None: ...
+
+class SurfaceView:
+    def __init__(self, surface: Surface, rect: RectValue) -> None: ...
+    @property
+    def surface(self) -> Surface: ...
+    @property
+    def rect(self) -> Rect: ...
+    def get_size(self) -> Tuple[int, int]: ...
+    def subsurface(self) -> Surface: ...
+
+class BlendMode(int):
+    def __new__(
+        cls,
+        src_factor: int,
+        dst_factor: int,
+        operation: int,
+        alpha_src_factor: Optional[int] = None,
+        alpha_dst_factor: Optional[int] = None,
+        alpha_operation: Optional[int] = None,
+    ) -> BlendMode: ...
+    @property
+    def src_factor(self) -> int: ...
+    @property
+    def dst_factor(self) -> int: ...
+    @property
+    def operation(self) -> int: ...
+    @property
+    def alpha_src_factor(self) -> int: ...
+    @property
+    def alpha_dst_factor(self) -> int: ...
+    @property
+    def alpha_operation(self) -> int: ...
+
+def set_blit_threads(num_threads: int, /) -> None: ...
+def get_blit_threads() -> int: ...
+
+class _BlitTraceEntry(TypedDict):
+    src_format: str
+    dst_format: str
+    special_flags: int
+    kernel: str
+    calls: int
+    pixels: int
+    ns: int
+
+def set_blit_trace(enabled: bool, /) -> None: ...
+def get_blit_trace() -> List[_BlitTraceEntry]: ...
+
+class _PoolStats(TypedDict):
+    limit: int
+    bytes: int
+    count: int
+    hits: int
+    misses: int
+
+def set_copy_on_write(enabled: bool, /) -> None: ...
+def get_copy_on_write() -> bool: ...
+def set_pool_limit(max_bytes: int, /) -> None: ...
+def get_pool_stats() -> _PoolStats: ...
+def set_row_alignment(align: int, /) -> None: ...
+def get_row_alignment() -> int: ...
+def get_bounding_rects(
+    surfaces: Sequence[Surface], min_alpha: int = 1, threads: int = 0
+) -> List[Rect]: ...
@@ -1,4 +1,4 @@
-from typing import List, Optional, final
+from typing import Dict, List, Literal, Optional, final
 
 from typing_extensions import TypedDict
 
@@ -25,8 +25,38 @@ class _Locale(TypedDict):
     language: str
     country: Optional[str]
 
+class _FreelistStats(TypedDict):
+    hits: int
+    misses: int
+    size: int
+    max_size: int
+    hit_rate: float
+
+class _PerfCounter(TypedDict):
+    calls: int
+    pixels: int
+    ns: int
+
+class _SurfaceMemoryCounter(TypedDict):
+    count: int
+    bytes: int
+    peak_count: int
+    peak_bytes: int
+
+class _SurfaceMemory(TypedDict):
+    total: _SurfaceMemoryCounter
+    origins: Dict[str, _SurfaceMemoryCounter]
+    formats: Dict[str, _SurfaceMemoryCounter]
+
 def get_cpu_instruction_sets() -> _InstructionSets: ...
 def get_total_ram() -> int: ...
 def get_pref_path(org: str, app: str) -> str: ...
 def get_pref_locales() -> List[_Locale]: ...
 def get_power_state() -> Optional[PowerState]: ...
+def get_freelist_stats() -> Dict[str, _FreelistStats]: ...
+def get_perf_counters() -> Dict[str, _PerfCounter]: ...
+def reset_perf_counters() -> None: ...
+def set_simd_level(level: Literal["scalar", "sse2", "neon", "avx2"], /) -> None: ...
+def get_simd_dispatch() -> Dict[str, str]: ...
+def get_surface_memory() -> _SurfaceMemory: ...
+def reset_surface_memory_peaks() -> None: ...
@@ -1,15 +1,17 @@
-from typing import Union, final
+from typing import Any, Dict, Union, final
 
 from pygame.event import Event
 
 def get_ticks() -> int: ...
 def wait(milliseconds: int, /) -> int: ...
 def delay(milliseconds: int, /) -> int: ...
-def set_timer(event: Union[int, Event], millis: int, loops: int = 0) -> None: ...
+def set_timer(event: Union[int, Event], millis: float, loops: int = 0) -> None: ...
 @final
 class Clock:
     def tick(self, framerate: float = 0, /) -> int: ...
     def tick_busy_loop(self, framerate: float = 0, /) -> int: ...
+    def tick_precise(self, framerate: float = 0, /) -> float: ...
     def get_time(self) -> int: ...
     def get_rawtime(self) -> int: ...
     def get_fps(self) -> float: ...
+    def get_frame_stats(self) -> Dict[str, Any]: ...
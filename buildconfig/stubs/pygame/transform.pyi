@@ -1,11 +1,29 @@
-from typing import Optional, Union, Literal
+from typing import List, Optional, Tuple, Union, Literal
+
+from typing_extensions import TypedDict
 
 from pygame.color import Color
+from pygame.rect import Rect
 from pygame.surface import Surface
 
 from ._common import ColorValue, Coordinate, RectValue, Sequence
 
-def flip(surface: Surface, flip_x: bool, flip_y: bool) -> Surface: ...
+# dict at runtime, TypedDict exists solely for the typechecking benefits
+class _CacheStats(TypedDict):
+    hits: int
+    misses: int
+    evictions: int
+    entries: int
+    bytes: int
+    max_bytes: int
+
+def flip(
+    surface: Surface,
+    flip_x: bool,
+    flip_y: bool,
+    dest_surface: Optional[Surface] = None,
+) -> Surface: ...
+def flip_ip(surface: Surface, flip_x: bool, flip_y: bool) -> None: ...
 def scale(
     surface: Surface,
     size: Coordinate,
@@ -16,33 +34,93 @@ def scale_by(
     factor: Union[float, Sequence[float]],
     dest_surface: Optional[Surface] = None,
 ) -> Surface: ...
-def rotate(surface: Surface, angle: float) -> Surface: ...
-def rotozoom(surface: Surface, angle: float, scale: float) -> Surface: ...
+def rotate(
+    surface: Surface, angle: float, dest_surface: Optional[Surface] = None
+) -> Surface: ...
+def rotozoom(
+    surface: Surface,
+    angle: float,
+    scale: float,
+    dest_surface: Optional[Surface] = None,
+) -> Surface: ...
 def scale2x(surface: Surface, dest_surface: Optional[Surface] = None) -> Surface: ...
+def scale3x(surface: Surface, dest_surface: Optional[Surface] = None) -> Surface: ...
+def scale4x(surface: Surface, dest_surface: Optional[Surface] = None) -> Surface: ...
 def grayscale(surface: Surface, dest_surface: Optional[Surface] = None) -> Surface: ...
+def grayscale_ip(surface: Surface) -> None: ...
 def smoothscale(
     surface: Surface,
     size: Coordinate,
     dest_surface: Optional[Surface] = None,
+    pyramid: Optional[Sequence[Surface]] = None,
 ) -> Surface: ...
 def smoothscale_by(
     surface: Surface,
     factor: Union[float, Sequence[float]],
     dest_surface: Optional[Surface] = None,
 ) -> Surface: ...
-def get_smoothscale_backend() -> Literal["GENERIC", "SSE2", "NEON"]: ...
-def set_smoothscale_backend(backend: Literal["GENERIC", "SSE2", "NEON"]) -> None: ...
-def chop(surface: Surface, rect: RectValue) -> Surface: ...
+def build_pyramid(surface: Surface, levels: int) -> List[Surface]: ...
+def get_smoothscale_backend() -> Literal["GENERIC", "SSE2", "NEON", "AVX2"]: ...
+def set_smoothscale_backend(
+    backend: Literal["GENERIC", "SSE2", "NEON", "AVX2"]
+) -> None: ...
+def set_smoothscale_threads(num_threads: int, /) -> None: ...
+def get_smoothscale_threads() -> int: ...
+def get_rotate_backend() -> Literal["GENERIC", "SSE2", "NEON", "AVX2"]: ...
+def set_rotate_backend(
+    backend: Literal["GENERIC", "SSE2", "NEON", "AVX2"]
+) -> None: ...
+def set_rotozoom_threads(num_threads: int, /) -> None: ...
+def get_rotozoom_threads() -> int: ...
+def enable_cache(max_bytes: int) -> None: ...
+def disable_cache() -> None: ...
+def clear_cache() -> None: ...
+def get_cache_stats() -> _CacheStats: ...
+def chop(
+    surface: Surface, rect: RectValue, dest_surface: Optional[Surface] = None
+) -> Surface: ...
 def laplacian(surface: Surface, dest_surface: Optional[Surface] = None) -> Surface: ...
 def invert(surface: Surface, dest_surface: Optional[Surface] = None) -> Surface: ...
+def invert_ip(surface: Surface) -> None: ...
 def average_surfaces(
     surfaces: Sequence[Surface],
     dest_surface: Optional[Surface] = None,
     palette_colors: Union[bool, int] = 1,
 ) -> Surface: ...
+
+class Accumulator:
+    def __init__(self, size: Coordinate) -> None: ...
+    def add(self, surface: Surface, /) -> None: ...
+    def get_average(self, dest_surface: Optional[Surface] = None) -> Surface: ...
+    def clear(self) -> None: ...
+    @property
+    def count(self) -> int: ...
+    @property
+    def size(self) -> Tuple[int, int]: ...
+
+class LightMap:
+    def __init__(self, size: Coordinate, ambient: ColorValue = (0, 0, 0)) -> None: ...
+    def add(
+        self,
+        light: Surface,
+        dest: Union[Coordinate, RectValue],
+        intensity: int = 255,
+        special_flags: int = 0,
+    ) -> None: ...
+    def apply(
+        self, surface: Surface, dest: Union[Coordinate, RectValue] = (0, 0)
+    ) -> Rect: ...
+    def clear(self, ambient: Optional[ColorValue] = None) -> None: ...
+    @property
+    def ambient(self) -> Tuple[int, int, int]: ...
+    @property
+    def size(self) -> Tuple[int, int]: ...
+
 def average_color(
     surface: Surface, rect: Optional[RectValue] = None, consider_alpha: bool = False
 ) -> Color: ...
+def set_average_color_threads(num_threads: int, /) -> None: ...
+def get_average_color_threads() -> int: ...
 def threshold(
     dest_surface: Optional[Surface],
     surface: Surface,
@@ -65,6 +143,19 @@ def gaussian_blur(
     repeat_edge_pixels: bool = True,
     dest_surface: Optional[Surface] = None
 ) -> Surface: ...
+def stack_blur(
+    surface: Surface,
+    radius: int,
+    repeat_edge_pixels: bool = True,
+    dest_surface: Optional[Surface] = None
+) -> Surface: ...
+def convolve(
+    surface: Surface,
+    kernel: Sequence[Sequence[float]],
+    dest_surface: Optional[Surface] = None,
+) -> Surface: ...
+def set_blur_threads(num_threads: int, /) -> None: ...
+def get_blur_threads() -> int: ...
 def hsl(
     surface: Surface,
     hue: float = 0,
@@ -72,3 +163,14 @@ def hsl(
     lightness: float = 0,
     dest_surface: Optional[Surface] = None,
 ) -> Surface: ...
+def hsl_ip(
+    surface: Surface,
+    hue: float = 0,
+    saturation: float = 0,
+    lightness: float = 0,
+) -> None: ...
+def color_matrix(
+    surface: Surface,
+    matrix: Sequence[Sequence[float]],
+    dest_surface: Optional[Surface] = None,
+) -> Surface: ...
@@ -1,4 +1,4 @@
-from typing import Optional, Tuple, Union, final
+from typing import Optional, Sequence, Tuple, Union, final
 
 from pygame._common import Coordinate, RectValue
 from pygame.locals import WINDOWPOS_UNDEFINED
@@ -28,6 +28,11 @@ class Window:
     def set_icon(self, icon: Surface, /) -> None: ...
     def get_surface(self) -> Surface: ...
     def flip(self) -> None: ...
+    @staticmethod
+    def flip_all(
+        windows: Sequence[Union[Window, Tuple[Window, Sequence[Optional[RectValue]]]]],
+        /,
+    ) -> None: ...
 
     grab_mouse: bool
     grab_keyboard: bool
@@ -74,7 +74,10 @@ import distutils
 
 import distutils.ccompiler
 
-avx2_filenames = ['simd_blitters_avx2', 'simd_transform_avx2', 'simd_surface_fill_avx2']
+avx2_filenames = ['simd_blitters_avx2', 'simd_transform_avx2', 'simd_surface_fill_avx2',
+                  'simd_mask_avx2', 'simd_image_avx2', 'ft_render_cb_avx2',
+                  'simd_camera_avx2', 'simd_geometry_avx2',
+                  'simd_noise_avx2']
 
 compiler_options = {
     'unix': ('-mavx2',),
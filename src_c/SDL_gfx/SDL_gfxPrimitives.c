@@ -1183,6 +1183,80 @@ hlineRGBAStore(SDL_Surface *dst, Sint16 x1, Sint16 x2, Sint16 y, Uint8 r,
         ((Uint32)r << 24) | ((Uint32)g << 16) | ((Uint32)b << 8) | (Uint32)a));
 }
 
+/*!
+\brief Internal function to draw a horizontal line of a color already mapped
+to the pixel format of the surface, without blending, locking or clipping.
+
+\param dst The surface to draw on.
+\param x1 X coordinate of the first point (i.e. left) of the line.
+\param x2 X coordinate of the second point (i.e. right) of the line.
+\param y Y coordinate of the points of the line.
+\param color The pixel value of the line to draw.
+*/
+static void
+_HLineMappedNolock(SDL_Surface *dst, Sint16 x1, Sint16 x2, Sint16 y,
+                   Uint32 color)
+{
+    Uint8 *pixel, *pixellast;
+    int dx = x2 - x1;
+    int pixx, pixy;
+    Uint8 color3[3];
+
+    pixx = GFX_SURF_BytesPerPixel(dst);
+    pixy = dst->pitch;
+    pixel = ((Uint8 *)dst->pixels) + pixx * (int)x1 + pixy * (int)y;
+
+    switch (pixx) {
+        case 1:
+            memset(pixel, color, dx + 1);
+            break;
+        case 2:
+            pixellast = pixel + dx + dx;
+            for (; pixel <= pixellast; pixel += pixx) {
+                *(Uint16 *)pixel = color;
+            }
+            break;
+        case 3:
+            pixellast = pixel + dx + dx + dx;
+            if (SDL_BYTEORDER == SDL_BIG_ENDIAN) {
+                color3[0] = (color >> 16) & 0xff;
+                color3[1] = (color >> 8) & 0xff;
+                color3[2] = color & 0xff;
+            }
+            else {
+                color3[0] = color & 0xff;
+                color3[1] = (color >> 8) & 0xff;
+                color3[2] = (color >> 16) & 0xff;
+            }
+            for (; pixel <= pixellast; pixel += pixx) {
+                memcpy(pixel, color3, 3);
+            }
+            break;
+        default: /* case 4 */
+            pixellast = pixel + 4 * dx;
+            for (; pixel <= pixellast; pixel += pixx) {
+                *(Uint32 *)pixel = color;
+            }
+            break;
+    }
+}
+
+/*!
+\brief Maps a 0xRRGGBBAA color to the pixel format of a surface.
+*/
+static Uint32
+_gfxPrimitivesMapColor(SDL_Surface *dst, Uint32 color)
+{
+    Uint8 *colorptr = (Uint8 *)&color;
+
+    if (SDL_BYTEORDER == SDL_BIG_ENDIAN) {
+        return SDL_MapRGBA(dst->format, colorptr[0], colorptr[1], colorptr[2],
+                           colorptr[3]);
+    }
+    return SDL_MapRGBA(dst->format, colorptr[3], colorptr[2], colorptr[1],
+                       colorptr[0]);
+}
+
 /*!
 \brief Draw horizontal line with blending.
 
@@ -1198,13 +1272,9 @@ int
 hlineColor(SDL_Surface *dst, Sint16 x1, Sint16 x2, Sint16 y, Uint32 color)
 {
     Sint16 left, right, top, bottom;
-    Uint8 *pixel, *pixellast;
     int dx;
-    int pixx, pixy;
     Sint16 xtmp;
     int result = -1;
-    Uint8 *colorptr;
-    Uint8 color3[3];
 
     /*
      * Check visibility of clipping rectangle
@@ -1266,15 +1336,7 @@ hlineColor(SDL_Surface *dst, Sint16 x1, Sint16 x2, Sint16 y, Uint32 color)
         /*
          * Setup color
          */
-        colorptr = (Uint8 *)&color;
-        if (SDL_BYTEORDER == SDL_BIG_ENDIAN) {
-            color = SDL_MapRGBA(dst->format, colorptr[0], colorptr[1],
-                                colorptr[2], colorptr[3]);
-        }
-        else {
-            color = SDL_MapRGBA(dst->format, colorptr[3], colorptr[2],
-                                colorptr[1], colorptr[0]);
-        }
+        color = _gfxPrimitivesMapColor(dst, color);
 
         /*
          * Lock the surface
@@ -1285,50 +1347,10 @@ hlineColor(SDL_Surface *dst, Sint16 x1, Sint16 x2, Sint16 y, Uint32 color)
             }
         }
 
-        /*
-         * More variable setup
-         */
-        pixx = GFX_SURF_BytesPerPixel(dst);
-        pixy = dst->pitch;
-        pixel = ((Uint8 *)dst->pixels) + pixx * (int)x1 + pixy * (int)y;
-
         /*
          * Draw
          */
-        switch (GFX_SURF_BytesPerPixel(dst)) {
-            case 1:
-                memset(pixel, color, dx + 1);
-                break;
-            case 2:
-                pixellast = pixel + dx + dx;
-                for (; pixel <= pixellast; pixel += pixx) {
-                    *(Uint16 *)pixel = color;
-                }
-                break;
-            case 3:
-                pixellast = pixel + dx + dx + dx;
-                if (SDL_BYTEORDER == SDL_BIG_ENDIAN) {
-                    color3[0] = (color >> 16) & 0xff;
-                    color3[1] = (color >> 8) & 0xff;
-                    color3[2] = color & 0xff;
-                }
-                else {
-                    color3[0] = color & 0xff;
-                    color3[1] = (color >> 8) & 0xff;
-                    color3[2] = (color >> 16) & 0xff;
-                }
-                for (; pixel <= pixellast; pixel += pixx) {
-                    memcpy(pixel, color3, 3);
-                }
-                break;
-            default: /* case 4 */
-                dx = dx + dx;
-                pixellast = pixel + dx + dx;
-                for (; pixel <= pixellast; pixel += pixx) {
-                    *(Uint32 *)pixel = color;
-                }
-                break;
-        }
+        _HLineMappedNolock(dst, x1, x1 + dx, y, color);
 
         /*
          * Unlock surface
@@ -5366,40 +5388,141 @@ aapolygonRGBA(SDL_Surface *dst, const Sint16 *vx, const Sint16 *vy, int n,
 /* ---- Filled Polygon */
 
 /*!
-\brief Internal helper qsort callback functions used in filled polygon drawing.
+\brief Polygons with at most this many vertices keep their scanline
+intersections on the stack when no cache is given.
+*/
+#define GFX_POLY_STACK_INTS 64
+
+/*!
+\brief Internal helper returning the temporary array for the scanline
+intersections of a polygon with n vertices.
+
+Without a cache, small polygons use stackInts and larger ones get an array of
+their own, which _gfxPrimitivesPolyIntsFree() releases. There is no global
+array, so polygons can be drawn on several threads at once with or without a
+cache.
 
-\param a The surface to draw on.
-\param b Vertex array containing X coordinates of the points of the polygon.
+\param n Number of points of the polygon.
+\param stackInts Array of GFX_POLY_STACK_INTS ints on the caller's stack.
+\param polyInts Preallocated, temporary vertex array, or NULL.
+\param polyAllocated Flag indicating if temporary vertex array was allocated,
+or NULL.
 
-\returns Returns 0 if a==b, a negative number if a<b or a positive number if
-a>b.
+\returns Returns the array, or NULL if it can't be allocated.
 */
-int
-_gfxPrimitivesCompareInt(const void *a, const void *b)
+static int *
+_gfxPrimitivesPolyInts(int n, int *stackInts, int **polyInts,
+                       int *polyAllocated)
 {
-    return (*(const int *)a) - (*(const int *)b);
+    int *ints;
+
+    if ((polyInts == NULL) || (polyAllocated == NULL)) {
+        if (n <= GFX_POLY_STACK_INTS) {
+            return stackInts;
+        }
+        return (int *)malloc(sizeof(int) * n);
+    }
+
+    /*
+     * Use local cache, only grow array
+     */
+    if (*polyAllocated < n) {
+        ints = (int *)realloc(*polyAllocated ? *polyInts : NULL,
+                              sizeof(int) * n);
+        if (ints == NULL) {
+            return NULL;
+        }
+        *polyInts = ints;
+        *polyAllocated = n;
+    }
+    return *polyInts;
 }
 
 /*!
-\brief Global vertex array to use if optional parameters are not given in
-filledPolygonMT calls.
-
-Note: Used for non-multithreaded (default) operation of filledPolygonMT.
+\brief Internal helper releasing an array from _gfxPrimitivesPolyInts().
 */
-static int *gfxPrimitivesPolyIntsGlobal = NULL;
+static void
+_gfxPrimitivesPolyIntsFree(int *ints, int *stackInts, int **polyInts,
+                           int *polyAllocated)
+{
+    if (((polyInts == NULL) || (polyAllocated == NULL)) &&
+        (ints != stackInts)) {
+        free(ints);
+    }
+}
 
 /*!
-\brief Flag indicating if global vertex array was already allocated.
+\brief Internal helper finding where scanline y crosses the edges of a
+polygon.
+
+\param vx Vertex array containing X coordinates of the points of the polygon.
+\param vy Vertex array containing Y coordinates of the points of the polygon.
+\param n Number of points in the vertex array.
+\param y The scanline.
+\param maxy The largest Y coordinate of the polygon.
+\param ints Array of at least n ints receiving the 16.16 X coordinates.
 
-Note: Used for non-multithreaded (default) operation of filledPolygonMT.
+\returns Returns the number of crossings, which are sorted.
 */
-static int gfxPrimitivesPolyAllocatedGlobal = 0;
+static int
+_gfxPrimitivesPolyScanline(const Sint16 *vx, const Sint16 *vy, int n, int y,
+                           int maxy, int *ints)
+{
+    int i, j, v;
+    int x1, y1;
+    int x2, y2;
+    int ind1, ind2;
+    int count = 0;
+
+    for (i = 0; (i < n); i++) {
+        if (!i) {
+            ind1 = n - 1;
+            ind2 = 0;
+        }
+        else {
+            ind1 = i - 1;
+            ind2 = i;
+        }
+        y1 = vy[ind1];
+        y2 = vy[ind2];
+        if (y1 < y2) {
+            x1 = vx[ind1];
+            x2 = vx[ind2];
+        }
+        else if (y1 > y2) {
+            y2 = vy[ind1];
+            y1 = vy[ind2];
+            x2 = vx[ind1];
+            x1 = vx[ind2];
+        }
+        else {
+            continue;
+        }
+        if (((y >= y1) && (y < y2)) ||
+            ((y == maxy) && (y > y1) && (y <= y2))) {
+            ints[count++] =
+                ((65536 * (y - y1)) / (y2 - y1)) * (x2 - x1) + (65536 * x1);
+        }
+    }
+
+    /*
+     * Insertion sort, a scanline crosses only a few edges
+     */
+    for (i = 1; i < count; i++) {
+        v = ints[i];
+        for (j = i; (j > 0) && (ints[j - 1] > v); j--) {
+            ints[j] = ints[j - 1];
+        }
+        ints[j] = v;
+    }
+    return count;
+}
 
 /*!
 \brief Draw filled polygon with alpha blending (multi-threaded capable).
 
-Note: The last two parameters are optional; but are required for multithreaded
-operation.
+Note: The last two parameters are optional; they let repeated calls reuse one
+temp array.
 
 \param dst The surface to draw on.
 \param vx Vertex array containing X coordinates of the points of the filled
@@ -5419,15 +5542,13 @@ filledPolygonColorMT(SDL_Surface *dst, const Sint16 *vx, const Sint16 *vy,
 {
     int result;
     int i;
-    int y, xa, xb;
-    int miny, maxy;
-    int x1, y1;
-    int x2, y2;
-    int ind1, ind2;
-    int ints;
+    int y, xa, xb, xtmp;
+    int miny, maxy, ystart, yend;
+    int left, right;
+    int ints, opaque;
+    int stackInts[GFX_POLY_STACK_INTS];
     int *gfxPrimitivesPolyInts = NULL;
-    int *gfxPrimitivesPolyIntsNew = NULL;
-    int gfxPrimitivesPolyAllocated = 0;
+    Uint32 mapped = 0;
 
     /*
      * Check visibility of clipping rectangle
@@ -5454,142 +5575,95 @@ filledPolygonColorMT(SDL_Surface *dst, const Sint16 *vx, const Sint16 *vy,
     }
 
     /*
-     * Map polygon cache
-     */
-    if ((polyInts == NULL) || (polyAllocated == NULL)) {
-        /* Use global cache */
-        gfxPrimitivesPolyInts = gfxPrimitivesPolyIntsGlobal;
-        gfxPrimitivesPolyAllocated = gfxPrimitivesPolyAllocatedGlobal;
-    }
-    else {
-        /* Use local cache */
-        gfxPrimitivesPolyInts = *polyInts;
-        gfxPrimitivesPolyAllocated = *polyAllocated;
-    }
-
-    /*
-     * Allocate temp array, only grow array
+     * Determine Y maxima
      */
-    if (!gfxPrimitivesPolyAllocated) {
-        gfxPrimitivesPolyInts = (int *)malloc(sizeof(int) * n);
-        gfxPrimitivesPolyAllocated = n;
-    }
-    else {
-        if (gfxPrimitivesPolyAllocated < n) {
-            gfxPrimitivesPolyIntsNew =
-                (int *)realloc(gfxPrimitivesPolyInts, sizeof(int) * n);
-            if (!gfxPrimitivesPolyIntsNew) {
-                if (!gfxPrimitivesPolyInts) {
-                    free(gfxPrimitivesPolyInts);
-                    gfxPrimitivesPolyInts = NULL;
-                }
-                gfxPrimitivesPolyAllocated = 0;
-            }
-            else {
-                gfxPrimitivesPolyInts = gfxPrimitivesPolyIntsNew;
-                gfxPrimitivesPolyAllocated = n;
-            }
+    miny = vy[0];
+    maxy = vy[0];
+    for (i = 1; (i < n); i++) {
+        if (vy[i] < miny) {
+            miny = vy[i];
+        }
+        else if (vy[i] > maxy) {
+            maxy = vy[i];
         }
     }
 
     /*
-     * Check temp array
-     */
-    if (gfxPrimitivesPolyInts == NULL) {
-        gfxPrimitivesPolyAllocated = 0;
-    }
-
-    /*
-     * Update cache variables
+     * Only the scanlines inside the clipping rectangle draw anything
      */
-    if ((polyInts == NULL) || (polyAllocated == NULL)) {
-        gfxPrimitivesPolyIntsGlobal = gfxPrimitivesPolyInts;
-        gfxPrimitivesPolyAllocatedGlobal = gfxPrimitivesPolyAllocated;
-    }
-    else {
-        *polyInts = gfxPrimitivesPolyInts;
-        *polyAllocated = gfxPrimitivesPolyAllocated;
+    ystart = SDL_max(miny, clip_ymin(dst));
+    yend = SDL_min(maxy, clip_ymax(dst));
+    if (ystart > yend) {
+        return (0);
     }
 
-    /*
-     * Check temp array again
-     */
+    gfxPrimitivesPolyInts =
+        _gfxPrimitivesPolyInts(n, stackInts, polyInts, polyAllocated);
     if (gfxPrimitivesPolyInts == NULL) {
         return (-1);
     }
 
     /*
-     * Determine Y maxima
+     * Opaque spans are written straight into the surface, which is locked
+     * once for all of them
      */
-    miny = vy[0];
-    maxy = vy[0];
-    for (i = 1; (i < n); i++) {
-        if (vy[i] < miny) {
-            miny = vy[i];
-        }
-        else if (vy[i] > maxy) {
-            maxy = vy[i];
+    opaque = ((color & 255) == 255);
+    if (opaque) {
+        mapped = _gfxPrimitivesMapColor(dst, color);
+        if (SDL_MUSTLOCK(dst)) {
+            if (SDL_LockSurface(dst) < 0) {
+                _gfxPrimitivesPolyIntsFree(gfxPrimitivesPolyInts, stackInts,
+                                           polyInts, polyAllocated);
+                return (-1);
+            }
         }
     }
+    left = clip_xmin(dst);
+    right = clip_xmax(dst);
 
     /*
      * Draw, scanning y
      */
     result = 0;
-    for (y = miny; (y <= maxy); y++) {
-        ints = 0;
-        for (i = 0; (i < n); i++) {
-            if (!i) {
-                ind1 = n - 1;
-                ind2 = 0;
-            }
-            else {
-                ind1 = i - 1;
-                ind2 = i;
-            }
-            y1 = vy[ind1];
-            y2 = vy[ind2];
-            if (y1 < y2) {
-                x1 = vx[ind1];
-                x2 = vx[ind2];
-            }
-            else if (y1 > y2) {
-                y2 = vy[ind1];
-                y1 = vy[ind2];
-                x2 = vx[ind1];
-                x1 = vx[ind2];
-            }
-            else {
-                continue;
-            }
-            if (((y >= y1) && (y < y2)) ||
-                ((y == maxy) && (y > y1) && (y <= y2))) {
-                gfxPrimitivesPolyInts[ints++] =
-                    ((65536 * (y - y1)) / (y2 - y1)) * (x2 - x1) +
-                    (65536 * x1);
-            }
-        }
-
-        qsort(gfxPrimitivesPolyInts, ints, sizeof(int),
-              _gfxPrimitivesCompareInt);
-
-        for (i = 0; (i < ints); i += 2) {
+    for (y = ystart; (y <= yend); y++) {
+        ints = _gfxPrimitivesPolyScanline(vx, vy, n, y, maxy,
+                                          gfxPrimitivesPolyInts);
+        for (i = 0; (i + 1 < ints); i += 2) {
             xa = gfxPrimitivesPolyInts[i] + 1;
             xa = (xa >> 16) + ((xa & 32768) >> 15);
             xb = gfxPrimitivesPolyInts[i + 1] - 1;
             xb = (xb >> 16) + ((xb & 32768) >> 15);
-            result |= hlineColor(dst, xa, xb, y, color);
+            if (!opaque) {
+                result |= hlineColor(dst, xa, xb, y, color);
+                continue;
+            }
+            if (xa > xb) {
+                xtmp = xa;
+                xa = xb;
+                xb = xtmp;
+            }
+            xa = SDL_max(xa, left);
+            xb = SDL_min(xb, right);
+            if (xa <= xb) {
+                _HLineMappedNolock(dst, xa, xb, y, mapped);
+            }
         }
     }
 
+    if (opaque && SDL_MUSTLOCK(dst)) {
+        SDL_UnlockSurface(dst);
+    }
+    _gfxPrimitivesPolyIntsFree(gfxPrimitivesPolyInts, stackInts, polyInts,
+                               polyAllocated);
+
     return (result);
 }
 
 /*!
 \brief Draw filled polygon with alpha blending (multi-threaded capable).
 
-Note: The last two parameters are optional; but are required for multithreaded
-operation.
+Note: The last two parameters are optional; they let repeated calls reuse one
+temp array.
 
 \param dst The surface to draw on.
 \param vx Vertex array containing X coordinates of the points of the filled
@@ -5623,7 +5697,7 @@ filledPolygonRGBAMT(SDL_Surface *dst, const Sint16 *vx, const Sint16 *vy,
 \brief Draw filled polygon with alpha blending.
 
 Note: Standard filledPolygon function is calling multithreaded version with
-NULL parameters to use the global vertex cache.
+NULL parameters, which uses a temp array for this call only.
 
 \param dst The surface to draw on.
 \param vx Vertex array containing X coordinates of the points of the filled
@@ -5801,6 +5875,80 @@ _HLineTextured(SDL_Surface *dst, Sint16 x1, Sint16 x2, Sint16 y,
     return result;
 }
 
+/*!
+\brief Internal helper checking whether blitting texture onto dst only copies
+the pixels, which is the case for 32 bit surfaces of the same format without
+any blending, color key or modulation.
+
+\param dst The surface to draw on.
+\param texture The texture surface to retrieve color information from.
+
+\returns Returns 1 if the pixels can be copied, 0 otherwise.
+*/
+static int
+_texturedCopyOnly(SDL_Surface *dst, SDL_Surface *texture)
+{
+    SDL_BlendMode mode = SDL_BLENDMODE_BLEND;
+    Uint8 r = 0, g = 0, b = 0, a = 0;
+
+    if ((GFX_SURF_BytesPerPixel(dst) != 4) ||
+        (dst->format->format != texture->format->format)) {
+        return 0;
+    }
+    SDL_GetSurfaceBlendMode(texture, &mode);
+    SDL_GetSurfaceColorMod(texture, &r, &g, &b);
+    SDL_GetSurfaceAlphaMod(texture, &a);
+    return (mode == SDL_BLENDMODE_NONE) && !SDL_HasColorKey(texture) &&
+           ((r & g & b & a) == 255);
+}
+
+/*!
+\brief Internal function to draw a textured horizontal line by copying whole
+runs of texture pixels, see _texturedCopyOnly(). Does no locking or clipping.
+
+\param dst The surface to draw on.
+\param x1 X coordinate of the first point (i.e. left) of the line.
+\param x2 X coordinate of the second point (i.e. right) of the line.
+\param y Y coordinate of the points of the line.
+\param texture The texture surface to retrieve color information from.
+\param texture_dx The X offset for the texture lookup.
+\param texture_dy The Y offset for the textured lookup.
+*/
+static void
+_HLineTexturedCopyNolock(SDL_Surface *dst, int x1, int x2, int y,
+                         SDL_Surface *texture, int texture_dx, int texture_dy)
+{
+    Uint8 *pixel = (Uint8 *)dst->pixels + y * dst->pitch + 4 * x1;
+    const Uint8 *texture_row;
+    int texture_x_walker, texture_y_start, w;
+
+    /*
+     * Determine where in the texture we start drawing, the same way as
+     * _HLineTextured
+     */
+    texture_x_walker = (x1 - texture_dx) % texture->w;
+    if (texture_x_walker < 0) {
+        texture_x_walker = texture->w + texture_x_walker;
+    }
+    texture_y_start = (y + texture_dy) % texture->h;
+    if (texture_y_start < 0) {
+        texture_y_start = texture->h + texture_y_start;
+    }
+    texture_row =
+        (const Uint8 *)texture->pixels + texture_y_start * texture->pitch;
+
+    /*
+     * Copy up to the end of the texture row, then wrap around
+     */
+    while (x1 <= x2) {
+        w = SDL_min(x2 - x1 + 1, texture->w - texture_x_walker);
+        memcpy(pixel, texture_row + 4 * texture_x_walker, 4 * (size_t)w);
+        pixel += 4 * w;
+        x1 += w;
+        texture_x_walker = 0;
+    }
+}
+
 /*!
 \brief Draws a polygon filled with the given texture (Multi-Threading Capable).
 
@@ -5810,8 +5958,10 @@ It supports alpha drawing.
 To get the best performance of this operation you need to make sure the texture
 and the dst surface have the same format (see
 http://docs.mandragor.org/files/Common_libs_documentation/SDL/SDL_Documentation_project_en/sdlblitsurface.html).
-The last two parameters are optional, but required for multithreaded operation.
-When set to NULL, uses global static temp array.
+32 bit textures of the same format without blending are copied straight into
+the destination, without blits.
+The last two parameters are optional. When set to NULL, a temp array on the
+stack or allocated for the call is used.
 
 \param dst the destination surface,
 \param vx array of x vector components
@@ -5834,14 +5984,12 @@ texturedPolygonMT(SDL_Surface *dst, const Sint16 *vx, const Sint16 *vy, int n,
 {
     int result;
     int i;
-    int y, xa, xb;
-    int minx, maxx, miny, maxy;
-    int x1, y1;
-    int x2, y2;
-    int ind1, ind2;
-    int ints;
+    int y, xa, xb, xtmp;
+    int minx, maxx, miny, maxy, ystart, yend;
+    int left, right;
+    int ints, copy;
+    int stackInts[GFX_POLY_STACK_INTS];
     int *gfxPrimitivesPolyInts = NULL;
-    int gfxPrimitivesPolyAllocated = 0;
 
     /*
      * Check visibility of clipping rectangle
@@ -5857,61 +6005,6 @@ texturedPolygonMT(SDL_Surface *dst, const Sint16 *vx, const Sint16 *vy, int n,
         return -1;
     }
 
-    /*
-     * Map polygon cache
-     */
-    if ((polyInts == NULL) || (polyAllocated == NULL)) {
-        /* Use global cache */
-        gfxPrimitivesPolyInts = gfxPrimitivesPolyIntsGlobal;
-        gfxPrimitivesPolyAllocated = gfxPrimitivesPolyAllocatedGlobal;
-    }
-    else {
-        /* Use local cache */
-        gfxPrimitivesPolyInts = *polyInts;
-        gfxPrimitivesPolyAllocated = *polyAllocated;
-    }
-
-    /*
-     * Allocate temp array, only grow array
-     */
-    if (!gfxPrimitivesPolyAllocated) {
-        gfxPrimitivesPolyInts = (int *)malloc(sizeof(int) * n);
-        gfxPrimitivesPolyAllocated = n;
-    }
-    else {
-        if (gfxPrimitivesPolyAllocated < n) {
-            gfxPrimitivesPolyInts =
-                (int *)realloc(gfxPrimitivesPolyInts, sizeof(int) * n);
-            gfxPrimitivesPolyAllocated = n;
-        }
-    }
-
-    /*
-     * Check temp array
-     */
-    if (gfxPrimitivesPolyInts == NULL) {
-        gfxPrimitivesPolyAllocated = 0;
-    }
-
-    /*
-     * Update cache variables
-     */
-    if ((polyInts == NULL) || (polyAllocated == NULL)) {
-        gfxPrimitivesPolyIntsGlobal = gfxPrimitivesPolyInts;
-        gfxPrimitivesPolyAllocatedGlobal = gfxPrimitivesPolyAllocated;
-    }
-    else {
-        *polyInts = gfxPrimitivesPolyInts;
-        *polyAllocated = gfxPrimitivesPolyAllocated;
-    }
-
-    /*
-     * Check temp array again
-     */
-    if (gfxPrimitivesPolyInts == NULL) {
-        return (-1);
-    }
-
     /*
      * Determine X,Y minima,maxima
      */
@@ -5940,56 +6033,79 @@ texturedPolygonMT(SDL_Surface *dst, const Sint16 *vx, const Sint16 *vy, int n,
         return -1;
     }
 
+    /*
+     * Only the scanlines inside the clipping rectangle draw anything
+     */
+    ystart = SDL_max(miny, clip_ymin(dst));
+    yend = SDL_min(maxy, clip_ymax(dst));
+    if (ystart > yend) {
+        return (0);
+    }
+
+    gfxPrimitivesPolyInts =
+        _gfxPrimitivesPolyInts(n, stackInts, polyInts, polyAllocated);
+    if (gfxPrimitivesPolyInts == NULL) {
+        return (-1);
+    }
+
+    /*
+     * When the blits would only copy pixels, the spans are copied straight
+     * from the texture with both surfaces locked once for all of them
+     */
+    copy = _texturedCopyOnly(dst, texture);
+    if (copy && SDL_MUSTLOCK(dst) && (SDL_LockSurface(dst) < 0)) {
+        copy = 0;
+    }
+    if (copy && SDL_MUSTLOCK(texture) && (SDL_LockSurface(texture) < 0)) {
+        if (SDL_MUSTLOCK(dst)) {
+            SDL_UnlockSurface(dst);
+        }
+        copy = 0;
+    }
+    left = clip_xmin(dst);
+    right = clip_xmax(dst);
+
     /*
      * Draw, scanning y
      */
     result = 0;
-    for (y = miny; (y <= maxy); y++) {
-        ints = 0;
-        for (i = 0; (i < n); i++) {
-            if (!i) {
-                ind1 = n - 1;
-                ind2 = 0;
-            }
-            else {
-                ind1 = i - 1;
-                ind2 = i;
-            }
-            y1 = vy[ind1];
-            y2 = vy[ind2];
-            if (y1 < y2) {
-                x1 = vx[ind1];
-                x2 = vx[ind2];
-            }
-            else if (y1 > y2) {
-                y2 = vy[ind1];
-                y1 = vy[ind2];
-                x2 = vx[ind1];
-                x1 = vx[ind2];
-            }
-            else {
+    for (y = ystart; (y <= yend); y++) {
+        ints = _gfxPrimitivesPolyScanline(vx, vy, n, y, maxy,
+                                          gfxPrimitivesPolyInts);
+        for (i = 0; (i + 1 < ints); i += 2) {
+            xa = gfxPrimitivesPolyInts[i] + 1;
+            xa = (xa >> 16) + ((xa & 32768) >> 15);
+            xb = gfxPrimitivesPolyInts[i + 1] - 1;
+            xb = (xb >> 16) + ((xb & 32768) >> 15);
+            if (!copy) {
+                result |= _HLineTextured(dst, xa, xb, y, texture, texture_dx,
+                                         texture_dy);
                 continue;
             }
-            if (((y >= y1) && (y < y2)) ||
-                ((y == maxy) && (y > y1) && (y <= y2))) {
-                gfxPrimitivesPolyInts[ints++] =
-                    ((65536 * (y - y1)) / (y2 - y1)) * (x2 - x1) +
-                    (65536 * x1);
+            if (xa > xb) {
+                xtmp = xa;
+                xa = xb;
+                xb = xtmp;
+            }
+            xa = SDL_max(xa, left);
+            xb = SDL_min(xb, right);
+            if (xa <= xb) {
+                _HLineTexturedCopyNolock(dst, xa, xb, y, texture, texture_dx,
+                                         texture_dy);
             }
         }
+    }
 
-        qsort(gfxPrimitivesPolyInts, ints, sizeof(int),
-              _gfxPrimitivesCompareInt);
-
-        for (i = 0; (i < ints); i += 2) {
-            xa = gfxPrimitivesPolyInts[i] + 1;
-            xa = (xa >> 16) + ((xa & 32768) >> 15);
-            xb = gfxPrimitivesPolyInts[i + 1] - 1;
-            xb = (xb >> 16) + ((xb & 32768) >> 15);
-            result |= _HLineTextured(dst, xa, xb, y, texture, texture_dx,
-                                     texture_dy);
+    if (copy) {
+        if (SDL_MUSTLOCK(texture)) {
+            SDL_UnlockSurface(texture);
+        }
+        if (SDL_MUSTLOCK(dst)) {
+            SDL_UnlockSurface(dst);
         }
     }
+    _gfxPrimitivesPolyIntsFree(gfxPrimitivesPolyInts, stackInts, polyInts,
+                               polyAllocated);
 
     return (result);
 }
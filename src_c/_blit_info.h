@@ -4,7 +4,7 @@
 #include "_surface.h"
 
 /* The structure passed to the low level blit functions */
-typedef struct {
+typedef struct pg_BlitInfo {
     int width;
     int height;
     Uint8 *s_pixels;
@@ -16,9 +16,23 @@ typedef struct {
     SDL_PixelFormat *src;
     SDL_PixelFormat *dst;
     Uint8 src_blanket_alpha;
+    /* The color modulation of the source: its red, green and blue are
+     * multiplied by src_tint[0], [1] and [2] / 255. The alpha blend kernels
+     * apply it when src_has_tint is set, the others ignore it. */
+    Uint8 src_tint[3];
+    int src_has_tint;
     int src_has_colorkey;
     Uint32 src_colorkey;
     SDL_BlendMode src_blend;
     SDL_BlendMode dst_blend;
+    Uint32 blend_custom; /* PYGAME_BLEND_CUSTOM flags, or 0 */
+    /* For alphablit_spans(): the source spans, the source position of the
+     * first pixel, how opaque runs are copied, whether only the zero runs
+     * are skipped and the kernel for the rest */
+    const struct pg_AlphaSpans *src_spans;
+    int span_x, span_y;
+    int span_copy;
+    int span_zero;
+    void (*span_blitter)(struct pg_BlitInfo *info);
 } SDL_BlitInfo;
 #endif  // BLIT_INFO_H
@@ -37,6 +37,8 @@
 #include "camera.h"
 #include "pgcompat.h"
 
+#include "simd_camera.h"
+
 /*
 #if defined(__unix__) || !defined(__APPLE__)
 #else
@@ -51,7 +53,11 @@ surf_colorspace(PyObject *self, PyObject *arg);
 PyObject *
 list_cameras(PyObject *self, PyObject *arg);
 PyObject *
-camera_start(pgCameraObject *self, PyObject *args);
+set_conversion_threads(PyObject *self, PyObject *arg);
+PyObject *
+get_conversion_threads(PyObject *self, PyObject *arg);
+PyObject *
+camera_start(pgCameraObject *self, PyObject *args, PyObject *kwargs);
 PyObject *
 camera_stop(pgCameraObject *self, PyObject *args);
 PyObject *
@@ -66,6 +72,12 @@ PyObject *
 camera_get_image(pgCameraObject *self, PyObject *arg);
 PyObject *
 camera_get_raw(pgCameraObject *self, PyObject *args);
+PyObject *
+camera_get_raw_view(pgCameraObject *self, PyObject *args);
+PyObject *
+camera_get_image_view(pgCameraObject *self, PyObject *args);
+PyObject *
+camera_get_frame_time(pgCameraObject *self, PyObject *args);
 
 /*
  * Functions available to pygame-ce users.  The idea is to make these as simple
@@ -204,8 +216,14 @@ error:
 
 /* start() - opens, inits, and starts capturing on the camera */
 PyObject *
-camera_start(pgCameraObject *self, PyObject *_null)
+camera_start(pgCameraObject *self, PyObject *args, PyObject *kwargs)
 {
+    int threaded = 0;
+    char *kwids[] = {"threaded", NULL};
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "|p", kwids, &threaded))
+        return NULL;
+
 #if defined(__unix__)
     if (v4l2_open_device(self) == 0) {
         v4l2_close_device(self);
@@ -221,6 +239,10 @@ camera_start(pgCameraObject *self, PyObject *_null)
             v4l2_close_device(self);
             return NULL;
         }
+        if (threaded && v4l2_start_thread(self) == 0) {
+            v4l2_close_device(self);
+            return NULL;
+        }
     }
 #elif defined(PYGAME_WINDOWS_CAMERA)
     if (self->open) { /* camera already started */
@@ -240,6 +262,14 @@ PyObject *
 camera_stop(pgCameraObject *self, PyObject *_null)
 {
 #if defined(__unix__)
+    if (self->exports > 0) {
+        return RAISE(PyExc_BufferError,
+                     "cannot stop the camera while a view of its frame "
+                     "is in use");
+    }
+    Py_BEGIN_ALLOW_THREADS;
+    v4l2_stop_thread(self);
+    Py_END_ALLOW_THREADS;
     if (v4l2_stop_capturing(self) == 0)
         return NULL;
     if (v4l2_uninit_device(self) == 0)
@@ -394,7 +424,10 @@ camera_get_image(pgCameraObject *self, PyObject *arg)
     }
 
     Py_BEGIN_ALLOW_THREADS;
-    ret = v4l2_read_frame(self, surf, &errno_code);
+    if (self->thread)
+        ret = v4l2_read_latest(self, surf, &errno_code);
+    else
+        ret = v4l2_read_frame(self, surf, &errno_code);
     Py_END_ALLOW_THREADS;
     if (!ret) {
         /* error occurred */
@@ -466,10 +499,336 @@ camera_get_raw(pgCameraObject *self, PyObject *_null)
     Py_RETURN_NONE;
 }
 
+#if defined(__unix__)
+/* dequeues a frame into self->held, raising on failure */
+static int
+_camera_hold_frame(pgCameraObject *self)
+{
+    int ret, errno_code = 0;
+
+    if (self->fd == -1) {
+        PyErr_SetString(PyExc_SystemError, "the camera is not started");
+        return 0;
+    }
+    if (self->thread) {
+        PyErr_SetString(PyExc_ValueError,
+                        "frame views are not available with the capture "
+                        "thread");
+        return 0;
+    }
+
+    Py_BEGIN_ALLOW_THREADS;
+    ret = v4l2_hold_frame(self, &errno_code);
+    Py_END_ALLOW_THREADS;
+    if (!ret) {
+        PyErr_Format(PyExc_SystemError, "ioctl(VIDIOC_DQBUF) failure : %d, %s",
+                     errno_code, strerror(errno_code));
+        return 0;
+    }
+    return 1;
+}
+#endif
+
+/* get_raw_view() - returns a memoryview of the driver's frame buffer */
+PyObject *
+camera_get_raw_view(pgCameraObject *self, PyObject *_null)
+{
+#if defined(__unix__)
+    if (!_camera_hold_frame(self))
+        return NULL;
+    return PyMemoryView_FromObject((PyObject *)self);
+#else
+    return RAISE(PyExc_NotImplementedError,
+                 "get_raw_view() is only supported with v4l2 cameras");
+#endif
+}
+
+/* get_image_view() - returns a Surface using the driver's frame buffer */
+PyObject *
+camera_get_image_view(pgCameraObject *self, PyObject *_null)
+{
+#if defined(__unix__)
+    SDL_Surface *surf;
+    pgSurfaceObject *surfobj;
+    PyObject *view;
+    Uint32 format;
+    int pitch, bpp;
+
+    /* only the packed RGB formats match a Surface as they are */
+    switch (self->pixelformat) {
+        case V4L2_PIX_FMT_RGB24:
+            format = SDL_PIXELFORMAT_RGB24;
+            bpp = 3;
+            break;
+#if SDL_BYTEORDER == SDL_LIL_ENDIAN
+        case V4L2_PIX_FMT_RGB444:
+            format = SDL_PIXELFORMAT_RGB444;
+            bpp = 2;
+            break;
+#endif
+        default:
+            return RAISE(PyExc_ValueError,
+                         "the camera's pixel format has no matching Surface "
+                         "format, use get_image() instead");
+    }
+    if (self->color_out != RGB_OUT) {
+        return RAISE(PyExc_ValueError,
+                     "get_image_view() needs a camera using the RGB format");
+    }
+
+    if (!_camera_hold_frame(self))
+        return NULL;
+
+    pitch = self->pitch;
+    if (pitch < self->width * bpp)
+        pitch = self->width * bpp;
+    if ((size_t)pitch * self->height > self->held_bytes) {
+        return RAISE(PyExc_ValueError,
+                     "the frame is smaller than the camera's image size");
+    }
+
+    view = PyMemoryView_FromObject((PyObject *)self);
+    if (!view)
+        return NULL;
+
+    surf = PG_CreateSurfaceFrom(self->buffers[self->held].start, self->width,
+                                self->height, pitch, format);
+    if (!surf) {
+        Py_DECREF(view);
+        return RAISE(pgExc_SDLError, SDL_GetError());
+    }
+    surfobj = (pgSurfaceObject *)pgSurface_New(surf);
+    if (!surfobj) {
+        Py_DECREF(view);
+        return NULL;
+    }
+    /* keeps the mapping alive, stop() refuses to unmap it meanwhile */
+    surfobj->dependency = view;
+    return (PyObject *)surfobj;
+#else
+    return RAISE(PyExc_NotImplementedError,
+                 "get_image_view() is only supported with v4l2 cameras");
+#endif
+}
+
+/* get_frame_time() - returns when the frame of get_image() was captured */
+PyObject *
+camera_get_frame_time(pgCameraObject *self, PyObject *_null)
+{
+#if defined(__unix__)
+    return PyLong_FromUnsignedLongLong(self->ticks);
+#else
+    return RAISE(PyExc_NotImplementedError,
+                 "get_frame_time() is only supported with v4l2 cameras");
+#endif
+}
+
 /*
  * Pixelformat conversion functions
  */
 
+/* Large images are split into bands of pixels that are converted in
+ * parallel, by up to convert_threads threads including the calling one. */
+#define CONVERT_MAX_THREADS 64
+#define CONVERT_THREAD_MIN_PIXELS (1 << 16)
+#define CONVERT_BAND_ALIGN 16
+
+static int convert_threads = 1;
+
+typedef struct pgConvertBand pgConvertBand;
+typedef void (*CONVERT_BAND_P)(pgConvertBand *band);
+
+struct pgConvertBand {
+    CONVERT_BAND_P func;
+    const Uint8 *src;
+    Uint8 *dst;
+    int first; /* the first pixel of the band */
+    int count; /* the number of pixels in the band */
+    int width;
+    int height;
+    unsigned long source;
+    SDL_PixelFormat *format;
+};
+
+static void
+_convert_band(void *data, int i)
+{
+    pgConvertBand *band = (pgConvertBand *)data + i;
+    band->func(band);
+}
+
+/* Runs func over the width * height pixels of an image, split into bands
+ * that are a multiple of align pixels long. Each band gets the whole src and
+ * dst and finds its part by the pixel index. Every pixel is converted the
+ * same way as without threads. Safe to be called without the GIL. */
+static void
+_convert_run(CONVERT_BAND_P func, const void *src, void *dst, int width,
+             int height, int align, unsigned long source,
+             SDL_PixelFormat *format)
+{
+    pgConvertBand bands[CONVERT_MAX_THREADS];
+    int length = width * height;
+    int nbands = MIN(convert_threads, length / align);
+    int i, start, end;
+
+    if (nbands < 2 || length < CONVERT_THREAD_MIN_PIXELS) {
+        nbands = 1;
+    }
+    for (i = 0; i < nbands; i++) {
+        start = (int)((Sint64)length * i / nbands / align * align);
+        end = i == nbands - 1
+                  ? length
+                  : (int)((Sint64)length * (i + 1) / nbands / align * align);
+        bands[i].func = func;
+        bands[i].src = (const Uint8 *)src;
+        bands[i].dst = (Uint8 *)dst;
+        bands[i].first = start;
+        bands[i].count = end - start;
+        bands[i].width = width;
+        bands[i].height = height;
+        bands[i].source = source;
+        bands[i].format = format;
+    }
+
+    pg_run_bands(_convert_band, bands, nbands);
+}
+
+/* Bytes per pixel of the V4L2 formats rgb_to_hsv and rgb_to_yuv read
+ * directly, 0 if the source is a Surface of the destination's format */
+static int
+_rgb_source_bpp(unsigned long source)
+{
+    switch (source) {
+        case V4L2_PIX_FMT_RGB444:
+            return 2;
+        case V4L2_PIX_FMT_RGB24:
+            return 3;
+        case V4L2_PIX_FMT_XBGR32:
+            return 4;
+    }
+    return 0;
+}
+
+/* Whether the row kernels of simd_camera.h can write the format, and the
+ * shifts to pass them. The 3 byte conversions always write b, g, r. */
+static int
+_row_kernel_format(SDL_PixelFormat *format, int *shifts)
+{
+    switch (PG_FORMAT_BytesPerPixel(format)) {
+        case 3:
+            shifts[0] = 16;
+            shifts[1] = 8;
+            shifts[2] = 0;
+            return 1;
+        case 4:
+            if (format->Rloss || format->Gloss || format->Bloss ||
+                format->Rshift % 8 || format->Gshift % 8 ||
+                format->Bshift % 8) {
+                return 0;
+            }
+            shifts[0] = format->Rshift;
+            shifts[1] = format->Gshift;
+            shifts[2] = format->Bshift;
+            return 1;
+    }
+    return 0;
+}
+
+void
+yuv422_row(const Uint8 *src, Uint8 *dst, int n, int yoff, const int *shifts,
+           int out_bpp)
+{
+    _pg_yuv422_row_finish(src, dst, 0, n, yoff, shifts, out_bpp);
+}
+
+void
+yuv420_row(const Uint8 *y, const Uint8 *u, const Uint8 *v, Uint8 *dst, int n,
+           const int *shifts, int out_bpp)
+{
+    _pg_yuv420_row_finish(y, u, v, dst, 0, n, shifts, out_bpp);
+}
+
+void
+hsv_row(const Uint8 *src, Uint8 *dst, int n, const int *shifts)
+{
+    _pg_hsv_row_finish(src, dst, 0, n, shifts);
+}
+
+static YUV422_ROW_P
+_get_yuv422_row(void)
+{
+#if !defined(__EMSCRIPTEN__)
+    if (_pg_camera_has_avx2()) {
+        return yuv422_row_avx2;
+    }
+#if PG_ENABLE_SSE_NEON
+    if (_pg_camera_HasSSE_NEON()) {
+        return yuv422_row_sse2;
+    }
+#endif /* PG_ENABLE_SSE_NEON */
+#endif /* !__EMSCRIPTEN__ */
+    return yuv422_row;
+}
+
+static YUV420_ROW_P
+_get_yuv420_row(void)
+{
+#if !defined(__EMSCRIPTEN__)
+    if (_pg_camera_has_avx2()) {
+        return yuv420_row_avx2;
+    }
+#if PG_ENABLE_SSE_NEON
+    if (_pg_camera_HasSSE_NEON()) {
+        return yuv420_row_sse2;
+    }
+#endif /* PG_ENABLE_SSE_NEON */
+#endif /* !__EMSCRIPTEN__ */
+    return yuv420_row;
+}
+
+static HSV_ROW_P
+_get_hsv_row(void)
+{
+#if !defined(__EMSCRIPTEN__)
+    if (_pg_camera_has_avx2()) {
+        return hsv_row_avx2;
+    }
+#if PG_ENABLE_SSE_NEON
+    if (_pg_camera_HasSSE_NEON()) {
+        return hsv_row_sse2;
+    }
+#endif /* PG_ENABLE_SSE_NEON */
+#endif /* !__EMSCRIPTEN__ */
+    return hsv_row;
+}
+
+/* set_conversion_threads() - sets the threads large conversions use */
+PyObject *
+set_conversion_threads(PyObject *self, PyObject *arg)
+{
+    long num_threads = PyLong_AsLong(arg);
+
+    if (num_threads == -1 && PyErr_Occurred()) {
+        return NULL;
+    }
+    if (num_threads < 0) {
+        return RAISE(PyExc_ValueError,
+                     "the number of conversion threads must not be negative");
+    }
+    if (num_threads == 0) {
+        num_threads = SDL_GetCPUCount();
+    }
+    convert_threads = (int)MIN(num_threads, CONVERT_MAX_THREADS);
+    Py_RETURN_NONE;
+}
+
+/* get_conversion_threads() - gets the threads large conversions use */
+PyObject *
+get_conversion_threads(PyObject *self, PyObject *_null)
+{
+    return PyLong_FromLong(convert_threads);
+}
+
 /* converts from rgb Surface to yuv or hsv */
 /* TODO: Allow for conversion from yuv and hsv to all */
 void
@@ -614,9 +973,9 @@ bgr32_to_rgb(const void *src, void *dst, int length, SDL_PixelFormat *format)
 }
 
 /* converts packed rgb to packed hsv. formulas modified from wikipedia */
-void
-rgb_to_hsv(const void *src, void *dst, int length, unsigned long source,
-           SDL_PixelFormat *format)
+static void
+_rgb_to_hsv(const void *src, void *dst, int length, unsigned long source,
+            SDL_PixelFormat *format)
 {
     Uint8 *s8, *d8;
     Uint16 *s16, *d16;
@@ -775,11 +1134,37 @@ rgb_to_hsv(const void *src, void *dst, int length, unsigned long source,
     }
 }
 
-/* convert packed rgb to yuv. Note that unlike many implementations of YUV,
-   this has a full range of 0-255 for Y, not 16-235. Formulas from wikipedia */
+static void
+_rgb_to_hsv_band(pgConvertBand *band)
+{
+    int bpp = PG_FORMAT_BytesPerPixel(band->format);
+    int srcbpp = _rgb_source_bpp(band->source);
+    const Uint8 *src =
+        band->src + (Sint64)band->first * (srcbpp ? srcbpp : bpp);
+    Uint8 *dst = band->dst + (Sint64)band->first * bpp;
+    int shifts[3];
+
+    if (!srcbpp && bpp == 4 && _row_kernel_format(band->format, shifts)) {
+        _get_hsv_row()(src, dst, band->count, shifts);
+    }
+    else {
+        _rgb_to_hsv(src, dst, band->count, band->source, band->format);
+    }
+}
+
 void
-rgb_to_yuv(const void *src, void *dst, int length, unsigned long source,
+rgb_to_hsv(const void *src, void *dst, int length, unsigned long source,
            SDL_PixelFormat *format)
+{
+    _convert_run(_rgb_to_hsv_band, src, dst, length, 1, CONVERT_BAND_ALIGN,
+                 source, format);
+}
+
+/* convert packed rgb to yuv. Note that unlike many implementations of YUV,
+   this has a full range of 0-255 for Y, not 16-235. Formulas from wikipedia */
+static void
+_rgb_to_yuv(const void *src, void *dst, int length, unsigned long source,
+            SDL_PixelFormat *format)
 {
     Uint8 *s8, *d8;
     Uint16 *s16, *d16;
@@ -914,6 +1299,25 @@ rgb_to_yuv(const void *src, void *dst, int length, unsigned long source,
     }
 }
 
+static void
+_rgb_to_yuv_band(pgConvertBand *band)
+{
+    int bpp = PG_FORMAT_BytesPerPixel(band->format);
+    int srcbpp = _rgb_source_bpp(band->source);
+
+    _rgb_to_yuv(band->src + (Sint64)band->first * (srcbpp ? srcbpp : bpp),
+                band->dst + (Sint64)band->first * bpp, band->count,
+                band->source, band->format);
+}
+
+void
+rgb_to_yuv(const void *src, void *dst, int length, unsigned long source,
+           SDL_PixelFormat *format)
+{
+    _convert_run(_rgb_to_yuv_band, src, dst, length, 1, CONVERT_BAND_ALIGN,
+                 source, format);
+}
+
 /* Converts from rgb444 (R444) to rgb24 (RGB3) */
 void
 rgb444_to_rgb(const void *src, void *dst, int length, SDL_PixelFormat *format)
@@ -979,8 +1383,8 @@ rgb444_to_rgb(const void *src, void *dst, int length, SDL_PixelFormat *format)
 /* convert from 4:2:2 YUYV interlaced to RGB */
 /* colorspace conversion routine from libv4l. Licensed LGPL 2.1
    (C) 2008 Hans de Goede <j.w.r.degoede@hhs.nl> */
-void
-yuyv_to_rgb(const void *src, void *dst, int length, SDL_PixelFormat *format)
+static void
+_yuyv_to_rgb(const void *src, void *dst, int length, SDL_PixelFormat *format)
 {
     Uint8 *s, *d8;
     Uint16 *d16;
@@ -1132,8 +1536,8 @@ yuyv_to_yuv(const void *src, void *dst, int length, SDL_PixelFormat *format)
 }
 
 /* cribbed from above, but modified for uyvy ordering */
-void
-uyvy_to_rgb(const void *src, void *dst, int length, SDL_PixelFormat *format)
+static void
+_uyvy_to_rgb(const void *src, void *dst, int length, SDL_PixelFormat *format)
 {
     Uint8 *s, *d8;
     Uint16 *d16;
@@ -1210,6 +1614,41 @@ uyvy_to_rgb(const void *src, void *dst, int length, SDL_PixelFormat *format)
         }
     }
 }
+
+/* shared by yuyv_to_rgb and uyvy_to_rgb */
+static void
+_yuv422_to_rgb_band(pgConvertBand *band)
+{
+    int bpp = PG_FORMAT_BytesPerPixel(band->format);
+    const Uint8 *src = band->src + (Sint64)band->first * 2;
+    Uint8 *dst = band->dst + (Sint64)band->first * bpp;
+    int shifts[3];
+
+    if (_row_kernel_format(band->format, shifts)) {
+        _get_yuv422_row()(src, dst, band->count & ~1,
+                          band->source == V4L2_PIX_FMT_UYVY, shifts, bpp);
+    }
+    else if (band->source == V4L2_PIX_FMT_UYVY) {
+        _uyvy_to_rgb(src, dst, band->count, band->format);
+    }
+    else {
+        _yuyv_to_rgb(src, dst, band->count, band->format);
+    }
+}
+
+void
+yuyv_to_rgb(const void *src, void *dst, int length, SDL_PixelFormat *format)
+{
+    _convert_run(_yuv422_to_rgb_band, src, dst, length, 1,
+                 CONVERT_BAND_ALIGN, V4L2_PIX_FMT_YUYV, format);
+}
+
+void
+uyvy_to_rgb(const void *src, void *dst, int length, SDL_PixelFormat *format)
+{
+    _convert_run(_yuv422_to_rgb_band, src, dst, length, 1,
+                 CONVERT_BAND_ALIGN, V4L2_PIX_FMT_UYVY, format);
+}
 /* turn uyvy into packed yuv. */
 void
 uyvy_to_yuv(const void *src, void *dst, int length, SDL_PixelFormat *format)
@@ -1310,17 +1749,18 @@ uyvy_to_yuv(const void *src, void *dst, int length, SDL_PixelFormat *format)
  * SUCH DAMAGE.
  */
 /* TODO: Certainly not the most efficient way of doing this conversion. */
-void
-sbggr8_to_rgb(const void *src, void *dst, int width, int height,
-              SDL_PixelFormat *format)
+/* converts count pixels starting at pixel first */
+static void
+_sbggr8_to_rgb(const void *src, void *dst, int width, int height, int first,
+               int count, SDL_PixelFormat *format)
 {
     Uint8 *rawpt, *d8;
     Uint16 *d16;
     Uint32 *d32;
     Uint8 r, g, b;
     int rshift, gshift, bshift, rloss, gloss, bloss;
-    int i = width * height;
-    rawpt = (Uint8 *)src;
+    int i = width * height - first;
+    rawpt = (Uint8 *)src + first;
     rshift = format->Rshift;
     gshift = format->Gshift;
     bshift = format->Bshift;
@@ -1328,11 +1768,12 @@ sbggr8_to_rgb(const void *src, void *dst, int width, int height,
     gloss = format->Gloss;
     bloss = format->Bloss;
 
-    d8 = (Uint8 *)dst;
-    d16 = (Uint16 *)dst;
-    d32 = (Uint32 *)dst;
+    d8 = (Uint8 *)dst + (Sint64)first * PG_FORMAT_BytesPerPixel(format);
+    d16 = (Uint16 *)dst + first;
+    d32 = (Uint32 *)dst + first;
 
-    while (i--) {
+    while (count--) {
+        i--;
         if ((i / width) % 2 == 0) {
             /* even row (BGBGBGBG)*/
             if ((i % 2) == 0) {
@@ -1427,15 +1868,30 @@ sbggr8_to_rgb(const void *src, void *dst, int width, int height,
     }
 }
 
+static void
+_sbggr8_to_rgb_band(pgConvertBand *band)
+{
+    _sbggr8_to_rgb(band->src, band->dst, band->width, band->height,
+                   band->first, band->count, band->format);
+}
+
+void
+sbggr8_to_rgb(const void *src, void *dst, int width, int height,
+              SDL_PixelFormat *format)
+{
+    _convert_run(_sbggr8_to_rgb_band, src, dst, width, height,
+                 CONVERT_BAND_ALIGN, V4L2_PIX_FMT_SBGGR8, format);
+}
+
 /* convert from YUV 4:2:0 (YU12) to RGB24 */
 /* based on v4lconvert_yuv420_to_rgb24 in libv4l (C) 2008 Hans de Goede. LGPL
  */
-void
-yuv420_to_rgb(const void *src, void *dst, int width, int height,
-              SDL_PixelFormat *format)
+static void
+_yuv420_to_rgb(const Uint8 *y1, const Uint8 *u, const Uint8 *v, void *dst,
+               int width, int pairs, SDL_PixelFormat *format)
 {
     int rshift, gshift, bshift, rloss, gloss, bloss, i, j, u1, v1, rg, y;
-    const Uint8 *y1, *y2, *u, *v;
+    const Uint8 *y2;
     Uint8 *d8_1, *d8_2;
     Uint16 *d16_1, *d16_2;
     Uint32 *d32_1, *d32_2;
@@ -1447,12 +1903,8 @@ yuv420_to_rgb(const void *src, void *dst, int width, int height,
     gloss = format->Gloss;
     bloss = format->Bloss;
 
-    /* see http://en.wikipedia.org/wiki/YUV for an explanation of YUV420 */
-    y1 = (Uint8 *)src;
     y2 = y1 + width;
-    u = y1 + width * height;
-    v = u + (width * height) / 4;
-    j = height / 2;
+    j = pairs;
     /* prepare the destination pointers for different surface depths. */
     d8_1 = (Uint8 *)dst;
     /* the following is because d8 used for both 8 and 24 bit surfaces */
@@ -1629,6 +2081,55 @@ yuv420_to_rgb(const void *src, void *dst, int width, int height,
     }
 }
 
+static void
+_yuv420_to_rgb_band(pgConvertBand *band)
+{
+    int bpp = PG_FORMAT_BytesPerPixel(band->format);
+    int width = band->width;
+    int pairs = band->count / (2 * width);
+    const Uint8 *y = band->src + band->first;
+    const Uint8 *u = band->src + (Sint64)width * band->height +
+                     (Sint64)band->first / (2 * width) * (width / 2);
+    const Uint8 *v = u + (Sint64)width * band->height / 4;
+    Uint8 *dst = band->dst + (Sint64)band->first * bpp;
+    YUV420_ROW_P row_func;
+    int shifts[3];
+
+    if (!_row_kernel_format(band->format, shifts)) {
+        _yuv420_to_rgb(y, u, v, dst, width, pairs, band->format);
+        return;
+    }
+    row_func = _get_yuv420_row();
+    while (pairs--) {
+        row_func(y, u, v, dst, width, shifts, bpp);
+        row_func(y + width, u, v, dst + width * bpp, width, shifts, bpp);
+        y += 2 * width;
+        u += width / 2;
+        v += width / 2;
+        dst += 2 * width * bpp;
+    }
+}
+
+void
+yuv420_to_rgb(const void *src, void *dst, int width, int height,
+              SDL_PixelFormat *format)
+{
+    /* see http://en.wikipedia.org/wiki/YUV for an explanation of YUV420 */
+    const Uint8 *y = (Uint8 *)src;
+    const Uint8 *u = y + width * height;
+
+    /* bands are whole pairs of rows, and the row kernels take pairs of
+     * pixels. Odd sizes are converted like before, as are 8 bit surfaces,
+     * where the second row of a pair starts 3 bytes after the first. */
+    if (width % 2 || height % 2 || PG_FORMAT_BytesPerPixel(format) == 1) {
+        _yuv420_to_rgb(y, u, u + (width * height) / 4, dst, width,
+                       height / 2, format);
+        return;
+    }
+    _convert_run(_yuv420_to_rgb_band, src, dst, width, height, 2 * width,
+                 V4L2_PIX_FMT_YUV420, format);
+}
+
 /* turn yuv420 into packed yuv. */
 void
 yuv420_to_yuv(const void *src, void *dst, int width, int height,
@@ -1761,7 +2262,8 @@ yuv420_to_yuv(const void *src, void *dst, int width, int height,
 
 /* Camera class definition */
 PyMethodDef cameraobj_builtins[] = {
-    {"start", (PyCFunction)camera_start, METH_NOARGS, DOC_CAMERA_CAMERA_START},
+    {"start", (PyCFunction)camera_start, METH_VARARGS | METH_KEYWORDS,
+     DOC_CAMERA_CAMERA_START},
     {"stop", (PyCFunction)camera_stop, METH_NOARGS, DOC_CAMERA_CAMERA_STOP},
     {"get_controls", (PyCFunction)camera_get_controls, METH_NOARGS,
      DOC_CAMERA_CAMERA_GETCONTROLS},
@@ -1775,8 +2277,44 @@ PyMethodDef cameraobj_builtins[] = {
      DOC_CAMERA_CAMERA_GETIMAGE},
     {"get_raw", (PyCFunction)camera_get_raw, METH_NOARGS,
      DOC_CAMERA_CAMERA_GETRAW},
+    {"get_raw_view", (PyCFunction)camera_get_raw_view, METH_NOARGS,
+     DOC_CAMERA_CAMERA_GETRAWVIEW},
+    {"get_image_view", (PyCFunction)camera_get_image_view, METH_NOARGS,
+     DOC_CAMERA_CAMERA_GETIMAGEVIEW},
+    {"get_frame_time", (PyCFunction)camera_get_frame_time, METH_NOARGS,
+     DOC_CAMERA_CAMERA_GETFRAMETIME},
     {NULL, NULL, 0, NULL}};
 
+#if defined(__unix__)
+/* the buffer interface exposes the frame held by get_raw_view() */
+static int
+camera_getbuffer(pgCameraObject *self, Py_buffer *view, int flags)
+{
+    if (self->held < 0) {
+        view->obj = NULL;
+        PyErr_SetString(PyExc_BufferError,
+                        "the camera holds no frame, call get_raw_view()");
+        return -1;
+    }
+    if (PyBuffer_FillInfo(view, (PyObject *)self,
+                          self->buffers[self->held].start,
+                          (Py_ssize_t)self->held_bytes, 0, flags)) {
+        return -1;
+    }
+    self->exports++;
+    return 0;
+}
+
+static void
+camera_releasebuffer(pgCameraObject *self, Py_buffer *view)
+{
+    self->exports--;
+}
+
+static PyBufferProcs camera_as_buffer = {
+    (getbufferproc)camera_getbuffer, (releasebufferproc)camera_releasebuffer};
+#endif
+
 void
 camera_dealloc(PyObject *self)
 {
@@ -1786,6 +2324,10 @@ camera_dealloc(PyObject *self)
     }
     windows_dealloc_device((pgCameraObject *)self);
 #else
+#if defined(__unix__)
+    /* the thread must not outlive the object it reads */
+    v4l2_stop_thread((pgCameraObject *)self);
+#endif
     free(((pgCameraObject *)self)->device_name);
 #endif
     Py_TYPE(self)->tp_free(self);
@@ -1842,6 +2384,15 @@ camera_init(pgCameraObject *self, PyObject *arg, PyObject *kwargs)
     self->vflip = 0;
     self->brightness = 0;
     self->fd = -1;
+    self->pitch = 0;
+    self->held = -1;
+    self->held_bytes = 0;
+    self->exports = 0;
+    self->ticks = 0;
+    self->thread = NULL;
+    self->lock = NULL;
+    self->cond = NULL;
+    self->frames[0] = self->frames[1] = NULL;
 
     return 0;
 #elif defined(PYGAME_WINDOWS_CAMERA)
@@ -1914,6 +2465,9 @@ PyTypeObject pgCamera_Type = {
     .tp_dealloc = camera_dealloc,
     .tp_doc = DOC_CAMERA_CAMERA,
     .tp_methods = cameraobj_builtins,
+#if defined(__unix__)
+    .tp_as_buffer = &camera_as_buffer,
+#endif
     .tp_init = (initproc)camera_init,
     .tp_new = PyType_GenericNew,
 };
@@ -1922,8 +2476,28 @@ PyTypeObject pgCamera_Type = {
 PyMethodDef camera_builtins[] = {
     {"colorspace", surf_colorspace, METH_VARARGS, DOC_CAMERA_COLORSPACE},
     {"list_cameras", list_cameras, METH_NOARGS, DOC_CAMERA_LISTCAMERAS},
+    {"set_conversion_threads", set_conversion_threads, METH_O,
+     DOC_CAMERA_SETCONVERSIONTHREADS},
+    {"get_conversion_threads", get_conversion_threads, METH_NOARGS,
+     DOC_CAMERA_GETCONVERSIONTHREADS},
     {NULL, NULL, 0, NULL}};
 
+/* The colorspace row kernels are picked on every call */
+static int
+_camera_simd_dispatch(PyObject *dispatch)
+{
+    int has_avx2 = 0, has_sse2_neon = 0;
+
+#if !defined(__EMSCRIPTEN__)
+    has_avx2 = _pg_camera_has_avx2();
+#if PG_ENABLE_SSE_NEON
+    has_sse2_neon = _pg_camera_HasSSE_NEON();
+#endif /* PG_ENABLE_SSE_NEON */
+#endif /* __EMSCRIPTEN__ */
+    return pg_simd_report(dispatch, "camera",
+                          pg_simd_backend_name(has_avx2, has_sse2_neon));
+}
+
 MODINIT_DEFINE(_camera)
 {
     PyObject *module;
@@ -1949,6 +2523,7 @@ MODINIT_DEFINE(_camera)
     if (PyErr_Occurred()) {
         return NULL;
     }
+    pg_RegisterSIMDDispatch(_camera_simd_dispatch);
 
     /* type preparation */
     // PyType_Init(pgCamera_Type);
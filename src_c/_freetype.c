@@ -18,6 +18,7 @@
 
 */
 
+#define PG_SURFACE_ORIGIN PG_SURF_ORIGIN_FONT
 #define PYGAME_FREETYPE_INTERNAL
 #define PYGAME_FREETYPE_FONT_INTERNAL
 
@@ -85,6 +86,10 @@ _ftfont_render(pgFontObject *, PyObject *, PyObject *);
 static PyObject *
 _ftfont_render_to(pgFontObject *, PyObject *, PyObject *);
 static PyObject *
+_ftfont_render_many(pgFontObject *, PyObject *, PyObject *);
+static PyObject *
+_ftfont_render_async(pgFontObject *, PyObject *, PyObject *);
+static PyObject *
 _ftfont_render_raw(pgFontObject *, PyObject *, PyObject *);
 static PyObject *
 _ftfont_render_raw_to(pgFontObject *, PyObject *, PyObject *);
@@ -98,6 +103,10 @@ static PyObject *
 _ftfont_getsizedglyphheight(pgFontObject *, PyObject *);
 static PyObject *
 _ftfont_getsizes(pgFontObject *, PyObject *);
+static PyObject *
+_ftfont_getcachestats(pgFontObject *, PyObject *);
+static PyObject *
+_ftfont_setcachebudget(pgFontObject *, PyObject *);
 
 /* static PyObject *_ftfont_copy(pgFontObject *); */
 
@@ -215,9 +224,13 @@ free_string(PGFT_String *);
 #define RESOURCE_FUNC_NAME "getResource"
 
 static unsigned int current_freetype_generation = 0;
+static PyObject *ft_executor = NULL; /* runs Font.render_async() */
 
-#define FreetypeFont_GenerationCheck(x) \
-    (((pgFontObject *)(x))->init_generation == current_freetype_generation)
+/* Every Font method starts with this check, so it also waits for a glyph
+ * being rasterised without the GIL, see _PGFT_BeginRaster. */
+#define FreetypeFont_GenerationCheck(x)      \
+    (_PGFT_WaitIdle(FREETYPE_STATE->freetype), \
+     ((pgFontObject *)(x))->init_generation == current_freetype_generation)
 
 #define RAISE_FREETYPE_QUIT_ERROR(r)                                       \
     RAISERETURN(                                                           \
@@ -539,10 +552,18 @@ static PyMethodDef _ftfont_methods[] = {
      DOC_FREETYPE_FONT_RENDER},
     {"render_to", (PyCFunction)_ftfont_render_to, METH_VARARGS | METH_KEYWORDS,
      DOC_FREETYPE_FONT_RENDERTO},
+    {"render_many", (PyCFunction)_ftfont_render_many,
+     METH_VARARGS | METH_KEYWORDS, DOC_FREETYPE_FONT_RENDERMANY},
+    {"render_async", (PyCFunction)_ftfont_render_async,
+     METH_VARARGS | METH_KEYWORDS, DOC_FREETYPE_FONT_RENDERASYNC},
     {"render_raw", (PyCFunction)_ftfont_render_raw,
      METH_VARARGS | METH_KEYWORDS, DOC_FREETYPE_FONT_RENDERRAW},
     {"render_raw_to", (PyCFunction)_ftfont_render_raw_to,
      METH_VARARGS | METH_KEYWORDS, DOC_FREETYPE_FONT_RENDERRAWTO},
+    {"get_cache_stats", (PyCFunction)_ftfont_getcachestats, METH_NOARGS,
+     DOC_FREETYPE_FONT_GETCACHESTATS},
+    {"set_cache_budget", (PyCFunction)_ftfont_setcachebudget, METH_VARARGS,
+     DOC_FREETYPE_FONT_SETCACHEBUDGET},
 
     {0, 0, 0, 0}};
 
@@ -598,6 +619,8 @@ static PyGetSetDef _ftfont_getsets[] = {
     {"use_bitmap_strikes", (getter)_ftfont_getrender_flag,
      (setter)_ftfont_setrender_flag, DOC_FREETYPE_FONT_USEBITMAPSTRIKES,
      (void *)FT_RFLAG_USE_BITMAP_STRIKES},
+    {"sdf", (getter)_ftfont_getrender_flag, (setter)_ftfont_setrender_flag,
+     DOC_FREETYPE_FONT_SDF, (void *)FT_RFLAG_SDF},
     {"resolution", (getter)_ftfont_getresolution, 0,
      DOC_FREETYPE_FONT_RESOLUTION, 0},
     {"rotation", (getter)_ftfont_getrotation, (setter)_ftfont_setrotation,
@@ -643,6 +666,7 @@ _ftfont_new(PyTypeObject *subtype, PyObject *args, PyObject *kwds)
     if (obj) {
         obj->id.open_args.flags = 0;
         obj->id.open_args.pathname = 0;
+        obj->face_id = &obj->id;
         obj->path = 0;
         obj->resolution = 0;
         obj->is_scalable = 0;
@@ -689,14 +713,18 @@ _ftfont_dealloc(pgFontObject *self)
 static int
 _ftfont_init(pgFontObject *self, PyObject *args, PyObject *kwds)
 {
-    static char *kwlist[] = {"file",       "size", "font_index",
-                             "resolution", "ucs4", 0};
+    static char *kwlist[] = {"file", "size", "font_index", "resolution",
+                             "ucs4", "share_cache", 0};
 
     PyObject *file, *original_file;
     long font_index = 0;
     Scale_t face_size = self->face_size;
     int ucs4 = (self->render_flags & FT_RFLAG_UCS4) ? 1 : 0;
     unsigned resolution = 0;
+    int share_cache = 0;
+    int shareable = 0;
+    const char *share_path;
+    const char *face_path;
     long size = 0;
     long height = 0;
     long width = 0;
@@ -708,9 +736,10 @@ _ftfont_init(pgFontObject *self, PyObject *args, PyObject *kwds)
     FreeTypeInstance *ft;
     ASSERT_GRAB_FREETYPE(ft, -1);
 
-    if (!PyArg_ParseTupleAndKeywords(args, kwds, "O|O&lIi", kwlist, &file,
-                                     obj_to_scale, (void *)&face_size,
-                                     &font_index, &resolution, &ucs4)) {
+    if (!PyArg_ParseTupleAndKeywords(
+            args, kwds, "O|O&lIii", kwlist, &file, obj_to_scale,
+            (void *)&face_size, &font_index, &resolution, &ucs4,
+            &share_cache)) {
         return -1;
     }
 
@@ -778,10 +807,17 @@ _ftfont_init(pgFontObject *self, PyObject *args, PyObject *kwds)
                 Py_DECREF(str);
             }
         }
+        else {
+            /* Only a real file name identifies the face for cache sharing,
+             * not e.g. the descriptor number of a file object */
+            shareable = PyUnicode_Check(path) || PyBytes_Check(path);
+        }
     }
     else {
         Py_INCREF(file);
         path = file;
+        /* a bytearray or memoryview holds font data, not a name */
+        shareable = PyBytes_Check(file) || !PyObject_CheckBuffer(file);
     }
 
     if (path) {
@@ -805,7 +841,17 @@ _ftfont_init(pgFontObject *self, PyObject *args, PyObject *kwds)
         goto end;
     }
 
-    if (_PGFT_TryLoadFont_RWops(ft, self, source, font_index)) {
+    /* Fonts opened from the same file share a face, see ft_wrap.h */
+    face_path = NULL;
+    if (shareable && !pgRWops_IsFileObject(source)) {
+        face_path = PyUnicode_AsUTF8(self->path);
+        if (!face_path) {
+            PyErr_Clear();
+        }
+    }
+    if (face_path ? _PGFT_TryLoadFont_Shared(ft, self, source, font_index,
+                                             face_path)
+                  : _PGFT_TryLoadFont_RWops(ft, self, source, font_index)) {
         goto end;
     }
 
@@ -827,6 +873,17 @@ _ftfont_init(pgFontObject *self, PyObject *args, PyObject *kwds)
     self->freetype = ft;
     ++ft->ref_count;
 
+    if (share_cache && shareable) {
+        share_path = PyUnicode_AsUTF8(self->path);
+        if (!share_path) {
+            /* Unencodable names just keep a private cache */
+            PyErr_Clear();
+        }
+        else if (_PGFT_Cache_Share(ft, self, share_path)) {
+            goto end;
+        }
+    }
+
     rval = 0;
 
 end:
@@ -1328,11 +1385,9 @@ _ftfont_getdebugcachestats(pgFontObject *self, void *closure)
      */
     const FontCache *cache = &PGFT_FONT_CACHE(self);
 
-    return Py_BuildValue("kkkkk", (unsigned long)cache->_debug_count,
-                         (unsigned long)cache->_debug_delete_count,
-                         (unsigned long)cache->_debug_access,
-                         (unsigned long)cache->_debug_hit,
-                         (unsigned long)cache->_debug_miss);
+    return Py_BuildValue("kkkkk", (unsigned long)cache->count,
+                         cache->evictions, cache->hits + cache->misses,
+                         cache->hits, cache->misses);
 }
 #endif
 
@@ -1658,6 +1713,98 @@ error:
     return 0;
 }
 
+static PyObject *
+_ftfont_getcachestats(pgFontObject *self, PyObject *_null)
+{
+    if (!FreetypeFont_GenerationCheck(self)) {
+        RAISE_FREETYPE_QUIT_ERROR(NULL);
+    }
+
+    const FontCache *cache;
+
+    ASSERT_SELF_IS_ALIVE(self);
+    cache = &PGFT_FONT_CACHE(self);
+    return Py_BuildValue(
+        "{sksksksksnsnsnsksn}", "hits", cache->hits, "misses", cache->misses,
+        "evictions", cache->evictions, "entries", (unsigned long)cache->count,
+        "bytes", (Py_ssize_t)cache->bytes, "max_bytes",
+        (Py_ssize_t)cache->max_bytes, "fonts", cache->ref_count, "sdf_glyphs",
+        (unsigned long)cache->sdf_count, "sdf_bytes",
+        (Py_ssize_t)cache->sdf_bytes);
+}
+
+static PyObject *
+_ftfont_setcachebudget(pgFontObject *self, PyObject *args)
+{
+    if (!FreetypeFont_GenerationCheck(self)) {
+        RAISE_FREETYPE_QUIT_ERROR(NULL);
+    }
+
+    Py_ssize_t max_bytes;
+
+    ASSERT_SELF_IS_ALIVE(self);
+    if (!PyArg_ParseTuple(args, "n", &max_bytes)) {
+        return 0;
+    }
+    if (max_bytes < 0) {
+        return RAISE(PyExc_ValueError, "max_bytes must not be negative");
+    }
+    _PGFT_Cache_SetBudget(&PGFT_FONT_CACHE(self), (size_t)max_bytes);
+    Py_RETURN_NONE;
+}
+
+static PyObject *
+_ftfont_render_async(pgFontObject *self, PyObject *args, PyObject *kwds)
+{
+    PyObject *render, *submit, *submit_args, *future;
+    Py_ssize_t i, nargs = PyTuple_GET_SIZE(args);
+
+    if (!FreetypeFont_GenerationCheck(self)) {
+        RAISE_FREETYPE_QUIT_ERROR(NULL);
+    }
+    ASSERT_SELF_IS_ALIVE(self);
+
+    /* One worker, so futures complete in the order they were made */
+    if (!ft_executor) {
+        PyObject *futures = PyImport_ImportModule("concurrent.futures");
+
+        if (!futures) {
+            return NULL;
+        }
+        ft_executor = PyObject_CallMethod(futures, "ThreadPoolExecutor", "is",
+                                          1, "pygame_freetype");
+        Py_DECREF(futures);
+        if (!ft_executor) {
+            return NULL;
+        }
+    }
+
+    submit_args = PyTuple_New(nargs + 1);
+    if (!submit_args) {
+        return NULL;
+    }
+    render = PyObject_GetAttrString((PyObject *)self, "render");
+    if (!render) {
+        Py_DECREF(submit_args);
+        return NULL;
+    }
+    PyTuple_SET_ITEM(submit_args, 0, render);
+    for (i = 0; i < nargs; ++i) {
+        Py_INCREF(PyTuple_GET_ITEM(args, i));
+        PyTuple_SET_ITEM(submit_args, i + 1, PyTuple_GET_ITEM(args, i));
+    }
+
+    submit = PyObject_GetAttrString(ft_executor, "submit");
+    if (!submit) {
+        Py_DECREF(submit_args);
+        return NULL;
+    }
+    future = PyObject_Call(submit, submit_args, kwds);
+    Py_DECREF(submit);
+    Py_DECREF(submit_args);
+    return future;
+}
+
 static PyObject *
 _ftfont_render_raw(pgFontObject *self, PyObject *args, PyObject *kwds)
 {
@@ -2037,6 +2184,208 @@ error:
     return 0;
 }
 
+static PyObject *
+_ftfont_render_many(pgFontObject *self, PyObject *args, PyObject *kwds)
+{
+    if (!FreetypeFont_GenerationCheck(self)) {
+        RAISE_FREETYPE_QUIT_ERROR(NULL);
+    }
+
+    /* keyword list */
+    static char *kwlist[] = {"surf", "items", "style", "rotation", "size", 0};
+
+    /* input arguments */
+    PyObject *surface_obj = 0;
+    PyObject *items = 0;
+    Scale_t face_size = FACE_SIZE_NONE;
+    Angle_t rotation = self->rotation;
+    int style = FT_STYLE_DEFAULT;
+
+    PyObject *seq = 0;
+    PyObject *layout_index = 0; /* text -> index of its layout in layouts */
+    PyObject *rects = 0;
+    PyObject *item, *textobj, *dest, *fg_color_obj, *bg_color_obj;
+    PyObject *index, *rect;
+    PGFT_String *text;
+    Layout *layouts = 0;
+    Layout *font_text;
+    Py_ssize_t num_layouts = 0;
+    Py_ssize_t num_items, i;
+    int xpos, ypos;
+    int have_bg_color;
+    int locked = 0;
+    SDL_Surface *surface;
+    SDL_Rect r;
+
+    FontColor fg_color;
+    FontColor bg_color;
+    FontRenderMode render;
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "O!O|iO&O&", kwlist,
+                                     &pgSurface_Type, &surface_obj, &items,
+                                     &style, obj_to_rotation,
+                                     (void *)&rotation, obj_to_scale,
+                                     (void *)&face_size)) {
+        return 0;
+    }
+
+    ASSERT_SELF_IS_ALIVE(self);
+
+    if (_PGFT_BuildRenderMode(self->freetype, self, &render, face_size, style,
+                              rotation)) {
+        return 0;
+    }
+
+    surface = pgSurface_AsSurface(surface_obj);
+    if (!surface) {
+        return RAISE(pgExc_SDLError, "display Surface quit");
+    }
+
+    seq = PySequence_Fast(items, "items must be a sequence of tuples");
+    if (!seq) {
+        return 0;
+    }
+    num_items = PySequence_Fast_GET_SIZE(seq);
+    rects = PyList_New(num_items);
+    layout_index = PyDict_New();
+    if (!rects || !layout_index) {
+        goto error;
+    }
+    if (num_items > 0) {
+        layouts = (Layout *)_PGFT_malloc((size_t)num_items * sizeof(Layout));
+        if (!layouts) {
+            PyErr_NoMemory();
+            goto error;
+        }
+    }
+
+    if (SDL_MUSTLOCK(surface)) {
+        if (SDL_LockSurface(surface) == -1) {
+            PyErr_SetString(pgExc_SDLError, SDL_GetError());
+            goto error;
+        }
+        locked = 1;
+    }
+
+    for (i = 0; i < num_items; ++i) {
+        item = PySequence_Fast_GET_ITEM(seq, i);
+        fg_color_obj = 0;
+        bg_color_obj = 0;
+        if (!PyTuple_Check(item) ||
+            !PyArg_ParseTuple(item, "OO|OO", &textobj, &dest, &fg_color_obj,
+                              &bg_color_obj)) {
+            PyErr_Format(PyExc_TypeError,
+                         "item %zd: expected a (text, dest[, fgcolor"
+                         "[, bgcolor]]) tuple",
+                         i);
+            goto error;
+        }
+        if (!PyUnicode_Check(textobj) && !PyBytes_Check(textobj)) {
+            PyErr_Format(PyExc_TypeError,
+                         "item %zd: text must be a str or bytes, not %.200s",
+                         i, Py_TYPE(textobj)->tp_name);
+            goto error;
+        }
+        if (parse_dest(dest, &xpos, &ypos)) {
+            goto error;
+        }
+
+        if (fg_color_obj && fg_color_obj != Py_None) {
+            if (!pg_RGBAFromObjEx(fg_color_obj, (Uint8 *)&fg_color,
+                                  PG_COLOR_HANDLE_ALL)) {
+                goto error;
+            }
+        }
+        else {
+            fg_color.r = self->fgcolor[0];
+            fg_color.g = self->fgcolor[1];
+            fg_color.b = self->fgcolor[2];
+            fg_color.a = self->fgcolor[3];
+        }
+        have_bg_color = 1;
+        if (bg_color_obj && bg_color_obj != Py_None) {
+            if (!pg_RGBAFromObjEx(bg_color_obj, (Uint8 *)&bg_color,
+                                  PG_COLOR_HANDLE_ALL)) {
+                goto error;
+            }
+        }
+        else if (self->is_bg_col_set) {
+            bg_color.r = self->bgcolor[0];
+            bg_color.g = self->bgcolor[1];
+            bg_color.b = self->bgcolor[2];
+            bg_color.a = self->bgcolor[3];
+        }
+        else {
+            have_bg_color = 0;
+        }
+
+        /* Every item shares one render mode, so a repeated string is laid
+         * out only once per call */
+        index = PyDict_GetItemWithError(layout_index, textobj);
+        if (index) {
+            font_text = &layouts[PyLong_AsSsize_t(index)];
+        }
+        else if (PyErr_Occurred()) {
+            goto error;
+        }
+        else {
+            text = _PGFT_EncodePyString(textobj,
+                                        self->render_flags & FT_RFLAG_UCS4);
+            if (!text) {
+                goto error;
+            }
+            font_text = _PGFT_LoadLayout(self->freetype, self, &render, text);
+            free_string(text);
+            if (!font_text ||
+                _PGFT_CopyLayout(self, &layouts[num_layouts])) {
+                goto error;
+            }
+            font_text = &layouts[num_layouts++];
+            index = PyLong_FromSsize_t(num_layouts - 1);
+            if (!index || PyDict_SetItem(layout_index, textobj, index)) {
+                Py_XDECREF(index);
+                goto error;
+            }
+            Py_DECREF(index);
+        }
+
+        if (_PGFT_Render_Layout(self->freetype, self, &render, font_text,
+                                surface, xpos, ypos, &fg_color,
+                                have_bg_color ? &bg_color : 0, &r)) {
+            goto error;
+        }
+        rect = pgRect_New(&r);
+        if (!rect) {
+            goto error;
+        }
+        PyList_SET_ITEM(rects, i, rect);
+    }
+
+    if (locked) {
+        SDL_UnlockSurface(surface);
+    }
+    for (i = 0; i < num_layouts; ++i) {
+        _PGFT_FreeLayoutCopy(self, &layouts[i]);
+    }
+    _PGFT_free(layouts);
+    Py_DECREF(layout_index);
+    Py_DECREF(seq);
+    return rects;
+
+error:
+    if (locked) {
+        SDL_UnlockSurface(surface);
+    }
+    for (i = 0; i < num_layouts; ++i) {
+        _PGFT_FreeLayoutCopy(self, &layouts[i]);
+    }
+    _PGFT_free(layouts);
+    Py_XDECREF(layout_index);
+    Py_XDECREF(rects);
+    Py_DECREF(seq);
+    return 0;
+}
+
 /****************************************************
  * C API CALLS
  ****************************************************/
@@ -2107,7 +2456,18 @@ _ft_quit(PyObject *self, PyObject *_null)
 {
     _FreeTypeState *state = FREETYPE_STATE;
 
+    if (ft_executor) {
+        PyObject *result = PyObject_CallMethod(ft_executor, "shutdown", NULL);
+
+        Py_CLEAR(ft_executor);
+        if (!result) {
+            return NULL;
+        }
+        Py_DECREF(result);
+    }
+
     if (state->freetype) {
+        _PGFT_WaitIdle(state->freetype);
         _PGFT_Quit(state->freetype);
         state->cache_size = 0;
         state->freetype = 0;
@@ -2258,6 +2618,16 @@ _ft_clear(PyObject *mod)
     return 0;
 }
 
+/* The kernels are picked on every render, so that set_simd_level() applies
+ * without a dispatch of its own */
+static int
+_ft_simd_dispatch(PyObject *dispatch)
+{
+    return pg_simd_report(
+        dispatch, "freetype",
+        pg_simd_backend_name(_pgft_has_avx2(), _pgft_HasSSE_NEON()));
+}
+
 /****************************************************
  * FREETYPE MODULE DECLARATION
  ****************************************************/
@@ -2324,6 +2694,7 @@ MODINIT_DEFINE(_freetype)
     FREETYPE_MOD_STATE(module)->freetype = 0;
     FREETYPE_MOD_STATE(module)->cache_size = 0;
     FREETYPE_MOD_STATE(module)->resolution = PGFT_DEFAULT_RESOLUTION;
+    pg_RegisterSIMDDispatch(_ft_simd_dispatch);
 
     Py_INCREF(&pgFont_Type);
     if (PyModule_AddObject(module, FONT_TYPE_NAME, (PyObject *)&pgFont_Type)) {
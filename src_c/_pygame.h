@@ -211,6 +211,85 @@ struct SDL_BlitMap {
 
 #endif
 
+/* The PYGAME_SIMD hint caps the SIMD kernels picked at runtime, to compare
+ * them with each other and with the plain C code: "none" (or "scalar") runs
+ * plain C only, "sse2" (or "neon") rules out AVX2, and anything else allows
+ * all that the CPU supports. It is set from the environment variable of the
+ * same name, or by pygame.system.set_simd_level(). Each file keeps its own
+ * copy of the level, which SDL updates when the hint changes. */
+#define PG_SIMD_HINT "PYGAME_SIMD"
+#define PG_SIMD_NONE 0
+#define PG_SIMD_SSE2_NEON 1
+#define PG_SIMD_AVX2 2
+
+static inline int
+pg_simd_parse_level(const char *value)
+{
+    if (value &&
+        (!SDL_strcasecmp(value, "none") || !SDL_strcasecmp(value, "scalar"))) {
+        return PG_SIMD_NONE;
+    }
+    if (value &&
+        (!SDL_strcasecmp(value, "sse2") || !SDL_strcasecmp(value, "neon"))) {
+        return PG_SIMD_SSE2_NEON;
+    }
+    return PG_SIMD_AVX2;
+}
+
+static inline void SDLCALL
+_pg_simd_hint_changed(void *userdata, const char *name, const char *old,
+                      const char *value)
+{
+    *(int *)userdata = pg_simd_parse_level(value);
+}
+
+static inline int
+pg_simd_max_level(void)
+{
+    static int level = -1;
+
+    if (level < 0) {
+        level = pg_simd_parse_level(SDL_GetHint(PG_SIMD_HINT));
+        /* keeps level in sync from now on */
+        SDL_AddHintCallback(PG_SIMD_HINT, _pg_simd_hint_changed, &level);
+    }
+    return level;
+}
+
+/* The name pygame.system.get_simd_dispatch() shows for the kernels picked
+ * by the runtime checks of a module */
+static inline const char *
+pg_simd_backend_name(int has_avx2, int has_sse2_neon)
+{
+    if (has_avx2) {
+        return "avx2";
+    }
+    if (has_sse2_neon) {
+        return SDL_HasNEON() ? "neon" : "sse2";
+    }
+    return "scalar";
+}
+
+/* Adds op: backend to the dict of pygame.system.get_simd_dispatch(), if
+ * dispatch isn't NULL */
+static inline int
+pg_simd_report(PyObject *dispatch, const char *op, const char *backend)
+{
+    PyObject *value;
+    int result;
+
+    if (!dispatch) {
+        return 0;
+    }
+    value = PyUnicode_FromString(backend);
+    if (!value) {
+        return -1;
+    }
+    result = PyDict_SetItemString(dispatch, op, value);
+    Py_DECREF(value);
+    return result;
+}
+
 /* DictProxy is useful for event posting with an arbitrary dict. Maintains
  * state of number of events on queue and whether the owner of this struct
  * wants this dict freed. This DictProxy is only to be freed when there are no
@@ -401,6 +480,9 @@ typedef enum {
     PGS_DOUBLEBUF = 0x40000000,
     PGS_FULLSCREEN = 0x80000000,
     PGS_SCALED = 0x00000200,
+    PGS_PIPELINED = 0x00000400,
+    PGS_STREAMED = 0x00000800,
+    PGS_ACCELERATED = 0x00020000,
 
     PGS_OPENGL = 0x00000002,
     PGS_OPENGLBLIT = 0x0000000A,
@@ -482,7 +564,13 @@ typedef enum {
  */
 struct pgEventObject {
     PyObject_HEAD int type;
+    /* NULL until first needed when the event was created lazily from
+     * 'event', see pgEvent_New */
     PyObject *dict;
+    SDL_Event event;
+    /* the pygame Window of a lazily created event, resolved when it was
+     * created so destroying the window does not change it */
+    PyObject *window;
 };
 
 /*
@@ -503,6 +591,14 @@ struct pgSubSurface_Data {
     int offsetx, offsety;
 };
 
+/* Most rects a Surface dirty rect tracker holds before merging them */
+#define PG_SURF_MAX_DIRTY_RECTS 32
+
+typedef struct pgSurfaceDirtyRects {
+    int count;
+    SDL_Rect rects[PG_SURF_MAX_DIRTY_RECTS];
+} pgSurfaceDirtyRects;
+
 /*
  * color module internals
  */
@@ -529,6 +625,17 @@ typedef enum {
     PG_COLOR_HANDLE_ALL = PG_COLOR_HANDLE_STR | PG_COLOR_HANDLE_INT,
 } pgColorHandleFlags;
 
+/*
+ * math module internals
+ */
+#define VECTOR_MAX_SIZE (3)
+
+typedef struct {
+    PyObject_HEAD double coords[VECTOR_MAX_SIZE]; /* Coordinates */
+    Py_ssize_t dim;                               /* Dimension of the vector */
+    double epsilon; /* Small value for comparisons */
+} pgVector;
+
 /*
  * include public API
  */
@@ -541,15 +648,85 @@ typedef enum {
 #define PYGAMEAPI_RECT_NUMSLOTS 10
 #define PYGAMEAPI_JOYSTICK_NUMSLOTS 3
 #define PYGAMEAPI_DISPLAY_NUMSLOTS 2
-#define PYGAMEAPI_SURFACE_NUMSLOTS 4
+#define PYGAMEAPI_SURFACE_NUMSLOTS 10
 #define PYGAMEAPI_SURFLOCK_NUMSLOTS 8
-#define PYGAMEAPI_RWOBJECT_NUMSLOTS 5
+#define PYGAMEAPI_RWOBJECT_NUMSLOTS 6
 #define PYGAMEAPI_PIXELARRAY_NUMSLOTS 2
 #define PYGAMEAPI_COLOR_NUMSLOTS 5
 #define PYGAMEAPI_MATH_NUMSLOTS 2
-#define PYGAMEAPI_BASE_NUMSLOTS 29
-#define PYGAMEAPI_EVENT_NUMSLOTS 10
+#define PYGAMEAPI_BASE_NUMSLOTS 35
+#define PYGAMEAPI_EVENT_NUMSLOTS 11
 #define PYGAMEAPI_WINDOW_NUMSLOTS 1
-#define PYGAMEAPI_GEOMETRY_NUMSLOTS 1
+#define PYGAMEAPI_GEOMETRY_NUMSLOTS 3
+
+/* Pixel loops of blits, fills, draws and image saves run with the GIL
+ * released when nothing else can get at the pixels meanwhile, so that
+ * threads rendering to Surfaces of their own run in parallel. A Surface
+ * qualifies when no object (PixelArray, buffer, array) locks it, it isn't a
+ * subsurface, whose pixels belong to its parent, and it isn't the surface
+ * of a window, which SDL may replace. Each SDL surface is referenced while
+ * the GIL is released, so that a Surface reinitialised by another thread
+ * doesn't free the pixels under the loop. */
+typedef struct {
+    PyThreadState *save;
+    SDL_Surface *surfs[2];
+} pg_NoGIL;
+
+static inline int
+pg_surface_is_private(pgSurfaceObject *surfobj)
+{
+    SDL_Surface *surf;
+
+    if (!surfobj) {
+        return 1;
+    }
+    surf = pgSurface_AsSurface(surfobj);
+    if (!surf || surfobj->subsurface ||
+        (surfobj->locklist && PyList_GET_SIZE(surfobj->locklist))) {
+        return 0;
+    }
+#if SDL_VERSION_ATLEAST(3, 0, 0)
+    /* SDL 3 doesn't tell window surfaces apart */
+    return 0;
+#else
+    return !(surf->flags & SDL_DONTFREE);
+#endif
+}
+
+/* Releases the GIL if the current thread holds it and surfobj and other
+ * (which may be NULL) are private, see above */
+static inline void
+pg_nogil_begin(pg_NoGIL *nogil, pgSurfaceObject *surfobj,
+               pgSurfaceObject *other)
+{
+    int i;
+
+    nogil->save = NULL;
+    if (!PyGILState_Check() || !pg_surface_is_private(surfobj) ||
+        !pg_surface_is_private(other)) {
+        return;
+    }
+    nogil->surfs[0] = surfobj ? pgSurface_AsSurface(surfobj) : NULL;
+    nogil->surfs[1] = other ? pgSurface_AsSurface(other) : NULL;
+    for (i = 0; i < 2; i++) {
+        if (nogil->surfs[i]) {
+            ++nogil->surfs[i]->refcount;
+        }
+    }
+    nogil->save = PyEval_SaveThread();
+}
+
+static inline void
+pg_nogil_end(pg_NoGIL *nogil)
+{
+    if (!nogil->save) {
+        return;
+    }
+    PyEval_RestoreThread(nogil->save);
+    nogil->save = NULL;
+    /* drops the references taken above, NULL is ignored */
+    SDL_FreeSurface(nogil->surfs[0]);
+    SDL_FreeSurface(nogil->surfs[1]);
+}
 
 #endif /* _PYGAME_INTERNAL_H */
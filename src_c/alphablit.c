@@ -23,9 +23,11 @@
 */
 
 #define NO_PYGAME_C_API
+#define PYGAMEAPI_SURFACE_INTERNAL
 #include "_surface.h"
 #include "simd_shared.h"
 #include "simd_blitters.h"
+#include "simd_565.h"
 
 static void
 alphablit_alpha(SDL_BlitInfo *info);
@@ -34,6 +36,8 @@ alphablit_colorkey(SDL_BlitInfo *info);
 static void
 alphablit_solid(SDL_BlitInfo *info);
 static void
+alphablit_copy(SDL_BlitInfo *info);
+static void
 blit_blend_add(SDL_BlitInfo *info);
 static void
 blit_blend_sub(SDL_BlitInfo *info);
@@ -57,18 +61,877 @@ blit_blend_rgba_max(SDL_BlitInfo *info);
 
 static void
 blit_blend_premultiplied(SDL_BlitInfo *info);
+static void
+blit_blend_custom(SDL_BlitInfo *info);
+
+static void
+alphablit_spans(SDL_BlitInfo *info);
 
 static int
 SoftBlitPyGame(SDL_Surface *src, SDL_Rect *srcrect, SDL_Surface *dst,
-               SDL_Rect *dstrect, int blend_flags);
+               SDL_Rect *dstrect, int blend_flags, const pg_AlphaSpans *spans,
+               pg_BlitQueue *queue, pg_BlitKernel *kernel);
 extern int
 SDL_RLESurface(SDL_Surface *surface);
 extern void
 SDL_UnRLESurface(SDL_Surface *surface, int recode);
 
+/* Threaded blitting.
+ *
+ * When enabled with pg_set_blit_threads(), large blits are cut into bands of
+ * destination rows. The bands are handed out to a small pool of worker
+ * threads, while the calling thread blits the first band itself. Every
+ * blitter only touches the rows described by its SDL_BlitInfo, so bands can
+ * run concurrently without further synchronisation as long as the source and
+ * destination pixels don't overlap.
+ *
+ * The blits of a pg_BlitQueue are grouped into waves instead, the blits of a
+ * wave having destination rects that don't overlap. The threads of the pool
+ * take the blits of a wave one at a time until it is done, then the next
+ * wave starts.
+ *
+ * Other modules run their own bands on the pool with pg_run_bands(), which
+ * starts more workers if it asks for more threads than blits use.
+ */
+#define PG_BLIT_MAX_THREADS 64
+#define PG_BLIT_THREAD_MIN_ROWS 16
+#define PG_BLIT_THREAD_MIN_PIXELS (1 << 16)
+
+/* A band with a NULL blitter takes blits of the current wave, or bands of
+ * the current pg_run_bands() call, instead */
+typedef struct {
+    pg_BlitKernel blitter;
+    SDL_BlitInfo info;
+} pg_BlitBand;
+
+typedef struct {
+    pg_BlitKernel blitter;
+    SDL_BlitInfo info;
+    SDL_Surface *src; /* referenced until the blit has run */
+    SDL_Rect rect;    /* the destination area */
+    int wave;
+} pg_QueuedBlit;
+
+struct pg_BlitQueue {
+    SDL_Surface *dst; /* referenced while blits are queued */
+    pg_QueuedBlit *blits;
+    int *order; /* of the blits, by wave */
+    int length;
+    int capacity;
+};
+
+/* The waves are found on a grid of cells of 64x64 destination pixels */
+#define PG_BLIT_QUEUE_CELL_SHIFT 6
+
+static struct {
+    int num_threads; /* used by blits, there may be more workers */
+    int num_workers;
+    SDL_Thread *workers[PG_BLIT_MAX_THREADS];
+    SDL_mutex *dispatch_lock;
+    SDL_sem *band_ready;
+    SDL_sem *band_done;
+    SDL_atomic_t next_band;
+    SDL_atomic_t quit;
+    pg_BlitBand bands[PG_BLIT_MAX_THREADS];
+    pg_QueuedBlit *wave;
+    const int *wave_order;
+    int wave_size;
+    SDL_atomic_t wave_next;
+    pg_BandFunc band_func;
+    void *band_data;
+    int band_count;
+    SDL_atomic_t band_next;
+} blit_pool = {1};
+
+static SDL_SpinLock blit_pool_init_lock;
+
+static void
+_blit_wave_work(void)
+{
+    pg_QueuedBlit *blit;
+    int i;
+
+    while ((i = SDL_AtomicAdd(&blit_pool.wave_next, 1)) <
+           blit_pool.wave_size) {
+        blit = &blit_pool.wave[blit_pool.wave_order[i]];
+        blit->blitter(&blit->info);
+    }
+}
+
+static void
+_blit_band_work(void)
+{
+    int i;
+
+    while ((i = SDL_AtomicAdd(&blit_pool.band_next, 1)) <
+           blit_pool.band_count) {
+        blit_pool.band_func(blit_pool.band_data, i);
+    }
+}
+
+static int SDLCALL
+_blit_worker(void *unused)
+{
+    pg_BlitBand *band;
+
+    for (;;) {
+        SDL_SemWait(blit_pool.band_ready);
+        if (SDL_AtomicGet(&blit_pool.quit)) {
+            break;
+        }
+        band = &blit_pool.bands[SDL_AtomicAdd(&blit_pool.next_band, 1)];
+        if (band->blitter) {
+            band->blitter(&band->info);
+        }
+        else if (blit_pool.band_func) {
+            _blit_band_work();
+        }
+        else {
+            _blit_wave_work();
+        }
+        SDL_SemPost(blit_pool.band_done);
+    }
+    return 0;
+}
+
+/* Must be called with dispatch_lock held */
+static void
+_blit_pool_stop_workers(void)
+{
+    int i;
+
+    SDL_AtomicSet(&blit_pool.quit, 1);
+    for (i = 0; i < blit_pool.num_workers; i++) {
+        SDL_SemPost(blit_pool.band_ready);
+    }
+    for (i = 0; i < blit_pool.num_workers; i++) {
+        SDL_WaitThread(blit_pool.workers[i], NULL);
+        blit_pool.workers[i] = NULL;
+    }
+    blit_pool.num_workers = 0;
+    SDL_AtomicSet(&blit_pool.quit, 0);
+}
+
+/* Must be called with dispatch_lock held. Returns -1 with SDL error set if
+ * a thread can't be started. */
+static int
+_blit_pool_start_workers(int num_workers)
+{
+    SDL_Thread *thread;
+
+    if (num_workers > PG_BLIT_MAX_THREADS - 1) {
+        num_workers = PG_BLIT_MAX_THREADS - 1;
+    }
+    while (blit_pool.num_workers < num_workers) {
+        thread = SDL_CreateThread(_blit_worker, "pygame_blit", NULL);
+        if (!thread) {
+            return -1;
+        }
+        blit_pool.workers[blit_pool.num_workers++] = thread;
+    }
+    return 0;
+}
+
+/* Creates the locks of the pool if there are none yet, returns -1 with SDL
+ * error set if it fails */
+static int
+_blit_pool_init(void)
+{
+    int result = 0;
+
+    SDL_AtomicLock(&blit_pool_init_lock);
+    if (!blit_pool.dispatch_lock) {
+        blit_pool.band_ready = SDL_CreateSemaphore(0);
+        blit_pool.band_done = SDL_CreateSemaphore(0);
+        blit_pool.dispatch_lock = SDL_CreateMutex();
+        if (!blit_pool.band_ready || !blit_pool.band_done ||
+            !blit_pool.dispatch_lock) {
+            pg_quit_blit_threads();
+            result = -1;
+        }
+    }
+    SDL_AtomicUnlock(&blit_pool_init_lock);
+    return result;
+}
+
+/* On error, returns -1 with SDL error set. The previous workers are stopped
+ * either way, so after an error blits use as many threads as could be
+ * started. */
+int
+pg_set_blit_threads(int num_threads)
+{
+    int result;
+
+    if (num_threads <= 0) {
+        num_threads = SDL_GetCPUCount();
+    }
+    if (num_threads > PG_BLIT_MAX_THREADS) {
+        num_threads = PG_BLIT_MAX_THREADS;
+    }
+
+    if (!blit_pool.dispatch_lock) {
+        if (num_threads < 2) {
+            blit_pool.num_threads = 1;
+            return 0;
+        }
+        if (_blit_pool_init() < 0) {
+            return -1;
+        }
+    }
+
+    SDL_LockMutex(blit_pool.dispatch_lock);
+    _blit_pool_stop_workers();
+    result = _blit_pool_start_workers(num_threads - 1);
+    blit_pool.num_threads = blit_pool.num_workers + 1;
+    SDL_UnlockMutex(blit_pool.dispatch_lock);
+    return result;
+}
+
+int
+pg_get_blit_threads(void)
+{
+    return blit_pool.num_threads;
+}
+
+void
+pg_quit_blit_threads(void)
+{
+    if (blit_pool.dispatch_lock) {
+        SDL_LockMutex(blit_pool.dispatch_lock);
+        _blit_pool_stop_workers();
+        SDL_UnlockMutex(blit_pool.dispatch_lock);
+        SDL_DestroyMutex(blit_pool.dispatch_lock);
+        blit_pool.dispatch_lock = NULL;
+    }
+    if (blit_pool.band_ready) {
+        SDL_DestroySemaphore(blit_pool.band_ready);
+        blit_pool.band_ready = NULL;
+    }
+    if (blit_pool.band_done) {
+        SDL_DestroySemaphore(blit_pool.band_done);
+        blit_pool.band_done = NULL;
+    }
+    blit_pool.num_threads = 1;
+}
+
+static void
+_blit_run(pg_BlitKernel blitter, SDL_BlitInfo *info)
+{
+    int s_pitch, d_pitch;
+    int nbands, rows, extra, band, y;
+    Uint8 *s_end, *d_end;
+    pg_BlitBand *b;
+    PyThreadState *save = NULL;
+
+    /* Reversed (overlapping self) blits and small blits stay on this
+     * thread, there is nothing to gain from splitting them. */
+    if (blit_pool.num_threads < 2 || info->s_pxskip < 0 ||
+        info->height < 2 * PG_BLIT_THREAD_MIN_ROWS ||
+        info->width * info->height < PG_BLIT_THREAD_MIN_PIXELS) {
+        blitter(info);
+        return;
+    }
+
+    s_pitch = info->width * info->s_pxskip + info->s_skip;
+    d_pitch = info->width * info->d_pxskip + info->d_skip;
+
+    /* Bands of a blit within one pixel buffer (e.g. a subsurface onto its
+     * parent) could read rows another band has already written. */
+    s_end = info->s_pixels + (info->height - 1) * s_pitch +
+            info->width * info->s_pxskip;
+    d_end = info->d_pixels + (info->height - 1) * d_pitch +
+            info->width * info->d_pxskip;
+    if (info->s_pixels < d_end && info->d_pixels < s_end) {
+        blitter(info);
+        return;
+    }
+
+    /* Another Python thread is already using the pool */
+    if (SDL_TryLockMutex(blit_pool.dispatch_lock) != 0) {
+        blitter(info);
+        return;
+    }
+
+    nbands = MIN(blit_pool.num_threads, blit_pool.num_workers + 1);
+    if (nbands > info->height / PG_BLIT_THREAD_MIN_ROWS) {
+        nbands = info->height / PG_BLIT_THREAD_MIN_ROWS;
+    }
+    if (nbands < 2) {
+        SDL_UnlockMutex(blit_pool.dispatch_lock);
+        blitter(info);
+        return;
+    }
+
+    rows = info->height / nbands;
+    extra = info->height % nbands;
+    y = 0;
+    for (band = 0; band < nbands; band++) {
+        b = &blit_pool.bands[band];
+        b->blitter = blitter;
+        b->info = *info;
+        b->info.height = rows + (band < extra ? 1 : 0);
+        b->info.s_pixels = info->s_pixels + y * s_pitch;
+        b->info.d_pixels = info->d_pixels + y * d_pitch;
+        b->info.span_y = info->span_y + y;
+        y += b->info.height;
+    }
+    SDL_AtomicSet(&blit_pool.next_band, 1);
+
+    /* the caller may have released the GIL already, see pg_nogil_begin() */
+    if (PyGILState_Check()) {
+        save = PyEval_SaveThread();
+    }
+    for (band = 1; band < nbands; band++) {
+        SDL_SemPost(blit_pool.band_ready);
+    }
+    blitter(&blit_pool.bands[0].info);
+    for (band = 1; band < nbands; band++) {
+        SDL_SemWait(blit_pool.band_done);
+    }
+    if (save) {
+        PyEval_RestoreThread(save);
+    }
+
+    SDL_UnlockMutex(blit_pool.dispatch_lock);
+}
+
+/* Runs the n blits of a wave, given by their indices in order. They don't
+ * overlap, so the threads of the pool run them in any order. */
+static void
+_blit_run_wave(pg_QueuedBlit *blits, const int *order, int n)
+{
+    int i, nbands, band;
+    PyThreadState *save = NULL;
+
+    /* a lone blit may still be cut into bands */
+    if (n == 1) {
+        _blit_run(blits[order[0]].blitter, &blits[order[0]].info);
+        return;
+    }
+    if (blit_pool.num_threads < 2 ||
+        SDL_TryLockMutex(blit_pool.dispatch_lock) != 0) {
+        for (i = 0; i < n; i++) {
+            blits[order[i]].blitter(&blits[order[i]].info);
+        }
+        return;
+    }
+
+    nbands = MIN(blit_pool.num_threads, blit_pool.num_workers + 1);
+    if (nbands > n) {
+        nbands = n;
+    }
+    blit_pool.wave = blits;
+    blit_pool.wave_order = order;
+    blit_pool.wave_size = n;
+    SDL_AtomicSet(&blit_pool.wave_next, 0);
+    for (band = 1; band < nbands; band++) {
+        blit_pool.bands[band].blitter = NULL;
+    }
+    SDL_AtomicSet(&blit_pool.next_band, 1);
+
+    /* the caller may have released the GIL already, see pg_nogil_begin() */
+    if (PyGILState_Check()) {
+        save = PyEval_SaveThread();
+    }
+    for (band = 1; band < nbands; band++) {
+        SDL_SemPost(blit_pool.band_ready);
+    }
+    _blit_wave_work();
+    for (band = 1; band < nbands; band++) {
+        SDL_SemWait(blit_pool.band_done);
+    }
+    if (save) {
+        PyEval_RestoreThread(save);
+    }
+
+    SDL_UnlockMutex(blit_pool.dispatch_lock);
+}
+
+void
+pg_run_bands(pg_BandFunc func, void *data, int nbands)
+{
+    int band, nworkers;
+    PyThreadState *save = NULL;
+
+    if (nbands < 2 || _blit_pool_init() < 0 ||
+        SDL_TryLockMutex(blit_pool.dispatch_lock) != 0) {
+        for (band = 0; band < nbands; band++) {
+            func(data, band);
+        }
+        return;
+    }
+
+    /* if a thread can't be started the ones there are take more bands */
+    _blit_pool_start_workers(nbands - 1);
+    nworkers = MIN(nbands - 1, blit_pool.num_workers);
+    blit_pool.band_func = func;
+    blit_pool.band_data = data;
+    blit_pool.band_count = nbands;
+    SDL_AtomicSet(&blit_pool.band_next, 0);
+    for (band = 1; band <= nworkers; band++) {
+        blit_pool.bands[band].blitter = NULL;
+    }
+    SDL_AtomicSet(&blit_pool.next_band, 1);
+
+    /* the caller may have released the GIL already, see pg_nogil_begin() */
+    if (PyGILState_Check()) {
+        save = PyEval_SaveThread();
+    }
+    for (band = 0; band < nworkers; band++) {
+        SDL_SemPost(blit_pool.band_ready);
+    }
+    _blit_band_work();
+    for (band = 0; band < nworkers; band++) {
+        SDL_SemWait(blit_pool.band_done);
+    }
+    if (save) {
+        PyEval_RestoreThread(save);
+    }
+
+    blit_pool.band_func = NULL;
+    SDL_UnlockMutex(blit_pool.dispatch_lock);
+}
+
+pg_BlitQueue *
+pg_blit_queue_new(void)
+{
+    return (pg_BlitQueue *)calloc(1, sizeof(pg_BlitQueue));
+}
+
+void
+pg_blit_queue_free(pg_BlitQueue *queue)
+{
+    if (!queue) {
+        return;
+    }
+    pg_blit_queue_flush(queue);
+    free(queue->blits);
+    free(queue->order);
+    free(queue);
+}
+
+/* Returns 0 if the blit can't be queued, then it must run right away.
+ * Blits reading the destination pixels and reversed (overlapping self)
+ * blits can't wait. */
+static int
+_blit_queue_add(pg_BlitQueue *queue, pg_BlitKernel blitter,
+                SDL_BlitInfo *info, SDL_Surface *src, SDL_Surface *dst,
+                SDL_Rect *rect)
+{
+    Uint8 *src_start = (Uint8 *)src->pixels;
+    Uint8 *dst_start = (Uint8 *)dst->pixels;
+    pg_QueuedBlit *blits, *blit;
+    int *order, capacity;
+
+    if (info->s_pxskip < 0 || (queue->length && queue->dst != dst) ||
+        (src_start < dst_start + dst->h * dst->pitch &&
+         dst_start < src_start + src->h * src->pitch)) {
+        return 0;
+    }
+
+    if (queue->length == queue->capacity) {
+        capacity = queue->capacity ? queue->capacity * 2 : 64;
+        blits = (pg_QueuedBlit *)realloc(queue->blits,
+                                         capacity * sizeof(pg_QueuedBlit));
+        if (!blits) {
+            return 0;
+        }
+        queue->blits = blits;
+        order = (int *)realloc(queue->order, capacity * sizeof(int));
+        if (!order) {
+            return 0;
+        }
+        queue->order = order;
+        queue->capacity = capacity;
+    }
+
+    if (!queue->length) {
+        queue->dst = dst;
+        ++dst->refcount;
+    }
+    blit = &queue->blits[queue->length++];
+    blit->blitter = blitter;
+    blit->info = *info;
+    blit->src = src;
+    ++src->refcount;
+    blit->rect = *rect;
+    return 1;
+}
+
+/* Puts the queued blits in waves and their indices in queue->order, sorted
+ * by wave. Returns the number of waves. */
+static int
+_blit_queue_sort(pg_BlitQueue *queue)
+{
+    SDL_Surface *dst = queue->dst;
+    int gw = ((dst->w - 1) >> PG_BLIT_QUEUE_CELL_SHIFT) + 1;
+    int gh = ((dst->h - 1) >> PG_BLIT_QUEUE_CELL_SHIFT) + 1;
+    int *cells, *starts;
+    int i, x, y, x0, x1, y0, y1, wave, waves = 0;
+    pg_QueuedBlit *blit;
+
+    /* Each cell holds the latest wave drawing into it. A blit goes in the
+     * wave after the latest of its cells, so after every earlier blit it
+     * overlaps. Blits sharing a cell without overlapping are kept apart
+     * too, which costs some parallelism but no correctness. */
+    cells = (int *)calloc((size_t)gw * gh, sizeof(int));
+    if (!cells) {
+        /* one blit per wave, in the order they were queued */
+        for (i = 0; i < queue->length; i++) {
+            queue->blits[i].wave = i;
+            queue->order[i] = i;
+        }
+        return queue->length;
+    }
+    for (i = 0; i < queue->length; i++) {
+        blit = &queue->blits[i];
+        x0 = blit->rect.x >> PG_BLIT_QUEUE_CELL_SHIFT;
+        y0 = blit->rect.y >> PG_BLIT_QUEUE_CELL_SHIFT;
+        x1 = (blit->rect.x + blit->rect.w - 1) >> PG_BLIT_QUEUE_CELL_SHIFT;
+        y1 = (blit->rect.y + blit->rect.h - 1) >> PG_BLIT_QUEUE_CELL_SHIFT;
+        wave = 0;
+        for (y = y0; y <= y1; y++) {
+            for (x = x0; x <= x1; x++) {
+                if (cells[y * gw + x] > wave) {
+                    wave = cells[y * gw + x];
+                }
+            }
+        }
+        for (y = y0; y <= y1; y++) {
+            for (x = x0; x <= x1; x++) {
+                cells[y * gw + x] = wave + 1;
+            }
+        }
+        blit->wave = wave;
+        if (wave >= waves) {
+            waves = wave + 1;
+        }
+    }
+    free(cells);
+
+    /* a counting sort, which keeps the queue order within a wave */
+    starts = (int *)calloc(waves + 1, sizeof(int));
+    if (!starts) {
+        for (i = 0; i < queue->length; i++) {
+            queue->blits[i].wave = i;
+            queue->order[i] = i;
+        }
+        return queue->length;
+    }
+    for (i = 0; i < queue->length; i++) {
+        starts[queue->blits[i].wave + 1]++;
+    }
+    for (wave = 0; wave < waves; wave++) {
+        starts[wave + 1] += starts[wave];
+    }
+    for (i = 0; i < queue->length; i++) {
+        queue->order[starts[queue->blits[i].wave]++] = i;
+    }
+    free(starts);
+    return waves;
+}
+
+void
+pg_blit_queue_flush(pg_BlitQueue *queue)
+{
+    PyThreadState *save = NULL;
+    int i, start, end;
+
+    if (!queue || !queue->length) {
+        return;
+    }
+
+    _blit_queue_sort(queue);
+
+    /* the caller may have released the GIL already, see pg_nogil_begin() */
+    if (PyGILState_Check()) {
+        save = PyEval_SaveThread();
+    }
+    for (start = 0; start < queue->length; start = end) {
+        int wave = queue->blits[queue->order[start]].wave;
+
+        end = start + 1;
+        while (end < queue->length &&
+               queue->blits[queue->order[end]].wave == wave) {
+            end++;
+        }
+        _blit_run_wave(queue->blits, queue->order + start, end - start);
+    }
+    if (save) {
+        PyEval_RestoreThread(save);
+    }
+
+    for (i = 0; i < queue->length; i++) {
+        SDL_FreeSurface(queue->blits[i].src);
+    }
+    SDL_FreeSurface(queue->dst);
+    queue->dst = NULL;
+    queue->length = 0;
+}
+
+/* Names of the kernels SoftBlitPyGame() may pick, for blit tracing. Only
+ * looked up on request, so the blit itself just passes the function back. */
+#define _PG_KERNEL(f, simd) {f, #f, simd}
+
+static const struct {
+    pg_BlitKernel blitter;
+    const char *name;
+    int simd;
+} blit_kernel_names[] = {
+    _PG_KERNEL(alphablit_alpha, 0),
+    _PG_KERNEL(alphablit_colorkey, 0),
+    _PG_KERNEL(alphablit_solid, 0),
+    _PG_KERNEL(alphablit_copy, 0),
+    _PG_KERNEL(blit_blend_add, 0),
+    _PG_KERNEL(blit_blend_sub, 0),
+    _PG_KERNEL(blit_blend_mul, 0),
+    _PG_KERNEL(blit_blend_min, 0),
+    _PG_KERNEL(blit_blend_max, 0),
+    _PG_KERNEL(blit_blend_rgba_add, 0),
+    _PG_KERNEL(blit_blend_rgba_sub, 0),
+    _PG_KERNEL(blit_blend_rgba_mul, 0),
+    _PG_KERNEL(blit_blend_rgba_min, 0),
+    _PG_KERNEL(blit_blend_rgba_max, 0),
+    _PG_KERNEL(blit_blend_premultiplied, 0),
+    _PG_KERNEL(blit_blend_custom, 0),
+#if !defined(__EMSCRIPTEN__)
+#if SDL_BYTEORDER == SDL_LIL_ENDIAN
+    _PG_KERNEL(alphablit_alpha_avx2_argb_surf_alpha, 1),
+    _PG_KERNEL(alphablit_alpha_avx2_argb_no_surf_alpha, 1),
+    _PG_KERNEL(alphablit_alpha_avx2_argb_no_surf_alpha_opaque_dst, 1),
+    _PG_KERNEL(alphablit_colorkey_avx2_argb, 1),
+    _PG_KERNEL(alphablit_solid_avx2_argb, 1),
+    _PG_KERNEL(blit_blend_rgb_add_avx2, 1),
+    _PG_KERNEL(blit_blend_rgb_sub_avx2, 1),
+    _PG_KERNEL(blit_blend_rgb_mul_avx2, 1),
+    _PG_KERNEL(blit_blend_rgb_min_avx2, 1),
+    _PG_KERNEL(blit_blend_rgb_max_avx2, 1),
+    _PG_KERNEL(blit_blend_rgba_add_avx2, 1),
+    _PG_KERNEL(blit_blend_rgba_sub_avx2, 1),
+    _PG_KERNEL(blit_blend_rgba_mul_avx2, 1),
+    _PG_KERNEL(blit_blend_rgba_min_avx2, 1),
+    _PG_KERNEL(blit_blend_rgba_max_avx2, 1),
+    _PG_KERNEL(blit_blend_premultiplied_avx2, 1),
+#if PG_ENABLE_SSE_NEON
+    _PG_KERNEL(alphablit_alpha_sse2_argb_surf_alpha, 1),
+    _PG_KERNEL(alphablit_alpha_sse2_argb_no_surf_alpha, 1),
+    _PG_KERNEL(alphablit_alpha_sse2_argb_no_surf_alpha_opaque_dst, 1),
+    _PG_KERNEL(alphablit_colorkey_sse2_argb, 1),
+    _PG_KERNEL(alphablit_alpha_sse2_argb_565, 1),
+    _PG_KERNEL(alphablit_solid_sse2_argb, 1),
+    _PG_KERNEL(blit_blend_rgb_add_sse2, 1),
+    _PG_KERNEL(blit_blend_rgb_sub_sse2, 1),
+    _PG_KERNEL(blit_blend_rgb_mul_sse2, 1),
+    _PG_KERNEL(blit_blend_rgb_min_sse2, 1),
+    _PG_KERNEL(blit_blend_rgb_max_sse2, 1),
+    _PG_KERNEL(blit_blend_rgba_add_sse2, 1),
+    _PG_KERNEL(blit_blend_rgba_sub_sse2, 1),
+    _PG_KERNEL(blit_blend_rgba_mul_sse2, 1),
+    _PG_KERNEL(blit_blend_rgba_min_sse2, 1),
+    _PG_KERNEL(blit_blend_rgba_max_sse2, 1),
+    _PG_KERNEL(blit_blend_premultiplied_sse2, 1),
+    _PG_KERNEL(blit_blend_custom_sse2, 1),
+#endif /* PG_ENABLE_SSE_NEON */
+#endif /* SDL_BYTEORDER == SDL_LIL_ENDIAN */
+#endif /* __EMSCRIPTEN__ */
+};
+
+const char *
+pg_blit_kernel_name(pg_BlitKernel kernel, int *simd)
+{
+    size_t i;
+
+    for (i = 0; i < SDL_arraysize(blit_kernel_names); i++) {
+        if (blit_kernel_names[i].blitter == kernel) {
+            *simd = blit_kernel_names[i].simd;
+            return blit_kernel_names[i].name;
+        }
+    }
+    *simd = 0;
+    return NULL;
+}
+
+/* The SIMD solid and colorkey blitters handle 32 bit surfaces which share
+ * the same byte aligned 8 bit RGB channels, with the destination alpha (if
+ * any) in the remaining byte. They walk the pixels forwards only, so an
+ * overlapping self blit that had to be reversed stays on the scalar path. */
+static int
+_pg_has_simd_solid_formats(SDL_BlitInfo *info)
+{
+    SDL_PixelFormat *srcfmt = info->src;
+    SDL_PixelFormat *dstfmt = info->dst;
+
+    if (PG_FORMAT_BytesPerPixel(srcfmt) != 4 ||
+        PG_FORMAT_BytesPerPixel(dstfmt) != 4 || info->s_pxskip < 0) {
+        return 0;
+    }
+    if (srcfmt->Rmask != dstfmt->Rmask || srcfmt->Gmask != dstfmt->Gmask ||
+        srcfmt->Bmask != dstfmt->Bmask) {
+        return 0;
+    }
+    if (dstfmt->Rloss || dstfmt->Gloss || dstfmt->Bloss ||
+        dstfmt->Rshift % 8 || dstfmt->Gshift % 8 || dstfmt->Bshift % 8) {
+        return 0;
+    }
+    return !dstfmt->Amask ||
+           dstfmt->Amask == ~(dstfmt->Rmask | dstfmt->Gmask | dstfmt->Bmask);
+}
+
+/* SDL_GetRGB() widens the channels of all formats with the same tables, so
+ * they are checked against PG_WIDEN_5() and PG_WIDEN_6() only once */
+int
+pg_has_simd_565_format(SDL_PixelFormat *fmt)
+{
+    static int widens_alike = -1;
+    Uint8 r, g, b;
+    Uint32 v;
+
+    if (PG_FORMAT_BytesPerPixel(fmt) != 2 || fmt->Amask || fmt->Rloss != 3 ||
+        fmt->Gloss != 2 || fmt->Bloss != 3 || fmt->Gshift != 5 ||
+        fmt->Rshift + fmt->Bshift != 11 || (fmt->Rshift && fmt->Bshift)) {
+        return 0;
+    }
+    if (widens_alike < 0) {
+        widens_alike = 1;
+        for (v = 0; v < 64 && widens_alike; v++) {
+            SDL_GetRGB((v & 0x1F) << fmt->Rshift | v << 5 |
+                           (v & 0x1F) << fmt->Bshift,
+                       fmt, &r, &g, &b);
+            widens_alike = r == PG_WIDEN_5(v & 0x1F) && g == PG_WIDEN_6(v) &&
+                           b == PG_WIDEN_5(v & 0x1F);
+        }
+    }
+    return widens_alike;
+}
+
+/* The SIMD alpha blitter for RGB565 and BGR565 destinations takes 32 bit
+ * sources with byte aligned 8 bit channels */
+static int
+_pg_has_simd_argb_565_formats(SDL_BlitInfo *info)
+{
+    SDL_PixelFormat *srcfmt = info->src;
+
+    if (PG_FORMAT_BytesPerPixel(srcfmt) != 4 || !srcfmt->Amask ||
+        srcfmt->Rloss || srcfmt->Gloss || srcfmt->Bloss || srcfmt->Aloss ||
+        srcfmt->Rshift % 8 || srcfmt->Gshift % 8 || srcfmt->Bshift % 8 ||
+        srcfmt->Ashift % 8) {
+        return 0;
+    }
+    return pg_has_simd_565_format(info->dst);
+}
+
+/* How alphablit_spans() copies opaque runs */
+#define PG_SPAN_COPY_NONE 0 /* blend them like the others */
+#define PG_SPAN_COPY_RAW 1  /* same format, the pixels as they are */
+#define PG_SPAN_COPY_RGB 2  /* no destination alpha, the colors only */
+
+/* Whether the blit set up in info is worth doing with spans, which it then
+ * sets up. Alpha and colorkey blits skip transparent runs and may copy
+ * opaque ones, the blend modes which add nothing for a pixel of 0 skip the
+ * PG_SPAN_ZERO runs. Only if enough of the source is skipped or copied to
+ * make up for blending the rest run by run. */
+static int
+_blit_use_spans(SDL_BlitInfo *info, const pg_AlphaSpans *spans,
+                SDL_Rect *srcrect, int blend_flags)
+{
+    SDL_PixelFormat *srcfmt = info->src, *dstfmt = info->dst;
+    int srcbpp = PG_FORMAT_BytesPerPixel(srcfmt);
+    int dstbpp = PG_FORMAT_BytesPerPixel(dstfmt);
+    int srcppa = info->src_blend != SDL_BLENDMODE_NONE && srcfmt->Amask;
+    Sint64 area = (Sint64)spans->w * spans->h;
+
+    if (srcbpp < 2 || dstbpp < 2 || info->s_pxskip < 0 ||
+        srcrect->x + info->width > spans->w ||
+        srcrect->y + info->height > spans->h) {
+        return 0;
+    }
+    /* kernels for an opaque destination set the alpha of every pixel they
+     * touch, so nothing may be skipped for them */
+    if (dstfmt->Amask && info->dst_blend == SDL_BLENDMODE_NONE) {
+        return 0;
+    }
+
+    info->span_copy = PG_SPAN_COPY_NONE;
+    info->span_zero = 0;
+    switch (blend_flags) {
+        case 0:
+            /* the runs have to be found the way the kernel tells pixels
+             * apart */
+            if (srcppa ? spans->keyed
+                       : !info->src_has_colorkey || !spans->keyed ||
+                             spans->colorkey != info->src_colorkey) {
+                return 0;
+            }
+            if (spans->skipped * 4 < area) {
+                return 0;
+            }
+            if (info->src_blanket_alpha == 255 && !info->src_has_tint &&
+                srcbpp == dstbpp &&
+                srcfmt->Rmask == dstfmt->Rmask &&
+                srcfmt->Gmask == dstfmt->Gmask &&
+                srcfmt->Bmask == dstfmt->Bmask) {
+                if (!dstfmt->Amask && !srcfmt->Amask) {
+                    info->span_copy = PG_SPAN_COPY_RAW;
+                }
+                else if (!dstfmt->Amask && srcbpp == 4) {
+                    info->span_copy = PG_SPAN_COPY_RGB;
+                }
+                else if (dstfmt->Amask == srcfmt->Amask &&
+                         info->dst_blend != SDL_BLENDMODE_NONE) {
+                    info->span_copy = PG_SPAN_COPY_RAW;
+                }
+            }
+            break;
+        case PYGAME_BLEND_RGBA_ADD:
+        case PYGAME_BLEND_RGBA_SUB:
+        case PYGAME_BLEND_RGBA_MAX:
+        case PYGAME_BLEND_PREMULTIPLIED:
+            /* without blended alpha a pixel of 0 is opaque black */
+            if (!srcppa) {
+                return 0;
+            }
+            /* fall through */
+        case PYGAME_BLEND_ADD:
+        case PYGAME_BLEND_SUB:
+        case PYGAME_BLEND_MAX:
+            if (spans->zeros * 4 < area) {
+                return 0;
+            }
+            info->span_zero = 1;
+            break;
+        default:
+            return 0;
+    }
+
+    info->src_spans = spans;
+    info->span_x = srcrect->x;
+    info->span_y = srcrect->y;
+    return 1;
+}
+
+/* Whether the factors and operations of PYGAME_BLEND_CUSTOM flags are all
+ * ones the kernels know */
+static int
+_blend_custom_valid(Uint32 mode)
+{
+    int i;
+
+    for (i = 0; i < 6; i++) {
+        int value = PG_BLEND_CUSTOM_FIELD(mode, i);
+        int last = (i % 3 == 2) ? SDL_BLENDOPERATION_MAXIMUM
+                                : SDL_BLENDFACTOR_ONE_MINUS_DST_ALPHA;
+
+        if (value < 1 || value > last) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
 static int
 SoftBlitPyGame(SDL_Surface *src, SDL_Rect *srcrect, SDL_Surface *dst,
-               SDL_Rect *dstrect, int blend_flags)
+               SDL_Rect *dstrect, int blend_flags, const pg_AlphaSpans *spans,
+               pg_BlitQueue *queue, pg_BlitKernel *kernel)
 {
     int okay;
     int src_locked;
@@ -97,6 +960,7 @@ SoftBlitPyGame(SDL_Surface *src, SDL_Rect *srcrect, SDL_Surface *dst,
     /* Set up source and destination buffer pointers, and BLIT! */
     if (okay && srcrect->w && srcrect->h) {
         SDL_BlitInfo info;
+        pg_BlitKernel blitter = NULL;
 
         /* Set up the blit information */
         info.width = srcrect->w;
@@ -114,6 +978,10 @@ SoftBlitPyGame(SDL_Surface *src, SDL_Rect *srcrect, SDL_Surface *dst,
         info.src = src->format;
         info.dst = dst->format;
         SDL_GetSurfaceAlphaMod(src, &info.src_blanket_alpha);
+        SDL_GetSurfaceColorMod(src, &info.src_tint[0], &info.src_tint[1],
+                               &info.src_tint[2]);
+        info.src_has_tint =
+            (info.src_tint[0] & info.src_tint[1] & info.src_tint[2]) != 255;
         if ((info.src_has_colorkey = SDL_HasColorKey(src))) {
             SDL_GetColorKey(src, &info.src_colorkey);
         }
@@ -154,6 +1022,15 @@ SoftBlitPyGame(SDL_Surface *src, SDL_Rect *srcrect, SDL_Surface *dst,
                 blend_flags = PYGAME_BLEND_MULT;
             }
 
+            /* pygame.BlendMode flags carry their blend equations along */
+            info.src_spans = NULL;
+            info.blend_custom = 0;
+            if ((blend_flags & ~PYGAME_BLEND_CUSTOM_MASK) ==
+                PYGAME_BLEND_CUSTOM) {
+                info.blend_custom = (Uint32)blend_flags;
+                blend_flags = PYGAME_BLEND_CUSTOM;
+            }
+
             switch (blend_flags) {
                 case 0: {
                     if (info.src_blend != SDL_BLENDMODE_NONE &&
@@ -169,53 +1046,104 @@ SoftBlitPyGame(SDL_Surface *src, SDL_Rect *srcrect, SDL_Surface *dst,
                                32bit format we can use SSE2/NEON/AVX2 to speed
                                up the blend */
                             if (pg_has_avx2() && (src != dst)) {
-                                if (info.src_blanket_alpha != 255) {
-                                    alphablit_alpha_avx2_argb_surf_alpha(
-                                        &info);
+                                if (info.src_blanket_alpha != 255 ||
+                                    info.src_has_tint) {
+                                    blitter =
+                                        alphablit_alpha_avx2_argb_surf_alpha;
                                 }
                                 else if (SDL_ISPIXELFORMAT_ALPHA(
                                              dst->format->format) &&
                                          info.dst_blend !=
                                              SDL_BLENDMODE_NONE) {
-                                    alphablit_alpha_avx2_argb_no_surf_alpha(
-                                        &info);
+                                    blitter =
+                                        alphablit_alpha_avx2_argb_no_surf_alpha;
                                 }
                                 else {
-                                    alphablit_alpha_avx2_argb_no_surf_alpha_opaque_dst(
-                                        &info);
+                                    blitter =
+                                        alphablit_alpha_avx2_argb_no_surf_alpha_opaque_dst;
                                 }
                                 break;
                             }
 #if PG_ENABLE_SSE_NEON
                             if ((pg_HasSSE_NEON()) && (src != dst)) {
-                                if (info.src_blanket_alpha != 255) {
-                                    alphablit_alpha_sse2_argb_surf_alpha(
-                                        &info);
+                                if (info.src_blanket_alpha != 255 ||
+                                    info.src_has_tint) {
+                                    blitter =
+                                        alphablit_alpha_sse2_argb_surf_alpha;
                                 }
                                 else if (SDL_ISPIXELFORMAT_ALPHA(
                                              dst->format->format) &&
                                          info.dst_blend !=
                                              SDL_BLENDMODE_NONE) {
-                                    alphablit_alpha_sse2_argb_no_surf_alpha(
-                                        &info);
+                                    blitter =
+                                        alphablit_alpha_sse2_argb_no_surf_alpha;
                                 }
                                 else {
-                                    alphablit_alpha_sse2_argb_no_surf_alpha_opaque_dst(
-                                        &info);
+                                    blitter =
+                                        alphablit_alpha_sse2_argb_no_surf_alpha_opaque_dst;
                                 }
                                 break;
                             }
 #endif /* PG_ENABLE_SSE_NEON */
                         }
+#if PG_ENABLE_SSE_NEON
+                        if (pg_HasSSE_NEON() && !info.src_has_tint &&
+                            _pg_has_simd_argb_565_formats(&info)) {
+                            blitter = alphablit_alpha_sse2_argb_565;
+                            break;
+                        }
+#endif /* PG_ENABLE_SSE_NEON */
+#endif /* SDL_BYTEORDER == SDL_LIL_ENDIAN */
+#endif /* __EMSCRIPTEN__ */
+                        blitter = alphablit_alpha;
+                    }
+                    else if (info.src_has_colorkey) {
+#if !defined(__EMSCRIPTEN__)
+#if SDL_BYTEORDER == SDL_LIL_ENDIAN
+                        if (_pg_has_simd_solid_formats(&info)) {
+                            if (pg_has_avx2()) {
+                                blitter = alphablit_colorkey_avx2_argb;
+                                break;
+                            }
+#if PG_ENABLE_SSE_NEON
+                            if (pg_HasSSE_NEON()) {
+                                blitter = alphablit_colorkey_sse2_argb;
+                                break;
+                            }
+#endif /* PG_ENABLE_SSE_NEON */
+                        }
+#endif /* SDL_BYTEORDER == SDL_LIL_ENDIAN */
+#endif /* __EMSCRIPTEN__ */
+                        blitter = alphablit_colorkey;
+                    }
+                    else {
+                        /* opaque pixels of the same format are copied
+                           as they are, like SDL does */
+                        if (info.src->format == info.dst->format &&
+                            !info.src->Amask &&
+                            !SDL_ISPIXELFORMAT_INDEXED(info.src->format) &&
+                            info.src_blanket_alpha == 255 &&
+                            !info.src_has_tint) {
+                            blitter = alphablit_copy;
+                            break;
+                        }
+#if !defined(__EMSCRIPTEN__)
+#if SDL_BYTEORDER == SDL_LIL_ENDIAN
+                        if (_pg_has_simd_solid_formats(&info)) {
+                            if (pg_has_avx2()) {
+                                blitter = alphablit_solid_avx2_argb;
+                                break;
+                            }
+#if PG_ENABLE_SSE_NEON
+                            if (pg_HasSSE_NEON()) {
+                                blitter = alphablit_solid_sse2_argb;
+                                break;
+                            }
+#endif /* PG_ENABLE_SSE_NEON */
+                        }
 #endif /* SDL_BYTEORDER == SDL_LIL_ENDIAN */
 #endif /* __EMSCRIPTEN__ */
-                        alphablit_alpha(&info);
-                    }
-                    else if (info.src_has_colorkey) {
-                        alphablit_colorkey(&info);
-                    }
-                    else {
-                        alphablit_solid(&info);
+                        blitter = alphablit_solid;
                     }
                     break;
                 }
@@ -230,7 +1158,7 @@ SoftBlitPyGame(SDL_Surface *src, SDL_Rect *srcrect, SDL_Surface *dst,
                         !(src->format->Amask != 0 && dst->format->Amask != 0 &&
                           src->format->Amask != dst->format->Amask) &&
                         pg_has_avx2() && (src != dst)) {
-                        blit_blend_rgb_add_avx2(&info);
+                        blitter = blit_blend_rgb_add_avx2;
                         break;
                     }
 #if PG_ENABLE_SSE_NEON
@@ -242,13 +1170,13 @@ SoftBlitPyGame(SDL_Surface *src, SDL_Rect *srcrect, SDL_Surface *dst,
                         !(src->format->Amask != 0 && dst->format->Amask != 0 &&
                           src->format->Amask != dst->format->Amask) &&
                         pg_HasSSE_NEON() && (src != dst)) {
-                        blit_blend_rgb_add_sse2(&info);
+                        blitter = blit_blend_rgb_add_sse2;
                         break;
                     }
 #endif /* PG_ENABLE_SSE_NEON */
 #endif /* SDL_BYTEORDER == SDL_LIL_ENDIAN */
 #endif /* __EMSCRIPTEN__ */
-                    blit_blend_add(&info);
+                    blitter = blit_blend_add;
                     break;
                 }
                 case PYGAME_BLEND_SUB: {
@@ -262,7 +1190,7 @@ SoftBlitPyGame(SDL_Surface *src, SDL_Rect *srcrect, SDL_Surface *dst,
                         !(src->format->Amask != 0 && dst->format->Amask != 0 &&
                           src->format->Amask != dst->format->Amask) &&
                         pg_has_avx2() && (src != dst)) {
-                        blit_blend_rgb_sub_avx2(&info);
+                        blitter = blit_blend_rgb_sub_avx2;
                         break;
                     }
 #if PG_ENABLE_SSE_NEON
@@ -274,13 +1202,13 @@ SoftBlitPyGame(SDL_Surface *src, SDL_Rect *srcrect, SDL_Surface *dst,
                         !(src->format->Amask != 0 && dst->format->Amask != 0 &&
                           src->format->Amask != dst->format->Amask) &&
                         pg_HasSSE_NEON() && (src != dst)) {
-                        blit_blend_rgb_sub_sse2(&info);
+                        blitter = blit_blend_rgb_sub_sse2;
                         break;
                     }
 #endif /* PG_ENABLE_SSE_NEON */
 #endif /* SDL_BYTEORDER == SDL_LIL_ENDIAN */
 #endif /* __EMSCRIPTEN__ */
-                    blit_blend_sub(&info);
+                    blitter = blit_blend_sub;
                     break;
                 }
                 case PYGAME_BLEND_MULT: {
@@ -294,7 +1222,7 @@ SoftBlitPyGame(SDL_Surface *src, SDL_Rect *srcrect, SDL_Surface *dst,
                         !(src->format->Amask != 0 && dst->format->Amask != 0 &&
                           src->format->Amask != dst->format->Amask) &&
                         pg_has_avx2() && (src != dst)) {
-                        blit_blend_rgb_mul_avx2(&info);
+                        blitter = blit_blend_rgb_mul_avx2;
                         break;
                     }
 #if PG_ENABLE_SSE_NEON
@@ -306,13 +1234,13 @@ SoftBlitPyGame(SDL_Surface *src, SDL_Rect *srcrect, SDL_Surface *dst,
                         !(src->format->Amask != 0 && dst->format->Amask != 0 &&
                           src->format->Amask != dst->format->Amask) &&
                         pg_HasSSE_NEON() && (src != dst)) {
-                        blit_blend_rgb_mul_sse2(&info);
+                        blitter = blit_blend_rgb_mul_sse2;
                         break;
                     }
 #endif /* PG_ENABLE_SSE_NEON */
 #endif /* SDL_BYTEORDER == SDL_LIL_ENDIAN */
 #endif /* __EMSCRIPTEN__ */
-                    blit_blend_mul(&info);
+                    blitter = blit_blend_mul;
                     break;
                 }
                 case PYGAME_BLEND_MIN: {
@@ -326,7 +1254,7 @@ SoftBlitPyGame(SDL_Surface *src, SDL_Rect *srcrect, SDL_Surface *dst,
                         !(src->format->Amask != 0 && dst->format->Amask != 0 &&
                           src->format->Amask != dst->format->Amask) &&
                         pg_has_avx2() && (src != dst)) {
-                        blit_blend_rgb_min_avx2(&info);
+                        blitter = blit_blend_rgb_min_avx2;
                         break;
                     }
 #if PG_ENABLE_SSE_NEON
@@ -338,13 +1266,13 @@ SoftBlitPyGame(SDL_Surface *src, SDL_Rect *srcrect, SDL_Surface *dst,
                         !(src->format->Amask != 0 && dst->format->Amask != 0 &&
                           src->format->Amask != dst->format->Amask) &&
                         pg_HasSSE_NEON() && (src != dst)) {
-                        blit_blend_rgb_min_sse2(&info);
+                        blitter = blit_blend_rgb_min_sse2;
                         break;
                     }
 #endif /* PG_ENABLE_SSE_NEON */
 #endif /* SDL_BYTEORDER == SDL_LIL_ENDIAN */
 #endif /* __EMSCRIPTEN__ */
-                    blit_blend_min(&info);
+                    blitter = blit_blend_min;
                     break;
                 }
                 case PYGAME_BLEND_MAX: {
@@ -358,7 +1286,7 @@ SoftBlitPyGame(SDL_Surface *src, SDL_Rect *srcrect, SDL_Surface *dst,
                         !(src->format->Amask != 0 && dst->format->Amask != 0 &&
                           src->format->Amask != dst->format->Amask) &&
                         pg_has_avx2() && (src != dst)) {
-                        blit_blend_rgb_max_avx2(&info);
+                        blitter = blit_blend_rgb_max_avx2;
                         break;
                     }
 #if PG_ENABLE_SSE_NEON
@@ -370,13 +1298,13 @@ SoftBlitPyGame(SDL_Surface *src, SDL_Rect *srcrect, SDL_Surface *dst,
                         !(src->format->Amask != 0 && dst->format->Amask != 0 &&
                           src->format->Amask != dst->format->Amask) &&
                         pg_HasSSE_NEON() && (src != dst)) {
-                        blit_blend_rgb_max_sse2(&info);
+                        blitter = blit_blend_rgb_max_sse2;
                         break;
                     }
 #endif /* PG_ENABLE_SSE_NEON */
 #endif /* SDL_BYTEORDER == SDL_LIL_ENDIAN */
 #endif /* __EMSCRIPTEN__ */
-                    blit_blend_max(&info);
+                    blitter = blit_blend_max;
                     break;
                 }
 
@@ -390,7 +1318,7 @@ SoftBlitPyGame(SDL_Surface *src, SDL_Rect *srcrect, SDL_Surface *dst,
                         src->format->Bmask == dst->format->Bmask &&
                         info.src_blend != SDL_BLENDMODE_NONE &&
                         pg_has_avx2() && (src != dst)) {
-                        blit_blend_rgba_add_avx2(&info);
+                        blitter = blit_blend_rgba_add_avx2;
                         break;
                     }
 #if PG_ENABLE_SSE_NEON
@@ -401,13 +1329,13 @@ SoftBlitPyGame(SDL_Surface *src, SDL_Rect *srcrect, SDL_Surface *dst,
                         src->format->Bmask == dst->format->Bmask &&
                         info.src_blend != SDL_BLENDMODE_NONE &&
                         pg_HasSSE_NEON() && (src != dst)) {
-                        blit_blend_rgba_add_sse2(&info);
+                        blitter = blit_blend_rgba_add_sse2;
                         break;
                     }
 #endif /* PG_ENABLE_SSE_NEON */
 #endif /* SDL_BYTEORDER == SDL_LIL_ENDIAN */
 #endif /* __EMSCRIPTEN__ */
-                    blit_blend_rgba_add(&info);
+                    blitter = blit_blend_rgba_add;
                     break;
                 }
                 case PYGAME_BLEND_RGBA_SUB: {
@@ -420,7 +1348,7 @@ SoftBlitPyGame(SDL_Surface *src, SDL_Rect *srcrect, SDL_Surface *dst,
                         src->format->Bmask == dst->format->Bmask &&
                         info.src_blend != SDL_BLENDMODE_NONE &&
                         pg_has_avx2() && (src != dst)) {
-                        blit_blend_rgba_sub_avx2(&info);
+                        blitter = blit_blend_rgba_sub_avx2;
                         break;
                     }
 #if PG_ENABLE_SSE_NEON
@@ -431,13 +1359,13 @@ SoftBlitPyGame(SDL_Surface *src, SDL_Rect *srcrect, SDL_Surface *dst,
                         src->format->Bmask == dst->format->Bmask &&
                         info.src_blend != SDL_BLENDMODE_NONE &&
                         pg_HasSSE_NEON() && (src != dst)) {
-                        blit_blend_rgba_sub_sse2(&info);
+                        blitter = blit_blend_rgba_sub_sse2;
                         break;
                     }
 #endif /* PG_ENABLE_SSE_NEON */
 #endif /* SDL_BYTEORDER == SDL_LIL_ENDIAN */
 #endif /* __EMSCRIPTEN__ */
-                    blit_blend_rgba_sub(&info);
+                    blitter = blit_blend_rgba_sub;
                     break;
                 }
                 case PYGAME_BLEND_RGBA_MULT: {
@@ -450,7 +1378,7 @@ SoftBlitPyGame(SDL_Surface *src, SDL_Rect *srcrect, SDL_Surface *dst,
                         src->format->Bmask == dst->format->Bmask &&
                         info.src_blend != SDL_BLENDMODE_NONE &&
                         pg_has_avx2() && (src != dst)) {
-                        blit_blend_rgba_mul_avx2(&info);
+                        blitter = blit_blend_rgba_mul_avx2;
                         break;
                     }
 #if PG_ENABLE_SSE_NEON
@@ -461,13 +1389,13 @@ SoftBlitPyGame(SDL_Surface *src, SDL_Rect *srcrect, SDL_Surface *dst,
                         src->format->Bmask == dst->format->Bmask &&
                         info.src_blend != SDL_BLENDMODE_NONE &&
                         pg_HasSSE_NEON() && (src != dst)) {
-                        blit_blend_rgba_mul_sse2(&info);
+                        blitter = blit_blend_rgba_mul_sse2;
                         break;
                     }
 #endif /* PG_ENABLE_SSE_NEON */
 #endif /* SDL_BYTEORDER == SDL_LIL_ENDIAN */
 #endif /* __EMSCRIPTEN__ */
-                    blit_blend_rgba_mul(&info);
+                    blitter = blit_blend_rgba_mul;
                     break;
                 }
                 case PYGAME_BLEND_RGBA_MIN: {
@@ -480,7 +1408,7 @@ SoftBlitPyGame(SDL_Surface *src, SDL_Rect *srcrect, SDL_Surface *dst,
                         src->format->Bmask == dst->format->Bmask &&
                         info.src_blend != SDL_BLENDMODE_NONE &&
                         pg_has_avx2() && (src != dst)) {
-                        blit_blend_rgba_min_avx2(&info);
+                        blitter = blit_blend_rgba_min_avx2;
                         break;
                     }
 #if PG_ENABLE_SSE_NEON
@@ -491,13 +1419,13 @@ SoftBlitPyGame(SDL_Surface *src, SDL_Rect *srcrect, SDL_Surface *dst,
                         src->format->Bmask == dst->format->Bmask &&
                         info.src_blend != SDL_BLENDMODE_NONE &&
                         pg_HasSSE_NEON() && (src != dst)) {
-                        blit_blend_rgba_min_sse2(&info);
+                        blitter = blit_blend_rgba_min_sse2;
                         break;
                     }
 #endif /* PG_ENABLE_SSE_NEON */
 #endif /* SDL_BYTEORDER == SDL_LIL_ENDIAN */
 #endif /* __EMSCRIPTEN__ */
-                    blit_blend_rgba_min(&info);
+                    blitter = blit_blend_rgba_min;
                     break;
                 }
                 case PYGAME_BLEND_RGBA_MAX: {
@@ -510,7 +1438,7 @@ SoftBlitPyGame(SDL_Surface *src, SDL_Rect *srcrect, SDL_Surface *dst,
                         src->format->Bmask == dst->format->Bmask &&
                         info.src_blend != SDL_BLENDMODE_NONE &&
                         pg_has_avx2() && (src != dst)) {
-                        blit_blend_rgba_max_avx2(&info);
+                        blitter = blit_blend_rgba_max_avx2;
                         break;
                     }
 #if PG_ENABLE_SSE_NEON
@@ -521,13 +1449,13 @@ SoftBlitPyGame(SDL_Surface *src, SDL_Rect *srcrect, SDL_Surface *dst,
                         src->format->Bmask == dst->format->Bmask &&
                         info.src_blend != SDL_BLENDMODE_NONE &&
                         pg_HasSSE_NEON() && (src != dst)) {
-                        blit_blend_rgba_max_sse2(&info);
+                        blitter = blit_blend_rgba_max_sse2;
                         break;
                     }
 #endif /* PG_ENABLE_SSE_NEON */
 #endif /* SDL_BYTEORDER == SDL_LIL_ENDIAN */
 #endif /* __EMSCRIPTEN__ */
-                    blit_blend_rgba_max(&info);
+                    blitter = blit_blend_rgba_max;
                     break;
                 }
                 case PYGAME_BLEND_PREMULTIPLIED: {
@@ -540,7 +1468,7 @@ SoftBlitPyGame(SDL_Surface *src, SDL_Rect *srcrect, SDL_Surface *dst,
                         src->format->Bmask == dst->format->Bmask &&
                         info.src_blend != SDL_BLENDMODE_NONE &&
                         pg_has_avx2() && (src != dst)) {
-                        blit_blend_premultiplied_avx2(&info);
+                        blitter = blit_blend_premultiplied_avx2;
                         break;
                     }
 #if PG_ENABLE_SSE_NEON
@@ -549,17 +1477,44 @@ SoftBlitPyGame(SDL_Surface *src, SDL_Rect *srcrect, SDL_Surface *dst,
                         src->format->Rmask == dst->format->Rmask &&
                         src->format->Gmask == dst->format->Gmask &&
                         src->format->Bmask == dst->format->Bmask &&
-                        src->format->Amask == 0xFF000000 &&
+                        src->format->Amask &&
                         info.src_blend != SDL_BLENDMODE_NONE &&
                         pg_HasSSE_NEON() && (src != dst)) {
-                        blit_blend_premultiplied_sse2(&info);
+                        blitter = blit_blend_premultiplied_sse2;
+                        break;
+                    }
+#endif /* PG_ENABLE_SSE_NEON */
+#endif /* SDL_BYTEORDER == SDL_LIL_ENDIAN */
+#endif /* __EMSCRIPTEN__ */
+
+                    blitter = blit_blend_premultiplied;
+                    break;
+                }
+                case PYGAME_BLEND_CUSTOM: {
+                    if (!_blend_custom_valid(info.blend_custom)) {
+                        SDL_SetError("Invalid argument passed to blit.");
+                        okay = 0;
+                        break;
+                    }
+#if !defined(__EMSCRIPTEN__)
+#if SDL_BYTEORDER == SDL_LIL_ENDIAN
+#if PG_ENABLE_SSE_NEON
+                    if (PG_SURF_BytesPerPixel(src) == 4 &&
+                        PG_SURF_BytesPerPixel(dst) == 4 &&
+                        src->format->Rmask == dst->format->Rmask &&
+                        src->format->Gmask == dst->format->Gmask &&
+                        src->format->Bmask == dst->format->Bmask &&
+                        !(src->format->Amask != 0 && dst->format->Amask != 0 &&
+                          src->format->Amask != dst->format->Amask) &&
+                        pg_HasSSE_NEON() && (src != dst)) {
+                        blitter = blit_blend_custom_sse2;
                         break;
                     }
 #endif /* PG_ENABLE_SSE_NEON */
 #endif /* SDL_BYTEORDER == SDL_LIL_ENDIAN */
 #endif /* __EMSCRIPTEN__ */
 
-                    blit_blend_premultiplied(&info);
+                    blitter = blit_blend_custom;
                     break;
                 }
                 default: {
@@ -568,6 +1523,23 @@ SoftBlitPyGame(SDL_Surface *src, SDL_Rect *srcrect, SDL_Surface *dst,
                     break;
                 }
             }
+            if (okay && spans &&
+                _blit_use_spans(&info, spans, srcrect, blend_flags)) {
+                info.span_blitter = blitter;
+                blitter = alphablit_spans;
+            }
+            if (okay) {
+                /* the pixels of locked (RLE) surfaces don't outlive this */
+                if (!queue || src_locked || dst_locked ||
+                    !_blit_queue_add(queue, blitter, &info, src, dst,
+                                     dstrect)) {
+                    pg_blit_queue_flush(queue);
+                    _blit_run(blitter, &info);
+                }
+                if (kernel) {
+                    *kernel = info.src_spans ? info.span_blitter : blitter;
+                }
+            }
         }
     }
 
@@ -580,6 +1552,208 @@ SoftBlitPyGame(SDL_Surface *src, SDL_Rect *srcrect, SDL_Surface *dst,
     return (okay ? 0 : -1);
 }
 
+/* Runs the kernel in info->span_blitter over the source spans, leaving the
+ * destination under skipped runs alone and copying opaque runs where that
+ * gives the same pixels as blending. */
+static void
+alphablit_spans(SDL_BlitInfo *info)
+{
+    const pg_AlphaSpans *spans = info->src_spans;
+    SDL_BlitInfo run_info = *info;
+    int srcbpp = PG_FORMAT_BytesPerPixel(info->src);
+    int dstbpp = PG_FORMAT_BytesPerPixel(info->dst);
+    int s_pitch = info->width * srcbpp + info->s_skip;
+    int d_pitch = info->width * dstbpp + info->d_skip;
+    int x0 = info->span_x, x1 = info->span_x + info->width;
+    Uint32 rgbmask = info->dst->Rmask | info->dst->Gmask | info->dst->Bmask;
+    int y, x, i, start, stop, count;
+
+    run_info.height = 1;
+    run_info.s_skip = run_info.d_skip = 0;
+    for (y = 0; y < info->height; y++) {
+        const Uint32 *run = spans->runs + spans->rows[info->span_y + y];
+        const Uint32 *end = spans->runs + spans->rows[info->span_y + y + 1];
+        Uint8 *srcp = info->s_pixels + y * s_pitch;
+        Uint8 *dstp = info->d_pixels + y * d_pitch;
+
+        for (x = 0; run < end && x < x1; run++) {
+            start = MAX(x, x0);
+            x += PG_SPAN_LENGTH(*run);
+            stop = MIN(x, x1);
+            if (start >= stop) {
+                continue;
+            }
+            count = stop - start;
+            start -= x0;
+
+            if (info->span_zero) {
+                if (*run & PG_SPAN_ZERO) {
+                    continue;
+                }
+            }
+            else if (PG_SPAN_KIND(*run) == PG_SPAN_TRANSPARENT) {
+                continue;
+            }
+            else if (PG_SPAN_KIND(*run) == PG_SPAN_OPAQUE) {
+                if (info->span_copy == PG_SPAN_COPY_RAW) {
+                    memcpy(dstp + start * dstbpp, srcp + start * srcbpp,
+                           count * srcbpp);
+                    continue;
+                }
+                if (info->span_copy == PG_SPAN_COPY_RGB) {
+                    Uint32 *s32 = (Uint32 *)srcp + start;
+                    Uint32 *d32 = (Uint32 *)dstp + start;
+
+                    for (i = 0; i < count; i++) {
+                        d32[i] = s32[i] & rgbmask;
+                    }
+                    continue;
+                }
+            }
+            run_info.width = count;
+            run_info.s_pixels = srcp + start * srcbpp;
+            run_info.d_pixels = dstp + start * dstbpp;
+            info->span_blitter(&run_info);
+        }
+    }
+}
+
+/* Appends a run of tag (its kind and zero flag) and length to the runs of
+ * the current row, merging it with the last one if they share the tag */
+static int
+_spans_add(pg_AlphaSpans *spans, int *count, int *capacity, int row_start,
+           Uint32 tag, int length)
+{
+    Uint32 *runs;
+
+    if (*count > row_start &&
+        (spans->runs[*count - 1] & ~0x1FFFFFFFu) == tag) {
+        spans->runs[*count - 1] += length;
+    }
+    else {
+        if (*count == *capacity) {
+            *capacity = *capacity * 2 + 64;
+            runs =
+                (Uint32 *)realloc(spans->runs, *capacity * sizeof(Uint32));
+            if (!runs) {
+                return -1;
+            }
+            spans->runs = runs;
+        }
+        spans->runs[(*count)++] = tag | (Uint32)length;
+    }
+    if (PG_SPAN_KIND(tag) != PG_SPAN_MIXED) {
+        spans->skipped += length;
+    }
+    if (tag & PG_SPAN_ZERO) {
+        spans->zeros += length;
+    }
+    return 0;
+}
+
+/* Runs shorter than this are blended, skipping them isn't worth another
+ * call of the blend kernel */
+#define PG_SPAN_MIN_LENGTH 8
+
+int
+pg_alpha_spans_keyed(SDL_Surface *surf, Uint32 *key)
+{
+    SDL_BlendMode mode = SDL_BLENDMODE_NONE;
+
+    *key = 0;
+    SDL_GetSurfaceBlendMode(surf, &mode);
+    if (surf->format->Amask && mode != SDL_BLENDMODE_NONE) {
+        return 0;
+    }
+    return SDL_GetColorKey(surf, key) == 0;
+}
+
+/* The kind and zero flag of pixel */
+static Uint32
+_span_tag(Uint32 pixel, const pg_AlphaSpans *spans, Uint32 amask)
+{
+    Uint32 kind;
+
+    if (spans->keyed) {
+        kind = pixel == spans->colorkey ? PG_SPAN_TRANSPARENT : PG_SPAN_OPAQUE;
+    }
+    else if ((pixel & amask) == amask) {
+        kind = PG_SPAN_OPAQUE;
+    }
+    else {
+        kind = (pixel & amask) ? PG_SPAN_MIXED : PG_SPAN_TRANSPARENT;
+    }
+    return (kind << 30) | (pixel ? 0 : PG_SPAN_ZERO);
+}
+
+pg_AlphaSpans *
+pg_alpha_spans_new(SDL_Surface *surf)
+{
+    SDL_PixelFormat *fmt = surf->format;
+    int bpp = PG_FORMAT_BytesPerPixel(fmt);
+    pg_AlphaSpans *spans;
+    int x, y, start, count = 0, capacity = 0;
+    Uint32 pixel, tag, next;
+
+    if (bpp < 2) {
+        SDL_SetError("alpha spans need a surface of 16 bits or more");
+        return NULL;
+    }
+    spans = (pg_AlphaSpans *)calloc(1, sizeof(pg_AlphaSpans));
+    if (!spans) {
+        SDL_OutOfMemory();
+        return NULL;
+    }
+    spans->w = surf->w;
+    spans->h = surf->h;
+    spans->keyed = pg_alpha_spans_keyed(surf, &spans->colorkey);
+    spans->rows = (int *)malloc((surf->h + 1) * sizeof(int));
+    if (!spans->rows) {
+        goto on_error;
+    }
+
+    for (y = 0; y < surf->h; y++) {
+        Uint8 *row = (Uint8 *)surf->pixels + y * surf->pitch;
+
+        spans->rows[y] = count;
+        for (start = x = 0; start < surf->w; start = x) {
+            GET_PIXEL(pixel, bpp, row + x * bpp);
+            tag = _span_tag(pixel, spans, fmt->Amask);
+            while (++x < surf->w) {
+                GET_PIXEL(pixel, bpp, row + x * bpp);
+                next = _span_tag(pixel, spans, fmt->Amask);
+                if (next != tag) {
+                    break;
+                }
+            }
+            if (x - start < PG_SPAN_MIN_LENGTH) {
+                tag = (Uint32)PG_SPAN_MIXED << 30;
+            }
+            if (_spans_add(spans, &count, &capacity, spans->rows[y], tag,
+                           x - start)) {
+                goto on_error;
+            }
+        }
+    }
+    spans->rows[surf->h] = count;
+    return spans;
+
+on_error:
+    pg_alpha_spans_free(spans);
+    SDL_OutOfMemory();
+    return NULL;
+}
+
+void
+pg_alpha_spans_free(pg_AlphaSpans *spans)
+{
+    if (spans) {
+        free(spans->rows);
+        free(spans->runs);
+        free(spans);
+    }
+}
+
 /* --------------------------------------------------------- */
 
 static void
@@ -1433,6 +2607,148 @@ blit_blend_premultiplied(SDL_BlitInfo *info)
     }
 }
 
+/* One channel of a custom blend equation. x * factor / 255 is rounded the
+ * same way as in the SIMD kernels. Like the GPU, minimum and maximum ignore
+ * the factors. */
+static Uint8
+_blend_custom_term(int factor, Uint32 x, Uint32 s, Uint32 d, Uint32 sa,
+                   Uint32 da)
+{
+    Uint32 f;
+
+    switch (factor) {
+        case SDL_BLENDFACTOR_ONE:
+            return x;
+        case SDL_BLENDFACTOR_SRC_COLOR:
+            f = s;
+            break;
+        case SDL_BLENDFACTOR_ONE_MINUS_SRC_COLOR:
+            f = 255 - s;
+            break;
+        case SDL_BLENDFACTOR_SRC_ALPHA:
+            f = sa;
+            break;
+        case SDL_BLENDFACTOR_ONE_MINUS_SRC_ALPHA:
+            f = 255 - sa;
+            break;
+        case SDL_BLENDFACTOR_DST_COLOR:
+            f = d;
+            break;
+        case SDL_BLENDFACTOR_ONE_MINUS_DST_COLOR:
+            f = 255 - d;
+            break;
+        case SDL_BLENDFACTOR_DST_ALPHA:
+            f = da;
+            break;
+        case SDL_BLENDFACTOR_ONE_MINUS_DST_ALPHA:
+            f = 255 - da;
+            break;
+        default: /* SDL_BLENDFACTOR_ZERO */
+            return 0;
+    }
+    x = x * f + 128;
+    return (x + (x >> 8)) >> 8;
+}
+
+static Uint8
+_blend_custom_channel(int fsrc, int fdst, int op, Uint8 s, Uint8 d, Uint8 sa,
+                      Uint8 da)
+{
+    int a, b;
+
+    switch (op) {
+        case SDL_BLENDOPERATION_MINIMUM:
+            return s < d ? s : d;
+        case SDL_BLENDOPERATION_MAXIMUM:
+            return s > d ? s : d;
+    }
+    a = _blend_custom_term(fsrc, s, s, d, sa, da);
+    b = _blend_custom_term(fdst, d, s, d, sa, da);
+    switch (op) {
+        case SDL_BLENDOPERATION_SUBTRACT:
+            a -= b;
+            break;
+        case SDL_BLENDOPERATION_REV_SUBTRACT:
+            a = b - a;
+            break;
+        default: /* SDL_BLENDOPERATION_ADD */
+            a += b;
+            break;
+    }
+    return a < 0 ? 0 : (a > 255 ? 255 : a);
+}
+
+/* The blend equations of a pygame.BlendMode, for any pixel formats */
+static void
+blit_blend_custom(SDL_BlitInfo *info)
+{
+    int n;
+    int width = info->width;
+    int height = info->height;
+    Uint8 *src = info->s_pixels;
+    int srcpxskip = info->s_pxskip;
+    int srcskip = info->s_skip;
+    Uint8 *dst = info->d_pixels;
+    int dstpxskip = info->d_pxskip;
+    int dstskip = info->d_skip;
+    SDL_PixelFormat *srcfmt = info->src;
+    SDL_PixelFormat *dstfmt = info->dst;
+    int srcbpp = PG_FORMAT_BytesPerPixel(srcfmt);
+    int dstbpp = PG_FORMAT_BytesPerPixel(dstfmt);
+    Uint8 dR, dG, dB, dA, sR, sG, sB, sA;
+    Uint32 pixel;
+    int srcppa = srcfmt->Amask != 0;
+    int dstppa = dstfmt->Amask != 0;
+    Uint32 mode = info->blend_custom;
+    int csrc = PG_BLEND_CUSTOM_CSRC(mode), cdst = PG_BLEND_CUSTOM_CDST(mode);
+    int cop = PG_BLEND_CUSTOM_COP(mode), asrc = PG_BLEND_CUSTOM_ASRC(mode);
+    int adst = PG_BLEND_CUSTOM_ADST(mode), aop = PG_BLEND_CUSTOM_AOP(mode);
+    size_t offsetR = 0, offsetG = 0, offsetB = 0;
+
+    if (dstbpp == 3) {
+        SET_OFFSETS_24(offsetR, offsetG, offsetB, dstfmt);
+    }
+    while (height--) {
+        LOOP_UNROLLED4(
+            {
+                if (srcbpp == 1) {
+                    GET_PIXELVALS_1(sR, sG, sB, sA, src, srcfmt);
+                }
+                else {
+                    GET_PIXEL(pixel, srcbpp, src);
+                    GET_PIXELVALS(sR, sG, sB, sA, pixel, srcfmt, srcppa);
+                }
+                if (dstbpp == 1) {
+                    GET_PIXELVALS_1(dR, dG, dB, dA, dst, dstfmt);
+                }
+                else {
+                    GET_PIXEL(pixel, dstbpp, dst);
+                    GET_PIXELVALS(dR, dG, dB, dA, pixel, dstfmt, dstppa);
+                }
+                dR = _blend_custom_channel(csrc, cdst, cop, sR, dR, sA, dA);
+                dG = _blend_custom_channel(csrc, cdst, cop, sG, dG, sA, dA);
+                dB = _blend_custom_channel(csrc, cdst, cop, sB, dB, sA, dA);
+                dA = _blend_custom_channel(asrc, adst, aop, sA, dA, sA, dA);
+                if (dstbpp == 1) {
+                    SET_PIXELVAL(dst, dstfmt, dR, dG, dB, dA);
+                }
+                else if (dstbpp == 3) {
+                    dst[offsetR] = dR;
+                    dst[offsetG] = dG;
+                    dst[offsetB] = dB;
+                }
+                else {
+                    CREATE_PIXEL(dst, dR, dG, dB, dA, dstbpp, dstfmt);
+                }
+                src += srcpxskip;
+                dst += dstpxskip;
+            },
+            n, width);
+        src += srcskip;
+        dst += dstskip;
+    }
+}
+
 /* --------------------------------------------------------- */
 
 static void
@@ -2426,6 +3742,11 @@ alphablit_alpha(SDL_BlitInfo *info)
                         SDL_GetRGBA(pixel, dstfmt, &dR, &dG, &dB, &dA);
                         /* modulate Alpha */
                         sA = (sA * modulateA) / 255;
+                        if (info->src_has_tint) {
+                            sR = (sR * info->src_tint[0]) / 255;
+                            sG = (sG * info->src_tint[1]) / 255;
+                            sB = (sB * info->src_tint[2]) / 255;
+                        }
 
                         dRi = dR;
                         dGi = dG;
@@ -2729,14 +4050,61 @@ alphablit_solid(SDL_BlitInfo *info)
     }
 }
 
+/* Copies the rows of src to dst, which have the same format. Reversed
+ * (overlapping self) blits start at the last pixel of the last row, so the
+ * rows are copied bottom up, each with memmove(). */
+static void
+alphablit_copy(SDL_BlitInfo *info)
+{
+    int height = info->height;
+    int bpp = PG_FORMAT_BytesPerPixel(info->src);
+    size_t length = (size_t)info->width * bpp;
+    int srcpitch = info->width * info->s_pxskip + info->s_skip;
+    int dstpitch = info->width * info->d_pxskip + info->d_skip;
+    Uint8 *src = info->s_pixels;
+    Uint8 *dst = info->d_pixels;
+
+    if (info->s_pxskip < 0) {
+        src -= length - bpp;
+        dst -= length - bpp;
+    }
+    while (height--) {
+        memmove(dst, src, length);
+        src += srcpitch;
+        dst += dstpitch;
+    }
+}
+
 /*we assume the "dst" has pixel alpha*/
 int
 pygame_Blit(SDL_Surface *src, SDL_Rect *srcrect, SDL_Surface *dst,
             SDL_Rect *dstrect, int blend_flags)
+{
+    return pygame_BlitSpans(src, srcrect, dst, dstrect, blend_flags, NULL);
+}
+
+int
+pygame_BlitSpans(SDL_Surface *src, SDL_Rect *srcrect, SDL_Surface *dst,
+                 SDL_Rect *dstrect, int blend_flags,
+                 const pg_AlphaSpans *spans)
+{
+    return pygame_BlitQueued(src, srcrect, dst, dstrect, blend_flags, spans,
+                             NULL, NULL);
+}
+
+int
+pygame_BlitQueued(SDL_Surface *src, SDL_Rect *srcrect, SDL_Surface *dst,
+                  SDL_Rect *dstrect, int blend_flags,
+                  const pg_AlphaSpans *spans, pg_BlitQueue *queue,
+                  pg_BlitKernel *kernel)
 {
     SDL_Rect fulldst;
     int srcx, srcy, w, h;
 
+    if (kernel) {
+        *kernel = NULL;
+    }
+
     /* Make sure the surfaces aren't locked */
     if (!src || !dst) {
         SDL_SetError("pygame_Blit: passed a NULL surface");
@@ -2818,7 +4186,8 @@ pygame_Blit(SDL_Surface *src, SDL_Rect *srcrect, SDL_Surface *dst,
         sr.y = srcy;
         sr.w = dstrect->w = w;
         sr.h = dstrect->h = h;
-        return SoftBlitPyGame(src, &sr, dst, dstrect, blend_flags);
+        return SoftBlitPyGame(src, &sr, dst, dstrect, blend_flags, spans,
+                              queue, kernel);
     }
     dstrect->w = dstrect->h = 0;
     return 0;
@@ -2831,6 +4200,334 @@ pygame_AlphaBlit(SDL_Surface *src, SDL_Rect *srcrect, SDL_Surface *dst,
     return pygame_Blit(src, srcrect, dst, dstrect, blend_flags);
 }
 
+#ifndef M_PI
+#define M_PI 3.141592654
+#endif
+
+/* the rb and ag lanes of two 32 bit pixels, mixed by f / 256 */
+#define LERP_LANES(a, b, f) \
+    ((((a) * (256 - (f)) + (b) * (f)) >> 8) & 0x00FF00FF)
+
+static Uint32
+_bilinear_pixel(Uint8 *pixels, int pitch, int w, int h, Sint64 fu,
+                Sint64 fv)
+{
+    Sint64 uu = fu - 0x8000, vv = fv - 0x8000;
+    int x0 = (int)(uu >> 16), y0 = (int)(vv >> 16);
+    int x1 = x0 + 1, y1 = y0 + 1;
+    Uint32 fx = (Uint32)(uu >> 8) & 0xFF, fy = (Uint32)(vv >> 8) & 0xFF;
+    Uint32 *row0, *row1, p00, p10, p01, p11, rb, ag;
+
+    x0 = MAX(0, MIN(x0, w - 1));
+    x1 = MAX(0, MIN(x1, w - 1));
+    y0 = MAX(0, MIN(y0, h - 1));
+    y1 = MAX(0, MIN(y1, h - 1));
+    row0 = (Uint32 *)(pixels + y0 * pitch);
+    row1 = (Uint32 *)(pixels + y1 * pitch);
+    p00 = row0[x0];
+    p10 = row0[x1];
+    p01 = row1[x0];
+    p11 = row1[x1];
+
+    rb = LERP_LANES(LERP_LANES(p00 & 0x00FF00FF, p10 & 0x00FF00FF, fx),
+                    LERP_LANES(p01 & 0x00FF00FF, p11 & 0x00FF00FF, fx), fy);
+    ag = LERP_LANES(
+        LERP_LANES((p00 >> 8) & 0x00FF00FF, (p10 >> 8) & 0x00FF00FF, fx),
+        LERP_LANES((p01 >> 8) & 0x00FF00FF, (p11 >> 8) & 0x00FF00FF, fx),
+        fy);
+    return rb | (ag << 8);
+}
+
+/* Samples n pixels of src into row, starting at the 16.16 fixed point
+ * source position (fu, fv) and stepping by (du, dv) */
+static void
+_sample_row(SDL_Surface *src, Uint8 *row, int n, Sint64 fu, Sint64 fv,
+            Sint64 du, Sint64 dv, int smooth)
+{
+    Uint8 *pixels = (Uint8 *)src->pixels;
+    int bpp = PG_SURF_BytesPerPixel(src);
+    int w = src->w, h = src->h, i, x, y;
+    Uint8 *p;
+
+    if (smooth) {
+        Uint32 *out = (Uint32 *)row;
+
+        for (i = 0; i < n; i++, fu += du, fv += dv) {
+            out[i] = _bilinear_pixel(pixels, src->pitch, w, h, fu, fv);
+        }
+        return;
+    }
+
+    /* the span ends are clamped, fixed point steps may drift past them */
+    for (i = 0; i < n; i++, fu += du, fv += dv, row += bpp) {
+        x = (int)(fu >> 16);
+        y = (int)(fv >> 16);
+        x = MAX(0, MIN(x, w - 1));
+        y = MAX(0, MIN(y, h - 1));
+        p = pixels + y * src->pitch + x * bpp;
+        switch (bpp) {
+            case 1:
+                *row = *p;
+                break;
+            case 2:
+                *(Uint16 *)row = *(Uint16 *)p;
+                break;
+            case 3:
+                row[0] = p[0];
+                row[1] = p[1];
+                row[2] = p[2];
+                break;
+            default:
+                *(Uint32 *)row = *(Uint32 *)p;
+                break;
+        }
+    }
+}
+
+/* Narrows [*xa, *xb) to the pixels whose centre maps to the source in the
+ * row starting with the source position (u, v) */
+static void
+_transformed_span(double u, double v, double dux, double dvx, int sw, int sh,
+                  int *xa, int *xb)
+{
+    double lo = *xa, hi = *xb, t0, t1;
+    int a, b;
+
+    if (dux != 0.0) {
+        t0 = -u / dux;
+        t1 = (sw - u) / dux;
+        lo = MAX(lo, MIN(t0, t1));
+        hi = MIN(hi, MAX(t0, t1));
+    }
+    else if (u < 0.0 || u >= sw) {
+        hi = lo;
+    }
+    if (dvx != 0.0) {
+        t0 = -v / dvx;
+        t1 = (sh - v) / dvx;
+        lo = MAX(lo, MIN(t0, t1));
+        hi = MIN(hi, MAX(t0, t1));
+    }
+    else if (v < 0.0 || v >= sh) {
+        hi = lo;
+    }
+    if (hi <= lo) {
+        *xb = *xa;
+        return;
+    }
+
+    /* the ends can be off by one from rounding, test them */
+    a = MAX(*xa, (int)floor(lo) - 1);
+    b = MIN(*xb, (int)ceil(hi) + 1);
+#define _INSIDE(x)                                                       \
+    (u + (x) * dux >= 0.0 && u + (x) * dux < sw && v + (x) * dvx >= 0.0 && \
+     v + (x) * dvx < sh)
+    while (a < b && !_INSIDE(a)) {
+        a++;
+    }
+    while (b > a && !_INSIDE(b - 1)) {
+        b--;
+    }
+#undef _INSIDE
+    *xa = a;
+    *xb = b;
+}
+
+int
+pygame_BlitTransformed(SDL_Surface *src, SDL_Surface *dst,
+                       const pg_BlitTransform *xf, int blend_flags,
+                       SDL_Rect *affected)
+{
+    double rad, c, s, dux, duy, dvx, dvy, ku, kv;
+    double minx, maxx, miny, maxy, u, v;
+    double corners[4][2];
+    SDL_Surface *row = NULL;
+    SDL_Rect box, srect, drect;
+    Uint8 *buffer = NULL;
+    SDL_BlendMode blend;
+    Uint32 colorkey;
+    Uint8 alpha;
+    int i, y, xa, xb, bpp, smooth, result = 0;
+
+    if (!src || !dst) {
+        SDL_SetError("pygame_BlitTransformed: passed a NULL surface");
+        return -1;
+    }
+    if (src->locked || dst->locked) {
+        SDL_SetError(
+            "pygame_BlitTransformed: Surfaces must not be locked during "
+            "blit");
+        return -1;
+    }
+    affected->x = (int)floor(xf->pos_x);
+    affected->y = (int)floor(xf->pos_y);
+    affected->w = affected->h = 0;
+    if (src->w <= 0 || src->h <= 0 || xf->scale_x <= 0.0 ||
+        xf->scale_y <= 0.0) {
+        return 0;
+    }
+
+    /* exact quarter turns, so they match rotate() */
+    if (fmod(xf->angle, 90.0) == 0.0) {
+        switch (((int)fmod(xf->angle, 360.0) + 360) % 360) {
+            case 90:
+                c = 0.0;
+                s = 1.0;
+                break;
+            case 180:
+                c = -1.0;
+                s = 0.0;
+                break;
+            case 270:
+                c = 0.0;
+                s = -1.0;
+                break;
+            default:
+                c = 1.0;
+                s = 0.0;
+                break;
+        }
+    }
+    else {
+        rad = xf->angle * (M_PI / 180.0);
+        c = cos(rad);
+        s = sin(rad);
+    }
+    ku = xf->flip_x ? -1.0 : 1.0;
+    kv = xf->flip_y ? -1.0 : 1.0;
+
+    /* The destination area, the source corners rotated counterclockwise
+     * (on screen) around origin */
+    corners[0][0] = corners[2][0] = ku * -xf->origin_x * xf->scale_x;
+    corners[1][0] = corners[3][0] = ku * (src->w - xf->origin_x) * xf->scale_x;
+    corners[0][1] = corners[1][1] = kv * -xf->origin_y * xf->scale_y;
+    corners[2][1] = corners[3][1] = kv * (src->h - xf->origin_y) * xf->scale_y;
+    minx = miny = HUGE_VAL;
+    maxx = maxy = -HUGE_VAL;
+    for (i = 0; i < 4; i++) {
+        double x = xf->pos_x + corners[i][0] * c + corners[i][1] * s;
+        double y = xf->pos_y - corners[i][0] * s + corners[i][1] * c;
+
+        minx = MIN(minx, x);
+        maxx = MAX(maxx, x);
+        miny = MIN(miny, y);
+        maxy = MAX(maxy, y);
+    }
+    {
+        SDL_Rect *clip = &dst->clip_rect;
+        double x0 = MAX(floor(minx), (double)clip->x);
+        double y0 = MAX(floor(miny), (double)clip->y);
+        double x1 = MIN(ceil(maxx), (double)clip->x + clip->w);
+        double y1 = MIN(ceil(maxy), (double)clip->y + clip->h);
+
+        if (x1 <= x0 || y1 <= y0) {
+            return 0;
+        }
+        box.x = (int)x0;
+        box.y = (int)y0;
+        box.w = (int)(x1 - x0);
+        box.h = (int)(y1 - y0);
+    }
+    *affected = box;
+
+    /* The inverse mapping, the source position of a destination pixel
+     * centre is linear in its coordinates */
+    dux = ku * c / xf->scale_x;
+    duy = -ku * s / xf->scale_x;
+    dvx = kv * s / xf->scale_y;
+    dvy = kv * c / xf->scale_y;
+
+    /* the rows are sampled to a buffer in the format of the source, then
+     * blended by pygame_Blit(), which picks the SIMD blitters */
+    bpp = PG_SURF_BytesPerPixel(src);
+    smooth = xf->smooth && bpp == 4 && !SDL_HasColorKey(src);
+    buffer = (Uint8 *)malloc((size_t)box.w * bpp);
+    if (!buffer) {
+        SDL_OutOfMemory();
+        return -1;
+    }
+    row = PG_CreateSurfaceFrom(buffer, box.w, 1, box.w * bpp,
+                               src->format->format);
+    if (!row) {
+        free(buffer);
+        return -1;
+    }
+    if ((src->format->palette &&
+         SDL_SetSurfacePalette(row, src->format->palette)) ||
+        SDL_GetSurfaceBlendMode(src, &blend) ||
+        SDL_SetSurfaceBlendMode(row, blend) ||
+        SDL_GetSurfaceAlphaMod(src, &alpha) ||
+        SDL_SetSurfaceAlphaMod(row, alpha) ||
+        (SDL_GetColorKey(src, &colorkey) == 0 &&
+         SDL_SetColorKey(row, SDL_TRUE, colorkey))) {
+        result = -1;
+        goto done;
+    }
+    if (SDL_LockSurface(src)) {
+        result = -1;
+        goto done;
+    }
+
+    for (y = box.y; y < box.y + box.h; y++) {
+        double py = y + 0.5 - xf->pos_y;
+
+        /* the source position of the pixel at x = 0 */
+        u = xf->origin_x + (0.5 - xf->pos_x) * dux + py * duy;
+        v = xf->origin_y + (0.5 - xf->pos_x) * dvx + py * dvy;
+        xa = box.x;
+        xb = box.x + box.w;
+        _transformed_span(u, v, dux, dvx, src->w, src->h, &xa, &xb);
+        if (xa >= xb) {
+            continue;
+        }
+
+        _sample_row(src, buffer, xb - xa,
+                    (Sint64)((u + xa * dux) * 65536.0),
+                    (Sint64)((v + xa * dvx) * 65536.0),
+                    (Sint64)(dux * 65536.0), (Sint64)(dvx * 65536.0),
+                    smooth);
+        srect.x = srect.y = 0;
+        srect.w = xb - xa;
+        srect.h = 1;
+        drect.x = xa;
+        drect.y = y;
+        drect.w = srect.w;
+        drect.h = 1;
+        if (pygame_Blit(row, &srect, dst, &drect, blend_flags)) {
+            result = -1;
+            break;
+        }
+    }
+    SDL_UnlockSurface(src);
+
+done:
+    SDL_FreeSurface(row);
+    free(buffer);
+    return result;
+}
+
+/* Adds the backend of the blitters and of premul_alpha() for
+ * pygame.system.get_simd_dispatch() */
+int
+pg_blit_simd_dispatch(PyObject *dispatch)
+{
+    const char *backend;
+    int has_avx2 = 0, has_sse2_neon = 0;
+
+#if !defined(__EMSCRIPTEN__) && SDL_BYTEORDER == SDL_LIL_ENDIAN
+    has_avx2 = pg_has_avx2();
+#if PG_ENABLE_SSE_NEON
+    has_sse2_neon = pg_HasSSE_NEON();
+#endif /* PG_ENABLE_SSE_NEON */
+#endif /* !__EMSCRIPTEN__ && SDL_LIL_ENDIAN */
+    backend = pg_simd_backend_name(has_avx2, has_sse2_neon);
+    if (pg_simd_report(dispatch, "blit", backend) ||
+        pg_simd_report(dispatch, "premul_alpha", backend)) {
+        return -1;
+    }
+    return 0;
+}
+
 int
 premul_surf_color_by_alpha(SDL_Surface *src, SDL_Surface *dst)
 {
@@ -2838,7 +4535,8 @@ premul_surf_color_by_alpha(SDL_Surface *src, SDL_Surface *dst)
     SDL_GetSurfaceBlendMode(src, &src_blend);
     if (src_blend == SDL_BLENDMODE_NONE && !(src->format->Amask != 0))
         return -1;
-        // since we know dst is a copy of src we can simplify the normal checks
+        // since we know dst has the format and size of src, or is src, we
+        // can simplify the normal checks
 #if !defined(__EMSCRIPTEN__)
 #if SDL_BYTEORDER == SDL_LIL_ENDIAN
     if ((PG_SURF_BytesPerPixel(src) == 4) && pg_has_avx2()) {
@@ -2846,13 +4544,13 @@ premul_surf_color_by_alpha(SDL_Surface *src, SDL_Surface *dst)
         return 0;
     }
 #if defined(__SSE2__)
-    if ((PG_SURF_BytesPerPixel(src) == 4) && SDL_HasSSE2()) {
+    if ((PG_SURF_BytesPerPixel(src) == 4) && pg_HasSSE_NEON()) {
         premul_surf_color_by_alpha_sse2(src, dst);
         return 0;
     }
 #endif /* __SSE2__*/
 #if PG_ENABLE_ARM_NEON
-    if ((PG_SURF_BytesPerPixel(src) == 4) && SDL_HasNEON()) {
+    if ((PG_SURF_BytesPerPixel(src) == 4) && pg_HasSSE_NEON()) {
         premul_surf_color_by_alpha_sse2(src, dst);
         return 0;
     }
@@ -2877,6 +4575,8 @@ premul_surf_color_by_alpha_non_simd(SDL_Surface *src, SDL_Surface *dst)
 
     int srcpxskip = PG_SURF_BytesPerPixel(src);
     int dstpxskip = PG_SURF_BytesPerPixel(dst);
+    int srcskip = src->pitch - width * srcpxskip;
+    int dstskip = dst->pitch - width * dstpxskip;
 
     int srcppa = SDL_TRUE;
 
@@ -2898,6 +4598,8 @@ premul_surf_color_by_alpha_non_simd(SDL_Surface *src, SDL_Surface *dst)
                 dst_pixels += dstpxskip;
             },
             n, width);
+        src_pixels += srcskip;
+        dst_pixels += dstskip;
     }
 }
 
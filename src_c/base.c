@@ -77,11 +77,18 @@ static PyObject *pgExc_BufferError = NULL;
 
 /* Only one instance of the state per process. */
 static PyObject *pg_quit_functions = NULL;
+static pg_mutex pg_quit_functions_lock;
 static int pg_is_init = 0;
 static int pg_sdl_was_init = 0;
 SDL_Window *pg_default_window = NULL;
 pgSurfaceObject *pg_default_screen = NULL;
 static char *pg_env_blend_alpha_SDL2 = NULL;
+static pgPerfCounter pg_perf_counters[PG_PERF_NUM_COUNTERS];
+/* arrays of one, so that they are used like the pointers of the C API */
+static pgSIMDDispatchTable pg_simd_dispatch_table[1];
+static pgSurfaceMemStats pg_surface_memory[1];
+/* kept out of the structs above, which other modules see */
+static pg_mutex pg_state_locks[PG_STATE_NUM_LOCKS];
 
 static void
 pg_install_parachute(void);
@@ -213,37 +220,78 @@ pg_CheckSDLVersions(void)
     return 1;
 }
 
-void
-pg_RegisterQuit(void (*func)(void))
+/* Appends obj to pg_quit_functions, which is created when needed.
+ * Modules may be imported by several threads at once. */
+static int
+_pg_append_quit(PyObject *obj)
 {
+    int result = -1;
+
+    pg_mutex_lock(&pg_quit_functions_lock);
     if (!pg_quit_functions) {
         pg_quit_functions = PyList_New(0);
-        if (!pg_quit_functions) {
-            return;
-        }
     }
+    if (pg_quit_functions) {
+        result = obj ? PyList_Append(pg_quit_functions, obj) : 0;
+    }
+    pg_mutex_unlock(&pg_quit_functions_lock);
+    return result;
+}
+
+void
+pg_RegisterQuit(void (*func)(void))
+{
+    PyObject *obj = NULL;
+
     if (func) {
-        PyObject *obj = PyCapsule_New(func, "quit", NULL);
+        obj = PyCapsule_New(func, "quit", NULL);
         if (!obj) {
             return;
         }
-        /* There is no difference between success and error
-           for PyList_Append in this case */
-        (void)PyList_Append(pg_quit_functions, obj);
-        Py_DECREF(obj);
     }
+    /* There is no difference between success and error
+       for PyList_Append in this case */
+    (void)_pg_append_quit(obj);
+    Py_XDECREF(obj);
 }
 
-static PyObject *
-pg_register_quit(PyObject *self, PyObject *value)
+/* Takes the lock of the shared state which, a PG_STATE_* */
+static void
+pg_LockState(int which)
 {
-    if (!pg_quit_functions) {
-        pg_quit_functions = PyList_New(0);
-        if (!pg_quit_functions) {
-            return NULL;
+    pg_mutex_lock(&pg_state_locks[which]);
+}
+
+static void
+pg_UnlockState(int which)
+{
+    pg_mutex_unlock(&pg_state_locks[which]);
+}
+
+/* Registers a module for pygame.system.set_simd_level() and
+ * get_simd_dispatch(), once. */
+static void
+pg_RegisterSIMDDispatch(pg_SIMDDispatchFunc func)
+{
+    pgSIMDDispatchTable *table = pg_simd_dispatch_table;
+    int i;
+
+    pg_LockState(PG_STATE_SIMD_DISPATCH);
+    for (i = 0; i < table->count; i++) {
+        if (table->funcs[i] == func) {
+            break;
         }
     }
-    if (0 != PyList_Append(pg_quit_functions, value)) {
+    if (i == table->count && table->count < PG_SIMD_MAX_DISPATCH) {
+        table->funcs[table->count++] = func;
+    }
+    pg_UnlockState(PG_STATE_SIMD_DISPATCH);
+}
+
+static PyObject *
+pg_register_quit(PyObject *self, PyObject *value)
+{
+    if (0 != _pg_append_quit(value)) {
         return NULL; /* Exception already set */
     }
 
@@ -317,10 +365,24 @@ pg_mod_autoquit(const char *modname)
     Py_XDECREF(funcobj);
 }
 
+/* Whether PYGAME_LAZY_IMPORT leaves modname alone until it is imported,
+ * pygame/__init__.py then inits it on import if pygame was inited */
+static int
+_pg_mod_lazy(const char *modname)
+{
+    return SDL_getenv("PYGAME_LAZY_IMPORT") &&
+           !PyDict_GetItemString(PyImport_GetModuleDict(), modname);
+}
+
 static PyObject *
-pg_init(PyObject *self, PyObject *_null)
+pg_init(PyObject *self, PyObject *args, PyObject *kwargs)
 {
     int i = 0, success = 0, fail = 0;
+    PyObject *subsystems = Py_None, *seq, *item;
+    Py_ssize_t j;
+    const char *name;
+    unsigned int wanted = ~0u; /* bit i for modnames[i] */
+    static char *keywords[] = {"subsystems", NULL};
 
     /* Put all the module names we want to init in this array */
     const char *modnames[] = {
@@ -330,6 +392,49 @@ pg_init(PyObject *self, PyObject *_null)
         /* IMPPREFIX "_sdl2.controller", Is this required? Comment for now*/
         NULL};
 
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "|O", keywords,
+                                     &subsystems)) {
+        return NULL;
+    }
+
+    /* checked before anything is inited */
+    if (subsystems != Py_None) {
+        if (PyUnicode_Check(subsystems)) {
+            return RAISE(PyExc_TypeError,
+                         "subsystems must be a sequence of module names, "
+                         "not str");
+        }
+        seq = PySequence_Fast(subsystems,
+                              "subsystems must be a sequence of module names");
+        if (!seq) {
+            return NULL;
+        }
+        wanted = 0;
+        for (j = 0; j < PySequence_Fast_GET_SIZE(seq); j++) {
+            item = PySequence_Fast_GET_ITEM(seq, j);
+            if (!PyUnicode_Check(item) || !(name = PyUnicode_AsUTF8(item))) {
+                Py_DECREF(seq);
+                return RAISE(PyExc_TypeError,
+                             "subsystems must be a sequence of module names");
+            }
+            for (i = 0; modnames[i]; i++) {
+                if (!strcmp(name, modnames[i] + sizeof(IMPPREFIX) - 1)) {
+                    break;
+                }
+            }
+            if (!modnames[i]) {
+                PyErr_Format(PyExc_ValueError,
+                             "unknown subsystem '%s', expected display, "
+                             "joystick, font, freetype or mixer",
+                             name);
+                Py_DECREF(seq);
+                return NULL;
+            }
+            wanted |= 1u << i;
+        }
+        Py_DECREF(seq);
+    }
+
     /*nice to initialize timer, so startup time will reflec pg_init() time*/
 #if defined(WITH_THREAD) && !defined(MS_WIN32) && defined(SDL_INIT_EVENTTHREAD)
     pg_sdl_was_init = SDL_Init(SDL_INIT_EVENTTHREAD | SDL_INIT_TIMER |
@@ -342,6 +447,10 @@ pg_init(PyObject *self, PyObject *_null)
 
     /* initialize all pygame modules */
     for (i = 0; modnames[i]; i++) {
+        /* neither counted as success nor failure, like an ImportError */
+        if (!(wanted & (1u << i)) ||
+            (subsystems == Py_None && _pg_mod_lazy(modnames[i])))
+            continue;
         if (pg_mod_autoinit(modnames[i]))
             success++;
         else {
@@ -412,10 +521,12 @@ _pg_quit(void)
         IMPPREFIX "display", /* Display last, this also quits event,time */
         NULL};
 
-    if (pg_quit_functions) {
-        privatefuncs = pg_quit_functions;
-        pg_quit_functions = NULL;
+    pg_mutex_lock(&pg_quit_functions_lock);
+    privatefuncs = pg_quit_functions;
+    pg_quit_functions = NULL;
+    pg_mutex_unlock(&pg_quit_functions_lock);
 
+    if (privatefuncs) {
         pg_uninstall_parachute(); /* Is this done here, or can it be done
                                      below? */
         num = PyList_Size(privatefuncs);
@@ -445,7 +556,8 @@ _pg_quit(void)
 
     /* quit all pygame modules */
     for (i = 0; modnames[i]; i++) {
-        pg_mod_autoquit(modnames[i]);
+        if (!_pg_mod_lazy(modnames[i]))
+            pg_mod_autoquit(modnames[i]);
     }
 
     /* Because quit never errors */
@@ -2187,7 +2299,7 @@ pg_uninstall_parachute(void)
 /* bind functions to python */
 
 static PyMethodDef _base_methods[] = {
-    {"init", (PyCFunction)pg_init, METH_NOARGS, DOC_INIT},
+    {"init", (PyCFunction)pg_init, METH_VARARGS | METH_KEYWORDS, DOC_INIT},
     {"quit", (PyCFunction)pg_quit, METH_NOARGS, DOC_QUIT},
     {"get_init", (PyCFunction)pg_base_get_init, METH_NOARGS, DOC_GETINIT},
     {"register_quit", (PyCFunction)pg_register_quit, METH_O, DOC_REGISTERQUIT},
@@ -2245,7 +2357,7 @@ MODINIT_DEFINE(base)
 
     /* create the module */
     module = PyModule_Create(&_module);
-    if (!module) {
+    if (!module || PG_GIL_NOT_USED(module)) {
         goto error;
     }
 
@@ -2296,8 +2408,14 @@ MODINIT_DEFINE(base)
     c_api[26] = pg_TwoDoublesFromFastcallArgs;
     c_api[27] = pg_GetDefaultConvertFormat;
     c_api[28] = pg_SetDefaultConvertFormat;
-
-#define FILLED_SLOTS 29
+    c_api[29] = pg_perf_counters;
+    c_api[30] = pg_RegisterSIMDDispatch;
+    c_api[31] = pg_simd_dispatch_table;
+    c_api[32] = pg_surface_memory;
+    c_api[33] = pg_LockState;
+    c_api[34] = pg_UnlockState;
+
+#define FILLED_SLOTS 35
 
 #if PYGAMEAPI_BASE_NUMSLOTS != FILLED_SLOTS
 #error export slot count mismatch
@@ -39,6 +39,10 @@
 static INLINE unsigned int
 bitcount(BITMASK_W n)
 {
+#if defined(__GNUC__) && (defined(__POPCNT__) || defined(__aarch64__))
+    /* a single instruction when the target has hardware popcount */
+    return (unsigned int)__builtin_popcountl(n);
+#else
     const int bitmask_len = BITMASK_W_LEN;
     if (bitmask_len == 32) {
 #ifdef GILLIES
@@ -87,6 +91,7 @@ bitcount(BITMASK_W n)
         }
         return nbits;
     }
+#endif
 }
 
 /* Positive modulo of the given dividend and divisor (dividend % divisor).
@@ -106,6 +111,97 @@ positive_modulo(int dividend, int divisor)
     return (result >= 0) ? result : result + divisor;
 }
 
+/* The portable kernels, see bitmask_kernels_t. The loops are kept free of
+   branches so compilers can vectorize them on their own. */
+static unsigned int
+bitmask_count_words(const BITMASK_W *w, int n)
+{
+    unsigned int tot = 0;
+    int i;
+
+    for (i = 0; i < n; i++) {
+        tot += bitcount(w[i]);
+    }
+    return tot;
+}
+
+static void
+bitmask_invert_words(BITMASK_W *w, int n, BITMASK_W mask)
+{
+    int i;
+
+    for (i = 0; i < n; i++) {
+        w[i] = ~w[i] & mask;
+    }
+}
+
+static void
+bitmask_draw_words(BITMASK_W *a, const BITMASK_W *b, int n, int shift)
+{
+    int i;
+
+    if (shift >= 0) {
+        for (i = 0; i < n; i++) {
+            a[i] |= b[i] << shift;
+        }
+    }
+    else {
+        for (i = 0; i < n; i++) {
+            a[i] |= b[i] >> -shift;
+        }
+    }
+}
+
+static void
+bitmask_erase_words(BITMASK_W *a, const BITMASK_W *b, int n, int shift)
+{
+    int i;
+
+    if (shift >= 0) {
+        for (i = 0; i < n; i++) {
+            a[i] &= ~(b[i] << shift);
+        }
+    }
+    else {
+        for (i = 0; i < n; i++) {
+            a[i] &= ~(b[i] >> -shift);
+        }
+    }
+}
+
+static void
+bitmask_overlap_words(BITMASK_W *c, const BITMASK_W *a, const BITMASK_W *b,
+                      int n, int shift, int accumulate)
+{
+    const BITMASK_W keep = accumulate ? ~(BITMASK_W)0 : 0;
+    int i;
+
+    if (shift >= 0) {
+        for (i = 0; i < n; i++) {
+            c[i] = (c[i] & keep) | (a[i] & (b[i] << shift));
+        }
+    }
+    else {
+        for (i = 0; i < n; i++) {
+            c[i] = (c[i] & keep) | (a[i] & (b[i] >> -shift));
+        }
+    }
+}
+
+static const bitmask_kernels_t default_kernels = {
+    bitmask_count_words, bitmask_invert_words, bitmask_draw_words,
+    bitmask_erase_words, bitmask_overlap_words};
+
+static bitmask_kernels_t kernels = {
+    bitmask_count_words, bitmask_invert_words, bitmask_draw_words,
+    bitmask_erase_words, bitmask_overlap_words};
+
+void
+bitmask_set_kernels(const bitmask_kernels_t *k)
+{
+    kernels = k ? *k : default_kernels;
+}
+
 bitmask_t *
 bitmask_create(int w, int h)
 {
@@ -187,7 +283,7 @@ void
 bitmask_fill(bitmask_t *m)
 {
     int len, shift;
-    BITMASK_W *pixels, cmask, full;
+    BITMASK_W *pixels, cmask;
 
     if (!m->h || !m->w) {
         return;
@@ -196,13 +292,11 @@ bitmask_fill(bitmask_t *m)
     len = m->h * ((m->w - 1) / BITMASK_W_LEN);
 
     shift = positive_modulo(BITMASK_W_LEN - m->w, (int)BITMASK_W_LEN);
-    full = ~(BITMASK_W)0;
     cmask = (~(BITMASK_W)0) >> shift;
 
     /* fill all the pixels that aren't in the rightmost BITMASK_Ws */
-    for (pixels = m->bits; pixels < (m->bits + len); pixels++) {
-        *pixels = full;
-    }
+    memset(m->bits, 0xFF, len * sizeof(BITMASK_W));
+
     /* for the rightmost BITMASK_Ws, use cmask to ensure we aren't setting
        bits that are outside of the mask */
     for (pixels = m->bits + len; pixels < (m->bits + len + m->h); pixels++) {
@@ -214,7 +308,7 @@ void
 bitmask_invert(bitmask_t *m)
 {
     int len, shift;
-    BITMASK_W *pixels, cmask;
+    BITMASK_W cmask;
 
     if (!m->h || !m->w) {
         return;
@@ -226,33 +320,21 @@ bitmask_invert(bitmask_t *m)
     cmask = (~(BITMASK_W)0) >> shift;
 
     /* flip all the pixels that aren't in the rightmost BITMASK_Ws */
-    for (pixels = m->bits; pixels < (m->bits + len); pixels++) {
-        *pixels = ~(*pixels);
-    }
+    kernels.invert(m->bits, len, ~(BITMASK_W)0);
+
     /* for the rightmost BITMASK_Ws, & with cmask to ensure we aren't setting
        bits that are outside of the mask */
-    for (pixels = m->bits + len; pixels < (m->bits + len + m->h); pixels++) {
-        *pixels = cmask & ~(*pixels);
-    }
+    kernels.invert(m->bits + len, m->h, cmask);
 }
 
 unsigned int
 bitmask_count(bitmask_t *m)
 {
-    BITMASK_W *pixels;
-    unsigned int tot = 0;
-
     if (!m->w || !m->h) {
-        return tot;
-    }
-
-    for (pixels = m->bits;
-         pixels < (m->bits + m->h * ((m->w - 1) / BITMASK_W_LEN + 1));
-         pixels++) {
-        tot += bitcount(*pixels);
+        return 0;
     }
 
-    return tot;
+    return kernels.count(m->bits, m->h * ((m->w - 1) / BITMASK_W_LEN + 1));
 }
 
 int
@@ -566,8 +648,7 @@ void
 bitmask_overlap_mask(const bitmask_t *a, const bitmask_t *b, bitmask_t *c,
                      int xoffset, int yoffset)
 {
-    const BITMASK_W *a_entry, *ap;
-    const BITMASK_W *b_entry, *bp;
+    const BITMASK_W *a_entry, *b_entry;
     BITMASK_W *c_entry, *cp;
     int shift, rshift, i, astripes, bstripes;
 
@@ -601,42 +682,37 @@ bitmask_overlap_mask(const bitmask_t *a, const bitmask_t *b, bitmask_t *c,
             if (bstripes > astripes) /* zig-zag .. zig*/
             {
                 for (i = 0; i < astripes; i++) {
-                    for (ap = a_entry, bp = b_entry, cp = c_entry; ap < a_end;
-                         ap++, bp++, cp++)
-                        *cp |= *ap & (*bp << shift);
+                    kernels.overlap(c_entry, a_entry, b_entry,
+                                    (int)(a_end - a_entry), shift, 1);
 
                     /* The c_entry (output mask) must advance with a_entry. */
                     a_entry += a->h;
                     a_end += a->h;
                     c_entry += c->h;
 
-                    for (ap = a_entry, bp = b_entry, cp = c_entry; ap < a_end;
-                         ap++, bp++, cp++)
-                        *cp |= *ap & (*bp >> rshift);
+                    kernels.overlap(c_entry, a_entry, b_entry,
+                                    (int)(a_end - a_entry), -rshift, 1);
 
                     b_entry += b->h;
                 }
 
                 /* This is the '.. zig' to handle the remaining bits. */
-                for (ap = a_entry, bp = b_entry, cp = c_entry; ap < a_end;
-                     ap++, bp++, cp++)
-                    *cp |= *ap & (*bp << shift);
+                kernels.overlap(c_entry, a_entry, b_entry,
+                                (int)(a_end - a_entry), shift, 1);
             }
             else /* zig-zag */
             {
                 for (i = 0; i < bstripes; i++) {
-                    for (ap = a_entry, bp = b_entry, cp = c_entry; ap < a_end;
-                         ap++, bp++, cp++)
-                        *cp |= *ap & (*bp << shift);
+                    kernels.overlap(c_entry, a_entry, b_entry,
+                                    (int)(a_end - a_entry), shift, 1);
 
                     /* The c_entry (output mask) must advance with a_entry. */
                     a_entry += a->h;
                     a_end += a->h;
                     c_entry += c->h;
 
-                    for (ap = a_entry, bp = b_entry, cp = c_entry; ap < a_end;
-                         ap++, bp++, cp++)
-                        *cp |= *ap & (*bp >> rshift);
+                    kernels.overlap(c_entry, a_entry, b_entry,
+                                    (int)(a_end - a_entry), -rshift, 1);
 
                     b_entry += b->h;
                 }
@@ -647,10 +723,8 @@ bitmask_overlap_mask(const bitmask_t *a, const bitmask_t *b, bitmask_t *c,
         {
             astripes = (MIN(b->w, a->w - xoffset) - 1) / BITMASK_W_LEN + 1;
             for (i = 0; i < astripes; i++) {
-                for (ap = a_entry, bp = b_entry, cp = c_entry; ap < a_end;
-                     ap++, bp++, cp++) {
-                    *cp = *ap & *bp;
-                }
+                kernels.overlap(c_entry, a_entry, b_entry,
+                                (int)(a_end - a_entry), 0, 0);
                 a_entry += a->h;
                 c_entry += c->h;
                 a_end += a->h;
@@ -684,32 +758,27 @@ bitmask_overlap_mask(const bitmask_t *a, const bitmask_t *b, bitmask_t *c,
             if (bstripes > astripes) /* zig-zag .. zig*/
             {
                 for (i = 0; i < astripes; i++) {
-                    for (bp = b_entry, ap = a_entry, cp = c_entry; bp < b_end;
-                         bp++, ap++, cp++)
-                        *cp = *ap & (*bp >> shift);
+                    kernels.overlap(c_entry, a_entry, b_entry,
+                                    (int)(b_end - b_entry), -shift, 0);
                     b_entry += b->h;
                     b_end += b->h;
-                    for (bp = b_entry, ap = a_entry, cp = c_entry; bp < b_end;
-                         bp++, ap++, cp++)
-                        *cp |= *ap & (*bp << rshift);
+                    kernels.overlap(c_entry, a_entry, b_entry,
+                                    (int)(b_end - b_entry), rshift, 1);
                     a_entry += a->h;
                     c_entry += c->h;
                 }
-                for (bp = b_entry, ap = a_entry, cp = c_entry; bp < b_end;
-                     bp++, ap++, cp++)
-                    *cp = *ap & (*bp >> shift);
+                kernels.overlap(c_entry, a_entry, b_entry,
+                                (int)(b_end - b_entry), -shift, 0);
             }
             else /* zig-zag */
             {
                 for (i = 0; i < bstripes; i++) {
-                    for (bp = b_entry, ap = a_entry, cp = c_entry; bp < b_end;
-                         bp++, ap++, cp++)
-                        *cp = *ap & (*bp >> shift);
+                    kernels.overlap(c_entry, a_entry, b_entry,
+                                    (int)(b_end - b_entry), -shift, 0);
                     b_entry += b->h;
                     b_end += b->h;
-                    for (bp = b_entry, ap = a_entry, cp = c_entry; bp < b_end;
-                         bp++, ap++, cp++)
-                        *cp |= *ap & (*bp << rshift);
+                    kernels.overlap(c_entry, a_entry, b_entry,
+                                    (int)(b_end - b_entry), rshift, 1);
                     a_entry += a->h;
                     c_entry += c->h;
                 }
@@ -720,10 +789,8 @@ bitmask_overlap_mask(const bitmask_t *a, const bitmask_t *b, bitmask_t *c,
         {
             astripes = (MIN(a->w, b->w - xoffset) - 1) / BITMASK_W_LEN + 1;
             for (i = 0; i < astripes; i++) {
-                for (bp = b_entry, ap = a_entry, cp = c_entry; bp < b_end;
-                     bp++, ap++, cp++) {
-                    *cp = *ap & *bp;
-                }
+                kernels.overlap(c_entry, a_entry, b_entry,
+                                (int)(b_end - b_entry), 0, 0);
                 b_entry += b->h;
                 b_end += b->h;
                 a_entry += a->h;
@@ -753,7 +820,7 @@ void
 bitmask_draw(bitmask_t *a, const bitmask_t *b, int xoffset, int yoffset)
 {
     BITMASK_W *a_entry, *a_end, *ap;
-    const BITMASK_W *b_entry, *bp;
+    const BITMASK_W *b_entry;
     int shift, rshift, i, astripes, bstripes;
 
     /* Return if no overlap or one mask has a width/height of 0. */
@@ -781,26 +848,25 @@ bitmask_draw(bitmask_t *a, const bitmask_t *b, int xoffset, int yoffset)
             if (bstripes > astripes) /* zig-zag .. zig*/
             {
                 for (i = 0; i < astripes; i++) {
-                    for (ap = a_entry, bp = b_entry; ap < a_end; ap++, bp++)
-                        *ap |= (*bp << shift);
+                    kernels.draw(a_entry, b_entry, (int)(a_end - a_entry),
+                                 shift);
                     a_entry += a->h;
                     a_end += a->h;
-                    for (ap = a_entry, bp = b_entry; ap < a_end; ap++, bp++)
-                        *ap |= (*bp >> rshift);
+                    kernels.draw(a_entry, b_entry, (int)(a_end - a_entry),
+                                 -rshift);
                     b_entry += b->h;
                 }
-                for (ap = a_entry, bp = b_entry; ap < a_end; ap++, bp++)
-                    *ap |= (*bp << shift);
+                kernels.draw(a_entry, b_entry, (int)(a_end - a_entry), shift);
             }
             else /* zig-zag */
             {
                 for (i = 0; i < bstripes; i++) {
-                    for (ap = a_entry, bp = b_entry; ap < a_end; ap++, bp++)
-                        *ap |= (*bp << shift);
+                    kernels.draw(a_entry, b_entry, (int)(a_end - a_entry),
+                                 shift);
                     a_entry += a->h;
                     a_end += a->h;
-                    for (ap = a_entry, bp = b_entry; ap < a_end; ap++, bp++)
-                        *ap |= (*bp >> rshift);
+                    kernels.draw(a_entry, b_entry, (int)(a_end - a_entry),
+                                 -rshift);
                     b_entry += b->h;
                 }
             }
@@ -810,9 +876,7 @@ bitmask_draw(bitmask_t *a, const bitmask_t *b, int xoffset, int yoffset)
         {
             astripes = (MIN(b->w, a->w - xoffset) - 1) / BITMASK_W_LEN + 1;
             for (i = 0; i < astripes; i++) {
-                for (ap = a_entry, bp = b_entry; ap < a_end; ap++, bp++) {
-                    *ap |= *bp;
-                }
+                kernels.draw(a_entry, b_entry, (int)(a_end - a_entry), 0);
                 a_entry += a->h;
                 a_end += a->h;
                 b_entry += b->h;
@@ -843,26 +907,25 @@ bitmask_draw(bitmask_t *a, const bitmask_t *b, int xoffset, int yoffset)
             if (bstripes > astripes) /* zig-zag .. zig*/
             {
                 for (i = 0; i < astripes; i++) {
-                    for (bp = b_entry, ap = a_entry; bp < b_end; bp++, ap++)
-                        *ap |= (*bp >> shift);
+                    kernels.draw(a_entry, b_entry, (int)(b_end - b_entry),
+                                 -shift);
                     b_entry += b->h;
                     b_end += b->h;
-                    for (bp = b_entry, ap = a_entry; bp < b_end; bp++, ap++)
-                        *ap |= (*bp << rshift);
+                    kernels.draw(a_entry, b_entry, (int)(b_end - b_entry),
+                                 rshift);
                     a_entry += a->h;
                 }
-                for (bp = b_entry, ap = a_entry; bp < b_end; bp++, ap++)
-                    *ap |= (*bp >> shift);
+                kernels.draw(a_entry, b_entry, (int)(b_end - b_entry), -shift);
             }
             else /* zig-zag */
             {
                 for (i = 0; i < bstripes; i++) {
-                    for (bp = b_entry, ap = a_entry; bp < b_end; bp++, ap++)
-                        *ap |= (*bp >> shift);
+                    kernels.draw(a_entry, b_entry, (int)(b_end - b_entry),
+                                 -shift);
                     b_entry += b->h;
                     b_end += b->h;
-                    for (bp = b_entry, ap = a_entry; bp < b_end; bp++, ap++)
-                        *ap |= (*bp << rshift);
+                    kernels.draw(a_entry, b_entry, (int)(b_end - b_entry),
+                                 rshift);
                     a_entry += a->h;
                 }
             }
@@ -872,9 +935,7 @@ bitmask_draw(bitmask_t *a, const bitmask_t *b, int xoffset, int yoffset)
         {
             astripes = (MIN(a->w, b->w - xoffset) - 1) / BITMASK_W_LEN + 1;
             for (i = 0; i < astripes; i++) {
-                for (bp = b_entry, ap = a_entry; bp < b_end; bp++, ap++) {
-                    *ap |= *bp;
-                }
+                kernels.draw(a_entry, b_entry, (int)(b_end - b_entry), 0);
                 b_entry += b->h;
                 b_end += b->h;
                 a_entry += a->h;
@@ -902,8 +963,8 @@ bitmask_draw(bitmask_t *a, const bitmask_t *b, int xoffset, int yoffset)
 void
 bitmask_erase(bitmask_t *a, const bitmask_t *b, int xoffset, int yoffset)
 {
-    BITMASK_W *a_entry, *ap;
-    const BITMASK_W *b_entry, *bp;
+    BITMASK_W *a_entry;
+    const BITMASK_W *b_entry;
     int shift, rshift, i, astripes, bstripes;
 
     /* Return if no overlap or one mask has a width/height of 0. */
@@ -933,26 +994,25 @@ bitmask_erase(bitmask_t *a, const bitmask_t *b, int xoffset, int yoffset)
             if (bstripes > astripes) /* zig-zag .. zig*/
             {
                 for (i = 0; i < astripes; i++) {
-                    for (ap = a_entry, bp = b_entry; ap < a_end; ap++, bp++)
-                        *ap &= ~(*bp << shift);
+                    kernels.erase(a_entry, b_entry, (int)(a_end - a_entry),
+                                  shift);
                     a_entry += a->h;
                     a_end += a->h;
-                    for (ap = a_entry, bp = b_entry; ap < a_end; ap++, bp++)
-                        *ap &= ~(*bp >> rshift);
+                    kernels.erase(a_entry, b_entry, (int)(a_end - a_entry),
+                                  -rshift);
                     b_entry += b->h;
                 }
-                for (ap = a_entry, bp = b_entry; ap < a_end; ap++, bp++)
-                    *ap &= ~(*bp << shift);
+                kernels.erase(a_entry, b_entry, (int)(a_end - a_entry), shift);
             }
             else /* zig-zag */
             {
                 for (i = 0; i < bstripes; i++) {
-                    for (ap = a_entry, bp = b_entry; ap < a_end; ap++, bp++)
-                        *ap &= ~(*bp << shift);
+                    kernels.erase(a_entry, b_entry, (int)(a_end - a_entry),
+                                  shift);
                     a_entry += a->h;
                     a_end += a->h;
-                    for (ap = a_entry, bp = b_entry; ap < a_end; ap++, bp++)
-                        *ap &= ~(*bp >> rshift);
+                    kernels.erase(a_entry, b_entry, (int)(a_end - a_entry),
+                                  -rshift);
                     b_entry += b->h;
                 }
             }
@@ -962,9 +1022,7 @@ bitmask_erase(bitmask_t *a, const bitmask_t *b, int xoffset, int yoffset)
         {
             astripes = (MIN(b->w, a->w - xoffset) - 1) / BITMASK_W_LEN + 1;
             for (i = 0; i < astripes; i++) {
-                for (ap = a_entry, bp = b_entry; ap < a_end; ap++, bp++) {
-                    *ap &= ~*bp;
-                }
+                kernels.erase(a_entry, b_entry, (int)(a_end - a_entry), 0);
                 a_entry += a->h;
                 a_end += a->h;
                 b_entry += b->h;
@@ -995,26 +1053,26 @@ bitmask_erase(bitmask_t *a, const bitmask_t *b, int xoffset, int yoffset)
             if (bstripes > astripes) /* zig-zag .. zig*/
             {
                 for (i = 0; i < astripes; i++) {
-                    for (bp = b_entry, ap = a_entry; bp < b_end; bp++, ap++)
-                        *ap &= ~(*bp >> shift);
+                    kernels.erase(a_entry, b_entry, (int)(b_end - b_entry),
+                                  -shift);
                     b_entry += b->h;
                     b_end += b->h;
-                    for (bp = b_entry, ap = a_entry; bp < b_end; bp++, ap++)
-                        *ap &= ~(*bp << rshift);
+                    kernels.erase(a_entry, b_entry, (int)(b_end - b_entry),
+                                  rshift);
                     a_entry += a->h;
                 }
-                for (bp = b_entry, ap = a_entry; bp < b_end; bp++, ap++)
-                    *ap &= ~(*bp >> shift);
+                kernels.erase(a_entry, b_entry, (int)(b_end - b_entry),
+                              -shift);
             }
             else /* zig-zag */
             {
                 for (i = 0; i < bstripes; i++) {
-                    for (bp = b_entry, ap = a_entry; bp < b_end; bp++, ap++)
-                        *ap &= ~(*bp >> shift);
+                    kernels.erase(a_entry, b_entry, (int)(b_end - b_entry),
+                                  -shift);
                     b_entry += b->h;
                     b_end += b->h;
-                    for (bp = b_entry, ap = a_entry; bp < b_end; bp++, ap++)
-                        *ap &= ~(*bp << rshift);
+                    kernels.erase(a_entry, b_entry, (int)(b_end - b_entry),
+                                  rshift);
                     a_entry += a->h;
                 }
             }
@@ -1024,8 +1082,7 @@ bitmask_erase(bitmask_t *a, const bitmask_t *b, int xoffset, int yoffset)
         {
             astripes = (MIN(a->w, b->w - xoffset) - 1) / BITMASK_W_LEN + 1;
             for (i = 0; i < astripes; i++) {
-                for (bp = b_entry, ap = a_entry; bp < b_end; bp++, ap++)
-                    *ap &= ~*bp;
+                kernels.erase(a_entry, b_entry, (int)(b_end - b_entry), 0);
                 b_entry += b->h;
                 b_end += b->h;
                 a_entry += a->h;
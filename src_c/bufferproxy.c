@@ -541,6 +541,1082 @@ static PyTypeObject pgBufproxy_Type = {
     .tp_free = PyObject_GC_Del,
 };
 
+/**** BufferArray ****/
+
+/* A strided, n-dimensional view of the numeric items of an exported buffer,
+ * such as a Surface view or a Sound. Indexing with integers and slices makes
+ * new views of the same memory, and the arithmetic operators work on every
+ * item in C. The array made by the constructor, the root, holds the buffer;
+ * the views taken from it keep the root alive.
+ */
+
+#define BUFARRAY_MAXDIM 8
+
+typedef struct pgBufarrayObject_s {
+    PyObject_HEAD PyObject *root; /* Array holding the buffer, or NULL  */
+    pg_buffer pg_view;            /* The buffer, in a root array only   */
+    char *buf;
+    int ndim;
+    int readonly;
+    Py_ssize_t itemsize;
+    char kind;      /* 'i' signed, 'u' unsigned or 'f' floating point  */
+    char format[2]; /* The struct module format character of the items  */
+    Py_ssize_t shape[BUFARRAY_MAXDIM];
+    Py_ssize_t strides[BUFARRAY_MAXDIM];
+    PyObject *weakrefs;
+} pgBufarrayObject;
+
+static PyTypeObject pgBufarray_Type;
+
+#define pgBufarray_Check(o) PyObject_TypeCheck((o), &pgBufarray_Type)
+
+/* The item layout of an array or of an operand buffer */
+typedef struct {
+    char *buf;
+    int ndim;
+    Py_ssize_t itemsize;
+    char kind;
+    const Py_ssize_t *shape;
+    const Py_ssize_t *strides;
+} _bufarray_items_t;
+
+/* Gets the kind of the items of a buffer, or 0 with an exception set if
+ * they aren't native order numbers. */
+static char
+_bufarray_kind(Py_buffer *view_p, char *format_char)
+{
+    const char *format = view_p->format ? view_p->format : "B";
+
+    switch (*format) {
+        case '@':
+        case '=':
+            ++format;
+            break;
+        case '<':
+#if SDL_BYTEORDER != SDL_LIL_ENDIAN
+            format = "";
+#endif
+            ++format;
+            break;
+        case '>':
+        case '!':
+#if SDL_BYTEORDER == SDL_LIL_ENDIAN
+            format = "";
+#endif
+            ++format;
+            break;
+    }
+    if (*format == '1') {
+        ++format;
+    }
+    if (*format && format[1] == '\0') {
+        *format_char = *format;
+        switch (*format) {
+            case 'b':
+            case 'h':
+            case 'i':
+            case 'l':
+            case 'q':
+                return 'i';
+            case 'B':
+            case 'H':
+            case 'I':
+            case 'L':
+            case 'Q':
+                return 'u';
+            case 'f':
+                if (view_p->itemsize == sizeof(float)) {
+                    return 'f';
+                }
+                break;
+            case 'd':
+                if (view_p->itemsize == sizeof(double)) {
+                    return 'f';
+                }
+                break;
+        }
+    }
+    PyErr_Format(PyExc_ValueError,
+                 "unsupported item format '%s': expected native order "
+                 "integers or floats",
+                 view_p->format ? view_p->format : "B");
+    return 0;
+}
+
+static long long
+_bufarray_get_int(const char *p, Py_ssize_t itemsize, char kind)
+{
+    switch (itemsize) {
+        case 1:
+            return kind == 'i' ? (long long)*(Sint8 *)p
+                               : (long long)*(Uint8 *)p;
+        case 2:
+            return kind == 'i' ? (long long)*(Sint16 *)p
+                               : (long long)*(Uint16 *)p;
+        case 4:
+            return kind == 'i' ? (long long)*(Sint32 *)p
+                               : (long long)*(Uint32 *)p;
+        default:
+            return kind == 'i' ? (long long)*(Sint64 *)p
+                               : (long long)SDL_min(*(Uint64 *)p,
+                                                    (Uint64)LLONG_MAX);
+    }
+}
+
+static double
+_bufarray_get_float(const char *p, Py_ssize_t itemsize)
+{
+    return itemsize == sizeof(float) ? (double)*(float *)p : *(double *)p;
+}
+
+/* Stores an integer, clamped to the range of the item */
+static void
+_bufarray_set_int(char *p, Py_ssize_t itemsize, char kind, long long value)
+{
+    switch (itemsize) {
+        case 1:
+            if (kind == 'i') {
+                *(Sint8 *)p = (Sint8)SDL_clamp(value, -0x80, 0x7F);
+            }
+            else {
+                *(Uint8 *)p = (Uint8)SDL_clamp(value, 0, 0xFF);
+            }
+            break;
+        case 2:
+            if (kind == 'i') {
+                *(Sint16 *)p = (Sint16)SDL_clamp(value, -0x8000, 0x7FFF);
+            }
+            else {
+                *(Uint16 *)p = (Uint16)SDL_clamp(value, 0, 0xFFFF);
+            }
+            break;
+        case 4:
+            if (kind == 'i') {
+                *(Sint32 *)p =
+                    (Sint32)SDL_clamp(value, -0x7FFFFFFFLL - 1, 0x7FFFFFFFLL);
+            }
+            else {
+                *(Uint32 *)p = (Uint32)SDL_clamp(value, 0, 0xFFFFFFFFLL);
+            }
+            break;
+        default:
+            if (kind == 'i') {
+                *(Sint64 *)p = (Sint64)value;
+            }
+            else {
+                *(Uint64 *)p = (Uint64)SDL_max(value, 0);
+            }
+    }
+}
+
+static void
+_bufarray_set_float(char *p, Py_ssize_t itemsize, char kind, double value)
+{
+    if (kind == 'f') {
+        if (itemsize == sizeof(float)) {
+            *(float *)p = (float)value;
+        }
+        else {
+            *(double *)p = value;
+        }
+        return;
+    }
+    /* Truncated towards zero, NaN giving zero */
+    if (value != value) {
+        _bufarray_set_int(p, itemsize, kind, 0);
+    }
+    else if (value >= 9223372036854775807.0) {
+        _bufarray_set_int(p, itemsize, kind, LLONG_MAX);
+    }
+    else if (value <= -9223372036854775808.0) {
+        _bufarray_set_int(p, itemsize, kind, LLONG_MIN);
+    }
+    else {
+        _bufarray_set_int(p, itemsize, kind, (long long)value);
+    }
+}
+
+/* The element-wise operations */
+typedef enum {
+    BUFARRAY_SET,
+    BUFARRAY_ADD,
+    BUFARRAY_SUB,
+    BUFARRAY_MUL,
+    BUFARRAY_AND,
+    BUFARRAY_OR,
+    BUFARRAY_XOR
+} _bufarray_op_t;
+
+static long long
+_bufarray_int_op(_bufarray_op_t op, long long a, long long b)
+{
+    switch (op) {
+        case BUFARRAY_SET:
+            return b;
+        case BUFARRAY_ADD:
+            if (b > 0 && a > LLONG_MAX - b) {
+                return LLONG_MAX;
+            }
+            if (b < 0 && a < LLONG_MIN - b) {
+                return LLONG_MIN;
+            }
+            return a + b;
+        case BUFARRAY_SUB:
+            if (b < 0 && a > LLONG_MAX + b) {
+                return LLONG_MAX;
+            }
+            if (b > 0 && a < LLONG_MIN + b) {
+                return LLONG_MIN;
+            }
+            return a - b;
+        case BUFARRAY_MUL:
+            if (a > 0 ? (b > 0 ? a > LLONG_MAX / b : b < LLONG_MIN / a)
+                      : (b > 0 ? a < LLONG_MIN / b
+                               : a && b < LLONG_MAX / a)) {
+                return (a < 0) == (b < 0) ? LLONG_MAX : LLONG_MIN;
+            }
+            return a * b;
+        case BUFARRAY_AND:
+            return a & b;
+        case BUFARRAY_OR:
+            return a | b;
+        default: /* BUFARRAY_XOR */
+            return a ^ b;
+    }
+}
+
+static double
+_bufarray_float_op(_bufarray_op_t op, double a, double b)
+{
+    switch (op) {
+        case BUFARRAY_SET:
+            return b;
+        case BUFARRAY_ADD:
+            return a + b;
+        case BUFARRAY_SUB:
+            return a - b;
+        default: /* BUFARRAY_MUL, the bitwise ones are rejected earlier */
+            return a * b;
+    }
+}
+
+/* The right hand operand: a number, or items of the same shape */
+typedef struct {
+    _bufarray_items_t items;
+    int is_float;
+    long long int_value;
+    double float_value;
+} _bufarray_operand_t;
+
+static void
+_bufarray_apply_dim(const _bufarray_items_t *dst, char *dst_p,
+                    const _bufarray_operand_t *src, char *src_p, int dim,
+                    _bufarray_op_t op)
+{
+    Py_ssize_t i;
+    Py_ssize_t n = dst->shape[dim];
+    Py_ssize_t dst_stride = dst->strides[dim];
+    Py_ssize_t src_stride = src->items.buf ? src->items.strides[dim] : 0;
+    int use_float = dst->kind == 'f' || src->is_float ||
+                    (src->items.buf && src->items.kind == 'f');
+    long long a, b;
+    double fa, fb;
+
+    if (dim < dst->ndim - 1) {
+        for (i = 0; i < n; ++i) {
+            _bufarray_apply_dim(dst, dst_p, src, src_p, dim + 1, op);
+            dst_p += dst_stride;
+            src_p += src_stride;
+        }
+        return;
+    }
+    for (i = 0; i < n; ++i) {
+        if (use_float) {
+            fa = dst->kind == 'f' ? _bufarray_get_float(dst_p, dst->itemsize)
+                                  : (double)_bufarray_get_int(
+                                        dst_p, dst->itemsize, dst->kind);
+            if (!src->items.buf) {
+                fb = src->is_float ? src->float_value
+                                   : (double)src->int_value;
+            }
+            else if (src->items.kind == 'f') {
+                fb = _bufarray_get_float(src_p, src->items.itemsize);
+            }
+            else {
+                fb = (double)_bufarray_get_int(src_p, src->items.itemsize,
+                                               src->items.kind);
+            }
+            _bufarray_set_float(dst_p, dst->itemsize, dst->kind,
+                                _bufarray_float_op(op, fa, fb));
+        }
+        else {
+            a = _bufarray_get_int(dst_p, dst->itemsize, dst->kind);
+            b = src->items.buf ? _bufarray_get_int(src_p, src->items.itemsize,
+                                                   src->items.kind)
+                               : src->int_value;
+            _bufarray_set_int(dst_p, dst->itemsize, dst->kind,
+                              _bufarray_int_op(op, a, b));
+        }
+        dst_p += dst_stride;
+        src_p += src_stride;
+    }
+}
+
+static void
+_bufarray_items(pgBufarrayObject *self, _bufarray_items_t *items)
+{
+    items->buf = self->buf;
+    items->ndim = self->ndim;
+    items->itemsize = self->itemsize;
+    items->kind = self->kind;
+    items->shape = self->shape;
+    items->strides = self->strides;
+}
+
+/* Applies op to the items and value, a number or anything exporting a
+ * buffer of the same shape. */
+static int
+_bufarray_apply(const _bufarray_items_t *dst, PyObject *value,
+                _bufarray_op_t op)
+{
+    _bufarray_operand_t src;
+    pg_buffer pg_view;
+    Py_buffer *view_p = (Py_buffer *)&pg_view;
+    char format_char;
+    int i;
+    int overflow;
+
+    memset(&src, 0, sizeof(src));
+    if (PyFloat_Check(value)) {
+        src.is_float = 1;
+        src.float_value = PyFloat_AS_DOUBLE(value);
+    }
+    else if (PyLong_Check(value)) {
+        src.int_value = PyLong_AsLongLongAndOverflow(value, &overflow);
+        if (overflow) {
+            src.int_value = overflow > 0 ? LLONG_MAX : LLONG_MIN;
+        }
+        else if (src.int_value == -1 && PyErr_Occurred()) {
+            return -1;
+        }
+    }
+    else {
+        pg_view.consumer = value;
+        if (pgObject_GetBuffer(value, &pg_view, PyBUF_RECORDS_RO)) {
+            return -1;
+        }
+        src.items.kind = _bufarray_kind(view_p, &format_char);
+        if (!src.items.kind) {
+            pgBuffer_Release(&pg_view);
+            return -1;
+        }
+        if (view_p->ndim != dst->ndim) {
+            pgBuffer_Release(&pg_view);
+            PyErr_Format(PyExc_ValueError,
+                         "expected a %d dimensional operand: got %d "
+                         "dimensions",
+                         dst->ndim, view_p->ndim);
+            return -1;
+        }
+        for (i = 0; i < dst->ndim; ++i) {
+            if (view_p->shape[i] != dst->shape[i]) {
+                pgBuffer_Release(&pg_view);
+                PyErr_Format(PyExc_ValueError,
+                             "operand size %zd does not match size %zd of "
+                             "dimension %d",
+                             view_p->shape[i], dst->shape[i], i);
+                return -1;
+            }
+        }
+        src.items.buf = view_p->buf;
+        src.items.ndim = view_p->ndim;
+        src.items.itemsize = view_p->itemsize;
+        src.items.shape = view_p->shape;
+        src.items.strides = view_p->strides;
+    }
+    if (op >= BUFARRAY_AND &&
+        (dst->kind == 'f' || src.is_float || src.items.kind == 'f')) {
+        if (src.items.buf) {
+            pgBuffer_Release(&pg_view);
+        }
+        PyErr_SetString(PyExc_TypeError,
+                        "bitwise operations need integer items");
+        return -1;
+    }
+
+    if (dst->ndim) {
+        Py_BEGIN_ALLOW_THREADS;
+        _bufarray_apply_dim(dst, dst->buf, &src, src.items.buf, 0, op);
+        Py_END_ALLOW_THREADS;
+    }
+    else {
+        /* A single item, see bufarray_ass_subscript */
+        _bufarray_items_t one = *dst;
+        Py_ssize_t shape = 1;
+        Py_ssize_t stride = 0;
+
+        one.ndim = 1;
+        one.shape = &shape;
+        one.strides = &stride;
+        if (src.items.buf) {
+            src.items.shape = &shape;
+            src.items.strides = &stride;
+        }
+        _bufarray_apply_dim(&one, one.buf, &src, src.items.buf, 0, op);
+    }
+    if (src.items.buf) {
+        pgBuffer_Release(&pg_view);
+    }
+    return 0;
+}
+
+static pgBufarrayObject *
+_bufarray_new_view(pgBufarrayObject *self)
+{
+    pgBufarrayObject *view =
+        (pgBufarrayObject *)pgBufarray_Type.tp_alloc(&pgBufarray_Type, 0);
+    PyObject *root = self->root ? self->root : (PyObject *)self;
+
+    if (!view) {
+        return 0;
+    }
+    Py_INCREF(root);
+    view->root = root;
+    view->buf = self->buf;
+    view->ndim = self->ndim;
+    view->readonly = self->readonly;
+    view->itemsize = self->itemsize;
+    view->kind = self->kind;
+    view->format[0] = self->format[0];
+    memcpy(view->shape, self->shape, sizeof(self->shape));
+    memcpy(view->strides, self->strides, sizeof(self->strides));
+    return view;
+}
+
+static PyObject *
+bufarray_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
+{
+    PyObject *obj;
+    pgBufarrayObject *self;
+    Py_buffer *view_p;
+    int i;
+    char *keywords[] = {"obj", 0};
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "O:BufferArray", keywords,
+                                     &obj)) {
+        return 0;
+    }
+    self = (pgBufarrayObject *)type->tp_alloc(type, 0);
+    if (!self) {
+        return 0;
+    }
+    view_p = (Py_buffer *)&self->pg_view;
+    self->pg_view.consumer = (PyObject *)self;
+    if (pgObject_GetBuffer(obj, &self->pg_view, PyBUF_RECORDS)) {
+        if (!PyErr_ExceptionMatches(PyExc_BufferError)) {
+            Py_DECREF(self);
+            return 0;
+        }
+        PyErr_Clear();
+        self->pg_view.consumer = (PyObject *)self;
+        if (pgObject_GetBuffer(obj, &self->pg_view, PyBUF_RECORDS_RO)) {
+            Py_DECREF(self);
+            return 0;
+        }
+    }
+    /* The buffer is held from here on, so dealloc releases it */
+    self->buf = view_p->buf;
+    self->readonly = view_p->readonly;
+    self->itemsize = view_p->itemsize;
+    self->ndim = view_p->ndim;
+    self->kind = _bufarray_kind(view_p, self->format);
+    if (!self->kind) {
+        Py_DECREF(self);
+        return 0;
+    }
+    if (view_p->ndim < 1 || view_p->ndim > BUFARRAY_MAXDIM) {
+        PyErr_Format(PyExc_ValueError,
+                     "expected 1 to %d dimensions: got %d", BUFARRAY_MAXDIM,
+                     view_p->ndim);
+        Py_DECREF(self);
+        return 0;
+    }
+    if (view_p->suboffsets) {
+        for (i = 0; i < view_p->ndim; ++i) {
+            if (view_p->suboffsets[i] >= 0) {
+                PyErr_SetString(PyExc_ValueError,
+                                "indirect buffers are unsupported");
+                Py_DECREF(self);
+                return 0;
+            }
+        }
+    }
+    for (i = 0; i < view_p->ndim; ++i) {
+        self->shape[i] = view_p->shape[i];
+        self->strides[i] = view_p->strides[i];
+    }
+    return (PyObject *)self;
+}
+
+static void
+bufarray_dealloc(pgBufarrayObject *self)
+{
+    if (self->weakrefs) {
+        PyObject_ClearWeakRefs((PyObject *)self);
+    }
+    if (self->root) {
+        Py_DECREF(self->root);
+    }
+    else if (self->buf) {
+        pgBuffer_Release(&self->pg_view);
+    }
+    Py_TYPE(self)->tp_free((PyObject *)self);
+}
+
+static PyObject *
+bufarray_repr(pgBufarrayObject *self)
+{
+    PyObject *shape = PyTuple_New(self->ndim);
+    PyObject *repr;
+    int i;
+
+    if (!shape) {
+        return 0;
+    }
+    for (i = 0; i < self->ndim; ++i) {
+        PyObject *size = PyLong_FromSsize_t(self->shape[i]);
+
+        if (!size) {
+            Py_DECREF(shape);
+            return 0;
+        }
+        PyTuple_SET_ITEM(shape, i, size);
+    }
+    repr = PyUnicode_FromFormat("<BufferArray(shape=%R, format='%s')>",
+                                shape, self->format);
+    Py_DECREF(shape);
+    return repr;
+}
+
+/**** Sequence and mapping access ****/
+
+static Py_ssize_t
+bufarray_length(pgBufarrayObject *self)
+{
+    return self->shape[0];
+}
+
+/* Narrows the view in place by key, an index, a slice or a tuple of them.
+ * Integer indices remove a dimension, so the view can end up with none. */
+static int
+_bufarray_narrow(pgBufarrayObject *view, PyObject *key)
+{
+    PyObject *item;
+    Py_ssize_t nkeys = PyTuple_Check(key) ? PyTuple_GET_SIZE(key) : 1;
+    Py_ssize_t k;
+    int dim = 0;
+    int i;
+    Py_ssize_t index, start, stop, step, length;
+
+    if (nkeys > view->ndim) {
+        PyErr_Format(PyExc_IndexError,
+                     "too many indices: %zd for %d dimensions", nkeys,
+                     view->ndim);
+        return -1;
+    }
+    for (k = 0; k < nkeys; ++k) {
+        item = PyTuple_Check(key) ? PyTuple_GET_ITEM(key, k) : key;
+        if (PySlice_Check(item)) {
+            if (PySlice_Unpack(item, &start, &stop, &step) < 0) {
+                return -1;
+            }
+            length = PySlice_AdjustIndices(view->shape[dim], &start, &stop,
+                                           step);
+            view->buf += start * view->strides[dim];
+            view->shape[dim] = length;
+            view->strides[dim] *= step;
+            ++dim;
+        }
+        else if (PyIndex_Check(item)) {
+            index = PyNumber_AsSsize_t(item, PyExc_IndexError);
+            if (index == -1 && PyErr_Occurred()) {
+                return -1;
+            }
+            if (index < 0) {
+                index += view->shape[dim];
+            }
+            if (index < 0 || index >= view->shape[dim]) {
+                PyErr_SetString(PyExc_IndexError, "array index out of range");
+                return -1;
+            }
+            view->buf += index * view->strides[dim];
+            for (i = dim; i < view->ndim - 1; ++i) {
+                view->shape[i] = view->shape[i + 1];
+                view->strides[i] = view->strides[i + 1];
+            }
+            --view->ndim;
+        }
+        else {
+            PyErr_Format(PyExc_TypeError,
+                         "array indices must be integers or slices, not %s",
+                         Py_TYPE(item)->tp_name);
+            return -1;
+        }
+    }
+    return 0;
+}
+
+static PyObject *
+_bufarray_item_value(pgBufarrayObject *view)
+{
+    if (view->kind == 'f') {
+        return PyFloat_FromDouble(
+            _bufarray_get_float(view->buf, view->itemsize));
+    }
+    if (view->kind == 'u' && view->itemsize == 8) {
+        return PyLong_FromUnsignedLongLong(*(Uint64 *)view->buf);
+    }
+    return PyLong_FromLongLong(
+        _bufarray_get_int(view->buf, view->itemsize, view->kind));
+}
+
+static PyObject *
+bufarray_subscript(pgBufarrayObject *self, PyObject *key)
+{
+    pgBufarrayObject *view = _bufarray_new_view(self);
+    PyObject *value;
+
+    if (!view) {
+        return 0;
+    }
+    if (_bufarray_narrow(view, key)) {
+        Py_DECREF(view);
+        return 0;
+    }
+    if (view->ndim) {
+        return (PyObject *)view;
+    }
+    value = _bufarray_item_value(view);
+    Py_DECREF(view);
+    return value;
+}
+
+static PyObject *
+bufarray_item(pgBufarrayObject *self, Py_ssize_t index)
+{
+    PyObject *key = PyLong_FromSsize_t(index);
+    PyObject *value;
+
+    if (!key) {
+        return 0;
+    }
+    value = bufarray_subscript(self, key);
+    Py_DECREF(key);
+    return value;
+}
+
+static int
+bufarray_ass_subscript(pgBufarrayObject *self, PyObject *key, PyObject *value)
+{
+    pgBufarrayObject view;
+    _bufarray_items_t items;
+
+    if (!value) {
+        PyErr_SetString(PyExc_TypeError, "cannot delete array items");
+        return -1;
+    }
+    if (self->readonly) {
+        PyErr_SetString(PyExc_TypeError, "the array is read-only");
+        return -1;
+    }
+    view = *self;
+    if (_bufarray_narrow(&view, key)) {
+        return -1;
+    }
+    _bufarray_items(&view, &items);
+    return _bufarray_apply(&items, value, BUFARRAY_SET);
+}
+
+/**** Arithmetic ****/
+
+static PyObject *
+bufarray_copy(pgBufarrayObject *self, PyObject *_null)
+{
+    pgBufarrayObject *copy;
+    PyObject *bytes;
+    PyObject *view;
+    Py_ssize_t size = self->itemsize;
+    Py_ssize_t shape[BUFARRAY_MAXDIM];
+    Py_ssize_t strides[BUFARRAY_MAXDIM];
+    int i;
+    _bufarray_items_t items;
+    Py_buffer *view_p;
+
+    for (i = self->ndim - 1; i >= 0; --i) {
+        shape[i] = self->shape[i];
+        strides[i] = size;
+        size *= self->shape[i];
+    }
+    bytes = PyByteArray_FromStringAndSize(0, size);
+    if (!bytes) {
+        return 0;
+    }
+    copy = (pgBufarrayObject *)pgBufarray_Type.tp_alloc(&pgBufarray_Type, 0);
+    if (!copy) {
+        Py_DECREF(bytes);
+        return 0;
+    }
+    /* A root array over a new bytearray, shaped and typed like self */
+    view_p = (Py_buffer *)&copy->pg_view;
+    copy->pg_view.consumer = (PyObject *)copy;
+    if (pgObject_GetBuffer(bytes, &copy->pg_view, PyBUF_RECORDS)) {
+        Py_DECREF(bytes);
+        Py_DECREF(copy);
+        return 0;
+    }
+    Py_DECREF(bytes);
+    copy->buf = view_p->buf;
+    copy->ndim = self->ndim;
+    copy->itemsize = self->itemsize;
+    copy->kind = self->kind;
+    copy->format[0] = self->format[0];
+    memcpy(copy->shape, shape, sizeof(shape));
+    memcpy(copy->strides, strides, sizeof(strides));
+
+    view = (PyObject *)_bufarray_new_view(self);
+    if (!view) {
+        Py_DECREF(copy);
+        return 0;
+    }
+    _bufarray_items(copy, &items);
+    if (_bufarray_apply(&items, view, BUFARRAY_SET)) {
+        Py_DECREF(view);
+        Py_DECREF(copy);
+        return 0;
+    }
+    Py_DECREF(view);
+    return (PyObject *)copy;
+}
+
+static PyObject *
+_bufarray_inplace(PyObject *self, PyObject *value, _bufarray_op_t op)
+{
+    _bufarray_items_t items;
+
+    if (!pgBufarray_Check(self)) {
+        Py_RETURN_NOTIMPLEMENTED;
+    }
+    if (((pgBufarrayObject *)self)->readonly) {
+        PyErr_SetString(PyExc_TypeError, "the array is read-only");
+        return 0;
+    }
+    _bufarray_items((pgBufarrayObject *)self, &items);
+    if (_bufarray_apply(&items, value, op)) {
+        return 0;
+    }
+    Py_INCREF(self);
+    return self;
+}
+
+static PyObject *
+_bufarray_binary(PyObject *a, PyObject *b, _bufarray_op_t op)
+{
+    PyObject *result;
+    PyObject *value;
+
+    if (!pgBufarray_Check(a)) {
+        /* number op array, only for the operations that commute */
+        if (op == BUFARRAY_SUB || !pgBufarray_Check(b)) {
+            Py_RETURN_NOTIMPLEMENTED;
+        }
+        value = a;
+        a = b;
+        b = value;
+    }
+    result = bufarray_copy((pgBufarrayObject *)a, 0);
+    if (!result) {
+        return 0;
+    }
+    value = _bufarray_inplace(result, b, op);
+    Py_DECREF(result);
+    return value;
+}
+
+static PyObject *
+bufarray_add(PyObject *a, PyObject *b)
+{
+    return _bufarray_binary(a, b, BUFARRAY_ADD);
+}
+
+static PyObject *
+bufarray_sub(PyObject *a, PyObject *b)
+{
+    return _bufarray_binary(a, b, BUFARRAY_SUB);
+}
+
+static PyObject *
+bufarray_mul(PyObject *a, PyObject *b)
+{
+    return _bufarray_binary(a, b, BUFARRAY_MUL);
+}
+
+static PyObject *
+bufarray_and(PyObject *a, PyObject *b)
+{
+    return _bufarray_binary(a, b, BUFARRAY_AND);
+}
+
+static PyObject *
+bufarray_or(PyObject *a, PyObject *b)
+{
+    return _bufarray_binary(a, b, BUFARRAY_OR);
+}
+
+static PyObject *
+bufarray_xor(PyObject *a, PyObject *b)
+{
+    return _bufarray_binary(a, b, BUFARRAY_XOR);
+}
+
+static PyObject *
+bufarray_iadd(PyObject *self, PyObject *value)
+{
+    return _bufarray_inplace(self, value, BUFARRAY_ADD);
+}
+
+static PyObject *
+bufarray_isub(PyObject *self, PyObject *value)
+{
+    return _bufarray_inplace(self, value, BUFARRAY_SUB);
+}
+
+static PyObject *
+bufarray_imul(PyObject *self, PyObject *value)
+{
+    return _bufarray_inplace(self, value, BUFARRAY_MUL);
+}
+
+static PyObject *
+bufarray_iand(PyObject *self, PyObject *value)
+{
+    return _bufarray_inplace(self, value, BUFARRAY_AND);
+}
+
+static PyObject *
+bufarray_ior(PyObject *self, PyObject *value)
+{
+    return _bufarray_inplace(self, value, BUFARRAY_OR);
+}
+
+static PyObject *
+bufarray_ixor(PyObject *self, PyObject *value)
+{
+    return _bufarray_inplace(self, value, BUFARRAY_XOR);
+}
+
+static PyObject *
+bufarray_fill(pgBufarrayObject *self, PyObject *value)
+{
+    PyObject *rval = _bufarray_inplace((PyObject *)self, value, BUFARRAY_SET);
+
+    if (!rval) {
+        return 0;
+    }
+    Py_DECREF(rval);
+    Py_RETURN_NONE;
+}
+
+/**** Getters ****/
+
+static PyObject *
+_bufarray_ssize_tuple(const Py_ssize_t *values, int n)
+{
+    PyObject *tuple = PyTuple_New(n);
+    PyObject *item;
+    int i;
+
+    if (!tuple) {
+        return 0;
+    }
+    for (i = 0; i < n; ++i) {
+        item = PyLong_FromSsize_t(values[i]);
+        if (!item) {
+            Py_DECREF(tuple);
+            return 0;
+        }
+        PyTuple_SET_ITEM(tuple, i, item);
+    }
+    return tuple;
+}
+
+static PyObject *
+bufarray_get_shape(pgBufarrayObject *self, void *closure)
+{
+    return _bufarray_ssize_tuple(self->shape, self->ndim);
+}
+
+static PyObject *
+bufarray_get_strides(pgBufarrayObject *self, void *closure)
+{
+    return _bufarray_ssize_tuple(self->strides, self->ndim);
+}
+
+static PyObject *
+bufarray_get_ndim(pgBufarrayObject *self, void *closure)
+{
+    return PyLong_FromLong(self->ndim);
+}
+
+static PyObject *
+bufarray_get_itemsize(pgBufarrayObject *self, void *closure)
+{
+    return PyLong_FromSsize_t(self->itemsize);
+}
+
+static PyObject *
+bufarray_get_format(pgBufarrayObject *self, void *closure)
+{
+    return PyUnicode_FromString(self->format);
+}
+
+static PyObject *
+bufarray_get_readonly(pgBufarrayObject *self, void *closure)
+{
+    return PyBool_FromLong(self->readonly);
+}
+
+static PyObject *
+bufarray_get_parent(pgBufarrayObject *self, void *closure)
+{
+    pgBufarrayObject *root =
+        self->root ? (pgBufarrayObject *)self->root : self;
+    PyObject *obj = ((Py_buffer *)&root->pg_view)->obj;
+
+    obj = obj ? obj : Py_None;
+    Py_INCREF(obj);
+    return obj;
+}
+
+/**** Buffer export ****/
+
+static int
+bufarray_getbuffer(pgBufarrayObject *self, Py_buffer *view_p, int flags)
+{
+    Py_ssize_t len = self->itemsize;
+    Py_ssize_t expected = self->itemsize;
+    int contiguous = 1;
+    int i;
+
+    view_p->obj = 0;
+    if (PyBUF_HAS_FLAG(flags, PyBUF_WRITABLE) && self->readonly) {
+        PyErr_SetString(PyExc_BufferError, "the array is read-only");
+        return -1;
+    }
+    for (i = self->ndim - 1; i >= 0; --i) {
+        if (self->shape[i] > 1 && self->strides[i] != expected) {
+            contiguous = 0;
+        }
+        expected *= self->shape[i];
+        len *= self->shape[i];
+    }
+    if (!PyBUF_HAS_FLAG(flags, PyBUF_STRIDES) && !contiguous) {
+        PyErr_SetString(PyExc_BufferError,
+                        "the array is not contiguous: needs strides");
+        return -1;
+    }
+    if ((PyBUF_HAS_FLAG(flags, PyBUF_C_CONTIGUOUS) ||
+         PyBUF_HAS_FLAG(flags, PyBUF_ANY_CONTIGUOUS) ||
+         PyBUF_HAS_FLAG(flags, PyBUF_F_CONTIGUOUS)) &&
+        !(contiguous && !PyBUF_HAS_FLAG(flags, PyBUF_F_CONTIGUOUS))) {
+        PyErr_SetString(PyExc_BufferError, "the array is not contiguous");
+        return -1;
+    }
+    view_p->buf = self->buf;
+    view_p->len = len;
+    view_p->readonly = self->readonly;
+    view_p->itemsize = self->itemsize;
+    view_p->format = PyBUF_HAS_FLAG(flags, PyBUF_FORMAT) ? self->format : 0;
+    view_p->ndim = self->ndim;
+    view_p->shape = PyBUF_HAS_FLAG(flags, PyBUF_ND) ? self->shape : 0;
+    view_p->strides =
+        PyBUF_HAS_FLAG(flags, PyBUF_STRIDES) ? self->strides : 0;
+    view_p->suboffsets = 0;
+    view_p->internal = 0;
+    Py_INCREF(self);
+    view_p->obj = (PyObject *)self;
+    return 0;
+}
+
+static PyBufferProcs bufarray_bufferprocs = {(getbufferproc)bufarray_getbuffer,
+                                             0};
+
+static PyNumberMethods bufarray_as_number = {
+    .nb_add = bufarray_add,
+    .nb_subtract = bufarray_sub,
+    .nb_multiply = bufarray_mul,
+    .nb_and = bufarray_and,
+    .nb_or = bufarray_or,
+    .nb_xor = bufarray_xor,
+    .nb_inplace_add = bufarray_iadd,
+    .nb_inplace_subtract = bufarray_isub,
+    .nb_inplace_multiply = bufarray_imul,
+    .nb_inplace_and = bufarray_iand,
+    .nb_inplace_or = bufarray_ior,
+    .nb_inplace_xor = bufarray_ixor,
+};
+
+static PySequenceMethods bufarray_as_sequence = {
+    .sq_length = (lenfunc)bufarray_length,
+    .sq_item = (ssizeargfunc)bufarray_item,
+};
+
+static PyMappingMethods bufarray_as_mapping = {
+    .mp_length = (lenfunc)bufarray_length,
+    .mp_subscript = (binaryfunc)bufarray_subscript,
+    .mp_ass_subscript = (objobjargproc)bufarray_ass_subscript,
+};
+
+static struct PyMethodDef bufarray_methods[] = {
+    {"copy", (PyCFunction)bufarray_copy, METH_NOARGS,
+     DOC_BUFFERARRAY_COPY},
+    {"fill", (PyCFunction)bufarray_fill, METH_O,
+     DOC_BUFFERARRAY_FILL},
+    {0, 0, 0, 0}};
+
+static PyGetSetDef bufarray_getsets[] = {
+    {"shape", (getter)bufarray_get_shape, 0,
+     DOC_BUFFERARRAY_SHAPE, 0},
+    {"strides", (getter)bufarray_get_strides, 0,
+     DOC_BUFFERARRAY_STRIDES, 0},
+    {"ndim", (getter)bufarray_get_ndim, 0, DOC_BUFFERARRAY_NDIM,
+     0},
+    {"itemsize", (getter)bufarray_get_itemsize, 0,
+     DOC_BUFFERARRAY_ITEMSIZE, 0},
+    {"format", (getter)bufarray_get_format, 0,
+     DOC_BUFFERARRAY_FORMAT, 0},
+    {"readonly", (getter)bufarray_get_readonly, 0,
+     DOC_BUFFERARRAY_READONLY, 0},
+    {"parent", (getter)bufarray_get_parent, 0,
+     DOC_BUFFERARRAY_PARENT, 0},
+    {0, 0, 0, 0, 0}};
+
+static PyTypeObject pgBufarray_Type = {
+    PyVarObject_HEAD_INIT(NULL, 0).tp_name = "pygame.bufferproxy.BufferArray",
+    .tp_basicsize = sizeof(pgBufarrayObject),
+    .tp_dealloc = (destructor)bufarray_dealloc,
+    .tp_repr = (reprfunc)bufarray_repr,
+    .tp_as_number = &bufarray_as_number,
+    .tp_as_sequence = &bufarray_as_sequence,
+    .tp_as_mapping = &bufarray_as_mapping,
+    .tp_as_buffer = &bufarray_bufferprocs,
+    .tp_flags = Py_TPFLAGS_DEFAULT,
+    .tp_doc = DOC_BUFFERARRAY,
+    .tp_weaklistoffset = offsetof(pgBufarrayObject, weakrefs),
+    .tp_methods = bufarray_methods,
+    .tp_getset = bufarray_getsets,
+    .tp_new = bufarray_new,
+};
+
 /**** Module methods ***/
 
 static PyMethodDef bufferproxy_methods[] = {{0, 0, 0, 0}};
@@ -613,6 +1689,9 @@ MODINIT_DEFINE(bufferproxy)
     if (PyType_Ready(&pgBufproxy_Type) < 0) {
         return NULL;
     }
+    if (PyType_Ready(&pgBufarray_Type) < 0) {
+        return NULL;
+    }
 
 #define bufferproxy_docs ""
 
@@ -621,6 +1700,10 @@ MODINIT_DEFINE(bufferproxy)
     if (!module) {
         return NULL;
     }
+    if (PG_GIL_NOT_USED(module)) {
+        Py_DECREF(module);
+        return NULL;
+    }
 
     Py_INCREF(&pgBufproxy_Type);
     if (PyModule_AddObject(module, PROXY_TYPE_NAME,
@@ -629,6 +1712,13 @@ MODINIT_DEFINE(bufferproxy)
         Py_DECREF(module);
         return NULL;
     }
+    Py_INCREF(&pgBufarray_Type);
+    if (PyModule_AddObject(module, "BufferArray",
+                           (PyObject *)&pgBufarray_Type)) {
+        Py_DECREF(&pgBufarray_Type);
+        Py_DECREF(module);
+        return NULL;
+    }
 #if PYGAMEAPI_BUFPROXY_NUMSLOTS != 4
 #error export slot count mismatch
 #endif
@@ -36,6 +36,7 @@
 #include <sys/stat.h>
 #include <sys/types.h>
 #include <sys/time.h>
+#include <sys/select.h>
 #include <sys/mman.h>
 #include <sys/ioctl.h>
 
@@ -81,6 +82,15 @@
 #ifndef V4L2_PIX_FMT_XBGR32
 #define V4L2_PIX_FMT_XBGR32 v4l2_fourcc('X', 'R', '2', '4')
 #endif
+#ifndef V4L2_PIX_FMT_UYVY
+#define V4L2_PIX_FMT_UYVY v4l2_fourcc('U', 'Y', 'V', 'Y')
+#endif
+#ifndef V4L2_PIX_FMT_SBGGR8
+#define V4L2_PIX_FMT_SBGGR8 v4l2_fourcc('B', 'A', '8', '1')
+#endif
+#ifndef V4L2_PIX_FMT_YUV420
+#define V4L2_PIX_FMT_YUV420 v4l2_fourcc('Y', 'U', '1', '2')
+#endif
 
 #define CLEAR(x) memset(&(x), 0, sizeof(x))
 #define SAT(c)        \
@@ -120,6 +130,23 @@ typedef struct pgCameraObject {
     int vflip;
     int brightness;
     int fd;
+    int pitch;
+    int held;                /* buffer lent out by get_raw_view(), or -1 */
+    unsigned int held_bytes; /* bytes of the frame in the held buffer */
+    Py_ssize_t exports;      /* buffer views of the held buffer */
+    Uint64 ticks;            /* capture time of the last get_image() frame */
+    /* capture thread of start(threaded=True), the fields below are guarded
+     * by lock. The thread converts into frames[0] and swaps it with
+     * frames[1], the latest frame, which get_image() copies. */
+    SDL_Thread *thread;
+    SDL_mutex *lock;
+    SDL_cond *cond; /* signaled on every new frame and when the thread ends */
+    SDL_Surface *frames[2];
+    Uint64 frame_ticks;  /* capture time of frames[1] */
+    Uint64 frame_count;  /* frames swapped in so far */
+    Uint64 frame_taken;  /* frame_count as of the last get_image() */
+    int thread_quit;     /* set by stop() */
+    int thread_errno;    /* why the thread ended early, or 0 */
 } pgCameraObject;
 #elif defined(PYGAME_WINDOWS_CAMERA)
 typedef struct pgCameraObject {
@@ -217,6 +244,16 @@ v4l2_query_buffer(pgCameraObject *self);
 int
 v4l2_read_frame(pgCameraObject *self, SDL_Surface *surf, int *errno_code);
 int
+v4l2_hold_frame(pgCameraObject *self, int *errno_code);
+int
+v4l2_release_frame(pgCameraObject *self, int *errno_code);
+int
+v4l2_start_thread(pgCameraObject *self);
+void
+v4l2_stop_thread(pgCameraObject *self);
+int
+v4l2_read_latest(pgCameraObject *self, SDL_Surface *surf, int *errno_code);
+int
 v4l2_stop_capturing(pgCameraObject *self);
 int
 v4l2_start_capturing(pgCameraObject *self);
@@ -149,6 +149,18 @@ v4l2_read_raw(pgCameraObject *self)
 {
     struct v4l2_buffer buf;
     PyObject *raw;
+    int errno_code = 0;
+
+    if (self->thread) {
+        return RAISE(PyExc_ValueError,
+                     "get_raw() is not available with the capture thread");
+    }
+
+    if (!v4l2_release_frame(self, &errno_code)) {
+        PyErr_Format(PyExc_SystemError, "ioctl(VIDIOC_QBUF) failure : %d, %s",
+                     errno_code, strerror(errno_code));
+        return NULL;
+    }
 
     CLEAR(buf);
 
@@ -362,6 +374,17 @@ v4l2_query_buffer(pgCameraObject *self)
 {
     unsigned int i;
 
+    /* with the capture thread, whether it has a frame get_image() hasn't
+     * returned yet */
+    if (self->thread) {
+        int ready;
+
+        SDL_LockMutex(self->lock);
+        ready = self->frame_count != self->frame_taken;
+        SDL_UnlockMutex(self->lock);
+        return ready;
+    }
+
     for (i = 0; i < self->n_buffers; ++i) {
         struct v4l2_buffer buf;
 
@@ -393,6 +416,9 @@ v4l2_read_frame(pgCameraObject *self, SDL_Surface *surf, int *errno_code)
 {
     struct v4l2_buffer buf;
 
+    if (!v4l2_release_frame(self, errno_code))
+        return 0;
+
     CLEAR(buf);
 
     buf.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
@@ -404,6 +430,7 @@ v4l2_read_frame(pgCameraObject *self, SDL_Surface *surf, int *errno_code)
     }
 
     assert(buf.index < self->n_buffers);
+    self->ticks = PG_GetTicks();
 
     if (!v4l2_process_image(self, self->buffers[buf.index].start,
                             self->buffers[buf.index].length, surf)) {
@@ -417,6 +444,233 @@ v4l2_read_frame(pgCameraObject *self, SDL_Surface *surf, int *errno_code)
     return 1;
 }
 
+/* Dequeues a frame and keeps its buffer out of the driver's queue, so the
+ * mmap'd memory can be handed out without a copy. A buffer held from before
+ * is given back first. This function is safe to be called with GIL
+ * released */
+int
+v4l2_hold_frame(pgCameraObject *self, int *errno_code)
+{
+    struct v4l2_buffer buf;
+
+    if (!v4l2_release_frame(self, errno_code))
+        return 0;
+
+    CLEAR(buf);
+
+    buf.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+    buf.memory = V4L2_MEMORY_MMAP;
+
+    if (-1 == v4l2_xioctl(self->fd, VIDIOC_DQBUF, &buf)) {
+        *errno_code = errno;
+        return 0;
+    }
+
+    assert(buf.index < self->n_buffers);
+
+    self->held = (int)buf.index;
+    /* some drivers leave bytesused at 0 */
+    self->held_bytes = buf.bytesused;
+    if (!self->held_bytes ||
+        self->held_bytes > self->buffers[buf.index].length)
+        self->held_bytes = (unsigned int)self->buffers[buf.index].length;
+    return 1;
+}
+
+/* Gives a buffer held by v4l2_hold_frame back to the driver. This function
+ * is safe to be called with GIL released */
+int
+v4l2_release_frame(pgCameraObject *self, int *errno_code)
+{
+    struct v4l2_buffer buf;
+
+    if (self->held < 0)
+        return 1;
+
+    CLEAR(buf);
+
+    buf.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+    buf.memory = V4L2_MEMORY_MMAP;
+    buf.index = (unsigned int)self->held;
+
+    if (-1 == v4l2_xioctl(self->fd, VIDIOC_QBUF, &buf)) {
+        *errno_code = errno;
+        return 0;
+    }
+    self->held = -1;
+    return 1;
+}
+
+/* Body of the capture thread. It waits for frames a tenth of a second at a
+ * time, so stop() is noticed while the device delivers none. */
+static int SDLCALL
+_v4l2_capture_thread(void *data)
+{
+    pgCameraObject *self = (pgCameraObject *)data;
+    struct v4l2_buffer buf;
+    struct timeval tv;
+    fd_set fds;
+    SDL_Surface *back;
+    Uint64 ticks;
+    int r, ok, quit = 0, errno_code = 0;
+
+    while (!quit) {
+        FD_ZERO(&fds);
+        FD_SET(self->fd, &fds);
+        tv.tv_sec = 0;
+        tv.tv_usec = 100000;
+
+        r = select(self->fd + 1, &fds, NULL, NULL, &tv);
+        if (r > 0) {
+            CLEAR(buf);
+            buf.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+            buf.memory = V4L2_MEMORY_MMAP;
+
+            if (-1 == v4l2_xioctl(self->fd, VIDIOC_DQBUF, &buf)) {
+                if (errno != EAGAIN) {
+                    errno_code = errno;
+                    break;
+                }
+            }
+            else {
+                assert(buf.index < self->n_buffers);
+                ticks = PG_GetTicks();
+                /* frames[0] is only ever touched by this thread */
+                ok = v4l2_process_image(self, self->buffers[buf.index].start,
+                                        self->buffers[buf.index].length,
+                                        self->frames[0]);
+                if (-1 == v4l2_xioctl(self->fd, VIDIOC_QBUF, &buf)) {
+                    errno_code = errno;
+                    break;
+                }
+                /* a short frame is dropped, like a failed get_image() */
+                if (ok) {
+                    SDL_LockMutex(self->lock);
+                    back = self->frames[1];
+                    self->frames[1] = self->frames[0];
+                    self->frames[0] = back;
+                    self->frame_ticks = ticks;
+                    self->frame_count++;
+                    SDL_CondBroadcast(self->cond);
+                    SDL_UnlockMutex(self->lock);
+                }
+            }
+        }
+        else if (r == -1 && errno != EINTR) {
+            errno_code = errno;
+            break;
+        }
+
+        SDL_LockMutex(self->lock);
+        quit = self->thread_quit;
+        SDL_UnlockMutex(self->lock);
+    }
+
+    SDL_LockMutex(self->lock);
+    self->thread_errno = errno_code;
+    self->thread_quit = 1;
+    SDL_CondBroadcast(self->cond);
+    SDL_UnlockMutex(self->lock);
+    return 0;
+}
+
+/* Starts a thread that keeps converting the newest frame of a started
+ * camera, for v4l2_read_latest to copy. Raises on failure. */
+int
+v4l2_start_thread(pgCameraObject *self)
+{
+    int i;
+
+    for (i = 0; i < 2; i++) {
+#if SDL_BYTEORDER == SDL_BIG_ENDIAN
+        self->frames[i] =
+            PG_CreateSurface(self->width, self->height, SDL_PIXELFORMAT_RGB24);
+#else
+        self->frames[i] =
+            PG_CreateSurface(self->width, self->height, SDL_PIXELFORMAT_BGR24);
+#endif
+        if (!self->frames[i])
+            goto error;
+        SDL_SetSurfaceBlendMode(self->frames[i], SDL_BLENDMODE_NONE);
+    }
+    self->frame_ticks = 0;
+    self->frame_count = 0;
+    self->frame_taken = 0;
+    self->thread_quit = 0;
+    self->thread_errno = 0;
+
+    if (!(self->lock = SDL_CreateMutex()) || !(self->cond = SDL_CreateCond()))
+        goto error;
+    self->thread =
+        SDL_CreateThread(_v4l2_capture_thread, "pygame_camera", self);
+    if (!self->thread)
+        goto error;
+    return 1;
+
+error:
+    PyErr_SetString(pgExc_SDLError, SDL_GetError());
+    v4l2_stop_thread(self);
+    return 0;
+}
+
+/* Ends the thread of v4l2_start_thread, if any, and frees what it used.
+ * This function is safe to be called with GIL released */
+void
+v4l2_stop_thread(pgCameraObject *self)
+{
+    int i;
+
+    if (self->thread) {
+        SDL_LockMutex(self->lock);
+        self->thread_quit = 1;
+        SDL_UnlockMutex(self->lock);
+        SDL_WaitThread(self->thread, NULL);
+        self->thread = NULL;
+    }
+    if (self->cond) {
+        SDL_DestroyCond(self->cond);
+        self->cond = NULL;
+    }
+    if (self->lock) {
+        SDL_DestroyMutex(self->lock);
+        self->lock = NULL;
+    }
+    for (i = 0; i < 2; i++) {
+        if (self->frames[i]) {
+            SDL_FreeSurface(self->frames[i]);
+            self->frames[i] = NULL;
+        }
+    }
+}
+
+/* Copies the newest frame of the capture thread into surf, waiting only
+ * when none arrived yet. Fails with the thread's errno if it ended early.
+ * This function is safe to be called with GIL released */
+int
+v4l2_read_latest(pgCameraObject *self, SDL_Surface *surf, int *errno_code)
+{
+    int ret = 1;
+
+    SDL_LockMutex(self->lock);
+    while (!self->frame_count && !self->thread_quit)
+        SDL_CondWait(self->cond, self->lock);
+
+    if (self->thread_errno) {
+        *errno_code = self->thread_errno;
+        ret = 0;
+    }
+    else if (!self->frame_count ||
+             SDL_BlitSurface(self->frames[1], NULL, surf, NULL)) {
+        ret = 0;
+    }
+    else {
+        self->frame_taken = self->frame_count;
+        self->ticks = self->frame_ticks;
+    }
+    SDL_UnlockMutex(self->lock);
+    return ret;
+}
+
 int
 v4l2_stop_capturing(pgCameraObject *self)
 {
@@ -430,6 +684,8 @@ v4l2_stop_capturing(pgCameraObject *self)
                      strerror(errno));
         return 0;
     }
+    /* STREAMOFF takes every buffer back, a held one included */
+    self->held = -1;
 
     return 1;
 }
@@ -665,6 +921,7 @@ v4l2_init_device(pgCameraObject *self)
     self->height = fmt.fmt.pix.height;
     self->size = self->width * self->height;
     self->pixelformat = fmt.fmt.pix.pixelformat;
+    self->pitch = fmt.fmt.pix.bytesperline;
 
     /* Buggy driver paranoia. */
     min = fmt.fmt.pix.width * 2;
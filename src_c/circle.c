@@ -312,42 +312,258 @@ pg_circle_rotate_ip(pgCircleObject *self, PyObject *const *args,
     Py_RETURN_NONE;
 }
 
-static PyObject *
-pg_circle_collideswith(pgCircleObject *self, PyObject *arg)
+/* Tests a shape or point for collision with a circle, returns 1 when they
+ * collide, 0 when they don't and -1 with an exception set when the argument
+ * isn't a shape. */
+static int
+_pg_circle_collideswith(pgCircleBase *scirc, PyObject *arg)
 {
-    int result = 0;
-    pgCircleBase *scirc = &self->circle;
     if (pgCircle_Check(arg)) {
-        result = pgCollision_CircleCircle(&pgCircle_AsCircle(arg), scirc);
+        return pgCollision_CircleCircle(&pgCircle_AsCircle(arg), scirc);
     }
     else if (pgRect_Check(arg)) {
         SDL_Rect *argrect = &pgRect_AsRect(arg);
-        result = pgCollision_RectCircle((double)argrect->x, (double)argrect->y,
-                                        (double)argrect->w, (double)argrect->h,
-                                        scirc);
+        return pgCollision_RectCircle((double)argrect->x, (double)argrect->y,
+                                      (double)argrect->w, (double)argrect->h,
+                                      scirc);
     }
     else if (pgFRect_Check(arg)) {
         SDL_FRect *argrect = &pgFRect_AsRect(arg);
-        result = pgCollision_RectCircle((double)argrect->x, (double)argrect->y,
-                                        (double)argrect->w, (double)argrect->h,
-                                        scirc);
+        return pgCollision_RectCircle((double)argrect->x, (double)argrect->y,
+                                      (double)argrect->w, (double)argrect->h,
+                                      scirc);
     }
     else if (PySequence_Check(arg)) {
         double x, y;
         if (!pg_TwoDoublesFromObj(arg, &x, &y)) {
-            return RAISE(
+            PyErr_SetString(
                 PyExc_TypeError,
                 "Invalid point argument, must be a sequence of two numbers");
+            return -1;
         }
-        result = pgCollision_CirclePoint(scirc, x, y);
+        return pgCollision_CirclePoint(scirc, x, y);
+    }
+
+    PyErr_SetString(PyExc_TypeError,
+                    "Invalid shape argument, must be a Circle, Rect / FRect, "
+                    "Line, Polygon or a sequence of two numbers");
+    return -1;
+}
+
+static PyObject *
+pg_circle_collideswith(pgCircleObject *self, PyObject *arg)
+{
+    int result = _pg_circle_collideswith(&self->circle, arg);
+    if (result < 0) {
+        return NULL;
+    }
+    return PyBool_FromLong(result);
+}
+
+static PyObject *
+pg_circle_collidelist(pgCircleObject *self, PyObject *arg)
+{
+    PyObject *seq, **items;
+    Py_ssize_t i, size;
+    int result;
+
+    seq = PySequence_Fast(arg, "Expected a sequence of shapes");
+    if (!seq) {
+        return NULL;
+    }
+    items = PySequence_Fast_ITEMS(seq);
+    size = PySequence_Fast_GET_SIZE(seq);
+
+    for (i = 0; i < size; i++) {
+        result = _pg_circle_collideswith(&self->circle, items[i]);
+        if (result) {
+            Py_DECREF(seq);
+            return result < 0 ? NULL : PyLong_FromSsize_t(i);
+        }
+    }
+    Py_DECREF(seq);
+    return PyLong_FromLong(-1);
+}
+
+static PyObject *
+pg_circle_collidelistall(pgCircleObject *self, PyObject *arg)
+{
+    PyObject *seq, **items, *list, *index;
+    Py_ssize_t i, size;
+    int result;
+
+    seq = PySequence_Fast(arg, "Expected a sequence of shapes");
+    if (!seq) {
+        return NULL;
+    }
+    list = PyList_New(0);
+    if (!list) {
+        Py_DECREF(seq);
+        return NULL;
+    }
+    items = PySequence_Fast_ITEMS(seq);
+    size = PySequence_Fast_GET_SIZE(seq);
+
+    for (i = 0; i < size; i++) {
+        result = _pg_circle_collideswith(&self->circle, items[i]);
+        if (result < 0) {
+            goto error;
+        }
+        if (result) {
+            if (!(index = PyLong_FromSsize_t(i))) {
+                goto error;
+            }
+            if (PyList_Append(list, index)) {
+                Py_DECREF(index);
+                goto error;
+            }
+            Py_DECREF(index);
+        }
+    }
+    Py_DECREF(seq);
+    return list;
+
+error:
+    Py_DECREF(seq);
+    Py_DECREF(list);
+    return NULL;
+}
+
+/* Gets a C contiguous buffer of doubles, returns 0 with an exception set
+ * when obj doesn't export one. */
+static int
+_pg_circle_double_buffer(PyObject *obj, Py_buffer *view, const char *name)
+{
+    const char *format;
+
+    if (PyObject_GetBuffer(obj, view, PyBUF_C_CONTIGUOUS | PyBUF_FORMAT)) {
+        PyErr_Format(PyExc_TypeError,
+                     "%s must be a contiguous buffer of float64 values", name);
+        return 0;
+    }
+    format = view->format ? view->format : "B";
+    if (format[0] == '@' || format[0] == '=' ||
+        (format[0] == '<' && SDL_BYTEORDER == SDL_LIL_ENDIAN) ||
+        (format[0] == '>' && SDL_BYTEORDER == SDL_BIG_ENDIAN)) {
+        format++;
+    }
+    if (strcmp(format, "d") != 0 || view->itemsize != sizeof(double)) {
+        PyErr_Format(PyExc_ValueError,
+                     "%s must hold float64 values, not format '%s'", name,
+                     view->format ? view->format : "B");
+        PyBuffer_Release(view);
+        return 0;
+    }
+    return 1;
+}
+
+/* Marks the circles overlapping the area within qr of the rect from
+ * (left, top) to (right, bottom). Points are empty rects and circles are
+ * empty rects at their center with qr as radius. Written to be auto
+ * vectorized, it has no branches and one output byte per circle. */
+static void
+_pg_circle_overlaps_kernel(const double *centers, const double *radii,
+                           Py_ssize_t n, double left, double top, double right,
+                           double bottom, double qr, Uint8 *hits)
+{
+    Py_ssize_t i;
+    for (i = 0; i < n; i++) {
+        const double cx = centers[2 * i], cy = centers[2 * i + 1];
+        const double tx = cx < left ? left : (cx > right ? right : cx);
+        const double ty = cy < top ? top : (cy > bottom ? bottom : cy);
+        const double dx = cx - tx, dy = cy - ty, r = radii[i] + qr;
+        hits[i] = dx * dx + dy * dy <= r * r;
+    }
+}
+
+static PyObject *
+pg_geometry_circle_overlaps(PyObject *self, PyObject *args, PyObject *kwargs)
+{
+    PyObject *centers_obj, *radii_obj, *query, *list = NULL, *index;
+    Py_buffer centers, radii;
+    Uint8 *hits = NULL;
+    double left, top, right, bottom, qr = 0.0;
+    Py_ssize_t i, n;
+    static char *keywords[] = {"centers", "radii", "query", NULL};
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "OOO", keywords,
+                                     &centers_obj, &radii_obj, &query)) {
+        return NULL;
+    }
+
+    if (pgCircle_Check(query)) {
+        pgCircleBase *circle = &pgCircle_AsCircle(query);
+        left = right = circle->x;
+        top = bottom = circle->y;
+        qr = circle->r;
+    }
+    else if (pgRect_Check(query)) {
+        SDL_Rect *rect = &pgRect_AsRect(query);
+        left = (double)rect->x;
+        top = (double)rect->y;
+        right = left + (double)rect->w;
+        bottom = top + (double)rect->h;
+    }
+    else if (pgFRect_Check(query)) {
+        SDL_FRect *rect = &pgFRect_AsRect(query);
+        left = (double)rect->x;
+        top = (double)rect->y;
+        right = left + (double)rect->w;
+        bottom = top + (double)rect->h;
+    }
+    else if (pg_TwoDoublesFromObj(query, &left, &top)) {
+        right = left;
+        bottom = top;
     }
     else {
         return RAISE(PyExc_TypeError,
-                     "Invalid shape argument, must be a Circle, Rect / FRect, "
-                     "Line, Polygon or a sequence of two numbers");
+                     "Invalid query argument, must be a Circle, Rect / FRect "
+                     "or a sequence of two numbers");
     }
 
-    return PyBool_FromLong(result);
+    if (!_pg_circle_double_buffer(centers_obj, &centers, "centers")) {
+        return NULL;
+    }
+    if (!_pg_circle_double_buffer(radii_obj, &radii, "radii")) {
+        PyBuffer_Release(&centers);
+        return NULL;
+    }
+    n = radii.len / (Py_ssize_t)sizeof(double);
+    if (centers.len != n * 2 * (Py_ssize_t)sizeof(double)) {
+        PyErr_Format(PyExc_ValueError,
+                     "centers must hold two values for each of the %zd radii",
+                     n);
+        goto end;
+    }
+
+    if (n && !(hits = PyMem_New(Uint8, n))) {
+        PyErr_NoMemory();
+        goto end;
+    }
+    _pg_circle_overlaps_kernel((const double *)centers.buf,
+                               (const double *)radii.buf, n, left, top, right,
+                               bottom, qr, hits);
+
+    if (!(list = PyList_New(0))) {
+        goto end;
+    }
+    for (i = 0; i < n; i++) {
+        if (!hits[i]) {
+            continue;
+        }
+        if (!(index = PyLong_FromSsize_t(i)) || PyList_Append(list, index)) {
+            Py_XDECREF(index);
+            Py_CLEAR(list);
+            goto end;
+        }
+        Py_DECREF(index);
+    }
+
+end:
+    PyMem_Free(hits);
+    PyBuffer_Release(&centers);
+    PyBuffer_Release(&radii);
+    return list;
 }
 
 static PyObject *
@@ -439,6 +655,10 @@ static struct PyMethodDef pg_circle_methods[] = {
      DOC_CIRCLE_UPDATE},
     {"collideswith", (PyCFunction)pg_circle_collideswith, METH_O,
      DOC_CIRCLE_COLLIDESWITH},
+    {"collidelist", (PyCFunction)pg_circle_collidelist, METH_O,
+     DOC_CIRCLE_COLLIDELIST},
+    {"collidelistall", (PyCFunction)pg_circle_collidelistall, METH_O,
+     DOC_CIRCLE_COLLIDELISTALL},
     {"as_rect", (PyCFunction)pg_circle_as_rect, METH_NOARGS,
      DOC_CIRCLE_ASRECT},
     {"as_frect", (PyCFunction)pg_circle_as_frect, METH_NOARGS,
@@ -93,6 +93,8 @@ _color_set_length(pgColorObject *, PyObject *);
 static PyObject *
 _color_lerp(pgColorObject *, PyObject *, PyObject *);
 static PyObject *
+_color_lerp_many(PyTypeObject *, PyObject *, PyObject *);
+static PyObject *
 _color_grayscale(pgColorObject *, PyObject *);
 static PyObject *
 _premul_alpha(pgColorObject *, PyObject *);
@@ -240,6 +242,8 @@ static PyMethodDef _color_methods[] = {
      DOC_COLOR_SETLENGTH},
     {"lerp", (PyCFunction)_color_lerp, METH_VARARGS | METH_KEYWORDS,
      DOC_COLOR_LERP},
+    {"lerp_many", (PyCFunction)_color_lerp_many,
+     METH_CLASS | METH_VARARGS | METH_KEYWORDS, DOC_COLOR_LERPMANY},
     {"grayscale", (PyCFunction)_color_grayscale, METH_NOARGS,
      DOC_COLOR_GRAYSCALE},
     {"premul_alpha", (PyCFunction)_premul_alpha, METH_NOARGS,
@@ -327,6 +331,7 @@ static PyTypeObject pgColor_Type = {
 /* Checks if object is an instance of Color (or a subtype of Color). If you
  * need exact checks, use pgColor_CheckExact */
 #define pgColor_Check(o) PyObject_IsInstance((o), (PyObject *)&pgColor_Type)
+#define pgColor_CheckExact(o) (Py_TYPE(o) == &pgColor_Type)
 
 static int
 _get_double(PyObject *obj, double *val)
@@ -584,16 +589,99 @@ _color_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
     return (PyObject *)_color_new_internal_length(type, DEFAULT_RGBA, 4);
 }
 
+/* Named colors that were already parsed, the passed string mapping to a
+ * (normalized name, THECOLORS value, packed rgba) tuple. The value is
+ * checked against THECOLORS on every hit so changes to it are picked up. */
+#define COLOR_NAME_CACHE_SIZE 1024
+static PyObject *_COLORNAMECACHE = NULL;
+
+static int
+_color_name_from_cache(PyObject *str_obj, Uint8 *rgba)
+{
+    PyObject *entry, *value;
+    Uint32 packed;
+    int ret = 1;
+
+    /* lookups hold borrowed entries, keep other threads from dropping them */
+    Py_BEGIN_CRITICAL_SECTION(_COLORNAMECACHE);
+    entry = PyDict_GetItemWithError(_COLORNAMECACHE, str_obj);
+    if (!entry) {
+        ret = PyErr_Occurred() ? -1 : 0;
+    }
+    else {
+        value =
+            PyDict_GetItemWithError(_COLORDICT, PyTuple_GET_ITEM(entry, 0));
+        if (value != PyTuple_GET_ITEM(entry, 1)) {
+            if (PyErr_Occurred() ||
+                PyDict_DelItem(_COLORNAMECACHE, str_obj)) {
+                ret = -1;
+            }
+            else {
+                ret = 0;
+            }
+        }
+        else {
+            packed =
+                (Uint32)PyLong_AsUnsignedLong(PyTuple_GET_ITEM(entry, 2));
+            rgba[0] = (Uint8)(packed >> 24);
+            rgba[1] = (Uint8)(packed >> 16);
+            rgba[2] = (Uint8)(packed >> 8);
+            rgba[3] = (Uint8)packed;
+        }
+    }
+    Py_END_CRITICAL_SECTION();
+    return ret;
+}
+
+static int
+_color_name_to_cache(PyObject *str_obj, PyObject *name, PyObject *value,
+                     const Uint8 *rgba)
+{
+    PyObject *entry;
+    int ret;
+
+    entry = Py_BuildValue("(OOk)", name, value,
+                          ((unsigned long)rgba[0] << 24) |
+                              ((unsigned long)rgba[1] << 16) |
+                              ((unsigned long)rgba[2] << 8) | rgba[3]);
+    if (!entry) {
+        return -1;
+    }
+    Py_BEGIN_CRITICAL_SECTION(_COLORNAMECACHE);
+    if (PyDict_GET_SIZE(_COLORNAMECACHE) >= COLOR_NAME_CACHE_SIZE) {
+        PyDict_Clear(_COLORNAMECACHE);
+    }
+    ret = PyDict_SetItem(_COLORNAMECACHE, str_obj, entry);
+    Py_END_CRITICAL_SECTION();
+    Py_DECREF(entry);
+    return ret;
+}
+
 static int
 _parse_color_from_text(PyObject *str_obj, Uint8 *rgba)
 {
     /* Named color */
     PyObject *color = NULL;
     PyObject *name1 = NULL, *name2 = NULL;
+    int cache, ret = 0;
 
     /* We assume the caller handled this check for us. */
     assert(PyUnicode_Check(str_obj));
 
+    /* Only exact str objects are cached, a subclass could hash and compare
+     * in its own way. */
+    cache = PyUnicode_CheckExact(str_obj);
+    if (cache) {
+        switch (_color_name_from_cache(str_obj, rgba)) {
+            case 1:
+                return 0;
+            case -1:
+                return -1;
+            default:
+                break;
+        }
+    }
+
     name1 = PyObject_CallMethod(str_obj, "replace", "(ss)", " ", "");
     if (!name1) {
         return -1;
@@ -604,8 +692,8 @@ _parse_color_from_text(PyObject *str_obj, Uint8 *rgba)
         return -1;
     }
     color = PyDict_GetItem(_COLORDICT, name2);
-    Py_DECREF(name2);
     if (!color) {
+        Py_DECREF(name2);
         switch (_hexcolor(str_obj, rgba)) {
             case TRISTATE_FAIL:
                 PyErr_SetString(PyExc_ValueError, "invalid color name");
@@ -617,6 +705,7 @@ _parse_color_from_text(PyObject *str_obj, Uint8 *rgba)
         }
     }
     else if (!pg_RGBAFromObjEx(color, rgba, PG_COLOR_HANDLE_RESTRICT_SEQ)) {
+        Py_DECREF(name2);
         PyErr_Format(PyExc_RuntimeError,
                      "internal pygame error - colordict is supposed to "
                      "only have tuple values, but there is an object of "
@@ -624,7 +713,15 @@ _parse_color_from_text(PyObject *str_obj, Uint8 *rgba)
                      Py_TYPE(color)->tp_name);
         return -1;
     }
-    return 0;
+    else {
+        /* color is borrowed from _COLORDICT, the cache keeps its own
+         * reference so that it can tell when the entry is replaced */
+        if (cache) {
+            ret = _color_name_to_cache(str_obj, name2, color, rgba);
+        }
+        Py_DECREF(name2);
+    }
+    return ret;
 }
 
 static int
@@ -821,6 +918,71 @@ _color_lerp(pgColorObject *self, PyObject *args, PyObject *kw)
     return (PyObject *)_color_new_internal(Py_TYPE(self), new_rgba);
 }
 
+/**
+ * Color.lerp_many(colors, color, amount)
+ */
+static PyObject *
+_color_lerp_many(PyTypeObject *type, PyObject *args, PyObject *kw)
+{
+    Uint8 rgba[4], to_rgba[4], new_rgba[4];
+    PyObject *colors, *colobj, *seq, *list, *item;
+    pgColorObject *color;
+    Py_ssize_t i, size;
+    int c;
+    double amt;
+    static char *keywords[] = {"colors", "color", "amount", NULL};
+
+    if (!PyArg_ParseTupleAndKeywords(args, kw, "OOd", keywords, &colors,
+                                     &colobj, &amt)) {
+        return NULL;
+    }
+
+    if (!pg_RGBAFromObjEx(colobj, to_rgba, PG_COLOR_HANDLE_ALL)) {
+        /* Exception already set for us */
+        return NULL;
+    }
+
+    if (amt < 0 || amt > 1) {
+        return RAISE(PyExc_ValueError, "Argument 3 must be in range [0, 1]");
+    }
+
+    seq = PySequence_Fast(colors, "colors must be a sequence of colors");
+    if (!seq) {
+        return NULL;
+    }
+    size = PySequence_Fast_GET_SIZE(seq);
+    list = PyList_New(size);
+    if (!list) {
+        Py_DECREF(seq);
+        return NULL;
+    }
+
+    for (i = 0; i < size; i++) {
+        item = PySequence_Fast_GET_ITEM(seq, i);
+        if (pgColor_CheckExact(item)) {
+            memcpy(rgba, ((pgColorObject *)item)->data, 4);
+        }
+        else if (!pg_RGBAFromObjEx(item, rgba, PG_COLOR_HANDLE_ALL)) {
+            Py_DECREF(seq);
+            Py_DECREF(list);
+            return NULL;
+        }
+        for (c = 0; c < 4; c++) {
+            new_rgba[c] =
+                (Uint8)pg_round(rgba[c] * (1 - amt) + to_rgba[c] * amt);
+        }
+        color = _color_new_internal(type, new_rgba);
+        if (!color) {
+            Py_DECREF(seq);
+            Py_DECREF(list);
+            return NULL;
+        }
+        PyList_SET_ITEM(list, i, (PyObject *)color);
+    }
+    Py_DECREF(seq);
+    return list;
+}
+
 /**
  * color.premul_alpha()
  */
@@ -2373,8 +2535,8 @@ error:
 static int
 pg_RGBAFromObjEx(PyObject *obj, Uint8 *rgba, pgColorHandleFlags handle_flags)
 {
-    /* Also works as a fastpath */
-    if (pgColor_Check(obj)) {
+    /* Also works as a fastpath, exact Colors skip the isinstance call */
+    if (Py_TYPE(obj) == &pgColor_Type || pgColor_Check(obj)) {
         memcpy(rgba, ((pgColorObject *)obj)->data, 4);
         return 1;
     }
@@ -2488,6 +2650,12 @@ MODINIT_DEFINE(color)
         return NULL;
     }
 
+    _COLORNAMECACHE = PyDict_New();
+    if (!_COLORNAMECACHE) {
+        Py_DECREF(_COLORDICT);
+        return NULL;
+    }
+
     /* type preparation */
     if (PyType_Ready(&pgColor_Type) < 0) {
         goto error;
@@ -2495,7 +2663,7 @@ MODINIT_DEFINE(color)
 
     /* create the module */
     module = PyModule_Create(&_module);
-    if (!module) {
+    if (!module || PG_GIL_NOT_USED(module)) {
         goto error;
     }
 
@@ -2527,5 +2695,6 @@ MODINIT_DEFINE(color)
 error:
     Py_XDECREF(module);
     Py_DECREF(_COLORDICT);
+    Py_CLEAR(_COLORNAMECACHE);
     return NULL;
 }
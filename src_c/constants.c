@@ -85,6 +85,10 @@ MODINIT_DEFINE(constants)
     if (module == NULL) {
         return NULL;
     }
+    if (PG_GIL_NOT_USED(module)) {
+        Py_DECREF(module);
+        return NULL;
+    }
 
     // Attempt to create __all__ variable for constants module
     all_list = PyList_New(0);
@@ -117,6 +121,9 @@ MODINIT_DEFINE(constants)
     DEC_CONSTSF(HIDDEN);
 
     DEC_CONSTSF(SCALED);
+    DEC_CONSTSF(PIPELINED);
+    DEC_CONSTSF(STREAMED);
+    DEC_CONSTSF(ACCELERATED);
 
     DEC_CONST(GL_RED_SIZE);
     DEC_CONST(GL_GREEN_SIZE);
@@ -157,6 +164,24 @@ MODINIT_DEFINE(constants)
     DEC_CONST(BLENDMODE_BLEND);
     DEC_CONST(BLENDMODE_ADD);
     DEC_CONST(BLENDMODE_MOD);
+
+    /* factors and operations for pygame.BlendMode */
+    DEC_CONST(BLENDFACTOR_ZERO);
+    DEC_CONST(BLENDFACTOR_ONE);
+    DEC_CONST(BLENDFACTOR_SRC_COLOR);
+    DEC_CONST(BLENDFACTOR_ONE_MINUS_SRC_COLOR);
+    DEC_CONST(BLENDFACTOR_SRC_ALPHA);
+    DEC_CONST(BLENDFACTOR_ONE_MINUS_SRC_ALPHA);
+    DEC_CONST(BLENDFACTOR_DST_COLOR);
+    DEC_CONST(BLENDFACTOR_ONE_MINUS_DST_COLOR);
+    DEC_CONST(BLENDFACTOR_DST_ALPHA);
+    DEC_CONST(BLENDFACTOR_ONE_MINUS_DST_ALPHA);
+    DEC_CONST(BLENDOPERATION_ADD);
+    DEC_CONST(BLENDOPERATION_SUBTRACT);
+    DEC_CONST(BLENDOPERATION_REV_SUBTRACT);
+    DEC_CONST(BLENDOPERATION_MINIMUM);
+    DEC_CONST(BLENDOPERATION_MAXIMUM);
+
     DEC_CONST(GL_STEREO);
     DEC_CONST(GL_MULTISAMPLEBUFFERS);
     DEC_CONST(GL_MULTISAMPLESAMPLES);
@@ -19,8 +19,10 @@ cdef extern from "SDL.h" nogil:
 
     ctypedef enum SDL_PixelFormatEnum:
         SDL_PIXELFORMAT_UNKNOWN
+        SDL_PIXELFORMAT_ARGB8888
 
     int SDL_BITSPERPIXEL(Uint32 format)
+    int SDL_BYTESPERPIXEL(Uint32 format)
 
     ctypedef struct SDL_PixelFormat:
         Uint32 format
@@ -310,6 +312,13 @@ cdef extern from "SDL.h" nogil:
                           const SDL_Rect* rect,
                           const void*     pixels,
                           int             pitch)
+    # https://wiki.libsdl.org/SDL_LockTexture
+    int SDL_LockTexture(SDL_Texture*    texture,
+                        const SDL_Rect* rect,
+                        void**          pixels,
+                        int*            pitch)
+    # https://wiki.libsdl.org/SDL_UnlockTexture
+    void SDL_UnlockTexture(SDL_Texture* texture)
     # https://wiki.libsdl.org/SDL_RenderReadPixels
     int SDL_RenderReadPixels(SDL_Renderer*   renderer,
                              const SDL_Rect* rect,
@@ -336,10 +345,13 @@ cdef extern from "SDL.h" nogil:
     # https://wiki.libsdl.org/SDL_RenderDrawLinesF
     # https://wiki.libsdl.org/SDL_RenderDrawPoint
     # https://wiki.libsdl.org/SDL_RenderDrawPointF
+    # https://wiki.libsdl.org/SDL_RenderDrawPointsF
     # https://wiki.libsdl.org/SDL_RenderDrawRect
     # https://wiki.libsdl.org/SDL_RenderDrawRectF
+    # https://wiki.libsdl.org/SDL_RenderDrawRectsF
     # https://wiki.libsdl.org/SDL_RenderFillRect
     # https://wiki.libsdl.org/SDL_RenderFillRectF
+    # https://wiki.libsdl.org/SDL_RenderFillRectsF
     # https://wiki.libsdl.org/SDL_RenderGeometry
     int SDL_RenderDrawLineF(SDL_Renderer* renderer,
                            float x1,
@@ -352,10 +364,19 @@ cdef extern from "SDL.h" nogil:
     int SDL_RenderDrawPointF(SDL_Renderer* renderer,
                            float x,
                            float y)
+    int SDL_RenderDrawPointsF(SDL_Renderer* renderer,
+                             const SDL_FPoint* points,
+                             int count)
     int SDL_RenderDrawRectF(SDL_Renderer* renderer,
                            const SDL_FRect* rect)
+    int SDL_RenderDrawRectsF(SDL_Renderer* renderer,
+                            const SDL_FRect* rects,
+                            int count)
     int SDL_RenderFillRectF(SDL_Renderer*   renderer,
                            const SDL_FRect* rect)
+    int SDL_RenderFillRectsF(SDL_Renderer*   renderer,
+                            const SDL_FRect* rects,
+                            int count)
     int SDL_RenderGeometry(SDL_Renderer* renderer,
                            SDL_Texture* texture,
                            const SDL_Vertex* vertices,
@@ -409,6 +430,19 @@ cdef extern from "SDL.h" nogil:
     int SDL_SetSurfaceBlendMode(SDL_Surface * surface, SDL_BlendMode blendMode)
     int SDL_GetSurfaceBlendMode(SDL_Surface * surface, SDL_BlendMode *blendMode)
 
+    # https://wiki.libsdl.org/SDL_ConvertPixels
+    # https://wiki.libsdl.org/SDL_LockSurface
+    # https://wiki.libsdl.org/SDL_UnlockSurface
+    # https://wiki.libsdl.org/SDL_GetPerformanceCounter
+    # https://wiki.libsdl.org/SDL_GetPerformanceFrequency
+    int SDL_ConvertPixels(int width, int height,
+                          Uint32 src_format, const void *src, int src_pitch,
+                          Uint32 dst_format, void *dst, int dst_pitch)
+    int SDL_LockSurface(SDL_Surface *surface)
+    void SDL_UnlockSurface(SDL_Surface *surface)
+    Uint64 SDL_GetPerformanceCounter()
+    Uint64 SDL_GetPerformanceFrequency()
+
 
 cdef extern from "pygame.h" nogil:
     ctypedef class pygame.color.Color [object pgColorObject]:
@@ -462,8 +496,11 @@ cdef class Renderer:
     cdef Texture _target
     cdef Window _win
     cdef int _is_borrowed
+    cdef object _uploads
+    cdef public double upload_budget
 
     cpdef object get_viewport(self)
+    cdef int _run_uploads(self, double budget) except -1
     cpdef object blit(self, object source, Rect dest=*, Rect area=*, int special_flags=*)
 
 cdef class Texture:
@@ -474,6 +511,14 @@ cdef class Texture:
 
     cpdef void draw(self, srcrect=*, dstrect=*, float angle=*, origin=*,
                     bint flip_x=*, bint flip_y=*)
+    cdef int _texture_area(self, area, SDL_Rect *rect) except -1
+
+cdef class TextureLock:
+    cdef readonly Texture texture
+    cdef void *_pixels
+    cdef Py_ssize_t _shape[2]
+    cdef Py_ssize_t _strides[2]
+    cdef int _exports
 
 cdef class Image:
     cdef Color _color
@@ -489,3 +534,15 @@ cdef class Image:
     cdef public Rect srcrect
 
     cpdef void draw(self, srcrect=*, dstrect=*)
+
+cdef class TextureAtlas:
+    cdef readonly Renderer renderer
+    cdef readonly int width
+    cdef readonly int height
+    cdef readonly int padding
+    cdef object _scale_quality
+    cdef list _pages
+    cdef list _skylines
+
+    cdef int _fit(self, list skyline, int index, int w, int h)
+    cdef tuple _pack(self, int w, int h)
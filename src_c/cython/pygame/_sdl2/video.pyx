@@ -1,9 +1,13 @@
 from cpython cimport PyObject
+from cpython.buffer cimport PyBUF_FORMAT, PyBUF_ND, PyBUF_SIMPLE, \
+    PyBUF_STRIDES, PyBUF_WRITABLE, PyObject_GetBuffer, PyBuffer_Release
 from cpython.ref cimport Py_DECREF
 cimport cython
+from collections import deque
 from pygame._sdl2.sdl2 import error
 from pygame._sdl2.sdl2 import error as errorfnc
 from libc.stdlib cimport free, malloc
+from libc.math cimport cos, sin
 
 
 WINDOWPOS_UNDEFINED = _SDL_WINDOWPOS_UNDEFINED
@@ -17,6 +21,15 @@ SCALEQUALITY_NEAREST=SDL_ScaleMode.SDL_ScaleModeNearest
 SCALEQUALITY_LINEAR=SDL_ScaleMode.SDL_ScaleModeLinear
 SCALEQUALITY_BEST=SDL_ScaleMode.SDL_ScaleModeBest
 
+# floats per sprite in the buffer of Renderer.draw_batch
+cdef enum:
+    _BATCH_RECORD = 13
+BATCH_RECORD_SIZE = _BATCH_RECORD
+
+# bytes uploaded by one SDL_UpdateTexture call of Renderer.queue_update
+cdef enum:
+    _UPLOAD_SLICE = 256 * 1024
+
 import_pygame_base()
 import_pygame_color()
 import_pygame_surface()
@@ -167,6 +180,35 @@ cdef Uint32 format_from_depth(int depth):
                                       Rmask, Gmask, Bmask, Amask)
 
 
+cdef inline Uint8 _batch_mod(float value, float mod) noexcept nogil:
+    value *= mod
+    if value <= 0:
+        return 0
+    if value >= 255:
+        return 255
+    return <Uint8>value
+
+
+cdef int _primitive_count(const float[::1] data, int size,
+                          str name) except -1:
+    """The number of primitives of size floats each in data"""
+    if data.shape[0] % size:
+        raise ValueError(f'the buffer must hold {size} floats per {name}')
+    if data.shape[0] // size > 0x7FFFFFFF:
+        raise ValueError(f'too many {name}s for one call')
+    return <int>(data.shape[0] // size)
+
+
+cdef inline void _batch_vertex(SDL_Vertex *v, float cx, float cy, float dx,
+                               float dy, float c, float s, float u, float t,
+                               SDL_Color color) noexcept nogil:
+    v.position.x = cx + dx * c - dy * s
+    v.position.y = cy + dx * s + dy * c
+    v.tex_coord.x = u
+    v.tex_coord.y = t
+    v.color = color
+
+
 # disable auto_pickle since it causes stubcheck error 
 @cython.auto_pickle(False)
 cdef class Texture:
@@ -619,6 +661,158 @@ cdef class Texture:
         if res < 0:
             raise error()
 
+    cdef int _texture_area(self, area, SDL_Rect *rect) except -1:
+        # the area of the texture given by area, None being all of it
+        cdef SDL_Rect temp
+        cdef SDL_Rect *rectptr
+        if area is None:
+            rect.x = rect.y = 0
+            rect.w = self.width
+            rect.h = self.height
+            return 0
+        rectptr = pgRect_FromObject(area, &temp)
+        if rectptr == NULL:
+            raise TypeError('area must be a rectangle or None')
+        if rectptr.x < 0 or rectptr.y < 0 or rectptr.w <= 0 or \
+                rectptr.h <= 0 or rectptr.x + rectptr.w > self.width or \
+                rectptr.y + rectptr.h > self.height:
+            raise ValueError('area must be inside the texture')
+        rect[0] = rectptr[0]
+        return 0
+
+    def lock(self, area=None):
+        """Lock a portion of a streaming texture for writing its pixels
+
+        :param area: The rectangular area of the texture to lock, or ``None``
+                     for all of it.
+        :return: A :class:`TextureLock` exposing the locked pixels through the
+                 buffer protocol.
+
+        The pixels are write-only, they don't hold what the texture shows.
+        Every pixel of the area should be written before the texture is
+        unlocked, by :meth:`TextureLock.unlock` or at the end of a ``with``
+        block.
+        """
+        # https://wiki.libsdl.org/SDL_LockTexture
+        cdef SDL_Rect rect
+        self._texture_area(area, &rect)
+
+        cdef Uint32 format_
+        if SDL_QueryTexture(self._tex, &format_, NULL, NULL, NULL) != 0:
+            raise error()
+
+        cdef void *pixels
+        cdef int pitch
+        if SDL_LockTexture(self._tex, &rect, &pixels, &pitch) < 0:
+            raise error()
+
+        cdef TextureLock lock = TextureLock.__new__(TextureLock)
+        lock.texture = self
+        lock._pixels = pixels
+        lock._shape[0] = rect.h
+        lock._shape[1] = rect.w * SDL_BYTESPERPIXEL(format_)
+        lock._strides[0] = pitch
+        lock._strides[1] = 1
+        return lock
+
+    def update_from_buffer(self, buffer, area=None, int pitch=0):
+        """Update the texture with raw pixel data
+
+        :param buffer: An object with the buffer protocol holding the pixels,
+                       in the pixel format of the texture.
+        :param area: The rectangular area of the texture to update, or
+                     ``None`` for all of it.
+        :param int pitch: The number of bytes between the starts of two rows
+                          in ``buffer``, or ``0`` for tightly packed rows.
+        """
+        # https://wiki.libsdl.org/SDL_UpdateTexture
+        cdef SDL_Rect rect
+        self._texture_area(area, &rect)
+
+        cdef Uint32 format_
+        if SDL_QueryTexture(self._tex, &format_, NULL, NULL, NULL) != 0:
+            raise error()
+        cdef Py_ssize_t row = rect.w * SDL_BYTESPERPIXEL(format_)
+        if pitch == 0:
+            pitch = <int>row
+        elif pitch < row:
+            raise ValueError('pitch is smaller than a row of the area')
+
+        cdef Py_buffer view
+        cdef int res
+        PyObject_GetBuffer(buffer, &view, PyBUF_SIMPLE)
+        try:
+            if view.len < pitch * <Py_ssize_t>(rect.h - 1) + row:
+                raise ValueError('buffer is too small for the area')
+            with nogil:
+                res = SDL_UpdateTexture(self._tex, &rect, view.buf, pitch)
+        finally:
+            PyBuffer_Release(&view)
+        if res < 0:
+            raise error()
+
+# disable auto_pickle since it causes stubcheck error
+@cython.auto_pickle(False)
+cdef class TextureLock:
+    """The locked pixels of a streaming texture, see :meth:`Texture.lock`
+
+    Exposes the locked area as a writable 2D buffer of bytes, one row of the
+    area per row of the buffer.
+    """
+
+    def __init__(self):
+        raise TypeError('use Texture.lock() to lock a texture')
+
+    def __dealloc__(self):
+        if self._pixels != NULL:
+            SDL_UnlockTexture(self.texture._tex)
+
+    def __getbuffer__(self, Py_buffer *buffer, int flags):
+        if self._pixels == NULL:
+            raise BufferError('the texture is not locked anymore')
+        cdef bint strided = (flags & PyBUF_STRIDES) == PyBUF_STRIDES
+        if not strided and self._strides[0] != self._shape[1]:
+            raise BufferError('the locked rows are not contiguous')
+        buffer.buf = self._pixels
+        buffer.obj = self
+        buffer.len = self._shape[0] * self._shape[1]
+        buffer.readonly = 0
+        buffer.itemsize = 1
+        buffer.format = 'B' if flags & PyBUF_FORMAT else NULL
+        buffer.ndim = 2
+        buffer.shape = self._shape if flags & PyBUF_ND else NULL
+        buffer.strides = self._strides if strided else NULL
+        buffer.suboffsets = NULL
+        buffer.internal = NULL
+        self._exports += 1
+
+    def __releasebuffer__(self, Py_buffer *buffer):
+        self._exports -= 1
+
+    @property
+    def locked(self):
+        """Whether the texture is still locked
+        """
+        return self._pixels != NULL
+
+    def unlock(self):
+        """Unlock the texture, uploading the written pixels
+
+        Raises ``BufferError`` while views of the pixels are still alive.
+        """
+        # https://wiki.libsdl.org/SDL_UnlockTexture
+        if self._exports > 0:
+            raise BufferError('views of the locked pixels are still alive')
+        if self._pixels != NULL:
+            self._pixels = NULL
+            SDL_UnlockTexture(self.texture._tex)
+
+    def __enter__(self):
+        return self
+
+    def __exit__(self, *args):
+        self.unlock()
+
 # disable auto_pickle since it causes stubcheck error 
 @cython.auto_pickle(False) 
 cdef class Image:
@@ -747,8 +941,202 @@ cdef class Image:
 
 # disable auto_pickle since it causes stubcheck error 
 @cython.auto_pickle(False) 
+cdef class TextureAtlas:
+
+    def __init__(self, Renderer renderer, size=(2048, 2048), int padding=1,
+                 scale_quality=None):
+        """pygame object that packs many surfaces into a few textures
+
+        Creates an empty TextureAtlas.
+
+        :param Renderer renderer: The rendering context for the textures.
+        :param tuple size: The width and height of each texture of the atlas.
+        :param int padding: Empty pixels kept to the right of and below each
+                            surface, so linear filtering doesn't bleed the
+                            neighbours in.
+        :param int scale_quality: The scale quality of the textures, see
+                                  :class:`Texture`.
+
+        Surfaces added to the atlas are copied into the first texture with room
+        for them, found with a skyline bottom-left packer. A new texture is
+        created when none has room. Each surface comes back as an
+        :class:`Image` of its area, so sprites drawn from the same texture
+        don't make the renderer switch textures.
+        """
+        if len(size) != 2:
+            raise ValueError('size must have two elements')
+        if size[0] <= 0 or size[1] <= 0:
+            raise ValueError('size must contain two positive values')
+        if padding < 0:
+            raise ValueError('padding must not be negative')
+
+        self.renderer = renderer
+        self.width, self.height = size[0], size[1]
+        self.padding = padding
+        self._scale_quality = scale_quality
+        self._pages = []
+        self._skylines = []
+
+    @property
+    def textures(self):
+        """Get a list of the textures of the atlas
+        """
+        return list(self._pages)
+
+    cdef int _fit(self, list skyline, int index, int w, int h):
+        # the lowest y at which a w by h area fits, starting at the x of the
+        # skyline node at index, or -1 if it doesn't fit there
+        cdef int x = skyline[index][0]
+        cdef int y = 0
+        cdef int left = w
+        cdef int i = index
+
+        if x + w > self.width:
+            return -1
+        while left > 0:
+            if i == len(skyline):
+                return -1
+            y = max(y, <int>skyline[i][1])
+            if y + h > self.height:
+                return -1
+            left -= skyline[i][2]
+            i += 1
+        return y
+
+    cdef tuple _pack(self, int w, int h):
+        cdef int page, i, x, y, bottom, width
+        cdef int best_page = -1, best_index = -1, best_y = 0
+        cdef int best_bottom = 0, best_width = 0
+        cdef list skyline, node, prev
+        cdef Texture texture
+        cdef SDL_Surface *surf
+
+        for page in range(len(self._skylines)):
+            skyline = self._skylines[page]
+            for i in range(len(skyline)):
+                y = self._fit(skyline, i, w, h)
+                if y < 0:
+                    continue
+                bottom = y + h
+                width = skyline[i][2]
+                if best_index < 0 or bottom < best_bottom or \
+                        (bottom == best_bottom and width < best_width):
+                    best_page, best_index, best_y = page, i, y
+                    best_bottom, best_width = bottom, width
+            if best_index >= 0:
+                break
+
+        if best_index < 0:
+            texture = Texture(self.renderer, (self.width, self.height),
+                              scale_quality=self._scale_quality)
+            texture.blend_mode = SDL_BLENDMODE_BLEND
+
+            # static textures start out undefined, clear the padding
+            surf = SDL_CreateRGBSurfaceWithFormat(
+                0, self.width, self.height, 32, format_from_depth(0))
+            if surf == NULL:
+                raise MemoryError("not enough memory for the surface")
+            clear = <object>pgSurface_New2(surf, 1)
+            # pgSurface_New2 already returned a new reference, see
+            # Renderer.to_surface
+            Py_DECREF(clear)
+            texture.update(clear)
+            self._pages.append(texture)
+            self._skylines.append([[0, 0, self.width]])
+            best_page, best_index, best_y = len(self._pages) - 1, 0, 0
+
+        skyline = self._skylines[best_page]
+        x = skyline[best_index][0]
+        skyline.insert(best_index, [x, best_y + h, w])
+
+        # cut the nodes the new one now shadows
+        i = best_index + 1
+        while i < len(skyline):
+            prev = skyline[i - 1]
+            node = skyline[i]
+            if node[0] >= prev[0] + prev[2]:
+                break
+            width = prev[0] + prev[2] - node[0]
+            node[0] += width
+            node[2] -= width
+            if node[2] > 0:
+                break
+            del skyline[i]
+
+        # join neighbours at the same height
+        i = 0
+        while i < len(skyline) - 1:
+            if skyline[i][1] == skyline[i + 1][1]:
+                skyline[i][2] += skyline[i + 1][2]
+                del skyline[i + 1]
+            else:
+                i += 1
+
+        return self._pages[best_page], x, best_y
+
+    def add(self, surface):
+        """Copy a surface into the atlas
+
+        :param pygame.Surface surface: The surface to add.
+        :return: An :class:`Image` of the area the surface was copied to.
+        """
+        if not pgSurface_Check(surface):
+            raise TypeError('surface must be a Surface')
+
+        cdef int w = surface.get_width()
+        cdef int h = surface.get_height()
+        if w <= 0 or h <= 0:
+            raise ValueError('surface must not be empty')
+        if w + self.padding > self.width or h + self.padding > self.height:
+            raise ValueError('surface is larger than the textures of the atlas')
+
+        cdef Texture texture
+        cdef int x, y
+        texture, x, y = self._pack(w + self.padding, h + self.padding)
+        area = pgRect_New4(x, y, w, h)
+        texture.update(surface, area)
+        return Image(texture, area)
+
+    def add_all(self, surfaces):
+        """Copy several surfaces into the atlas
+
+        :param surfaces: A sequence of surfaces.
+        :return: A list with an :class:`Image` for each surface, in the same
+                 order.
+
+        The surfaces are packed tallest first, which wastes less room than
+        adding them one by one in any order.
+        """
+        surfaces = list(surfaces)
+        order = sorted(range(len(surfaces)),
+                       key=lambda i: (surfaces[i].get_height(),
+                                      surfaces[i].get_width()),
+                       reverse=True)
+        images = [None] * len(surfaces)
+        for i in order:
+            images[i] = self.add(surfaces[i])
+        return images
+
+# disable auto_pickle since it causes stubcheck error 
+@cython.auto_pickle(False) 
+# disable auto_pickle since it causes stubcheck error
+@cython.auto_pickle(False)
+@cython.final
+cdef class _TextureUpload:
+    # pixels staged by Renderer.queue_update, in the format of texture
+    cdef Texture texture
+    cdef SDL_Rect rect
+    cdef int pitch
+    cdef int done  # rows already uploaded
+    cdef bytearray pixels
+
+
 cdef class Renderer:
 
+    def __cinit__(self, *args, **kwargs):
+        self._uploads = deque()
+        self.upload_budget = 2.0
+
     @classmethod
     def from_window(cls, Window window):
         cdef Renderer self = cls.__new__(cls)
@@ -905,8 +1293,107 @@ cdef class Renderer:
         Updates the screen with any rendering performed since the previous call.
         """
         # https://wiki.libsdl.org/SDL_RenderPresent
+        if self._uploads:
+            self._run_uploads(self.upload_budget)
         SDL_RenderPresent(self._renderer)
 
+    def queue_update(self, Texture texture, surface, area=None):
+        """Stage a surface to be uploaded to a texture by the next presents
+
+        :param Texture texture: A texture of this renderer.
+        :param Surface surface: The source surface.
+        :param area: The rectangular area of the texture to update, or
+                     ``None`` for all of it.
+
+        Unlike :meth:`Texture.update`, this may be called from any thread.
+        The pixels are converted and copied right away, so the surface is free
+        to change afterwards. :meth:`present` uploads them in slices until
+        :attr:`upload_budget` runs out.
+        """
+        if not pgSurface_Check(surface):
+            raise TypeError("surface must be a Surface")
+        if texture.renderer is not self:
+            raise ValueError("the texture belongs to another renderer")
+
+        cdef SDL_Rect rect
+        texture._texture_area(area, &rect)
+        cdef SDL_Surface *surf = pgSurface_AsSurface(surface)
+        if not surf:
+            raise error("display Surface quit")
+        # like Texture.update, a smaller surface updates less of the area
+        rect.w = min(rect.w, surf.w)
+        rect.h = min(rect.h, surf.h)
+        if rect.w <= 0 or rect.h <= 0:
+            return
+
+        cdef Uint32 format_
+        if SDL_QueryTexture(texture._tex, &format_, NULL, NULL, NULL) != 0:
+            raise error()
+
+        cdef _TextureUpload upload = _TextureUpload.__new__(_TextureUpload)
+        upload.texture = texture
+        upload.rect = rect
+        upload.pitch = rect.w * SDL_BYTESPERPIXEL(format_)
+        upload.done = 0
+        upload.pixels = bytearray(<Py_ssize_t>upload.pitch * rect.h)
+
+        cdef char *dst = upload.pixels
+        cdef int res
+        if SDL_LockSurface(surf) < 0:
+            raise error()
+        with nogil:
+            res = SDL_ConvertPixels(rect.w, rect.h, surf.format.format,
+                                    surf.pixels, surf.pitch, format_, dst,
+                                    upload.pitch)
+        SDL_UnlockSurface(surf)
+        if res < 0:
+            raise error()
+        self._uploads.append(upload)
+
+    @property
+    def pending_uploads(self):
+        """Get the number of updates staged by :meth:`queue_update` that are
+        not fully uploaded yet
+        """
+        return len(self._uploads)
+
+    def flush_uploads(self):
+        """Upload everything staged by :meth:`queue_update` right away
+        """
+        self._run_uploads(-1.0)
+
+    cdef int _run_uploads(self, double budget) except -1:
+        # uploads staged pixels slice by slice, until budget milliseconds
+        # have passed, or without limit for a negative budget. At least one
+        # slice is uploaded, so the queue moves on every frame.
+        cdef Uint64 start = SDL_GetPerformanceCounter()
+        cdef Uint64 limit = <Uint64>(
+            max(budget, 0.0) * SDL_GetPerformanceFrequency() / 1000.0)
+        cdef _TextureUpload upload
+        cdef SDL_Rect rect
+        cdef const char *src
+        cdef int rows, res
+
+        while self._uploads:
+            upload = self._uploads[0]
+            rows = max(1, _UPLOAD_SLICE // max(upload.pitch, 1))
+            rows = min(rows, upload.rect.h - upload.done)
+            rect = upload.rect
+            rect.y += upload.done
+            rect.h = rows
+            src = upload.pixels
+            res = SDL_UpdateTexture(upload.texture._tex, &rect,
+                                    src + <Py_ssize_t>upload.done * upload.pitch,
+                                    upload.pitch)
+            upload.done += rows
+            if upload.done >= upload.rect.h or res < 0:
+                self._uploads.popleft()
+            if res < 0:
+                raise error()
+            if budget >= 0 and SDL_GetPerformanceCounter() - start >= limit:
+                break
+        return 0
+
     cpdef get_viewport(self):
         """Get the drawing area on the rendering target
         """
@@ -1088,6 +1575,70 @@ cdef class Renderer:
         if res < 0:
             raise error()
 
+    def draw_points(self, buffer):
+        """Draw many points with a single render call
+
+        :param buffer: A contiguous buffer of 32 bit floats, with the
+                       ``x, y`` of each point.
+        """
+        # https://wiki.libsdl.org/SDL_RenderDrawPointsF
+        cdef const float[::1] data = buffer
+        cdef int count = _primitive_count(data, 2, 'point')
+        if count == 0:
+            return
+        cdef int res = SDL_RenderDrawPointsF(
+            self._renderer, <const SDL_FPoint *>&data[0], count)
+        if res < 0:
+            raise error()
+
+    def draw_lines(self, buffer):
+        """Draw a polyline with a single render call
+
+        :param buffer: A contiguous buffer of 32 bit floats, with the
+                       ``x, y`` of each point of the polyline.
+        """
+        # https://wiki.libsdl.org/SDL_RenderDrawLinesF
+        cdef const float[::1] data = buffer
+        cdef int count = _primitive_count(data, 2, 'point')
+        if count == 0:
+            return
+        cdef int res = SDL_RenderDrawLinesF(
+            self._renderer, <const SDL_FPoint *>&data[0], count)
+        if res < 0:
+            raise error()
+
+    def draw_rects(self, buffer):
+        """Draw many rectangle outlines with a single render call
+
+        :param buffer: A contiguous buffer of 32 bit floats, with the
+                       ``x, y, w, h`` of each rectangle.
+        """
+        # https://wiki.libsdl.org/SDL_RenderDrawRectsF
+        cdef const float[::1] data = buffer
+        cdef int count = _primitive_count(data, 4, 'rect')
+        if count == 0:
+            return
+        cdef int res = SDL_RenderDrawRectsF(
+            self._renderer, <const SDL_FRect *>&data[0], count)
+        if res < 0:
+            raise error()
+
+    def fill_rects(self, buffer):
+        """Draw many filled rectangles with a single render call
+
+        :param buffer: A contiguous buffer of 32 bit floats, with the
+                       ``x, y, w, h`` of each rectangle.
+        """
+        # https://wiki.libsdl.org/SDL_RenderFillRectsF
+        cdef const float[::1] data = buffer
+        cdef int count = _primitive_count(data, 4, 'rect')
+        if count == 0:
+            return
+        cdef int res = SDL_RenderFillRectsF(
+            self._renderer, <const SDL_FRect *>&data[0], count)
+        if res < 0:
+            raise error()
+
     def draw_triangle(self, p1, p2, p3):
         # https://wiki.libsdl.org/SDL_RenderDrawLinesF
         cdef SDL_FPoint fpoints[4]
@@ -1142,6 +1693,96 @@ cdef class Renderer:
         if res < 0:
             raise error()
 
+    def draw_batch(self, Texture texture, buffer):
+        """Draw many portions of a texture with a single render call
+
+        :param Texture texture: The texture to draw from.
+        :param buffer: A contiguous buffer of 32 bit floats, with
+                       ``BATCH_RECORD_SIZE`` (13) floats per sprite: the
+                       destination rect ``x, y, w, h``, the source rect
+                       ``x, y, w, h`` on the texture, the clockwise angle in
+                       degrees to rotate around the center of the destination
+                       rect, and the color modulation ``r, g, b, a`` (0-255).
+        """
+        # https://wiki.libsdl.org/SDL_RenderGeometry
+        if not SDL_VERSION_ATLEAST(2, 0, 18):
+            raise error("draw_batch requires SDL 2.0.18 or newer")
+
+        cdef const float[::1] data = buffer
+        cdef Py_ssize_t count = data.shape[0] // _BATCH_RECORD
+        if data.shape[0] % _BATCH_RECORD:
+            raise ValueError('the buffer must hold 13 floats per sprite')
+        if count == 0:
+            return
+        if count > 0x7FFFFFFF // 6:
+            raise ValueError('too many sprites for one batch')
+
+        cdef Uint8 _r_mod, _g_mod, _b_mod, _a_mod
+        SDL_GetTextureColorMod(texture._tex, &_r_mod, &_g_mod, &_b_mod)
+        SDL_GetTextureAlphaMod(texture._tex, &_a_mod)
+        cdef float r_mod = <float>_r_mod / <float>255.0
+        cdef float g_mod = <float>_g_mod / <float>255.0
+        cdef float b_mod = <float>_b_mod / <float>255.0
+        cdef float a_mod = <float>_a_mod / <float>255.0
+
+        cdef SDL_Vertex *vertices = <SDL_Vertex *>malloc(
+            count * 4 * sizeof(SDL_Vertex))
+        cdef int *indices = <int *>malloc(count * 6 * sizeof(int))
+        if vertices == NULL or indices == NULL:
+            free(vertices)
+            free(indices)
+            raise MemoryError()
+
+        cdef float tw = texture.width, th = texture.height
+        cdef const float *rec
+        cdef SDL_Vertex *v
+        cdef SDL_Color color
+        cdef float hw, hh, cx, cy, c, s, u0, v0, u1, v1
+        cdef Py_ssize_t i
+        cdef int k, base
+        with nogil:
+            for i in range(count):
+                rec = &data[i * _BATCH_RECORD]
+                hw = rec[2] * <float>0.5
+                hh = rec[3] * <float>0.5
+                cx = rec[0] + hw
+                cy = rec[1] + hh
+                c = cos(rec[8] * <float>0.017453292519943295)
+                s = sin(rec[8] * <float>0.017453292519943295)
+                u0 = rec[4] / tw
+                v0 = rec[5] / th
+                u1 = (rec[4] + rec[6]) / tw
+                v1 = (rec[5] + rec[7]) / th
+                color.r = _batch_mod(rec[9], r_mod)
+                color.g = _batch_mod(rec[10], g_mod)
+                color.b = _batch_mod(rec[11], b_mod)
+                color.a = _batch_mod(rec[12], a_mod)
+
+                # corners clockwise from the top left, rotated around the
+                # center
+                v = vertices + i * 4
+                _batch_vertex(v, cx, cy, -hw, -hh, c, s, u0, v0, color)
+                _batch_vertex(v + 1, cx, cy, hw, -hh, c, s, u1, v0, color)
+                _batch_vertex(v + 2, cx, cy, hw, hh, c, s, u1, v1, color)
+                _batch_vertex(v + 3, cx, cy, -hw, hh, c, s, u0, v1, color)
+
+                base = <int>(i * 4)
+                k = <int>(i * 6)
+                indices[k] = base
+                indices[k + 1] = base + 1
+                indices[k + 2] = base + 2
+                indices[k + 3] = base + 2
+                indices[k + 4] = base + 3
+                indices[k + 5] = base
+
+        cdef int res = SDL_RenderGeometry(self._renderer, texture._tex,
+                                          vertices, <int>(count * 4),
+                                          indices, <int>(count * 6))
+        free(vertices)
+        free(indices)
+        if res < 0:
+            raise error()
+
     def fill_quad(self, p1, p2, p3, p4):
         # https://wiki.libsdl.org/SDL_RenderGeometry
         if not SDL_VERSION_ATLEAST(2, 0, 18):
@@ -1253,6 +1894,55 @@ cdef class Renderer:
             raise error()
         return surface
 
+    def read_pixels(self, buffer=None, area=None):
+        """Read pixels from the current rendering target into a buffer
+
+        :param buffer: A writable object with the buffer protocol to read the
+                       pixels into, at least ``4 * w * h`` bytes long for the
+                       area, otherwise ``ValueError`` is raised.
+                       If set to ``None``, a new ``bytearray`` is created.
+        :param area: The area of the screen to read pixels from. The area is
+                     clipped to fit inside the viewport.
+                     If ``None``, the entire viewport is used.
+        :return: ``buffer``, holding tightly packed rows of 32 bit pixels in
+                 the ``"BGRA"`` byte order of :func:`pygame.image.frombuffer`.
+        """
+        # https://wiki.libsdl.org/SDL_RenderReadPixels
+        cdef SDL_Rect rarea
+        cdef SDL_Rect tempviewport
+        cdef SDL_Rect *rectptr
+        cdef Py_buffer view
+        cdef int res
+
+        SDL_RenderGetViewport(self._renderer, &tempviewport)
+        if area is not None:
+            rectptr = pgRect_FromObject(area, &rarea)
+            if rectptr == NULL:
+                raise TypeError('area must be None or a rect')
+            if not SDL_IntersectRect(rectptr, &tempviewport, &rarea):
+                rarea.w = rarea.h = 0
+        else:
+            rarea = tempviewport
+
+        if buffer is None:
+            buffer = bytearray(4 * rarea.w * rarea.h)
+        if rarea.w <= 0 or rarea.h <= 0:
+            return buffer
+
+        PyObject_GetBuffer(buffer, &view, PyBUF_WRITABLE)
+        try:
+            if view.len < 4 * <Py_ssize_t>rarea.w * rarea.h:
+                raise ValueError('the buffer is too small for the area')
+            with nogil:
+                res = SDL_RenderReadPixels(self._renderer, &rarea,
+                                           SDL_PIXELFORMAT_ARGB8888,
+                                           view.buf, 4 * rarea.w)
+        finally:
+            PyBuffer_Release(&view)
+        if res < 0:
+            raise error()
+        return buffer
+
     @staticmethod
     def compose_custom_blend_mode(color_mode, alpha_mode):
         """Compose a custom blend mode
@@ -12,6 +12,8 @@ __version__ = "0.0.6"
 import array
 import sys
 
+from libc.stdlib cimport malloc, free
+
 # CHANGES:
 
 # 0.0.6: (Feb 25, 2011) christopher arndt <chris@chrisarndt.de>
@@ -126,11 +128,13 @@ cdef extern from "portmidi.h":
         PmMessage message
         PmTimestamp timestamp
 
-    PmError Pm_Read(PortMidiStream *stream, PmEvent *buffer, long length)
+    PmError Pm_Read(PortMidiStream *stream, PmEvent *buffer,
+                    long length) nogil
     PmError Pm_Poll(PortMidiStream *stream)
     int Pm_Channel(int channel)
     PmError Pm_SetChannelMask(PortMidiStream *stream, int mask)
-    PmError Pm_Write(PortMidiStream *stream, PmEvent *buffer, long length)
+    PmError Pm_Write(PortMidiStream *stream, PmEvent *buffer,
+                     long length) nogil
     PmError Pm_WriteSysEx(PortMidiStream *stream, PmTimestamp when,
                           unsigned char *msg)
 
@@ -436,6 +440,44 @@ cdef class Output:
         if err < 0:
             raise Exception(Pm_GetErrorText(err))
 
+    def write_from(self, buffer):
+        """Output the MIDI events packed in an array of 32 bit integers.
+
+        Usage::
+
+            write_from(array.array('i', [timestamp, message, ...]))
+
+        The buffer holds pairs of a timestamp and a message, the message
+        having the status byte in the lowest byte and the data bytes above
+        it, like Pm_Write() takes. There is no limit on the number of
+        events, and the GIL is released while they are written.
+
+        """
+        cdef const int[::1] view = buffer
+        cdef Py_ssize_t num_events = view.shape[0] // 2
+        cdef Py_ssize_t ev_no
+        cdef PmEvent *events
+        cdef PmError err = pmNoError
+
+        self._check_open()
+
+        if view.shape[0] % 2:
+            raise ValueError('Buffer must hold (timestamp, message) pairs.')
+        if not num_events:
+            return
+
+        events = <PmEvent *>malloc(num_events * sizeof(PmEvent))
+        if events == NULL:
+            raise MemoryError()
+        with nogil:
+            for ev_no in range(num_events):
+                events[ev_no].timestamp = view[2 * ev_no]
+                events[ev_no].message = <unsigned int>view[2 * ev_no + 1]
+            err = Pm_Write(self.midi, events, num_events)
+        free(events)
+        if err < 0:
+            raise Exception(Pm_GetErrorText(err))
+
     def WriteShort(self, status, data1=0, data2=0):
         """Output MIDI event of three bytes or less immediately on this device.
 
@@ -728,3 +770,37 @@ cdef class Input:
                 )
 
         return events
+
+    def read_into(self, buffer):
+        """Read events from input into an array of 32 bit integers.
+
+        Reads as many events as fit into the writable buffer, and returns
+        how many were read. Each event takes two integers, the timestamp and
+        the message, the message having the status byte in the lowest byte
+        and the data bytes above it. The GIL is released while reading.
+
+        """
+        cdef int[::1] view = buffer
+        cdef Py_ssize_t max_events = view.shape[0] // 2
+        cdef Py_ssize_t ev_no
+        cdef PmEvent *events
+        cdef PmError num_events
+
+        self._check_open()
+
+        if not max_events:
+            raise ValueError('Buffer is too small for one event.')
+
+        events = <PmEvent *>malloc(max_events * sizeof(PmEvent))
+        if events == NULL:
+            raise MemoryError()
+        with nogil:
+            num_events = Pm_Read(self.midi, events, max_events)
+            for ev_no in range(<Py_ssize_t>num_events):
+                view[2 * ev_no] = <int>events[ev_no].timestamp
+                view[2 * ev_no + 1] = <int>events[ev_no].message
+        free(events)
+        if num_events < 0:
+            raise Exception(Pm_GetErrorText(num_events))
+
+        return num_events
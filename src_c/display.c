@@ -23,6 +23,7 @@
 /*
  *  pygame display module
  */
+#define PG_SURFACE_ORIGIN PG_SURF_ORIGIN_DISPLAY
 #define PYGAMEAPI_DISPLAY_INTERNAL
 #include "pygame.h"
 
@@ -40,6 +41,14 @@ pgVidInfo_New(const pg_VideoInfo *info);
 
 static SDL_Renderer *pg_renderer = NULL;
 static SDL_Texture *pg_texture = NULL;
+/* set while pg_texture holds nothing of the display surface yet, so the
+ * next update uploads all of it instead of just the updated rects */
+static SDL_bool pg_texture_stale = SDL_TRUE;
+/* presented in place of pg_texture while ACCELERATED surfaces are drawn */
+static SDL_Texture *pg_canvas = NULL;
+static pgSurfaceCanvas pg_canvas_hooks;
+/* bumped when pg_renderer goes away, with the textures it made */
+static Uint32 pg_renderer_generation = 0;
 
 typedef struct _display_state_s {
     char *title;
@@ -93,6 +102,575 @@ _display_state_cleanup(_DisplayState *state)
     }
 }
 
+/* PIPELINED displays present on a thread of their own. A submitted frame
+ * is copied into frame, so python can draw the next one while the thread
+ * uploads and presents it. Only one frame is in flight, the next submit
+ * waits for it. The main thread must call pg_pipeline_wait before using
+ * pg_renderer or pg_texture itself. */
+#define PG_PIPELINE_MAX_RECTS 64
+
+typedef struct {
+    SDL_Thread *thread;
+    SDL_mutex *lock;
+    SDL_cond *cond;
+    SDL_Surface *frame;
+    SDL_Rect rects[PG_PIPELINE_MAX_RECTS];
+    int count; /* -1 uploads the whole frame */
+    SDL_bool pending;
+    SDL_bool quit;
+} pgPipeline;
+
+static pgPipeline pg_pipeline = {0};
+
+/* STREAMED displays are drawn straight into pg_texture, which stays locked
+ * between presents: the display surface pg_stream_surface gets the locked
+ * pixels in place of its own, kept in pg_stream_pixels. That saves copying
+ * each frame into the texture. SDL only promises what was drawn survives a
+ * lock and unlock with the OpenGL and software renderers, whose locked
+ * pixels are a buffer of the texture, so the others upload as before. */
+static SDL_Surface *pg_stream_surface = NULL;
+static void *pg_stream_pixels = NULL;
+static int pg_stream_pitch = 0;
+
+static void
+_pg_copy_rows(Uint8 *dst, int dstpitch, const Uint8 *src, int srcpitch,
+              SDL_Surface *surf)
+{
+    size_t len = (size_t)surf->w * PG_SURF_BytesPerPixel(surf);
+    int y;
+
+    for (y = 0; y < surf->h; y++) {
+        memcpy(dst, src, len);
+        dst += dstpitch;
+        src += srcpitch;
+    }
+}
+
+/* Gives the display surface its own pixels back, with what was drawn on
+ * it. locked tells whether pg_texture is still locked. */
+static void
+pg_stream_release(SDL_bool locked)
+{
+    SDL_Surface *surf = pg_stream_surface;
+
+    if (!surf) {
+        return;
+    }
+    _pg_copy_rows(pg_stream_pixels, pg_stream_pitch, surf->pixels,
+                  surf->pitch, surf);
+    surf->pixels = pg_stream_pixels;
+    surf->pitch = pg_stream_pitch;
+    if (locked) {
+        SDL_UnlockTexture(pg_texture);
+    }
+    pg_stream_surface = NULL;
+}
+
+/* Must be called before pg_texture or the display surface go away */
+static void
+pg_stream_stop(void)
+{
+    pg_stream_release(SDL_TRUE);
+}
+
+static void
+pg_stream_start(SDL_Surface *screen)
+{
+    SDL_RendererInfo info;
+    void *pixels;
+    int pitch;
+
+    pg_stream_stop();
+    if (!pg_texture || pg_pipeline.thread ||
+        SDL_GetRendererInfo(pg_renderer, &info) != 0 ||
+        (SDL_strncmp(info.name, "opengl", 6) != 0 &&
+         SDL_strcmp(info.name, "software") != 0)) {
+        return;
+    }
+    if (SDL_LockTexture(pg_texture, NULL, &pixels, &pitch) != 0) {
+        return;
+    }
+    _pg_copy_rows(pixels, pitch, screen->pixels, screen->pitch, screen);
+    pg_stream_surface = screen;
+    pg_stream_pixels = screen->pixels;
+    pg_stream_pitch = screen->pitch;
+    screen->pixels = pixels;
+    screen->pitch = pitch;
+}
+
+/* Uploads rects of src to pg_texture and presents it. A count of -1, or
+ * rects covering the screen, upload all of src. A streamed src is uploaded
+ * whole by unlocking pg_texture, and locked again for the next frame. */
+static void
+pg_present_texture(SDL_Surface *src, const SDL_Rect *rects, int count)
+{
+    Sint64 area = 0;
+    void *pixels;
+    int i, pitch;
+
+    if (pg_canvas_hooks.drawn) {
+        SDL_SetRenderTarget(pg_renderer, NULL);
+        SDL_RenderClear(pg_renderer);
+        SDL_RenderCopy(pg_renderer, pg_canvas, NULL, NULL);
+        SDL_RenderPresent(pg_renderer);
+        return;
+    }
+    for (i = 0; i < count; i++) {
+        area += (Sint64)rects[i].w * rects[i].h;
+    }
+    if (src == pg_stream_surface) {
+        SDL_UnlockTexture(pg_texture);
+    }
+    else if (count < 0 || pg_texture_stale ||
+             area >= (Sint64)src->w * src->h) {
+        SDL_UpdateTexture(pg_texture, NULL, src->pixels, src->pitch);
+        pg_texture_stale = SDL_FALSE;
+    }
+    else {
+        for (i = 0; i < count; i++) {
+            SDL_UpdateTexture(pg_texture, &rects[i],
+                              (Uint8 *)src->pixels + rects[i].y * src->pitch +
+                                  rects[i].x * PG_SURF_BytesPerPixel(src),
+                              src->pitch);
+        }
+    }
+    SDL_RenderClear(pg_renderer);
+    SDL_RenderCopy(pg_renderer, pg_texture, NULL, NULL);
+    SDL_RenderPresent(pg_renderer);
+
+    if (src == pg_stream_surface) {
+        if (SDL_LockTexture(pg_texture, NULL, &pixels, &pitch) != 0) {
+            pg_stream_release(SDL_FALSE);
+            return;
+        }
+        src->pixels = pixels;
+        src->pitch = pitch;
+    }
+}
+
+static int SDLCALL
+pg_pipeline_run(void *data)
+{
+    pgPipeline *pipeline = (pgPipeline *)data;
+
+    SDL_LockMutex(pipeline->lock);
+    for (;;) {
+        while (!pipeline->pending && !pipeline->quit) {
+            SDL_CondWait(pipeline->cond, pipeline->lock);
+        }
+        if (!pipeline->pending) {
+            break;
+        }
+        /* frame and rects are left alone while pending */
+        SDL_UnlockMutex(pipeline->lock);
+        pg_present_texture(pipeline->frame, pipeline->rects, pipeline->count);
+        SDL_LockMutex(pipeline->lock);
+        pipeline->pending = SDL_FALSE;
+        SDL_CondBroadcast(pipeline->cond);
+    }
+    SDL_UnlockMutex(pipeline->lock);
+    return 0;
+}
+
+static void
+pg_pipeline_wait(void)
+{
+    if (!pg_pipeline.thread) {
+        return;
+    }
+    SDL_LockMutex(pg_pipeline.lock);
+    while (pg_pipeline.pending) {
+        SDL_CondWait(pg_pipeline.cond, pg_pipeline.lock);
+    }
+    SDL_UnlockMutex(pg_pipeline.lock);
+}
+
+static void
+pg_pipeline_stop(void)
+{
+    if (pg_pipeline.thread) {
+        SDL_LockMutex(pg_pipeline.lock);
+        pg_pipeline.quit = SDL_TRUE;
+        SDL_CondBroadcast(pg_pipeline.cond);
+        SDL_UnlockMutex(pg_pipeline.lock);
+        /* a pending frame is still presented before the thread ends */
+        SDL_WaitThread(pg_pipeline.thread, NULL);
+    }
+    if (pg_pipeline.cond) {
+        SDL_DestroyCond(pg_pipeline.cond);
+    }
+    if (pg_pipeline.lock) {
+        SDL_DestroyMutex(pg_pipeline.lock);
+    }
+    if (pg_pipeline.frame) {
+        SDL_FreeSurface(pg_pipeline.frame);
+    }
+    memset(&pg_pipeline, 0, sizeof(pg_pipeline));
+}
+
+/* Starts the present thread for pg_renderer. SDL renderers are meant to be
+ * used from the thread that created them, which the Direct3D ones put up
+ * with as long as the calls don't overlap. The others, OpenGL contexts in
+ * particular, can't be handed between threads like that, so they keep
+ * presenting synchronously. */
+static void
+pg_pipeline_start(void)
+{
+    SDL_RendererInfo info;
+
+    pg_pipeline_stop();
+    if (SDL_GetRendererInfo(pg_renderer, &info) != 0 ||
+        SDL_strncmp(info.name, "direct3d", 8) != 0) {
+        return;
+    }
+    pg_pipeline.lock = SDL_CreateMutex();
+    pg_pipeline.cond = SDL_CreateCond();
+    if (pg_pipeline.lock && pg_pipeline.cond) {
+        pg_pipeline.thread = SDL_CreateThread(
+            pg_pipeline_run, "pygame display present", &pg_pipeline);
+    }
+    if (!pg_pipeline.thread) {
+        pg_pipeline_stop();
+    }
+}
+
+static void
+_pg_copy_rect(SDL_Surface *dst, SDL_Surface *src, const SDL_Rect *rect)
+{
+    size_t len = (size_t)rect->w * PG_SURF_BytesPerPixel(src);
+    Uint8 *dstrow = (Uint8 *)dst->pixels + rect->y * dst->pitch +
+                    rect->x * PG_SURF_BytesPerPixel(dst);
+    const Uint8 *srcrow = (Uint8 *)src->pixels + rect->y * src->pitch +
+                          rect->x * PG_SURF_BytesPerPixel(src);
+    int y;
+
+    for (y = 0; y < rect->h; y++) {
+        memcpy(dstrow, srcrow, len);
+        dstrow += dst->pitch;
+        srcrow += src->pitch;
+    }
+}
+
+/* Presents rects of the display surface screen through pg_renderer, on the
+ * present thread when there is one. Must be called without the GIL. */
+static void
+pg_pipeline_present(SDL_Surface *screen, const SDL_Rect *rects, int count)
+{
+    SDL_Surface *frame;
+    SDL_Rect whole = {0, 0, screen->w, screen->h};
+    int i;
+
+    if (!pg_pipeline.thread) {
+        pg_present_texture(screen, rects, count);
+        return;
+    }
+    pg_pipeline_wait();
+
+    frame = pg_pipeline.frame;
+    if (!frame || frame->w != screen->w || frame->h != screen->h) {
+        if (frame) {
+            SDL_FreeSurface(frame);
+        }
+        frame = pg_pipeline.frame =
+            PG_CreateSurface(screen->w, screen->h, PG_PIXELFORMAT_XRGB8888);
+        if (!frame) {
+            pg_present_texture(screen, rects, count);
+            return;
+        }
+        count = -1;
+    }
+    if (pg_texture_stale || count > PG_PIPELINE_MAX_RECTS) {
+        count = -1;
+    }
+
+    if (count < 0) {
+        _pg_copy_rect(frame, screen, &whole);
+    }
+    for (i = 0; i < count; i++) {
+        _pg_copy_rect(frame, screen, &rects[i]);
+        pg_pipeline.rects[i] = rects[i];
+    }
+    pg_pipeline.count = count;
+
+    SDL_LockMutex(pg_pipeline.lock);
+    pg_pipeline.pending = SDL_TRUE;
+    SDL_CondBroadcast(pg_pipeline.cond);
+    SDL_UnlockMutex(pg_pipeline.lock);
+}
+
+/* Surfaces made with the ACCELERATED flag are drawn by pg_renderer. The
+ * first one blitted to the display surface uploads the display to
+ * pg_canvas, a target texture, and from then on blits and fills of the
+ * display are rendered into pg_canvas, which is what gets presented. Its
+ * pixels are out of date meanwhile, until they are read or written in
+ * software, which reads pg_canvas back and goes back to software drawing.
+ * PIPELINED and STREAMED displays are always drawn in software. */
+typedef struct {
+    pgSurfaceTexture base;
+    SDL_Texture *texture;
+    Uint32 generation; /* pg_renderer_generation it was made in */
+    Uint64 version;    /* of the surface it was made of */
+    int w, h;
+    Uint32 format;
+    SDL_bool keyed;
+    Uint32 colorkey;
+} pgCanvasTexture;
+
+static void
+pg_canvas_texture_release(pgSurfaceTexture *base)
+{
+    pgCanvasTexture *cached = (pgCanvasTexture *)base;
+
+    /* textures go away with the renderer that made them */
+    if (cached->generation == pg_renderer_generation) {
+        SDL_DestroyTexture(cached->texture);
+    }
+    free(cached);
+}
+
+/* The texture srcobj is drawn with, NULL with an SDL error on failure. An
+ * ACCELERATED surface keeps its texture until it changes, the others get
+ * one for the blit, which temp tells to destroy. */
+static SDL_Texture *
+pg_canvas_texture(pgSurfaceObject *srcobj, SDL_bool *temp)
+{
+    SDL_Surface *src = pgSurface_AsSurface(srcobj);
+    pgCanvasTexture *cached = (pgCanvasTexture *)srcobj->texture;
+    Uint64 version = pgSurface_GetVersion(srcobj);
+    Uint32 colorkey = 0;
+    SDL_bool keyed = SDL_GetColorKey(src, &colorkey) == 0;
+    SDL_Texture *texture;
+
+    *temp = !srcobj->accelerated;
+    if (!*temp && cached && cached->generation == pg_renderer_generation &&
+        cached->version == version && cached->w == src->w &&
+        cached->h == src->h && cached->format == src->format->format &&
+        cached->keyed == keyed && cached->colorkey == colorkey) {
+        return cached->texture;
+    }
+
+    pgSurface_Prep(srcobj);
+    texture = SDL_CreateTextureFromSurface(pg_renderer, src);
+    pgSurface_Unprep(srcobj);
+    if (!texture || *temp) {
+        return texture;
+    }
+    if (!cached) {
+        cached = (pgCanvasTexture *)malloc(sizeof(pgCanvasTexture));
+        if (!cached) {
+            *temp = SDL_TRUE;
+            return texture;
+        }
+        cached->base.release = pg_canvas_texture_release;
+        srcobj->texture = &cached->base;
+    }
+    else if (cached->generation == pg_renderer_generation) {
+        SDL_DestroyTexture(cached->texture);
+    }
+    cached->texture = texture;
+    cached->generation = pg_renderer_generation;
+    cached->version = version;
+    cached->w = src->w;
+    cached->h = src->h;
+    cached->format = src->format->format;
+    cached->keyed = keyed;
+    cached->colorkey = colorkey;
+    return texture;
+}
+
+/* Uploads the display surface screen to pg_canvas and draws into it */
+static int
+pg_canvas_start(SDL_Surface *screen)
+{
+    int w, h;
+
+    if (pg_canvas && (SDL_QueryTexture(pg_canvas, NULL, NULL, &w, &h) != 0 ||
+                      w != screen->w || h != screen->h)) {
+        SDL_DestroyTexture(pg_canvas);
+        pg_canvas = NULL;
+    }
+    if (!pg_canvas) {
+        pg_canvas =
+            SDL_CreateTexture(pg_renderer, SDL_PIXELFORMAT_ARGB8888,
+                              SDL_TEXTUREACCESS_TARGET, screen->w, screen->h);
+        if (!pg_canvas) {
+            return -1;
+        }
+        SDL_SetTextureBlendMode(pg_canvas, SDL_BLENDMODE_NONE);
+    }
+    if (SDL_UpdateTexture(pg_canvas, NULL, screen->pixels, screen->pitch) !=
+        0) {
+        return -1;
+    }
+    pg_canvas_hooks.drawn = 1;
+    return 0;
+}
+
+/* Reads pg_canvas back into the display surface, which is drawn in
+ * software again. What pg_canvas holds is lost if that fails. */
+static void
+pg_canvas_sync(PyObject *dstobj)
+{
+    SDL_Surface *screen = pgSurface_AsSurface(dstobj);
+
+    pg_canvas_hooks.drawn = 0;
+    pg_texture_stale = SDL_TRUE;
+    if (screen && SDL_SetRenderTarget(pg_renderer, pg_canvas) == 0) {
+        SDL_RenderReadPixels(pg_renderer, NULL, SDL_PIXELFORMAT_ARGB8888,
+                             screen->pixels, screen->pitch);
+    }
+    SDL_SetRenderTarget(pg_renderer, NULL);
+}
+
+/* Must be called before pg_renderer or the display surface go away */
+static void
+pg_canvas_stop(void)
+{
+    pgSurfaceObject *screen = pg_GetDefaultWindowSurface();
+
+    if (pg_canvas_hooks.drawn && screen) {
+        pg_canvas_sync((PyObject *)screen);
+    }
+    pg_canvas_hooks.drawn = 0;
+    if (pg_canvas) {
+        SDL_DestroyTexture(pg_canvas);
+        pg_canvas = NULL;
+    }
+}
+
+static int
+pg_canvas_accepts(PyObject *dstobj, PyObject *srcobj, int blend_flags)
+{
+    pgSurfaceObject *src = (pgSurfaceObject *)srcobj;
+
+    /* only the plain blit is mapped to the renderer, and an ACCELERATED
+     * source is what starts drawing with it */
+    if (blend_flags != 0 || !pg_renderer || !pg_texture ||
+        pg_pipeline.thread || pg_stream_surface ||
+        dstobj != (PyObject *)pg_GetDefaultWindowSurface() ||
+        (!pg_canvas_hooks.drawn && !src->accelerated) ||
+        !SDL_RenderTargetSupported(pg_renderer)) {
+        return 0;
+    }
+    /* the display blitted onto itself is left to software */
+    while (src->subsurface) {
+        src = (pgSurfaceObject *)src->subsurface->owner;
+    }
+    return (PyObject *)src != dstobj;
+}
+
+static int
+pg_canvas_blit(PyObject *dstobj, PyObject *srcobj, SDL_Rect *dstrect,
+               SDL_Rect *srcrect)
+{
+    SDL_Surface *dst = pgSurface_AsSurface(dstobj);
+    SDL_Surface *src = pgSurface_AsSurface(srcobj);
+    SDL_Rect clip, area = {0, 0, src->w, src->h};
+    SDL_Texture *texture;
+    SDL_BlendMode mode;
+    SDL_bool temp;
+    Uint8 r, g, b, a;
+    int d, result;
+
+    /* clipped the way SDL_BlitSurface() clips */
+    if (srcrect) {
+        area = *srcrect;
+        if (area.x < 0) {
+            area.w += area.x;
+            dstrect->x -= area.x;
+            area.x = 0;
+        }
+        if (area.y < 0) {
+            area.h += area.y;
+            dstrect->y -= area.y;
+            area.y = 0;
+        }
+        area.w = MIN(area.w, src->w - area.x);
+        area.h = MIN(area.h, src->h - area.y);
+    }
+    SDL_GetClipRect(dst, &clip);
+    if ((d = clip.x - dstrect->x) > 0) {
+        area.w -= d;
+        area.x += d;
+        dstrect->x += d;
+    }
+    if ((d = dstrect->x + area.w - clip.x - clip.w) > 0) {
+        area.w -= d;
+    }
+    if ((d = clip.y - dstrect->y) > 0) {
+        area.h -= d;
+        area.y += d;
+        dstrect->y += d;
+    }
+    if ((d = dstrect->y + area.h - clip.y - clip.h) > 0) {
+        area.h -= d;
+    }
+    if (area.w <= 0 || area.h <= 0) {
+        dstrect->w = dstrect->h = 0;
+        return 0;
+    }
+    dstrect->w = area.w;
+    dstrect->h = area.h;
+
+    if (!pg_canvas_hooks.drawn && pg_canvas_start(dst) != 0) {
+        goto error;
+    }
+    texture = pg_canvas_texture((pgSurfaceObject *)srcobj, &temp);
+    if (!texture) {
+        goto error;
+    }
+    /* a colorkey is alpha in the texture */
+    SDL_GetSurfaceBlendMode(src, &mode);
+    if (mode == SDL_BLENDMODE_NONE && SDL_HasColorKey(src)) {
+        mode = SDL_BLENDMODE_BLEND;
+    }
+    SDL_GetSurfaceColorMod(src, &r, &g, &b);
+    SDL_GetSurfaceAlphaMod(src, &a);
+    SDL_SetTextureBlendMode(texture, mode);
+    SDL_SetTextureColorMod(texture, r, g, b);
+    SDL_SetTextureAlphaMod(texture, a);
+
+    result = SDL_SetRenderTarget(pg_renderer, pg_canvas);
+    if (result == 0) {
+        result = SDL_RenderCopy(pg_renderer, texture, &area, dstrect);
+    }
+    if (temp) {
+        SDL_DestroyTexture(texture);
+    }
+    if (result == 0) {
+        return 0;
+    }
+
+error:
+    PyErr_SetString(pgExc_SDLError, SDL_GetError());
+    return -1;
+}
+
+static int
+pg_canvas_fill(PyObject *dstobj, const SDL_Rect *rect, Uint32 color)
+{
+    SDL_Surface *dst = pgSurface_AsSurface(dstobj);
+    SDL_Rect clip, area;
+    Uint8 r, g, b;
+
+    if (!pg_canvas_hooks.drawn) {
+        return 0;
+    }
+    SDL_GetClipRect(dst, &clip);
+    if (!SDL_IntersectRect(rect, &clip, &area)) {
+        return 1;
+    }
+    SDL_GetRGB(color, dst->format, &r, &g, &b);
+    /* on failure it is filled in software, after reading pg_canvas back */
+    return SDL_SetRenderTarget(pg_renderer, pg_canvas) == 0 &&
+           SDL_SetRenderDrawBlendMode(pg_renderer, SDL_BLENDMODE_NONE) == 0 &&
+           SDL_SetRenderDrawColor(pg_renderer, r, g, b, 255) == 0 &&
+           SDL_RenderFillRect(pg_renderer, &area) == 0;
+}
+
+static pgSurfaceCanvas pg_canvas_hooks = {
+    0, pg_canvas_accepts, pg_canvas_blit, pg_canvas_fill, pg_canvas_sync};
+
 // prevent this code block from being linked twice
 // (this code block is copied by window.c)
 #ifndef BUILD_STATIC
@@ -187,8 +765,14 @@ static PyObject *
 pg_display_quit(PyObject *self, PyObject *_null)
 {
     _DisplayState *state = DISPLAY_STATE;
+    pg_stream_stop();
+    pg_canvas_stop();
+    pg_pipeline_stop();
     _display_state_cleanup(state);
+    /* the window takes pg_renderer with it */
+    pg_renderer_generation++;
     if (pg_GetDefaultWindowSurface()) {
+        pg_GetDefaultWindowSurface()->canvas = NULL;
         pgSurface_AsSurface(pg_GetDefaultWindowSurface()) = NULL;
         pg_SetDefaultWindowSurface(NULL);
         pg_SetDefaultWindow(NULL);
@@ -692,6 +1276,10 @@ pg_ResizeEventWatch(void *userdata, SDL_Event *event)
     if (window != pygame_window)
         return 0;
 
+    if (pg_renderer != NULL) {
+        pg_pipeline_wait();
+    }
+
     if (state->unscaled_render && pg_renderer != NULL) {
         if (event->window.event == SDL_WINDOWEVENT_SIZE_CHANGED) {
             int w = event->window.data1;
@@ -699,7 +1287,10 @@ pg_ResizeEventWatch(void *userdata, SDL_Event *event)
             pgSurfaceObject *display_surface = pg_GetDefaultWindowSurface();
             SDL_Surface *surf =
                 PG_CreateSurface(w, h, PG_PIXELFORMAT_XRGB8888);
+            SDL_bool streamed = pg_stream_surface != NULL;
 
+            pg_stream_stop();
+            pg_canvas_stop();
             SDL_FreeSurface(display_surface->surf);
             display_surface->surf = surf;
 
@@ -708,6 +1299,10 @@ pg_ResizeEventWatch(void *userdata, SDL_Event *event)
             pg_texture =
                 SDL_CreateTexture(pg_renderer, SDL_PIXELFORMAT_ARGB8888,
                                   SDL_TEXTUREACCESS_STREAMING, w, h);
+            pg_texture_stale = SDL_TRUE;
+            if (streamed && surf) {
+                pg_stream_start(surf);
+            }
         }
         return 0;
     }
@@ -918,6 +1513,10 @@ pg_set_mode(PyObject *self, PyObject *arg, PyObject *kwds)
     state->toggle_windowed_w = 0;
     state->toggle_windowed_h = 0;
 
+    pg_stream_stop();
+    pg_canvas_stop();
+    pg_pipeline_stop();
+
     if (pg_texture) {
         SDL_DestroyTexture(pg_texture);
         pg_texture = NULL;
@@ -926,6 +1525,7 @@ pg_set_mode(PyObject *self, PyObject *arg, PyObject *kwds)
     if (pg_renderer) {
         SDL_DestroyRenderer(pg_renderer);
         pg_renderer = NULL;
+        pg_renderer_generation++;
     }
 
     SDL_DelEventWatch(pg_ResizeEventWatch, self);
@@ -1261,9 +1861,17 @@ pg_set_mode(PyObject *self, PyObject *arg, PyObject *kwds)
                     pg_texture = SDL_CreateTexture(
                         pg_renderer, SDL_PIXELFORMAT_ARGB8888,
                         SDL_TEXTUREACCESS_STREAMING, w, h);
+                    pg_texture_stale = SDL_TRUE;
+
+                    if (flags & PGS_PIPELINED) {
+                        pg_pipeline_start();
+                    }
                 }
                 surf = PG_CreateSurface(w, h, PG_PIXELFORMAT_XRGB8888);
                 newownedsurf = surf;
+                if (surf && flags & PGS_STREAMED) {
+                    pg_stream_start(surf);
+                }
             }
             else {
                 surf = SDL_GetWindowSurface(win);
@@ -1305,6 +1913,7 @@ pg_set_mode(PyObject *self, PyObject *arg, PyObject *kwds)
             Py_INCREF(surface);
         }
         if (!surface) {
+            pg_stream_stop();
             if (newownedsurf)
                 SDL_FreeSurface(newownedsurf);
             _display_state_cleanup(state);
@@ -1314,6 +1923,7 @@ pg_set_mode(PyObject *self, PyObject *arg, PyObject *kwds)
         /*no errors; make the window available*/
         pg_SetDefaultWindow(win);
         pg_SetDefaultWindowSurface(surface);
+        surface->canvas = pg_renderer ? &pg_canvas_hooks : NULL;
         Py_DECREF(surface);
 
         /* ensure window is always black after a set_mode call */
@@ -1351,6 +1961,9 @@ pg_set_mode(PyObject *self, PyObject *arg, PyObject *kwds)
 
 DESTROY_WINDOW:
 
+    pg_stream_stop();
+    pg_pipeline_stop();
+    pg_renderer_generation++;
     if (win == pg_GetDefaultWindow())
         pg_SetDefaultWindow(NULL);
     else if (win)
@@ -1570,7 +2183,8 @@ static int
 pg_flip_internal(_DisplayState *state)
 {
     SDL_Window *win = pg_GetDefaultWindow();
-    int status = 0;
+    int status = 0, w, h;
+    PG_PERF_START(perf_start);
 
     /* Same check as VIDEO_INIT_CHECK() but returns -1 instead of NULL on
      * fail. */
@@ -1590,12 +2204,8 @@ pg_flip_internal(_DisplayState *state)
     }
     else {
         if (pg_renderer != NULL) {
-            SDL_Surface *screen =
-                pgSurface_AsSurface(pg_GetDefaultWindowSurface());
-            SDL_UpdateTexture(pg_texture, NULL, screen->pixels, screen->pitch);
-            SDL_RenderClear(pg_renderer);
-            SDL_RenderCopy(pg_renderer, pg_texture, NULL, NULL);
-            SDL_RenderPresent(pg_renderer);
+            pg_pipeline_present(
+                pgSurface_AsSurface(pg_GetDefaultWindowSurface()), NULL, -1);
         }
         else {
             /* Force a re-initialization of the surface in case it
@@ -1618,6 +2228,8 @@ pg_flip_internal(_DisplayState *state)
         return -1;
     }
 
+    SDL_GetWindowSize(win, &w, &h);
+    PG_PERF_STOP(perf_start, PG_PERF_FLIP, (Uint64)w * h);
     return 0;
 }
 
@@ -1656,6 +2268,77 @@ pg_screencroprect(SDL_Rect *r, int w, int h, SDL_Rect *cur)
     return cur;
 }
 
+/* Rect lists longer than this only get the full update check, merging is
+ * quadratic in the number of rects */
+#define PG_UPDATE_MERGE_MAX 256
+
+static Sint64
+_pg_rect_area(const SDL_Rect *r)
+{
+    return (Sint64)r->w * r->h;
+}
+
+/* Merges overlapping or adjacent update rects, cropped to the screen, when
+ * their bounding rect pushes at most a quarter more pixels than the rects
+ * themselves. The rects end up covering at least what they did before.
+ * When what is left covers most of the screen, it becomes a single rect
+ * for the whole screen, which is one upload instead of many. Returns the
+ * new number of rects. */
+static int
+pg_merge_update_rects(SDL_Rect *rects, int count, int w, int h)
+{
+    SDL_Rect u, inter;
+    Sint64 covered, total = 0;
+    int i, j, merged = 1;
+
+    while (merged && count <= PG_UPDATE_MERGE_MAX) {
+        merged = 0;
+        for (i = 0; i < count; i++) {
+            for (j = i + 1; j < count; j++) {
+                SDL_UnionRect(&rects[i], &rects[j], &u);
+                covered = _pg_rect_area(&rects[i]) + _pg_rect_area(&rects[j]);
+                if (SDL_IntersectRect(&rects[i], &rects[j], &inter)) {
+                    covered -= _pg_rect_area(&inter);
+                }
+                if (_pg_rect_area(&u) * 4 > covered * 5) {
+                    continue;
+                }
+                rects[i] = u;
+                rects[j--] = rects[--count];
+                merged = 1;
+            }
+        }
+    }
+
+    for (i = 0; i < count; i++) {
+        total += _pg_rect_area(&rects[i]);
+    }
+    if (count > 1 && total * 4 >= (Sint64)w * h * 3) {
+        rects[0].x = rects[0].y = 0;
+        rects[0].w = w;
+        rects[0].h = h;
+        count = 1;
+    }
+    return count;
+}
+
+/* Pushes rects of the display surface to the window. With a renderer only
+ * those areas of pg_texture are uploaded, the rest of it keeps what earlier
+ * updates put there, and the frame is presented even without any rects.
+ * Must be called without the GIL. */
+static void
+pg_update_window_rects(SDL_Window *win, const SDL_Rect *rects, int count)
+{
+    if (pg_renderer == NULL) {
+        if (count > 0) {
+            SDL_UpdateWindowSurfaceRects(win, rects, count);
+        }
+        return;
+    }
+    pg_pipeline_present(pgSurface_AsSurface(pg_GetDefaultWindowSurface()),
+                        rects, count);
+}
+
 static PyObject *
 pg_update(PyObject *self, PyObject *arg)
 {
@@ -1670,30 +2353,67 @@ pg_update(PyObject *self, PyObject *arg)
         return RAISE(pgExc_SDLError, "Display mode not set");
 
     if (pg_renderer != NULL) {
-        return pg_flip(self, NULL);
+        SDL_Surface *screen;
+
+        /* an OPENGL display has no texture to update parts of */
+        if (state->using_gl) {
+            return pg_flip(self, NULL);
+        }
+        /* the rects are in the coordinates of the unscaled surface */
+        screen = pgSurface_AsSurface(pg_GetDefaultWindowSurface());
+        wide = screen->w;
+        high = screen->h;
     }
-    SDL_GetWindowSize(win, &wide, &high);
+    else {
+        SDL_GetWindowSize(win, &wide, &high);
 
-    if (state->using_gl)
-        return RAISE(pgExc_SDLError, "Cannot update an OPENGL display");
+        if (state->using_gl)
+            return RAISE(pgExc_SDLError, "Cannot update an OPENGL display");
+    }
 
     /*determine type of argument we got*/
     if (PyTuple_Size(arg) == 0) {
-        return pg_flip(self, NULL);
+        pgSurfaceObject *screen = pg_GetDefaultWindowSurface();
+        SDL_Rect dirty[PG_SURF_MAX_DIRTY_RECTS];
+        int count, loop, ndirty = 0;
+
+        /* With dirty rect tracking on the display surface, only push the
+         * areas that changed since the last update */
+        count = screen ? pgSurface_GetDirtyRects(screen, dirty, 1) : -1;
+        if (count < 0) {
+            return pg_flip(self, NULL);
+        }
+        for (loop = 0; loop < count; ++loop) {
+            if (pg_screencroprect(&dirty[loop], wide, high, &dirty[ndirty]))
+                ++ndirty;
+        }
+        ndirty = pg_merge_update_rects(dirty, ndirty, wide, high);
+        Py_BEGIN_ALLOW_THREADS;
+        pg_update_window_rects(win, dirty, ndirty);
+        Py_END_ALLOW_THREADS;
+        Py_RETURN_NONE;
     }
 
     if (PyTuple_GET_ITEM(arg, 0) == Py_None) {
         /* This is to comply with old behaviour of the function, might be worth
          * deprecating this in the future */
+        if (pg_renderer != NULL) {
+            /* still present, to keep the pacing of vsync */
+            Py_BEGIN_ALLOW_THREADS;
+            pg_update_window_rects(win, NULL, 0);
+            Py_END_ALLOW_THREADS;
+        }
         Py_RETURN_NONE;
     }
 
     gr = pgRect_FromObject(arg, &temp);
     if (gr) {
         SDL_Rect sdlr;
+        int onscreen = pg_screencroprect(gr, wide, high, &sdlr) != NULL;
 
-        if (pg_screencroprect(gr, wide, high, &sdlr))
-            SDL_UpdateWindowSurfaceRects(win, &sdlr, 1);
+        Py_BEGIN_ALLOW_THREADS;
+        pg_update_window_rects(win, &sdlr, onscreen);
+        Py_END_ALLOW_THREADS;
     }
     else {
         PyObject *seq;
@@ -1743,11 +2463,10 @@ pg_update(PyObject *self, PyObject *arg)
             ++count;
         }
 
-        if (count) {
-            Py_BEGIN_ALLOW_THREADS;
-            SDL_UpdateWindowSurfaceRects(win, rects, count);
-            Py_END_ALLOW_THREADS;
-        }
+        Py_BEGIN_ALLOW_THREADS;
+        count = pg_merge_update_rects(rects, count, wide, high);
+        pg_update_window_rects(win, rects, count);
+        Py_END_ALLOW_THREADS;
 
         PyMem_Free((char *)rects);
     }
@@ -2261,6 +2980,7 @@ pg_toggle_fullscreen(PyObject *self, PyObject *_null)
         if (SDL_GetRendererInfo(pg_renderer, &r_info) != 0) {
             return RAISE(pgExc_SDLError, SDL_GetError());
         }
+        pg_pipeline_wait();
     }
 
     switch (wm_info.subsystem) {
@@ -2355,13 +3075,22 @@ pg_toggle_fullscreen(PyObject *self, PyObject *_null)
             if (r_info.flags & SDL_RENDERER_SOFTWARE &&
                 wm_info.subsystem == SDL_SYSWM_X11) {
                 /* display surface lost? */
+                SDL_bool streamed = pg_stream_surface != NULL;
+
+                pg_stream_stop();
+                pg_canvas_stop();
                 SDL_DestroyTexture(pg_texture);
                 SDL_DestroyRenderer(pg_renderer);
+                pg_renderer_generation++;
                 pg_renderer =
                     SDL_CreateRenderer(win, -1, SDL_RENDERER_SOFTWARE);
                 pg_texture =
                     SDL_CreateTexture(pg_renderer, SDL_PIXELFORMAT_ARGB8888,
                                       SDL_TEXTUREACCESS_STREAMING, w, h);
+                pg_texture_stale = SDL_TRUE;
+                if (streamed) {
+                    pg_stream_start(display_surface->surf);
+                }
             }
             SDL_RenderSetLogicalSize(pg_renderer, w, h);
 
@@ -2496,13 +3225,22 @@ pg_toggle_fullscreen(PyObject *self, PyObject *_null)
                     return NULL;
                 }
                 /* display surface lost? only on x11? */
+                SDL_bool streamed = pg_stream_surface != NULL;
+
+                pg_stream_stop();
+                pg_canvas_stop();
                 SDL_DestroyTexture(pg_texture);
                 SDL_DestroyRenderer(pg_renderer);
+                pg_renderer_generation++;
                 pg_renderer =
                     SDL_CreateRenderer(win, -1, SDL_RENDERER_SOFTWARE);
                 pg_texture =
                     SDL_CreateTexture(pg_renderer, SDL_PIXELFORMAT_ARGB8888,
                                       SDL_TEXTUREACCESS_STREAMING, w, h);
+                pg_texture_stale = SDL_TRUE;
+                if (streamed) {
+                    pg_stream_start(display_surface->surf);
+                }
             }
 
             SDL_RenderSetLogicalSize(pg_renderer, w, h);
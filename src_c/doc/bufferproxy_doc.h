@@ -4,3 +4,13 @@
 #define DOC_BUFFERPROXY_LENGTH "length -> int\nThe size, in bytes, of the exported buffer."
 #define DOC_BUFFERPROXY_RAW "raw -> bytes\nA copy of the exported buffer as a single block of bytes."
 #define DOC_BUFFERPROXY_WRITE "write(buffer, offset=0)\nWrite raw bytes to object buffer."
+#define DOC_BUFFERARRAY "BufferArray(obj) -> BufferArray\nstrided array of the numbers in a buffer"
+#define DOC_BUFFERARRAY_SHAPE "shape -> tuple\nThe length of each dimension."
+#define DOC_BUFFERARRAY_STRIDES "strides -> tuple\nThe step, in bytes, along each dimension."
+#define DOC_BUFFERARRAY_NDIM "ndim -> int\nThe number of dimensions."
+#define DOC_BUFFERARRAY_ITEMSIZE "itemsize -> int\nThe size, in bytes, of an item."
+#define DOC_BUFFERARRAY_FORMAT "format -> str\nThe struct module format character of the items."
+#define DOC_BUFFERARRAY_READONLY "readonly -> bool\nWhether the items can be changed."
+#define DOC_BUFFERARRAY_PARENT "parent -> object\nThe object whose buffer the array uses."
+#define DOC_BUFFERARRAY_COPY "copy() -> BufferArray\nA contiguous copy of the array."
+#define DOC_BUFFERARRAY_FILL "fill(value) -> None\nSet every item to a number or to the items of a buffer."
@@ -3,9 +3,11 @@
 #define DOC_CAMERA_INIT "init(backend = None) -> None\nModule init"
 #define DOC_CAMERA_GETBACKENDS "get_backends() -> [str]\nGet the backends supported on this system"
 #define DOC_CAMERA_COLORSPACE "colorspace(surface, format, dest_surface = None, /) -> Surface\nSurface colorspace conversion"
+#define DOC_CAMERA_SETCONVERSIONTHREADS "set_conversion_threads(num_threads, /) -> None\nset the number of threads used for colorspace conversion"
+#define DOC_CAMERA_GETCONVERSIONTHREADS "get_conversion_threads() -> int\nget the number of threads used for colorspace conversion"
 #define DOC_CAMERA_LISTCAMERAS "list_cameras() -> [cameras]\nreturns a list of available cameras"
 #define DOC_CAMERA_CAMERA "Camera(device, (width, height), format) -> Camera\nload a camera"
-#define DOC_CAMERA_CAMERA_START "start() -> None\nopens, initializes, and starts capturing"
+#define DOC_CAMERA_CAMERA_START "start(threaded=False) -> None\nopens, initializes, and starts capturing"
 #define DOC_CAMERA_CAMERA_STOP "stop() -> None\nstops, uninitializes, and closes the camera"
 #define DOC_CAMERA_CAMERA_GETCONTROLS "get_controls() -> (hflip = bool, vflip = bool, brightness)\ngets current values of user controls"
 #define DOC_CAMERA_CAMERA_SETCONTROLS "set_controls(hflip = bool, vflip = bool, brightness) -> (hflip = bool, vflip = bool, brightness)\nchanges camera settings if supported by the camera"
@@ -13,3 +15,6 @@
 #define DOC_CAMERA_CAMERA_QUERYIMAGE "query_image() -> bool\nchecks if a frame is ready"
 #define DOC_CAMERA_CAMERA_GETIMAGE "get_image(Surface = None, /) -> Surface\ncaptures an image as a Surface"
 #define DOC_CAMERA_CAMERA_GETRAW "get_raw() -> bytes\nreturns an unmodified image as bytes"
+#define DOC_CAMERA_CAMERA_GETRAWVIEW "get_raw_view() -> memoryview\nreturns the unmodified frame without copying it"
+#define DOC_CAMERA_CAMERA_GETIMAGEVIEW "get_image_view() -> Surface\nreturns the frame as a Surface without copying it"
+#define DOC_CAMERA_CAMERA_GETFRAMETIME "get_frame_time() -> int\nreturns when the last image was captured"
@@ -19,5 +19,6 @@
 #define DOC_COLOR_SETLENGTH "set_length(len, /) -> None\nSet the number of elements in the Color to 1,2,3, or 4."
 #define DOC_COLOR_GRAYSCALE "grayscale() -> Color\nreturns the grayscale of a Color"
 #define DOC_COLOR_LERP "lerp(Color, float) -> Color\nreturns a linear interpolation to the given Color."
+#define DOC_COLOR_LERPMANY "lerp_many(colors, Color, float) -> list[Color]\nreturns linear interpolations of many colors to the given Color."
 #define DOC_COLOR_PREMULALPHA "premul_alpha() -> Color\nreturns a Color where the r,g,b components have been multiplied by the alpha."
 #define DOC_COLOR_UPDATE "update(r, g, b, /) -> None\nupdate(r, g, b, a=255, /) -> None\nupdate(color_value, /) -> None\nSets the elements of the color"
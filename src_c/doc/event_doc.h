@@ -2,6 +2,7 @@
 #define DOC_EVENT "pygame module for interacting with events and queues"
 #define DOC_EVENT_PUMP "pump() -> None\ninternally process pygame event handlers"
 #define DOC_EVENT_GET "get(eventtype=None) -> Eventlist\nget(eventtype=None, pump=True) -> Eventlist\nget(eventtype=None, pump=True, exclude=None) -> Eventlist\nget events from the queue"
+#define DOC_EVENT_GETINTO "get_into(buffer, pump=True) -> int\ncopy events from the queue into a buffer"
 #define DOC_EVENT_POLL "poll() -> Event instance\nget a single event from the queue"
 #define DOC_EVENT_WAIT "wait() -> Event instance\nwait(timeout) -> Event instance\nwait for a single event from the queue"
 #define DOC_EVENT_PEEK "peek(eventtype=None) -> bool\npeek(eventtype=None, pump=True) -> bool\ntest if event types are waiting on the queue"
@@ -14,6 +15,13 @@
 #define DOC_EVENT_GETGRAB "get_grab() -> bool\ntest if the program is sharing input devices"
 #define DOC_EVENT_POST "post(event, /) -> bool\nplace a new event on the queue"
 #define DOC_EVENT_CUSTOMTYPE "custom_type() -> int\nmake custom user event type"
+#define DOC_EVENT_SETCOALESCE "set_coalesce(eventtype, coalesce=True, keep_samples=False) -> None\nmerge consecutive motion events"
+#define DOC_EVENT_GETSAMPLES "get_samples() -> list\nget the raw motion samples recorded while coalescing"
+#define DOC_EVENT_RECORD "record(file) -> None\nrecord the input events into a log"
+#define DOC_EVENT_REPLAY "replay(file) -> None\nreplay the input events of a log"
 #define DOC_EVENT_EVENT "Event(type, dict) -> Event\nEvent(type, **attributes) -> Event\npygame object for representing events"
 #define DOC_EVENT_EVENT_TYPE "type -> int\nevent type identifier."
 #define DOC_EVENT_EVENT_DICT "__dict__ -> dict\nevent attribute dictionary"
+#define DOC_EVENT_CHANNEL "Channel(capacity=1024, item_size=64, eventtype=None) -> Channel\nfixed size lock-free queue for passing data between threads"
+#define DOC_EVENT_CHANNEL_PUSH "push(data, /) -> bool\nadd a payload to the channel"
+#define DOC_EVENT_CHANNEL_DRAIN "drain(max=-1) -> list\ntake the payloads out of the channel"
@@ -18,7 +18,10 @@
 #define DOC_FONT_FONT_ALIGN "align -> int\nSet how rendered text is aligned when given a wrap length."
 #define DOC_FONT_FONT_POINTSIZE "point_size -> int\nGets or sets the font's point size"
 #define DOC_FONT_FONT_RENDER "render(text, antialias, color, bgcolor=None, wraplength=0) -> Surface\ndraw text on a new Surface"
+#define DOC_FONT_FONT_RENDERTO "render_to(surface, dest, text, antialias, color) -> Rect\ndraw text onto a Surface from a glyph atlas"
+#define DOC_FONT_FONT_RENDERASYNC "render_async(text, antialias, color, bgcolor=None, wraplength=0) -> Future\nrender text on a worker thread"
 #define DOC_FONT_FONT_SIZE "size(text, /) -> (width, height)\ndetermine the amount of space needed to render text"
+#define DOC_FONT_FONT_SIZEMANY "size_many(strings, /) -> memoryview\ndetermine the sizes of many texts at once"
 #define DOC_FONT_FONT_SETUNDERLINE "set_underline(bool, /) -> None\ncontrol if text is rendered with an underline"
 #define DOC_FONT_FONT_GETUNDERLINE "get_underline() -> bool\ncheck if text will be rendered with an underline"
 #define DOC_FONT_FONT_SETSTRIKETHROUGH "set_strikethrough(bool, /) -> None\ncontrol if text is rendered with a strikethrough"
@@ -36,3 +39,7 @@
 #define DOC_FONT_FONT_GETDESCENT "get_descent() -> int\nget the descent of the font"
 #define DOC_FONT_FONT_SETSCRIPT "set_script(str, /) -> None\nset the script code for text shaping"
 #define DOC_FONT_FONT_SETDIRECTION "set_direction(direction) -> None\nset the script direction for text shaping"
+#define DOC_FONT_FONT_ENABLECACHE "enable_cache(max_bytes, /) -> None\ncache the surfaces returned by render"
+#define DOC_FONT_FONT_DISABLECACHE "disable_cache() -> None\nstop caching the surfaces returned by render"
+#define DOC_FONT_FONT_CLEARCACHE "clear_cache() -> None\nfree the surfaces cached by render"
+#define DOC_FONT_FONT_GETCACHESTATS "get_cache_stats() -> dict\nreturn statistics of the render cache"
@@ -11,7 +11,7 @@
 #define DOC_FREETYPE_SETDEFAULTRESOLUTION "set_default_resolution(resolution, /)\nSet the default pixel size in dots per inch for the module"
 #define DOC_FREETYPE_SYSFONT "SysFont(name, size, bold=False, italic=False) -> Font\ncreate a Font object from the system fonts"
 #define DOC_FREETYPE_GETDEFAULTFONT "get_default_font() -> string\nGet the filename of the default font"
-#define DOC_FREETYPE_FONT "Font(file, size=0, font_index=0, resolution=0, ucs4=False) -> Font\nFont(pathlib.Path) -> Font\nCreate a new Font instance from a supported font file."
+#define DOC_FREETYPE_FONT "Font(file, size=0, font_index=0, resolution=0, ucs4=False, share_cache=False) -> Font\nFont(pathlib.Path) -> Font\nCreate a new Font instance from a supported font file."
 #define DOC_FREETYPE_FONT_NAME "name -> string\nProper font name."
 #define DOC_FREETYPE_FONT_STYLENAME "style_name -> str\nGets the font's style_name."
 #define DOC_FREETYPE_FONT_PATH "path -> unicode\nFont file path"
@@ -28,8 +28,12 @@
 #define DOC_FREETYPE_FONT_GETSIZES "get_sizes() -> [(int, int, int, float, float), ...]\nget_sizes() -> []\nreturn the available sizes of embedded bitmaps"
 #define DOC_FREETYPE_FONT_RENDER "render(text, fgcolor=None, bgcolor=None, style=STYLE_DEFAULT, rotation=0, size=0) -> (Surface, Rect)\nReturn rendered text as a surface"
 #define DOC_FREETYPE_FONT_RENDERTO "render_to(surf, dest, text, fgcolor=None, bgcolor=None, style=STYLE_DEFAULT, rotation=0, size=0) -> Rect\nRender text onto an existing surface"
+#define DOC_FREETYPE_FONT_RENDERMANY "render_many(surf, items, style=STYLE_DEFAULT, rotation=0, size=0) -> list\nRender many texts onto one surface"
+#define DOC_FREETYPE_FONT_RENDERASYNC "render_async(text, fgcolor=None, bgcolor=None, style=STYLE_DEFAULT, rotation=0, size=0) -> Future\nRender text on a worker thread"
 #define DOC_FREETYPE_FONT_RENDERRAW "render_raw(text, style=STYLE_DEFAULT, rotation=0, size=0, invert=False) -> (bytes, (int, int))\nReturn rendered text as a string of bytes"
 #define DOC_FREETYPE_FONT_RENDERRAWTO "render_raw_to(array, text, dest=None, style=STYLE_DEFAULT, rotation=0, size=0, invert=False) -> Rect\nRender text into an array of ints"
+#define DOC_FREETYPE_FONT_GETCACHESTATS "get_cache_stats() -> dict\nReturn statistics of the glyph cache"
+#define DOC_FREETYPE_FONT_SETCACHEBUDGET "set_cache_budget(max_bytes, /) -> None\nLimit the memory used by the glyph cache"
 #define DOC_FREETYPE_FONT_STYLE "style -> int\nThe font's style flags"
 #define DOC_FREETYPE_FONT_UNDERLINE "underline -> bool\nThe state of the font's underline style flag"
 #define DOC_FREETYPE_FONT_STRONG "strong -> bool\nThe state of the font's strong style flag"
@@ -41,6 +45,7 @@
 #define DOC_FREETYPE_FONT_FIXEDSIZES "fixed_sizes -> int\nthe number of available bitmap sizes for the font"
 #define DOC_FREETYPE_FONT_SCALABLE "scalable -> bool\nGets whether the font is scalable"
 #define DOC_FREETYPE_FONT_USEBITMAPSTRIKES "use_bitmap_strikes -> bool\nallow the use of embedded bitmaps in an outline font file"
+#define DOC_FREETYPE_FONT_SDF "sdf -> bool\nrender glyphs from signed distance fields"
 #define DOC_FREETYPE_FONT_ANTIALIASED "antialiased -> bool\nFont anti-aliasing mode"
 #define DOC_FREETYPE_FONT_KERNING "kerning -> bool\nCharacter kerning mode"
 #define DOC_FREETYPE_FONT_VERTICAL "vertical -> bool\nFont vertical mode"
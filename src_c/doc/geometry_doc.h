@@ -15,6 +15,8 @@
 #define DOC_CIRCLE_MOVEIP "move_ip((x, y), /) -> None\nmove_ip(x, y, /) -> None\nmove_ip(vector2, /) -> None\nmoves the circle by a given amount, in place"
 #define DOC_CIRCLE_COLLIDERECT "colliderect(rect, /) -> bool\ncolliderect((x, y, width, height), /) -> bool\ncolliderect(x, y, width, height, /) -> bool\ncolliderect((x, y), (width, height), /) -> bool\nchecks if a rectangle intersects the circle"
 #define DOC_CIRCLE_COLLIDESWITH "collideswith(circle, /) -> bool\ncollideswith(rect, /) -> bool\ncollideswith((x, y), /) -> bool\ncollideswith(vector2, /) -> bool\ncheck if a shape or point collides with the circle"
+#define DOC_CIRCLE_COLLIDELIST "collidelist(shapes, /) -> int\nreturns the index of the first shape colliding with the circle"
+#define DOC_CIRCLE_COLLIDELISTALL "collidelistall(shapes, /) -> list\nreturns the indices of all shapes colliding with the circle"
 #define DOC_CIRCLE_CONTAINS "contains(circle, /) -> bool\ncontains(rect, /) -> bool\ncontains((x, y), /) -> bool\ncontains(vector2, /) -> bool\ncheck if a shape or point is inside the circle"
 #define DOC_CIRCLE_UPDATE "update((x, y), radius, /) -> None\nupdate(x, y, radius, /) -> None\nupdates the circle position and radius"
 #define DOC_CIRCLE_ROTATE "rotate(angle, rotation_point=Circle.center, /) -> Circle\nrotate(angle, /) -> Circle\nrotates the circle"
@@ -22,3 +24,36 @@
 #define DOC_CIRCLE_ASRECT "as_rect() -> Rect\nreturns the smallest pygame.Rect object that contains the circle"
 #define DOC_CIRCLE_ASFRECT "as_frect() -> FRect\nreturns the smallest pygame.FRect object that contains the circle"
 #define DOC_CIRCLE_COPY "copy() -> Circle\nreturns a copy of the circle"
+#define DOC_RECTINDEX "RectIndex(cell_size=64) -> RectIndex\nspatial index for fast rect collision queries"
+#define DOC_RECTINDEX_CELLSIZE "cell_size -> float\nsize of the grid cells"
+#define DOC_RECTINDEX_INSERT "insert(key, rect, /) -> None\nadds a rect to the index"
+#define DOC_RECTINDEX_MOVE "move(key, rect, /) -> None\nchanges the rect stored for a key"
+#define DOC_RECTINDEX_REMOVE "remove(key, /) -> None\nremoves a rect from the index"
+#define DOC_RECTINDEX_CLEAR "clear() -> None\nremoves all rects from the index"
+#define DOC_RECTINDEX_GETRECT "get_rect(key, /) -> FRect\nreturns the rect stored for a key"
+#define DOC_RECTINDEX_COLLIDEPOINT "collidepoint((x, y), /) -> list\ncollidepoint(x, y, /) -> list\nreturns the keys of all rects containing a point"
+#define DOC_RECTINDEX_COLLIDERECT "colliderect(rect, /) -> list\nreturns the keys of all rects overlapping a rect"
+#define DOC_RECTINDEX_COLLIDEPAIRS "collidepairs() -> list\nreturns all pairs of overlapping rects"
+#define DOC_LINE "Line((ax, ay), (bx, by)) -> Line\nLine(ax, ay, bx, by) -> Line\npygame object for representing a line segment"
+#define DOC_LINE_AX "ax -> float\nx coordinate of the start of the line"
+#define DOC_LINE_AY "ay -> float\ny coordinate of the start of the line"
+#define DOC_LINE_BX "bx -> float\nx coordinate of the end of the line"
+#define DOC_LINE_BY "by -> float\ny coordinate of the end of the line"
+#define DOC_LINE_A "a -> (float, float)\nthe start of the line"
+#define DOC_LINE_B "b -> (float, float)\nthe end of the line"
+#define DOC_LINE_LENGTH "length -> float\nthe length of the line"
+#define DOC_LINE_MOVE "move((x, y), /) -> Line\nmove(x, y, /) -> Line\nmoves the line by a given amount"
+#define DOC_LINE_MOVEIP "move_ip((x, y), /) -> None\nmove_ip(x, y, /) -> None\nmoves the line by a given amount, in place"
+#define DOC_LINE_UPDATE "update((ax, ay), (bx, by), /) -> None\nupdate(ax, ay, bx, by, /) -> None\nupdate(line, /) -> None\nupdates the line's points"
+#define DOC_LINE_COLLIDESWITH "collideswith(shape, /) -> bool\ncheck if a shape collides with the line"
+#define DOC_LINE_RAYCAST "raycast(shapes, /) -> (float, float) or None\nreturns the first point where the line hits one of the shapes"
+#define DOC_LINE_COPY "copy() -> Line\nreturns a copy of the line"
+#define DOC_POLYGON "Polygon([(x, y), (x, y), (x, y), ...]) -> Polygon\npygame object for representing a polygon"
+#define DOC_POLYGON_VERTICES "vertices -> list\nthe vertices of the polygon"
+#define DOC_POLYGON_VERTSNUM "verts_num -> int\nthe number of vertices of the polygon"
+#define DOC_POLYGON_CENTER "center -> (float, float)\nthe center of the polygon"
+#define DOC_POLYGON_COLLIDEPOINT "collidepoint((x, y), /) -> bool\ncollidepoint(x, y, /) -> bool\ntest if a point is inside the polygon"
+#define DOC_POLYGON_MOVE "move((x, y), /) -> Polygon\nmove(x, y, /) -> Polygon\nmoves the polygon by a given amount"
+#define DOC_POLYGON_MOVEIP "move_ip((x, y), /) -> None\nmove_ip(x, y, /) -> None\nmoves the polygon by a given amount, in place"
+#define DOC_POLYGON_COPY "copy() -> Polygon\nreturns a copy of the polygon"
+#define DOC_GEOMETRY_CIRCLEOVERLAPS "circle_overlaps(centers, radii, query) -> list\nreturns the indices of the circles of two arrays overlapping a shape"
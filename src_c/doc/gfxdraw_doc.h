@@ -22,3 +22,26 @@
 #define DOC_GFXDRAW_FILLEDPOLYGON "filled_polygon(surface, points, color, /) -> None\ndraw a filled polygon"
 #define DOC_GFXDRAW_TEXTUREDPOLYGON "textured_polygon(surface, points, texture, tx, ty, /) -> None\ndraw a textured polygon"
 #define DOC_GFXDRAW_BEZIER "bezier(surface, points, steps, color, /) -> None\ndraw a Bezier curve"
+#define DOC_GFXDRAW_BATCH "batch(surface) -> batch\nqueue gfxdraw primitives and draw them together"
+#define DOC_GFXDRAW_BATCH_PIXEL "pixel(x, y, color, /) -> None\nqueue a pixel"
+#define DOC_GFXDRAW_BATCH_HLINE "hline(x1, x2, y, color, /) -> None\nqueue a horizontal line"
+#define DOC_GFXDRAW_BATCH_VLINE "vline(x, y1, y2, color, /) -> None\nqueue a vertical line"
+#define DOC_GFXDRAW_BATCH_LINE "line(x1, y1, x2, y2, color, /) -> None\nqueue a line"
+#define DOC_GFXDRAW_BATCH_RECTANGLE "rectangle(rect, color, /) -> None\nqueue a rectangle"
+#define DOC_GFXDRAW_BATCH_BOX "box(rect, color, /) -> None\nqueue a filled rectangle"
+#define DOC_GFXDRAW_BATCH_CIRCLE "circle(x, y, r, color, /) -> None\nqueue a circle"
+#define DOC_GFXDRAW_BATCH_AACIRCLE "aacircle(x, y, r, color, /) -> None\nqueue an antialiased circle"
+#define DOC_GFXDRAW_BATCH_FILLEDCIRCLE "filled_circle(x, y, r, color, /) -> None\nqueue a filled circle"
+#define DOC_GFXDRAW_BATCH_ELLIPSE "ellipse(x, y, rx, ry, color, /) -> None\nqueue an ellipse"
+#define DOC_GFXDRAW_BATCH_AAELLIPSE "aaellipse(x, y, rx, ry, color, /) -> None\nqueue an antialiased ellipse"
+#define DOC_GFXDRAW_BATCH_FILLEDELLIPSE "filled_ellipse(x, y, rx, ry, color, /) -> None\nqueue a filled ellipse"
+#define DOC_GFXDRAW_BATCH_ARC "arc(x, y, r, start_angle, stop_angle, color, /) -> None\nqueue an arc"
+#define DOC_GFXDRAW_BATCH_PIE "pie(x, y, r, start_angle, stop_angle, color, /) -> None\nqueue a pie"
+#define DOC_GFXDRAW_BATCH_TRIGON "trigon(x1, y1, x2, y2, x3, y3, color, /) -> None\nqueue a trigon/triangle"
+#define DOC_GFXDRAW_BATCH_AATRIGON "aatrigon(x1, y1, x2, y2, x3, y3, color, /) -> None\nqueue an antialiased trigon/triangle"
+#define DOC_GFXDRAW_BATCH_FILLEDTRIGON "filled_trigon(x1, y1, x2, y2, x3, y3, color, /) -> None\nqueue a filled trigon/triangle"
+#define DOC_GFXDRAW_BATCH_POLYGON "polygon(points, color, /) -> None\nqueue a polygon"
+#define DOC_GFXDRAW_BATCH_AAPOLYGON "aapolygon(points, color, /) -> None\nqueue an antialiased polygon"
+#define DOC_GFXDRAW_BATCH_FILLEDPOLYGON "filled_polygon(points, color, /) -> None\nqueue a filled polygon"
+#define DOC_GFXDRAW_BATCH_BEZIER "bezier(points, steps, color, /) -> None\nqueue a Bezier curve"
+#define DOC_GFXDRAW_BATCH_QUEUED "queued -> int\nnumber of queued primitives"
@@ -1,12 +1,25 @@
 /* Auto generated file: with make_docs.py .  Docs go in docs/reST/ref/ . */
 #define DOC_IMAGE "pygame module for image transfer"
 #define DOC_IMAGE_LOAD "load(file) -> Surface\nload(file, namehint="") -> Surface\nload new image from a file (or file-like object)"
-#define DOC_IMAGE_LOADSIZEDSVG "load_sized_svg(file, size) -> Surface\nload an SVG image from a file (or file-like object) with the given size"
+#define DOC_IMAGE_LOADSIZEDSVG "load_sized_svg(file, size) -> Surface\nload_sized_svg(file, sizes) -> list[Surface]\nload an SVG image from a file (or file-like object) with the given size"
+#define DOC_IMAGE_SETSVGCACHELIMIT "set_svg_cache_limit(limit, /) -> None\nset how many rasterised SVGs load_sized_svg keeps"
+#define DOC_IMAGE_LOADANIMATION "load_animation(file, namehint="", atlas=False) -> list[tuple[Surface, int]]\nload_animation(file, namehint="", atlas=True) -> tuple[Surface, list[tuple[Rect, int]]]\nload the frames of an animated image"
+#define DOC_IMAGE_LOADMANY "load_many(paths, threads=0) -> (surfaces, errors)\nload many images at once on several threads"
+#define DOC_IMAGE_LOADASYNC "load_async(file, namehint=\"\", *, convert=False, convert_alpha=False) -> concurrent.futures.Future\nload an image on a background thread"
 #define DOC_IMAGE_SAVE "save(Surface, file) -> None\nsave(Surface, file, namehint="") -> None\nsave an image to file (or file-like object)"
+#define DOC_IMAGE_SAVEASYNC "save_async(Surface, file, namehint=\"\", *, quality=85) -> concurrent.futures.Future\nsave an image on a background thread"
+#define DOC_IMAGE_SAVERAW "save_raw(Surface, file, compress='lz4') -> None\nsave a surface in pygame's own uncompressed or LZ4 format"
+#define DOC_IMAGE_LOADRAW "load_raw(file) -> Surface\nload a surface written by save_raw"
+#define DOC_IMAGE_RECORDER "Recorder(file, format=None, buffers=4) -> Recorder\nwrite frames of the display to files on a background thread"
+#define DOC_IMAGE_RECORDER_CAPTURE "capture(surface=None) -> bool\ncopy a surface into the next free frame"
+#define DOC_IMAGE_RECORDER_CLOSE "close() -> None\nwrite the queued frames and stop the worker"
+#define DOC_IMAGE_RECORDER_CAPTURED "captured -> int\nnumber of frames captured"
+#define DOC_IMAGE_RECORDER_DROPPED "dropped -> int\nnumber of frames dropped because the writer fell behind"
+#define DOC_IMAGE_RECORDER_PENDING "pending -> int\nnumber of frames waiting to be written"
 #define DOC_IMAGE_GETSDLIMAGEVERSION "get_sdl_image_version(linked=True) -> None\nget_sdl_image_version(linked=True) -> (major, minor, patch)\nget version number of the SDL_Image library being used"
 #define DOC_IMAGE_GETEXTENDED "get_extended() -> bool\ntest if extended image formats can be loaded"
 #define DOC_IMAGE_TOSTRING "tostring(Surface, format, flipped=False, pitch=-1) -> bytes\ntransfer image to byte buffer"
-#define DOC_IMAGE_TOBYTES "tobytes(Surface, format, flipped=False, pitch=-1) -> bytes\ntransfer image to byte buffer"
+#define DOC_IMAGE_TOBYTES "tobytes(Surface, format, flipped=False, pitch=-1, into=None) -> bytes\ntransfer image to byte buffer"
 #define DOC_IMAGE_FROMSTRING "fromstring(bytes, size, format, flipped=False, pitch=-1) -> Surface\ncreate new Surface from a byte buffer"
 #define DOC_IMAGE_FROMBYTES "frombytes(bytes, size, format, flipped=False, pitch=-1) -> Surface\ncreate new Surface from a byte buffer"
 #define DOC_IMAGE_FROMBUFFER "frombuffer(buffer, size, format, pitch=-1) -> Surface\ncreate a new Surface that shares data inside a bytes buffer"
@@ -0,0 +1,12 @@
+/* Auto generated file: with make_docs.py .  Docs go in docs/reST/ref/ . */
+#define DOC_INPUT "pygame module to read the keyboard, mouse and joysticks at once"
+#define DOC_INPUT_SNAPSHOT "snapshot(into=None) -> InputState\nread the state of the keyboard, mouse and joysticks"
+#define DOC_INPUT_INPUTSTATE "InputState() -> InputState\nthe state of the input devices at one point in time"
+#define DOC_INPUT_INPUTSTATE_KEYPRESSED "key_pressed(key, /) -> bool\ncheck if a key was held down"
+#define DOC_INPUT_INPUTSTATE_MOUSEPRESSED "mouse_pressed(button, /) -> bool\ncheck if a mouse button was held down"
+#define DOC_INPUT_INPUTSTATE_GETAXIS "get_axis(instance_id, axis, /) -> float\nget the position of a joystick axis"
+#define DOC_INPUT_INPUTSTATE_GETBUTTON "get_button(instance_id, button, /) -> bool\nget the state of a joystick button"
+#define DOC_INPUT_INPUTSTATE_GETHAT "get_hat(instance_id, hat, /) -> tuple[int, int]\nget the position of a joystick hat"
+#define DOC_INPUT_INPUTSTATE_MODS "mods -> int\nthe modifier keys that were held down"
+#define DOC_INPUT_INPUTSTATE_MOUSEPOS "mouse_pos -> tuple[int, int]\nthe position of the mouse cursor"
+#define DOC_INPUT_INPUTSTATE_JOYSTICKIDS "joystick_ids -> tuple[int, ...]\nthe instance ids of the joysticks that were read"
@@ -23,3 +23,6 @@
 #define DOC_JOYSTICK_JOYSTICK_GETHAT "get_hat(hat_number, /) -> x, y\nget the position of a joystick hat"
 #define DOC_JOYSTICK_JOYSTICK_RUMBLE "rumble(low_frequency, high_frequency, duration) -> bool\nStart a rumbling effect"
 #define DOC_JOYSTICK_JOYSTICK_STOPRUMBLE "stop_rumble() -> None\nStop any rumble effect playing"
+#define DOC_JOYSTICK_JOYSTICK_STARTSAMPLING "start_sampling(rate=1000, capacity=4096) -> None\nStart recording the axes on a background thread"
+#define DOC_JOYSTICK_JOYSTICK_STOPSAMPLING "stop_sampling() -> None\nStop recording the axes"
+#define DOC_JOYSTICK_JOYSTICK_GETSAMPLES "get_samples() -> list[tuple[float, tuple[float, ...]]]\nCollect the recorded axes"
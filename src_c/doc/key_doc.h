@@ -4,6 +4,9 @@
 #define DOC_KEY_GETPRESSED "get_pressed() -> bools\nget the state of all keyboard buttons"
 #define DOC_KEY_GETJUSTPRESSED "get_just_pressed() -> bools\nreturns a pygame.key.ScancodeWrapper containing the most recent key presses"
 #define DOC_KEY_GETJUSTRELEASED "get_just_pressed() -> bools\nreturns a pygame.key.ScancodeWrapper containing the most recent key releases"
+#define DOC_KEY_GETPRESSEDVIEW "get_pressed_view() -> memoryview\nget a live view of the state of all keyboard keys"
+#define DOC_KEY_GETJUSTPRESSEDVIEW "get_just_pressed_view() -> memoryview\nget a live view of the keys pressed since events were last processed"
+#define DOC_KEY_GETJUSTRELEASEDVIEW "get_just_released_view() -> memoryview\nget a live view of the keys released since events were last processed"
 #define DOC_KEY_GETMODS "get_mods() -> int\ndetermine which modifier keys are being held"
 #define DOC_KEY_SETMODS "set_mods(int, /) -> None\ntemporarily set which modifier keys are pressed"
 #define DOC_KEY_SETREPEAT "set_repeat() -> None\nset_repeat(delay, /) -> None\nset_repeat(delay, interval, /) -> None\ncontrol how held keys are repeated"
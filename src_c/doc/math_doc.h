@@ -5,6 +5,8 @@
 #define DOC_MATH_INVLERP "invlerp(a, b, value, /) -> float\nreturns value inverse interpolated between a and b"
 #define DOC_MATH_SMOOTHSTEP "smoothstep(a, b, value, /) -> float\nreturns value smoothly interpolated between a and b."
 #define DOC_MATH_REMAP "remap(i_min, i_max, o_min, o_max, value, /) -> float\nremaps value from given input range to given output range"
+#define DOC_MATH_NOISE "noise(x, y, /, *, kind='perlin', octaves=1, persistence=0.5, lacunarity=2.0, seed=0) -> float\nreturns 2D procedural noise at a point"
+#define DOC_MATH_NOISEFILL "noise_fill(dest, /, *, kind='perlin', frequency=0.0625, offset=(0, 0), octaves=1, persistence=0.5, lacunarity=2.0, seed=0, channel=None, threads=0) -> None\nfills an array or Surface with 2D procedural noise"
 #define DOC_MATH_VECTOR2 "Vector2() -> Vector2(0, 0)\nVector2(int) -> Vector2\nVector2(float) -> Vector2\nVector2(Vector2) -> Vector2\nVector2(x, y) -> Vector2\nVector2((x, y)) -> Vector2\na 2-Dimensional Vector"
 #define DOC_MATH_VECTOR2_DOT "dot(Vector2, /) -> float\ncalculates the dot- or scalar-product with the other vector"
 #define DOC_MATH_VECTOR2_CROSS "cross(Vector2, /) -> float\ncalculates the cross- or vector-product"
@@ -90,3 +92,15 @@
 #define DOC_MATH_VECTOR3_CLAMPMAGNITUDEIP "clamp_magnitude_ip(max_length, /) -> None\nclamp_magnitude_ip(min_length, max_length, /) -> None\nClamps the vector's magnitude between max_length and min_length"
 #define DOC_MATH_VECTOR3_UPDATE "update() -> None\nupdate(int) -> None\nupdate(float) -> None\nupdate(Vector3) -> None\nupdate(x, y, z) -> None\nupdate((x, y, z)) -> None\nSets the coordinates of the vector."
 #define DOC_MATH_VECTOR3_EPSILON "Determines the tolerance of vector calculations."
+#define DOC_MATH_VECTOR2ARRAY "Vector2Array() -> Vector2Array\nVector2Array(length) -> Vector2Array\nVector2Array(vectors) -> Vector2Array\na fixed size array of 2-Dimensional Vectors"
+#define DOC_MATH_VECTOR2ARRAY_COPY "copy() -> Vector2Array\nReturns a copy of itself."
+#define DOC_MATH_VECTOR2ARRAY_LENGTH "length() -> list\nreturns the Euclidean length of every vector."
+#define DOC_MATH_VECTOR2ARRAY_LENGTHSQUARED "length_squared() -> list\nreturns the squared Euclidean length of every vector."
+#define DOC_MATH_VECTOR2ARRAY_DOT "dot(other, /) -> list\ncalculates the dot product of every vector with other."
+#define DOC_MATH_VECTOR2ARRAY_DISTANCETO "distance_to(other, /) -> list\ncalculates the Euclidean distance of every vector to other."
+#define DOC_MATH_VECTOR2ARRAY_DISTANCESQUAREDTO "distance_squared_to(other, /) -> list\ncalculates the squared Euclidean distance of every vector to other."
+#define DOC_MATH_VECTOR2ARRAY_NORMALIZE "normalize() -> Vector2Array\nreturns an array with all vectors normalized."
+#define DOC_MATH_VECTOR2ARRAY_NORMALIZEIP "normalize_ip() -> None\nnormalizes all vectors in place."
+#define DOC_MATH_VECTOR2ARRAY_ROTATE "rotate(angle, /) -> Vector2Array\nreturns an array with all vectors rotated by an angle in degrees."
+#define DOC_MATH_VECTOR2ARRAY_ROTATEIP "rotate_ip(angle, /) -> None\nrotates all vectors by an angle in degrees in place."
+#define DOC_MATH_VECTOR2ARRAY_LERP "lerp(other, value, /) -> Vector2Array\nreturns a linear interpolation of every vector to other."
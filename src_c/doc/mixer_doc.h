@@ -6,24 +6,31 @@
 #define DOC_MIXER_GETINIT "get_init() -> (frequency, format, channels)\ntest if the mixer is initialized"
 #define DOC_MIXER_GETDRIVER "get_driver() -> str\nget the name of the current audio backend driver"
 #define DOC_MIXER_STOP "stop() -> None\nstop playback of all sound channels"
+#define DOC_MIXER_SETDSP "set_dsp(*, gain=1.0, ramp_ms=0.0, filter=None, cutoff=1000.0, q=0.7071, threshold=None, ratio=4.0, attack_ms=5.0, release_ms=100.0, reverb=0.0, room_size=0.5, damping=0.5) -> None\nconfigure the effect chain on the master bus"
+#define DOC_MIXER_RESETDSP "reset_dsp() -> None\nremove the effect chain from the master bus"
+#define DOC_MIXER_SETOUTPUTCALLBACK "set_output_callback(buffer, /) -> None\nset_output_callback(callback, /) -> None\nset_output_callback(None, /) -> None\nreceive the final mix as it is sent to the audio device"
+#define DOC_MIXER_GETOUTPUTPOSITION "get_output_position() -> (frames, ticks)\nget the number of frames sent to the audio device"
 #define DOC_MIXER_PAUSE "pause() -> None\ntemporarily stop playback of all sound channels"
 #define DOC_MIXER_UNPAUSE "unpause() -> None\nresume paused playback of sound channels"
 #define DOC_MIXER_FADEOUT "fadeout(time, /) -> None\nfade out the volume on all sounds before stopping"
 #define DOC_MIXER_SETNUMCHANNELS "set_num_channels(count, /) -> None\nset the total number of playback channels"
 #define DOC_MIXER_GETNUMCHANNELS "get_num_channels() -> count\nget the total number of playback channels"
 #define DOC_MIXER_SETRESERVED "set_reserved(count, /) -> count\nreserve channels from being automatically used"
+#define DOC_MIXER_SETCULLDISTANCE "set_cull_distance(distance, /) -> None\nskip playing sounds from this distance on"
 #define DOC_MIXER_FINDCHANNEL "find_channel(force=False) -> Channel\nfind an unused channel"
 #define DOC_MIXER_SETSOUNDFONT "set_soundfont(path, /) -> None\nset the soundfont for playing midi music"
 #define DOC_MIXER_GETSOUNDFONT "get_soundfont() -> paths\nget the soundfont for playing midi music"
 #define DOC_MIXER_GETBUSY "get_busy() -> bool\ntest if any sound is being mixed"
 #define DOC_MIXER_GETSDLMIXERVERSION "get_sdl_mixer_version() -> (major, minor, patch)\nget_sdl_mixer_version(linked=True) -> (major, minor, patch)\nget the mixer's SDL version"
-#define DOC_MIXER_SOUND "Sound(filename) -> Sound\nSound(file=filename) -> Sound\nSound(file=pathlib_path) -> Sound\nSound(buffer) -> Sound\nSound(buffer=buffer) -> Sound\nSound(object) -> Sound\nSound(file=object) -> Sound\nSound(array=object) -> Sound\nCreate a new Sound object from a file or buffer object"
-#define DOC_MIXER_SOUND_PLAY "play(loops=0, maxtime=0, fade_ms=0) -> Channel\nbegin sound playback"
+#define DOC_MIXER_SOUND "Sound(filename) -> Sound\nSound(file=filename) -> Sound\nSound(file=pathlib_path) -> Sound\nSound(file=filename, mmap=True) -> Sound\nSound(buffer) -> Sound\nSound(buffer=buffer) -> Sound\nSound(buffer=buffer, copy=False) -> Sound\nSound(object) -> Sound\nSound(file=object) -> Sound\nSound(array=object) -> Sound\nCreate a new Sound object from a file or buffer object"
+#define DOC_MIXER_SOUND_PLAY "play(loops=0, maxtime=0, fade_ms=0, priority=0, distance=None) -> Channel\nbegin sound playback"
 #define DOC_MIXER_SOUND_STOP "stop() -> None\nstop sound playback"
 #define DOC_MIXER_SOUND_FADEOUT "fadeout(time, /) -> None\nstop sound playback after fading out"
 #define DOC_MIXER_SOUND_SETVOLUME "set_volume(value, /) -> None\nset the playback volume for this Sound"
 #define DOC_MIXER_SOUND_GETVOLUME "get_volume() -> value\nget the playback volume"
 #define DOC_MIXER_SOUND_GETNUMCHANNELS "get_num_channels() -> count\ncount how many times this Sound is playing"
+#define DOC_MIXER_SOUND_SETMAXINSTANCES "set_max_instances(count, /) -> None\nlimit how many times this Sound plays at once"
+#define DOC_MIXER_SOUND_GETMAXINSTANCES "get_max_instances() -> count\nget the limit of how many times this Sound plays at once"
 #define DOC_MIXER_SOUND_GETLENGTH "get_length() -> seconds\nget the length of the Sound"
 #define DOC_MIXER_SOUND_GETRAW "get_raw() -> bytes\nreturn a bytestring copy of the Sound samples."
 #define DOC_MIXER_CHANNEL "Channel(id) -> Channel\nCreate a Channel object for controlling playback"
@@ -36,6 +43,8 @@
 #define DOC_MIXER_CHANNEL_SETSOURCELOCATION "set_source_location(angle, distance, /) -> None\nset the position of a playing channel"
 #define DOC_MIXER_CHANNEL_SETVOLUME "set_volume(value, /) -> None\nset_volume(left, right, /) -> None\nset the volume of a playing channel"
 #define DOC_MIXER_CHANNEL_GETVOLUME "get_volume() -> value\nget the volume of the playing channel"
+#define DOC_MIXER_CHANNEL_SETDSP "set_dsp(*, gain=1.0, ramp_ms=0.0, filter=None, cutoff=1000.0, q=0.7071, threshold=None, ratio=4.0, attack_ms=5.0, release_ms=100.0, reverb=0.0, room_size=0.5, damping=0.5) -> None\nconfigure the effect chain of the channel"
+#define DOC_MIXER_CHANNEL_RESETDSP "reset_dsp() -> None\nremove the effect chain of the channel"
 #define DOC_MIXER_CHANNEL_GETBUSY "get_busy() -> bool\ncheck if the channel is active"
 #define DOC_MIXER_CHANNEL_GETSOUND "get_sound() -> Sound\nget the currently playing Sound"
 #define DOC_MIXER_CHANNEL_QUEUE "queue(sound, /) -> None\nqueue a Sound object to follow the current"
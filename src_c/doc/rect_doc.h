@@ -28,3 +28,12 @@
 #define DOC_RECT_COLLIDEOBJECTSALL "collideobjectsall(rect_list) -> objects\ncollideobjectsall(obj_list, key=func) -> objects\ntest if all objects in a list intersect"
 #define DOC_RECT_COLLIDEDICT "collidedict(rect_dict) -> (key, value)\ncollidedict(rect_dict) -> None\ncollidedict(rect_dict, values=False) -> (key, value)\ncollidedict(rect_dict, values=False) -> None\ntest if one rectangle in a dictionary intersects"
 #define DOC_RECT_COLLIDEDICTALL "collidedictall(rect_dict) -> [(key, value), ...]\ncollidedictall(rect_dict, values=False) -> [(key, value), ...]\ntest if all rectangles in a dictionary intersect"
+#define DOC_RECT_COLLIDEALLPAIRS "collide_all_pairs(rects, /) -> [(i, j), ...]\nfind all pairs of intersecting rectangles in a list"
+#define DOC_RECTARRAY "RectArray(rects=(), /) -> RectArray\npygame object storing many rectangles in one block"
+#define DOC_RECTARRAY_APPEND "append(rect, /) -> None\nadd a rectangle to the end of the array"
+#define DOC_RECTARRAY_COPY "copy() -> RectArray\ncopy the array"
+#define DOC_RECTARRAY_MOVEIP "move_ip(x, y, /) -> None\nmove all the rectangles, in place"
+#define DOC_RECTARRAY_CLAMPIP "clamp_ip(rect, /) -> None\nmove all the rectangles inside another, in place"
+#define DOC_RECTARRAY_COLLIDEPOINT "collidepoint(x, y, /) -> bytes\ncollidepoint((x, y), /) -> bytes\ntest which rectangles a point is inside of"
+#define DOC_RECTARRAY_COLLIDERECT "colliderect(rect, /) -> bytes\ntest which rectangles overlap another"
+#define DOC_RECTARRAY_UNION "union() -> Rect\nthe union of all the rectangles"
@@ -18,6 +18,12 @@
 #define DOC_SDL2_VIDEO_TEXTURE_DRAWTRIANGLE "draw_triangle(p1_xy, p2_xy, p3_xy, p1_uv=(0.0, 0.0), p2_uv=(1.0, 1.0), p3_uv=(0.0, 1.0), p1_mod=(255, 255, 255, 255), p2_mod=(255, 255, 255, 255), p3_mod=(255, 255, 255, 255)) -> None\nCopy a triangle portion of the texture to the rendering target using the given coordinates"
 #define DOC_SDL2_VIDEO_TEXTURE_DRAWQUAD "draw_quad(p1_xy, p2_xy, p3_xy, p4_xy, p1_uv=(0.0, 0.0), p2_uv=(1.0, 0.0), p3_uv=(1.0, 1.0), p4_uv=(0.0, 1.0), p1_mod=(255, 255, 255, 255), p2_mod=(255, 255, 255, 255), p3_mod=(255, 255, 255, 255), p4_mod=(255, 255, 255, 255)) -> None\nCopy a quad portion of the texture to the rendering target using the given coordinates"
 #define DOC_SDL2_VIDEO_TEXTURE_UPDATE "update(surface, area=None) -> None\nUpdate the texture with Surface (slow operation, use sparingly)"
+#define DOC_SDL2_VIDEO_TEXTURE_LOCK "lock(area=None) -> TextureLock\nLock a portion of a streaming texture for writing its pixels"
+#define DOC_SDL2_VIDEO_TEXTURE_UPDATEFROMBUFFER "update_from_buffer(buffer, area=None, pitch=0) -> None\nUpdate the texture with raw pixel data"
+#define DOC_SDL2_VIDEO_TEXTURELOCK "TextureLock -> TextureLock\nThe locked pixels of a streaming texture"
+#define DOC_SDL2_VIDEO_TEXTURELOCK_TEXTURE "texture -> Texture\nGet the locked texture"
+#define DOC_SDL2_VIDEO_TEXTURELOCK_LOCKED "locked -> bool\nGet whether the texture is still locked"
+#define DOC_SDL2_VIDEO_TEXTURELOCK_UNLOCK "unlock() -> None\nUnlock the texture, uploading the written pixels"
 #define DOC_SDL2_VIDEO_IMAGE "Image(texture_or_image, srcrect=None) -> Image\npygame object that represents a portion of a texture"
 #define DOC_SDL2_VIDEO_IMAGE_ANGLE "angle -> float\nGet and set the angle the Image draws itself with"
 #define DOC_SDL2_VIDEO_IMAGE_FLIPX "flip_x -> bool\nGet or set whether the Image is flipped on the x axis"
@@ -30,6 +36,10 @@
 #define DOC_SDL2_VIDEO_IMAGE_ORIGIN "origin -> (float, float) or None\nGet or set the Image's origin of rotation"
 #define DOC_SDL2_VIDEO_IMAGE_GETRECT "get_rect() -> Rect\nGet the rectangular area of the Image"
 #define DOC_SDL2_VIDEO_IMAGE_DRAW "draw(srcrect=None, dstrect=None) -> None\nCopy a portion of the Image to the rendering target"
+#define DOC_SDL2_VIDEO_TEXTUREATLAS "TextureAtlas(renderer, size=(2048, 2048), padding=1, scale_quality=None) -> TextureAtlas\npygame object that packs many surfaces into a few textures"
+#define DOC_SDL2_VIDEO_TEXTUREATLAS_TEXTURES "textures -> list[Texture]\nGet a list of the textures of the atlas"
+#define DOC_SDL2_VIDEO_TEXTUREATLAS_ADD "add(surface) -> Image\nCopy a surface into the atlas"
+#define DOC_SDL2_VIDEO_TEXTUREATLAS_ADDALL "add_all(surfaces) -> list[Image]\nCopy several surfaces into the atlas"
 #define DOC_SDL2_VIDEO_RENDERER "Renderer(window, index=-1, accelerated=-1, vsync=False, target_texture=False) -> Renderer\npygame object wrapping a 2D rendering context for a window"
 #define DOC_SDL2_VIDEO_RENDERER_DRAWBLENDMODE "draw_blend_mode -> int\nGet or set the blend mode used for primitive drawing operations"
 #define DOC_SDL2_VIDEO_RENDERER_DRAWCOLOR "draw_color -> Color\nGet or set the color used for primitive drawing operations"
@@ -50,5 +60,7 @@
 #define DOC_SDL2_VIDEO_RENDERER_FILLTRIANGLE "fill_triangle(p1, p2, p3) -> None\nDraw a filled triangle"
 #define DOC_SDL2_VIDEO_RENDERER_DRAWQUAD "draw_quad(p1, p2, p3, p4) -> None\nDraw a quad outline"
 #define DOC_SDL2_VIDEO_RENDERER_FILLQUAD "fill_quad(p1, p2, p3, p4) -> None\nDraw a filled quad"
+#define DOC_SDL2_VIDEO_RENDERER_DRAWBATCH "draw_batch(texture, buffer) -> None\nDraw many portions of a texture with a single render call"
 #define DOC_SDL2_VIDEO_RENDERER_TOSURFACE "to_surface(surface=None, area=None)-> Surface\nRead pixels from current rendering target and create a Surface (slow operation, use sparingly)"
+#define DOC_SDL2_VIDEO_RENDERER_READPIXELS "read_pixels(buffer=None, area=None) -> buffer\nRead pixels from the current rendering target into a buffer"
 #define DOC_SDL2_VIDEO_RENDERER_COMPOSECUSTOMBLENDMODE "compose_custom_blend_mode(color_mode, alpha_mode) -> int\nCompose a custom blend mode"
@@ -1,12 +1,17 @@
 /* Auto generated file: with make_docs.py .  Docs go in docs/reST/ref/ . */
 #define DOC_SURFACE "Surface((width, height), flags=0, depth=0, masks=None) -> Surface\nSurface((width, height), flags=0, Surface) -> Surface\npygame object for representing images"
 #define DOC_SURFACE_BLIT "blit(source, dest, area=None, special_flags=0) -> Rect\ndraw another surface onto this one"
-#define DOC_SURFACE_BLITS "blits(blit_sequence=((source, dest), ...), doreturn=True) -> [Rect, ...] or None\nblits(((source, dest, area), ...)) -> [Rect, ...]\nblits(((source, dest, area, special_flags), ...)) -> [Rect, ...]\ndraw many surfaces onto this surface at their corresponding location"
-#define DOC_SURFACE_FBLITS "fblits(blit_sequence=((source, dest), ...), special_flags=0, /) -> None\ndraw many surfaces onto this surface at their corresponding location and with the same special_flags"
+#define DOC_SURFACE_BLITS "blits(blit_sequence=((source, dest), ...), doreturn=True, parallel=False) -> [Rect, ...] or None\nblits(((source, dest, area), ...)) -> [Rect, ...]\nblits(((source, dest, area, special_flags), ...)) -> [Rect, ...]\ndraw many surfaces onto this surface at their corresponding location"
+#define DOC_SURFACE_FBLITS "fblits(blit_sequence=((source, dest), ...), special_flags=0, parallel=False, /) -> None\ndraw many surfaces onto this surface at their corresponding location and with the same special_flags"
+#define DOC_SURFACE_BLITTRANSFORMED "blit_transformed(source, pos, angle=0, scale=1, flip_x=False, flip_y=False, origin=None, smooth=False, special_flags=0) -> Rect\ndraw a rotated, scaled or flipped surface onto this surface"
+#define DOC_SURFACE_BLITTILED "blit_tiled(source, rect, offset=(0, 0), special_flags=0) -> Rect\nfill an area of this surface with copies of another surface"
+#define DOC_SURFACE_BLITTILEMAP "blit_tilemap(tileset, indices, tile_size, origin=(0, 0), special_flags=0) -> Rect\ndraw a grid of tiles from a tileset onto this surface"
 #define DOC_SURFACE_CONVERT "convert(surface, /) -> Surface\nconvert(depth, flags=0, /) -> Surface\nconvert(masks, flags=0, /) -> Surface\nconvert() -> Surface\nchange the pixel format of a surface"
 #define DOC_SURFACE_CONVERTALPHA "convert_alpha() -> Surface\nchange the pixel format of a surface including per pixel alphas"
+#define DOC_SURFACE_CONVERTMANY "convert_many(surfaces, alpha=True) -> list\nchange the pixel format of many surfaces at once"
 #define DOC_SURFACE_COPY "copy() -> Surface\ncreate a new copy of a Surface"
 #define DOC_SURFACE_FILL "fill(color, rect=None, special_flags=0) -> Rect\nfill Surface with a solid color"
+#define DOC_SURFACE_FILLMANY "fill_many(rects, colors, special_flags=0) -> None\nfill many areas of the Surface in one call"
 #define DOC_SURFACE_SCROLL "scroll(dx=0, dy=0, /) -> None\nshift the surface image in place"
 #define DOC_SURFACE_SETCOLORKEY "set_colorkey(color, flags=0, /) -> None\nset_colorkey(None) -> None\nset the transparent colorkey"
 #define DOC_SURFACE_GETCOLORKEY "get_colorkey() -> RGB or None\nget the current transparent colorkey"
@@ -19,6 +24,8 @@
 #define DOC_SURFACE_GETLOCKS "get_locks() -> tuple\ngets the locks for the Surface"
 #define DOC_SURFACE_GETAT "get_at((x, y), /) -> Color\nget the color value at a single pixel"
 #define DOC_SURFACE_SETAT "set_at((x, y), color, /) -> None\nset the color value for a single pixel"
+#define DOC_SURFACE_GETATMANY "get_at_many(points, out=None) -> memoryview\nget the mapped color values of many pixels"
+#define DOC_SURFACE_SETATMANY "set_at_many(points, colors) -> None\nset the color of many pixels"
 #define DOC_SURFACE_GETATMAPPED "get_at_mapped((x, y), /) -> Color\nget the mapped color value at a single pixel"
 #define DOC_SURFACE_GETPALETTE "get_palette() -> [RGB, RGB, RGB, ...]\nget the color index palette for an 8-bit Surface"
 #define DOC_SURFACE_GETPALETTEAT "get_palette_at(index, /) -> RGB\nget the color for a single entry in a palette"
@@ -29,6 +36,7 @@
 #define DOC_SURFACE_SETCLIP "set_clip(rect, /) -> None\nset_clip(None) -> None\nset the current clipping area of the Surface"
 #define DOC_SURFACE_GETCLIP "get_clip() -> Rect\nget the current clipping area of the Surface"
 #define DOC_SURFACE_SUBSURFACE "subsurface(rect, /) -> Surface\ncreate a new surface that references its parent"
+#define DOC_SURFACE_SUBSURFACES "subsurfaces(rects, views=False) -> list\ncreate many subsurfaces or views of the surface at once"
 #define DOC_SURFACE_GETPARENT "get_parent() -> Surface\nfind the parent of a subsurface"
 #define DOC_SURFACE_GETABSPARENT "get_abs_parent() -> Surface\nfind the top level parent of a subsurface"
 #define DOC_SURFACE_GETOFFSET "get_offset() -> (x, y)\nfind the position of a child subsurface inside a parent"
@@ -50,8 +58,47 @@
 #define DOC_SURFACE_GETBOUNDINGRECT "get_bounding_rect(min_alpha = 1) -> Rect\nfind the smallest rect containing data"
 #define DOC_SURFACE_GETVIEW "get_view(kind='2', /) -> BufferProxy\nreturn a buffer view of the Surface's pixels."
 #define DOC_SURFACE_GETBUFFER "get_buffer() -> BufferProxy\nacquires a buffer object for the pixels of the Surface."
+#define DOC_SURFACE_FROMBUFFER "from_buffer(buffer, size, pitch=0, masks=None, depth=32) -> Surface\ncreate a Surface that draws to the memory of a buffer object"
+#define DOC_SURFACE_FROMSHAREDMEMORY "from_shared_memory(name, size, format) -> Surface\ncreate a Surface whose pixels live in a shared memory block"
+#define DOC_SURFACE_TOSHAREDMEMORY "to_shared_memory(format=\"RGBA\") -> SharedMemory\ncopy the pixels into a new shared memory block"
 #define DOC_SURFACE_PIXELSADDRESS "_pixels_address -> int\npixel buffer address"
 #define DOC_SURFACE_PREMULALPHA "premul_alpha() -> Surface\nreturns a copy of the surface with the RGB channels pre-multiplied by the alpha channel."
+#define DOC_SURFACE_PREMULALPHAIP "premul_alpha_ip() -> Surface\npre-multiplies the RGB channels of the surface by its alpha channel in place."
+#define DOC_SURFACE_SETALPHASPANS "set_alpha_spans(enable, /) -> None\nenable or disable run-length encoding for blits from the surface"
+#define DOC_SURFACE_SETDIRTYTRACKING "set_dirty_tracking(enable, /) -> None\nenable or disable recording of changed areas"
+#define DOC_SURFACE_GETDIRTYRECTS "get_dirty_rects(clear=True) -> list[Rect]\nget the areas changed since they were last cleared"
+#define DOC_SURFACE_GETVERSION "get_version() -> int\nget a counter that increases whenever the Surface changes"
+#define DOC_SURFACE_SNAPSHOT "snapshot() -> SurfaceSnapshot\nremember the pixels so they can be restored later"
+#define DOC_SURFACE_RESTORE "restore(snapshot, /) -> None\nput back the pixels as they were at a snapshot"
 #define DOC_SURFACE_WIDTH "width -> int\nSurface width in pixels (read-only)"
 #define DOC_SURFACE_HEIGHT "height -> int\nSurface height in pixels (read-only)"
 #define DOC_SURFACE_SIZE "height -> tuple[int, int]\nSurface size in pixels (read-only)"
+#define DOC_SURFACE_PREMULTIPLIED "premultiplied -> bool\nwhether the colors are pre-multiplied by the alpha"
+#define DOC_BLITBATCH "BlitBatch(blit_sequence=()) -> BlitBatch\npygame object for storing a reusable sequence of blits"
+#define DOC_BLITBATCH_APPEND "append(source, dest, /) -> None\nadd a (source, dest) pair to the batch"
+#define DOC_BLITBATCH_EXTEND "extend(blit_sequence, /) -> None\nadd many (source, dest) pairs to the batch"
+#define DOC_BLITBATCH_CLEAR "clear() -> None\nremove all blits from the batch"
+#define DOC_SURFACESNAPSHOT "pygame object for a point in the undo history of a Surface"
+#define DOC_SURFACEVIEW "SurfaceView(surface, rect) -> SurfaceView\npygame object for blitting an area of a surface"
+#define DOC_SURFACEVIEW_SURFACE "surface -> Surface\nthe surface the view is an area of"
+#define DOC_SURFACEVIEW_RECT "rect -> Rect\nthe area of the surface"
+#define DOC_SURFACEVIEW_GETSIZE "get_size() -> (width, height)\nget the size of the view"
+#define DOC_SURFACEVIEW_SUBSURFACE "subsurface() -> Surface\ncreate a subsurface of the same area"
+#define DOC_BLENDMODE "BlendMode(src_factor, dst_factor, operation, alpha_src_factor=None, alpha_dst_factor=None, alpha_operation=None) -> BlendMode\npygame object for a custom blend equation"
+#define DOC_BLENDMODE_SRCFACTOR "src_factor -> int\nthe source factor of the colour equation"
+#define DOC_BLENDMODE_DSTFACTOR "dst_factor -> int\nthe destination factor of the colour equation"
+#define DOC_BLENDMODE_OPERATION "operation -> int\nthe operation of the colour equation"
+#define DOC_BLENDMODE_ALPHASRCFACTOR "alpha_src_factor -> int\nthe source factor of the alpha equation"
+#define DOC_BLENDMODE_ALPHADSTFACTOR "alpha_dst_factor -> int\nthe destination factor of the alpha equation"
+#define DOC_BLENDMODE_ALPHAOPERATION "alpha_operation -> int\nthe operation of the alpha equation"
+#define DOC_SURFACE_SETBLITTHREADS "set_blit_threads(num_threads, /) -> None\nset the number of threads used for large blits"
+#define DOC_SURFACE_GETBLITTHREADS "get_blit_threads() -> int\nget the number of threads used for large blits"
+#define DOC_SURFACE_SETBLITTRACE "set_blit_trace(enabled, /) -> None\nrecord which blit kernels run"
+#define DOC_SURFACE_GETBLITTRACE "get_blit_trace() -> list[dict[str, Any]]\nget the recorded blit kernels"
+#define DOC_SURFACE_SETCOPYONWRITE "set_copy_on_write(enabled, /) -> None\nshare the pixels of Surface copies until they are changed"
+#define DOC_SURFACE_GETCOPYONWRITE "get_copy_on_write() -> bool\ntell whether Surface copies share their pixels"
+#define DOC_SURFACE_SETPOOLLIMIT "set_pool_limit(max_bytes, /) -> None\nrecycle the surfaces of transform and font results"
+#define DOC_SURFACE_GETPOOLSTATS "get_pool_stats() -> dict[str, int]\nget the state of the surface pool"
+#define DOC_SURFACE_SETROWALIGNMENT "set_row_alignment(align, /) -> None\nalign the pixel rows of new surfaces"
+#define DOC_SURFACE_GETROWALIGNMENT "get_row_alignment() -> int\nget the row alignment of new surfaces"
+#define DOC_SURFACE_GETBOUNDINGRECTS "get_bounding_rects(surfaces, min_alpha=1, threads=0) -> list[Rect]\nfind the bounding rects of many surfaces at once"
@@ -5,3 +5,10 @@
 #define DOC_SYSTEM_GETPREFPATH "get_pref_path(org, app) -> path\nget a writeable folder for your app"
 #define DOC_SYSTEM_GETPREFLOCALES "get_pref_locales() -> list[locale]\nget preferred locales set on the system"
 #define DOC_SYSTEM_GETPOWERSTATE "get_pref_power_state() -> PowerState\nget the current power supply state"
+#define DOC_SYSTEM_GETFREELISTSTATS "get_freelist_stats() -> dict\nget statistics about the object free lists"
+#define DOC_SYSTEM_GETPERFCOUNTERS "get_perf_counters() -> dict\nget the counters of the hot paths of pygame"
+#define DOC_SYSTEM_RESETPERFCOUNTERS "reset_perf_counters() -> None\nset the counters of the hot paths back to zero"
+#define DOC_SYSTEM_SETSIMDLEVEL "set_simd_level(level, /) -> None\nlimit the SIMD kernels pygame picks at runtime"
+#define DOC_SYSTEM_GETSIMDDISPATCH "get_simd_dispatch() -> dict\nget the SIMD kernels each operation of pygame uses"
+#define DOC_SYSTEM_GETSURFACEMEMORY "get_surface_memory() -> dict\nget the pixel memory held by surfaces"
+#define DOC_SYSTEM_RESETSURFACEMEMORYPEAKS "reset_surface_memory_peaks() -> None\nset the high-water marks of the surface memory to the current values"
@@ -7,6 +7,8 @@
 #define DOC_TIME_CLOCK "Clock() -> Clock\ncreate an object to help track time"
 #define DOC_TIME_CLOCK_TICK "tick(framerate=0, /) -> milliseconds\nupdate the clock"
 #define DOC_TIME_CLOCK_TICKBUSYLOOP "tick_busy_loop(framerate=0, /) -> milliseconds\nupdate the clock"
+#define DOC_TIME_CLOCK_TICKPRECISE "tick_precise(framerate=0, /) -> float\nupdate the clock with sub-millisecond accuracy"
 #define DOC_TIME_CLOCK_GETTIME "get_time() -> milliseconds\ntime used in the previous tick"
 #define DOC_TIME_CLOCK_GETRAWTIME "get_rawtime() -> milliseconds\nactual time used in the previous tick"
 #define DOC_TIME_CLOCK_GETFPS "get_fps() -> float\ncompute the clock framerate"
+#define DOC_TIME_CLOCK_GETFRAMESTATS "get_frame_stats() -> dict\nframe time distribution of recent ticks"
@@ -1,22 +1,58 @@
 /* Auto generated file: with make_docs.py .  Docs go in docs/reST/ref/ . */
 #define DOC_TRANSFORM "pygame module to transform surfaces"
-#define DOC_TRANSFORM_FLIP "flip(surface, flip_x, flip_y) -> Surface\nflip vertically and horizontally"
+#define DOC_TRANSFORM_FLIP "flip(surface, flip_x, flip_y, dest_surface=None) -> Surface\nflip vertically and horizontally"
+#define DOC_TRANSFORM_FLIPIP "flip_ip(surface, flip_x, flip_y) -> None\nflip a surface in place"
 #define DOC_TRANSFORM_SCALE "scale(surface, size, dest_surface=None) -> Surface\nresize to new resolution"
 #define DOC_TRANSFORM_SCALEBY "scale_by(surface, factor, dest_surface=None) -> Surface\nresize to new resolution, using scalar(s)"
-#define DOC_TRANSFORM_ROTATE "rotate(surface, angle) -> Surface\nrotate an image"
-#define DOC_TRANSFORM_ROTOZOOM "rotozoom(surface, angle, scale) -> Surface\nfiltered scale and rotation"
+#define DOC_TRANSFORM_ROTATE "rotate(surface, angle, dest_surface=None) -> Surface\nrotate an image"
+#define DOC_TRANSFORM_ROTOZOOM "rotozoom(surface, angle, scale, dest_surface=None) -> Surface\nfiltered scale and rotation"
 #define DOC_TRANSFORM_SCALE2X "scale2x(surface, dest_surface=None) -> Surface\nspecialized image doubler"
-#define DOC_TRANSFORM_SMOOTHSCALE "smoothscale(surface, size, dest_surface=None) -> Surface\nscale a surface to an arbitrary size smoothly"
+#define DOC_TRANSFORM_SCALE3X "scale3x(surface, dest_surface=None) -> Surface\nspecialized image tripler"
+#define DOC_TRANSFORM_SCALE4X "scale4x(surface, dest_surface=None) -> Surface\nspecialized image quadrupler"
+#define DOC_TRANSFORM_SMOOTHSCALE "smoothscale(surface, size, dest_surface=None, pyramid=None) -> Surface\nscale a surface to an arbitrary size smoothly"
 #define DOC_TRANSFORM_SMOOTHSCALEBY "smoothscale_by(surface, factor, dest_surface=None) -> Surface\nresize to new resolution, using scalar(s)"
-#define DOC_TRANSFORM_GETSMOOTHSCALEBACKEND "get_smoothscale_backend() -> string\nreturn smoothscale filter version in use: 'GENERIC', 'MMX', 'SSE', 'SSE2', or 'NEON'"
-#define DOC_TRANSFORM_SETSMOOTHSCALEBACKEND "set_smoothscale_backend(backend) -> None\nset smoothscale filter version to one of: 'GENERIC', 'MMX', 'SSE', 'SSE2', or 'NEON'"
-#define DOC_TRANSFORM_CHOP "chop(surface, rect) -> Surface\ngets a copy of an image with an interior area removed"
+#define DOC_TRANSFORM_BUILDPYRAMID "build_pyramid(surface, levels) -> list\nbuild successively halved copies of a surface"
+#define DOC_TRANSFORM_GETSMOOTHSCALEBACKEND "get_smoothscale_backend() -> string\nreturn smoothscale filter version in use: 'GENERIC', 'MMX', 'SSE', 'SSE2', 'NEON', or 'AVX2'"
+#define DOC_TRANSFORM_SETSMOOTHSCALEBACKEND "set_smoothscale_backend(backend) -> None\nset smoothscale filter version to one of: 'GENERIC', 'MMX', 'SSE', 'SSE2', 'NEON', or 'AVX2'"
+#define DOC_TRANSFORM_SETSMOOTHSCALETHREADS "set_smoothscale_threads(num_threads, /) -> None\nset the number of threads used by smoothscale"
+#define DOC_TRANSFORM_GETSMOOTHSCALETHREADS "get_smoothscale_threads() -> int\nget the number of threads used by smoothscale"
+#define DOC_TRANSFORM_GETROTATEBACKEND "get_rotate_backend() -> string\nreturn the rotate and rotozoom implementation in use: 'GENERIC', 'SSE2', 'NEON', or 'AVX2'"
+#define DOC_TRANSFORM_SETROTATEBACKEND "set_rotate_backend(backend) -> None\nset the rotate and rotozoom implementation to one of: 'GENERIC', 'SSE2', 'NEON', or 'AVX2'"
+#define DOC_TRANSFORM_SETROTOZOOMTHREADS "set_rotozoom_threads(num_threads, /) -> None\nset the number of threads used by rotozoom"
+#define DOC_TRANSFORM_GETROTOZOOMTHREADS "get_rotozoom_threads() -> int\nget the number of threads used by rotozoom"
+#define DOC_TRANSFORM_ENABLECACHE "enable_cache(max_bytes) -> None\ncache the results of rotate and rotozoom"
+#define DOC_TRANSFORM_DISABLECACHE "disable_cache() -> None\nstop caching rotate and rotozoom results"
+#define DOC_TRANSFORM_CLEARCACHE "clear_cache() -> None\nforget all cached rotate and rotozoom results"
+#define DOC_TRANSFORM_GETCACHESTATS "get_cache_stats() -> dict\nreturn statistics of the rotate and rotozoom result cache"
+#define DOC_TRANSFORM_CHOP "chop(surface, rect, dest_surface=None) -> Surface\ngets a copy of an image with an interior area removed"
 #define DOC_TRANSFORM_LAPLACIAN "laplacian(surface, dest_surface=None) -> Surface\nfind edges in a surface"
 #define DOC_TRANSFORM_BOXBLUR "box_blur(surface, radius, repeat_edge_pixels=True, dest_surface=None) -> Surface\nblur a surface using box blur"
 #define DOC_TRANSFORM_GAUSSIANBLUR "gaussian_blur(surface, radius, repeat_edge_pixels=True, dest_surface=None) -> Surface\nblur a surface using gaussian blur"
+#define DOC_TRANSFORM_STACKBLUR "stack_blur(surface, radius, repeat_edge_pixels=True, dest_surface=None) -> Surface\nblur a surface using stack blur"
+#define DOC_TRANSFORM_CONVOLVE "convolve(surface, kernel, dest_surface=None) -> Surface\napply a small convolution kernel to a surface"
+#define DOC_TRANSFORM_SETBLURTHREADS "set_blur_threads(num_threads, /) -> None\nset the number of threads used by the blur functions"
+#define DOC_TRANSFORM_GETBLURTHREADS "get_blur_threads() -> int\nget the number of threads used by the blur functions"
 #define DOC_TRANSFORM_AVERAGESURFACES "average_surfaces(surfaces, dest_surface=None, palette_colors=1) -> Surface\nfind the average surface from many surfaces."
+#define DOC_TRANSFORM_ACCUMULATOR "Accumulator(size) -> Accumulator\npygame object for averaging many surfaces one at a time"
+#define DOC_TRANSFORM_ACCUMULATOR_ADD "add(surface, /) -> None\nadd a surface to the running sum"
+#define DOC_TRANSFORM_ACCUMULATOR_GETAVERAGE "get_average(dest_surface=None) -> Surface\nget the average of the surfaces added so far"
+#define DOC_TRANSFORM_ACCUMULATOR_CLEAR "clear() -> None\nforget all added surfaces"
+#define DOC_TRANSFORM_ACCUMULATOR_COUNT "count -> int\nnumber of surfaces added"
+#define DOC_TRANSFORM_ACCUMULATOR_SIZE "size -> (width, height)\nsize of the surfaces that can be added"
+#define DOC_TRANSFORM_LIGHTMAP "LightMap(size, ambient=(0, 0, 0)) -> LightMap\npygame object for lighting a scene with many lights in one pass"
+#define DOC_TRANSFORM_LIGHTMAP_ADD "add(light, dest, intensity=255, special_flags=0) -> None\nadd a light to the map"
+#define DOC_TRANSFORM_LIGHTMAP_APPLY "apply(surface, dest=(0, 0)) -> Rect\nmultiply a surface by the light"
+#define DOC_TRANSFORM_LIGHTMAP_CLEAR "clear(ambient=None) -> None\nreset the map to the ambient light"
+#define DOC_TRANSFORM_LIGHTMAP_AMBIENT "ambient -> (r, g, b)\nthe light of the map before any light is added"
+#define DOC_TRANSFORM_LIGHTMAP_SIZE "size -> (width, height)\nsize of the map"
 #define DOC_TRANSFORM_AVERAGECOLOR "average_color(surface, rect=None, consider_alpha=False) -> Color\nfinds the average color of a surface"
+#define DOC_TRANSFORM_SETAVERAGECOLORTHREADS "set_average_color_threads(num_threads, /) -> None\nset the number of threads used by average_color"
+#define DOC_TRANSFORM_GETAVERAGECOLORTHREADS "get_average_color_threads() -> int\nget the number of threads used by average_color"
 #define DOC_TRANSFORM_INVERT "invert(surface, dest_surface=None) -> Surface\ninverts the RGB elements of a surface"
+#define DOC_TRANSFORM_INVERTIP "invert_ip(surface) -> None\ninverts the RGB elements of a surface in place"
 #define DOC_TRANSFORM_GRAYSCALE "grayscale(surface, dest_surface=None) -> Surface\ngrayscale a surface"
+#define DOC_TRANSFORM_GRAYSCALEIP "grayscale_ip(surface) -> None\ngrayscale a surface in place"
 #define DOC_TRANSFORM_THRESHOLD "threshold(dest_surface, surface, search_color, threshold=(0,0,0,0), set_color=(0,0,0,0), set_behavior=1, search_surf=None, inverse_set=False) -> num_threshold_pixels\nfinds which, and how many pixels in a surface are within a threshold of a 'search_color' or a 'search_surf'."
 #define DOC_TRANSFORM_HSL "hsl(surface, hue, saturation, lightness, dest_surface=None) -> Surface\nChange the hue, saturation, and lightness of a surface."
+#define DOC_TRANSFORM_HSLIP "hsl_ip(surface, hue, saturation, lightness) -> None\nchange the hue, saturation, and lightness of a surface in place"
+#define DOC_TRANSFORM_COLORMATRIX "color_matrix(surface, matrix, dest_surface=None) -> Surface\napply a color matrix to every pixel of a surface"
@@ -19,6 +19,7 @@
 #define DOC_WINDOW_FROMDISPLAYMODULE "from_display_module() -> Window\nCreate a Window object using window data from display module"
 #define DOC_WINDOW_GETSURFACE "get_surface() -> Surface\nGet the window surface"
 #define DOC_WINDOW_FLIP "flip() -> None\nUpdate the display surface to the window."
+#define DOC_WINDOW_FLIPALL "flip_all(windows) -> None\nUpdate the display surfaces of several windows at once"
 #define DOC_WINDOW_SETWINDOWED "set_windowed() -> None\nEnable windowed mode (exit fullscreen)"
 #define DOC_WINDOW_SETFULLSCREEN "set_fullscreen(desktop=False) -> None\nEnter fullscreen"
 #define DOC_WINDOW_DESTROY "destroy() -> None\nDestroy the window"
@@ -27,8 +27,12 @@
 
 #include "pgcompat.h"
 
+#include "pgarg.h"
+
 #include "doc/draw_doc.h"
 
+#include "simd_fill.h"
+
 #include <math.h>
 
 #include <float.h>
@@ -37,6 +41,13 @@
 #define M_PI 3.14159265358979323846
 #endif
 
+/* Joints between the segments of wide antialiased lines */
+#define PG_JOINT_MITER 0
+#define PG_JOINT_ROUND 1
+#define PG_JOINT_BEVEL 2
+/* Most points of a round joint */
+#define PG_AAJOINT_MAX_POINTS 128
+
 /* Declaration of drawing algorithms */
 static void
 draw_line_width(SDL_Surface *surf, Uint32 color, int x1, int y1, int x2,
@@ -69,6 +80,12 @@ static void
 draw_circle_filled(SDL_Surface *surf, int x0, int y0, int radius, Uint32 color,
                    int *drawn_area);
 static void
+draw_circle_width(SDL_Surface *surf, int x0, int y0, int radius, int width,
+                  Uint32 color, int *drawn_area);
+static void
+draw_aacircle_width(SDL_Surface *surf, int x0, int y0, int radius, int width,
+                    Uint32 color, int *drawn_area);
+static void
 draw_circle_quadrant(SDL_Surface *surf, int x0, int y0, int radius,
                      int thickness, Uint32 color, int top_right, int top_left,
                      int bottom_left, int bottom_right, int *drawn_area);
@@ -82,6 +99,14 @@ draw_ellipse_thickness(SDL_Surface *surf, int x0, int y0, int width,
 static void
 draw_fillpoly(SDL_Surface *surf, int *vx, int *vy, Py_ssize_t n, Uint32 color,
               int *drawn_area);
+static void
+draw_aapolygon_filled(SDL_Surface *surf, const float *point_x,
+                      const float *point_y, Py_ssize_t num_points,
+                      Uint32 color, int *drawn_area);
+static void
+draw_aalines_width(SDL_Surface *surf, Uint32 color, const float *point_x,
+                   const float *point_y, Py_ssize_t num_points, int closed,
+                   float width, int joint, int *drawn_area);
 static int
 draw_filltri(SDL_Surface *surf, int *xlist, int *ylist, Uint32 color,
              int *drawn_area);
@@ -100,6 +125,55 @@ draw_round_rect(SDL_Surface *surf, int x1, int y1, int x2, int y2, int radius,
         return NULL;                                             \
     }
 
+/* Records the drawn area in the dirty rect tracker of the surface, if it
+ * has one. drawn_area holds the bounds of the drawn pixels as
+ * {min x, min y, max x, max y}. */
+static void
+_mark_drawn_area(pgSurfaceObject *surfobj, int *drawn_area)
+{
+    if (drawn_area[0] != INT_MAX && drawn_area[1] != INT_MAX &&
+        drawn_area[2] != INT_MIN && drawn_area[3] != INT_MIN) {
+        SDL_Rect rect = {drawn_area[0], drawn_area[1],
+                         drawn_area[2] - drawn_area[0] + 1,
+                         drawn_area[3] - drawn_area[1] + 1};
+        pgSurface_AddDirtyRect(surfobj, &rect);
+    }
+}
+
+/* Parses the arguments of a METH_FASTCALL | METH_KEYWORDS draw function
+ * taking a Surface, nobjs - 1 more required objects and then optional ints.
+ * objs receives the required objects, the surface first. ints points at the
+ * variables holding the defaults of the optional ints.
+ * Returns 0 with an exception set on failure. */
+static int
+_draw_fastcall_args(const char *fname, PyObject *const *args,
+                    Py_ssize_t nargs, PyObject *kwnames, char *const *keywords,
+                    Py_ssize_t nobjs, PyObject **objs, int *const *ints)
+{
+    PyObject *parsed[PG_FASTCALL_MAX_ARGS] = {NULL};
+    Py_ssize_t i;
+
+    if (!pg_ParseFastcallArgs(fname, args, nargs, kwnames, keywords, nobjs,
+                              parsed)) {
+        return 0;
+    }
+    if (!PyObject_TypeCheck(parsed[0], &pgSurface_Type)) {
+        PyErr_Format(PyExc_TypeError,
+                     "%s() argument 1 must be pygame.surface.Surface, not %s",
+                     fname, Py_TYPE(parsed[0])->tp_name);
+        return 0;
+    }
+    for (i = 0; i < nobjs; i++) {
+        objs[i] = parsed[i];
+    }
+    for (i = nobjs; keywords[i]; i++) {
+        if (parsed[i] && !pg_IntFromFastcallArg(parsed[i], ints[i - nobjs])) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
 /* Definition of functions that get called in Python */
 
 /* Draws an antialiased line on the given surface.
@@ -112,17 +186,20 @@ aaline(PyObject *self, PyObject *arg, PyObject *kwargs)
     pgSurfaceObject *surfobj;
     PyObject *colorobj, *start, *end;
     SDL_Surface *surf = NULL;
+    pg_NoGIL nogil;
     float startx, starty, endx, endy;
+    float xlist[2], ylist[2];
     PyObject *blend = NULL;
+    int width = 1; /* Default width. */
     int drawn_area[4] = {INT_MAX, INT_MAX, INT_MIN,
                          INT_MIN}; /* Used to store bounding box values */
     Uint32 color;
-    static char *keywords[] = {"surface", "color", "start_pos",
-                               "end_pos", "blend", NULL};
+    static char *keywords[] = {"surface", "color", "start_pos", "end_pos",
+                               "blend",   "width", NULL};
 
-    if (!PyArg_ParseTupleAndKeywords(arg, kwargs, "O!OOO|O", keywords,
+    if (!PyArg_ParseTupleAndKeywords(arg, kwargs, "O!OOO|O$i", keywords,
                                      &pgSurface_Type, &surfobj, &colorobj,
-                                     &start, &end, &blend)) {
+                                     &start, &end, &blend, &width)) {
         return NULL; /* Exception already set. */
     }
 
@@ -155,15 +232,36 @@ aaline(PyObject *self, PyObject *arg, PyObject *kwargs)
         return RAISE(PyExc_TypeError, "invalid end_pos argument");
     }
 
+    if (width < 1) {
+        return pgRect_New4((int)startx, (int)starty, 0, 0);
+    }
+
     if (!pgSurface_Lock(surfobj)) {
         return RAISE(PyExc_RuntimeError, "error locking surface");
     }
 
-    draw_aaline(surf, color, startx, starty, endx, endy, drawn_area);
+    if (width == 1) {
+        pg_nogil_begin(&nogil, surfobj, NULL);
+        draw_aaline(surf, color, startx, starty, endx, endy, drawn_area);
+        pg_nogil_end(&nogil);
+    }
+    else {
+        xlist[0] = startx;
+        ylist[0] = starty;
+        xlist[1] = endx;
+        ylist[1] = endy;
+        draw_aalines_width(surf, color, xlist, ylist, 2, 0, (float)width,
+                           PG_JOINT_MITER, drawn_area);
+    }
 
     if (!pgSurface_Unlock(surfobj)) {
         return RAISE(PyExc_RuntimeError, "error unlocking surface");
     }
+    if (PyErr_Occurred()) {
+        return NULL;
+    }
+
+    _mark_drawn_area(surfobj, drawn_area);
 
     if (drawn_area[0] != INT_MAX && drawn_area[1] != INT_MAX &&
         drawn_area[2] != INT_MIN && drawn_area[3] != INT_MIN)
@@ -179,11 +277,14 @@ aaline(PyObject *self, PyObject *arg, PyObject *kwargs)
  * Returns a Rect bounding the drawn area.
  */
 static PyObject *
-line(PyObject *self, PyObject *arg, PyObject *kwargs)
+line(PyObject *self, PyObject *const *args, Py_ssize_t nargs,
+     PyObject *kwnames)
 {
     pgSurfaceObject *surfobj;
     PyObject *colorobj, *start, *end;
+    PyObject *objs[4];
     SDL_Surface *surf = NULL;
+    pg_NoGIL nogil;
     int startx, starty, endx, endy;
     Uint32 color;
     int width = 1; /* Default width. */
@@ -191,12 +292,16 @@ line(PyObject *self, PyObject *arg, PyObject *kwargs)
                          INT_MIN}; /* Used to store bounding box values */
     static char *keywords[] = {"surface", "color", "start_pos",
                                "end_pos", "width", NULL};
+    int *ints[] = {&width};
 
-    if (!PyArg_ParseTupleAndKeywords(arg, kwargs, "O!OOO|i", keywords,
-                                     &pgSurface_Type, &surfobj, &colorobj,
-                                     &start, &end, &width)) {
+    if (!_draw_fastcall_args("line", args, nargs, kwnames, keywords, 4, objs,
+                             ints)) {
         return NULL; /* Exception already set. */
     }
+    surfobj = (pgSurfaceObject *)objs[0];
+    colorobj = objs[1];
+    start = objs[2];
+    end = objs[3];
 
     surf = pgSurface_AsSurface(surfobj);
     SURF_INIT_CHECK(surf)
@@ -209,11 +314,11 @@ line(PyObject *self, PyObject *arg, PyObject *kwargs)
 
     CHECK_LOAD_COLOR(colorobj)
 
-    if (!pg_TwoIntsFromObj(start, &startx, &starty)) {
+    if (!pg_TwoIntsFromFastObj(start, &startx, &starty)) {
         return RAISE(PyExc_TypeError, "invalid start_pos argument");
     }
 
-    if (!pg_TwoIntsFromObj(end, &endx, &endy)) {
+    if (!pg_TwoIntsFromFastObj(end, &endx, &endy)) {
         return RAISE(PyExc_TypeError, "invalid end_pos argument");
     }
 
@@ -225,13 +330,17 @@ line(PyObject *self, PyObject *arg, PyObject *kwargs)
         return RAISE(PyExc_RuntimeError, "error locking surface");
     }
 
+    pg_nogil_begin(&nogil, surfobj, NULL);
     draw_line_width(surf, color, startx, starty, endx, endy, width,
                     drawn_area);
+    pg_nogil_end(&nogil);
 
     if (!pgSurface_Unlock(surfobj)) {
         return RAISE(PyExc_RuntimeError, "error unlocking surface");
     }
 
+    _mark_drawn_area(surfobj, drawn_area);
+
     /* Compute return rect. */
     if (drawn_area[0] != INT_MAX && drawn_area[1] != INT_MAX &&
         drawn_area[2] != INT_MIN && drawn_area[3] != INT_MIN)
@@ -261,17 +370,34 @@ aalines(PyObject *self, PyObject *arg, PyObject *kwargs)
     PyObject *blend = NULL;
     int drawn_area[4] = {INT_MAX, INT_MAX, INT_MIN,
                          INT_MIN}; /* Used to store bounding box values */
-    int result, closed;
+    int result, closed, joint;
+    int width = 1; /* Default width. */
+    const char *joint_name = "miter";
     Py_ssize_t loop, length;
-    static char *keywords[] = {"surface", "color", "closed",
-                               "points",  "blend", NULL};
+    static char *keywords[] = {"surface", "color", "closed", "points",
+                               "blend",   "width", "joint",  NULL};
 
-    if (!PyArg_ParseTupleAndKeywords(arg, kwargs, "O!OpO|O", keywords,
+    if (!PyArg_ParseTupleAndKeywords(arg, kwargs, "O!OpO|O$is", keywords,
                                      &pgSurface_Type, &surfobj, &colorobj,
-                                     &closed, &points, &blend)) {
+                                     &closed, &points, &blend, &width,
+                                     &joint_name)) {
         return NULL; /* Exception already set. */
     }
 
+    if (!strcmp(joint_name, "miter")) {
+        joint = PG_JOINT_MITER;
+    }
+    else if (!strcmp(joint_name, "round")) {
+        joint = PG_JOINT_ROUND;
+    }
+    else if (!strcmp(joint_name, "bevel")) {
+        joint = PG_JOINT_BEVEL;
+    }
+    else {
+        return RAISE(PyExc_ValueError,
+                     "joint must be 'miter', 'round' or 'bevel'");
+    }
+
     if (blend != NULL) {
         if (PyErr_WarnEx(
                 PyExc_DeprecationWarning,
@@ -338,25 +464,39 @@ aalines(PyObject *self, PyObject *arg, PyObject *kwargs)
         ylist[loop] = y;
     }
 
+    if (width < 1) {
+        PyMem_Free(xlist);
+        PyMem_Free(ylist);
+        return pgRect_New4(l, t, 0, 0);
+    }
+
     if (!pgSurface_Lock(surfobj)) {
         PyMem_Free(xlist);
         PyMem_Free(ylist);
         return RAISE(PyExc_RuntimeError, "error locking surface");
     }
 
-    for (loop = 1; loop < length; ++loop) {
-        pts[0] = xlist[loop - 1];
-        pts[1] = ylist[loop - 1];
-        pts[2] = xlist[loop];
-        pts[3] = ylist[loop];
-        draw_aaline(surf, color, pts[0], pts[1], pts[2], pts[3], drawn_area);
+    if (width > 1) {
+        draw_aalines_width(surf, color, xlist, ylist, length, closed,
+                           (float)width, joint, drawn_area);
     }
-    if (closed && length > 2) {
-        pts[0] = xlist[length - 1];
-        pts[1] = ylist[length - 1];
-        pts[2] = xlist[0];
-        pts[3] = ylist[0];
-        draw_aaline(surf, color, pts[0], pts[1], pts[2], pts[3], drawn_area);
+    else {
+        for (loop = 1; loop < length; ++loop) {
+            pts[0] = xlist[loop - 1];
+            pts[1] = ylist[loop - 1];
+            pts[2] = xlist[loop];
+            pts[3] = ylist[loop];
+            draw_aaline(surf, color, pts[0], pts[1], pts[2], pts[3],
+                        drawn_area);
+        }
+        if (closed && length > 2) {
+            pts[0] = xlist[length - 1];
+            pts[1] = ylist[length - 1];
+            pts[2] = xlist[0];
+            pts[3] = ylist[0];
+            draw_aaline(surf, color, pts[0], pts[1], pts[2], pts[3],
+                        drawn_area);
+        }
     }
 
     PyMem_Free(xlist);
@@ -365,6 +505,11 @@ aalines(PyObject *self, PyObject *arg, PyObject *kwargs)
     if (!pgSurface_Unlock(surfobj)) {
         return RAISE(PyExc_RuntimeError, "error unlocking surface");
     }
+    if (PyErr_Occurred()) {
+        return NULL;
+    }
+
+    _mark_drawn_area(surfobj, drawn_area);
 
     /* Compute return rect. */
     if (drawn_area[0] != INT_MAX && drawn_area[1] != INT_MAX &&
@@ -387,6 +532,7 @@ lines(PyObject *self, PyObject *arg, PyObject *kwargs)
     PyObject *colorobj;
     PyObject *points, *item = NULL;
     SDL_Surface *surf = NULL;
+    pg_NoGIL nogil;
     Uint32 color;
     int x, y, closed, result;
     int *xlist = NULL, *ylist = NULL;
@@ -470,6 +616,7 @@ lines(PyObject *self, PyObject *arg, PyObject *kwargs)
         return RAISE(PyExc_RuntimeError, "error locking surface");
     }
 
+    pg_nogil_begin(&nogil, surfobj, NULL);
     for (loop = 1; loop < length; ++loop) {
         draw_line_width(surf, color, xlist[loop - 1], ylist[loop - 1],
                         xlist[loop], ylist[loop], width, drawn_area);
@@ -479,6 +626,7 @@ lines(PyObject *self, PyObject *arg, PyObject *kwargs)
         draw_line_width(surf, color, xlist[length - 1], ylist[length - 1],
                         xlist[0], ylist[0], width, drawn_area);
     }
+    pg_nogil_end(&nogil);
 
     PyMem_Free(xlist);
     PyMem_Free(ylist);
@@ -487,6 +635,8 @@ lines(PyObject *self, PyObject *arg, PyObject *kwargs)
         return RAISE(PyExc_RuntimeError, "error unlocking surface");
     }
 
+    _mark_drawn_area(surfobj, drawn_area);
+
     /* Compute return rect. */
     if (drawn_area[0] != INT_MAX && drawn_area[1] != INT_MAX &&
         drawn_area[2] != INT_MIN && drawn_area[3] != INT_MIN)
@@ -504,6 +654,7 @@ arc(PyObject *self, PyObject *arg, PyObject *kwargs)
     PyObject *colorobj, *rectobj;
     SDL_Rect *rect = NULL, temp;
     SDL_Surface *surf = NULL;
+    pg_NoGIL nogil;
     Uint32 color;
     int width = 1; /* Default width. */
     int drawn_area[4] = {INT_MAX, INT_MAX, INT_MIN,
@@ -554,13 +705,17 @@ arc(PyObject *self, PyObject *arg, PyObject *kwargs)
 
     width = MIN(width, MIN(rect->w, rect->h) / 2);
 
+    pg_nogil_begin(&nogil, surfobj, NULL);
     draw_arc(surf, rect->x + rect->w / 2, rect->y + rect->h / 2, rect->w / 2,
              rect->h / 2, width, angle_start, angle_stop, color, drawn_area);
+    pg_nogil_end(&nogil);
 
     if (!pgSurface_Unlock(surfobj)) {
         return RAISE(PyExc_RuntimeError, "error unlocking surface");
     }
 
+    _mark_drawn_area(surfobj, drawn_area);
+
     /* Compute return rect. */
     if (drawn_area[0] != INT_MAX && drawn_area[1] != INT_MAX &&
         drawn_area[2] != INT_MIN && drawn_area[3] != INT_MIN)
@@ -578,6 +733,7 @@ ellipse(PyObject *self, PyObject *arg, PyObject *kwargs)
     PyObject *colorobj, *rectobj;
     SDL_Rect *rect = NULL, temp;
     SDL_Surface *surf = NULL;
+    pg_NoGIL nogil;
     Uint32 color;
     int width = 0; /* Default width. */
     int drawn_area[4] = {INT_MAX, INT_MAX, INT_MIN,
@@ -615,6 +771,7 @@ ellipse(PyObject *self, PyObject *arg, PyObject *kwargs)
         return RAISE(PyExc_RuntimeError, "error locking surface");
     }
 
+    pg_nogil_begin(&nogil, surfobj, NULL);
     if (!width ||
         width >= MIN(rect->w / 2 + rect->w % 2, rect->h / 2 + rect->h % 2)) {
         draw_ellipse_filled(surf, rect->x, rect->y, rect->w, rect->h, color,
@@ -624,11 +781,14 @@ ellipse(PyObject *self, PyObject *arg, PyObject *kwargs)
         draw_ellipse_thickness(surf, rect->x, rect->y, rect->w, rect->h,
                                width - 1, color, drawn_area);
     }
+    pg_nogil_end(&nogil);
 
     if (!pgSurface_Unlock(surfobj)) {
         return RAISE(PyExc_RuntimeError, "error unlocking surface");
     }
 
+    _mark_drawn_area(surfobj, drawn_area);
+
     if (drawn_area[0] != INT_MAX && drawn_area[1] != INT_MAX &&
         drawn_area[2] != INT_MIN && drawn_area[3] != INT_MIN)
         return pgRect_New4(drawn_area[0], drawn_area[1],
@@ -639,11 +799,14 @@ ellipse(PyObject *self, PyObject *arg, PyObject *kwargs)
 }
 
 static PyObject *
-circle(PyObject *self, PyObject *args, PyObject *kwargs)
+circle(PyObject *self, PyObject *const *args, Py_ssize_t nargs,
+       PyObject *kwnames)
 {
     pgSurfaceObject *surfobj;
     PyObject *colorobj;
+    PyObject *objs[4];
     SDL_Surface *surf = NULL;
+    pg_NoGIL nogil;
     Uint32 color;
     SDL_Rect cliprect;
     PyObject *posobj, *radiusobj;
@@ -663,13 +826,18 @@ circle(PyObject *self, PyObject *args, PyObject *kwargs)
                                "draw_bottom_right",
                                NULL};
 
-    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "O!OOO|iiiii", keywords,
-                                     &pgSurface_Type, &surfobj, &colorobj,
-                                     &posobj, &radiusobj, &width, &top_right,
-                                     &top_left, &bottom_left, &bottom_right))
+    int *ints[] = {&width, &top_right, &top_left, &bottom_left,
+                   &bottom_right};
+
+    if (!_draw_fastcall_args("circle", args, nargs, kwnames, keywords, 4,
+                             objs, ints))
         return NULL; /* Exception already set. */
+    surfobj = (pgSurfaceObject *)objs[0];
+    colorobj = objs[1];
+    posobj = objs[2];
+    radiusobj = objs[3];
 
-    if (!pg_TwoIntsFromObj(posobj, &posx, &posy)) {
+    if (!pg_TwoIntsFromFastObj(posobj, &posx, &posy)) {
         PyErr_SetString(PyExc_TypeError,
                         "center argument must be a pair of numbers");
         return 0;
@@ -712,28 +880,23 @@ circle(PyObject *self, PyObject *args, PyObject *kwargs)
         return RAISE(PyExc_RuntimeError, "error locking surface");
     }
 
+    pg_nogil_begin(&nogil, surfobj, NULL);
     if ((top_right == 0 && top_left == 0 && bottom_left == 0 &&
          bottom_right == 0)) {
-        if (!width || width == radius) {
-            draw_circle_filled(surf, posx, posy, radius, color, drawn_area);
-        }
-        else if (width == 1) {
-            draw_circle_bresenham_thin(surf, posx, posy, radius, color,
-                                       drawn_area);
-        }
-        else {
-            draw_circle_bresenham(surf, posx, posy, radius, width, color,
-                                  drawn_area);
-        }
+        draw_circle_width(surf, posx, posy, radius, width, color,
+                          drawn_area);
     }
     else {
         draw_circle_quadrant(surf, posx, posy, radius, width, color, top_right,
                              top_left, bottom_left, bottom_right, drawn_area);
     }
+    pg_nogil_end(&nogil);
 
     if (!pgSurface_Unlock(surfobj)) {
         return RAISE(PyExc_RuntimeError, "error unlocking surface");
     }
+    _mark_drawn_area(surfobj, drawn_area);
+
     if (drawn_area[0] != INT_MAX && drawn_area[1] != INT_MAX &&
         drawn_area[2] != INT_MIN && drawn_area[3] != INT_MIN)
         return pgRect_New4(drawn_area[0], drawn_area[1],
@@ -744,11 +907,14 @@ circle(PyObject *self, PyObject *args, PyObject *kwargs)
 }
 
 static PyObject *
-aacircle(PyObject *self, PyObject *args, PyObject *kwargs)
+aacircle(PyObject *self, PyObject *const *args, Py_ssize_t nargs,
+         PyObject *kwnames)
 {
     pgSurfaceObject *surfobj;
     PyObject *colorobj;
+    PyObject *objs[4];
     SDL_Surface *surf = NULL;
+    pg_NoGIL nogil;
     Uint32 color;
     SDL_Rect cliprect;
     PyObject *posobj, *radiusobj;
@@ -768,13 +934,18 @@ aacircle(PyObject *self, PyObject *args, PyObject *kwargs)
                                "draw_bottom_right",
                                NULL};
 
-    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "O!OOO|iiiii", keywords,
-                                     &pgSurface_Type, &surfobj, &colorobj,
-                                     &posobj, &radiusobj, &width, &top_right,
-                                     &top_left, &bottom_left, &bottom_right))
+    int *ints[] = {&width, &top_right, &top_left, &bottom_left,
+                   &bottom_right};
+
+    if (!_draw_fastcall_args("aacircle", args, nargs, kwnames, keywords, 4,
+                             objs, ints))
         return NULL; /* Exception already set. */
+    surfobj = (pgSurfaceObject *)objs[0];
+    colorobj = objs[1];
+    posobj = objs[2];
+    radiusobj = objs[3];
 
-    if (!pg_TwoIntsFromObj(posobj, &posx, &posy)) {
+    if (!pg_TwoIntsFromFastObj(posobj, &posx, &posy)) {
         return RAISE(PyExc_TypeError,
                      "center argument must be a pair of numbers");
     }
@@ -815,22 +986,11 @@ aacircle(PyObject *self, PyObject *args, PyObject *kwargs)
         return RAISE(PyExc_RuntimeError, "error locking surface");
     }
 
+    pg_nogil_begin(&nogil, surfobj, NULL);
     if ((top_right == 0 && top_left == 0 && bottom_left == 0 &&
          bottom_right == 0)) {
-        if (!width || width == radius) {
-            draw_circle_filled(surf, posx, posy, radius - 1, color,
-                               drawn_area);
-            draw_circle_xaolinwu(surf, posx, posy, radius, 2, color, 1, 1, 1,
-                                 1, drawn_area);
-        }
-        else if (width == 1) {
-            draw_circle_xaolinwu_thin(surf, posx, posy, radius, color, 1, 1, 1,
-                                      1, drawn_area);
-        }
-        else {
-            draw_circle_xaolinwu(surf, posx, posy, radius, width, color, 1, 1,
-                                 1, 1, drawn_area);
-        }
+        draw_aacircle_width(surf, posx, posy, radius, width, color,
+                            drawn_area);
     }
     else {
         if (!width || width == radius) {
@@ -849,10 +1009,13 @@ aacircle(PyObject *self, PyObject *args, PyObject *kwargs)
                                  bottom_right, drawn_area);
         }
     }
+    pg_nogil_end(&nogil);
 
     if (!pgSurface_Unlock(surfobj)) {
         return RAISE(PyExc_RuntimeError, "error unlocking surface");
     }
+    _mark_drawn_area(surfobj, drawn_area);
+
     if (drawn_area[0] != INT_MAX && drawn_area[1] != INT_MAX &&
         drawn_area[2] != INT_MIN && drawn_area[3] != INT_MIN)
         return pgRect_New4(drawn_area[0], drawn_area[1],
@@ -862,6 +1025,166 @@ aacircle(PyObject *self, PyObject *args, PyObject *kwargs)
         return pgRect_New4(posx, posy, 0, 0);
 }
 
+/* Cache of the circle_stamp() surfaces, by radius, width, aa and color.
+ * When the cached stamps hold more than PG_STAMP_CACHE_PIXELS pixels, the
+ * least recently used ones are dropped. Dicts keep their insertion order,
+ * so a stamp is moved to the end whenever it is used. */
+#define PG_STAMP_CACHE_PIXELS (1 << 22)
+static PyObject *stamp_cache = NULL;
+static Py_ssize_t stamp_cache_pixels = 0;
+static pg_mutex stamp_cache_lock; /* held by the two functions below */
+
+/* Returns a new reference to the stamp of key, moved to the end as the most
+ * recently used, or NULL, with an exception set on error. */
+static PyObject *
+_stamp_cache_get(PyObject *key)
+{
+    PyObject *stampobj;
+
+    if (!stamp_cache && !(stamp_cache = PyDict_New())) {
+        return NULL;
+    }
+    stampobj = PyDict_GetItemWithError(stamp_cache, key);
+    if (stampobj) {
+        Py_INCREF(stampobj);
+        if (PyDict_DelItem(stamp_cache, key) ||
+            PyDict_SetItem(stamp_cache, key, stampobj)) {
+            Py_CLEAR(stampobj);
+        }
+    }
+    return stampobj;
+}
+
+/* Adds stampobj to the cache, dropping old stamps to make room. Returns -1
+ * with an exception set on error. */
+static int
+_stamp_cache_add(PyObject *key, PyObject *stampobj, Py_ssize_t pixels)
+{
+    PyObject *old_key, *old_stamp;
+    SDL_Surface *old;
+    Py_ssize_t pos;
+
+    if (pixels > PG_STAMP_CACHE_PIXELS) {
+        return 0; /* too large to keep around */
+    }
+    switch (PyDict_Contains(stamp_cache, key)) {
+        case -1:
+            return -1;
+        case 1:
+            return 0; /* another thread drew it meanwhile */
+    }
+    while (stamp_cache_pixels + pixels > PG_STAMP_CACHE_PIXELS &&
+           PyDict_Size(stamp_cache) > 0) {
+        pos = 0;
+        PyDict_Next(stamp_cache, &pos, &old_key, &old_stamp);
+        old = pgSurface_AsSurface(old_stamp);
+        stamp_cache_pixels -= (Py_ssize_t)old->w * old->h;
+        Py_INCREF(old_key);
+        if (PyDict_DelItem(stamp_cache, old_key)) {
+            Py_DECREF(old_key);
+            return -1;
+        }
+        Py_DECREF(old_key);
+    }
+    if (PyDict_SetItem(stamp_cache, key, stampobj)) {
+        return -1;
+    }
+    stamp_cache_pixels += pixels;
+    return 0;
+}
+
+/* Returns a cached surface with a circle drawn on it, to be blitted with
+ * its center at the center of the circle.
+ */
+static PyObject *
+circle_stamp(PyObject *self, PyObject *arg, PyObject *kwargs)
+{
+    PyObject *colorobj, *key, *stampobj;
+    SDL_Surface *stamp;
+    Uint8 rgba[4];
+    Uint32 color;
+    int radius, size;
+    int width = 0, aa = 0; /* Default values. */
+    int drawn_area[4] = {INT_MAX, INT_MAX, INT_MIN,
+                         INT_MIN}; /* Used to store bounding box values */
+    static char *keywords[] = {"radius", "color", "width", "aa", NULL};
+
+    if (!PyArg_ParseTupleAndKeywords(arg, kwargs, "iO|ip", keywords, &radius,
+                                     &colorobj, &width, &aa)) {
+        return NULL; /* Exception already set. */
+    }
+
+    if (!pg_RGBAFromObjEx(colorobj, rgba, PG_COLOR_HANDLE_ALL)) {
+        return NULL; /* Exception already set. */
+    }
+
+    if (radius < 1) {
+        return RAISE(PyExc_ValueError, "radius must be positive");
+    }
+    if (radius > INT_MAX / 4) {
+        return RAISE(PyExc_ValueError, "radius is too large");
+    }
+    if (width < 0) {
+        return RAISE(PyExc_ValueError, "width must not be negative");
+    }
+    if (width > radius) {
+        width = radius;
+    }
+
+    key = Py_BuildValue("(iiiBBBB)", radius, width, aa, rgba[0], rgba[1],
+                        rgba[2], rgba[3]);
+    if (!key) {
+        return NULL;
+    }
+
+    pg_mutex_lock(&stamp_cache_lock);
+    stampobj = _stamp_cache_get(key);
+    pg_mutex_unlock(&stamp_cache_lock);
+    if (stampobj) {
+        Py_DECREF(key);
+        return stampobj;
+    }
+    if (PyErr_Occurred()) {
+        Py_DECREF(key);
+        return NULL;
+    }
+
+    size = 2 * radius + 2;
+    stamp = PG_CreateSurface(size, size, SDL_PIXELFORMAT_ARGB8888);
+    if (!stamp) {
+        Py_DECREF(key);
+        return RAISE(pgExc_SDLError, SDL_GetError());
+    }
+    /* Transparent pixels of the drawing color, so that antialiasing only
+     * fades the alpha of the edges. */
+    SDL_FillRect(stamp, NULL,
+                 SDL_MapRGBA(stamp->format, rgba[0], rgba[1], rgba[2], 0));
+    color = SDL_MapRGBA(stamp->format, rgba[0], rgba[1], rgba[2], rgba[3]);
+
+    if (aa) {
+        draw_aacircle_width(stamp, radius + 1, radius + 1, radius, width,
+                            color, drawn_area);
+    }
+    else {
+        draw_circle_width(stamp, radius + 1, radius + 1, radius, width, color,
+                          drawn_area);
+    }
+
+    stampobj = (PyObject *)pgSurface_New(stamp);
+    if (!stampobj) {
+        SDL_FreeSurface(stamp);
+        Py_DECREF(key);
+        return NULL;
+    }
+    pg_mutex_lock(&stamp_cache_lock);
+    if (_stamp_cache_add(key, stampobj, (Py_ssize_t)size * size)) {
+        Py_CLEAR(stampobj);
+    }
+    pg_mutex_unlock(&stamp_cache_lock);
+    Py_DECREF(key);
+    return stampobj;
+}
+
 static PyObject *
 polygon(PyObject *self, PyObject *arg, PyObject *kwargs)
 {
@@ -972,6 +1295,129 @@ polygon(PyObject *self, PyObject *arg, PyObject *kwargs)
         return RAISE(PyExc_RuntimeError, "error unlocking surface");
     }
 
+    _mark_drawn_area(surfobj, drawn_area);
+
+    if (drawn_area[0] != INT_MAX && drawn_area[1] != INT_MAX &&
+        drawn_area[2] != INT_MIN && drawn_area[3] != INT_MIN)
+        return pgRect_New4(drawn_area[0], drawn_area[1],
+                           drawn_area[2] - drawn_area[0] + 1,
+                           drawn_area[3] - drawn_area[1] + 1);
+    else
+        return pgRect_New4(l, t, 0, 0);
+}
+
+/* Draws an antialiased polygon on the given surface, filled or as an
+ * outline.
+ *
+ * Returns a Rect bounding the drawn area.
+ */
+static PyObject *
+aapolygon(PyObject *self, PyObject *arg, PyObject *kwargs)
+{
+    pgSurfaceObject *surfobj;
+    PyObject *colorobj, *points, *item;
+    SDL_Surface *surf = NULL;
+    Uint32 color;
+    float *xlist, *ylist;
+    float x, y;
+    int l = 0, t = 0, result, filled = 1;
+    int drawn_area[4] = {INT_MAX, INT_MAX, INT_MIN,
+                         INT_MIN}; /* Used to store bounding box values */
+    Py_ssize_t loop, length;
+    static char *keywords[] = {"surface", "color", "points", "filled", NULL};
+
+    if (!PyArg_ParseTupleAndKeywords(arg, kwargs, "O!OO|p", keywords,
+                                     &pgSurface_Type, &surfobj, &colorobj,
+                                     &points, &filled)) {
+        return NULL; /* Exception already set. */
+    }
+
+    surf = pgSurface_AsSurface(surfobj);
+    SURF_INIT_CHECK(surf)
+
+    if (PG_SURF_BytesPerPixel(surf) <= 0 || PG_SURF_BytesPerPixel(surf) > 4) {
+        return PyErr_Format(PyExc_ValueError,
+                            "unsupported surface bit depth (%d) for drawing",
+                            PG_SURF_BytesPerPixel(surf));
+    }
+
+    CHECK_LOAD_COLOR(colorobj)
+
+    if (!PySequence_Check(points)) {
+        return RAISE(PyExc_TypeError,
+                     "points argument must be a sequence of number pairs");
+    }
+
+    length = PySequence_Length(points);
+
+    if (length < 3) {
+        return RAISE(PyExc_ValueError,
+                     "points argument must contain more than 2 points");
+    }
+
+    xlist = PyMem_New(float, length);
+    ylist = PyMem_New(float, length);
+
+    if (NULL == xlist || NULL == ylist) {
+        if (xlist) {
+            PyMem_Free(xlist);
+        }
+        if (ylist) {
+            PyMem_Free(ylist);
+        }
+        return RAISE(PyExc_MemoryError,
+                     "cannot allocate memory to draw aapolygon");
+    }
+
+    for (loop = 0; loop < length; ++loop) {
+        item = PySequence_GetItem(points, loop);
+        result = item && pg_TwoFloatsFromObj(item, &x, &y);
+        if (loop == 0) {
+            l = (int)x;
+            t = (int)y;
+        }
+        Py_XDECREF(item);
+
+        if (!result) {
+            PyMem_Free(xlist);
+            PyMem_Free(ylist);
+            return RAISE(PyExc_TypeError, "points must be number pairs");
+        }
+
+        xlist[loop] = x;
+        ylist[loop] = y;
+    }
+
+    if (!pgSurface_Lock(surfobj)) {
+        PyMem_Free(xlist);
+        PyMem_Free(ylist);
+        return RAISE(PyExc_RuntimeError, "error locking surface");
+    }
+
+    if (filled) {
+        draw_aapolygon_filled(surf, xlist, ylist, length, color, drawn_area);
+    }
+    else {
+        /* same segment order as aalines(), so the shared end points are
+         * blended the same way */
+        for (loop = 1; loop <= length; ++loop) {
+            draw_aaline(surf, color, xlist[loop - 1], ylist[loop - 1],
+                        xlist[loop % length], ylist[loop % length],
+                        drawn_area);
+        }
+    }
+    PyMem_Free(xlist);
+    PyMem_Free(ylist);
+
+    if (!pgSurface_Unlock(surfobj)) {
+        return RAISE(PyExc_RuntimeError, "error unlocking surface");
+    }
+    if (PyErr_Occurred()) {
+        return NULL;
+    }
+
+    _mark_drawn_area(surfobj, drawn_area);
+
     if (drawn_area[0] != INT_MAX && drawn_area[1] != INT_MAX &&
         drawn_area[2] != INT_MIN && drawn_area[3] != INT_MIN)
         return pgRect_New4(drawn_area[0], drawn_area[1],
@@ -982,12 +1428,15 @@ polygon(PyObject *self, PyObject *arg, PyObject *kwargs)
 }
 
 static PyObject *
-rect(PyObject *self, PyObject *args, PyObject *kwargs)
+rect(PyObject *self, PyObject *const *args, Py_ssize_t nargs,
+     PyObject *kwnames)
 {
     pgSurfaceObject *surfobj;
     PyObject *colorobj, *rectobj;
+    PyObject *objs[3];
     SDL_Rect *rect = NULL, temp;
     SDL_Surface *surf = NULL;
+    pg_NoGIL nogil;
     Uint32 color;
     int width = 0, radius = 0; /* Default values. */
     int top_left_radius = -1, top_right_radius = -1, bottom_left_radius = -1,
@@ -1008,12 +1457,20 @@ rect(PyObject *self, PyObject *args, PyObject *kwargs)
                                "border_bottom_left_radius",
                                "border_bottom_right_radius",
                                NULL};
-    if (!PyArg_ParseTupleAndKeywords(
-            args, kwargs, "O!OO|iiiiii", keywords, &pgSurface_Type, &surfobj,
-            &colorobj, &rectobj, &width, &radius, &top_left_radius,
-            &top_right_radius, &bottom_left_radius, &bottom_right_radius)) {
+    int *ints[] = {&width,
+                   &radius,
+                   &top_left_radius,
+                   &top_right_radius,
+                   &bottom_left_radius,
+                   &bottom_right_radius};
+
+    if (!_draw_fastcall_args("rect", args, nargs, kwnames, keywords, 3, objs,
+                             ints)) {
         return NULL; /* Exception already set. */
     }
+    surfobj = (pgSurfaceObject *)objs[0];
+    colorobj = objs[1];
+    rectobj = objs[2];
 
     if (!(rect = pgRect_FromObject(rectobj, &temp))) {
         return RAISE(PyExc_TypeError, "rect argument is invalid");
@@ -1053,18 +1510,23 @@ rect(PyObject *self, PyObject *args, PyObject *kwargs)
             return pgRect_New4(rect->x, rect->y, 0, 0);
         }
         if (width > 0 && (width * 2) < clipped.w && (width * 2) < clipped.h) {
+            pg_nogil_begin(&nogil, surfobj, NULL);
             draw_rect(surf, sdlrect.x, sdlrect.y, sdlrect.x + sdlrect.w - 1,
                       sdlrect.y + sdlrect.h - 1, width, color);
+            pg_nogil_end(&nogil);
         }
         else {
             pgSurface_Prep(surfobj);
             pgSurface_Lock(surfobj);
+            pg_nogil_begin(&nogil, surfobj, NULL);
             result = SDL_FillRect(surf, &clipped, color);
+            pg_nogil_end(&nogil);
             pgSurface_Unlock(surfobj);
             pgSurface_Unprep(surfobj);
             if (result != 0)
                 return RAISE(pgExc_SDLError, SDL_GetError());
         }
+        pgSurface_AddDirtyRect(surfobj, &clipped);
         return pgRect_New(&clipped);
     }
     else {
@@ -1072,37 +1534,521 @@ rect(PyObject *self, PyObject *args, PyObject *kwargs)
             return RAISE(PyExc_RuntimeError, "error locking surface");
         }
 
-        /* Little bit to normalize the rect: this matters for the rounded
-           rects, despite not mattering for the normal rects. */
-        if (rect->w < 0) {
-            rect->x += rect->w;
-            rect->w = -rect->w;
+        /* Little bit to normalize the rect: this matters for the rounded
+           rects, despite not mattering for the normal rects. */
+        if (rect->w < 0) {
+            rect->x += rect->w;
+            rect->w = -rect->w;
+        }
+        if (rect->h < 0) {
+            rect->y += rect->h;
+            rect->h = -rect->h;
+        }
+
+        if (width > rect->w / 2 || width > rect->h / 2) {
+            width = MAX(rect->w / 2, rect->h / 2);
+        }
+
+        draw_round_rect(surf, rect->x, rect->y, rect->x + rect->w - 1,
+                        rect->y + rect->h - 1, radius, width, color,
+                        top_left_radius, top_right_radius, bottom_left_radius,
+                        bottom_right_radius, drawn_area);
+        if (!pgSurface_Unlock(surfobj)) {
+            return RAISE(PyExc_RuntimeError, "error unlocking surface");
+        }
+    }
+
+    _mark_drawn_area(surfobj, drawn_area);
+
+    if (drawn_area[0] != INT_MAX && drawn_area[1] != INT_MAX &&
+        drawn_area[2] != INT_MIN && drawn_area[3] != INT_MIN)
+        return pgRect_New4(drawn_area[0], drawn_area[1],
+                           drawn_area[2] - drawn_area[0] + 1,
+                           drawn_area[3] - drawn_area[1] + 1);
+    else
+        return pgRect_New4(rect->x, rect->y, 0, 0);
+}
+
+/* Batched drawing.
+ *
+ * rects(), circles() and lines_batch() draw many primitives of one kind with
+ * a single call. The coordinates come either from a C contiguous buffer of
+ * numbers, like a numpy array or a Vector2Array, or from a sequence of
+ * sequences, and are converted to ints up front. The surface is then locked
+ * once for the whole batch.
+ */
+
+/* Item i of the buffer view, as an int */
+#define _BATCH_CASE(c, type)                          \
+    case c:                                           \
+        values[i] = (int)((const type *)view.buf)[i]; \
+        break;
+
+/* Converts obj into a PyMem allocated array of *count rows of ncols ints.
+ * With ncols == 1 a sequence holds the numbers themselves instead of rows.
+ * Returns NULL with an exception set on failure, name is used in the error
+ * messages. */
+static int *
+_batch_load_ints(PyObject *obj, int ncols, const char *name,
+                 Py_ssize_t *count)
+{
+    Py_buffer view;
+    PyObject *item;
+    const char *fmt;
+    Py_ssize_t n, i;
+    int j, *values;
+
+    if (PyObject_CheckBuffer(obj) && !PyBytes_Check(obj) &&
+        !PyByteArray_Check(obj)) {
+        if (PyObject_GetBuffer(obj, &view, PyBUF_FORMAT | PyBUF_ND)) {
+            return NULL;
+        }
+        fmt = view.format ? view.format : "B";
+        if (*fmt == '@' || *fmt == '=') {
+            fmt++;
+        }
+        n = view.itemsize ? view.len / view.itemsize : 0;
+        if (!PyBuffer_IsContiguous(&view, 'C') || strlen(fmt) != 1 ||
+            !strchr("bBhHiIlLqQnNfd", *fmt) || n % ncols ||
+            (view.ndim > 1 && view.shape[view.ndim - 1] != ncols)) {
+            PyBuffer_Release(&view);
+            return (int *)PyErr_Format(
+                PyExc_ValueError,
+                "%s must be a C contiguous buffer of numbers with %d per item",
+                name, ncols);
+        }
+        values = PyMem_Malloc((n ? n : 1) * sizeof(int));
+        if (!values) {
+            PyBuffer_Release(&view);
+            return (int *)PyErr_NoMemory();
+        }
+        for (i = 0; i < n; i++) {
+            switch (*fmt) {
+                _BATCH_CASE('b', signed char)
+                _BATCH_CASE('B', unsigned char)
+                _BATCH_CASE('h', short)
+                _BATCH_CASE('H', unsigned short)
+                _BATCH_CASE('i', int)
+                _BATCH_CASE('I', unsigned int)
+                _BATCH_CASE('l', long)
+                _BATCH_CASE('L', unsigned long)
+                _BATCH_CASE('q', long long)
+                _BATCH_CASE('Q', unsigned long long)
+                _BATCH_CASE('n', Py_ssize_t)
+                _BATCH_CASE('N', size_t)
+                _BATCH_CASE('f', float)
+                _BATCH_CASE('d', double)
+            }
+        }
+        PyBuffer_Release(&view);
+        *count = n / ncols;
+        return values;
+    }
+
+    if (!PySequence_Check(obj)) {
+        return (int *)PyErr_Format(PyExc_TypeError,
+                                   "%s must be a sequence or a buffer", name);
+    }
+    n = PySequence_Length(obj);
+    if (n < 0) {
+        return NULL;
+    }
+    values = PyMem_Malloc((n ? n * ncols : 1) * sizeof(int));
+    if (!values) {
+        return (int *)PyErr_NoMemory();
+    }
+    for (i = 0; i < n; i++) {
+        if (ncols == 1) {
+            if (pg_IntFromObjIndex(obj, (int)i, &values[i])) {
+                continue;
+            }
+            PyMem_Free(values);
+            return (int *)PyErr_Format(PyExc_TypeError,
+                                       "%s must contain numbers", name);
+        }
+        item = PySequence_GetItem(obj, i);
+        if (!item) {
+            PyMem_Free(values);
+            return NULL;
+        }
+        if (!PySequence_Check(item) || PySequence_Length(item) != ncols) {
+            Py_DECREF(item);
+            PyMem_Free(values);
+            return (int *)PyErr_Format(
+                PyExc_TypeError, "%s must contain sequences of %d numbers",
+                name, ncols);
+        }
+        for (j = 0; j < ncols; j++) {
+            if (!pg_IntFromObjIndex(item, j, &values[i * ncols + j])) {
+                Py_DECREF(item);
+                PyMem_Free(values);
+                return (int *)PyErr_Format(
+                    PyExc_TypeError, "%s must contain sequences of %d numbers",
+                    name, ncols);
+            }
+        }
+        Py_DECREF(item);
+    }
+    *count = n;
+    return values;
+}
+
+#undef _BATCH_CASE
+
+/* Gets the colors of a batch of count primitives. colorobj is either one
+ * color, which is stored in *color and NULL is returned with no exception
+ * set, or a PyMem allocated array of count mapped colors is made from a
+ * sequence of colors or a buffer of (count, 3) or (count, 4) bytes. */
+static Uint32 *
+_batch_load_colors(PyObject *colorobj, SDL_Surface *surf, Py_ssize_t count,
+                   Uint32 *color)
+{
+    Py_buffer view;
+    PyObject *item;
+    const Uint8 *rgba;
+    Uint32 *colors;
+    Py_ssize_t i;
+    int channels;
+
+    if (pg_MappedColorFromObj(colorobj, surf->format, color,
+                              PG_COLOR_HANDLE_ALL)) {
+        return NULL;
+    }
+    if (PyUnicode_Check(colorobj)) {
+        return NULL; /* not a color name, keep the exception */
+    }
+    PyErr_Clear();
+
+    colors = PyMem_Malloc((count ? count : 1) * sizeof(Uint32));
+    if (!colors) {
+        return (Uint32 *)PyErr_NoMemory();
+    }
+
+    if (PyObject_CheckBuffer(colorobj)) {
+        if (PyObject_GetBuffer(colorobj, &view, PyBUF_FORMAT | PyBUF_ND)) {
+            PyMem_Free(colors);
+            return NULL;
+        }
+        channels = count ? (int)(view.len / count) : 0;
+        if (view.itemsize != 1 || !PyBuffer_IsContiguous(&view, 'C') ||
+            (view.format && strcmp(view.format, "B") != 0 &&
+             strcmp(view.format, "@B") != 0) ||
+            (channels != 3 && channels != 4) ||
+            view.len != count * channels) {
+            PyBuffer_Release(&view);
+            PyMem_Free(colors);
+            return (Uint32 *)PyErr_Format(
+                PyExc_ValueError,
+                "color buffer must hold %zd RGB or RGBA colors of bytes",
+                count);
+        }
+        for (i = 0; i < count; i++) {
+            rgba = (const Uint8 *)view.buf + i * channels;
+            colors[i] = SDL_MapRGBA(surf->format, rgba[0], rgba[1], rgba[2],
+                                    channels == 4 ? rgba[3] : 255);
+        }
+        PyBuffer_Release(&view);
+        return colors;
+    }
+
+    if (!PySequence_Check(colorobj)) {
+        PyMem_Free(colors);
+        return (Uint32 *)RAISE(PyExc_TypeError, "invalid color argument");
+    }
+    if (PySequence_Length(colorobj) != count) {
+        PyMem_Free(colors);
+        return (Uint32 *)PyErr_Format(
+            PyExc_ValueError,
+            "there must be one color, or as many colors as shapes (%zd)",
+            count);
+    }
+    for (i = 0; i < count; i++) {
+        item = PySequence_GetItem(colorobj, i);
+        if (!item) {
+            PyMem_Free(colors);
+            return NULL;
+        }
+        if (!pg_MappedColorFromObj(item, surf->format, &colors[i],
+                                   PG_COLOR_HANDLE_ALL)) {
+            Py_DECREF(item);
+            PyMem_Free(colors);
+            return NULL;
+        }
+        Py_DECREF(item);
+    }
+    return colors;
+}
+
+/* Adds rect to the {min x, min y, max x, max y} bounds in drawn_area */
+static void
+_batch_add_drawn_rect(int *drawn_area, SDL_Rect *rect)
+{
+    drawn_area[0] = MIN(drawn_area[0], rect->x);
+    drawn_area[1] = MIN(drawn_area[1], rect->y);
+    drawn_area[2] = MAX(drawn_area[2], rect->x + rect->w - 1);
+    drawn_area[3] = MAX(drawn_area[3], rect->y + rect->h - 1);
+}
+
+/* Shared start of the batch functions: checks the bit depth of surf and
+ * loads the colors of count primitives. Returns 0 with an exception set on
+ * failure. */
+static int
+_batch_prepare(SDL_Surface *surf, PyObject *colorobj, Py_ssize_t count,
+               Uint32 *color, Uint32 **colors)
+{
+    if (PG_SURF_BytesPerPixel(surf) <= 0 || PG_SURF_BytesPerPixel(surf) > 4) {
+        PyErr_Format(PyExc_ValueError,
+                     "unsupported surface bit depth (%d) for drawing",
+                     PG_SURF_BytesPerPixel(surf));
+        return 0;
+    }
+    *colors = _batch_load_colors(colorobj, surf, count, color);
+    return *colors || !PyErr_Occurred();
+}
+
+/* Shared end of the batch functions, returns the Rect bounding the drawn
+ * area, or a Rect with no size at (x, y) if nothing was drawn. */
+static PyObject *
+_batch_finish(pgSurfaceObject *surfobj, int *drawn_area, int x, int y)
+{
+    if (!pgSurface_Unlock(surfobj)) {
+        return RAISE(PyExc_RuntimeError, "error unlocking surface");
+    }
+    _mark_drawn_area(surfobj, drawn_area);
+
+    if (drawn_area[0] != INT_MAX && drawn_area[1] != INT_MAX &&
+        drawn_area[2] != INT_MIN && drawn_area[3] != INT_MIN)
+        return pgRect_New4(drawn_area[0], drawn_area[1],
+                           drawn_area[2] - drawn_area[0] + 1,
+                           drawn_area[3] - drawn_area[1] + 1);
+    else
+        return pgRect_New4(x, y, 0, 0);
+}
+
+/* Draws many rectangles without rounded corners.
+ *
+ * Returns a Rect bounding the drawn area.
+ */
+static PyObject *
+rects(PyObject *self, PyObject *args, PyObject *kwargs)
+{
+    pgSurfaceObject *surfobj;
+    PyObject *colorobj, *rectsobj, *ret;
+    SDL_Surface *surf;
+    SDL_Rect cliprect, sdlrect, clipped;
+    Uint32 color, *colors = NULL;
+    Py_ssize_t count = 0, i;
+    int *values;
+    int width = 0, result = 0;
+    int drawn_area[4] = {INT_MAX, INT_MAX, INT_MIN, INT_MIN};
+    static char *keywords[] = {"surface", "color", "rects", "width", NULL};
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "O!OO|i", keywords,
+                                     &pgSurface_Type, &surfobj, &colorobj,
+                                     &rectsobj, &width)) {
+        return NULL; /* Exception already set. */
+    }
+
+    if (!(values = _batch_load_ints(rectsobj, 4, "rects", &count))) {
+        return NULL;
+    }
+    surf = pgSurface_AsSurface(surfobj);
+    if (!surf) {
+        PyMem_Free(values);
+        return RAISE(pgExc_SDLError, "Surface is not initialized");
+    }
+    if (!_batch_prepare(surf, colorobj, count, &color, &colors)) {
+        PyMem_Free(values);
+        return NULL;
+    }
+
+    if (!pgSurface_Lock(surfobj)) {
+        PyMem_Free(values);
+        PyMem_Free(colors);
+        return RAISE(PyExc_RuntimeError, "error locking surface");
+    }
+
+    SDL_GetClipRect(surf, &cliprect);
+    for (i = 0; i < count && width >= 0; i++) {
+        sdlrect.x = values[i * 4];
+        sdlrect.y = values[i * 4 + 1];
+        sdlrect.w = values[i * 4 + 2];
+        sdlrect.h = values[i * 4 + 3];
+        if (!SDL_IntersectRect(&sdlrect, &cliprect, &clipped)) {
+            continue;
+        }
+        if (colors) {
+            color = colors[i];
+        }
+        if (width > 0 && (width * 2) < clipped.w && (width * 2) < clipped.h) {
+            draw_rect(surf, sdlrect.x, sdlrect.y, sdlrect.x + sdlrect.w - 1,
+                      sdlrect.y + sdlrect.h - 1, width, color);
+        }
+        else if (SDL_FillRect(surf, &clipped, color)) {
+            result = -1;
+            break;
+        }
+        _batch_add_drawn_rect(drawn_area, &clipped);
+    }
+
+    ret = _batch_finish(surfobj, drawn_area, count ? values[0] : 0,
+                        count ? values[1] : 0);
+    PyMem_Free(values);
+    PyMem_Free(colors);
+    if (ret && result) {
+        Py_DECREF(ret);
+        return RAISE(pgExc_SDLError, SDL_GetError());
+    }
+    return ret;
+}
+
+/* Draws many full circles.
+ *
+ * Returns a Rect bounding the drawn area.
+ */
+static PyObject *
+circles(PyObject *self, PyObject *args, PyObject *kwargs)
+{
+    pgSurfaceObject *surfobj;
+    PyObject *colorobj, *centersobj, *radiiobj, *ret;
+    SDL_Surface *surf;
+    SDL_Rect cliprect;
+    Uint32 color, *colors = NULL;
+    Py_ssize_t count = 0, nradii = 1, i;
+    int *centers, *radii = NULL;
+    int x, y, radius, width = 0;
+    int drawn_area[4] = {INT_MAX, INT_MAX, INT_MIN, INT_MIN};
+    static char *keywords[] = {"surface", "color", "centers",
+                               "radii",   "width", NULL};
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "O!OOO|i", keywords,
+                                     &pgSurface_Type, &surfobj, &colorobj,
+                                     &centersobj, &radiiobj, &width)) {
+        return NULL; /* Exception already set. */
+    }
+
+    if (!(centers = _batch_load_ints(centersobj, 2, "centers", &count))) {
+        return NULL;
+    }
+    /* one radius for all circles */
+    if (pg_IntFromObj(radiiobj, &radius)) {
+        nradii = 0;
+    }
+    else if (!(radii = _batch_load_ints(radiiobj, 1, "radii", &nradii))) {
+        PyMem_Free(centers);
+        return NULL;
+    }
+    else if (nradii != count) {
+        PyMem_Free(centers);
+        PyMem_Free(radii);
+        return PyErr_Format(
+            PyExc_ValueError,
+            "there must be one radius, or as many radii as centers (%zd)",
+            count);
+    }
+
+    surf = pgSurface_AsSurface(surfobj);
+    if (!surf) {
+        PyMem_Free(centers);
+        PyMem_Free(radii);
+        return RAISE(pgExc_SDLError, "Surface is not initialized");
+    }
+    if (!_batch_prepare(surf, colorobj, count, &color, &colors)) {
+        PyMem_Free(centers);
+        PyMem_Free(radii);
+        return NULL;
+    }
+
+    if (!pgSurface_Lock(surfobj)) {
+        PyMem_Free(centers);
+        PyMem_Free(radii);
+        PyMem_Free(colors);
+        return RAISE(PyExc_RuntimeError, "error locking surface");
+    }
+
+    SDL_GetClipRect(surf, &cliprect);
+    for (i = 0; i < count && width >= 0; i++) {
+        x = centers[i * 2];
+        y = centers[i * 2 + 1];
+        if (radii) {
+            radius = radii[i];
         }
-        if (rect->h < 0) {
-            rect->y += rect->h;
-            rect->h = -rect->h;
+        if (radius < 1 || x > cliprect.x + cliprect.w + radius ||
+            x < cliprect.x - radius || y > cliprect.y + cliprect.h + radius ||
+            y < cliprect.y - radius) {
+            continue;
         }
-
-        if (width > rect->w / 2 || width > rect->h / 2) {
-            width = MAX(rect->w / 2, rect->h / 2);
+        if (colors) {
+            color = colors[i];
         }
+        draw_circle_width(surf, x, y, radius, MIN(width, radius), color,
+                          drawn_area);
+    }
 
-        draw_round_rect(surf, rect->x, rect->y, rect->x + rect->w - 1,
-                        rect->y + rect->h - 1, radius, width, color,
-                        top_left_radius, top_right_radius, bottom_left_radius,
-                        bottom_right_radius, drawn_area);
-        if (!pgSurface_Unlock(surfobj)) {
-            return RAISE(PyExc_RuntimeError, "error unlocking surface");
+    ret = _batch_finish(surfobj, drawn_area, count ? centers[0] : 0,
+                        count ? centers[1] : 0);
+    PyMem_Free(centers);
+    PyMem_Free(radii);
+    PyMem_Free(colors);
+    return ret;
+}
+
+/* Draws many separate line segments.
+ *
+ * Returns a Rect bounding the drawn area.
+ */
+static PyObject *
+lines_batch(PyObject *self, PyObject *args, PyObject *kwargs)
+{
+    pgSurfaceObject *surfobj;
+    PyObject *colorobj, *linesobj, *ret;
+    SDL_Surface *surf;
+    Uint32 color, *colors = NULL;
+    Py_ssize_t count = 0, i;
+    int *values;
+    int width = 1;
+    int drawn_area[4] = {INT_MAX, INT_MAX, INT_MIN, INT_MIN};
+    static char *keywords[] = {"surface", "color", "lines", "width", NULL};
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "O!OO|i", keywords,
+                                     &pgSurface_Type, &surfobj, &colorobj,
+                                     &linesobj, &width)) {
+        return NULL; /* Exception already set. */
+    }
+
+    if (!(values = _batch_load_ints(linesobj, 4, "lines", &count))) {
+        return NULL;
+    }
+    surf = pgSurface_AsSurface(surfobj);
+    if (!surf) {
+        PyMem_Free(values);
+        return RAISE(pgExc_SDLError, "Surface is not initialized");
+    }
+    if (!_batch_prepare(surf, colorobj, count, &color, &colors)) {
+        PyMem_Free(values);
+        return NULL;
+    }
+
+    if (!pgSurface_Lock(surfobj)) {
+        PyMem_Free(values);
+        PyMem_Free(colors);
+        return RAISE(PyExc_RuntimeError, "error locking surface");
+    }
+
+    for (i = 0; i < count && width >= 1; i++) {
+        if (colors) {
+            color = colors[i];
         }
+        draw_line_width(surf, color, values[i * 4], values[i * 4 + 1],
+                        values[i * 4 + 2], values[i * 4 + 3], width,
+                        drawn_area);
     }
 
-    if (drawn_area[0] != INT_MAX && drawn_area[1] != INT_MAX &&
-        drawn_area[2] != INT_MIN && drawn_area[3] != INT_MIN)
-        return pgRect_New4(drawn_area[0], drawn_area[1],
-                           drawn_area[2] - drawn_area[0] + 1,
-                           drawn_area[3] - drawn_area[1] + 1);
-    else
-        return pgRect_New4(rect->x, rect->y, 0, 0);
+    ret = _batch_finish(surfobj, drawn_area, count ? values[0] : 0,
+                        count ? values[1] : 0);
+    PyMem_Free(values);
+    PyMem_Free(colors);
+    return ret;
 }
 
 /* Functions used in drawing algorithms */
@@ -1454,19 +2400,76 @@ draw_aaline(SDL_Surface *surf, Uint32 color, float from_x, float from_y,
     }
 }
 
+/* Spans shorter than this are filled pixel by pixel, building the pattern
+ * for the SIMD fill would cost more than it saves. */
+#define PG_SIMD_SPAN_MIN_BYTES 256
+
+/* Fills pattern with copies of the bytes of color */
+static void
+_span_pattern(Uint8 *pattern, Uint32 color, int bpp)
+{
+    Uint16 color16 = (Uint16)color;
+    int size, copy;
+
+    switch (bpp) {
+        case 2:
+            memcpy(pattern, &color16, 2);
+            break;
+        case 3:
+#if SDL_BYTEORDER == SDL_BIG_ENDIAN
+            color <<= 8;
+#endif
+            memcpy(pattern, &color, 3);
+            break;
+        default: /*case 4*/
+            memcpy(pattern, &color, 4);
+            break;
+    }
+    for (size = bpp; size < PG_SPAN_PATTERN_SIZE; size += copy) {
+        copy = MIN(size, PG_SPAN_PATTERN_SIZE - size);
+        memcpy(pattern + size, pattern, copy);
+    }
+}
+
 static void
 drawhorzline(SDL_Surface *surf, Uint32 color, int x1, int y1, int x2)
 {
     Uint8 *pixel, *end;
+    int bpp = PG_SURF_BytesPerPixel(surf);
+#if !defined(__EMSCRIPTEN__)
+    Uint8 pattern[PG_SPAN_PATTERN_SIZE];
+    size_t nbytes;
+#endif /* __EMSCRIPTEN__ */
 
+    if (x2 < x1) {
+        return;
+    }
     pixel = ((Uint8 *)surf->pixels) + surf->pitch * y1;
-    end = pixel + x2 * PG_SURF_BytesPerPixel(surf);
-    pixel += x1 * PG_SURF_BytesPerPixel(surf);
-    switch (PG_SURF_BytesPerPixel(surf)) {
+    end = pixel + x2 * bpp;
+    pixel += x1 * bpp;
+
+#if !defined(__EMSCRIPTEN__)
+    /* memset() is already as fast as it gets for 8 bit surfaces */
+    nbytes = (size_t)(x2 - x1 + 1) * bpp;
+    if (bpp > 1 && nbytes >= PG_SIMD_SPAN_MIN_BYTES) {
+        if (_pg_has_avx2()) {
+            _span_pattern(pattern, color, bpp);
+            surface_fill_span_avx2(pixel, nbytes, pattern);
+            return;
+        }
+#if PG_ENABLE_SSE_NEON
+        if (_pg_HasSSE_NEON()) {
+            _span_pattern(pattern, color, bpp);
+            surface_fill_span_sse2(pixel, nbytes, pattern);
+            return;
+        }
+#endif /* PG_ENABLE_SSE_NEON */
+    }
+#endif /* __EMSCRIPTEN__ */
+
+    switch (bpp) {
         case 1:
-            for (; pixel <= end; ++pixel) {
-                *pixel = (Uint8)color;
-            }
+            memset(pixel, (Uint8)color, x2 - x1 + 1);
             break;
         case 2:
             for (; pixel <= end; pixel += 2) {
@@ -1482,9 +2485,7 @@ drawhorzline(SDL_Surface *surf, Uint32 color, int x1, int y1, int x2)
             }
             break;
         default: /*case 4*/
-            for (; pixel <= end; pixel += 4) {
-                *(Uint32 *)pixel = color;
-            }
+            SDL_memset4(pixel, color, x2 - x1 + 1);
             break;
     }
 }
@@ -1744,11 +2745,7 @@ draw_line(SDL_Surface *surf, int x1, int y1, int x2, int y2, Uint32 color,
         return;
     }
     if (y1 == y2) { /* Horizontal line */
-        dx = (x1 < x2) ? 1 : -1;
-        for (sx = 0; sx <= abs(x1 - x2); sx++) {
-            set_and_check_rect(surf, x1 + dx * sx, y1, color, drawn_area);
-        }
-
+        drawhorzlineclipbounding(surf, color, x1, y1, x2, drawn_area);
         return;
     }
     if (x1 == x2) { /* Vertical line */
@@ -2472,6 +3469,42 @@ draw_circle_filled(SDL_Surface *surf, int x0, int y0, int radius, Uint32 color,
     }
 }
 
+/* Draws a full circle, filled if width is 0 or radius */
+static void
+draw_circle_width(SDL_Surface *surf, int x0, int y0, int radius, int width,
+                  Uint32 color, int *drawn_area)
+{
+    if (!width || width == radius) {
+        draw_circle_filled(surf, x0, y0, radius, color, drawn_area);
+    }
+    else if (width == 1) {
+        draw_circle_bresenham_thin(surf, x0, y0, radius, color, drawn_area);
+    }
+    else {
+        draw_circle_bresenham(surf, x0, y0, radius, width, color, drawn_area);
+    }
+}
+
+/* Draws a full antialiased circle, filled if width is 0 or radius */
+static void
+draw_aacircle_width(SDL_Surface *surf, int x0, int y0, int radius, int width,
+                    Uint32 color, int *drawn_area)
+{
+    if (!width || width == radius) {
+        draw_circle_filled(surf, x0, y0, radius - 1, color, drawn_area);
+        draw_circle_xaolinwu(surf, x0, y0, radius, 2, color, 1, 1, 1, 1,
+                             drawn_area);
+    }
+    else if (width == 1) {
+        draw_circle_xaolinwu_thin(surf, x0, y0, radius, color, 1, 1, 1, 1,
+                                  drawn_area);
+    }
+    else {
+        draw_circle_xaolinwu(surf, x0, y0, radius, width, color, 1, 1, 1, 1,
+                             drawn_area);
+    }
+}
+
 static void
 draw_eight_symetric_pixels(SDL_Surface *surf, int x0, int y0, Uint32 color,
                            int x, int y, float opacity, int top_right,
@@ -2854,6 +3887,41 @@ draw_ellipse_thickness(SDL_Surface *surf, int x0, int y0, int width,
     }
 }
 
+/* An edge of a polygon in the active edge table of draw_fillpoly(). The
+ * intersection with the current row is x + rem / dy, stepped exactly from
+ * row to row without a division. */
+typedef struct {
+    int index;    /* position in the polygon, decides the rounding */
+    int y1, yend; /* the edge intersects rows y1 to yend - 1 */
+    int x1, dx, dy;
+    int x, rem; /* 0 <= rem < dy */
+    int step, step_rem;
+} pg_PolyEdge;
+
+/* Moves edge to row y */
+static void
+_poly_edge_seek(pg_PolyEdge *edge, int y)
+{
+    Sint64 num = (Sint64)(y - edge->y1) * edge->dx;
+    Sint64 q = num / edge->dy;
+
+    if (num % edge->dy < 0) {
+        q--;
+    }
+    edge->x = edge->x1 + (int)q;
+    edge->rem = (int)(num - q * edge->dy);
+}
+
+static int
+_poly_edge_compare_y1(const void *a, const void *b)
+{
+    const pg_PolyEdge *ea = a, *eb = b;
+    if (ea->y1 != eb->y1) {
+        return ea->y1 < eb->y1 ? -1 : 1;
+    }
+    return ea->index - eb->index;
+}
+
 static void
 draw_fillpoly(SDL_Surface *surf, int *point_x, int *point_y,
               Py_ssize_t num_points, Uint32 color, int *drawn_area)
@@ -2863,17 +3931,16 @@ draw_fillpoly(SDL_Surface *surf, int *point_x, int *point_y,
      * num_points : the number of points
      */
     Py_ssize_t i, i_previous;  // i_previous is the index of the point before i
-    int y, miny, maxy;
+    Py_ssize_t n_edges = 0, next_edge = 0, n_active = 0, j, k;
+    int y, miny, maxy, ystart, ystop, x;
     int x1, y1;
     int x2, y2;
-    float intersect;
+    pg_PolyEdge *edges, *edge;
+    /* active edges in polygon order */
+    pg_PolyEdge **active;
     /* x_intersect are the x-coordinates of intersections of the polygon
      * with some horizontal line */
-    int *x_intersect = PyMem_New(int, num_points);
-    if (x_intersect == NULL) {
-        PyErr_NoMemory();
-        return;
-    }
+    int *x_intersect;
 
     /* Determine Y maxima */
     miny = point_y[0];
@@ -2894,55 +3961,135 @@ draw_fillpoly(SDL_Surface *surf, int *point_x, int *point_y,
             maxx = MAX(maxx, point_x[i]);
         }
         drawhorzlineclipbounding(surf, color, minx, miny, maxx, drawn_area);
+        return;
+    }
+
+    edges = PyMem_New(pg_PolyEdge, num_points);
+    active = PyMem_New(pg_PolyEdge *, num_points);
+    x_intersect = PyMem_New(int, num_points);
+    if (!edges || !active || !x_intersect) {
+        PyMem_Free(edges);
+        PyMem_Free(active);
         PyMem_Free(x_intersect);
+        PyErr_NoMemory();
         return;
     }
 
+    /* Build the edge table, sorted by the first row of each edge. The
+     * horizontal edges are handled as a special case (below). */
+    for (i = 0; (i < num_points); i++) {
+        i_previous = ((i) ? (i - 1) : (num_points - 1));
+
+        y1 = point_y[i_previous];
+        y2 = point_y[i];
+        if (y1 < y2) {
+            x1 = point_x[i_previous];
+            x2 = point_x[i];
+        }
+        else if (y1 > y2) {
+            y2 = point_y[i_previous];
+            y1 = point_y[i];
+            x2 = point_x[i_previous];
+            x1 = point_x[i];
+        }
+        else {
+            continue;
+        }
+        edge = &edges[n_edges++];
+        edge->index = (int)i;
+        edge->y1 = y1;
+        // the lower end is excluded, except on the lowest line (maxy)
+        edge->yend = (y2 == maxy) ? y2 + 1 : y2;
+        edge->x1 = x1;
+        edge->dx = x2 - x1;
+        edge->dy = y2 - y1;
+        edge->step = edge->dx / edge->dy;
+        edge->step_rem = edge->dx % edge->dy;
+        if (edge->step_rem < 0) {
+            edge->step--;
+            edge->step_rem += edge->dy;
+        }
+    }
+    qsort(edges, n_edges, sizeof(pg_PolyEdge), _poly_edge_compare_y1);
+
+    /* Rows outside of the clip rect are skipped, the edges that are already
+     * active at the first visible row are moved there directly. */
+    ystart = MAX(miny, surf->clip_rect.y);
+    ystop = MIN(maxy, surf->clip_rect.y + surf->clip_rect.h - 1);
+
     /* Draw, scanning y
      * ----------------
      * The algorithm uses a horizontal line (y) that moves from top to the
      * bottom of the polygon:
      *
-     * 1. search intersections with the border lines
-     * 2. sort intersections (x_intersect)
+     * 1. update the active edges crossing the line, in polygon order
+     * 2. round their intersections down and up in turn, in that order, and
+     *    sort them (x_intersect)
      * 3. each two x-coordinates in x_intersect are then inside the polygon
      *    (draw line for a pair of two such points)
+     * 4. step each active edge to the next line
      */
-    for (y = miny; (y <= maxy); y++) {
+    for (y = ystart; y <= ystop; y++) {
         // n_intersections is the number of intersections with the polygon
         int n_intersections = 0;
-        for (i = 0; (i < num_points); i++) {
-            i_previous = ((i) ? (i - 1) : (num_points - 1));
-
-            y1 = point_y[i_previous];
-            y2 = point_y[i];
-            if (y1 < y2) {
-                x1 = point_x[i_previous];
-                x2 = point_x[i];
+
+        for (; next_edge < n_edges && edges[next_edge].y1 <= y; next_edge++) {
+            edge = &edges[next_edge];
+            if (edge->yend <= y) {
+                continue;
             }
-            else if (y1 > y2) {
-                y2 = point_y[i_previous];
-                y1 = point_y[i];
-                x2 = point_x[i_previous];
-                x1 = point_x[i];
+            if (edge->y1 < y) {
+                _poly_edge_seek(edge, y);
             }
-            else {  // y1 == y2 : has to be handled as special case (below)
+            else {
+                edge->x = edge->x1;
+                edge->rem = 0;
+            }
+            for (j = n_active; j > 0 && active[j - 1]->index > edge->index;
+                 j--) {
+                active[j] = active[j - 1];
+            }
+            active[j] = edge;
+            n_active++;
+        }
+
+        for (j = k = 0; j < n_active; j++) {
+            edge = active[j];
+            if (edge->yend <= y) {
                 continue;
             }
-            if (((y >= y1) && (y < y2)) || ((y == maxy) && (y2 == maxy))) {
-                // add intersection if y crosses the edge (excluding the lower
-                // end), or when we are on the lowest line (maxy)
-                intersect = (y - y1) * (x2 - x1) / (float)(y2 - y1);
-                if (n_intersections % 2 == 0) {
-                    intersect = (float)floor(intersect);
+            active[k++] = edge;
+
+            x_intersect[n_intersections] = edge->x;
+            if (n_intersections % 2 && edge->rem) {
+                x_intersect[n_intersections]++;
+            }
+            n_intersections++;
+
+            edge->x += edge->step;
+            edge->rem += edge->step_rem;
+            if (edge->rem >= edge->dy) {
+                edge->x++;
+                edge->rem -= edge->dy;
+            }
+        }
+        n_active = k;
+
+        /* most rows only cross a few edges */
+        if (n_intersections > 16) {
+            qsort(x_intersect, n_intersections, sizeof(int), compare_int);
+        }
+        else {
+            for (j = 1; j < n_intersections; j++) {
+                x = x_intersect[j];
+                for (k = j; k > 0 && x_intersect[k - 1] > x; k--) {
+                    x_intersect[k] = x_intersect[k - 1];
                 }
-                else
-                    intersect = (float)ceil(intersect);
-                x_intersect[n_intersections++] = (int)intersect + x1;
+                x_intersect[k] = x;
             }
         }
-        qsort(x_intersect, n_intersections, sizeof(int), compare_int);
-        for (i = 0; (i < n_intersections); i += 2) {
+
+        for (i = 0; (i + 1 < n_intersections); i += 2) {
             drawhorzlineclipbounding(surf, color, x_intersect[i], y,
                                      x_intersect[i + 1], drawn_area);
         }
@@ -2966,9 +4113,371 @@ draw_fillpoly(SDL_Surface *surf, int *point_x, int *point_y,
                                      point_x[i_previous], drawn_area);
         }
     }
+    PyMem_Free(edges);
+    PyMem_Free(active);
     PyMem_Free(x_intersect);
 }
 
+/* Adds the signed area that the part of an edge from (x0, y0) to (x1, y1)
+ * inside of rows 0 to h - 1 covers of each pixel to acc, which has w + 2
+ * floats per row. The coverage of a pixel is the running sum of acc along
+ * its row, see https://github.com/raphlinus/font-rs. Parts of the edge left
+ * and right of the rows are moved to their edges. */
+static void
+_aafill_edge(float *acc, int w, int h, float x0, float y0, float x1,
+             float y1)
+{
+    float dir = 1.0f, dxdy, x, xnext, dy, d, t;
+    float xl, xr, xl_floor, xr_ceil, xlf, xrf, s, a0, a1, a2, am;
+    int y, yend, xli, xri, xi;
+    float *row;
+
+    /* nearly horizontal edges add next to nothing */
+    if (!isfinite(x0) || !isfinite(y0) || !isfinite(x1) || !isfinite(y1) ||
+        fabsf(y1 - y0) < 1e-4f) {
+        return;
+    }
+    if (y0 > y1) {
+        dir = -1.0f;
+        t = x0, x0 = x1, x1 = t;
+        t = y0, y0 = y1, y1 = t;
+    }
+    if (y1 <= 0 || y0 >= h) {
+        return;
+    }
+    dxdy = (x1 - x0) / (y1 - y0);
+    x = x0;
+    if (y0 < 0) {
+        x -= y0 * dxdy;
+        y0 = 0;
+    }
+    yend = (int)MIN((float)h, ceilf(y1));
+
+    for (y = (int)y0; y < yend; y++) {
+        row = acc + (size_t)y * (w + 2);
+        dy = MIN((float)(y + 1), y1) - MAX((float)y, y0);
+        xnext = x + dxdy * dy;
+        d = dy * dir;
+        xl = MIN(MAX(MIN(x, xnext), 0.0f), (float)w);
+        xr = MIN(MAX(MAX(x, xnext), 0.0f), (float)w);
+        xl_floor = floorf(xl);
+        xli = (int)xl_floor;
+        xr_ceil = ceilf(xr);
+        xri = (int)xr_ceil;
+        if (xri <= xli + 1) {
+            /* within one pixel */
+            a0 = 0.5f * (xl + xr) - xl_floor;
+            row[xli] += d - d * a0;
+            row[xli + 1] += d * a0;
+        }
+        else {
+            s = 1.0f / (xr - xl);
+            xlf = xl - xl_floor;
+            a0 = 0.5f * s * (1.0f - xlf) * (1.0f - xlf);
+            xrf = xr - xr_ceil + 1.0f;
+            am = 0.5f * s * xrf * xrf;
+            row[xli] += d * a0;
+            if (xri == xli + 2) {
+                row[xli + 1] += d * (1.0f - a0 - am);
+            }
+            else {
+                a1 = s * (1.5f - xlf);
+                row[xli + 1] += d * (a1 - a0);
+                for (xi = xli + 2; xi < xri - 1; xi++) {
+                    row[xi] += d * s;
+                }
+                a2 = a1 + (xri - xli - 3) * s;
+                row[xri - 1] += d * (1.0f - a2 - am);
+            }
+            row[xri] += d * am;
+        }
+        x = xnext;
+    }
+}
+
+static int
+_aafill_clamp(float v, int low, int high)
+{
+    if (!(v > (float)low)) { /* also NaN */
+        return low;
+    }
+    return v < (float)high ? (int)v : high;
+}
+
+/* Coverage accumulator of the antialiased fills, for the pixels x0 to
+ * x0 + w - 1 and y0 to y0 + h - 1. */
+typedef struct {
+    float *acc;
+    int x0, y0, w, h;
+} pg_AAFill;
+
+/* Sets up fill for the pixels touched by shapes within the given bounds,
+ * limited to the clip rect. Returns 1 on success, 0 if there is nothing to
+ * draw or -1 with MemoryError set. */
+static int
+_aafill_init(pg_AAFill *fill, SDL_Surface *surf, float minx, float miny,
+             float maxx, float maxy)
+{
+    SDL_Rect *clip = &surf->clip_rect;
+    int x1, y1;
+
+    fill->x0 = _aafill_clamp(floorf(minx + 0.5f), clip->x, clip->x + clip->w);
+    fill->y0 = _aafill_clamp(floorf(miny + 0.5f), clip->y, clip->y + clip->h);
+    x1 = _aafill_clamp(ceilf(maxx + 0.5f), clip->x, clip->x + clip->w);
+    y1 = _aafill_clamp(ceilf(maxy + 0.5f), clip->y, clip->y + clip->h);
+    if (fill->x0 >= x1 || fill->y0 >= y1) {
+        return 0;
+    }
+    fill->w = x1 - fill->x0;
+    fill->h = y1 - fill->y0;
+
+    fill->acc = PyMem_Calloc((size_t)(fill->w + 2) * fill->h, sizeof(float));
+    if (!fill->acc) {
+        PyErr_NoMemory();
+        return -1;
+    }
+    return 1;
+}
+
+/* Adds an edge in surface coordinates, integer coordinates are pixel
+ * centers */
+static void
+_aafill_add_edge(pg_AAFill *fill, float x0, float y0, float x1, float y1)
+{
+    _aafill_edge(fill->acc, fill->w, fill->h, x0 + 0.5f - fill->x0,
+                 y0 + 0.5f - fill->y0, x1 + 0.5f - fill->x0,
+                 y1 + 0.5f - fill->y0);
+}
+
+/* Adds a polygon with a positive winding, whatever the order of its
+ * points, so that overlapping shapes join with the non-zero rule. */
+static void
+_aafill_add_shape(pg_AAFill *fill, const float *point_x, const float *point_y,
+                  int num_points)
+{
+    float area = 0.0f;
+    int i, i_previous;
+
+    for (i = 0; i < num_points; i++) {
+        i_previous = i ? i - 1 : num_points - 1;
+        area += (point_x[i_previous] - point_x[i]) *
+                (point_y[i_previous] + point_y[i]);
+    }
+    for (i = 0; i < num_points; i++) {
+        i_previous = i ? i - 1 : num_points - 1;
+        if (area >= 0.0f) {
+            _aafill_add_edge(fill, point_x[i_previous], point_y[i_previous],
+                             point_x[i], point_y[i]);
+        }
+        else {
+            _aafill_add_edge(fill, point_x[i], point_y[i],
+                             point_x[i_previous], point_y[i_previous]);
+        }
+    }
+}
+
+/* Draws the accumulated coverage and frees it. With nonzero set, any
+ * winding counts as inside, otherwise the even-odd rule is used. */
+static void
+_aafill_draw(pg_AAFill *fill, SDL_Surface *surf, Uint32 color, int nonzero,
+             int *drawn_area)
+{
+    float sum, coverage;
+    float *row;
+    int x, y, px, py;
+
+    for (y = 0; y < fill->h; y++) {
+        row = fill->acc + (size_t)y * (fill->w + 2);
+        py = fill->y0 + y;
+        sum = 0.0f;
+        for (x = 0; x < fill->w; x++) {
+            sum += row[x];
+            px = fill->x0 + x;
+            if (nonzero) {
+                coverage = MIN(fabsf(sum), 1.0f);
+            }
+            else {
+                /* even-odd rule: windings of 1, 3, ... are inside */
+                coverage = fmodf(fabsf(sum), 2.0f);
+                if (coverage > 1.0f) {
+                    coverage = 2.0f - coverage;
+                }
+            }
+            if (coverage >= 254.5f / 255.0f) {
+                set_and_check_rect(surf, px, py, color, drawn_area);
+            }
+            else if (coverage >= 0.5f / 255.0f) {
+                set_and_check_rect(
+                    surf, px, py,
+                    get_antialiased_color(surf, px, py, color, coverage),
+                    drawn_area);
+            }
+        }
+    }
+    PyMem_Free(fill->acc);
+    fill->acc = NULL;
+}
+
+/* Fills a polygon with antialiased edges, with the same even-odd rule as
+ * draw_fillpoly(). Integer coordinates are pixel centers. */
+static void
+draw_aapolygon_filled(SDL_Surface *surf, const float *point_x,
+                      const float *point_y, Py_ssize_t num_points,
+                      Uint32 color, int *drawn_area)
+{
+    pg_AAFill fill;
+    float minx, miny, maxx, maxy;
+    Py_ssize_t i, i_previous;
+
+    minx = maxx = point_x[0];
+    miny = maxy = point_y[0];
+    for (i = 1; i < num_points; i++) {
+        minx = MIN(minx, point_x[i]);
+        maxx = MAX(maxx, point_x[i]);
+        miny = MIN(miny, point_y[i]);
+        maxy = MAX(maxy, point_y[i]);
+    }
+    if (_aafill_init(&fill, surf, minx, miny, maxx, maxy) <= 0) {
+        return;
+    }
+    for (i = 0; i < num_points; i++) {
+        i_previous = i ? i - 1 : num_points - 1;
+        _aafill_add_edge(&fill, point_x[i_previous], point_y[i_previous],
+                         point_x[i], point_y[i]);
+    }
+    _aafill_draw(&fill, surf, color, 0, drawn_area);
+}
+
+/* Longest miter, relative to the line width, before a miter joint is cut
+ * off to a bevel */
+#define PG_MITER_LIMIT 4.0f
+
+/* Joins two segments of a wide antialiased polyline at (x, y). (nx0, ny0)
+ * and (nx1, ny1) are the normals of the segments, as long as half the line
+ * width. */
+static void
+_aafill_add_joint(pg_AAFill *fill, float x, float y, float nx0, float ny0,
+                  float nx1, float ny1, int joint)
+{
+    float shape_x[PG_AAJOINT_MAX_POINTS], shape_y[PG_AAJOINT_MAX_POINTS];
+    float half_width = sqrtf(nx0 * nx0 + ny0 * ny0);
+    float dot, cross, side, angle;
+    int i, n;
+
+    if (joint == PG_JOINT_ROUND) {
+        /* circle with a chord error of at most a tenth of a pixel */
+        n = 8;
+        if (half_width > 0.1f) {
+            n = (int)ceilf((float)M_PI / acosf(1.0f - 0.1f / half_width));
+            n = MIN(MAX(n, 8), PG_AAJOINT_MAX_POINTS);
+        }
+        for (i = 0; i < n; i++) {
+            angle = 2.0f * (float)M_PI * i / n;
+            shape_x[i] = x + half_width * cosf(angle);
+            shape_y[i] = y + half_width * sinf(angle);
+        }
+        _aafill_add_shape(fill, shape_x, shape_y, n);
+        return;
+    }
+
+    dot = (nx0 * nx1 + ny0 * ny1) / (half_width * half_width);
+    cross = nx0 * ny1 - ny0 * nx1;
+    if (dot > 0.0f && fabsf(cross) < 1e-6f * half_width * half_width) {
+        return; /* straight on, nothing to fill */
+    }
+    /* the gap to fill is on the outside of the turn */
+    side = cross > 0.0f ? -1.0f : 1.0f;
+
+    shape_x[0] = x;
+    shape_y[0] = y;
+    shape_x[1] = x + side * nx0;
+    shape_y[1] = y + side * ny0;
+    n = 2;
+    if (joint == PG_JOINT_MITER &&
+        1.0f + dot > 2.0f / (PG_MITER_LIMIT * PG_MITER_LIMIT)) {
+        shape_x[n] = x + side * (nx0 + nx1) / (1.0f + dot);
+        shape_y[n] = y + side * (ny0 + ny1) / (1.0f + dot);
+        n++;
+    }
+    shape_x[n] = x + side * nx1;
+    shape_y[n] = y + side * ny1;
+    _aafill_add_shape(fill, shape_x, shape_y, n + 1);
+}
+
+/* Draws connected antialiased line segments of the given width with
+ * joints between them. The segments and joints are accumulated first, so
+ * every pixel is drawn once, even where they overlap. */
+static void
+draw_aalines_width(SDL_Surface *surf, Uint32 color, const float *point_x,
+                   const float *point_y, Py_ssize_t num_points, int closed,
+                   float width, int joint, int *drawn_area)
+{
+    pg_AAFill fill;
+    float minx, miny, maxx, maxy, margin, dx, dy, length;
+    float quad_x[4], quad_y[4];
+    float nx, ny, nx_first = 0.0f, ny_first = 0.0f, nx_prev = 0.0f,
+                  ny_prev = 0.0f;
+    float half_width = width / 2.0f;
+    Py_ssize_t i, next, num_segments;
+    int have_prev = 0;
+
+    minx = maxx = point_x[0];
+    miny = maxy = point_y[0];
+    for (i = 1; i < num_points; i++) {
+        minx = MIN(minx, point_x[i]);
+        maxx = MAX(maxx, point_x[i]);
+        miny = MIN(miny, point_y[i]);
+        maxy = MAX(maxy, point_y[i]);
+    }
+    margin = half_width * (joint == PG_JOINT_MITER ? PG_MITER_LIMIT : 1.0f);
+    if (_aafill_init(&fill, surf, minx - margin, miny - margin, maxx + margin,
+                     maxy + margin) <= 0) {
+        return;
+    }
+
+    num_segments = closed && num_points > 2 ? num_points : num_points - 1;
+    for (i = 0; i < num_segments; i++) {
+        next = (i + 1) % num_points;
+        dx = point_x[next] - point_x[i];
+        dy = point_y[next] - point_y[i];
+        length = sqrtf(dx * dx + dy * dy);
+        if (!(length > 1e-6f)) { /* also NaN */
+            continue;
+        }
+        nx = -dy / length * half_width;
+        ny = dx / length * half_width;
+
+        quad_x[0] = point_x[i] + nx;
+        quad_y[0] = point_y[i] + ny;
+        quad_x[1] = point_x[next] + nx;
+        quad_y[1] = point_y[next] + ny;
+        quad_x[2] = point_x[next] - nx;
+        quad_y[2] = point_y[next] - ny;
+        quad_x[3] = point_x[i] - nx;
+        quad_y[3] = point_y[i] - ny;
+        _aafill_add_shape(&fill, quad_x, quad_y, 4);
+
+        if (have_prev) {
+            _aafill_add_joint(&fill, point_x[i], point_y[i], nx_prev, ny_prev,
+                              nx, ny, joint);
+        }
+        else {
+            nx_first = nx;
+            ny_first = ny;
+            have_prev = 1;
+        }
+        nx_prev = nx;
+        ny_prev = ny;
+    }
+    /* skipped segments have no length, so the first segment that was drawn
+     * starts at the first point */
+    if (closed && num_points > 2 && have_prev) {
+        _aafill_add_joint(&fill, point_x[0], point_y[0], nx_prev, ny_prev,
+                          nx_first, ny_first, joint);
+    }
+    _aafill_draw(&fill, surf, color, 1, drawn_area);
+}
+
 static void
 draw_rect(SDL_Surface *surf, int x1, int y1, int x2, int y2, int width,
           Uint32 color)
@@ -3108,7 +4617,8 @@ draw_round_rect(SDL_Surface *surf, int x1, int y1, int x2, int y2, int radius,
 static PyMethodDef _draw_methods[] = {
     {"aaline", (PyCFunction)aaline, METH_VARARGS | METH_KEYWORDS,
      DOC_DRAW_AALINE},
-    {"line", (PyCFunction)line, METH_VARARGS | METH_KEYWORDS, DOC_DRAW_LINE},
+    {"line", (PyCFunction)line, METH_FASTCALL | METH_KEYWORDS,
+     DOC_DRAW_LINE},
     {"aalines", (PyCFunction)aalines, METH_VARARGS | METH_KEYWORDS,
      DOC_DRAW_AALINES},
     {"lines", (PyCFunction)lines, METH_VARARGS | METH_KEYWORDS,
@@ -3116,18 +4626,46 @@ static PyMethodDef _draw_methods[] = {
     {"ellipse", (PyCFunction)ellipse, METH_VARARGS | METH_KEYWORDS,
      DOC_DRAW_ELLIPSE},
     {"arc", (PyCFunction)arc, METH_VARARGS | METH_KEYWORDS, DOC_DRAW_ARC},
-    {"circle", (PyCFunction)circle, METH_VARARGS | METH_KEYWORDS,
+    {"circle", (PyCFunction)circle, METH_FASTCALL | METH_KEYWORDS,
      DOC_DRAW_CIRCLE},
-    {"aacircle", (PyCFunction)aacircle, METH_VARARGS | METH_KEYWORDS,
+    {"aacircle", (PyCFunction)aacircle, METH_FASTCALL | METH_KEYWORDS,
      DOC_DRAW_AACIRCLE},
+    {"circle_stamp", (PyCFunction)circle_stamp, METH_VARARGS | METH_KEYWORDS,
+     DOC_DRAW_CIRCLESTAMP},
     {"polygon", (PyCFunction)polygon, METH_VARARGS | METH_KEYWORDS,
      DOC_DRAW_POLYGON},
-    {"rect", (PyCFunction)rect, METH_VARARGS | METH_KEYWORDS, DOC_DRAW_RECT},
+    {"aapolygon", (PyCFunction)aapolygon, METH_VARARGS | METH_KEYWORDS,
+     DOC_DRAW_AAPOLYGON},
+    {"rect", (PyCFunction)rect, METH_FASTCALL | METH_KEYWORDS,
+     DOC_DRAW_RECT},
+    {"rects", (PyCFunction)rects, METH_VARARGS | METH_KEYWORDS,
+     DOC_DRAW_RECTS},
+    {"circles", (PyCFunction)circles, METH_VARARGS | METH_KEYWORDS,
+     DOC_DRAW_CIRCLES},
+    {"lines_batch", (PyCFunction)lines_batch, METH_VARARGS | METH_KEYWORDS,
+     DOC_DRAW_LINESBATCH},
 
     {NULL, NULL, 0, NULL}};
 
+/* The horizontal spans are filled with the kernel picked on every call */
+static int
+_draw_simd_dispatch(PyObject *dispatch)
+{
+    int has_avx2 = 0, has_sse2_neon = 0;
+
+#if !defined(__EMSCRIPTEN__)
+    has_avx2 = _pg_has_avx2();
+#if PG_ENABLE_SSE_NEON
+    has_sse2_neon = _pg_HasSSE_NEON();
+#endif /* PG_ENABLE_SSE_NEON */
+#endif /* __EMSCRIPTEN__ */
+    return pg_simd_report(dispatch, "draw_span",
+                          pg_simd_backend_name(has_avx2, has_sse2_neon));
+}
+
 MODINIT_DEFINE(draw)
 {
+    PyObject *module;
     static struct PyModuleDef _module = {PyModuleDef_HEAD_INIT,
                                          "draw",
                                          DOC_DRAW,
@@ -3157,7 +4695,17 @@ MODINIT_DEFINE(draw)
     if (PyErr_Occurred()) {
         return NULL;
     }
+    import_pygame_math();
+    if (PyErr_Occurred()) {
+        return NULL;
+    }
+
+    pg_RegisterSIMDDispatch(_draw_simd_dispatch);
 
     /* create the module */
-    return PyModule_Create(&_module);
+    module = PyModule_Create(&_module);
+    if (module && PG_GIL_NOT_USED(module)) {
+        Py_CLEAR(module);
+    }
+    return module;
 }
@@ -92,6 +92,55 @@ static SDL_TimerID _pg_repeat_timer = 0;
 static SDL_Event _pg_repeat_event;
 static SDL_Event _pg_last_keydown_event = {0};
 
+/* Motion coalescing state, see pygame.event.set_coalesce(). The modes are
+ * 0 (off), 1 (on) or 2 (on, keeping the raw samples). Pending events are
+ * kept in arrival order and flushed onto the queue before any other event
+ * and on every pump. */
+#define PG_COALESCE_PENDING 11
+#define PG_COALESCE_SAMPLES 1024
+
+static int pg_coalesce_mouse = 0;
+static int pg_coalesce_finger = 0;
+static SDL_Event _pg_coalesce_pending[PG_COALESCE_PENDING];
+static int _pg_coalesce_num_pending = 0;
+
+typedef struct {
+    Uint32 type;
+    Uint32 timestamp;
+    float x, y, dx, dy;
+} pgMotionSample;
+
+/* ring buffer, the oldest samples are overwritten when it is full */
+static pgMotionSample _pg_coalesce_samples[PG_COALESCE_SAMPLES];
+static int _pg_coalesce_samples_start = 0;
+static int _pg_coalesce_num_samples = 0;
+
+/* Input log of pygame.event.record() and pygame.event.replay(). The log
+ * is the file format in memory: a header holding the SDL ticks at the
+ * start and the number of pumps recorded, then for each event the pump it
+ * was seen in, the size of its SDL event struct and the struct itself,
+ * which is only valid on the same build and byte order. Events are counted
+ * by pump so a replay hands them to the game on the same frames, however
+ * long those take. */
+#define PG_LOG_MAGIC "PGEV"
+#define PG_LOG_VERSION 1
+#define PG_LOG_HEADER_SIZE 16
+#define PG_LOG_ENTRY_SIZE 6
+
+#define PG_LOG_OFF 0
+#define PG_LOG_RECORD 1
+#define PG_LOG_REPLAY 2
+
+static int _pg_log_mode = PG_LOG_OFF;
+static Uint8 *_pg_log = NULL;
+static size_t _pg_log_size = 0; /* bytes used, or read so far on replay */
+static size_t _pg_log_cap = 0;  /* bytes allocated, or in the replay log */
+static Uint32 _pg_log_pump = 0; /* pumps since the log started */
+static Uint32 _pg_log_shift = 0; /* added to replayed timestamps */
+static PyObject *_pg_log_file = NULL; /* the file of record() */
+/* the thread pushing replayed events, which the filter lets through */
+static SDL_threadID _pg_log_injector = 0;
+
 /* Not used as text, acts as an array of bools */
 static char pressed_keys[SDL_NUM_SCANCODES] = {0};
 static char released_keys[SDL_NUM_SCANCODES] = {0};
@@ -457,6 +506,235 @@ _pg_remove_pending_VIDEOEXPOSE(void *userdata, SDL_Event *event)
     return 1;
 }
 
+/* The coalescing functions below touch state shared with the event filter,
+ * the caller must hold the safety mutex */
+static void
+_pg_coalesce_flush(void)
+{
+    int i;
+    /* SDL_ADDEVENT skips the event filter, these were filtered already */
+    for (i = 0; i < _pg_coalesce_num_pending; i++) {
+        SDL_PeepEvents(&_pg_coalesce_pending[i], 1, SDL_ADDEVENT, 0, 0);
+    }
+    _pg_coalesce_num_pending = 0;
+}
+
+static void
+_pg_coalesce_add_sample(SDL_Event *event)
+{
+    pgMotionSample *sample;
+    int index = (_pg_coalesce_samples_start + _pg_coalesce_num_samples) %
+                PG_COALESCE_SAMPLES;
+
+    if (_pg_coalesce_num_samples < PG_COALESCE_SAMPLES) {
+        _pg_coalesce_num_samples++;
+    }
+    else {
+        _pg_coalesce_samples_start =
+            (_pg_coalesce_samples_start + 1) % PG_COALESCE_SAMPLES;
+    }
+
+    sample = &_pg_coalesce_samples[index];
+    sample->type = event->type;
+    if (event->type == SDL_MOUSEMOTION) {
+        sample->timestamp = event->motion.timestamp;
+        sample->x = (float)event->motion.x;
+        sample->y = (float)event->motion.y;
+        sample->dx = (float)event->motion.xrel;
+        sample->dy = (float)event->motion.yrel;
+    }
+    else {
+        sample->timestamp = event->tfinger.timestamp;
+        sample->x = event->tfinger.x;
+        sample->y = event->tfinger.y;
+        sample->dx = event->tfinger.dx;
+        sample->dy = event->tfinger.dy;
+    }
+}
+
+/* Returns 1 if the event was folded into a pending one and must not be
+ * queued, 0 if it should go through after the pending events. */
+static int
+_pg_coalesce_event(SDL_Event *event)
+{
+    SDL_Event *pending;
+    int i, mode = 0;
+
+    if (event->type == SDL_MOUSEMOTION)
+        mode = pg_coalesce_mouse;
+    else if (event->type == SDL_FINGERMOTION)
+        mode = pg_coalesce_finger;
+
+    if (!mode || !PG_EventEnabled(_pg_pgevent_proxify(event->type))) {
+        _pg_coalesce_flush();
+        return 0;
+    }
+
+    if (mode == 2)
+        _pg_coalesce_add_sample(event);
+
+    for (i = 0; i < _pg_coalesce_num_pending; i++) {
+        pending = &_pg_coalesce_pending[i];
+        if (pending->type != event->type)
+            continue;
+
+        if (event->type == SDL_MOUSEMOTION &&
+            pending->motion.windowID == event->motion.windowID &&
+            pending->motion.which == event->motion.which) {
+            pending->motion.timestamp = event->motion.timestamp;
+            pending->motion.state = event->motion.state;
+            pending->motion.x = event->motion.x;
+            pending->motion.y = event->motion.y;
+            pending->motion.xrel += event->motion.xrel;
+            pending->motion.yrel += event->motion.yrel;
+            return 1;
+        }
+        if (event->type == SDL_FINGERMOTION &&
+            pending->tfinger.touchId == event->tfinger.touchId &&
+            pending->tfinger.fingerId == event->tfinger.fingerId) {
+            pending->tfinger.timestamp = event->tfinger.timestamp;
+            pending->tfinger.x = event->tfinger.x;
+            pending->tfinger.y = event->tfinger.y;
+            pending->tfinger.pressure = event->tfinger.pressure;
+            pending->tfinger.dx += event->tfinger.dx;
+            pending->tfinger.dy += event->tfinger.dy;
+            return 1;
+        }
+    }
+
+    if (_pg_coalesce_num_pending == PG_COALESCE_PENDING)
+        _pg_coalesce_flush();
+    _pg_coalesce_pending[_pg_coalesce_num_pending++] = *event;
+    return 1;
+}
+
+/* Size of the struct of an event the input log keeps, or 0 for events that
+ * are not input, carry pointers or are made by the event filter from input.
+ * Key repeats of set_repeat() are kept so a replay repeats at the same
+ * pumps, the timer is ignored while replaying. */
+static size_t
+_pg_log_event_size(SDL_Event *event)
+{
+    switch (event->type) {
+        case SDL_QUIT:
+            return sizeof(SDL_QuitEvent);
+        case SDL_KEYDOWN:
+        case SDL_KEYUP:
+        case PGE_KEYREPEAT:
+            return sizeof(SDL_KeyboardEvent);
+        case SDL_TEXTEDITING:
+            return sizeof(SDL_TextEditingEvent);
+        case SDL_TEXTINPUT:
+            return sizeof(SDL_TextInputEvent);
+        case SDL_MOUSEMOTION:
+            return sizeof(SDL_MouseMotionEvent);
+        case SDL_MOUSEBUTTONDOWN:
+        case SDL_MOUSEBUTTONUP:
+            if (event->button.button & PGM_BUTTON_KEEP)
+                return 0; /* made from a wheel event */
+            return sizeof(SDL_MouseButtonEvent);
+        case SDL_MOUSEWHEEL:
+            return sizeof(SDL_MouseWheelEvent);
+        case SDL_JOYAXISMOTION:
+            return sizeof(SDL_JoyAxisEvent);
+        case SDL_JOYBALLMOTION:
+            return sizeof(SDL_JoyBallEvent);
+        case SDL_JOYHATMOTION:
+            return sizeof(SDL_JoyHatEvent);
+        case SDL_JOYBUTTONDOWN:
+        case SDL_JOYBUTTONUP:
+            return sizeof(SDL_JoyButtonEvent);
+        case SDL_CONTROLLERAXISMOTION:
+            return sizeof(SDL_ControllerAxisEvent);
+        case SDL_CONTROLLERBUTTONDOWN:
+        case SDL_CONTROLLERBUTTONUP:
+            return sizeof(SDL_ControllerButtonEvent);
+        case SDL_FINGERMOTION:
+        case SDL_FINGERDOWN:
+        case SDL_FINGERUP:
+            return sizeof(SDL_TouchFingerEvent);
+    }
+    return 0;
+}
+
+/* Records an input event, or tells whether a replay drops it because it
+ * comes from the real devices. Live QUIT events always go through, so the
+ * window can be closed during a replay. The caller must hold the safety
+ * mutex. Returns 1 if the event must not be queued. */
+static int
+_pg_log_event(SDL_Event *event)
+{
+    size_t size = _pg_log_event_size(event), cap;
+    Uint8 *grown, *entry;
+    Uint16 size16;
+    Uint32 pump;
+
+    if (!size)
+        return 0;
+
+    if (_pg_log_mode == PG_LOG_REPLAY) {
+        return event->type != SDL_QUIT && SDL_ThreadID() != _pg_log_injector;
+    }
+
+    if (_pg_log_size + PG_LOG_ENTRY_SIZE + size > _pg_log_cap) {
+        cap = _pg_log_cap * 2;
+        if (!(grown = (Uint8 *)SDL_realloc(_pg_log, cap)))
+            return 0; /* out of memory, the event is lost to the log */
+        _pg_log = grown;
+        _pg_log_cap = cap;
+    }
+    entry = _pg_log + _pg_log_size;
+    pump = SDL_SwapLE32(_pg_log_pump);
+    size16 = SDL_SwapLE16((Uint16)size);
+    memcpy(entry, &pump, 4);
+    memcpy(entry + 4, &size16, 2);
+    memcpy(entry + PG_LOG_ENTRY_SIZE, event, size);
+    _pg_log_size += PG_LOG_ENTRY_SIZE + size;
+    return 0;
+}
+
+/* Pushes the replayed events of the pumps so far through the event filter
+ * and ends the replay after the last one. Called on the thread that pumps,
+ * the only one touching the replay log. The safety mutex is not held while
+ * pushing, as SDL holds its own lock around the filter. */
+static void
+_pg_log_replay(void)
+{
+    SDL_Event event;
+    Uint32 pump;
+    Uint16 size;
+
+    _pg_log_injector = SDL_ThreadID();
+    while (_pg_log_size + PG_LOG_ENTRY_SIZE <= _pg_log_cap) {
+        memcpy(&pump, _pg_log + _pg_log_size, 4);
+        memcpy(&size, _pg_log + _pg_log_size + 4, 2);
+        pump = SDL_SwapLE32(pump);
+        size = SDL_SwapLE16(size);
+        if (pump > _pg_log_pump)
+            break;
+
+        _pg_log_size += PG_LOG_ENTRY_SIZE;
+        if (size > sizeof(SDL_Event) || _pg_log_size + size > _pg_log_cap) {
+            _pg_log_size = _pg_log_cap; /* truncated, checked on load */
+            break;
+        }
+        memset(&event, 0, sizeof(event));
+        memcpy(&event, _pg_log + _pg_log_size, size);
+        _pg_log_size += size;
+        event.common.timestamp += _pg_log_shift;
+        SDL_PushEvent(&event);
+    }
+    _pg_log_injector = 0;
+
+    if (_pg_log_size + PG_LOG_ENTRY_SIZE > _pg_log_cap) {
+        PG_LOCK_EVFILTER_MUTEX
+        _pg_log_mode = PG_LOG_OFF;
+        PG_UNLOCK_EVFILTER_MUTEX
+        SDL_free(_pg_log);
+        _pg_log = NULL;
+    }
+}
+
 /* SDL 2 to SDL 1.2 event mapping and SDL 1.2 key repeat emulation,
  * this can alter events in-place.
  * This function can be called from multiple threads, so a mutex must be held
@@ -468,6 +746,22 @@ pg_event_filter(void *_, SDL_Event *event)
     SDL_Event newdownevent, newupevent, newevent = *event;
     int x, y, i;
 
+    if (_pg_log_mode) {
+        PG_LOCK_EVFILTER_MUTEX
+        i = _pg_log_mode && _pg_log_event(event);
+        PG_UNLOCK_EVFILTER_MUTEX
+        if (i)
+            return 0;
+    }
+
+    if (pg_coalesce_mouse || pg_coalesce_finger || _pg_coalesce_num_pending) {
+        PG_LOCK_EVFILTER_MUTEX
+        i = _pg_coalesce_event(event);
+        PG_UNLOCK_EVFILTER_MUTEX
+        if (i)
+            return 0;
+    }
+
     if (event->type == SDL_WINDOWEVENT) {
         /* DON'T filter SDL_WINDOWEVENTs here. If we delete events, they
          * won't be available to low-level SDL2 either.*/
@@ -637,7 +931,18 @@ pgEvent_AutoQuit(PyObject *self, PyObject *_null)
             SDL_RemoveTimer(_pg_repeat_timer);
             _pg_repeat_timer = 0;
         }
+        pg_coalesce_mouse = pg_coalesce_finger = 0;
+        _pg_coalesce_num_pending = 0;
+        _pg_coalesce_num_samples = 0;
+        if (_pg_log_mode == PG_LOG_REPLAY) {
+            _pg_log_mode = PG_LOG_OFF;
+            SDL_free(_pg_log);
+            _pg_log = NULL;
+        }
         PG_UNLOCK_EVFILTER_MUTEX
+        /* a recording running until quit is written out now */
+        if (_pg_log_mode == PG_LOG_RECORD && _pg_log_finish() < 0)
+            PyErr_WriteUnraisable(NULL);
         /* The main reason for _custom_event to be reset here is so we
          * can have a unit test that checks if pygame.event.custom_type()
          * stops returning new types when they are finished, without that
@@ -916,6 +1221,88 @@ get_joy_device_index(int instance_id)
     return PyLong_FromLong(device_index);
 }
 
+/* Returns a new reference to the pygame Window the event was sent to,
+ * None if it has no Window object, or NULL without an exception set for
+ * events that carry no window id. */
+static PyObject *
+_pg_event_window(SDL_Event *event)
+{
+    SDL_Window *window;
+    switch (event->type) {
+        case PGE_WINDOWSHOWN:
+        case PGE_WINDOWHIDDEN:
+        case PGE_WINDOWEXPOSED:
+        case PGE_WINDOWMOVED:
+        case PGE_WINDOWRESIZED:
+        case PGE_WINDOWSIZECHANGED:
+        case PGE_WINDOWMINIMIZED:
+        case PGE_WINDOWMAXIMIZED:
+        case PGE_WINDOWRESTORED:
+        case PGE_WINDOWENTER:
+        case PGE_WINDOWLEAVE:
+        case PGE_WINDOWFOCUSGAINED:
+        case PGE_WINDOWFOCUSLOST:
+        case PGE_WINDOWCLOSE:
+        case PGE_WINDOWTAKEFOCUS:
+        case PGE_WINDOWHITTEST:
+        case PGE_WINDOWICCPROFCHANGED:
+        case PGE_WINDOWDISPLAYCHANGED: {
+            window = SDL_GetWindowFromID(event->window.windowID);
+            break;
+        }
+        case SDL_TEXTEDITING: {
+            window = SDL_GetWindowFromID(event->edit.windowID);
+            break;
+        }
+        case SDL_TEXTINPUT: {
+            window = SDL_GetWindowFromID(event->text.windowID);
+            break;
+        }
+        case SDL_DROPBEGIN:
+        case SDL_DROPCOMPLETE:
+        case SDL_DROPTEXT:
+        case SDL_DROPFILE: {
+            window = SDL_GetWindowFromID(event->drop.windowID);
+            break;
+        }
+        case SDL_KEYDOWN:
+        case SDL_KEYUP: {
+            window = SDL_GetWindowFromID(event->key.windowID);
+            break;
+        }
+        case SDL_MOUSEWHEEL: {
+            window = SDL_GetWindowFromID(event->wheel.windowID);
+            break;
+        }
+        case SDL_MOUSEMOTION: {
+            window = SDL_GetWindowFromID(event->motion.windowID);
+            break;
+        }
+        case SDL_MOUSEBUTTONDOWN:
+        case SDL_MOUSEBUTTONUP: {
+            window = SDL_GetWindowFromID(event->button.windowID);
+            break;
+        }
+#if SDL_VERSION_ATLEAST(2, 0, 14)
+        case SDL_FINGERMOTION:
+        case SDL_FINGERDOWN:
+        case SDL_FINGERUP: {
+            window = SDL_GetWindowFromID(event->tfinger.windowID);
+            break;
+        }
+#endif
+        default: {
+            return NULL;
+        }
+    }
+    PyObject *pgWindow;
+    if (!window || !(pgWindow = SDL_GetWindowData(window, "pg_window"))) {
+        pgWindow = Py_None;
+    }
+    Py_INCREF(pgWindow);
+    return pgWindow;
+}
+
 static PyObject *
 dict_from_event(SDL_Event *event)
 {
@@ -1261,8 +1648,39 @@ dict_from_event(SDL_Event *event)
     } /* switch (event->type) */
     /* Events that don't have any attributes are not handled in switch
      * statement */
-    SDL_Window *window;
-    switch (event->type) {
+    PyObject *pgWindow = _pg_event_window(event);
+    if (pgWindow) {
+        _pg_insobj(dict, "window", pgWindow);
+    }
+    return dict;
+}
+
+/* event object internals */
+
+/* Events whose attributes are plain values copied into the SDL_Event can
+ * have their dict built on first use. Everything else has side effects in
+ * dict_from_event (proxy refcounts, freeing drop strings, the unicode key
+ * table, joystick index lookups) and must be converted right away. The
+ * window is looked up up front by pgEvent_New, it may be gone later. */
+static int
+_pg_event_can_defer(Uint32 type)
+{
+    switch (type) {
+        case SDL_MOUSEMOTION:
+        case SDL_MOUSEBUTTONDOWN:
+        case SDL_MOUSEBUTTONUP:
+        case SDL_MOUSEWHEEL:
+        case SDL_FINGERMOTION:
+        case SDL_FINGERDOWN:
+        case SDL_FINGERUP:
+        case SDL_MULTIGESTURE:
+        case SDL_CONTROLLERAXISMOTION:
+        case SDL_CONTROLLERBUTTONDOWN:
+        case SDL_CONTROLLERBUTTONUP:
+        case SDL_TEXTINPUT:
+        case SDL_TEXTEDITING:
+        case SDL_VIDEORESIZE:
+        case SDL_ACTIVEEVENT:
         case PGE_WINDOWSHOWN:
         case PGE_WINDOWHIDDEN:
         case PGE_WINDOWEXPOSED:
@@ -1280,71 +1698,35 @@ dict_from_event(SDL_Event *event)
         case PGE_WINDOWTAKEFOCUS:
         case PGE_WINDOWHITTEST:
         case PGE_WINDOWICCPROFCHANGED:
-        case PGE_WINDOWDISPLAYCHANGED: {
-            window = SDL_GetWindowFromID(event->window.windowID);
-            break;
-        }
-        case SDL_TEXTEDITING: {
-            window = SDL_GetWindowFromID(event->edit.windowID);
-            break;
-        }
-        case SDL_TEXTINPUT: {
-            window = SDL_GetWindowFromID(event->text.windowID);
-            break;
-        }
-        case SDL_DROPBEGIN:
-        case SDL_DROPCOMPLETE:
-        case SDL_DROPTEXT:
-        case SDL_DROPFILE: {
-            window = SDL_GetWindowFromID(event->drop.windowID);
-            break;
-        }
-        case SDL_KEYDOWN:
-        case SDL_KEYUP: {
-            window = SDL_GetWindowFromID(event->key.windowID);
-            break;
-        }
-        case SDL_MOUSEWHEEL: {
-            window = SDL_GetWindowFromID(event->wheel.windowID);
-            break;
-        }
-        case SDL_MOUSEMOTION: {
-            window = SDL_GetWindowFromID(event->motion.windowID);
-            break;
-        }
-        case SDL_MOUSEBUTTONDOWN:
-        case SDL_MOUSEBUTTONUP: {
-            window = SDL_GetWindowFromID(event->button.windowID);
-            break;
-        }
-#if SDL_VERSION_ATLEAST(2, 0, 14)
-        case SDL_FINGERMOTION:
-        case SDL_FINGERDOWN:
-        case SDL_FINGERUP: {
-            window = SDL_GetWindowFromID(event->tfinger.windowID);
-            break;
-        }
-#endif
-        default: {
-            return dict;
-        }
+        case PGE_WINDOWDISPLAYCHANGED:
+            return 1;
+        default:
+            return 0;
     }
-    PyObject *pgWindow;
-    if (!window || !(pgWindow = SDL_GetWindowData(window, "pg_window"))) {
-        pgWindow = Py_None;
-    }
-    Py_INCREF(pgWindow);
-    _pg_insobj(dict, "window", pgWindow);
-    return dict;
 }
 
-/* event object internals */
+/* Returns a borrowed reference to the attribute dict, building it from the
+ * stored SDL_Event if that has not happened yet. */
+static PyObject *
+_pg_event_get_dict(pgEventObject *e)
+{
+    if (!e->dict) {
+        e->dict = dict_from_event(&e->event);
+        if (e->dict && e->window &&
+            PyDict_SetItemString(e->dict, "window", e->window)) {
+            Py_CLEAR(e->dict);
+        }
+        Py_CLEAR(e->window);
+    }
+    return e->dict;
+}
 
 static void
 pg_event_dealloc(PyObject *self)
 {
     pgEventObject *e = (pgEventObject *)self;
     Py_XDECREF(e->dict);
+    Py_XDECREF(e->window);
     Py_TYPE(self)->tp_free(self);
 }
 
@@ -1354,7 +1736,11 @@ PyObject *
 pg_EventGetAttr(PyObject *o, PyObject *attr_name)
 {
     /* Try e->dict first, if not try the generic attribute. */
-    PyObject *result = PyDict_GetItem(((pgEventObject *)o)->dict, attr_name);
+    PyObject *result, *dict = _pg_event_get_dict((pgEventObject *)o);
+    if (!dict) {
+        return NULL;
+    }
+    result = PyDict_GetItem(dict, attr_name);
     if (!result) {
         return PyObject_GenericGetAttr(o, attr_name);
     }
@@ -1370,7 +1756,11 @@ pg_EventSetAttr(PyObject *o, PyObject *name, PyObject *value)
     */
     int dictResult;
     int setInDict = 0;
-    PyObject *result = PyDict_GetItem(((pgEventObject *)o)->dict, name);
+    PyObject *result, *dict = _pg_event_get_dict((pgEventObject *)o);
+    if (!dict) {
+        return -1;
+    }
+    result = PyDict_GetItem(dict, name);
 
     if (result) {
         setInDict = 1;
@@ -1384,7 +1774,7 @@ pg_EventSetAttr(PyObject *o, PyObject *name, PyObject *value)
     }
 
     if (setInDict) {
-        dictResult = PyDict_SetItem(((pgEventObject *)o)->dict, name, value);
+        dictResult = PyDict_SetItem(dict, name, value);
         if (dictResult) {
             return -1;
         }
@@ -1394,14 +1784,48 @@ pg_EventSetAttr(PyObject *o, PyObject *name, PyObject *value)
         return PyObject_GenericSetAttr(o, name, value);
     }
 }
-#endif
+#else /* ~PYPY_VERSION */
+static PyObject *
+pg_EventGetAttr(PyObject *o, PyObject *attr_name)
+{
+    PyObject *result;
+
+    /* type and the methods do not need the dict, so only build it once a
+     * lookup misses */
+    if (!((pgEventObject *)o)->dict) {
+        result = PyObject_GenericGetAttr(o, attr_name);
+        if (result || !PyErr_ExceptionMatches(PyExc_AttributeError)) {
+            return result;
+        }
+        PyErr_Clear();
+        if (!_pg_event_get_dict((pgEventObject *)o)) {
+            return NULL;
+        }
+    }
+    return PyObject_GenericGetAttr(o, attr_name);
+}
+
+static int
+pg_EventSetAttr(PyObject *o, PyObject *name, PyObject *value)
+{
+    /* the generic setter would put an empty dict in the slot otherwise */
+    if (!_pg_event_get_dict((pgEventObject *)o)) {
+        return -1;
+    }
+    return PyObject_GenericSetAttr(o, name, value);
+}
+#endif /* ~PYPY_VERSION */
 
 PyObject *
 pg_event_str(PyObject *self)
 {
     pgEventObject *e = (pgEventObject *)self;
+    PyObject *dict = _pg_event_get_dict(e);
+    if (!dict) {
+        return NULL;
+    }
     return PyUnicode_FromFormat("<Event(%d-%s %S)>", e->type,
-                                _pg_name_from_eventtype(e->type), e->dict);
+                                _pg_name_from_eventtype(e->type), dict);
 }
 
 static int
@@ -1419,9 +1843,21 @@ static PyTypeObject pgEvent_Type;
 #define OFF(x) offsetof(pgEventObject, x)
 
 static PyMemberDef pg_event_members[] = {
-    {"__dict__", T_OBJECT, OFF(dict), READONLY},
     {"type", T_INT, OFF(type), READONLY},
-    {"dict", T_OBJECT, OFF(dict), READONLY},
+    {NULL} /* Sentinel */
+};
+
+static PyObject *
+pg_event_get_dict_attr(pgEventObject *self, void *closure)
+{
+    PyObject *dict = _pg_event_get_dict(self);
+    Py_XINCREF(dict);
+    return dict;
+}
+
+static PyGetSetDef pg_event_getsets[] = {
+    {"__dict__", (getter)pg_event_get_dict_attr, NULL, NULL, NULL},
+    {"dict", (getter)pg_event_get_dict_attr, NULL, NULL, NULL},
     {NULL} /* Sentinel */
 };
 
@@ -1440,6 +1876,9 @@ pg_event_richcompare(PyObject *o1, PyObject *o2, int opid)
 
     e1 = (pgEventObject *)o1;
     e2 = (pgEventObject *)o2;
+    if (!_pg_event_get_dict(e1) || !_pg_event_get_dict(e2)) {
+        return NULL;
+    }
     switch (opid) {
         case Py_EQ:
             return PyBool_FromLong(
@@ -1514,16 +1953,12 @@ static PyTypeObject pgEvent_Type = {
     .tp_dealloc = pg_event_dealloc,
     .tp_repr = pg_event_str,
     .tp_as_number = &pg_event_as_number,
-#ifdef PYPY_VERSION
     .tp_getattro = pg_EventGetAttr,
     .tp_setattro = pg_EventSetAttr,
-#else
-    .tp_getattro = PyObject_GenericGetAttr,
-    .tp_setattro = PyObject_GenericSetAttr,
-#endif
     .tp_doc = DOC_EVENT_EVENT,
     .tp_richcompare = pg_event_richcompare,
     .tp_members = pg_event_members,
+    .tp_getset = pg_event_getsets,
     .tp_dictoffset = offsetof(pgEventObject, dict),
     .tp_init = (initproc)pg_event_init,
     .tp_new = PyType_GenericNew,
@@ -1537,7 +1972,17 @@ pgEvent_New(SDL_Event *event)
     if (!e)
         return PyErr_NoMemory();
 
-    if (event) {
+    e->window = NULL;
+    if (event && _pg_event_can_defer(event->type)) {
+        /* most events in a get() loop are only checked for their type, so
+         * keep the raw event and build the dict when it is first needed */
+        e->type = _pg_pgevent_deproxify(event->type);
+        e->event = *event;
+        e->dict = NULL;
+        e->window = _pg_event_window(event);
+        return (PyObject *)e;
+    }
+    else if (event) {
         e->type = _pg_pgevent_deproxify(event->type);
         e->dict = dict_from_event(event);
     }
@@ -1552,6 +1997,197 @@ pgEvent_New(SDL_Event *event)
     return (PyObject *)e;
 }
 
+/* channel object internals */
+
+/* A single producer, single consumer ring of fixed size slots. Each slot is
+ * a Uint32 length followed by item_size bytes of payload. head and tail only
+ * ever grow (wrapping at 2^32), the producer alone stores head and the
+ * consumer alone stores tail, so neither side needs a lock. */
+typedef struct {
+    PyObject_HEAD char *slots;
+    Uint32 capacity;
+    Uint32 item_size;
+    SDL_atomic_t head;
+    SDL_atomic_t tail;
+    /* set once a wakeup event was posted, cleared by drain() */
+    SDL_atomic_t notified;
+    int eventtype;
+} pgChannelObject;
+
+#define CHANNEL_SLOT(ch, index) \
+    ((ch)->slots +              \
+     (size_t)((index) % (ch)->capacity) * (sizeof(Uint32) + (ch)->item_size))
+
+/* Push a payload onto a channel. Does not need the GIL, but only one thread
+ * may push to a given channel at a time. Returns 1 on success, 0 if the
+ * channel is full and -1 if the payload is larger than the item size. */
+static int
+pgChannel_Push(PyObject *obj, const void *data, Py_ssize_t len)
+{
+    pgChannelObject *ch = (pgChannelObject *)obj;
+    Uint32 head = (Uint32)SDL_AtomicGet(&ch->head);
+    Uint32 tail = (Uint32)SDL_AtomicGet(&ch->tail);
+    char *slot;
+
+    if (len < 0 || (size_t)len > ch->item_size)
+        return -1;
+    if (head - tail >= ch->capacity)
+        return 0;
+
+    slot = CHANNEL_SLOT(ch, head);
+    *(Uint32 *)slot = (Uint32)len;
+    memcpy(slot + sizeof(Uint32), data, len);
+    /* publishes the slot, SDL_AtomicSet is a full barrier */
+    SDL_AtomicSet(&ch->head, (int)(head + 1));
+
+    if (ch->eventtype >= 0 && SDL_AtomicCAS(&ch->notified, 0, 1)) {
+        /* posting without a dict does not need the GIL either */
+        pg_post_event((Uint32)ch->eventtype, NULL);
+    }
+    return 1;
+}
+
+static int
+channel_init(pgChannelObject *self, PyObject *args, PyObject *kwargs)
+{
+    int capacity = 1024, item_size = 64, eventtype = -1;
+    PyObject *obj_eventtype = Py_None;
+    static char *kwids[] = {"capacity", "item_size", "eventtype", NULL};
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "|iiO", kwids, &capacity,
+                                     &item_size, &obj_eventtype))
+        return -1;
+
+    if (capacity <= 0 || item_size <= 0) {
+        PyErr_SetString(PyExc_ValueError,
+                        "capacity and item_size must be positive");
+        return -1;
+    }
+    if (obj_eventtype != Py_None) {
+        eventtype = (int)PyLong_AsLong(obj_eventtype);
+        if (eventtype == -1 && PyErr_Occurred())
+            return -1;
+        if (eventtype < 0 || eventtype >= PG_NUMEVENTS) {
+            PyErr_SetString(PyExc_ValueError, "event type out of range");
+            return -1;
+        }
+    }
+
+    if (self->slots) {
+        PyErr_SetString(PyExc_RuntimeError, "Channel is already initialized");
+        return -1;
+    }
+    self->slots =
+        PyMem_Malloc((size_t)capacity * (sizeof(Uint32) + (size_t)item_size));
+    if (!self->slots) {
+        PyErr_NoMemory();
+        return -1;
+    }
+    self->capacity = (Uint32)capacity;
+    self->item_size = (Uint32)item_size;
+    self->eventtype = eventtype;
+    SDL_AtomicSet(&self->head, 0);
+    SDL_AtomicSet(&self->tail, 0);
+    SDL_AtomicSet(&self->notified, 0);
+    return 0;
+}
+
+static void
+channel_dealloc(pgChannelObject *self)
+{
+    PyMem_Free(self->slots);
+    Py_TYPE(self)->tp_free((PyObject *)self);
+}
+
+static PyObject *
+channel_push(pgChannelObject *self, PyObject *arg)
+{
+    Py_buffer view;
+    int ret;
+
+    if (!self->slots)
+        return RAISE(PyExc_RuntimeError, "Channel is not initialized");
+    if (PyObject_GetBuffer(arg, &view, PyBUF_SIMPLE))
+        return NULL;
+
+    ret = pgChannel_Push((PyObject *)self, view.buf, view.len);
+    PyBuffer_Release(&view);
+
+    if (ret < 0)
+        return RAISE(PyExc_ValueError, "payload is larger than item_size");
+    return PyBool_FromLong(ret);
+}
+
+static PyObject *
+channel_drain(pgChannelObject *self, PyObject *args, PyObject *kwargs)
+{
+    int max = -1;
+    Uint32 head, tail, count, i;
+    PyObject *list, *item;
+    char *slot;
+    static char *kwids[] = {"max", NULL};
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "|i", kwids, &max))
+        return NULL;
+    if (!self->slots)
+        return RAISE(PyExc_RuntimeError, "Channel is not initialized");
+
+    /* clear first, so a push racing with this drain posts a new wakeup */
+    SDL_AtomicSet(&self->notified, 0);
+    tail = (Uint32)SDL_AtomicGet(&self->tail);
+    head = (Uint32)SDL_AtomicGet(&self->head);
+    count = head - tail;
+    if (max >= 0 && (Uint32)max < count)
+        count = (Uint32)max;
+
+    list = PyList_New(count);
+    if (!list)
+        return NULL;
+    for (i = 0; i < count; i++) {
+        slot = CHANNEL_SLOT(self, tail + i);
+        item = PyBytes_FromStringAndSize(slot + sizeof(Uint32),
+                                         *(Uint32 *)slot);
+        if (!item) {
+            Py_DECREF(list);
+            return NULL;
+        }
+        PyList_SET_ITEM(list, i, item);
+    }
+    /* hands the slots back to the producer */
+    SDL_AtomicSet(&self->tail, (int)(tail + count));
+    return list;
+}
+
+static Py_ssize_t
+channel_len(pgChannelObject *self)
+{
+    if (!self->slots)
+        return 0;
+    return (Uint32)SDL_AtomicGet(&self->head) -
+           (Uint32)SDL_AtomicGet(&self->tail);
+}
+
+static PyMethodDef channel_methods[] = {
+    {"push", (PyCFunction)channel_push, METH_O, DOC_EVENT_CHANNEL_PUSH},
+    {"drain", (PyCFunction)channel_drain, METH_VARARGS | METH_KEYWORDS,
+     DOC_EVENT_CHANNEL_DRAIN},
+    {NULL, NULL, 0, NULL}};
+
+static PySequenceMethods channel_as_sequence = {
+    .sq_length = (lenfunc)channel_len,
+};
+
+static PyTypeObject pgChannel_Type = {
+    PyVarObject_HEAD_INIT(NULL, 0).tp_name = "pygame.event.Channel",
+    .tp_basicsize = sizeof(pgChannelObject),
+    .tp_dealloc = (destructor)channel_dealloc,
+    .tp_as_sequence = &channel_as_sequence,
+    .tp_doc = DOC_EVENT_CHANNEL,
+    .tp_methods = channel_methods,
+    .tp_init = (initproc)channel_init,
+    .tp_new = PyType_GenericNew,
+};
+
 /* event module functions */
 
 static PyObject *
@@ -1616,6 +2252,24 @@ _pg_event_pump(int dopump)
         memset(released_mouse_buttons, 0, sizeof(released_mouse_buttons));
 
         SDL_PumpEvents();
+
+        /* events recorded by now are seen on the next pump, so a replay
+         * pushes them right after pumping the same number of times */
+        if (_pg_log_mode == PG_LOG_REPLAY)
+            _pg_log_replay();
+        if (_pg_log_mode) {
+            PG_LOCK_EVFILTER_MUTEX
+            _pg_log_pump++;
+            PG_UNLOCK_EVFILTER_MUTEX
+        }
+    }
+
+    /* Motion folded by the event filter waits for the next event, make it
+     * visible now that this batch is done */
+    if (_pg_coalesce_num_pending) {
+        PG_LOCK_EVFILTER_MUTEX
+        _pg_coalesce_flush();
+        PG_UNLOCK_EVFILTER_MUTEX
     }
 
     /* We need to translate WINDOWEVENTS. But if we do that from the
@@ -1631,13 +2285,17 @@ _pg_event_wait(SDL_Event *event, int timeout)
     /* Custom re-implementation of SDL_WaitEventTimeout, doing this has
      * many advantages. This is copied from SDL source code, with a few
      * minor modifications */
-    Uint64 finish = 0;
+    Uint64 finish = 0, now;
+    int dopump = 1;
+#if SDL_VERSION_ATLEAST(2, 0, 16)
+    int slice;
+#endif
 
     if (timeout > 0)
         finish = PG_GetTicks() + timeout;
 
     while (1) {
-        _pg_event_pump(1); /* Use our custom pump here */
+        _pg_event_pump(dopump); /* Use our custom pump here */
         switch (PG_PEEP_EVENT_ALL(event, 1, SDL_GETEVENT)) {
             case -1:
                 return 0; /* Because this never happens, SDL does it too*/
@@ -1645,11 +2303,30 @@ _pg_event_wait(SDL_Event *event, int timeout)
                 return 1;
 
             default:
-                if (timeout >= 0 && PG_GetTicks() >= finish) {
+                now = PG_GetTicks();
+                if (timeout >= 0 && now >= finish) {
                     /* no events */
                     return 0;
                 }
+#if SDL_VERSION_ATLEAST(2, 0, 16)
+                /* Sleep in the OS until an event arrives instead of polling.
+                 * SDL_PushEvent wakes this up, so posted events and timers
+                 * are seen right away. Passing NULL leaves the event on the
+                 * queue for the peep above. */
+                slice = timeout >= 0 ? (int)(finish - now) : -1;
+                if (pg_coalesce_mouse || pg_coalesce_finger ||
+                    _pg_log_mode == PG_LOG_REPLAY) {
+                    /* motion folded by the filter and replayed events never
+                     * reach the queue on their own, so keep coming back to
+                     * flush and push them */
+                    slice = 1;
+                }
+                /* SDL pumped the events already, don't reset the key and
+                 * button state gathered there */
+                dopump = !SDL_WaitEventTimeout(NULL, slice);
+#else
                 SDL_Delay(1);
+#endif
         }
     }
 }
@@ -1821,114 +2498,113 @@ pgEvent_GetMouseButtonUpInfo(void)
     return released_mouse_buttons;
 }
 
-static PyObject *
-_pg_get_all_events_except(PyObject *obj)
+/* State for pulling a subset of the queue out in one ordered pass */
+typedef struct {
+    int *types;
+    Py_ssize_t num_types;
+    int exclude;
+    SDL_Event *events;
+    int len;
+    int capacity;
+    int failed;
+} pgEventGather;
+
+/* Called by SDL_FilterEvents with the queue locked, for every queued event
+ * in order. Returning 0 removes the event from the queue. This must not
+ * touch python or the event filter mutex. */
+static int SDLCALL
+_pg_gather_events(void *userdata, SDL_Event *event)
 {
-    SDL_Event event;
-    Py_ssize_t len;
-    int loop, type, ret;
-    PyObject *seq, *list;
-
-    SDL_Event *filtered_events;
-    int filtered_index = 0;
-    int filtered_events_len = 16;
-
-    SDL_Event eventbuf[PG_GET_LIST_LEN];
-
-    filtered_events = malloc(sizeof(SDL_Event) * filtered_events_len);
-    if (!filtered_events)
-        return PyErr_NoMemory();
+    pgEventGather *gather = (pgEventGather *)userdata;
+    int type = (int)_pg_pgevent_deproxify(event->type);
+    int match = 0;
+    Py_ssize_t i;
+    SDL_Event *new_events;
+
+    for (i = 0; i < gather->num_types; i++) {
+        if (gather->types[i] == type) {
+            match = 1;
+            break;
+        }
+    }
+    if (match == gather->exclude || gather->failed)
+        return 1;
 
-    list = PyList_New(0);
-    if (!list) {
-        free(filtered_events);
-        return PyErr_NoMemory();
+    if (gather->len == gather->capacity) {
+        new_events = realloc(gather->events,
+                             sizeof(SDL_Event) * gather->capacity * 4);
+        if (!new_events) {
+            gather->failed = 1;
+            return 1;
+        }
+        gather->events = new_events;
+        gather->capacity *= 4;
     }
+    gather->events[gather->len++] = *event;
+    return 0;
+}
+
+/* Removes the events of the given types (or, with exclude, of every other
+ * type) from the queue and returns them as a list, in queue order. This is
+ * a single pass over the queue however many types are given. */
+static PyObject *
+_pg_get_events_filtered(PyObject *obj, int exclude)
+{
+    pgEventGather gather = {NULL, 0, exclude, NULL, 0, 16, 0};
+    PyObject *seq, *list = NULL;
+    Py_ssize_t len;
+    int loop;
 
     seq = _pg_eventtype_as_seq(obj, &len);
     if (!seq)
-        goto error;
+        return NULL;
+    if (len < 0) {
+        Py_DECREF(seq);
+        return NULL;
+    }
 
-    for (loop = 0; loop < len; loop++) {
-        type = _pg_eventtype_from_seq(seq, loop);
-        if (type == -1)
-            goto error;
+    gather.types = PyMem_New(int, len ? len : 1);
+    gather.events = malloc(sizeof(SDL_Event) * gather.capacity);
+    if (!gather.types || !gather.events) {
+        PyErr_NoMemory();
+        goto end;
+    }
 
-        do {
-            ret = PG_PEEP_EVENT(&event, 1, SDL_GETEVENT, type);
-            if (ret < 0) {
-                PyErr_SetString(pgExc_SDLError, SDL_GetError());
-                goto error;
-            }
-            else if (ret > 0) {
-                if (filtered_index == filtered_events_len) {
-                    SDL_Event *new_filtered_events =
-                        malloc(sizeof(SDL_Event) * filtered_events_len * 4);
-                    if (new_filtered_events == NULL) {
-                        goto error;
-                    }
-                    memcpy(new_filtered_events, filtered_events,
-                           sizeof(SDL_Event) * filtered_events_len);
-                    filtered_events_len *= 4;
-                    free(filtered_events);
-                    filtered_events = new_filtered_events;
-                }
-                filtered_events[filtered_index] = event;
-                filtered_index++;
-            }
-        } while (ret);
-        do {
-            ret = PG_PEEP_EVENT(&event, 1, SDL_GETEVENT,
-                                _pg_pgevent_proxify(type));
-            if (ret < 0) {
-                PyErr_SetString(pgExc_SDLError, SDL_GetError());
-                goto error;
-            }
-            else if (ret > 0) {
-                if (filtered_index == filtered_events_len) {
-                    SDL_Event *new_filtered_events =
-                        malloc(sizeof(SDL_Event) * filtered_events_len * 4);
-                    if (new_filtered_events == NULL) {
-                        free(filtered_events);
-                        goto error;
-                    }
-                    memcpy(new_filtered_events, filtered_events,
-                           sizeof(SDL_Event) * filtered_events_len);
-                    filtered_events_len *= 4;
-                    free(filtered_events);
-                    filtered_events = new_filtered_events;
-                }
-                filtered_events[filtered_index] = event;
-                filtered_index++;
-            }
-        } while (ret);
+    for (loop = 0; loop < len; loop++) {
+        gather.types[loop] = _pg_eventtype_from_seq(seq, loop);
+        if (gather.types[loop] == -1)
+            goto end;
     }
+    gather.num_types = len;
 
-    do {
-        len = PG_PEEP_EVENT_ALL(eventbuf, PG_GET_LIST_LEN, SDL_GETEVENT);
-        if (len == -1) {
-            PyErr_SetString(pgExc_SDLError, SDL_GetError());
-            goto error;
-        }
+    SDL_FilterEvents(_pg_gather_events, &gather);
 
-        for (loop = 0; loop < len; loop++) {
-            if (!_pg_event_append_to_list(list, &eventbuf[loop]))
-                goto error;
+    list = PyList_New(0);
+    if (!list)
+        goto end;
+
+    for (loop = 0; loop < gather.len; loop++) {
+        if (!_pg_event_append_to_list(list, &gather.events[loop])) {
+            Py_CLEAR(list);
+            goto end;
         }
-    } while (len == PG_GET_LIST_LEN);
+    }
 
-    PG_PEEP_EVENT_ALL(filtered_events, filtered_index, SDL_ADDEVENT);
+    /* if growing the buffer failed, the events that did not fit are still
+     * queued and are returned by the next call */
 
-    free(filtered_events);
+end:
+    /* While doing a goto here with a NULL list, PyErr must be set */
+    free(gather.events);
+    PyMem_Free(gather.types);
     Py_DECREF(seq);
     return list;
+}
 
-error:
-    /* While doing a goto here, PyErr must be set */
-    free(filtered_events);
-    Py_DECREF(list);
-    Py_XDECREF(seq);
-    return NULL;
+static PyObject *
+_pg_get_all_events_except(PyObject *obj)
+{
+    return _pg_get_events_filtered(obj, 1);
 }
 
 static PyObject *
@@ -1964,56 +2640,7 @@ error:
 static PyObject *
 _pg_get_seq_events(PyObject *obj)
 {
-    Py_ssize_t len;
-    SDL_Event event;
-    int loop, type, ret;
-    PyObject *seq, *list;
-
-    list = PyList_New(0);
-    if (!list)
-        return PyErr_NoMemory();
-
-    seq = _pg_eventtype_as_seq(obj, &len);
-    if (!seq)
-        goto error;
-
-    for (loop = 0; loop < len; loop++) {
-        type = _pg_eventtype_from_seq(seq, loop);
-        if (type == -1)
-            goto error;
-
-        do {
-            ret = PG_PEEP_EVENT(&event, 1, SDL_GETEVENT, type);
-            if (ret < 0) {
-                PyErr_SetString(pgExc_SDLError, SDL_GetError());
-                goto error;
-            }
-            else if (ret > 0) {
-                if (!_pg_event_append_to_list(list, &event))
-                    goto error;
-            }
-        } while (ret);
-        do {
-            ret = PG_PEEP_EVENT(&event, 1, SDL_GETEVENT,
-                                _pg_pgevent_proxify(type));
-            if (ret < 0) {
-                PyErr_SetString(pgExc_SDLError, SDL_GetError());
-                goto error;
-            }
-            else if (ret > 0) {
-                if (!_pg_event_append_to_list(list, &event))
-                    goto error;
-            }
-        } while (ret);
-    }
-    Py_DECREF(seq);
-    return list;
-
-error:
-    /* While doing a goto here, PyErr must be set */
-    Py_DECREF(list);
-    Py_XDECREF(seq);
-    return NULL;
+    return _pg_get_events_filtered(obj, 0);
 }
 
 static PyObject *
@@ -2021,7 +2648,9 @@ pg_event_get(PyObject *self, PyObject *args, PyObject *kwargs)
 {
     PyObject *obj_evtype = NULL;
     PyObject *obj_exclude = NULL;
+    PyObject *result;
     int dopump = 1;
+    PG_PERF_START(perf_start);
 
     static char *kwids[] = {"eventtype", "pump", "exclude", NULL};
 
@@ -2035,9 +2664,11 @@ pg_event_get(PyObject *self, PyObject *args, PyObject *kwargs)
 
     if (obj_evtype == NULL || obj_evtype == Py_None) {
         if (obj_exclude != NULL && obj_exclude != Py_None) {
-            return _pg_get_all_events_except(obj_exclude);
+            result = _pg_get_all_events_except(obj_exclude);
+        }
+        else {
+            result = _pg_get_all_events();
         }
-        return _pg_get_all_events();
     }
     else {
         if (obj_exclude != NULL && obj_exclude != Py_None) {
@@ -2045,8 +2676,198 @@ pg_event_get(PyObject *self, PyObject *args, PyObject *kwargs)
                 pgExc_SDLError,
                 "Invalid combination of excluded and included event type");
         }
-        return _pg_get_seq_events(obj_evtype);
+        result = _pg_get_seq_events(obj_evtype);
+    }
+
+    PG_PERF_STOP(perf_start, PG_PERF_EVENT, 0);
+    return result;
+}
+
+/* Fixed layout record written by pygame.event.get_into(), documented as the
+ * struct format "=IIiiiiiiiIiI". Fields that do not apply to an event type
+ * are left at zero. */
+typedef struct {
+    Uint32 type;
+    Uint32 timestamp;
+    Sint32 x;
+    Sint32 y;
+    Sint32 rel_x;
+    Sint32 rel_y;
+    Sint32 button;
+    Sint32 key;
+    Sint32 scancode;
+    Uint32 mod;
+    Sint32 which;
+    Uint32 touch;
+} pgEventRecord;
+
+/* touch coordinates are normalized floats, store them as 16.16 fixed point */
+#define PG_RECORD_FIXED(v) ((Sint32)((v)*65536.0f))
+
+static void
+_pg_event_to_record(SDL_Event *event, pgEventRecord *rec)
+{
+    int hx, hy;
+
+    memset(rec, 0, sizeof(pgEventRecord));
+    rec->type = _pg_pgevent_deproxify(event->type);
+    rec->timestamp = event->common.timestamp;
+
+    if (event->type >= PGPOST_EVENTBEGIN) {
+        /* posted events carry a dict that has no place in a record, release
+         * it the same way dict_from_event would */
+        PyObject *dict = dict_from_event(event);
+        Py_XDECREF(dict);
+        PyErr_Clear();
+        return;
+    }
+
+    switch (event->type) {
+        case SDL_VIDEORESIZE:
+        case PGE_WINDOWMOVED:
+        case PGE_WINDOWRESIZED:
+        case PGE_WINDOWSIZECHANGED:
+        case PGE_WINDOWDISPLAYCHANGED:
+            rec->x = event->window.data1;
+            rec->y = event->window.data2;
+            break;
+        case SDL_KEYDOWN:
+        case SDL_KEYUP:
+            rec->key = event->key.keysym.sym;
+            rec->scancode = event->key.keysym.scancode;
+            rec->mod = event->key.keysym.mod;
+            break;
+        case SDL_MOUSEMOTION:
+            rec->x = event->motion.x;
+            rec->y = event->motion.y;
+            rec->rel_x = event->motion.xrel;
+            rec->rel_y = event->motion.yrel;
+            rec->button = (Sint32)event->motion.state;
+            rec->which = (Sint32)event->motion.which;
+            rec->touch = event->motion.which == SDL_TOUCH_MOUSEID;
+            break;
+        case SDL_MOUSEBUTTONDOWN:
+        case SDL_MOUSEBUTTONUP:
+            rec->x = event->button.x;
+            rec->y = event->button.y;
+            rec->button = event->button.button;
+            rec->which = (Sint32)event->button.which;
+            rec->touch = event->button.which == SDL_TOUCH_MOUSEID;
+            break;
+        case SDL_MOUSEWHEEL:
+            rec->x = event->wheel.x;
+            rec->y = event->wheel.y;
+            rec->which = (Sint32)event->wheel.which;
+            rec->touch = event->wheel.which == SDL_TOUCH_MOUSEID;
+            break;
+        case SDL_JOYAXISMOTION:
+            rec->which = event->jaxis.which;
+            rec->button = event->jaxis.axis;
+            rec->x = event->jaxis.value;
+            break;
+        case SDL_JOYBALLMOTION:
+            rec->which = event->jball.which;
+            rec->button = event->jball.ball;
+            rec->rel_x = event->jball.xrel;
+            rec->rel_y = event->jball.yrel;
+            break;
+        case SDL_JOYHATMOTION:
+            rec->which = event->jhat.which;
+            rec->button = event->jhat.hat;
+            hx = hy = 0;
+            if (event->jhat.value & SDL_HAT_UP)
+                hy = 1;
+            else if (event->jhat.value & SDL_HAT_DOWN)
+                hy = -1;
+            if (event->jhat.value & SDL_HAT_RIGHT)
+                hx = 1;
+            else if (event->jhat.value & SDL_HAT_LEFT)
+                hx = -1;
+            rec->x = hx;
+            rec->y = hy;
+            break;
+        case SDL_JOYBUTTONUP:
+        case SDL_JOYBUTTONDOWN:
+            rec->which = event->jbutton.which;
+            rec->button = event->jbutton.button;
+            break;
+        case SDL_CONTROLLERAXISMOTION:
+            rec->which = event->caxis.which;
+            rec->button = event->caxis.axis;
+            rec->x = event->caxis.value;
+            break;
+        case SDL_CONTROLLERBUTTONDOWN:
+        case SDL_CONTROLLERBUTTONUP:
+            rec->which = event->cbutton.which;
+            rec->button = event->cbutton.button;
+            break;
+        case SDL_FINGERMOTION:
+        case SDL_FINGERDOWN:
+        case SDL_FINGERUP:
+            rec->which = (Sint32)event->tfinger.fingerId;
+            rec->x = PG_RECORD_FIXED(event->tfinger.x);
+            rec->y = PG_RECORD_FIXED(event->tfinger.y);
+            rec->rel_x = PG_RECORD_FIXED(event->tfinger.dx);
+            rec->rel_y = PG_RECORD_FIXED(event->tfinger.dy);
+            rec->touch = 1;
+            break;
+        case SDL_DROPFILE:
+        case SDL_DROPTEXT:
+            SDL_free(event->drop.file);
+            break;
+    }
+}
+
+static PyObject *
+pg_event_get_into(PyObject *self, PyObject *args, PyObject *kwargs)
+{
+    SDL_Event eventbuf[PG_GET_LIST_LEN];
+    Py_buffer view;
+    PyObject *obj;
+    pgEventRecord *records;
+    Py_ssize_t capacity, count = 0;
+    int loop, len, want;
+    int dopump = 1;
+
+    static char *kwids[] = {"buffer", "pump", NULL};
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "O|p", kwids, &obj,
+                                     &dopump))
+        return NULL;
+
+    VIDEO_INIT_CHECK();
+
+    if (PyObject_GetBuffer(obj, &view, PyBUF_WRITABLE | PyBUF_C_CONTIGUOUS))
+        return NULL;
+
+    capacity = view.len / (Py_ssize_t)sizeof(pgEventRecord);
+    records = (pgEventRecord *)view.buf;
+
+    _pg_event_pump(dopump);
+
+    /* only take as many events as fit, the rest stays on the queue for the
+     * next call */
+    while (count < capacity) {
+        want = capacity - count < PG_GET_LIST_LEN ? (int)(capacity - count)
+                                                  : PG_GET_LIST_LEN;
+        len = PG_PEEP_EVENT_ALL(eventbuf, want, SDL_GETEVENT);
+        if (len == -1) {
+            PyBuffer_Release(&view);
+            return RAISE(pgExc_SDLError, SDL_GetError());
+        }
+
+        for (loop = 0; loop < len; loop++) {
+            pgEventRecord rec;
+            _pg_event_to_record(&eventbuf[loop], &rec);
+            /* the buffer need not be aligned, e.g. a slice of a bytearray */
+            memcpy(records + count++, &rec, sizeof(pgEventRecord));
+        }
+        if (len < want)
+            break;
     }
+
+    PyBuffer_Release(&view);
+    return PyLong_FromSsize_t(count);
 }
 
 static PyObject *
@@ -2121,6 +2942,8 @@ pg_event_post(PyObject *self, PyObject *obj)
         return RAISE(PyExc_TypeError, "argument must be an Event object");
 
     pgEventObject *e = (pgEventObject *)obj;
+    if (!_pg_event_get_dict(e))
+        return NULL;
     switch (pg_post_event(e->type, e->dict)) {
         case 0:
             Py_RETURN_FALSE;
@@ -2229,6 +3052,248 @@ pg_event_get_blocked(PyObject *self, PyObject *obj)
     return PyBool_FromLong(isblocked);
 }
 
+static PyObject *
+pg_event_set_coalesce(PyObject *self, PyObject *args, PyObject *kwargs)
+{
+    int type, coalesce = 1, keep_samples = 0;
+    static char *kwids[] = {"eventtype", "coalesce", "keep_samples", NULL};
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "i|pp", kwids, &type,
+                                     &coalesce, &keep_samples))
+        return NULL;
+
+    if (type != SDL_MOUSEMOTION && type != SDL_FINGERMOTION)
+        return RAISE(PyExc_ValueError,
+                     "only MOUSEMOTION and FINGERMOTION can be coalesced");
+
+    VIDEO_INIT_CHECK();
+
+    PG_LOCK_EVFILTER_MUTEX
+    if (type == SDL_MOUSEMOTION)
+        pg_coalesce_mouse = coalesce ? 1 + keep_samples : 0;
+    else
+        pg_coalesce_finger = coalesce ? 1 + keep_samples : 0;
+    if (!coalesce)
+        _pg_coalesce_flush();
+    PG_UNLOCK_EVFILTER_MUTEX
+
+    Py_RETURN_NONE;
+}
+
+static PyObject *
+pg_event_get_samples(PyObject *self, PyObject *_null)
+{
+    pgMotionSample *sample;
+    PyObject *list, *item;
+    int i;
+
+    VIDEO_INIT_CHECK();
+
+    PG_LOCK_EVFILTER_MUTEX
+    list = PyList_New(_pg_coalesce_num_samples);
+    for (i = 0; list && i < _pg_coalesce_num_samples; i++) {
+        sample = &_pg_coalesce_samples[(_pg_coalesce_samples_start + i) %
+                                       PG_COALESCE_SAMPLES];
+        if (sample->type == SDL_MOUSEMOTION) {
+            item = Py_BuildValue("(IIiiii)", sample->type, sample->timestamp,
+                                 (int)sample->x, (int)sample->y,
+                                 (int)sample->dx, (int)sample->dy);
+        }
+        else {
+            item = Py_BuildValue("(IIdddd)", sample->type, sample->timestamp,
+                                 (double)sample->x, (double)sample->y,
+                                 (double)sample->dx, (double)sample->dy);
+        }
+        if (!item) {
+            Py_CLEAR(list);
+            break;
+        }
+        PyList_SET_ITEM(list, i, item);
+    }
+    if (list) {
+        _pg_coalesce_samples_start = _pg_coalesce_num_samples = 0;
+    }
+    PG_UNLOCK_EVFILTER_MUTEX
+
+    return list;
+}
+
+/* Ends a recording, writing its log to the file given to record(). Returns
+ * -1 with an exception set on failure. */
+static int
+_pg_log_finish(void)
+{
+    PyObject *file = _pg_log_file, *oencoded, *ret;
+    Uint8 *log;
+    size_t size;
+    Uint32 count;
+    SDL_RWops *rw;
+    int result;
+
+    PG_LOCK_EVFILTER_MUTEX
+    log = _pg_log;
+    size = _pg_log_size;
+    count = SDL_SwapLE32(_pg_log_pump);
+    _pg_log = NULL;
+    _pg_log_file = NULL;
+    _pg_log_mode = PG_LOG_OFF;
+    PG_UNLOCK_EVFILTER_MUTEX
+
+    /* the header ends with the number of pumps recorded */
+    memcpy(log + 12, &count, 4);
+
+    oencoded = pg_EncodeString(file, "UTF-8", NULL, pgExc_SDLError);
+    if (oencoded == Py_None) {
+        ret = PyObject_CallMethod(file, "write", "y#", (char *)log,
+                                  (Py_ssize_t)size);
+        result = ret ? 0 : -2;
+        Py_XDECREF(ret);
+    }
+    else if (oencoded) {
+        const char *name = PyBytes_AS_STRING(oencoded);
+
+        Py_BEGIN_ALLOW_THREADS;
+        rw = SDL_RWFromFile(name, "wb");
+        if (!rw) {
+            result = -1;
+        }
+        else {
+            result = SDL_RWwrite(rw, log, size, 1) == 1 ? 0 : -1;
+            if (SDL_RWclose(rw) < 0) {
+                result = -1;
+            }
+        }
+        Py_END_ALLOW_THREADS;
+    }
+    else {
+        result = -2;
+    }
+    Py_XDECREF(oencoded);
+    Py_DECREF(file);
+    SDL_free(log);
+
+    if (result == -1)
+        PyErr_SetString(pgExc_SDLError, SDL_GetError());
+    return result ? -1 : 0;
+}
+
+static PyObject *
+pg_event_record(PyObject *self, PyObject *obj)
+{
+    PyObject *oencoded;
+    Uint8 *log;
+    Uint32 version = SDL_SwapLE32(PG_LOG_VERSION), ticks;
+
+    VIDEO_INIT_CHECK();
+
+    if (_pg_log_mode == PG_LOG_REPLAY)
+        return RAISE(pgExc_SDLError, "cannot record during a replay");
+    if (_pg_log_mode == PG_LOG_RECORD && _pg_log_finish() < 0)
+        return NULL;
+    if (obj == Py_None)
+        Py_RETURN_NONE;
+
+    /* the file is only written to at the end, check it can be now */
+    oencoded = pg_EncodeString(obj, "UTF-8", NULL, pgExc_SDLError);
+    if (!oencoded)
+        return NULL;
+    Py_DECREF(oencoded);
+    if (oencoded == Py_None && !PyObject_HasAttrString(obj, "write"))
+        return RAISE(PyExc_TypeError,
+                     "record() needs a path or a writable file object");
+
+    if (!(log = (Uint8 *)SDL_malloc(65536)))
+        return PyErr_NoMemory();
+    ticks = SDL_GetTicks();
+    memcpy(log, PG_LOG_MAGIC, 4);
+    memcpy(log + 4, &version, 4);
+    ticks = SDL_SwapLE32(ticks);
+    memcpy(log + 8, &ticks, 4);
+    memset(log + 12, 0, 4);
+
+    Py_INCREF(obj);
+    PG_LOCK_EVFILTER_MUTEX
+    _pg_log = log;
+    _pg_log_size = PG_LOG_HEADER_SIZE;
+    _pg_log_cap = 65536;
+    _pg_log_pump = 0;
+    _pg_log_file = obj;
+    _pg_log_mode = PG_LOG_RECORD;
+    PG_UNLOCK_EVFILTER_MUTEX
+
+    Py_RETURN_NONE;
+}
+
+static PyObject *
+pg_event_replay(PyObject *self, PyObject *obj)
+{
+    SDL_RWops *rw;
+    Uint8 *log, *grown;
+    size_t size = 0, cap = 65536, n;
+    Uint32 version, ticks;
+
+    VIDEO_INIT_CHECK();
+
+    if (_pg_log_mode == PG_LOG_RECORD)
+        return RAISE(pgExc_SDLError, "cannot replay during a recording");
+
+    if (_pg_log_mode == PG_LOG_REPLAY) {
+        PG_LOCK_EVFILTER_MUTEX
+        _pg_log_mode = PG_LOG_OFF;
+        PG_UNLOCK_EVFILTER_MUTEX
+        SDL_free(_pg_log);
+        _pg_log = NULL;
+    }
+    if (obj == Py_None)
+        Py_RETURN_NONE;
+
+    if (!(rw = pgRWops_FromObject(obj, NULL)))
+        return NULL;
+    log = (Uint8 *)SDL_malloc(cap);
+    while (log) {
+        if (size == cap) {
+            grown = (Uint8 *)SDL_realloc(log, cap * 2);
+            if (!grown) {
+                SDL_free(log);
+                log = NULL;
+                break;
+            }
+            log = grown;
+            cap *= 2;
+        }
+        n = SDL_RWread(rw, log + size, 1, cap - size);
+        if (!n)
+            break;
+        size += n;
+    }
+    SDL_RWclose(rw);
+    if (!log)
+        return PyErr_NoMemory();
+
+    if (size < PG_LOG_HEADER_SIZE || memcmp(log, PG_LOG_MAGIC, 4)) {
+        SDL_free(log);
+        return RAISE(pgExc_SDLError, "not a pygame input log");
+    }
+    memcpy(&version, log + 4, 4);
+    if (SDL_SwapLE32(version) != PG_LOG_VERSION) {
+        SDL_free(log);
+        return RAISE(pgExc_SDLError, "unsupported input log version");
+    }
+    memcpy(&ticks, log + 8, 4);
+
+    PG_LOCK_EVFILTER_MUTEX
+    _pg_log = log;
+    _pg_log_size = PG_LOG_HEADER_SIZE;
+    _pg_log_cap = size;
+    _pg_log_pump = 0;
+    /* replayed timestamps keep their distance to the start of the log */
+    _pg_log_shift = SDL_GetTicks() - SDL_SwapLE32(ticks);
+    _pg_log_mode = PG_LOG_REPLAY;
+    PG_UNLOCK_EVFILTER_MUTEX
+
+    Py_RETURN_NONE;
+}
+
 static PyObject *
 pg_event_custom_type(PyObject *self, PyObject *_null)
 {
@@ -2258,6 +3323,8 @@ static PyMethodDef _event_methods[] = {
      DOC_EVENT_CLEAR},
     {"get", (PyCFunction)pg_event_get, METH_VARARGS | METH_KEYWORDS,
      DOC_EVENT_GET},
+    {"get_into", (PyCFunction)pg_event_get_into, METH_VARARGS | METH_KEYWORDS,
+     DOC_EVENT_GETINTO},
     {"peek", (PyCFunction)pg_event_peek, METH_VARARGS | METH_KEYWORDS,
      DOC_EVENT_PEEK},
     {"post", (PyCFunction)pg_event_post, METH_O, DOC_EVENT_POST},
@@ -2268,8 +3335,14 @@ static PyMethodDef _event_methods[] = {
      DOC_EVENT_SETBLOCKED},
     {"get_blocked", (PyCFunction)pg_event_get_blocked, METH_O,
      DOC_EVENT_GETBLOCKED},
+    {"record", (PyCFunction)pg_event_record, METH_O, DOC_EVENT_RECORD},
+    {"replay", (PyCFunction)pg_event_replay, METH_O, DOC_EVENT_REPLAY},
     {"custom_type", (PyCFunction)pg_event_custom_type, METH_NOARGS,
      DOC_EVENT_CUSTOMTYPE},
+    {"set_coalesce", (PyCFunction)pg_event_set_coalesce,
+     METH_VARARGS | METH_KEYWORDS, DOC_EVENT_SETCOALESCE},
+    {"get_samples", (PyCFunction)pg_event_get_samples, METH_NOARGS,
+     DOC_EVENT_GETSAMPLES},
 
     {NULL, NULL, 0, NULL}};
 
@@ -2301,10 +3374,18 @@ MODINIT_DEFINE(event)
         return NULL;
     }
 
+    import_pygame_rwobject();
+    if (PyErr_Occurred()) {
+        return NULL;
+    }
+
     /* type preparation */
     if (PyType_Ready(&pgEvent_Type) < 0) {
         return NULL;
     }
+    if (PyType_Ready(&pgChannel_Type) < 0) {
+        return NULL;
+    }
 
     /* create the module */
     module = PyModule_Create(&_module);
@@ -2324,9 +3405,15 @@ MODINIT_DEFINE(event)
         Py_DECREF(module);
         return NULL;
     }
+    Py_INCREF(&pgChannel_Type);
+    if (PyModule_AddObject(module, "Channel", (PyObject *)&pgChannel_Type)) {
+        Py_DECREF(&pgChannel_Type);
+        Py_DECREF(module);
+        return NULL;
+    }
 
     /* export the c api */
-    assert(PYGAMEAPI_EVENT_NUMSLOTS == 10);
+    assert(PYGAMEAPI_EVENT_NUMSLOTS == 11);
     c_api[0] = &pgEvent_Type;
     c_api[1] = pgEvent_New;
     c_api[2] = pg_post_event;
@@ -2337,6 +3424,7 @@ MODINIT_DEFINE(event)
     c_api[7] = pgEvent_GetKeyUpInfo;
     c_api[8] = pgEvent_GetMouseButtonDownInfo;
     c_api[9] = pgEvent_GetMouseButtonUpInfo;
+    c_api[10] = pgChannel_Push;
 
     apiobj = encapsulate_api(c_api, "event");
     if (PyModule_AddObject(module, PYGAMEAPI_LOCAL_ENTRY, apiobj)) {
@@ -23,6 +23,7 @@
 /*
  *  font module for pygame
  */
+#define PG_SURFACE_ORIGIN PG_SURF_ORIGIN_FONT
 #define PYGAMEAPI_FONT_INTERNAL
 #include "font.h"
 
@@ -62,8 +63,37 @@ PyFont_New(TTF_Font *);
 
 static unsigned int current_ttf_generation = 0;
 
-#define PgFont_GenerationCheck(x) \
-    (((PyFontObject *)(x))->ttf_init_generation == current_ttf_generation)
+/* Font.render() rasterises without the GIL, holding its font's lock.
+ * font_renders_active counts those renders, for font.quit() to wait on. */
+static int font_renders_active = 0;
+static PyObject *font_executor = NULL; /* runs Font.render_async() */
+
+/* Take the font's lock, with the GIL held once it returns. */
+static void
+_font_lock(PyFontObject *self)
+{
+    while (!PyThread_acquire_lock(self->lock, NOWAIT_LOCK)) {
+        Py_BEGIN_ALLOW_THREADS;
+        PyThread_acquire_lock(self->lock, WAIT_LOCK);
+        PyThread_release_lock(self->lock);
+        Py_END_ALLOW_THREADS;
+    }
+}
+
+static void
+_font_wait_idle(PyFontObject *self)
+{
+    if (self->lock) {
+        _font_lock(self);
+        PyThread_release_lock(self->lock);
+    }
+}
+
+/* Every Font method starts with this check, so it also waits for a render
+ * of the font running on another thread. */
+#define PgFont_GenerationCheck(x)            \
+    (_font_wait_idle((PyFontObject *)(x)), \
+     ((PyFontObject *)(x))->ttf_init_generation == current_ttf_generation)
 
 #if defined(BUILD_STATIC)
 // SDL_Init + TTF_Init()  are made in main before CPython process the module
@@ -152,6 +182,21 @@ fontmodule_init(PyObject *self, PyObject *_null)
 static PyObject *
 fontmodule_quit(PyObject *self, PyObject *_null)
 {
+    if (font_executor) {
+        PyObject *result = PyObject_CallMethod(font_executor, "shutdown", NULL);
+
+        Py_CLEAR(font_executor);
+        if (!result) {
+            return NULL;
+        }
+        Py_DECREF(result);
+    }
+    while (font_renders_active) {
+        Py_BEGIN_ALLOW_THREADS;
+        SDL_Delay(1);
+        Py_END_ALLOW_THREADS;
+    }
+
     if (font_initialized) {
         TTF_Quit();
         font_initialized = 0;
@@ -538,6 +583,302 @@ font_set_strikethrough(PyObject *self, PyObject *arg)
     Py_RETURN_NONE;
 }
 
+/* Rendered text cache
+ *
+ * Keys are (text, antialias, color, background, wraplength, style, align,
+ * point size) tuples, with the colors packed into integers and a background
+ * of -1 without bgcolor. Entries are (surface, surface version, size)
+ * tuples, so a shared surface that has been changed since it was rendered is
+ * rendered again. The script and direction can't be read back from the
+ * font, so setting them clears the cache instead.
+ */
+struct pgFontRenderCache {
+    PyObject *entries; /* key -> entry, least recently used first */
+    Py_ssize_t max_bytes;
+    Py_ssize_t bytes;
+    Py_ssize_t hits;
+    Py_ssize_t misses;
+    Py_ssize_t evictions;
+};
+
+/* Returns pgSurface_GetVersion(surfobj) + 1, or 0 if surfobj is locked */
+static Uint64
+_font_cache_version(PyObject *surfobj)
+{
+    SDL_Surface *surf = pgSurface_AsSurface(surfobj);
+
+    if (!surf || surf->locked) {
+        return 0;
+    }
+    return pgSurface_GetVersion((pgSurfaceObject *)surfobj) + 1;
+}
+
+/* Also forgets the measured text sizes, anything that changes how text
+ * renders changes its size too */
+static void
+_font_cache_clear(PyFontObject *self)
+{
+    Py_CLEAR(self->size_cache);
+    if (self->render_cache) {
+        PyDict_Clear(self->render_cache->entries);
+        self->render_cache->bytes = 0;
+    }
+}
+
+static void
+_font_cache_free(PyFontObject *self)
+{
+    Py_CLEAR(self->size_cache);
+    if (self->render_cache) {
+        Py_DECREF(self->render_cache->entries);
+        PyMem_Free(self->render_cache);
+        self->render_cache = NULL;
+    }
+}
+
+static int
+_font_cache_remove(struct pgFontRenderCache *cache, PyObject *key,
+                   PyObject *entry)
+{
+    cache->bytes -= PyLong_AsSsize_t(PyTuple_GET_ITEM(entry, 2));
+    return PyDict_DelItem(cache->entries, key);
+}
+
+/* Removes least recently used entries until there is room for nbytes */
+static int
+_font_cache_evict(struct pgFontRenderCache *cache, Py_ssize_t nbytes)
+{
+    PyObject *key, *entry;
+    Py_ssize_t pos;
+    int result;
+
+    while (cache->bytes + nbytes > cache->max_bytes &&
+           PyDict_Size(cache->entries) > 0) {
+        pos = 0;
+        PyDict_Next(cache->entries, &pos, &key, &entry);
+        Py_INCREF(key);
+        result = _font_cache_remove(cache, key, entry);
+        Py_DECREF(key);
+        if (result) {
+            return -1;
+        }
+        cache->evictions++;
+    }
+    return 0;
+}
+
+/* Looks up a rendered surface. Returns 1 with a new reference in *result on
+ * a hit, 0 on a miss and -1 on error. On a miss, *key is set to the key the
+ * surface should be stored under with _font_cache_store, or NULL if the cache
+ * is disabled. */
+static int
+_font_cache_lookup(PyFontObject *self, PyObject *text, int antialias,
+                   SDL_Color fg, SDL_Color *bg, int wraplength,
+                   PyObject **key, PyObject **result)
+{
+    struct pgFontRenderCache *cache = self->render_cache;
+    TTF_Font *font = PyFont_AsFont(self);
+    PyObject *entry, *cached;
+    long background = -1;
+    int align = 0;
+
+    *key = NULL;
+    if (!cache) {
+        return 0;
+    }
+    if (bg) {
+        background = ((long)bg->r << 16) | ((long)bg->g << 8) | bg->b;
+    }
+#if SDL_TTF_VERSION_ATLEAST(2, 20, 0)
+    align = TTF_GetFontWrappedAlign(font);
+#endif
+
+    *key = Py_BuildValue("(Oilliiii)", text, antialias,
+                         ((long)fg.r << 16) | ((long)fg.g << 8) | fg.b,
+                         background, wraplength, TTF_GetFontStyle(font),
+                         align, self->ptsize);
+    if (!*key) {
+        return -1;
+    }
+    entry = PyDict_GetItemWithError(cache->entries, *key);
+    if (!entry) {
+        if (PyErr_Occurred()) {
+            Py_CLEAR(*key);
+            return -1;
+        }
+        cache->misses++;
+        return 0;
+    }
+
+    cached = PyTuple_GET_ITEM(entry, 0);
+    if (PyLong_AsUnsignedLongLong(PyTuple_GET_ITEM(entry, 1)) !=
+        _font_cache_version(cached)) {
+        /* stale, the shared surface has been changed */
+        if (_font_cache_remove(cache, *key, entry)) {
+            Py_CLEAR(*key);
+            return -1;
+        }
+        cache->misses++;
+        return 0;
+    }
+
+    /* move to the most recently used end */
+    Py_INCREF(entry);
+    if (PyDict_DelItem(cache->entries, *key) ||
+        PyDict_SetItem(cache->entries, *key, entry)) {
+        Py_DECREF(entry);
+        Py_CLEAR(*key);
+        return -1;
+    }
+    Py_DECREF(entry);
+    Py_CLEAR(*key);
+
+    cache->hits++;
+    Py_INCREF(cached);
+    *result = cached;
+    return 1;
+}
+
+/* Stores a rendered surface under the key from _font_cache_lookup, stealing
+ * the key. Returns -1 on error. */
+static int
+_font_cache_store(PyFontObject *self, PyObject *key, PyObject *result)
+{
+    struct pgFontRenderCache *cache = self->render_cache;
+    SDL_Surface *surf = pgSurface_AsSurface(result);
+    Py_ssize_t nbytes = (Py_ssize_t)surf->h * surf->pitch;
+    Uint64 version = _font_cache_version(result);
+    PyObject *entry;
+
+    if (!cache || !version || nbytes > cache->max_bytes) {
+        Py_DECREF(key);
+        return 0;
+    }
+    if (_font_cache_evict(cache, nbytes)) {
+        Py_DECREF(key);
+        return -1;
+    }
+
+    entry = Py_BuildValue("(OKn)", result, (unsigned long long)version,
+                          nbytes);
+    if (!entry || PyDict_SetItem(cache->entries, key, entry)) {
+        Py_XDECREF(entry);
+        Py_DECREF(key);
+        return -1;
+    }
+    Py_DECREF(entry);
+    Py_DECREF(key);
+    cache->bytes += nbytes;
+    return 0;
+}
+
+static PyObject *
+font_enable_cache(PyObject *self, PyObject *arg)
+{
+    PyFontObject *fontobj = (PyFontObject *)self;
+    struct pgFontRenderCache *cache = fontobj->render_cache;
+    Py_ssize_t max_bytes = PyLong_AsSsize_t(arg);
+
+    if (max_bytes == -1 && PyErr_Occurred()) {
+        return NULL;
+    }
+    if (max_bytes <= 0) {
+        return RAISE(PyExc_ValueError, "max_bytes must be positive");
+    }
+    if (!cache) {
+        cache = PyMem_New(struct pgFontRenderCache, 1);
+        if (!cache) {
+            return PyErr_NoMemory();
+        }
+        cache->entries = PyDict_New();
+        if (!cache->entries) {
+            PyMem_Free(cache);
+            return NULL;
+        }
+        cache->bytes = 0;
+        fontobj->render_cache = cache;
+    }
+    cache->max_bytes = max_bytes;
+    cache->hits = cache->misses = cache->evictions = 0;
+    if (_font_cache_evict(cache, 0)) {
+        return NULL;
+    }
+    Py_RETURN_NONE;
+}
+
+static PyObject *
+font_disable_cache(PyObject *self, PyObject *_null)
+{
+    _font_cache_free((PyFontObject *)self);
+    Py_RETURN_NONE;
+}
+
+static PyObject *
+font_clear_cache(PyObject *self, PyObject *_null)
+{
+    _font_cache_clear((PyFontObject *)self);
+    Py_RETURN_NONE;
+}
+
+static PyObject *
+font_get_cache_stats(PyObject *self, PyObject *_null)
+{
+    struct pgFontRenderCache *cache = ((PyFontObject *)self)->render_cache;
+
+    if (!cache) {
+        return Py_BuildValue("{sisisisisisi}", "hits", 0, "misses", 0,
+                             "evictions", 0, "entries", 0, "bytes", 0,
+                             "max_bytes", 0);
+    }
+    return Py_BuildValue("{snsnsnsnsnsn}", "hits", cache->hits, "misses",
+                         cache->misses, "evictions", cache->evictions,
+                         "entries", PyDict_Size(cache->entries), "bytes",
+                         cache->bytes, "max_bytes", cache->max_bytes);
+}
+
+/* Render text the way Font.render() does. This runs without the GIL, so
+ * it must not touch any Python object. */
+static SDL_Surface *
+_font_render_text(TTF_Font *font, const char *astring, int antialias,
+                  int has_bg, SDL_Color foreg, SDL_Color backg,
+                  int wraplength)
+{
+    SDL_Surface *surf;
+
+    if (antialias && !has_bg) {
+#if SDL_TTF_VERSION_ATLEAST(2, 0, 18)
+        surf =
+            TTF_RenderUTF8_Blended_Wrapped(font, astring, foreg, wraplength);
+#else
+        surf = TTF_RenderUTF8_Blended(font, astring, foreg);
+#endif
+    }
+    else if (antialias) {
+#if SDL_TTF_VERSION_ATLEAST(2, 0, 18)
+        surf = TTF_RenderUTF8_Shaded_Wrapped(font, astring, foreg, backg,
+                                             wraplength);
+#else
+        surf = TTF_RenderUTF8_Shaded(font, astring, foreg, backg);
+#endif
+    }
+    else {
+#if SDL_TTF_VERSION_ATLEAST(2, 0, 18)
+        surf = TTF_RenderUTF8_Solid_Wrapped(font, astring, foreg, wraplength);
+#else
+        surf = TTF_RenderUTF8_Solid(font, astring, foreg);
+#endif
+        /* If an explicit background was provided and the rendering options
+        resolve to Render_Solid, that needs to be explicitly handled. */
+        if (surf != NULL && has_bg) {
+            SDL_SetColorKey(surf, 0, 0);
+            surf->format->palette->colors[0].r = backg.r;
+            surf->format->palette->colors[0].g = backg.g;
+            surf->format->palette->colors[0].b = backg.b;
+        }
+    }
+    return surf;
+}
+
 static PyObject *
 font_render(PyObject *self, PyObject *args, PyObject *kwds)
 {
@@ -547,7 +888,7 @@ font_render(PyObject *self, PyObject *args, PyObject *kwds)
 
     TTF_Font *font = PyFont_AsFont(self);
     int antialias;
-    PyObject *text, *final;
+    PyObject *text, *final, *key;
     PyObject *fg_rgba_obj, *bg_rgba_obj = Py_None;
     Uint8 rgba[] = {0, 0, 0, 0};
     SDL_Surface *surf;
@@ -616,69 +957,517 @@ font_render(PyObject *self, PyObject *args, PyObject *kwds)
     /* if text is Py_None, leave astring as a null byte to represent 0
        length string */
 
+    switch (_font_cache_lookup((PyFontObject *)self, text, antialias, foreg,
+                               bg_rgba_obj != Py_None ? &backg : NULL,
+                               wraplength, &key, &final)) {
+        case 1:
+            return final;
+        case -1:
+            return NULL;
+    }
+
+    /* only the renders are counted, not the cache hits */
+    PG_PERF_START(perf_start);
     if (strlen(astring) == 0) { /* special 0 string case */
         int height = TTF_FontHeight(font);
         surf = PG_CreateSurface(0, height, PG_PIXELFORMAT_XRGB8888);
     }
     else { /* normal case */
-        if (antialias && bg_rgba_obj == Py_None) {
-#if SDL_TTF_VERSION_ATLEAST(2, 0, 18)
-            surf = TTF_RenderUTF8_Blended_Wrapped(font, astring, foreg,
-                                                  wraplength);
-#else
-            surf = TTF_RenderUTF8_Blended(font, astring, foreg);
-#endif
+        PyFontObject *fontobj = (PyFontObject *)self;
+
+        if (!fontobj->lock && !(fontobj->lock = PyThread_allocate_lock())) {
+            Py_XDECREF(key);
+            return PyErr_NoMemory();
         }
-        else if (antialias) {
+        _font_lock(fontobj);
+        font_renders_active++;
+        Py_BEGIN_ALLOW_THREADS;
+        surf = _font_render_text(font, astring, antialias,
+                                 bg_rgba_obj != Py_None, foreg, backg,
+                                 wraplength);
+        Py_END_ALLOW_THREADS;
+        font_renders_active--;
+        PyThread_release_lock(fontobj->lock);
+    }
+
+    PG_PERF_STOP(perf_start, PG_PERF_TEXT,
+                 surf ? (Uint64)surf->w * surf->h : 0);
+    if (surf == NULL) {
+        Py_XDECREF(key);
+        return RAISE(pgExc_SDLError, TTF_GetError());
+    }
+
+    final = (PyObject *)pgSurface_New(surf);
+    if (final == NULL) {
+        SDL_FreeSurface(surf);
+        Py_XDECREF(key);
+        return NULL;
+    }
+    if (key && _font_cache_store((PyFontObject *)self, key, final)) {
+        Py_DECREF(final);
+        return NULL;
+    }
+    return final;
+}
+
+static PyObject *
+font_render_async(PyObject *self, PyObject *args, PyObject *kwds)
+{
+    PyObject *render, *submit, *submit_args, *future;
+    Py_ssize_t i, nargs = PyTuple_GET_SIZE(args);
+
+    if (!PgFont_GenerationCheck(self)) {
+        return RAISE_FONT_QUIT_ERROR();
+    }
+
+    /* One worker, so futures complete in the order they were made */
+    if (!font_executor) {
+        PyObject *futures = PyImport_ImportModule("concurrent.futures");
+
+        if (!futures) {
+            return NULL;
+        }
+        font_executor = PyObject_CallMethod(futures, "ThreadPoolExecutor",
+                                            "is", 1, "pygame_font");
+        Py_DECREF(futures);
+        if (!font_executor) {
+            return NULL;
+        }
+    }
+
+    submit_args = PyTuple_New(nargs + 1);
+    if (!submit_args) {
+        return NULL;
+    }
+    render = PyObject_GetAttrString(self, "render");
+    if (!render) {
+        Py_DECREF(submit_args);
+        return NULL;
+    }
+    PyTuple_SET_ITEM(submit_args, 0, render);
+    for (i = 0; i < nargs; ++i) {
+        Py_INCREF(PyTuple_GET_ITEM(args, i));
+        PyTuple_SET_ITEM(submit_args, i + 1, PyTuple_GET_ITEM(args, i));
+    }
+
+    submit = PyObject_GetAttrString(font_executor, "submit");
+    if (!submit) {
+        Py_DECREF(submit_args);
+        return NULL;
+    }
+    future = PyObject_Call(submit, submit_args, kwds);
+    Py_DECREF(submit);
+    Py_DECREF(submit_args);
+    return future;
+}
+
+/* Glyph atlas
+ *
+ * Font.render_to() draws each character from a cell of an atlas page, a
+ * SRCALPHA Surface the glyph was rendered into the first time it was drawn
+ * with that color. The cells are blitted straight onto the destination, so
+ * no Surface is made per string. Pages are filled shelf by shelf. Once
+ * ATLAS_MAX_PAGES are full, or if the style or point size changed since the
+ * glyphs were rendered, the atlas starts over.
+ */
+#define ATLAS_PAGE_SIZE 512
+#define ATLAS_MAX_PAGES 8
+
+typedef struct {
+    int page; /* -1 for glyphs without pixels, like spaces */
+    SDL_Rect rect;
+    int xoffset; /* of the cell from the pen position */
+    int advance;
+} pgFontGlyph;
+
+struct pgFontAtlas {
+    PyObject *index; /* (codepoint, antialias, color) key -> glyph number */
+    pgFontGlyph *glyphs;
+    Py_ssize_t num_glyphs;
+    Py_ssize_t max_glyphs;
+    PyObject *pages; /* list of Surfaces */
+    int shelf_x, shelf_y, shelf_h; /* free space on the last page */
+    int style, ptsize; /* the glyphs were rendered with */
+};
+
+static void
+_font_atlas_free(PyFontObject *self)
+{
+    struct pgFontAtlas *atlas = self->atlas;
+
+    if (atlas) {
+        Py_XDECREF(atlas->index);
+        Py_XDECREF(atlas->pages);
+        PyMem_Free(atlas->glyphs);
+        PyMem_Free(atlas);
+        self->atlas = NULL;
+    }
+}
+
+/* Drops all glyphs, creating the atlas first if needed. Returns -1 on
+ * error. */
+static int
+_font_atlas_reset(PyFontObject *self)
+{
+    struct pgFontAtlas *atlas = self->atlas;
+
+    if (!atlas) {
+        atlas = PyMem_New(struct pgFontAtlas, 1);
+        if (!atlas) {
+            PyErr_NoMemory();
+            return -1;
+        }
+        atlas->index = PyDict_New();
+        atlas->pages = PyList_New(0);
+        atlas->glyphs = NULL;
+        atlas->max_glyphs = 0;
+        self->atlas = atlas;
+        if (!atlas->index || !atlas->pages) {
+            _font_atlas_free(self);
+            return -1;
+        }
+    }
+    else {
+        PyDict_Clear(atlas->index);
+        if (PyList_SetSlice(atlas->pages, 0, PY_SSIZE_T_MAX, NULL)) {
+            return -1;
+        }
+    }
+    atlas->num_glyphs = 0;
+    atlas->shelf_x = atlas->shelf_y = atlas->shelf_h = 0;
+    atlas->style = TTF_GetFontStyle(self->font);
+    atlas->ptsize = self->ptsize;
+    return 0;
+}
+
+/* Finds room for a w x h cell, adding a page if needed. Returns the page
+ * number, -1 on error or -2 if the atlas is full. */
+static int
+_font_atlas_place(struct pgFontAtlas *atlas, int w, int h, SDL_Rect *rect)
+{
+    Py_ssize_t num_pages = PyList_GET_SIZE(atlas->pages);
+    SDL_Surface *page = NULL, *surf;
+    PyObject *pageobj;
+
+    if (num_pages) {
+        page = pgSurface_AsSurface(
+            PyList_GET_ITEM(atlas->pages, num_pages - 1));
+        if (atlas->shelf_x + w > page->w) {
+            atlas->shelf_y += atlas->shelf_h;
+            atlas->shelf_x = atlas->shelf_h = 0;
+        }
+    }
+    if (!page || w > page->w || atlas->shelf_y + h > page->h) {
+        if (num_pages == ATLAS_MAX_PAGES) {
+            return -2;
+        }
+        surf = PG_CreateSurface(MAX(w, ATLAS_PAGE_SIZE),
+                                MAX(h, ATLAS_PAGE_SIZE),
+                                SDL_PIXELFORMAT_ARGB8888);
+        if (!surf) {
+            PyErr_SetString(pgExc_SDLError, SDL_GetError());
+            return -1;
+        }
+        SDL_SetSurfaceBlendMode(surf, SDL_BLENDMODE_BLEND);
+        pageobj = (PyObject *)pgSurface_New(surf);
+        if (!pageobj) {
+            SDL_FreeSurface(surf);
+            return -1;
+        }
+        if (PyList_Append(atlas->pages, pageobj)) {
+            Py_DECREF(pageobj);
+            return -1;
+        }
+        Py_DECREF(pageobj);
+        atlas->shelf_x = atlas->shelf_y = atlas->shelf_h = 0;
+        num_pages++;
+    }
+
+    rect->x = atlas->shelf_x;
+    rect->y = atlas->shelf_y;
+    rect->w = w;
+    rect->h = h;
+    atlas->shelf_x += w;
+    atlas->shelf_h = MAX(atlas->shelf_h, h);
+    return (int)num_pages - 1;
+}
+
+/* Returns the glyph for ch in the given color, rendering it into the atlas
+ * the first time. The pointer is only valid until the next call. Returns
+ * NULL on error. */
+static pgFontGlyph *
+_font_atlas_glyph(PyFontObject *self, Uint32 ch, int antialias, SDL_Color fg)
+{
+    struct pgFontAtlas *atlas = self->atlas;
+    TTF_Font *font = PyFont_AsFont(self);
+    unsigned long long key;
+    PyObject *keyobj, *value;
+    SDL_Surface *surf = NULL;
+    SDL_Rect rect = {0, 0, 0, 0}, cell;
+    pgFontGlyph *glyph;
+    int minx, maxx, miny, maxy, advance, page = -1;
+
+    key = ((unsigned long long)fg.r << 16) | ((unsigned long long)fg.g << 8) |
+          fg.b;
+    key = (((key << 1) | (antialias ? 1 : 0)) << 21) | ch;
+    keyobj = PyLong_FromUnsignedLongLong(key);
+    if (!keyobj) {
+        return NULL;
+    }
+    value = PyDict_GetItemWithError(atlas->index, keyobj);
+    if (value) {
+        Py_DECREF(keyobj);
+        return &atlas->glyphs[PyLong_AsSsize_t(value)];
+    }
+    if (PyErr_Occurred()) {
+        goto error;
+    }
+
 #if SDL_TTF_VERSION_ATLEAST(2, 0, 18)
-            surf = TTF_RenderUTF8_Shaded_Wrapped(font, astring, foreg, backg,
-                                                 wraplength);
+    if (TTF_GlyphMetrics32(font, ch, &minx, &maxx, &miny, &maxy, &advance)) {
+        PyErr_SetString(pgExc_SDLError, TTF_GetError());
+        goto error;
+    }
 #else
-            surf = TTF_RenderUTF8_Shaded(font, astring, foreg, backg);
+    if (ch > 0xFFFF) {
+        PyErr_SetString(PyExc_ValueError,
+                        "characters above '\\uFFFF' need SDL_ttf 2.0.18 or "
+                        "above to be rendered with render_to");
+        goto error;
+    }
+    if (TTF_GlyphMetrics(font, (Uint16)ch, &minx, &maxx, &miny, &maxy,
+                         &advance)) {
+        PyErr_SetString(pgExc_SDLError, TTF_GetError());
+        goto error;
+    }
 #endif
-        }
-        else {
+
+    if (maxx > minx && maxy > miny) {
 #if SDL_TTF_VERSION_ATLEAST(2, 0, 18)
-            surf =
-                TTF_RenderUTF8_Solid_Wrapped(font, astring, foreg, wraplength);
+        surf = antialias ? TTF_RenderGlyph32_Blended(font, ch, fg)
+                         : TTF_RenderGlyph32_Solid(font, ch, fg);
 #else
-            surf = TTF_RenderUTF8_Solid(font, astring, foreg);
+        surf = antialias ? TTF_RenderGlyph_Blended(font, (Uint16)ch, fg)
+                         : TTF_RenderGlyph_Solid(font, (Uint16)ch, fg);
 #endif
-            /* If an explicit background was provided and the rendering options
-            resolve to Render_Solid, that needs to be explicitly handled. */
-            if (surf != NULL && bg_rgba_obj != Py_None) {
-                SDL_SetColorKey(surf, 0, 0);
-                surf->format->palette->colors[0].r = backg.r;
-                surf->format->palette->colors[0].g = backg.g;
-                surf->format->palette->colors[0].b = backg.b;
+        if (!surf) {
+            PyErr_SetString(pgExc_SDLError, TTF_GetError());
+            goto error;
+        }
+        page = _font_atlas_place(atlas, surf->w, surf->h, &rect);
+        if (page == -2) {
+            if (_font_atlas_reset(self)) {
+                goto error;
             }
+            page = _font_atlas_place(atlas, surf->w, surf->h, &rect);
+        }
+        if (page < 0) {
+            goto error;
         }
+
+        /* copy the pixels as they are, keeping the colorkey of Solid glyphs
+         * transparent */
+        SDL_SetSurfaceBlendMode(surf, SDL_BLENDMODE_NONE);
+        cell = rect; /* SDL_BlitSurface changes the destination rect */
+        SDL_BlitSurface(
+            surf, NULL,
+            pgSurface_AsSurface(PyList_GET_ITEM(atlas->pages, page)), &cell);
+        SDL_FreeSurface(surf);
+        surf = NULL;
     }
 
-    if (surf == NULL) {
-        return RAISE(pgExc_SDLError, TTF_GetError());
+    if (atlas->num_glyphs == atlas->max_glyphs) {
+        Py_ssize_t max_glyphs = atlas->max_glyphs ? 2 * atlas->max_glyphs : 64;
+        pgFontGlyph *glyphs = PyMem_Resize(atlas->glyphs, pgFontGlyph,
+                                           max_glyphs);
+
+        if (!glyphs) {
+            PyErr_NoMemory();
+            goto error;
+        }
+        atlas->glyphs = glyphs;
+        atlas->max_glyphs = max_glyphs;
+    }
+    value = PyLong_FromSsize_t(atlas->num_glyphs);
+    if (!value || PyDict_SetItem(atlas->index, keyobj, value)) {
+        Py_XDECREF(value);
+        goto error;
     }
+    Py_DECREF(value);
+    Py_DECREF(keyobj);
 
-    final = (PyObject *)pgSurface_New(surf);
-    if (final == NULL) {
+    glyph = &atlas->glyphs[atlas->num_glyphs++];
+    glyph->page = page;
+    glyph->rect = rect;
+    glyph->xoffset = minx < 0 ? minx : 0;
+    glyph->advance = advance;
+    return glyph;
+
+error:
+    if (surf) {
         SDL_FreeSurface(surf);
     }
-    return final;
+    Py_DECREF(keyobj);
+    return NULL;
 }
 
 static PyObject *
-font_size(PyObject *self, PyObject *text)
+font_render_to(PyObject *self, PyObject *args, PyObject *kwds)
 {
     if (!PgFont_GenerationCheck(self)) {
         return RAISE_FONT_QUIT_ERROR();
     }
 
+    PyFontObject *fontobj = (PyFontObject *)self;
     TTF_Font *font = PyFont_AsFont(self);
+    pgSurfaceObject *surfobj;
+    PyObject *dest, *text, *fg_rgba_obj, *utext;
+    Uint8 rgba[] = {0, 0, 0, 0};
+    SDL_Rect temp, *rect, dstrect, srcrect;
+    pgFontGlyph *glyph;
+    Py_ssize_t i, len;
+    Uint32 ch, prev = 0;
+    int antialias, x, y, penx, peny, width = 0;
+    int lineskip = TTF_FontLineSkip(font);
+
+    static char *kwlist[] = {"surface", "dest",  "text",
+                             "antialias", "color", NULL};
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "O!OOpO", kwlist,
+                                     &pgSurface_Type, &surfobj, &dest, &text,
+                                     &antialias, &fg_rgba_obj)) {
+        return NULL;
+    }
+
+    if (!pgSurface_AsSurface(surfobj)) {
+        return RAISE(pgExc_SDLError, "display Surface quit");
+    }
+
+    if ((rect = pgRect_FromObject(dest, &temp))) {
+        x = rect->x;
+        y = rect->y;
+    }
+    else if (!pg_TwoIntsFromObj(dest, &x, &y)) {
+        return RAISE(PyExc_TypeError,
+                     "invalid destination position for render_to");
+    }
+
+    if (!pg_RGBAFromObjEx(fg_rgba_obj, rgba, PG_COLOR_HANDLE_ALL)) {
+        /* Exception already set for us */
+        return NULL;
+    }
+    SDL_Color foreg = {rgba[0], rgba[1], rgba[2], SDL_ALPHA_OPAQUE};
+
+    if (PyUnicode_Check(text)) {
+        Py_INCREF(text);
+        utext = text;
+    }
+    else if (PyBytes_Check(text)) {
+        utext = PyUnicode_FromEncodedObject(text, "utf-8", "strict");
+        if (!utext) {
+            return NULL;
+        }
+    }
+    else if (text == Py_None) {
+        utext = PyUnicode_New(0, 0);
+        if (!utext) {
+            return NULL;
+        }
+    }
+    else {
+        return RAISE_TEXT_TYPE_ERROR();
+    }
+    len = PyUnicode_GET_LENGTH(utext);
+
+    if (PyUnicode_FindChar(utext, 0, 0, len, 1) != -1) {
+        Py_DECREF(utext);
+        return RAISE(PyExc_ValueError,
+                     "A null character was found in the text");
+    }
+
+    if (!fontobj->atlas || fontobj->atlas->style != TTF_GetFontStyle(font) ||
+        fontobj->atlas->ptsize != fontobj->ptsize) {
+        if (_font_atlas_reset(fontobj)) {
+            Py_DECREF(utext);
+            return NULL;
+        }
+    }
+
+    penx = x;
+    peny = y;
+    for (i = 0; i < len; i++) {
+        ch = PyUnicode_READ_CHAR(utext, i);
+        if (ch == '\n') {
+            width = MAX(width, penx - x);
+            penx = x;
+            peny += lineskip;
+            prev = 0;
+            continue;
+        }
+
+        glyph = _font_atlas_glyph(fontobj, ch, antialias, foreg);
+        if (!glyph) {
+            Py_DECREF(utext);
+            return NULL;
+        }
+
+#if SDL_TTF_VERSION_ATLEAST(2, 0, 18)
+        if (prev && TTF_GetFontKerning(font)) {
+            penx += TTF_GetFontKerningSizeGlyphs32(font, prev, ch);
+        }
+#endif
+
+        if (glyph->page >= 0) {
+            dstrect.x = penx + glyph->xoffset;
+            dstrect.y = peny;
+            srcrect = glyph->rect;
+            if (pgSurface_Blit(surfobj,
+                               (pgSurfaceObject *)PyList_GET_ITEM(
+                                   fontobj->atlas->pages, glyph->page),
+                               &dstrect, &srcrect, 0)) {
+                Py_DECREF(utext);
+                return NULL;
+            }
+        }
+        penx += glyph->advance;
+        prev = ch;
+    }
+    Py_DECREF(utext);
+
+    width = MAX(width, penx - x);
+    return pgRect_New4(x, y, width, peny - y + TTF_FontHeight(font));
+}
+
+/* Text layout measures the same words over and over, so the sizes are
+ * kept in a dict keyed by the text. Only exact str and bytes are cached,
+ * a subclass could compare equal to text that measures differently. The
+ * dict is dropped when it fills up, or when the point size or style it
+ * was made with changes. */
+#define PG_FONT_SIZE_CACHE_MAX 4096
+
+/* Returns a new reference to the (w, h) tuple of text */
+static PyObject *
+_font_size_of(PyFontObject *self, PyObject *text)
+{
+    TTF_Font *font = PyFont_AsFont(self);
+    int stamp = self->ptsize << 4 | (TTF_GetFontStyle(font) & 0x0f);
+    int cacheable = PyUnicode_CheckExact(text) || PyBytes_CheckExact(text);
+    PyObject *size;
     int w, h;
     const char *string;
 
-    if (!PgFont_GenerationCheck(self)) {
-        return RAISE_FONT_QUIT_ERROR();
+    if (self->size_cache && self->size_cache_stamp != stamp) {
+        Py_CLEAR(self->size_cache);
+    }
+    if (cacheable && self->size_cache) {
+        size = PyDict_GetItemWithError(self->size_cache, text);
+        if (size) {
+            Py_INCREF(size);
+            return size;
+        }
+        if (PyErr_Occurred()) {
+            return NULL;
+        }
     }
 
     if (PyUnicode_Check(text)) {
@@ -704,7 +1493,127 @@ font_size(PyObject *self, PyObject *text)
     else {
         return RAISE_TEXT_TYPE_ERROR();
     }
-    return pg_tuple_couple_from_values_int(w, h);
+
+    size = pg_tuple_couple_from_values_int(w, h);
+    if (!size || !cacheable) {
+        return size;
+    }
+    if (!self->size_cache ||
+        PyDict_GET_SIZE(self->size_cache) >= PG_FONT_SIZE_CACHE_MAX) {
+        Py_XSETREF(self->size_cache, PyDict_New());
+        self->size_cache_stamp = stamp;
+    }
+    if (!self->size_cache || PyDict_SetItem(self->size_cache, text, size)) {
+        Py_DECREF(size);
+        return NULL;
+    }
+    return size;
+}
+
+static PyObject *
+font_size(PyObject *self, PyObject *text)
+{
+    if (!PgFont_GenerationCheck(self)) {
+        return RAISE_FONT_QUIT_ERROR();
+    }
+
+    return _font_size_of((PyFontObject *)self, text);
+}
+
+/* Exports the sizes returned by Font.size_many() as a writable (n, 2)
+ * buffer of C ints, wrapped in a memoryview. */
+typedef struct {
+    PyObject_HEAD int *sizes;
+    Py_ssize_t shape[2];
+    Py_ssize_t strides[2];
+} pgFontSizesObject;
+
+static int
+font_sizes_getbuffer(pgFontSizesObject *self, Py_buffer *view, int flags)
+{
+    view->obj = (PyObject *)self;
+    Py_INCREF(self);
+    view->buf = self->sizes;
+    view->len = self->shape[0] * self->strides[0];
+    view->readonly = 0;
+    view->itemsize = sizeof(int);
+    view->ndim = 2;
+    view->shape = (flags & PyBUF_ND) ? self->shape : NULL;
+    view->strides = (flags & PyBUF_STRIDES) ? self->strides : NULL;
+    view->format = (flags & PyBUF_FORMAT) ? "i" : NULL;
+    view->suboffsets = NULL;
+    view->internal = NULL;
+    return 0;
+}
+
+static void
+font_sizes_dealloc(pgFontSizesObject *self)
+{
+    PyMem_Free(self->sizes);
+    Py_TYPE(self)->tp_free((PyObject *)self);
+}
+
+static PyBufferProcs font_sizes_buffer_procs = {
+    (getbufferproc)font_sizes_getbuffer, NULL};
+
+static PyTypeObject pgFontSizes_Type = {
+    PyVarObject_HEAD_INIT(NULL, 0).tp_name = "pygame.font._FontSizes",
+    .tp_basicsize = sizeof(pgFontSizesObject),
+    .tp_dealloc = (destructor)font_sizes_dealloc,
+    .tp_as_buffer = &font_sizes_buffer_procs,
+    .tp_flags = Py_TPFLAGS_DEFAULT,
+};
+
+static PyObject *
+font_size_many(PyObject *self, PyObject *strings)
+{
+    pgFontSizesObject *result;
+    PyObject *seq, *size, *view;
+    Py_ssize_t i, n;
+    int *sizes;
+
+    if (!PgFont_GenerationCheck(self)) {
+        return RAISE_FONT_QUIT_ERROR();
+    }
+
+    seq = PySequence_Fast(strings, "size_many requires a sequence of text");
+    if (!seq) {
+        return NULL;
+    }
+    n = PySequence_Fast_GET_SIZE(seq);
+    sizes = PyMem_New(int, n * 2 + 1);
+    if (!sizes) {
+        Py_DECREF(seq);
+        return PyErr_NoMemory();
+    }
+    for (i = 0; i < n; i++) {
+        size = _font_size_of((PyFontObject *)self,
+                             PySequence_Fast_GET_ITEM(seq, i));
+        if (!size) {
+            PyMem_Free(sizes);
+            Py_DECREF(seq);
+            return NULL;
+        }
+        sizes[2 * i] = (int)PyLong_AsLong(PyTuple_GET_ITEM(size, 0));
+        sizes[2 * i + 1] = (int)PyLong_AsLong(PyTuple_GET_ITEM(size, 1));
+        Py_DECREF(size);
+    }
+    Py_DECREF(seq);
+
+    result = PyObject_New(pgFontSizesObject, &pgFontSizes_Type);
+    if (!result) {
+        PyMem_Free(sizes);
+        return NULL;
+    }
+    result->sizes = sizes;
+    result->shape[0] = n;
+    result->shape[1] = 2;
+    result->strides[0] = 2 * sizeof(int);
+    result->strides[1] = sizeof(int);
+
+    view = PyMemoryView_FromObject((PyObject *)result);
+    Py_DECREF(result);
+    return view;
 }
 
 static PyObject *
@@ -947,6 +1856,7 @@ font_set_script(PyObject *self, PyObject *arg)
     if (TTF_SetFontScriptName(font, script_code) < 0) {
         return RAISE(pgExc_SDLError, SDL_GetError());
     }
+    _font_cache_clear((PyFontObject *)self);
 #else
     return RAISE(pgExc_SDLError,
                  "pygame.font not compiled with a new enough SDL_ttf version. "
@@ -1030,6 +1940,7 @@ font_set_direction(PyObject *self, PyObject *arg, PyObject *kwarg)
     if (TTF_SetFontDirection(font, dir)) {
         return RAISE(pgExc_SDLError, SDL_GetError());
     }
+    _font_cache_clear((PyFontObject *)self);
 
 #else
     return RAISE(pgExc_SDLError,
@@ -1083,10 +1994,21 @@ static PyMethodDef font_methods[] = {
     {"metrics", font_metrics, METH_O, DOC_FONT_FONT_METRICS},
     {"render", (PyCFunction)font_render, METH_VARARGS | METH_KEYWORDS,
      DOC_FONT_FONT_RENDER},
+    {"render_to", (PyCFunction)font_render_to, METH_VARARGS | METH_KEYWORDS,
+     DOC_FONT_FONT_RENDERTO},
+    {"render_async", (PyCFunction)font_render_async,
+     METH_VARARGS | METH_KEYWORDS, DOC_FONT_FONT_RENDERASYNC},
     {"size", font_size, METH_O, DOC_FONT_FONT_SIZE},
+    {"size_many", font_size_many, METH_O, DOC_FONT_FONT_SIZEMANY},
     {"set_script", font_set_script, METH_O, DOC_FONT_FONT_SETSCRIPT},
     {"set_direction", (PyCFunction)font_set_direction,
      METH_VARARGS | METH_KEYWORDS, DOC_FONT_FONT_SETDIRECTION},
+    {"enable_cache", font_enable_cache, METH_O, DOC_FONT_FONT_ENABLECACHE},
+    {"disable_cache", font_disable_cache, METH_NOARGS,
+     DOC_FONT_FONT_DISABLECACHE},
+    {"clear_cache", font_clear_cache, METH_NOARGS, DOC_FONT_FONT_CLEARCACHE},
+    {"get_cache_stats", font_get_cache_stats, METH_NOARGS,
+     DOC_FONT_FONT_GETCACHESTATS},
     {NULL, NULL, 0, NULL}};
 
 /*font object internals*/
@@ -1104,6 +2026,11 @@ font_dealloc(PyFontObject *self)
         TTF_CloseFont(font);
         self->font = NULL;
     }
+    _font_cache_free(self);
+    _font_atlas_free(self);
+    if (self->lock) {
+        PyThread_free_lock(self->lock);
+    }
 
     if (self->weakreflist)
         PyObject_ClearWeakRefs((PyObject *)self);
@@ -1121,6 +2048,8 @@ font_init(PyFontObject *self, PyObject *args, PyObject *kwds)
     static char *kwlist[] = {"filename", "size", NULL};
 
     self->font = NULL;
+    _font_cache_clear(self);
+    _font_atlas_free(self);
     if (!PyArg_ParseTupleAndKeywords(args, kwds, "|Oi", kwlist, &obj,
                                      &fontsize)) {
         return -1;
@@ -1308,6 +2237,10 @@ MODINIT_DEFINE(font)
     if (PyErr_Occurred()) {
         return NULL;
     }
+    import_pygame_rect();
+    if (PyErr_Occurred()) {
+        return NULL;
+    }
     import_pygame_rwobject();
     if (PyErr_Occurred()) {
         return NULL;
@@ -1317,6 +2250,9 @@ MODINIT_DEFINE(font)
     if (PyType_Ready(&PyFont_Type) < 0) {
         return NULL;
     }
+    if (PyType_Ready(&pgFontSizes_Type) < 0) {
+        return NULL;
+    }
     PyFont_Type.tp_new = PyType_GenericNew;
 
     module = PyModule_Create(&_module);
@@ -59,6 +59,7 @@
 #define FT_RFLAG_ORIGIN (1 << 7)
 #define FT_RFLAG_UCS4 (1 << 8)
 #define FT_RFLAG_USE_BITMAP_STRIKES (1 << 9)
+#define FT_RFLAG_SDF (1 << 10)
 #define FT_RFLAG_DEFAULTS \
     (FT_RFLAG_HINTED | FT_RFLAG_USE_BITMAP_STRIKES | FT_RFLAG_ANTIALIAS)
 
@@ -85,6 +86,7 @@ typedef struct {
 
 typedef struct {
     PyObject_HEAD pgFontId id;
+    pgFontId *face_id; /* &id, or the id of a face shared with other fonts */
     PyObject *path;
     int is_scalable;
     int is_bg_col_set;
@@ -38,11 +38,17 @@ typedef union cachenodekey_ {
     FT_UInt32 dwords[(sizeof(KeyFields) + 3) / 4];
 } NodeKey;
 
+/* The glyph must stay the first field: the layout code pins and unpins
+ * glyphs by their FontGlyph pointer. */
 typedef struct cachenode_ {
     FontGlyph glyph;
     struct cachenode_ *next;
+    struct cachenode_ *lru_prev;
+    struct cachenode_ *lru_next;
     NodeKey key;
     FT_UInt32 hash;
+    int pins;
+    size_t size;
 } CacheNode;
 
 static FT_UInt32
@@ -52,6 +58,14 @@ allocate_node(FontCache *, const FontRenderMode *, GlyphIndex_t, void *);
 static void
 free_node(FontCache *, CacheNode *);
 static void
+evict_nodes(FontCache *, size_t);
+static void
+grow_table(FontCache *);
+static void
+lru_unlink(FontCache *, CacheNode *);
+static void
+lru_push(FontCache *, CacheNode *);
+static void
 set_node_key(NodeKey *, GlyphIndex_t, const FontRenderMode *);
 static int
 equal_node_keys(const NodeKey *, const NodeKey *);
@@ -130,10 +144,11 @@ get_hash(const NodeKey *key)
     return h1;
 }
 
-int
-_PGFT_Cache_Init(FreeTypeInstance *ft, FontCache *cache)
+FontCache *
+_PGFT_Cache_New(FreeTypeInstance *ft)
 {
     int cache_size = MAX(ft->cache_size - 1, PGFT_MIN_CACHE_SIZE - 1);
+    FontCache *cache;
 
     /*
      * Make sure this is a power of 2.
@@ -146,91 +161,105 @@ _PGFT_Cache_Init(FreeTypeInstance *ft, FontCache *cache)
 
     cache_size = cache_size + 1;
 
-    cache->nodes = _PGFT_calloc((size_t)cache_size, sizeof(FontGlyph *));
-    if (!cache->nodes)
-        return -1;
-    cache->depths = _PGFT_calloc((size_t)cache_size, sizeof(FT_Byte));
-    if (!cache->depths) {
-        _PGFT_free(cache->nodes);
-        cache->nodes = 0;
-        return -1;
+    cache = _PGFT_calloc(1, sizeof(FontCache));
+    if (!cache) {
+        return 0;
+    }
+    cache->nodes = _PGFT_calloc((size_t)cache_size, sizeof(CacheNode *));
+    if (!cache->nodes) {
+        _PGFT_free(cache);
+        return 0;
     }
-    cache->free_nodes = 0;
     cache->size_mask = (FT_UInt32)(cache_size - 1);
-
-#ifdef PGFT_DEBUG_CACHE
-    cache->_debug_count = 0;
-    cache->_debug_delete_count = 0;
-    cache->_debug_access = 0;
-    cache->_debug_hit = 0;
-    cache->_debug_miss = 0;
-#endif
-    return 0;
+    cache->max_bytes = PGFT_DEFAULT_CACHE_BUDGET;
+    cache->ref_count = 1;
+    return cache;
 }
 
 void
-_PGFT_Cache_Destroy(FontCache *cache)
+_PGFT_Cache_Release(FontCache *cache)
 {
     CacheNode *node, *next;
 
-    if (!cache) {
+    if (!cache || --cache->ref_count > 0) {
         return;
     }
 
-    /* PGFT_DEBUG_CACHE - Here is a good place to set a breakpoint
-     * to examine _debug fields.
-     */
-
-    if (cache->nodes) {
-        FT_UInt i;
+    if (cache->share_prev) {
+        *cache->share_prev = cache->share_next;
+        if (cache->share_next) {
+            cache->share_next->share_prev = cache->share_prev;
+        }
+    }
 
-        for (i = 0; i <= cache->size_mask; ++i) {
-            node = cache->nodes[i];
+    node = cache->lru_first;
+    while (node) {
+        next = node->lru_next;
+        free_node(cache, node);
+        node = next;
+    }
+    _PGFT_free(cache->nodes);
+    _PGFT_SDF_Free(cache);
+    _PGFT_free(cache->share_path);
+    _PGFT_free(cache);
+}
 
-            while (node) {
-                next = node->next;
-                free_node(cache, node);
-                node = next;
-            }
+/* Swap the font's private cache for the one shared by other fonts loaded
+ * from path with the same face index and resolution, or publish the
+ * font's cache as that shared one. Only call this before the font has
+ * loaded any glyphs.
+ */
+int
+_PGFT_Cache_Share(FreeTypeInstance *ft, pgFontObject *fontobj,
+                  const char *path)
+{
+    FontCache **font_cache = &fontobj->_internals->glyph_cache;
+    FontCache *cache;
+    size_t path_len;
+
+    for (cache = ft->shared_caches; cache; cache = cache->share_next) {
+        if (cache->share_index == fontobj->id.font_index &&
+            cache->share_resolution == fontobj->resolution &&
+            strcmp(cache->share_path, path) == 0) {
+            ++cache->ref_count;
+            _PGFT_Cache_Release(*font_cache);
+            *font_cache = cache;
+            return 0;
         }
-        _PGFT_free(cache->nodes);
-        cache->nodes = 0;
     }
-    _PGFT_free(cache->depths);
-    cache->depths = 0;
+
+    cache = *font_cache;
+    assert(!cache->share_path && cache->count == 0);
+    path_len = strlen(path);
+    cache->share_path = _PGFT_malloc(path_len + 1);
+    if (!cache->share_path) {
+        PyErr_NoMemory();
+        return -1;
+    }
+    memcpy(cache->share_path, path, path_len + 1);
+    cache->share_index = fontobj->id.font_index;
+    cache->share_resolution = fontobj->resolution;
+
+    cache->share_next = ft->shared_caches;
+    if (cache->share_next) {
+        cache->share_next->share_prev = &cache->share_next;
+    }
+    cache->share_prev = &ft->shared_caches;
+    ft->shared_caches = cache;
+    return 0;
 }
 
 void
 _PGFT_Cache_Cleanup(FontCache *cache)
 {
-    const FT_Byte MAX_BUCKET_DEPTH = 2;
-    CacheNode *node, *prev;
-    FT_UInt32 i;
-
-    for (i = 0; i <= cache->size_mask; ++i) {
-        while (cache->depths[i] > MAX_BUCKET_DEPTH) {
-            node = cache->nodes[i];
-            prev = 0;
-
-            for (;;) {
-                if (!node->next) {
-#ifdef PGFT_DEBUG_CACHE
-                    cache->_debug_delete_count++;
-#endif
-
-                    if (prev) {
-                        prev->next = 0;
-                    }
-
-                    free_node(cache, node);
-                    break;
-                }
+    evict_nodes(cache, 0);
+}
 
-                prev = node;
-                node = node->next;
-            }
-        }
-    }
+void
+_PGFT_Cache_SetBudget(FontCache *cache, size_t max_bytes)
+{
+    cache->max_bytes = max_bytes;
+    evict_nodes(cache, 0);
 }
 
 FontGlyph *
@@ -250,10 +279,6 @@ _PGFT_Cache_FindGlyph(GlyphIndex_t id, const FontRenderMode *render,
     node = nodes[bucket];
     prev = 0;
 
-#ifdef PGFT_DEBUG_CACHE
-    cache->_debug_access++;
-#endif
-
     while (node) {
         if (equal_node_keys(&node->key, &key)) {
             if (prev) {
@@ -261,11 +286,9 @@ _PGFT_Cache_FindGlyph(GlyphIndex_t id, const FontRenderMode *render,
                 node->next = nodes[bucket];
                 nodes[bucket] = node;
             }
-
-#ifdef PGFT_DEBUG_CACHE
-            cache->_debug_hit++;
-#endif
-
+            lru_unlink(cache, node);
+            lru_push(cache, node);
+            cache->hits++;
             return &node->glyph;
         }
 
@@ -273,15 +296,122 @@ _PGFT_Cache_FindGlyph(GlyphIndex_t id, const FontRenderMode *render,
         node = node->next;
     }
 
+    cache->misses++;
     node = allocate_node(cache, render, id, internal);
 
-#ifdef PGFT_DEBUG_CACHE
-    cache->_debug_miss++;
-#endif
-
     return node ? &node->glyph : 0;
 }
 
+void
+_PGFT_Cache_PinGlyph(FontCache *cache, FontGlyph *glyph)
+{
+    CacheNode *node = (CacheNode *)glyph;
+
+    if (node->pins++ == 0) {
+        cache->pinned_bytes += node->size;
+    }
+}
+
+void
+_PGFT_Cache_UnpinGlyph(FontCache *cache, FontGlyph *glyph)
+{
+    CacheNode *node = (CacheNode *)glyph;
+
+    assert(node->pins > 0);
+    if (--node->pins == 0) {
+        cache->pinned_bytes -= node->size;
+    }
+}
+
+static void
+lru_unlink(FontCache *cache, CacheNode *node)
+{
+    if (node->lru_prev) {
+        node->lru_prev->lru_next = node->lru_next;
+    }
+    else {
+        cache->lru_first = node->lru_next;
+    }
+    if (node->lru_next) {
+        node->lru_next->lru_prev = node->lru_prev;
+    }
+    else {
+        cache->lru_last = node->lru_prev;
+    }
+    node->lru_prev = node->lru_next = 0;
+}
+
+static void
+lru_push(FontCache *cache, CacheNode *node)
+{
+    node->lru_prev = 0;
+    node->lru_next = cache->lru_first;
+    if (cache->lru_first) {
+        cache->lru_first->lru_prev = node;
+    }
+    else {
+        cache->lru_last = node;
+    }
+    cache->lru_first = node;
+}
+
+/* Free least recently used, unpinned glyphs until another extra bytes fit
+ * in the budget, or only pinned glyphs are left.
+ */
+static void
+evict_nodes(FontCache *cache, size_t extra)
+{
+    CacheNode *node = cache->lru_last;
+    CacheNode *prev, **link;
+
+    while (node && cache->bytes + extra > cache->max_bytes &&
+           cache->bytes > cache->pinned_bytes) {
+        prev = node->lru_prev;
+        if (!node->pins) {
+            link = &cache->nodes[node->hash & cache->size_mask];
+            while (*link != node) {
+                link = &(*link)->next;
+            }
+            *link = node->next;
+            lru_unlink(cache, node);
+            free_node(cache, node);
+            cache->evictions++;
+        }
+        node = prev;
+    }
+}
+
+/* Double the bucket count. The nodes themselves don't move, so glyphs
+ * handed out earlier stay valid. If memory is short the table just keeps
+ * its current size and chains get longer.
+ */
+static void
+grow_table(FontCache *cache)
+{
+    FT_UInt32 size_mask = cache->size_mask * 2 + 1;
+    CacheNode **nodes;
+    CacheNode *node;
+    FT_UInt32 bucket;
+
+    if (size_mask < cache->size_mask) {
+        return;
+    }
+    nodes = _PGFT_calloc((size_t)size_mask + 1, sizeof(CacheNode *));
+    if (!nodes) {
+        return;
+    }
+
+    /* Oldest first, so the most recently used glyphs head their chains */
+    for (node = cache->lru_last; node; node = node->lru_prev) {
+        bucket = node->hash & size_mask;
+        node->next = nodes[bucket];
+        nodes[bucket] = node;
+    }
+    _PGFT_free(cache->nodes);
+    cache->nodes = nodes;
+    cache->size_mask = size_mask;
+}
+
 static void
 free_node(FontCache *cache, CacheNode *node)
 {
@@ -289,11 +419,8 @@ free_node(FontCache *cache, CacheNode *node)
         return;
     }
 
-#ifdef PGFT_DEBUG_CACHE
-    cache->_debug_count--;
-#endif
-
-    cache->depths[node->hash & cache->size_mask]--;
+    cache->count--;
+    cache->bytes -= node->size;
 
     FT_Done_Glyph((FT_Glyph)(node->glyph.image));
     _PGFT_free(node);
@@ -304,6 +431,7 @@ allocate_node(FontCache *cache, const FontRenderMode *render, GlyphIndex_t id,
               void *internal)
 {
     CacheNode *node = _PGFT_calloc(1, sizeof(CacheNode));
+    const FT_Bitmap *bitmap;
     FT_UInt32 bucket;
 
     if (!node) {
@@ -314,17 +442,24 @@ allocate_node(FontCache *cache, const FontRenderMode *render, GlyphIndex_t id,
         goto cleanup;
     }
 
+    bitmap = &node->glyph.image->bitmap;
+    node->size = sizeof(CacheNode) +
+                 (size_t)(bitmap->pitch < 0 ? -bitmap->pitch : bitmap->pitch) *
+                     bitmap->rows;
+    evict_nodes(cache, node->size);
+
     set_node_key(&node->key, id, render);
     node->hash = get_hash(&node->key);
     bucket = node->hash & cache->size_mask;
     node->next = cache->nodes[bucket];
     cache->nodes[bucket] = node;
+    lru_push(cache, node);
 
-    cache->depths[bucket]++;
-
-#ifdef PGFT_DEBUG_CACHE
-    cache->_debug_count++;
-#endif
+    cache->count++;
+    cache->bytes += node->size;
+    if (cache->count > cache->size_mask + 1) {
+        grow_table(cache);
+    }
 
     return node;
 
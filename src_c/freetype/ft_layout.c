@@ -39,10 +39,12 @@ static FT_Matrix slant_matrix = {FX16_ONE, (FT_Fixed)(SLANT_FACTOR *FX16_ONE),
 static FT_Matrix unit_matrix = {FX16_ONE, 0, 0, FX16_ONE};
 
 typedef struct textcontext_ {
+    FreeTypeInstance *ft;
     FT_Library lib;
     FTC_FaceID id;
     FT_Face font;
     FTC_CMapCache charmap;
+    FontCache *cache;
     int do_transform;
     FT_Matrix transform;
 } TextContext;
@@ -61,7 +63,7 @@ typedef enum { UPDATE_NONE, UPDATE_LAYOUT, UPDATE_GLYPHS } UpdateLevel_t;
 /** render modes requiring glyph reloading and repositioning */
 static const FT_UInt16 GLYPH_RENDER_FLAGS =
     (FT_RFLAG_ANTIALIAS | FT_RFLAG_AUTOHINT | FT_RFLAG_TRANSFORM |
-     FT_RFLAG_USE_BITMAP_STRIKES);
+     FT_RFLAG_USE_BITMAP_STRIKES | FT_RFLAG_SDF);
 /** render modes requiring only glyph repositioning */
 static const FT_UInt16 LAYOUT_RENDER_FLAGS =
     (FT_RFLAG_VERTICAL | FT_RFLAG_HINTED | FT_RFLAG_KERNING | FT_RFLAG_PAD);
@@ -69,18 +71,22 @@ static const FT_UInt16 LAYOUT_RENDER_FLAGS =
 static const FT_UInt16 GLYPH_STYLE_FLAGS =
     (FT_STYLE_OBLIQUE | FT_STYLE_STRONG | FT_STYLE_WIDE);
 
+static int
+use_sdf(const FontRenderMode *, const TextContext *);
 static FT_UInt32
 get_load_flags(const FontRenderMode *);
 static void
 fill_metrics(FontMetrics *, FT_Pos, FT_Pos, FT_Vector *, FT_Vector *);
 static void
-fill_context(TextContext *, const FreeTypeInstance *, const pgFontObject *,
+fill_context(TextContext *, FreeTypeInstance *, const pgFontObject *,
              const FontRenderMode *, const FT_Face);
 static int
 size_text(Layout *, FreeTypeInstance *, TextContext *, const PGFT_String *);
 static int
 load_glyphs(Layout *, TextContext *, FontCache *);
 static void
+unpin_glyphs(Layout *, FontCache *);
+static void
 position_glyphs(Layout *);
 static void
 fill_text_bounding_box(Layout *, FT_Vector, FT_Pos, FT_Pos, FT_Pos, FT_Pos,
@@ -98,12 +104,14 @@ int
 _PGFT_LayoutInit(FreeTypeInstance *ft, pgFontObject *fontobj)
 {
     Layout *ftext = &fontobj->_internals->active_text;
-    FontCache *cache = &fontobj->_internals->glyph_cache;
 
+    ftext->length = 0;
     ftext->buffer_size = 0;
+    ftext->pinned = 0;
     ftext->glyphs = 0;
 
-    if (_PGFT_Cache_Init(ft, cache)) {
+    fontobj->_internals->glyph_cache = _PGFT_Cache_New(ft);
+    if (!fontobj->_internals->glyph_cache) {
         PyErr_NoMemory();
         return -1;
     }
@@ -115,13 +123,58 @@ void
 _PGFT_LayoutFree(pgFontObject *fontobj)
 {
     Layout *ftext = &(fontobj->_internals->active_text);
-    FontCache *cache = &fontobj->_internals->glyph_cache;
+    FontCache *cache = fontobj->_internals->glyph_cache;
 
+    unpin_glyphs(ftext, cache);
     if (ftext->buffer_size > 0) {
         _PGFT_free(ftext->glyphs);
         ftext->glyphs = 0;
     }
-    _PGFT_Cache_Destroy(cache);
+    _PGFT_Cache_Release(cache);
+    fontobj->_internals->glyph_cache = 0;
+}
+
+/* Copy the font's active layout, pinning its glyphs so the copy stays
+ * valid while the font loads other text. Release it with
+ * _PGFT_FreeLayoutCopy.
+ */
+int
+_PGFT_CopyLayout(pgFontObject *fontobj, Layout *copy)
+{
+    Layout *ftext = &fontobj->_internals->active_text;
+    FontCache *cache = fontobj->_internals->glyph_cache;
+    int i;
+
+    *copy = *ftext;
+    copy->buffer_size = 0;
+    copy->pinned = 0;
+    copy->glyphs = 0;
+    if (ftext->length > 0) {
+        copy->glyphs = (GlyphSlot *)_PGFT_malloc((size_t)ftext->length *
+                                                 sizeof(GlyphSlot));
+        if (!copy->glyphs) {
+            PyErr_NoMemory();
+            return -1;
+        }
+        memcpy(copy->glyphs, ftext->glyphs,
+               (size_t)ftext->length * sizeof(GlyphSlot));
+        copy->buffer_size = ftext->length;
+    }
+    for (i = 0; i < copy->length; ++i) {
+        _PGFT_Cache_PinGlyph(cache, copy->glyphs[i].glyph);
+    }
+    copy->pinned = copy->length;
+    return 0;
+}
+
+void
+_PGFT_FreeLayoutCopy(pgFontObject *fontobj, Layout *copy)
+{
+    unpin_glyphs(copy, fontobj->_internals->glyph_cache);
+    _PGFT_free(copy->glyphs);
+    copy->glyphs = 0;
+    copy->buffer_size = 0;
+    copy->length = 0;
 }
 
 Layout *
@@ -129,7 +182,7 @@ _PGFT_LoadLayout(FreeTypeInstance *ft, pgFontObject *fontobj,
                  const FontRenderMode *mode, PGFT_String *text)
 {
     Layout *ftext = &fontobj->_internals->active_text;
-    FontCache *cache = &fontobj->_internals->glyph_cache;
+    FontCache *cache = fontobj->_internals->glyph_cache;
     UpdateLevel_t level =
         (text ? UPDATE_GLYPHS : mode_compare(&ftext->mode, mode));
     FT_Face font = 0;
@@ -146,8 +199,10 @@ _PGFT_LoadLayout(FreeTypeInstance *ft, pgFontObject *fontobj,
 
     switch (level) {
         case UPDATE_GLYPHS:
+            unpin_glyphs(ftext, cache);
             _PGFT_Cache_Cleanup(cache);
             fill_context(&context, ft, fontobj, mode, font);
+            context.cache = cache;
             if (text) {
                 if (size_text(ftext, ft, &context, text)) {
                     return 0;
@@ -247,6 +302,7 @@ load_glyphs(Layout *ftext, TextContext *context, FontCache *cache)
     FontGlyph *glyph;
     Py_ssize_t i;
 
+    assert(ftext->pinned == 0);
     for (i = 0; i < length; ++i) {
         glyph = _PGFT_Cache_FindGlyph(slot[i].id, mode, cache, context);
         if (!glyph) {
@@ -254,11 +310,25 @@ load_glyphs(Layout *ftext, TextContext *context, FontCache *cache)
                          (unsigned long)slot[i].id);
             return -1;
         }
+        /* Pin right away, so loading the rest of the text can't evict it */
+        _PGFT_Cache_PinGlyph(cache, glyph);
         slot[i].glyph = glyph;
+        ftext->pinned = (int)i + 1;
     }
     return 0;
 }
 
+static void
+unpin_glyphs(Layout *ftext, FontCache *cache)
+{
+    int i;
+
+    for (i = 0; i < ftext->pinned; ++i) {
+        _PGFT_Cache_UnpinGlyph(cache, ftext->glyphs[i].glyph);
+    }
+    ftext->pinned = 0;
+}
+
 static void
 position_glyphs(Layout *ftext)
 {
@@ -453,7 +523,7 @@ _PGFT_GetMetrics(FreeTypeInstance *ft, pgFontObject *fontobj,
                  FT_UInt *gindex, long *minx, long *maxx, long *miny,
                  long *maxy, double *advance_x, double *advance_y)
 {
-    FontCache *cache = &(fontobj->_internals->glyph_cache);
+    FontCache *cache = fontobj->_internals->glyph_cache;
     FT_UInt32 ch = (FT_UInt32)character;
     GlyphIndex_t id;
     FontGlyph *glyph = 0;
@@ -470,6 +540,7 @@ _PGFT_GetMetrics(FreeTypeInstance *ft, pgFontObject *fontobj,
     _PGFT_Cache_Cleanup(cache);
 
     fill_context(&context, ft, fontobj, mode, font);
+    context.cache = cache;
     id = FTC_CMapCache_Lookup(context.charmap, context.id, -1, ch);
     if (!id) {
         return -1;
@@ -501,6 +572,7 @@ _PGFT_LoadGlyph(FontGlyph *glyph, GlyphIndex_t id, const FontRenderMode *mode,
                                                    : FT_RENDER_MODE_MONO);
     FT_Vector strong_delta = {0, 0};
     FT_Glyph image = 0;
+    PyThreadState *state;
 
     FT_Glyph_Metrics *ft_metrics;
     TextContext *context = (TextContext *)internal;
@@ -521,6 +593,30 @@ _PGFT_LoadGlyph(FontGlyph *glyph, GlyphIndex_t id, const FontRenderMode *mode,
      */
     load_flags = get_load_flags(mode);
 
+    /*
+     * Threshold an upright antialiased glyph from the face's distance
+     * field instead of rasterising it at this size. The glyph is then
+     * loaded for its sized metrics only.
+     */
+    if (use_sdf(mode, context)) {
+        FT_Pos strength = 0;
+
+        if (mode->style & FT_STYLE_STRONG) {
+            FT_UShort x_ppem = context->font->size->metrics.x_ppem;
+
+            /* FT_Outline_Embolden grows the outline by half on each side */
+            strength = FX16_CEIL_TO_FX6(mode->strength * x_ppem);
+            strong_delta.x = strength;
+            strong_delta.y = strength;
+        }
+        if (_PGFT_SDF_RenderGlyph(context->ft, context->cache, context->font,
+                                  id, strength / 2, &image) ||
+            FT_Load_Glyph(context->font, id, (FT_Int)load_flags)) {
+            goto cleanup;
+        }
+        goto loaded;
+    }
+
     /*
      * Load the glyph into the glyph slot
      */
@@ -557,11 +653,14 @@ _PGFT_LoadGlyph(FontGlyph *glyph, GlyphIndex_t id, const FontRenderMode *mode,
     /*
      * Finished with outline transformations, now replace with a bitmap
      */
+    state = _PGFT_BeginRaster(context->ft);
     error = FT_Glyph_To_Bitmap(&image, rmode, 0, 1);
+    _PGFT_EndRaster(context->ft, state);
     if (error) {
         goto cleanup;
     }
 
+loaded:
     if (mode->style & FT_STYLE_WIDE) {
         FT_Bitmap *bitmap = &((FT_BitmapGlyph)image)->bitmap;
         int w = bitmap->width;
@@ -641,12 +740,13 @@ cleanup:
 }
 
 static void
-fill_context(TextContext *context, const FreeTypeInstance *ft,
+fill_context(TextContext *context, FreeTypeInstance *ft,
              const pgFontObject *fontobj, const FontRenderMode *mode,
              const FT_Face font)
 {
+    context->ft = ft;
     context->lib = ft->library;
-    context->id = (FTC_FaceID) & (fontobj->id);
+    context->id = (FTC_FaceID)fontobj->face_id;
     context->font = font;
     context->charmap = ft->cache_charmap;
     context->do_transform = 0;
@@ -690,6 +790,18 @@ fill_metrics(FontMetrics *metrics, FT_Pos bearing_x, FT_Pos bearing_y,
     metrics->advance_rotated.y = advance_rotated->y;
 }
 
+static int
+use_sdf(const FontRenderMode *mode, const TextContext *context)
+{
+#if defined(PGFT_HAVE_SDF)
+    return (mode->render_flags & FT_RFLAG_SDF) &&
+           (mode->render_flags & FT_RFLAG_ANTIALIAS) &&
+           !context->do_transform && FT_IS_SCALABLE(context->font);
+#else
+    return 0;
+#endif
+}
+
 static FT_UInt32
 get_load_flags(const FontRenderMode *mode)
 {
@@ -709,7 +821,7 @@ get_load_flags(const FontRenderMode *mode)
     }
 
     if (!(mode->render_flags & FT_RFLAG_USE_BITMAP_STRIKES) ||
-        (mode->render_flags & FT_RFLAG_TRANSFORM) ||
+        (mode->render_flags & (FT_RFLAG_TRANSFORM | FT_RFLAG_SDF)) ||
         (mode->rotation_angle != 0) ||
         (mode->style & (FT_STYLE_STRONG | FT_STYLE_OBLIQUE))) {
         load_flags |= FT_LOAD_NO_BITMAP;
@@ -261,6 +261,45 @@ _PGFT_Render_ExistingSurface(FreeTypeInstance *ft, pgFontObject *fontobj,
                              SDL_Surface *surface, int x, int y,
                              FontColor *fgcolor, FontColor *bgcolor,
                              SDL_Rect *r)
+{
+    int locked = 0;
+    int rval;
+    Layout *font_text;
+
+    if (SDL_MUSTLOCK(surface)) {
+        if (SDL_LockSurface(surface) == -1) {
+            PyErr_SetString(pgExc_SDLError, SDL_GetError());
+            return -1;
+        }
+        locked = 1;
+    }
+
+    /* build font text */
+    font_text = _PGFT_LoadLayout(ft, fontobj, mode, text);
+    if (!font_text) {
+        rval = -1;
+    }
+    else {
+        rval = _PGFT_Render_Layout(ft, fontobj, mode, font_text, surface, x,
+                                   y, fgcolor, bgcolor, r);
+    }
+
+    if (locked) {
+        SDL_UnlockSurface(surface);
+    }
+
+    return rval;
+}
+
+/* Render an already loaded layout, either the font's active one or a copy
+ * from _PGFT_CopyLayout. The caller locks the surface, so a batch of texts
+ * only locks it once.
+ */
+int
+_PGFT_Render_Layout(FreeTypeInstance *ft, pgFontObject *fontobj,
+                    const FontRenderMode *mode, Layout *font_text,
+                    SDL_Surface *surface, int x, int y, FontColor *fgcolor,
+                    FontColor *bgcolor, SDL_Rect *r)
 {
     static const FontRenderPtr __SDLrenderFuncs[] = {
         0, __render_glyph_RGB1, __render_glyph_RGB2, __render_glyph_RGB3,
@@ -274,7 +313,6 @@ _PGFT_Render_ExistingSurface(FreeTypeInstance *ft, pgFontObject *fontobj,
         0, __fill_glyph_RGB1, __fill_glyph_RGB2, __fill_glyph_RGB3,
         __fill_glyph_RGB4};
 
-    int locked = 0;
     unsigned width;
     unsigned height;
     FT_Vector offset;
@@ -283,25 +321,7 @@ _PGFT_Render_ExistingSurface(FreeTypeInstance *ft, pgFontObject *fontobj,
     FT_Fixed underline_size;
 
     FontSurface font_surf;
-    Layout *font_text;
 
-    if (SDL_MUSTLOCK(surface)) {
-        if (SDL_LockSurface(surface) == -1) {
-            SDL_FreeSurface(surface);
-            PyErr_SetString(pgExc_SDLError, SDL_GetError());
-            return -1;
-        }
-        locked = 1;
-    }
-
-    /* build font text */
-    font_text = _PGFT_LoadLayout(ft, fontobj, mode, text);
-    if (!font_text) {
-        if (locked) {
-            SDL_UnlockSurface(surface);
-        }
-        return -1;
-    }
     if (font_text->length == 0) {
         /* Nothing to rendering */
         r->x = 0;
@@ -315,9 +335,6 @@ _PGFT_Render_ExistingSurface(FreeTypeInstance *ft, pgFontObject *fontobj,
                            &underline_top, &underline_size);
     if (width == 0 || height == 0) {
         /* Nothing more to do. */
-        if (locked) {
-            SDL_UnlockSurface(surface);
-        }
         r->x = 0;
         r->y = 0;
         r->w = 0;
@@ -349,7 +366,13 @@ _PGFT_Render_ExistingSurface(FreeTypeInstance *ft, pgFontObject *fontobj,
     font_surf.height = surface->h;
     font_surf.pitch = surface->pitch;
     font_surf.format = surface->format;
-    font_surf.render_gray = __SDLrenderFuncs[PG_SURF_BytesPerPixel(surface)];
+    if (PG_SURF_BytesPerPixel(surface) == 4) {
+        font_surf.render_gray = __select_render_glyph_RGB4(surface->format);
+    }
+    else {
+        font_surf.render_gray =
+            __SDLrenderFuncs[PG_SURF_BytesPerPixel(surface)];
+    }
     font_surf.render_mono = __MONOrenderFuncs[PG_SURF_BytesPerPixel(surface)];
     font_surf.fill = __RGBfillFuncs[PG_SURF_BytesPerPixel(surface)];
 
@@ -388,10 +411,6 @@ _PGFT_Render_ExistingSurface(FreeTypeInstance *ft, pgFontObject *fontobj,
     r->w = (Uint16)width;
     r->h = (Uint16)height;
 
-    if (locked) {
-        SDL_UnlockSurface(surface);
-    }
-
     return 0;
 }
 
@@ -461,7 +480,7 @@ _PGFT_Render_NewSurface(FreeTypeInstance *ft, pgFontObject *fontobj,
     if (bits_per_pixel == 32) {
         FT_UInt32 fillcolor;
 
-        font_surf.render_gray = __render_glyph_RGB4;
+        font_surf.render_gray = __select_render_glyph_RGB4(surface->format);
         font_surf.render_mono = __render_glyph_MONO4;
         font_surf.fill = __fill_glyph_RGB4;
         /*
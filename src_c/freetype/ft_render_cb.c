@@ -24,6 +24,7 @@
 #include "ft_wrap.h"
 #include FT_MODULE_H
 #include "ft_pixel.h"
+#include "ft_render_cb_simd.h"
 
 void
 __render_glyph_GRAY1(int x, int y, FontSurface *surface,
@@ -780,12 +781,18 @@ __fill_glyph_INT(FT_Fixed x, FT_Fixed y, FT_Fixed w, FT_Fixed h,
 
 #define _SET_PIXEL(T) *(T *)_dst = (T)full_color;
 
-#define _BLEND_PIXEL(T)                                                    \
-    *((T *)_dst) =                                                         \
-        (T)(((bgR >> surface->format->Rloss) << surface->format->Rshift) | \
-            ((bgG >> surface->format->Gloss) << surface->format->Gshift) | \
-            ((bgB >> surface->format->Bloss) << surface->format->Bshift) | \
-            ((bgA >> surface->format->Aloss) << surface->format->Ashift &  \
+/* The masks drop the bits a blend toward a darker color leaves above the
+ * channel, as the components are unsigned.
+ */
+#define _BLEND_PIXEL(T)                                                   \
+    *((T *)_dst) =                                                        \
+        (T)(((bgR >> surface->format->Rloss) << surface->format->Rshift & \
+             surface->format->Rmask) |                                    \
+            ((bgG >> surface->format->Gloss) << surface->format->Gshift & \
+             surface->format->Gmask) |                                    \
+            ((bgB >> surface->format->Bloss) << surface->format->Bshift & \
+             surface->format->Bmask) |                                    \
+            ((bgA >> surface->format->Aloss) << surface->format->Ashift & \
              surface->format->Amask))
 
 #define _BLEND_PIXEL_GENERIC(T)                                              \
@@ -817,3 +824,84 @@ _CREATE_RGB_FILLER(2, _GET_PIXEL(FT_UInt16), _SET_PIXEL(FT_UInt16),
                    _BLEND_PIXEL(FT_UInt16))
 _CREATE_RGB_FILLER(1, _GET_PIXEL(FT_Byte), _SET_PIXEL(FT_Byte),
                    _BLEND_PIXEL_GENERIC(FT_Byte))
+
+/* The SSE2/NEON and AVX2 versions of __render_glyph_RGB4, for 32 bit formats
+ * with 8 bit channels on byte boundaries. They blend a row of the glyph at a
+ * time, with the same results as the generic version.
+ */
+static int
+_is_byte_channel(FT_UInt32 mask, int shift)
+{
+    return shift % 8 == 0 && mask == (FT_UInt32)0xFF << shift;
+}
+
+static void
+_render_glyph_RGB4_rows(int x, int y, FontSurface *surface,
+                        const FT_Bitmap *bitmap, const FontColor *color,
+                        FT_RENDER_ROW_RGB4_P render_row)
+{
+    const SDL_PixelFormat *format = surface->format;
+    const int off_x = (x < 0) ? -x : 0;
+    const int off_y = (y < 0) ? -y : 0;
+
+    const int max_x = MIN(x + (int)bitmap->width, (int)surface->width);
+    const int max_y = MIN(y + (int)bitmap->rows, (int)surface->height);
+
+    const int rx = MAX(0, x);
+    const int ry = MAX(0, y);
+
+    FT_Byte *dst = ((FT_Byte *)surface->buffer) + (rx * 4) +
+                   (ry * surface->pitch);
+    const FT_Byte *src = bitmap->buffer + off_x + (off_y * bitmap->pitch);
+
+    const FT_UInt32 full_color =
+        SDL_MapRGBA(surface->format, (FT_Byte)color->r, (FT_Byte)color->g,
+                    (FT_Byte)color->b, 255);
+    const FT_UInt32 keep =
+        format->Rmask | format->Gmask | format->Bmask | format->Amask;
+    int j;
+
+    if (color->a == 0 || max_x <= rx) {
+        return;
+    }
+    for (j = ry; j < max_y; ++j) {
+        render_row(src, (Uint32 *)dst, max_x - rx, full_color, keep,
+                   format->Amask, format->Ashift, color->a);
+        dst += surface->pitch;
+        src += bitmap->pitch;
+    }
+}
+
+static void
+__render_glyph_RGB4_sse2(int x, int y, FontSurface *surface,
+                         const FT_Bitmap *bitmap, const FontColor *color)
+{
+    _render_glyph_RGB4_rows(x, y, surface, bitmap, color,
+                            __render_row_RGB4_sse2);
+}
+
+static void
+__render_glyph_RGB4_avx2(int x, int y, FontSurface *surface,
+                         const FT_Bitmap *bitmap, const FontColor *color)
+{
+    _render_glyph_RGB4_rows(x, y, surface, bitmap, color,
+                            __render_row_RGB4_avx2);
+}
+
+FontRenderPtr
+__select_render_glyph_RGB4(const SDL_PixelFormat *format)
+{
+    if (!_is_byte_channel(format->Rmask, format->Rshift) ||
+        !_is_byte_channel(format->Gmask, format->Gshift) ||
+        !_is_byte_channel(format->Bmask, format->Bshift) ||
+        (format->Amask && !_is_byte_channel(format->Amask, format->Ashift))) {
+        return __render_glyph_RGB4;
+    }
+    if (_pgft_has_avx2()) {
+        return __render_glyph_RGB4_avx2;
+    }
+    if (_pgft_HasSSE_NEON()) {
+        return __render_glyph_RGB4_sse2;
+    }
+    return __render_glyph_RGB4;
+}
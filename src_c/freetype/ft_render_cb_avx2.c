@@ -0,0 +1,168 @@
+#include "ft_render_cb_simd.h"
+
+#if defined(HAVE_IMMINTRIN_H) && !defined(SDL_DISABLE_IMMINTRIN_H)
+#include <immintrin.h>
+#endif /* defined(HAVE_IMMINTRIN_H) && !defined(SDL_DISABLE_IMMINTRIN_H) */
+
+#define BAD_AVX2_FUNCTION_CALL                                               \
+    printf(                                                                  \
+        "Fatal Error: Attempted calling an AVX2 function when both compile " \
+        "time and runtime support is missing. If you are seeing this "       \
+        "message, you have stumbled across a pygame bug, please report it "  \
+        "to the devs!");                                                     \
+    PG_EXIT(1)
+
+/* helper function that does a runtime check for AVX2. It has the added
+ * functionality of also returning 0 if compile time support is missing or
+ * pygame.system.set_simd_level() is below it */
+int
+_pgft_has_avx2()
+{
+#if defined(__AVX2__) && defined(HAVE_IMMINTRIN_H) && \
+    !defined(SDL_DISABLE_IMMINTRIN_H)
+    return pg_simd_max_level() >= PG_SIMD_AVX2 && SDL_HasAVX2();
+#else
+    return 0;
+#endif /* defined(__AVX2__) && defined(HAVE_IMMINTRIN_H) && \
+          !defined(SDL_DISABLE_IMMINTRIN_H) */
+}
+
+#if defined(__AVX2__) && defined(HAVE_IMMINTRIN_H) && \
+    !defined(SDL_DISABLE_IMMINTRIN_H)
+/* x / 255 for 0 <= x <= 65025, in the low 16 bit lanes */
+static PG_INLINE __m256i
+_div255_avx2(__m256i x, __m256i one, __m256i m257)
+{
+    return _mm256_mulhi_epu16(_mm256_add_epi16(x, one), m257);
+}
+
+/* Blends the 16 bit channels of two pixels in each 128 bit half, see
+ * _pgft_blend_pixel_RGB4 */
+static PG_INLINE __m256i
+_blend_channels_avx2(__m256i d, __m256i a, __m256i s, __m256i alpha_lanes)
+{
+    const __m256i one = _mm256_set1_epi16(1);
+    __m256i color, alpha;
+
+    color = _mm256_add_epi16(
+        _mm256_mullo_epi16(s, _mm256_add_epi16(a, one)),
+        _mm256_mullo_epi16(d, _mm256_sub_epi16(_mm256_set1_epi16(256), a)));
+    color = _mm256_srli_epi16(color, 8);
+    alpha = _mm256_sub_epi16(
+        _mm256_add_epi16(a, d),
+        _div255_avx2(_mm256_mullo_epi16(a, d), one, _mm256_set1_epi16(257)));
+    return _mm256_blendv_epi8(color, alpha, alpha_lanes);
+}
+
+void
+__render_row_RGB4_avx2(const Uint8 *cov, Uint32 *dst, int n,
+                       Uint32 full_color, Uint32 keep, Uint32 amask,
+                       int ashift, int alpha)
+{
+    const __m256i mm_zero = _mm256_setzero_si256();
+    const __m256i mm_full = _mm256_set1_epi32((int)full_color);
+    const __m256i mm_keep = _mm256_set1_epi32((int)keep);
+    const __m256i mm_amask = _mm256_set1_epi32((int)amask);
+    const __m256i mm_has_amask = _mm256_set1_epi32(amask ? -1 : 0);
+    const __m256i mm_color = _mm256_andnot_si256(mm_amask, mm_full);
+    const __m256i mm_s = _mm256_unpacklo_epi8(mm_full, mm_zero);
+    const __m256i mm_alpha_lanes = _mm256_unpacklo_epi8(mm_amask, mm_amask);
+    const __m256i mm_alpha = _mm256_set1_epi32(alpha);
+    const __m256i mm_one = _mm256_set1_epi32(1);
+    const __m256i mm_257 = _mm256_set1_epi32(257);
+    const __m128i mm_ashift = _mm_cvtsi32_si128(ashift);
+    const __m256i mm_255 = _mm256_set1_epi32(255);
+    __m256i mm_a, mm_a2, mm_d, mm_out, mm_first;
+    Uint64 c;
+    int x;
+
+    for (x = 0; x + 8 <= n; x += 8) {
+        memcpy(&c, cov + x, sizeof(c));
+        if (!c) {
+            continue;
+        }
+
+        /* the alpha of each pixel in a 32 bit lane, and in all four 16 bit
+         * channel lanes of each pixel. The unpacks work within the 128 bit
+         * halves, which matches the unpacked destination pixels. */
+        mm_a = _mm256_cvtepu8_epi32(_mm_loadl_epi64((const __m128i *)&c));
+        mm_a = _div255_avx2(_mm256_mullo_epi16(mm_a, mm_alpha), mm_one,
+                            mm_257);
+        mm_a2 = _mm256_or_si256(mm_a, _mm256_slli_epi32(mm_a, 16));
+
+        mm_d = _mm256_loadu_si256((const __m256i *)(dst + x));
+        mm_first = _blend_channels_avx2(_mm256_unpacklo_epi8(mm_d, mm_zero),
+                                        _mm256_unpacklo_epi32(mm_a2, mm_a2),
+                                        mm_s, mm_alpha_lanes);
+        mm_out = _blend_channels_avx2(_mm256_unpackhi_epi8(mm_d, mm_zero),
+                                      _mm256_unpackhi_epi32(mm_a2, mm_a2),
+                                      mm_s, mm_alpha_lanes);
+        mm_out = _mm256_and_si256(_mm256_packus_epi16(mm_first, mm_out),
+                                  mm_keep);
+
+        /* transparent pixels take the color as is */
+        mm_out = _mm256_blendv_epi8(
+            mm_out,
+            _mm256_or_si256(mm_color, _mm256_sll_epi32(mm_a, mm_ashift)),
+            _mm256_and_si256(
+                mm_has_amask,
+                _mm256_cmpeq_epi32(_mm256_and_si256(mm_d, mm_amask),
+                                   mm_zero)));
+        mm_out = _mm256_blendv_epi8(mm_out, mm_full,
+                                    _mm256_cmpeq_epi32(mm_a, mm_255));
+        mm_out = _mm256_blendv_epi8(mm_out, mm_d,
+                                    _mm256_cmpeq_epi32(mm_a, mm_zero));
+        _mm256_storeu_si256((__m256i *)(dst + x), mm_out);
+    }
+    for (; x < n; x++) {
+        dst[x] = _pgft_blend_pixel_RGB4(dst[x], cov[x], full_color, keep,
+                                        amask, ashift, alpha);
+    }
+}
+
+void
+__sdf_threshold_row_avx2(const float *distance, Uint8 *coverage, int n,
+                         float gain, float bias)
+{
+    const __m256 mm256_gain = _mm256_set1_ps(gain);
+    const __m256 mm256_bias = _mm256_set1_ps(bias);
+    const __m256 mm256_zero = _mm256_setzero_ps();
+    const __m256 mm256_255 = _mm256_set1_ps(255.0f);
+    __m256 mm256_value;
+    __m256i mm256_cov;
+    __m128i mm_cov;
+    int x;
+
+    for (x = 0; x + 8 <= n; x += 8) {
+        mm256_value = _mm256_add_ps(
+            _mm256_mul_ps(_mm256_loadu_ps(distance + x), mm256_gain),
+            mm256_bias);
+        mm256_value =
+            _mm256_min_ps(_mm256_max_ps(mm256_value, mm256_zero), mm256_255);
+        mm256_cov = _mm256_cvttps_epi32(mm256_value);
+        mm_cov = _mm_packs_epi32(_mm256_castsi256_si128(mm256_cov),
+                                 _mm256_extracti128_si256(mm256_cov, 1));
+        mm_cov = _mm_packus_epi16(mm_cov, mm_cov);
+        _mm_storel_epi64((__m128i *)(coverage + x), mm_cov);
+    }
+    for (; x < n; x++) {
+        coverage[x] = _pgft_sdf_coverage(distance[x], gain, bias);
+    }
+}
+#else
+void
+__render_row_RGB4_avx2(const Uint8 *cov, Uint32 *dst, int n,
+                       Uint32 full_color, Uint32 keep, Uint32 amask,
+                       int ashift, int alpha)
+{
+    BAD_AVX2_FUNCTION_CALL;
+}
+
+void
+__sdf_threshold_row_avx2(const float *distance, Uint8 *coverage, int n,
+                         float gain, float bias)
+{
+    BAD_AVX2_FUNCTION_CALL;
+}
+#endif /* defined(__AVX2__) && defined(HAVE_IMMINTRIN_H) && \
+          !defined(SDL_DISABLE_IMMINTRIN_H) */
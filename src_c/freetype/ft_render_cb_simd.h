@@ -0,0 +1,95 @@
+#define NO_PYGAME_C_API
+#include "../_pygame.h"
+
+#if !defined(PG_ENABLE_ARM_NEON) && defined(__aarch64__)
+// arm64 has neon optimisations enabled by default, even when fpu=neon is not
+// passed
+#define PG_ENABLE_ARM_NEON 1
+#endif
+
+int
+_pgft_has_avx2();
+
+/* This returns True if either SSE2 or NEON is present at runtime.
+ * Relevant because they use the same codepaths. Only the relevant runtime
+ * SDL cpu feature check is compiled in.*/
+int
+_pgft_HasSSE_NEON();
+
+/* Row kernel of __render_glyph_RGB4, for 32 bit formats whose channels are
+ * all 8 bits on a byte boundary. Blends the n coverage values of cov, scaled
+ * by alpha, into the n pixels of dst, exactly as the generic ALPHA_BLEND
+ * path does. full_color is the text color mapped with an opaque alpha, keep
+ * is the union of the format's channel masks and amask, ashift its alpha
+ * mask and shift (amask may be 0). */
+typedef void (*FT_RENDER_ROW_RGB4_P)(const Uint8 *cov, Uint32 *dst, int n,
+                                     Uint32 full_color, Uint32 keep,
+                                     Uint32 amask, int ashift, int alpha);
+
+/* The generic blend of one pixel, used by the kernels on the row tails */
+static PG_INLINE Uint32
+_pgft_blend_pixel_RGB4(Uint32 pixel, Uint32 cov, Uint32 full_color,
+                       Uint32 keep, Uint32 amask, int ashift, int alpha)
+{
+    Uint32 a = cov * (Uint32)alpha / 255;
+    Uint32 out = 0;
+    Uint32 s, d;
+    int shift;
+
+    if (a == 0) {
+        return pixel;
+    }
+    if (a == 255) {
+        return full_color;
+    }
+    if (amask && !(pixel & amask)) {
+        return (full_color & ~amask) | (a << ashift);
+    }
+    for (shift = 0; shift < 32; shift += 8) {
+        s = full_color >> shift & 0xFF;
+        d = pixel >> shift & 0xFF;
+        if (amask >> shift & 0xFF) {
+            out |= (a + d - a * d / 255) << shift;
+        }
+        else {
+            /* ((s - d) * a + s >> 8) + d, without the negative terms */
+            out |= (s * (a + 1) + d * (256 - a)) >> 8 << shift;
+        }
+    }
+    return out & keep;
+}
+
+void
+__render_row_RGB4_sse2(const Uint8 *cov, Uint32 *dst, int n,
+                       Uint32 full_color, Uint32 keep, Uint32 amask,
+                       int ashift, int alpha);
+
+void
+__render_row_RGB4_avx2(const Uint8 *cov, Uint32 *dst, int n,
+                       Uint32 full_color, Uint32 keep, Uint32 amask,
+                       int ashift, int alpha);
+
+/* The coverage of a distance field sample, see _PGFT_SDF_RenderGlyph.
+ * bias includes the 0.5 of rounding, so this truncates like the kernels. */
+static PG_INLINE Uint8
+_pgft_sdf_coverage(float distance, float gain, float bias)
+{
+    float value = distance * gain + bias;
+
+    if (value <= 0.0f) {
+        return 0;
+    }
+    if (value >= 255.0f) {
+        return 255;
+    }
+    return (Uint8)value;
+}
+
+/* Threshold n interpolated distance field samples into coverage values */
+void
+__sdf_threshold_row_sse2(const float *distance, Uint8 *coverage, int n,
+                         float gain, float bias);
+
+void
+__sdf_threshold_row_avx2(const float *distance, Uint8 *coverage, int n,
+                         float gain, float bias);
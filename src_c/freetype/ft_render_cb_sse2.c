@@ -0,0 +1,159 @@
+#include "ft_render_cb_simd.h"
+
+#if PG_ENABLE_ARM_NEON
+// sse2neon.h is from here: https://github.com/DLTcollab/sse2neon
+#include "../include/sse2neon.h"
+#endif /* PG_ENABLE_ARM_NEON */
+
+#define BAD_SSE2_FUNCTION_CALL                                               \
+    printf(                                                                  \
+        "Fatal Error: Attempted calling an SSE2 function when both compile " \
+        "time and runtime support is missing. If you are seeing this "       \
+        "message, you have stumbled across a pygame bug, please report it "  \
+        "to the devs!");                                                     \
+    PG_EXIT(1)
+
+int
+_pgft_HasSSE_NEON()
+{
+#if defined(__SSE2__)
+    return pg_simd_max_level() >= PG_SIMD_SSE2_NEON && SDL_HasSSE2();
+#elif PG_ENABLE_ARM_NEON
+    return pg_simd_max_level() >= PG_SIMD_SSE2_NEON && SDL_HasNEON();
+#else
+    return 0;
+#endif
+}
+
+#if defined(__SSE2__) || defined(PG_ENABLE_ARM_NEON)
+/* x / 255 for 0 <= x <= 65025, in 16 bit lanes */
+static PG_INLINE __m128i
+_div255_sse2(__m128i x)
+{
+    return _mm_mulhi_epu16(_mm_add_epi16(x, _mm_set1_epi16(1)),
+                           _mm_set1_epi16(257));
+}
+
+/* Blends the 16 bit channels of two pixels, see _pgft_blend_pixel_RGB4 */
+static PG_INLINE __m128i
+_blend_channels_sse2(__m128i d, __m128i a, __m128i s, __m128i alpha_lanes)
+{
+    __m128i color, alpha;
+
+    color = _mm_add_epi16(
+        _mm_mullo_epi16(s, _mm_add_epi16(a, _mm_set1_epi16(1))),
+        _mm_mullo_epi16(d, _mm_sub_epi16(_mm_set1_epi16(256), a)));
+    color = _mm_srli_epi16(color, 8);
+    alpha = _mm_sub_epi16(_mm_add_epi16(a, d),
+                          _div255_sse2(_mm_mullo_epi16(a, d)));
+    return _mm_or_si128(_mm_and_si128(alpha_lanes, alpha),
+                        _mm_andnot_si128(alpha_lanes, color));
+}
+
+static PG_INLINE __m128i
+_select_sse2(__m128i mask, __m128i a, __m128i b)
+{
+    return _mm_or_si128(_mm_and_si128(mask, a), _mm_andnot_si128(mask, b));
+}
+
+void
+__render_row_RGB4_sse2(const Uint8 *cov, Uint32 *dst, int n,
+                       Uint32 full_color, Uint32 keep, Uint32 amask,
+                       int ashift, int alpha)
+{
+    const __m128i mm_zero = _mm_setzero_si128();
+    const __m128i mm_full = _mm_set1_epi32((int)full_color);
+    const __m128i mm_keep = _mm_set1_epi32((int)keep);
+    const __m128i mm_amask = _mm_set1_epi32((int)amask);
+    const __m128i mm_has_amask = _mm_set1_epi32(amask ? -1 : 0);
+    const __m128i mm_color = _mm_andnot_si128(mm_amask, mm_full);
+    const __m128i mm_s = _mm_unpacklo_epi8(mm_full, mm_zero);
+    const __m128i mm_alpha_lanes = _mm_unpacklo_epi8(mm_amask, mm_amask);
+    const __m128i mm_alpha = _mm_set1_epi16((short)alpha);
+    const __m128i mm_ashift = _mm_cvtsi32_si128(ashift);
+    const __m128i mm_255 = _mm_set1_epi32(255);
+    __m128i mm_a, mm_a2, mm_d, mm_out, mm_first;
+    Uint32 c;
+    int x;
+
+    for (x = 0; x + 4 <= n; x += 4) {
+        memcpy(&c, cov + x, sizeof(c));
+        if (!c) {
+            continue;
+        }
+
+        /* the alpha of each pixel in a 32 bit lane, and in all four 16 bit
+         * channel lanes of each pixel */
+        mm_a = _mm_unpacklo_epi8(_mm_cvtsi32_si128((int)c), mm_zero);
+        mm_a = _div255_sse2(_mm_mullo_epi16(mm_a, mm_alpha));
+        mm_a = _mm_unpacklo_epi16(mm_a, mm_zero);
+        mm_a2 = _mm_or_si128(mm_a, _mm_slli_epi32(mm_a, 16));
+
+        mm_d = _mm_loadu_si128((const __m128i *)(dst + x));
+        mm_first = _blend_channels_sse2(_mm_unpacklo_epi8(mm_d, mm_zero),
+                                        _mm_unpacklo_epi32(mm_a2, mm_a2),
+                                        mm_s, mm_alpha_lanes);
+        mm_out = _blend_channels_sse2(_mm_unpackhi_epi8(mm_d, mm_zero),
+                                      _mm_unpackhi_epi32(mm_a2, mm_a2),
+                                      mm_s, mm_alpha_lanes);
+        mm_out = _mm_and_si128(_mm_packus_epi16(mm_first, mm_out), mm_keep);
+
+        /* transparent pixels take the color as is */
+        mm_out = _select_sse2(
+            _mm_and_si128(mm_has_amask,
+                          _mm_cmpeq_epi32(_mm_and_si128(mm_d, mm_amask),
+                                          mm_zero)),
+            _mm_or_si128(mm_color, _mm_sll_epi32(mm_a, mm_ashift)), mm_out);
+        mm_out = _select_sse2(_mm_cmpeq_epi32(mm_a, mm_255), mm_full, mm_out);
+        mm_out = _select_sse2(_mm_cmpeq_epi32(mm_a, mm_zero), mm_d, mm_out);
+        _mm_storeu_si128((__m128i *)(dst + x), mm_out);
+    }
+    for (; x < n; x++) {
+        dst[x] = _pgft_blend_pixel_RGB4(dst[x], cov[x], full_color, keep,
+                                        amask, ashift, alpha);
+    }
+}
+
+void
+__sdf_threshold_row_sse2(const float *distance, Uint8 *coverage, int n,
+                         float gain, float bias)
+{
+    const __m128 mm_gain = _mm_set1_ps(gain);
+    const __m128 mm_bias = _mm_set1_ps(bias);
+    const __m128 mm_zero = _mm_setzero_ps();
+    const __m128 mm_255 = _mm_set1_ps(255.0f);
+    __m128 mm_value;
+    __m128i mm_cov;
+    Uint32 c;
+    int x;
+
+    for (x = 0; x + 4 <= n; x += 4) {
+        mm_value = _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(distance + x), mm_gain),
+                              mm_bias);
+        mm_value = _mm_min_ps(_mm_max_ps(mm_value, mm_zero), mm_255);
+        mm_cov = _mm_cvttps_epi32(mm_value);
+        mm_cov = _mm_packs_epi32(mm_cov, mm_cov);
+        mm_cov = _mm_packus_epi16(mm_cov, mm_cov);
+        c = (Uint32)_mm_cvtsi128_si32(mm_cov);
+        memcpy(coverage + x, &c, sizeof(c));
+    }
+    for (; x < n; x++) {
+        coverage[x] = _pgft_sdf_coverage(distance[x], gain, bias);
+    }
+}
+#else
+void
+__render_row_RGB4_sse2(const Uint8 *cov, Uint32 *dst, int n,
+                       Uint32 full_color, Uint32 keep, Uint32 amask,
+                       int ashift, int alpha)
+{
+    BAD_SSE2_FUNCTION_CALL;
+}
+
+void
+__sdf_threshold_row_sse2(const float *distance, Uint8 *coverage, int n,
+                         float gain, float bias)
+{
+    BAD_SSE2_FUNCTION_CALL;
+}
+#endif /* defined(__SSE2__) || defined(PG_ENABLE_ARM_NEON) */
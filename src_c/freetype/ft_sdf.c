@@ -0,0 +1,465 @@
+/*
+  pygame-ce - Python Game Library
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Library General Public
+  License as published by the Free Software Foundation; either
+  version 2 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Library General Public License for more details.
+
+  You should have received a copy of the GNU Library General Public
+  License along with this library; if not, write to the Free
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+*/
+
+#define PYGAME_FREETYPE_INTERNAL
+#define NO_PYGAME_C_API
+
+#include "ft_wrap.h"
+#include "ft_render_cb_simd.h"
+#include FT_OUTLINE_H
+#include FT_BITMAP_H
+
+#include <math.h>
+
+#if defined(PGFT_HAVE_SDF)
+
+#define SDF_MIN_BUCKETS 64
+#define SDF_EDGE 128 /* Field value on the outline */
+
+/* The distance field of one glyph, rendered from its outline scaled to
+ * PGFT_SDF_BASE_SIZE pixels per em. Each byte holds the signed distance of
+ * a pixel center to the outline, positive inside, as
+ * SDF_EDGE + distance * 127 / PGFT_SDF_SPREAD. left and top place the
+ * field relative to the glyph origin, in base size pixels, y up.
+ */
+typedef struct sdfglyph_ {
+    struct sdfglyph_ *next;
+    GlyphIndex_t id;
+    int width;
+    int rows;
+    int left;
+    int top;
+    FT_Byte field[1];
+} SdfGlyph;
+
+typedef void (*SdfThresholdPtr)(const float *, Uint8 *, int, float, float);
+
+static SdfGlyph *
+find_field(FontCache *, GlyphIndex_t);
+static SdfGlyph *
+build_field(FreeTypeInstance *, FT_Face, GlyphIndex_t);
+static void
+fill_distances(SdfGlyph *, const FT_Byte *);
+static int
+grow_fields(FontCache *);
+static void
+threshold_row(const float *, Uint8 *, int, float, float);
+static SdfThresholdPtr
+select_threshold_row(void);
+
+void
+_PGFT_SDF_Free(FontCache *cache)
+{
+    SdfGlyph *node, *next;
+    FT_UInt32 i;
+
+    if (!cache->sdf_nodes) {
+        return;
+    }
+    for (i = 0; i <= cache->sdf_mask; ++i) {
+        for (node = cache->sdf_nodes[i]; node; node = next) {
+            next = node->next;
+            _PGFT_free(node);
+        }
+    }
+    _PGFT_free(cache->sdf_nodes);
+    cache->sdf_nodes = 0;
+    cache->sdf_mask = 0;
+    cache->sdf_count = 0;
+    cache->sdf_bytes = 0;
+}
+
+/* Render glyph id of the sized face font from the face's distance field,
+ * building the field first if this is the glyph's first use. The outline
+ * is pushed out by strength, in 26.6 pixels, on every side. The result is
+ * a new 8 bit gray bitmap glyph.
+ *
+ * This loads the glyph into the face's glyph slot unscaled, so callers
+ * must load it again for its sized metrics.
+ */
+int
+_PGFT_SDF_RenderGlyph(FreeTypeInstance *ft, FontCache *cache, FT_Face font,
+                      GlyphIndex_t id, FT_Pos strength, FT_Glyph *image)
+{
+    static SdfThresholdPtr threshold = 0;
+
+    FT_Library lib = ft->library;
+    PyThreadState *state;
+    SdfGlyph *sdf = find_field(cache, id);
+    FT_BitmapGlyph bitmap_glyph;
+    FT_Bitmap bitmap;
+    double sx, sy, scale, offset;
+    double x_min, x_max, y_min, y_max, margin;
+    float gain, bias;
+    float *row = 0;
+    int *u0 = 0;
+    float *uf = 0;
+    int left, top, width, rows;
+    int i, j;
+
+    if (!sdf) {
+        sdf = build_field(ft, font, id);
+        if (!sdf) {
+            return -1;
+        }
+        if ((!cache->sdf_nodes ||
+             cache->sdf_count + 1 > 2 * (cache->sdf_mask + 1)) &&
+            grow_fields(cache)) {
+            _PGFT_free(sdf);
+            return -1;
+        }
+        sdf->next = cache->sdf_nodes[id & cache->sdf_mask];
+        cache->sdf_nodes[id & cache->sdf_mask] = sdf;
+        cache->sdf_count++;
+        cache->sdf_bytes += sizeof(SdfGlyph) + (size_t)sdf->width * sdf->rows;
+    }
+    if (!threshold) {
+        threshold = select_threshold_row();
+    }
+
+    /* Target pixels per base pixel, from the face's font unit scale */
+    sx = FX16_TO_DBL(font->size->metrics.x_scale) / 64.0 *
+         font->units_per_EM / PGFT_SDF_BASE_SIZE;
+    sy = FX16_TO_DBL(font->size->metrics.y_scale) / 64.0 *
+         font->units_per_EM / PGFT_SDF_BASE_SIZE;
+    scale = (sx + sy) / 2.0;
+    offset = FX6_TO_DBL(strength);
+
+    /* Keep only a thin margin of the field's padding */
+    margin = offset + 1.0;
+    left = 0;
+    top = 0;
+    width = 0;
+    rows = 0;
+    if (sdf->width > 2 * PGFT_SDF_SPREAD && sdf->rows > 2 * PGFT_SDF_SPREAD) {
+        x_min = (sdf->left + PGFT_SDF_SPREAD) * sx - margin;
+        x_max = (sdf->left + sdf->width - PGFT_SDF_SPREAD) * sx + margin;
+        y_max = (sdf->top - PGFT_SDF_SPREAD) * sy + margin;
+        y_min = (sdf->top - sdf->rows + PGFT_SDF_SPREAD) * sy - margin;
+        left = (int)floor(x_min);
+        top = (int)ceil(y_max);
+        width = (int)ceil(x_max) - left;
+        rows = top - (int)floor(y_min);
+    }
+
+    /* coverage = (distance * scale + 0.5 + offset) * 255, rounded */
+    gain = (float)(PGFT_SDF_SPREAD * scale * 255.0 / 127.0);
+    bias = (float)((0.5 + offset) * 255.0 - SDF_EDGE * gain + 0.5);
+
+    FT_Bitmap_Init(&bitmap);
+    bitmap.width = (unsigned int)width;
+    bitmap.rows = (unsigned int)rows;
+    bitmap.pitch = width;
+    bitmap.pixel_mode = FT_PIXEL_MODE_GRAY;
+    bitmap.num_grays = 256;
+    if (width && rows) {
+        bitmap.buffer = _PGFT_malloc((size_t)width * rows);
+        row = _PGFT_malloc(sizeof(float) * width);
+        u0 = _PGFT_malloc(sizeof(int) * width);
+        uf = _PGFT_malloc(sizeof(float) * width);
+        if (!bitmap.buffer || !row || !u0 || !uf) {
+            goto cleanup;
+        }
+
+        state = _PGFT_BeginRaster(ft);
+
+        /* The field column left of each target pixel center, and the
+         * weight of the column right of it */
+        for (i = 0; i < width; ++i) {
+            double u = (left + i + 0.5) / sx - sdf->left - 0.5;
+            double u_floor = floor(u);
+
+            u0[i] = (int)u_floor;
+            uf[i] = (float)(u - u_floor);
+        }
+
+        for (j = 0; j < rows; ++j) {
+            double v = sdf->top - (top - j - 0.5) / sy - 0.5;
+            double v_floor = floor(v);
+            int v0 = (int)v_floor;
+            float vf = (float)(v - v_floor);
+            const FT_Byte *above = 0;
+            const FT_Byte *below = 0;
+
+            if (v0 >= 0 && v0 < sdf->rows) {
+                above = sdf->field + (size_t)v0 * sdf->width;
+            }
+            if (v0 + 1 >= 0 && v0 + 1 < sdf->rows) {
+                below = sdf->field + (size_t)(v0 + 1) * sdf->width;
+            }
+            for (i = 0; i < width; ++i) {
+                int c0 = u0[i];
+                float a0 = 0, a1 = 0, b0 = 0, b1 = 0;
+
+                /* Outside the field is as far outside as it records */
+                if (above) {
+                    a0 = (c0 >= 0 && c0 < sdf->width) ? above[c0] : 0;
+                    a1 = (c0 + 1 >= 0 && c0 + 1 < sdf->width) ? above[c0 + 1]
+                                                               : 0;
+                }
+                if (below) {
+                    b0 = (c0 >= 0 && c0 < sdf->width) ? below[c0] : 0;
+                    b1 = (c0 + 1 >= 0 && c0 + 1 < sdf->width) ? below[c0 + 1]
+                                                               : 0;
+                }
+                a0 += (a1 - a0) * uf[i];
+                b0 += (b1 - b0) * uf[i];
+                row[i] = a0 + (b0 - a0) * vf;
+            }
+            threshold(row, bitmap.buffer + (size_t)j * width, width, gain,
+                      bias);
+        }
+        _PGFT_EndRaster(ft, state);
+    }
+
+    if (FT_New_Glyph(lib, FT_GLYPH_FORMAT_BITMAP, image)) {
+        goto cleanup;
+    }
+    bitmap_glyph = (FT_BitmapGlyph)*image;
+    bitmap_glyph->left = left;
+    bitmap_glyph->top = top;
+    if (FT_Bitmap_Copy(lib, &bitmap, &bitmap_glyph->bitmap)) {
+        FT_Done_Glyph(*image);
+        *image = 0;
+        goto cleanup;
+    }
+
+    _PGFT_free(bitmap.buffer);
+    _PGFT_free(row);
+    _PGFT_free(u0);
+    _PGFT_free(uf);
+    return 0;
+
+cleanup:
+    _PGFT_free(bitmap.buffer);
+    _PGFT_free(row);
+    _PGFT_free(u0);
+    _PGFT_free(uf);
+    return -1;
+}
+
+static SdfGlyph *
+find_field(FontCache *cache, GlyphIndex_t id)
+{
+    SdfGlyph *node;
+
+    if (!cache->sdf_nodes) {
+        return 0;
+    }
+    for (node = cache->sdf_nodes[id & cache->sdf_mask]; node;
+         node = node->next) {
+        if (node->id == id) {
+            return node;
+        }
+    }
+    return 0;
+}
+
+static SdfGlyph *
+build_field(FreeTypeInstance *ft, FT_Face font, GlyphIndex_t id)
+{
+    PyThreadState *state;
+    FT_Error error;
+    FT_Outline *outline;
+    FT_Matrix to_base;
+    FT_BBox box;
+    FT_Bitmap coverage;
+    SdfGlyph *sdf;
+    int width = 0, rows = 0, x_min = 0, y_max = 0;
+
+    if (FT_Load_Glyph(font, id, FT_LOAD_NO_SCALE | FT_LOAD_NO_BITMAP) ||
+        font->glyph->format != FT_GLYPH_FORMAT_OUTLINE) {
+        return 0;
+    }
+
+    /* Font units to 26.6 base size pixels */
+    outline = &font->glyph->outline;
+    to_base.xx = to_base.yy =
+        FT_DivFix(INT_TO_FX6(PGFT_SDF_BASE_SIZE), font->units_per_EM);
+    to_base.xy = to_base.yx = 0;
+    FT_Outline_Transform(outline, &to_base);
+
+    if (outline->n_points) {
+        FT_Outline_Get_CBox(outline, &box);
+        x_min = (int)FX6_TRUNC(FX6_FLOOR(box.xMin)) - PGFT_SDF_SPREAD;
+        y_max = (int)FX6_TRUNC(FX6_CEIL(box.yMax)) + PGFT_SDF_SPREAD;
+        width = (int)FX6_TRUNC(FX6_CEIL(box.xMax)) + PGFT_SDF_SPREAD - x_min;
+        rows = y_max - ((int)FX6_TRUNC(FX6_FLOOR(box.yMin)) - PGFT_SDF_SPREAD);
+    }
+
+    sdf = _PGFT_malloc(sizeof(SdfGlyph) + (size_t)width * rows);
+    if (!sdf) {
+        return 0;
+    }
+    sdf->next = 0;
+    sdf->id = id;
+    sdf->width = width;
+    sdf->rows = rows;
+    sdf->left = x_min;
+    sdf->top = y_max;
+    if (!width || !rows) {
+        return sdf;
+    }
+
+    /* The one rasterisation of the glyph, at the base size */
+    FT_Bitmap_Init(&coverage);
+    coverage.width = (unsigned int)width;
+    coverage.rows = (unsigned int)rows;
+    coverage.pitch = width;
+    coverage.pixel_mode = FT_PIXEL_MODE_GRAY;
+    coverage.num_grays = 256;
+    coverage.buffer = _PGFT_calloc((size_t)width * rows, 1);
+    if (!coverage.buffer) {
+        _PGFT_free(sdf);
+        return 0;
+    }
+    FT_Outline_Translate(outline, -INT_TO_FX6(x_min),
+                         -INT_TO_FX6(y_max - rows));
+    state = _PGFT_BeginRaster(ft);
+    error = FT_Outline_Get_Bitmap(ft->library, outline, &coverage);
+    if (!error) {
+        fill_distances(sdf, coverage.buffer);
+    }
+    _PGFT_EndRaster(ft, state);
+    _PGFT_free(coverage.buffer);
+    if (error) {
+        _PGFT_free(sdf);
+        return 0;
+    }
+    return sdf;
+}
+
+/* Convert the antialiased coverage of the base size glyph to distances.
+ * Edge pixels take their distance from their own coverage; every other
+ * pixel from the nearest pixel on the other side of the outline, searched
+ * within PGFT_SDF_SPREAD. This runs once per glyph and face.
+ */
+static void
+fill_distances(SdfGlyph *sdf, const FT_Byte *coverage)
+{
+    const int spread = PGFT_SDF_SPREAD;
+    const int max_d2 = (spread + 1) * (spread + 1);
+    int width = sdf->width;
+    int rows = sdf->rows;
+    int x, y, dx, dy, d2, best;
+    double distance;
+    int inside, value;
+
+    for (y = 0; y < rows; ++y) {
+        for (x = 0; x < width; ++x) {
+            FT_Byte c = coverage[y * width + x];
+
+            if (c > 0 && c < 255) {
+                distance = c / 255.0 - 0.5;
+            }
+            else {
+                inside = c >= SDF_EDGE;
+                best = max_d2;
+                for (dy = -spread; dy <= spread; ++dy) {
+                    if (y + dy < 0 || y + dy >= rows || dy * dy >= best) {
+                        continue;
+                    }
+                    for (dx = -spread; dx <= spread; ++dx) {
+                        if (x + dx < 0 || x + dx >= width) {
+                            continue;
+                        }
+                        d2 = dx * dx + dy * dy;
+                        if (d2 < best &&
+                            (coverage[(y + dy) * width + x + dx] >=
+                             SDF_EDGE) != inside) {
+                            best = d2;
+                        }
+                    }
+                }
+                distance = sqrt((double)best) - 0.5;
+                if (!inside) {
+                    distance = -distance;
+                }
+            }
+            value = SDF_EDGE + (int)floor(distance * 127.0 / spread + 0.5);
+            sdf->field[y * width + x] = (FT_Byte)MAX(0, MIN(255, value));
+        }
+    }
+}
+
+static int
+grow_fields(FontCache *cache)
+{
+    FT_UInt32 size = cache->sdf_nodes ? 2 * (cache->sdf_mask + 1)
+                                      : SDF_MIN_BUCKETS;
+    SdfGlyph **nodes = _PGFT_calloc(size, sizeof(SdfGlyph *));
+    SdfGlyph *node, *next;
+    FT_UInt32 i;
+
+    if (!nodes) {
+        return -1;
+    }
+    if (cache->sdf_nodes) {
+        for (i = 0; i <= cache->sdf_mask; ++i) {
+            for (node = cache->sdf_nodes[i]; node; node = next) {
+                next = node->next;
+                node->next = nodes[node->id & (size - 1)];
+                nodes[node->id & (size - 1)] = node;
+            }
+        }
+        _PGFT_free(cache->sdf_nodes);
+    }
+    cache->sdf_nodes = nodes;
+    cache->sdf_mask = size - 1;
+    return 0;
+}
+
+static void
+threshold_row(const float *distance, Uint8 *coverage, int n, float gain,
+              float bias)
+{
+    int x;
+
+    for (x = 0; x < n; ++x) {
+        coverage[x] = _pgft_sdf_coverage(distance[x], gain, bias);
+    }
+}
+
+static SdfThresholdPtr
+select_threshold_row(void)
+{
+    if (_pgft_has_avx2()) {
+        return __sdf_threshold_row_avx2;
+    }
+    if (_pgft_HasSSE_NEON()) {
+        return __sdf_threshold_row_sse2;
+    }
+    return threshold_row;
+}
+
+#else /* !defined(PGFT_HAVE_SDF) */
+
+void
+_PGFT_SDF_Free(FontCache *cache)
+{
+}
+
+int
+_PGFT_SDF_RenderGlyph(FreeTypeInstance *ft, FontCache *cache, FT_Face font,
+                      GlyphIndex_t id, FT_Pos strength, FT_Glyph *image)
+{
+    return -1;
+}
+
+#endif /* defined(PGFT_HAVE_SDF) */
@@ -341,7 +341,7 @@ _PGFT_GetFont(FreeTypeInstance *ft, pgFontObject *fontobj)
     FT_Face font;
 
     error = FTC_Manager_LookupFace(ft->cache_manager,
-                                   (FTC_FaceID)(&fontobj->id), &font);
+                                   (FTC_FaceID)fontobj->face_id, &font);
 
     if (error) {
         _PGFT_SetError(ft, "Failed to load font", error);
@@ -359,7 +359,7 @@ _PGFT_GetFont(FreeTypeInstance *ft, pgFontObject *fontobj)
 void
 _PGFT_BuildScaler(pgFontObject *fontobj, FTC_Scaler scale, Scale_t face_size)
 {
-    scale->face_id = (FTC_FaceID)(&fontobj->id);
+    scale->face_id = (FTC_FaceID)fontobj->face_id;
     scale->width = face_size.x;
     scale->height = face_size.y ? face_size.y : face_size.x;
     scale->pixel = 0;
@@ -378,9 +378,20 @@ static FT_Error
 _PGFT_font_request(FTC_FaceID font_id, FT_Library library,
                    FT_Pointer request_data, FT_Face *afont)
 {
+    FreeTypeInstance *ft = (FreeTypeInstance *)request_data;
     pgFontId *id = (pgFontId *)font_id;
+    SharedFace *face;
     FT_Error error;
 
+    /* Another thread could open the same shared face while this one is
+     * without the GIL, and the two would read its stream at once */
+    for (face = ft->shared_faces; face; face = face->next) {
+        if (&face->id == id) {
+            return FT_Open_Face(library, &id->open_args, id->font_index,
+                                afont);
+        }
+    }
+
     Py_BEGIN_ALLOW_THREADS;
     error = FT_Open_Face(library, &id->open_args, id->font_index, afont);
     Py_END_ALLOW_THREADS;
@@ -460,6 +471,7 @@ _PGFT_TryLoadFont_Filename(FreeTypeInstance *ft, pgFontObject *fontobj,
     fontobj->id.font_index = (FT_Long)font_index;
     fontobj->id.open_args.flags = FT_OPEN_PATHNAME;
     fontobj->id.open_args.pathname = filename_alloc;
+    fontobj->face_id = &fontobj->id;
 
     return ft_wrap_init(ft, fontobj);
 }
@@ -479,9 +491,8 @@ RWops_read(FT_Stream stream, unsigned long offset, unsigned char *buffer,
     return (unsigned long)SDL_RWread(src, buffer, 1, (int)count);
 }
 
-int
-_PGFT_TryLoadFont_RWops(FreeTypeInstance *ft, pgFontObject *fontobj,
-                        SDL_RWops *src, long font_index)
+static FT_Stream
+RWops_stream(SDL_RWops *src)
 {
     FT_Stream stream;
     Sint64 position;
@@ -489,30 +500,135 @@ _PGFT_TryLoadFont_RWops(FreeTypeInstance *ft, pgFontObject *fontobj,
     position = SDL_RWtell(src);
     if (position < 0) {
         PyErr_SetString(pgExc_SDLError, "Failed to seek in font stream");
-        return -1;
+        return 0;
     }
 
     stream = _PGFT_calloc(1, sizeof(*stream));
     if (!stream) {
         PyErr_NoMemory();
-        return -1;
+        return 0;
     }
     stream->read = RWops_read;
     stream->descriptor.pointer = src;
     stream->pos = (unsigned long)position;
     stream->size = (unsigned long)(SDL_RWsize(src));
+    return stream;
+}
+
+int
+_PGFT_TryLoadFont_RWops(FreeTypeInstance *ft, pgFontObject *fontobj,
+                        SDL_RWops *src, long font_index)
+{
+    FT_Stream stream = RWops_stream(src);
+
+    if (!stream) {
+        return -1;
+    }
 
     fontobj->id.font_index = (FT_Long)font_index;
     fontobj->id.open_args.flags = FT_OPEN_STREAM;
     fontobj->id.open_args.stream = stream;
+    fontobj->face_id = &fontobj->id;
 
     return ft_wrap_init(ft, fontobj);
 }
 
+static void
+_PGFT_ReleaseFace(FreeTypeInstance *ft, SharedFace *face)
+{
+    if (--face->ref_count != 0) {
+        return;
+    }
+    if (ft) {
+        FTC_Manager_RemoveFaceID(ft->cache_manager, (FTC_FaceID)&face->id);
+    }
+    *face->prev = face->next;
+    if (face->next) {
+        face->next->prev = face->prev;
+    }
+    SDL_RWclose((SDL_RWops *)face->id.open_args.stream->descriptor.pointer);
+    _PGFT_free(face->id.open_args.stream);
+    _PGFT_free(face->path);
+    _PGFT_free(face);
+}
+
+/* Load the font from the face shared by all fonts opened from path with
+ * the same face index, or make src the stream of a new shared face. The
+ * file size is compared too, so a file replaced in between gets a face of
+ * its own. src is owned by the shared face, or closed, after the call.
+ */
+int
+_PGFT_TryLoadFont_Shared(FreeTypeInstance *ft, pgFontObject *fontobj,
+                         SDL_RWops *src, long font_index, const char *path)
+{
+    unsigned long size = (unsigned long)(SDL_RWsize(src));
+    SharedFace *face;
+    size_t path_len;
+
+    for (face = ft->shared_faces; face; face = face->next) {
+        if (face->id.font_index == (FT_Long)font_index &&
+            face->id.open_args.stream->size == size &&
+            strcmp(face->path, path) == 0) {
+            break;
+        }
+    }
+
+    if (face) {
+        SDL_RWclose(src);
+        ++face->ref_count;
+    }
+    else {
+        face = _PGFT_calloc(1, sizeof(SharedFace));
+        path_len = strlen(path);
+        if (face) {
+            face->path = _PGFT_malloc(path_len + 1);
+        }
+        if (!face || !face->path) {
+            if (face) {
+                _PGFT_free(face);
+            }
+            SDL_RWclose(src);
+            PyErr_NoMemory();
+            return -1;
+        }
+        face->id.open_args.stream = RWops_stream(src);
+        if (!face->id.open_args.stream) {
+            _PGFT_free(face->path);
+            _PGFT_free(face);
+            SDL_RWclose(src);
+            return -1;
+        }
+        memcpy(face->path, path, path_len + 1);
+        face->id.font_index = (FT_Long)font_index;
+        face->id.open_args.flags = FT_OPEN_STREAM;
+        face->ref_count = 1;
+
+        face->next = ft->shared_faces;
+        if (face->next) {
+            face->next->prev = &face->next;
+        }
+        face->prev = &ft->shared_faces;
+        ft->shared_faces = face;
+    }
+
+    fontobj->id.font_index = (FT_Long)font_index;
+    fontobj->face_id = &face->id;
+
+    if (ft_wrap_init(ft, fontobj)) {
+        /* Let go of the face while the manager is known to be there */
+        fontobj->face_id = &fontobj->id;
+        _PGFT_ReleaseFace(ft, face);
+        return -1;
+    }
+    return 0;
+}
+
 SDL_RWops *
 _PGFT_GetRWops(pgFontObject *fontobj)
 {
-    if (fontobj->id.open_args.flags == FT_OPEN_STREAM)
+    /* A shared face closes its stream itself */
+    if (fontobj->id.open_args.flags == FT_OPEN_STREAM &&
+        fontobj->face_id == &fontobj->id)
         return fontobj->id.open_args.stream->descriptor.pointer;
     return NULL;
 }
@@ -520,6 +636,15 @@ _PGFT_GetRWops(pgFontObject *fontobj)
 void
 _PGFT_UnloadFont(FreeTypeInstance *ft, pgFontObject *fontobj)
 {
+    if (fontobj->face_id && fontobj->face_id != &fontobj->id) {
+        if (ft) {
+            ft_wrap_quit(fontobj);
+        }
+        _PGFT_ReleaseFace(ft, (SharedFace *)fontobj->face_id);
+        fontobj->face_id = &fontobj->id;
+        return;
+    }
+
     if (fontobj->id.open_args.flags == 0)
         return;
 
@@ -558,9 +683,18 @@ _PGFT_Init(FreeTypeInstance **_instance, int cache_size)
     }
 
     inst->ref_count = 1;
+    inst->render_lock = 0;
     inst->cache_manager = 0;
     inst->library = 0;
     inst->cache_size = cache_size;
+    inst->shared_caches = 0;
+    inst->shared_faces = 0;
+    inst->render_lock = PyThread_allocate_lock();
+    inst->main_thread = PyThread_get_thread_ident();
+    if (!inst->render_lock) {
+        PyErr_NoMemory();
+        goto error_cleanup;
+    }
 
     error = FT_Init_FreeType(&inst->library);
     if (error) {
@@ -570,7 +704,7 @@ _PGFT_Init(FreeTypeInstance **_instance, int cache_size)
         goto error_cleanup;
     }
 
-    if (FTC_Manager_New(inst->library, 0, 0, 0, &_PGFT_font_request, 0,
+    if (FTC_Manager_New(inst->library, 0, 0, 0, &_PGFT_font_request, inst,
                         &inst->cache_manager) != 0) {
         PyErr_SetString(
             PyExc_RuntimeError,
@@ -612,5 +746,54 @@ _PGFT_Quit(FreeTypeInstance *ft)
     if (ft->library)
         FT_Done_FreeType(ft->library);
 
+    if (ft->render_lock)
+        PyThread_free_lock(ft->render_lock);
+
     _PGFT_free(ft);
 }
+
+/* Glyphs rasterised on threads other than the main one are rasterised
+ * without the GIL, so text rendered in the background leaves the main
+ * thread running. The main thread keeps the GIL: taking it back after every
+ * glyph could stall it behind the other threads.
+ *
+ * Faces, the cache manager and the glyph caches are only safe to use with
+ * the GIL held, so a thread rasterising without it holds render_lock, and
+ * font methods first wait for the lock with _PGFT_WaitIdle. Only code that
+ * uses no Python API may run between _PGFT_BeginRaster and _PGFT_EndRaster.
+ */
+PyThreadState *
+_PGFT_BeginRaster(FreeTypeInstance *ft)
+{
+    if (PyThread_get_thread_ident() == ft->main_thread ||
+        !PyThread_acquire_lock(ft->render_lock, NOWAIT_LOCK)) {
+        return 0;
+    }
+    return PyEval_SaveThread();
+}
+
+void
+_PGFT_EndRaster(FreeTypeInstance *ft, PyThreadState *state)
+{
+    if (state) {
+        PyEval_RestoreThread(state);
+        PyThread_release_lock(ft->render_lock);
+    }
+}
+
+void
+_PGFT_WaitIdle(FreeTypeInstance *ft)
+{
+    if (!ft) {
+        return;
+    }
+    /* The lock must be found free with the GIL held, or another glyph
+     * could be started in between */
+    while (!PyThread_acquire_lock(ft->render_lock, NOWAIT_LOCK)) {
+        Py_BEGIN_ALLOW_THREADS;
+        PyThread_acquire_lock(ft->render_lock, WAIT_LOCK);
+        PyThread_release_lock(ft->render_lock);
+        Py_END_ALLOW_THREADS;
+    }
+    PyThread_release_lock(ft->render_lock);
+}
@@ -51,6 +51,7 @@
 /* Internal configuration variables */
 #define PGFT_DEFAULT_CACHE_SIZE 64
 #define PGFT_MIN_CACHE_SIZE 32
+#define PGFT_DEFAULT_CACHE_BUDGET (2 << 20) /* bytes of glyph bitmaps */
 #if defined(PGFT_DEBUG_CACHE)
 #undef PGFT_DEBUG_CACHE
 #endif
@@ -58,6 +59,13 @@
 
 #define PGFT_DBL_DEFAULT_STRENGTH (1.0 / 36.0)
 
+/* Distance field glyphs need FT_New_Glyph */
+#if FREETYPE_MAJOR > 2 || (FREETYPE_MAJOR == 2 && FREETYPE_MINOR >= 10)
+#define PGFT_HAVE_SDF 1
+#endif
+#define PGFT_SDF_BASE_SIZE 48 /* pixels per em of a distance field */
+#define PGFT_SDF_SPREAD 6     /* distance range, in base size pixels */
+
 /* Rendering styles unsupported for bitmap fonts */
 #define FT_STYLES_SCALABLE_ONLY (FT_STYLE_STRONG | FT_STYLE_OBLIQUE)
 
@@ -91,6 +99,13 @@ typedef struct freetypeinstance_ {
     FTC_CMapCache cache_charmap;
 
     int cache_size;
+    struct fontcache_ *shared_caches;
+    struct sharedface_ *shared_faces;
+
+    /* Held while rasterising without the GIL, see _PGFT_BeginRaster */
+    PyThread_type_lock render_lock;
+    unsigned long main_thread;
+
     char _error_msg[1024];
 } FreeTypeInstance;
 
@@ -118,24 +133,67 @@ typedef struct rendermode_ {
 #endif
 
 struct cachenode_;
+struct sdfglyph_;
 
+/* FontCache: the rendered glyphs of a face.
+ *
+ * The hash table doubles as it fills. Memory is bounded by max_bytes
+ * instead: when a new glyph would take the cache over budget, the least
+ * recently used glyphs are freed first. Glyphs pinned by a font's active
+ * layout are never freed. All access happens with the GIL held, so the
+ * cache takes no locks of its own. Glyphs are only rasterised without the
+ * GIL once their outline is loaded, see _PGFT_BeginRaster.
+ *
+ * Fonts loaded from the same file, face index and resolution can share a
+ * cache (see _PGFT_Cache_Share). Shared caches are reference counted and
+ * listed in their FreeTypeInstance.
+ *
+ * The cache also keeps the distance fields of the face's glyphs, built
+ * once for all sizes by fonts with FT_RFLAG_SDF (see ft_sdf.c). They are
+ * not counted against max_bytes and live as long as the cache.
+ */
 typedef struct fontcache_ {
     struct cachenode_ **nodes;
-    struct cachenode_ *free_nodes;
+    struct cachenode_ *lru_first; /* Most recently used */
+    struct cachenode_ *lru_last;  /* Least recently used */
+    FT_UInt32 size_mask;
+    FT_UInt32 count;
 
-    FT_Byte *depths;
+    size_t bytes;
+    size_t pinned_bytes;
+    size_t max_bytes;
+    unsigned long hits;
+    unsigned long misses;
+    unsigned long evictions;
 
-#ifdef PGFT_DEBUG_CACHE
-    FT_UInt32 _debug_count;
-    FT_UInt32 _debug_delete_count;
-    FT_UInt32 _debug_access;
-    FT_UInt32 _debug_hit;
-    FT_UInt32 _debug_miss;
-#endif
+    struct sdfglyph_ **sdf_nodes;
+    FT_UInt32 sdf_mask;
+    FT_UInt32 sdf_count;
+    size_t sdf_bytes;
 
-    FT_UInt32 size_mask;
+    Py_ssize_t ref_count;
+    char *share_path;
+    FT_Long share_index;
+    FT_UInt share_resolution;
+    struct fontcache_ *share_next;
+    struct fontcache_ **share_prev;
 } FontCache;
 
+/* A face opened from a file, used by every font loaded from the same path
+ * and face index (see _PGFT_TryLoadFont_Shared). The face id is what the
+ * FTC manager caches the face and its sizes under, so each file is parsed
+ * once however many fonts and sizes are made from it. Shared faces are
+ * reference counted and listed in their FreeTypeInstance; the last font to
+ * let go removes the face from the manager and closes the file.
+ */
+typedef struct sharedface_ {
+    pgFontId id;
+    Py_ssize_t ref_count;
+    char *path;
+    struct sharedface_ *next;
+    struct sharedface_ **prev;
+} SharedFace;
+
 typedef struct fontmetrics_ {
     /* All these are 26.6 precision */
     FT_Pos bearing_x;
@@ -182,6 +240,7 @@ typedef struct layout_ {
     FT_Pos underline_pos;
 
     int buffer_size;
+    int pinned; /* Leading glyphs pinned in the cache */
     GlyphSlot *glyphs;
 } Layout;
 
@@ -210,7 +269,7 @@ typedef struct fontsurface_ {
 
 typedef struct fontinternals_ {
     Layout active_text;
-    FontCache glyph_cache;
+    FontCache *glyph_cache;
 } FontInternals;
 
 typedef struct PGFT_String_ {
@@ -218,9 +277,7 @@ typedef struct PGFT_String_ {
     PGFT_char data[1];
 } PGFT_String;
 
-#if defined(PGFT_DEBUG_CACHE)
-#define PGFT_FONT_CACHE(f) ((f)->_internals->glyph_cache)
-#endif
+#define PGFT_FONT_CACHE(f) (*(f)->_internals->glyph_cache)
 
 /**********************************************************
  * Module state
@@ -290,10 +347,19 @@ _PGFT_TryLoadFont_Filename(FreeTypeInstance *, pgFontObject *, const char *,
                            long);
 int
 _PGFT_TryLoadFont_RWops(FreeTypeInstance *, pgFontObject *, SDL_RWops *, long);
+int
+_PGFT_TryLoadFont_Shared(FreeTypeInstance *, pgFontObject *, SDL_RWops *,
+                         long, const char *);
 SDL_RWops *
 _PGFT_GetRWops(pgFontObject *fontobj);
 void
 _PGFT_UnloadFont(FreeTypeInstance *, pgFontObject *);
+PyThreadState *
+_PGFT_BeginRaster(FreeTypeInstance *);
+void
+_PGFT_EndRaster(FreeTypeInstance *, PyThreadState *);
+void
+_PGFT_WaitIdle(FreeTypeInstance *);
 
 /**************************************** Metrics management *****************/
 int
@@ -322,6 +388,10 @@ _PGFT_Render_ExistingSurface(FreeTypeInstance *, pgFontObject *,
                              SDL_Surface *, int, int, FontColor *, FontColor *,
                              SDL_Rect *);
 int
+_PGFT_Render_Layout(FreeTypeInstance *, pgFontObject *, const FontRenderMode *,
+                    Layout *, SDL_Surface *, int, int, FontColor *,
+                    FontColor *, SDL_Rect *);
+int
 _PGFT_Render_Array(FreeTypeInstance *, pgFontObject *, const FontRenderMode *,
                    PyObject *, PGFT_String *, int, int, int, SDL_Rect *);
 int
@@ -376,6 +446,15 @@ __render_glyph_RGB3(int, int, FontSurface *, const FT_Bitmap *,
 void
 __render_glyph_RGB4(int, int, FontSurface *, const FT_Bitmap *,
                     const FontColor *);
+/* __render_glyph_RGB4, or a SIMD version of it when format allows one */
+FontRenderPtr
+__select_render_glyph_RGB4(const SDL_PixelFormat *format);
+
+/* The runtime checks of the text and SDF kernels, see ft_render_cb_simd.h */
+int
+_pgft_has_avx2();
+int
+_pgft_HasSSE_NEON();
 
 void
 __render_glyph_GRAY1(int, int, FontSurface *, const FT_Bitmap *,
@@ -403,17 +482,36 @@ Layout *
 _PGFT_LoadLayout(FreeTypeInstance *, pgFontObject *, const FontRenderMode *,
                  PGFT_String *);
 int
+_PGFT_CopyLayout(pgFontObject *, Layout *);
+void
+_PGFT_FreeLayoutCopy(pgFontObject *, Layout *);
+int
 _PGFT_LoadGlyph(FontGlyph *, GlyphIndex_t, const FontRenderMode *, void *);
 
 /**************************************** Glyph cache management *************/
-int
-_PGFT_Cache_Init(FreeTypeInstance *, FontCache *);
+FontCache *
+_PGFT_Cache_New(FreeTypeInstance *);
 void
-_PGFT_Cache_Destroy(FontCache *);
+_PGFT_Cache_Release(FontCache *);
+int
+_PGFT_Cache_Share(FreeTypeInstance *, pgFontObject *, const char *);
 void
 _PGFT_Cache_Cleanup(FontCache *);
+void
+_PGFT_Cache_SetBudget(FontCache *, size_t);
 FontGlyph *
 _PGFT_Cache_FindGlyph(FT_UInt32, const FontRenderMode *, FontCache *, void *);
+void
+_PGFT_Cache_PinGlyph(FontCache *, FontGlyph *);
+void
+_PGFT_Cache_UnpinGlyph(FontCache *, FontGlyph *);
+
+/**************************************** Distance field glyphs **************/
+int
+_PGFT_SDF_RenderGlyph(FreeTypeInstance *, FontCache *, FT_Face, GlyphIndex_t,
+                      FT_Pos, FT_Glyph *);
+void
+_PGFT_SDF_Free(FontCache *);
 
 /**************************************** Unicode ****************************/
 PGFT_String *
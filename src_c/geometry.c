@@ -1,7 +1,13 @@
 #include "circle.c"
+#include "polygon.c"
+#include "line.c"
+#include "rect_index.c"
 #include "geometry_common.c"
 
-static PyMethodDef geometry_methods[] = {{NULL, NULL, 0, NULL}};
+static PyMethodDef geometry_methods[] = {
+    {"circle_overlaps", (PyCFunction)pg_geometry_circle_overlaps,
+     METH_VARARGS | METH_KEYWORDS, DOC_GEOMETRY_CIRCLEOVERLAPS},
+    {NULL, NULL, 0, NULL}};
 
 MODINIT_DEFINE(geometry)
 {
@@ -26,10 +32,24 @@ MODINIT_DEFINE(geometry)
         return NULL;
     }
 
+    pg_RegisterSIMDDispatch(_pg_line_simd_dispatch);
+
     if (PyType_Ready(&pgCircle_Type) < 0) {
         return NULL;
     }
 
+    if (PyType_Ready(&pgLine_Type) < 0) {
+        return NULL;
+    }
+
+    if (PyType_Ready(&pgPolygon_Type) < 0) {
+        return NULL;
+    }
+
+    if (PyType_Ready(&pgRectIndex_Type) < 0) {
+        return NULL;
+    }
+
     module = PyModule_Create(&_module);
     if (!module) {
         return NULL;
@@ -42,7 +62,31 @@ MODINIT_DEFINE(geometry)
         return NULL;
     }
 
+    Py_INCREF(&pgLine_Type);
+    if (PyModule_AddObject(module, "Line", (PyObject *)&pgLine_Type)) {
+        Py_DECREF(&pgLine_Type);
+        Py_DECREF(module);
+        return NULL;
+    }
+
+    Py_INCREF(&pgPolygon_Type);
+    if (PyModule_AddObject(module, "Polygon", (PyObject *)&pgPolygon_Type)) {
+        Py_DECREF(&pgPolygon_Type);
+        Py_DECREF(module);
+        return NULL;
+    }
+
+    Py_INCREF(&pgRectIndex_Type);
+    if (PyModule_AddObject(module, "RectIndex",
+                           (PyObject *)&pgRectIndex_Type)) {
+        Py_DECREF(&pgRectIndex_Type);
+        Py_DECREF(module);
+        return NULL;
+    }
+
     c_api[0] = &pgCircle_Type;
+    c_api[1] = &pgLine_Type;
+    c_api[2] = &pgPolygon_Type;
     apiobj = encapsulate_api(c_api, "geometry");
     if (PyModule_AddObject(module, PYGAMEAPI_LOCAL_ENTRY, apiobj)) {
         Py_XDECREF(apiobj);
@@ -21,6 +21,71 @@ typedef struct {
 #define pgCircle_Check(o) ((o)->ob_type == &pgCircle_Type)
 
 static PyTypeObject pgCircle_Type;
+
+typedef struct {
+    double ax, ay, bx, by;
+} pgLineBase;
+
+typedef struct {
+    PyObject_HEAD pgLineBase line;
+    PyObject *weakreflist;
+} pgLineObject;
+
+#define pgLine_CAST(o) ((pgLineObject *)(o))
+#define pgLine_AsLine(o) (pgLine_CAST(o)->line)
+#define pgLine_Check(o) (PyObject_TypeCheck(o, &pgLine_Type))
+
+static PyTypeObject pgLine_Type;
+
+typedef struct {
+    PyObject_HEAD Py_ssize_t verts_num;
+    double *vertices; /* x0, y0, x1, y1, ... */
+    PyObject *weakreflist;
+} pgPolygonObject;
+
+#define pgPolygon_CAST(o) ((pgPolygonObject *)(o))
+#define pgPolygon_Check(o) (PyObject_TypeCheck(o, &pgPolygon_Type))
+
+static PyTypeObject pgPolygon_Type;
+
+/* Where a RectIndex entry is stored */
+#define PG_RECTINDEX_UNLINKED 0 /* free slot, or a zero sized rect */
+#define PG_RECTINDEX_GRID 1
+#define PG_RECTINDEX_LARGE 2
+
+typedef struct {
+    PyObject *key; /* borrowed from the keys dict, NULL for a free slot */
+    SDL_FRect rect; /* normalized */
+    int cx0, cy0, cx1, cy1; /* range of grid cells covered */
+    int where;
+    Py_ssize_t stamp; /* last query that reported this entry */
+} pgRectIndexEntry;
+
+typedef struct {
+    int cx, cy;
+    Py_ssize_t count, capacity; /* capacity 0 means the slot is unused */
+    Py_ssize_t *items;          /* entry indices */
+} pgRectIndexCell;
+
+typedef struct {
+    PyObject_HEAD double cell_size;
+    double inv_cell_size;
+    PyObject *keys; /* key -> entry index */
+    pgRectIndexEntry *entries;
+    Py_ssize_t num_entries, entries_capacity;
+    Py_ssize_t *free_entries;
+    Py_ssize_t num_free;
+    pgRectIndexCell *cells; /* open addressing hash table of grid cells */
+    Py_ssize_t cells_size, cells_used;
+    Py_ssize_t *large; /* entries covering too many cells for the grid */
+    Py_ssize_t num_large, large_capacity;
+    Py_ssize_t stamp;
+    PyObject *weakreflist;
+} pgRectIndexObject;
+
+#define pgRectIndex_Check(o) (PyObject_TypeCheck(o, &pgRectIndex_Type))
+
+static PyTypeObject pgRectIndex_Type;
 /* Constants */
 
 /* PI */
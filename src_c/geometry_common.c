@@ -146,3 +146,92 @@ pgCircle_FromObjectFastcall(PyObject *const *args, Py_ssize_t nargs,
             return 0;
     }
 }
+
+int
+pgLine_FromObject(PyObject *obj, pgLineBase *out)
+{
+    Py_ssize_t length;
+
+    if (pgLine_Check(obj)) {
+        *out = pgLine_AsLine(obj);
+        return 1;
+    }
+
+    if (pgSequenceFast_Check(obj)) {
+        PyObject **f_arr = PySequence_Fast_ITEMS(obj);
+        length = PySequence_Fast_GET_SIZE(obj);
+
+        switch (length) {
+            case 1:
+                return pgLine_FromObject(f_arr[0], out);
+            case 2:
+                return pg_TwoDoublesFromObj(f_arr[0], &out->ax, &out->ay) &&
+                       pg_TwoDoublesFromObj(f_arr[1], &out->bx, &out->by);
+            case 4:
+                return pg_DoubleFromObj(f_arr[0], &out->ax) &&
+                       pg_DoubleFromObj(f_arr[1], &out->ay) &&
+                       pg_DoubleFromObj(f_arr[2], &out->bx) &&
+                       pg_DoubleFromObj(f_arr[3], &out->by);
+            default:
+                return 0;
+        }
+    }
+    else if (PySequence_Check(obj) && !PyUnicode_Check(obj)) {
+        PyObject *tuple = PySequence_Tuple(obj);
+        int result;
+        if (!tuple) {
+            PyErr_Clear();
+            return 0;
+        }
+        result = pgLine_FromObject(tuple, out);
+        Py_DECREF(tuple);
+        return result;
+    }
+
+    /* Path for objects that have a line attribute */
+    PyObject *lineattr;
+    if (!(lineattr = PyObject_GetAttrString(obj, "line"))) {
+        PyErr_Clear();
+        return 0;
+    }
+
+    if (PyCallable_Check(lineattr)) /*call if it's a method*/
+    {
+        PyObject *lineresult = PyObject_CallObject(lineattr, NULL);
+        Py_DECREF(lineattr);
+        if (!lineresult) {
+            PyErr_Clear();
+            return 0;
+        }
+        lineattr = lineresult;
+    }
+
+    if (!pgLine_FromObject(lineattr, out)) {
+        Py_DECREF(lineattr);
+        return 0;
+    }
+
+    Py_DECREF(lineattr);
+
+    return 1;
+}
+
+int
+pgLine_FromObjectFastcall(PyObject *const *args, Py_ssize_t nargs,
+                          pgLineBase *out)
+{
+    switch (nargs) {
+        case 1:
+            return pgLine_FromObject(args[0], out);
+        case 2:
+            return pg_TwoDoublesFromObj(args[0], &out->ax, &out->ay) &&
+                   pg_TwoDoublesFromObj(args[1], &out->bx, &out->by);
+        case 4:
+            return pg_DoubleFromObj(args[0], &out->ax) &&
+                   pg_DoubleFromObj(args[1], &out->ay) &&
+                   pg_DoubleFromObj(args[2], &out->bx) &&
+                   pg_DoubleFromObj(args[3], &out->by);
+        default:
+            return 0;
+    }
+}
@@ -22,7 +22,6 @@
   from Pygame 2.
 
   TODO:
-  - fix filledPolygonRGBA to use MT versions for threaded use.
   - do a filled pie version using filledPieColor
   - Determine if SDL video must be initiated for all routines to work.
     Add check if required, else remove ASSERT_VIDEO_INIT.
@@ -1009,8 +1008,526 @@ _gfx_beziercolor(PyObject *self, PyObject *args)
     Py_RETURN_NONE;
 }
 
+/* gfxdraw.batch: primitives are queued as commands while inside of the
+ * with block, and drawn together when it ends. The surface is locked once
+ * and the GIL is released while drawing. */
+enum {
+    GFX_PIXEL,
+    GFX_HLINE,
+    GFX_VLINE,
+    GFX_RECTANGLE,
+    GFX_BOX,
+    GFX_LINE,
+    GFX_CIRCLE,
+    GFX_ARC,
+    GFX_AACIRCLE,
+    GFX_FILLEDCIRCLE,
+    GFX_ELLIPSE,
+    GFX_AAELLIPSE,
+    GFX_FILLEDELLIPSE,
+    GFX_PIE,
+    GFX_TRIGON,
+    GFX_AATRIGON,
+    GFX_FILLEDTRIGON,
+    GFX_POLYGON,
+    GFX_AAPOLYGON,
+    GFX_FILLEDPOLYGON,
+    GFX_BEZIER
+};
+
+typedef struct {
+    int type;
+    Sint16 v[6];
+    Uint8 rgba[4];
+    /* points of polygons and bezier curves, and the bezier steps */
+    Sint16 *vx, *vy;
+    int count, steps;
+} pg_GfxCommand;
+
+typedef struct {
+    PyObject_HEAD PyObject *surface;
+    pg_GfxCommand *commands;
+    Py_ssize_t count, capacity;
+    int active;
+} pgGfxBatchObject;
+
+/* Reads a sequence of at least 3 points into new arrays, to be freed with
+ * PyMem_Free(). Returns 0 with an exception set on error. */
+static int
+_gfx_points_from_obj(PyObject *points, Sint16 **vx, Sint16 **vy, int *count)
+{
+    PyObject *item;
+    Py_ssize_t length, i;
+    int result;
+
+    if (!PySequence_Check(points)) {
+        PyErr_SetString(PyExc_TypeError, "points must be a sequence");
+        return 0;
+    }
+    length = PySequence_Size(points);
+    if (length < 0) {
+        return 0;
+    }
+    if (length < 3) {
+        PyErr_SetString(PyExc_ValueError,
+                        "points must contain more than 2 points");
+        return 0;
+    }
+    if (length > INT_MAX) {
+        PyErr_SetString(PyExc_OverflowError, "too many points");
+        return 0;
+    }
+
+    *vx = PyMem_New(Sint16, (size_t)length);
+    *vy = PyMem_New(Sint16, (size_t)length);
+    if (!*vx || !*vy) {
+        PyMem_Free(*vx);
+        PyMem_Free(*vy);
+        PyErr_NoMemory();
+        return 0;
+    }
+    for (i = 0; i < length; i++) {
+        item = PySequence_ITEM(points, i);
+        result = item && Sint16FromSeqIndex(item, 0, *vx + i) &&
+                 Sint16FromSeqIndex(item, 1, *vy + i);
+        Py_XDECREF(item);
+        if (!result) {
+            PyMem_Free(*vx);
+            PyMem_Free(*vy);
+            return 0;
+        }
+    }
+    *count = (int)length;
+    return 1;
+}
+
+static void
+_gfxbatch_clear(pgGfxBatchObject *self)
+{
+    Py_ssize_t i;
+
+    for (i = 0; i < self->count; i++) {
+        PyMem_Free(self->commands[i].vx);
+        PyMem_Free(self->commands[i].vy);
+    }
+    self->count = 0;
+}
+
+static PyObject *
+_gfxbatch_queue(pgGfxBatchObject *self, PyObject *args, int type)
+{
+    pg_GfxCommand cmd;
+    pg_GfxCommand *commands;
+    PyObject *color, *rect, *points = NULL;
+    SDL_Rect temprect, *sdlrect;
+    Sint16 *v = cmd.v;
+    Py_ssize_t capacity;
+    int ok = 0;
+
+    if (!self->active) {
+        return RAISE(PyExc_RuntimeError,
+                     "primitives can only be queued inside of the with "
+                     "block of the batch");
+    }
+
+    memset(&cmd, 0, sizeof(cmd));
+    cmd.type = type;
+    switch (type) {
+        case GFX_PIXEL:
+            ok = PyArg_ParseTuple(args, "hhO:pixel", &v[0], &v[1], &color);
+            break;
+        case GFX_HLINE:
+            ok = PyArg_ParseTuple(args, "hhhO:hline", &v[0], &v[1], &v[2],
+                                  &color);
+            break;
+        case GFX_VLINE:
+            ok = PyArg_ParseTuple(args, "hhhO:vline", &v[0], &v[1], &v[2],
+                                  &color);
+            break;
+        case GFX_RECTANGLE:
+        case GFX_BOX:
+            ok = PyArg_ParseTuple(args,
+                                  type == GFX_BOX ? "OO:box" : "OO:rectangle",
+                                  &rect, &color);
+            if (ok) {
+                sdlrect = pgRect_FromObject(rect, &temprect);
+                if (sdlrect == NULL) {
+                    return RAISE(PyExc_TypeError,
+                                 "invalid rect style argument");
+                }
+                v[0] = sdlrect->x;
+                v[1] = sdlrect->y;
+                v[2] = (Sint16)(sdlrect->x + sdlrect->w - 1);
+                v[3] = (Sint16)(sdlrect->y + sdlrect->h - 1);
+            }
+            break;
+        case GFX_LINE:
+            ok = PyArg_ParseTuple(args, "hhhhO:line", &v[0], &v[1], &v[2],
+                                  &v[3], &color);
+            break;
+        case GFX_CIRCLE:
+            ok = PyArg_ParseTuple(args, "hhhO:circle", &v[0], &v[1], &v[2],
+                                  &color);
+            break;
+        case GFX_AACIRCLE:
+            ok = PyArg_ParseTuple(args, "hhhO:aacircle", &v[0], &v[1], &v[2],
+                                  &color);
+            break;
+        case GFX_FILLEDCIRCLE:
+            ok = PyArg_ParseTuple(args, "hhhO:filled_circle", &v[0], &v[1],
+                                  &v[2], &color);
+            break;
+        case GFX_ARC:
+            ok = PyArg_ParseTuple(args, "hhhhhO:arc", &v[0], &v[1], &v[2],
+                                  &v[3], &v[4], &color);
+            break;
+        case GFX_PIE:
+            ok = PyArg_ParseTuple(args, "hhhhhO:pie", &v[0], &v[1], &v[2],
+                                  &v[3], &v[4], &color);
+            break;
+        case GFX_ELLIPSE:
+            ok = PyArg_ParseTuple(args, "hhhhO:ellipse", &v[0], &v[1], &v[2],
+                                  &v[3], &color);
+            break;
+        case GFX_AAELLIPSE:
+            ok = PyArg_ParseTuple(args, "hhhhO:aaellipse", &v[0], &v[1],
+                                  &v[2], &v[3], &color);
+            break;
+        case GFX_FILLEDELLIPSE:
+            ok = PyArg_ParseTuple(args, "hhhhO:filled_ellipse", &v[0], &v[1],
+                                  &v[2], &v[3], &color);
+            break;
+        case GFX_TRIGON:
+            ok = PyArg_ParseTuple(args, "hhhhhhO:trigon", &v[0], &v[1],
+                                  &v[2], &v[3], &v[4], &v[5], &color);
+            break;
+        case GFX_AATRIGON:
+            ok = PyArg_ParseTuple(args, "hhhhhhO:aatrigon", &v[0], &v[1],
+                                  &v[2], &v[3], &v[4], &v[5], &color);
+            break;
+        case GFX_FILLEDTRIGON:
+            ok = PyArg_ParseTuple(args, "hhhhhhO:filled_trigon", &v[0],
+                                  &v[1], &v[2], &v[3], &v[4], &v[5], &color);
+            break;
+        case GFX_POLYGON:
+            ok = PyArg_ParseTuple(args, "OO:polygon", &points, &color);
+            break;
+        case GFX_AAPOLYGON:
+            ok = PyArg_ParseTuple(args, "OO:aapolygon", &points, &color);
+            break;
+        case GFX_FILLEDPOLYGON:
+            ok = PyArg_ParseTuple(args, "OO:filled_polygon", &points, &color);
+            break;
+        case GFX_BEZIER:
+            ok = PyArg_ParseTuple(args, "OiO:bezier", &points, &cmd.steps,
+                                  &color);
+            if (ok && cmd.steps < 2) {
+                return RAISE(PyExc_ValueError,
+                             "steps parameter must be greater than 1");
+            }
+            break;
+    }
+    if (!ok) {
+        return NULL;
+    }
+    if (!pg_RGBAFromObjEx(color, cmd.rgba, PG_COLOR_HANDLE_SIMPLE)) {
+        return NULL;
+    }
+    if (points &&
+        !_gfx_points_from_obj(points, &cmd.vx, &cmd.vy, &cmd.count)) {
+        return NULL;
+    }
+
+    if (self->count == self->capacity) {
+        capacity = self->capacity ? self->capacity * 2 : 64;
+        commands = self->commands;
+        PyMem_Resize(commands, pg_GfxCommand, (size_t)capacity);
+        if (!commands) {
+            PyMem_Free(cmd.vx);
+            PyMem_Free(cmd.vy);
+            return PyErr_NoMemory();
+        }
+        self->commands = commands;
+        self->capacity = capacity;
+    }
+    self->commands[self->count++] = cmd;
+    Py_RETURN_NONE;
+}
+
+/* Returns -1 with the SDL error set if a primitive failed */
+static int
+_gfxbatch_draw(SDL_Surface *surf, pg_GfxCommand *commands, Py_ssize_t count)
+{
+    pg_GfxCommand *cmd;
+    Sint16 *v;
+    Uint8 r, g, b, a;
+    Py_ssize_t i;
+    int ret = 0;
+
+    for (i = 0; i < count && ret != -1; i++) {
+        cmd = commands + i;
+        v = cmd->v;
+        r = cmd->rgba[0];
+        g = cmd->rgba[1];
+        b = cmd->rgba[2];
+        a = cmd->rgba[3];
+        switch (cmd->type) {
+            case GFX_PIXEL:
+                ret = pixelRGBA(surf, v[0], v[1], r, g, b, a);
+                break;
+            case GFX_HLINE:
+                ret = hlineRGBA(surf, v[0], v[1], v[2], r, g, b, a);
+                break;
+            case GFX_VLINE:
+                ret = vlineRGBA(surf, v[0], v[1], v[2], r, g, b, a);
+                break;
+            case GFX_RECTANGLE:
+                ret = rectangleRGBA(surf, v[0], v[1], v[2], v[3], r, g, b, a);
+                break;
+            case GFX_BOX:
+                ret = boxRGBA(surf, v[0], v[1], v[2], v[3], r, g, b, a);
+                break;
+            case GFX_LINE:
+                ret = lineRGBA(surf, v[0], v[1], v[2], v[3], r, g, b, a);
+                break;
+            case GFX_CIRCLE:
+                ret = circleRGBA(surf, v[0], v[1], v[2], r, g, b, a);
+                break;
+            case GFX_AACIRCLE:
+                ret = aacircleRGBA(surf, v[0], v[1], v[2], r, g, b, a);
+                break;
+            case GFX_FILLEDCIRCLE:
+                ret = filledCircleRGBA(surf, v[0], v[1], v[2], r, g, b, a);
+                break;
+            case GFX_ARC:
+                ret = arcRGBA(surf, v[0], v[1], v[2], v[3], v[4], r, g, b, a);
+                break;
+            case GFX_PIE:
+                ret = pieRGBA(surf, v[0], v[1], v[2], v[3], v[4], r, g, b, a);
+                break;
+            case GFX_ELLIPSE:
+                ret = ellipseRGBA(surf, v[0], v[1], v[2], v[3], r, g, b, a);
+                break;
+            case GFX_AAELLIPSE:
+                ret = aaellipseRGBA(surf, v[0], v[1], v[2], v[3], r, g, b, a);
+                break;
+            case GFX_FILLEDELLIPSE:
+                ret = filledEllipseRGBA(surf, v[0], v[1], v[2], v[3], r, g, b,
+                                        a);
+                break;
+            case GFX_TRIGON:
+                ret = trigonRGBA(surf, v[0], v[1], v[2], v[3], v[4], v[5], r,
+                                 g, b, a);
+                break;
+            case GFX_AATRIGON:
+                ret = aatrigonRGBA(surf, v[0], v[1], v[2], v[3], v[4], v[5],
+                                   r, g, b, a);
+                break;
+            case GFX_FILLEDTRIGON:
+                ret = filledTrigonRGBA(surf, v[0], v[1], v[2], v[3], v[4],
+                                       v[5], r, g, b, a);
+                break;
+            case GFX_POLYGON:
+                ret = polygonRGBA(surf, cmd->vx, cmd->vy, cmd->count, r, g, b,
+                                  a);
+                break;
+            case GFX_AAPOLYGON:
+                ret = aapolygonRGBA(surf, cmd->vx, cmd->vy, cmd->count, r, g,
+                                    b, a);
+                break;
+            case GFX_FILLEDPOLYGON:
+                ret = filledPolygonRGBA(surf, cmd->vx, cmd->vy, cmd->count, r,
+                                        g, b, a);
+                break;
+            case GFX_BEZIER:
+                ret = bezierRGBA(surf, cmd->vx, cmd->vy, cmd->count,
+                                 cmd->steps, r, g, b, a);
+                break;
+        }
+    }
+    return ret == -1 ? -1 : 0;
+}
+
+static PyObject *
+_gfxbatch_enter(pgGfxBatchObject *self, PyObject *_null)
+{
+    if (self->active) {
+        return RAISE(PyExc_RuntimeError, "batch is already active");
+    }
+    self->active = 1;
+    Py_INCREF(self);
+    return (PyObject *)self;
+}
+
+static PyObject *
+_gfxbatch_exit(pgGfxBatchObject *self, PyObject *args)
+{
+    PyObject *exc_type, *exc_value, *traceback;
+    SDL_Surface *surf;
+    int ret;
+
+    if (!PyArg_ParseTuple(args, "OOO:__exit__", &exc_type, &exc_value,
+                          &traceback)) {
+        return NULL;
+    }
+    self->active = 0;
+
+    /* nothing is drawn if the block raised */
+    if (exc_type != Py_None || !self->count) {
+        _gfxbatch_clear(self);
+        Py_RETURN_NONE;
+    }
+
+    surf = pgSurface_AsSurface(self->surface);
+    if (!surf) {
+        _gfxbatch_clear(self);
+        return RAISE(pgExc_SDLError, "display Surface quit");
+    }
+    if (!pgSurface_Lock((pgSurfaceObject *)self->surface)) {
+        _gfxbatch_clear(self);
+        return NULL;
+    }
+    Py_BEGIN_ALLOW_THREADS;
+    ret = _gfxbatch_draw(surf, self->commands, self->count);
+    Py_END_ALLOW_THREADS;
+    _gfxbatch_clear(self);
+    if (!pgSurface_Unlock((pgSurfaceObject *)self->surface)) {
+        return NULL;
+    }
+    if (ret == -1) {
+        return RAISE(pgExc_SDLError, SDL_GetError());
+    }
+    Py_RETURN_NONE;
+}
+
+#define GFXBATCH_METHOD(name, type)                                      \
+    static PyObject *_gfxbatch_##name(pgGfxBatchObject *self,           \
+                                      PyObject *args)                   \
+    {                                                                    \
+        return _gfxbatch_queue(self, args, type);                        \
+    }
+
+GFXBATCH_METHOD(pixel, GFX_PIXEL)
+GFXBATCH_METHOD(hline, GFX_HLINE)
+GFXBATCH_METHOD(vline, GFX_VLINE)
+GFXBATCH_METHOD(rectangle, GFX_RECTANGLE)
+GFXBATCH_METHOD(box, GFX_BOX)
+GFXBATCH_METHOD(line, GFX_LINE)
+GFXBATCH_METHOD(circle, GFX_CIRCLE)
+GFXBATCH_METHOD(arc, GFX_ARC)
+GFXBATCH_METHOD(aacircle, GFX_AACIRCLE)
+GFXBATCH_METHOD(filled_circle, GFX_FILLEDCIRCLE)
+GFXBATCH_METHOD(ellipse, GFX_ELLIPSE)
+GFXBATCH_METHOD(aaellipse, GFX_AAELLIPSE)
+GFXBATCH_METHOD(filled_ellipse, GFX_FILLEDELLIPSE)
+GFXBATCH_METHOD(pie, GFX_PIE)
+GFXBATCH_METHOD(trigon, GFX_TRIGON)
+GFXBATCH_METHOD(aatrigon, GFX_AATRIGON)
+GFXBATCH_METHOD(filled_trigon, GFX_FILLEDTRIGON)
+GFXBATCH_METHOD(polygon, GFX_POLYGON)
+GFXBATCH_METHOD(aapolygon, GFX_AAPOLYGON)
+GFXBATCH_METHOD(filled_polygon, GFX_FILLEDPOLYGON)
+GFXBATCH_METHOD(bezier, GFX_BEZIER)
+
+static PyObject *
+_gfxbatch_get_queued(pgGfxBatchObject *self, void *closure)
+{
+    return PyLong_FromSsize_t(self->count);
+}
+
+static int
+_gfxbatch_init(pgGfxBatchObject *self, PyObject *args, PyObject *kwargs)
+{
+    PyObject *surface;
+    static char *keywords[] = {"surface", NULL};
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "O!:batch", keywords,
+                                     &pgSurface_Type, &surface)) {
+        return -1;
+    }
+    if (self->active) {
+        PyErr_SetString(PyExc_RuntimeError, "batch is active");
+        return -1;
+    }
+    _gfxbatch_clear(self);
+    Py_INCREF(surface);
+    Py_XSETREF(self->surface, surface);
+    return 0;
+}
+
+static void
+_gfxbatch_dealloc(pgGfxBatchObject *self)
+{
+    _gfxbatch_clear(self);
+    PyMem_Free(self->commands);
+    Py_XDECREF(self->surface);
+    Py_TYPE(self)->tp_free((PyObject *)self);
+}
+
+static PyMethodDef _gfxbatch_methods[] = {
+    {"__enter__", (PyCFunction)_gfxbatch_enter, METH_NOARGS, NULL},
+    {"__exit__", (PyCFunction)_gfxbatch_exit, METH_VARARGS, NULL},
+    {"pixel", (PyCFunction)_gfxbatch_pixel, METH_VARARGS,
+     DOC_GFXDRAW_BATCH_PIXEL},
+    {"hline", (PyCFunction)_gfxbatch_hline, METH_VARARGS,
+     DOC_GFXDRAW_BATCH_HLINE},
+    {"vline", (PyCFunction)_gfxbatch_vline, METH_VARARGS,
+     DOC_GFXDRAW_BATCH_VLINE},
+    {"rectangle", (PyCFunction)_gfxbatch_rectangle, METH_VARARGS,
+     DOC_GFXDRAW_BATCH_RECTANGLE},
+    {"box", (PyCFunction)_gfxbatch_box, METH_VARARGS, DOC_GFXDRAW_BATCH_BOX},
+    {"line", (PyCFunction)_gfxbatch_line, METH_VARARGS,
+     DOC_GFXDRAW_BATCH_LINE},
+    {"circle", (PyCFunction)_gfxbatch_circle, METH_VARARGS,
+     DOC_GFXDRAW_BATCH_CIRCLE},
+    {"arc", (PyCFunction)_gfxbatch_arc, METH_VARARGS, DOC_GFXDRAW_BATCH_ARC},
+    {"aacircle", (PyCFunction)_gfxbatch_aacircle, METH_VARARGS,
+     DOC_GFXDRAW_BATCH_AACIRCLE},
+    {"filled_circle", (PyCFunction)_gfxbatch_filled_circle, METH_VARARGS,
+     DOC_GFXDRAW_BATCH_FILLEDCIRCLE},
+    {"ellipse", (PyCFunction)_gfxbatch_ellipse, METH_VARARGS,
+     DOC_GFXDRAW_BATCH_ELLIPSE},
+    {"aaellipse", (PyCFunction)_gfxbatch_aaellipse, METH_VARARGS,
+     DOC_GFXDRAW_BATCH_AAELLIPSE},
+    {"filled_ellipse", (PyCFunction)_gfxbatch_filled_ellipse, METH_VARARGS,
+     DOC_GFXDRAW_BATCH_FILLEDELLIPSE},
+    {"pie", (PyCFunction)_gfxbatch_pie, METH_VARARGS, DOC_GFXDRAW_BATCH_PIE},
+    {"trigon", (PyCFunction)_gfxbatch_trigon, METH_VARARGS,
+     DOC_GFXDRAW_BATCH_TRIGON},
+    {"aatrigon", (PyCFunction)_gfxbatch_aatrigon, METH_VARARGS,
+     DOC_GFXDRAW_BATCH_AATRIGON},
+    {"filled_trigon", (PyCFunction)_gfxbatch_filled_trigon, METH_VARARGS,
+     DOC_GFXDRAW_BATCH_FILLEDTRIGON},
+    {"polygon", (PyCFunction)_gfxbatch_polygon, METH_VARARGS,
+     DOC_GFXDRAW_BATCH_POLYGON},
+    {"aapolygon", (PyCFunction)_gfxbatch_aapolygon, METH_VARARGS,
+     DOC_GFXDRAW_BATCH_AAPOLYGON},
+    {"filled_polygon", (PyCFunction)_gfxbatch_filled_polygon, METH_VARARGS,
+     DOC_GFXDRAW_BATCH_FILLEDPOLYGON},
+    {"bezier", (PyCFunction)_gfxbatch_bezier, METH_VARARGS,
+     DOC_GFXDRAW_BATCH_BEZIER},
+    {NULL, NULL, 0, NULL}};
+
+static PyGetSetDef _gfxbatch_getsets[] = {
+    {"queued", (getter)_gfxbatch_get_queued, NULL, DOC_GFXDRAW_BATCH_QUEUED,
+     NULL},
+    {NULL, 0, NULL, NULL, NULL}};
+
+static PyTypeObject pgGfxBatch_Type = {
+    PyVarObject_HEAD_INIT(NULL, 0).tp_name = "pygame.gfxdraw.batch",
+    .tp_basicsize = sizeof(pgGfxBatchObject),
+    .tp_dealloc = (destructor)_gfxbatch_dealloc,
+    .tp_flags = Py_TPFLAGS_DEFAULT,
+    .tp_doc = DOC_GFXDRAW_BATCH,
+    .tp_methods = _gfxbatch_methods,
+    .tp_getset = _gfxbatch_getsets,
+    .tp_init = (initproc)_gfxbatch_init,
+    .tp_new = PyType_GenericNew,
+};
+
 MODINIT_DEFINE(gfxdraw)
 {
+    PyObject *module;
     static struct PyModuleDef _module = {PyModuleDef_HEAD_INIT,
                                          "gfxdraw",
                                          DOC_GFXDRAW,
@@ -1041,5 +1558,20 @@ MODINIT_DEFINE(gfxdraw)
         return NULL;
     }
 
-    return PyModule_Create(&_module);
+    if (PyType_Ready(&pgGfxBatch_Type) < 0) {
+        return NULL;
+    }
+
+    module = PyModule_Create(&_module);
+    if (module == NULL) {
+        return NULL;
+    }
+
+    Py_INCREF(&pgGfxBatch_Type);
+    if (PyModule_AddObject(module, "batch", (PyObject *)&pgGfxBatch_Type)) {
+        Py_DECREF(&pgGfxBatch_Type);
+        Py_DECREF(module);
+        return NULL;
+    }
+    return module;
 }
@@ -24,22 +24,27 @@
 /*
  *  image module for pygame
  */
+#define PG_SURFACE_ORIGIN PG_SURF_ORIGIN_IMAGE
 #include "pygame.h"
 
 #include "pgcompat.h"
 
 #include "doc/image_doc.h"
 
-#if PG_COMPILE_SSE4_2
-#include <emmintrin.h>
-/* SSSE 3 */
-#include <tmmintrin.h>
-#endif
+#include "image.h"
+
+#include "simd_image.h"
 
 static int
 SaveTGA(SDL_Surface *surface, const char *file, int rle);
 static int
 SaveTGA_RW(SDL_Surface *surface, SDL_RWops *out, int rle);
+static int
+SaveQOI(SDL_Surface *surface, const char *file);
+static int
+SaveQOI_RW(SDL_Surface *surface, SDL_RWops *out);
+static SDL_Surface *
+LoadQOI_RW(SDL_RWops *src, int freesrc);
 
 #define DATAROW(data, row, width, height, flipped)             \
     ((flipped) ? (((char *)data) + (height - row - 1) * width) \
@@ -49,6 +54,10 @@ static PyObject *extloadobj = NULL;
 static PyObject *extsaveobj = NULL;
 static PyObject *extverobj = NULL;
 static PyObject *ext_load_sized_svg = NULL;
+static PyObject *ext_load_animation = NULL;
+static PyObject *ext_set_svg_cache_limit = NULL;
+static pgImageDecoder *ext_decoder = NULL;
+static pgImageEncoder *ext_encoder = NULL;
 
 static inline void
 pad(char **data, int padding)
@@ -110,6 +119,49 @@ image_load_extended(PyObject *self, PyObject *arg, PyObject *kwarg)
         return PyObject_Call(extloadobj, arg, kwarg);
 }
 
+/* Returns 1 if the namehint, or else the file name, ends in ".qoi" */
+static int
+_is_qoi(PyObject *obj, const char *namehint)
+{
+    PyObject *oencoded;
+    int ret = 0;
+
+    if (namehint) {
+        return !SDL_strcasecmp(find_extension(namehint), "qoi");
+    }
+    oencoded = pg_EncodeString(obj, "UTF-8", NULL, NULL);
+    if (oencoded == NULL) {
+        /* the loader will report it */
+        PyErr_Clear();
+        return 0;
+    }
+    if (oencoded != Py_None) {
+        ret = !SDL_strcasecmp(find_extension(PyBytes_AS_STRING(oencoded)),
+                              "qoi");
+    }
+    Py_DECREF(oencoded);
+    return ret;
+}
+
+static PyObject *
+image_load_qoi(PyObject *obj)
+{
+    SDL_Surface *surf;
+    SDL_RWops *rw = pgRWops_FromObject(obj, NULL);
+
+    if (rw == NULL) {
+        return NULL;
+    }
+    Py_BEGIN_ALLOW_THREADS;
+    surf = LoadQOI_RW(rw, 1);
+    Py_END_ALLOW_THREADS;
+
+    if (surf == NULL) {
+        return RAISE(pgExc_SDLError, SDL_GetError());
+    }
+    return (PyObject *)pgSurface_New(surf);
+}
+
 static PyObject *
 image_load(PyObject *self, PyObject *arg, PyObject *kwarg)
 {
@@ -117,17 +169,503 @@ image_load(PyObject *self, PyObject *arg, PyObject *kwarg)
     const char *name = NULL;
     static char *kwds[] = {"file", "namehint", NULL};
 
+    if (!PyArg_ParseTupleAndKeywords(arg, kwarg, "O|s", kwds, &obj, &name)) {
+        return NULL;
+    }
+    /* QOI is built in, whether or not SDL_image knows it */
+    if (_is_qoi(obj, name)) {
+        return image_load_qoi(obj);
+    }
     if (extloadobj == NULL) {
-        if (!PyArg_ParseTupleAndKeywords(arg, kwarg, "O|s", kwds, &obj,
-                                         &name)) {
-            return NULL;
-        }
         return image_load_basic(self, obj);
     }
     else
         return image_load_extended(self, arg, kwarg);
 }
 
+/* Decode for load_many and load_async worker threads */
+static SDL_Surface *
+_decode_rw(SDL_RWops *rw, const char *type)
+{
+    if (type && !SDL_strcasecmp(type, "qoi")) {
+        return LoadQOI_RW(rw, 1);
+    }
+    if (ext_decoder) {
+        return ext_decoder->decode(rw, type);
+    }
+    return SDL_LoadBMP_RW(rw, 1);
+}
+
+/* Encode for save_async worker threads, like image.save does. rw is left
+ * open. */
+static int
+_encode_rw(SDL_Surface *surf, SDL_RWops *rw, const char *type, int quality)
+{
+    if (!SDL_strcasecmp(type, "png") || !SDL_strcasecmp(type, "jpg") ||
+        !SDL_strcasecmp(type, "jpeg")) {
+        return ext_encoder->encode(surf, rw, type, quality);
+    }
+    if (!SDL_strcasecmp(type, "bmp")) {
+        return SDL_SaveBMP_RW(surf, rw, 0) == 0 ? 0 : -1;
+    }
+    if (!SDL_strcasecmp(type, "qoi")) {
+        return SaveQOI_RW(surf, rw);
+    }
+    return SaveTGA_RW(surf, rw, 1);
+}
+
+/* One file of an image.load_many batch. */
+typedef struct {
+    const char *path; /* borrowed from the encoded path bytes */
+    SDL_Surface *surf;
+    char *error;
+} pgLoadJob;
+
+typedef struct {
+    pgLoadJob *jobs;
+    int count;
+    SDL_atomic_t next;
+    pgImageDecoder *decoder;
+} pgLoadBatch;
+
+static int SDLCALL
+_load_many_worker(void *data)
+{
+    pgLoadBatch *batch = (pgLoadBatch *)data;
+    pgLoadJob *job;
+    SDL_RWops *rw;
+    const char *type;
+    int i;
+
+    while ((i = SDL_AtomicAdd(&batch->next, 1)) < batch->count) {
+        job = batch->jobs + i;
+        rw = SDL_RWFromFile(job->path, "rb");
+        if (rw) {
+            type = strrchr(job->path, '.');
+            job->surf = _decode_rw(rw, type ? type + 1 : NULL);
+        }
+        if (!job->surf) {
+            /* SDL keeps the error message per thread */
+            job->error = SDL_strdup(SDL_GetError());
+        }
+    }
+    return 0;
+}
+
+static PyObject *
+image_load_many(PyObject *self, PyObject *arg, PyObject *kwarg)
+{
+    PyObject *paths, *seq, *encoded = NULL, *surfaces = NULL;
+    PyObject *errors = NULL, *item, *key, *ret = NULL;
+    pgLoadBatch batch;
+    SDL_Thread **workers = NULL;
+    int threads = 0, nworkers = 0, i;
+    Py_ssize_t count;
+    static char *kwds[] = {"paths", "threads", NULL};
+
+    if (!PyArg_ParseTupleAndKeywords(arg, kwarg, "O|i", kwds, &paths,
+                                     &threads)) {
+        return NULL;
+    }
+    if (threads < 0) {
+        return RAISE(PyExc_ValueError, "threads must not be negative");
+    }
+    if (!(seq = PySequence_Fast(paths, "paths must be a sequence"))) {
+        return NULL;
+    }
+    count = PySequence_Fast_GET_SIZE(seq);
+    if (count > INT_MAX) {
+        Py_DECREF(seq);
+        return RAISE(PyExc_OverflowError, "too many paths");
+    }
+
+    memset(&batch, 0, sizeof(batch));
+    batch.count = (int)count;
+    batch.decoder = ext_decoder;
+    if (!(encoded = PyList_New(count))) {
+        goto end;
+    }
+    if (!(batch.jobs = PyMem_New(pgLoadJob, count ? count : 1))) {
+        PyErr_NoMemory();
+        goto end;
+    }
+    memset(batch.jobs, 0, sizeof(pgLoadJob) * (count ? count : 1));
+    for (i = 0; i < batch.count; ++i) {
+        item = pg_EncodeString(PySequence_Fast_GET_ITEM(seq, i), "UTF-8",
+                               NULL, NULL);
+        if (!item) {
+            goto end;
+        }
+        if (item == Py_None) {
+            Py_DECREF(item);
+            PyErr_Format(PyExc_TypeError,
+                         "paths must be str, bytes or os.PathLike, got %s",
+                         Py_TYPE(PySequence_Fast_GET_ITEM(seq, i))->tp_name);
+            goto end;
+        }
+        PyList_SET_ITEM(encoded, i, item);
+        batch.jobs[i].path = PyBytes_AS_STRING(item);
+    }
+
+    if (!threads) {
+        threads = SDL_GetCPUCount();
+    }
+    if (batch.decoder && !batch.decoder->threadsafe) {
+        threads = 1;
+    }
+    if (threads > batch.count) {
+        threads = batch.count;
+    }
+
+    /* the calling thread decodes too, so spawn one worker less */
+    Py_BEGIN_ALLOW_THREADS;
+    if (threads > 1) {
+        workers = (SDL_Thread **)SDL_malloc(sizeof(SDL_Thread *) *
+                                            (threads - 1));
+    }
+    for (nworkers = 0; workers && nworkers < threads - 1; ++nworkers) {
+        workers[nworkers] = SDL_CreateThread(_load_many_worker,
+                                             "pygame_image_load", &batch);
+        if (!workers[nworkers]) {
+            break; /* carry on with the threads we have */
+        }
+    }
+    _load_many_worker(&batch);
+    for (i = 0; i < nworkers; ++i) {
+        SDL_WaitThread(workers[i], NULL);
+    }
+    SDL_free(workers);
+    Py_END_ALLOW_THREADS;
+
+    /* build the Surface objects in input order on this thread */
+    if (!(surfaces = PyList_New(count)) || !(errors = PyDict_New())) {
+        goto end;
+    }
+    for (i = 0; i < batch.count; ++i) {
+        pgLoadJob *job = batch.jobs + i;
+
+        if (job->surf) {
+            if (!(item = (PyObject *)pgSurface_New(job->surf))) {
+                goto end;
+            }
+            job->surf = NULL; /* owned by the Surface now */
+        }
+        else {
+            key = PyLong_FromLong(i);
+            item = PyUnicode_FromString(job->error ? job->error : "");
+            if (!key || !item || PyDict_SetItem(errors, key, item)) {
+                Py_XDECREF(key);
+                Py_XDECREF(item);
+                goto end;
+            }
+            Py_DECREF(key);
+            Py_DECREF(item);
+            Py_INCREF(Py_None);
+            item = Py_None;
+        }
+        PyList_SET_ITEM(surfaces, i, item);
+    }
+    ret = PyTuple_Pack(2, surfaces, errors);
+
+end:
+    Py_XDECREF(surfaces);
+    Py_XDECREF(errors);
+    Py_XDECREF(encoded);
+    Py_DECREF(seq);
+    if (batch.jobs) {
+        for (i = 0; i < batch.count; ++i) {
+            if (batch.jobs[i].surf) {
+                SDL_FreeSurface(batch.jobs[i].surf);
+            }
+            SDL_free(batch.jobs[i].error);
+        }
+        PyMem_Free(batch.jobs);
+    }
+    return ret;
+}
+
+/* image.load_async and image.save_async jobs, run by a small pool of
+ * detached workers that exit as soon as the queue is empty. */
+#define ASYNC_MAX_WORKERS 4
+
+typedef struct pgAsyncJob {
+    struct pgAsyncJob *next;
+    SDL_RWops *rw;
+    char *ext; /* malloc'd file type, may be NULL */
+    const char *convert; /* Surface method to call when done, or NULL */
+    SDL_Surface *save;   /* the pixels to save, NULL to load */
+    int quality;
+    PyObject *future;
+} pgAsyncJob;
+
+static SDL_mutex *async_lock = NULL;
+static SDL_cond *async_idle = NULL;
+static pgAsyncJob *async_head = NULL, *async_tail = NULL;
+static int async_workers = 0;
+static int async_quit_registered = 0;
+static PyObject *future_type = NULL;
+
+/* Resolves the future of job to the loaded surf, to None for a save
+ * without error, or to a pygame.error of error */
+static void
+_async_finish(pgAsyncJob *job, SDL_Surface *surf, const char *error)
+{
+    PyGILState_STATE state = PyGILState_Ensure();
+    PyObject *obj = NULL, *ret;
+
+    if (error) {
+        PyErr_SetString(pgExc_SDLError, error);
+    }
+    else if (surf) {
+        if (!(obj = (PyObject *)pgSurface_New(surf))) {
+            SDL_FreeSurface(surf);
+        }
+        else if (job->convert) {
+            ret = PyObject_CallMethod(obj, job->convert, NULL);
+            Py_SETREF(obj, ret);
+        }
+    }
+    else {
+        Py_INCREF(Py_None);
+        obj = Py_None;
+    }
+    if (obj) {
+        ret = PyObject_CallMethod(job->future, "set_result", "O", obj);
+        Py_DECREF(obj);
+    }
+    else {
+        PyObject *type, *value, *tb;
+
+        PyErr_Fetch(&type, &value, &tb);
+        PyErr_NormalizeException(&type, &value, &tb);
+        ret = PyObject_CallMethod(job->future, "set_exception", "O", value);
+        Py_XDECREF(type);
+        Py_XDECREF(value);
+        Py_XDECREF(tb);
+    }
+    if (!ret) {
+        PyErr_WriteUnraisable(job->future);
+    }
+    Py_XDECREF(ret);
+    Py_DECREF(job->future);
+    PyGILState_Release(state);
+}
+
+static void
+_async_free_job(pgAsyncJob *job)
+{
+    if (job->rw) {
+        SDL_RWclose(job->rw);
+    }
+    if (job->save) {
+        SDL_FreeSurface(job->save);
+    }
+    free(job->ext);
+    free(job);
+}
+
+static int SDLCALL
+_async_worker(void *data)
+{
+    pgAsyncJob *job;
+    SDL_Surface *surf;
+    int result;
+
+    for (;;) {
+        SDL_LockMutex(async_lock);
+        job = async_head;
+        if (job) {
+            async_head = job->next;
+            if (!async_head) {
+                async_tail = NULL;
+            }
+        }
+        else {
+            --async_workers;
+            SDL_CondBroadcast(async_idle);
+            SDL_UnlockMutex(async_lock);
+            return 0;
+        }
+        SDL_UnlockMutex(async_lock);
+
+        if (job->save) {
+            result = _encode_rw(job->save, job->rw, job->ext, job->quality);
+            if (SDL_RWclose(job->rw) < 0) {
+                result = -1;
+            }
+            job->rw = NULL;
+            _async_finish(job, NULL, result ? SDL_GetError() : NULL);
+        }
+        else {
+            surf = _decode_rw(job->rw, job->ext);
+            job->rw = NULL; /* closed by the decoder */
+            _async_finish(job, surf, surf ? NULL : SDL_GetError());
+        }
+        _async_free_job(job);
+    }
+}
+
+/* Registered with pg_RegisterQuit: let queued jobs finish before SDL and
+ * the interpreter go away. */
+static void
+_async_quit(void)
+{
+    Py_BEGIN_ALLOW_THREADS;
+    SDL_LockMutex(async_lock);
+    while (async_workers) {
+        SDL_CondWait(async_idle, async_lock);
+    }
+    SDL_UnlockMutex(async_lock);
+    Py_END_ALLOW_THREADS;
+    async_quit_registered = 0;
+}
+
+/* Sets up the job queue and the Future class on first use */
+static int
+_async_init(void)
+{
+    if (!async_lock) {
+        if (!(async_lock = SDL_CreateMutex()) ||
+            !(async_idle = SDL_CreateCond())) {
+            PyErr_SetString(pgExc_SDLError, SDL_GetError());
+            return -1;
+        }
+    }
+    if (!future_type) {
+        PyObject *mod = PyImport_ImportModule("concurrent.futures");
+
+        if (!mod) {
+            return -1;
+        }
+        future_type = PyObject_GetAttrString(mod, "Future");
+        Py_DECREF(mod);
+        if (!future_type) {
+            return -1;
+        }
+    }
+    return 0;
+}
+
+/* Sets the file type of job to the extension of name */
+static int
+_async_set_ext(pgAsyncJob *job, const char *name)
+{
+    const char *ext = find_extension(name);
+
+    free(job->ext);
+    if (!(job->ext = malloc(strlen(ext) + 1))) {
+        PyErr_NoMemory();
+        return -1;
+    }
+    strcpy(job->ext, ext);
+    return 0;
+}
+
+/* Queues job, starting a worker for it if there are less than the maximum.
+ * Returns the Future of the job, or NULL with an exception set and the job
+ * freed. */
+static PyObject *
+_async_submit(pgAsyncJob *job)
+{
+    PyObject *future;
+    int spawn = 0, max_workers = ASYNC_MAX_WORKERS;
+    SDL_Thread *thread;
+
+    if (!(future = PyObject_CallObject(future_type, NULL))) {
+        _async_free_job(job);
+        return NULL;
+    }
+    Py_INCREF(future);
+    job->future = future;
+
+    if (!async_quit_registered) {
+        pg_RegisterQuit(_async_quit);
+        async_quit_registered = 1;
+    }
+    if (ext_decoder && !ext_decoder->threadsafe) {
+        max_workers = 1;
+    }
+
+    SDL_LockMutex(async_lock);
+    if (async_tail) {
+        async_tail->next = job;
+    }
+    else {
+        async_head = job;
+    }
+    async_tail = job;
+    if (async_workers < max_workers) {
+        ++async_workers;
+        spawn = 1;
+    }
+    SDL_UnlockMutex(async_lock);
+
+    if (spawn) {
+        thread = SDL_CreateThread(_async_worker, "pygame_image_async", NULL);
+        if (thread) {
+            SDL_DetachThread(thread);
+        }
+        else {
+            /* an existing worker will pick the job up; with none left,
+             * take it back and fail */
+            SDL_LockMutex(async_lock);
+            spawn = --async_workers;
+            if (!spawn) {
+                async_head = async_tail = NULL;
+            }
+            SDL_UnlockMutex(async_lock);
+            if (!spawn) {
+                PyErr_SetString(pgExc_SDLError, SDL_GetError());
+                _async_free_job(job);
+                Py_DECREF(future); /* the job's reference */
+                Py_DECREF(future);
+                return NULL;
+            }
+        }
+    }
+    return future;
+}
+
+static PyObject *
+image_load_async(PyObject *self, PyObject *arg, PyObject *kwarg)
+{
+    PyObject *obj;
+    const char *name = NULL;
+    int convert = 0, convert_alpha = 0;
+    pgAsyncJob *job;
+    static char *kwds[] = {"file", "namehint", "convert", "convert_alpha",
+                           NULL};
+
+    if (!PyArg_ParseTupleAndKeywords(arg, kwarg, "O|s$pp", kwds, &obj, &name,
+                                     &convert, &convert_alpha)) {
+        return NULL;
+    }
+    if (convert && convert_alpha) {
+        return RAISE(PyExc_ValueError,
+                     "convert and convert_alpha are mutually exclusive");
+    }
+    if (_async_init()) {
+        return NULL;
+    }
+
+    if (!(job = (pgAsyncJob *)calloc(1, sizeof(pgAsyncJob)))) {
+        return PyErr_NoMemory();
+    }
+    if (!(job->rw = pgRWops_FromObject(obj, &job->ext))) {
+        free(job);
+        return NULL;
+    }
+    /* override extension with namehint if given */
+    if (name && _async_set_ext(job, name)) {
+        _async_free_job(job);
+        return NULL;
+    }
+    job->convert = convert         ? "convert"
+                   : convert_alpha ? "convert_alpha"
+                                   : NULL;
+    return _async_submit(job);
+}
+
 #ifdef WIN32
 #define strcasecmp _stricmp
 #else
@@ -196,6 +734,11 @@ image_save(PyObject *self, PyObject *arg, PyObject *kwarg)
                      * result is either 0 or -1: */
                     result = (SDL_SaveBMP_RW(surf, rw, 0) == 0 ? 0 : -1);
                 }
+                else if (!strcasecmp(ext, "qoi")) {
+                    Py_BEGIN_ALLOW_THREADS;
+                    result = SaveQOI_RW(surf, rw);
+                    Py_END_ALLOW_THREADS;
+                }
                 else {
                     result = SaveTGA_RW(surf, rw, 1);
                 }
@@ -213,6 +756,11 @@ image_save(PyObject *self, PyObject *arg, PyObject *kwarg)
                 result = (SDL_SaveBMP(surf, name) == 0 ? 0 : -1);
                 Py_END_ALLOW_THREADS;
             }
+            else if (!strcasecmp(ext, "qoi")) {
+                Py_BEGIN_ALLOW_THREADS;
+                result = SaveQOI(surf, name);
+                Py_END_ALLOW_THREADS;
+            }
             else {
                 Py_BEGIN_ALLOW_THREADS;
                 result = SaveTGA(surf, name, 1);
@@ -240,6 +788,77 @@ image_save(PyObject *self, PyObject *arg, PyObject *kwarg)
     Py_RETURN_NONE;
 }
 
+static PyObject *
+image_save_async(PyObject *self, PyObject *arg, PyObject *kwarg)
+{
+    pgSurfaceObject *surfobj;
+    PyObject *obj, *oencoded;
+    const char *name, *namehint = NULL;
+    int quality = JPEG_QUALITY;
+    SDL_Surface *surf;
+    pgAsyncJob *job;
+    static char *kwds[] = {"surface", "file", "namehint", "quality", NULL};
+
+    if (!PyArg_ParseTupleAndKeywords(arg, kwarg, "O!O|s$i", kwds,
+                                     &pgSurface_Type, &surfobj, &obj,
+                                     &namehint, &quality)) {
+        return NULL;
+    }
+    if (quality < 0 || quality > 100) {
+        return RAISE(PyExc_ValueError, "quality must be between 0 and 100");
+    }
+    surf = pgSurface_AsSurface(surfobj);
+    SURF_INIT_CHECK(surf)
+    if (_async_init()) {
+        return NULL;
+    }
+
+    oencoded = pg_EncodeString(obj, "UTF-8", NULL, pgExc_SDLError);
+    if (!oencoded) {
+        return NULL;
+    }
+    if (oencoded == Py_None) {
+        Py_DECREF(oencoded);
+        return RAISE(PyExc_TypeError,
+                     "file must be a str, bytes or os.PathLike path");
+    }
+    name = PyBytes_AS_STRING(oencoded);
+
+    if (!(job = (pgAsyncJob *)calloc(1, sizeof(pgAsyncJob)))) {
+        Py_DECREF(oencoded);
+        return PyErr_NoMemory();
+    }
+    job->quality = quality;
+    if (_async_set_ext(job, namehint ? namehint : name)) {
+        Py_DECREF(oencoded);
+        free(job);
+        return NULL;
+    }
+    if (!ext_encoder && (!strcasecmp(job->ext, "png") ||
+                         !strcasecmp(job->ext, "jpg") ||
+                         !strcasecmp(job->ext, "jpeg"))) {
+        Py_DECREF(oencoded);
+        _async_free_job(job);
+        return RAISE(PyExc_NotImplementedError,
+                     "saving images of extended format is not available");
+    }
+
+    /* the pixels are saved as they are now, whatever is drawn next */
+    pgSurface_Prep(surfobj);
+    job->save = PG_ConvertSurface(surf, surf->format);
+    pgSurface_Unprep(surfobj);
+    if (job->save) {
+        job->rw = SDL_RWFromFile(name, "wb");
+    }
+    Py_DECREF(oencoded);
+    if (!job->rw) {
+        PyErr_SetString(pgExc_SDLError, SDL_GetError());
+        _async_free_job(job);
+        return NULL;
+    }
+    return _async_submit(job);
+}
+
 static PyObject *
 image_get_extended(PyObject *self, PyObject *_null)
 {
@@ -258,248 +877,190 @@ image_get_sdl_image_version(PyObject *self, PyObject *args, PyObject *kwargs)
         return PyObject_Call(extverobj, args, kwargs);
 }
 
-#if PG_COMPILE_SSE4_2
-#define SSE42_ALIGN_NEEDED 16
-#define SSE42_ALIGN __attribute__((aligned(SSE42_ALIGN_NEEDED)))
-
-#define _SHIFT_N_STEP2ALIGN(shift, step) (shift / 8 + step * 4)
+/* The generic row kernels, see simd_image.h */
+void
+tobytes_row(const Uint8 *src, Uint8 *dst, int n, const Sint8 *order,
+            int out_bpp)
+{
+    _pg_tobytes_row_finish(src, dst, 0, n, order, out_bpp);
+}
 
-#if PYGAME_DEBUG_SSE
-/* Useful for debugging/comparing the SSE vectors */
-static void
-_debug_print128_num(__m128i var, const char *msg)
+void
+swap24_row(const Uint8 *src, Uint8 *dst, int n)
 {
-    uint32_t val[4];
-    memcpy(val, &var, sizeof(val));
-    fprintf(stderr, "%s: %04x%04x%04x%04x\n", msg, val[0], val[1], val[2],
-            val[3]);
+    _pg_swap24_row_finish(src, dst, 0, n);
 }
-#define DEBUG_PRINT128_NUM(var, msg) _debug_print128_num(var, msg)
-#else
-#define DEBUG_PRINT128_NUM(var, msg) \
-    do { /* do nothing */            \
-    } while (0)
-#endif
 
-/*
- * Generates an SSE vector useful for reordering a SSE vector
- * based on the "in-memory layout" to match the "tobytes layout"
- * It is only useful as second parameter to _mm_shuffle_epi8.
- *
- * A short _mm_shuffle_epi8 primer:
- *
- * - If the highest bit of a byte in the reorder vector is set,
- *   the matching byte in the original vector is cleared:
- * - Otherwise, the 3 lowest bit of the byte in the reorder vector
- *   represent the byte index of where to find the relevant value
- *   from the original vector.
- *
- * As an example, given the following in memory layout (bytes):
- *
- *    R1 G1 B1 A1 R2 G2 B2 A2 ...
- *
- * And we want:
- *
- *    A1 R1 G1 B1 A2 R2 G2 B2
- *
- * Then the reorder vector should look like (in hex):
- *
- *    03 00 01 02 07 04 05 06
- *
- * This is exactly the type of vector that compute_align_vector
- * produces (based on the pixel format and where the alpha should
- * be placed in the output).
- */
-static PG_INLINE __m128i
-compute_align_vector(SDL_PixelFormat *format, int color_offset,
-                     int alpha_offset)
-{
-    int output_align[4];
-    size_t i;
-    size_t limit = sizeof(output_align) / sizeof(int);
-    int a_shift = alpha_offset * 8;
-    int r_shift = (color_offset + 0) * 8;
-    int g_shift = (color_offset + 1) * 8;
-    int b_shift = (color_offset + 2) * 8;
-    for (i = 0; i < limit; i++) {
-        int p = 3 - i;
-        output_align[i] = _SHIFT_N_STEP2ALIGN(format->Rshift, p) << r_shift |
-                          _SHIFT_N_STEP2ALIGN(format->Gshift, p) << g_shift |
-                          _SHIFT_N_STEP2ALIGN(format->Bshift, p) << b_shift |
-                          _SHIFT_N_STEP2ALIGN(format->Ashift, p) << a_shift;
-    }
-    return _mm_set_epi32(output_align[0], output_align[1], output_align[2],
-                         output_align[3]);
-}
-
-static PG_INLINE PG_FUNCTION_TARGET_SSE4_2 void
-tobytes_pixels_32bit_sse4(const __m128i *row, __m128i *data, int loop_max,
-                          __m128i mask_vector, __m128i align_vector)
-{
-    int w;
-    for (w = 0; w < loop_max; ++w) {
-        __m128i pvector = _mm_loadu_si128(row + w);
-        DEBUG_PRINT128_NUM(pvector, "Load");
-        pvector = _mm_and_si128(pvector, mask_vector);
-        DEBUG_PRINT128_NUM(pvector, "after _mm_and_si128 (and)");
-        pvector = _mm_shuffle_epi8(pvector, align_vector);
-        DEBUG_PRINT128_NUM(pvector, "after _mm_shuffle_epi8 (reorder)");
-        _mm_storeu_si128(data + w, pvector);
+static TOBYTES_ROW_P
+_get_tobytes_row(void)
+{
+#if !defined(__EMSCRIPTEN__)
+    if (_pg_image_has_avx2()) {
+        return tobytes_row_avx2;
+    }
+#if PG_ENABLE_SSE_NEON
+    if (_pg_image_HasSSE_NEON()) {
+        return tobytes_row_sse2;
     }
+#endif /* PG_ENABLE_SSE_NEON */
+#endif /* !__EMSCRIPTEN__ */
+    return tobytes_row;
 }
 
-/*
- * SSE4.2 variant of tobytes_surf_32bpp.
- *
- * It is a lot faster but only works on a subset of the surfaces
- * (plus requires SSE4.2 support from the CPU).
- */
-static PG_FUNCTION_TARGET_SSE4_2 void
-tobytes_surf_32bpp_sse42(SDL_Surface *surf, int flipped, char *data,
-                         int color_offset, int alpha_offset)
+static SWAP24_ROW_P
+_get_swap24_row(void)
 {
-    const int step_size = 4;
-    int h;
-    SDL_PixelFormat *format = surf->format;
-    int loop_max = surf->w / step_size;
-    int mask = (format->Rloss ? 0 : format->Rmask) |
-               (format->Gloss ? 0 : format->Gmask) |
-               (format->Bloss ? 0 : format->Bmask) |
-               (format->Aloss ? 0 : format->Amask);
-
-    __m128i mask_vector = _mm_set_epi32(mask, mask, mask, mask);
-    __m128i align_vector =
-        compute_align_vector(surf->format, color_offset, alpha_offset);
-    /* How much we would overshoot if we overstep loop_max */
-    int rollback_count = surf->w % step_size;
-    if (rollback_count) {
-        rollback_count = step_size - rollback_count;
-    }
-
-    DEBUG_PRINT128_NUM(mask_vector, "mask-vector");
-    DEBUG_PRINT128_NUM(align_vector, "align-vector");
-
-    /* This code will be horribly wrong if these assumptions do not hold.
-     * They are intended as a debug/testing guard to ensure that nothing
-     * calls this function without ensuring the assumptions during
-     * development
-     */
-    assert(sizeof(int) == sizeof(Uint32));
-    assert(4 * sizeof(Uint32) == sizeof(__m128i));
-    /* If this assertion does not hold, the fallback code will overrun
-     * the buffers.
-     */
-    assert(surf->w >= step_size);
-    assert(format->Rloss % 8 == 0);
-    assert(format->Gloss % 8 == 0);
-    assert(format->Bloss % 8 == 0);
-    assert(format->Aloss % 8 == 0);
-
-    for (h = 0; h < surf->h; ++h) {
-        const char *row =
-            (char *)DATAROW(surf->pixels, h, surf->pitch, surf->h, flipped);
-        tobytes_pixels_32bit_sse4((const __m128i *)row, (__m128i *)data,
-                                  loop_max, mask_vector, align_vector);
-        row += sizeof(__m128i) * loop_max;
-        data += sizeof(__m128i) * loop_max;
-        if (rollback_count) {
-            /* Back up a bit to ensure we stay within the memory boundaries
-             * Technically, we end up redoing part of the computations, but
-             * it does not really matter as the runtime of these operations
-             * are fixed and the results are deterministic.
-             */
-            row -= rollback_count * sizeof(Uint32);
-            data -= rollback_count * sizeof(Uint32);
-
-            tobytes_pixels_32bit_sse4((const __m128i *)row, (__m128i *)data, 1,
-                                      mask_vector, align_vector);
+#if !defined(__EMSCRIPTEN__)
+    if (_pg_image_has_avx2()) {
+        return swap24_row_avx2;
+    }
+#if PG_ENABLE_SSE_NEON
+    if (_pg_image_HasSSE_NEON()) {
+        return swap24_row_sse2;
+    }
+#endif /* PG_ENABLE_SSE_NEON */
+#endif /* !__EMSCRIPTEN__ */
+    return swap24_row;
+}
 
-            row += sizeof(__m128i);
-            data += sizeof(__m128i);
-        }
+/* The byte in memory of a bpp bytes pixel that holds the channel, or -1 if
+ * the channel isn't a whole byte */
+static int
+_channel_byte(Uint32 mask, Uint32 shift, int bpp)
+{
+    if (shift % 8 || mask != (Uint32)0xFF << shift) {
+        return -1;
     }
+#if SDL_BYTEORDER == SDL_LIL_ENDIAN
+    return (int)shift / 8;
+#else
+    return bpp - 1 - (int)shift / 8;
+#endif
 }
-#endif /* PG_COMPILE_SSE4_2 */
 
+/* Writes the 32 bit surf as out_bpp bytes per pixel, with the R, G, B and A
+ * bytes at offsets[0] to offsets[3]. A negative alpha offset leaves the
+ * alpha out. */
 static void
 tobytes_surf_32bpp(SDL_Surface *surf, int flipped, int hascolorkey,
-                   Uint32 colorkey, char *serialized_image, int color_offset,
-                   int alpha_offset, int padding)
-{
-    int w, h;
-
-    Uint32 Rmask = surf->format->Rmask;
-    Uint32 Gmask = surf->format->Gmask;
-    Uint32 Bmask = surf->format->Bmask;
-    Uint32 Amask = surf->format->Amask;
-    Uint32 Rshift = surf->format->Rshift;
-    Uint32 Gshift = surf->format->Gshift;
-    Uint32 Bshift = surf->format->Bshift;
-    Uint32 Ashift = surf->format->Ashift;
-    Uint32 Rloss = surf->format->Rloss;
-    Uint32 Gloss = surf->format->Gloss;
-    Uint32 Bloss = surf->format->Bloss;
-    Uint32 Aloss = surf->format->Aloss;
-
-#if PG_COMPILE_SSE4_2
-    if (/* SDL uses Uint32, SSE uses int for building vectors.
-         * Related, we assume that Uint32 is packed so 4 of
-         * them perfectly matches an __m128i.
-         * If these assumptions do not match up, we will
-         * produce incorrect results.
-         */
-        sizeof(int) == sizeof(Uint32) &&
-        4 * sizeof(Uint32) == sizeof(__m128i) &&
-        !hascolorkey /* No color key */
-        && !padding &&
-        SDL_HasSSE42() == SDL_TRUE
-        /* The SSE code assumes it will always read at least 4 pixels */
-        && surf->w >= 4
-        /* Our SSE code assumes masks are at most 0xff */
-        && (surf->format->Rmask >> surf->format->Rshift) <= 0x0ff &&
-        (surf->format->Gmask >> surf->format->Gshift) <= 0x0ff &&
-        (surf->format->Bmask >> surf->format->Bshift) <= 0x0ff &&
-        (Amask >> Ashift) <= 0x0ff
-        /* Our SSE code cannot handle losses other than 0 or 8
-         * Note the mask check above ensures that losses can be
-         * at most be 8 (assuming the pixel format makes sense
-         * at all).
-         */
-        && (surf->format->Rloss % 8) == 0 && (surf->format->Bloss % 8) == 0 &&
-        (surf->format->Gloss % 8) == 0 && (Aloss % 8) == 0) {
-        tobytes_surf_32bpp_sse42(surf, flipped, serialized_image, color_offset,
-                                 alpha_offset);
+                   Uint32 colorkey, char *serialized_image,
+                   const int *offsets, int out_bpp, int padding)
+{
+    SDL_PixelFormat *format = surf->format;
+    Uint32 masks[4] = {format->Rmask, format->Gmask, format->Bmask,
+                       format->Amask};
+    Uint32 shifts[4] = {format->Rshift, format->Gshift, format->Bshift,
+                        format->Ashift};
+    Uint32 losses[4] = {format->Rloss, format->Gloss, format->Bloss,
+                        format->Aloss};
+    Sint8 order[4] = {-1, -1, -1, -1};
+    TOBYTES_ROW_P row_func;
+    int byte, w, h, c;
+    int whole_bytes = !hascolorkey;
+
+    /* the row kernels only move whole bytes around, a missing alpha is
+     * filled in as 0xFF */
+    for (c = 0; c < 4 && whole_bytes; c++) {
+        if (offsets[c] < 0 || (c == 3 && !masks[3])) {
+            continue;
+        }
+        byte = _channel_byte(masks[c], shifts[c], 4);
+        if (byte < 0) {
+            whole_bytes = 0;
+        }
+        order[offsets[c]] = (Sint8)byte;
+    }
+
+    if (whole_bytes) {
+        row_func = _get_tobytes_row();
+        for (h = 0; h < surf->h; ++h) {
+            row_func((Uint8 *)DATAROW(surf->pixels, h, surf->pitch, surf->h,
+                                      flipped),
+                     (Uint8 *)serialized_image, surf->w, order, out_bpp);
+            serialized_image += surf->w * out_bpp;
+            pad(&serialized_image, padding);
+        }
         return;
     }
-#endif /* PG_COMPILE_SSE4_2 */
 
     for (h = 0; h < surf->h; ++h) {
         Uint32 *pixel_row =
             (Uint32 *)DATAROW(surf->pixels, h, surf->pitch, surf->h, flipped);
         for (w = 0; w < surf->w; ++w) {
             Uint32 color = *pixel_row++;
-            serialized_image[color_offset + 0] =
-                (char)(((color & Rmask) >> Rshift) << Rloss);
-            serialized_image[color_offset + 1] =
-                (char)(((color & Gmask) >> Gshift) << Gloss);
-            serialized_image[color_offset + 2] =
-                (char)(((color & Bmask) >> Bshift) << Bloss);
-            serialized_image[alpha_offset] =
-                hascolorkey
-                    ? (char)(color != colorkey) * 255
-                    : (char)(Amask ? (((color & Amask) >> Ashift) << Aloss)
-                                   : 255);
-            serialized_image += 4;
+            for (c = 0; c < 3; c++) {
+                serialized_image[offsets[c]] =
+                    (char)(((color & masks[c]) >> shifts[c]) << losses[c]);
+            }
+            if (offsets[3] < 0) {
+                /* no alpha byte */
+            }
+            else if (hascolorkey) {
+                serialized_image[offsets[3]] = (char)(color != colorkey) * 255;
+            }
+            else if (masks[3]) {
+                serialized_image[offsets[3]] =
+                    (char)(((color & masks[3]) >> shifts[3]) << losses[3]);
+            }
+            else {
+                serialized_image[offsets[3]] = (char)255;
+            }
+            serialized_image += out_bpp;
         }
         pad(&serialized_image, padding);
     }
 }
 
+/* Writes the 24 bit surf as RGB bytes, returns 0 without writing anything
+ * if its channels aren't whole bytes */
+static int
+tobytes_surf_24bpp_rgb(SDL_Surface *surf, int flipped, char *data,
+                       int padding)
+{
+    SDL_PixelFormat *format = surf->format;
+    SWAP24_ROW_P row_func = NULL;
+    Uint8 *row;
+    int h;
+
+    if (_channel_byte(format->Gmask, format->Gshift, 3) != 1) {
+        return 0;
+    }
+    if (_channel_byte(format->Rmask, format->Rshift, 3) == 2 &&
+        _channel_byte(format->Bmask, format->Bshift, 3) == 0) {
+        row_func = _get_swap24_row();
+    }
+    else if (_channel_byte(format->Rmask, format->Rshift, 3) != 0 ||
+             _channel_byte(format->Bmask, format->Bshift, 3) != 2) {
+        return 0;
+    }
+
+    for (h = 0; h < surf->h; ++h) {
+        row = (Uint8 *)DATAROW(surf->pixels, h, surf->pitch, surf->h, flipped);
+        if (row_func) {
+            row_func(row, (Uint8 *)data, surf->w);
+        }
+        else {
+            memcpy(data, row, surf->w * 3);
+        }
+        data += surf->w * 3;
+        pad(&data, padding);
+    }
+    return 1;
+}
+
+/* byte offsets of R, G, B and A in the tobytes formats */
+static const int _rgb_offsets[4] = {0, 1, 2, -1};
+static const int _rgba_offsets[4] = {0, 1, 2, 3};
+static const int _argb_offsets[4] = {1, 2, 3, 0};
+static const int _bgra_offsets[4] = {2, 1, 0, 3};
+static const int _abgr_offsets[4] = {3, 2, 1, 0};
+
 PyObject *
 image_tobytes(PyObject *self, PyObject *arg, PyObject *kwarg)
 {
     pgSurfaceObject *surfobj;
-    PyObject *bytes = NULL;
+    PyObject *bytes = NULL, *into = NULL;
+    Py_buffer view;
     char *format, *data;
     SDL_Surface *surf;
     int w, h, flipped = 0, pitch = -1;
@@ -510,7 +1071,8 @@ image_tobytes(PyObject *self, PyObject *arg, PyObject *kwarg)
     int hascolorkey = 0;
     Uint32 color, colorkey;
     Uint32 alpha;
-    static char *kwds[] = {"surface", "format", "flipped", "pitch", NULL};
+    static char *kwds[] = {"surface", "format", "flipped",
+                           "pitch",   "into",   NULL};
 
 #ifdef _MSC_VER
     /* MSVC static analyzer false alarm: assure format is NULL-terminated by
@@ -518,10 +1080,13 @@ image_tobytes(PyObject *self, PyObject *arg, PyObject *kwarg)
     __analysis_assume(format = "inited");
 #endif
 
-    if (!PyArg_ParseTupleAndKeywords(arg, kwarg, "O!s|ii", kwds,
+    if (!PyArg_ParseTupleAndKeywords(arg, kwarg, "O!s|iiO", kwds,
                                      &pgSurface_Type, &surfobj, &format,
-                                     &flipped, &pitch))
+                                     &flipped, &pitch, &into))
         return NULL;
+    if (into == Py_None) {
+        into = NULL;
+    }
     surf = pgSurface_AsSurface(surfobj);
 
     Rmask = surf->format->Rmask;
@@ -582,10 +1147,26 @@ image_tobytes(PyObject *self, PyObject *arg, PyObject *kwarg)
         padding = pitch - byte_width;
     }
 
-    bytes = PyBytes_FromStringAndSize(NULL, (Py_ssize_t)pitch * surf->h);
-    if (!bytes)
-        return NULL;
-    PyBytes_AsStringAndSize(bytes, &data, &len);
+    if (into) {
+        if (PyObject_GetBuffer(into, &view,
+                               PyBUF_WRITABLE | PyBUF_C_CONTIGUOUS)) {
+            return NULL;
+        }
+        if (view.len < (Py_ssize_t)pitch * surf->h) {
+            PyBuffer_Release(&view);
+            return PyErr_Format(PyExc_ValueError,
+                                "into buffer is too small, %zd bytes are "
+                                "needed",
+                                (Py_ssize_t)pitch * surf->h);
+        }
+        data = (char *)view.buf;
+    }
+    else {
+        bytes = PyBytes_FromStringAndSize(NULL, (Py_ssize_t)pitch * surf->h);
+        if (!bytes)
+            return NULL;
+        PyBytes_AsStringAndSize(bytes, &data, &len);
+    }
 
     if (!strcmp(format, "P")) {
         pgSurface_Lock(surfobj);
@@ -630,6 +1211,9 @@ image_tobytes(PyObject *self, PyObject *arg, PyObject *kwarg)
                 }
                 break;
             case 3:
+                if (tobytes_surf_24bpp_rgb(surf, flipped, data, padding)) {
+                    break;
+                }
                 for (h = 0; h < surf->h; ++h) {
                     Uint8 *ptr = (Uint8 *)DATAROW(surf->pixels, h, surf->pitch,
                                                   surf->h, flipped);
@@ -649,18 +1233,8 @@ image_tobytes(PyObject *self, PyObject *arg, PyObject *kwarg)
                 }
                 break;
             case 4:
-                for (h = 0; h < surf->h; ++h) {
-                    Uint32 *ptr = (Uint32 *)DATAROW(
-                        surf->pixels, h, surf->pitch, surf->h, flipped);
-                    for (w = 0; w < surf->w; ++w) {
-                        color = *ptr++;
-                        data[0] = (char)(((color & Rmask) >> Rshift) << Rloss);
-                        data[1] = (char)(((color & Gmask) >> Gshift) << Rloss);
-                        data[2] = (char)(((color & Bmask) >> Bshift) << Rloss);
-                        data += 3;
-                    }
-                    pad(&data, padding);
-                }
+                tobytes_surf_32bpp(surf, flipped, 0, 0, data, _rgb_offsets, 3,
+                                   padding);
                 break;
         }
 
@@ -732,7 +1306,7 @@ image_tobytes(PyObject *self, PyObject *arg, PyObject *kwarg)
                 break;
             case 4:
                 tobytes_surf_32bpp(surf, flipped, hascolorkey, colorkey, data,
-                                   0, 3, padding);
+                                   _rgba_offsets, 4, padding);
                 break;
         }
         pgSurface_Unlock(surfobj);
@@ -795,8 +1369,8 @@ image_tobytes(PyObject *self, PyObject *arg, PyObject *kwarg)
                 }
                 break;
             case 4:
-                tobytes_surf_32bpp(surf, flipped, hascolorkey, colorkey, data,
-                                   1, 0, padding);
+                tobytes_surf_32bpp(surf, flipped, 0, 0, data, _argb_offsets, 4,
+                                   padding);
                 break;
         }
         pgSurface_Unlock(surfobj);
@@ -859,21 +1433,8 @@ image_tobytes(PyObject *self, PyObject *arg, PyObject *kwarg)
                 }
                 break;
             case 4:
-                for (h = 0; h < surf->h; ++h) {
-                    Uint32 *ptr = (Uint32 *)DATAROW(
-                        surf->pixels, h, surf->pitch, surf->h, flipped);
-                    for (w = 0; w < surf->w; ++w) {
-                        color = *ptr++;
-                        data[2] = (char)(((color & Rmask) >> Rshift) << Rloss);
-                        data[1] = (char)(((color & Gmask) >> Gshift) << Gloss);
-                        data[0] = (char)(((color & Bmask) >> Bshift) << Bloss);
-                        data[3] = (char)(Amask ? (((color & Amask) >> Ashift)
-                                                  << Aloss)
-                                               : 255);
-                        data += 4;
-                    }
-                    pad(&data, padding);
-                }
+                tobytes_surf_32bpp(surf, flipped, 0, 0, data, _bgra_offsets, 4,
+                                   padding);
                 break;
         }
         pgSurface_Unlock(surfobj);
@@ -936,21 +1497,8 @@ image_tobytes(PyObject *self, PyObject *arg, PyObject *kwarg)
                 }
                 break;
             case 4:
-                for (h = 0; h < surf->h; ++h) {
-                    Uint32 *ptr = (Uint32 *)DATAROW(
-                        surf->pixels, h, surf->pitch, surf->h, flipped);
-                    for (w = 0; w < surf->w; ++w) {
-                        color = *ptr++;
-                        data[3] = (char)(((color & Rmask) >> Rshift) << Rloss);
-                        data[2] = (char)(((color & Gmask) >> Gshift) << Gloss);
-                        data[1] = (char)(((color & Bmask) >> Bshift) << Bloss);
-                        data[0] = (char)(Amask ? (((color & Amask) >> Ashift)
-                                                  << Aloss)
-                                               : 255);
-                        data += 4;
-                    }
-                    pad(&data, padding);
-                }
+                tobytes_surf_32bpp(surf, flipped, 0, 0, data, _abgr_offsets, 4,
+                                   padding);
                 break;
         }
         pgSurface_Unlock(surfobj);
@@ -1120,6 +1668,11 @@ image_tobytes(PyObject *self, PyObject *arg, PyObject *kwarg)
         pgSurface_Unlock(surfobj);
     }
 
+    if (into) {
+        PyBuffer_Release(&view);
+        Py_INCREF(into);
+        return into;
+    }
     return bytes;
 }
 
@@ -1131,7 +1684,7 @@ image_frombytes(PyObject *self, PyObject *arg, PyObject *kwds)
     SDL_Surface *surf = NULL;
     int w, h, flipped = 0, pitch = -1;
     Py_ssize_t len;
-    int loopw, looph;
+    int looph;
 
 #ifdef _MSC_VER
     /* MSVC static analyzer false alarm: assure format is NULL-terminated by
@@ -1192,6 +1745,7 @@ image_frombytes(PyObject *self, PyObject *arg, PyObject *kwds)
                 "Bytes length does not equal format and resolution size");
 
 #if SDL_BYTEORDER == SDL_LIL_ENDIAN
+        SWAP24_ROW_P swap_func = _get_swap24_row();
         surf = PG_CreateSurface(w, h, SDL_PIXELFORMAT_BGR24);
 #else
         surf = PG_CreateSurface(w, h, SDL_PIXELFORMAT_RGB24);
@@ -1202,21 +1756,12 @@ image_frombytes(PyObject *self, PyObject *arg, PyObject *kwds)
         for (looph = 0; looph < h; ++looph) {
             Uint8 *pix =
                 (Uint8 *)DATAROW(surf->pixels, looph, surf->pitch, h, flipped);
-            for (loopw = 0; loopw < w; ++loopw) {
 #if SDL_BYTEORDER == SDL_LIL_ENDIAN
-                pix[2] = data[0];
-                pix[1] = data[1];
-                pix[0] = data[2];
+            swap_func((Uint8 *)data, pix, w);
 #else
-                pix[0] = data[0];
-                pix[1] = data[1];
-                pix[2] = data[2];
+            memcpy(pix, data, w * 3);
 #endif
-                pix += 3;
-                data += 3;
-            }
-
-            data += pitch - w * 3;
+            data += pitch;
         }
         SDL_UnlockSurface(surf);
     }
@@ -1778,103 +2323,1569 @@ SaveTGA(SDL_Surface *surface, const char *file, int rle)
     return ret;
 }
 
-static PyObject *
-image_load_sized_svg(PyObject *self, PyObject *args, PyObject *kwargs)
-{
-    if (ext_load_sized_svg) {
-        return PyObject_Call(ext_load_sized_svg, args, kwargs);
-    }
+/*
+ * QOI ("Quite OK Image") support, see https://qoiformat.org/
+ * The format is byte oriented and every op depends on the previous pixel,
+ * so both directions are a single tight pass with no SIMD to speak of.
+ */
+#define QOI_OP_INDEX 0x00
+#define QOI_OP_DIFF 0x40
+#define QOI_OP_LUMA 0x80
+#define QOI_OP_RUN 0xc0
+#define QOI_OP_RGB 0xfe
+#define QOI_OP_RGBA 0xff
+#define QOI_MASK_2 0xc0
+#define QOI_HEADER_SIZE 14
+#define QOI_PADDING_SIZE 8
+#define QOI_PIXELS_MAX 400000000u
+#define QOI_HASH(p) (((p).r * 3 + (p).g * 5 + (p).b * 7 + (p).a * 11) & 63)
+
+typedef struct {
+    Uint8 r, g, b, a;
+} pgQoiPixel;
+
+static const Uint8 qoi_padding[QOI_PADDING_SIZE] = {0, 0, 0, 0, 0, 0, 0, 1};
 
-    return RAISE(PyExc_NotImplementedError,
-                 "Support for sized svg image loading was not compiled in.");
+static void
+_qoi_put_be32(Uint8 *p, Uint32 v)
+{
+    v = SDL_SwapBE32(v);
+    memcpy(p, &v, 4);
 }
 
-static PyMethodDef _image_methods[] = {
-    {"load_basic", (PyCFunction)image_load_basic, METH_O, DOC_IMAGE_LOADBASIC},
-    {"load_extended", (PyCFunction)image_load_extended,
-     METH_VARARGS | METH_KEYWORDS, DOC_IMAGE_LOADEXTENDED},
-    {"load", (PyCFunction)image_load, METH_VARARGS | METH_KEYWORDS,
-     DOC_IMAGE_LOAD},
-    {"load_sized_svg", (PyCFunction)image_load_sized_svg,
-     METH_VARARGS | METH_KEYWORDS, DOC_IMAGE_LOADSIZEDSVG},
+static Uint32
+_qoi_get_be32(const Uint8 *p)
+{
+    Uint32 v;
 
-    {"save_extended", (PyCFunction)image_save_extended,
-     METH_VARARGS | METH_KEYWORDS, DOC_IMAGE_SAVEEXTENDED},
-    {"save", (PyCFunction)image_save, METH_VARARGS | METH_KEYWORDS,
-     DOC_IMAGE_SAVE},
-    {"get_extended", (PyCFunction)image_get_extended, METH_NOARGS,
-     DOC_IMAGE_GETEXTENDED},
-    {"get_sdl_image_version", (PyCFunction)image_get_sdl_image_version,
-     METH_VARARGS | METH_KEYWORDS, DOC_IMAGE_GETSDLIMAGEVERSION},
+    memcpy(&v, p, 4);
+    return SDL_SwapBE32(v);
+}
 
-    {"tostring", (PyCFunction)image_tostring, METH_VARARGS | METH_KEYWORDS,
-     DOC_IMAGE_TOSTRING},
-    {"tobytes", (PyCFunction)image_tobytes, METH_VARARGS | METH_KEYWORDS,
-     DOC_IMAGE_TOBYTES},
-    {"fromstring", (PyCFunction)image_fromstring, METH_VARARGS | METH_KEYWORDS,
-     DOC_IMAGE_FROMSTRING},
-    {"frombytes", (PyCFunction)image_frombytes, METH_VARARGS | METH_KEYWORDS,
-     DOC_IMAGE_FROMBYTES},
-    {"frombuffer", (PyCFunction)image_frombuffer, METH_VARARGS | METH_KEYWORDS,
-     DOC_IMAGE_FROMBUFFER},
-    {NULL, NULL, 0, NULL}};
+#define QOI_EQUAL(p, q) \
+    ((p).r == (q).r && (p).g == (q).g && (p).b == (q).b && (p).a == (q).a)
 
-MODINIT_DEFINE(image)
+/* Encode a surface to a malloc'd QOI image. Surfaces with 8 bits per
+ * channel in 32 bit pixels are read in place, others are converted first.
+ * Returns NULL with the SDL error set on failure.
+ */
+static Uint8 *
+_qoi_encode(SDL_Surface *surf, size_t *len)
 {
-    PyObject *module;
-    PyObject *extmodule;
-
-    static struct PyModuleDef _module = {PyModuleDef_HEAD_INIT,
-                                         "image",
-                                         DOC_IMAGE,
-                                         -1,
-                                         _image_methods,
-                                         NULL,
-                                         NULL,
-                                         NULL,
-                                         NULL};
+    SDL_Surface *conv = NULL;
+    SDL_PixelFormat *fmt = surf->format;
+    pgQoiPixel index[64], px, prev = {0, 0, 0, 255}, key = {0, 0, 0, 0};
+    Uint8 *out, *op;
+    const Uint32 *row;
+    Uint32 pixel, pos, colorkey;
+    int has_colorkey, channels, locked = 0, run = 0, x, y;
+    int vr, vg, vb, vg_r, vg_b;
+
+    /* a colorkey is written as transparency, matched by color so that it
+     * survives the conversion below */
+    if ((has_colorkey = SDL_HasColorKey(surf))) {
+        SDL_GetColorKey(surf, &colorkey);
+        SDL_GetRGB(colorkey, fmt, &key.r, &key.g, &key.b);
+    }
+    channels = fmt->Amask || has_colorkey ? 4 : 3;
+    if (PG_SURF_BytesPerPixel(surf) != 4 || fmt->Rloss || fmt->Gloss ||
+        fmt->Bloss || (fmt->Amask && fmt->Aloss)) {
+        conv = PG_ConvertSurfaceFormat(surf, SDL_PIXELFORMAT_RGBA32);
+        if (!conv) {
+            return NULL;
+        }
+        surf = conv;
+        fmt = surf->format;
+    }
 
-    /* imported needed apis; Do this first so if there is an error
-       the module is not loaded.
-    */
-    import_pygame_base();
-    if (PyErr_Occurred()) {
+    out = (Uint8 *)malloc(QOI_HEADER_SIZE +
+                          (size_t)surf->w * surf->h * (channels + 1) +
+                          QOI_PADDING_SIZE);
+    if (!out) {
+        SDL_FreeSurface(conv);
+        SDL_OutOfMemory();
         return NULL;
     }
-    import_pygame_surface();
-    if (PyErr_Occurred()) {
+    if (SDL_MUSTLOCK(surf)) {
+        SDL_LockSurface(surf);
+        locked = 1;
+    }
+
+    memcpy(out, "qoif", 4);
+    _qoi_put_be32(out + 4, (Uint32)surf->w);
+    _qoi_put_be32(out + 8, (Uint32)surf->h);
+    out[12] = (Uint8)channels;
+    out[13] = 0; /* sRGB with linear alpha */
+    op = out + QOI_HEADER_SIZE;
+    memset(index, 0, sizeof(index));
+
+    for (y = 0; y < surf->h; ++y) {
+        row = (const Uint32 *)((const Uint8 *)surf->pixels +
+                               (size_t)y * surf->pitch);
+        for (x = 0; x < surf->w; ++x) {
+            pixel = row[x];
+            px.r = (Uint8)((pixel & fmt->Rmask) >> fmt->Rshift);
+            px.g = (Uint8)((pixel & fmt->Gmask) >> fmt->Gshift);
+            px.b = (Uint8)((pixel & fmt->Bmask) >> fmt->Bshift);
+            px.a = fmt->Amask ? (Uint8)((pixel & fmt->Amask) >> fmt->Ashift)
+                              : 255;
+            if (has_colorkey && px.r == key.r && px.g == key.g &&
+                px.b == key.b) {
+                px.a = 0;
+            }
+
+            if (QOI_EQUAL(px, prev)) {
+                if (++run == 62) {
+                    *op++ = QOI_OP_RUN | (run - 1);
+                    run = 0;
+                }
+                continue;
+            }
+            if (run) {
+                *op++ = QOI_OP_RUN | (run - 1);
+                run = 0;
+            }
+
+            pos = QOI_HASH(px);
+            if (QOI_EQUAL(index[pos], px)) {
+                *op++ = QOI_OP_INDEX | (Uint8)pos;
+            }
+            else {
+                index[pos] = px;
+                if (px.a == prev.a) {
+                    vr = (Sint8)(px.r - prev.r);
+                    vg = (Sint8)(px.g - prev.g);
+                    vb = (Sint8)(px.b - prev.b);
+                    vg_r = vr - vg;
+                    vg_b = vb - vg;
+                    if (vr > -3 && vr < 2 && vg > -3 && vg < 2 && vb > -3 &&
+                        vb < 2) {
+                        *op++ = QOI_OP_DIFF | (vr + 2) << 4 | (vg + 2) << 2 |
+                                (vb + 2);
+                    }
+                    else if (vg_r > -9 && vg_r < 8 && vg > -33 && vg < 32 &&
+                             vg_b > -9 && vg_b < 8) {
+                        *op++ = QOI_OP_LUMA | (vg + 32);
+                        *op++ = (vg_r + 8) << 4 | (vg_b + 8);
+                    }
+                    else {
+                        *op++ = QOI_OP_RGB;
+                        *op++ = px.r;
+                        *op++ = px.g;
+                        *op++ = px.b;
+                    }
+                }
+                else {
+                    *op++ = QOI_OP_RGBA;
+                    *op++ = px.r;
+                    *op++ = px.g;
+                    *op++ = px.b;
+                    *op++ = px.a;
+                }
+            }
+            prev = px;
+        }
+    }
+    if (run) {
+        *op++ = QOI_OP_RUN | (run - 1);
+    }
+    memcpy(op, qoi_padding, QOI_PADDING_SIZE);
+    op += QOI_PADDING_SIZE;
+
+    if (locked) {
+        SDL_UnlockSurface(surf);
+    }
+    SDL_FreeSurface(conv);
+    *len = op - out;
+    return out;
+}
+
+/* Decode a QOI image held in memory into a new RGB24 or RGBA32 surface.
+ * Returns NULL with the SDL error set on failure.
+ */
+static SDL_Surface *
+_qoi_decode(const Uint8 *data, size_t size)
+{
+    SDL_Surface *surf;
+    pgQoiPixel index[64], px = {0, 0, 0, 255};
+    const Uint8 *p, *end;
+    Uint8 *dst, b1, b2;
+    Uint32 width, height;
+    int channels, run = 0, x, y, vg;
+
+    if (size < QOI_HEADER_SIZE + QOI_PADDING_SIZE ||
+        memcmp(data, "qoif", 4)) {
+        SDL_SetError("not a QOI image");
         return NULL;
     }
-    import_pygame_rwobject();
-    if (PyErr_Occurred()) {
+    width = _qoi_get_be32(data + 4);
+    height = _qoi_get_be32(data + 8);
+    channels = data[12];
+    if (!width || !height || width > INT_MAX || height > INT_MAX ||
+        (Uint64)width * height > QOI_PIXELS_MAX || channels < 3 ||
+        channels > 4 || data[13] > 1) {
+        SDL_SetError("corrupt QOI header");
         return NULL;
     }
-
-    /* create the module */
-    module = PyModule_Create(&_module);
-    if (module == NULL) {
+    surf = PG_CreateSurface((int)width, (int)height,
+                            channels == 4 ? SDL_PIXELFORMAT_RGBA32
+                                          : SDL_PIXELFORMAT_RGB24);
+    if (!surf) {
         return NULL;
     }
 
-    /* try to get extended formats */
-    extmodule = PyImport_ImportModule(IMPPREFIX "imageext");
-    if (extmodule) {
-        extloadobj = PyObject_GetAttrString(extmodule, "load_extended");
-        if (!extloadobj) {
-            goto error;
+    memset(index, 0, sizeof(index));
+    p = data + QOI_HEADER_SIZE;
+    end = data + size - QOI_PADDING_SIZE;
+    for (y = 0; y < surf->h; ++y) {
+        dst = (Uint8 *)surf->pixels + (size_t)y * surf->pitch;
+        for (x = 0; x < surf->w; ++x) {
+            if (run) {
+                run--;
+            }
+            else {
+                if (p >= end) {
+                    goto truncated;
+                }
+                b1 = *p++;
+                if (b1 == QOI_OP_RGB) {
+                    if (end - p < 3) {
+                        goto truncated;
+                    }
+                    px.r = p[0];
+                    px.g = p[1];
+                    px.b = p[2];
+                    p += 3;
+                }
+                else if (b1 == QOI_OP_RGBA) {
+                    if (end - p < 4) {
+                        goto truncated;
+                    }
+                    px.r = p[0];
+                    px.g = p[1];
+                    px.b = p[2];
+                    px.a = p[3];
+                    p += 4;
+                }
+                else {
+                    switch (b1 & QOI_MASK_2) {
+                        case QOI_OP_INDEX:
+                            px = index[b1];
+                            break;
+                        case QOI_OP_DIFF:
+                            px.r += ((b1 >> 4) & 0x03) - 2;
+                            px.g += ((b1 >> 2) & 0x03) - 2;
+                            px.b += (b1 & 0x03) - 2;
+                            break;
+                        case QOI_OP_LUMA:
+                            if (p >= end) {
+                                goto truncated;
+                            }
+                            b2 = *p++;
+                            vg = (b1 & 0x3f) - 32;
+                            px.r += vg - 8 + ((b2 >> 4) & 0x0f);
+                            px.g += vg;
+                            px.b += vg - 8 + (b2 & 0x0f);
+                            break;
+                        default: /* QOI_OP_RUN */
+                            run = b1 & 0x3f;
+                            break;
+                    }
+                }
+                index[QOI_HASH(px)] = px;
+            }
+            *dst++ = px.r;
+            *dst++ = px.g;
+            *dst++ = px.b;
+            if (channels == 4) {
+                *dst++ = px.a;
+            }
         }
-        extsaveobj = PyObject_GetAttrString(extmodule, "save_extended");
-        if (!extsaveobj) {
-            goto error;
+    }
+    return surf;
+
+truncated:
+    SDL_FreeSurface(surf);
+    SDL_SetError("truncated QOI image");
+    return NULL;
+}
+
+static SDL_Surface *
+LoadQOI_RW(SDL_RWops *src, int freesrc)
+{
+    SDL_Surface *surf = NULL;
+    Sint64 hint = SDL_RWsize(src);
+    /* one spare byte so a file of known size is read without regrowing */
+    size_t cap = hint > 0 ? (size_t)hint + 1 : 65536, size = 0, n;
+    Uint8 *data = (Uint8 *)malloc(cap), *grown;
+
+    while (data) {
+        if (size == cap) {
+            grown = (Uint8 *)realloc(data, cap * 2);
+            if (!grown) {
+                free(data);
+                data = NULL;
+                break;
+            }
+            data = grown;
+            cap *= 2;
         }
-        extverobj =
-            PyObject_GetAttrString(extmodule, "_get_sdl_image_version");
-        if (!extverobj) {
-            goto error;
+        n = SDL_RWread(src, data + size, 1, cap - size);
+        if (!n) {
+            break;
         }
-        ext_load_sized_svg =
-            PyObject_GetAttrString(extmodule, "_load_sized_svg");
-        if (!ext_load_sized_svg) {
+        size += n;
+    }
+    if (data) {
+        surf = _qoi_decode(data, size);
+        free(data);
+    }
+    else {
+        SDL_OutOfMemory();
+    }
+    if (freesrc) {
+        SDL_RWclose(src);
+    }
+    return surf;
+}
+
+/* Returns -1 upon error, 0 if success */
+static int
+SaveQOI_RW(SDL_Surface *surface, SDL_RWops *out)
+{
+    size_t len;
+    Uint8 *data = _qoi_encode(surface, &len);
+    int ret;
+
+    if (!data) {
+        return -1;
+    }
+    ret = SDL_RWwrite(out, data, len, 1) == 1 ? 0 : -1;
+    free(data);
+    return ret;
+}
+
+static int
+SaveQOI(SDL_Surface *surface, const char *file)
+{
+    SDL_RWops *out = SDL_RWFromFile(file, "wb");
+    int ret;
+    if (!out)
+        return -1;
+    ret = SaveQOI_RW(surface, out);
+    if (SDL_RWclose(out) < 0)
+        ret = -1;
+    return ret;
+}
+
+/*
+ * Native surface cache: image.save_raw / image.load_raw
+ *
+ * A small header (see RAW_HEADER_SIZE) holding the pixel format, pitch,
+ * colorkey, alpha and blend mode, then an optional palette and the pixel
+ * rows exactly as they sit in memory. The rows may be compressed in the
+ * LZ4 block format, implemented here since it is all we need of LZ4.
+ */
+#define RAW_MAGIC "PGRW"
+#define RAW_VERSION 1
+#define RAW_HEADER_SIZE 64
+#define RAW_FLAG_LZ4 0x1
+#define RAW_FLAG_COLORKEY 0x2
+
+#define LZ4_HASH_LOG 14
+#define LZ4_MIN_MATCH 4
+#define LZ4_LAST_LITERALS 5 /* the block must end with this many literals */
+#define LZ4_MF_LIMIT 12     /* no match may start closer to the end */
+#define LZ4_MAX_OFFSET 65535
+
+static size_t
+_lz4_bound(size_t size)
+{
+    return size + size / 255 + 16;
+}
+
+static Uint32
+_lz4_read32(const Uint8 *p)
+{
+    Uint32 v;
+
+    memcpy(&v, p, 4);
+    return v;
+}
+
+static Uint8 *
+_lz4_put_length(Uint8 *op, size_t len)
+{
+    for (; len >= 255; len -= 255) {
+        *op++ = 255;
+    }
+    *op++ = (Uint8)len;
+    return op;
+}
+
+/* Greedy single-probe compressor. dst must hold _lz4_bound(size) bytes and
+ * table (1 << LZ4_HASH_LOG entries) must be zeroed. Returns the block size.
+ */
+static size_t
+_lz4_compress(const Uint8 *src, size_t size, Uint8 *dst, Uint32 *table)
+{
+    const Uint8 *ip = src, *anchor = src, *ref, *end = src + size;
+    const Uint8 *match_limit = end - LZ4_LAST_LITERALS;
+    Uint8 *op = dst, *token;
+    Uint32 seq, h;
+    size_t lit, len;
+
+    if (size > LZ4_MF_LIMIT) {
+        for (ip = src + 1; ip <= end - LZ4_MF_LIMIT;) {
+            seq = _lz4_read32(ip);
+            h = (seq * 2654435761U) >> (32 - LZ4_HASH_LOG);
+            ref = src + table[h];
+            table[h] = (Uint32)(ip - src);
+            if (ip - ref > LZ4_MAX_OFFSET || _lz4_read32(ref) != seq) {
+                ip++;
+                continue;
+            }
+
+            lit = ip - anchor;
+            token = op++;
+            if (lit >= 15) {
+                *token = 15 << 4;
+                op = _lz4_put_length(op, lit - 15);
+            }
+            else {
+                *token = (Uint8)(lit << 4);
+            }
+            memcpy(op, anchor, lit);
+            op += lit;
+            *op++ = (Uint8)((ip - ref) & 0xff);
+            *op++ = (Uint8)((ip - ref) >> 8);
+
+            ip += LZ4_MIN_MATCH;
+            ref += LZ4_MIN_MATCH;
+            while (ip < match_limit && *ip == *ref) {
+                ip++;
+                ref++;
+            }
+            len = ip - anchor - lit - LZ4_MIN_MATCH;
+            if (len >= 15) {
+                *token |= 15;
+                op = _lz4_put_length(op, len - 15);
+            }
+            else {
+                *token |= (Uint8)len;
+            }
+            anchor = ip;
+        }
+    }
+
+    lit = end - anchor;
+    token = op++;
+    if (lit >= 15) {
+        *token = 15 << 4;
+        op = _lz4_put_length(op, lit - 15);
+    }
+    else {
+        *token = (Uint8)(lit << 4);
+    }
+    memcpy(op, anchor, lit);
+    op += lit;
+    return op - dst;
+}
+
+static int
+_lz4_get_length(const Uint8 **ip, const Uint8 *end, size_t *len)
+{
+    Uint8 b;
+
+    do {
+        if (*ip >= end) {
+            return -1;
+        }
+        b = *(*ip)++;
+        *len += b;
+    } while (b == 255);
+    return 0;
+}
+
+/* Decode a whole block into exactly dst_size bytes. Returns -1 on
+ * malformed or truncated input, never reading or writing out of bounds.
+ */
+static int
+_lz4_decompress(const Uint8 *src, size_t size, Uint8 *dst, size_t dst_size)
+{
+    const Uint8 *ip = src, *end = src + size, *ref;
+    Uint8 *op = dst, *dst_end = dst + dst_size;
+    size_t len, offset;
+    Uint8 token;
+
+    for (;;) {
+        if (ip >= end) {
+            return -1;
+        }
+        token = *ip++;
+        len = token >> 4;
+        if (len == 15 && _lz4_get_length(&ip, end, &len)) {
+            return -1;
+        }
+        if (len > (size_t)(end - ip) || len > (size_t)(dst_end - op)) {
+            return -1;
+        }
+        memcpy(op, ip, len);
+        op += len;
+        ip += len;
+        if (ip == end) {
+            break; /* the last sequence has no match */
+        }
+
+        if (end - ip < 2) {
+            return -1;
+        }
+        offset = ip[0] | (ip[1] << 8);
+        ip += 2;
+        if (!offset || offset > (size_t)(op - dst)) {
+            return -1;
+        }
+        len = token & 15;
+        if (len == 15 && _lz4_get_length(&ip, end, &len)) {
+            return -1;
+        }
+        len += LZ4_MIN_MATCH;
+        if (len > (size_t)(dst_end - op)) {
+            return -1;
+        }
+        ref = op - offset;
+        if (offset >= len) {
+            memcpy(op, ref, len);
+            op += len;
+        }
+        else {
+            while (len--) { /* overlapping copy repeats the pattern */
+                *op++ = *ref++;
+            }
+        }
+    }
+    return op == dst_end ? 0 : -1;
+}
+
+/* Rows are stored packed to 4 bytes, as SDL lays out a new surface */
+static Uint32
+_raw_pitch(SDL_Surface *surf, Uint32 *row_bytes)
+{
+    Uint32 bits = PG_SURF_BitsPerPixel(surf);
+
+    *row_bytes = bits < 8 ? ((Uint32)surf->w * bits + 7) / 8
+                          : (Uint32)surf->w * PG_SURF_BytesPerPixel(surf);
+    return (*row_bytes + 3) & ~3u;
+}
+
+static void
+_raw_put32(Uint8 *p, Uint32 v)
+{
+    v = SDL_SwapLE32(v);
+    memcpy(p, &v, 4);
+}
+
+static Uint32
+_raw_get32(const Uint8 *p)
+{
+    Uint32 v;
+
+    memcpy(&v, p, 4);
+    return SDL_SwapLE32(v);
+}
+
+/* Reads a surface saved by image.save_raw and closes rw. Needs no GIL
+ * unless rw wraps a Python file object. Returns NULL with the SDL error
+ * set on failure.
+ */
+static SDL_Surface *
+_raw_load_rw(SDL_RWops *rw)
+{
+    SDL_Surface *surf = NULL;
+    SDL_Palette *palette;
+    SDL_Color colors[256];
+    Uint8 header[RAW_HEADER_SIZE], rgba[256 * 4];
+    Uint8 *packed = NULL, *rows = NULL, *dst;
+    Uint32 width, height, pitch, format, flags, ncolors, row_bytes, i;
+    Uint64 payload_size;
+    size_t raw_size;
+    int y, ok = 0;
+
+    if (SDL_RWread(rw, header, RAW_HEADER_SIZE, 1) != 1 ||
+        memcmp(header, RAW_MAGIC, 4)) {
+        SDL_SetError("not a pygame raw surface file");
+        goto end;
+    }
+    if (_raw_get32(header + 4) != RAW_VERSION) {
+        SDL_SetError("unsupported raw surface version %u",
+                     (unsigned)_raw_get32(header + 4));
+        goto end;
+    }
+    width = _raw_get32(header + 8);
+    height = _raw_get32(header + 12);
+    pitch = _raw_get32(header + 16);
+    format = _raw_get32(header + 20);
+    flags = _raw_get32(header + 24);
+    ncolors = _raw_get32(header + 40);
+    payload_size = _raw_get32(header + 44) |
+                   ((Uint64)_raw_get32(header + 48) << 32);
+    if (width > INT_MAX || height > INT_MAX || ncolors > 256 ||
+        SDL_ISPIXELFORMAT_FOURCC(format)) {
+        SDL_SetError("corrupt raw surface header");
+        goto end;
+    }
+
+    surf = PG_CreateSurface((int)width, (int)height, format);
+    if (!surf) {
+        goto end;
+    }
+    raw_size = (size_t)pitch * height;
+    if (_raw_pitch(surf, &row_bytes) != pitch ||
+        ((flags & RAW_FLAG_LZ4)
+             ? payload_size > (Uint64)_lz4_bound(raw_size)
+             : payload_size != (Uint64)raw_size)) {
+        SDL_SetError("corrupt raw surface header");
+        goto end;
+    }
+
+    palette = surf->format->palette;
+    if (ncolors) {
+        if (!palette || ncolors > (Uint32)palette->ncolors) {
+            SDL_SetError("corrupt raw surface header");
+            goto end;
+        }
+        if (SDL_RWread(rw, rgba, 4, ncolors) != ncolors) {
+            SDL_SetError("truncated raw surface file");
+            goto end;
+        }
+        for (i = 0; i < ncolors; ++i) {
+            colors[i].r = rgba[i * 4];
+            colors[i].g = rgba[i * 4 + 1];
+            colors[i].b = rgba[i * 4 + 2];
+            colors[i].a = rgba[i * 4 + 3];
+        }
+        SDL_SetPaletteColors(palette, colors, 0, (int)ncolors);
+    }
+
+    if (surf->pitch == (int)pitch) {
+        dst = (Uint8 *)surf->pixels;
+    }
+    else if (!(dst = rows = (Uint8 *)malloc(raw_size ? raw_size : 1))) {
+        SDL_OutOfMemory();
+        goto end;
+    }
+    if (flags & RAW_FLAG_LZ4) {
+        packed = (Uint8 *)malloc(payload_size ? (size_t)payload_size : 1);
+        if (!packed) {
+            SDL_OutOfMemory();
+            goto end;
+        }
+        if (SDL_RWread(rw, packed, 1, (size_t)payload_size) !=
+                (size_t)payload_size ||
+            _lz4_decompress(packed, (size_t)payload_size, dst, raw_size)) {
+            SDL_SetError("corrupt raw surface data");
+            goto end;
+        }
+    }
+    else if (raw_size && SDL_RWread(rw, dst, raw_size, 1) != 1) {
+        SDL_SetError("truncated raw surface file");
+        goto end;
+    }
+    if (rows) {
+        for (y = 0; y < surf->h; ++y) {
+            memcpy((Uint8 *)surf->pixels + (size_t)y * surf->pitch,
+                   rows + (size_t)y * pitch, row_bytes);
+        }
+    }
+
+    if (flags & RAW_FLAG_COLORKEY) {
+        SDL_SetColorKey(surf, SDL_TRUE, _raw_get32(header + 28));
+    }
+    SDL_SetSurfaceAlphaMod(surf, header[32]);
+    SDL_SetSurfaceBlendMode(surf, (SDL_BlendMode)_raw_get32(header + 36));
+    ok = 1;
+
+end:
+    free(packed);
+    free(rows);
+    SDL_RWclose(rw);
+    if (!ok) {
+        SDL_FreeSurface(surf);
+        return NULL;
+    }
+    return surf;
+}
+
+static PyObject *
+image_load_raw(PyObject *self, PyObject *obj)
+{
+    SDL_Surface *surf;
+    SDL_RWops *rw = pgRWops_FromObject(obj, NULL);
+
+    if (rw == NULL) {
+        return NULL;
+    }
+    Py_BEGIN_ALLOW_THREADS;
+    surf = _raw_load_rw(rw);
+    Py_END_ALLOW_THREADS;
+
+    if (surf == NULL) {
+        return RAISE(pgExc_SDLError, SDL_GetError());
+    }
+    return (PyObject *)pgSurface_New(surf);
+}
+
+static PyObject *
+image_save_raw(PyObject *self, PyObject *arg, PyObject *kwarg)
+{
+    pgSurfaceObject *surfobj;
+    PyObject *obj, *oencoded, *ret = NULL;
+    const char *compress = "lz4";
+    SDL_Surface *surf;
+    SDL_Palette *palette;
+    SDL_RWops *rw;
+    SDL_BlendMode blend;
+    Uint8 *out, *payload, *rows = NULL;
+    Uint32 *table = NULL;
+    Uint32 flags = 0, colorkey = 0, ncolors = 0, pitch, row_bytes;
+    Uint8 alpha;
+    size_t raw_size, offset, size;
+    int i, y, result = 0;
+    static char *kwds[] = {"surface", "file", "compress", NULL};
+
+    if (!PyArg_ParseTupleAndKeywords(arg, kwarg, "O!O|z", kwds,
+                                     &pgSurface_Type, &surfobj, &obj,
+                                     &compress)) {
+        return NULL;
+    }
+    if (compress && strcmp(compress, "lz4")) {
+        return RAISE(PyExc_ValueError, "compress must be 'lz4' or None");
+    }
+    surf = pgSurface_AsSurface(surfobj);
+    SURF_INIT_CHECK(surf)
+
+    pitch = _raw_pitch(surf, &row_bytes);
+    raw_size = (size_t)pitch * surf->h;
+    palette = surf->format->palette;
+    if (palette) {
+        ncolors = (Uint32)palette->ncolors;
+    }
+    offset = RAW_HEADER_SIZE + (size_t)ncolors * 4;
+
+    out = (Uint8 *)calloc(1, offset + (compress ? _lz4_bound(raw_size)
+                                                : raw_size));
+    if (compress) {
+        table = (Uint32 *)calloc((size_t)1 << LZ4_HASH_LOG, sizeof(Uint32));
+    }
+    if (surf->pitch != (int)pitch) {
+        /* a subsurface shares its parent's pitch */
+        rows = (Uint8 *)malloc(raw_size ? raw_size : 1);
+    }
+    if (!out || (compress && !table) || (surf->pitch != (int)pitch && !rows)) {
+        free(out);
+        free(table);
+        free(rows);
+        return PyErr_NoMemory();
+    }
+
+    if (SDL_HasColorKey(surf)) {
+        flags |= RAW_FLAG_COLORKEY;
+        SDL_GetColorKey(surf, &colorkey);
+    }
+    SDL_GetSurfaceAlphaMod(surf, &alpha);
+    SDL_GetSurfaceBlendMode(surf, &blend);
+    for (i = 0; i < (int)ncolors; ++i) {
+        out[RAW_HEADER_SIZE + i * 4] = palette->colors[i].r;
+        out[RAW_HEADER_SIZE + i * 4 + 1] = palette->colors[i].g;
+        out[RAW_HEADER_SIZE + i * 4 + 2] = palette->colors[i].b;
+        out[RAW_HEADER_SIZE + i * 4 + 3] = palette->colors[i].a;
+    }
+
+    pgSurface_Lock(surfobj);
+    Py_BEGIN_ALLOW_THREADS;
+    payload = (Uint8 *)surf->pixels;
+    if (rows) {
+        memset(rows, 0, raw_size);
+        for (y = 0; y < surf->h; ++y) {
+            memcpy(rows + (size_t)y * pitch,
+                   (Uint8 *)surf->pixels + (size_t)y * surf->pitch,
+                   row_bytes);
+        }
+        payload = rows;
+    }
+    size = compress && raw_size
+               ? _lz4_compress(payload, raw_size, out + offset, table)
+               : raw_size;
+    if (size >= raw_size) {
+        /* incompressible, or not asked to: store the rows as they are */
+        size = raw_size;
+        if (raw_size) {
+            memcpy(out + offset, payload, raw_size);
+        }
+    }
+    else {
+        flags |= RAW_FLAG_LZ4;
+    }
+    Py_END_ALLOW_THREADS;
+    pgSurface_Unlock(surfobj);
+
+    memcpy(out, RAW_MAGIC, 4);
+    _raw_put32(out + 4, RAW_VERSION);
+    _raw_put32(out + 8, (Uint32)surf->w);
+    _raw_put32(out + 12, (Uint32)surf->h);
+    _raw_put32(out + 16, pitch);
+    _raw_put32(out + 20, surf->format->format);
+    _raw_put32(out + 24, flags);
+    _raw_put32(out + 28, colorkey);
+    _raw_put32(out + 32, alpha);
+    _raw_put32(out + 36, (Uint32)blend);
+    _raw_put32(out + 40, ncolors);
+    _raw_put32(out + 44, (Uint32)((Uint64)size & 0xffffffff));
+    _raw_put32(out + 48, (Uint32)((Uint64)size >> 32));
+    size += offset;
+
+    oencoded = pg_EncodeString(obj, "UTF-8", NULL, pgExc_SDLError);
+    if (oencoded == Py_None) {
+        ret = PyObject_CallMethod(obj, "write", "y#", (char *)out,
+                                  (Py_ssize_t)size);
+        result = ret ? 0 : -2;
+        Py_XDECREF(ret);
+    }
+    else if (oencoded) {
+        const char *name = PyBytes_AS_STRING(oencoded);
+
+        Py_BEGIN_ALLOW_THREADS;
+        rw = SDL_RWFromFile(name, "wb");
+        if (!rw) {
+            result = -1;
+        }
+        else {
+            result = SDL_RWwrite(rw, out, size, 1) == 1 ? 0 : -1;
+            if (SDL_RWclose(rw) < 0) {
+                result = -1;
+            }
+        }
+        Py_END_ALLOW_THREADS;
+    }
+    else {
+        result = -2;
+    }
+    Py_XDECREF(oencoded);
+    free(out);
+    free(table);
+    free(rows);
+
+    if (result == -2) {
+        return NULL;
+    }
+    if (result == -1) {
+        return RAISE(pgExc_SDLError, SDL_GetError());
+    }
+    Py_RETURN_NONE;
+}
+
+static PyObject *
+image_load_sized_svg(PyObject *self, PyObject *args, PyObject *kwargs)
+{
+    if (ext_load_sized_svg) {
+        return PyObject_Call(ext_load_sized_svg, args, kwargs);
+    }
+
+    return RAISE(PyExc_NotImplementedError,
+                 "Support for sized svg image loading was not compiled in.");
+}
+
+static PyObject *
+image_set_svg_cache_limit(PyObject *self, PyObject *arg)
+{
+    if (ext_set_svg_cache_limit) {
+        return PyObject_CallFunctionObjArgs(ext_set_svg_cache_limit, arg,
+                                            NULL);
+    }
+
+    return RAISE(PyExc_NotImplementedError,
+                 "Support for sized svg image loading was not compiled in.");
+}
+
+static PyObject *
+image_load_animation(PyObject *self, PyObject *args, PyObject *kwargs)
+{
+    if (ext_load_animation) {
+        return PyObject_Call(ext_load_animation, args, kwargs);
+    }
+
+    return RAISE(PyExc_NotImplementedError,
+                 "Support for animation loading was not compiled in.");
+}
+
+/* image.Recorder: capture() copies a surface into the next free frame of a
+ * ring, a worker thread writes the queued frames out in order. When the
+ * ring is full the new frame is dropped, so the caller never waits on the
+ * encoder. */
+#define RECORD_RAW 0
+#define RECORD_QOI 1
+#define RECORD_TGA 2
+
+typedef struct {
+    SDL_Surface *surf;
+    char *name; /* file of the frame when each frame gets its own file */
+} pgRecorderFrame;
+
+typedef struct {
+    PyObject_HEAD int format;
+    PyObject *pattern;  /* str path with a '%' for one file per frame */
+    SDL_RWops *rw;      /* the one stream all frames are written to */
+    pgRecorderFrame *frames;
+    int nframes;
+    int head;  /* the oldest queued frame, written by the worker */
+    int count; /* number of queued frames */
+    int quit;
+    char *error; /* first write error, no frames are written after it */
+    Sint64 captured, dropped;
+    SDL_mutex *lock;
+    SDL_cond *queued;
+    SDL_Thread *thread;
+} pgRecorderObject;
+
+/* Writes surf to rw as rows of pixels without padding. */
+static int
+_raw_frame_write(SDL_Surface *surf, SDL_RWops *rw)
+{
+    size_t row_bytes = (size_t)surf->w * PG_SURF_BytesPerPixel(surf);
+    Uint8 *row = (Uint8 *)surf->pixels;
+    int y;
+
+    if ((size_t)surf->pitch == row_bytes) {
+        return SDL_RWwrite(rw, row, row_bytes, surf->h) == (size_t)surf->h
+                   ? 0
+                   : -1;
+    }
+    for (y = 0; y < surf->h; ++y, row += surf->pitch) {
+        if (SDL_RWwrite(rw, row, row_bytes, 1) != 1) {
+            return -1;
+        }
+    }
+    return 0;
+}
+
+/* Returns -1 upon error, 0 if success */
+static int
+_recorder_write(pgRecorderObject *self, pgRecorderFrame *frame)
+{
+    SDL_RWops *rw = self->rw;
+    int ret;
+
+    if (frame->name && !(rw = SDL_RWFromFile(frame->name, "wb"))) {
+        return -1;
+    }
+    switch (self->format) {
+        case RECORD_QOI:
+            ret = SaveQOI_RW(frame->surf, rw);
+            break;
+        case RECORD_TGA:
+            ret = SaveTGA_RW(frame->surf, rw, 1);
+            break;
+        default:
+            ret = _raw_frame_write(frame->surf, rw);
+            break;
+    }
+    if (frame->name && SDL_RWclose(rw) < 0) {
+        ret = -1;
+    }
+    return ret;
+}
+
+static int SDLCALL
+_recorder_worker(void *data)
+{
+    pgRecorderObject *self = (pgRecorderObject *)data;
+    pgRecorderFrame *frame;
+    int skip, failed;
+
+    SDL_LockMutex(self->lock);
+    for (;;) {
+        while (!self->count && !self->quit) {
+            SDL_CondWait(self->queued, self->lock);
+        }
+        if (!self->count) {
+            break;
+        }
+        frame = self->frames + self->head;
+        skip = self->error != NULL;
+        SDL_UnlockMutex(self->lock);
+
+        failed = !skip && _recorder_write(self, frame) < 0;
+
+        SDL_LockMutex(self->lock);
+        if (failed) {
+            self->error = SDL_strdup(SDL_GetError());
+        }
+        self->head = (self->head + 1) % self->nframes;
+        --self->count;
+    }
+    SDL_UnlockMutex(self->lock);
+    return 0;
+}
+
+/* Stops the worker once the queued frames are written and closes the
+ * stream. Returns -1 with a Python error set if a frame failed to write. */
+static int
+_recorder_stop(pgRecorderObject *self)
+{
+    int ret = 0;
+
+    if (self->thread) {
+        SDL_LockMutex(self->lock);
+        self->quit = 1;
+        SDL_CondSignal(self->queued);
+        SDL_UnlockMutex(self->lock);
+        Py_BEGIN_ALLOW_THREADS;
+        SDL_WaitThread(self->thread, NULL);
+        Py_END_ALLOW_THREADS;
+        self->thread = NULL;
+    }
+    if (self->rw) {
+        if (SDL_RWclose(self->rw) < 0 && !self->error) {
+            self->error = SDL_strdup(SDL_GetError());
+        }
+        self->rw = NULL;
+    }
+    if (self->error) {
+        PyErr_SetString(pgExc_SDLError, self->error);
+        SDL_free(self->error);
+        self->error = NULL;
+        ret = -1;
+    }
+    return ret;
+}
+
+static void
+recorder_dealloc(pgRecorderObject *self)
+{
+    int i;
+
+    if (_recorder_stop(self) < 0) {
+        PyErr_WriteUnraisable((PyObject *)self);
+    }
+    if (self->frames) {
+        for (i = 0; i < self->nframes; ++i) {
+            SDL_FreeSurface(self->frames[i].surf);
+            free(self->frames[i].name);
+        }
+        PyMem_Free(self->frames);
+    }
+    if (self->queued) {
+        SDL_DestroyCond(self->queued);
+    }
+    if (self->lock) {
+        SDL_DestroyMutex(self->lock);
+    }
+    Py_XDECREF(self->pattern);
+    Py_TYPE(self)->tp_free((PyObject *)self);
+}
+
+/* Formats the pattern with the frame number into a malloc'd UTF-8 path. */
+static char *
+_recorder_frame_name(PyObject *pattern, Sint64 number)
+{
+    PyObject *args, *name;
+    const char *utf8;
+    char *ret = NULL;
+
+    if (!(args = Py_BuildValue("(L)", (long long)number))) {
+        return NULL;
+    }
+    name = PyUnicode_Format(pattern, args);
+    Py_DECREF(args);
+    if (!name) {
+        return NULL;
+    }
+    if (!PyUnicode_Check(name)) {
+        PyErr_SetString(PyExc_TypeError, "file pattern must give a str");
+    }
+    else if ((utf8 = PyUnicode_AsUTF8(name))) {
+        if ((ret = malloc(strlen(utf8) + 1))) {
+            strcpy(ret, utf8);
+        }
+        else {
+            PyErr_NoMemory();
+        }
+    }
+    Py_DECREF(name);
+    return ret;
+}
+
+/* A stream to the write method of the file object only, so closing the
+ * stream leaves the file object open for its owner. */
+static SDL_RWops *
+_recorder_stream(PyObject *file)
+{
+    PyObject *types, *namespace = NULL, *args, *kwargs = NULL;
+    SDL_RWops *rw = NULL;
+
+    if (!(args = PyObject_GetAttrString(file, "write"))) {
+        return NULL;
+    }
+    kwargs = Py_BuildValue("{sO}", "write", args);
+    Py_DECREF(args);
+    if (!kwargs) {
+        return NULL;
+    }
+    if ((types = PyImport_ImportModule("types"))) {
+        namespace = PyObject_GetAttrString(types, "SimpleNamespace");
+        Py_DECREF(types);
+    }
+    if (namespace && (args = PyTuple_New(0))) {
+        Py_SETREF(namespace, PyObject_Call(namespace, args, kwargs));
+        Py_DECREF(args);
+    }
+    else {
+        Py_CLEAR(namespace);
+    }
+    if (namespace) {
+        rw = pgRWops_FromFileObject(namespace);
+        Py_DECREF(namespace);
+    }
+    Py_DECREF(kwargs);
+    return rw;
+}
+
+static int
+recorder_init(pgRecorderObject *self, PyObject *args, PyObject *kwargs)
+{
+    PyObject *file, *path;
+    const char *format = NULL, *utf8 = NULL;
+    char *name;
+    int buffers = 4;
+    static char *kwids[] = {"file", "format", "buffers", NULL};
+
+    if (self->frames) {
+        PyErr_SetString(PyExc_RuntimeError,
+                        "Recorder can only be initialized once");
+        return -1;
+    }
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "O|zi", kwids, &file,
+                                     &format, &buffers)) {
+        return -1;
+    }
+    if (buffers < 1) {
+        PyErr_SetString(PyExc_ValueError, "buffers must be at least 1");
+        return -1;
+    }
+
+    /* a path, or else a file object */
+    if (!(path = PyOS_FSPath(file))) {
+        PyErr_Clear();
+    }
+    else {
+        if (PyBytes_Check(path)) {
+            Py_SETREF(path,
+                      PyUnicode_DecodeFSDefault(PyBytes_AS_STRING(path)));
+        }
+        if (!path || !(utf8 = PyUnicode_AsUTF8(path))) {
+            Py_XDECREF(path);
+            return -1;
+        }
+    }
+    if (!format) {
+        format = utf8 ? find_extension(utf8) : "raw";
+        if (strcasecmp(format, "qoi") && strcasecmp(format, "tga")) {
+            format = "raw";
+        }
+    }
+    if (!strcasecmp(format, "raw")) {
+        self->format = RECORD_RAW;
+    }
+    else if (!strcasecmp(format, "qoi")) {
+        self->format = RECORD_QOI;
+    }
+    else if (!strcasecmp(format, "tga")) {
+        self->format = RECORD_TGA;
+    }
+    else {
+        Py_XDECREF(path);
+        PyErr_Format(PyExc_ValueError, "Unsupported recording format '%s'",
+                     format);
+        return -1;
+    }
+
+    if (path && PyUnicode_FindChar(path, '%', 0, PyUnicode_GET_LENGTH(path),
+                                   1) >= 0) {
+        /* fail early on a bad pattern */
+        if (!(name = _recorder_frame_name(path, 0))) {
+            Py_DECREF(path);
+            return -1;
+        }
+        free(name);
+        self->pattern = path;
+    }
+    else if (path) {
+        self->rw = SDL_RWFromFile(utf8, "wb");
+        Py_DECREF(path);
+        if (!self->rw) {
+            PyErr_SetString(pgExc_SDLError, SDL_GetError());
+            return -1;
+        }
+    }
+    else if (!(self->rw = _recorder_stream(file))) {
+        return -1;
+    }
+
+    self->frames = PyMem_New(pgRecorderFrame, buffers);
+    if (!self->frames) {
+        PyErr_NoMemory();
+        return -1;
+    }
+    memset(self->frames, 0, sizeof(pgRecorderFrame) * buffers);
+    self->nframes = buffers;
+    if (!(self->lock = SDL_CreateMutex()) ||
+        !(self->queued = SDL_CreateCond()) ||
+        !(self->thread = SDL_CreateThread(_recorder_worker,
+                                          "pygame_image_recorder", self))) {
+        PyErr_SetString(pgExc_SDLError, SDL_GetError());
+        return -1;
+    }
+    return 0;
+}
+
+/* Copies surf into the frame, reallocating the frame surface when the size
+ * or the pixel format changed. */
+static int
+_recorder_copy(pgRecorderFrame *frame, SDL_Surface *surf)
+{
+    SDL_Surface *copy = frame->surf;
+    size_t row_bytes = (size_t)surf->w * PG_SURF_BytesPerPixel(surf);
+    int y;
+
+    if (copy && (copy->w != surf->w || copy->h != surf->h ||
+                 copy->format->format != surf->format->format)) {
+        SDL_FreeSurface(copy);
+        copy = frame->surf = NULL;
+    }
+    if (!copy && !(copy = frame->surf = PG_CreateSurface(
+                       surf->w, surf->h, surf->format->format))) {
+        return -1;
+    }
+    if (surf->format->palette &&
+        SDL_SetPaletteColors(copy->format->palette,
+                             surf->format->palette->colors, 0,
+                             surf->format->palette->ncolors)) {
+        return -1;
+    }
+    for (y = 0; y < surf->h; ++y) {
+        memcpy((Uint8 *)copy->pixels + (size_t)y * copy->pitch,
+               (Uint8 *)surf->pixels + (size_t)y * surf->pitch, row_bytes);
+    }
+    return 0;
+}
+
+static PyObject *
+recorder_capture(pgRecorderObject *self, PyObject *args, PyObject *kwargs)
+{
+    PyObject *surfobj = NULL;
+    SDL_Surface *surf;
+    pgRecorderFrame *frame;
+    char *name = NULL;
+    int full, ret;
+    static char *kwids[] = {"surface", NULL};
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "|O!", kwids,
+                                     &pgSurface_Type, &surfobj)) {
+        return NULL;
+    }
+    if (!self->thread) {
+        return RAISE(PyExc_ValueError, "capture on a closed Recorder");
+    }
+    if (!surfobj) {
+        surfobj = (PyObject *)pg_GetDefaultWindowSurface();
+        if (!surfobj) {
+            return RAISE(pgExc_SDLError, "No video mode has been set");
+        }
+    }
+    surf = pgSurface_AsSurface(surfobj);
+    SURF_INIT_CHECK(surf)
+
+    SDL_LockMutex(self->lock);
+    full = self->count == self->nframes;
+    frame = self->frames + (self->head + self->count) % self->nframes;
+    if (self->error) {
+        PyErr_SetString(pgExc_SDLError, self->error);
+    }
+    SDL_UnlockMutex(self->lock);
+    if (PyErr_Occurred()) {
+        return NULL;
+    }
+    if (full) {
+        ++self->dropped;
+        Py_RETURN_FALSE;
+    }
+
+    /* the worker doesn't touch the frame until it is counted below */
+    if (self->pattern) {
+        if (!(name = _recorder_frame_name(self->pattern, self->captured))) {
+            return NULL;
+        }
+        free(frame->name);
+        frame->name = name;
+    }
+    if (!pgSurface_Lock((pgSurfaceObject *)surfobj)) {
+        return NULL;
+    }
+    ret = _recorder_copy(frame, surf);
+    if (!pgSurface_Unlock((pgSurfaceObject *)surfobj)) {
+        return NULL;
+    }
+    if (ret < 0) {
+        return RAISE(pgExc_SDLError, SDL_GetError());
+    }
+
+    SDL_LockMutex(self->lock);
+    ++self->count;
+    SDL_CondSignal(self->queued);
+    SDL_UnlockMutex(self->lock);
+    ++self->captured;
+    Py_RETURN_TRUE;
+}
+
+static PyObject *
+recorder_close(pgRecorderObject *self, PyObject *_null)
+{
+    if (_recorder_stop(self) < 0) {
+        return NULL;
+    }
+    Py_RETURN_NONE;
+}
+
+static PyObject *
+recorder_enter(PyObject *self, PyObject *_null)
+{
+    Py_INCREF(self);
+    return self;
+}
+
+static PyObject *
+recorder_exit(pgRecorderObject *self, PyObject *args)
+{
+    return recorder_close(self, NULL);
+}
+
+static PyObject *
+recorder_get_captured(pgRecorderObject *self, void *closure)
+{
+    return PyLong_FromLongLong(self->captured);
+}
+
+static PyObject *
+recorder_get_dropped(pgRecorderObject *self, void *closure)
+{
+    return PyLong_FromLongLong(self->dropped);
+}
+
+static PyObject *
+recorder_get_pending(pgRecorderObject *self, void *closure)
+{
+    int count = 0;
+
+    if (self->lock) {
+        SDL_LockMutex(self->lock);
+        count = self->count;
+        SDL_UnlockMutex(self->lock);
+    }
+    return PyLong_FromLong(count);
+}
+
+static PyMethodDef recorder_methods[] = {
+    {"capture", (PyCFunction)recorder_capture, METH_VARARGS | METH_KEYWORDS,
+     DOC_IMAGE_RECORDER_CAPTURE},
+    {"close", (PyCFunction)recorder_close, METH_NOARGS,
+     DOC_IMAGE_RECORDER_CLOSE},
+    {"__enter__", (PyCFunction)recorder_enter, METH_NOARGS, NULL},
+    {"__exit__", (PyCFunction)recorder_exit, METH_VARARGS, NULL},
+    {NULL, NULL, 0, NULL}};
+
+static PyGetSetDef recorder_getsets[] = {
+    {"captured", (getter)recorder_get_captured, NULL,
+     DOC_IMAGE_RECORDER_CAPTURED, NULL},
+    {"dropped", (getter)recorder_get_dropped, NULL, DOC_IMAGE_RECORDER_DROPPED,
+     NULL},
+    {"pending", (getter)recorder_get_pending, NULL, DOC_IMAGE_RECORDER_PENDING,
+     NULL},
+    {NULL, NULL, NULL, NULL, NULL}};
+
+static PyTypeObject pgRecorder_Type = {
+    PyVarObject_HEAD_INIT(NULL, 0).tp_name = "pygame.image.Recorder",
+    .tp_basicsize = sizeof(pgRecorderObject),
+    .tp_dealloc = (destructor)recorder_dealloc,
+    .tp_flags = Py_TPFLAGS_DEFAULT,
+    .tp_doc = DOC_IMAGE_RECORDER,
+    .tp_methods = recorder_methods,
+    .tp_getset = recorder_getsets,
+    .tp_init = (initproc)recorder_init,
+    .tp_new = PyType_GenericNew,
+};
+
+static PyMethodDef _image_methods[] = {
+    {"load_basic", (PyCFunction)image_load_basic, METH_O, DOC_IMAGE_LOADBASIC},
+    {"load_extended", (PyCFunction)image_load_extended,
+     METH_VARARGS | METH_KEYWORDS, DOC_IMAGE_LOADEXTENDED},
+    {"load", (PyCFunction)image_load, METH_VARARGS | METH_KEYWORDS,
+     DOC_IMAGE_LOAD},
+    {"load_sized_svg", (PyCFunction)image_load_sized_svg,
+     METH_VARARGS | METH_KEYWORDS, DOC_IMAGE_LOADSIZEDSVG},
+    {"set_svg_cache_limit", (PyCFunction)image_set_svg_cache_limit, METH_O,
+     DOC_IMAGE_SETSVGCACHELIMIT},
+    {"load_animation", (PyCFunction)image_load_animation,
+     METH_VARARGS | METH_KEYWORDS, DOC_IMAGE_LOADANIMATION},
+    {"load_many", (PyCFunction)image_load_many, METH_VARARGS | METH_KEYWORDS,
+     DOC_IMAGE_LOADMANY},
+    {"load_async", (PyCFunction)image_load_async,
+     METH_VARARGS | METH_KEYWORDS, DOC_IMAGE_LOADASYNC},
+
+    {"save_extended", (PyCFunction)image_save_extended,
+     METH_VARARGS | METH_KEYWORDS, DOC_IMAGE_SAVEEXTENDED},
+    {"save", (PyCFunction)image_save, METH_VARARGS | METH_KEYWORDS,
+     DOC_IMAGE_SAVE},
+    {"save_async", (PyCFunction)image_save_async,
+     METH_VARARGS | METH_KEYWORDS, DOC_IMAGE_SAVEASYNC},
+    {"save_raw", (PyCFunction)image_save_raw, METH_VARARGS | METH_KEYWORDS,
+     DOC_IMAGE_SAVERAW},
+    {"load_raw", (PyCFunction)image_load_raw, METH_O, DOC_IMAGE_LOADRAW},
+    {"get_extended", (PyCFunction)image_get_extended, METH_NOARGS,
+     DOC_IMAGE_GETEXTENDED},
+    {"get_sdl_image_version", (PyCFunction)image_get_sdl_image_version,
+     METH_VARARGS | METH_KEYWORDS, DOC_IMAGE_GETSDLIMAGEVERSION},
+
+    {"tostring", (PyCFunction)image_tostring, METH_VARARGS | METH_KEYWORDS,
+     DOC_IMAGE_TOSTRING},
+    {"tobytes", (PyCFunction)image_tobytes, METH_VARARGS | METH_KEYWORDS,
+     DOC_IMAGE_TOBYTES},
+    {"fromstring", (PyCFunction)image_fromstring, METH_VARARGS | METH_KEYWORDS,
+     DOC_IMAGE_FROMSTRING},
+    {"frombytes", (PyCFunction)image_frombytes, METH_VARARGS | METH_KEYWORDS,
+     DOC_IMAGE_FROMBYTES},
+    {"frombuffer", (PyCFunction)image_frombuffer, METH_VARARGS | METH_KEYWORDS,
+     DOC_IMAGE_FROMBUFFER},
+    {NULL, NULL, 0, NULL}};
+
+/* The row kernels of tobytes() and frombytes() are picked on every call */
+static int
+_image_simd_dispatch(PyObject *dispatch)
+{
+    int has_avx2 = 0, has_sse2_neon = 0;
+
+#if !defined(__EMSCRIPTEN__)
+    has_avx2 = _pg_image_has_avx2();
+#if PG_ENABLE_SSE_NEON
+    has_sse2_neon = _pg_image_HasSSE_NEON();
+#endif /* PG_ENABLE_SSE_NEON */
+#endif /* __EMSCRIPTEN__ */
+    return pg_simd_report(dispatch, "image",
+                          pg_simd_backend_name(has_avx2, has_sse2_neon));
+}
+
+MODINIT_DEFINE(image)
+{
+    PyObject *module;
+    PyObject *extmodule;
+    PyObject *decodeobj;
+
+    static struct PyModuleDef _module = {PyModuleDef_HEAD_INIT,
+                                         "image",
+                                         DOC_IMAGE,
+                                         -1,
+                                         _image_methods,
+                                         NULL,
+                                         NULL,
+                                         NULL,
+                                         NULL};
+
+    /* imported needed apis; Do this first so if there is an error
+       the module is not loaded.
+    */
+    import_pygame_base();
+    if (PyErr_Occurred()) {
+        return NULL;
+    }
+    import_pygame_surface();
+    if (PyErr_Occurred()) {
+        return NULL;
+    }
+    import_pygame_rwobject();
+    if (PyErr_Occurred()) {
+        return NULL;
+    }
+
+    if (PyType_Ready(&pgRecorder_Type) < 0) {
+        return NULL;
+    }
+    pg_RegisterSIMDDispatch(_image_simd_dispatch);
+
+    /* create the module */
+    module = PyModule_Create(&_module);
+    if (module == NULL) {
+        return NULL;
+    }
+    if (PG_GIL_NOT_USED(module)) {
+        Py_DECREF(module);
+        return NULL;
+    }
+
+    Py_INCREF(&pgRecorder_Type);
+    if (PyModule_AddObject(module, "Recorder", (PyObject *)&pgRecorder_Type)) {
+        Py_DECREF(&pgRecorder_Type);
+        Py_DECREF(module);
+        return NULL;
+    }
+
+    /* try to get extended formats */
+    extmodule = PyImport_ImportModule(IMPPREFIX "imageext");
+    if (extmodule) {
+        extloadobj = PyObject_GetAttrString(extmodule, "load_extended");
+        if (!extloadobj) {
+            goto error;
+        }
+        extsaveobj = PyObject_GetAttrString(extmodule, "save_extended");
+        if (!extsaveobj) {
+            goto error;
+        }
+        extverobj =
+            PyObject_GetAttrString(extmodule, "_get_sdl_image_version");
+        if (!extverobj) {
+            goto error;
+        }
+        ext_load_sized_svg =
+            PyObject_GetAttrString(extmodule, "_load_sized_svg");
+        if (!ext_load_sized_svg) {
+            goto error;
+        }
+        ext_set_svg_cache_limit =
+            PyObject_GetAttrString(extmodule, "_set_svg_cache_limit");
+        if (!ext_set_svg_cache_limit) {
+            goto error;
+        }
+        ext_load_animation =
+            PyObject_GetAttrString(extmodule, "_load_animation");
+        if (!ext_load_animation) {
+            goto error;
+        }
+        decodeobj = PyObject_GetAttrString(extmodule, "_DECODE");
+        if (!decodeobj) {
+            goto error;
+        }
+        ext_decoder = (pgImageDecoder *)PyCapsule_GetPointer(
+            decodeobj, "pygame.imageext._DECODE");
+        Py_DECREF(decodeobj);
+        if (!ext_decoder) {
+            goto error;
+        }
+        decodeobj = PyObject_GetAttrString(extmodule, "_ENCODE");
+        if (!decodeobj) {
+            goto error;
+        }
+        ext_encoder = (pgImageEncoder *)PyCapsule_GetPointer(
+            decodeobj, "pygame.imageext._ENCODE");
+        Py_DECREF(decodeobj);
+        if (!ext_encoder) {
             goto error;
         }
         Py_DECREF(extmodule);
@@ -1890,6 +3901,8 @@ error:
     Py_XDECREF(extsaveobj);
     Py_XDECREF(extverobj);
     Py_XDECREF(ext_load_sized_svg);
+    Py_XDECREF(ext_load_animation);
+    Py_XDECREF(ext_set_svg_cache_limit);
     Py_DECREF(extmodule);
     Py_DECREF(module);
     return NULL;
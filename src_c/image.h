@@ -0,0 +1,26 @@
+#ifndef IMAGE_INTERNAL_H
+#define IMAGE_INTERNAL_H
+
+/* The quality of JPEG files when none is given */
+#define JPEG_QUALITY 85
+
+/* Decoder exported by imageext as the _DECODE capsule. decode() takes
+ * ownership of rw and is called without the GIL; when threadsafe is 0 it
+ * must not run on more than one thread at a time.
+ */
+typedef struct {
+    SDL_Surface *(*decode)(SDL_RWops *rw, const char *type);
+    int threadsafe;
+} pgImageDecoder;
+
+/* Encoder exported by imageext as the _ENCODE capsule, for the types
+ * "png", "jpg" and "jpeg". encode() leaves rw open, is called without the
+ * GIL and may run on several threads at once. It returns 0 on success and
+ * -1 with the SDL error set on failure.
+ */
+typedef struct {
+    int (*encode)(SDL_Surface *surf, SDL_RWops *rw, const char *type,
+                  int quality);
+} pgImageEncoder;
+
+#endif /* ~IMAGE_INTERNAL_H */
@@ -26,6 +26,7 @@
  *  the extended load and save functions, which are automatically used
  *  by the normal pygame.image module if it is available.
  */
+#define PG_SURFACE_ORIGIN PG_SURF_ORIGIN_IMAGE
 #include "pygame.h"
 
 /* Keep a stray macro from conflicting with python.h */
@@ -46,6 +47,8 @@
 
 #include "pgopengl.h"
 
+#include "image.h"
+
 #include <SDL_image.h>
 #ifdef WIN32
 #define strcasecmp _stricmp
@@ -54,8 +57,6 @@
 #endif
 #include <string.h>
 
-#define JPEG_QUALITY 85
-
 /*
 #ifdef WITH_THREAD
 static SDL_mutex *_pg_img_mutex = 0;
@@ -78,6 +79,30 @@ iext_find_extension(char *fullname)
     return dot + 1;
 }
 
+/* Decoder handed to image.load_many through the _DECODE capsule. It is
+ * called without the GIL, possibly from several threads at once. */
+static SDL_Surface *
+iext_decode(SDL_RWops *rw, const char *type)
+{
+    return IMG_LoadTyped_RW(rw, 1, type);
+}
+
+static pgImageDecoder iext_decoder = {iext_decode, 1};
+
+static int
+iext_encode(SDL_Surface *surf, SDL_RWops *rw, const char *type, int quality)
+{
+    if (!strcasecmp(type, "jpeg") || !strcasecmp(type, "jpg")) {
+        return IMG_SaveJPG_RW(surf, rw, 0, quality);
+    }
+    if (!strcasecmp(type, "png")) {
+        return IMG_SavePNG_RW(surf, rw, 0);
+    }
+    return SDL_SetError("Unrecognized image type");
+}
+
+static pgImageEncoder iext_encoder = {iext_encode};
+
 static PyObject *
 image_load_ext(PyObject *self, PyObject *arg, PyObject *kwarg)
 {
@@ -137,45 +162,393 @@ image_load_ext(PyObject *self, PyObject *arg, PyObject *kwarg)
     return final;
 }
 
+#if SDL_IMAGE_VERSION_ATLEAST(2, 6, 0)
+/* Rasterised SVGs by (path, width, height), least recently used first,
+ * while svg_cache_limit is above 0. Hits are returned as copies so the
+ * cached Surfaces stay as they were loaded. */
+static PyObject *svg_cache = NULL;
+static Py_ssize_t svg_cache_limit = 0;
+
+/* Returns a copy of the cached Surface for key, or NULL without an
+ * exception on a miss */
+static PyObject *
+iext_svg_cache_get(PyObject *key)
+{
+    PyObject *surfobj = NULL;
+
+    if (!svg_cache) {
+        return NULL;
+    }
+    Py_BEGIN_CRITICAL_SECTION(svg_cache);
+    surfobj = PyDict_GetItemWithError(svg_cache, key);
+    if (surfobj) {
+        /* move it to the end as the most recently used */
+        Py_INCREF(surfobj);
+        if (PyDict_DelItem(svg_cache, key) ||
+            PyDict_SetItem(svg_cache, key, surfobj)) {
+            Py_CLEAR(surfobj);
+        }
+    }
+    Py_END_CRITICAL_SECTION();
+    if (!surfobj) {
+        PyErr_Clear();
+        return NULL;
+    }
+    Py_SETREF(surfobj, PyObject_CallMethod(surfobj, "copy", NULL));
+    return surfobj;
+}
+
+/* Caches surfobj under key, dropping the least recently used entries over
+ * the limit. Returns -1 on error. */
+static int
+iext_svg_cache_put(PyObject *key, PyObject *surfobj)
+{
+    PyObject *oldest;
+    Py_ssize_t pos;
+    int result = 0;
+
+    if (!svg_cache) {
+        return 0;
+    }
+    Py_BEGIN_CRITICAL_SECTION(svg_cache);
+    result = PyDict_SetItem(svg_cache, key, surfobj);
+    while (!result && PyDict_GET_SIZE(svg_cache) > svg_cache_limit) {
+        pos = 0;
+        PyDict_Next(svg_cache, &pos, &oldest, NULL);
+        result = PyDict_DelItem(svg_cache, oldest);
+    }
+    Py_END_CRITICAL_SECTION();
+    return result;
+}
+#endif /* SDL_IMAGE_VERSION_ATLEAST(2, 6, 0) */
+
 static PyObject *
 imageext_load_sized_svg(PyObject *self, PyObject *arg, PyObject *kwargs)
 {
 #if SDL_IMAGE_VERSION_ATLEAST(2, 6, 0)
-    PyObject *obj, *size, *final;
-    SDL_Surface *surf;
-    SDL_RWops *rw = NULL;
-    int width, height;
+    PyObject *obj, *size, *seq = NULL, *path = NULL, *result = NULL;
+    PyObject *surfobj, **keys = NULL;
+    SDL_Surface **surfs = NULL;
+    SDL_RWops *rw = NULL, *mem;
+    void *data = NULL;
+    size_t datasize;
+    int *dims = NULL, single, width, height, loaded;
+    Py_ssize_t count, i, missing = 0;
     static char *kwds[] = {"file", "size", NULL};
 
     if (!PyArg_ParseTupleAndKeywords(arg, kwargs, "OO", kwds, &obj, &size)) {
         return NULL;
     }
 
-    if (!pg_TwoIntsFromObj(size, &width, &height)) {
-        return RAISE(PyExc_TypeError, "size must be two numbers");
+    /* size is a pair of numbers, or a sequence of them */
+    single = pg_TwoIntsFromObj(size, &width, &height);
+    PyErr_Clear();
+    count = 1;
+    if (!single) {
+        if (PyUnicode_Check(size) || PyBytes_Check(size) ||
+            !(seq = PySequence_Fast(size, "size must be two numbers"))) {
+            PyErr_Clear();
+            return RAISE(PyExc_TypeError, "size must be two numbers");
+        }
+        count = PySequence_Fast_GET_SIZE(seq);
+    }
+    dims = PyMem_New(int, 2 * count + 1);
+    keys = PyMem_Calloc(count + 1, sizeof(PyObject *));
+    surfs = PyMem_Calloc(count + 1, sizeof(SDL_Surface *));
+    result = PyList_New(count);
+    if (!dims || !keys || !surfs) {
+        PyErr_NoMemory();
+        goto error;
+    }
+    if (!result) {
+        goto end;
+    }
+    for (i = 0; i < count; i++) {
+        if (single) {
+            dims[0] = width;
+            dims[1] = height;
+        }
+        else if (!pg_TwoIntsFromObj(PySequence_Fast_GET_ITEM(seq, i),
+                                    &dims[2 * i], &dims[2 * i + 1])) {
+            PyErr_SetString(PyExc_TypeError, "size must be two numbers");
+            goto error;
+        }
+        if (dims[2 * i] <= 0 || dims[2 * i + 1] <= 0) {
+            PyErr_SetString(PyExc_ValueError,
+                            "both components of size must be positive");
+            goto error;
+        }
+    }
+
+    /* Surfaces already rasterised from the same path */
+    if (svg_cache) {
+        path = PyOS_FSPath(obj);
+        PyErr_Clear();
+    }
+    for (i = 0; i < count; i++) {
+        surfobj = NULL;
+        if (path) {
+            keys[i] = Py_BuildValue("(Oii)", path, dims[2 * i],
+                                    dims[2 * i + 1]);
+            if (!keys[i]) {
+                goto error;
+            }
+            surfobj = iext_svg_cache_get(keys[i]);
+        }
+        if (surfobj) {
+            PyList_SET_ITEM(result, i, surfobj);
+            dims[2 * i] = 0; /* nothing to rasterise */
+        }
+        else {
+            missing++;
+        }
     }
 
-    if (width <= 0 || height <= 0) {
-        return RAISE(PyExc_ValueError,
-                     "both components of size must be positive");
+    /* the file is read once and rasterised at every missing size */
+    if (missing) {
+        rw = pgRWops_FromObject(obj, NULL);
+        if (rw == NULL) {
+            goto error;
+        }
+        Py_BEGIN_ALLOW_THREADS;
+        data = SDL_LoadFile_RW(rw, &datasize, 1);
+        loaded = data != NULL;
+        for (i = 0; loaded && i < count; i++) {
+            if (!dims[2 * i]) {
+                continue;
+            }
+            mem = SDL_RWFromConstMem(data, (int)datasize);
+            surfs[i] = mem ? IMG_LoadSizedSVG_RW(mem, dims[2 * i],
+                                                 dims[2 * i + 1])
+                           : NULL;
+            if (mem) {
+                SDL_RWclose(mem);
+            }
+            if (!surfs[i]) {
+                break;
+            }
+        }
+        SDL_free(data);
+        Py_END_ALLOW_THREADS;
+        for (i = 0; i < count; i++) {
+            if (PyList_GET_ITEM(result, i)) {
+                continue;
+            }
+            if (!surfs[i]) {
+                PyErr_SetString(pgExc_SDLError,
+                                loaded ? IMG_GetError() : SDL_GetError());
+                goto error;
+            }
+            surfobj = (PyObject *)pgSurface_New(surfs[i]);
+            if (!surfobj) {
+                goto error;
+            }
+            surfs[i] = NULL;
+            if (keys[i]) {
+                if (iext_svg_cache_put(keys[i], surfobj)) {
+                    Py_DECREF(surfobj);
+                    goto error;
+                }
+                Py_SETREF(surfobj,
+                          PyObject_CallMethod(surfobj, "copy", NULL));
+                if (!surfobj) {
+                    goto error;
+                }
+            }
+            PyList_SET_ITEM(result, i, surfobj);
+        }
     }
+    if (single) {
+        surfobj = PyList_GET_ITEM(result, 0);
+        Py_INCREF(surfobj);
+        Py_SETREF(result, surfobj);
+    }
+    goto end;
+
+error:
+    Py_CLEAR(result);
+end:
+    for (i = 0; keys && surfs && i < count; i++) {
+        Py_XDECREF(keys[i]);
+        if (surfs[i]) {
+            SDL_FreeSurface(surfs[i]);
+        }
+    }
+    PyMem_Free(keys);
+    PyMem_Free(surfs);
+    PyMem_Free(dims);
+    Py_XDECREF(path);
+    Py_XDECREF(seq);
+    return result;
+#else  /* ~SDL_IMAGE_VERSION_ATLEAST(2, 6, 0) */
+    return RAISE(
+        pgExc_SDLError,
+        "pygame must be compiled with SDL_image 2.6.0+ to use this function");
+#endif /* ~SDL_IMAGE_VERSION_ATLEAST(2, 6, 0) */
+}
 
-    rw = pgRWops_FromObject(obj, NULL);
+static PyObject *
+imageext_set_svg_cache_limit(PyObject *self, PyObject *arg)
+{
+#if SDL_IMAGE_VERSION_ATLEAST(2, 6, 0)
+    Py_ssize_t limit = PyLong_AsSsize_t(arg);
+    PyObject *cache = NULL;
+
+    if (limit == -1 && PyErr_Occurred()) {
+        return NULL;
+    }
+    if (limit < 0) {
+        return RAISE(PyExc_ValueError, "limit must not be negative");
+    }
+    if (limit) {
+        cache = PyDict_New();
+        if (!cache) {
+            return NULL;
+        }
+    }
+    /* setting the limit always empties the cache */
+    Py_XSETREF(svg_cache, cache);
+    svg_cache_limit = limit;
+    Py_RETURN_NONE;
+#else  /* ~SDL_IMAGE_VERSION_ATLEAST(2, 6, 0) */
+    return RAISE(
+        pgExc_SDLError,
+        "pygame must be compiled with SDL_image 2.6.0+ to use this function");
+#endif /* ~SDL_IMAGE_VERSION_ATLEAST(2, 6, 0) */
+}
+
+#if SDL_IMAGE_VERSION_ATLEAST(2, 6, 0)
+/* Returns the frames of anim as a list of (Surface, duration) tuples. The
+ * frames handed over to Surfaces are taken out of anim. */
+static PyObject *
+iext_animation_frames(IMG_Animation *anim)
+{
+    PyObject *list, *surfobj, *item;
+    int i;
+
+    list = PyList_New(anim->count);
+    if (!list) {
+        return NULL;
+    }
+    for (i = 0; i < anim->count; i++) {
+        surfobj = (PyObject *)pgSurface_New(anim->frames[i]);
+        if (!surfobj) {
+            Py_DECREF(list);
+            return NULL;
+        }
+        anim->frames[i] = NULL;
+        item = Py_BuildValue("(Ni)", surfobj, anim->delays[i]);
+        if (!item) {
+            Py_DECREF(list);
+            return NULL;
+        }
+        PyList_SET_ITEM(list, i, item);
+    }
+    return list;
+}
+
+/* Copies the frames of anim into a grid on one Surface, as close to square
+ * as it gets, and returns (Surface, [(Rect, duration), ...]). Each frame is
+ * freed as soon as it is copied. */
+static PyObject *
+iext_animation_atlas(IMG_Animation *anim)
+{
+    PyObject *atlas, *rects, *item;
+    SDL_Surface *surf, *frame;
+    SDL_Rect r;
+    int columns = 1, rows, i;
+
+    while (columns * columns < anim->count) {
+        columns++;
+    }
+    rows = (anim->count + columns - 1) / columns;
+    if (anim->w <= 0 || anim->h <= 0 ||
+        (Sint64)anim->w * columns > SDL_MAX_SINT32 / 4 ||
+        (Sint64)anim->h * rows > SDL_MAX_SINT32 / 4) {
+        return RAISE(PyExc_ValueError, "animation too large for an atlas");
+    }
+    surf = PG_CreateSurface(anim->w * columns, anim->h * rows,
+                            SDL_PIXELFORMAT_ARGB8888);
+    if (!surf) {
+        return RAISE(pgExc_SDLError, SDL_GetError());
+    }
+    atlas = (PyObject *)pgSurface_New(surf);
+    if (!atlas) {
+        SDL_FreeSurface(surf);
+        return NULL;
+    }
+    rects = PyList_New(anim->count);
+    if (!rects) {
+        Py_DECREF(atlas);
+        return NULL;
+    }
+    for (i = 0; i < anim->count; i++) {
+        frame = anim->frames[i];
+        r.x = (i % columns) * anim->w;
+        r.y = (i / columns) * anim->h;
+        r.w = MIN(frame->w, anim->w);
+        r.h = MIN(frame->h, anim->h);
+        if (SDL_ConvertPixels(r.w, r.h, frame->format->format, frame->pixels,
+                              frame->pitch, SDL_PIXELFORMAT_ARGB8888,
+                              (Uint8 *)surf->pixels + r.y * surf->pitch +
+                                  r.x * 4,
+                              surf->pitch) < 0) {
+            PyErr_SetString(pgExc_SDLError, SDL_GetError());
+            goto error;
+        }
+        SDL_FreeSurface(frame);
+        anim->frames[i] = NULL;
+        r.w = anim->w;
+        r.h = anim->h;
+        item = Py_BuildValue("(Ni)", pgRect_New(&r), anim->delays[i]);
+        if (!item) {
+            goto error;
+        }
+        PyList_SET_ITEM(rects, i, item);
+    }
+    return Py_BuildValue("(NN)", atlas, rects);
+
+error:
+    Py_DECREF(atlas);
+    Py_DECREF(rects);
+    return NULL;
+}
+#endif /* SDL_IMAGE_VERSION_ATLEAST(2, 6, 0) */
+
+static PyObject *
+imageext_load_animation(PyObject *self, PyObject *arg, PyObject *kwargs)
+{
+#if SDL_IMAGE_VERSION_ATLEAST(2, 6, 0)
+    PyObject *obj, *final;
+    char *name = NULL, *ext = NULL, *type;
+    int atlas = 0;
+    IMG_Animation *anim;
+    SDL_RWops *rw;
+    static char *kwds[] = {"file", "namehint", "atlas", NULL};
+
+    if (!PyArg_ParseTupleAndKeywords(arg, kwargs, "O|sp", kwds, &obj, &name,
+                                     &atlas)) {
+        return NULL;
+    }
+
+    rw = pgRWops_FromObject(obj, &ext);
     if (rw == NULL) {
         return NULL;
     }
+    type = name ? iext_find_extension(name) : ext;
 
     Py_BEGIN_ALLOW_THREADS;
-    surf = IMG_LoadSizedSVG_RW(rw, width, height);
-    SDL_RWclose(rw);
+    anim = IMG_LoadAnimationTyped_RW(rw, 1, type);
     Py_END_ALLOW_THREADS;
-    if (surf == NULL) {
-        return RAISE(pgExc_SDLError, IMG_GetError());
+    if (ext) {
+        free(ext);
     }
-    final = (PyObject *)pgSurface_New(surf);
-    if (final == NULL) {
-        SDL_FreeSurface(surf);
+    if (anim == NULL) {
+        return RAISE(pgExc_SDLError, IMG_GetError());
     }
+
+    final = atlas ? iext_animation_atlas(anim) : iext_animation_frames(anim);
+    IMG_FreeAnimation(anim);
     return final;
 #else  /* ~SDL_IMAGE_VERSION_ATLEAST(2, 6, 0) */
     return RAISE(
@@ -195,6 +568,7 @@ image_save_ext(PyObject *self, PyObject *arg, PyObject *kwarg)
     int result = 1;
     char *name = NULL;
     SDL_RWops *rw = NULL;
+    pg_NoGIL nogil;
     static char *kwds[] = {"surface", "file", "namehint", NULL};
 
     if (!PyArg_ParseTupleAndKeywords(arg, kwarg, "O!O|s", kwds,
@@ -234,18 +608,21 @@ image_save_ext(PyObject *self, PyObject *arg, PyObject *kwarg)
                 result = IMG_SaveJPG_RW(surf, rw, 0, JPEG_QUALITY);
             }
             else {
+                pg_nogil_begin(&nogil, surfobj, NULL);
                 result = IMG_SaveJPG(surf, name, JPEG_QUALITY);
+                pg_nogil_end(&nogil);
             }
         }
         else if (!strcasecmp(ext, "png")) {
-            /*Py_BEGIN_ALLOW_THREADS; */
+            /* a file object is written with the GIL held */
             if (rw != NULL) {
                 result = IMG_SavePNG_RW(surf, rw, 0);
             }
             else {
+                pg_nogil_begin(&nogil, surfobj, NULL);
                 result = IMG_SavePNG(surf, name);
+                pg_nogil_end(&nogil);
             }
-            /*Py_END_ALLOW_THREADS; */
         }
     }
 
@@ -314,6 +691,10 @@ static PyMethodDef _imageext_methods[] = {
      "Note: Should not be used directly."},
     {"_load_sized_svg", (PyCFunction)imageext_load_sized_svg,
      METH_VARARGS | METH_KEYWORDS, "Note: Should not be used directly."},
+    {"_set_svg_cache_limit", (PyCFunction)imageext_set_svg_cache_limit,
+     METH_O, "Note: Should not be used directly."},
+    {"_load_animation", (PyCFunction)imageext_load_animation,
+     METH_VARARGS | METH_KEYWORDS, "Note: Should not be used directly."},
     {NULL, NULL, 0, NULL}};
 
 /*DOC*/ static char _imageext_doc[] =
@@ -321,6 +702,8 @@ static PyMethodDef _imageext_methods[] = {
 
 MODINIT_DEFINE(imageext)
 {
+    PyObject *module, *cobj;
+    const SDL_version *ver;
     static struct PyModuleDef _module = {PyModuleDef_HEAD_INIT,
                                          "imageext",
                                          _imageext_doc,
@@ -344,6 +727,10 @@ MODINIT_DEFINE(imageext)
     }
     import_pygame_rwobject();
 
+    if (PyErr_Occurred()) {
+        return NULL;
+    }
+    import_pygame_rect();
     if (PyErr_Occurred()) {
         return NULL;
     }
@@ -359,5 +746,31 @@ MODINIT_DEFINE(imageext)
     */
 
     /* create the module */
-    return PyModule_Create(&_module);
+    module = PyModule_Create(&_module);
+    if (module == NULL) {
+        return NULL;
+    }
+    if (PG_GIL_NOT_USED(module)) {
+        Py_DECREF(module);
+        return NULL;
+    }
+
+    /* SDL_image <= 2.0.4 could not decode from several threads at once */
+    ver = IMG_Linked_Version();
+    iext_decoder.threadsafe = SDL_VERSIONNUM(ver->major, ver->minor,
+                                             ver->patch) >=
+                              SDL_VERSIONNUM(2, 0, 5);
+    cobj = PyCapsule_New(&iext_decoder, "pygame.imageext._DECODE", NULL);
+    if (PyModule_AddObject(module, "_DECODE", cobj)) {
+        Py_XDECREF(cobj);
+        Py_DECREF(module);
+        return NULL;
+    }
+    cobj = PyCapsule_New(&iext_encoder, "pygame.imageext._ENCODE", NULL);
+    if (PyModule_AddObject(module, "_ENCODE", cobj)) {
+        Py_XDECREF(cobj);
+        Py_DECREF(module);
+        return NULL;
+    }
+    return module;
 }
@@ -102,6 +102,76 @@ typedef struct pg_bufferinfo_s {
 #include "pgimport.h"
 #include "../pgcompat_rect.h"
 
+/* Hot path counters, read by pygame.system.get_perf_counters(). There is
+ * one per PG_PERF_* kind, updated while holding its lock, see
+ * pg_LockState(). The time is kept
+ * in SDL performance counter ticks. Building with PG_NO_PERF_COUNTERS
+ * compiles the instrumentation out. */
+#define PG_PERF_BLIT 0
+#define PG_PERF_FILL 1
+#define PG_PERF_TRANSFORM 2
+#define PG_PERF_TEXT 3
+#define PG_PERF_EVENT 4
+#define PG_PERF_FLIP 5
+#define PG_PERF_NUM_COUNTERS 6
+
+typedef struct {
+    Uint64 calls;
+    Uint64 pixels;
+    Uint64 ticks;
+} pgPerfCounter;
+
+/* Pixel memory held by Surfaces, read by pygame.system.get_surface_memory().
+ * Each Surface that owns its SDL surface is counted once in total, under
+ * the PG_SURF_ORIGIN_* of the module that created it, and under its pixel
+ * format. The first PG_SURF_MAX_FORMATS formats seen get a counter. Updated
+ * while holding the PG_STATE_SURFACE_MEMORY lock. */
+#define PG_SURF_ORIGIN_SURFACE 0
+#define PG_SURF_ORIGIN_TRANSFORM 1
+#define PG_SURF_ORIGIN_IMAGE 2
+#define PG_SURF_ORIGIN_FONT 3
+#define PG_SURF_ORIGIN_DISPLAY 4
+#define PG_SURF_ORIGIN_OTHER 5
+#define PG_SURF_NUM_ORIGINS 6
+#define PG_SURF_MAX_FORMATS 32
+
+typedef struct {
+    Sint64 count;
+    Sint64 bytes;
+    Sint64 peak_count;
+    Sint64 peak_bytes;
+} pgSurfaceMemCounter;
+
+typedef struct {
+    pgSurfaceMemCounter total;
+    pgSurfaceMemCounter origins[PG_SURF_NUM_ORIGINS];
+    int num_formats;
+    Uint32 formats[PG_SURF_MAX_FORMATS];
+    pgSurfaceMemCounter by_format[PG_SURF_MAX_FORMATS];
+} pgSurfaceMemStats;
+
+/* The modules with runtime picked SIMD kernels register one of these with
+ * pg_RegisterSIMDDispatch(). It is called with the GIL held, to pick the
+ * kernels again when pygame.system.set_simd_level() changed the level, and
+ * to add the backend each operation of the module uses to the dispatch dict
+ * if that isn't NULL. Returns -1 with an exception set on failure. */
+typedef int (*pg_SIMDDispatchFunc)(PyObject *dispatch);
+
+#define PG_SIMD_MAX_DISPATCH 16
+
+/* Modules only get added, under the PG_STATE_SIMD_DISPATCH lock */
+typedef struct {
+    int count;
+    pg_SIMDDispatchFunc funcs[PG_SIMD_MAX_DISPATCH];
+} pgSIMDDispatchTable;
+
+/* The locks of the state above are kept by the base module, taken with
+ * pg_LockState() and released with pg_UnlockState() */
+#define PG_STATE_SIMD_DISPATCH 0
+#define PG_STATE_SURFACE_MEMORY 1
+#define PG_STATE_PERF 2 /* plus the PG_PERF_* kind */
+#define PG_STATE_NUM_LOCKS (PG_STATE_PERF + PG_PERF_NUM_COUNTERS)
+
 /*
  * BASE module
  */
@@ -189,6 +259,40 @@ typedef struct pg_bufferinfo_s {
 #define pg_SetDefaultConvertFormat \
     (*(SDL_PixelFormat * (*)(Uint32)) PYGAMEAPI_GET_SLOT(base, 28))
 
+#define pg_perf_counters ((pgPerfCounter *)PYGAMEAPI_GET_SLOT(base, 29))
+
+#define pg_RegisterSIMDDispatch \
+    (*(void (*)(pg_SIMDDispatchFunc))PYGAMEAPI_GET_SLOT(base, 30))
+
+#define pg_simd_dispatch_table \
+    ((pgSIMDDispatchTable *)PYGAMEAPI_GET_SLOT(base, 31))
+
+#define pg_surface_memory ((pgSurfaceMemStats *)PYGAMEAPI_GET_SLOT(base, 32))
+
+#define pg_LockState (*(void (*)(int))PYGAMEAPI_GET_SLOT(base, 33))
+
+#define pg_UnlockState (*(void (*)(int))PYGAMEAPI_GET_SLOT(base, 34))
+
+/* PG_PERF_START(start) declares start and reads the clock into it.
+ * PG_PERF_STOP(start, kind, npixels) adds a call of the given kind that
+ * began at start, npixels must not have side effects. */
+#ifndef PG_NO_PERF_COUNTERS
+#define PG_PERF_START(start) Uint64 start = SDL_GetPerformanceCounter()
+#define PG_PERF_STOP(start, kind, npixels)                              \
+    do {                                                                \
+        pgPerfCounter *_pg_counter = pg_perf_counters + (kind);         \
+        Uint64 _pg_ticks = SDL_GetPerformanceCounter() - (start);       \
+        pg_LockState(PG_STATE_PERF + (kind));                           \
+        _pg_counter->calls++;                                           \
+        _pg_counter->pixels += (Uint64)(npixels);                       \
+        _pg_counter->ticks += _pg_ticks;                                \
+        pg_UnlockState(PG_STATE_PERF + (kind));                         \
+    } while (0)
+#else
+#define PG_PERF_START(start) const Uint64 start = 0
+#define PG_PERF_STOP(start, kind, npixels) ((void)(start), (void)(npixels))
+#endif /* ~PG_NO_PERF_COUNTERS */
+
 #define import_pygame_base() IMPORT_PYGAME_MODULE(base)
 #endif /* ~PYGAMEAPI_BASE_INTERNAL */
 
@@ -249,6 +353,9 @@ typedef struct pgJoystickObject {
      */
     struct pgJoystickObject *next;
     struct pgJoystickObject *prev;
+
+    /* The axis sampling thread of start_sampling(), or NULL */
+    struct pgJoySampler *sampler;
 } pgJoystickObject;
 
 #define pgJoystick_AsID(x) (((pgJoystickObject *)x)->id)
@@ -306,8 +413,44 @@ typedef struct {
  * SURFACE module
  */
 struct pgSubSurface_Data;
+struct pgSurfaceDirtyRects;
+struct pgSurfaceHistory;
+struct pg_AlphaSpans;
 struct SDL_Surface;
 
+/* Pixels that Surface.copy() results read together while copy-on-write is
+ * on, until one of them is written to. Owned by the sharing surfaces, the
+ * last one to let go frees them. */
+typedef struct pgSharedPixels {
+    void *pixels;
+    int simd_aligned; /* allocated with SDL_SIMDAlloc() */
+    int count;        /* surfaces using the pixels, under lock */
+    pg_mutex lock;
+    /* gives a surface pixels of its own, 0 with an exception on failure */
+    int (*unshare)(PyObject *surfobj);
+} pgSharedPixels;
+
+/* A texture the display module made of an ACCELERATED surface, freed with
+ * the surface */
+typedef struct pgSurfaceTexture {
+    void (*release)(struct pgSurfaceTexture *texture);
+} pgSurfaceTexture;
+
+/* Set by the display module on the display surface, to draw blits and fills
+ * of it with the display renderer. While drawn is set, what was drawn is in
+ * a texture and the pixels are out of date until sync() reads them back. */
+typedef struct pgSurfaceCanvas {
+    int drawn;
+    /* whether blit() can draw srcobj onto dstobj with blend_flags */
+    int (*accepts)(PyObject *dstobj, PyObject *srcobj, int blend_flags);
+    /* like SDL_BlitSurface(), 0 or -1 with an exception on failure */
+    int (*blit)(PyObject *dstobj, PyObject *srcobj, SDL_Rect *dstrect,
+                SDL_Rect *srcrect);
+    /* fills rect, clipped, if drawn is set, returns 0 when it isn't */
+    int (*fill)(PyObject *dstobj, const SDL_Rect *rect, Uint32 color);
+    void (*sync)(PyObject *dstobj);
+} pgSurfaceCanvas;
+
 typedef struct {
     PyObject_HEAD struct SDL_Surface *surf;
     int owner;
@@ -316,17 +459,50 @@ typedef struct {
     PyObject *weakreflist;
     PyObject *locklist;
     PyObject *dependency;
+    struct pgSurfaceDirtyRects *dirty; /* dirty rect tracker (if enabled) */
+    Uint64 version; /* bumped whenever the pixels or format may change */
+    /* what pygame.system.get_surface_memory() counts the surface as */
+    int origin;       /* PG_SURF_ORIGIN_* */
+    Sint64 mem_bytes; /* -1 if not counted */
+    Uint32 mem_format;
+    int premultiplied; /* blits default to BLEND_PREMULTIPLIED */
+    struct pg_AlphaSpans *alpha_spans; /* set_alpha_spans() index, or NULL */
+    pgSharedPixels *shared; /* copy-on-write pixels, or NULL */
+    struct pgSurfaceHistory *history; /* snapshot() tiles, or NULL */
+    int accelerated; /* Surface(flags=ACCELERATED) */
+    pgSurfaceTexture *texture; /* of an ACCELERATED surface, or NULL */
+    pgSurfaceCanvas *canvas;   /* of the display surface, or NULL */
+    int selflocks; /* locks the surface holds on itself, not in locklist */
 } pgSurfaceObject;
 #define pgSurface_AsSurface(x) (((pgSurfaceObject *)x)->surf)
 
+/* Called by pg_run_bands() for each band, on one of the blit threads */
+typedef void (*pg_BandFunc)(void *data, int band);
+
+/* Brings the pixels up to date with what the display renderer drew */
+#define pgSurface_Sync(x)                     \
+    ((x)->canvas && (x)->canvas->drawn        \
+         ? (x)->canvas->sync((PyObject *)(x)) \
+         : (void)0)
+
+/* Call before writing to the pixels without locking the surface */
+#define pgSurface_Unshare(x) \
+    (pgSurface_Sync(x),      \
+     (!(x)->shared || (x)->shared->unshare((PyObject *)(x))))
+
 #ifndef PYGAMEAPI_SURFACE_INTERNAL
 #define pgSurface_Type (*(PyTypeObject *)PYGAMEAPI_GET_SLOT(surface, 0))
 
 #define pgSurface_Check(x) \
     (PyObject_IsInstance((x), (PyObject *)&pgSurface_Type))
-#define pgSurface_New2                            \
-    (*(pgSurfaceObject * (*)(SDL_Surface *, int)) \
-         PYGAMEAPI_GET_SLOT(surface, 1))
+/* Define PG_SURFACE_ORIGIN before including this file to count the
+ * surfaces a module creates under another origin */
+#ifndef PG_SURFACE_ORIGIN
+#define PG_SURFACE_ORIGIN PG_SURF_ORIGIN_OTHER
+#endif
+
+#define pgSurface_New2(surface, owner) \
+    pgSurface_NewWithOrigin((surface), (owner), PG_SURFACE_ORIGIN)
 
 #define pgSurface_SetSurface                                              \
     (*(int (*)(pgSurfaceObject *, SDL_Surface *, int))PYGAMEAPI_GET_SLOT( \
@@ -336,6 +512,27 @@ typedef struct {
     (*(int (*)(pgSurfaceObject *, pgSurfaceObject *, SDL_Rect *, SDL_Rect *, \
                int))PYGAMEAPI_GET_SLOT(surface, 2))
 
+#define pgSurface_AddDirtyRect                  \
+    (*(void (*)(pgSurfaceObject *, SDL_Rect *)) \
+         PYGAMEAPI_GET_SLOT(surface, 4))
+
+#define pgSurface_GetDirtyRects                     \
+    (*(int (*)(pgSurfaceObject *, SDL_Rect *, int)) \
+         PYGAMEAPI_GET_SLOT(surface, 5))
+
+#define pgSurface_GetVersion \
+    (*(Uint64(*)(pgSurfaceObject *))PYGAMEAPI_GET_SLOT(surface, 6))
+
+#define pgSurface_NewWithOrigin                        \
+    (*(pgSurfaceObject * (*)(SDL_Surface *, int, int)) \
+         PYGAMEAPI_GET_SLOT(surface, 7))
+
+#define pgSurface_CreatePooled \
+    (*(SDL_Surface * (*)(int, int, Uint32)) PYGAMEAPI_GET_SLOT(surface, 8))
+
+#define pg_run_bands \
+    (*(void (*)(pg_BandFunc, void *, int))PYGAMEAPI_GET_SLOT(surface, 9))
+
 #define import_pygame_surface()         \
     do {                                \
         IMPORT_PYGAME_MODULE(surface);  \
@@ -358,8 +555,8 @@ typedef struct {
 
 #define pgLifetimeLock_Check(x) ((x)->ob_type == &pgLifetimeLock_Type)
 
-#define pgSurface_Prep(x) \
-    if ((x)->subsurface)  \
+#define pgSurface_Prep(x)               \
+    if ((x)->subsurface || (x)->canvas) \
     (*(*(void (*)(pgSurfaceObject *))PYGAMEAPI_GET_SLOT(surflock, 1)))(x)
 
 #define pgSurface_Unprep(x) \
@@ -415,6 +612,10 @@ typedef struct pgEventObject pgEventObject;
 #define pgEvent_GetMouseButtonUpInfo \
     (*(char *(*)(void))PYGAMEAPI_GET_SLOT(event, 9))
 
+#define pgChannel_Push                                       \
+    (*(int (*)(PyObject *, const void *, Py_ssize_t)) \
+         PYGAMEAPI_GET_SLOT(event, 10))
+
 #define import_pygame_event() IMPORT_PYGAME_MODULE(event)
 #endif
 
@@ -439,6 +640,9 @@ typedef struct pgEventObject pgEventObject;
 #define pgRWops_FromFileObject \
     (*(SDL_RWops * (*)(PyObject *)) PYGAMEAPI_GET_SLOT(rwobject, 4))
 
+#define pgRWops_FromBuffer \
+    (*(SDL_RWops * (*)(PyObject *)) PYGAMEAPI_GET_SLOT(rwobject, 5))
+
 #define import_pygame_rwobject() IMPORT_PYGAME_MODULE(rwobject)
 
 #endif
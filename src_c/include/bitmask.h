@@ -164,6 +164,32 @@ void
 bitmask_convolve(const bitmask_t *a, const bitmask_t *b, bitmask_t *o,
                  int xoffset, int yoffset);
 
+/* The kernels doing the bulk of bitmask_invert(), bitmask_count(),
+   bitmask_draw(), bitmask_erase() and bitmask_overlap_mask(). Each works
+   on n consecutive words, i.e. on rows of one stripe. The words of b are
+   shifted left by shift, or right by -shift if shift is negative.
+
+   count:   returns the number of bits set in w
+   invert:  w = ~w & mask
+   draw:    a |= b << shift
+   erase:   a &= ~(b << shift)
+   overlap: c = a & (b << shift), or c |= a & (b << shift) if accumulate
+            is nonzero */
+typedef struct bitmask_kernels {
+    unsigned int (*count)(const BITMASK_W *w, int n);
+    void (*invert)(BITMASK_W *w, int n, BITMASK_W mask);
+    void (*draw)(BITMASK_W *a, const BITMASK_W *b, int n, int shift);
+    void (*erase)(BITMASK_W *a, const BITMASK_W *b, int n, int shift);
+    void (*overlap)(BITMASK_W *c, const BITMASK_W *a, const BITMASK_W *b,
+                    int n, int shift, int accumulate);
+} bitmask_kernels_t;
+
+/* Replaces the kernels, e.g. with SIMD versions picked at runtime. NULL
+   restores the portable C ones. This is not thread safe, call it once
+   before using any of the masks. */
+void
+bitmask_set_kernels(const bitmask_kernels_t *kernels);
+
 #ifdef __cplusplus
 } /* End of extern "C" { */
 #endif
@@ -11,6 +11,31 @@
 #define PG_EXIT(n) Py_Exit(n)
 #endif
 
+/* Free-threaded CPython builds (Py_GIL_DISABLED) have no GIL to serialise
+ * the C code. State shared by all threads is guarded by a pg_mutex, and the
+ * fields of a Python object by a critical section on it. Both compile to
+ * nothing when the GIL is there. A module tells the interpreter that it is
+ * safe without the GIL with PG_GIL_NOT_USED(module), which returns -1 on
+ * error. Importing a module that doesn't turns the GIL back on. */
+#ifdef Py_GIL_DISABLED
+typedef PyMutex pg_mutex;
+#define pg_mutex_lock(m) PyMutex_Lock(m)
+#define pg_mutex_unlock(m) PyMutex_Unlock(m)
+#define PG_GIL_NOT_USED(module) \
+    PyUnstable_Module_SetGIL(module, Py_MOD_GIL_NOT_USED)
+#else
+typedef char pg_mutex;
+#define pg_mutex_lock(m) ((void)(m))
+#define pg_mutex_unlock(m) ((void)(m))
+#define PG_GIL_NOT_USED(module) ((void)(module), 0)
+#endif
+
+/* Critical sections are new in Python 3.13 */
+#ifndef Py_BEGIN_CRITICAL_SECTION
+#define Py_BEGIN_CRITICAL_SECTION(op) {
+#define Py_END_CRITICAL_SECTION() }
+#endif
+
 /* define common types where SDL is not included */
 #ifndef SDL_VERSION_ATLEAST
 #ifdef _MSC_VER
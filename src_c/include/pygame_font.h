@@ -24,12 +24,19 @@
 #include "pgplatform.h"
 
 struct TTF_Font;
+struct pgFontRenderCache;
+struct pgFontAtlas;
 
 typedef struct {
     PyObject_HEAD TTF_Font *font;
     PyObject *weakreflist;
     int ptsize;
     unsigned int ttf_init_generation;
+    struct pgFontRenderCache *render_cache; /* rendered text (if enabled) */
+    struct pgFontAtlas *atlas; /* glyphs drawn by render_to (once used) */
+    PyObject *size_cache;      /* text -> (w, h), see _font_size_of */
+    int size_cache_stamp;      /* point size and style it was made with */
+    PyThread_type_lock lock;   /* held while rendering without the GIL */
 } PyFontObject;
 #define PyFont_AsFont(x) (((PyFontObject *)x)->font)
 
@@ -25,6 +25,15 @@
 typedef struct {
     PyObject_HEAD bitmask_t *mask;
     void *bufdata;
+    /* NULL, or the copies of mask shifted right by 1 to BITMASK_W_LEN - 1
+     * bits (index 0 is unused), made by Mask.prepare_shifts() */
+    bitmask_t **shifts;
+    /* NULL, or the state of each BITMASK_W_LEN x BITMASK_W_LEN block of
+     * mask (unknown, empty or used) for skipping empty blocks, see mask.c */
+    unsigned char *blocks;
+    /* NULL, or the x, y pairs of the points traced by Mask.outline() */
+    int *outline;
+    Py_ssize_t outline_len;
 } pgMaskObject;
 
 #define pgMask_AsBitmap(x) (((pgMaskObject *)x)->mask)
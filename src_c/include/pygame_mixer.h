@@ -34,6 +34,8 @@ typedef struct {
     PyObject_HEAD Mix_Chunk *chunk;
     Uint8 *mem;
     PyObject *weakreflist;
+    Py_buffer *view; /* held exporter view when created with copy=False */
+    int max_instances; /* channels Sound.play() may use at once, 0: any */
 } pgSoundObject;
 
 typedef struct {
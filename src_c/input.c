@@ -0,0 +1,396 @@
+/*
+  pygame-ce - Python Game Library
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Library General Public
+  License as published by the Free Software Foundation; either
+  version 2 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Library General Public License for more details.
+
+  You should have received a copy of the GNU Library General Public
+  License along with this library; if not, write to the Free
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+*/
+
+/*
+ *  pygame input module, the keyboard, mouse and joystick state read in one
+ *  call
+ */
+#include "pygame.h"
+
+#include "pgcompat.h"
+
+#include "doc/input_doc.h"
+
+#define PG_INPUT_MAX_JOYSTICKS 8
+#define PG_INPUT_MAX_AXES 16
+#define PG_INPUT_MAX_BUTTONS 64
+#define PG_INPUT_MAX_HATS 4
+
+typedef struct {
+    SDL_JoystickID instance_id;
+    int num_axes, num_buttons, num_hats;
+    Sint16 axes[PG_INPUT_MAX_AXES];
+    Uint64 buttons;
+    Uint8 hats[PG_INPUT_MAX_HATS];
+} pgInputJoystick;
+
+/* Everything snapshot() reads, stored in place so that refreshing an
+ * InputState allocates nothing */
+typedef struct {
+    PyObject_HEAD Uint8 keys[(SDL_NUM_SCANCODES + 7) / 8];
+    int mods;
+    int mouse_x, mouse_y;
+    Uint32 mouse_buttons;
+    int num_joysticks;
+    pgInputJoystick joysticks[PG_INPUT_MAX_JOYSTICKS];
+} pgInputStateObject;
+
+static void
+_input_read_keyboard(pgInputStateObject *self)
+{
+    const Uint8 *key_state;
+    int num_keys, i;
+
+    memset(self->keys, 0, sizeof(self->keys));
+    key_state = SDL_GetKeyboardState(&num_keys);
+    if (key_state) {
+        num_keys = MIN(num_keys, SDL_NUM_SCANCODES);
+        for (i = 0; i < num_keys; i++) {
+            if (key_state[i]) {
+                self->keys[i >> 3] |= 1 << (i & 7);
+            }
+        }
+    }
+    self->mods = SDL_GetModState();
+}
+
+/* the position is scaled like mouse.get_pos() does for SCALED displays */
+static void
+_input_read_mouse(pgInputStateObject *self)
+{
+    SDL_Window *sdlWindow = pg_GetDefaultWindow();
+    SDL_Renderer *sdlRenderer = SDL_GetRenderer(sdlWindow);
+    int x, y;
+
+    self->mouse_buttons = SDL_GetMouseState(&x, &y);
+    if (sdlRenderer != NULL) {
+        SDL_Rect vprect;
+        float scalex, scaley;
+
+        SDL_RenderGetScale(sdlRenderer, &scalex, &scaley);
+        SDL_RenderGetViewport(sdlRenderer, &vprect);
+
+        x = (int)(x / scalex) - vprect.x;
+        y = (int)(y / scaley) - vprect.y;
+        x = MAX(0, MIN(x, vprect.w - 1));
+        y = MAX(0, MIN(y, vprect.h - 1));
+    }
+    self->mouse_x = x;
+    self->mouse_y = y;
+}
+
+/* only the joysticks opened with pygame.joystick.Joystick() are read */
+static void
+_input_read_joysticks(pgInputStateObject *self)
+{
+    int count, i, j;
+
+    self->num_joysticks = 0;
+    if (!SDL_WasInit(SDL_INIT_JOYSTICK)) {
+        return;
+    }
+    count = SDL_NumJoysticks();
+    for (i = 0; i < count && self->num_joysticks < PG_INPUT_MAX_JOYSTICKS;
+         i++) {
+        SDL_JoystickID id = SDL_JoystickGetDeviceInstanceID(i);
+        SDL_Joystick *joy = SDL_JoystickFromInstanceID(id);
+        pgInputJoystick *state;
+
+        if (!joy) {
+            continue;
+        }
+        state = &self->joysticks[self->num_joysticks++];
+        state->instance_id = id;
+        state->num_axes = MIN(SDL_JoystickNumAxes(joy), PG_INPUT_MAX_AXES);
+        state->num_buttons =
+            MIN(SDL_JoystickNumButtons(joy), PG_INPUT_MAX_BUTTONS);
+        state->num_hats = MIN(SDL_JoystickNumHats(joy), PG_INPUT_MAX_HATS);
+        for (j = 0; j < state->num_axes; j++) {
+            state->axes[j] = SDL_JoystickGetAxis(joy, j);
+        }
+        state->buttons = 0;
+        for (j = 0; j < state->num_buttons; j++) {
+            if (SDL_JoystickGetButton(joy, j)) {
+                state->buttons |= (Uint64)1 << j;
+            }
+        }
+        for (j = 0; j < state->num_hats; j++) {
+            state->hats[j] = SDL_JoystickGetHat(joy, j);
+        }
+    }
+}
+
+static pgInputJoystick *
+_input_get_joystick(pgInputStateObject *self, int instance_id)
+{
+    int i;
+
+    for (i = 0; i < self->num_joysticks; i++) {
+        if (self->joysticks[i].instance_id == instance_id) {
+            return &self->joysticks[i];
+        }
+    }
+    PyErr_Format(pgExc_SDLError, "joystick %d is not in the snapshot",
+                 instance_id);
+    return NULL;
+}
+
+static PyObject *
+input_state_key_pressed(pgInputStateObject *self, PyObject *arg)
+{
+    long key;
+    int scancode;
+
+    if ((key = PyLong_AsLong(arg)) == -1 && PyErr_Occurred()) {
+        return NULL;
+    }
+    scancode = SDL_GetScancodeFromKey((SDL_Keycode)key);
+    if (scancode <= 0 || scancode >= SDL_NUM_SCANCODES) {
+        Py_RETURN_FALSE;
+    }
+    return PyBool_FromLong(self->keys[scancode >> 3] & (1 << (scancode & 7)));
+}
+
+static PyObject *
+input_state_mouse_pressed(pgInputStateObject *self, PyObject *arg)
+{
+    long button;
+
+    if ((button = PyLong_AsLong(arg)) == -1 && PyErr_Occurred()) {
+        return NULL;
+    }
+    if (button < 0 || button > 4) {
+        return RAISE(PyExc_ValueError, "button must be between 0 and 4");
+    }
+    return PyBool_FromLong(self->mouse_buttons &
+                           SDL_BUTTON((Uint32)button + 1));
+}
+
+static PyObject *
+input_state_get_axis(pgInputStateObject *self, PyObject *args)
+{
+    pgInputJoystick *joy;
+    int instance_id, axis;
+
+    if (!PyArg_ParseTuple(args, "ii", &instance_id, &axis)) {
+        return NULL;
+    }
+    if (!(joy = _input_get_joystick(self, instance_id))) {
+        return NULL;
+    }
+    if (axis < 0 || axis >= joy->num_axes) {
+        return RAISE(pgExc_SDLError, "Invalid joystick axis");
+    }
+    return PyFloat_FromDouble(joy->axes[axis] / 32768.0);
+}
+
+static PyObject *
+input_state_get_button(pgInputStateObject *self, PyObject *args)
+{
+    pgInputJoystick *joy;
+    int instance_id, button;
+
+    if (!PyArg_ParseTuple(args, "ii", &instance_id, &button)) {
+        return NULL;
+    }
+    if (!(joy = _input_get_joystick(self, instance_id))) {
+        return NULL;
+    }
+    if (button < 0 || button >= joy->num_buttons) {
+        return RAISE(pgExc_SDLError, "Invalid joystick button");
+    }
+    return PyBool_FromLong((joy->buttons >> button) & 1);
+}
+
+static PyObject *
+input_state_get_hat(pgInputStateObject *self, PyObject *args)
+{
+    pgInputJoystick *joy;
+    int instance_id, hat, px = 0, py = 0;
+    Uint8 value;
+
+    if (!PyArg_ParseTuple(args, "ii", &instance_id, &hat)) {
+        return NULL;
+    }
+    if (!(joy = _input_get_joystick(self, instance_id))) {
+        return NULL;
+    }
+    if (hat < 0 || hat >= joy->num_hats) {
+        return RAISE(pgExc_SDLError, "Invalid joystick hat");
+    }
+
+    value = joy->hats[hat];
+    if (value & SDL_HAT_UP) {
+        py = 1;
+    }
+    else if (value & SDL_HAT_DOWN) {
+        py = -1;
+    }
+    if (value & SDL_HAT_RIGHT) {
+        px = 1;
+    }
+    else if (value & SDL_HAT_LEFT) {
+        px = -1;
+    }
+    return pg_tuple_couple_from_values_int(px, py);
+}
+
+static PyObject *
+input_state_get_mods(pgInputStateObject *self, void *closure)
+{
+    return PyLong_FromLong(self->mods);
+}
+
+static PyObject *
+input_state_get_mouse_pos(pgInputStateObject *self, void *closure)
+{
+    return pg_tuple_couple_from_values_int(self->mouse_x, self->mouse_y);
+}
+
+static PyObject *
+input_state_get_joystick_ids(pgInputStateObject *self, void *closure)
+{
+    PyObject *ids = PyTuple_New(self->num_joysticks);
+    PyObject *id;
+    int i;
+
+    if (!ids) {
+        return NULL;
+    }
+    for (i = 0; i < self->num_joysticks; i++) {
+        if (!(id = PyLong_FromLong(self->joysticks[i].instance_id))) {
+            Py_DECREF(ids);
+            return NULL;
+        }
+        PyTuple_SET_ITEM(ids, i, id);
+    }
+    return ids;
+}
+
+static PyMethodDef input_state_methods[] = {
+    {"key_pressed", (PyCFunction)input_state_key_pressed, METH_O,
+     DOC_INPUT_INPUTSTATE_KEYPRESSED},
+    {"mouse_pressed", (PyCFunction)input_state_mouse_pressed, METH_O,
+     DOC_INPUT_INPUTSTATE_MOUSEPRESSED},
+    {"get_axis", (PyCFunction)input_state_get_axis, METH_VARARGS,
+     DOC_INPUT_INPUTSTATE_GETAXIS},
+    {"get_button", (PyCFunction)input_state_get_button, METH_VARARGS,
+     DOC_INPUT_INPUTSTATE_GETBUTTON},
+    {"get_hat", (PyCFunction)input_state_get_hat, METH_VARARGS,
+     DOC_INPUT_INPUTSTATE_GETHAT},
+    {NULL, NULL, 0, NULL}};
+
+static PyGetSetDef input_state_getsets[] = {
+    {"mods", (getter)input_state_get_mods, NULL, DOC_INPUT_INPUTSTATE_MODS,
+     NULL},
+    {"mouse_pos", (getter)input_state_get_mouse_pos, NULL,
+     DOC_INPUT_INPUTSTATE_MOUSEPOS, NULL},
+    {"joystick_ids", (getter)input_state_get_joystick_ids, NULL,
+     DOC_INPUT_INPUTSTATE_JOYSTICKIDS, NULL},
+    {NULL, NULL, NULL, NULL, NULL}};
+
+static PyTypeObject pgInputState_Type = {
+    PyVarObject_HEAD_INIT(NULL, 0).tp_name = "pygame.input.InputState",
+    .tp_basicsize = sizeof(pgInputStateObject),
+    .tp_flags = Py_TPFLAGS_DEFAULT,
+    .tp_doc = DOC_INPUT_INPUTSTATE,
+    .tp_methods = input_state_methods,
+    .tp_getset = input_state_getsets,
+    .tp_new = PyType_GenericNew,
+};
+
+static PyObject *
+input_snapshot(PyObject *self, PyObject *args, PyObject *kwargs)
+{
+    PyObject *into = Py_None;
+    pgInputStateObject *state;
+
+    static char *kwids[] = {"into", NULL};
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "|O", kwids, &into)) {
+        return NULL;
+    }
+    VIDEO_INIT_CHECK();
+
+    if (into == Py_None) {
+        state = (pgInputStateObject *)PyType_GenericNew(&pgInputState_Type,
+                                                        NULL, NULL);
+        if (!state) {
+            return NULL;
+        }
+    }
+    else if (PyObject_TypeCheck(into, &pgInputState_Type)) {
+        state = (pgInputStateObject *)into;
+        Py_INCREF(state);
+    }
+    else {
+        return PyErr_Format(PyExc_TypeError,
+                            "into must be an InputState or None, not %s",
+                            Py_TYPE(into)->tp_name);
+    }
+
+    _input_read_keyboard(state);
+    _input_read_mouse(state);
+    _input_read_joysticks(state);
+    return (PyObject *)state;
+}
+
+static PyMethodDef _input_methods[] = {
+    {"snapshot", (PyCFunction)input_snapshot, METH_VARARGS | METH_KEYWORDS,
+     DOC_INPUT_SNAPSHOT},
+    {NULL, NULL, 0, NULL}};
+
+MODINIT_DEFINE(input)
+{
+    PyObject *module;
+
+    static struct PyModuleDef _module = {PyModuleDef_HEAD_INIT,
+                                         "input",
+                                         DOC_INPUT,
+                                         -1,
+                                         _input_methods,
+                                         NULL,
+                                         NULL,
+                                         NULL,
+                                         NULL};
+
+    /* imported needed apis; Do this first so if there is an error
+       the module is not loaded.
+    */
+    import_pygame_base();
+    if (PyErr_Occurred()) {
+        return NULL;
+    }
+
+    if (PyType_Ready(&pgInputState_Type) < 0) {
+        return NULL;
+    }
+
+    module = PyModule_Create(&_module);
+    if (module == NULL) {
+        return NULL;
+    }
+
+    Py_INCREF(&pgInputState_Type);
+    if (PyModule_AddObject(module, "InputState",
+                           (PyObject *)&pgInputState_Type)) {
+        Py_DECREF(&pgInputState_Type);
+        Py_DECREF(module);
+        return NULL;
+    }
+    return module;
+}
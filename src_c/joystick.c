@@ -34,6 +34,8 @@ pgJoystick_New(int);
 static int
 pgJoystick_GetDeviceIndexByInstanceID(int);
 #define pgJoystick_Check(x) ((x)->ob_type == &pgJoystick_Type)
+static void
+_joy_stop_sampling(pgJoystickObject *jstick);
 
 static PyObject *
 init(PyObject *self, PyObject *_null)
@@ -52,6 +54,7 @@ quit(PyObject *self, PyObject *_null)
     /* Walk joystick objects to deallocate the stick objects. */
     pgJoystickObject *cur = joylist_head;
     while (cur) {
+        _joy_stop_sampling(cur);
         if (cur->joy) {
             SDL_JoystickClose(cur->joy);
             cur->joy = NULL;
@@ -78,6 +81,7 @@ joy_dealloc(PyObject *self)
 {
     pgJoystickObject *jstick = (pgJoystickObject *)self;
 
+    _joy_stop_sampling(jstick);
     if (jstick->joy) {
         SDL_JoystickClose(jstick->joy);
     }
@@ -145,6 +149,7 @@ joy_quit(PyObject *self, PyObject *_null)
     pgJoystickObject *joy = (pgJoystickObject *)self;
 
     JOYSTICK_INIT_CHECK();
+    _joy_stop_sampling(joy);
     if (joy->joy) {
         SDL_JoystickClose(joy->joy);
         joy->joy = NULL;
@@ -482,6 +487,236 @@ joy_get_hat(PyObject *self, PyObject *args)
     return pg_tuple_couple_from_values_int(px, py);
 }
 
+/* The axis sampler of a joystick. The thread updates the joysticks itself
+ * at the given rate and records the axes with a timestamp into a ring,
+ * which get_samples() drains. */
+typedef struct pgJoySampler {
+    SDL_Joystick *joy;
+    SDL_Thread *thread;
+    SDL_mutex *lock;
+    SDL_atomic_t quit;
+    Uint64 period;
+    int num_axes;
+    int capacity;
+    /* ring of capacity samples, guarded by lock */
+    int head, count;
+    Uint64 *times;
+    Sint16 *axes;
+    /* maps the performance counter to SDL_GetTicks() milliseconds */
+    Uint64 counter_base;
+    double ticks_base;
+} pgJoySampler;
+
+static int SDLCALL
+_joy_sampler_thread(void *data)
+{
+    pgJoySampler *s = (pgJoySampler *)data;
+    Uint64 freq = SDL_GetPerformanceFrequency();
+    Uint64 next = SDL_GetPerformanceCounter(), now;
+    Sint16 *slot;
+    int i, index;
+
+    while (!SDL_AtomicGet(&s->quit)) {
+        /* devices only report new values after an update, the main thread
+         * does one per event pump */
+        SDL_JoystickUpdate();
+        now = SDL_GetPerformanceCounter();
+
+        SDL_LockMutex(s->lock);
+        index = (s->head + s->count) % s->capacity;
+        if (s->count == s->capacity) {
+            /* full, the oldest sample is dropped */
+            s->head = (s->head + 1) % s->capacity;
+        }
+        else {
+            s->count++;
+        }
+        s->times[index] = now;
+        slot = s->axes + (size_t)index * s->num_axes;
+        SDL_LockJoysticks();
+        for (i = 0; i < s->num_axes; i++) {
+            slot[i] = SDL_JoystickGetAxis(s->joy, i);
+        }
+        SDL_UnlockJoysticks();
+        SDL_UnlockMutex(s->lock);
+
+        next += s->period;
+        now = SDL_GetPerformanceCounter();
+        if (next <= now) {
+            /* fell behind, don't make up for the missed samples */
+            next = now;
+        }
+        else {
+            SDL_Delay((Uint32)((next - now) * 1000 / freq));
+        }
+    }
+    return 0;
+}
+
+static void
+_joy_stop_sampling(pgJoystickObject *jstick)
+{
+    pgJoySampler *s = jstick->sampler;
+
+    if (!s) {
+        return;
+    }
+    jstick->sampler = NULL;
+    if (s->thread) {
+        SDL_AtomicSet(&s->quit, 1);
+        Py_BEGIN_ALLOW_THREADS;
+        SDL_WaitThread(s->thread, NULL);
+        Py_END_ALLOW_THREADS;
+    }
+    if (s->lock) {
+        SDL_DestroyMutex(s->lock);
+    }
+    free(s->times);
+    free(s->axes);
+    free(s);
+}
+
+static PyObject *
+joy_start_sampling(PyObject *self, PyObject *args, PyObject *kwargs)
+{
+    pgJoystickObject *jstick = (pgJoystickObject *)self;
+    SDL_Joystick *joy = jstick->joy;
+    pgJoySampler *s;
+    int rate = 1000, capacity = 4096;
+
+    static char *kwids[] = {"rate", "capacity", NULL};
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "|ii", kwids, &rate,
+                                     &capacity)) {
+        return NULL;
+    }
+    JOYSTICK_INIT_CHECK();
+    if (!joy) {
+        return RAISE(pgExc_SDLError, "Joystick not initialized");
+    }
+    if (rate <= 0 || rate > 10000) {
+        return RAISE(PyExc_ValueError, "rate must be between 1 and 10000");
+    }
+    if (capacity <= 0) {
+        return RAISE(PyExc_ValueError, "capacity must be positive");
+    }
+
+    _joy_stop_sampling(jstick);
+    if (!(s = (pgJoySampler *)calloc(1, sizeof(pgJoySampler)))) {
+        return PyErr_NoMemory();
+    }
+    s->joy = joy;
+    s->num_axes = SDL_JoystickNumAxes(joy);
+    s->num_axes = MAX(s->num_axes, 0);
+    s->capacity = capacity;
+    s->period = SDL_GetPerformanceFrequency() / rate;
+    s->times = (Uint64 *)malloc(sizeof(Uint64) * capacity);
+    s->axes = (Sint16 *)malloc(sizeof(Sint16) * capacity *
+                               (size_t)MAX(s->num_axes, 1));
+    s->counter_base = SDL_GetPerformanceCounter();
+    s->ticks_base = (double)SDL_GetTicks();
+    jstick->sampler = s;
+    if (!s->times || !s->axes) {
+        _joy_stop_sampling(jstick);
+        return PyErr_NoMemory();
+    }
+    if (!(s->lock = SDL_CreateMutex()) ||
+        !(s->thread = SDL_CreateThread(_joy_sampler_thread,
+                                       "pygame_joystick", s))) {
+        PyErr_SetString(pgExc_SDLError, SDL_GetError());
+        _joy_stop_sampling(jstick);
+        return NULL;
+    }
+    Py_RETURN_NONE;
+}
+
+static PyObject *
+joy_stop_sampling(PyObject *self, PyObject *_null)
+{
+    _joy_stop_sampling((pgJoystickObject *)self);
+    Py_RETURN_NONE;
+}
+
+static PyObject *
+joy_get_samples(PyObject *self, PyObject *_null)
+{
+    pgJoySampler *s = ((pgJoystickObject *)self)->sampler;
+    PyObject *list, *item;
+    Uint64 *times;
+    Sint16 *axes;
+    double scale;
+    int count, i, j;
+
+    if (!s) {
+        return PyList_New(0);
+    }
+
+    /* copy the samples out first, so the thread isn't blocked by the
+     * Python objects being made */
+    SDL_LockMutex(s->lock);
+    count = s->count;
+    times = (Uint64 *)malloc(sizeof(Uint64) * MAX(count, 1));
+    axes = (Sint16 *)malloc(sizeof(Sint16) * MAX(count, 1) *
+                            (size_t)MAX(s->num_axes, 1));
+    if (times && axes) {
+        for (i = 0; i < count; i++) {
+            int index = (s->head + i) % s->capacity;
+
+            times[i] = s->times[index];
+            memcpy(axes + (size_t)i * s->num_axes,
+                   s->axes + (size_t)index * s->num_axes,
+                   sizeof(Sint16) * s->num_axes);
+        }
+        s->head = (s->head + count) % s->capacity;
+        s->count = 0;
+    }
+    SDL_UnlockMutex(s->lock);
+    if (!times || !axes) {
+        free(times);
+        free(axes);
+        return PyErr_NoMemory();
+    }
+
+    scale = 1000.0 / (double)SDL_GetPerformanceFrequency();
+    if (!(list = PyList_New(count))) {
+        goto error;
+    }
+    for (i = 0; i < count; i++) {
+        PyObject *values = PyTuple_New(s->num_axes);
+
+        if (!values) {
+            goto error;
+        }
+        for (j = 0; j < s->num_axes; j++) {
+            PyObject *value = PyFloat_FromDouble(
+                axes[(size_t)i * s->num_axes + j] / 32768.0);
+
+            if (!value) {
+                Py_DECREF(values);
+                goto error;
+            }
+            PyTuple_SET_ITEM(values, j, value);
+        }
+        item = Py_BuildValue(
+            "(dN)",
+            s->ticks_base +
+                (double)(Sint64)(times[i] - s->counter_base) * scale,
+            values);
+        if (!item) {
+            goto error;
+        }
+        PyList_SET_ITEM(list, i, item);
+    }
+    free(times);
+    free(axes);
+    return list;
+
+error:
+    Py_XDECREF(list);
+    free(times);
+    free(axes);
+    return NULL;
+}
+
 static PyMethodDef joy_methods[] = {
     {"init", joy_init, METH_NOARGS, DOC_JOYSTICK_JOYSTICK_INIT},
     {"quit", joy_quit, METH_NOARGS, DOC_JOYSTICK_JOYSTICK_QUIT},
@@ -511,6 +746,12 @@ static PyMethodDef joy_methods[] = {
     {"get_numhats", joy_get_numhats, METH_NOARGS,
      DOC_JOYSTICK_JOYSTICK_GETNUMHATS},
     {"get_hat", joy_get_hat, METH_VARARGS, DOC_JOYSTICK_JOYSTICK_GETHAT},
+    {"start_sampling", (PyCFunction)joy_start_sampling,
+     METH_VARARGS | METH_KEYWORDS, DOC_JOYSTICK_JOYSTICK_STARTSAMPLING},
+    {"stop_sampling", joy_stop_sampling, METH_NOARGS,
+     DOC_JOYSTICK_JOYSTICK_STOPSAMPLING},
+    {"get_samples", joy_get_samples, METH_NOARGS,
+     DOC_JOYSTICK_JOYSTICK_GETSAMPLES},
 
     {NULL, NULL, 0, NULL}};
 
@@ -571,6 +812,7 @@ pgJoystick_New(int id)
     }
     jstick->id = id;
     jstick->joy = joy;
+    jstick->sampler = NULL;
     jstick->prev = NULL;
     jstick->next = joylist_head;
     if (joylist_head) {
@@ -250,6 +250,41 @@ get_just_released(PyObject *self, PyObject *_null)
     return ret_obj;
 }
 
+/* The views share the memory of the key states, SDL's for the held keys and
+ * event.c's for the ones pressed or released since the last pump, so they
+ * update in place and are indexed by scancode */
+static PyObject *
+key_get_pressed_view(PyObject *self, PyObject *_null)
+{
+    int num_keys;
+    const Uint8 *key_state;
+
+    VIDEO_INIT_CHECK();
+
+    key_state = SDL_GetKeyboardState(&num_keys);
+    if (!key_state || !num_keys)
+        Py_RETURN_NONE;
+    return PyMemoryView_FromMemory((char *)key_state, num_keys, PyBUF_READ);
+}
+
+static PyObject *
+key_get_just_pressed_view(PyObject *self, PyObject *_null)
+{
+    VIDEO_INIT_CHECK();
+
+    return PyMemoryView_FromMemory(pgEvent_GetKeyDownInfo(),
+                                   SDL_NUM_SCANCODES, PyBUF_READ);
+}
+
+static PyObject *
+key_get_just_released_view(PyObject *self, PyObject *_null)
+{
+    VIDEO_INIT_CHECK();
+
+    return PyMemoryView_FromMemory(pgEvent_GetKeyUpInfo(), SDL_NUM_SCANCODES,
+                                   PyBUF_READ);
+}
+
 /* Keep our own key-name table for backwards compatibility.
  * This has to be kept updated (only new things can be added, existing records
  * in this must not be changed).
@@ -582,6 +617,12 @@ static PyMethodDef _key_methods[] = {
      DOC_KEY_GETJUSTPRESSED},
     {"get_just_released", (PyCFunction)get_just_released, METH_NOARGS,
      DOC_KEY_GETJUSTRELEASED},
+    {"get_pressed_view", key_get_pressed_view, METH_NOARGS,
+     DOC_KEY_GETPRESSEDVIEW},
+    {"get_just_pressed_view", key_get_just_pressed_view, METH_NOARGS,
+     DOC_KEY_GETJUSTPRESSEDVIEW},
+    {"get_just_released_view", key_get_just_released_view, METH_NOARGS,
+     DOC_KEY_GETJUSTRELEASEDVIEW},
 
     {NULL, NULL, 0, NULL}};
 
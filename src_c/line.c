@@ -0,0 +1,525 @@
+#include "doc/geometry_doc.h"
+#include "geometry_common.h"
+#include "simd_geometry.h"
+
+static PyObject *
+_pg_line_subtype_new(PyTypeObject *type, pgLineBase *line)
+{
+    pgLineObject *line_obj =
+        (pgLineObject *)pgLine_Type.tp_new(type, NULL, NULL);
+
+    if (line_obj) {
+        line_obj->line = *line;
+    }
+    return (PyObject *)line_obj;
+}
+
+static PyObject *
+pg_line_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
+{
+    pgLineObject *self = (pgLineObject *)type->tp_alloc(type, 0);
+
+    if (self) {
+        self->line.ax = self->line.ay = 0;
+        self->line.bx = self->line.by = 0;
+        self->weakreflist = NULL;
+    }
+    return (PyObject *)self;
+}
+
+static int
+pg_line_init(pgLineObject *self, PyObject *args, PyObject *kwds)
+{
+    if (!pgLine_FromObject(args, &self->line)) {
+        PyErr_SetString(PyExc_TypeError,
+                        "Arguments must be a Line, a sequence of length 4 or "
+                        "2 points, or an object with an attribute called "
+                        "'line'");
+        return -1;
+    }
+    return 0;
+}
+
+static void
+pg_line_dealloc(pgLineObject *self)
+{
+    if (self->weakreflist) {
+        PyObject_ClearWeakRefs((PyObject *)self);
+    }
+
+    Py_TYPE(self)->tp_free((PyObject *)self);
+}
+
+static PyObject *
+pg_line_copy(pgLineObject *self, PyObject *_null)
+{
+    return _pg_line_subtype_new(Py_TYPE(self), &self->line);
+}
+
+static PyObject *
+pg_line_repr(pgLineObject *self)
+{
+    PyObject *a, *b, *result;
+
+    a = pg_tuple_couple_from_values_double(self->line.ax, self->line.ay);
+    if (!a) {
+        return NULL;
+    }
+    b = pg_tuple_couple_from_values_double(self->line.bx, self->line.by);
+    if (!b) {
+        Py_DECREF(a);
+        return NULL;
+    }
+
+    result = PyUnicode_FromFormat("<Line(%R, %R)>", a, b);
+
+    Py_DECREF(a);
+    Py_DECREF(b);
+
+    return result;
+}
+
+static PyObject *
+pg_line_move(pgLineObject *self, PyObject *const *args, Py_ssize_t nargs)
+{
+    pgLineBase line = self->line;
+    double Dx, Dy;
+
+    if (!pg_TwoDoublesFromFastcallArgs(args, nargs, &Dx, &Dy)) {
+        return RAISE(PyExc_TypeError, "move requires a pair of numbers");
+    }
+
+    line.ax += Dx;
+    line.ay += Dy;
+    line.bx += Dx;
+    line.by += Dy;
+    return _pg_line_subtype_new(Py_TYPE(self), &line);
+}
+
+static PyObject *
+pg_line_move_ip(pgLineObject *self, PyObject *const *args, Py_ssize_t nargs)
+{
+    double Dx, Dy;
+
+    if (!pg_TwoDoublesFromFastcallArgs(args, nargs, &Dx, &Dy)) {
+        return RAISE(PyExc_TypeError, "move_ip requires a pair of numbers");
+    }
+
+    self->line.ax += Dx;
+    self->line.ay += Dy;
+    self->line.bx += Dx;
+    self->line.by += Dy;
+
+    Py_RETURN_NONE;
+}
+
+static PyObject *
+pg_line_update(pgLineObject *self, PyObject *const *args, Py_ssize_t nargs)
+{
+    if (!pgLine_FromObjectFastcall(args, nargs, &self->line)) {
+        return RAISE(PyExc_TypeError,
+                     "Line.update requires a line or LineLike object");
+    }
+    Py_RETURN_NONE;
+}
+
+/* Where the line first touches the polygon, an edge or its inside */
+static double
+_pg_line_polygon_t(const double *line, const pgPolygonObject *polygon)
+{
+    const double *v = polygon->vertices;
+    const Py_ssize_t n = polygon->verts_num;
+    double t, best;
+    Py_ssize_t i;
+
+    if (!n || _pg_polygon_collidepoint(polygon, line[0], line[1])) {
+        return n ? 0.0 : INFINITY;
+    }
+    best = _pg_line_hit_segment(line, v[2 * n - 2], v[2 * n - 1], v[0], v[1]);
+    for (i = 0; i < n - 1; i++) {
+        t = _pg_line_hit_segment(line, v[2 * i], v[2 * i + 1], v[2 * i + 2],
+                                 v[2 * i + 3]);
+        best = t < best ? t : best;
+    }
+    return best;
+}
+
+/* Where the line first touches a shape, INFINITY when it doesn't. Returns 0
+ * with an exception set when the argument isn't a shape. */
+static int
+_pg_line_shape_t(const double *line, PyObject *shape, double *t)
+{
+    if (pgRect_Check(shape)) {
+        SDL_Rect *r = &pgRect_AsRect(shape);
+        double x0 = r->x, y0 = r->y, x1 = x0 + r->w, y1 = y0 + r->h;
+        *t = _pg_line_hit_rect(line, MIN(x0, x1), MIN(y0, y1), MAX(x0, x1),
+                               MAX(y0, y1));
+    }
+    else if (pgFRect_Check(shape)) {
+        SDL_FRect *r = &pgFRect_AsRect(shape);
+        double x0 = r->x, y0 = r->y, x1 = x0 + r->w, y1 = y0 + r->h;
+        *t = _pg_line_hit_rect(line, MIN(x0, x1), MIN(y0, y1), MAX(x0, x1),
+                               MAX(y0, y1));
+    }
+    else if (pgCircle_Check(shape)) {
+        pgCircleBase *c = &pgCircle_AsCircle(shape);
+        *t = _pg_line_hit_circle(line, c->x, c->y, c->r);
+    }
+    else if (pgLine_Check(shape)) {
+        pgLineBase *l = &pgLine_AsLine(shape);
+        *t = _pg_line_hit_segment(line, l->ax, l->ay, l->bx, l->by);
+    }
+    else if (pgPolygon_Check(shape)) {
+        *t = _pg_line_polygon_t(line, pgPolygon_CAST(shape));
+    }
+    else {
+        PyErr_Format(PyExc_TypeError,
+                     "Invalid shape argument, must be a Rect / FRect, "
+                     "Circle, Line or Polygon, not '%s'",
+                     Py_TYPE(shape)->tp_name);
+        return 0;
+    }
+    return 1;
+}
+
+static PyObject *
+pg_line_collideswith(pgLineObject *self, PyObject *arg)
+{
+    const double line[4] = {self->line.ax, self->line.ay, self->line.bx,
+                            self->line.by};
+    double t;
+
+    if (!_pg_line_shape_t(line, arg, &t)) {
+        return NULL;
+    }
+    return PyBool_FromLong(t != INFINITY);
+}
+
+/* The generic raycast kernels, see simd_geometry.h */
+void
+line_hit_segments(const double *line, const double *x0, const double *y0,
+                  const double *x1, const double *y1, Py_ssize_t n, double *t)
+{
+    Py_ssize_t i;
+    for (i = 0; i < n; i++) {
+        t[i] = _pg_line_hit_segment(line, x0[i], y0[i], x1[i], y1[i]);
+    }
+}
+
+void
+line_hit_rects(const double *line, const double *x0, const double *y0,
+               const double *x1, const double *y1, Py_ssize_t n, double *t)
+{
+    Py_ssize_t i;
+    for (i = 0; i < n; i++) {
+        t[i] = _pg_line_hit_rect(line, x0[i], y0[i], x1[i], y1[i]);
+    }
+}
+
+void
+line_hit_circles(const double *line, const double *x, const double *y,
+                 const double *r, Py_ssize_t n, double *t)
+{
+    Py_ssize_t i;
+    for (i = 0; i < n; i++) {
+        t[i] = _pg_line_hit_circle(line, x[i], y[i], r[i]);
+    }
+}
+
+/* The fastest raycast kernels the CPU supports. */
+static void
+_pg_line_get_kernels(LINE_HIT_BOXES_P *segments, LINE_HIT_BOXES_P *rects,
+                     LINE_HIT_CIRCLES_P *circles)
+{
+#if !defined(__EMSCRIPTEN__)
+    if (_pg_geometry_has_avx2()) {
+        *segments = line_hit_segments_avx2;
+        *rects = line_hit_rects_avx2;
+        *circles = line_hit_circles_avx2;
+        return;
+    }
+#if PG_ENABLE_SSE_NEON
+    else if (_pg_geometry_HasSSE_NEON()) {
+        *segments = line_hit_segments_sse2;
+        *rects = line_hit_rects_sse2;
+        *circles = line_hit_circles_sse2;
+        return;
+    }
+#endif /* PG_ENABLE_SSE_NEON */
+#endif /* !__EMSCRIPTEN__ */
+    *segments = line_hit_segments;
+    *rects = line_hit_rects;
+    *circles = line_hit_circles;
+}
+
+/* The raycast kernels are picked on every call */
+static int
+_pg_line_simd_dispatch(PyObject *dispatch)
+{
+    int has_avx2 = 0, has_sse2_neon = 0;
+
+#if !defined(__EMSCRIPTEN__)
+    has_avx2 = _pg_geometry_has_avx2();
+#if PG_ENABLE_SSE_NEON
+    has_sse2_neon = _pg_geometry_HasSSE_NEON();
+#endif /* PG_ENABLE_SSE_NEON */
+#endif /* __EMSCRIPTEN__ */
+    return pg_simd_report(dispatch, "raycast",
+                          pg_simd_backend_name(has_avx2, has_sse2_neon));
+}
+
+static double
+_pg_line_nearest(const double *t, Py_ssize_t n, double best)
+{
+    Py_ssize_t i;
+    for (i = 0; i < n; i++) {
+        best = t[i] < best ? t[i] : best;
+    }
+    return best;
+}
+
+/* Stores a rect normalized into the packed arrays of raycast */
+#define PG_LINE_PACK_RECT(r, rects, n, i)                  \
+    {                                                      \
+        double x0 = (r)->x, y0 = (r)->y;                   \
+        double x1 = x0 + (r)->w, y1 = y0 + (r)->h;         \
+        (rects)[i] = MIN(x0, x1);                          \
+        (rects)[(n) + (i)] = MIN(y0, y1);                  \
+        (rects)[2 * (n) + (i)] = MAX(x0, x1);              \
+        (rects)[3 * (n) + (i)] = MAX(y0, y1);              \
+    }
+
+static PyObject *
+pg_line_raycast(pgLineObject *self, PyObject *arg)
+{
+    const double line[4] = {self->line.ax, self->line.ay, self->line.bx,
+                            self->line.by};
+    LINE_HIT_BOXES_P hit_segments, hit_rects;
+    LINE_HIT_CIRCLES_P hit_circles;
+    PyObject *seq, **items, *shape;
+    Py_ssize_t i, size, nsegs = 0, nrects = 0, ncircles = 0;
+    Py_ssize_t iseg = 0, irect = 0, icircle = 0;
+    double *buf, *segs, *rects, *circles, *t, best = INFINITY;
+
+    seq = PySequence_Fast(arg, "Expected a sequence of shapes");
+    if (!seq) {
+        return NULL;
+    }
+    items = PySequence_Fast_ITEMS(seq);
+    size = PySequence_Fast_GET_SIZE(seq);
+
+    /* size the packed arrays, polygons are done one by one */
+    for (i = 0; i < size; i++) {
+        shape = items[i];
+        if (pgRect_Check(shape) || pgFRect_Check(shape)) {
+            nrects++;
+        }
+        else if (pgCircle_Check(shape)) {
+            ncircles++;
+        }
+        else if (pgLine_Check(shape)) {
+            nsegs++;
+        }
+        else if (!pgPolygon_Check(shape)) {
+            PyErr_Format(PyExc_TypeError,
+                         "Invalid shape at index %zd, must be a Rect / "
+                         "FRect, Circle, Line or Polygon, not '%s'",
+                         i, Py_TYPE(shape)->tp_name);
+            Py_DECREF(seq);
+            return NULL;
+        }
+    }
+
+    /* one array per coordinate, so the kernels load whole SIMD vectors */
+    buf = PyMem_New(double, 4 * nsegs + 4 * nrects + 3 * ncircles +
+                                MAX(MAX(nsegs, nrects), ncircles) + 1);
+    if (!buf) {
+        Py_DECREF(seq);
+        return PyErr_NoMemory();
+    }
+    segs = buf;
+    rects = segs + 4 * nsegs;
+    circles = rects + 4 * nrects;
+    t = circles + 3 * ncircles;
+
+    for (i = 0; i < size; i++) {
+        shape = items[i];
+        if (pgRect_Check(shape)) {
+            PG_LINE_PACK_RECT(&pgRect_AsRect(shape), rects, nrects, irect);
+            irect++;
+        }
+        else if (pgFRect_Check(shape)) {
+            PG_LINE_PACK_RECT(&pgFRect_AsRect(shape), rects, nrects, irect);
+            irect++;
+        }
+        else if (pgCircle_Check(shape)) {
+            pgCircleBase *c = &pgCircle_AsCircle(shape);
+            circles[icircle] = c->x;
+            circles[ncircles + icircle] = c->y;
+            circles[2 * ncircles + icircle] = c->r;
+            icircle++;
+        }
+        else if (pgLine_Check(shape)) {
+            pgLineBase *l = &pgLine_AsLine(shape);
+            segs[iseg] = l->ax;
+            segs[nsegs + iseg] = l->ay;
+            segs[2 * nsegs + iseg] = l->bx;
+            segs[3 * nsegs + iseg] = l->by;
+            iseg++;
+        }
+        else {
+            double pt = _pg_line_polygon_t(line, pgPolygon_CAST(shape));
+            best = pt < best ? pt : best;
+        }
+    }
+    Py_DECREF(seq);
+
+    _pg_line_get_kernels(&hit_segments, &hit_rects, &hit_circles);
+    hit_segments(line, segs, segs + nsegs, segs + 2 * nsegs,
+                 segs + 3 * nsegs, nsegs, t);
+    best = _pg_line_nearest(t, nsegs, best);
+    hit_rects(line, rects, rects + nrects, rects + 2 * nrects,
+              rects + 3 * nrects, nrects, t);
+    best = _pg_line_nearest(t, nrects, best);
+    hit_circles(line, circles, circles + ncircles, circles + 2 * ncircles,
+                ncircles, t);
+    best = _pg_line_nearest(t, ncircles, best);
+    PyMem_Free(buf);
+
+    if (best == INFINITY) {
+        Py_RETURN_NONE;
+    }
+    return pg_tuple_couple_from_values_double(
+        line[0] + best * (line[2] - line[0]),
+        line[1] + best * (line[3] - line[1]));
+}
+
+#undef PG_LINE_PACK_RECT
+
+static struct PyMethodDef pg_line_methods[] = {
+    {"move", (PyCFunction)pg_line_move, METH_FASTCALL, DOC_LINE_MOVE},
+    {"move_ip", (PyCFunction)pg_line_move_ip, METH_FASTCALL,
+     DOC_LINE_MOVEIP},
+    {"update", (PyCFunction)pg_line_update, METH_FASTCALL, DOC_LINE_UPDATE},
+    {"collideswith", (PyCFunction)pg_line_collideswith, METH_O,
+     DOC_LINE_COLLIDESWITH},
+    {"raycast", (PyCFunction)pg_line_raycast, METH_O, DOC_LINE_RAYCAST},
+    {"__copy__", (PyCFunction)pg_line_copy, METH_NOARGS, DOC_LINE_COPY},
+    {"copy", (PyCFunction)pg_line_copy, METH_NOARGS, DOC_LINE_COPY},
+    {NULL, NULL, 0, NULL}};
+
+#define GETTER_SETTER(name)                                               \
+    static PyObject *pg_line_get##name(pgLineObject *self, void *closure) \
+    {                                                                     \
+        return PyFloat_FromDouble(self->line.name);                       \
+    }                                                                     \
+    static int pg_line_set##name(pgLineObject *self, PyObject *value,     \
+                                 void *closure)                           \
+    {                                                                     \
+        double val;                                                       \
+        DEL_ATTR_NOT_SUPPORTED_CHECK_NO_NAME(value);                      \
+        if (!pg_DoubleFromObj(value, &val)) {                             \
+            PyErr_Format(PyExc_TypeError, "Expected a number, got '%s'",  \
+                         Py_TYPE(value)->tp_name);                        \
+            return -1;                                                    \
+        }                                                                 \
+        self->line.name = val;                                            \
+        return 0;                                                         \
+    }
+
+GETTER_SETTER(ax)
+GETTER_SETTER(ay)
+GETTER_SETTER(bx)
+GETTER_SETTER(by)
+
+#undef GETTER_SETTER
+
+static PyObject *
+pg_line_geta(pgLineObject *self, void *closure)
+{
+    return pg_tuple_couple_from_values_double(self->line.ax, self->line.ay);
+}
+
+static int
+pg_line_seta(pgLineObject *self, PyObject *value, void *closure)
+{
+    DEL_ATTR_NOT_SUPPORTED_CHECK_NO_NAME(value);
+    if (!pg_TwoDoublesFromObj(value, &self->line.ax, &self->line.ay)) {
+        PyErr_SetString(PyExc_TypeError, "Expected a sequence of 2 numbers");
+        return -1;
+    }
+    return 0;
+}
+
+static PyObject *
+pg_line_getb(pgLineObject *self, void *closure)
+{
+    return pg_tuple_couple_from_values_double(self->line.bx, self->line.by);
+}
+
+static int
+pg_line_setb(pgLineObject *self, PyObject *value, void *closure)
+{
+    DEL_ATTR_NOT_SUPPORTED_CHECK_NO_NAME(value);
+    if (!pg_TwoDoublesFromObj(value, &self->line.bx, &self->line.by)) {
+        PyErr_SetString(PyExc_TypeError, "Expected a sequence of 2 numbers");
+        return -1;
+    }
+    return 0;
+}
+
+static PyObject *
+pg_line_getlength(pgLineObject *self, void *closure)
+{
+    return PyFloat_FromDouble(hypot(self->line.bx - self->line.ax,
+                                    self->line.by - self->line.ay));
+}
+
+static PyObject *
+pg_line_richcompare(PyObject *self, PyObject *other, int op)
+{
+    pgLineBase l1, l2;
+    int equal;
+
+    if (!pgLine_FromObject(self, &l1) || !pgLine_FromObject(other, &l2)) {
+        equal = 0;
+    }
+    else {
+        equal = double_compare(l1.ax, l2.ax) && double_compare(l1.ay, l2.ay) &&
+                double_compare(l1.bx, l2.bx) && double_compare(l1.by, l2.by);
+    }
+
+    switch (op) {
+        case Py_EQ:
+            return PyBool_FromLong(equal);
+        case Py_NE:
+            return PyBool_FromLong(!equal);
+        default:
+            Py_RETURN_NOTIMPLEMENTED;
+    }
+}
+
+static PyGetSetDef pg_line_getsets[] = {
+    {"ax", (getter)pg_line_getax, (setter)pg_line_setax, DOC_LINE_AX, NULL},
+    {"ay", (getter)pg_line_getay, (setter)pg_line_setay, DOC_LINE_AY, NULL},
+    {"bx", (getter)pg_line_getbx, (setter)pg_line_setbx, DOC_LINE_BX, NULL},
+    {"by", (getter)pg_line_getby, (setter)pg_line_setby, DOC_LINE_BY, NULL},
+    {"a", (getter)pg_line_geta, (setter)pg_line_seta, DOC_LINE_A, NULL},
+    {"b", (getter)pg_line_getb, (setter)pg_line_setb, DOC_LINE_B, NULL},
+    {"length", (getter)pg_line_getlength, NULL, DOC_LINE_LENGTH, NULL},
+    {NULL, 0, NULL, NULL, NULL}};
+
+static PyTypeObject pgLine_Type = {
+    PyVarObject_HEAD_INIT(NULL, 0).tp_name = "pygame.geometry.Line",
+    .tp_basicsize = sizeof(pgLineObject),
+    .tp_dealloc = (destructor)pg_line_dealloc,
+    .tp_repr = (reprfunc)pg_line_repr,
+    .tp_flags = Py_TPFLAGS_DEFAULT | Py_TPFLAGS_BASETYPE,
+    .tp_doc = DOC_LINE,
+    .tp_weaklistoffset = offsetof(pgLineObject, weakreflist),
+    .tp_methods = pg_line_methods,
+    .tp_getset = pg_line_getsets,
+    .tp_init = (initproc)pg_line_init,
+    .tp_new = pg_line_new,
+    .tp_richcompare = pg_line_richcompare,
+};
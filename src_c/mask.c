@@ -35,6 +35,8 @@
 
 #include "doc/mask_doc.h"
 
+#include "simd_mask.h"
+
 #include "structmember.h"
 
 #include <math.h>
@@ -70,6 +72,541 @@ abs_diff_uint32(Uint32 a, Uint32 b)
     return (a > b) ? a - b : b - a;
 }
 
+/* Frees the shifted copies made by Mask.prepare_shifts() and the cached
+ * outline. Must be called whenever the bits of the mask change. */
+static void
+mask_drop_caches(pgMaskObject *maskobj)
+{
+    int i;
+
+    if (NULL != maskobj->outline) {
+        PyMem_RawFree(maskobj->outline);
+        maskobj->outline = NULL;
+        maskobj->outline_len = 0;
+    }
+    if (NULL == maskobj->shifts) {
+        return;
+    }
+    for (i = 1; i < (int)BITMASK_W_LEN; ++i) {
+        if (NULL != maskobj->shifts[i]) {
+            bitmask_free(maskobj->shifts[i]);
+        }
+    }
+    PyMem_Free(maskobj->shifts);
+    maskobj->shifts = NULL;
+}
+
+/* Large masks keep the state of each block of BITMASK_W_LEN words of one
+ * stripe (BITMASK_W_LEN x BITMASK_W_LEN bits) in maskobj->blocks, stored like
+ * the words of a bitmask: blocks[stripe * MASK_BLOCK_ROWS(mask) + row / W].
+ * A block is scanned the first time it is needed. Setting bits marks their
+ * blocks as used and clearing bits leaves them used, so a block in the
+ * MASK_BLOCK_EMPTY state never has set bits.
+ */
+#define MASK_BLOCK_UNKNOWN 0
+#define MASK_BLOCK_EMPTY 1
+#define MASK_BLOCK_USED 2
+
+/* Masks with fewer blocks than this don't keep block states. */
+#define MASK_BLOCKS_MIN 16
+
+#define MASK_STRIPES(m) (((m)->w - 1) / (int)BITMASK_W_LEN + 1)
+#define MASK_BLOCK_ROWS(m) (((m)->h - 1) / (int)BITMASK_W_LEN + 1)
+
+/* Forgets the block states, for changes that can't be tracked. */
+static void
+mask_drop_blocks(pgMaskObject *maskobj)
+{
+    PyMem_Free(maskobj->blocks);
+    maskobj->blocks = NULL;
+}
+
+/* Returns the block states of the mask, all unknown when they are first
+ * made. Returns NULL, without an exception set, if the mask is too small,
+ * its buffer is exported or there is no memory for them. */
+static unsigned char *
+mask_get_blocks(pgMaskObject *maskobj)
+{
+    bitmask_t *m = maskobj->mask;
+    int n;
+
+    if (NULL != maskobj->blocks || NULL != maskobj->bufdata || !m->w ||
+        !m->h) {
+        return maskobj->blocks;
+    }
+
+    n = MASK_STRIPES(m) * MASK_BLOCK_ROWS(m);
+    if (n >= MASK_BLOCKS_MIN) {
+        /* MASK_BLOCK_UNKNOWN is 0 */
+        maskobj->blocks = PyMem_Calloc(n, 1);
+    }
+    return maskobj->blocks;
+}
+
+/* Sets the state of all the blocks, after filling or clearing the mask. */
+static void
+mask_set_blocks(pgMaskObject *maskobj, unsigned char state)
+{
+    bitmask_t *m = maskobj->mask;
+
+    if (NULL != maskobj->blocks) {
+        memset(maskobj->blocks, state,
+               MASK_STRIPES(m) * MASK_BLOCK_ROWS(m));
+    }
+}
+
+/* Marks the blocks of the given area (clipped to the mask) as used, after
+ * bits in it have been set. */
+static void
+mask_mark_blocks(pgMaskObject *maskobj, int x, int y, int w, int h)
+{
+    bitmask_t *m = maskobj->mask;
+    int i, j, x2, y2, block_rows;
+
+    if (NULL == maskobj->blocks) {
+        return;
+    }
+    if (x < 0) {
+        w += x;
+        x = 0;
+    }
+    if (y < 0) {
+        h += y;
+        y = 0;
+    }
+    if (w <= 0 || h <= 0 || x >= m->w || y >= m->h) {
+        return;
+    }
+    x2 = (w > m->w - x) ? m->w : x + w;
+    y2 = (h > m->h - y) ? m->h : y + h;
+
+    block_rows = MASK_BLOCK_ROWS(m);
+    for (i = x / (int)BITMASK_W_LEN; i <= (x2 - 1) / (int)BITMASK_W_LEN;
+         ++i) {
+        for (j = y / (int)BITMASK_W_LEN; j <= (y2 - 1) / (int)BITMASK_W_LEN;
+             ++j) {
+            maskobj->blocks[i * block_rows + j] = MASK_BLOCK_USED;
+        }
+    }
+}
+
+/* Returns 1 if the block holding row y of stripe i is empty, scanning it if
+ * its state is unknown. Always 0 without block states. */
+static int
+block_is_empty(const bitmask_t *m, unsigned char *blocks, int i, int y)
+{
+    const BITMASK_W *p, *end;
+    unsigned char *state;
+    BITMASK_W bits = 0;
+
+    if (NULL == blocks) {
+        return 0;
+    }
+
+    state = blocks + i * MASK_BLOCK_ROWS(m) + y / (int)BITMASK_W_LEN;
+    if (MASK_BLOCK_UNKNOWN == *state) {
+        y -= y % (int)BITMASK_W_LEN;
+        p = m->bits + i * m->h + y;
+        end = p + MIN((int)BITMASK_W_LEN, m->h - y);
+        for (; p < end; ++p) {
+            bits |= *p;
+        }
+        *state = bits ? MASK_BLOCK_USED : MASK_BLOCK_EMPTY;
+    }
+    return MASK_BLOCK_EMPTY == *state;
+}
+
+/* Returns 1 if the blocks holding rows y to y2 - 1 of stripe i are empty. */
+static int
+rows_are_empty(const bitmask_t *m, unsigned char *blocks, int i, int y,
+               int y2)
+{
+    if (NULL == blocks) {
+        return 0;
+    }
+    for (; y < y2; y += (int)BITMASK_W_LEN - y % (int)BITMASK_W_LEN) {
+        if (!block_is_empty(m, blocks, i, y)) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+/* Index of the lowest set bit, w must not be 0. */
+static PG_INLINE int
+lowest_set_bit(BITMASK_W w)
+{
+#ifdef __GNUC__
+    return __builtin_ctzl(w);
+#else
+    int i = 0;
+
+    while (!(w & 1)) {
+        w >>= 1;
+        ++i;
+    }
+    return i;
+#endif /* __GNUC__ */
+}
+
+/* The fastest and_count kernel the CPU supports. */
+static MASK_AND_COUNT_P
+get_and_count_kernel(void)
+{
+#if !defined(__EMSCRIPTEN__)
+    if (_pg_mask_has_avx2()) {
+        return mask_and_count_avx2;
+    }
+#if PG_ENABLE_SSE_NEON
+    else if (_pg_mask_HasSSE_NEON()) {
+        return mask_and_count_sse2;
+    }
+#endif /* PG_ENABLE_SSE_NEON */
+#endif /* !__EMSCRIPTEN__ */
+    return mask_and_count;
+}
+
+/* The fastest to_surface row kernel the CPU supports. */
+static MASK_TO_SURFACE_ROW_P
+get_to_surface_kernel(void)
+{
+#if !defined(__EMSCRIPTEN__)
+    if (_pg_mask_has_avx2()) {
+        return mask_to_surface_row_avx2;
+    }
+#if PG_ENABLE_SSE_NEON
+    else if (_pg_mask_HasSSE_NEON()) {
+        return mask_to_surface_row_sse2;
+    }
+#endif /* PG_ENABLE_SSE_NEON */
+#endif /* !__EMSCRIPTEN__ */
+    return mask_to_surface_row;
+}
+
+/* Hands the fastest bitmask.h kernels the CPU supports to bitmask.c, which
+ * keeps its portable ones otherwise. */
+static void
+set_bitmask_kernels(void)
+{
+#if !defined(__EMSCRIPTEN__)
+    bitmask_kernels_t kernels;
+
+    /* the portable ones, unless replaced below */
+    bitmask_set_kernels(NULL);
+    if (_pg_mask_has_avx2()) {
+        kernels.count = mask_count_words_avx2;
+        kernels.invert = mask_invert_words_avx2;
+        kernels.draw = mask_draw_words_avx2;
+        kernels.erase = mask_erase_words_avx2;
+        kernels.overlap = mask_overlap_words_avx2;
+        bitmask_set_kernels(&kernels);
+    }
+#if PG_ENABLE_SSE_NEON
+    else if (_pg_mask_HasSSE_NEON()) {
+        kernels.count = mask_count_words_sse2;
+        kernels.invert = mask_invert_words_sse2;
+        kernels.draw = mask_draw_words_sse2;
+        kernels.erase = mask_erase_words_sse2;
+        kernels.overlap = mask_overlap_words_sse2;
+        bitmask_set_kernels(&kernels);
+    }
+#endif /* PG_ENABLE_SSE_NEON */
+#endif /* !__EMSCRIPTEN__ */
+}
+
+/* The block_overlap_* functions walk the overlapping area of a and b (at
+ * xoffset, yoffset) one stripe of a at a time, in chunks of the rows of one
+ * block, and skip the chunks that are empty in either mask. The block states
+ * ablocks and bblocks can be NULL.
+ *
+ * Word row y of stripe i of a lines up with row y - yoffset of
+ * (b1 >> t) | (b2 << (BITMASK_W_LEN - t)), where b1 and b2 are stripes j and
+ * j + 1 of b, and b2 is only used if t isn't 0. block_stripes() finds j, t
+ * and the two stripes, which are NULL if they are outside of b.
+ */
+static void
+block_stripes(const bitmask_t *b, int i, int xoffset, int *j, int *t,
+              const BITMASK_W **b1, const BITMASK_W **b2)
+{
+    int s = xoffset & BITMASK_W_MASK;
+    int q = (xoffset - s) / (int)BITMASK_W_LEN;
+    int bstripes = MASK_STRIPES(b);
+
+    *j = s ? i - q - 1 : i - q;
+    *t = s ? (int)BITMASK_W_LEN - s : 0;
+    *b1 = (*j >= 0 && *j < bstripes) ? b->bits + *j * b->h : NULL;
+    *b2 = (s && *j + 1 >= 0 && *j + 1 < bstripes)
+              ? b->bits + (*j + 1) * b->h
+              : NULL;
+}
+
+/* The end of the chunk of rows starting at y, which has to be before y2. */
+static PG_INLINE int
+block_chunk_end(int y, int y2, int use_blocks)
+{
+    int left = (int)BITMASK_W_LEN - y % (int)BITMASK_W_LEN;
+
+    return (use_blocks && y2 - y > left) ? y + left : y2;
+}
+
+/* Sets up the overlapping area for the block_overlap_* functions, returns 0
+ * if there is none. The area is x1 to x2 - 1 and y1 to y2 - 1 of mask a. */
+static int
+block_overlap_rect(const bitmask_t *a, const bitmask_t *b, int xoffset,
+                   int yoffset, int *x1, int *x2, int *y1, int *y2)
+{
+    /* Return if no overlap or one mask has a width/height of 0. */
+    if ((xoffset >= a->w) || (yoffset >= a->h) || (yoffset <= -b->h) ||
+        (xoffset <= -b->w) || (!a->h) || (!a->w) || (!b->h) || (!b->w)) {
+        return 0;
+    }
+    *x1 = MAX(xoffset, 0);
+    *x2 = (xoffset > a->w - b->w) ? a->w : xoffset + b->w;
+    *y1 = MAX(yoffset, 0);
+    *y2 = (yoffset > a->h - b->h) ? a->h : yoffset + b->h;
+    return 1;
+}
+
+/* Returns 1 if the chunk of rows y to y2 - 1 of stripe i of a can be
+ * skipped. */
+static PG_INLINE int
+block_chunk_is_empty(const bitmask_t *a, unsigned char *ablocks,
+                     const bitmask_t *b, unsigned char *bblocks, int i,
+                     int j, const BITMASK_W *b1, const BITMASK_W *b2, int y,
+                     int y2, int yoffset)
+{
+    return block_is_empty(a, ablocks, i, y) ||
+           ((!b1 || rows_are_empty(b, bblocks, j, y - yoffset,
+                                   y2 - yoffset)) &&
+            (!b2 || rows_are_empty(b, bblocks, j + 1, y - yoffset,
+                                   y2 - yoffset)));
+}
+
+/* Same as bitmask_overlap_area(). With t == 0 the words of the masks line
+ * up, and the rows of each chunk are counted by the and_count kernel.
+ */
+static int
+block_overlap_area(const bitmask_t *a, unsigned char *ablocks,
+                   const bitmask_t *b, unsigned char *bblocks, int xoffset,
+                   int yoffset)
+{
+    MASK_AND_COUNT_P and_count = get_and_count_kernel();
+    const BITMASK_W *ap, *b1, *b2;
+    BITMASK_W word;
+    unsigned int count = 0;
+    int use_blocks = NULL != ablocks || NULL != bblocks;
+    int x1, x2, y1, y2, i, j, t, y, yend, row;
+
+    if (!block_overlap_rect(a, b, xoffset, yoffset, &x1, &x2, &y1, &y2)) {
+        return 0;
+    }
+
+    for (i = x1 / (int)BITMASK_W_LEN; i <= (x2 - 1) / (int)BITMASK_W_LEN;
+         ++i) {
+        block_stripes(b, i, xoffset, &j, &t, &b1, &b2);
+        ap = a->bits + i * a->h;
+        for (y = y1; y < y2; y = yend) {
+            yend = block_chunk_end(y, y2, use_blocks);
+            if (block_chunk_is_empty(a, ablocks, b, bblocks, i, j, b1, b2, y,
+                                     yend, yoffset)) {
+                continue;
+            }
+            if (!t) {
+                count += and_count(ap + y, b1 + (y - yoffset), yend - y);
+                continue;
+            }
+            for (row = y; row < yend; ++row) {
+                word = b1 ? b1[row - yoffset] >> t : 0;
+                if (b2) {
+                    word |= b2[row - yoffset] << (BITMASK_W_LEN - t);
+                }
+                count += _pg_mask_bitcount(ap[row] & word);
+            }
+        }
+    }
+    return (int)count;
+}
+
+/* Same as bitmask_overlap_mask() for a c that is the size of a and clear. */
+static void
+block_overlap_mask(const bitmask_t *a, unsigned char *ablocks,
+                   const bitmask_t *b, unsigned char *bblocks, bitmask_t *c,
+                   int xoffset, int yoffset)
+{
+    const BITMASK_W *ap, *b1, *b2;
+    BITMASK_W *cp, word;
+    int use_blocks = NULL != ablocks || NULL != bblocks;
+    int x1, x2, y1, y2, i, j, t, y, yend, row;
+
+    if (!block_overlap_rect(a, b, xoffset, yoffset, &x1, &x2, &y1, &y2)) {
+        return;
+    }
+
+    for (i = x1 / (int)BITMASK_W_LEN; i <= (x2 - 1) / (int)BITMASK_W_LEN;
+         ++i) {
+        block_stripes(b, i, xoffset, &j, &t, &b1, &b2);
+        ap = a->bits + i * a->h;
+        cp = c->bits + i * c->h;
+        for (y = y1; y < y2; y = yend) {
+            yend = block_chunk_end(y, y2, use_blocks);
+            if (block_chunk_is_empty(a, ablocks, b, bblocks, i, j, b1, b2, y,
+                                     yend, yoffset)) {
+                continue;
+            }
+            for (row = y; row < yend; ++row) {
+                word = b1 ? b1[row - yoffset] >> t : 0;
+                if (b2) {
+                    word |= b2[row - yoffset] << (BITMASK_W_LEN - t);
+                }
+                cp[row] = ap[row] & word;
+            }
+        }
+    }
+}
+
+/* Same as bitmask_overlap_pos() for an xoffset >= 0. Like
+ * bitmask_overlap_pos(), each stripe of a is searched for the high bits of
+ * b1 first and then for the low bits of b2, so the same point is found.
+ */
+static int
+block_overlap_pos(const bitmask_t *a, unsigned char *ablocks,
+                  const bitmask_t *b, unsigned char *bblocks, int xoffset,
+                  int yoffset, int *x, int *y)
+{
+    const BITMASK_W *ap, *bp, *b1, *b2;
+    BITMASK_W word;
+    int use_blocks = NULL != ablocks || NULL != bblocks;
+    int x1, x2, y1, y2, i, j, t, pass, row, rowend, r;
+
+    if (!block_overlap_rect(a, b, xoffset, yoffset, &x1, &x2, &y1, &y2)) {
+        return 0;
+    }
+
+    for (i = x1 / (int)BITMASK_W_LEN; i <= (x2 - 1) / (int)BITMASK_W_LEN;
+         ++i) {
+        block_stripes(b, i, xoffset, &j, &t, &b1, &b2);
+        ap = a->bits + i * a->h;
+        for (pass = 0; pass < 2; ++pass) {
+            bp = pass ? b2 : b1;
+            if (NULL == bp) {
+                continue;
+            }
+            for (row = y1; row < y2; row = rowend) {
+                rowend = block_chunk_end(row, y2, use_blocks);
+                if (block_is_empty(a, ablocks, i, row) ||
+                    rows_are_empty(b, bblocks, j + pass, row - yoffset,
+                                   rowend - yoffset)) {
+                    continue;
+                }
+                for (r = row; r < rowend; ++r) {
+                    word = pass ? bp[r - yoffset] << (BITMASK_W_LEN - t)
+                                : bp[r - yoffset] >> t;
+                    word &= ap[r];
+                    if (word) {
+                        *x = i * (int)BITMASK_W_LEN + lowest_set_bit(word);
+                        *y = r;
+                        return 1;
+                    }
+                }
+            }
+        }
+    }
+    return 0;
+}
+
+/* Same as bitmask_count(), recording the state of the blocks on the way. */
+static unsigned int
+block_count(const bitmask_t *m, unsigned char *blocks)
+{
+    const BITMASK_W *p, *end;
+    unsigned int total = 0, count;
+    int i, y;
+
+    for (i = 0; i < MASK_STRIPES(m); ++i) {
+        for (y = 0; y < m->h; y += (int)BITMASK_W_LEN, ++blocks) {
+            if (MASK_BLOCK_EMPTY == *blocks) {
+                continue;
+            }
+            p = m->bits + i * m->h + y;
+            end = p + MIN((int)BITMASK_W_LEN, m->h - y);
+            for (count = 0; p < end; ++p) {
+                count += _pg_mask_bitcount(*p);
+            }
+            *blocks = count ? MASK_BLOCK_USED : MASK_BLOCK_EMPTY;
+            total += count;
+        }
+    }
+    return total;
+}
+
+/* Same as bitmask_overlap_pos(a, b, xoffset, yoffset, x, y) for an
+ * xoffset >= 0, that isn't a multiple of BITMASK_W_LEN. bs is the copy of b
+ * shifted right by shift = xoffset % BITMASK_W_LEN bits, so its words line
+ * up with the words of a.
+ *
+ * bitmask_overlap_pos() tests each word of a against the high bits of the
+ * b word to its left first, then against the low bits of the b word itself.
+ * The same point is found here by looking at both parts of the bs word in
+ * one pass, remembering the first hit of the second part.
+ */
+static int
+shifted_overlap_pos(const bitmask_t *a, const bitmask_t *bs, int shift,
+                    int xoffset, int yoffset, int *x, int *y)
+{
+    const BITMASK_W *a_entry, *b_entry;
+    const BITMASK_W lowbits = BITMASK_N(shift) - 1;
+    BITMASK_W word, high_word = 0;
+    unsigned int i, xbase, stripes;
+    int row, rows, high_row;
+
+    /* Return if no overlap or one mask has a width/height of 0. */
+    if ((xoffset >= a->w) || (yoffset >= a->h) || (yoffset <= -bs->h) ||
+        (!a->h) || (!a->w) || (!bs->h) || (bs->w == shift)) {
+        return 0;
+    }
+
+    xbase = xoffset / BITMASK_W_LEN;
+    a_entry = a->bits + a->h * xbase;
+    b_entry = bs->bits;
+    if (yoffset >= 0) {
+        a_entry += yoffset;
+        rows = MIN(bs->h, a->h - yoffset);
+    }
+    else {
+        b_entry -= yoffset;
+        rows = MIN(bs->h + yoffset, a->h);
+        yoffset = 0; /* relied on below */
+    }
+
+    stripes = MIN((a->w - 1) / BITMASK_W_LEN - xbase,
+                  (bs->w - 1) / BITMASK_W_LEN) +
+              1;
+    for (i = 0; i < stripes; ++i) {
+        high_row = -1;
+        for (row = 0; row < rows; ++row) {
+            word = a_entry[row] & b_entry[row];
+            if (word & lowbits) {
+                *y = row + yoffset;
+                *x = (xbase + i) * BITMASK_W_LEN +
+                     lowest_set_bit(word & lowbits);
+                return 1;
+            }
+            if (high_row < 0 && (word & ~lowbits)) {
+                high_row = row;
+                high_word = word & ~lowbits;
+            }
+        }
+        if (high_row >= 0) {
+            *y = high_row + yoffset;
+            *x = (xbase + i) * BITMASK_W_LEN + lowest_set_bit(high_word);
+            return 1;
+        }
+        a_entry += a->h;
+        b_entry += bs->h;
+    }
+    return 0;
+}
+
 /********** mask object methods **********/
 
 /* Copies the given mask. */
@@ -186,8 +723,10 @@ mask_set_at(PyObject *self, PyObject *args, PyObject *kwargs)
     }
 
     if (x >= 0 && x < mask->w && y >= 0 && y < mask->h) {
+        mask_drop_caches((pgMaskObject *)self);
         if (value) {
             bitmask_setbit(mask, x, y);
+            mask_mark_blocks((pgMaskObject *)self, x, y, 1, 1);
         }
         else {
             bitmask_clearbit(mask, x, y);
@@ -201,13 +740,90 @@ mask_set_at(PyObject *self, PyObject *args, PyObject *kwargs)
     return Py_None;
 }
 
+/* The first point where other, at offset (x, y), overlaps self, found with
+ * the shifted copies or the block states of the masks if they have them.
+ * Returns 0 if they don't overlap. */
+static int
+mask_overlap_pos_of(pgMaskObject *self, pgMaskObject *other, int x, int y,
+                    int *xp, int *yp)
+{
+    bitmask_t *mask = self->mask;
+    bitmask_t *othermask = other->mask;
+    bitmask_t **shifts;
+    unsigned char *blocks, *otherblocks;
+    int val, shift;
+
+    blocks = mask_get_blocks(self);
+    otherblocks = mask_get_blocks(other);
+    shifts = x >= 0 ? other->shifts : self->shifts;
+    shift = (x >= 0 ? x : -x) & BITMASK_W_MASK;
+
+    if (NULL != shifts && shift) {
+        /* bitmask_overlap_pos() swaps the masks for negative offsets, the
+         * shifts of the mask further to the right are used the same way */
+        if (x >= 0) {
+            val = shifted_overlap_pos(mask, shifts[shift], shift, x, y, xp,
+                                      yp);
+        }
+        else if ((val = shifted_overlap_pos(othermask, shifts[shift], shift,
+                                            -x, -y, xp, yp))) {
+            *xp += x;
+            *yp += y;
+        }
+    }
+    else if (NULL != blocks || NULL != otherblocks) {
+        if (x >= 0) {
+            val = block_overlap_pos(mask, blocks, othermask, otherblocks, x,
+                                    y, xp, yp);
+        }
+        else if ((val = block_overlap_pos(othermask, otherblocks, mask,
+                                          blocks, -x, -y, xp, yp))) {
+            *xp += x;
+            *yp += y;
+        }
+    }
+    else {
+        val = bitmask_overlap_pos(mask, othermask, x, y, xp, yp);
+    }
+    return val;
+}
+
+/* The number of set bits of other, at offset (x, y), overlapping those of
+ * self, like mask_overlap_pos_of() */
+static int
+mask_overlap_area_of(pgMaskObject *self, pgMaskObject *other, int x, int y)
+{
+    bitmask_t *mask = self->mask;
+    bitmask_t *othermask = other->mask;
+    bitmask_t **shifts;
+    unsigned char *blocks, *otherblocks;
+    int shift;
+
+    blocks = mask_get_blocks(self);
+    otherblocks = mask_get_blocks(other);
+    shifts = other->shifts;
+    shift = x & BITMASK_W_MASK;
+    if (shift && NULL != shifts) {
+        return block_overlap_area(mask, blocks, shifts[shift], NULL,
+                                  x - shift, y);
+    }
+    if (shift && NULL != (shifts = self->shifts)) {
+        /* the same area, with self shifted to line up with the other mask */
+        shift = -x & BITMASK_W_MASK;
+        return block_overlap_area(othermask, otherblocks, shifts[shift],
+                                  NULL, -x - shift, -y);
+    }
+    if (!shift || NULL != blocks || NULL != otherblocks) {
+        return block_overlap_area(mask, blocks, othermask, otherblocks, x, y);
+    }
+    return bitmask_overlap_area(mask, othermask, x, y);
+}
+
 static PyObject *
 mask_overlap(PyObject *self, PyObject *args, PyObject *kwargs)
 {
-    bitmask_t *mask = pgMask_AsBitmap(self);
-    bitmask_t *othermask;
     PyObject *maskobj;
-    int x, y, val;
+    int x, y;
     int xp, yp;
     PyObject *offset = NULL;
     static char *keywords[] = {"other", "offset", NULL};
@@ -216,14 +832,12 @@ mask_overlap(PyObject *self, PyObject *args, PyObject *kwargs)
                                      &pgMask_Type, &maskobj, &offset))
         return NULL;
 
-    othermask = pgMask_AsBitmap(maskobj);
-
     if (!pg_TwoIntsFromObj(offset, &x, &y)) {
         return RAISE(PyExc_TypeError, "offset must be two numbers");
     }
 
-    val = bitmask_overlap_pos(mask, othermask, x, y, &xp, &yp);
-    if (val) {
+    if (mask_overlap_pos_of((pgMaskObject *)self, (pgMaskObject *)maskobj, x,
+                            y, &xp, &yp)) {
         return pg_tuple_couple_from_values_int(xp, yp);
     }
     else {
@@ -235,10 +849,8 @@ mask_overlap(PyObject *self, PyObject *args, PyObject *kwargs)
 static PyObject *
 mask_overlap_area(PyObject *self, PyObject *args, PyObject *kwargs)
 {
-    bitmask_t *mask = pgMask_AsBitmap(self);
-    bitmask_t *othermask;
     PyObject *maskobj;
-    int x, y, val;
+    int x, y;
     PyObject *offset = NULL;
     static char *keywords[] = {"other", "offset", NULL};
 
@@ -247,14 +859,12 @@ mask_overlap_area(PyObject *self, PyObject *args, PyObject *kwargs)
         return NULL;
     }
 
-    othermask = pgMask_AsBitmap(maskobj);
-
     if (!pg_TwoIntsFromObj(offset, &x, &y)) {
         return RAISE(PyExc_TypeError, "offset must be two numbers");
     }
 
-    val = bitmask_overlap_area(mask, othermask, x, y);
-    return PyLong_FromLong(val);
+    return PyLong_FromLong(mask_overlap_area_of(
+        (pgMaskObject *)self, (pgMaskObject *)maskobj, x, y));
 }
 
 static PyObject *
@@ -264,6 +874,7 @@ mask_overlap_mask(PyObject *self, PyObject *args, PyObject *kwargs)
     bitmask_t *bitmask = pgMask_AsBitmap(self);
     PyObject *maskobj;
     pgMaskObject *output_maskobj;
+    unsigned char *blocks, *otherblocks;
     PyObject *offset = NULL;
     static char *keywords[] = {"other", "offset", NULL};
 
@@ -282,8 +893,16 @@ mask_overlap_mask(PyObject *self, PyObject *args, PyObject *kwargs)
         return NULL; /* Exception already set. */
     }
 
-    bitmask_overlap_mask(bitmask, pgMask_AsBitmap(maskobj),
-                         output_maskobj->mask, x, y);
+    blocks = mask_get_blocks((pgMaskObject *)self);
+    otherblocks = mask_get_blocks((pgMaskObject *)maskobj);
+    if (NULL != blocks || NULL != otherblocks) {
+        block_overlap_mask(bitmask, blocks, pgMask_AsBitmap(maskobj),
+                           otherblocks, output_maskobj->mask, x, y);
+    }
+    else {
+        bitmask_overlap_mask(bitmask, pgMask_AsBitmap(maskobj),
+                             output_maskobj->mask, x, y);
+    }
 
     return (PyObject *)output_maskobj;
 }
@@ -293,6 +912,8 @@ mask_fill(PyObject *self, PyObject *_null)
 {
     bitmask_t *mask = pgMask_AsBitmap(self);
 
+    mask_drop_caches((pgMaskObject *)self);
+    mask_set_blocks((pgMaskObject *)self, MASK_BLOCK_USED);
     bitmask_fill(mask);
 
     Py_RETURN_NONE;
@@ -303,6 +924,8 @@ mask_clear(PyObject *self, PyObject *_null)
 {
     bitmask_t *mask = pgMask_AsBitmap(self);
 
+    mask_drop_caches((pgMaskObject *)self);
+    mask_set_blocks((pgMaskObject *)self, MASK_BLOCK_EMPTY);
     bitmask_clear(mask);
 
     Py_RETURN_NONE;
@@ -313,11 +936,55 @@ mask_invert(PyObject *self, PyObject *_null)
 {
     bitmask_t *mask = pgMask_AsBitmap(self);
 
+    mask_drop_caches((pgMaskObject *)self);
+    mask_drop_blocks((pgMaskObject *)self);
     bitmask_invert(mask);
 
     Py_RETURN_NONE;
 }
 
+static PyObject *
+mask_prepare_shifts(PyObject *self, PyObject *_null)
+{
+    pgMaskObject *maskobj = (pgMaskObject *)self;
+    bitmask_t *mask = pgMask_AsBitmap(self);
+    bitmask_t **shifts;
+    int i;
+
+    if (NULL != maskobj->shifts) {
+        Py_RETURN_NONE; /* Already prepared. */
+    }
+
+    if (NULL != maskobj->bufdata) {
+        return RAISE(PyExc_BufferError,
+                     "cannot prepare shifts while the mask buffer is "
+                     "exported");
+    }
+
+    if (mask->w > INT_MAX - (int)BITMASK_W_LEN) {
+        return RAISE(PyExc_ValueError, "mask is too wide to prepare shifts");
+    }
+
+    shifts = PyMem_New(bitmask_t *, BITMASK_W_LEN);
+    if (NULL == shifts) {
+        return PyErr_NoMemory();
+    }
+    memset(shifts, 0, BITMASK_W_LEN * sizeof(bitmask_t *));
+    maskobj->shifts = shifts;
+
+    for (i = 1; i < (int)BITMASK_W_LEN; ++i) {
+        shifts[i] = bitmask_create(mask->w + i, mask->h);
+        if (NULL == shifts[i]) {
+            mask_drop_caches(maskobj);
+            return RAISE(PyExc_MemoryError,
+                         "cannot allocate memory for bitmask");
+        }
+        bitmask_draw(shifts[i], mask, i, 0);
+    }
+
+    Py_RETURN_NONE;
+}
+
 static PyObject *
 mask_scale(PyObject *self, PyObject *args, PyObject *kwargs)
 {
@@ -368,6 +1035,8 @@ mask_draw(PyObject *self, PyObject *args, PyObject *kwargs)
 
     othermask = pgMask_AsBitmap(maskobj);
 
+    mask_drop_caches((pgMaskObject *)self);
+    mask_mark_blocks((pgMaskObject *)self, x, y, othermask->w, othermask->h);
     bitmask_draw(mask, othermask, x, y);
 
     Py_RETURN_NONE;
@@ -394,6 +1063,8 @@ mask_erase(PyObject *self, PyObject *args, PyObject *kwargs)
 
     othermask = pgMask_AsBitmap(maskobj);
 
+    /* erasing leaves the used blocks used, which is still right */
+    mask_drop_caches((pgMaskObject *)self);
     bitmask_erase(mask, othermask, x, y);
 
     Py_RETURN_NONE;
@@ -403,72 +1074,100 @@ static PyObject *
 mask_count(PyObject *self, PyObject *_null)
 {
     bitmask_t *m = pgMask_AsBitmap(self);
+    unsigned char *blocks = mask_get_blocks((pgMaskObject *)self);
 
+    if (NULL != blocks) {
+        return PyLong_FromLong(block_count(m, blocks));
+    }
     return PyLong_FromLong(bitmask_count(m));
 }
 
-static PyObject *
-mask_centroid(PyObject *self, PyObject *_null)
+/* The raw moments of the set bits up to the second order, mXY being the sum
+ * of x**X * y**Y over them. */
+typedef struct {
+    long long m00, m10, m01, m20, m11, m02;
+} mask_moments_t;
+
+/* Sums the moments of m a word at a time. The x moments of a word come from
+ * the bit counts of the word masked with bitsel[k], the bits whose index
+ * has bit k set: the sum of the set bit indices is the sum of
+ * 2**k * count(w & bitsel[k]) and the sum of their squares the sum of
+ * 2**(j + k) * count(w & bitsel[j] & bitsel[k]). Doesn't need the GIL. */
+static void
+mask_moments(const bitmask_t *m, mask_moments_t *mo)
 {
-    bitmask_t *mask = pgMask_AsBitmap(self);
-    int x, y;
-    long int m10, m01, m00;
-    PyObject *xobj, *yobj;
-
-    m10 = m01 = m00 = 0;
-
-    for (x = 0; x < mask->w; x++) {
-        for (y = 0; y < mask->h; y++) {
-            if (bitmask_getbit(mask, x, y)) {
-                m10 += x;
-                m01 += y;
-                m00++;
+    BITMASK_W bitsel[8];
+    long long count, sum, sum2, c, s1, s2, base;
+    BITMASK_W w;
+    int levels, x, y, j, k;
+
+    /* bitsel[k] = 0b...1111000011110000 for k = 2 and so on */
+    for (levels = 0; (1 << levels) < (int)BITMASK_W_LEN; ++levels) {
+        bitsel[levels] = ~(BITMASK_W)0 /
+                         ((BITMASK_W)1 + BITMASK_N(1 << levels))
+                         << (1 << levels);
+    }
+    memset(mo, 0, sizeof(mask_moments_t));
+
+    for (y = 0; y < m->h; ++y) {
+        count = sum = sum2 = 0;
+        for (x = 0; x < m->w; x += BITMASK_W_LEN) {
+            w = m->bits[x / BITMASK_W_LEN * m->h + y];
+            if (!w) {
+                continue;
+            }
+            c = _pg_mask_bitcount(w);
+            s1 = s2 = 0;
+            for (j = 0; j < levels; ++j) {
+                s1 += (long long)_pg_mask_bitcount(w & bitsel[j]) << j;
+                s2 += (long long)_pg_mask_bitcount(w & bitsel[j]) << (2 * j);
+                for (k = j + 1; k < levels; ++k) {
+                    s2 += (long long)_pg_mask_bitcount(w & bitsel[j] &
+                                                       bitsel[k])
+                          << (j + k + 1);
+                }
             }
+            /* the indices of the word start at base */
+            base = x;
+            count += c;
+            sum += c * base + s1;
+            sum2 += c * base * base + 2 * base * s1 + s2;
         }
+        mo->m00 += count;
+        mo->m10 += sum;
+        mo->m01 += count * y;
+        mo->m20 += sum2;
+        mo->m11 += sum * y;
+        mo->m02 += count * y * y;
     }
+}
 
-    if (m00) {
-        xobj = PyLong_FromLong(m10 / m00);
-        yobj = PyLong_FromLong(m01 / m00);
-    }
-    else {
-        xobj = PyLong_FromLong(0);
-        yobj = PyLong_FromLong(0);
-    }
+static PyObject *
+mask_centroid(PyObject *self, PyObject *_null)
+{
+    mask_moments_t mo;
 
-    return Py_BuildValue("(NN)", xobj, yobj);
+    mask_moments(pgMask_AsBitmap(self), &mo);
+    if (mo.m00) {
+        return Py_BuildValue("(LL)", mo.m10 / mo.m00, mo.m01 / mo.m00);
+    }
+    return Py_BuildValue("(ii)", 0, 0);
 }
 
 static PyObject *
 mask_angle(PyObject *self, PyObject *_null)
 {
-    bitmask_t *mask = pgMask_AsBitmap(self);
-    int x, y;
-    long int m10, m01, m00, m20, m02, m11;
-
-    m10 = m01 = m00 = m20 = m02 = m11 = 0;
-
-    for (x = 0; x < mask->w; x++) {
-        for (y = 0; y < mask->h; y++) {
-            if (bitmask_getbit(mask, x, y)) {
-                m10 += x;
-                m20 += (long)x * x;
-                m11 += (long)x * y;
-                m02 += (long)y * y;
-                m01 += y;
-                m00++;
-            }
-        }
-    }
-
-    if (m00) {
-        int xc = m10 / m00;
-        int yc = m01 / m00;
-        double theta =
-            -90.0 *
-            atan2(2 * (m11 / m00 - (long)xc * yc),
-                  (m20 / m00 - (long)xc * xc) - (m02 / m00 - (long)yc * yc)) /
-            M_PI;
+    mask_moments_t mo;
+
+    mask_moments(pgMask_AsBitmap(self), &mo);
+    if (mo.m00) {
+        long long xc = mo.m10 / mo.m00;
+        long long yc = mo.m01 / mo.m00;
+        double theta = -90.0 *
+                       atan2((double)(2 * (mo.m11 / mo.m00 - xc * yc)),
+                             (double)((mo.m20 / mo.m00 - xc * xc) -
+                                      (mo.m02 / mo.m00 - yc * yc))) /
+                       M_PI;
         return PyFloat_FromDouble(theta);
     }
     else {
@@ -477,172 +1176,634 @@ mask_angle(PyObject *self, PyObject *_null)
 }
 
 static PyObject *
-mask_outline(PyObject *self, PyObject *args, PyObject *kwargs)
+mask_get_moments(PyObject *self, PyObject *_null)
 {
-    bitmask_t *c = pgMask_AsBitmap(self);
-    bitmask_t *m = NULL;
-    PyObject *plist = NULL;
-    PyObject *value = NULL;
-    int x, y, firstx, firsty, secx, secy, currx, curry, nextx, nexty, n;
-    int e, every = 1;
-    int a[] = {1, 1, 0, -1, -1, -1, 0, 1, 1, 1, 0, -1, -1, -1};
-    int b[] = {0, 1, 1, 1, 0, -1, -1, -1, 0, 1, 1, 1, 0, -1};
-    static char *keywords[] = {"every", NULL};
+    mask_moments_t mo;
+
+    mask_moments(pgMask_AsBitmap(self), &mo);
+    return Py_BuildValue("(LLLLLL)", mo.m00, mo.m10, mo.m01, mo.m20, mo.m11,
+                         mo.m02);
+}
 
-    firstx = firsty = secx = x = 0;
+/* Offsets of the 8 neighbours of a pixel, clockwise from the right one. */
+static const int outline_dx[] = {1, 1, 0, -1, -1, -1, 0, 1};
+static const int outline_dy[] = {0, 1, 1, 1, 0, -1, -1, -1};
 
-    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "|i", keywords, &every)) {
-        return NULL;
+/* Bit n of the result is set if the neighbour n of (x, y) is set. The mask
+ * must have a border of cleared bits around (x, y). */
+static PG_INLINE unsigned int
+outline_neighbours(const bitmask_t *m, int x, int y)
+{
+    unsigned int code = 0;
+    int n;
+
+    for (n = 0; n < 8; ++n) {
+        if (bitmask_getbit(m, x + outline_dx[n], y + outline_dy[n])) {
+            code |= 1u << n;
+        }
     }
+    return code;
+}
 
-    plist = PyList_New(0);
-    if (!plist) {
-        return RAISE(PyExc_MemoryError,
-                     "outline cannot allocate memory for list");
+/* Traces the outline of the first connected component of c, going clockwise
+ * from its first set bit (searched per row, a word at a time). The walk ends
+ * when it is about to repeat itself, so the first point is also the last one
+ * unless it is the only one. Stores the points as x, y pairs in a buffer from
+ * PyMem_RawMalloc and returns their number, or -1 if out of memory. Doesn't
+ * need the GIL.
+ */
+static Py_ssize_t
+trace_outline(const bitmask_t *c, int **ret_points)
+{
+    bitmask_t *m;
+    BITMASK_W word = 0;
+    int *points, *more;
+    Py_ssize_t len = 0, size = 64;
+    int stripes = c->w ? (c->w - 1) / (int)BITMASK_W_LEN + 1 : 0;
+    int x, y, s, n, firstx, firsty, secx, secy, currx, curry, nextx, nexty;
+    unsigned int code;
+
+    points = PyMem_RawMalloc(size * 2 * sizeof(int));
+    if (NULL == points) {
+        return -1;
     }
+    *ret_points = points;
 
-    if (!c->w || !c->h) {
-        return plist;
+    for (y = 0; y < c->h; ++y) {
+        for (s = 0; s < stripes; ++s) {
+            word = c->bits[s * c->h + y];
+            if (word) {
+                break;
+            }
+        }
+        if (s < stripes) {
+            break;
+        }
+    }
+
+    /* the mask has no bits set */
+    if (y == c->h) {
+        return 0;
     }
 
+    x = s * (int)BITMASK_W_LEN + lowest_set_bit(word);
+    points[0] = x;
+    points[1] = y;
+    len = 1;
+
     /* Copying to a larger mask to avoid border checking. */
     m = bitmask_create(c->w + 2, c->h + 2);
-    if (!m) {
-        Py_DECREF(plist);
-        return RAISE(PyExc_MemoryError,
-                     "outline cannot allocate memory for mask");
+    if (NULL == m) {
+        PyMem_RawFree(points);
+        return -1;
     }
-
     bitmask_draw(m, c, 1, 1);
 
-    /* find the first set pixel in the mask */
-    for (y = 1; y < m->h - 1; y++) {
-        for (x = 1; x < m->w - 1; x++) {
-            if (bitmask_getbit(m, x, y)) {
-                firstx = x;
-                firsty = y;
-                value = pg_tuple_couple_from_values_int(x - 1, y - 1);
+    firstx = x + 1;
+    firsty = y + 1;
 
-                if (NULL == value) {
-                    Py_DECREF(plist);
-                    bitmask_free(m);
+    /* if there are no neighbors, the outline is just the first pixel */
+    code = outline_neighbours(m, firstx, firsty);
+    if (!code) {
+        bitmask_free(m);
+        return len;
+    }
 
-                    return NULL; /* Exception already set. */
-                }
+    n = lowest_set_bit(code);
+    currx = secx = firstx + outline_dx[n];
+    curry = secy = firsty + outline_dy[n];
+    points[2 * len] = secx - 1;
+    points[2 * len + 1] = secy - 1;
+    ++len;
 
-                if (0 != PyList_Append(plist, value)) {
-                    Py_DECREF(value);
-                    Py_DECREF(plist);
-                    bitmask_free(m);
+    for (;;) {
+        /* Look around the pixel clockwise, starting next to the pixel we
+         * came from. There is at least that one neighbour. */
+        s = (n + 6) & 7;
+        code = outline_neighbours(m, currx, curry);
+        code = ((code >> s) | (code << (8 - s))) & 0xff;
+        n = (s + lowest_set_bit(code)) & 7;
+        nextx = currx + outline_dx[n];
+        nexty = curry + outline_dy[n];
 
-                    return NULL; /* Exception already set. */
-                }
+        /* if we are back at the first pixel, and the next one will be the
+           second one we visited, we are done */
+        if ((curry == firsty && currx == firstx) &&
+            (secx == nextx && secy == nexty)) {
+            break;
+        }
 
-                Py_DECREF(value);
-                break;
+        if (len == size) {
+            size *= 2;
+            more = PyMem_RawRealloc(points, size * 2 * sizeof(int));
+            if (NULL == more) {
+                PyMem_RawFree(points);
+                bitmask_free(m);
+                return -1;
             }
+            points = more;
+            *ret_points = points;
         }
-        if (bitmask_getbit(m, x, y))
-            break;
+        points[2 * len] = nextx - 1;
+        points[2 * len + 1] = nexty - 1;
+        ++len;
+
+        currx = nextx;
+        curry = nexty;
     }
 
-    /* covers the mask having zero pixels set or only the final pixel */
-    if ((x == m->w - 1) && (y == m->h - 1)) {
-        bitmask_free(m);
-        return plist;
+    bitmask_free(m);
+    return len;
+}
+
+/* Squared distance of point p from the line through a and b (or from a, if
+ * a and b are the same point), multiplied by the squared length of a-b. */
+static double
+outline_distance(const int *p, const int *a, const int *b, double *scale)
+{
+    double dx = b[0] - a[0], dy = b[1] - a[1];
+    double px = p[0] - a[0], py = p[1] - a[1];
+    double cross;
+
+    *scale = dx * dx + dy * dy;
+    if (*scale == 0.0) {
+        *scale = 1.0;
+        return px * px + py * py;
     }
+    cross = dx * py - dy * px;
+    return cross * cross;
+}
 
-    e = every;
+/* Drops the points of the polyline (x, y pairs) that are closer than epsilon
+ * to the line simplifying them (Douglas-Peucker), keeping the first and last
+ * points. Returns the number of points left or -1 if out of memory. */
+static Py_ssize_t
+simplify_outline(int *points, Py_ssize_t len, double epsilon)
+{
+    Py_ssize_t *stack;
+    char *keep;
+    Py_ssize_t top = 0, lo, hi, i, far, kept = 0;
+    double dist, maxdist, scale, maxscale;
 
-    /* check just the first pixel for neighbors */
-    for (n = 0; n < 8; n++) {
-        if (bitmask_getbit(m, x + a[n], y + b[n])) {
-            currx = secx = x + a[n];
-            curry = secy = y + b[n];
-            e--;
-            if (!e) {
-                e = every;
-                value = pg_tuple_couple_from_values_int(secx - 1, secy - 1);
+    if (len < 3) {
+        return len;
+    }
 
-                if (NULL == value) {
-                    Py_DECREF(plist);
-                    bitmask_free(m);
+    keep = PyMem_Calloc(len, 1);
+    stack = PyMem_New(Py_ssize_t, 2 * len);
+    if (NULL == keep || NULL == stack) {
+        PyMem_Free(keep);
+        PyMem_Free(stack);
+        return -1;
+    }
+    keep[0] = keep[len - 1] = 1;
+    stack[top++] = 0;
+    stack[top++] = len - 1;
+
+    while (top) {
+        hi = stack[--top];
+        lo = stack[--top];
+        far = -1;
+        maxdist = 0.0;
+        maxscale = 1.0;
+        for (i = lo + 1; i < hi; ++i) {
+            dist = outline_distance(points + 2 * i, points + 2 * lo,
+                                    points + 2 * hi, &scale);
+            if (far < 0 || dist * maxscale > maxdist * scale) {
+                far = i;
+                maxdist = dist;
+                maxscale = scale;
+            }
+        }
+        if (far >= 0 && maxdist > epsilon * epsilon * maxscale) {
+            keep[far] = 1;
+            stack[top++] = lo;
+            stack[top++] = far;
+            stack[top++] = far;
+            stack[top++] = hi;
+        }
+    }
 
-                    return NULL; /* Exception already set. */
-                }
+    for (i = 0; i < len; ++i) {
+        if (keep[i]) {
+            points[2 * kept] = points[2 * i];
+            points[2 * kept + 1] = points[2 * i + 1];
+            ++kept;
+        }
+    }
 
-                if (0 != PyList_Append(plist, value)) {
-                    Py_DECREF(value);
-                    Py_DECREF(plist);
-                    bitmask_free(m);
+    PyMem_Free(keep);
+    PyMem_Free(stack);
+    return kept;
+}
 
-                    return NULL; /* Exception already set. */
-                }
+/* Does the common work of Mask.outline() and Mask.outline_points(): parses
+ * every and epsilon, traces the outline (or uses the one cached on the mask)
+ * and returns the chosen points as x, y pairs in a buffer from PyMem_Malloc.
+ * Returns NULL with an exception set on failure.
+ */
+static int *
+mask_outline_points_common(PyObject *self, PyObject *args, PyObject *kwargs,
+                           Py_ssize_t *ret_len)
+{
+    pgMaskObject *maskobj = (pgMaskObject *)self;
+    bitmask_t *c = pgMask_AsBitmap(self);
+    int *traced = NULL, *points;
+    Py_ssize_t i, len, traced_len;
+    int every = 1;
+    double epsilon = 0.0;
+    static char *keywords[] = {"every", "epsilon", NULL};
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "|id", keywords, &every,
+                                     &epsilon)) {
+        return NULL;
+    }
 
-                Py_DECREF(value);
-            }
+    if (epsilon < 0.0) {
+        return (int *)RAISE(PyExc_ValueError, "epsilon must not be negative");
+    }
+
+    if (NULL != maskobj->outline) {
+        traced = maskobj->outline;
+        traced_len = maskobj->outline_len;
+    }
+    else {
+        Py_BEGIN_ALLOW_THREADS;
+        traced_len = trace_outline(c, &traced);
+        Py_END_ALLOW_THREADS;
+
+        if (traced_len < 0) {
+            return (int *)RAISE(PyExc_MemoryError,
+                                "outline cannot allocate memory for points");
+        }
+
+        /* the bits can be changed through an exported buffer at any time */
+        if (NULL == maskobj->bufdata && NULL == maskobj->outline) {
+            maskobj->outline = traced;
+            maskobj->outline_len = traced_len;
+        }
+    }
+
+    points = PyMem_New(int, 2 * traced_len + 2);
+    if (NULL == points) {
+        if (traced != maskobj->outline) {
+            PyMem_RawFree(traced);
+        }
+        return (int *)PyErr_NoMemory();
+    }
+
+    /* the first point, then every every-th point after it */
+    len = 0;
+    for (i = 0; i < traced_len; i += every) {
+        points[2 * len] = traced[2 * i];
+        points[2 * len + 1] = traced[2 * i + 1];
+        ++len;
+        if (every < 1) {
             break;
         }
     }
 
-    /* if there are no neighbors, return */
-    if (!secx) {
-        bitmask_free(m);
-        return plist;
+    if (traced != maskobj->outline) {
+        PyMem_RawFree(traced);
     }
 
-    /* the outline tracing loop */
-    for (;;) {
-        /* look around the pixel, it has to have a neighbor */
-        for (n = (n + 6) & 7;; n++) {
-            if (bitmask_getbit(m, currx + a[n], curry + b[n])) {
-                nextx = currx + a[n];
-                nexty = curry + b[n];
-                e--;
-                if (!e) {
-                    e = every;
-                    if ((curry == firsty && currx == firstx) &&
-                        (secx == nextx && secy == nexty)) {
-                        break;
-                    }
+    if (epsilon > 0.0) {
+        len = simplify_outline(points, len, epsilon);
+        if (len < 0) {
+            PyMem_Free(points);
+            return (int *)PyErr_NoMemory();
+        }
+    }
+
+    *ret_len = len;
+    return points;
+}
+
+static PyObject *
+mask_outline(PyObject *self, PyObject *args, PyObject *kwargs)
+{
+    PyObject *plist = NULL;
+    PyObject *value = NULL;
+    int *points;
+    Py_ssize_t i, len;
 
-                    value =
-                        pg_tuple_couple_from_values_int(nextx - 1, nexty - 1);
+    points = mask_outline_points_common(self, args, kwargs, &len);
+    if (NULL == points) {
+        return NULL; /* Exception already set. */
+    }
 
-                    if (NULL == value) {
-                        Py_DECREF(plist);
-                        bitmask_free(m);
+    plist = PyList_New(len);
+    if (!plist) {
+        PyMem_Free(points);
+        return RAISE(PyExc_MemoryError,
+                     "outline cannot allocate memory for list");
+    }
 
-                        return NULL; /* Exception already set. */
-                    }
+    for (i = 0; i < len; ++i) {
+        value = pg_tuple_couple_from_values_int(points[2 * i],
+                                                points[2 * i + 1]);
 
-                    if (0 != PyList_Append(plist, value)) {
-                        Py_DECREF(value);
-                        Py_DECREF(plist);
-                        bitmask_free(m);
+        if (NULL == value) {
+            Py_DECREF(plist);
+            PyMem_Free(points);
 
-                        return NULL; /* Exception already set. */
-                    }
+            return NULL; /* Exception already set. */
+        }
+
+        PyList_SET_ITEM(plist, i, value);
+    }
+
+    PyMem_Free(points);
+    return plist;
+}
+
+/* Exports the results of Mask.outline_points() and Mask.overlap_many() as
+ * a writable (n, cols) buffer of C ints, or (n,) with one column, wrapped
+ * in a memoryview. */
+typedef struct {
+    PyObject_HEAD int *points;
+    int ndim;
+    Py_ssize_t shape[2];
+    Py_ssize_t strides[2];
+} pgMaskOutlineObject;
+
+static int
+mask_outline_getbuffer(pgMaskOutlineObject *self, Py_buffer *view, int flags)
+{
+    view->obj = (PyObject *)self;
+    Py_INCREF(self);
+    view->buf = self->points;
+    view->len = self->shape[0] * self->strides[0];
+    view->readonly = 0;
+    view->itemsize = sizeof(int);
+    view->ndim = self->ndim;
+    view->shape = (flags & PyBUF_ND) ? self->shape : NULL;
+    view->strides = (flags & PyBUF_STRIDES) ? self->strides : NULL;
+    view->format = (flags & PyBUF_FORMAT) ? "i" : NULL;
+    view->suboffsets = NULL;
+    view->internal = NULL;
+    return 0;
+}
+
+static void
+mask_outline_dealloc(pgMaskOutlineObject *self)
+{
+    PyMem_Free(self->points);
+    Py_TYPE(self)->tp_free((PyObject *)self);
+}
+
+static PyBufferProcs mask_outline_buffer_procs = {
+    (getbufferproc)mask_outline_getbuffer, NULL};
+
+static PyTypeObject pgMaskOutline_Type = {
+    PyVarObject_HEAD_INIT(NULL, 0).tp_name = "pygame.mask._MaskOutline",
+    .tp_basicsize = sizeof(pgMaskOutlineObject),
+    .tp_dealloc = (destructor)mask_outline_dealloc,
+    .tp_as_buffer = &mask_outline_buffer_procs,
+    .tp_flags = Py_TPFLAGS_DEFAULT,
+};
 
-                    Py_DECREF(value);
+/* Wraps the n rows of cols ints in values, from PyMem_Malloc, in a
+ * memoryview, which takes them over. They are freed on failure. */
+static PyObject *
+mask_ints_view(int *values, Py_ssize_t n, int cols)
+{
+    pgMaskOutlineObject *outline;
+    PyObject *view;
+
+    outline = PyObject_New(pgMaskOutlineObject, &pgMaskOutline_Type);
+    if (NULL == outline) {
+        PyMem_Free(values);
+        return NULL;
+    }
+    outline->points = values;
+    outline->ndim = cols > 1 ? 2 : 1;
+    outline->shape[0] = n;
+    outline->shape[1] = cols;
+    outline->strides[0] = cols * sizeof(int);
+    outline->strides[1] = sizeof(int);
+
+    view = PyMemoryView_FromObject((PyObject *)outline);
+    Py_DECREF(outline);
+    return view;
+}
+
+static PyObject *
+mask_outline_points(PyObject *self, PyObject *args, PyObject *kwargs)
+{
+    int *points;
+    Py_ssize_t len;
+
+    points = mask_outline_points_common(self, args, kwargs, &len);
+    if (NULL == points) {
+        return NULL; /* Exception already set. */
+    }
+    return mask_ints_view(points, len, 2);
+}
+
+/* The bounds of the set bits of m, x2 and y2 being exclusive. Returns 0 if
+ * no bits are set. */
+static int
+mask_bits_bounds(const bitmask_t *m, int *x1, int *y1, int *x2, int *y2)
+{
+    const BITMASK_W *p;
+    BITMASK_W bits, first = 0, last = 0;
+    int i, y, stripes, first_stripe = -1, last_stripe = 0;
+
+    if (!m->w || !m->h) {
+        return 0;
+    }
+    *y1 = m->h;
+    *y2 = 0;
+    stripes = (m->w - 1) / (int)BITMASK_W_LEN + 1;
+    for (i = 0; i < stripes; ++i) {
+        p = m->bits + i * m->h;
+        bits = 0;
+        for (y = 0; y < m->h; ++y) {
+            if (p[y]) {
+                bits |= p[y];
+                if (y < *y1) {
+                    *y1 = y;
                 }
-                break;
+                *y2 = y + 1;
             }
         }
-        /* if we are back at the first pixel, and the next one will be the
-           second one we visited, we are done */
-        if ((curry == firsty && currx == firstx) &&
-            (secx == nextx && secy == nexty)) {
-            break;
+        if (bits) {
+            if (first_stripe < 0) {
+                first_stripe = i;
+                first = bits;
+            }
+            last_stripe = i;
+            last = bits;
         }
+    }
+    if (first_stripe < 0) {
+        return 0;
+    }
 
-        curry = nexty;
-        currx = nextx;
+    for (i = 0; !(first & BITMASK_N(i)); ++i) {
+    }
+    *x1 = first_stripe * (int)BITMASK_W_LEN + i;
+    for (i = BITMASK_W_MASK; !(last & BITMASK_N(i)); --i) {
     }
+    *x2 = last_stripe * (int)BITMASK_W_LEN + i + 1;
+    return 1;
+}
 
-    bitmask_free(m);
+/* Reads pairs of ints from a buffer of native 32 bit ints or a sequence of
+ * pairs. Returns the ints, from PyMem_Malloc, or NULL with an exception
+ * set. */
+static int *
+mask_load_offsets(PyObject *obj, Py_ssize_t *count)
+{
+    Py_buffer view;
+    PyObject *fast, **items;
+    const char *fmt;
+    Py_ssize_t n, i;
+    int *offsets;
+
+    if (PyObject_CheckBuffer(obj)) {
+        if (PyObject_GetBuffer(obj, &view,
+                               PyBUF_C_CONTIGUOUS | PyBUF_FORMAT)) {
+            return NULL;
+        }
+        fmt = view.format ? view.format : "B";
+        if (*fmt == '@' || *fmt == '=') {
+            ++fmt;
+        }
+        if (view.itemsize != sizeof(int) ||
+            (strcmp(fmt, "i") && strcmp(fmt, "l")) ||
+            view.len % (2 * sizeof(int))) {
+            PyBuffer_Release(&view);
+            return (int *)RAISE(PyExc_ValueError,
+                                "offsets buffer must hold pairs of native "
+                                "32 bit integers");
+        }
+        n = view.len / (2 * sizeof(int));
+        offsets = PyMem_New(int, 2 * n + 2);
+        if (NULL != offsets) {
+            memcpy(offsets, view.buf, view.len);
+        }
+        PyBuffer_Release(&view);
+        if (NULL == offsets) {
+            return (int *)PyErr_NoMemory();
+        }
+        *count = n;
+        return offsets;
+    }
+
+    fast = PySequence_Fast(obj, "offsets must be a buffer or a sequence");
+    if (NULL == fast) {
+        return NULL;
+    }
+    n = PySequence_Fast_GET_SIZE(fast);
+    items = PySequence_Fast_ITEMS(fast);
+    offsets = PyMem_New(int, 2 * n + 2);
+    if (NULL == offsets) {
+        Py_DECREF(fast);
+        return (int *)PyErr_NoMemory();
+    }
+    for (i = 0; i < n; ++i) {
+        if (!pg_TwoIntsFromObj(items[i], &offsets[2 * i],
+                               &offsets[2 * i + 1])) {
+            Py_DECREF(fast);
+            PyMem_Free(offsets);
+            return (int *)RAISE(PyExc_TypeError,
+                                "offset must be two numbers");
+        }
+    }
+    Py_DECREF(fast);
+    *count = n;
+    return offsets;
+}
+
+static PyObject *
+mask_overlap_many(PyObject *self, PyObject *args, PyObject *kwargs)
+{
+    pgMaskObject *maskobj = (pgMaskObject *)self, *other, *single = NULL;
+    PyObject *masks, *offsetsobj, *fast = NULL, **items = NULL;
+    int *offsets, *results;
+    int area = 0, has_bits, x, y, xp, yp, hit;
+    int x1 = 0, y1 = 0, x2 = 0, y2 = 0;
+    int ox1 = 0, oy1 = 0, ox2 = 0, oy2 = 0;
+    Py_ssize_t n, i;
+    static char *keywords[] = {"masks", "offsets", "area", NULL};
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "OO|p", keywords, &masks,
+                                     &offsetsobj, &area)) {
+        return NULL;
+    }
+
+    offsets = mask_load_offsets(offsetsobj, &n);
+    if (NULL == offsets) {
+        return NULL; /* Exception already set. */
+    }
+
+    if (PyObject_TypeCheck(masks, &pgMask_Type)) {
+        single = (pgMaskObject *)masks;
+    }
+    else {
+        fast = PySequence_Fast(masks, "masks must be a Mask or a sequence");
+        if (NULL == fast) {
+            PyMem_Free(offsets);
+            return NULL;
+        }
+        if (PySequence_Fast_GET_SIZE(fast) != n) {
+            Py_DECREF(fast);
+            PyMem_Free(offsets);
+            return RAISE(PyExc_ValueError,
+                         "masks and offsets must have the same length");
+        }
+        items = PySequence_Fast_ITEMS(fast);
+        for (i = 0; i < n; ++i) {
+            if (!PyObject_TypeCheck(items[i], &pgMask_Type)) {
+                Py_DECREF(fast);
+                PyMem_Free(offsets);
+                return RAISE(PyExc_TypeError, "masks must be Mask objects");
+            }
+        }
+    }
+
+    results = PyMem_New(int, area ? n + 1 : 2 * n + 2);
+    if (NULL == results) {
+        Py_XDECREF(fast);
+        PyMem_Free(offsets);
+        return PyErr_NoMemory();
+    }
+
+    /* The bitmasks are only compared where the other mask (or the bounds
+     * of its bits, if it is the same for all the offsets) meets the bounds
+     * of the bits of this mask */
+    has_bits = mask_bits_bounds(maskobj->mask, &x1, &y1, &x2, &y2);
+    if (single && has_bits) {
+        has_bits = mask_bits_bounds(single->mask, &ox1, &oy1, &ox2, &oy2);
+    }
+    for (i = 0; i < n; ++i) {
+        other = single ? single : (pgMaskObject *)items[i];
+        if (!single) {
+            ox2 = other->mask->w;
+            oy2 = other->mask->h;
+        }
+        x = offsets[2 * i];
+        y = offsets[2 * i + 1];
+        hit = has_bits && (Sint64)x + ox1 < x2 && (Sint64)x + ox2 > x1 &&
+              (Sint64)y + oy1 < y2 && (Sint64)y + oy2 > y1;
+
+        if (area) {
+            results[i] = hit ? mask_overlap_area_of(maskobj, other, x, y) : 0;
+        }
+        else if (hit && mask_overlap_pos_of(maskobj, other, x, y, &xp, &yp)) {
+            results[2 * i] = xp;
+            results[2 * i + 1] = yp;
+        }
+        else {
+            results[2 * i] = results[2 * i + 1] = -1;
+        }
+    }
 
-    return plist;
+    Py_XDECREF(fast);
+    PyMem_Free(offsets);
+    return mask_ints_view(results, n, area ? 1 : 2);
 }
 
 static PyObject *
@@ -682,6 +1843,8 @@ mask_convolve(PyObject *aobj, PyObject *args, PyObject *kwargs)
         oobj = (PyObject *)maskobj;
     }
 
+    mask_drop_caches((pgMaskObject *)oobj);
+    mask_drop_blocks((pgMaskObject *)oobj);
     bitmask_convolve(a, b, pgMask_AsBitmap(oobj), xoffset, yoffset);
 
     return oobj;
@@ -756,11 +1919,97 @@ set_pixel_color(Uint8 *pixel, Uint8 bpp, Uint32 color)
     }
 }
 
+/* Adds the bit of pixel (x, y) to word, a mask row is built a word at a
+ * time. The word is stored into the mask once it is full or x is the last
+ * pixel of the row, and then cleared to start the next one.
+ *
+ * Params:
+ *     bitmask: bitmask to alter, the row must not have been written yet
+ *     x, y: position of the bit
+ *     set: whether to set the bit
+ *     word: the word being built
+ */
+static PG_INLINE void
+add_row_bit(bitmask_t *bitmask, int x, int y, int set, BITMASK_W *word)
+{
+    if (set) {
+        *word |= BITMASK_N(x & BITMASK_W_MASK);
+    }
+    if ((x & BITMASK_W_MASK) == BITMASK_W_MASK || x == bitmask->w - 1) {
+        bitmask->bits[x / BITMASK_W_LEN * bitmask->h + y] = *word;
+        *word = 0;
+    }
+}
+
+/* The generic row kernels, see simd_mask.h */
+void
+mask_alpha_row(const Uint32 *src, int n, int ashift, int threshold,
+               BITMASK_W *bits, int stride)
+{
+    BITMASK_W word = 0;
+    int x = 0;
+
+    PG_MASK_ROW_FINISH((int)(src[x] >> ashift & 0xFF) > threshold)
+}
+
+void
+mask_colorkey_row(const Uint32 *src, int n, Uint32 colorkey, BITMASK_W *bits,
+                  int stride)
+{
+    BITMASK_W word = 0;
+    int x = 0;
+
+    PG_MASK_ROW_FINISH(src[x] != colorkey)
+}
+
+void
+mask_threshold_row(const Uint32 *src, const Uint32 *src2, int n, Uint32 color,
+                   Uint32 tlimit, BITMASK_W *bits, int stride)
+{
+    BITMASK_W word = 0;
+    int x = 0;
+
+    PG_MASK_ROW_FINISH(
+        PG_MASK_THRESHOLD_TEST(src[x], src2 ? src2[x] : color, tlimit))
+}
+
+unsigned int
+mask_and_count(const BITMASK_W *a, const BITMASK_W *b, int n)
+{
+    unsigned int count = 0;
+    int i;
+
+    for (i = 0; i < n; ++i) {
+        count += _pg_mask_bitcount(a[i] & b[i]);
+    }
+    return count;
+}
+
+void
+mask_to_surface_row(Uint32 *dst, int n, const BITMASK_W *bits, int stride,
+                    int x, Uint32 setcolor, Uint32 unsetcolor, int draw_set,
+                    int draw_unset)
+{
+    BITMASK_W w;
+    int i, len;
+
+    for (i = 0; i < n; i += len) {
+        len = MIN((int)BITMASK_W_LEN, n - i);
+        w = _pg_mask_row_word(bits, stride, x + i, n - i);
+        if (!_pg_mask_fill_word(dst + i, w, len, setcolor, unsetcolor,
+                                draw_set, draw_unset)) {
+            _pg_mask_expand_word(dst + i, w, 0, len, setcolor, unsetcolor,
+                                 draw_set, draw_unset);
+        }
+    }
+}
+
 /* For each surface pixel's alpha that is greater than the threshold,
  * the corresponding bitmask bit is set.
  *
  * Params:
  *     surf: surface
+ *     rect: area of the surface to use, the size of the bitmask
  *     bitmask: bitmask to alter
  *     threshold: threshold used check surface pixels (alpha) against
  *
@@ -768,23 +2017,54 @@ set_pixel_color(Uint8 *pixel, Uint8 bpp, Uint32 color)
  *     void
  */
 static void
-set_from_threshold(SDL_Surface *surf, bitmask_t *bitmask, int threshold)
+set_from_threshold(SDL_Surface *surf, SDL_Rect *rect, bitmask_t *bitmask,
+                   int threshold)
 {
     SDL_PixelFormat *format = surf->format;
     Uint8 bpp = PG_FORMAT_BytesPerPixel(format);
+    MASK_ALPHA_ROW_P row_func = mask_alpha_row;
     Uint8 *pixel = NULL;
     Uint8 rgba[4];
+    BITMASK_W word = 0;
     int x, y;
 
-    for (y = 0; y < surf->h; ++y) {
-        pixel = (Uint8 *)surf->pixels + y * surf->pitch;
+    if (threshold >= 255) {
+        return; /* no alpha is greater */
+    }
+    if (bpp > 1 && !format->Amask) {
+        /* without per pixel alpha every pixel is opaque */
+        bitmask_fill(bitmask);
+        return;
+    }
+
+    if (bpp == 4 && format->Amask == (Uint32)0xFF << format->Ashift) {
+#if !defined(__EMSCRIPTEN__)
+        if (_pg_mask_has_avx2()) {
+            row_func = mask_alpha_row_avx2;
+        }
+#if PG_ENABLE_SSE_NEON
+        else if (_pg_mask_HasSSE_NEON()) {
+            row_func = mask_alpha_row_sse2;
+        }
+#endif /* PG_ENABLE_SSE_NEON */
+#endif /* !__EMSCRIPTEN__ */
+        for (y = 0; y < rect->h; ++y) {
+            pixel = (Uint8 *)surf->pixels + (rect->y + y) * surf->pitch +
+                    rect->x * 4;
+            row_func((Uint32 *)pixel, rect->w, format->Ashift, threshold,
+                     bitmask->bits + y, bitmask->h);
+        }
+        return;
+    }
+
+    for (y = 0; y < rect->h; ++y) {
+        pixel = (Uint8 *)surf->pixels + (rect->y + y) * surf->pitch +
+                rect->x * bpp;
 
-        for (x = 0; x < surf->w; ++x, pixel += bpp) {
+        for (x = 0; x < rect->w; ++x, pixel += bpp) {
             SDL_GetRGBA(get_pixel_color(pixel, bpp), format, rgba, rgba + 1,
                         rgba + 2, rgba + 3);
-            if (rgba[3] > threshold) {
-                bitmask_setbit(bitmask, x, y);
-            }
+            add_row_bit(bitmask, x, y, rgba[3] > threshold, &word);
         }
     }
 }
@@ -794,6 +2074,7 @@ set_from_threshold(SDL_Surface *surf, bitmask_t *bitmask, int threshold)
  *
  * Params:
  *     surf: surface
+ *     rect: area of the surface to use, the size of the bitmask
  *     bitmask: bitmask to alter
  *     colorkey: color used to check surface pixels against
  *
@@ -801,19 +2082,42 @@ set_from_threshold(SDL_Surface *surf, bitmask_t *bitmask, int threshold)
  *     void
  */
 static void
-set_from_colorkey(SDL_Surface *surf, bitmask_t *bitmask, Uint32 colorkey)
+set_from_colorkey(SDL_Surface *surf, SDL_Rect *rect, bitmask_t *bitmask,
+                  Uint32 colorkey)
 {
     Uint8 bpp = PG_SURF_BytesPerPixel(surf);
+    MASK_COLORKEY_ROW_P row_func = mask_colorkey_row;
     Uint8 *pixel = NULL;
+    BITMASK_W word = 0;
     int x, y;
 
-    for (y = 0; y < surf->h; ++y) {
-        pixel = (Uint8 *)surf->pixels + y * surf->pitch;
+    if (bpp == 4) {
+#if !defined(__EMSCRIPTEN__)
+        if (_pg_mask_has_avx2()) {
+            row_func = mask_colorkey_row_avx2;
+        }
+#if PG_ENABLE_SSE_NEON
+        else if (_pg_mask_HasSSE_NEON()) {
+            row_func = mask_colorkey_row_sse2;
+        }
+#endif /* PG_ENABLE_SSE_NEON */
+#endif /* !__EMSCRIPTEN__ */
+        for (y = 0; y < rect->h; ++y) {
+            pixel = (Uint8 *)surf->pixels + (rect->y + y) * surf->pitch +
+                    rect->x * 4;
+            row_func((Uint32 *)pixel, rect->w, colorkey, bitmask->bits + y,
+                     bitmask->h);
+        }
+        return;
+    }
 
-        for (x = 0; x < surf->w; ++x, pixel += bpp) {
-            if (get_pixel_color(pixel, bpp) != colorkey) {
-                bitmask_setbit(bitmask, x, y);
-            }
+    for (y = 0; y < rect->h; ++y) {
+        pixel = (Uint8 *)surf->pixels + (rect->y + y) * surf->pitch +
+                rect->x * bpp;
+
+        for (x = 0; x < rect->w; ++x, pixel += bpp) {
+            add_row_bit(bitmask, x, y, get_pixel_color(pixel, bpp) != colorkey,
+                        &word);
         }
     }
 }
@@ -829,12 +2133,15 @@ mask_from_surface(PyObject *self, PyObject *args, PyObject *kwargs)
     SDL_Surface *surf = NULL;
     pgSurfaceObject *surfobj;
     pgMaskObject *maskobj = NULL;
+    PyObject *rectobj = Py_None;
+    SDL_Rect area, temp_rect, *rect;
     Uint32 colorkey;
     int threshold = 127; /* default value */
-    static char *keywords[] = {"surface", "threshold", NULL};
+    static char *keywords[] = {"surface", "threshold", "rect", NULL};
 
-    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "O!|i", keywords,
-                                     &pgSurface_Type, &surfobj, &threshold)) {
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "O!|iO", keywords,
+                                     &pgSurface_Type, &surfobj, &threshold,
+                                     &rectobj)) {
         return NULL; /* Exception already set. */
     }
 
@@ -845,14 +2152,34 @@ mask_from_surface(PyObject *self, PyObject *args, PyObject *kwargs)
                      "cannot create mask with negative size");
     }
 
-    maskobj = CREATE_MASK_OBJ(surf->w, surf->h, 0);
+    if (rectobj == Py_None) {
+        area.x = area.y = 0;
+        area.w = surf->w;
+        area.h = surf->h;
+    }
+    else {
+        if (!(rect = pgRect_FromObject(rectobj, &temp_rect))) {
+            return RAISE(PyExc_TypeError, "invalid rect style argument");
+        }
+        if (rect->w < 0 || rect->h < 0) {
+            return RAISE(PyExc_ValueError,
+                         "cannot create mask with negative size");
+        }
+        if (rect->x < 0 || rect->y < 0 || rect->x + rect->w > surf->w ||
+            rect->y + rect->h > surf->h) {
+            return RAISE(PyExc_ValueError, "rect outside of surface area");
+        }
+        area = *rect;
+    }
+
+    maskobj = CREATE_MASK_OBJ(area.w, area.h, 0);
 
     if (NULL == maskobj) {
         return NULL; /* Exception already set. */
     }
 
-    if (surf->w == 0 || surf->h == 0) {
-        /* Nothing left to do for 0 sized surfaces. */
+    if (area.w == 0 || area.h == 0) {
+        /* Nothing left to do for 0 sized areas. */
         return (PyObject *)maskobj;
     }
 
@@ -865,10 +2192,10 @@ mask_from_surface(PyObject *self, PyObject *args, PyObject *kwargs)
 
     if (SDL_HasColorKey(surf)) {
         SDL_GetColorKey(surf, &colorkey);
-        set_from_colorkey(surf, maskobj->mask, colorkey);
+        set_from_colorkey(surf, &area, maskobj->mask, colorkey);
     }
     else {  // use threshold
-        set_from_threshold(surf, maskobj->mask, threshold);
+        set_from_threshold(surf, &area, maskobj->mask, threshold);
     }
 
     Py_END_ALLOW_THREADS; /* Obtain the GIL. */
@@ -902,7 +2229,10 @@ bitmask_threshold(bitmask_t *m, SDL_Surface *surf, SDL_Surface *surf2,
     Uint8 *pix;
     Uint8 r, g, b, a;
     Uint8 tr, tg, tb, ta;
-    int bpp1, bpp2;
+    MASK_THRESHOLD_ROW_P row_func = mask_threshold_row;
+    Uint32 tlimit;
+    BITMASK_W word = 0;
+    int bpp1, bpp2, set;
 
     format = surf->format;
     rmask = format->Rmask;
@@ -942,12 +2272,45 @@ bitmask_threshold(bitmask_t *m, SDL_Surface *surf, SDL_Surface *surf2,
     SDL_GetRGBA(color, format, &r, &g, &b, &a);
     SDL_GetRGBA(threshold, format, &tr, &tg, &tb, &ta);
 
+    /* 32 bit pixels with byte channels, compared bytewise */
+    if (bpp1 == 4 && rmask == (Uint32)0xFF << rshift &&
+        gmask == (Uint32)0xFF << gshift && bmask == (Uint32)0xFF << bshift &&
+        (!surf2 || (PG_SURF_BytesPerPixel(surf2) == 4 && rmask2 == rmask &&
+                    gmask2 == gmask && bmask2 == bmask))) {
+        if (!tr || !tg || !tb) {
+            return; /* no difference is less than 0 */
+        }
+        /* the bytes outside of the channels always match */
+        tlimit = ~(rmask | gmask | bmask) | (Uint32)(tr - 1) << rshift |
+                 (Uint32)(tg - 1) << gshift | (Uint32)(tb - 1) << bshift;
+#if !defined(__EMSCRIPTEN__)
+        if (_pg_mask_has_avx2()) {
+            row_func = mask_threshold_row_avx2;
+        }
+#if PG_ENABLE_SSE_NEON
+        else if (_pg_mask_HasSSE_NEON()) {
+            row_func = mask_threshold_row_sse2;
+        }
+#endif /* PG_ENABLE_SSE_NEON */
+#endif /* !__EMSCRIPTEN__ */
+        for (y = 0; y < surf->h; y++) {
+            pixels = (Uint8 *)surf->pixels + y * surf->pitch;
+            if (surf2) {
+                pixels2 = (Uint8 *)surf2->pixels + y * surf2->pitch;
+            }
+            row_func((Uint32 *)pixels, (Uint32 *)pixels2, surf->w, color,
+                     tlimit, m->bits + y, m->h);
+        }
+        return;
+    }
+
     for (y = 0; y < surf->h; y++) {
         pixels = (Uint8 *)surf->pixels + y * surf->pitch;
         if (surf2) {
             pixels2 = (Uint8 *)surf2->pixels + y * surf2->pitch;
         }
         for (x = 0; x < surf->w; x++) {
+            set = 0;
             /* the_color = surf->get_at(x,y) */
             switch (bpp1) {
                 case 1:
@@ -1007,7 +2370,7 @@ bitmask_threshold(bitmask_t *m, SDL_Surface *surf, SDL_Surface *surf2,
                     if (abs_diff_uint32(the_color2, the_color) < tr) {
                         /* this pixel is within the threshold of othersurface.
                          */
-                        bitmask_setbit(m, x, y);
+                        set = 1;
                     }
                 }
                 else if ((abs_diff_uint32(
@@ -1023,7 +2386,7 @@ bitmask_threshold(bitmask_t *m, SDL_Surface *surf, SDL_Surface *surf2,
                               (((the_color & bmask) >> bshift) << bloss)) <
                           tb)) {
                     /* this pixel is within the threshold of othersurface. */
-                    bitmask_setbit(m, x, y);
+                    set = 1;
                 }
 
                 /* TODO: will need to handle surfaces with palette colors.
@@ -1040,8 +2403,9 @@ bitmask_threshold(bitmask_t *m, SDL_Surface *surf, SDL_Surface *surf2,
                           (((the_color & bmask) >> bshift) << bloss), b) <
                       tb)) {
                 /* this pixel is within the threshold of the color. */
-                bitmask_setbit(m, x, y);
+                set = 1;
             }
+            add_row_bit(m, x, y, set, &word);
         }
     }
 }
@@ -1113,206 +2477,289 @@ mask_from_threshold(PyObject *self, PyObject *args, PyObject *kwargs)
     return (PyObject *)maskobj;
 }
 
-/* The initial labelling phase of the connected components algorithm.
+/* Connected component labelling.
  *
- * Connected component labeling based on the SAUF algorithm by Kesheng Wu,
- * Ekow Otoo, and Kenji Suzuki. The algorithm is best explained by their
- * paper, "Two Strategies to Speed up Connected Component Labeling Algorithms",
- * but in summary, it is a very efficient two pass method for 8-connected
- * components. It uses a decision tree to minimize the number of neighbors that
- * need to be checked. It stores equivalence information in an array based
- * union-find.
+ * The set bits of each row are found as runs, a word at a time, skipping
+ * the zero words. Runs of neighbouring rows that touch (8-connectivity) are
+ * joined in an array based union-find over the runs. The root of a
+ * component is always its first run (top to bottom, left to right), so the
+ * components are numbered in the order their first bits appear in the mask.
  *
- * Params:
- *     input - the input mask
- *     image - an array to store labelled pixels
- *     ufind - the union-find label equivalence array
- *     largest - an array to store the number of pixels for each label
- *
- * Returns:
- *     the highest label in the labelled image
+ * Large masks are cut into strips of rows, which have their runs found and
+ * joined by up to cc_threads threads. The runs on either side of each strip
+ * border are joined afterwards.
  */
-unsigned int
-cc_label(bitmask_t *input, unsigned int *image, unsigned int *ufind,
-         unsigned int *largest)
-{
-    unsigned int *buf;
-    unsigned int x, y, w, h, root, aroot, croot, temp, label;
+#define CC_MAX_THREADS 64
+#define CC_THREAD_MIN_ROWS 64
+#define CC_THREAD_MIN_BITS (1 << 18)
 
-    label = 0;
-    w = input->w;
-    h = input->h;
+/* Set with set_connected_components_threads(). */
+static int cc_threads = 1;
 
-    ufind[0] = 0;
-    buf = image;
+typedef struct {
+    int x, end; /* bits x to end - 1 of the row are set */
+    /* the union-find parent, then the number of the component (from 1) */
+    unsigned int parent;
+} cc_run;
 
-    /* special case for first pixel */
-    if (bitmask_getbit(input, 0, 0)) { /* process for a new connected comp: */
-        label++;                       /* create a new label */
-        *buf = label;                  /* give the pixel the label */
-        ufind[label] = label; /* put the label in the equivalence array */
-        largest[label] = 1;   /* the label has 1 pixel associated with it */
+typedef struct {
+    const bitmask_t *mask;
+    /* runs row_start[y] to row_start[y + 1] - 1 are the runs of row y */
+    unsigned int *row_start;
+    cc_run *runs;
+    int y1, y2; /* the rows y1 to y2 - 1 of the strip */
+    int count_only;
+} cc_strip;
+
+/* Counts the runs of each row of the strip into row_start[y + 1]. */
+static void
+cc_count_runs(cc_strip *strip)
+{
+    const bitmask_t *m = strip->mask;
+    const BITMASK_W *p, *end;
+    BITMASK_W word, carry;
+    unsigned int count;
+    int y;
+
+    for (y = strip->y1; y < strip->y2; ++y) {
+        count = 0;
+        carry = 0;
+        end = m->bits + MASK_STRIPES(m) * m->h + y;
+        for (p = m->bits + y; p < end; p += m->h) {
+            word = *p;
+            if (word) {
+                /* the bits that start a run */
+                count += _pg_mask_bitcount(word & ~((word << 1) | carry));
+            }
+            carry = word >> BITMASK_W_MASK;
+        }
+        strip->row_start[y + 1] = count;
     }
-    else {
-        *buf = 0;
+}
+
+static unsigned int
+cc_find(cc_run *runs, unsigned int r)
+{
+    while (runs[r].parent != r) {
+        runs[r].parent = runs[runs[r].parent].parent;
+        r = runs[r].parent;
     }
-    buf++;
+    return r;
+}
 
-    /* special case for first row.
-           Go over the first row except the first pixel.
-    */
-    for (x = 1; x < w; x++) {
-        if (bitmask_getbit(input, x, 0)) {
-            if (*(buf - 1)) { /* d label */
-                *buf = *(buf - 1);
-            }
-            else { /* create label */
-                label++;
-                *buf = label;
-                ufind[label] = label;
-                largest[label] = 0;
-            }
-            largest[*buf]++;
+/* Joins the components of runs a and b, keeping the first root. */
+static void
+cc_union(cc_run *runs, unsigned int a, unsigned int b)
+{
+    a = cc_find(runs, a);
+    b = cc_find(runs, b);
+    if (a < b) {
+        runs[b].parent = a;
+    }
+    else if (b < a) {
+        runs[a].parent = b;
+    }
+}
+
+/* Joins the runs of row y with the touching runs of row y - 1. */
+static void
+cc_join_rows(cc_run *runs, const unsigned int *row_start, int y)
+{
+    unsigned int r, p, q;
+    unsigned int above_end = row_start[y];
+
+    p = row_start[y - 1];
+    for (r = row_start[y]; r < row_start[y + 1] && p < above_end; ++r) {
+        /* skip the runs above that end left of this one's left neighbour */
+        while (p < above_end && runs[p].end < runs[r].x) {
+            ++p;
         }
-        else {
-            *buf = 0;
+        for (q = p; q < above_end && runs[q].x <= runs[r].end; ++q) {
+            cc_union(runs, r, q);
         }
-        buf++;
     }
+}
 
-    /* the rest of the image */
-    for (y = 1; y < h; y++) {
-        /* first pixel of the row */
-        if (bitmask_getbit(input, 0, y)) {
-            if (*(buf - w)) { /* b label */
-                *buf = *(buf - w);
-            }
-            else if (*(buf - w + 1)) { /* c label */
-                *buf = *(buf - w + 1);
-            }
-            else { /* create label */
-                label++;
-                *buf = label;
-                ufind[label] = label;
-                largest[label] = 0;
-            }
-            largest[*buf]++;
-        }
-        else {
-            *buf = 0;
-        }
-        buf++;
-        /* middle pixels of the row */
-        for (x = 1; x < (w - 1); x++) {
-            if (bitmask_getbit(input, x, y)) {
-                if (*(buf - w)) { /* b label */
-                    *buf = *(buf - w);
-                }
-                else if (*(buf - w + 1)) { /* c branch of tree */
-                    if (*(buf - w - 1)) {  /* union(c, a) */
-                        croot = root = *(buf - w + 1);
-                        while (ufind[root] < root) { /* find root */
-                            root = ufind[root];
-                        }
-                        if (croot != *(buf - w - 1)) {
-                            temp = aroot = *(buf - w - 1);
-                            while (ufind[aroot] < aroot) { /* find root */
-                                aroot = ufind[aroot];
-                            }
-                            if (root > aroot) {
-                                root = aroot;
-                            }
-                            while (ufind[temp] > root) { /* set root */
-                                aroot = ufind[temp];
-                                ufind[temp] = root;
-                                temp = aroot;
-                            }
-                        }
-                        while (ufind[croot] > root) { /* set root */
-                            temp = ufind[croot];
-                            ufind[croot] = root;
-                            croot = temp;
-                        }
-                        *buf = root;
-                    }
-                    else if (*(buf - 1)) { /* union(c, d) */
-                        croot = root = *(buf - w + 1);
-                        while (ufind[root] < root) { /* find root */
-                            root = ufind[root];
-                        }
-                        if (croot != *(buf - 1)) {
-                            temp = aroot = *(buf - 1);
-                            while (ufind[aroot] < aroot) { /* find root */
-                                aroot = ufind[aroot];
-                            }
-                            if (root > aroot) {
-                                root = aroot;
-                            }
-                            while (ufind[temp] > root) { /* set root */
-                                aroot = ufind[temp];
-                                ufind[temp] = root;
-                                temp = aroot;
-                            }
-                        }
-                        while (ufind[croot] > root) { /* set root */
-                            temp = ufind[croot];
-                            ufind[croot] = root;
-                            croot = temp;
-                        }
-                        *buf = root;
-                    }
-                    else { /* c label */
-                        *buf = *(buf - w + 1);
-                    }
-                }
-                else if (*(buf - w - 1)) { /* a label */
-                    *buf = *(buf - w - 1);
-                }
-                else if (*(buf - 1)) { /* d label */
-                    *buf = *(buf - 1);
-                }
-                else { /* create label */
-                    label++;
-                    *buf = label;
-                    ufind[label] = label;
-                    largest[label] = 0;
+/* Finds the runs of the rows of the strip and joins them. */
+static void
+cc_label_strip(cc_strip *strip)
+{
+    const bitmask_t *m = strip->mask;
+    const int stripes = MASK_STRIPES(m);
+    cc_run *run;
+    BITMASK_W word;
+    unsigned int r;
+    int y, i, pos, open, start;
+
+    for (y = strip->y1; y < strip->y2; ++y) {
+        run = strip->runs + strip->row_start[y];
+        open = 0;
+        start = 0;
+        for (i = 0; i < stripes; ++i) {
+            word = m->bits[i * m->h + y];
+            if (!word) {
+                if (open) {
+                    run->x = start;
+                    run->end = i * (int)BITMASK_W_LEN;
+                    ++run;
+                    open = 0;
                 }
-                largest[*buf]++;
-            }
-            else {
-                *buf = 0;
+                continue;
             }
-            buf++;
-        }
-        /* last pixel of the row, if it's not also the first pixel of the row
-         */
-        if (w > 1) {
-            if (bitmask_getbit(input, x, y)) {
-                if (*(buf - w)) { /* b label */
-                    *buf = *(buf - w);
-                }
-                else if (*(buf - w - 1)) { /* a label */
-                    *buf = *(buf - w - 1);
-                }
-                else if (*(buf - 1)) { /* d label */
-                    *buf = *(buf - 1);
+            for (pos = 0; pos < (int)BITMASK_W_LEN;) {
+                if (open) {
+                    if (!(~word >> pos)) {
+                        break; /* the run goes on into the next word */
+                    }
+                    pos += lowest_set_bit(~word >> pos);
+                    run->x = start;
+                    run->end = i * (int)BITMASK_W_LEN + pos;
+                    ++run;
+                    open = 0;
                 }
-                else { /* create label */
-                    label++;
-                    *buf = label;
-                    ufind[label] = label;
-                    largest[label] = 0;
+                else {
+                    if (!(word >> pos)) {
+                        break;
+                    }
+                    pos += lowest_set_bit(word >> pos);
+                    start = i * (int)BITMASK_W_LEN + pos;
+                    open = 1;
                 }
-                largest[*buf]++;
             }
-            else {
-                *buf = 0;
-            }
-            buf++;
+        }
+        if (open) {
+            run->x = start;
+            run->end = m->w;
+        }
+
+        for (r = strip->row_start[y]; r < strip->row_start[y + 1]; ++r) {
+            strip->runs[r].parent = r;
+        }
+        if (y > strip->y1) {
+            cc_join_rows(strip->runs, strip->row_start, y);
+        }
+    }
+}
+
+static void
+cc_strip_band(void *data, int i)
+{
+    cc_strip *strip = (cc_strip *)data + i;
+
+    if (strip->count_only) {
+        cc_count_runs(strip);
+    }
+    else {
+        cc_label_strip(strip);
+    }
+}
+
+/* Runs cc_strip_band() for every strip, on the blit threads */
+static void
+cc_run_strips(cc_strip *strips, int num_strips)
+{
+    pg_run_bands(cc_strip_band, strips, num_strips);
+}
+
+/* Labels the connected components of the mask.
+ *
+ * Params:
+ *     mask - the mask to label, with a width and height greater than 0
+ *     ret_row_start - passes back the first run of each row, the runs of
+ *         row y are ret_row_start[y] to ret_row_start[y + 1] - 1, memory is
+ *         allocated
+ *     num_components - passes back the number of connected components
+ *
+ * Returns:
+ *     the runs of the mask, with the parent of each run set to the number
+ *     (from 1) of its component, memory is allocated
+ *     NULL on memory allocation error
+ *
+ * NOTE: Caller is responsible for freeing the runs and "ret_row_start".
+ * Doesn't need the GIL.
+ */
+static cc_run *
+cc_label(const bitmask_t *mask, unsigned int **ret_row_start,
+         unsigned int *num_components)
+{
+    cc_strip strips[CC_MAX_THREADS];
+    unsigned int *row_start;
+    cc_run *runs;
+    unsigned int r, count = 0;
+    int i, y, num_strips = 1;
+    int w = mask->w, h = mask->h;
+
+    if ((Sint64)w * h >= CC_THREAD_MIN_BITS) {
+        num_strips = MAX(1, MIN(cc_threads, h / CC_THREAD_MIN_ROWS));
+    }
+
+    row_start = (unsigned int *)malloc(sizeof(unsigned int) * ((size_t)h + 1));
+    if (!row_start) {
+        return NULL;
+    }
+
+    for (i = 0; i < num_strips; ++i) {
+        strips[i].mask = mask;
+        strips[i].row_start = row_start;
+        strips[i].y1 = (int)((Sint64)h * i / num_strips);
+        strips[i].y2 = (int)((Sint64)h * (i + 1) / num_strips);
+        strips[i].count_only = 1;
+    }
+    cc_run_strips(strips, num_strips);
+
+    row_start[0] = 0;
+    for (y = 0; y < h; ++y) {
+        row_start[y + 1] += row_start[y];
+    }
+
+    /* one more run than needed, so an empty mask doesn't need malloc(0) */
+    runs = (cc_run *)malloc(sizeof(cc_run) * ((size_t)row_start[h] + 1));
+    if (!runs) {
+        free(row_start);
+        return NULL;
+    }
+
+    for (i = 0; i < num_strips; ++i) {
+        strips[i].runs = runs;
+        strips[i].count_only = 0;
+    }
+    cc_run_strips(strips, num_strips);
+
+    for (i = 1; i < num_strips; ++i) {
+        cc_join_rows(runs, row_start, strips[i].y1);
+    }
+
+    /* Number the components. A run that isn't a root has a parent before
+     * it, which already has its component number. */
+    for (r = 0; r < row_start[h]; ++r) {
+        if (runs[r].parent == r) {
+            runs[r].parent = ++count;
+        }
+        else {
+            runs[r].parent = runs[runs[r].parent].parent;
         }
     }
 
-    return label;
+    *ret_row_start = row_start;
+    *num_components = count;
+    return runs;
+}
+
+/* Sets bits x to end - 1 of row y of the mask. */
+static void
+cc_set_run(bitmask_t *m, int y, int x, int end)
+{
+    BITMASK_W bits;
+    int n, shift;
+
+    while (x < end) {
+        shift = x & BITMASK_W_MASK;
+        n = MIN((int)BITMASK_W_LEN - shift, end - x);
+        bits = (n == (int)BITMASK_W_LEN) ? ~(BITMASK_W)0
+                                          : (BITMASK_N(n) - 1) << shift;
+        m->bits[x / BITMASK_W_LEN * m->h + y] |= bits;
+        x += n;
+    }
 }
 
 /* Creates a bounding rect for each connected component in the given mask.
@@ -1335,113 +2782,64 @@ static int
 get_bounding_rects(bitmask_t *input, int *num_bounding_boxes,
                    SDL_Rect **ret_rects)
 {
-    unsigned int *image, *ufind, *largest, *buf;
-    unsigned int x_uf, label = 0;
-    int x, y, w, h, temp, relabel;
-    SDL_Rect *rects;
+    unsigned int *row_start;
+    unsigned int r, label = 0;
+    int y, right;
+    cc_run *runs;
+    SDL_Rect *rects, *rect;
 
     rects = NULL;
 
-    w = input->w;
-    h = input->h;
-
-    if (!w || !h) {
+    if (!input->w || !input->h) {
         *ret_rects = rects;
         return 0;
     }
-    /* a temporary image to assign labels to each bit of the mask */
-    image = (unsigned int *)malloc(sizeof(unsigned int) * w * h);
-    if (!image) {
-        return -2;
-    }
-
-    /* allocate enough space for the maximum possible connected components */
-    /* the union-find array. see wikipedia for info on union find */
-    ufind = (unsigned int *)malloc(sizeof(unsigned int) * (w / 2 + 1) *
-                                   (h / 2 + 1));
-    if (!ufind) {
-        free(image);
-        return -2;
-    }
 
-    largest = (unsigned int *)malloc(sizeof(unsigned int) * (w / 2 + 1) *
-                                     (h / 2 + 1));
-    if (!largest) {
-        free(image);
-        free(ufind);
+    runs = cc_label(input, &row_start, &label);
+    if (!runs) {
         return -2;
     }
 
-    /* do the initial labelling */
-    label = cc_label(input, image, ufind, largest);
-
-    relabel = 0;
-    /* flatten and relabel the union-find equivalence array.  Start at label 1
-       because label 0 indicates an unset pixel.  For this reason, we also use
-       <= label rather than < label. */
-    for (x_uf = 1; x_uf <= label; ++x_uf) {
-        if (ufind[x_uf] < x_uf) {             /* is it a union find root? */
-            ufind[x_uf] = ufind[ufind[x_uf]]; /* relabel it to its root */
-        }
-        else { /* it's a root */
-            relabel++;
-            ufind[x_uf] = relabel; /* assign the lowest label available */
-        }
-    }
-
-    *num_bounding_boxes = relabel;
+    *num_bounding_boxes = label;
 
-    if (relabel == 0) {
+    if (label == 0) {
         /* early out, as we didn't find anything. */
-        free(image);
-        free(ufind);
-        free(largest);
+        free(runs);
+        free(row_start);
         *ret_rects = rects;
         return 0;
     }
 
     /* the bounding rects, need enough space for the number of labels */
-    rects = (SDL_Rect *)malloc(sizeof(SDL_Rect) * (relabel + 1));
+    rects = (SDL_Rect *)calloc(label + 1, sizeof(SDL_Rect));
     if (!rects) {
-        free(image);
-        free(ufind);
-        free(largest);
+        free(runs);
+        free(row_start);
         return -2;
     }
 
-    for (temp = 0; temp <= relabel; temp++) {
-        rects[temp].h = 0; /* so we know if it's a new rect or not */
-    }
-
-    /* find the bounding rect of each connected component */
-    buf = image;
-    for (y = 0; y < h; y++) {
-        for (x = 0; x < w; x++) {
-            if (ufind[*buf]) { /* if the pixel is part of a component */
-                if (rects[ufind[*buf]].h) { /* the component has a rect */
-                    temp = rects[ufind[*buf]].x;
-                    rects[ufind[*buf]].x = MIN(x, temp);
-                    rects[ufind[*buf]].y = MIN(y, rects[ufind[*buf]].y);
-                    rects[ufind[*buf]].w =
-                        MAX(rects[ufind[*buf]].w + temp, x + 1) -
-                        rects[ufind[*buf]].x;
-                    rects[ufind[*buf]].h = MAX(rects[ufind[*buf]].h,
-                                               y - rects[ufind[*buf]].y + 1);
-                }
-                else { /* otherwise, start the rect */
-                    rects[ufind[*buf]].x = x;
-                    rects[ufind[*buf]].y = y;
-                    rects[ufind[*buf]].w = 1;
-                    rects[ufind[*buf]].h = 1;
-                }
+    /* find the bounding rect of each connected component, a rect with a
+     * height of 0 hasn't been started yet */
+    for (y = 0; y < input->h; y++) {
+        for (r = row_start[y]; r < row_start[y + 1]; r++) {
+            rect = rects + runs[r].parent;
+            if (rect->h) {
+                right = MAX(rect->x + rect->w, runs[r].end);
+                rect->x = MIN(rect->x, runs[r].x);
+                rect->w = right - rect->x;
+                rect->h = y - rect->y + 1;
+            }
+            else {
+                rect->x = runs[r].x;
+                rect->y = y;
+                rect->w = runs[r].end - runs[r].x;
+                rect->h = 1;
             }
-            buf++;
         }
     }
 
-    free(image);
-    free(ufind);
-    free(largest);
+    free(runs);
+    free(row_start);
     *ret_rects = rects;
 
     return 0;
@@ -1533,107 +2931,86 @@ mask_get_bounding_rects(PyObject *self, PyObject *_null)
 static int
 get_connected_components(bitmask_t *mask, bitmask_t ***components, int min)
 {
-    unsigned int *image, *ufind, *largest, *buf;
-    unsigned int x_uf, min_cc, label = 0;
-    int x, y, w, h, relabel;
+    unsigned int *row_start, *sizes;
+    unsigned int r, c, min_cc, label = 0;
+    int x, y, relabel;
+    cc_run *runs;
     bitmask_t **comps;
 
-    w = mask->w;
-    h = mask->h;
-
-    if (!w || !h) {
+    if (!mask->w || !mask->h) {
         return 0;
     }
 
-    /* a temporary image to assign labels to each bit of the mask */
-    image = (unsigned int *)malloc(sizeof(unsigned int) * w * h);
-    if (!image) {
+    runs = cc_label(mask, &row_start, &label);
+    if (!runs) {
         return -2;
     }
 
-    /* allocate enough space for the maximum possible connected components */
-    /* the union-find array. see wikipedia for info on union find */
-    ufind = (unsigned int *)malloc(sizeof(unsigned int) * (w / 2 + 1) *
-                                   (h / 2 + 1));
-    if (!ufind) {
-        free(image);
+    /* the number of bits of each component, then its new label */
+    sizes = (unsigned int *)calloc(label + 1, sizeof(unsigned int));
+    if (!sizes) {
+        free(runs);
+        free(row_start);
         return -2;
     }
-
-    largest = (unsigned int *)malloc(sizeof(unsigned int) * (w / 2 + 1) *
-                                     (h / 2 + 1));
-    if (!largest) {
-        free(image);
-        free(ufind);
-        return -2;
-    }
-
-    /* do the initial labelling */
-    label = cc_label(mask, image, ufind, largest);
-
-    for (x_uf = 1; x_uf <= label; ++x_uf) {
-        if (ufind[x_uf] < x_uf) {
-            largest[ufind[x_uf]] += largest[x_uf];
-        }
+    for (r = 0; r < row_start[mask->h]; ++r) {
+        sizes[runs[r].parent] += runs[r].end - runs[r].x;
     }
 
     relabel = 0;
     min_cc = (0 < min) ? (unsigned int)min : 0;
 
-    /* flatten and relabel the union-find equivalence array.  Start at label 1
-       because label 0 indicates an unset pixel.  For this reason, we also use
-       <= label rather than < label. */
-    for (x_uf = 1; x_uf <= label; ++x_uf) {
-        if (ufind[x_uf] < x_uf) {             /* is it a union find root? */
-            ufind[x_uf] = ufind[ufind[x_uf]]; /* relabel it to its root */
-        }
-        else { /* it's a root */
-            if (largest[x_uf] >= min_cc) {
-                relabel++;
-                ufind[x_uf] = relabel; /* assign the lowest label available */
-            }
-            else {
-                ufind[x_uf] = 0;
-            }
-        }
+    /* relabel the components that are big enough, starting at label 1
+       because label 0 is used for the ones that are dropped */
+    for (c = 1; c <= label; ++c) {
+        sizes[c] = (sizes[c] >= min_cc) ? ++relabel : 0;
     }
 
     if (relabel == 0) {
         /* early out, as we didn't find anything. */
-        free(image);
-        free(ufind);
-        free(largest);
+        free(runs);
+        free(row_start);
+        free(sizes);
         return 0;
     }
 
     /* allocate space for the mask array */
     comps = (bitmask_t **)malloc(sizeof(bitmask_t *) * (relabel + 1));
     if (!comps) {
-        free(image);
-        free(ufind);
-        free(largest);
+        free(runs);
+        free(row_start);
+        free(sizes);
         return -2;
     }
 
     /* create the empty masks */
     for (x = 1; x <= relabel; x++) {
-        comps[x] = bitmask_create(w, h);
+        comps[x] = bitmask_create(mask->w, mask->h);
+        if (!comps[x]) {
+            while (--x) {
+                bitmask_free(comps[x]);
+            }
+            free(comps);
+            free(runs);
+            free(row_start);
+            free(sizes);
+            return -2;
+        }
     }
 
     /* set the bits in each mask */
-    buf = image;
-    for (y = 0; y < h; y++) {
-        for (x = 0; x < w; x++) {
-            if (ufind[*buf]) { /* if the pixel is part of a component */
-                bitmask_setbit(comps[ufind[*buf]], x, y);
+    for (y = 0; y < mask->h; y++) {
+        for (r = row_start[y]; r < row_start[y + 1]; r++) {
+            if (sizes[runs[r].parent]) {
+                cc_set_run(comps[sizes[runs[r].parent]], y, runs[r].x,
+                           runs[r].end);
             }
-            buf++;
         }
     }
 
-    free(image);
-    free(ufind);
-    free(largest);
+    free(runs);
+    free(row_start);
+    free(sizes);
 
     *components = comps;
 
@@ -1711,8 +3088,8 @@ mask_connected_components(PyObject *self, PyObject *args, PyObject *kwargs)
 
 /* Finds the largest connected component in a given mask.
  *
- * Tracks the number of pixels in each label, finding the biggest one while
- * flattening the union-find equivalence array. It then writes an output mask
+ * Tracks the number of pixels in each component to find the biggest one (the
+ * first one of them if there are several). It then writes an output mask
  * containing only the largest connected component.
  *
  * Params:
@@ -1730,69 +3107,64 @@ mask_connected_components(PyObject *self, PyObject *args, PyObject *kwargs)
 static int
 largest_connected_comp(bitmask_t *input, bitmask_t *output, int ccx, int ccy)
 {
-    unsigned int *image, *ufind, *largest, *buf;
-    unsigned int max, x, y, w, h, label;
+    unsigned int *row_start, *sizes;
+    unsigned int r, c, max, label;
+    int y;
+    cc_run *runs;
 
-    w = input->w;
-    h = input->h;
-
-    if (!w || !h) {
+    if (!input->w || !input->h) {
         return 0;
     }
 
-    /* a temporary image to assign labels to each bit of the mask */
-    image = (unsigned int *)malloc(sizeof(unsigned int) * w * h);
-    if (!image) {
-        return -2;
-    }
-    /* allocate enough space for the maximum possible connected components */
-    /* the union-find array. see wikipedia for info on union find */
-    ufind = (unsigned int *)malloc(sizeof(unsigned int) * (w / 2 + 1) *
-                                   (h / 2 + 1));
-    if (!ufind) {
-        free(image);
-        return -2;
-    }
-    /* an array to track the number of pixels associated with each label */
-    largest = (unsigned int *)malloc(sizeof(unsigned int) * (w / 2 + 1) *
-                                     (h / 2 + 1));
-    if (!largest) {
-        free(image);
-        free(ufind);
+    runs = cc_label(input, &row_start, &label);
+    if (!runs) {
         return -2;
     }
 
-    /* do the initial labelling */
-    label = cc_label(input, image, ufind, largest);
-
-    max = 1;
-    /* flatten the union-find equivalence array */
-    for (x = 2; x <= label; x++) {
-        if (ufind[x] != x) {                 /* is it a union find root? */
-            largest[ufind[x]] += largest[x]; /* add its pixels to its root */
-            ufind[x] = ufind[ufind[x]];      /* relabel it to its root */
+    max = 0;
+    if (ccx >= 0) {
+        /* the component of the run holding (ccx, ccy) */
+        for (r = row_start[ccy]; r < row_start[ccy + 1]; r++) {
+            if (runs[r].x <= ccx && ccx < runs[r].end) {
+                max = runs[r].parent;
+                break;
+            }
         }
-        if (largest[ufind[x]] > largest[max]) { /* is it the new biggest? */
-            max = ufind[x];
+    }
+    else if (label) {
+        /* an array to track the number of bits of each component */
+        sizes = (unsigned int *)calloc(label + 1, sizeof(unsigned int));
+        if (!sizes) {
+            free(runs);
+            free(row_start);
+            return -2;
+        }
+        for (r = 0; r < row_start[input->h]; r++) {
+            sizes[runs[r].parent] += runs[r].end - runs[r].x;
+        }
+        /* the first of the biggest components */
+        max = 1;
+        for (c = 2; c <= label; c++) {
+            if (sizes[c] > sizes[max]) {
+                max = c;
+            }
         }
+        free(sizes);
     }
 
     /* write out the final image */
-    buf = image;
-    if (ccx >= 0)
-        max = ufind[*(buf + ccy * w + ccx)];
-    for (y = 0; y < h; y++) {
-        for (x = 0; x < w; x++) {
-            if (ufind[*buf] == max) {         /* if the label is the max one */
-                bitmask_setbit(output, x, y); /* set the bit in the mask */
+    if (max) {
+        for (y = 0; y < input->h; y++) {
+            for (r = row_start[y]; r < row_start[y + 1]; r++) {
+                if (runs[r].parent == max) {
+                    cc_set_run(output, y, runs[r].x, runs[r].end);
+                }
             }
-            buf++;
         }
     }
 
-    free(image);
-    free(ufind);
-    free(largest);
+    free(runs);
+    free(row_start);
 
     return 0;
 }
@@ -1802,7 +3174,7 @@ mask_connected_component(PyObject *self, PyObject *args, PyObject *kwargs)
 {
     bitmask_t *input = pgMask_AsBitmap(self);
     pgMaskObject *output_maskobj = NULL;
-    int x = -1, y = -1;
+    int x = -1, y = -1, r;
     Py_ssize_t args_exist = PyTuple_Size(args);
     PyObject *pos = NULL;
     static char *keywords[] = {"pos", NULL};
@@ -1835,7 +3207,11 @@ mask_connected_component(PyObject *self, PyObject *args, PyObject *kwargs)
      * returned mask is empty.
      */
     if (!args_exist || bitmask_getbit(input, x, y)) {
-        if (largest_connected_comp(input, output_maskobj->mask, x, y) == -2) {
+        Py_BEGIN_ALLOW_THREADS;
+        r = largest_connected_comp(input, output_maskobj->mask, x, y);
+        Py_END_ALLOW_THREADS;
+
+        if (r == -2) {
             Py_DECREF(output_maskobj);
             return RAISE(PyExc_MemoryError,
                          "cannot allocate memory for connected component");
@@ -1934,6 +3310,21 @@ draw_to_surface(SDL_Surface *surf, bitmask_t *bitmask, int x_dest, int y_dest,
         draw_setbits = draw_setbits && NULL != setcolor;
         draw_unsetbits = draw_unsetbits && NULL != unsetcolor;
 
+        if (bpp == 4) {
+            /* A word of mask bits at a time, see simd_mask.h */
+            MASK_TO_SURFACE_ROW_P kernel = get_to_surface_kernel();
+
+            for (y = y_start, ym = ym_start; y < y_end; ++y, ++ym) {
+                kernel((Uint32 *)((Uint8 *)surf->pixels + y * surf->pitch) +
+                           x_start,
+                       x_end - x_start, bitmask->bits + ym, bitmask->h,
+                       xm_start, draw_setbits ? *setcolor : 0,
+                       draw_unsetbits ? *unsetcolor : 0, draw_setbits,
+                       draw_unsetbits);
+            }
+            return;
+        }
+
         for (y = y_start, ym = ym_start; y < y_end; ++y, ++ym) {
             pixel = (Uint8 *)surf->pixels + y * surf->pitch + x_start * bpp;
 
@@ -2284,9 +3675,13 @@ static PyMethodDef mask_methods[] = {
      METH_VARARGS | METH_KEYWORDS, DOC_MASK_MASK_OVERLAPAREA},
     {"overlap_mask", (PyCFunction)mask_overlap_mask,
      METH_VARARGS | METH_KEYWORDS, DOC_MASK_MASK_OVERLAPMASK},
+    {"overlap_many", (PyCFunction)mask_overlap_many,
+     METH_VARARGS | METH_KEYWORDS, DOC_MASK_MASK_OVERLAPMANY},
     {"fill", mask_fill, METH_NOARGS, DOC_MASK_MASK_FILL},
     {"clear", mask_clear, METH_NOARGS, DOC_MASK_MASK_CLEAR},
     {"invert", mask_invert, METH_NOARGS, DOC_MASK_MASK_INVERT},
+    {"prepare_shifts", mask_prepare_shifts, METH_NOARGS,
+     DOC_MASK_MASK_PREPARESHIFTS},
     {"scale", (PyCFunction)mask_scale, METH_VARARGS | METH_KEYWORDS,
      DOC_MASK_MASK_SCALE},
     {"draw", (PyCFunction)mask_draw, METH_VARARGS | METH_KEYWORDS,
@@ -2296,8 +3691,11 @@ static PyMethodDef mask_methods[] = {
     {"count", mask_count, METH_NOARGS, DOC_MASK_MASK_COUNT},
     {"centroid", mask_centroid, METH_NOARGS, DOC_MASK_MASK_CENTROID},
     {"angle", mask_angle, METH_NOARGS, DOC_MASK_MASK_ANGLE},
+    {"moments", mask_get_moments, METH_NOARGS, DOC_MASK_MASK_MOMENTS},
     {"outline", (PyCFunction)mask_outline, METH_VARARGS | METH_KEYWORDS,
      DOC_MASK_MASK_OUTLINE},
+    {"outline_points", (PyCFunction)mask_outline_points,
+     METH_VARARGS | METH_KEYWORDS, DOC_MASK_MASK_OUTLINEPOINTS},
     {"convolve", (PyCFunction)mask_convolve, METH_VARARGS | METH_KEYWORDS,
      DOC_MASK_MASK_CONVOLVE},
     {"connected_component", (PyCFunction)mask_connected_component,
@@ -2359,6 +3757,9 @@ mask_dealloc(PyObject *self)
 {
     bitmask_t *bitmask = pgMask_AsBitmap(self);
 
+    mask_drop_caches((pgMaskObject *)self);
+    mask_drop_blocks((pgMaskObject *)self);
+
     if (NULL != bitmask) {
         /* Free up the bitmask. */
         bitmask_free(bitmask);
@@ -2385,6 +3786,10 @@ mask_new(PyTypeObject *subtype, PyObject *args, PyObject *kwargs)
     }
 
     maskobj->mask = NULL;
+    maskobj->shifts = NULL;
+    maskobj->blocks = NULL;
+    maskobj->outline = NULL;
+    maskobj->outline_len = 0;
     return (PyObject *)maskobj;
 }
 
@@ -2426,6 +3831,8 @@ mask_init(PyObject *self, PyObject *args, PyObject *kwargs)
         bitmask_fill(bitmask);
     }
 
+    mask_drop_caches((pgMaskObject *)self);
+    mask_drop_blocks((pgMaskObject *)self);
     ((pgMaskObject *)self)->mask = bitmask;
     return 0;
 }
@@ -2462,6 +3869,10 @@ pgMask_GetBuffer(pgMaskObject *self, Py_buffer *view, int flags)
         bufinfo->numbufs++;
     }
 
+    /* the bits can be changed through the buffer */
+    mask_drop_caches(self);
+    mask_drop_blocks(self);
+
     view->buf = m->bits;
     view->len = m->h * ((m->w - 1) / BITMASK_W_LEN + 1) * sizeof(BITMASK_W);
     view->readonly = 0;
@@ -2513,13 +3924,65 @@ static PyTypeObject pgMask_Type = {
 };
 
 /*mask module methods*/
+static PyObject *
+mask_set_connected_components_threads(PyObject *self, PyObject *arg)
+{
+    long num_threads = PyLong_AsLong(arg);
+
+    if (num_threads == -1 && PyErr_Occurred()) {
+        return NULL;
+    }
+    if (num_threads < 0) {
+        return RAISE(PyExc_ValueError,
+                     "the number of threads must not be negative");
+    }
+    if (num_threads == 0) {
+        num_threads = SDL_GetCPUCount();
+    }
+    cc_threads = (int)MIN(num_threads, CC_MAX_THREADS);
+    Py_RETURN_NONE;
+}
+
+static PyObject *
+mask_get_connected_components_threads(PyObject *self, PyObject *_null)
+{
+    return PyLong_FromLong(cc_threads);
+}
+
 static PyMethodDef _mask_methods[] = {
     {"from_surface", (PyCFunction)mask_from_surface,
      METH_VARARGS | METH_KEYWORDS, DOC_MASK_FROMSURFACE},
     {"from_threshold", (PyCFunction)mask_from_threshold,
      METH_VARARGS | METH_KEYWORDS, DOC_MASK_FROMTHRESHOLD},
+    {"set_connected_components_threads",
+     mask_set_connected_components_threads, METH_O,
+     DOC_MASK_SETCONNECTEDCOMPONENTSTHREADS},
+    {"get_connected_components_threads",
+     mask_get_connected_components_threads, METH_NOARGS,
+     DOC_MASK_GETCONNECTEDCOMPONENTSTHREADS},
     {NULL, NULL, 0, NULL}};
 
+/* The bitmask.h kernels are handed to bitmask.c once, the others are
+ * picked on every call */
+static int
+_mask_simd_dispatch(PyObject *dispatch)
+{
+    int has_avx2 = 0, has_sse2_neon = 0;
+
+    if (!dispatch) {
+        set_bitmask_kernels();
+        return 0;
+    }
+#if !defined(__EMSCRIPTEN__)
+    has_avx2 = _pg_mask_has_avx2();
+#if PG_ENABLE_SSE_NEON
+    has_sse2_neon = _pg_mask_HasSSE_NEON();
+#endif /* PG_ENABLE_SSE_NEON */
+#endif /* __EMSCRIPTEN__ */
+    return pg_simd_report(dispatch, "mask",
+                          pg_simd_backend_name(has_avx2, has_sse2_neon));
+}
+
 MODINIT_DEFINE(mask)
 {
     PyObject *module, *apiobj;
@@ -2555,10 +4018,16 @@ MODINIT_DEFINE(mask)
         return NULL;
     }
 
+    set_bitmask_kernels();
+    pg_RegisterSIMDDispatch(_mask_simd_dispatch);
+
     /* create the mask type */
     if (PyType_Ready(&pgMask_Type) < 0) {
         return NULL;
     }
+    if (PyType_Ready(&pgMaskOutline_Type) < 0) {
+        return NULL;
+    }
 
     /* create the module */
     module = PyModule_Create(&_module);
@@ -30,7 +30,6 @@
 #endif
 
 #define PYGAMEAPI_MATH_INTERNAL
-#define NO_PYGAME_C_API
 #include "doc/math_doc.h"
 
 #include "pygame.h"
@@ -39,6 +38,8 @@
 
 #include "pgcompat.h"
 
+#include "simd_noise.h"
+
 #include <float.h>
 #include <math.h>
 #include <stddef.h>
@@ -56,7 +57,7 @@
 #endif /* M_PI_2 */
 
 #define VECTOR_EPSILON (1e-6)
-#define VECTOR_MAX_SIZE (3)
+#define VECTOR_FREELIST_MAX (256)
 #define STRING_BUF_SIZE_REPR (110)
 #define STRING_BUF_SIZE_STR (103)
 #define SWIZZLE_ERR_NO_ERR 0
@@ -84,10 +85,13 @@ static PyTypeObject pgVector2_Type;
 static PyTypeObject pgVector3_Type;
 static PyTypeObject pgVectorElementwiseProxy_Type;
 static PyTypeObject pgVectorIter_Type;
+static PyTypeObject pgVector2Array_Type;
 
 #define pgVector2_Check(x) (PyType_IsSubtype(Py_TYPE(x), &pgVector2_Type))
 #define pgVector3_Check(x) (PyType_IsSubtype(Py_TYPE(x), &pgVector3_Type))
 #define pgVector_Check(x) (pgVector2_Check(x) || pgVector3_Check(x))
+#define pgVector2Array_Check(x) \
+    (PyType_IsSubtype(Py_TYPE(x), &pgVector2Array_Type))
 #define vector_elementwiseproxy_Check(x) \
     (Py_TYPE(x) == &pgVectorElementwiseProxy_Type)
 #define _vector_subtype_new(x) \
@@ -96,12 +100,6 @@ static PyTypeObject pgVectorIter_Type;
 #define DEG2RAD(angle) ((angle) * M_PI / 180.)
 #define RAD2DEG(angle) ((angle) * 180. / M_PI)
 
-typedef struct {
-    PyObject_HEAD double coords[VECTOR_MAX_SIZE]; /* Coordinates */
-    Py_ssize_t dim;                               /* Dimension of the vector */
-    double epsilon; /* Small value for comparisons */
-} pgVector;
-
 typedef struct {
     PyObject_HEAD long it_index;
     pgVector *vec;
@@ -111,6 +109,28 @@ typedef struct {
     PyObject_HEAD pgVector *vec;
 } vector_elementwiseproxy;
 
+typedef struct {
+    PyObject_HEAD double *coords; /* x0, y0, x1, y1, ... */
+    Py_ssize_t length;            /* Number of vectors */
+    Py_ssize_t exports;           /* Number of active buffer exports */
+    Py_ssize_t shape[2];
+    Py_ssize_t strides[2];
+    PyObject *weakreflist;
+} pgVector2Array;
+
+/* Deallocated instances of exactly Vector2 or Vector3 are kept here and
+ * handed out again by vector2_new()/vector3_new(), so the temporaries made by
+ * arithmetic don't hit the allocator every time. Subclasses are not cached. */
+typedef struct {
+    pgVector *items[VECTOR_FREELIST_MAX];
+    int num;
+    unsigned long long hits;   /* allocations served from the free list */
+    unsigned long long misses; /* allocations that used tp_alloc */
+} pgVectorFreelist;
+
+static pgVectorFreelist vector2_freelist;
+static pgVectorFreelist vector3_freelist;
+
 /* further forward declarations */
 /* math functions */
 static PyObject *
@@ -644,9 +664,57 @@ pgVector_NEW(Py_ssize_t dim)
     }
 }
 
+static pgVectorFreelist *
+_vector_freelist_for(PyTypeObject *type)
+{
+#ifdef Py_GIL_DISABLED
+    /* the freelists are not thread-safe without the GIL */
+    return NULL;
+#endif
+    if (type == &pgVector2_Type) {
+        return &vector2_freelist;
+    }
+    if (type == &pgVector3_Type) {
+        return &vector3_freelist;
+    }
+    return NULL;
+}
+
+static pgVector *
+_vector_alloc(PyTypeObject *type)
+{
+    pgVector *vec;
+    pgVectorFreelist *freelist = _vector_freelist_for(type);
+
+    if (freelist) {
+        if (freelist->num > 0) {
+            vec = freelist->items[--freelist->num];
+#ifdef PYPY_VERSION
+            Py_INCREF(vec);
+            /* See the comment in RectExport_new (rect_impl.h) */
+            ((PyObject *)(vec))->ob_pypy_link = 0;
+#else
+            PyObject_Init((PyObject *)vec, type);
+#endif
+            /* tp_alloc hands out zeroed memory, keep it that way */
+            memset(vec->coords, 0, sizeof(vec->coords));
+            freelist->hits++;
+            return vec;
+        }
+        freelist->misses++;
+    }
+    return (pgVector *)type->tp_alloc(type, 0);
+}
+
 static void
 vector_dealloc(pgVector *self)
 {
+    pgVectorFreelist *freelist = _vector_freelist_for(Py_TYPE(self));
+
+    if (freelist && freelist->num < VECTOR_FREELIST_MAX) {
+        freelist->items[freelist->num++] = self;
+        return;
+    }
     Py_TYPE(self)->tp_free((PyObject *)self);
 }
 
@@ -1911,42 +1979,62 @@ vector_project_onto(pgVector *self, PyObject *other)
     return (PyObject *)ret;
 }
 
-/* This method first tries normal attribute access. If successful we're
- * done. If not we try swizzling. Here we have 3 different outcomes:
- *  1) swizzling works. we return the result as a tuple
- *  2) swizzling fails because it wasn't a valid swizzle. we return the
- *     original AttributeError
- *  3) swizzling fails due to some internal error. we return this error.
+/* The coordinate a swizzle character stands for, -2 and -1 for the '0' and
+ * '1' constants, or -3 if the character can't be part of a swizzle */
+static int
+_vector_swizzle_index(Py_UCS4 c)
+{
+    switch (c) {
+        case 'x':
+            return 0;
+        case 'y':
+            return 1;
+        case 'z':
+            return 2;
+        case 'w':
+            return 3;
+        case '0':
+            return -2;
+        case '1':
+            return -1;
+    }
+    return -3;
+}
+
+/* Whether attr_name, an exact or derived str, may be a swizzle. Single
+ * letters are the coordinate getsets, and a swizzle starts with a
+ * coordinate. This only peeks at the name, so plain attribute and method
+ * access goes to the generic lookup as quickly as on any object. */
+static int
+_vector_maybe_swizzle(PyObject *attr_name)
+{
+    return PyUnicode_Check(attr_name) &&
+           PyUnicode_GET_LENGTH(attr_name) > 1 &&
+           _vector_swizzle_index(PyUnicode_READ_CHAR(attr_name, 0)) >= 0;
+}
+
+/* Names that can't be swizzles take the generic attribute lookup right
+ * away. The others are swizzled if every character is valid for the
+ * vector, which gives a Vector2 or Vector3 for 2 or 3 characters and a
+ * tuple for more. Otherwise they fall back to the generic lookup too, so
+ * a name that is no swizzle raises the usual AttributeError.
  */
 static PyObject *
 vector_getAttr_swizzle(pgVector *self, PyObject *attr_name)
 {
     double value;
-    double *coords;
-    Py_ssize_t i, idx, len;
-    PyObject *attr_unicode = NULL;
-    const char *attr = NULL;
-    PyObject *res = NULL;
-
-    len = PySequence_Length(attr_name);
+    Py_ssize_t i, len;
+    int idx;
+    PyObject *res, *item;
 
-    if (len == 1) {
+    if (!_vector_maybe_swizzle(attr_name))
         return PyObject_GenericGetAttr((PyObject *)self, attr_name);
-    }
 
-    if (len < 0)
-        goto swizzle_failed;
-    coords = self->coords;
-    attr_unicode = PyUnicode_FromObject(attr_name);
-    if (attr_unicode == NULL)
-        goto swizzle_failed;
-    attr = PyUnicode_AsUTF8AndSize(attr_unicode, &len);
-    if (attr == NULL)
-        goto internal_error;
-    /* If we are not a swizzle, go straight to GenericGetAttr. */
-    if ((attr[0] != 'x') && (attr[0] != 'y') && (attr[0] != 'z') &&
-        (attr[0] != 'w')) {
-        goto swizzle_failed;
+    len = PyUnicode_GET_LENGTH(attr_name);
+    for (i = 0; i < len; i++) {
+        idx = _vector_swizzle_index(PyUnicode_READ_CHAR(attr_name, i));
+        if (idx == -3 || idx >= self->dim)
+            return PyObject_GenericGetAttr((PyObject *)self, attr_name);
     }
 
     if (len == 2 || len == 3) {
@@ -1954,111 +2042,54 @@ vector_getAttr_swizzle(pgVector *self, PyObject *attr_name)
     }
     else {
         /* More than 3, we return a tuple. */
-        res = (PyObject *)PyTuple_New(len);
+        res = PyTuple_New(len);
     }
     if (res == NULL)
-        goto internal_error;
+        return NULL;
     for (i = 0; i < len; i++) {
-        switch (attr[i]) {
-            case 'x':
-            case 'y':
-            case 'z':
-                idx = attr[i] - 'x';
-                goto swizzle_idx;
-            case 'w':
-                idx = 3;
-
-            swizzle_idx:
-                if (idx >= self->dim) {
-                    goto swizzle_failed;
-                };
-                value = coords[idx];
-                break;
-
-            case '0':
-                value = 0.0f;
-                break;
-            case '1':
-                value = 1.0f;
-                break;
-
-            default:
-                goto swizzle_failed;
-        }
+        idx = _vector_swizzle_index(PyUnicode_READ_CHAR(attr_name, i));
+        value = idx >= 0 ? self->coords[idx] : (double)(idx + 2);
         if (len == 2 || len == 3) {
             ((pgVector *)res)->coords[i] = value;
         }
         else {
-            if (PyTuple_SetItem(res, i, PyFloat_FromDouble(value)) != 0)
-                goto internal_error;
+            if (!(item = PyFloat_FromDouble(value))) {
+                Py_DECREF(res);
+                return NULL;
+            }
+            PyTuple_SET_ITEM(res, i, item);
         }
     }
-    /* swizzling succeeded! */
-    Py_DECREF(attr_unicode);
     return res;
-
-    /* swizzling failed! clean up and return NULL */
-swizzle_failed:
-    Py_XDECREF(res);
-    Py_XDECREF(attr_unicode);
-    return PyObject_GenericGetAttr((PyObject *)self, attr_name);
-internal_error:
-    Py_XDECREF(res);
-    Py_XDECREF(attr_unicode);
-    return NULL;
 }
 
 static int
 vector_setAttr_swizzle(pgVector *self, PyObject *attr_name, PyObject *val)
 {
-    const char *attr = NULL;
-    PyObject *attr_unicode;
-    Py_ssize_t len = PySequence_Length(attr_name);
+    Py_ssize_t len;
     double entry[VECTOR_MAX_SIZE];
     int entry_was_set[VECTOR_MAX_SIZE];
     int swizzle_err = SWIZZLE_ERR_NO_ERR;
     Py_ssize_t i;
 
-    if (len == 1)
+    if (!_vector_maybe_swizzle(attr_name))
         return PyObject_GenericSetAttr((PyObject *)self, attr_name, val);
 
-    /* if swizzling is enabled first try swizzle */
     for (i = 0; i < self->dim; ++i)
         entry_was_set[i] = 0;
 
-    /* handle string and unicode uniformly */
-    attr_unicode = PyUnicode_FromObject(attr_name);
-    if (attr_unicode == NULL)
-        return -1;
-    attr = PyUnicode_AsUTF8AndSize(attr_unicode, &len);
-
-    if (attr == NULL) {
-        Py_DECREF(attr_unicode);
-        return -1;
+    /* constants can't be assigned to, nor coordinates the vector doesn't
+     * have. check the whole name before reading val, names that are no
+     * swizzle attempt generic attribute setting */
+    len = PyUnicode_GET_LENGTH(attr_name);
+    for (i = 0; i < len; ++i) {
+        int idx = _vector_swizzle_index(PyUnicode_READ_CHAR(attr_name, i));
+        if (idx < 0 || idx >= self->dim)
+            return PyObject_GenericSetAttr((PyObject *)self, attr_name, val);
     }
 
     for (i = 0; i < len; ++i) {
-        int idx;
-        switch (attr[i]) {
-            case 'x':
-            case 'y':
-            case 'z':
-                idx = attr[i] - 'x';
-                break;
-            case 'w':
-                idx = 3;
-                break;
-            default:
-                /* swizzle failed. attempt generic attribute setting */
-                Py_DECREF(attr_unicode);
-                return PyObject_GenericSetAttr((PyObject *)self, attr_name,
-                                               val);
-        }
-        if (idx >= self->dim) {
-            /* swizzle failed. attempt generic attribute setting */
-            Py_DECREF(attr_unicode);
-            return PyObject_GenericSetAttr((PyObject *)self, attr_name, val);
-        }
+        int idx = _vector_swizzle_index(PyUnicode_READ_CHAR(attr_name, i));
         if (entry_was_set[idx])
             swizzle_err = SWIZZLE_ERR_DOUBLE_IDX;
         if (swizzle_err == SWIZZLE_ERR_NO_ERR) {
@@ -2068,7 +2099,6 @@ vector_setAttr_swizzle(pgVector *self, PyObject *attr_name, PyObject *val)
                 swizzle_err = SWIZZLE_ERR_EXTRACTION_ERR;
         }
     }
-    Py_DECREF(attr_unicode);
 
     switch (swizzle_err) {
         case SWIZZLE_ERR_NO_ERR:
@@ -2210,7 +2240,7 @@ vector___round__(pgVector *self, PyObject *args)
 static PyObject *
 vector2_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
 {
-    pgVector *vec = (pgVector *)type->tp_alloc(type, 0);
+    pgVector *vec = _vector_alloc(type);
 
     if (vec != NULL) {
         vec->dim = 2;
@@ -2641,7 +2671,7 @@ static PyTypeObject pgVector2_Type = {
 static PyObject *
 vector3_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
 {
-    pgVector *vec = (pgVector *)type->tp_alloc(type, 0);
+    pgVector *vec = _vector_alloc(type);
 
     if (vec != NULL) {
         vec->dim = 3;
@@ -4192,142 +4222,1074 @@ vector_elementwise(pgVector *vec, PyObject *_null)
     return (PyObject *)proxy;
 }
 
-static inline double
-lerp(double a, double b, double v)
-{
-    return a + (b - a) * v;
-}
+/********************************
+ * pgVector2Array type definition
+ ********************************/
 
-static inline double
-invlerp(double a, double b, double v)
+/* The vectors are stored as one contiguous block of doubles
+ * (x0, y0, x1, y1, ...). The element-wise helpers below are plain loops over
+ * that block without any Python object in between, so the compiler can
+ * vectorize them. */
+
+static PyObject *
+_vector2array_new(PyTypeObject *type, Py_ssize_t length)
 {
-    return (v - a) / (b - a);
+    pgVector2Array *ret = (pgVector2Array *)type->tp_alloc(type, 0);
+
+    if (ret == NULL) {
+        return NULL;
+    }
+    ret->coords = PyMem_Calloc(length ? 2 * length : 1, sizeof(double));
+    if (ret->coords == NULL) {
+        Py_DECREF(ret);
+        return PyErr_NoMemory();
+    }
+    ret->length = length;
+    ret->shape[0] = length;
+    ret->shape[1] = 2;
+    ret->strides[0] = 2 * sizeof(double);
+    ret->strides[1] = sizeof(double);
+    return (PyObject *)ret;
 }
 
 static PyObject *
-math_clamp(PyObject *self, PyObject *const *args, Py_ssize_t nargs)
+vector2array_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
 {
-    if (nargs != 3)
-        return RAISE(PyExc_TypeError, "clamp requires 3 arguments");
+    return _vector2array_new(type, 0);
+}
 
-    PyObject *value = args[0];
-    PyObject *min = args[1];
-    PyObject *max = args[2];
+/* Fills coords with the vectors of a sequence, returns the number of vectors
+ * or -1 on error */
+static Py_ssize_t
+_vector2array_coords_from_seq(PyObject *seq, double **coords)
+{
+    PyObject *fast, **items;
+    Py_ssize_t i, length;
 
-    if (PyNumber_Check(args[0]) != 1 || PyNumber_Check(args[1]) != 1 ||
-        PyNumber_Check(args[2]) != 1) {
-        return RAISE(PyExc_TypeError, "clamp requires 3 numeric arguments");
+    fast = PySequence_Fast(seq, "Expected a sequence of Vector2");
+    if (fast == NULL) {
+        return -1;
+    }
+    length = PySequence_Fast_GET_SIZE(fast);
+    items = PySequence_Fast_ITEMS(fast);
+    *coords = PyMem_Calloc(length ? 2 * length : 1, sizeof(double));
+    if (*coords == NULL) {
+        Py_DECREF(fast);
+        PyErr_NoMemory();
+        return -1;
+    }
+    for (i = 0; i < length; ++i) {
+        if (!pg_VectorCoordsFromObj(items[i], 2, *coords + 2 * i)) {
+            PyMem_Free(*coords);
+            *coords = NULL;
+            Py_DECREF(fast);
+            PyErr_SetString(PyExc_TypeError,
+                            "Vector2Array items must be Vector2 compatible");
+            return -1;
+        }
     }
+    Py_DECREF(fast);
+    return length;
+}
 
-    // Using RichCompare instead of converting to C types for performance
-    // reasons. This implementation was tested to be faster than using
-    // PyFloat_AsDouble and PyErr_Occurred.
+static int
+vector2array_init(pgVector2Array *self, PyObject *args, PyObject *kwds)
+{
+    PyObject *obj = NULL;
+    double *coords = NULL;
+    Py_ssize_t length = 0;
+    static char *kwlist[] = {"vectors", NULL};
 
-    // if value < min: return min
-    int result = PyObject_RichCompareBool(value, min, Py_LT);
-    if (result == 1) {
-        Py_INCREF(min);
-        return min;
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "|O:Vector2Array", kwlist,
+                                     &obj)) {
+        return -1;
+    }
+    if (self->exports > 0) {
+        PyErr_SetString(PyExc_BufferError,
+                        "Vector2Array is exporting its buffer");
+        return -1;
     }
-    else if (result == -1)
-        return NULL;
 
-    // if value > max: return max
-    result = PyObject_RichCompareBool(value, max, Py_GT);
-    if (result == 1) {
-        Py_INCREF(max);
-        return max;
+    if (obj == NULL) {
+        coords = PyMem_Calloc(1, sizeof(double));
     }
-    else if (result == -1)
-        return NULL;
+    else if (PyLong_Check(obj)) {
+        length = PyLong_AsSsize_t(obj);
+        if (length == -1 && PyErr_Occurred()) {
+            return -1;
+        }
+        if (length < 0) {
+            PyErr_SetString(PyExc_ValueError,
+                            "Vector2Array length must not be negative");
+            return -1;
+        }
+        if (length > PY_SSIZE_T_MAX / (Py_ssize_t)(2 * sizeof(double))) {
+            PyErr_NoMemory();
+            return -1;
+        }
+        coords = PyMem_Calloc(length ? 2 * length : 1, sizeof(double));
+    }
+    else if (pgVector2Array_Check(obj)) {
+        length = ((pgVector2Array *)obj)->length;
+        coords = PyMem_Malloc((length ? 2 * length : 1) * sizeof(double));
+        if (coords) {
+            memcpy(coords, ((pgVector2Array *)obj)->coords,
+                   2 * length * sizeof(double));
+        }
+    }
+    else if (PyObject_CheckBuffer(obj)) {
+        Py_buffer view;
+        int ok;
 
-    Py_INCREF(value);
-    return value;
+        if (PyObject_GetBuffer(obj, &view, PyBUF_FORMAT | PyBUF_ND)) {
+            return -1;
+        }
+        ok = view.format && strcmp(view.format, "d") == 0 &&
+             PyBuffer_IsContiguous(&view, 'C') &&
+             ((view.ndim == 2 && view.shape[1] == 2) ||
+              (view.ndim == 1 && view.shape[0] % 2 == 0));
+        if (!ok) {
+            PyBuffer_Release(&view);
+            PyErr_SetString(PyExc_ValueError,
+                            "buffer must be C contiguous doubles with a "
+                            "shape of (n, 2) or (n * 2,)");
+            return -1;
+        }
+        length = view.len / (2 * sizeof(double));
+        coords = PyMem_Malloc((length ? 2 * length : 1) * sizeof(double));
+        if (coords) {
+            memcpy(coords, view.buf, 2 * length * sizeof(double));
+        }
+        PyBuffer_Release(&view);
+    }
+    else {
+        length = _vector2array_coords_from_seq(obj, &coords);
+        if (length < 0) {
+            return -1;
+        }
+    }
+
+    if (coords == NULL) {
+        PyErr_NoMemory();
+        return -1;
+    }
+    PyMem_Free(self->coords);
+    self->coords = coords;
+    self->length = length;
+    self->shape[0] = length;
+    return 0;
 }
 
-#define RAISE_ARG_TYPE_ERROR(var)                                     \
-    if (PyErr_Occurred()) {                                           \
-        return RAISE(PyExc_TypeError,                                 \
-                     "The argument '" var "' must be a real number"); \
+static void
+vector2array_dealloc(pgVector2Array *self)
+{
+    if (self->weakreflist) {
+        PyObject_ClearWeakRefs((PyObject *)self);
     }
+    PyMem_Free(self->coords);
+    Py_TYPE(self)->tp_free((PyObject *)self);
+}
 
-static PyObject *
-math_invlerp(PyObject *self, PyObject *const *args, Py_ssize_t nargs)
+/* Gets the other operand of an element-wise operation. Another array must
+ * have the same length and is used with a step of 2 doubles, a single vector
+ * is copied into buf and broadcast with a step of 0.
+ * Returns 1 on success, 0 if obj is not usable (no exception set) and -1 on
+ * error. */
+static int
+_vector2array_operand(pgVector2Array *self, PyObject *obj,
+                      const double **coords, Py_ssize_t *step, double *buf)
 {
-    if (nargs != 3)
-        return RAISE(PyExc_TypeError,
-                     "invlerp requires exactly 3 numeric arguments");
+    if (pgVector2Array_Check(obj)) {
+        if (((pgVector2Array *)obj)->length != self->length) {
+            PyErr_SetString(PyExc_ValueError,
+                            "Vector2Array lengths don't match");
+            return -1;
+        }
+        *coords = ((pgVector2Array *)obj)->coords;
+        *step = 2;
+        return 1;
+    }
+    if (pg_VectorCoordsFromObj(obj, 2, buf)) {
+        *coords = buf;
+        *step = 0;
+        return 1;
+    }
+    return 0;
+}
 
-    double a = PyFloat_AsDouble(args[0]);
-    RAISE_ARG_TYPE_ERROR("a")
-    double b = PyFloat_AsDouble(args[1]);
-    RAISE_ARG_TYPE_ERROR("b")
-    double t = PyFloat_AsDouble(args[2]);
-    RAISE_ARG_TYPE_ERROR("value")
+/* dst = sa * a + sb * b, where sa and sb are 1 or -1 */
+static void
+_vector2array_add_helper(double *dst, const double *a, double sa,
+                         const double *b, Py_ssize_t b_step, double sb,
+                         Py_ssize_t length)
+{
+    Py_ssize_t i;
 
-    if (PyErr_Occurred())
-        return RAISE(PyExc_ValueError,
-                     "invalid argument values passed to invlerp, numbers "
-                     "might be too small or too big");
+    if (b_step) {
+        for (i = 0; i < 2 * length; ++i) {
+            dst[i] = sa * a[i] + sb * b[i];
+        }
+    }
+    else {
+        const double bx = sb * b[0], by = sb * b[1];
+        for (i = 0; i < length; ++i) {
+            dst[2 * i] = sa * a[2 * i] + bx;
+            dst[2 * i + 1] = sa * a[2 * i + 1] + by;
+        }
+    }
+}
 
-    if (b - a == 0)
-        return RAISE(PyExc_ValueError,
-                     "the result of b - a needs to be different from zero");
+static void
+_vector2array_scale_helper(double *dst, const double *src, double factor,
+                           Py_ssize_t length)
+{
+    Py_ssize_t i;
 
-    return PyFloat_FromDouble(invlerp(a, b, t));
+    for (i = 0; i < 2 * length; ++i) {
+        dst[i] = src[i] * factor;
+    }
 }
 
-#
-
 static PyObject *
-math_remap(PyObject *self, PyObject *const *args, Py_ssize_t nargs)
+_vector2array_add_sub(PyObject *o1, PyObject *o2, int subtract)
 {
-    if (nargs != 5)
-        return RAISE(PyExc_TypeError,
-                     "remap requires exactly 5 numeric arguments");
-
-    PyObject *i_min = args[0];
-    PyObject *i_max = args[1];
-    PyObject *o_min = args[2];
-    PyObject *o_max = args[3];
-    PyObject *value = args[4];
-
-    double v = PyFloat_AsDouble(value);
-    RAISE_ARG_TYPE_ERROR("value")
-    double a = PyFloat_AsDouble(i_min);
-    RAISE_ARG_TYPE_ERROR("i_min")
-    double b = PyFloat_AsDouble(i_max);
-    RAISE_ARG_TYPE_ERROR("i_max")
-    double c = PyFloat_AsDouble(o_min);
-    RAISE_ARG_TYPE_ERROR("o_min")
-    double d = PyFloat_AsDouble(o_max);
-    RAISE_ARG_TYPE_ERROR("o_max")
+    pgVector2Array *self, *ret;
+    PyObject *other;
+    const double *other_coords;
+    double buf[2];
+    Py_ssize_t step;
+    int reverse = !pgVector2Array_Check(o1);
+
+    self = (pgVector2Array *)(reverse ? o2 : o1);
+    other = reverse ? o1 : o2;
+    switch (_vector2array_operand(self, other, &other_coords, &step, buf)) {
+        case -1:
+            return NULL;
+        case 0:
+            Py_RETURN_NOTIMPLEMENTED;
+    }
 
-    if (b - a == 0)
-        return RAISE(
-            PyExc_ValueError,
-            "the result of i_max - i_min needs to be different from zero");
+    ret = (pgVector2Array *)_vector2array_new(Py_TYPE(self), self->length);
+    if (ret == NULL) {
+        return NULL;
+    }
+    _vector2array_add_helper(ret->coords, self->coords,
+                             (subtract && reverse) ? -1 : 1, other_coords,
+                             step, (subtract && !reverse) ? -1 : 1,
+                             self->length);
+    return (PyObject *)ret;
+}
 
-    return PyFloat_FromDouble(lerp(c, d, invlerp(a, b, v)));
+static PyObject *
+vector2array_add(PyObject *o1, PyObject *o2)
+{
+    return _vector2array_add_sub(o1, o2, 0);
 }
 
 static PyObject *
-math_lerp(PyObject *self, PyObject *const *args, Py_ssize_t nargs)
+vector2array_sub(PyObject *o1, PyObject *o2)
 {
-    if (nargs != 3 && nargs != 4)
-        return RAISE(PyExc_TypeError, "lerp requires 3 or 4 arguments");
+    return _vector2array_add_sub(o1, o2, 1);
+}
 
-    PyObject *min = args[0];
-    PyObject *max = args[1];
-    PyObject *value = args[2];
+static PyObject *
+_vector2array_inplace_add_sub(pgVector2Array *self, PyObject *other,
+                              int subtract)
+{
+    const double *other_coords;
+    double buf[2];
+    Py_ssize_t step;
 
-    if (PyNumber_Check(args[2]) != 1) {
-        return RAISE(PyExc_TypeError,
-                     "lerp requires the interpolation amount to be number");
+    switch (_vector2array_operand(self, other, &other_coords, &step, buf)) {
+        case -1:
+            return NULL;
+        case 0:
+            Py_RETURN_NOTIMPLEMENTED;
     }
+    _vector2array_add_helper(self->coords, self->coords, 1, other_coords,
+                             step, subtract ? -1 : 1, self->length);
+    Py_INCREF(self);
+    return (PyObject *)self;
+}
+
+static PyObject *
+vector2array_inplace_add(pgVector2Array *self, PyObject *other)
+{
+    return _vector2array_inplace_add_sub(self, other, 0);
+}
+
+static PyObject *
+vector2array_inplace_sub(pgVector2Array *self, PyObject *other)
+{
+    return _vector2array_inplace_add_sub(self, other, 1);
+}
+
+/* Gets the number for a multiplication or division, returns 0 if there is
+ * none. With divide set, 0 is rejected with an exception and -1 returned. */
+static int
+_vector2array_factor(PyObject *obj, double *factor, int divide)
+{
+    if (!RealNumber_Check(obj)) {
+        return 0;
+    }
+    *factor = PyFloat_AsDouble(obj);
+    if (*factor == -1.0 && PyErr_Occurred()) {
+        return -1;
+    }
+    if (divide) {
+        if (*factor == 0.0) {
+            PyErr_SetString(PyExc_ZeroDivisionError, "division by zero");
+            return -1;
+        }
+        *factor = 1.0 / *factor;
+    }
+    return 1;
+}
+
+static PyObject *
+_vector2array_mul_div(PyObject *o1, PyObject *o2, int divide)
+{
+    pgVector2Array *self, *ret;
+    double factor;
+
+    if (pgVector2Array_Check(o1)) {
+        self = (pgVector2Array *)o1;
+        o1 = o2;
+    }
+    else if (divide) {
+        Py_RETURN_NOTIMPLEMENTED;
+    }
+    else {
+        self = (pgVector2Array *)o2;
+    }
+
+    switch (_vector2array_factor(o1, &factor, divide)) {
+        case -1:
+            return NULL;
+        case 0:
+            Py_RETURN_NOTIMPLEMENTED;
+    }
+    ret = (pgVector2Array *)_vector2array_new(Py_TYPE(self), self->length);
+    if (ret == NULL) {
+        return NULL;
+    }
+    _vector2array_scale_helper(ret->coords, self->coords, factor,
+                               self->length);
+    return (PyObject *)ret;
+}
+
+static PyObject *
+vector2array_mul(PyObject *o1, PyObject *o2)
+{
+    return _vector2array_mul_div(o1, o2, 0);
+}
+
+static PyObject *
+vector2array_div(PyObject *o1, PyObject *o2)
+{
+    return _vector2array_mul_div(o1, o2, 1);
+}
+
+static PyObject *
+_vector2array_inplace_mul_div(pgVector2Array *self, PyObject *other,
+                              int divide)
+{
+    double factor;
+
+    switch (_vector2array_factor(other, &factor, divide)) {
+        case -1:
+            return NULL;
+        case 0:
+            Py_RETURN_NOTIMPLEMENTED;
+    }
+    _vector2array_scale_helper(self->coords, self->coords, factor,
+                               self->length);
+    Py_INCREF(self);
+    return (PyObject *)self;
+}
+
+static PyObject *
+vector2array_inplace_mul(pgVector2Array *self, PyObject *other)
+{
+    return _vector2array_inplace_mul_div(self, other, 0);
+}
+
+static PyObject *
+vector2array_inplace_div(pgVector2Array *self, PyObject *other)
+{
+    return _vector2array_inplace_mul_div(self, other, 1);
+}
+
+static PyObject *
+vector2array_neg(pgVector2Array *self)
+{
+    pgVector2Array *ret =
+        (pgVector2Array *)_vector2array_new(Py_TYPE(self), self->length);
+
+    if (ret == NULL) {
+        return NULL;
+    }
+    _vector2array_scale_helper(ret->coords, self->coords, -1.0, self->length);
+    return (PyObject *)ret;
+}
+
+static PyObject *
+vector2array_copy(pgVector2Array *self, PyObject *_null)
+{
+    pgVector2Array *ret =
+        (pgVector2Array *)_vector2array_new(Py_TYPE(self), self->length);
+
+    if (ret == NULL) {
+        return NULL;
+    }
+    memcpy(ret->coords, self->coords, 2 * self->length * sizeof(double));
+    return (PyObject *)ret;
+}
+
+static Py_ssize_t
+vector2array_len(pgVector2Array *self)
+{
+    return self->length;
+}
+
+static PyObject *
+vector2array_item(pgVector2Array *self, Py_ssize_t index)
+{
+    pgVector *ret;
+
+    if (index < 0 || index >= self->length) {
+        return RAISE(PyExc_IndexError, "Vector2Array index out of range");
+    }
+    ret = (pgVector *)pgVector_NEW(2);
+    if (ret == NULL) {
+        return NULL;
+    }
+    ret->coords[0] = self->coords[2 * index];
+    ret->coords[1] = self->coords[2 * index + 1];
+    return (PyObject *)ret;
+}
+
+static PyObject *
+vector2array_subscript(pgVector2Array *self, PyObject *key)
+{
+    Py_ssize_t start, stop, step, slicelen, i;
+    pgVector2Array *ret;
+
+    if (PyIndex_Check(key)) {
+        i = PyNumber_AsSsize_t(key, PyExc_IndexError);
+        if (i == -1 && PyErr_Occurred()) {
+            return NULL;
+        }
+        if (i < 0) {
+            i += self->length;
+        }
+        return vector2array_item(self, i);
+    }
+    if (!PySlice_Check(key)) {
+        return RAISE(PyExc_TypeError,
+                     "Vector2Array indices must be integers or slices");
+    }
+    if (PySlice_Unpack(key, &start, &stop, &step) < 0) {
+        return NULL;
+    }
+    slicelen = PySlice_AdjustIndices(self->length, &start, &stop, step);
+
+    ret = (pgVector2Array *)_vector2array_new(Py_TYPE(self), slicelen);
+    if (ret == NULL) {
+        return NULL;
+    }
+    for (i = 0; i < slicelen; ++i, start += step) {
+        ret->coords[2 * i] = self->coords[2 * start];
+        ret->coords[2 * i + 1] = self->coords[2 * start + 1];
+    }
+    return (PyObject *)ret;
+}
+
+static int
+vector2array_ass_subscript(pgVector2Array *self, PyObject *key,
+                           PyObject *value)
+{
+    Py_ssize_t start, stop, step, slicelen, i, length;
+    double coords[2], *src = NULL;
+    int broadcast = 0;
+
+    if (value == NULL) {
+        PyErr_SetString(PyExc_TypeError,
+                        "Vector2Array does not support item deletion");
+        return -1;
+    }
+
+    if (PyIndex_Check(key)) {
+        i = PyNumber_AsSsize_t(key, PyExc_IndexError);
+        if (i == -1 && PyErr_Occurred()) {
+            return -1;
+        }
+        if (i < 0) {
+            i += self->length;
+        }
+        if (i < 0 || i >= self->length) {
+            PyErr_SetString(PyExc_IndexError,
+                            "Vector2Array assignment index out of range");
+            return -1;
+        }
+        if (!pg_VectorCoordsFromObj(value, 2, coords)) {
+            PyErr_SetString(PyExc_TypeError,
+                            "Vector2Array items must be Vector2 compatible");
+            return -1;
+        }
+        self->coords[2 * i] = coords[0];
+        self->coords[2 * i + 1] = coords[1];
+        return 0;
+    }
+    if (!PySlice_Check(key)) {
+        PyErr_SetString(PyExc_TypeError,
+                        "Vector2Array indices must be integers or slices");
+        return -1;
+    }
+    if (PySlice_Unpack(key, &start, &stop, &step) < 0) {
+        return -1;
+    }
+    slicelen = PySlice_AdjustIndices(self->length, &start, &stop, step);
+
+    /* A single vector is assigned to every item of the slice */
+    if (pg_VectorCoordsFromObj(value, 2, coords)) {
+        broadcast = 1;
+    }
+    else if (pgVector2Array_Check(value)) {
+        /* copy first, value may be self */
+        length = ((pgVector2Array *)value)->length;
+        src = PyMem_Malloc((length ? 2 * length : 1) * sizeof(double));
+        if (src == NULL) {
+            PyErr_NoMemory();
+            return -1;
+        }
+        memcpy(src, ((pgVector2Array *)value)->coords,
+               2 * length * sizeof(double));
+    }
+    else if ((length = _vector2array_coords_from_seq(value, &src)) < 0) {
+        return -1;
+    }
+
+    if (!broadcast && length != slicelen) {
+        PyMem_Free(src);
+        PyErr_Format(PyExc_ValueError,
+                     "attempt to assign sequence of size %zd to slice of "
+                     "size %zd",
+                     length, slicelen);
+        return -1;
+    }
+    for (i = 0; i < slicelen; ++i, start += step) {
+        self->coords[2 * start] = broadcast ? coords[0] : src[2 * i];
+        self->coords[2 * start + 1] = broadcast ? coords[1] : src[2 * i + 1];
+    }
+    PyMem_Free(src);
+    return 0;
+}
+
+static PyObject *
+vector2array_richcompare(PyObject *o1, PyObject *o2, int op)
+{
+    pgVector2Array *a = (pgVector2Array *)o1, *b = (pgVector2Array *)o2;
+    Py_ssize_t i;
+    int equal;
+
+    if ((op != Py_EQ && op != Py_NE) || !pgVector2Array_Check(o1) ||
+        !pgVector2Array_Check(o2)) {
+        Py_RETURN_NOTIMPLEMENTED;
+    }
+    equal = a->length == b->length;
+    for (i = 0; equal && i < 2 * a->length; ++i) {
+        equal = a->coords[i] == b->coords[i];
+    }
+    return PyBool_FromLong(op == Py_EQ ? equal : !equal);
+}
+
+static PyObject *
+vector2array_repr(pgVector2Array *self)
+{
+    return PyUnicode_FromFormat("<Vector2Array(%zd vectors)>", self->length);
+}
+
+/* Builds a list of floats from n values */
+static PyObject *
+_vector2array_float_list(const double *values, Py_ssize_t n)
+{
+    PyObject *ret = PyList_New(n), *value;
+    Py_ssize_t i;
+
+    if (ret == NULL) {
+        return NULL;
+    }
+    for (i = 0; i < n; ++i) {
+        if (!(value = PyFloat_FromDouble(values[i]))) {
+            Py_DECREF(ret);
+            return NULL;
+        }
+        PyList_SET_ITEM(ret, i, value);
+    }
+    return ret;
+}
+
+#define _VECTOR2ARRAY_LENGTH_SQUARED 0
+#define _VECTOR2ARRAY_LENGTH 1
+#define _VECTOR2ARRAY_DOT 2
+#define _VECTOR2ARRAY_DISTANCE_SQUARED 3
+#define _VECTOR2ARRAY_DISTANCE 4
+
+/* Computes one float per vector, other is only used by the operations that
+ * take a second operand. */
+static PyObject *
+_vector2array_reduce(pgVector2Array *self, PyObject *other, int op)
+{
+    const double *a = self->coords, *b = NULL;
+    double buf[2], *values, dx, dy;
+    Py_ssize_t i, step = 0;
+    PyObject *ret;
+
+    if (other) {
+        switch (_vector2array_operand(self, other, &b, &step, buf)) {
+            case -1:
+                return NULL;
+            case 0:
+                return RAISE(PyExc_TypeError,
+                             "Expected a Vector2Array or Vector2 as argument");
+        }
+    }
+
+    values = PyMem_New(double, self->length ? self->length : 1);
+    if (values == NULL) {
+        return PyErr_NoMemory();
+    }
+    for (i = 0; i < self->length; ++i) {
+        switch (op) {
+            case _VECTOR2ARRAY_LENGTH_SQUARED:
+            case _VECTOR2ARRAY_LENGTH:
+                values[i] = a[2 * i] * a[2 * i] + a[2 * i + 1] * a[2 * i + 1];
+                break;
+            case _VECTOR2ARRAY_DOT:
+                values[i] = a[2 * i] * b[step * i] +
+                            a[2 * i + 1] * b[step * i + 1];
+                break;
+            default:
+                dx = b[step * i] - a[2 * i];
+                dy = b[step * i + 1] - a[2 * i + 1];
+                values[i] = dx * dx + dy * dy;
+                break;
+        }
+    }
+    if (op == _VECTOR2ARRAY_LENGTH || op == _VECTOR2ARRAY_DISTANCE) {
+        for (i = 0; i < self->length; ++i) {
+            values[i] = sqrt(values[i]);
+        }
+    }
+    ret = _vector2array_float_list(values, self->length);
+    PyMem_Free(values);
+    return ret;
+}
+
+static PyObject *
+vector2array_length(pgVector2Array *self, PyObject *_null)
+{
+    return _vector2array_reduce(self, NULL, _VECTOR2ARRAY_LENGTH);
+}
+
+static PyObject *
+vector2array_length_squared(pgVector2Array *self, PyObject *_null)
+{
+    return _vector2array_reduce(self, NULL, _VECTOR2ARRAY_LENGTH_SQUARED);
+}
+
+static PyObject *
+vector2array_dot(pgVector2Array *self, PyObject *other)
+{
+    return _vector2array_reduce(self, other, _VECTOR2ARRAY_DOT);
+}
+
+static PyObject *
+vector2array_distance_to(pgVector2Array *self, PyObject *other)
+{
+    return _vector2array_reduce(self, other, _VECTOR2ARRAY_DISTANCE);
+}
+
+static PyObject *
+vector2array_distance_squared_to(pgVector2Array *self, PyObject *other)
+{
+    return _vector2array_reduce(self, other, _VECTOR2ARRAY_DISTANCE_SQUARED);
+}
+
+/* Normalizes src into dst, fails without writing anything if there is a
+ * vector of length zero. */
+static int
+_vector2array_normalize_helper(double *dst, const double *src,
+                               Py_ssize_t length)
+{
+    Py_ssize_t i;
+    double len;
+
+    for (i = 0; i < length; ++i) {
+        if (sqrt(src[2 * i] * src[2 * i] + src[2 * i + 1] * src[2 * i + 1]) ==
+            0) {
+            PyErr_SetString(PyExc_ValueError,
+                            "Can't normalize Vector of length zero");
+            return 0;
+        }
+    }
+    for (i = 0; i < length; ++i) {
+        len = sqrt(src[2 * i] * src[2 * i] + src[2 * i + 1] * src[2 * i + 1]);
+        dst[2 * i] = src[2 * i] / len;
+        dst[2 * i + 1] = src[2 * i + 1] / len;
+    }
+    return 1;
+}
+
+static PyObject *
+vector2array_normalize(pgVector2Array *self, PyObject *_null)
+{
+    pgVector2Array *ret =
+        (pgVector2Array *)_vector2array_new(Py_TYPE(self), self->length);
+
+    if (ret == NULL) {
+        return NULL;
+    }
+    if (!_vector2array_normalize_helper(ret->coords, self->coords,
+                                        self->length)) {
+        Py_DECREF(ret);
+        return NULL;
+    }
+    return (PyObject *)ret;
+}
+
+static PyObject *
+vector2array_normalize_ip(pgVector2Array *self, PyObject *_null)
+{
+    if (!_vector2array_normalize_helper(self->coords, self->coords,
+                                        self->length)) {
+        return NULL;
+    }
+    Py_RETURN_NONE;
+}
+
+/* Rotates all vectors by the same angle (in degrees) */
+static int
+_vector2array_rotate_helper(double *dst, const double *src,
+                            PyObject *angle_obj, Py_ssize_t length)
+{
+    static const double unit[2] = {1.0, 0.0};
+    double angle, cs[2], x;
+    Py_ssize_t i;
+
+    angle = PyFloat_AsDouble(angle_obj);
+    if (angle == -1.0 && PyErr_Occurred()) {
+        return 0;
+    }
+    /* cos and sin of the angle, with exact values for multiples of 90 */
+    if (!_vector2_rotate_helper(cs, unit, DEG2RAD(angle), VECTOR_EPSILON)) {
+        return 0;
+    }
+    for (i = 0; i < length; ++i) {
+        x = src[2 * i];
+        dst[2 * i] = cs[0] * x - cs[1] * src[2 * i + 1];
+        dst[2 * i + 1] = cs[1] * x + cs[0] * src[2 * i + 1];
+    }
+    return 1;
+}
+
+static PyObject *
+vector2array_rotate(pgVector2Array *self, PyObject *angle)
+{
+    pgVector2Array *ret =
+        (pgVector2Array *)_vector2array_new(Py_TYPE(self), self->length);
+
+    if (ret == NULL) {
+        return NULL;
+    }
+    if (!_vector2array_rotate_helper(ret->coords, self->coords, angle,
+                                     self->length)) {
+        Py_DECREF(ret);
+        return NULL;
+    }
+    return (PyObject *)ret;
+}
+
+static PyObject *
+vector2array_rotate_ip(pgVector2Array *self, PyObject *angle)
+{
+    if (!_vector2array_rotate_helper(self->coords, self->coords, angle,
+                                     self->length)) {
+        return NULL;
+    }
+    Py_RETURN_NONE;
+}
+
+static PyObject *
+vector2array_lerp(pgVector2Array *self, PyObject *args)
+{
+    pgVector2Array *ret;
+    PyObject *other;
+    const double *b;
+    double buf[2], t;
+    Py_ssize_t i, step;
+
+    if (!PyArg_ParseTuple(args, "Od:Vector2Array.lerp", &other, &t)) {
+        return NULL;
+    }
+    switch (_vector2array_operand(self, other, &b, &step, buf)) {
+        case -1:
+            return NULL;
+        case 0:
+            return RAISE(PyExc_TypeError,
+                         "Expected a Vector2Array or Vector2 as argument 1");
+    }
+    if (t < 0 || t > 1) {
+        return RAISE(PyExc_ValueError, "Argument 2 must be in range [0, 1]");
+    }
+
+    ret = (pgVector2Array *)_vector2array_new(Py_TYPE(self), self->length);
+    if (ret == NULL) {
+        return NULL;
+    }
+    for (i = 0; i < self->length; ++i) {
+        ret->coords[2 * i] = self->coords[2 * i] * (1 - t) + b[step * i] * t;
+        ret->coords[2 * i + 1] =
+            self->coords[2 * i + 1] * (1 - t) + b[step * i + 1] * t;
+    }
+    return (PyObject *)ret;
+}
+
+static int
+vector2array_getbuffer(pgVector2Array *self, Py_buffer *view, int flags)
+{
+    view->buf = self->coords;
+    view->obj = (PyObject *)self;
+    Py_INCREF(self);
+    view->len = 2 * self->length * sizeof(double);
+    view->readonly = 0;
+    view->itemsize = sizeof(double);
+    view->format = (flags & PyBUF_FORMAT) ? "d" : NULL;
+    view->ndim = (flags & PyBUF_ND) ? 2 : 1;
+    view->shape = (flags & PyBUF_ND) ? self->shape : NULL;
+    view->strides =
+        ((flags & PyBUF_STRIDES) == PyBUF_STRIDES) ? self->strides : NULL;
+    view->suboffsets = NULL;
+    view->internal = NULL;
+    self->exports++;
+    return 0;
+}
+
+static void
+vector2array_releasebuffer(pgVector2Array *self, Py_buffer *view)
+{
+    self->exports--;
+}
+
+static PyMethodDef vector2array_methods[] = {
+    {"copy", (PyCFunction)vector2array_copy, METH_NOARGS,
+     DOC_MATH_VECTOR2ARRAY_COPY},
+    {"__copy__", (PyCFunction)vector2array_copy, METH_NOARGS, NULL},
+    {"length", (PyCFunction)vector2array_length, METH_NOARGS,
+     DOC_MATH_VECTOR2ARRAY_LENGTH},
+    {"length_squared", (PyCFunction)vector2array_length_squared, METH_NOARGS,
+     DOC_MATH_VECTOR2ARRAY_LENGTHSQUARED},
+    {"dot", (PyCFunction)vector2array_dot, METH_O, DOC_MATH_VECTOR2ARRAY_DOT},
+    {"distance_to", (PyCFunction)vector2array_distance_to, METH_O,
+     DOC_MATH_VECTOR2ARRAY_DISTANCETO},
+    {"distance_squared_to", (PyCFunction)vector2array_distance_squared_to,
+     METH_O, DOC_MATH_VECTOR2ARRAY_DISTANCESQUAREDTO},
+    {"normalize", (PyCFunction)vector2array_normalize, METH_NOARGS,
+     DOC_MATH_VECTOR2ARRAY_NORMALIZE},
+    {"normalize_ip", (PyCFunction)vector2array_normalize_ip, METH_NOARGS,
+     DOC_MATH_VECTOR2ARRAY_NORMALIZEIP},
+    {"rotate", (PyCFunction)vector2array_rotate, METH_O,
+     DOC_MATH_VECTOR2ARRAY_ROTATE},
+    {"rotate_ip", (PyCFunction)vector2array_rotate_ip, METH_O,
+     DOC_MATH_VECTOR2ARRAY_ROTATEIP},
+    {"lerp", (PyCFunction)vector2array_lerp, METH_VARARGS,
+     DOC_MATH_VECTOR2ARRAY_LERP},
+    {NULL, NULL, 0, NULL}};
+
+static PyNumberMethods vector2array_as_number = {
+    .nb_add = (binaryfunc)vector2array_add,
+    .nb_subtract = (binaryfunc)vector2array_sub,
+    .nb_multiply = (binaryfunc)vector2array_mul,
+    .nb_negative = (unaryfunc)vector2array_neg,
+    .nb_positive = (unaryfunc)vector2array_copy,
+    .nb_inplace_add = (binaryfunc)vector2array_inplace_add,
+    .nb_inplace_subtract = (binaryfunc)vector2array_inplace_sub,
+    .nb_inplace_multiply = (binaryfunc)vector2array_inplace_mul,
+    .nb_true_divide = (binaryfunc)vector2array_div,
+    .nb_inplace_true_divide = (binaryfunc)vector2array_inplace_div,
+};
+
+static PySequenceMethods vector2array_as_sequence = {
+    .sq_length = (lenfunc)vector2array_len,
+    .sq_item = (ssizeargfunc)vector2array_item,
+};
+
+static PyMappingMethods vector2array_as_mapping = {
+    .mp_length = (lenfunc)vector2array_len,
+    .mp_subscript = (binaryfunc)vector2array_subscript,
+    .mp_ass_subscript = (objobjargproc)vector2array_ass_subscript,
+};
+
+static PyBufferProcs vector2array_as_buffer = {
+    .bf_getbuffer = (getbufferproc)vector2array_getbuffer,
+    .bf_releasebuffer = (releasebufferproc)vector2array_releasebuffer,
+};
+
+static PyTypeObject pgVector2Array_Type = {
+    PyVarObject_HEAD_INIT(NULL, 0).tp_name = "pygame.math.Vector2Array",
+    .tp_basicsize = sizeof(pgVector2Array),
+    .tp_dealloc = (destructor)vector2array_dealloc,
+    .tp_repr = (reprfunc)vector2array_repr,
+    .tp_as_number = &vector2array_as_number,
+    .tp_as_sequence = &vector2array_as_sequence,
+    .tp_as_mapping = &vector2array_as_mapping,
+    .tp_as_buffer = &vector2array_as_buffer,
+    .tp_flags = Py_TPFLAGS_DEFAULT | Py_TPFLAGS_BASETYPE,
+    .tp_doc = DOC_MATH_VECTOR2ARRAY,
+    .tp_richcompare = (richcmpfunc)vector2array_richcompare,
+    .tp_weaklistoffset = offsetof(pgVector2Array, weakreflist),
+    .tp_methods = vector2array_methods,
+    .tp_init = (initproc)vector2array_init,
+    .tp_new = (newfunc)vector2array_new,
+};
+
+static inline double
+lerp(double a, double b, double v)
+{
+    return a + (b - a) * v;
+}
+
+static inline double
+invlerp(double a, double b, double v)
+{
+    return (v - a) / (b - a);
+}
+
+static PyObject *
+math_clamp(PyObject *self, PyObject *const *args, Py_ssize_t nargs)
+{
+    if (nargs != 3)
+        return RAISE(PyExc_TypeError, "clamp requires 3 arguments");
+
+    PyObject *value = args[0];
+    PyObject *min = args[1];
+    PyObject *max = args[2];
+
+    if (PyNumber_Check(args[0]) != 1 || PyNumber_Check(args[1]) != 1 ||
+        PyNumber_Check(args[2]) != 1) {
+        return RAISE(PyExc_TypeError, "clamp requires 3 numeric arguments");
+    }
+
+    // Using RichCompare instead of converting to C types for performance
+    // reasons. This implementation was tested to be faster than using
+    // PyFloat_AsDouble and PyErr_Occurred.
+
+    // if value < min: return min
+    int result = PyObject_RichCompareBool(value, min, Py_LT);
+    if (result == 1) {
+        Py_INCREF(min);
+        return min;
+    }
+    else if (result == -1)
+        return NULL;
+
+    // if value > max: return max
+    result = PyObject_RichCompareBool(value, max, Py_GT);
+    if (result == 1) {
+        Py_INCREF(max);
+        return max;
+    }
+    else if (result == -1)
+        return NULL;
+
+    Py_INCREF(value);
+    return value;
+}
+
+#define RAISE_ARG_TYPE_ERROR(var)                                     \
+    if (PyErr_Occurred()) {                                           \
+        return RAISE(PyExc_TypeError,                                 \
+                     "The argument '" var "' must be a real number"); \
+    }
+
+static PyObject *
+math_invlerp(PyObject *self, PyObject *const *args, Py_ssize_t nargs)
+{
+    if (nargs != 3)
+        return RAISE(PyExc_TypeError,
+                     "invlerp requires exactly 3 numeric arguments");
+
+    double a = PyFloat_AsDouble(args[0]);
+    RAISE_ARG_TYPE_ERROR("a")
+    double b = PyFloat_AsDouble(args[1]);
+    RAISE_ARG_TYPE_ERROR("b")
+    double t = PyFloat_AsDouble(args[2]);
+    RAISE_ARG_TYPE_ERROR("value")
+
+    if (PyErr_Occurred())
+        return RAISE(PyExc_ValueError,
+                     "invalid argument values passed to invlerp, numbers "
+                     "might be too small or too big");
+
+    if (b - a == 0)
+        return RAISE(PyExc_ValueError,
+                     "the result of b - a needs to be different from zero");
+
+    return PyFloat_FromDouble(invlerp(a, b, t));
+}
+
+#
+
+static PyObject *
+math_remap(PyObject *self, PyObject *const *args, Py_ssize_t nargs)
+{
+    if (nargs != 5)
+        return RAISE(PyExc_TypeError,
+                     "remap requires exactly 5 numeric arguments");
+
+    PyObject *i_min = args[0];
+    PyObject *i_max = args[1];
+    PyObject *o_min = args[2];
+    PyObject *o_max = args[3];
+    PyObject *value = args[4];
+
+    double v = PyFloat_AsDouble(value);
+    RAISE_ARG_TYPE_ERROR("value")
+    double a = PyFloat_AsDouble(i_min);
+    RAISE_ARG_TYPE_ERROR("i_min")
+    double b = PyFloat_AsDouble(i_max);
+    RAISE_ARG_TYPE_ERROR("i_max")
+    double c = PyFloat_AsDouble(o_min);
+    RAISE_ARG_TYPE_ERROR("o_min")
+    double d = PyFloat_AsDouble(o_max);
+    RAISE_ARG_TYPE_ERROR("o_max")
+
+    if (b - a == 0)
+        return RAISE(
+            PyExc_ValueError,
+            "the result of i_max - i_min needs to be different from zero");
+
+    return PyFloat_FromDouble(lerp(c, d, invlerp(a, b, v)));
+}
+
+static PyObject *
+math_lerp(PyObject *self, PyObject *const *args, Py_ssize_t nargs)
+{
+    if (nargs != 3 && nargs != 4)
+        return RAISE(PyExc_TypeError, "lerp requires 3 or 4 arguments");
+
+    PyObject *min = args[0];
+    PyObject *max = args[1];
+    PyObject *value = args[2];
+
+    if (PyNumber_Check(args[2]) != 1) {
+        return RAISE(PyExc_TypeError,
+                     "lerp requires the interpolation amount to be number");
+    }
+
+    double t = PyFloat_AsDouble(value);
 
-    double t = PyFloat_AsDouble(value);
-
     if (nargs == 4 && !PyObject_IsTrue(args[3])) {
         ;  // pass if do_clamp is false
     }
@@ -4392,6 +5354,404 @@ math_smoothstep(PyObject *self, PyObject *const *args, Py_ssize_t nargs)
     }
 }
 
+/*
+ * Procedural noise
+ */
+
+/* Fields of at least this many pixels are filled by up to
+ * NOISE_MAX_THREADS threads, each taking a band of rows */
+#define NOISE_MAX_THREADS 16
+#define NOISE_THREAD_MIN_PIXELS (1 << 15)
+
+void
+noise_row(const pgNoiseParams *params, int x, float ox, float freq, float y,
+          int n, float *out)
+{
+    int i;
+    for (i = 0; i < n; i++) {
+        out[i] = _pg_noise_sample(params, ((float)(x + i) + ox) * freq, y);
+    }
+}
+
+/* The fastest row kernel the CPU supports, picked on every call so that
+ * pygame.system.set_simd_level() applies */
+static NOISE_ROW_P
+_pg_noise_get_row(void)
+{
+#if !defined(__EMSCRIPTEN__)
+    if (_pg_noise_has_avx2()) {
+        return noise_row_avx2;
+    }
+#if PG_ENABLE_SSE_NEON
+    else if (_pg_noise_HasSSE_NEON()) {
+        return noise_row_sse2;
+    }
+#endif /* PG_ENABLE_SSE_NEON */
+#endif /* !__EMSCRIPTEN__ */
+    return noise_row;
+}
+
+/* The row kernel is picked on every call, so set_simd_level() needs
+ * nothing done */
+static int
+_pg_noise_simd_dispatch(PyObject *dispatch)
+{
+    int has_avx2 = 0, has_sse2_neon = 0;
+
+#if !defined(__EMSCRIPTEN__)
+    has_avx2 = _pg_noise_has_avx2();
+#if PG_ENABLE_SSE_NEON
+    has_sse2_neon = _pg_noise_HasSSE_NEON();
+#endif /* PG_ENABLE_SSE_NEON */
+#endif /* !__EMSCRIPTEN__ */
+    return pg_simd_report(dispatch, "noise",
+                          pg_simd_backend_name(has_avx2, has_sse2_neon));
+}
+
+/* Fills params from the arguments shared by noise() and noise_fill(), seed
+ * being NULL if it wasn't given. Returns 0 with an exception set on
+ * failure. */
+static int
+_pg_noise_params(pgNoiseParams *params, const char *kind, int octaves,
+                 double persistence, double lacunarity, PyObject *seedobj)
+{
+    Uint32 seed;
+    double freq = 1.0, amp = 1.0, total = 0.0;
+    int o;
+
+    if (!strcmp(kind, "value")) {
+        params->kind = PG_NOISE_VALUE;
+    }
+    else if (!strcmp(kind, "perlin")) {
+        params->kind = PG_NOISE_PERLIN;
+    }
+    else if (!strcmp(kind, "simplex")) {
+        params->kind = PG_NOISE_SIMPLEX;
+    }
+    else {
+        PyErr_Format(PyExc_ValueError,
+                     "kind must be 'value', 'perlin' or 'simplex', not '%s'",
+                     kind);
+        return 0;
+    }
+    if (octaves < 1 || octaves > PG_NOISE_MAX_OCTAVES) {
+        PyErr_Format(PyExc_ValueError, "octaves must be between 1 and %d",
+                     PG_NOISE_MAX_OCTAVES);
+        return 0;
+    }
+    if (!seedobj) {
+        seed = 0;
+    }
+    else if (!PyLong_Check(seedobj)) {
+        PyErr_SetString(PyExc_TypeError, "seed must be an int");
+        return 0;
+    }
+    else {
+        /* only the low 32 bits of the seed matter */
+        seed = (Uint32)PyLong_AsUnsignedLongMask(seedobj);
+        if (PyErr_Occurred()) {
+            return 0;
+        }
+    }
+
+    params->octaves = octaves;
+    for (o = 0; o < octaves; o++) {
+        params->seeds[o] = (seed + (Uint32)o) * PG_NOISE_HASH_SEED;
+        params->freqs[o] = (float)freq;
+        params->amps[o] = (float)amp;
+        total += amp;
+        freq *= lacunarity;
+        amp *= persistence;
+    }
+    if (!(total > 0.0) || !isfinite(total)) {
+        PyErr_SetString(PyExc_ValueError,
+                        "the octave amplitudes must have a positive sum");
+        return 0;
+    }
+    params->scale = (float)(1.0 / total);
+    return 1;
+}
+
+static PyObject *
+math_noise(PyObject *self, PyObject *args, PyObject *kwargs)
+{
+    pgNoiseParams params;
+    double x, y, persistence = 0.5, lacunarity = 2.0;
+    const char *kind = "perlin";
+    int octaves = 1;
+    PyObject *seed = NULL;
+    static char *keywords[] = {
+        "", "", "kind", "octaves", "persistence", "lacunarity", "seed", NULL};
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "dd|$siddO", keywords, &x,
+                                     &y, &kind, &octaves, &persistence,
+                                     &lacunarity, &seed)) {
+        return NULL;
+    }
+    if (!_pg_noise_params(&params, kind, octaves, persistence, lacunarity,
+                          seed)) {
+        return NULL;
+    }
+    return PyFloat_FromDouble(
+        (double)_pg_noise_sample(&params, (float)x, (float)y));
+}
+
+/* A 2D array noise_fill() writes to, as float32 values or as bytes mapped
+ * from [-1, 1] to [0, 255] */
+typedef struct {
+    char *pixels;
+    Py_ssize_t xstride;
+    Py_ssize_t ystride;
+    int is_float;
+} pgNoisePlane;
+
+typedef struct {
+    NOISE_ROW_P row;
+    const pgNoiseParams *params;
+    const pgNoisePlane *planes;
+    int nplanes;
+    int width;
+    int first; /* the first row of the band */
+    int count; /* the number of rows in the band */
+    float ox, oy, freq;
+    float *tmp; /* a row of noise, if it can't go into the plane directly */
+} pgNoiseBand;
+
+static void
+_pg_noise_fill_band(pgNoiseBand *band)
+{
+    const pgNoisePlane *plane = band->planes;
+    float *out;
+    char *dst;
+    Uint8 value;
+    int row, x, p;
+
+    for (row = band->first; row < band->first + band->count; row++) {
+        out = band->tmp ? band->tmp
+                        : (float *)(plane->pixels + row * plane->ystride);
+        band->row(band->params, 0, band->ox, band->freq,
+                  ((float)row + band->oy) * band->freq, band->width, out);
+        if (!band->tmp) {
+            continue;
+        }
+        for (p = 0; p < band->nplanes; p++) {
+            dst = band->planes[p].pixels + row * band->planes[p].ystride;
+            for (x = 0; x < band->width; x++) {
+                if (band->planes[p].is_float) {
+                    memcpy(dst, out + x, sizeof(float));
+                }
+                else {
+                    value = (Uint8)((out[x] + 1.0f) * 127.5f + 0.5f);
+                    *dst = (char)value;
+                }
+                dst += band->planes[p].xstride;
+            }
+        }
+    }
+}
+
+static void
+_pg_noise_band(void *data, int i)
+{
+    _pg_noise_fill_band((pgNoiseBand *)data + i);
+}
+
+/* Fills the planes, width by height, in bands of rows run in parallel by up
+ * to nthreads threads including the calling one. Returns 0 with an
+ * exception set if the row buffers can't be allocated or pygame.surface
+ * can't be imported. */
+static int
+_pg_noise_run(const pgNoiseParams *params, const pgNoisePlane *planes,
+              int nplanes, int width, int height, float ox, float oy,
+              float freq, int nthreads)
+{
+    pgNoiseBand bands[NOISE_MAX_THREADS];
+    NOISE_ROW_P row = _pg_noise_get_row();
+    /* a float plane with packed pixels gets the rows directly */
+    int direct = nplanes == 1 && planes[0].is_float &&
+                 planes[0].xstride == (Py_ssize_t)sizeof(float);
+    int nbands = MIN(MIN(nthreads, height), NOISE_MAX_THREADS);
+    int i, result = 1;
+
+    if (nbands < 2 || (Sint64)width * height < NOISE_THREAD_MIN_PIXELS) {
+        nbands = 1;
+    }
+    /* the bands run on the blit threads of pygame.surface, which imports
+     * this module, so its C API is only imported once it is needed */
+    if (nbands > 1 && !_PGSLOTS_surface) {
+        _IMPORT_PYGAME_MODULE(surface);
+        if (PyErr_Occurred()) {
+            return 0;
+        }
+    }
+    for (i = 0; i < nbands; i++) {
+        bands[i].row = row;
+        bands[i].params = params;
+        bands[i].planes = planes;
+        bands[i].nplanes = nplanes;
+        bands[i].width = width;
+        bands[i].first = (int)((Sint64)height * i / nbands);
+        bands[i].count =
+            (int)((Sint64)height * (i + 1) / nbands) - bands[i].first;
+        bands[i].ox = ox;
+        bands[i].oy = oy;
+        bands[i].freq = freq;
+        bands[i].tmp = NULL;
+        if (!direct) {
+            bands[i].tmp = PyMem_New(float, width);
+            if (!bands[i].tmp) {
+                PyErr_NoMemory();
+                nbands = i;
+                result = 0;
+                goto end;
+            }
+        }
+    }
+
+    Py_BEGIN_ALLOW_THREADS;
+    if (nbands > 1) {
+        pg_run_bands(_pg_noise_band, bands, nbands);
+    }
+    else {
+        _pg_noise_fill_band(&bands[0]);
+    }
+    Py_END_ALLOW_THREADS;
+
+end:
+    for (i = 0; i < nbands; i++) {
+        PyMem_Free(bands[i].tmp);
+    }
+    return result;
+}
+
+static PyObject *
+math_noise_fill(PyObject *self, PyObject *args, PyObject *kwargs)
+{
+    static const char *const channel_views[] = {"R", "G", "B", "A"};
+    pgNoiseParams params;
+    pgNoisePlane planes[3];
+    Py_buffer bufs[3];
+    PyObject *views[3] = {NULL, NULL, NULL};
+    PyObject *dest, *offsetobj = NULL, *seed = NULL, *channelobj = Py_None;
+    double frequency = 0.0625, offset[2] = {0.0, 0.0};
+    double persistence = 0.5, lacunarity = 2.0;
+    const char *kind = "perlin";
+    int octaves = 1, threads = 0, channel = -1;
+    int nbufs = 0, width = 0, height = 0, i;
+    PyObject *result = NULL;
+    static char *keywords[] = {"",
+                               "kind",
+                               "frequency",
+                               "offset",
+                               "octaves",
+                               "persistence",
+                               "lacunarity",
+                               "seed",
+                               "channel",
+                               "threads",
+                               NULL};
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "O|$sdOiddOOi", keywords,
+                                     &dest, &kind, &frequency, &offsetobj,
+                                     &octaves, &persistence, &lacunarity,
+                                     &seed, &channelobj, &threads)) {
+        return NULL;
+    }
+    if (!_pg_noise_params(&params, kind, octaves, persistence, lacunarity,
+                          seed)) {
+        return NULL;
+    }
+    if (offsetobj && !PySequence_AsVectorCoords(offsetobj, offset, 2)) {
+        return NULL;
+    }
+    if (channelobj != Py_None) {
+        channel = PyLong_AsLong(channelobj);
+        if (channel == -1 && PyErr_Occurred()) {
+            return NULL;
+        }
+        if (channel < 0 || channel > 3) {
+            return RAISE(PyExc_ValueError, "channel must be 0, 1, 2 or 3");
+        }
+    }
+    if (threads < 0) {
+        return RAISE(PyExc_ValueError, "threads must not be negative");
+    }
+    if (!threads) {
+        threads = SDL_GetCPUCount();
+    }
+
+    if (PyObject_CheckBuffer(dest)) {
+        /* a 2D float32 array, indexed by row and then column */
+        if (channel >= 0) {
+            return RAISE(PyExc_ValueError,
+                         "channel is only supported for Surfaces");
+        }
+        if (PyObject_GetBuffer(dest, &bufs[0], PyBUF_RECORDS)) {
+            return NULL;
+        }
+        nbufs = 1;
+        if (bufs[0].ndim != 2 || bufs[0].itemsize != sizeof(float) ||
+            !bufs[0].format || strcmp(bufs[0].format, "f")) {
+            PyErr_SetString(PyExc_ValueError,
+                            "dest must be a 2D float32 buffer or a Surface");
+            goto end;
+        }
+        height = (int)bufs[0].shape[0];
+        width = (int)bufs[0].shape[1];
+        planes[0].pixels = (char *)bufs[0].buf;
+        planes[0].ystride = bufs[0].strides[0];
+        planes[0].xstride = bufs[0].strides[1];
+        planes[0].is_float = 1;
+    }
+    else {
+        /* A Surface, through the views of its color channels, which are
+         * indexed by column and then row. Grey noise goes into red, green
+         * and blue. */
+        int count = channel >= 0 ? 1 : 3;
+        for (i = 0; i < count; i++) {
+            views[i] = PyObject_CallMethod(
+                dest, "get_view", "s",
+                channel_views[channel >= 0 ? channel : i]);
+            if (!views[i]) {
+                if (PyErr_ExceptionMatches(PyExc_AttributeError)) {
+                    PyErr_SetString(
+                        PyExc_TypeError,
+                        "dest must be a 2D float32 buffer or a Surface");
+                }
+                goto end;
+            }
+            if (PyObject_GetBuffer(views[i], &bufs[i], PyBUF_RECORDS)) {
+                goto end;
+            }
+            nbufs++;
+            width = (int)bufs[i].shape[0];
+            height = (int)bufs[i].shape[1];
+            planes[i].pixels = (char *)bufs[i].buf;
+            planes[i].xstride = bufs[i].strides[0];
+            planes[i].ystride = bufs[i].strides[1];
+            planes[i].is_float = 0;
+        }
+    }
+
+    if (width > 0 && height > 0 &&
+        !_pg_noise_run(&params, planes, nbufs, width, height,
+                       (float)offset[0], (float)offset[1], (float)frequency,
+                       threads)) {
+        goto end;
+    }
+    Py_INCREF(Py_None);
+    result = Py_None;
+
+end:
+    for (i = 0; i < nbufs; i++) {
+        PyBuffer_Release(&bufs[i]);
+    }
+    for (i = 0; i < 3; i++) {
+        Py_XDECREF(views[i]);
+    }
+    return result;
+}
+
 static PyObject *
 math_enable_swizzling(pgVector *self, PyObject *_null)
 {
@@ -4418,6 +5778,25 @@ math_disable_swizzling(pgVector *self, PyObject *_null)
     Py_RETURN_NONE;
 }
 
+static PyObject *
+_vector_freelist_stats(pgVectorFreelist *freelist)
+{
+    unsigned long long total = freelist->hits + freelist->misses;
+
+    return Py_BuildValue("{s:K,s:K,s:i,s:i,s:d}", "hits", freelist->hits,
+                         "misses", freelist->misses, "size", freelist->num,
+                         "max_size", VECTOR_FREELIST_MAX, "hit_rate",
+                         total ? (double)freelist->hits / total : 0.0);
+}
+
+static PyObject *
+math_freelist_stats(PyObject *self, PyObject *_null)
+{
+    return Py_BuildValue("{s:N,s:N}", "Vector2",
+                         _vector_freelist_stats(&vector2_freelist), "Vector3",
+                         _vector_freelist_stats(&vector3_freelist));
+}
+
 static PyMethodDef _math_methods[] = {
     {"clamp", (PyCFunction)math_clamp, METH_FASTCALL, DOC_MATH_CLAMP},
     {"lerp", (PyCFunction)math_lerp, METH_FASTCALL, DOC_MATH_LERP},
@@ -4425,10 +5804,16 @@ static PyMethodDef _math_methods[] = {
     {"remap", (PyCFunction)math_remap, METH_FASTCALL, DOC_MATH_REMAP},
     {"smoothstep", (PyCFunction)math_smoothstep, METH_FASTCALL,
      DOC_MATH_SMOOTHSTEP},
+    {"noise", (PyCFunction)math_noise, METH_VARARGS | METH_KEYWORDS,
+     DOC_MATH_NOISE},
+    {"noise_fill", (PyCFunction)math_noise_fill, METH_VARARGS | METH_KEYWORDS,
+     DOC_MATH_NOISEFILL},
     {"enable_swizzling", (PyCFunction)math_enable_swizzling, METH_NOARGS,
      "Deprecated, will be removed in a future version"},
     {"disable_swizzling", (PyCFunction)math_disable_swizzling, METH_NOARGS,
      "Deprecated, will be removed in a future version."},
+    {"_freelist_stats", math_freelist_stats, METH_NOARGS,
+     "private: used by pygame.system.get_freelist_stats()"},
     {NULL, NULL, 0, NULL}};
 
 /****************************
@@ -4455,11 +5840,18 @@ MODINIT_DEFINE(math)
                                          NULL,
                                          NULL};
 
+    /* for pg_RegisterSIMDDispatch() */
+    import_pygame_base();
+    if (PyErr_Occurred()) {
+        return NULL;
+    }
+
     /* initialize the extension types */
     if ((PyType_Ready(&pgVector2_Type) < 0) ||
         (PyType_Ready(&pgVector3_Type) < 0) ||
         (PyType_Ready(&pgVectorIter_Type) < 0) ||
-        (PyType_Ready(&pgVectorElementwiseProxy_Type) < 0) /*||
+        (PyType_Ready(&pgVectorElementwiseProxy_Type) < 0) ||
+        (PyType_Ready(&pgVector2Array_Type) < 0) /*||
         (PyType_Ready(&pgVector4_Type) < 0)*/) {
         return NULL;
     }
@@ -4470,12 +5862,18 @@ MODINIT_DEFINE(math)
     if (module == NULL) {
         return NULL;
     }
+    if (PG_GIL_NOT_USED(module)) {
+        Py_DECREF(module);
+        return NULL;
+    }
+    pg_RegisterSIMDDispatch(_pg_noise_simd_dispatch);
 
     /* add extension types to module */
     Py_INCREF(&pgVector2_Type);
     Py_INCREF(&pgVector3_Type);
     Py_INCREF(&pgVectorIter_Type);
     Py_INCREF(&pgVectorElementwiseProxy_Type);
+    Py_INCREF(&pgVector2Array_Type);
     /*
     Py_INCREF(&pgVector4_Type);
     */
@@ -4487,7 +5885,9 @@ MODINIT_DEFINE(math)
                             (PyObject *)&pgVectorElementwiseProxy_Type) !=
          0) ||
         (PyModule_AddObject(module, "VectorIterator",
-                            (PyObject *)&pgVectorIter_Type) != 0) /*||
+                            (PyObject *)&pgVectorIter_Type) != 0) ||
+        (PyModule_AddObject(module, "Vector2Array",
+                            (PyObject *)&pgVector2Array_Type) != 0) /*||
 (PyModule_AddObject(module, "Vector4", (PyObject *)&pgVector4_Type) !=
 0)*/) {
         if (!PyObject_HasAttrString(module, "Vector2"))
@@ -4498,6 +5898,8 @@ MODINIT_DEFINE(math)
             Py_DECREF(&pgVectorElementwiseProxy_Type);
         if (!PyObject_HasAttrString(module, "VectorIterator"))
             Py_DECREF(&pgVectorIter_Type);
+        if (!PyObject_HasAttrString(module, "Vector2Array"))
+            Py_DECREF(&pgVector2Array_Type);
         /*
         if (!PyObject_HasAttrString(module, "Vector4"))
             Py_DECREF(&pgVector4_Type);
@@ -32,6 +32,26 @@
 
 #include "mixer.h"
 
+#if !defined(PG_ENABLE_ARM_NEON) && defined(__aarch64__)
+// arm64 has neon optimisations enabled by default, even when fpu=neon is not
+// passed
+#define PG_ENABLE_ARM_NEON 1
+#endif
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#define PG_DSP_SSE_NEON 1
+#elif PG_ENABLE_ARM_NEON
+#include "include/sse2neon.h"
+#define PG_DSP_SSE_NEON 1
+#endif
+
+#include <math.h>
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
 #define PyBUF_HAS_FLAG(f, F) (((f) & (F)) == (F))
 
 #define CHECK_CHUNK_VALID(CHUNK, RET)                                      \
@@ -57,6 +77,7 @@ const PG_sample_format_t PG_SAMPLE_LITTLE_ENDIAN = 0;
 const PG_sample_format_t PG_SAMPLE_BIG_ENDIAN = 0x20000u;
 #endif
 const PG_sample_format_t PG_SAMPLE_CHAR_SIGN = (char)0xff > 0 ? 0 : 0x10000u;
+const PG_sample_format_t PG_SAMPLE_FLOAT = 0x40000u;
 #define PG_SAMPLE_SIZE(sf) ((sf) & 0x0ffffu)
 #define PG_IS_SAMPLE_SIGNED(sf) ((sf) & PG_SAMPLE_SIGNED != 0)
 #define PG_IS_SAMPLE_NATIVE_ENDIAN(sf) ((sf) & PG_SAMPLE_NATIVE_ENDIAN != 0)
@@ -101,13 +122,130 @@ static int request_chunksize = PYGAME_MIXER_DEFAULT_CHUNKSIZE;
 static int request_allowedchanges = PYGAME_MIXER_DEFAULT_ALLOWEDCHANGES;
 static char *request_devicename = NULL;
 
+/* Native effect chain, see the DSP section further down. */
+typedef struct pgDspState pgDspState;
+static void
+_dsp_remove(int channel, pgDspState **slot);
+static int
+_output_tap_open(void);
+static void
+_output_tap_set(Py_buffer *ring, PyObject *callback);
+static void
+_output_tap_close(void);
+
 struct ChannelData {
     PyObject *sound;
     PyObject *queue;
     int endevent;
+    pgDspState *dsp;
+    int priority;    /* of the sound playing, for Sound.play() */
+    Uint64 started;  /* voice_clock when it started */
+    int free_listed; /* in voice_free */
 };
 static struct ChannelData *channeldata = NULL;
 static int numchanneldata = 0;
+static pgDspState *master_dsp = NULL;
+
+/* Voice allocation for Sound.play(). Finished channels go on a stack, so a
+ * free one is found without scanning every channel. Channels started
+ * since through Channel.play() can still be on it and are skipped when
+ * popped. With none free, the channel playing the lowest priority below
+ * that of the new sound, the oldest of them, is taken over. The stack is
+ * pushed from the mixer thread, the spinlock is never held while calling
+ * into SDL_mixer, which could be waiting for that thread. */
+static int *voice_free = NULL;
+static int voice_nfree = 0, voice_capacity = 0;
+static SDL_SpinLock voice_lock = 0;
+static Uint64 voice_clock = 0;
+static int voice_reserved = 0;
+static float voice_cull_distance = -1.0f; /* < 0 when off */
+
+static void
+_voice_push(int channel)
+{
+    SDL_AtomicLock(&voice_lock);
+    if (voice_nfree < voice_capacity && !channeldata[channel].free_listed) {
+        channeldata[channel].free_listed = 1;
+        voice_free[voice_nfree++] = channel;
+    }
+    SDL_AtomicUnlock(&voice_lock);
+}
+
+static int
+_voice_pop(void)
+{
+    int channel = -1;
+
+    SDL_AtomicLock(&voice_lock);
+    if (voice_nfree > 0) {
+        channel = voice_free[--voice_nfree];
+        channeldata[channel].free_listed = 0;
+    }
+    SDL_AtomicUnlock(&voice_lock);
+    return channel;
+}
+
+/* Makes room on the stack for numchanneldata channels and pushes the ones
+ * from first on. Returns -1 if out of memory. */
+static int
+_voice_grow(int first)
+{
+    int *grown, i;
+
+    SDL_AtomicLock(&voice_lock);
+    grown = (int *)realloc(voice_free, sizeof(int) * numchanneldata);
+    if (grown) {
+        voice_free = grown;
+        voice_capacity = numchanneldata;
+    }
+    SDL_AtomicUnlock(&voice_lock);
+    if (!grown) {
+        return -1;
+    }
+    /* lowest channel on top, like Mix_PlayChannel() picks them */
+    for (i = numchanneldata - 1; i >= first; i--) {
+        channeldata[i].priority = 0;
+        channeldata[i].started = 0;
+        channeldata[i].free_listed = 0;
+        _voice_push(i);
+    }
+    return 0;
+}
+
+/* Picks the channel for a chunk played with priority, or -1 if there is
+ * none to spare. A chunk already on max_instances channels replaces the
+ * oldest of them. */
+static int
+_voice_alloc(Mix_Chunk *chunk, int max_instances, int priority)
+{
+    int numchans = Mix_AllocateChannels(-1);
+    int channel, victim = -1;
+
+    if (max_instances > 0 &&
+        Mix_GroupCount((int)(intptr_t)chunk) >= max_instances) {
+        return Mix_GroupOldest((int)(intptr_t)chunk);
+    }
+    while ((channel = _voice_pop()) != -1) {
+        if (channel >= voice_reserved && channel < numchans &&
+            !Mix_Playing(channel)) {
+            return channel;
+        }
+    }
+    /* channels left off the stack are still found here, if slowly */
+    for (channel = voice_reserved; channel < numchans; channel++) {
+        if (!Mix_Playing(channel)) {
+            return channel;
+        }
+        if (channeldata[channel].priority < priority &&
+            (victim == -1 ||
+             channeldata[channel].priority < channeldata[victim].priority ||
+             (channeldata[channel].priority == channeldata[victim].priority &&
+              channeldata[channel].started < channeldata[victim].started))) {
+            victim = channel;
+        }
+    }
+    return victim;
+}
 
 Mix_Music **mx_current_music;
 Mix_Music **mx_queue_music;
@@ -233,10 +371,12 @@ _format_view_to_audio(Py_buffer *view)
             break;
 
         case 'f':
+            format |= PG_SAMPLE_FLOAT;
             format += native_size ? sizeof(float) : 4;
             break;
 
         case 'd':
+            format |= PG_SAMPLE_FLOAT;
             format += native_size ? sizeof(double) : 8;
             break;
 
@@ -310,6 +450,8 @@ endsound_callback(int channel)
             channeldata[channel].sound = NULL;
             PyGILState_Release(gstate);
             Mix_GroupChannel(channel, -1);
+            channeldata[channel].priority = 0;
+            _voice_push(channel);
         }
     }
 }
@@ -421,6 +563,12 @@ _init(int freq, int size, int channels, int chunk, char *devicename,
                 channeldata[i].sound = NULL;
                 channeldata[i].queue = NULL;
                 channeldata[i].endevent = 0;
+                channeldata[i].dsp = NULL;
+            }
+            voice_nfree = 0;
+            voice_reserved = 0;
+            if (_voice_grow(0)) {
+                return PyErr_NoMemory();
             }
         }
 
@@ -448,6 +596,7 @@ _init(int freq, int size, int channels, int chunk, char *devicename,
         }
         Mix_ChannelFinished(endsound_callback);
         Mix_VolumeMusic(127);
+        _output_tap_open();
     }
 
     mx_current_music = NULL;
@@ -508,8 +657,12 @@ mixer_quit(PyObject *self, PyObject *_null)
         Mix_HaltMusic();
         Py_END_ALLOW_THREADS;
 
+        _dsp_remove(MIX_CHANNEL_POST, &master_dsp);
+        _output_tap_set(NULL, NULL);
+        _output_tap_close();
         if (channeldata) {
             for (i = 0; i < numchanneldata; ++i) {
+                _dsp_remove(i, &channeldata[i].dsp);
                 Py_XDECREF(channeldata[i].sound);
                 Py_XDECREF(channeldata[i].queue);
             }
@@ -517,6 +670,9 @@ mixer_quit(PyObject *self, PyObject *_null)
             channeldata = NULL;
             numchanneldata = 0;
         }
+        free(voice_free);
+        voice_free = NULL;
+        voice_nfree = voice_capacity = 0;
 
         if (mx_current_music) {
             if (*mx_current_music) {
@@ -636,28 +792,59 @@ static PyObject *
 pgSound_Play(PyObject *self, PyObject *args, PyObject *kwargs)
 {
     Mix_Chunk *chunk = pgSound_AsChunk(self);
+    int max_instances = ((pgSoundObject *)self)->max_instances;
     int channelnum = -1;
-    int loops = 0, playtime = -1, fade_ms = 0;
+    int loops = 0, playtime = -1, fade_ms = 0, priority = 0;
+    PyObject *distobj = Py_None;
+    float distance = -1.0f;
 
     CHECK_CHUNK_VALID(chunk, NULL);
 
-    char *kwids[] = {"loops", "maxtime", "fade_ms", NULL};
-    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "|iii", kwids, &loops,
-                                     &playtime, &fade_ms))
+    char *kwids[] = {"loops",    "maxtime",  "fade_ms",
+                     "priority", "distance", NULL};
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "|iiiiO", kwids, &loops,
+                                     &playtime, &fade_ms, &priority,
+                                     &distobj))
         return NULL;
 
+    if (distobj != Py_None) {
+        distance = (float)PyFloat_AsDouble(distobj);
+        if (distance == -1.0f && PyErr_Occurred()) {
+            return NULL;
+        }
+        distance = roundf(distance);
+        if (0 > distance || 256 <= distance) {
+            return RAISE(PyExc_ValueError,
+                         "distance out of range, expected (0, 255)");
+        }
+        if (voice_cull_distance >= 0 && distance >= voice_cull_distance) {
+            Py_RETURN_NONE;
+        }
+    }
+
     Py_BEGIN_ALLOW_THREADS;
-    if (fade_ms > 0) {
-        channelnum =
-            Mix_FadeInChannelTimed(-1, chunk, loops, fade_ms, playtime);
+    channelnum = _voice_alloc(chunk, max_instances, priority);
+    if (channelnum != -1) {
+        if (fade_ms > 0) {
+            channelnum = Mix_FadeInChannelTimed(channelnum, chunk, loops,
+                                                fade_ms, playtime);
+        }
+        else {
+            channelnum =
+                Mix_PlayChannelTimed(channelnum, chunk, loops, playtime);
+        }
     }
-    else {
-        channelnum = Mix_PlayChannelTimed(-1, chunk, loops, playtime);
+    /* effects are dropped when a channel finishes, so this is per play */
+    if (channelnum != -1 && distobj != Py_None) {
+        Mix_SetDistance(channelnum, (Uint8)distance);
     }
     Py_END_ALLOW_THREADS;
     if (channelnum == -1)
         Py_RETURN_NONE;
 
+    channeldata[channelnum].priority = priority;
+    channeldata[channelnum].started = ++voice_clock;
+
     Py_XDECREF(channeldata[channelnum].sound);
     Py_XDECREF(channeldata[channelnum].queue);
     channeldata[channelnum].queue = NULL;
@@ -685,6 +872,27 @@ snd_get_num_channels(PyObject *self, PyObject *_null)
     return PyLong_FromLong(Mix_GroupCount((int)(intptr_t)chunk));
 }
 
+static PyObject *
+snd_set_max_instances(PyObject *self, PyObject *arg)
+{
+    long count = PyLong_AsLong(arg);
+
+    if (count == -1 && PyErr_Occurred()) {
+        return NULL;
+    }
+    if (count < 0 || count > INT_MAX) {
+        return RAISE(PyExc_ValueError, "count out of range");
+    }
+    ((pgSoundObject *)self)->max_instances = (int)count;
+    Py_RETURN_NONE;
+}
+
+static PyObject *
+snd_get_max_instances(PyObject *self, PyObject *_null)
+{
+    return PyLong_FromLong(((pgSoundObject *)self)->max_instances);
+}
+
 static PyObject *
 snd_fadeout(PyObject *self, PyObject *args)
 {
@@ -836,6 +1044,10 @@ PyMethodDef sound_methods[] = {
      DOC_MIXER_SOUND_PLAY},
     {"get_num_channels", snd_get_num_channels, METH_NOARGS,
      DOC_MIXER_SOUND_GETNUMCHANNELS},
+    {"set_max_instances", snd_set_max_instances, METH_O,
+     DOC_MIXER_SOUND_SETMAXINSTANCES},
+    {"get_max_instances", snd_get_max_instances, METH_NOARGS,
+     DOC_MIXER_SOUND_GETMAXINSTANCES},
     {"fadeout", snd_fadeout, METH_VARARGS, DOC_MIXER_SOUND_FADEOUT},
     {"stop", snd_stop, METH_NOARGS, DOC_MIXER_SOUND_STOP},
     {"set_volume", snd_set_volume, METH_VARARGS, DOC_MIXER_SOUND_SETVOLUME},
@@ -969,11 +1181,21 @@ snd_getbuffer(PyObject *obj, Py_buffer *view, int flags)
             strides[ndim - 1] = itemsize;
         }
     }
+    if (((pgSoundObject *)obj)->view &&
+        ((pgSoundObject *)obj)->view->readonly &&
+        PyBUF_HAS_FLAG(flags, PyBUF_WRITABLE)) {
+        PyMem_Free(shape);
+        PyErr_SetString(pgExc_BufferError,
+                        "Sound shares the memory of a read-only buffer");
+        return -1;
+    }
     Py_INCREF(obj);
     view->obj = obj;
     view->buf = chunk->abuf;
     view->len = (Py_ssize_t)chunk->alen;
-    view->readonly = 0;
+    view->readonly =
+        ((pgSoundObject *)obj)->view ? ((pgSoundObject *)obj)->view->readonly
+                                     : 0;
     view->itemsize = itemsize;
     view->format = PyBUF_HAS_FLAG(flags, PyBUF_FORMAT) ? format : 0;
     view->ndim = ndim;
@@ -1007,6 +1229,10 @@ sound_dealloc(pgSoundObject *self)
     }
     if (self->mem)
         PyMem_Free(self->mem);
+    if (self->view) {
+        PyBuffer_Release(self->view);
+        PyMem_Free(self->view);
+    }
     if (self->weakreflist)
         PyObject_ClearWeakRefs((PyObject *)self);
     Py_TYPE(self)->tp_free((PyObject *)self);
@@ -1059,6 +1285,8 @@ chan_play(PyObject *self, PyObject *args, PyObject *kwargs)
     Py_XDECREF(channeldata[channelnum].queue);
     channeldata[channelnum].sound = sound;
     channeldata[channelnum].queue = NULL;
+    channeldata[channelnum].priority = 0;
+    channeldata[channelnum].started = ++voice_clock;
     Py_INCREF(sound);
     Py_RETURN_NONE;
 }
@@ -1318,6 +1546,763 @@ static PyGetSetDef _channel_getsets[] = {
     {"id", (getter)chan_get_id, NULL, DOC_MIXER_CHANNEL_ID, NULL},
     {NULL, NULL, NULL, NULL, NULL}};
 
+/* DSP effect chain
+ *
+ * Each channel (and the master bus, MIX_CHANNEL_POST) may own a pgDspState
+ * registered with Mix_RegisterEffect. The chain runs gain ramp -> biquad
+ * filter -> compressor -> reverb on float samples, converting from and to
+ * the mixer format in blocks of DSP_BLOCK frames.
+ *
+ * Python threads only ever write state->pending, bracketed by an odd/even
+ * sequence number. The audio thread copies it into state->params when it
+ * sees a new even sequence number and keeps its old settings otherwise, so
+ * neither side waits on the other.
+ */
+#define DSP_BLOCK 256
+#define DSP_MAX_CHANNELS 8
+#define DSP_COMBS 4
+#define DSP_ALLPASSES 2
+#define DSP_STEREO_SPREAD 23
+
+enum { DSP_FILTER_OFF, DSP_FILTER_LOWPASS, DSP_FILTER_HIGHPASS };
+
+static const int dsp_comb_tuning[DSP_COMBS] = {1116, 1188, 1277, 1356};
+static const int dsp_allpass_tuning[DSP_ALLPASSES] = {556, 441};
+
+typedef struct {
+    /* user facing values, kept so partial updates can be recomputed */
+    float gain, ramp_ms;
+    int filter;
+    float cutoff, q;
+    int compress;
+    float threshold_db, ratio, attack_ms, release_ms;
+    float reverb, room_size, damping;
+    /* derived values used by the audio thread */
+    float b0, b1, b2, a1, a2;
+    float threshold, attack, release;
+    float feedback;
+} pgDspParams;
+
+struct pgDspState {
+    SDL_atomic_t seq;
+    int seen;
+    pgDspParams pending;
+    pgDspParams params;
+    int freq, channels;
+    Uint16 format;
+    float gain, gain_step;
+    int ramp_left;
+    float z1[DSP_MAX_CHANNELS], z2[DSP_MAX_CHANNELS];
+    float env;
+    float *comb[DSP_MAX_CHANNELS][DSP_COMBS];
+    float comb_store[DSP_MAX_CHANNELS][DSP_COMBS];
+    int comb_len[DSP_MAX_CHANNELS][DSP_COMBS];
+    int comb_pos[DSP_MAX_CHANNELS][DSP_COMBS];
+    float *allpass[DSP_MAX_CHANNELS][DSP_ALLPASSES];
+    int allpass_len[DSP_MAX_CHANNELS][DSP_ALLPASSES];
+    int allpass_pos[DSP_MAX_CHANNELS][DSP_ALLPASSES];
+    float *reverb_mem;
+};
+
+static void
+_dsp_scale(float *buf, int count, float gain)
+{
+    int i = 0;
+#ifdef PG_DSP_SSE_NEON
+    __m128 g = _mm_set1_ps(gain);
+
+    for (; i + 4 <= count; i += 4) {
+        _mm_storeu_ps(buf + i, _mm_mul_ps(_mm_loadu_ps(buf + i), g));
+    }
+#endif
+    for (; i < count; ++i) {
+        buf[i] *= gain;
+    }
+}
+
+static void
+_dsp_to_float(Uint16 format, const Uint8 *src, float *dst, int count)
+{
+    int i = 0;
+
+    if (format == AUDIO_F32SYS) {
+        memcpy(dst, src, sizeof(float) * count);
+    }
+    else if (format == AUDIO_S16SYS) {
+        const Sint16 *s = (const Sint16 *)src;
+#ifdef PG_DSP_SSE_NEON
+        __m128 k = _mm_set1_ps(1.0f / 32768.0f);
+
+        for (; i + 8 <= count; i += 8) {
+            __m128i v = _mm_loadu_si128((const __m128i *)(s + i));
+            /* sign extend by unpacking into the high halves */
+            __m128i lo = _mm_srai_epi32(_mm_unpacklo_epi16(v, v), 16);
+            __m128i hi = _mm_srai_epi32(_mm_unpackhi_epi16(v, v), 16);
+
+            _mm_storeu_ps(dst + i, _mm_mul_ps(_mm_cvtepi32_ps(lo), k));
+            _mm_storeu_ps(dst + i + 4, _mm_mul_ps(_mm_cvtepi32_ps(hi), k));
+        }
+#endif
+        for (; i < count; ++i) {
+            dst[i] = s[i] * (1.0f / 32768.0f);
+        }
+    }
+    else { /* AUDIO_S32SYS */
+        const Sint32 *s = (const Sint32 *)src;
+
+        for (; i < count; ++i) {
+            dst[i] = (float)(s[i] * (1.0 / 2147483648.0));
+        }
+    }
+}
+
+static void
+_dsp_from_float(Uint16 format, const float *src, Uint8 *dst, int count)
+{
+    int i = 0;
+
+    if (format == AUDIO_F32SYS) {
+        memcpy(dst, src, sizeof(float) * count);
+    }
+    else if (format == AUDIO_S16SYS) {
+        Sint16 *d = (Sint16 *)dst;
+#ifdef PG_DSP_SSE_NEON
+        __m128 k = _mm_set1_ps(32768.0f);
+
+        for (; i + 8 <= count; i += 8) {
+            /* cvtps rounds, packs saturates to the Sint16 range */
+            __m128i lo = _mm_cvtps_epi32(_mm_mul_ps(_mm_loadu_ps(src + i), k));
+            __m128i hi =
+                _mm_cvtps_epi32(_mm_mul_ps(_mm_loadu_ps(src + i + 4), k));
+
+            _mm_storeu_si128((__m128i *)(d + i), _mm_packs_epi32(lo, hi));
+        }
+#endif
+        for (; i < count; ++i) {
+            float v = src[i] * 32768.0f;
+
+            d[i] = (Sint16)(v >= 32767.0f    ? 32767
+                            : v <= -32768.0f ? -32768
+                                             : (int)v);
+        }
+    }
+    else { /* AUDIO_S32SYS */
+        Sint32 *d = (Sint32 *)dst;
+
+        for (; i < count; ++i) {
+            double v = src[i] * 2147483648.0;
+
+            d[i] = (Sint32)(v >= 2147483647.0    ? 2147483647.0
+                            : v <= -2147483648.0 ? -2147483648.0
+                                                 : v);
+        }
+    }
+}
+
+/* Pick up new parameters from Python without ever waiting on the writer. */
+static void
+_dsp_sync(pgDspState *st)
+{
+    int seq = SDL_AtomicGet(&st->seq);
+    pgDspParams p;
+    float target;
+
+    if (seq == st->seen || (seq & 1)) {
+        return;
+    }
+    p = st->pending;
+    if (SDL_AtomicGet(&st->seq) != seq) {
+        return; /* torn read, try again on the next buffer */
+    }
+    st->seen = seq;
+    target = p.gain;
+    if (target != st->params.gain || st->ramp_left) {
+        st->ramp_left = (int)(p.ramp_ms * st->freq / 1000.0f);
+        if (st->ramp_left > 0) {
+            st->gain_step = (target - st->gain) / st->ramp_left;
+        }
+        else {
+            st->gain = target;
+        }
+    }
+    if (p.compress && !st->params.compress) {
+        st->env = 0.0f;
+    }
+    st->params = p;
+}
+
+static void
+_dsp_process(pgDspState *st, float *buf, int frames)
+{
+    const pgDspParams *p = &st->params;
+    int nch = st->channels;
+    int i, c, k;
+
+    /* gain, ramping linearly towards the target */
+    if (st->ramp_left > 0) {
+        for (i = 0; i < frames; ++i) {
+            if (st->ramp_left > 0) {
+                st->gain += st->gain_step;
+                if (--st->ramp_left == 0) {
+                    st->gain = p->gain;
+                }
+            }
+            for (c = 0; c < nch; ++c) {
+                buf[i * nch + c] *= st->gain;
+            }
+        }
+    }
+    else if (st->gain != 1.0f) {
+        _dsp_scale(buf, frames * nch, st->gain);
+    }
+
+    /* biquad, transposed direct form II */
+    if (p->filter != DSP_FILTER_OFF) {
+        for (c = 0; c < nch; ++c) {
+            float z1 = st->z1[c], z2 = st->z2[c];
+            float *x = buf + c;
+
+            for (i = 0; i < frames; ++i, x += nch) {
+                float y = p->b0 * *x + z1;
+
+                z1 = p->b1 * *x - p->a1 * y + z2;
+                z2 = p->b2 * *x - p->a2 * y;
+                *x = y;
+            }
+            st->z1[c] = z1;
+            st->z2[c] = z2;
+        }
+    }
+
+    /* linked peak compressor */
+    if (p->compress) {
+        for (i = 0; i < frames; ++i) {
+            float *x = buf + i * nch;
+            float peak = 0.0f, coeff;
+
+            for (c = 0; c < nch; ++c) {
+                float a = x[c] < 0 ? -x[c] : x[c];
+
+                if (a > peak) {
+                    peak = a;
+                }
+            }
+            coeff = peak > st->env ? p->attack : p->release;
+            st->env = coeff * st->env + (1.0f - coeff) * peak;
+            if (st->env > p->threshold) {
+                float g = powf(st->env / p->threshold, 1.0f / p->ratio - 1.0f);
+
+                for (c = 0; c < nch; ++c) {
+                    x[c] *= g;
+                }
+            }
+        }
+    }
+
+    /* Schroeder reverb: parallel damped combs into series allpasses */
+    if (p->reverb > 0.0f && st->reverb_mem) {
+        float wet = p->reverb, dry = 1.0f - p->reverb;
+        float damp = p->damping, feedback = p->feedback;
+
+        for (c = 0; c < nch; ++c) {
+            float *x = buf + c;
+
+            for (i = 0; i < frames; ++i, x += nch) {
+                float in = *x * 0.05f, out = 0.0f;
+
+                for (k = 0; k < DSP_COMBS; ++k) {
+                    float *line = st->comb[c][k];
+                    int pos = st->comb_pos[c][k];
+                    float y = line[pos];
+
+                    st->comb_store[c][k] =
+                        y * (1.0f - damp) + st->comb_store[c][k] * damp;
+                    line[pos] = in + st->comb_store[c][k] * feedback;
+                    if (++pos == st->comb_len[c][k]) {
+                        pos = 0;
+                    }
+                    st->comb_pos[c][k] = pos;
+                    out += y;
+                }
+                for (k = 0; k < DSP_ALLPASSES; ++k) {
+                    float *line = st->allpass[c][k];
+                    int pos = st->allpass_pos[c][k];
+                    float y = line[pos];
+
+                    line[pos] = out + y * 0.5f;
+                    out = y - out;
+                    if (++pos == st->allpass_len[c][k]) {
+                        pos = 0;
+                    }
+                    st->allpass_pos[c][k] = pos;
+                }
+                *x = *x * dry + out * wet;
+            }
+        }
+    }
+}
+
+static void SDLCALL
+_dsp_effect(int chan, void *stream, int len, void *udata)
+{
+    pgDspState *st = (pgDspState *)udata;
+    float block[DSP_BLOCK * DSP_MAX_CHANNELS];
+    Uint8 *data = (Uint8 *)stream;
+    int frame_size = SDL_AUDIO_BITSIZE(st->format) / 8 * st->channels;
+    int frames = len / frame_size;
+    int n;
+
+    _dsp_sync(st);
+    if (st->gain == 1.0f && !st->ramp_left &&
+        st->params.filter == DSP_FILTER_OFF && !st->params.compress &&
+        st->params.reverb <= 0.0f) {
+        return;
+    }
+    while (frames > 0) {
+        n = frames < DSP_BLOCK ? frames : DSP_BLOCK;
+        _dsp_to_float(st->format, data, block, n * st->channels);
+        _dsp_process(st, block, n);
+        _dsp_from_float(st->format, block, data, n * st->channels);
+        data += n * frame_size;
+        frames -= n;
+    }
+}
+
+static pgDspState *
+_dsp_new(void)
+{
+    pgDspState *st;
+    int freq, channels, c, k, len, total = 0;
+    Uint16 format;
+    float *mem;
+
+    if (!Mix_QuerySpec(&freq, &format, &channels)) {
+        return (pgDspState *)RAISE(pgExc_SDLError, "mixer not initialized");
+    }
+    if (format != AUDIO_S16SYS && format != AUDIO_S32SYS &&
+        format != AUDIO_F32SYS) {
+        return (pgDspState *)RAISE(
+            pgExc_SDLError,
+            "effects need a native 16 bit, 32 bit or float mixer format");
+    }
+    if (channels > DSP_MAX_CHANNELS) {
+        return (pgDspState *)RAISE(pgExc_SDLError,
+                                   "too many mixer channels for effects");
+    }
+    st = PyMem_New(pgDspState, 1);
+    if (!st) {
+        return (pgDspState *)PyErr_NoMemory();
+    }
+    memset(st, 0, sizeof(pgDspState));
+    st->freq = freq;
+    st->channels = channels;
+    st->format = format;
+    st->gain = 1.0f;
+    st->params.gain = 1.0f;
+    st->params.cutoff = 1000.0f;
+    st->params.q = 0.7071f;
+    st->params.threshold_db = -12.0f;
+    st->params.ratio = 4.0f;
+    st->params.attack_ms = 5.0f;
+    st->params.release_ms = 100.0f;
+    st->params.room_size = 0.5f;
+    st->params.damping = 0.5f;
+    st->pending = st->params;
+
+    /* delay lines are tuned for 44.1kHz, odd channels slightly longer */
+    for (c = 0; c < channels; ++c) {
+        for (k = 0; k < DSP_COMBS; ++k) {
+            len = (dsp_comb_tuning[k] + (c & 1) * DSP_STEREO_SPREAD) * freq /
+                  44100;
+            st->comb_len[c][k] = len > 0 ? len : 1;
+            total += st->comb_len[c][k];
+        }
+        for (k = 0; k < DSP_ALLPASSES; ++k) {
+            len = (dsp_allpass_tuning[k] + (c & 1) * DSP_STEREO_SPREAD) *
+                  freq / 44100;
+            st->allpass_len[c][k] = len > 0 ? len : 1;
+            total += st->allpass_len[c][k];
+        }
+    }
+    mem = PyMem_New(float, total);
+    if (!mem) {
+        PyMem_Free(st);
+        return (pgDspState *)PyErr_NoMemory();
+    }
+    memset(mem, 0, sizeof(float) * total);
+    st->reverb_mem = mem;
+    for (c = 0; c < channels; ++c) {
+        for (k = 0; k < DSP_COMBS; ++k) {
+            st->comb[c][k] = mem;
+            mem += st->comb_len[c][k];
+        }
+        for (k = 0; k < DSP_ALLPASSES; ++k) {
+            st->allpass[c][k] = mem;
+            mem += st->allpass_len[c][k];
+        }
+    }
+    return st;
+}
+
+static void
+_dsp_remove(int channel, pgDspState **slot)
+{
+    pgDspState *st = *slot;
+
+    if (!st) {
+        return;
+    }
+    *slot = NULL;
+    /* unregistering locks the audio device, which the channel finished
+     * callback may hold while it waits for the GIL */
+    Py_BEGIN_ALLOW_THREADS;
+    Mix_UnregisterEffect(channel, _dsp_effect);
+    Py_END_ALLOW_THREADS;
+    PyMem_Free(st->reverb_mem);
+    PyMem_Free(st);
+}
+
+/* Recompute the derived parameters after a Python side change. */
+static void
+_dsp_derive(pgDspParams *p, int freq)
+{
+    if (p->filter != DSP_FILTER_OFF) {
+        double w0 = 2.0 * M_PI * p->cutoff / freq;
+        double alpha = sin(w0) / (2.0 * p->q);
+        double cw = cos(w0);
+        double a0 = 1.0 + alpha;
+        double b1 = p->filter == DSP_FILTER_LOWPASS ? 1.0 - cw : -(1.0 + cw);
+
+        p->b0 = (float)((p->filter == DSP_FILTER_LOWPASS ? b1 : -b1) / 2.0 /
+                        a0);
+        p->b1 = (float)(b1 / a0);
+        p->b2 = p->b0;
+        p->a1 = (float)(-2.0 * cw / a0);
+        p->a2 = (float)((1.0 - alpha) / a0);
+    }
+    p->threshold = powf(10.0f, p->threshold_db / 20.0f);
+    p->attack = expf(-1000.0f / (p->attack_ms * freq));
+    p->release = expf(-1000.0f / (p->release_ms * freq));
+    p->feedback = 0.7f + 0.28f * p->room_size;
+}
+
+static PyObject *
+_dsp_configure(int channel, pgDspState **slot, PyObject *args,
+               PyObject *kwargs)
+{
+    static char *keywords[] = {"gain",       "ramp_ms",   "filter",
+                               "cutoff",     "q",         "threshold",
+                               "ratio",      "attack_ms", "release_ms",
+                               "reverb",     "room_size", "damping",
+                               NULL};
+    pgDspState *st = *slot;
+    pgDspParams p;
+    PyObject *filter = NULL, *threshold = NULL;
+    int registered = st != NULL, ok;
+
+    MIXER_INIT_CHECK();
+    if (!st && !(st = _dsp_new())) {
+        return NULL;
+    }
+    p = st->pending;
+    if (!PyArg_ParseTupleAndKeywords(
+            args, kwargs, "|$ffOffOffffff", keywords, &p.gain, &p.ramp_ms,
+            &filter, &p.cutoff, &p.q, &threshold, &p.ratio, &p.attack_ms,
+            &p.release_ms, &p.reverb, &p.room_size, &p.damping)) {
+        goto error;
+    }
+    if (filter == Py_None) {
+        p.filter = DSP_FILTER_OFF;
+    }
+    else if (filter) {
+        if (!PyUnicode_Check(filter)) {
+            PyErr_SetString(PyExc_TypeError,
+                            "filter must be 'lowpass', 'highpass' or None");
+            goto error;
+        }
+        if (!PyUnicode_CompareWithASCIIString(filter, "lowpass")) {
+            p.filter = DSP_FILTER_LOWPASS;
+        }
+        else if (!PyUnicode_CompareWithASCIIString(filter, "highpass")) {
+            p.filter = DSP_FILTER_HIGHPASS;
+        }
+        else {
+            PyErr_SetString(PyExc_ValueError,
+                            "filter must be 'lowpass', 'highpass' or None");
+            goto error;
+        }
+    }
+    if (threshold == Py_None) {
+        p.compress = 0;
+    }
+    else if (threshold) {
+        p.threshold_db = (float)PyFloat_AsDouble(threshold);
+        if (p.threshold_db == -1.0f && PyErr_Occurred()) {
+            goto error;
+        }
+        p.compress = 1;
+    }
+    if (p.gain < 0.0f || p.ramp_ms < 0.0f || p.q <= 0.0f ||
+        p.cutoff <= 0.0f || p.cutoff >= st->freq / 2.0f || p.ratio < 1.0f ||
+        p.attack_ms <= 0.0f || p.release_ms <= 0.0f || p.reverb < 0.0f ||
+        p.reverb > 1.0f || p.room_size < 0.0f || p.room_size > 1.0f ||
+        p.damping < 0.0f || p.damping > 1.0f) {
+        PyErr_SetString(PyExc_ValueError, "effect parameter out of range");
+        goto error;
+    }
+    _dsp_derive(&p, st->freq);
+
+    /* single writer: the GIL serializes Python callers */
+    SDL_AtomicAdd(&st->seq, 1);
+    st->pending = p;
+    SDL_AtomicAdd(&st->seq, 1);
+
+    if (!registered) {
+        Py_BEGIN_ALLOW_THREADS;
+        ok = Mix_RegisterEffect(channel, _dsp_effect, NULL, st);
+        Py_END_ALLOW_THREADS;
+        if (!ok) {
+            PyErr_SetString(pgExc_SDLError, Mix_GetError());
+            goto error;
+        }
+        *slot = st;
+    }
+    Py_RETURN_NONE;
+
+error:
+    if (!registered) {
+        PyMem_Free(st->reverb_mem);
+        PyMem_Free(st);
+    }
+    return NULL;
+}
+
+static PyObject *
+chan_set_dsp(PyObject *self, PyObject *args, PyObject *kwargs)
+{
+    int channelnum = pgChannel_AsInt(self);
+
+    MIXER_INIT_CHECK();
+    if (channelnum >= numchanneldata) {
+        return RAISE(PyExc_IndexError, "invalid channel index");
+    }
+    return _dsp_configure(channelnum, &channeldata[channelnum].dsp, args,
+                          kwargs);
+}
+
+static PyObject *
+chan_reset_dsp(PyObject *self, PyObject *_null)
+{
+    int channelnum = pgChannel_AsInt(self);
+
+    MIXER_INIT_CHECK();
+    if (channelnum < numchanneldata) {
+        _dsp_remove(channelnum, &channeldata[channelnum].dsp);
+    }
+    Py_RETURN_NONE;
+}
+
+static PyObject *
+mixer_set_dsp(PyObject *self, PyObject *args, PyObject *kwargs)
+{
+    return _dsp_configure(MIX_CHANNEL_POST, &master_dsp, args, kwargs);
+}
+
+static PyObject *
+mixer_reset_dsp(PyObject *self, PyObject *_null)
+{
+    MIXER_INIT_CHECK();
+    _dsp_remove(MIX_CHANNEL_POST, &master_dsp);
+    Py_RETURN_NONE;
+}
+
+/* Output tap
+ *
+ * A MIX_CHANNEL_POST effect registered for as long as the mixer is open.
+ * It counts the frames handed to the device, stamps them with the
+ * performance counter and optionally copies the final mix into a ring
+ * buffer or passes it to a Python callable. The ring buffer and callable
+ * are only swapped while the tap is unregistered.
+ */
+typedef struct {
+    SDL_atomic_t seq;
+    Uint64 frames;
+    Uint64 counter;
+    int frame_size;
+    Py_buffer ring; /* ring.obj is NULL when no buffer is installed */
+    PyObject *callback;
+} pgOutputTap;
+
+static pgOutputTap output_tap;
+
+static void SDLCALL
+_output_tap_effect(int chan, void *stream, int len, void *udata)
+{
+    pgOutputTap *tap = (pgOutputTap *)udata;
+    Uint64 start = tap->frames;
+
+    if (tap->ring.obj) {
+        Uint8 *src = (Uint8 *)stream;
+        Py_ssize_t pos = (Py_ssize_t)((start * tap->frame_size) %
+                                      (Uint64)tap->ring.len);
+        Py_ssize_t left = len, n;
+
+        while (left > 0) {
+            n = tap->ring.len - pos;
+            n = n < left ? n : left;
+            memcpy((Uint8 *)tap->ring.buf + pos, src, n);
+            src += n;
+            left -= n;
+            pos = 0;
+        }
+    }
+    if (tap->callback) {
+        PyGILState_STATE gstate = PyGILState_Ensure();
+        PyObject *view, *result = NULL;
+
+        view = PyMemoryView_FromMemory((char *)stream, len, PyBUF_READ);
+        if (view) {
+            result = PyObject_CallFunction(tap->callback, "OK", view,
+                                           (unsigned long long)start);
+            Py_XDECREF(result);
+            if (result) {
+                /* the memory is only valid during the call */
+                result = PyObject_CallMethod(view, "release", NULL);
+                Py_XDECREF(result);
+            }
+            Py_DECREF(view);
+        }
+        if (!result) {
+            PyErr_WriteUnraisable(tap->callback);
+        }
+        PyGILState_Release(gstate);
+    }
+
+    SDL_AtomicAdd(&tap->seq, 1);
+    tap->frames = start + len / tap->frame_size;
+    tap->counter = SDL_GetPerformanceCounter();
+    SDL_AtomicAdd(&tap->seq, 1);
+}
+
+/* Called with the audio device open, right after Mix_OpenAudioDevice, or
+ * on first use if something else opened the device. */
+static int
+_output_tap_open(void)
+{
+    int freq, channels;
+    Uint16 format;
+
+    if (!Mix_QuerySpec(&freq, &format, &channels)) {
+        return -1;
+    }
+    output_tap.frame_size = SDL_AUDIO_BITSIZE(format) / 8 * channels;
+    output_tap.frames = 0;
+    output_tap.counter = SDL_GetPerformanceCounter();
+    Mix_RegisterEffect(MIX_CHANNEL_POST, _output_tap_effect, NULL,
+                       &output_tap);
+    return 0;
+}
+
+/* Forget the device format; Mix_CloseAudio drops the tap itself. */
+static void
+_output_tap_close(void)
+{
+    output_tap.frame_size = 0;
+}
+
+static void
+_output_tap_set(Py_buffer *ring, PyObject *callback)
+{
+    Py_buffer old_ring = output_tap.ring;
+    PyObject *old_callback = output_tap.callback;
+
+    /* the tap may hold the GIL while the audio device is locked */
+    Py_BEGIN_ALLOW_THREADS;
+    Mix_UnregisterEffect(MIX_CHANNEL_POST, _output_tap_effect);
+    Py_END_ALLOW_THREADS;
+
+    if (ring) {
+        output_tap.ring = *ring;
+    }
+    else {
+        output_tap.ring.obj = NULL;
+    }
+    Py_XINCREF(callback);
+    output_tap.callback = callback;
+
+    if (SDL_WasInit(SDL_INIT_AUDIO)) {
+        Py_BEGIN_ALLOW_THREADS;
+        Mix_RegisterEffect(MIX_CHANNEL_POST, _output_tap_effect, NULL,
+                           &output_tap);
+        Py_END_ALLOW_THREADS;
+    }
+
+    if (old_ring.obj) {
+        PyBuffer_Release(&old_ring);
+    }
+    Py_XDECREF(old_callback);
+}
+
+static PyObject *
+mixer_set_output_callback(PyObject *self, PyObject *arg)
+{
+    Py_buffer ring;
+
+    MIXER_INIT_CHECK();
+    if (!output_tap.frame_size && _output_tap_open()) {
+        return RAISE(pgExc_SDLError, "mixer not initialized");
+    }
+    if (arg == Py_None) {
+        _output_tap_set(NULL, NULL);
+    }
+    else if (PyCallable_Check(arg)) {
+        _output_tap_set(NULL, arg);
+    }
+    else {
+        if (PyObject_GetBuffer(arg, &ring, PyBUF_WRITABLE)) {
+            PyErr_Format(PyExc_TypeError,
+                         "expected None, a callable or a writable "
+                         "contiguous buffer, got %s",
+                         Py_TYPE(arg)->tp_name);
+            return NULL;
+        }
+        if (!ring.len || ring.len % output_tap.frame_size) {
+            PyErr_Format(PyExc_ValueError,
+                         "buffer length must be a non-zero multiple of the "
+                         "frame size (%d bytes)",
+                         output_tap.frame_size);
+            PyBuffer_Release(&ring);
+            return NULL;
+        }
+        _output_tap_set(&ring, NULL);
+    }
+    Py_RETURN_NONE;
+}
+
+static PyObject *
+mixer_get_output_position(PyObject *self, PyObject *_null)
+{
+    Uint64 frames, counter, now;
+    double ticks;
+    int seq;
+
+    MIXER_INIT_CHECK();
+    if (!output_tap.frame_size && _output_tap_open()) {
+        return RAISE(pgExc_SDLError, "mixer not initialized");
+    }
+    do {
+        seq = SDL_AtomicGet(&output_tap.seq);
+        frames = output_tap.frames;
+        counter = output_tap.counter;
+    } while ((seq & 1) || SDL_AtomicGet(&output_tap.seq) != seq);
+
+    /* express the counter on the pygame.time.get_ticks() clock */
+    now = SDL_GetPerformanceCounter();
+    ticks = (double)PG_GetTicks() -
+            (double)(now - counter) * 1000.0 / SDL_GetPerformanceFrequency();
+    return Py_BuildValue("(Kd)", (unsigned long long)frames, ticks);
+}
+
 static PyMethodDef channel_methods[] = {
     {"play", (PyCFunction)chan_play, METH_VARARGS | METH_KEYWORDS,
      DOC_MIXER_CHANNEL_PLAY},
@@ -1334,6 +2319,10 @@ static PyMethodDef channel_methods[] = {
     {"set_volume", chan_set_volume, METH_VARARGS, DOC_MIXER_CHANNEL_SETVOLUME},
     {"get_volume", (PyCFunction)chan_get_volume, METH_NOARGS,
      DOC_MIXER_CHANNEL_GETVOLUME},
+    {"set_dsp", (PyCFunction)chan_set_dsp, METH_VARARGS | METH_KEYWORDS,
+     DOC_MIXER_CHANNEL_SETDSP},
+    {"reset_dsp", (PyCFunction)chan_reset_dsp, METH_NOARGS,
+     DOC_MIXER_CHANNEL_RESETDSP},
 
     {"get_sound", (PyCFunction)chan_get_sound, METH_NOARGS,
      DOC_MIXER_CHANNEL_GETSOUND},
@@ -1423,8 +2412,18 @@ set_num_channels(PyObject *self, PyObject *args)
             channeldata[i].sound = NULL;
             channeldata[i].queue = NULL;
             channeldata[i].endevent = 0;
+            channeldata[i].dsp = NULL;
         }
+        i = numchanneldata;
         numchanneldata = numchans;
+        if (_voice_grow(i)) {
+            return PyErr_NoMemory();
+        }
+    }
+
+    /* dropped channels lose their effects, a negative count changes nothing */
+    for (i = numchans; i >= 0 && i < numchanneldata; ++i) {
+        _dsp_remove(i, &channeldata[i].dsp);
     }
 
     Py_BEGIN_ALLOW_THREADS;
@@ -1444,9 +2443,28 @@ set_reserved(PyObject *self, PyObject *args)
     MIXER_INIT_CHECK();
 
     numchans_reserved = Mix_ReserveChannels(numchans_requested);
+    voice_reserved = numchans_reserved;
     return PyLong_FromLong(numchans_reserved);
 }
 
+static PyObject *
+set_cull_distance(PyObject *self, PyObject *arg)
+{
+    float distance = -1.0f;
+
+    if (arg != Py_None) {
+        distance = (float)PyFloat_AsDouble(arg);
+        if (distance == -1.0f && PyErr_Occurred()) {
+            return NULL;
+        }
+        if (distance < 0) {
+            return RAISE(PyExc_ValueError, "distance must not be negative");
+        }
+    }
+    voice_cull_distance = distance;
+    Py_RETURN_NONE;
+}
+
 static PyObject *
 get_busy(PyObject *self, PyObject *_null)
 {
@@ -1621,11 +2639,347 @@ _chunk_from_buf(const void *buf, Py_ssize_t len, Mix_Chunk **chunk,
         PyErr_NoMemory();
         return -1;
     }
+    Py_BEGIN_ALLOW_THREADS;
     memcpy(m, (Uint8 *)buf, (size_t)len);
+    Py_END_ALLOW_THREADS;
     *mem = m;
     return 0;
 }
 
+/* Point a chunk straight at the exporter's memory. The view is moved into
+ * *held on success and must stay alive for as long as the chunk does;
+ * Mix_QuickLoad_RAW leaves chunk->allocated at 0 so Mix_FreeChunk will not
+ * try to free it.
+ */
+static int
+_chunk_from_view(Py_buffer *view, Mix_Chunk **chunk, Py_buffer **held)
+{
+    int freq, channels;
+    Uint16 format;
+    int itemsize;
+    Py_buffer *v;
+
+    if (!Mix_QuerySpec(&freq, &format, &channels)) {
+        PyErr_SetString(pgExc_SDLError, "mixer not initialized");
+        return -1;
+    }
+    itemsize = _format_itemsize(format);
+    if (itemsize < 0) {
+        return -1;
+    }
+    if (view->len % (itemsize * channels)) {
+        PyErr_Format(PyExc_ValueError,
+                     "buffer length %zd is not a multiple of the mixer "
+                     "frame size %d",
+                     view->len, itemsize * channels);
+        return -1;
+    }
+    v = PyMem_New(Py_buffer, 1);
+    if (!v) {
+        PyErr_NoMemory();
+        return -1;
+    }
+    *chunk = Mix_QuickLoad_RAW((Uint8 *)view->buf, (Uint32)view->len);
+    if (!*chunk) {
+        PyMem_Free(v);
+        PyErr_SetString(pgExc_SDLError, SDL_GetError());
+        return -1;
+    }
+    *v = *view;
+    *held = v;
+    return 0;
+}
+
+static Uint32
+_read_le32(const Uint8 *p)
+{
+    return (Uint32)p[0] | ((Uint32)p[1] << 8) | ((Uint32)p[2] << 16) |
+           ((Uint32)p[3] << 24);
+}
+
+/* Locate the sample data of a plain PCM or float RIFF/WAVE image.
+ * Returns 0 and fills in the format on success, -1 (without an exception
+ * set) if the data cannot be played as is.
+ */
+static int
+_wav_find_data(const Uint8 *buf, Py_ssize_t len, Uint16 *format,
+               int *channels, int *freq, Py_ssize_t *offset, Py_ssize_t *size)
+{
+    Py_ssize_t pos = 12;
+    Uint32 ck_size;
+    Uint16 tag = 0, bits = 0, align = 0;
+
+    *format = 0;
+    if (len < 12 || memcmp(buf, "RIFF", 4) || memcmp(buf + 8, "WAVE", 4)) {
+        return -1;
+    }
+    while (pos + 8 <= len) {
+        ck_size = _read_le32(buf + pos + 4);
+        if (!memcmp(buf + pos, "fmt ", 4) && ck_size >= 16 &&
+            pos + 8 + 16 <= len) {
+            const Uint8 *f = buf + pos + 8;
+
+            tag = (Uint16)(f[0] | (f[1] << 8));
+            *channels = f[2] | (f[3] << 8);
+            *freq = (int)_read_le32(f + 4);
+            align = (Uint16)(f[12] | (f[13] << 8));
+            bits = (Uint16)(f[14] | (f[15] << 8));
+            /* WAVE_FORMAT_EXTENSIBLE keeps the real tag in the GUID */
+            if (tag == 0xFFFE && ck_size >= 40 && pos + 8 + 40 <= len) {
+                tag = (Uint16)(f[24] | (f[25] << 8));
+            }
+            if (tag == 1 && bits == 8) {
+                *format = AUDIO_U8;
+            }
+            else if (tag == 1 && bits == 16) {
+                *format = AUDIO_S16LSB;
+            }
+            else if (tag == 1 && bits == 32) {
+                *format = AUDIO_S32LSB;
+            }
+            else if (tag == 3 && bits == 32) {
+                *format = AUDIO_F32LSB;
+            }
+            else {
+                return -1;
+            }
+        }
+        else if (!memcmp(buf + pos, "data", 4)) {
+            if (!*format || !align) {
+                return -1;
+            }
+            *offset = pos + 8;
+            *size = len - *offset;
+            if ((Py_ssize_t)ck_size < *size) {
+                *size = (Py_ssize_t)ck_size;
+            }
+            /* drop a trailing partial frame of a truncated file */
+            *size -= *size % align;
+            return 0;
+        }
+        pos += 8 + (Py_ssize_t)ck_size + (ck_size & 1);
+    }
+    return -1;
+}
+
+/* Map a WAV file read-only and return a memoryview of its sample data,
+ * Py_None if the file is not in the mixer's format, or NULL on error.
+ */
+static PyObject *
+_sound_map_wav(PyObject *path)
+{
+    PyObject *mmap_mod = NULL, *fileobj = NULL, *map = NULL, *mv = NULL;
+    PyObject *fileno = NULL, *args = NULL, *kwargs = NULL, *tmp;
+    PyObject *ret = NULL;
+    Py_buffer view;
+    Uint16 format, mix_format;
+    int channels, freq, mix_channels, mix_freq;
+    Py_ssize_t offset, size;
+    int found;
+
+    if (!Mix_QuerySpec(&mix_freq, &mix_format, &mix_channels)) {
+        return RAISE(pgExc_SDLError, "mixer not initialized");
+    }
+    if (!(mmap_mod = PyImport_ImportModule("mmap"))) {
+        return NULL;
+    }
+    if (!(tmp = PyImport_ImportModule("io"))) {
+        goto end;
+    }
+    fileobj = PyObject_CallMethod(tmp, "open", "Os", path, "rb");
+    Py_DECREF(tmp);
+    if (!fileobj) {
+        goto end;
+    }
+    if (!(fileno = PyObject_CallMethod(fileobj, "fileno", NULL))) {
+        goto end;
+    }
+    if (!(args = Py_BuildValue("(Oi)", fileno, 0)) ||
+        !(kwargs = PyDict_New()) ||
+        !(tmp = PyObject_GetAttrString(mmap_mod, "ACCESS_READ"))) {
+        goto end;
+    }
+    if (PyDict_SetItemString(kwargs, "access", tmp)) {
+        Py_DECREF(tmp);
+        goto end;
+    }
+    Py_DECREF(tmp);
+    if (!(tmp = PyObject_GetAttrString(mmap_mod, "mmap"))) {
+        goto end;
+    }
+    map = PyObject_Call(tmp, args, kwargs);
+    Py_DECREF(tmp);
+    tmp = PyObject_CallMethod(fileobj, "close", NULL);
+    if (!map || !tmp) {
+        Py_XDECREF(tmp);
+        goto end;
+    }
+    Py_DECREF(tmp);
+
+    if (PyObject_GetBuffer(map, &view, PyBUF_SIMPLE)) {
+        goto end;
+    }
+    found = _wav_find_data((const Uint8 *)view.buf, view.len, &format,
+                           &channels, &freq, &offset, &size);
+    PyBuffer_Release(&view);
+    if (found || format != mix_format || channels != mix_channels ||
+        freq != mix_freq) {
+        tmp = PyObject_CallMethod(map, "close", NULL);
+        Py_XDECREF(tmp);
+        if (tmp) {
+            Py_INCREF(Py_None);
+            ret = Py_None;
+        }
+        goto end;
+    }
+    if ((mv = PyMemoryView_FromObject(map))) {
+        ret = PySequence_GetSlice(mv, offset, offset + size);
+    }
+
+end:
+    Py_XDECREF(mv);
+    Py_XDECREF(map);
+    Py_XDECREF(kwargs);
+    Py_XDECREF(args);
+    Py_XDECREF(fileno);
+    Py_XDECREF(fileobj);
+    Py_DECREF(mmap_mod);
+    return ret;
+}
+
+static int
+_sound_is_option(PyObject *key)
+{
+    return PyUnicode_Check(key) &&
+           (PyUnicode_CompareWithASCIIString(key, "copy") == 0 ||
+            PyUnicode_CompareWithASCIIString(key, "mmap") == 0);
+}
+
+/* Converts n samples, step bytes apart in src, to the mixer format. Float
+ * samples are in [-1, 1], integer ones are scaled to the full range of
+ * their size. Returns 0, doing nothing, for pairs of formats that are
+ * copied as they are. The loops over contiguous samples are plain enough
+ * for the compiler to vectorise. */
+#define PG_SAMPLES_CONVERT(dst_t, src_t, expr)                  \
+    do {                                                        \
+        dst_t *d = (dst_t *)dst;                                \
+        src_t x;                                                \
+        if (step == (Py_ssize_t)sizeof(src_t)) {                \
+            const src_t *s = (const src_t *)src;                \
+            for (i = 0; i < n; i++) {                           \
+                x = s[i];                                       \
+                d[i] = (expr);                                  \
+            }                                                   \
+        }                                                       \
+        else {                                                  \
+            for (i = 0; i < n; i++) {                           \
+                x = *(const src_t *)(src + i * step);           \
+                d[i] = (expr);                                  \
+            }                                                   \
+        }                                                       \
+    } while (0)
+
+#define PG_CLAMP_SAMPLE(v, lo, hi) \
+    ((v) < (lo) ? (lo) : (v) > (hi) ? (hi) : (v))
+
+static int
+_samples_convert(Uint8 *dst, Uint16 format, const Uint8 *src,
+                 PG_sample_format_t view_format, Py_ssize_t n,
+                 Py_ssize_t step)
+{
+    int is_float = (view_format & PG_SAMPLE_FLOAT) != 0;
+    int is_signed = (view_format & PG_SAMPLE_SIGNED) != 0;
+    Py_ssize_t i;
+
+    if (format == AUDIO_F32SYS) {
+        switch (PG_SAMPLE_SIZE(view_format) | is_float << 4 | is_signed << 5) {
+            case 4 | 1 << 4:
+                PG_SAMPLES_CONVERT(float, float, x);
+                return 1;
+            case 8 | 1 << 4:
+                PG_SAMPLES_CONVERT(float, double, (float)x);
+                return 1;
+            case 1:
+                PG_SAMPLES_CONVERT(float, Uint8, (x - 128) * (1.0f / 128));
+                return 1;
+            case 1 | 1 << 5:
+                PG_SAMPLES_CONVERT(float, Sint8, x * (1.0f / 128));
+                return 1;
+            case 2:
+                PG_SAMPLES_CONVERT(float, Uint16,
+                                   (x - 32768) * (1.0f / 32768));
+                return 1;
+            case 2 | 1 << 5:
+                PG_SAMPLES_CONVERT(float, Sint16, x * (1.0f / 32768));
+                return 1;
+            case 4 | 1 << 5:
+                PG_SAMPLES_CONVERT(float, Sint32,
+                                   (float)x * (1.0f / 2147483648.0f));
+                return 1;
+        }
+        return 0;
+    }
+    if (!is_float) {
+        return 0;
+    }
+    /* float samples to the integer formats */
+    switch (format) {
+        case AUDIO_S32SYS:
+            if (PG_SAMPLE_SIZE(view_format) == 4) {
+                PG_SAMPLES_CONVERT(
+                    Sint32, float,
+                    (Sint32)PG_CLAMP_SAMPLE((double)x * 2147483647.0,
+                                            -2147483648.0, 2147483647.0));
+            }
+            else {
+                PG_SAMPLES_CONVERT(
+                    Sint32, double,
+                    (Sint32)PG_CLAMP_SAMPLE(x * 2147483647.0, -2147483648.0,
+                                            2147483647.0));
+            }
+            return 1;
+        case AUDIO_S16SYS:
+            if (PG_SAMPLE_SIZE(view_format) == 4) {
+                PG_SAMPLES_CONVERT(
+                    Sint16, float,
+                    (Sint16)PG_CLAMP_SAMPLE(x * 32767.0f, -32768.0f,
+                                            32767.0f));
+            }
+            else {
+                PG_SAMPLES_CONVERT(
+                    Sint16, double,
+                    (Sint16)PG_CLAMP_SAMPLE(x * 32767.0, -32768.0, 32767.0));
+            }
+            return 1;
+        case AUDIO_S8:
+            if (PG_SAMPLE_SIZE(view_format) == 4) {
+                PG_SAMPLES_CONVERT(
+                    Sint8, float,
+                    (Sint8)PG_CLAMP_SAMPLE(x * 127.0f, -128.0f, 127.0f));
+            }
+            else {
+                PG_SAMPLES_CONVERT(
+                    Sint8, double,
+                    (Sint8)PG_CLAMP_SAMPLE(x * 127.0, -128.0, 127.0));
+            }
+            return 1;
+        case AUDIO_U8:
+            if (PG_SAMPLE_SIZE(view_format) == 4) {
+                PG_SAMPLES_CONVERT(
+                    Uint8, float,
+                    (Uint8)PG_CLAMP_SAMPLE(x * 127.0f + 128.0f, 0.0f,
+                                           255.0f));
+            }
+            else {
+                PG_SAMPLES_CONVERT(
+                    Uint8, double,
+                    (Uint8)PG_CLAMP_SAMPLE(x * 127.0 + 128.0, 0.0, 255.0));
+            }
+            return 1;
+    }
+    return 0;
+}
+
 static int
 _chunk_from_array(void *buf, PG_sample_format_t view_format, int ndim,
                   Py_ssize_t *shape, Py_ssize_t *strides, Mix_Chunk **chunk,
@@ -1677,7 +3031,20 @@ _chunk_from_array(void *buf, PG_sample_format_t view_format, int ndim,
     if (itemsize < 0) {
         return -1;
     }
-    if (view_itemsize != 1 && view_itemsize != 2 && view_itemsize != 4) {
+    if (view_format & PG_SAMPLE_FLOAT) {
+        if (view_itemsize != 4 && view_itemsize != 8) {
+            PyErr_Format(PyExc_ValueError, "Unsupported float size %d",
+                         view_itemsize);
+            return -1;
+        }
+        if (!(view_format & PG_SAMPLE_NATIVE_ENDIAN)) {
+            PyErr_SetString(PyExc_ValueError,
+                            "Float samples must be in native byte order");
+            return -1;
+        }
+    }
+    else if (view_itemsize != 1 && view_itemsize != 2 &&
+             view_itemsize != 4) {
         PyErr_Format(PyExc_ValueError, "Unsupported integer size %d",
                      view_itemsize);
         return -1;
@@ -1715,9 +3082,25 @@ _chunk_from_array(void *buf, PG_sample_format_t view_format, int ndim,
     printf("!! step1: %d, step2: %d, view_itemsize: %d, length: %d\n",
            step1, step2, view_itemsize, length);
     */
-    /* Copy samples.
+    /* Copy samples. Float samples, and any samples for a float mixer,
+     * are scaled to the mixer format, the rest are copied as they were.
+     * None of it touches Python objects, so other threads may run.
      */
-    if (step1 == (Py_ssize_t)itemsize * channels && step2 == itemsize) {
+    Py_BEGIN_ALLOW_THREADS;
+    if (step2 == view_itemsize &&
+        step1 == (Py_ssize_t)view_itemsize * channels &&
+        _samples_convert(dst, format, buf, view_format, length * channels,
+                         view_itemsize)) {
+        /* converted in one pass */
+    }
+    else if (_samples_convert(dst, format, buf, view_format, 0, step2)) {
+        for (loop1 = 0; loop1 < length; loop1++, dst += itemsize * channels) {
+            _samples_convert(dst, format, (Uint8 *)buf + loop1 * step1,
+                             view_format, channels, step2);
+        }
+    }
+    else if (step1 == (Py_ssize_t)itemsize * channels &&
+             step2 == itemsize) {
         /*OPTIMIZATION: in these cases, we don't need to loop through
          *the samples individually, because the bytes are already laid
          *out correctly*/
@@ -1773,6 +3156,7 @@ _chunk_from_array(void *buf, PG_sample_format_t view_format, int ndim,
             }
         }
     }
+    Py_END_ALLOW_THREADS;
 
     return 0;
 }
@@ -1787,13 +3171,23 @@ sound_init(PyObject *self, PyObject *arg, PyObject *kwarg)
     PyObject *buffer = NULL;
     PyObject *array = NULL;
     PyObject *keys;
+    PyObject *key;
     PyObject *kencoded;
+    Py_ssize_t i;
+    PyObject *copyobj = NULL;
+    PyObject *mmapobj = NULL;
+    PyObject *mapped = NULL;
+    Py_ssize_t nkw = 0;
+    int copy = 1;
+    int map = 0;
     SDL_RWops *rw;
     Mix_Chunk *chunk = NULL;
     Uint8 *mem = NULL;
 
     ((pgSoundObject *)self)->chunk = NULL;
     ((pgSoundObject *)self)->mem = NULL;
+    ((pgSoundObject *)self)->view = NULL;
+    ((pgSoundObject *)self)->max_instances = 0;
 
     /* Similar to MIXER_INIT_CHECK(), but different return value. */
     if (!SDL_WasInit(SDL_INIT_AUDIO)) {
@@ -1802,11 +3196,27 @@ sound_init(PyObject *self, PyObject *arg, PyObject *kwarg)
     }
 
     /* Process arguments, returning cleaner error messages than
-       PyArg_ParseTupleAndKeywords would.
+       PyArg_ParseTupleAndKeywords would. The 'copy' and 'mmap' keywords
+       may accompany any of the other forms.
     */
+    if (kwarg != NULL) {
+        nkw = PyDict_Size(kwarg);
+        if ((copyobj = PyDict_GetItemString(kwarg, "copy")) != NULL) {
+            if ((copy = PyObject_IsTrue(copyobj)) == -1) {
+                return -1;
+            }
+            --nkw;
+        }
+        if ((mmapobj = PyDict_GetItemString(kwarg, "mmap")) != NULL) {
+            if ((map = PyObject_IsTrue(mmapobj)) == -1) {
+                return -1;
+            }
+            --nkw;
+        }
+    }
+
     if (arg != NULL && PyTuple_GET_SIZE(arg)) {
-        if ((kwarg != NULL && PyDict_Size(kwarg)) || /* conditional and */
-            PyTuple_GET_SIZE(arg) != 1) {
+        if (nkw || PyTuple_GET_SIZE(arg) != 1) {
             PyErr_SetString(PyExc_TypeError, arg_cnt_err_msg);
             return -1;
         }
@@ -1818,12 +3228,15 @@ sound_init(PyObject *self, PyObject *arg, PyObject *kwarg)
             obj = NULL;
         }
         else {
-            file = obj;
+            /* A lone buffer object other than bytes is raw samples, as it
+             * always was; only file= reads one as an encoded file. */
+            file = PyObject_CheckBuffer(obj) && !PyBytes_Check(obj) ? NULL
+                                                                   : obj;
             buffer = obj;
         }
     }
     else if (kwarg != NULL) {
-        if (PyDict_Size(kwarg) != 1) {
+        if (nkw != 1) {
             PyErr_SetString(PyExc_TypeError, arg_cnt_err_msg);
             return -1;
         }
@@ -1834,8 +3247,11 @@ sound_init(PyObject *self, PyObject *arg, PyObject *kwarg)
             if (keys == NULL) {
                 return -1;
             }
-            kencoded =
-                pg_EncodeString(PyList_GET_ITEM(keys, 0), NULL, NULL, NULL);
+            key = PyList_GET_ITEM(keys, 0);
+            for (i = 1; _sound_is_option(key); ++i) {
+                key = PyList_GET_ITEM(keys, i);
+            }
+            kencoded = pg_EncodeString(key, NULL, NULL, NULL);
             Py_DECREF(keys);
             if (kencoded == NULL) {
                 return -1;
@@ -1857,7 +3273,43 @@ sound_init(PyObject *self, PyObject *arg, PyObject *kwarg)
         return -1;
     }
 
-    if (file != NULL) {
+    if (!copy && array != NULL) {
+        PyErr_SetString(PyExc_ValueError,
+                        "copy=False is only supported with a buffer");
+        return -1;
+    }
+
+    if (map) {
+        if (file == NULL || obj != NULL) {
+            PyErr_SetString(PyExc_ValueError,
+                            "mmap=True requires a str or os.PathLike path");
+            return -1;
+        }
+        if (!(mapped = _sound_map_wav(file))) {
+            return -1;
+        }
+        if (mapped != Py_None) {
+            /* play straight from the mapped pages */
+            Py_buffer view;
+            int rcode = PyObject_GetBuffer(mapped, &view, PyBUF_SIMPLE);
+
+            Py_DECREF(mapped);
+            if (rcode) {
+                return -1;
+            }
+            if (_chunk_from_view(&view, &chunk,
+                                 &((pgSoundObject *)self)->view)) {
+                PyBuffer_Release(&view);
+                return -1;
+            }
+            file = NULL;
+        }
+        else {
+            Py_DECREF(mapped);
+        }
+    }
+
+    if (file != NULL && (copy || obj == NULL)) {
         rw = pgRWops_FromObject(file, NULL);
 
         if (rw == NULL) {
@@ -1895,6 +3347,13 @@ LOAD_BUFFER:
                 return -1;
             }
         }
+        else if (!copy) {
+            if (_chunk_from_view(&view, &chunk,
+                                 &((pgSoundObject *)self)->view)) {
+                PyBuffer_Release(&view);
+                return -1;
+            }
+        }
         else {
             rcode = _chunk_from_buf(view.buf, view.len, &chunk, &mem);
             PyBuffer_Release(&view);
@@ -1962,6 +3421,8 @@ static PyMethodDef _mixer_methods[] = {
     {"set_num_channels", set_num_channels, METH_VARARGS,
      DOC_MIXER_SETNUMCHANNELS},
     {"set_reserved", set_reserved, METH_VARARGS, DOC_MIXER_SETRESERVED},
+    {"set_cull_distance", set_cull_distance, METH_O,
+     DOC_MIXER_SETCULLDISTANCE},
 
     {"get_busy", (PyCFunction)get_busy, METH_NOARGS, DOC_MIXER_GETBUSY},
     {"find_channel", (PyCFunction)mixer_find_channel,
@@ -1972,6 +3433,14 @@ static PyMethodDef _mixer_methods[] = {
      DOC_MIXER_GETSOUNDFONT},
     {"fadeout", mixer_fadeout, METH_VARARGS, DOC_MIXER_FADEOUT},
     {"stop", (PyCFunction)mixer_stop, METH_NOARGS, DOC_MIXER_STOP},
+    {"set_dsp", (PyCFunction)mixer_set_dsp, METH_VARARGS | METH_KEYWORDS,
+     DOC_MIXER_SETDSP},
+    {"reset_dsp", (PyCFunction)mixer_reset_dsp, METH_NOARGS,
+     DOC_MIXER_RESETDSP},
+    {"set_output_callback", mixer_set_output_callback, METH_O,
+     DOC_MIXER_SETOUTPUTCALLBACK},
+    {"get_output_position", (PyCFunction)mixer_get_output_position,
+     METH_NOARGS, DOC_MIXER_GETOUTPUTPOSITION},
     {"pause", (PyCFunction)mixer_pause, METH_NOARGS, DOC_MIXER_PAUSE},
     {"unpause", (PyCFunction)mixer_unpause, METH_NOARGS, DOC_MIXER_UNPAUSE},
     {"get_sdl_mixer_version", (PyCFunction)mixer_get_sdl_mixer_version,
@@ -1992,6 +3461,8 @@ pgSound_New(Mix_Chunk *chunk)
     soundobj = (pgSoundObject *)pgSound_Type.tp_new(&pgSound_Type, NULL, NULL);
     if (soundobj) {
         soundobj->mem = NULL;
+        soundobj->view = NULL;
+        soundobj->max_instances = 0;
         soundobj->chunk = chunk;
     }
 
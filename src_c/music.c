@@ -33,8 +33,17 @@
 #include "mixer.h"
 
 static Mix_Music *current_music = NULL;
+static int current_music_loops = 0;
 static Mix_Music *queue_music = NULL;
 static int queue_music_loops = 0;
+static int queue_fade_ms = 0;
+/* The queued track is handed over on the audio thread, swapped for its
+ * preloaded copy on a loader thread and replaced from Python, so all three
+ * take queue_lock. queue_generation counts the replacements, letting a
+ * loader tell that the track it preloaded is no longer the queued one. */
+static SDL_SpinLock queue_lock = 0;
+static Uint32 queue_generation = 0;
+static int fading_ahead = 0;
 static int endmusic_event = SDL_NOEVENT;
 static Uint64 music_pos = 0;
 static Uint64 music_pos_time = -1;
@@ -42,6 +51,91 @@ static int music_frequency = 0;
 static Uint16 music_format = 0;
 static int music_channels = 0;
 
+/* Replaces the queued track, returning the old one for the caller to free
+ * once it is outside the lock. The generation of the new track is stored
+ * in *generation unless that is NULL. */
+static Mix_Music *
+_swap_queue_music(Mix_Music *music, int loops, int fade_ms,
+                  Uint32 *generation)
+{
+    Mix_Music *old;
+
+    SDL_AtomicLock(&queue_lock);
+    old = queue_music;
+    queue_music = music;
+    queue_music_loops = loops;
+    queue_fade_ms = fade_ms;
+    queue_generation++;
+    if (generation) {
+        *generation = queue_generation;
+    }
+    SDL_AtomicUnlock(&queue_lock);
+    return old;
+}
+
+static void
+_clear_queue_music(void)
+{
+    Mix_Music *old = _swap_queue_music(NULL, 0, 0, NULL);
+
+    if (old) {
+        Mix_FreeMusic(old);
+    }
+}
+
+typedef struct {
+    SDL_RWops *rw;
+    Mix_MusicType type;
+    Mix_Music *original;
+    Uint32 generation;
+} pgMusicPreload;
+
+static int SDLCALL
+_music_mem_close(SDL_RWops *rw)
+{
+    SDL_free(rw->hidden.mem.base);
+    SDL_FreeRW(rw);
+    return 0;
+}
+
+/* Reads a queued file into memory and opens it again from there, so that
+ * starting it needs no I/O on the audio thread. The copy takes the place
+ * of the file backed track, unless the queue changed in the meantime. */
+static int SDLCALL
+_music_preload(void *arg)
+{
+    pgMusicPreload *job = (pgMusicPreload *)arg;
+    Mix_Music *music = NULL;
+    SDL_RWops *mem = NULL;
+    size_t size;
+    void *data;
+
+    data = SDL_LoadFile_RW(job->rw, &size, 1);
+    if (data && size <= INT_MAX) {
+        mem = SDL_RWFromConstMem(data, (int)size);
+    }
+    if (mem) {
+        mem->close = _music_mem_close;
+        music = Mix_LoadMUSType_RW(mem, job->type, SDL_TRUE);
+    }
+    else {
+        SDL_free(data);
+    }
+
+    if (music) {
+        SDL_AtomicLock(&queue_lock);
+        if (queue_music == job->original &&
+            queue_generation == job->generation) {
+            queue_music = music;
+            music = job->original;
+        }
+        SDL_AtomicUnlock(&queue_lock);
+        Mix_FreeMusic(music);
+    }
+    free(job);
+    return 0;
+}
+
 static void
 mixmusic_callback(void *udata, Uint8 *stream, int len)
 {
@@ -49,24 +143,61 @@ mixmusic_callback(void *udata, Uint8 *stream, int len)
         music_pos += len;
         music_pos_time = PG_GetTicks();
     }
+
+#if SDL_MIXER_VERSION_ATLEAST(2, 6, 0)
+    /* Fade the last pass of the playing track out so that it ends right
+     * as the fade does, for the queued track to fade in after it. This
+     * runs once per audio buffer, which is as close as it gets. */
+    if (!fading_ahead && current_music_loops == 0 && Mix_PlayingMusic()) {
+        int fade_ms, ms;
+        double duration, remaining;
+
+        SDL_AtomicLock(&queue_lock);
+        fade_ms = queue_music ? queue_fade_ms : 0;
+        SDL_AtomicUnlock(&queue_lock);
+        if (fade_ms <= 0) {
+            return;
+        }
+        duration = Mix_MusicDuration(NULL);
+        remaining = duration - Mix_GetMusicPosition(NULL);
+        ms = (int)(remaining * 1000.0);
+        if (duration > 0.0 && ms > 0 && ms <= fade_ms) {
+            fading_ahead = 1;
+            Mix_FadeOutMusic(ms);
+        }
+    }
+#endif
 }
 
 static void
 endmusic_callback(void)
 {
+    Mix_Music *next;
+    int loops, fade_ms;
+
     if (endmusic_event && SDL_WasInit(SDL_INIT_VIDEO)) {
         pg_post_event(endmusic_event, NULL);
     }
 
-    if (queue_music) {
+    SDL_AtomicLock(&queue_lock);
+    next = queue_music;
+    loops = queue_music_loops;
+    fade_ms = queue_fade_ms;
+    queue_music = NULL;
+    queue_music_loops = 0;
+    queue_fade_ms = 0;
+    queue_generation++;
+    SDL_AtomicUnlock(&queue_lock);
+    fading_ahead = 0;
+
+    if (next) {
         if (current_music)
             Mix_FreeMusic(current_music);
-        current_music = queue_music;
-        queue_music = NULL;
+        current_music = next;
+        current_music_loops = loops;
         Mix_HookMusicFinished(endmusic_callback);
         music_pos = 0;
-        Mix_PlayMusic(current_music, queue_music_loops);
-        queue_music_loops = 0;
+        Mix_FadeInMusic(current_music, loops, fade_ms);
     }
     else {
         music_pos_time = -1;
@@ -97,6 +228,8 @@ music_play(PyObject *self, PyObject *args, PyObject *keywds)
     Mix_QuerySpec(&music_frequency, &music_format, &music_channels);
     music_pos = 0;
     music_pos_time = PG_GetTicks();
+    current_music_loops = loops;
+    fading_ahead = 0;
 
     volume = Mix_VolumeMusic(-1);
     val = Mix_FadeInMusicPos(current_music, loops, fade_ms, startpos);
@@ -133,11 +266,7 @@ music_fadeout(PyObject *self, PyObject *args)
 
     Py_BEGIN_ALLOW_THREADS;
     /* To prevent the queue_music from playing, free it before fading. */
-    if (queue_music) {
-        Mix_FreeMusic(queue_music);
-        queue_music = NULL;
-        queue_music_loops = 0;
-    }
+    _clear_queue_music();
 
     Mix_FadeOutMusic(_time);
 
@@ -152,11 +281,7 @@ music_stop(PyObject *self, PyObject *_null)
 
     Py_BEGIN_ALLOW_THREADS;
     /* To prevent the queue_music from playing, free it before stopping. */
-    if (queue_music) {
-        Mix_FreeMusic(queue_music);
-        queue_music = NULL;
-        queue_music_loops = 0;
-    }
+    _clear_queue_music();
 
     Mix_HaltMusic();
 
@@ -425,11 +550,7 @@ music_load(PyObject *self, PyObject *args, PyObject *keywds)
         Mix_FreeMusic(current_music);
         current_music = NULL;
     }
-    if (queue_music != NULL) {
-        Mix_FreeMusic(queue_music);
-        queue_music = NULL;
-        queue_music_loops = 0;
-    }
+    _clear_queue_music();
     Py_END_ALLOW_THREADS;
 
     current_music = new_music;
@@ -446,45 +567,89 @@ music_unload(PyObject *self, PyObject *_null)
         Mix_FreeMusic(current_music);
         current_music = NULL;
     }
-    if (queue_music) {
-        Mix_FreeMusic(queue_music);
-        queue_music = NULL;
-        queue_music_loops = 0;
-    }
+    _clear_queue_music();
     Py_END_ALLOW_THREADS;
 
     Py_RETURN_NONE;
 }
 
+/* Starts reading a queued file into memory on a thread of its own. Only
+ * files on disk are preloaded: Python file objects need the GIL to be
+ * read, and buffers are in memory already. Failing to start is harmless,
+ * the track then plays from the file as it always did. */
+static void
+_start_music_preload(PyObject *obj, char *namehint, Mix_Music *original,
+                     Uint32 generation)
+{
+    pgMusicPreload *job;
+    SDL_Thread *thread;
+    char *ext = NULL;
+    SDL_RWops *rw;
+
+    rw = pgRWops_FromObject(obj, &ext);
+    if (rw == NULL) {
+        PyErr_Clear();
+        return;
+    }
+    if (pgRWops_IsFileObject(rw) || rw->type == SDL_RWOPS_MEMORY ||
+        rw->type == SDL_RWOPS_MEMORY_RO) {
+        SDL_RWclose(rw);
+        free(ext);
+        return;
+    }
+    job = (pgMusicPreload *)malloc(sizeof(pgMusicPreload));
+    if (job == NULL) {
+        SDL_RWclose(rw);
+        free(ext);
+        return;
+    }
+    job->rw = rw;
+    job->type = _get_type_from_hint(namehint ? namehint : ext);
+    job->original = original;
+    job->generation = generation;
+    free(ext);
+
+    thread = SDL_CreateThread(_music_preload, "pg_music_preload", job);
+    if (thread == NULL) {
+        SDL_RWclose(rw);
+        free(job);
+        return;
+    }
+    SDL_DetachThread(thread);
+}
+
 static PyObject *
 music_queue(PyObject *self, PyObject *args, PyObject *keywds)
 {
     Mix_Music *local_queue_music = NULL;
+    Mix_Music *old;
+    Uint32 generation;
     PyObject *obj;
-    int loops = 0;
+    int loops = 0, fade_ms = 0;
     char *namehint = NULL;
-    static char *kwids[] = {"filename", "namehint", "loops", NULL};
+    static char *kwids[] = {"filename", "namehint", "loops", "fade_ms",
+                            NULL};
 
-    if (!PyArg_ParseTupleAndKeywords(args, keywds, "O|si", kwids, &obj,
-                                     &namehint, &loops))
+    if (!PyArg_ParseTupleAndKeywords(args, keywds, "O|sii", kwids, &obj,
+                                     &namehint, &loops, &fade_ms))
         return NULL;
 
     MIXER_INIT_CHECK();
 
-    queue_music_loops = loops;
-
     local_queue_music = _load_music(obj, namehint);
     if (local_queue_music == NULL)  // meaning it has an error to return
         return NULL;
 
     Py_BEGIN_ALLOW_THREADS;
     /* Free any existing queued music. */
-    if (queue_music != NULL) {
-        Mix_FreeMusic(queue_music);
+    old = _swap_queue_music(local_queue_music, loops, SDL_max(fade_ms, 0),
+                            &generation);
+    if (old != NULL) {
+        Mix_FreeMusic(old);
     }
     Py_END_ALLOW_THREADS;
 
-    queue_music = local_queue_music;
+    _start_music_preload(obj, namehint, local_queue_music, generation);
 
     Py_RETURN_NONE;
 }
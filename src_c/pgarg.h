@@ -0,0 +1,143 @@
+/* Argument parsing helpers for hot METH_FASTCALL | METH_KEYWORDS functions
+ * (internal). Include after pygame.h, the base module C API is used.
+ */
+#ifndef PGARG_INTERNAL_H
+#define PGARG_INTERNAL_H
+
+#include <limits.h>
+
+/* Most parameters a function parsed with pg_ParseFastcallArgs can take */
+#define PG_FASTCALL_MAX_ARGS 16
+
+/* Sorts the arguments of a METH_FASTCALL | METH_KEYWORDS call into one slot
+ * per name of the NULL terminated kwids, like PyArg_ParseTupleAndKeywords
+ * but without building an argument tuple and a keyword dict first.
+ * The first `required` names must be given. Slots of omitted optional
+ * arguments are left untouched, so they can hold the defaults.
+ * Returns 0 with a TypeError set when the arguments don't match. */
+static PG_INLINE int
+pg_ParseFastcallArgs(const char *fname, PyObject *const *args,
+                     Py_ssize_t nargs, PyObject *kwnames, char *const *kwids,
+                     Py_ssize_t required, PyObject **parsed)
+{
+    PyObject *given[PG_FASTCALL_MAX_ARGS] = {NULL};
+    Py_ssize_t i, j, nids = 0;
+    Py_ssize_t nkw = kwnames ? PyTuple_GET_SIZE(kwnames) : 0;
+
+    while (kwids[nids]) {
+        nids++;
+    }
+    assert(nids <= PG_FASTCALL_MAX_ARGS);
+
+    if (nargs > nids) {
+        PyErr_Format(PyExc_TypeError,
+                     "%s() takes at most %zd arguments (%zd given)", fname,
+                     nids, nargs + nkw);
+        return 0;
+    }
+    for (i = 0; i < nargs; i++) {
+        given[i] = args[i];
+    }
+
+    for (i = 0; i < nkw; i++) {
+        PyObject *key = PyTuple_GET_ITEM(kwnames, i);
+        for (j = 0; j < nids; j++) {
+            if (PyUnicode_CompareWithASCIIString(key, kwids[j]) == 0) {
+                break;
+            }
+        }
+        if (j == nids) {
+            PyErr_Format(PyExc_TypeError,
+                         "'%U' is an invalid keyword argument for %s()", key,
+                         fname);
+            return 0;
+        }
+        if (given[j]) {
+            PyErr_Format(PyExc_TypeError,
+                         "argument for %s() given by name ('%s') and "
+                         "position (%zd)",
+                         fname, kwids[j], j + 1);
+            return 0;
+        }
+        given[j] = args[nargs + i];
+    }
+
+    for (i = 0; i < nids; i++) {
+        if (given[i]) {
+            parsed[i] = given[i];
+        }
+        else if (i < required) {
+            PyErr_Format(PyExc_TypeError,
+                         "%s() missing required argument '%s' (pos %zd)",
+                         fname, kwids[i], i + 1);
+            return 0;
+        }
+    }
+    return 1;
+}
+
+/* Converts an argument the way the "i" format of PyArg_ParseTuple does.
+ * Returns 0 with an exception set on failure. */
+static PG_INLINE int
+pg_IntFromFastcallArg(PyObject *obj, int *val)
+{
+    long tmp;
+
+    if (PyFloat_Check(obj)) {
+        PyErr_SetString(PyExc_TypeError,
+                        "'float' object cannot be interpreted as an integer");
+        return 0;
+    }
+    tmp = PyLong_AsLong(obj);
+    if (tmp == -1 && PyErr_Occurred()) {
+        return 0;
+    }
+    if (tmp > INT_MAX) {
+        PyErr_SetString(PyExc_OverflowError,
+                        "signed integer is greater than maximum");
+        return 0;
+    }
+    if (tmp < INT_MIN) {
+        PyErr_SetString(PyExc_OverflowError,
+                        "signed integer is less than minimum");
+        return 0;
+    }
+    *val = (int)tmp;
+    return 1;
+}
+
+/* pg_TwoIntsFromObj, with exact type checks first for the tuples, lists
+ * and Vector2s that positions are nearly always given as. */
+static PG_INLINE int
+pg_TwoIntsFromFastObj(PyObject *obj, int *val1, int *val2)
+{
+    if ((PyTuple_CheckExact(obj) || PyList_CheckExact(obj)) &&
+        PySequence_Fast_GET_SIZE(obj) == 2) {
+        PyObject **items = PySequence_Fast_ITEMS(obj);
+        if (PyLong_CheckExact(items[0]) && PyLong_CheckExact(items[1])) {
+            long x, y;
+            if ((x = PyLong_AsLong(items[0])) == -1 && PyErr_Occurred()) {
+                PyErr_Clear();
+                return 0;
+            }
+            if ((y = PyLong_AsLong(items[1])) == -1 && PyErr_Occurred()) {
+                PyErr_Clear();
+                return 0;
+            }
+            *val1 = (int)x;
+            *val2 = (int)y;
+            return 1;
+        }
+    }
+#ifndef NO_PYGAME_C_API
+    /* the math API is only there in modules that imported it */
+    else if (_PGSLOTS_math && pgVector2_Check(obj)) {
+        *val1 = (int)((pgVector *)obj)->coords[0];
+        *val2 = (int)((pgVector *)obj)->coords[1];
+        return 1;
+    }
+#endif
+    return pg_TwoIntsFromObj(obj, val1, val2);
+}
+
+#endif /* ~PGARG_INTERNAL_H */
@@ -1083,16 +1083,23 @@ _array_assign_sequence(pgPixelArrayObject *array, Py_ssize_t low,
     Py_ssize_t stride1 = array->strides[1];
     Uint8 *pixels = array->pixels + low * array->strides[0];
     int bpp;
-    Py_ssize_t val_dim0 = PySequence_Size(val);
+    Py_ssize_t val_dim0;
     Uint32 *val_colors;
     Uint8 *pixelrow;
     Uint8 *pixel_p;
     Uint32 *val_color_p;
     Py_ssize_t x;
     Py_ssize_t y;
-    PyObject *item;
+    PyObject *fast;
+    PyObject **items;
 
+    fast = PySequence_Fast(val, "expected a sequence");
+    if (!fast) {
+        return -1;
+    }
+    val_dim0 = PySequence_Fast_GET_SIZE(fast);
     if (val_dim0 != dim0) {
+        Py_DECREF(fast);
         PyErr_SetString(PyExc_ValueError, "sequence size mismatch");
         return -1;
     }
@@ -1105,20 +1112,21 @@ _array_assign_sequence(pgPixelArrayObject *array, Py_ssize_t low,
     }
 
     /* Copy the values. */
-    val_colors = malloc(sizeof(Uint32) * val_dim0);
+    val_colors = malloc(sizeof(Uint32) * (val_dim0 ? val_dim0 : 1));
     if (!val_colors) {
+        Py_DECREF(fast);
         PyErr_NoMemory();
         return -1;
     }
+    items = PySequence_Fast_ITEMS(fast);
     for (x = 0; x < val_dim0; ++x) {
-        item = PySequence_ITEM(val, x);
-        if (!_get_color_from_object(item, format, (val_colors + x))) {
-            Py_DECREF(item);
+        if (!_get_color_from_object(items[x], format, (val_colors + x))) {
+            Py_DECREF(fast);
             free(val_colors);
             return -1;
         }
-        Py_DECREF(item);
     }
+    Py_DECREF(fast);
 
     pixelrow = pixels;
 
@@ -1173,6 +1181,11 @@ _array_assign_sequence(pgPixelArrayObject *array, Py_ssize_t low,
         } break;
         default: /* case 4: */
             for (y = 0; y < dim1; ++y) {
+                if (stride0 == 4) {
+                    memcpy(pixelrow, val_colors, dim0 * 4);
+                    pixelrow += stride1;
+                    continue;
+                }
                 pixel_p = pixelrow;
                 val_color_p = val_colors;
                 for (x = 0; x < dim0; ++x) {
@@ -1438,6 +1451,33 @@ _pxarray_ass_slice(pgPixelArrayObject *array, Py_ssize_t low, Py_ssize_t high,
     return 0;
 }
 
+/* Searches a contiguous row of 4 byte pixels in blocks, the compares of a
+ * block have no early exit so compilers can vectorize them.
+ */
+static int
+_row_contains_32(const Uint32 *row, Py_ssize_t n, Uint32 color)
+{
+    Py_ssize_t x = 0;
+    Py_ssize_t i;
+    int hit;
+
+    for (; x + 16 <= n; x += 16) {
+        hit = 0;
+        for (i = 0; i < 16; ++i) {
+            hit |= row[x + i] == color;
+        }
+        if (hit) {
+            return 1;
+        }
+    }
+    for (; x < n; ++x) {
+        if (row[x] == color) {
+            return 1;
+        }
+    }
+    return 0;
+}
+
 /**
  * x in array
  */
@@ -1513,6 +1553,11 @@ _pxarray_contains(pgPixelArrayObject *array, PyObject *value)
             break;
         default: /* case 4: */
             for (y = 0; !found && y < dim1; ++y) {
+                if (stride0 == 4) {
+                    found = _row_contains_32((Uint32 *)pixelrow, dim0, color);
+                    pixelrow += stride1;
+                    continue;
+                }
                 pixel_p = pixelrow;
                 for (x = 0; !found && x < dim0; ++x) {
                     found = *((Uint32 *)pixel_p) == color ? 1 : 0;
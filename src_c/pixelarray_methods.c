@@ -47,6 +47,106 @@ _get_color_from_object(PyObject *val, SDL_PixelFormat *format, Uint32 *color)
         PG_COLOR_HANDLE_INT | PG_COLOR_HANDLE_RESTRICT_SEQ);
 }
 
+/* The exact match loops for 4 byte pixels, used when distance is 0. When
+ * stride0 is 4 the rows are contiguous and the loops have no branches, so
+ * compilers can turn them into SIMD compares and blends.
+ */
+static void
+_replace_color_32(Uint8 *pixelrow, Py_ssize_t dim0, Py_ssize_t dim1,
+                  Py_ssize_t stride0, Py_ssize_t stride1, Uint32 dcolor,
+                  Uint32 rcolor)
+{
+    Uint32 *row;
+    Uint8 *pixel_p;
+    Py_ssize_t x;
+    Py_ssize_t y;
+
+    for (y = 0; y < dim1; ++y) {
+        if (stride0 == 4) {
+            row = (Uint32 *)pixelrow;
+            for (x = 0; x < dim0; ++x) {
+                row[x] = row[x] == dcolor ? rcolor : row[x];
+            }
+        }
+        else {
+            pixel_p = pixelrow;
+            for (x = 0; x < dim0; ++x) {
+                if (*(Uint32 *)pixel_p == dcolor) {
+                    *(Uint32 *)pixel_p = rcolor;
+                }
+                pixel_p += stride0;
+            }
+        }
+        pixelrow += stride1;
+    }
+}
+
+static void
+_extract_color_32(Uint8 *pixelrow, Py_ssize_t dim0, Py_ssize_t dim1,
+                  Py_ssize_t stride0, Py_ssize_t stride1, Uint32 color,
+                  Uint32 white, Uint32 black)
+{
+    Uint32 *row;
+    Uint8 *pixel_p;
+    Py_ssize_t x;
+    Py_ssize_t y;
+
+    for (y = 0; y < dim1; ++y) {
+        if (stride0 == 4) {
+            row = (Uint32 *)pixelrow;
+            for (x = 0; x < dim0; ++x) {
+                row[x] = row[x] == color ? white : black;
+            }
+        }
+        else {
+            pixel_p = pixelrow;
+            for (x = 0; x < dim0; ++x) {
+                *(Uint32 *)pixel_p =
+                    *(Uint32 *)pixel_p == color ? white : black;
+                pixel_p += stride0;
+            }
+        }
+        pixelrow += stride1;
+    }
+}
+
+static void
+_compare_32(Uint8 *row_p, Uint8 *other_row_p, Py_ssize_t dim0,
+            Py_ssize_t dim1, Py_ssize_t stride0, Py_ssize_t stride1,
+            Py_ssize_t other_stride0, Py_ssize_t other_stride1, Uint32 white,
+            Uint32 black)
+{
+    Uint32 *row;
+    Uint32 *other_row;
+    Uint8 *byte_p;
+    Uint8 *other_byte_p;
+    Py_ssize_t x;
+    Py_ssize_t y;
+
+    for (y = 0; y < dim1; ++y) {
+        if (stride0 == 4 && other_stride0 == 4) {
+            row = (Uint32 *)row_p;
+            other_row = (Uint32 *)other_row_p;
+            for (x = 0; x < dim0; ++x) {
+                row[x] = row[x] == other_row[x] ? white : black;
+            }
+        }
+        else {
+            byte_p = row_p;
+            other_byte_p = other_row_p;
+            for (x = 0; x < dim0; ++x) {
+                *(Uint32 *)byte_p =
+                    *(Uint32 *)byte_p == *(Uint32 *)other_byte_p ? white
+                                                                 : black;
+                byte_p += stride0;
+                other_byte_p += other_stride0;
+            }
+        }
+        row_p += stride1;
+        other_row_p += other_stride1;
+    }
+}
+
 /**
  * Retrieves a single pixel located at index from the surface pixel
  * array.
@@ -92,6 +192,66 @@ _get_single_pixel(pgPixelArrayObject *array, Py_ssize_t x, Py_ssize_t y)
     return PyLong_FromLong((long)pixel);
 }
 
+/* The side of the blocks _copy_transposed() copies, in pixels */
+#define PXARRAY_TILE 32
+
+#define _COPY_TRANSPOSED_TILE(type)                                  \
+    for (x = x0; x < x1; ++x) {                                     \
+        const type *src = (const type *)(pixels + x * stride0 +     \
+                                         y0 * stride1);             \
+        Uint8 *dst = new_pixels + y0 * new_stride1 + x * bpp;       \
+        for (y = y0; y < y1; ++y) {                                 \
+            *(type *)dst = *src++;                                  \
+            dst += new_stride1;                                     \
+        }                                                           \
+    }
+
+/* Copies an array whose pixels are contiguous along its second axis, like
+ * the transpose of a surface, to new_pixels in blocks. The reads go along
+ * the source rows and the writes of a block stay within a few cache lines
+ * of each destination row, instead of one of the two walking a column
+ * across the whole image for every pixel.
+ */
+static void
+_copy_transposed(Uint8 *pixels, Py_ssize_t dim0, Py_ssize_t dim1,
+                 Py_ssize_t stride0, Py_ssize_t stride1, Uint8 *new_pixels,
+                 Py_ssize_t new_stride1, int bpp)
+{
+    Py_ssize_t x0, y0, x1, y1, x, y;
+
+    for (y0 = 0; y0 < dim1; y0 += PXARRAY_TILE) {
+        y1 = MIN(y0 + PXARRAY_TILE, dim1);
+        for (x0 = 0; x0 < dim0; x0 += PXARRAY_TILE) {
+            x1 = MIN(x0 + PXARRAY_TILE, dim0);
+            switch (bpp) {
+                case 1:
+                    _COPY_TRANSPOSED_TILE(Uint8);
+                    break;
+                case 2:
+                    _COPY_TRANSPOSED_TILE(Uint16);
+                    break;
+                case 3:
+                    for (x = x0; x < x1; ++x) {
+                        const Uint8 *src =
+                            pixels + x * stride0 + y0 * stride1;
+                        Uint8 *dst = new_pixels + y0 * new_stride1 + x * 3;
+                        for (y = y0; y < y1; ++y) {
+                            memcpy(dst, src, 3);
+                            src += 3;
+                            dst += new_stride1;
+                        }
+                    }
+                    break;
+                default: /* case: 4 */
+                    _COPY_TRANSPOSED_TILE(Uint32);
+                    break;
+            }
+        }
+    }
+}
+
+#undef _COPY_TRANSPOSED_TILE
+
 /**
  * Creates a new surface using the currently applied dimensions, step
  * size, etc.
@@ -126,10 +286,14 @@ _make_surface(pgPixelArrayObject *array, PyObject *args)
     surf = pgSurface_AsSurface(array->surface);
     bpp = PG_SURF_BytesPerPixel(surf);
     temp_surf = surf;
-    const int same_dims = (dim0 == surf->w && dim1 == surf->h);
-
-    /* If the array dimensions are different from the surface dimensions,
-     * create a new surface with the array dimensions */
+    /* The array is the whole surface as it is, not a flipped or transposed
+     * view of the same size */
+    const int same_dims = (dim0 == surf->w && dim1 == surf->h &&
+                           pixels == (Uint8 *)surf->pixels &&
+                           stride0 == bpp && stride1 == surf->pitch);
+
+    /* If the array is not the whole surface, create a new surface with the
+     * array dimensions */
     if (!same_dims) {
         if (!(temp_surf = PG_CreateSurface((int)dim0, (int)dim1,
                                            surf->format->format)))
@@ -168,7 +332,12 @@ _make_surface(pgPixelArrayObject *array, PyObject *args)
 
     Py_BEGIN_ALLOW_THREADS;
 
-    if (stride0 == new_stride0) {
+    if (stride0 == new_stride0 && stride1 == new_stride1 &&
+        stride1 == stride0 * dim0) {
+        /* both are gapless, so the pixels are copied in one go */
+        memcpy(new_pixelrow, pixelrow, stride1 * dim1);
+    }
+    else if (stride0 == new_stride0) {
         /* if src and dest have the same bpp, so we can copy the whole
          * rows at once */
         y = dim1;
@@ -178,6 +347,10 @@ _make_surface(pgPixelArrayObject *array, PyObject *args)
             new_pixelrow += new_stride1;
         }
     }
+    else if (stride1 == bpp && dim1 > 1) {
+        _copy_transposed(pixels, dim0, dim1, stride0, stride1, new_pixels,
+                         new_stride1, bpp);
+    }
     else {
         switch (bpp) {
             case 1:
@@ -488,18 +661,18 @@ _replace_color(pgPixelArrayObject *array, PyObject *args, PyObject *kwds)
             int ppa = (SDL_ISPIXELFORMAT_ALPHA(format->format) &&
                        surf->format->Amask);
 
+            if (distance == 0.0) {
+                _replace_color_32(pixelrow, dim0, dim1, stride0, stride1,
+                                  dcolor, rcolor);
+                break;
+            }
             for (y = 0; y < dim1; ++y) {
                 pixel_p = pixelrow;
                 for (x = 0; x < dim0; ++x) {
                     px_p = (Uint32 *)pixel_p;
-                    if (distance != 0.0) {
-                        GET_PIXELVALS(r2, g2, b2, a2, *px_p, format, ppa);
-                        if (COLOR_DIFF_RGB(wr, wg, wb, r1, g1, b1, r2, g2,
-                                           b2) <= distance) {
-                            *px_p = rcolor;
-                        }
-                    }
-                    else if (*px_p == dcolor) {
+                    GET_PIXELVALS(r2, g2, b2, a2, *px_p, format, ppa);
+                    if (COLOR_DIFF_RGB(wr, wg, wb, r1, g1, b1, r2, g2, b2) <=
+                        distance) {
                         *px_p = rcolor;
                     }
                     pixel_p += stride0;
@@ -712,22 +885,22 @@ _extract_color(pgPixelArrayObject *array, PyObject *args, PyObject *kwds)
             int ppa =
                 (SDL_ISPIXELFORMAT_ALPHA(format->format) && format->Amask);
 
+            if (distance == 0.0) {
+                _extract_color_32(pixelrow, dim0, dim1, stride0, stride1,
+                                  color, white, black);
+                break;
+            }
             for (y = 0; y < dim1; ++y) {
                 pixel_p = pixelrow;
                 for (x = 0; x < dim0; ++x) {
                     px_p = (Uint32 *)pixel_p;
-                    if (distance != 0.0) {
-                        GET_PIXELVALS(r2, g2, b2, a2, *px_p, format, ppa);
-                        if (COLOR_DIFF_RGB(wr, wg, wb, r1, g1, b1, r2, g2,
-                                           b2) <= distance) {
-                            *px_p = white;
-                        }
-                        else {
-                            *px_p = black;
-                        }
+                    GET_PIXELVALS(r2, g2, b2, a2, *px_p, format, ppa);
+                    if (COLOR_DIFF_RGB(wr, wg, wb, r1, g1, b1, r2, g2, b2) <=
+                        distance) {
+                        *px_p = white;
                     }
                     else {
-                        *px_p = *px_p == color ? white : black;
+                        *px_p = black;
                     }
                     pixel_p += stride0;
                 }
@@ -989,26 +1162,26 @@ _compare(pgPixelArrayObject *array, PyObject *args, PyObject *kwds)
             int other_ppa = (SDL_ISPIXELFORMAT_ALPHA(other_format->format) &&
                              other_format->Amask);
 
+            if (distance == 0.0) {
+                _compare_32(row_p, other_row_p, dim0, dim1, stride0, stride1,
+                            other_stride0, other_stride1, white, black);
+                break;
+            }
             for (y = 0; y < dim1; ++y) {
                 byte_p = row_p;
                 other_byte_p = other_row_p;
                 for (x = 0; x < dim0; ++x) {
                     pixel_p = (Uint32 *)byte_p;
                     other_pixel_p = (Uint32 *)other_byte_p;
-                    if (distance != 0.0) {
-                        GET_PIXELVALS(r1, g1, b1, a1, *pixel_p, format, ppa);
-                        GET_PIXELVALS(r2, g2, b2, a2, *other_pixel_p,
-                                      other_format, other_ppa);
-                        if (COLOR_DIFF_RGB(wr, wg, wb, r1, g1, b1, r2, g2,
-                                           b2) <= distance) {
-                            *pixel_p = white;
-                        }
-                        else {
-                            *pixel_p = black;
-                        }
+                    GET_PIXELVALS(r1, g1, b1, a1, *pixel_p, format, ppa);
+                    GET_PIXELVALS(r2, g2, b2, a2, *other_pixel_p, other_format,
+                                  other_ppa);
+                    if (COLOR_DIFF_RGB(wr, wg, wb, r1, g1, b1, r2, g2, b2) <=
+                        distance) {
+                        *pixel_p = white;
                     }
                     else {
-                        *pixel_p = *pixel_p == *other_pixel_p ? white : black;
+                        *pixel_p = black;
                     }
                     byte_p += stride0;
                     other_byte_p += other_stride0;
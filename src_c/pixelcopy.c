@@ -188,6 +188,20 @@ typedef union {
     Uint8 bytes[sizeof(Uint32)];
 } _pc_pixel_t;
 
+/* The 32 bit fast paths go through the pixels in bands of this many surface
+ * rows, so the rows of a band stay in cache whichever of the two array axes
+ * is the contiguous one.
+ */
+#define PXC_BAND_ROWS 16
+
+/* The shift of an 8 bit channel of a 32 bit pixel, or -1 if the channel is
+ * missing or not 8 bits wide. */
+static int
+_pc_channel_shift(Uint32 mask, Uint8 shift, Uint8 loss)
+{
+    return mask && !loss && (mask >> shift) == 0xFF ? shift : -1;
+}
+
 static int
 _copy_mapped(Py_buffer *view_p, SDL_Surface *surf)
 {
@@ -225,6 +239,26 @@ _copy_mapped(Py_buffer *view_p, SDL_Surface *surf)
                      pixelsize, intsize);
         return -1;
     }
+    if (pixelsize == 4 && intsize == 4 && !_is_swapped(view_p)) {
+        /* Native order 32 bit items, copy whole pixels */
+        Py_intptr_t y_end;
+        Uint32 pixel;
+
+        src = (char *)surf->pixels;
+        Py_BEGIN_ALLOW_THREADS;
+        for (y_end = 0; y_end < h;) {
+            y = y_end;
+            y_end = SDL_min(y + PXC_BAND_ROWS, h);
+            for (x = 0; x < w; ++x) {
+                for (z = y; z < y_end; ++z) {
+                    memcpy(&pixel, src + dx_src * x + dy_src * z, 4);
+                    memcpy(dst + dx_dst * x + dy_dst * z, &pixel, 4);
+                }
+            }
+        }
+        Py_END_ALLOW_THREADS;
+        return 0;
+    }
 #if SDL_BYTEORDER == SDL_LIL_ENDIAN
     if (_is_swapped(view_p)) {
         dst += intsize - 1;
@@ -236,6 +270,7 @@ _copy_mapped(Py_buffer *view_p, SDL_Surface *surf)
         dz_dst = -1;
     }
 #endif
+    Py_BEGIN_ALLOW_THREADS;
     for (x = 0; x < w; ++x) {
         for (y = 0; y < h; ++y) {
             for (z = 0; z < pixelsize; ++z) {
@@ -248,6 +283,7 @@ _copy_mapped(Py_buffer *view_p, SDL_Surface *surf)
             }
         }
     }
+    Py_END_ALLOW_THREADS;
 
     return 0;
 }
@@ -275,6 +311,7 @@ _copy_colorplane(Py_buffer *view_p, SDL_Surface *surf,
     Uint8 *element = 0;
     _pc_pixel_t pixel = {0};
     Uint32 colorkey;
+    int shift = -1;
 
     if (view_p->shape[0] != w || view_p->shape[1] != h) {
         PyErr_Format(PyExc_ValueError,
@@ -322,8 +359,47 @@ _copy_colorplane(Py_buffer *view_p, SDL_Surface *surf,
         dz_dst = -1;
     }
 #endif
-    if (view_kind == VIEWKIND_COLORKEY && SDL_HasColorKey(surf)) {
+    if (view_kind != VIEWKIND_COLORKEY && pixelsize == 4 && intsize == 1 &&
+        (view_kind != PXC_VIEWKIND_ALPHA || mode != SDL_BLENDMODE_NONE)) {
+        switch (view_kind) {
+            case PXC_VIEWKIND_RED:
+                shift = _pc_channel_shift(format->Rmask, format->Rshift,
+                                          format->Rloss);
+                break;
+            case PXC_VIEWKIND_GREEN:
+                shift = _pc_channel_shift(format->Gmask, format->Gshift,
+                                          format->Gloss);
+                break;
+            case PXC_VIEWKIND_BLUE:
+                shift = _pc_channel_shift(format->Bmask, format->Bshift,
+                                          format->Bloss);
+                break;
+            default:
+                shift = _pc_channel_shift(format->Amask, format->Ashift,
+                                          format->Aloss);
+        }
+    }
+    if (shift >= 0) {
+        /* An 8 bit channel of 32 bit pixels into a byte array */
+        Py_intptr_t y_end;
+        Uint32 value;
+
+        Py_BEGIN_ALLOW_THREADS;
+        for (y_end = 0; y_end < h;) {
+            y = y_end;
+            y_end = SDL_min(y + PXC_BAND_ROWS, h);
+            for (x = 0; x < w; ++x) {
+                for (z = y; z < y_end; ++z) {
+                    memcpy(&value, src + dx_src * x + dy_src * z, 4);
+                    dst[dx_dst * x + dy_dst * z] = (char)(value >> shift);
+                }
+            }
+        }
+        Py_END_ALLOW_THREADS;
+    }
+    else if (view_kind == VIEWKIND_COLORKEY && SDL_HasColorKey(surf)) {
         SDL_GetColorKey(surf, &colorkey);
+        Py_BEGIN_ALLOW_THREADS;
         for (x = 0; x < w; ++x) {
             for (y = 0; y < h; ++y) {
                 for (z = 0; z < pixelsize; ++z) {
@@ -336,9 +412,11 @@ _copy_colorplane(Py_buffer *view_p, SDL_Surface *surf,
                 }
             }
         }
+        Py_END_ALLOW_THREADS;
     }
     else if ((view_kind != VIEWKIND_COLORKEY) &&
              (view_kind != PXC_VIEWKIND_ALPHA || mode != SDL_BLENDMODE_NONE)) {
+        Py_BEGIN_ALLOW_THREADS;
         for (x = 0; x < w; ++x) {
             for (y = 0; y < h; ++y) {
                 for (z = 0; z < pixelsize; ++z) {
@@ -351,8 +429,10 @@ _copy_colorplane(Py_buffer *view_p, SDL_Surface *surf,
                 }
             }
         }
+        Py_END_ALLOW_THREADS;
     }
     else {
+        Py_BEGIN_ALLOW_THREADS;
         for (x = 0; x < w; ++x) {
             for (y = 0; y < h; ++y) {
                 dst[dx_dst * x + dy_dst * y] = opaque;
@@ -361,6 +441,7 @@ _copy_colorplane(Py_buffer *view_p, SDL_Surface *surf,
                 }
             }
         }
+        Py_END_ALLOW_THREADS;
     }
 
     return 0;
@@ -386,6 +467,7 @@ _copy_unmapped(Py_buffer *view_p, SDL_Surface *surf)
     Py_intptr_t x, y, z;
     _pc_pixel_t pixel = {0};
     Uint8 r, g, b;
+    int rshift, gshift, bshift;
 
     if (view_p->shape[0] != w || view_p->shape[1] != h ||
         view_p->shape[2] != 3) {
@@ -414,6 +496,34 @@ _copy_unmapped(Py_buffer *view_p, SDL_Surface *surf)
         dz_dst = -1;
     }
 #endif
+    rshift = _pc_channel_shift(format->Rmask, format->Rshift, format->Rloss);
+    gshift = _pc_channel_shift(format->Gmask, format->Gshift, format->Gloss);
+    bshift = _pc_channel_shift(format->Bmask, format->Bshift, format->Bloss);
+    if (pixelsize == 4 && intsize == 1 && rshift >= 0 && gshift >= 0 &&
+        bshift >= 0) {
+        /* 8 bit channels of 32 bit pixels into a byte array */
+        Py_intptr_t y_end;
+        Uint32 value;
+        char *p;
+
+        Py_BEGIN_ALLOW_THREADS;
+        for (y_end = 0; y_end < h;) {
+            y = y_end;
+            y_end = SDL_min(y + PXC_BAND_ROWS, h);
+            for (x = 0; x < w; ++x) {
+                for (z = y; z < y_end; ++z) {
+                    memcpy(&value, src + dx_src * x + dy_src * z, 4);
+                    p = dst + dx_dst * x + dy_dst * z;
+                    p[0] = (char)(value >> rshift);
+                    p[dp_dst] = (char)(value >> gshift);
+                    p[2 * dp_dst] = (char)(value >> bshift);
+                }
+            }
+        }
+        Py_END_ALLOW_THREADS;
+        return 0;
+    }
+    Py_BEGIN_ALLOW_THREADS;
     for (x = 0; x < w; ++x) {
         for (y = 0; y < h; ++y) {
             for (z = 0; z < pixelsize; ++z) {
@@ -434,20 +544,24 @@ _copy_unmapped(Py_buffer *view_p, SDL_Surface *surf)
             }
         }
     }
+    Py_END_ALLOW_THREADS;
 
     return 0;
 }
 
 /*macros used to blit arrays*/
 #define COPYMACRO_2D(DST, SRC)                                               \
+    Py_BEGIN_ALLOW_THREADS;                                                  \
     for (loopy = 0; loopy < sizey; ++loopy) {                                \
         DST *imgrow = (DST *)(((char *)surf->pixels) + loopy * surf->pitch); \
         Uint8 *datarow = (Uint8 *)array_data + stridey * loopy;              \
         for (loopx = 0; loopx < sizex; ++loopx)                              \
             *(imgrow + loopx) = (DST) * (SRC *)(datarow + stridex * loopx);  \
-    }
+    }                                                                        \
+    Py_END_ALLOW_THREADS
 
 #define COPYMACRO_3D(DST, SRC)                                              \
+    Py_BEGIN_ALLOW_THREADS;                                                 \
     for (loopy = 0; loopy < sizey; ++loopy) {                               \
         DST *pix = (DST *)(((char *)surf->pixels) + surf->pitch * loopy);   \
         char *data = array_data + stridey * loopy;                          \
@@ -458,7 +572,8 @@ _copy_unmapped(Py_buffer *view_p, SDL_Surface *surf)
                            alpha);                                          \
             data += stridex;                                                \
         }                                                                   \
-    }
+    }                                                                       \
+    Py_END_ALLOW_THREADS
 
 static PyObject *
 array_to_surface(PyObject *self, PyObject *arg)
@@ -671,6 +786,7 @@ array_to_surface(PyObject *self, PyObject *arg)
                          offset);
                 }
 #endif
+                Py_BEGIN_ALLOW_THREADS;
                 for (loopy = 0; loopy < sizey; ++loopy) {
                     Uint8 *pix = ((Uint8 *)surf->pixels) + surf->pitch * loopy;
                     Uint8 *data = (Uint8 *)array_data + stridey * loopy;
@@ -682,6 +798,7 @@ array_to_surface(PyObject *self, PyObject *arg)
                         data += stridex;
                     }
                 }
+                Py_END_ALLOW_THREADS;
             }
             else {
                 pgBuffer_Release(&pg_view);
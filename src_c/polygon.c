@@ -0,0 +1,333 @@
+#include "doc/geometry_doc.h"
+#include "geometry_common.h"
+
+/* Reads a sequence of at least 3 points into a newly allocated array of
+ * coordinates. Returns NULL with an exception set on failure. */
+static double *
+_pg_polygon_vertices_from_obj(PyObject *obj, Py_ssize_t *verts_num)
+{
+    PyObject *seq, **items;
+    Py_ssize_t i, n;
+    double *vertices;
+
+    if (pgPolygon_Check(obj)) {
+        n = pgPolygon_CAST(obj)->verts_num;
+        if (!(vertices = PyMem_New(double, 2 * n))) {
+            PyErr_NoMemory();
+            return NULL;
+        }
+        memcpy(vertices, pgPolygon_CAST(obj)->vertices,
+               2 * n * sizeof(double));
+        *verts_num = n;
+        return vertices;
+    }
+
+    seq = PySequence_Fast(obj, "Expected a sequence of points");
+    if (!seq) {
+        return NULL;
+    }
+    items = PySequence_Fast_ITEMS(seq);
+    n = PySequence_Fast_GET_SIZE(seq);
+    if (n < 3) {
+        Py_DECREF(seq);
+        PyErr_SetString(PyExc_ValueError,
+                        "A Polygon needs at least 3 vertices");
+        return NULL;
+    }
+
+    if (!(vertices = PyMem_New(double, 2 * n))) {
+        Py_DECREF(seq);
+        PyErr_NoMemory();
+        return NULL;
+    }
+    for (i = 0; i < n; i++) {
+        if (!pg_TwoDoublesFromObj(items[i], &vertices[2 * i],
+                                  &vertices[2 * i + 1])) {
+            PyErr_Format(PyExc_TypeError,
+                         "Invalid vertex at index %zd, must be a sequence of "
+                         "two numbers",
+                         i);
+            PyMem_Free(vertices);
+            Py_DECREF(seq);
+            return NULL;
+        }
+    }
+    Py_DECREF(seq);
+    *verts_num = n;
+    return vertices;
+}
+
+static PyObject *
+_pg_polygon_subtype_new(PyTypeObject *type, const double *vertices,
+                        Py_ssize_t verts_num)
+{
+    pgPolygonObject *polygon_obj =
+        (pgPolygonObject *)pgPolygon_Type.tp_new(type, NULL, NULL);
+
+    if (!polygon_obj) {
+        return NULL;
+    }
+    if (!(polygon_obj->vertices = PyMem_New(double, 2 * verts_num))) {
+        Py_DECREF(polygon_obj);
+        return PyErr_NoMemory();
+    }
+    memcpy(polygon_obj->vertices, vertices, 2 * verts_num * sizeof(double));
+    polygon_obj->verts_num = verts_num;
+    return (PyObject *)polygon_obj;
+}
+
+static PyObject *
+pg_polygon_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
+{
+    pgPolygonObject *self = (pgPolygonObject *)type->tp_alloc(type, 0);
+
+    if (self) {
+        self->verts_num = 0;
+        self->vertices = NULL;
+        self->weakreflist = NULL;
+    }
+    return (PyObject *)self;
+}
+
+static int
+pg_polygon_init(pgPolygonObject *self, PyObject *args, PyObject *kwds)
+{
+    PyObject *arg;
+    double *vertices;
+    Py_ssize_t verts_num;
+
+    if (!PyArg_ParseTuple(args, "O:Polygon", &arg)) {
+        return -1;
+    }
+    if (!(vertices = _pg_polygon_vertices_from_obj(arg, &verts_num))) {
+        return -1;
+    }
+    PyMem_Free(self->vertices);
+    self->vertices = vertices;
+    self->verts_num = verts_num;
+    return 0;
+}
+
+static void
+pg_polygon_dealloc(pgPolygonObject *self)
+{
+    if (self->weakreflist) {
+        PyObject_ClearWeakRefs((PyObject *)self);
+    }
+    PyMem_Free(self->vertices);
+
+    Py_TYPE(self)->tp_free((PyObject *)self);
+}
+
+static PyObject *
+_pg_polygon_vertices_list(pgPolygonObject *self)
+{
+    PyObject *list, *point;
+    Py_ssize_t i;
+
+    if (!(list = PyList_New(self->verts_num))) {
+        return NULL;
+    }
+    for (i = 0; i < self->verts_num; i++) {
+        point = pg_tuple_couple_from_values_double(self->vertices[2 * i],
+                                                   self->vertices[2 * i + 1]);
+        if (!point) {
+            Py_DECREF(list);
+            return NULL;
+        }
+        PyList_SET_ITEM(list, i, point);
+    }
+    return list;
+}
+
+static PyObject *
+pg_polygon_repr(pgPolygonObject *self)
+{
+    PyObject *vertices, *result;
+
+    if (!(vertices = _pg_polygon_vertices_list(self))) {
+        return NULL;
+    }
+    result = PyUnicode_FromFormat("<Polygon(%R)>", vertices);
+    Py_DECREF(vertices);
+    return result;
+}
+
+static PyObject *
+pg_polygon_copy(pgPolygonObject *self, PyObject *_null)
+{
+    return _pg_polygon_subtype_new(Py_TYPE(self), self->vertices,
+                                   self->verts_num);
+}
+
+static void
+_pg_polygon_move_helper(pgPolygonObject *self, double dx, double dy)
+{
+    Py_ssize_t i;
+    for (i = 0; i < self->verts_num; i++) {
+        self->vertices[2 * i] += dx;
+        self->vertices[2 * i + 1] += dy;
+    }
+}
+
+static PyObject *
+pg_polygon_move(pgPolygonObject *self, PyObject *const *args,
+                Py_ssize_t nargs)
+{
+    PyObject *ret;
+    double dx, dy;
+
+    if (!pg_TwoDoublesFromFastcallArgs(args, nargs, &dx, &dy)) {
+        return RAISE(PyExc_TypeError, "move requires a pair of numbers");
+    }
+
+    if (!(ret = pg_polygon_copy(self, NULL))) {
+        return NULL;
+    }
+    _pg_polygon_move_helper(pgPolygon_CAST(ret), dx, dy);
+    return ret;
+}
+
+static PyObject *
+pg_polygon_move_ip(pgPolygonObject *self, PyObject *const *args,
+                   Py_ssize_t nargs)
+{
+    double dx, dy;
+
+    if (!pg_TwoDoublesFromFastcallArgs(args, nargs, &dx, &dy)) {
+        return RAISE(PyExc_TypeError, "move_ip requires a pair of numbers");
+    }
+
+    _pg_polygon_move_helper(self, dx, dy);
+    Py_RETURN_NONE;
+}
+
+/* Even-odd test of a point against the polygon's edges */
+static int
+_pg_polygon_collidepoint(const pgPolygonObject *self, double px, double py)
+{
+    const double *v = self->vertices;
+    Py_ssize_t i, j;
+    int inside = 0;
+
+    for (i = 0, j = self->verts_num - 1; i < self->verts_num; j = i++) {
+        const double xi = v[2 * i], yi = v[2 * i + 1];
+        const double xj = v[2 * j], yj = v[2 * j + 1];
+        if ((yi > py) != (yj > py) &&
+            px < (xj - xi) * (py - yi) / (yj - yi) + xi) {
+            inside = !inside;
+        }
+    }
+    return inside;
+}
+
+static PyObject *
+pg_polygon_collidepoint(pgPolygonObject *self, PyObject *const *args,
+                        Py_ssize_t nargs)
+{
+    double px, py;
+
+    if (!pg_TwoDoublesFromFastcallArgs(args, nargs, &px, &py)) {
+        return RAISE(
+            PyExc_TypeError,
+            "Polygon.collidepoint requires a point or PointLike object");
+    }
+
+    return PyBool_FromLong(_pg_polygon_collidepoint(self, px, py));
+}
+
+static struct PyMethodDef pg_polygon_methods[] = {
+    {"collidepoint", (PyCFunction)pg_polygon_collidepoint, METH_FASTCALL,
+     DOC_POLYGON_COLLIDEPOINT},
+    {"move", (PyCFunction)pg_polygon_move, METH_FASTCALL, DOC_POLYGON_MOVE},
+    {"move_ip", (PyCFunction)pg_polygon_move_ip, METH_FASTCALL,
+     DOC_POLYGON_MOVEIP},
+    {"__copy__", (PyCFunction)pg_polygon_copy, METH_NOARGS,
+     DOC_POLYGON_COPY},
+    {"copy", (PyCFunction)pg_polygon_copy, METH_NOARGS, DOC_POLYGON_COPY},
+    {NULL, NULL, 0, NULL}};
+
+static PyObject *
+pg_polygon_getvertices(pgPolygonObject *self, void *closure)
+{
+    return _pg_polygon_vertices_list(self);
+}
+
+static int
+pg_polygon_setvertices(pgPolygonObject *self, PyObject *value, void *closure)
+{
+    double *vertices;
+    Py_ssize_t verts_num;
+
+    DEL_ATTR_NOT_SUPPORTED_CHECK_NO_NAME(value);
+    if (!(vertices = _pg_polygon_vertices_from_obj(value, &verts_num))) {
+        return -1;
+    }
+    PyMem_Free(self->vertices);
+    self->vertices = vertices;
+    self->verts_num = verts_num;
+    return 0;
+}
+
+static PyObject *
+pg_polygon_getverts_num(pgPolygonObject *self, void *closure)
+{
+    return PyLong_FromSsize_t(self->verts_num);
+}
+
+static PyObject *
+pg_polygon_getcenter(pgPolygonObject *self, void *closure)
+{
+    double cx = 0.0, cy = 0.0;
+    Py_ssize_t i;
+
+    for (i = 0; i < self->verts_num; i++) {
+        cx += self->vertices[2 * i];
+        cy += self->vertices[2 * i + 1];
+    }
+    return pg_tuple_couple_from_values_double(cx / self->verts_num,
+                                              cy / self->verts_num);
+}
+
+static int
+pg_polygon_setcenter(pgPolygonObject *self, PyObject *value, void *closure)
+{
+    double cx = 0.0, cy = 0.0, x, y;
+    Py_ssize_t i;
+
+    DEL_ATTR_NOT_SUPPORTED_CHECK_NO_NAME(value);
+    if (!pg_TwoDoublesFromObj(value, &x, &y)) {
+        PyErr_SetString(PyExc_TypeError, "Expected a sequence of 2 numbers");
+        return -1;
+    }
+    for (i = 0; i < self->verts_num; i++) {
+        cx += self->vertices[2 * i];
+        cy += self->vertices[2 * i + 1];
+    }
+    _pg_polygon_move_helper(self, x - cx / self->verts_num,
+                            y - cy / self->verts_num);
+    return 0;
+}
+
+static PyGetSetDef pg_polygon_getsets[] = {
+    {"vertices", (getter)pg_polygon_getvertices,
+     (setter)pg_polygon_setvertices, DOC_POLYGON_VERTICES, NULL},
+    {"verts_num", (getter)pg_polygon_getverts_num, NULL,
+     DOC_POLYGON_VERTSNUM, NULL},
+    {"center", (getter)pg_polygon_getcenter, (setter)pg_polygon_setcenter,
+     DOC_POLYGON_CENTER, NULL},
+    {NULL, 0, NULL, NULL, NULL}};
+
+static PyTypeObject pgPolygon_Type = {
+    PyVarObject_HEAD_INIT(NULL, 0).tp_name = "pygame.geometry.Polygon",
+    .tp_basicsize = sizeof(pgPolygonObject),
+    .tp_dealloc = (destructor)pg_polygon_dealloc,
+    .tp_repr = (reprfunc)pg_polygon_repr,
+    .tp_flags = Py_TPFLAGS_DEFAULT | Py_TPFLAGS_BASETYPE,
+    .tp_doc = DOC_POLYGON,
+    .tp_weaklistoffset = offsetof(pgPolygonObject, weakreflist),
+    .tp_methods = pg_polygon_methods,
+    .tp_getset = pg_polygon_getsets,
+    .tp_init = (initproc)pg_polygon_init,
+    .tp_new = pg_polygon_new,
+};
@@ -43,12 +43,59 @@ static PyTypeObject pgFRect_Type;
 #define pgFRect_Check(x) (PyObject_IsInstance(x, (PyObject *)&pgFRect_Type))
 #define pgFRect_CheckExact(x) (Py_TYPE(x) == &pgFRect_Type)
 
+/* Many rects in one block, the x, y, w and h fields each take capacity
+ * items of data, in that order. See rect_array_impl.h */
+typedef struct {
+    PyObject_HEAD Py_ssize_t length;
+    Py_ssize_t capacity;
+    int *data;
+    Py_ssize_t exports;
+    Py_ssize_t shape[2];
+    Py_ssize_t strides[2];
+} pgRectArrayObject;
+
+typedef struct {
+    PyObject_HEAD Py_ssize_t length;
+    Py_ssize_t capacity;
+    float *data;
+    Py_ssize_t exports;
+    Py_ssize_t shape[2];
+    Py_ssize_t strides[2];
+} pgFRectArrayObject;
+
+static PyTypeObject pgRectArray_Type;
+static PyTypeObject pgFRectArray_Type;
+#define pgRectArray_Check(x) (PyObject_TypeCheck(x, &pgRectArray_Type))
+#define pgFRectArray_Check(x) (PyObject_TypeCheck(x, &pgFRectArray_Type))
+
+/* Number of deallocated Rect/FRect objects kept around for reuse */
+#ifdef PYPY_VERSION
+#define PG_RECT_FREELIST_SIZE 49152
+#else
+#define PG_RECT_FREELIST_SIZE 1024
+#endif
+
 static int
 four_ints_from_obj(PyObject *obj, int *val1, int *val2, int *val3, int *val4);
 static int
 four_floats_from_obj(PyObject *obj, float *val1, float *val2, float *val3,
                      float *val4);
 
+/* Normalized bounds of a rect for the sort and sweep in collide_all_pairs */
+typedef struct {
+    double left, right, top, bottom;
+    Py_ssize_t index;
+} pgSweepBox;
+
+static PyObject *
+_pg_sweep_pairs(pgSweepBox *boxes, Py_ssize_t count);
+static int
+_pg_buffer_item_as_double(Py_buffer *view, Py_ssize_t i, double *value);
+static Py_ssize_t
+_pg_rect_array_length(PyObject *obj);
+static void
+_pg_rect_array_item_as_doubles(PyObject *obj, Py_ssize_t i, double *values);
+
 #define RectExport_init pg_rect_init
 #define RectExport_subtypeNew4 _pg_rect_subtype_new4
 #define RectExport_new pg_rect_new
@@ -76,6 +123,7 @@ four_floats_from_obj(PyObject *obj, float *val1, float *val2, float *val3,
 #define RectExport_collideobjects pg_rect_collideobjects
 #define RectExport_collidedict pg_rect_collidedict
 #define RectExport_collidedictall pg_rect_collidedictall
+#define RectExport_collideAllPairs pg_rect_collide_all_pairs
 #define RectExport_clip pg_rect_clip
 #define RectExport_clipline pg_rect_clipline
 #define RectExport_do_rects_intresect _pg_do_rects_intersect
@@ -155,13 +203,13 @@ four_floats_from_obj(PyObject *obj, float *val1, float *val2, float *val3,
 #define RectImport_PythonNumberCheck PyLong_Check
 #define RectImport_PythonNumberAsPrimitiveType PyLong_AsLong
 #define RectImport_PrimitiveTypeAsPythonNumber PyLong_FromLong
-#ifdef PYPY_VERSION
 #define RectOptional_FREELIST
 #define RectOptional_FreelistlimitNumberName PG_RECT_FREELIST_MAX
-#define RectOptional_FreelistlimitNumber 49152
+#define RectOptional_FreelistlimitNumber PG_RECT_FREELIST_SIZE
 #define RectOptional_FreelistFreelistName pg_rect_freelist
 #define RectOptional_Freelist_Num pg_rect_freelist_num
-#endif /* PYPY_VERSION */
+#define RectOptional_Freelist_Hits pg_rect_freelist_hits
+#define RectOptional_Freelist_Misses pg_rect_freelist_misses
 #include "rect_impl.h"
 
 #define RectExport_init pg_frect_init
@@ -191,6 +239,7 @@ four_floats_from_obj(PyObject *obj, float *val1, float *val2, float *val3,
 #define RectExport_collideobjects pg_frect_collideobjects
 #define RectExport_collidedict pg_frect_collidedict
 #define RectExport_collidedictall pg_frect_collidedictall
+#define RectExport_collideAllPairs pg_frect_collide_all_pairs
 #define RectExport_clip pg_frect_clip
 #define RectExport_clipline pg_frect_clipline
 #define RectExport_do_rects_intresect _pg_do_frects_intersect
@@ -270,15 +319,109 @@ four_floats_from_obj(PyObject *obj, float *val1, float *val2, float *val3,
 #define RectImport_PythonNumberCheck PyFloat_Check
 #define RectImport_PythonNumberAsPrimitiveType PyFloat_AsDouble
 #define RectImport_PrimitiveTypeAsPythonNumber pg_PyFloat_FromFloat
-#ifdef PYPY_VERSION
 #define RectOptional_FREELIST
 #define RectOptional_FreelistlimitNumberName PG_FRECT_FREELIST_MAX
-#define RectOptional_FreelistlimitNumber 49152
+#define RectOptional_FreelistlimitNumber PG_RECT_FREELIST_SIZE
 #define RectOptional_FreelistFreelistName pg_frect_freelist
 #define RectOptional_Freelist_Num pg_frect_freelist_num
-#endif /* PYPY_VERSION */
+#define RectOptional_Freelist_Hits pg_frect_freelist_hits
+#define RectOptional_Freelist_Misses pg_frect_freelist_misses
 #include "rect_impl.h"
 
+#define RectArrayExport_new pg_rect_array_new
+#define RectArrayExport_init pg_rect_array_init
+#define RectArrayExport_dealloc pg_rect_array_dealloc
+#define RectArrayExport_reserve _pg_rect_array_reserve
+#define RectArrayExport_appendRect _pg_rect_array_append_rect
+#define RectArrayExport_repr pg_rect_array_repr
+#define RectArrayExport_length pg_rect_array_length
+#define RectArrayExport_item pg_rect_array_item
+#define RectArrayExport_assItem pg_rect_array_ass_item
+#define RectArrayExport_append pg_rect_array_append
+#define RectArrayExport_copy pg_rect_array_copy
+#define RectArrayExport_moveIp pg_rect_array_move_ip
+#define RectArrayExport_clampIp pg_rect_array_clamp_ip
+#define RectArrayExport_collidepoint pg_rect_array_collidepoint
+#define RectArrayExport_colliderect pg_rect_array_colliderect
+#define RectArrayExport_union pg_rect_array_union
+#define RectArrayExport_getbuffer pg_rect_array_getbuffer
+#define RectArrayExport_releasebuffer pg_rect_array_releasebuffer
+#define RectArrayImport_primitiveType int
+#define RectArrayImport_ArrayObject pgRectArrayObject
+#define RectArrayImport_TypeObject pgRectArray_Type
+#define RectArrayImport_innerRectStruct SDL_Rect
+#define RectArrayImport_RectFromObject pgRect_FromObject
+#define RectArrayImport_RectFromFastcallArgs pgRect_FromFastcallArgs
+#define RectArrayImport_twoValuesFromFastcallArgs pgTwoValuesFromFastcallArgs_i
+#define RectArrayImport_RectNew4 pgRect_New4
+#define RectArrayImport_BufferFormat "i"
+#define RectArrayImport_ObjectName "RectArray"
+#include "rect_array_impl.h"
+
+#define RectArrayExport_new pg_frect_array_new
+#define RectArrayExport_init pg_frect_array_init
+#define RectArrayExport_dealloc pg_frect_array_dealloc
+#define RectArrayExport_reserve _pg_frect_array_reserve
+#define RectArrayExport_appendRect _pg_frect_array_append_rect
+#define RectArrayExport_repr pg_frect_array_repr
+#define RectArrayExport_length pg_frect_array_length
+#define RectArrayExport_item pg_frect_array_item
+#define RectArrayExport_assItem pg_frect_array_ass_item
+#define RectArrayExport_append pg_frect_array_append
+#define RectArrayExport_copy pg_frect_array_copy
+#define RectArrayExport_moveIp pg_frect_array_move_ip
+#define RectArrayExport_clampIp pg_frect_array_clamp_ip
+#define RectArrayExport_collidepoint pg_frect_array_collidepoint
+#define RectArrayExport_colliderect pg_frect_array_colliderect
+#define RectArrayExport_union pg_frect_array_union
+#define RectArrayExport_getbuffer pg_frect_array_getbuffer
+#define RectArrayExport_releasebuffer pg_frect_array_releasebuffer
+#define RectArrayImport_primitiveType float
+#define RectArrayImport_ArrayObject pgFRectArrayObject
+#define RectArrayImport_TypeObject pgFRectArray_Type
+#define RectArrayImport_innerRectStruct SDL_FRect
+#define RectArrayImport_RectFromObject pgFRect_FromObject
+#define RectArrayImport_RectFromFastcallArgs pgFRect_FromFastcallArgs
+#define RectArrayImport_twoValuesFromFastcallArgs pgTwoValuesFromFastcallArgs_f
+#define RectArrayImport_RectNew4 pgFRect_New4
+#define RectArrayImport_BufferFormat "f"
+#define RectArrayImport_ObjectName "FRectArray"
+#include "rect_array_impl.h"
+
+/* Returns the number of rects of a RectArray or FRectArray, or -1 if obj is
+ * neither */
+static Py_ssize_t
+_pg_rect_array_length(PyObject *obj)
+{
+    if (pgRectArray_Check(obj)) {
+        return ((pgRectArrayObject *)obj)->length;
+    }
+    if (pgFRectArray_Check(obj)) {
+        return ((pgFRectArrayObject *)obj)->length;
+    }
+    return -1;
+}
+
+/* Reads x, y, w and h of rect i of a RectArray or FRectArray */
+static void
+_pg_rect_array_item_as_doubles(PyObject *obj, Py_ssize_t i, double *values)
+{
+    int k;
+
+    if (pgRectArray_Check(obj)) {
+        pgRectArrayObject *array = (pgRectArrayObject *)obj;
+        for (k = 0; k < 4; k++) {
+            values[k] = array->data[k * array->capacity + i];
+        }
+    }
+    else {
+        pgFRectArrayObject *array = (pgFRectArrayObject *)obj;
+        for (k = 0; k < 4; k++) {
+            values[k] = array->data[k * array->capacity + i];
+        }
+    }
+}
+
 /* Helper method to extract 4 ints from an object.
  *
  * This sequence extraction supports the following formats:
@@ -454,6 +597,98 @@ four_floats_from_obj(PyObject *obj, float *val1, float *val2, float *val3,
     return 1;
 }
 
+static int
+_pg_sweep_compare(const void *a, const void *b)
+{
+    double left_a = ((const pgSweepBox *)a)->left;
+    double left_b = ((const pgSweepBox *)b)->left;
+
+    return (left_a > left_b) - (left_a < left_b);
+}
+
+/* Sort and sweep: after sorting the boxes by their left edge, each box only
+ * needs to be tested against the following boxes that start before its right
+ * edge. Returns a list of (i, j) index tuples with i < j. */
+static PyObject *
+_pg_sweep_pairs(pgSweepBox *boxes, Py_ssize_t count)
+{
+    Py_ssize_t i, j;
+    pgSweepBox *a, *b;
+    PyObject *ret, *pair;
+
+    if (!(ret = PyList_New(0))) {
+        return NULL;
+    }
+
+    qsort(boxes, count, sizeof(pgSweepBox), _pg_sweep_compare);
+
+    for (i = 0; i < count; i++) {
+        a = &boxes[i];
+        for (j = i + 1; j < count && boxes[j].left < a->right; j++) {
+            b = &boxes[j];
+            if (a->top >= b->bottom || b->top >= a->bottom) {
+                continue;
+            }
+            pair = Py_BuildValue("(nn)", MIN(a->index, b->index),
+                                 MAX(a->index, b->index));
+            if (!pair || PyList_Append(ret, pair)) {
+                Py_XDECREF(pair);
+                Py_DECREF(ret);
+                return NULL;
+            }
+            Py_DECREF(pair);
+        }
+    }
+
+    return ret;
+}
+
+/* Reads item i of a contiguous buffer of numbers, returns 0 with TypeError
+ * set if the buffer format is not a supported number type. */
+static int
+_pg_buffer_item_as_double(Py_buffer *view, Py_ssize_t i, double *value)
+{
+    const char *format = view->format ? view->format : "B";
+    const char *ptr = (const char *)view->buf + i * view->itemsize;
+
+    /* only native buffers are expected, skip the byte order character */
+    if (*format == '@' || *format == '=' || *format == '<') {
+        format++;
+    }
+    if (format[0] == '\0' || format[1] != '\0') {
+        goto unsupported;
+    }
+
+#define _PG_BUFFER_CASE(fmt, type)            \
+    case fmt:                                 \
+        if (view->itemsize != sizeof(type)) { \
+            goto unsupported;                 \
+        }                                     \
+        *value = (double)*(const type *)ptr;  \
+        return 1;
+
+    switch (*format) {
+        _PG_BUFFER_CASE('b', signed char)
+        _PG_BUFFER_CASE('B', unsigned char)
+        _PG_BUFFER_CASE('h', short)
+        _PG_BUFFER_CASE('H', unsigned short)
+        _PG_BUFFER_CASE('i', int)
+        _PG_BUFFER_CASE('I', unsigned int)
+        _PG_BUFFER_CASE('l', long)
+        _PG_BUFFER_CASE('L', unsigned long)
+        _PG_BUFFER_CASE('q', long long)
+        _PG_BUFFER_CASE('Q', unsigned long long)
+        _PG_BUFFER_CASE('f', float)
+        _PG_BUFFER_CASE('d', double)
+    }
+#undef _PG_BUFFER_CASE
+
+unsupported:
+    PyErr_Format(PyExc_TypeError, "unsupported buffer format '%s'",
+                 view->format ? view->format : "B");
+    return 0;
+}
+
 static struct PyMethodDef pg_rect_methods[] = {
     {"normalize", (PyCFunction)pg_rect_normalize, METH_NOARGS,
      DOC_RECT_NORMALIZE},
@@ -499,6 +734,8 @@ static struct PyMethodDef pg_rect_methods[] = {
      METH_VARARGS | METH_KEYWORDS, DOC_RECT_COLLIDEOBJECTSALL},
     {"collideobjects", (PyCFunction)pg_rect_collideobjects,
      METH_VARARGS | METH_KEYWORDS, DOC_RECT_COLLIDEOBJECTS},
+    {"collide_all_pairs", (PyCFunction)pg_rect_collide_all_pairs,
+     METH_O | METH_STATIC, DOC_RECT_COLLIDEALLPAIRS},
     {"contains", (PyCFunction)pg_rect_contains, METH_FASTCALL,
      DOC_RECT_CONTAINS},
     {"__reduce__", (PyCFunction)pg_rect_reduce, METH_NOARGS, NULL},
@@ -550,6 +787,8 @@ static struct PyMethodDef pg_frect_methods[] = {
      METH_VARARGS | METH_KEYWORDS, DOC_RECT_COLLIDEOBJECTSALL},
     {"collideobjects", (PyCFunction)pg_frect_collideobjects,
      METH_VARARGS | METH_KEYWORDS, DOC_RECT_COLLIDEOBJECTS},
+    {"collide_all_pairs", (PyCFunction)pg_frect_collide_all_pairs,
+     METH_O | METH_STATIC, DOC_RECT_COLLIDEALLPAIRS},
     {"contains", (PyCFunction)pg_frect_contains, METH_FASTCALL,
      DOC_RECT_CONTAINS},
     {"__reduce__", (PyCFunction)pg_frect_reduce, METH_NOARGS, NULL},
@@ -760,7 +999,184 @@ static PyTypeObject pgFRect_Type = {
     .tp_getset = pg_frect_getsets, .tp_init = (initproc)pg_frect_init,
     .tp_new = pg_frect_new};
 
-static PyMethodDef _pg_module_methods[] = {{NULL, NULL, 0, NULL}};
+static struct PyMethodDef pg_rect_array_methods[] = {
+    {"append", (PyCFunction)pg_rect_array_append, METH_O,
+     DOC_RECTARRAY_APPEND},
+    {"copy", (PyCFunction)pg_rect_array_copy, METH_NOARGS, DOC_RECTARRAY_COPY},
+    {"move_ip", (PyCFunction)pg_rect_array_move_ip, METH_FASTCALL,
+     DOC_RECTARRAY_MOVEIP},
+    {"clamp_ip", (PyCFunction)pg_rect_array_clamp_ip, METH_FASTCALL,
+     DOC_RECTARRAY_CLAMPIP},
+    {"collidepoint", (PyCFunction)pg_rect_array_collidepoint, METH_FASTCALL,
+     DOC_RECTARRAY_COLLIDEPOINT},
+    {"colliderect", (PyCFunction)pg_rect_array_colliderect, METH_FASTCALL,
+     DOC_RECTARRAY_COLLIDERECT},
+    {"union", (PyCFunction)pg_rect_array_union, METH_NOARGS,
+     DOC_RECTARRAY_UNION},
+    {"__copy__", (PyCFunction)pg_rect_array_copy, METH_NOARGS, NULL},
+    {NULL, NULL, 0, NULL}};
+
+static struct PyMethodDef pg_frect_array_methods[] = {
+    {"append", (PyCFunction)pg_frect_array_append, METH_O,
+     DOC_RECTARRAY_APPEND},
+    {"copy", (PyCFunction)pg_frect_array_copy, METH_NOARGS,
+     DOC_RECTARRAY_COPY},
+    {"move_ip", (PyCFunction)pg_frect_array_move_ip, METH_FASTCALL,
+     DOC_RECTARRAY_MOVEIP},
+    {"clamp_ip", (PyCFunction)pg_frect_array_clamp_ip, METH_FASTCALL,
+     DOC_RECTARRAY_CLAMPIP},
+    {"collidepoint", (PyCFunction)pg_frect_array_collidepoint, METH_FASTCALL,
+     DOC_RECTARRAY_COLLIDEPOINT},
+    {"colliderect", (PyCFunction)pg_frect_array_colliderect, METH_FASTCALL,
+     DOC_RECTARRAY_COLLIDERECT},
+    {"union", (PyCFunction)pg_frect_array_union, METH_NOARGS,
+     DOC_RECTARRAY_UNION},
+    {"__copy__", (PyCFunction)pg_frect_array_copy, METH_NOARGS, NULL},
+    {NULL, NULL, 0, NULL}};
+
+static PySequenceMethods pg_rect_array_as_sequence = {
+    .sq_length = (lenfunc)pg_rect_array_length,
+    .sq_item = (ssizeargfunc)pg_rect_array_item,
+    .sq_ass_item = (ssizeobjargproc)pg_rect_array_ass_item,
+};
+
+static PySequenceMethods pg_frect_array_as_sequence = {
+    .sq_length = (lenfunc)pg_frect_array_length,
+    .sq_item = (ssizeargfunc)pg_frect_array_item,
+    .sq_ass_item = (ssizeobjargproc)pg_frect_array_ass_item,
+};
+
+static PyBufferProcs pg_rect_array_as_buffer = {
+    (getbufferproc)pg_rect_array_getbuffer,
+    (releasebufferproc)pg_rect_array_releasebuffer};
+
+static PyBufferProcs pg_frect_array_as_buffer = {
+    (getbufferproc)pg_frect_array_getbuffer,
+    (releasebufferproc)pg_frect_array_releasebuffer};
+
+static PyTypeObject pgRectArray_Type = {
+    PyVarObject_HEAD_INIT(NULL, 0).tp_name = "pygame.rect.RectArray",
+    .tp_basicsize = sizeof(pgRectArrayObject),
+    .tp_dealloc = (destructor)pg_rect_array_dealloc,
+    .tp_repr = (reprfunc)pg_rect_array_repr,
+    .tp_as_sequence = &pg_rect_array_as_sequence,
+    .tp_as_buffer = &pg_rect_array_as_buffer,
+    .tp_flags = Py_TPFLAGS_DEFAULT | Py_TPFLAGS_BASETYPE,
+    .tp_doc = DOC_RECTARRAY, .tp_methods = pg_rect_array_methods,
+    .tp_init = (initproc)pg_rect_array_init, .tp_new = pg_rect_array_new};
+
+static PyTypeObject pgFRectArray_Type = {
+    PyVarObject_HEAD_INIT(NULL, 0).tp_name = "pygame.rect.FRectArray",
+    .tp_basicsize = sizeof(pgFRectArrayObject),
+    .tp_dealloc = (destructor)pg_frect_array_dealloc,
+    .tp_repr = (reprfunc)pg_frect_array_repr,
+    .tp_as_sequence = &pg_frect_array_as_sequence,
+    .tp_as_buffer = &pg_frect_array_as_buffer,
+    .tp_flags = Py_TPFLAGS_DEFAULT | Py_TPFLAGS_BASETYPE,
+    .tp_doc = DOC_RECTARRAY, .tp_methods = pg_frect_array_methods,
+    .tp_init = (initproc)pg_frect_array_init, .tp_new = pg_frect_array_new};
+
+static PyObject *
+_pg_freelist_stats(unsigned long long hits, unsigned long long misses,
+                   int num)
+{
+    unsigned long long total = hits + misses;
+
+    return Py_BuildValue("{s:K,s:K,s:i,s:i,s:d}", "hits", hits, "misses",
+                         misses, "size", num + 1, "max_size",
+                         PG_RECT_FREELIST_SIZE, "hit_rate",
+                         total ? (double)hits / total : 0.0);
+}
+
+static PyObject *
+pg_rect_freelist_stats(PyObject *self, PyObject *_null)
+{
+    return Py_BuildValue(
+        "{s:N,s:N}", "Rect",
+        _pg_freelist_stats(pg_rect_freelist_hits, pg_rect_freelist_misses,
+                           pg_rect_freelist_num),
+        "FRect",
+        _pg_freelist_stats(pg_frect_freelist_hits, pg_frect_freelist_misses,
+                           pg_frect_freelist_num));
+}
+
+/* The dirty rect merging of pygame.sprite.LayeredDirty. Grows the rect by
+ * every rect of the update list it collides with, taking those out of the
+ * list, until it collides with none of them. Then appends the rect clipped
+ * to the clip rect. */
+static PyObject *
+pg_rect_merge_dirty(PyObject *self, PyObject *const *args, Py_ssize_t nargs)
+{
+    SDL_Rect rect, clip, temp, *argrect;
+    PyObject *update, *merged;
+    Py_ssize_t i;
+    int x, y, w, h;
+
+    if (nargs != 3 || !PyList_Check(args[0])) {
+        return RAISE(PyExc_TypeError,
+                     "_merge_dirty requires a list, a rect and a clip rect");
+    }
+    update = args[0];
+    if (!(argrect = pgRect_FromObject(args[1], &temp))) {
+        return RAISE(PyExc_TypeError, "Argument must be rect style object");
+    }
+    rect = *argrect;
+    if (!(argrect = pgRect_FromObject(args[2], &temp))) {
+        return RAISE(PyExc_TypeError, "Argument must be rect style object");
+    }
+    clip = *argrect;
+
+    i = 0;
+    while (i < PyList_GET_SIZE(update)) {
+        argrect = pgRect_FromObject(PyList_GET_ITEM(update, i), &temp);
+        if (!argrect) {
+            return RAISE(PyExc_TypeError,
+                         "Argument must be a sequence of rectstyle objects.");
+        }
+        if (!_pg_do_rects_intersect(&rect, argrect)) {
+            i++;
+            continue;
+        }
+        x = MIN(rect.x, argrect->x);
+        y = MIN(rect.y, argrect->y);
+        rect.w = MAX(rect.x + rect.w, argrect->x + argrect->w) - x;
+        rect.h = MAX(rect.y + rect.h, argrect->y + argrect->h) - y;
+        rect.x = x;
+        rect.y = y;
+        if (PyList_SetSlice(update, i, i + 1, NULL)) {
+            return NULL;
+        }
+        /* the grown rect may now collide with rects it was tested against */
+        i = 0;
+    }
+
+    x = MAX(rect.x, clip.x);
+    y = MAX(rect.y, clip.y);
+    w = MIN(rect.x + rect.w, clip.x + clip.w) - x;
+    h = MIN(rect.y + rect.h, clip.y + clip.h) - y;
+    if (w <= 0 || h <= 0) {
+        merged = pgRect_New4(rect.x, rect.y, 0, 0);
+    }
+    else {
+        merged = pgRect_New4(x, y, w, h);
+    }
+    if (!merged) {
+        return NULL;
+    }
+    if (PyList_Append(update, merged)) {
+        Py_DECREF(merged);
+        return NULL;
+    }
+    Py_DECREF(merged);
+    Py_RETURN_NONE;
+}
+
+static PyMethodDef _pg_module_methods[] = {
+    {"_freelist_stats", pg_rect_freelist_stats, METH_NOARGS,
+     "private: used by pygame.system.get_freelist_stats()"},
+    {"_merge_dirty", (PyCFunction)pg_rect_merge_dirty, METH_FASTCALL,
+     "private: used by pygame.sprite.LayeredDirty"},
+    {NULL, NULL, 0, NULL}};
 
 static char _pg_module_doc[] = "Module for the rectangle object\n";
 
@@ -788,7 +1204,9 @@ MODINIT_DEFINE(rect)
     }
 
     /* Create the module and add the functions */
-    if (PyType_Ready(&pgRect_Type) < 0 || PyType_Ready(&pgFRect_Type) < 0) {
+    if (PyType_Ready(&pgRect_Type) < 0 || PyType_Ready(&pgFRect_Type) < 0 ||
+        PyType_Ready(&pgRectArray_Type) < 0 ||
+        PyType_Ready(&pgFRectArray_Type) < 0) {
         return NULL;
     }
 
@@ -796,6 +1214,10 @@ MODINIT_DEFINE(rect)
     if (module == NULL) {
         return NULL;
     }
+    if (PG_GIL_NOT_USED(module)) {
+        Py_DECREF(module);
+        return NULL;
+    }
 
     Py_INCREF(&pgRect_Type);
     if (PyModule_AddObject(module, "RectType", (PyObject *)&pgRect_Type)) {
@@ -821,6 +1243,20 @@ MODINIT_DEFINE(rect)
         Py_DECREF(module);
         return NULL;
     }
+    Py_INCREF(&pgRectArray_Type);
+    if (PyModule_AddObject(module, "RectArray",
+                           (PyObject *)&pgRectArray_Type)) {
+        Py_DECREF(&pgRectArray_Type);
+        Py_DECREF(module);
+        return NULL;
+    }
+    Py_INCREF(&pgFRectArray_Type);
+    if (PyModule_AddObject(module, "FRectArray",
+                           (PyObject *)&pgFRectArray_Type)) {
+        Py_DECREF(&pgFRectArray_Type);
+        Py_DECREF(module);
+        return NULL;
+    }
 
     /* export the c api */
     c_api[0] = &pgRect_Type;
@@ -0,0 +1,590 @@
+/*
+  pygame - Python Game Library
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Library General Public
+  License as published by the Free Software Foundation; either
+  version 2 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Library General Public License for more details.
+
+  You should have received a copy of the GNU Library General Public
+  License along with this library; if not, write to the Free
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+*/
+
+/*
+ *  RectArray and FRectArray -- many rects stored in one block
+ *  a template like file, like rect_impl.h, that works with defines.
+ *
+ *  The x, y, w and h fields of the rects each get their own array of
+ *  capacity items (structure of arrays), so the bulk operations below are
+ *  plain loops over contiguous numbers that the compiler turns into SIMD
+ *  code.
+ */
+
+// #region RectArrayExport
+#ifndef RectArrayExport_new
+#error RectArrayExport_new needs to be defined
+#endif
+#ifndef RectArrayExport_init
+#error RectArrayExport_init needs to be defined
+#endif
+#ifndef RectArrayExport_dealloc
+#error RectArrayExport_dealloc needs to be defined
+#endif
+#ifndef RectArrayExport_reserve
+#error RectArrayExport_reserve needs to be defined
+#endif
+#ifndef RectArrayExport_appendRect
+#error RectArrayExport_appendRect needs to be defined
+#endif
+#ifndef RectArrayExport_repr
+#error RectArrayExport_repr needs to be defined
+#endif
+#ifndef RectArrayExport_length
+#error RectArrayExport_length needs to be defined
+#endif
+#ifndef RectArrayExport_item
+#error RectArrayExport_item needs to be defined
+#endif
+#ifndef RectArrayExport_assItem
+#error RectArrayExport_assItem needs to be defined
+#endif
+#ifndef RectArrayExport_append
+#error RectArrayExport_append needs to be defined
+#endif
+#ifndef RectArrayExport_copy
+#error RectArrayExport_copy needs to be defined
+#endif
+#ifndef RectArrayExport_moveIp
+#error RectArrayExport_moveIp needs to be defined
+#endif
+#ifndef RectArrayExport_clampIp
+#error RectArrayExport_clampIp needs to be defined
+#endif
+#ifndef RectArrayExport_collidepoint
+#error RectArrayExport_collidepoint needs to be defined
+#endif
+#ifndef RectArrayExport_colliderect
+#error RectArrayExport_colliderect needs to be defined
+#endif
+#ifndef RectArrayExport_union
+#error RectArrayExport_union needs to be defined
+#endif
+#ifndef RectArrayExport_getbuffer
+#error RectArrayExport_getbuffer needs to be defined
+#endif
+#ifndef RectArrayExport_releasebuffer
+#error RectArrayExport_releasebuffer needs to be defined
+#endif
+// #endregion RectArrayExport
+
+// #region RectArrayImport
+#ifndef RectArrayImport_primitiveType
+#error RectArrayImport_primitiveType needs to be defined
+#endif
+#ifndef RectArrayImport_ArrayObject
+#error RectArrayImport_ArrayObject needs to be defined
+#endif
+#ifndef RectArrayImport_TypeObject
+#error RectArrayImport_TypeObject needs to be defined
+#endif
+#ifndef RectArrayImport_innerRectStruct
+#error RectArrayImport_innerRectStruct needs to be defined
+#endif
+#ifndef RectArrayImport_RectFromObject
+#error RectArrayImport_RectFromObject needs to be defined
+#endif
+#ifndef RectArrayImport_RectFromFastcallArgs
+#error RectArrayImport_RectFromFastcallArgs needs to be defined
+#endif
+#ifndef RectArrayImport_twoValuesFromFastcallArgs
+#error RectArrayImport_twoValuesFromFastcallArgs needs to be defined
+#endif
+#ifndef RectArrayImport_RectNew4
+#error RectArrayImport_RectNew4 needs to be defined
+#endif
+#ifndef RectArrayImport_BufferFormat
+#error RectArrayImport_BufferFormat needs to be defined
+#endif
+#ifndef RectArrayImport_ObjectName
+#error RectArrayImport_ObjectName needs to be defined
+#endif
+// #endregion RectArrayImport
+
+#define PrimitiveType RectArrayImport_primitiveType
+#define ArrayObject RectArrayImport_ArrayObject
+#define TypeObject RectArrayImport_TypeObject
+#define InnerRect RectArrayImport_innerRectStruct
+#define ObjectName RectArrayImport_ObjectName
+
+/* capacity of a new array, and the least it grows by */
+#ifndef PG_RECT_ARRAY_MIN_CAPACITY
+#define PG_RECT_ARRAY_MIN_CAPACITY 8
+#endif
+
+/* the x, y, w and h arrays of a RectArray */
+#define RA_X(self) ((self)->data)
+#define RA_Y(self) ((self)->data + (self)->capacity)
+#define RA_W(self) ((self)->data + 2 * (self)->capacity)
+#define RA_H(self) ((self)->data + 3 * (self)->capacity)
+
+/* Makes room for at least capacity rects, returns -1 with an exception set
+ * on failure. The block can't move while a buffer of it is exported. */
+static int
+RectArrayExport_reserve(ArrayObject *self, Py_ssize_t capacity)
+{
+    PrimitiveType *data;
+    Py_ssize_t i;
+
+    if (capacity <= self->capacity) {
+        return 0;
+    }
+    if (self->exports > 0) {
+        PyErr_SetString(PyExc_BufferError,
+                        "Existing exports of data: " ObjectName
+                        " cannot be resized");
+        return -1;
+    }
+    if (capacity > PY_SSIZE_T_MAX / (Py_ssize_t)(4 * sizeof(PrimitiveType)) ||
+        !(data = PyMem_New(PrimitiveType, 4 * capacity))) {
+        PyErr_NoMemory();
+        return -1;
+    }
+    for (i = 0; i < 4; i++) {
+        memcpy(data + i * capacity, self->data + i * self->capacity,
+               self->length * sizeof(PrimitiveType));
+    }
+    PyMem_Free(self->data);
+    self->data = data;
+    self->capacity = capacity;
+    return 0;
+}
+
+static int
+RectArrayExport_appendRect(ArrayObject *self, InnerRect *rect)
+{
+    Py_ssize_t i = self->length;
+
+    if (i == self->capacity &&
+        RectArrayExport_reserve(
+            self, MAX(2 * self->capacity, PG_RECT_ARRAY_MIN_CAPACITY))) {
+        return -1;
+    }
+    RA_X(self)[i] = rect->x;
+    RA_Y(self)[i] = rect->y;
+    RA_W(self)[i] = rect->w;
+    RA_H(self)[i] = rect->h;
+    self->length++;
+    return 0;
+}
+
+static PyObject *
+RectArrayExport_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
+{
+    ArrayObject *self = (ArrayObject *)type->tp_alloc(type, 0);
+
+    if (!self) {
+        return NULL;
+    }
+    self->length = 0;
+    self->capacity = PG_RECT_ARRAY_MIN_CAPACITY;
+    self->exports = 0;
+    self->data = PyMem_New(PrimitiveType, 4 * PG_RECT_ARRAY_MIN_CAPACITY);
+    if (!self->data) {
+        Py_DECREF(self);
+        return PyErr_NoMemory();
+    }
+    return (PyObject *)self;
+}
+
+static int
+RectArrayExport_init(ArrayObject *self, PyObject *args, PyObject *kwds)
+{
+    PyObject *arg = NULL, *seq, **items;
+    InnerRect *argrect, temp;
+    Py_ssize_t i, size;
+
+    if (!PyArg_ParseTuple(args, "|O:" ObjectName, &arg)) {
+        return -1;
+    }
+    if (self->exports > 0) {
+        PyErr_SetString(PyExc_BufferError,
+                        "Existing exports of data: " ObjectName
+                        " cannot be resized");
+        return -1;
+    }
+    if (arg == (PyObject *)self) {
+        return 0;
+    }
+    self->length = 0;
+    if (!arg) {
+        return 0;
+    }
+
+    if (PyObject_TypeCheck(arg, &TypeObject)) {
+        ArrayObject *other = (ArrayObject *)arg;
+        if (RectArrayExport_reserve(self, other->length)) {
+            return -1;
+        }
+        for (i = 0; i < 4; i++) {
+            memcpy(self->data + i * self->capacity,
+                   other->data + i * other->capacity,
+                   other->length * sizeof(PrimitiveType));
+        }
+        self->length = other->length;
+        return 0;
+    }
+
+    if (!(seq = PySequence_Fast(
+              arg, "Argument must be an iterable of rectstyle objects."))) {
+        return -1;
+    }
+    items = PySequence_Fast_ITEMS(seq);
+    size = PySequence_Fast_GET_SIZE(seq);
+    if (RectArrayExport_reserve(self, size)) {
+        Py_DECREF(seq);
+        return -1;
+    }
+    for (i = 0; i < size; i++) {
+        if (!(argrect = RectArrayImport_RectFromObject(items[i], &temp))) {
+            Py_DECREF(seq);
+            self->length = 0;
+            PyErr_SetString(
+                PyExc_TypeError,
+                "Argument must be an iterable of rectstyle objects.");
+            return -1;
+        }
+        RA_X(self)[i] = argrect->x;
+        RA_Y(self)[i] = argrect->y;
+        RA_W(self)[i] = argrect->w;
+        RA_H(self)[i] = argrect->h;
+        self->length++;
+    }
+    Py_DECREF(seq);
+    return 0;
+}
+
+static void
+RectArrayExport_dealloc(ArrayObject *self)
+{
+    PyMem_Free(self->data);
+    Py_TYPE(self)->tp_free((PyObject *)self);
+}
+
+static PyObject *
+RectArrayExport_repr(ArrayObject *self)
+{
+    return PyUnicode_FromFormat("<" ObjectName "(%zd rects)>", self->length);
+}
+
+static Py_ssize_t
+RectArrayExport_length(ArrayObject *self)
+{
+    return self->length;
+}
+
+static PyObject *
+RectArrayExport_item(ArrayObject *self, Py_ssize_t i)
+{
+    if (i < 0 || i >= self->length) {
+        return RAISE(PyExc_IndexError, ObjectName " index out of range");
+    }
+    return RectArrayImport_RectNew4(RA_X(self)[i], RA_Y(self)[i],
+                                    RA_W(self)[i], RA_H(self)[i]);
+}
+
+static int
+RectArrayExport_assItem(ArrayObject *self, Py_ssize_t i, PyObject *value)
+{
+    InnerRect *argrect, temp;
+
+    if (!value) {
+        PyErr_SetString(PyExc_TypeError,
+                        ObjectName " does not support item deletion");
+        return -1;
+    }
+    if (i < 0 || i >= self->length) {
+        PyErr_SetString(PyExc_IndexError,
+                        ObjectName " assignment index out of range");
+        return -1;
+    }
+    if (!(argrect = RectArrayImport_RectFromObject(value, &temp))) {
+        PyErr_SetString(PyExc_TypeError, "Argument must be rect style object");
+        return -1;
+    }
+    RA_X(self)[i] = argrect->x;
+    RA_Y(self)[i] = argrect->y;
+    RA_W(self)[i] = argrect->w;
+    RA_H(self)[i] = argrect->h;
+    return 0;
+}
+
+static PyObject *
+RectArrayExport_append(ArrayObject *self, PyObject *arg)
+{
+    InnerRect *argrect, temp;
+
+    if (!(argrect = RectArrayImport_RectFromObject(arg, &temp))) {
+        return RAISE(PyExc_TypeError, "Argument must be rect style object");
+    }
+    if (RectArrayExport_appendRect(self, argrect)) {
+        return NULL;
+    }
+    Py_RETURN_NONE;
+}
+
+static PyObject *
+RectArrayExport_copy(ArrayObject *self, PyObject *_null)
+{
+    return PyObject_CallFunctionObjArgs((PyObject *)Py_TYPE(self),
+                                        (PyObject *)self, NULL);
+}
+
+static PyObject *
+RectArrayExport_moveIp(ArrayObject *self, PyObject *const *args,
+                       Py_ssize_t nargs)
+{
+    PrimitiveType dx, dy, *x = RA_X(self), *y = RA_Y(self);
+    Py_ssize_t i, n = self->length;
+
+    if (!RectArrayImport_twoValuesFromFastcallArgs(args, nargs, &dx, &dy)) {
+        return NULL;
+    }
+
+    for (i = 0; i < n; i++) {
+        x[i] += dx;
+    }
+    for (i = 0; i < n; i++) {
+        y[i] += dy;
+    }
+    Py_RETURN_NONE;
+}
+
+/* Moves every rect inside rect like Rect.clamp_ip(), which is
+ *     clamped = MIN(MAX(x, left), MAX(right - w, centered))
+ * as centered is at most left when the rect is not smaller, and at most
+ * right - w when it is. Having no branches, the loops become SIMD code. */
+static PyObject *
+RectArrayExport_clampIp(ArrayObject *self, PyObject *const *args,
+                        Py_ssize_t nargs)
+{
+    InnerRect *argrect, temp;
+    PrimitiveType *pos, *size, low, high, start, extent, mid, end;
+    Py_ssize_t i, axis, n = self->length;
+
+    if (!(argrect = RectArrayImport_RectFromFastcallArgs(args, nargs,
+                                                         &temp))) {
+        return RAISE(PyExc_TypeError, "Argument must be rect style object");
+    }
+
+    for (axis = 0; axis < 2; axis++) {
+        pos = axis ? RA_Y(self) : RA_X(self);
+        size = axis ? RA_H(self) : RA_W(self);
+        start = axis ? argrect->y : argrect->x;
+        extent = axis ? argrect->h : argrect->w;
+        mid = start + extent / 2;
+        end = start + extent;
+        for (i = 0; i < n; i++) {
+            low = MAX(pos[i], start);
+            high = MAX(end - size[i], mid - size[i] / 2);
+            pos[i] = MIN(low, high);
+        }
+    }
+    Py_RETURN_NONE;
+}
+
+/* The results of the collide functions are bytes with one 0 or 1 per rect,
+ * they are filled by branchless loops. */
+static PyObject *
+RectArrayExport_collidepoint(ArrayObject *self, PyObject *const *args,
+                             Py_ssize_t nargs)
+{
+    const PrimitiveType *x = RA_X(self), *y = RA_Y(self);
+    const PrimitiveType *w = RA_W(self), *h = RA_H(self);
+    Py_ssize_t i, n = self->length;
+    PrimitiveType px, py;
+    PyObject *ret;
+    char *mask;
+
+    if (!RectArrayImport_twoValuesFromFastcallArgs(args, nargs, &px, &py)) {
+        return NULL;
+    }
+    if (!(ret = PyBytes_FromStringAndSize(NULL, n))) {
+        return NULL;
+    }
+    mask = PyBytes_AS_STRING(ret);
+
+    for (i = 0; i < n; i++) {
+        mask[i] = (px >= x[i]) & (px < x[i] + w[i]) & (py >= y[i]) &
+                  (py < y[i] + h[i]);
+    }
+    return ret;
+}
+
+static PyObject *
+RectArrayExport_colliderect(ArrayObject *self, PyObject *const *args,
+                            Py_ssize_t nargs)
+{
+    const PrimitiveType *x = RA_X(self), *y = RA_Y(self);
+    const PrimitiveType *w = RA_W(self), *h = RA_H(self);
+    Py_ssize_t i, n = self->length;
+    PrimitiveType left, right, top, bottom;
+    InnerRect *argrect, temp;
+    PyObject *ret;
+    char *mask;
+
+    if (!(argrect = RectArrayImport_RectFromFastcallArgs(args, nargs,
+                                                         &temp))) {
+        return RAISE(PyExc_TypeError, "Argument must be rect style object");
+    }
+    if (!(ret = PyBytes_FromStringAndSize(NULL, n))) {
+        return NULL;
+    }
+    mask = PyBytes_AS_STRING(ret);
+
+    /* zero sized rects should not collide with anything #1197 */
+    if (argrect->w == 0 || argrect->h == 0) {
+        memset(mask, 0, n);
+        return ret;
+    }
+    left = MIN(argrect->x, argrect->x + argrect->w);
+    right = MAX(argrect->x, argrect->x + argrect->w);
+    top = MIN(argrect->y, argrect->y + argrect->h);
+    bottom = MAX(argrect->y, argrect->y + argrect->h);
+
+    for (i = 0; i < n; i++) {
+        mask[i] = (w[i] != 0) & (h[i] != 0) &
+                  (MIN(x[i], x[i] + w[i]) < right) &
+                  (MIN(y[i], y[i] + h[i]) < bottom) &
+                  (MAX(x[i], x[i] + w[i]) > left) &
+                  (MAX(y[i], y[i] + h[i]) > top);
+    }
+    return ret;
+}
+
+/* Only the int reduction becomes SIMD code, a MIN() or MAX() over floats
+ * needs the compiler to be allowed to ignore NaNs and signed zeros. */
+static PyObject *
+RectArrayExport_union(ArrayObject *self, PyObject *_null)
+{
+    const PrimitiveType *x = RA_X(self), *y = RA_Y(self);
+    const PrimitiveType *w = RA_W(self), *h = RA_H(self);
+    Py_ssize_t i, n = self->length;
+    PrimitiveType l, t, r, b;
+
+    if (n == 0) {
+        return RAISE(PyExc_ValueError, "union() of an empty " ObjectName);
+    }
+
+    l = x[0];
+    t = y[0];
+    r = x[0] + w[0];
+    b = y[0] + h[0];
+    for (i = 1; i < n; i++) {
+        l = MIN(l, x[i]);
+        t = MIN(t, y[i]);
+        r = MAX(r, x[i] + w[i]);
+        b = MAX(b, y[i] + h[i]);
+    }
+    return RectArrayImport_RectNew4(l, t, r - l, b - t);
+}
+
+/* The buffer is the x, y, w and h arrays as the rows of a C contiguous
+ * (4, len) array. The rows are moved next to each other first, then the
+ * block can't be resized while the buffer is exported. */
+static int
+RectArrayExport_getbuffer(ArrayObject *self, Py_buffer *view, int flags)
+{
+    const Py_ssize_t itemsize = sizeof(PrimitiveType);
+    Py_ssize_t i;
+
+    if ((flags & PyBUF_F_CONTIGUOUS) == PyBUF_F_CONTIGUOUS &&
+        self->length > 1) {
+        view->obj = NULL;
+        PyErr_SetString(PyExc_BufferError,
+                        ObjectName " is not Fortran contiguous");
+        return -1;
+    }
+
+    if (self->capacity != self->length) {
+        for (i = 1; i < 4; i++) {
+            memmove(self->data + i * self->length,
+                    self->data + i * self->capacity,
+                    self->length * itemsize);
+        }
+        self->capacity = self->length;
+    }
+    self->shape[0] = 4;
+    self->shape[1] = self->length;
+    self->strides[0] = self->length * itemsize;
+    self->strides[1] = itemsize;
+
+    Py_INCREF(self);
+    view->obj = (PyObject *)self;
+    view->buf = self->data;
+    view->len = 4 * self->length * itemsize;
+    view->readonly = 0;
+    view->itemsize = itemsize;
+    view->format =
+        (flags & PyBUF_FORMAT) ? (char *)RectArrayImport_BufferFormat : NULL;
+    view->ndim = (flags & PyBUF_ND) ? 2 : 1;
+    view->shape = (flags & PyBUF_ND) ? self->shape : NULL;
+    view->strides =
+        (flags & PyBUF_STRIDES) == PyBUF_STRIDES ? self->strides : NULL;
+    view->suboffsets = NULL;
+    view->internal = NULL;
+    self->exports++;
+    return 0;
+}
+
+static void
+RectArrayExport_releasebuffer(ArrayObject *self, Py_buffer *view)
+{
+    self->exports--;
+}
+
+#undef RA_X
+#undef RA_Y
+#undef RA_W
+#undef RA_H
+
+#undef RectArrayExport_new
+#undef RectArrayExport_init
+#undef RectArrayExport_dealloc
+#undef RectArrayExport_reserve
+#undef RectArrayExport_appendRect
+#undef RectArrayExport_repr
+#undef RectArrayExport_length
+#undef RectArrayExport_item
+#undef RectArrayExport_assItem
+#undef RectArrayExport_append
+#undef RectArrayExport_copy
+#undef RectArrayExport_moveIp
+#undef RectArrayExport_clampIp
+#undef RectArrayExport_collidepoint
+#undef RectArrayExport_colliderect
+#undef RectArrayExport_union
+#undef RectArrayExport_getbuffer
+#undef RectArrayExport_releasebuffer
+
+#undef RectArrayImport_primitiveType
+#undef RectArrayImport_ArrayObject
+#undef RectArrayImport_TypeObject
+#undef RectArrayImport_innerRectStruct
+#undef RectArrayImport_RectFromObject
+#undef RectArrayImport_RectFromFastcallArgs
+#undef RectArrayImport_twoValuesFromFastcallArgs
+#undef RectArrayImport_RectNew4
+#undef RectArrayImport_BufferFormat
+#undef RectArrayImport_ObjectName
+
+#undef PrimitiveType
+#undef ArrayObject
+#undef TypeObject
+#undef InnerRect
+#undef ObjectName
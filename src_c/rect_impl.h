@@ -116,6 +116,9 @@
 #ifndef RectExport_collidedictall
 #error RectExport_collidedictall needs to be defined
 #endif
+#ifndef RectExport_collideAllPairs
+#error RectExport_collideAllPairs needs to be defined
+#endif
 #ifndef RectExport_clip
 #error RectExport_clip needs to be defined
 #endif
@@ -360,9 +363,6 @@
 
 // #region RectOptional
 #ifdef RectOptional_FREELIST
-#ifndef PYPY_VERSION
-#error freelist is currently only supported for PyPy
-#endif
 #ifndef RectOptional_FreelistlimitNumberName
 #error RectOptional_FreelistlimitNumberName needs to be defined as RectOptional_FREELIST is defined
 #endif
@@ -375,6 +375,12 @@
 #ifndef RectOptional_Freelist_Num
 #error RectOptional_Freelist_Num needs to be defined as RectOptional_FREELIST is defined
 #endif
+#ifndef RectOptional_Freelist_Hits
+#error RectOptional_Freelist_Hits needs to be defined as RectOptional_FREELIST is defined
+#endif
+#ifndef RectOptional_Freelist_Misses
+#error RectOptional_Freelist_Misses needs to be defined as RectOptional_FREELIST is defined
+#endif
 #endif  // RectOptional_FREELIST
 // #endregion RectOptional
 
@@ -498,6 +504,8 @@ RectExport_collidedict(RectObject *self, PyObject *args, PyObject *kwargs);
 static PyObject *
 RectExport_collidedictall(RectObject *self, PyObject *args, PyObject *kwargs);
 static PyObject *
+RectExport_collideAllPairs(PyObject *cls, PyObject *arg);
+static PyObject *
 RectExport_clip(RectObject *self, PyObject *const *args, Py_ssize_t nargs);
 static int
 RectExport_contains_internal(RectObject *self, PyObject *const *args,
@@ -609,6 +617,9 @@ const int RectOptional_FreelistlimitNumberName =
 static RectObject
     *RectOptional_FreelistFreelistName[RectOptional_FreelistlimitNumber];
 int RectOptional_Freelist_Num = -1;
+/* allocations served from the freelist and ones that used tp_alloc */
+static unsigned long long RectOptional_Freelist_Hits = 0;
+static unsigned long long RectOptional_Freelist_Misses = 0;
 #endif
 
 static InnerRect *
@@ -796,20 +807,30 @@ RectExport_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
 {
     RectObject *self;
 
-#ifdef RectOptional_FREELIST
+#if defined(RectOptional_FREELIST) && !defined(Py_GIL_DISABLED)
     /* Only instances of the base pygame.Rect class are allowed in the
-     * current freelist implementation (subclasses are not allowed) */
+     * current freelist implementation (subclasses are not allowed).
+     * Free-threaded builds skip it, the list is not thread-safe. */
     if (RectOptional_Freelist_Num > -1 && type == &RectImport_TypeObject) {
         self = RectOptional_FreelistFreelistName[RectOptional_Freelist_Num];
+#ifdef PYPY_VERSION
         Py_INCREF(self);
         /* This is so that pypy garbage collector thinks it is a new obj
            TODO: May be a hack. Is a hack.
            See https://github.com/pygame/pygame/issues/430
         */
         ((PyObject *)(self))->ob_pypy_link = 0;
+#else
+        /* the object was deallocated, revive it with a fresh reference */
+        PyObject_Init((PyObject *)self, type);
+#endif
         RectOptional_Freelist_Num--;
+        RectOptional_Freelist_Hits++;
     }
     else {
+        if (type == &RectImport_TypeObject) {
+            RectOptional_Freelist_Misses++;
+        }
         self = (RectObject *)type->tp_alloc(type, 0);
     }
 #else
@@ -831,9 +852,10 @@ RectExport_dealloc(RectObject *self)
         PyObject_ClearWeakRefs((PyObject *)self);
     }
 
-#ifdef PYPY_VERSION
+#if defined(RectOptional_FREELIST) && !defined(Py_GIL_DISABLED)
     /* Only instances of the base pygame.Rect class are allowed in the
-     * current freelist implementation (subclasses are not allowed) */
+     * current freelist implementation (subclasses are not allowed).
+     * Free-threaded builds skip it, the list is not thread-safe. */
     if (RectOptional_Freelist_Num < RectOptional_FreelistlimitNumberName - 1 &&
         RectImport_RectCheckExact(self)) {
         RectOptional_Freelist_Num++;
@@ -1794,6 +1816,124 @@ RectExport_collidedictall(RectObject *self, PyObject *args, PyObject *kwargs)
     return ret;
 }
 
+static PyObject *
+RectExport_collideAllPairs(PyObject *cls, PyObject *arg)
+{
+    InnerRect *argrect, temp;
+    pgSweepBox *boxes;
+    Py_buffer view;
+    int use_buffer = 0, use_array = 0;
+    Py_ssize_t loop, length, count = 0;
+    PyObject *ret;
+
+    if ((length = _pg_rect_array_length(arg)) >= 0) {
+        /* read the fields straight from a RectArray or FRectArray */
+        use_array = 1;
+    }
+    else if (PyObject_CheckBuffer(arg) && !pgSequenceFast_Check(arg)) {
+        if (PyObject_GetBuffer(arg, &view, PyBUF_FORMAT | PyBUF_ND)) {
+            return NULL;
+        }
+        if (view.ndim < 1 || view.ndim > 2 ||
+            (view.ndim == 2 && view.shape[1] != 4) ||
+            (view.len / view.itemsize) % 4) {
+            PyBuffer_Release(&view);
+            return RAISE(PyExc_ValueError,
+                         "buffer must have a shape of (n, 4) or (n * 4,)");
+        }
+        if (!PyBuffer_IsContiguous(&view, 'C')) {
+            PyBuffer_Release(&view);
+            return RAISE(PyExc_ValueError, "buffer must be C contiguous");
+        }
+        length = view.len / view.itemsize / 4;
+        use_buffer = 1;
+    }
+    else if (PySequence_Check(arg)) {
+        if ((length = PySequence_Length(arg)) < 0) {
+            return NULL;
+        }
+    }
+    else {
+        return RAISE(PyExc_TypeError,
+                     "Argument must be a sequence of rectstyle objects or a "
+                     "buffer.");
+    }
+
+    boxes = PyMem_New(pgSweepBox, length ? length : 1);
+    if (!boxes) {
+        if (use_buffer) {
+            PyBuffer_Release(&view);
+        }
+        return PyErr_NoMemory();
+    }
+
+    for (loop = 0; loop < length; loop++) {
+        PyObject *obj = NULL;
+
+        if (use_array) {
+            double values[4];
+            _pg_rect_array_item_as_doubles(arg, loop, values);
+            temp.x = (PrimitiveType)values[0];
+            temp.y = (PrimitiveType)values[1];
+            temp.w = (PrimitiveType)values[2];
+            temp.h = (PrimitiveType)values[3];
+            argrect = &temp;
+        }
+        else if (use_buffer) {
+            double values[4];
+            int i;
+            for (i = 0; i < 4; i++) {
+                if (!_pg_buffer_item_as_double(&view, loop * 4 + i,
+                                               &values[i])) {
+                    goto error;
+                }
+            }
+            temp.x = (PrimitiveType)values[0];
+            temp.y = (PrimitiveType)values[1];
+            temp.w = (PrimitiveType)values[2];
+            temp.h = (PrimitiveType)values[3];
+            argrect = &temp;
+        }
+        else {
+            /* argrect may point into obj, which is released below */
+            obj = PySequence_ITEM(arg, loop);
+
+            if (!obj || !(argrect = RectFromObject(obj, &temp))) {
+                Py_XDECREF(obj);
+                PyErr_SetString(
+                    PyExc_TypeError,
+                    "Argument must be a sequence of rectstyle objects.");
+                goto error;
+            }
+        }
+
+        /* zero sized rects should not collide with anything #1197 */
+        if (argrect->w != 0 && argrect->h != 0) {
+            boxes[count].left = MIN(argrect->x, argrect->x + argrect->w);
+            boxes[count].right = MAX(argrect->x, argrect->x + argrect->w);
+            boxes[count].top = MIN(argrect->y, argrect->y + argrect->h);
+            boxes[count].bottom = MAX(argrect->y, argrect->y + argrect->h);
+            boxes[count].index = loop;
+            count++;
+        }
+        Py_XDECREF(obj);
+    }
+
+    if (use_buffer) {
+        PyBuffer_Release(&view);
+    }
+    ret = _pg_sweep_pairs(boxes, count);
+    PyMem_Free(boxes);
+    return ret;
+
+error:
+    if (use_buffer) {
+        PyBuffer_Release(&view);
+    }
+    PyMem_Free(boxes);
+    return NULL;
+}
+
 static PyObject *
 RectExport_clip(RectObject *self, PyObject *const *args, Py_ssize_t nargs)
 {
@@ -2862,6 +3002,7 @@ RectExport_iterator(RectObject *self)
 #undef RectExport_collidelistall
 #undef RectExport_collidedict
 #undef RectExport_collidedictall
+#undef RectExport_collideAllPairs
 #undef RectExport_collideobjectsall
 #undef RectExport_collideobjects
 #undef RectExport_RectFromObjectAndKeyFunc
@@ -2979,4 +3120,6 @@ RectExport_iterator(RectObject *self)
 #undef RectOptional_FreelistlimitNumber
 #undef RectOptional_FreelistFreelistName
 #undef RectOptional_Freelist_Num
+#undef RectOptional_Freelist_Hits
+#undef RectOptional_Freelist_Misses
 #endif /* RectOptional_FREELIST */
@@ -0,0 +1,814 @@
+#include "doc/geometry_doc.h"
+#include "geometry_common.h"
+
+/* RectIndex is a uniform grid spatial hash. Every entry is linked into each
+ * grid cell its rect covers, so queries only have to look at the entries
+ * sharing a cell with the query area. Entries that would cover more than
+ * PG_RECTINDEX_MAX_CELLS cells are kept in a separate list and always tested
+ * instead, so a few huge rects don't flood the grid. */
+#define PG_RECTINDEX_MAX_CELLS 64
+#define PG_RECTINDEX_COORD_LIMIT (1 << 28)
+#define PG_RECTINDEX_MIN_TABLE 64
+
+static int
+_pg_rectindex_cell_coord(double v, double inv_cell_size)
+{
+    v = floor(v * inv_cell_size);
+    /* also catches NaN */
+    if (!(v > -PG_RECTINDEX_COORD_LIMIT)) {
+        return -PG_RECTINDEX_COORD_LIMIT;
+    }
+    if (v > PG_RECTINDEX_COORD_LIMIT) {
+        return PG_RECTINDEX_COORD_LIMIT;
+    }
+    return (int)v;
+}
+
+static Py_ssize_t
+_pg_rectindex_hash(int cx, int cy, Py_ssize_t mask)
+{
+    return (Py_ssize_t)(((Uint32)cx * 73856093u) ^ ((Uint32)cy * 19349663u)) &
+           mask;
+}
+
+static inline int
+_pg_rectindex_overlap(const SDL_FRect *a, const SDL_FRect *b)
+{
+    return a->x < b->x + b->w && a->y < b->y + b->h && a->x + a->w > b->x &&
+           a->y + a->h > b->y;
+}
+
+static inline int
+_pg_rectindex_contains_point(const SDL_FRect *r, double x, double y)
+{
+    return x >= r->x && x < r->x + r->w && y >= r->y && y < r->y + r->h;
+}
+
+/* Rebuilds the cell table with room for at least min_used cells, dropping
+ * cells that became empty. Returns 0 on success, -1 with MemoryError set. */
+static int
+_pg_rectindex_rehash(pgRectIndexObject *self, Py_ssize_t min_used)
+{
+    pgRectIndexCell *old = self->cells, *cells, *cell;
+    Py_ssize_t old_size = self->cells_size, size, i, j, used = 0;
+
+    if (min_used < 0) {
+        /* count the cells that survive */
+        min_used = 0;
+        for (i = 0; i < old_size; i++) {
+            if (old[i].count > 0) {
+                min_used++;
+            }
+        }
+    }
+    size = PG_RECTINDEX_MIN_TABLE;
+    while (size < 2 * (min_used + 1)) {
+        size *= 2;
+    }
+
+    cells = PyMem_New(pgRectIndexCell, size);
+    if (!cells) {
+        PyErr_NoMemory();
+        return -1;
+    }
+    memset(cells, 0, size * sizeof(pgRectIndexCell));
+
+    for (i = 0; i < old_size; i++) {
+        if (old[i].count == 0) {
+            PyMem_Free(old[i].items);
+            continue;
+        }
+        j = _pg_rectindex_hash(old[i].cx, old[i].cy, size - 1);
+        while (cells[j].capacity) {
+            j = (j + 1) & (size - 1);
+        }
+        cell = &cells[j];
+        *cell = old[i];
+        used++;
+    }
+    PyMem_Free(old);
+
+    self->cells = cells;
+    self->cells_size = size;
+    self->cells_used = used;
+    return 0;
+}
+
+/* Returns the cell at (cx, cy), or NULL if there is none. With create set a
+ * missing cell gets added, in which case NULL means MemoryError is set. */
+static pgRectIndexCell *
+_pg_rectindex_get_cell(pgRectIndexObject *self, int cx, int cy, int create)
+{
+    pgRectIndexCell *cell;
+    Py_ssize_t i;
+
+    if (self->cells_size) {
+        i = _pg_rectindex_hash(cx, cy, self->cells_size - 1);
+        while (self->cells[i].capacity) {
+            cell = &self->cells[i];
+            if (cell->cx == cx && cell->cy == cy) {
+                return cell;
+            }
+            i = (i + 1) & (self->cells_size - 1);
+        }
+    }
+    if (!create) {
+        return NULL;
+    }
+
+    if (2 * (self->cells_used + 1) > self->cells_size) {
+        if (_pg_rectindex_rehash(self, -1) ||
+            (2 * (self->cells_used + 1) > self->cells_size &&
+             _pg_rectindex_rehash(self, self->cells_used * 2))) {
+            return NULL;
+        }
+    }
+
+    i = _pg_rectindex_hash(cx, cy, self->cells_size - 1);
+    while (self->cells[i].capacity) {
+        i = (i + 1) & (self->cells_size - 1);
+    }
+    cell = &self->cells[i];
+    cell->items = PyMem_New(Py_ssize_t, 4);
+    if (!cell->items) {
+        PyErr_NoMemory();
+        return NULL;
+    }
+    cell->cx = cx;
+    cell->cy = cy;
+    cell->count = 0;
+    cell->capacity = 4;
+    self->cells_used++;
+    return cell;
+}
+
+static int
+_pg_rectindex_push(Py_ssize_t **items, Py_ssize_t *count,
+                   Py_ssize_t *capacity, Py_ssize_t value)
+{
+    Py_ssize_t *new_items;
+
+    if (*count == *capacity) {
+        Py_ssize_t new_capacity = *capacity ? *capacity * 2 : 8;
+        new_items = PyMem_Resize(*items, Py_ssize_t, new_capacity);
+        if (!new_items) {
+            PyErr_NoMemory();
+            return -1;
+        }
+        *items = new_items;
+        *capacity = new_capacity;
+    }
+    (*items)[(*count)++] = value;
+    return 0;
+}
+
+static void
+_pg_rectindex_discard(Py_ssize_t *items, Py_ssize_t *count, Py_ssize_t value)
+{
+    Py_ssize_t i;
+
+    for (i = 0; i < *count; i++) {
+        if (items[i] == value) {
+            items[i] = items[--(*count)];
+            return;
+        }
+    }
+}
+
+static void
+_pg_rectindex_unlink(pgRectIndexObject *self, Py_ssize_t idx)
+{
+    pgRectIndexEntry *e = &self->entries[idx];
+    pgRectIndexCell *cell;
+    int cx, cy;
+
+    if (e->where == PG_RECTINDEX_GRID) {
+        for (cy = e->cy0; cy <= e->cy1; cy++) {
+            for (cx = e->cx0; cx <= e->cx1; cx++) {
+                cell = _pg_rectindex_get_cell(self, cx, cy, 0);
+                if (cell) {
+                    _pg_rectindex_discard(cell->items, &cell->count, idx);
+                }
+            }
+        }
+    }
+    else if (e->where == PG_RECTINDEX_LARGE) {
+        _pg_rectindex_discard(self->large, &self->num_large, idx);
+    }
+    e->where = PG_RECTINDEX_UNLINKED;
+}
+
+/* Sets the rect of an unlinked entry and links it into the grid or the large
+ * list. Returns 0 on success, -1 with MemoryError set (the entry is left
+ * unlinked). */
+static int
+_pg_rectindex_link(pgRectIndexObject *self, Py_ssize_t idx, SDL_FRect *rect)
+{
+    pgRectIndexEntry *e = &self->entries[idx];
+    pgRectIndexCell *cell;
+    double ncells;
+    int cx, cy;
+
+    e->rect = *rect;
+    if (e->rect.w < 0) {
+        e->rect.x += e->rect.w;
+        e->rect.w = -e->rect.w;
+    }
+    if (e->rect.h < 0) {
+        e->rect.y += e->rect.h;
+        e->rect.h = -e->rect.h;
+    }
+    e->where = PG_RECTINDEX_UNLINKED;
+
+    /* zero sized rects never collide with anything */
+    if (!(e->rect.w > 0 && e->rect.h > 0)) {
+        return 0;
+    }
+
+    e->cx0 = _pg_rectindex_cell_coord(e->rect.x, self->inv_cell_size);
+    e->cy0 = _pg_rectindex_cell_coord(e->rect.y, self->inv_cell_size);
+    e->cx1 = _pg_rectindex_cell_coord((double)e->rect.x + e->rect.w,
+                                      self->inv_cell_size);
+    e->cy1 = _pg_rectindex_cell_coord((double)e->rect.y + e->rect.h,
+                                      self->inv_cell_size);
+    ncells = ((double)e->cx1 - e->cx0 + 1) * ((double)e->cy1 - e->cy0 + 1);
+
+    if (ncells > PG_RECTINDEX_MAX_CELLS) {
+        if (_pg_rectindex_push(&self->large, &self->num_large,
+                               &self->large_capacity, idx)) {
+            return -1;
+        }
+        e->where = PG_RECTINDEX_LARGE;
+        return 0;
+    }
+
+    e->where = PG_RECTINDEX_GRID;
+    for (cy = e->cy0; cy <= e->cy1; cy++) {
+        for (cx = e->cx0; cx <= e->cx1; cx++) {
+            cell = _pg_rectindex_get_cell(self, cx, cy, 1);
+            if (!cell || _pg_rectindex_push(&cell->items, &cell->count,
+                                            &cell->capacity, idx)) {
+                _pg_rectindex_unlink(self, idx);
+                return -1;
+            }
+        }
+    }
+    return 0;
+}
+
+static void
+_pg_rectindex_reset(pgRectIndexObject *self)
+{
+    Py_ssize_t i;
+
+    for (i = 0; i < self->cells_size; i++) {
+        PyMem_Free(self->cells[i].items);
+    }
+    PyMem_Free(self->cells);
+    PyMem_Free(self->entries);
+    PyMem_Free(self->free_entries);
+    PyMem_Free(self->large);
+    self->cells = NULL;
+    self->cells_size = self->cells_used = 0;
+    self->entries = NULL;
+    self->num_entries = self->entries_capacity = 0;
+    self->free_entries = NULL;
+    self->num_free = 0;
+    self->large = NULL;
+    self->num_large = self->large_capacity = 0;
+}
+
+/* Returns the entry index stored for key, or -1. On error -1 is returned with
+ * an exception set. */
+static Py_ssize_t
+_pg_rectindex_lookup(pgRectIndexObject *self, PyObject *key)
+{
+    PyObject *value = PyDict_GetItemWithError(self->keys, key);
+
+    if (!value) {
+        if (!PyErr_Occurred()) {
+            PyErr_SetObject(PyExc_KeyError, key);
+        }
+        return -1;
+    }
+    return PyLong_AsSsize_t(value);
+}
+
+static PyObject *
+pg_rectindex_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
+{
+    pgRectIndexObject *self = (pgRectIndexObject *)type->tp_alloc(type, 0);
+
+    if (self) {
+        self->keys = PyDict_New();
+        if (!self->keys) {
+            Py_DECREF(self);
+            return NULL;
+        }
+        self->cell_size = 64.0;
+        self->inv_cell_size = 1.0 / 64.0;
+        self->weakreflist = NULL;
+    }
+    return (PyObject *)self;
+}
+
+static int
+pg_rectindex_init(pgRectIndexObject *self, PyObject *args, PyObject *kwds)
+{
+    double cell_size = 64.0;
+    static char *keywords[] = {"cell_size", NULL};
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "|d", keywords,
+                                     &cell_size)) {
+        return -1;
+    }
+    if (!(cell_size > 0) || isinf(cell_size)) {
+        PyErr_SetString(PyExc_ValueError,
+                        "cell_size must be a positive number");
+        return -1;
+    }
+
+    PyDict_Clear(self->keys);
+    _pg_rectindex_reset(self);
+    self->cell_size = cell_size;
+    self->inv_cell_size = 1.0 / cell_size;
+    return 0;
+}
+
+static int
+pg_rectindex_traverse(pgRectIndexObject *self, visitproc visit, void *arg)
+{
+    Py_VISIT(self->keys);
+    return 0;
+}
+
+/* Keeps the (empty) keys dict around, so the index stays usable */
+static int
+pg_rectindex_clear(pgRectIndexObject *self)
+{
+    _pg_rectindex_reset(self);
+    if (self->keys) {
+        PyDict_Clear(self->keys);
+    }
+    return 0;
+}
+
+static void
+pg_rectindex_dealloc(pgRectIndexObject *self)
+{
+    PyObject_GC_UnTrack(self);
+    if (self->weakreflist) {
+        PyObject_ClearWeakRefs((PyObject *)self);
+    }
+    _pg_rectindex_reset(self);
+    Py_XDECREF(self->keys);
+    Py_TYPE(self)->tp_free((PyObject *)self);
+}
+
+static PyObject *
+pg_rectindex_insert(pgRectIndexObject *self, PyObject *const *args,
+                    Py_ssize_t nargs)
+{
+    SDL_FRect temp, *rect;
+    pgRectIndexEntry *e;
+    PyObject *value;
+    Py_ssize_t idx;
+    int contained;
+
+    if (nargs != 2) {
+        return RAISE(PyExc_TypeError,
+                     "insert requires a key and a rect-like object");
+    }
+    if (!(rect = pgFRect_FromObject(args[1], &temp))) {
+        return RAISE(PyExc_TypeError, "Argument must be rect style object");
+    }
+    contained = PyDict_Contains(self->keys, args[0]);
+    if (contained < 0) {
+        return NULL;
+    }
+    if (contained) {
+        PyErr_SetObject(PyExc_KeyError, args[0]);
+        return NULL;
+    }
+
+    if (self->num_free) {
+        idx = self->free_entries[--self->num_free];
+    }
+    else {
+        if (self->num_entries == self->entries_capacity) {
+            Py_ssize_t capacity =
+                self->entries_capacity ? self->entries_capacity * 2 : 16;
+            pgRectIndexEntry *entries =
+                PyMem_Resize(self->entries, pgRectIndexEntry, capacity);
+            Py_ssize_t *free_entries;
+
+            if (!entries) {
+                return PyErr_NoMemory();
+            }
+            self->entries = entries;
+            /* sized like entries, so freeing a slot never has to allocate */
+            free_entries =
+                PyMem_Resize(self->free_entries, Py_ssize_t, capacity);
+            if (!free_entries) {
+                return PyErr_NoMemory();
+            }
+            self->free_entries = free_entries;
+            self->entries_capacity = capacity;
+        }
+        idx = self->num_entries++;
+    }
+    e = &self->entries[idx];
+    e->key = NULL;
+    e->where = PG_RECTINDEX_UNLINKED;
+    e->stamp = 0;
+
+    if (!(value = PyLong_FromSsize_t(idx)) ||
+        PyDict_SetItem(self->keys, args[0], value)) {
+        Py_XDECREF(value);
+        goto error;
+    }
+    Py_DECREF(value);
+
+    if (_pg_rectindex_link(self, idx, rect)) {
+        PyDict_DelItem(self->keys, args[0]);
+        goto error;
+    }
+    /* the dict keeps the key alive */
+    e->key = args[0];
+    Py_RETURN_NONE;
+
+error:
+    /* cannot fail, a free slot was taken or the array just grew */
+    self->free_entries[self->num_free++] = idx;
+    return NULL;
+}
+
+static PyObject *
+pg_rectindex_move(pgRectIndexObject *self, PyObject *const *args,
+                  Py_ssize_t nargs)
+{
+    SDL_FRect temp, *rect;
+    pgRectIndexEntry *e;
+    Py_ssize_t idx;
+    int cx0, cy0, cx1, cy1;
+
+    if (nargs != 2) {
+        return RAISE(PyExc_TypeError,
+                     "move requires a key and a rect-like object");
+    }
+    if (!(rect = pgFRect_FromObject(args[1], &temp))) {
+        return RAISE(PyExc_TypeError, "Argument must be rect style object");
+    }
+    if ((idx = _pg_rectindex_lookup(self, args[0])) < 0) {
+        return NULL;
+    }
+    e = &self->entries[idx];
+
+    /* Small moves usually stay within the same cells */
+    if (e->where == PG_RECTINDEX_GRID && rect->w > 0 && rect->h > 0) {
+        cx0 = _pg_rectindex_cell_coord(rect->x, self->inv_cell_size);
+        cy0 = _pg_rectindex_cell_coord(rect->y, self->inv_cell_size);
+        cx1 = _pg_rectindex_cell_coord((double)rect->x + rect->w,
+                                       self->inv_cell_size);
+        cy1 = _pg_rectindex_cell_coord((double)rect->y + rect->h,
+                                       self->inv_cell_size);
+        if (cx0 == e->cx0 && cy0 == e->cy0 && cx1 == e->cx1 &&
+            cy1 == e->cy1) {
+            e->rect = *rect;
+            Py_RETURN_NONE;
+        }
+    }
+
+    _pg_rectindex_unlink(self, idx);
+    if (_pg_rectindex_link(self, idx, rect)) {
+        return NULL;
+    }
+    Py_RETURN_NONE;
+}
+
+static PyObject *
+pg_rectindex_remove(pgRectIndexObject *self, PyObject *key)
+{
+    pgRectIndexEntry *e;
+    Py_ssize_t idx;
+
+    if ((idx = _pg_rectindex_lookup(self, key)) < 0) {
+        return NULL;
+    }
+    e = &self->entries[idx];
+    _pg_rectindex_unlink(self, idx);
+    e->key = NULL;
+    self->free_entries[self->num_free++] = idx;
+    if (PyDict_DelItem(self->keys, key)) {
+        return NULL;
+    }
+    Py_RETURN_NONE;
+}
+
+static PyObject *
+pg_rectindex_clear_method(pgRectIndexObject *self, PyObject *_null)
+{
+    pg_rectindex_clear(self);
+    Py_RETURN_NONE;
+}
+
+static PyObject *
+pg_rectindex_get_rect(pgRectIndexObject *self, PyObject *key)
+{
+    Py_ssize_t idx;
+
+    if ((idx = _pg_rectindex_lookup(self, key)) < 0) {
+        return NULL;
+    }
+    return pgFRect_New(&self->entries[idx].rect);
+}
+
+static PyObject *
+pg_rectindex_collidepoint(pgRectIndexObject *self, PyObject *const *args,
+                          Py_ssize_t nargs)
+{
+    pgRectIndexCell *cell;
+    pgRectIndexEntry *e;
+    PyObject *result;
+    double x, y;
+    Py_ssize_t i;
+
+    if (!pg_TwoDoublesFromFastcallArgs(args, nargs, &x, &y)) {
+        return RAISE(PyExc_TypeError,
+                     "collidepoint requires a pair of numbers");
+    }
+    if (!(result = PyList_New(0))) {
+        return NULL;
+    }
+
+    cell = _pg_rectindex_get_cell(
+        self, _pg_rectindex_cell_coord(x, self->inv_cell_size),
+        _pg_rectindex_cell_coord(y, self->inv_cell_size), 0);
+    if (cell) {
+        for (i = 0; i < cell->count; i++) {
+            e = &self->entries[cell->items[i]];
+            if (_pg_rectindex_contains_point(&e->rect, x, y) &&
+                PyList_Append(result, e->key)) {
+                Py_DECREF(result);
+                return NULL;
+            }
+        }
+    }
+    for (i = 0; i < self->num_large; i++) {
+        e = &self->entries[self->large[i]];
+        if (_pg_rectindex_contains_point(&e->rect, x, y) &&
+            PyList_Append(result, e->key)) {
+            Py_DECREF(result);
+            return NULL;
+        }
+    }
+    return result;
+}
+
+static PyObject *
+pg_rectindex_colliderect(pgRectIndexObject *self, PyObject *const *args,
+                         Py_ssize_t nargs)
+{
+    SDL_FRect temp, rect;
+    pgRectIndexCell *cell;
+    pgRectIndexEntry *e;
+    PyObject *result;
+    Py_ssize_t i, stamp;
+    int cx, cy, cx0, cy0, cx1, cy1;
+
+    if (nargs == 1) {
+        SDL_FRect *r = pgFRect_FromObject(args[0], &temp);
+        if (!r) {
+            return RAISE(PyExc_TypeError,
+                         "Argument must be rect style object");
+        }
+        rect = *r;
+    }
+    else {
+        return RAISE(PyExc_TypeError, "colliderect requires a rect");
+    }
+    if (!(result = PyList_New(0))) {
+        return NULL;
+    }
+    if (rect.w < 0) {
+        rect.x += rect.w;
+        rect.w = -rect.w;
+    }
+    if (rect.h < 0) {
+        rect.y += rect.h;
+        rect.h = -rect.h;
+    }
+    if (!(rect.w > 0 && rect.h > 0)) {
+        return result;
+    }
+
+    cx0 = _pg_rectindex_cell_coord(rect.x, self->inv_cell_size);
+    cy0 = _pg_rectindex_cell_coord(rect.y, self->inv_cell_size);
+    cx1 = _pg_rectindex_cell_coord((double)rect.x + rect.w,
+                                   self->inv_cell_size);
+    cy1 = _pg_rectindex_cell_coord((double)rect.y + rect.h,
+                                   self->inv_cell_size);
+
+    stamp = ++self->stamp;
+    if (((double)cx1 - cx0 + 1) * ((double)cy1 - cy0 + 1) >
+        (double)self->cells_used) {
+        /* The query covers more cells than exist, walk the table instead */
+        for (i = 0; i < self->cells_size; i++) {
+            cell = &self->cells[i];
+            if (cell->count && cell->cx >= cx0 && cell->cx <= cx1 &&
+                cell->cy >= cy0 && cell->cy <= cy1) {
+                Py_ssize_t j;
+                for (j = 0; j < cell->count; j++) {
+                    e = &self->entries[cell->items[j]];
+                    if (e->stamp != stamp) {
+                        e->stamp = stamp;
+                        if (_pg_rectindex_overlap(&e->rect, &rect) &&
+                            PyList_Append(result, e->key)) {
+                            goto error;
+                        }
+                    }
+                }
+            }
+        }
+    }
+    else {
+        for (cy = cy0; cy <= cy1; cy++) {
+            for (cx = cx0; cx <= cx1; cx++) {
+                if (!(cell = _pg_rectindex_get_cell(self, cx, cy, 0))) {
+                    continue;
+                }
+                for (i = 0; i < cell->count; i++) {
+                    e = &self->entries[cell->items[i]];
+                    if (e->stamp != stamp) {
+                        e->stamp = stamp;
+                        if (_pg_rectindex_overlap(&e->rect, &rect) &&
+                            PyList_Append(result, e->key)) {
+                            goto error;
+                        }
+                    }
+                }
+            }
+        }
+    }
+    for (i = 0; i < self->num_large; i++) {
+        e = &self->entries[self->large[i]];
+        if (_pg_rectindex_overlap(&e->rect, &rect) &&
+            PyList_Append(result, e->key)) {
+            goto error;
+        }
+    }
+    return result;
+
+error:
+    Py_DECREF(result);
+    return NULL;
+}
+
+static int
+_pg_rectindex_append_pair(PyObject *list, PyObject *a, PyObject *b)
+{
+    PyObject *pair = PyTuple_Pack(2, a, b);
+    int ret;
+
+    if (!pair) {
+        return -1;
+    }
+    ret = PyList_Append(list, pair);
+    Py_DECREF(pair);
+    return ret;
+}
+
+static PyObject *
+pg_rectindex_collidepairs(pgRectIndexObject *self, PyObject *_null)
+{
+    pgRectIndexCell *cell;
+    pgRectIndexEntry *a, *b;
+    PyObject *result;
+    Py_ssize_t c, i, j;
+
+    if (!(result = PyList_New(0))) {
+        return NULL;
+    }
+
+    for (c = 0; c < self->cells_size; c++) {
+        cell = &self->cells[c];
+        for (i = 0; i < cell->count; i++) {
+            a = &self->entries[cell->items[i]];
+            for (j = i + 1; j < cell->count; j++) {
+                b = &self->entries[cell->items[j]];
+                /* Two entries can share several cells, only report the pair
+                 * from the first cell of the shared range */
+                if (MAX(a->cx0, b->cx0) != cell->cx ||
+                    MAX(a->cy0, b->cy0) != cell->cy) {
+                    continue;
+                }
+                if (_pg_rectindex_overlap(&a->rect, &b->rect) &&
+                    _pg_rectindex_append_pair(result, a->key, b->key)) {
+                    goto error;
+                }
+            }
+        }
+    }
+
+    for (i = 0; i < self->num_large; i++) {
+        a = &self->entries[self->large[i]];
+        for (j = i + 1; j < self->num_large; j++) {
+            b = &self->entries[self->large[j]];
+            if (_pg_rectindex_overlap(&a->rect, &b->rect) &&
+                _pg_rectindex_append_pair(result, a->key, b->key)) {
+                goto error;
+            }
+        }
+        for (j = 0; j < self->num_entries; j++) {
+            b = &self->entries[j];
+            if (b->where == PG_RECTINDEX_GRID &&
+                _pg_rectindex_overlap(&a->rect, &b->rect) &&
+                _pg_rectindex_append_pair(result, a->key, b->key)) {
+                goto error;
+            }
+        }
+    }
+    return result;
+
+error:
+    Py_DECREF(result);
+    return NULL;
+}
+
+static Py_ssize_t
+pg_rectindex_length(pgRectIndexObject *self)
+{
+    return PyDict_GET_SIZE(self->keys);
+}
+
+static int
+pg_rectindex_contains(pgRectIndexObject *self, PyObject *key)
+{
+    return PyDict_Contains(self->keys, key);
+}
+
+static PyObject *
+pg_rectindex_repr(pgRectIndexObject *self)
+{
+    PyObject *cell_size, *result;
+
+    if (!(cell_size = PyFloat_FromDouble(self->cell_size))) {
+        return NULL;
+    }
+    result = PyUnicode_FromFormat("<RectIndex(%zd rects, cell_size=%R)>",
+                                  PyDict_GET_SIZE(self->keys), cell_size);
+    Py_DECREF(cell_size);
+    return result;
+}
+
+static PyObject *
+pg_rectindex_get_cell_size(pgRectIndexObject *self, void *closure)
+{
+    return PyFloat_FromDouble(self->cell_size);
+}
+
+static struct PyMethodDef pg_rectindex_methods[] = {
+    {"insert", (PyCFunction)pg_rectindex_insert, METH_FASTCALL,
+     DOC_RECTINDEX_INSERT},
+    {"move", (PyCFunction)pg_rectindex_move, METH_FASTCALL,
+     DOC_RECTINDEX_MOVE},
+    {"remove", (PyCFunction)pg_rectindex_remove, METH_O,
+     DOC_RECTINDEX_REMOVE},
+    {"clear", (PyCFunction)pg_rectindex_clear_method, METH_NOARGS,
+     DOC_RECTINDEX_CLEAR},
+    {"get_rect", (PyCFunction)pg_rectindex_get_rect, METH_O,
+     DOC_RECTINDEX_GETRECT},
+    {"collidepoint", (PyCFunction)pg_rectindex_collidepoint, METH_FASTCALL,
+     DOC_RECTINDEX_COLLIDEPOINT},
+    {"colliderect", (PyCFunction)pg_rectindex_colliderect, METH_FASTCALL,
+     DOC_RECTINDEX_COLLIDERECT},
+    {"collidepairs", (PyCFunction)pg_rectindex_collidepairs, METH_NOARGS,
+     DOC_RECTINDEX_COLLIDEPAIRS},
+    {NULL, NULL, 0, NULL}};
+
+static PyGetSetDef pg_rectindex_getsets[] = {
+    {"cell_size", (getter)pg_rectindex_get_cell_size, NULL,
+     DOC_RECTINDEX_CELLSIZE, NULL},
+    {NULL, 0, NULL, NULL, NULL}};
+
+static PySequenceMethods pg_rectindex_as_sequence = {
+    .sq_length = (lenfunc)pg_rectindex_length,
+    .sq_contains = (objobjproc)pg_rectindex_contains,
+};
+
+static PyTypeObject pgRectIndex_Type = {
+    PyVarObject_HEAD_INIT(NULL, 0).tp_name = "pygame.geometry.RectIndex",
+    .tp_basicsize = sizeof(pgRectIndexObject),
+    .tp_dealloc = (destructor)pg_rectindex_dealloc,
+    .tp_repr = (reprfunc)pg_rectindex_repr,
+    .tp_as_sequence = &pg_rectindex_as_sequence,
+    .tp_flags = Py_TPFLAGS_DEFAULT | Py_TPFLAGS_BASETYPE | Py_TPFLAGS_HAVE_GC,
+    .tp_doc = DOC_RECTINDEX,
+    .tp_traverse = (traverseproc)pg_rectindex_traverse,
+    .tp_clear = (inquiry)pg_rectindex_clear,
+    .tp_weaklistoffset = offsetof(pgRectIndexObject, weakreflist),
+    .tp_methods = pg_rectindex_methods,
+    .tp_getset = pg_rectindex_getsets,
+    .tp_init = (initproc)pg_rectindex_init,
+    .tp_new = pg_rectindex_new,
+};
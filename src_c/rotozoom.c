@@ -15,6 +15,8 @@
 #define NO_PYGAME_C_API
 #include "pygame.h"
 
+#include "simd_transform.h"
+
 #include "math.h"
 
 typedef struct tColorRGBA {
@@ -34,201 +36,216 @@ typedef struct tColorRGBA {
 
 /*
 
- 32bit Zoomer with optional anti-aliasing by bilinear interpolation.
-
- Zoomes 32bit RGBA/ABGR 'src' surface to 'dst' surface.
+ Rotozooms are split into bands of destination rows that are computed in
+ parallel, every destination row only depends on its own coordinates.
 
 */
-int
-zoomSurfaceRGBA(SDL_Surface *src, SDL_Surface *dst, int smooth)
+
+typedef struct tRotozoomJob tRotozoomJob;
+
+struct tRotozoomJob {
+    SDL_Surface *src;
+    SDL_Surface *dst;
+    int smooth;
+    ROTOZOOM_SMOOTH_RUN_P smooth_run;
+    /* zoom: the 16.16 source step per destination pixel and row, and the
+     * source x of every destination x without smoothing */
+    int sx, sy;
+    const int *sax;
+    /* rotozoom: the center and the 16.16 rotation */
+    int cx, cy, isin, icos;
+    void (*rows)(const tRotozoomJob *job, int y_start, int y_end);
+};
+
+typedef struct {
+    const tRotozoomJob *job;
+    int y_start;
+    int y_end;
+} tRotozoomBand;
+
+#define ROTOZOOM_THREAD_MIN_ROWS 16
+#define ROTOZOOM_THREAD_MIN_PIXELS (1 << 16)
+
+static void
+_rotozoom_band(void *data, int i)
 {
-    int x, y, sx, sy, *sax, *say, *csax, *csay, csx, csy, ex, ey, t1, t2,
-        sstep;
-    tColorRGBA *c00, *c01, *c10, *c11;
-    tColorRGBA *sp, *csp, *dp;
-    int dgap;
+    tRotozoomBand *band = (tRotozoomBand *)data + i;
+    band->job->rows(band->job, band->y_start, band->y_end);
+}
 
-    /*
-     * Variable setup
-     */
-    if (smooth) {
-        /*
-         * For interpolation: assume source dimension is one pixel
-         */
-        /*
-         * smaller to avoid overflow on right and bottom edge.
-         */
-        sx = (int)(65536.0 * (float)(src->w - 1) / (float)dst->w);
-        sy = (int)(65536.0 * (float)(src->h - 1) / (float)dst->h);
-    }
-    else {
-        sx = (int)(65536.0 * (float)src->w / (float)dst->w);
-        sy = (int)(65536.0 * (float)src->h / (float)dst->h);
+/* Runs job->rows over all the destination rows, on up to num_threads
+ * blit threads. Small surfaces are done on the calling thread. */
+static void
+_rotozoom_run(const tRotozoomJob *job, int num_threads)
+{
+    tRotozoomBand bands[ROTOZOOM_MAX_THREADS];
+    int h = job->dst->h;
+    int nbands = MIN(num_threads, h / ROTOZOOM_THREAD_MIN_ROWS);
+    int i;
+
+    nbands = MIN(nbands, ROTOZOOM_MAX_THREADS);
+    if (nbands < 2 ||
+        (Sint64)job->dst->w * h < ROTOZOOM_THREAD_MIN_PIXELS) {
+        job->rows(job, 0, h);
+        return;
     }
 
-    /*
-     * Allocate memory for row increments
-     */
-    if ((sax = (int *)malloc((dst->w + 1) * sizeof(int))) == NULL) {
-        return (-1);
-    }
-    if ((say = (int *)malloc((dst->h + 1) * sizeof(int))) == NULL) {
-        free(sax);
-        return (-1);
+    for (i = 0; i < nbands; i++) {
+        bands[i].job = job;
+        bands[i].y_start = (int)((Sint64)h * i / nbands);
+        bands[i].y_end = (int)((Sint64)h * (i + 1) / nbands);
     }
 
-    /*
-     * Precalculate row increments
-     */
-    csx = 0;
-    csax = sax;
-    for (x = 0; x <= dst->w; x++) {
-        *csax = csx;
-        csax++;
-        csx &= 0xffff;
-        csx += sx;
-    }
-    csy = 0;
-    csay = say;
-    for (y = 0; y <= dst->h; y++) {
-        *csay = csy;
-        csay++;
-        csy &= 0xffff;
-        csy += sy;
-    }
+    pg_run_bands(_rotozoom_band, bands, nbands);
+}
 
-    /*
-     * Pointer setup
-     */
-    csp = (tColorRGBA *)src->pixels;
-    dp = (tColorRGBA *)dst->pixels;
-    dgap = dst->pitch - dst->w * 4;
+/*
 
-    /*
-     * Switch between interpolating and non-interpolating code
-     */
-    if (smooth) {
-        /*
-         * Interpolating Zoom
-         */
+ Zooms the destination rows y_start to y_end. Destination pixel x of row y
+ samples the source at the 16.16 position (x * sx, y * sy), which is where
+ the step tables of SDL_gfx ended up too.
 
-        /*
-         * Scan destination
-         */
-        csay = say;
-        for (y = 0; y < dst->h; y++) {
-            /*
-             * Setup color source pointers
-             */
-            c00 = csp;
-            c01 = csp;
-            c01++;
-            c10 = (tColorRGBA *)((Uint8 *)csp + src->pitch);
-            c11 = c10;
-            c11++;
-            csax = sax;
+*/
+
+static void
+_zoom_rows(const tRotozoomJob *job, int y_start, int y_end)
+{
+    SDL_Surface *src = job->src, *dst = job->dst;
+    int x, y, n, span, pos;
+    Sint64 sy;
+    const Uint8 *srcrow;
+    Uint32 *dp;
+
+    /* the source x of a run is kept below 2^31 by starting a new run */
+    span = job->sx > 0 ? MAX(0x7fff0000 / job->sx, 1) : dst->w;
+    for (y = y_start; y < y_end; y++) {
+        sy = (Sint64)y * job->sy;
+        srcrow = (const Uint8 *)src->pixels + (sy >> 16) * src->pitch;
+        dp = (Uint32 *)((Uint8 *)dst->pixels + (Sint64)y * dst->pitch);
+        if (job->smooth) {
+            for (x = 0; x < dst->w; x += n) {
+                n = MIN(span, dst->w - x);
+                pos = (int)(((Sint64)x * job->sx) >> 16);
+                job->smooth_run(srcrow + pos * 4, src->pitch, dp + x, n,
+                                (int)(((Sint64)x * job->sx) & 0xffff),
+                                (int)(sy & 0xffff), job->sx, 0);
+            }
+        }
+        else {
             for (x = 0; x < dst->w; x++) {
-                /*
-                 * Interpolate colors
-                 */
-                ex = (*csax & 0xffff);
-                ey = (*csay & 0xffff);
-                t1 = ((((c01->r - c00->r) * ex) >> 16) + c00->r) & 0xff;
-                t2 = ((((c11->r - c10->r) * ex) >> 16) + c10->r) & 0xff;
-                dp->r = (((t2 - t1) * ey) >> 16) + t1;
-                t1 = ((((c01->g - c00->g) * ex) >> 16) + c00->g) & 0xff;
-                t2 = ((((c11->g - c10->g) * ex) >> 16) + c10->g) & 0xff;
-                dp->g = (((t2 - t1) * ey) >> 16) + t1;
-                t1 = ((((c01->b - c00->b) * ex) >> 16) + c00->b) & 0xff;
-                t2 = ((((c11->b - c10->b) * ex) >> 16) + c10->b) & 0xff;
-                dp->b = (((t2 - t1) * ey) >> 16) + t1;
-                t1 = ((((c01->a - c00->a) * ex) >> 16) + c00->a) & 0xff;
-                t2 = ((((c11->a - c10->a) * ex) >> 16) + c10->a) & 0xff;
-                dp->a = (((t2 - t1) * ey) >> 16) + t1;
-
-                /*
-                 * Advance source pointers
-                 */
-                csax++;
-                sstep = (*csax >> 16);
-                c00 += sstep;
-                c01 += sstep;
-                c10 += sstep;
-                c11 += sstep;
-                /*
-                 * Advance destination pointer
-                 */
-                dp++;
+                dp[x] = ((const Uint32 *)srcrow)[job->sax[x]];
             }
-            /*
-             * Advance source pointer
-             */
-            csay++;
-            csp = (tColorRGBA *)((Uint8 *)csp + (*csay >> 16) * src->pitch);
-            /*
-             * Advance destination pointers
-             */
-            dp = (tColorRGBA *)((Uint8 *)dp + dgap);
         }
     }
-    else {
+}
+
+/*
+
+ 32bit Zoomer with optional anti-aliasing by bilinear interpolation.
+
+ Zoomes 32bit RGBA/ABGR 'src' surface to 'dst' surface.
+
+*/
+int
+zoomSurfaceRGBA(SDL_Surface *src, SDL_Surface *dst, int smooth,
+                ROTOZOOM_SMOOTH_RUN_P smooth_run, int num_threads)
+{
+    tRotozoomJob job = {0};
+    int x, *sax = NULL;
+
+    job.src = src;
+    job.dst = dst;
+    job.smooth = smooth;
+    job.smooth_run = smooth_run;
+    job.rows = _zoom_rows;
+    if (smooth) {
         /*
-         * Non-Interpolating Zoom
+         * For interpolation: assume source dimension is one pixel
+         * smaller to avoid overflow on right and bottom edge.
          */
+        job.sx = (int)(65536.0 * (float)(src->w - 1) / (float)dst->w);
+        job.sy = (int)(65536.0 * (float)(src->h - 1) / (float)dst->h);
+    }
+    else {
+        job.sx = (int)(65536.0 * (float)src->w / (float)dst->w);
+        job.sy = (int)(65536.0 * (float)src->h / (float)dst->h);
 
-        csay = say;
-        for (y = 0; y < dst->h; y++) {
-            sp = csp;
-            csax = sax;
-            for (x = 0; x < dst->w; x++) {
-                /*
-                 * Draw
-                 */
-                *dp = *sp;
-                /*
-                 * Advance source pointers
-                 */
-                csax++;
-                sp += (*csax >> 16);
-                /*
-                 * Advance destination pointer
-                 */
-                dp++;
-            }
-            /*
-             * Advance source pointer
-             */
-            csay++;
-            csp = (tColorRGBA *)((Uint8 *)csp + (*csay >> 16) * src->pitch);
-            /*
-             * Advance destination pointers
-             */
-            dp = (tColorRGBA *)((Uint8 *)dp + dgap);
+        if ((sax = (int *)malloc((dst->w + 1) * sizeof(int))) == NULL) {
+            return (-1);
         }
+        for (x = 0; x < dst->w; x++) {
+            sax[x] = (int)(((Sint64)x * job.sx) >> 16);
+        }
+        job.sax = sax;
     }
 
-    /*
-     * Remove temp arrays
-     */
-    free(sax);
-    free(say);
+    _rotozoom_run(&job, num_threads);
 
+    free(sax);
     return (0);
 }
 
 /*
 
- 32bit Rotozoomer with optional anti-aliasing by bilinear interpolation.
-
- Rotates and zooms 32bit RGBA/ABGR 'src' surface to 'dst' surface.
+ Bilinear interpolation of a run of 'width' 32bit pixels, starting at the
+ 16.16 fixed point source position (sdx, sdy) and advancing by (icos, isin).
+ All of the 2x2 source neighbourhoods must be inside the source surface, the
+ edges are handled by transformSurfaceRGBA itself. The SIMD versions of this
+ live in simd_transform_*.c and give the same results.
 
 */
 
 void
-transformSurfaceRGBA(SDL_Surface *src, SDL_Surface *dst, int cx, int cy,
-                     int isin, int icos, int smooth)
+rotozoom_smooth_run(const Uint8 *srcpix, int srcpitch, Uint32 *dstpix,
+                    int width, int sdx, int sdy, int icos, int isin)
 {
-    int x, y, t1, t2, dx, dy, xd, yd, sdx, sdy, ax, ay, ex, ey, sw, sh;
+    int x, t1, t2, ex, ey;
+    tColorRGBA c00, c01, c10, c11;
+    const tColorRGBA *sp;
+    tColorRGBA *pc = (tColorRGBA *)dstpix;
+
+    for (x = 0; x < width; x++) {
+        sp = (const tColorRGBA *)(srcpix + srcpitch * (sdy >> 16));
+        sp += (sdx >> 16);
+        c00 = sp[0];
+        c01 = sp[1];
+        sp = (const tColorRGBA *)((const Uint8 *)sp + srcpitch);
+        c10 = sp[0];
+        c11 = sp[1];
+
+        ex = (sdx & 0xffff);
+        ey = (sdy & 0xffff);
+        t1 = ((((c01.r - c00.r) * ex) >> 16) + c00.r) & 0xff;
+        t2 = ((((c11.r - c10.r) * ex) >> 16) + c10.r) & 0xff;
+        pc->r = (((t2 - t1) * ey) >> 16) + t1;
+        t1 = ((((c01.g - c00.g) * ex) >> 16) + c00.g) & 0xff;
+        t2 = ((((c11.g - c10.g) * ex) >> 16) + c10.g) & 0xff;
+        pc->g = (((t2 - t1) * ey) >> 16) + t1;
+        t1 = ((((c01.b - c00.b) * ex) >> 16) + c00.b) & 0xff;
+        t2 = ((((c11.b - c10.b) * ex) >> 16) + c10.b) & 0xff;
+        pc->b = (((t2 - t1) * ey) >> 16) + t1;
+        t1 = ((((c01.a - c00.a) * ex) >> 16) + c00.a) & 0xff;
+        t2 = ((((c11.a - c10.a) * ex) >> 16) + c10.a) & 0xff;
+        pc->a = (((t2 - t1) * ey) >> 16) + t1;
+
+        sdx += icos;
+        sdy += isin;
+        pc++;
+    }
+}
+
+/*
+
+ Rotozooms the destination rows y_start to y_end, see transformSurfaceRGBA.
+
+*/
+
+static void
+_transform_rows(const tRotozoomJob *job, int y_start, int y_end)
+{
+    SDL_Surface *src = job->src, *dst = job->dst;
+    int cx = job->cx, cy = job->cy, isin = job->isin, icos = job->icos;
+    int x, y, t1, t2, dx, dy, xd, yd, sdx, sdy, ax, ay, ex, ey, sw, sh, n;
     tColorRGBA c00, c01, c10, c11;
     tColorRGBA *pc, *sp;
     int gap;
@@ -242,20 +259,42 @@ transformSurfaceRGBA(SDL_Surface *src, SDL_Surface *dst, int cx, int cy,
     ay = (cy << 16) - (isin * cx);
     sw = src->w - 1;
     sh = src->h - 1;
-    pc = dst->pixels;
+    pc = (tColorRGBA *)((Uint8 *)dst->pixels + (Sint64)y_start * dst->pitch);
     gap = dst->pitch - dst->w * 4;
 
     /*
      * Switch between interpolating and non-interpolating code
      */
-    if (smooth) {
-        for (y = 0; y < dst->h; y++) {
+    if (job->smooth) {
+        for (y = y_start; y < y_end; y++) {
             dy = cy - y;
             sdx = (ax + (isin * dy)) + xd;
             sdy = (ay - (icos * dy)) + yd;
             for (x = 0; x < dst->w; x++) {
                 dx = (sdx >> 16);
                 dy = (sdy >> 16);
+                if ((dx >= 0) && (dy >= 0) && (dx < sw) && (dy < sh)) {
+                    /*
+                     * The pixels with their whole neighbourhood inside the
+                     * source form a single run on every row, hand it to the
+                     * (possibly SIMD) interpolation kernel at once
+                     */
+                    n = 1;
+                    while (x + n < dst->w) {
+                        dx = ((sdx + n * icos) >> 16);
+                        dy = ((sdy + n * isin) >> 16);
+                        if ((dx < 0) || (dy < 0) || (dx >= sw) || (dy >= sh))
+                            break;
+                        n++;
+                    }
+                    job->smooth_run((Uint8 *)src->pixels, src->pitch,
+                                    (Uint32 *)pc, n, sdx, sdy, icos, isin);
+                    sdx += n * icos;
+                    sdy += n * isin;
+                    pc += n;
+                    x += n - 1;
+                    continue;
+                }
                 if ((dx >= -1) && (dy >= -1) && (dx < src->w) &&
                     (dy < src->h)) {
                     if ((dx >= 0) && (dy >= 0) && (dx < sw) && (dy < sh)) {
@@ -378,7 +417,7 @@ transformSurfaceRGBA(SDL_Surface *src, SDL_Surface *dst, int cx, int cy,
         }
     }
     else {
-        for (y = 0; y < dst->h; y++) {
+        for (y = y_start; y < y_end; y++) {
             dy = cy - y;
             sdx = (ax + (isin * dy)) + xd;
             sdy = (ay - (icos * dy)) + yd;
@@ -400,6 +439,33 @@ transformSurfaceRGBA(SDL_Surface *src, SDL_Surface *dst, int cx, int cy,
     }
 }
 
+/*
+
+ 32bit Rotozoomer with optional anti-aliasing by bilinear interpolation.
+
+ Rotates and zooms 32bit RGBA/ABGR 'src' surface to 'dst' surface.
+
+*/
+
+void
+transformSurfaceRGBA(SDL_Surface *src, SDL_Surface *dst, int cx, int cy,
+                     int isin, int icos, int smooth,
+                     ROTOZOOM_SMOOTH_RUN_P smooth_run, int num_threads)
+{
+    tRotozoomJob job = {0};
+
+    job.src = src;
+    job.dst = dst;
+    job.smooth = smooth;
+    job.smooth_run = smooth_run;
+    job.cx = cx;
+    job.cy = cy;
+    job.isin = isin;
+    job.icos = icos;
+    job.rows = _transform_rows;
+    _rotozoom_run(&job, num_threads);
+}
+
 /*
 
  rotozoomSurface()
@@ -410,6 +476,12 @@ transformSurfaceRGBA(SDL_Surface *src, SDL_Surface *dst, int cx, int cy,
  surface is not 8bit or 32bit RGBA/ABGR it will be converted into a 32bit RGBA
  format on the fly.
 
+ If 'dst' is not NULL, only its pixels are written instead. It must have the
+ size rotozoomSurfaceResultSize() gives and the format of the result.
+
+ The destination rows are split across up to 'num_threads' threads, see
+ _rotozoom_run(). Must be called without the GIL.
+
 */
 
 #define VALUE_LIMIT 0.001
@@ -501,10 +573,29 @@ zoomSurfaceSize(int width, int height, double zoomx, double zoomy,
     }
 }
 
+/* The size of the surface rotozoomSurface() returns */
+
+void
+rotozoomSurfaceResultSize(int width, int height, double angle, double zoom,
+                          int *dstwidth, int *dstheight)
+{
+    if (zoom < VALUE_LIMIT) {
+        zoom = VALUE_LIMIT;
+    }
+    if (fabs(angle) > VALUE_LIMIT) {
+        rotozoomSurfaceSize(width, height, angle, zoom, dstwidth, dstheight);
+    }
+    else {
+        zoomSurfaceSize(width, height, zoom, zoom, dstwidth, dstheight);
+    }
+}
+
 /* Publicly available rotozoom function */
 
 SDL_Surface *
-rotozoomSurface(SDL_Surface *src, double angle, double zoom, int smooth)
+rotozoomSurface(SDL_Surface *src, double angle, double zoom, int smooth,
+                ROTOZOOM_SMOOTH_RUN_P smooth_run, int num_threads,
+                SDL_Surface *dst)
 {
     SDL_Surface *rz_src;
     SDL_Surface *rz_dst;
@@ -584,8 +675,10 @@ rotozoomSurface(SDL_Surface *src, double angle, double zoom, int smooth)
         /*
          * Target surface is 32bit with source RGBA/ABGR ordering
          */
-        rz_dst = PG_CreateSurface(dstwidth, dstheight, rz_src->format->format);
-        if (SDL_HasColorKey(src)) {
+        rz_dst = dst ? dst
+                     : PG_CreateSurface(dstwidth, dstheight,
+                                        rz_src->format->format);
+        if (!dst && SDL_HasColorKey(src)) {
             SDL_GetColorKey(src, &colorkey);
             if (SDL_SetColorKey(rz_dst, SDL_TRUE, colorkey) != 0) {
                 SDL_FreeSurface(rz_dst);
@@ -598,6 +691,12 @@ rotozoomSurface(SDL_Surface *src, double angle, double zoom, int smooth)
             }
         }
 
+        /* the corners outside of the source aren't written, new surfaces
+         * start out cleared */
+        if (dst) {
+            SDL_FillRect(rz_dst, NULL, 0);
+        }
+
         /*
          * Lock source surface
          */
@@ -611,11 +710,13 @@ rotozoomSurface(SDL_Surface *src, double angle, double zoom, int smooth)
          */
         transformSurfaceRGBA(rz_src, rz_dst, dstwidthhalf, dstheighthalf,
                              (int)(sanglezoominv), (int)(canglezoominv),
-                             smooth);
+                             smooth, smooth_run, num_threads);
         /*
          * Turn on source-alpha support
          */
-        SDL_SetSurfaceAlphaMod(rz_dst, SDL_ALPHA_OPAQUE);
+        if (!dst) {
+            SDL_SetSurfaceAlphaMod(rz_dst, SDL_ALPHA_OPAQUE);
+        }
         /*
          * Unlock source surface
          */
@@ -643,8 +744,10 @@ rotozoomSurface(SDL_Surface *src, double angle, double zoom, int smooth)
          * Target surface is 32bit with source RGBA/ABGR ordering
          */
 
-        rz_dst = PG_CreateSurface(dstwidth, dstheight, rz_src->format->format);
-        if (SDL_HasColorKey(src)) {
+        rz_dst = dst ? dst
+                     : PG_CreateSurface(dstwidth, dstheight,
+                                        rz_src->format->format);
+        if (!dst && SDL_HasColorKey(src)) {
             SDL_GetColorKey(src, &colorkey);
             if (SDL_SetColorKey(rz_dst, SDL_TRUE, colorkey) != 0) {
                 SDL_FreeSurface(rz_dst);
@@ -668,11 +771,24 @@ rotozoomSurface(SDL_Surface *src, double angle, double zoom, int smooth)
          * Call the 32bit transformation routine to do the zooming (using
          * alpha)
          */
-        zoomSurfaceRGBA(rz_src, rz_dst, smooth);
+        if (zoomSurfaceRGBA(rz_src, rz_dst, smooth, smooth_run,
+                            num_threads) != 0) {
+            SDL_UnlockSurface(rz_src);
+            if (src_converted) {
+                SDL_FreeSurface(rz_src);
+            }
+            if (!dst) {
+                SDL_FreeSurface(rz_dst);
+            }
+            SDL_OutOfMemory();
+            return NULL;
+        }
         /*
          * Turn on source-alpha support
          */
-        SDL_SetSurfaceAlphaMod(rz_dst, SDL_ALPHA_OPAQUE);
+        if (!dst) {
+            SDL_SetSurfaceAlphaMod(rz_dst, SDL_ALPHA_OPAQUE);
+        }
         /*
          * Unlock source surface
          */
@@ -31,6 +31,22 @@
 
 #include "doc/pygame_doc.h"
 
+/* Paths are memory mapped where the platform allows it */
+#if defined(MS_WIN32)
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#define PG_RW_MMAP
+#elif !defined(__EMSCRIPTEN__) && \
+    (defined(unix) || defined(__unix__) || defined(__APPLE__))
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define PG_RW_MMAP
+#endif
+
 typedef struct {
     PyObject *read;
     PyObject *write;
@@ -538,6 +554,227 @@ end:
     return retval;
 }
 
+/* Read-only RWops over memory that stays valid until close: a mapped
+ * file, or the buffer exported by a Python object. Reads never call back
+ * into Python, so callers may release the GIL around them. */
+typedef struct {
+    const char *base;
+    Sint64 size;
+    Sint64 pos;
+    Py_buffer view; /* view.obj is NULL for a mapped file */
+} pgRWMemory;
+
+#ifdef PG_RW_MMAP
+static void
+_pg_rw_unmap(const char *base, Sint64 size)
+{
+#ifdef MS_WIN32
+    UnmapViewOfFile(base);
+#else
+    munmap((void *)base, (size_t)size);
+#endif
+}
+#endif /* PG_RW_MMAP */
+
+static Sint64
+_pg_rw_mem_size(SDL_RWops *context)
+{
+    return ((pgRWMemory *)context->hidden.unknown.data1)->size;
+}
+
+static Sint64
+_pg_rw_mem_seek(SDL_RWops *context, Sint64 offset, int whence)
+{
+    pgRWMemory *mem = (pgRWMemory *)context->hidden.unknown.data1;
+
+    switch (whence) {
+        case RW_SEEK_SET:
+            break;
+        case RW_SEEK_CUR:
+            offset += mem->pos;
+            break;
+        case RW_SEEK_END:
+            offset += mem->size;
+            break;
+        default:
+            return SDL_SetError("Unknown value for 'whence'");
+    }
+    /* clamp like SDL's own memory RWops */
+    if (offset < 0) {
+        offset = 0;
+    }
+    else if (offset > mem->size) {
+        offset = mem->size;
+    }
+    mem->pos = offset;
+    return offset;
+}
+
+static size_t
+_pg_rw_mem_read(SDL_RWops *context, void *ptr, size_t size, size_t maxnum)
+{
+    pgRWMemory *mem = (pgRWMemory *)context->hidden.unknown.data1;
+    size_t total = size * maxnum;
+    size_t avail = (size_t)(mem->size - mem->pos);
+
+    if (!size || total / size != maxnum) {
+        return 0;
+    }
+    if (total > avail) {
+        total = avail;
+    }
+    memcpy(ptr, mem->base + mem->pos, total);
+    mem->pos += total;
+    return total / size;
+}
+
+static size_t
+_pg_rw_mem_write(SDL_RWops *context, const void *ptr, size_t size,
+                 size_t num)
+{
+    SDL_SetError("Can't write to read-only memory");
+    return 0;
+}
+
+static int
+_pg_rw_mem_close(SDL_RWops *context)
+{
+    pgRWMemory *mem = (pgRWMemory *)context->hidden.unknown.data1;
+
+    if (mem->view.obj) {
+        PyGILState_STATE state = PyGILState_Ensure();
+        PyBuffer_Release(&mem->view);
+        PyGILState_Release(state);
+    }
+#ifdef PG_RW_MMAP
+    else {
+        _pg_rw_unmap(mem->base, mem->size);
+    }
+#endif
+    free(mem);
+    SDL_FreeRW(context);
+    return 0;
+}
+
+/* Takes ownership of mem on success only */
+static SDL_RWops *
+_pg_rw_from_memory(pgRWMemory *mem)
+{
+    SDL_RWops *rw = SDL_AllocRW();
+
+    if (rw == NULL) {
+        return NULL;
+    }
+    rw->hidden.unknown.data1 = (void *)mem;
+    rw->size = _pg_rw_mem_size;
+    rw->seek = _pg_rw_mem_seek;
+    rw->read = _pg_rw_mem_read;
+    rw->write = _pg_rw_mem_write;
+    rw->close = _pg_rw_mem_close;
+    return rw;
+}
+
+static SDL_RWops *
+pgRWops_FromBuffer(PyObject *obj)
+{
+    pgRWMemory *mem;
+    SDL_RWops *rw;
+
+    mem = (pgRWMemory *)calloc(1, sizeof(pgRWMemory));
+    if (mem == NULL) {
+        return (SDL_RWops *)PyErr_NoMemory();
+    }
+    if (PyObject_GetBuffer(obj, &mem->view, PyBUF_SIMPLE)) {
+        free(mem);
+        return NULL;
+    }
+    mem->base = (const char *)mem->view.buf;
+    mem->size = (Sint64)mem->view.len;
+
+    rw = _pg_rw_from_memory(mem);
+    if (rw == NULL) {
+        PyBuffer_Release(&mem->view);
+        free(mem);
+        return (SDL_RWops *)PyErr_NoMemory();
+    }
+    return rw;
+}
+
+#ifdef PG_RW_MMAP
+/* Map a regular file read-only. Returns NULL without an exception when
+ * the file can't be mapped (missing, empty, not a regular file, too large
+ * for the address space) so the caller can fall back to SDL's stdio RWops.
+ */
+static SDL_RWops *
+_pg_rw_map_file(const char *path)
+{
+    pgRWMemory *mem;
+    SDL_RWops *rw;
+    const char *base = NULL;
+    Sint64 size = 0;
+#ifdef MS_WIN32
+    HANDLE file, mapping;
+    LARGE_INTEGER length;
+    wchar_t *wpath;
+    int wlen = MultiByteToWideChar(CP_UTF8, 0, path, -1, NULL, 0);
+
+    if (wlen <= 0 || !(wpath = malloc(wlen * sizeof(wchar_t)))) {
+        return NULL;
+    }
+    MultiByteToWideChar(CP_UTF8, 0, path, -1, wpath, wlen);
+    file = CreateFileW(wpath, GENERIC_READ, FILE_SHARE_READ, NULL,
+                       OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    free(wpath);
+    if (file == INVALID_HANDLE_VALUE) {
+        return NULL;
+    }
+    if (GetFileType(file) == FILE_TYPE_DISK &&
+        GetFileSizeEx(file, &length) && length.QuadPart > 0 &&
+        (Uint64)length.QuadPart <= (Uint64)SIZE_MAX) {
+        mapping = CreateFileMappingW(file, NULL, PAGE_READONLY, 0, 0, NULL);
+        if (mapping) {
+            base = (const char *)MapViewOfFile(mapping, FILE_MAP_READ, 0, 0,
+                                               0);
+            size = (Sint64)length.QuadPart;
+            /* the view keeps the mapping alive */
+            CloseHandle(mapping);
+        }
+    }
+    CloseHandle(file);
+#else
+    struct stat st;
+    void *addr;
+    int fd = open(path, O_RDONLY);
+
+    if (fd < 0) {
+        return NULL;
+    }
+    if (!fstat(fd, &st) && S_ISREG(st.st_mode) && st.st_size > 0 &&
+        (Uint64)st.st_size <= (Uint64)SIZE_MAX) {
+        addr = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (addr != MAP_FAILED) {
+            base = (const char *)addr;
+            size = (Sint64)st.st_size;
+        }
+    }
+    close(fd);
+#endif
+    if (base == NULL) {
+        return NULL;
+    }
+
+    mem = (pgRWMemory *)calloc(1, sizeof(pgRWMemory));
+    if (mem == NULL || (rw = _pg_rw_from_memory(mem)) == NULL) {
+        free(mem);
+        _pg_rw_unmap(base, size);
+        return NULL;
+    }
+    mem->base = base;
+    mem->size = size;
+    return rw;
+}
+#endif /* PG_RW_MMAP */
+
 static SDL_RWops *
 _rwops_from_pystr(PyObject *obj, char **extptr)
 {
@@ -567,7 +804,11 @@ _rwops_from_pystr(PyObject *obj, char **extptr)
     }
 
     encoded = PyBytes_AS_STRING(oencoded);
-    rw = SDL_RWFromFile(encoded, "rb");
+#ifdef PG_RW_MMAP
+    rw = _pg_rw_map_file(encoded);
+    if (rw == NULL)
+#endif
+        rw = SDL_RWFromFile(encoded, "rb");
 
     if (rw) {
         /* If a valid extptr has been passed, populate it with a dynamically
@@ -649,6 +890,9 @@ again:
     else {
         return rw;
     }
+    if (!retry && PyObject_CheckBuffer(obj)) {
+        return pgRWops_FromBuffer(obj);
+    }
 
 fail:
     if (retry)
@@ -671,6 +915,10 @@ fail:
     else {
         return rw;
     }
+    /* bytes were taken as a path above, other buffers hold file data */
+    if (PyObject_CheckBuffer(obj)) {
+        return pgRWops_FromBuffer(obj);
+    }
     return pgRWops_FromFileObject(obj);
 #endif
 }
@@ -741,6 +989,10 @@ MODINIT_DEFINE(rwobject)
     if (module == NULL) {
         return NULL;
     }
+    if (PG_GIL_NOT_USED(module)) {
+        Py_DECREF(module);
+        return NULL;
+    }
 
     /* export the c api */
     c_api[0] = pgRWops_FromObject;
@@ -748,6 +1000,7 @@ MODINIT_DEFINE(rwobject)
     c_api[2] = pg_EncodeFilePath;
     c_api[3] = pg_EncodeString;
     c_api[4] = pgRWops_FromFileObject;
+    c_api[5] = pgRWops_FromBuffer;
     apiobj = encapsulate_api(c_api, "rwobject");
     if (PyModule_AddObject(module, PYGAMEAPI_LOCAL_ENTRY, apiobj)) {
         Py_XDECREF(apiobj);
@@ -28,11 +28,17 @@
    an astonishing job of doubling game graphic data while interpolating out
    the jaggies. Congrats to the AdvanceMAME team, I'm very impressed and
    surprised with this code!
+
+   Scale3x follows the same page, Scale4x is Scale2x applied twice.
 */
 
-#include <SDL.h>
-#define MAX(a, b) (((a) > (b)) ? (a) : (b))
-#define MIN(a, b) (((a) < (b)) ? (a) : (b))
+/* first, simd_transform.h would leave out the surface C API */
+#include "_surface.h"
+#include "simd_transform.h"
+
+#define SCALENX_MAX_THREADS 16
+#define SCALENX_THREAD_MIN_ROWS 16
+#define SCALENX_THREAD_MIN_PIXELS (1 << 16)
 
 static inline int
 read_int24(const Uint8 *x)
@@ -48,188 +54,355 @@ store_int24(Uint8 *x, int i)
     x[2] = i & 0xff;
 }
 
-/*
-  this requires a destination surface already setup to be twice as
-  large as the source. oh, and formats must match too. this will just
-  blindly assume you didn't flounder.
-*/
+/* The scalers work on rows of 32 bit pixels. 32 bit surfaces are used in
+ * place, rows of other depths are first widened into scratch rows and the
+ * scaled rows narrowed again. Only whether two pixels are equal matters, so
+ * this gives the same result as working on the pixels directly.
+ */
+
+/* E is the pixel, B, D, F and H its neighbours above, left, right and below.
+ */
+static inline void
+_scalenx_2x(Uint32 B, Uint32 D, Uint32 E, Uint32 F, Uint32 H, Uint32 *d0,
+            Uint32 *d1)
+{
+    int edge = B != H && D != F;
+
+    d0[0] = edge && D == B ? D : E;
+    d0[1] = edge && B == F ? F : E;
+    d1[0] = edge && D == H ? D : E;
+    d1[1] = edge && H == F ? F : E;
+}
+
+/* The AdvanceMAME Scale3x rules, with A, C, G and I the corner neighbours */
+static inline void
+_scalenx_3x(Uint32 A, Uint32 B, Uint32 C, Uint32 D, Uint32 E, Uint32 F,
+            Uint32 G, Uint32 H, Uint32 I, Uint32 *d0, Uint32 *d1, Uint32 *d2)
+{
+    int edge = B != H && D != F;
+    int db = edge && D == B, bf = edge && B == F;
+    int dh = edge && D == H, hf = edge && H == F;
+
+    d0[0] = db ? D : E;
+    d0[1] = (db && E != C) || (bf && E != A) ? B : E;
+    d0[2] = bf ? F : E;
+    d1[0] = (db && E != G) || (dh && E != A) ? D : E;
+    d1[1] = E;
+    d1[2] = (bf && E != I) || (hf && E != C) ? F : E;
+    d2[0] = dh ? D : E;
+    d2[1] = (dh && E != I) || (hf && E != G) ? H : E;
+    d2[2] = hf ? F : E;
+}
 
 void
-scale2x(SDL_Surface *src, SDL_Surface *dst)
+scale2x_row(const Uint32 *prev, const Uint32 *cur, const Uint32 *next,
+            Uint32 *dst0, Uint32 *dst1, int n)
 {
-    int looph, loopw;
+    int x;
 
-    Uint8 *srcpix = (Uint8 *)src->pixels;
-    Uint8 *dstpix = (Uint8 *)dst->pixels;
+    for (x = 0; x < n; ++x) {
+        _scalenx_2x(prev[x], cur[x - 1], cur[x], cur[x + 1], next[x],
+                    dst0 + 2 * x, dst1 + 2 * x);
+    }
+}
 
-    const int srcpitch = src->pitch;
-    const int dstpitch = dst->pitch;
-    const int width = src->w;
-    const int height = src->h;
+void
+scale3x_row(const Uint32 *prev, const Uint32 *cur, const Uint32 *next,
+            Uint32 *dst0, Uint32 *dst1, Uint32 *dst2, int n)
+{
+    int x;
 
-#if SDL_VERSION_ATLEAST(3, 0, 0)
-    const Uint8 Bpp = src->format->bytes_per_pixel;
-#else
-    const Uint8 Bpp = src->format->BytesPerPixel;
-#endif
+    for (x = 0; x < n; ++x) {
+        _scalenx_3x(prev[x - 1], prev[x], prev[x + 1], cur[x - 1], cur[x],
+                    cur[x + 1], next[x - 1], next[x], next[x + 1],
+                    dst0 + 3 * x, dst1 + 3 * x, dst2 + 3 * x);
+    }
+}
 
-    switch (Bpp) {
-        case 1: {
-            Uint8 E0, E1, E2, E3, B, D, E, F, H;
-            for (looph = 0; looph < height; ++looph) {
-                Uint8 *src_row = srcpix + looph * srcpitch;
-                Uint8 *dst_row0 = dstpix + looph * 2 * dstpitch;
-                Uint8 *dst_row1 = dstpix + (looph * 2 + 1) * dstpitch;
-
-                Uint8 *src_row_prev = srcpix + MAX(0, looph - 1) * srcpitch;
-                Uint8 *src_row_next =
-                    srcpix + MIN(height - 1, looph + 1) * srcpitch;
-
-                for (loopw = 0; loopw < width; ++loopw) {
-                    B = *(Uint8 *)(src_row_prev + loopw);
-                    D = *(Uint8 *)(src_row + MAX(0, loopw - 1));
-                    E = *(Uint8 *)(src_row + loopw);
-                    F = *(Uint8 *)(src_row + MIN(width - 1, loopw + 1));
-                    H = *(Uint8 *)(src_row_next + loopw);
-
-                    if (B != H && D != F) {
-                        E0 = (D == B) ? D : E;
-                        E1 = (B == F) ? F : E;
-                        E2 = (D == H) ? D : E;
-                        E3 = (H == F) ? F : E;
-                    }
-                    else {
-                        E0 = E;
-                        E1 = E;
-                        E2 = E;
-                        E3 = E;
-                    }
-
-                    *(Uint8 *)(dst_row0 + loopw * 2) = E0;
-                    *(Uint8 *)(dst_row0 + loopw * 2 + 1) = E1;
-                    *(Uint8 *)(dst_row1 + loopw * 2) = E2;
-                    *(Uint8 *)(dst_row1 + loopw * 2 + 1) = E3;
+/* A whole row, the first and last pixels have themselves as the missing
+ * neighbours. */
+static void
+_scalenx_row2x(SCALE2X_ROW_P row_func, const Uint32 *prev, const Uint32 *cur,
+               const Uint32 *next, Uint32 *dst0, Uint32 *dst1, int width)
+{
+    int last = width - 1;
+
+    if (width == 1) {
+        dst0[0] = dst0[1] = dst1[0] = dst1[1] = cur[0];
+        return;
+    }
+    _scalenx_2x(prev[0], cur[0], cur[0], cur[1], next[0], dst0, dst1);
+    row_func(prev + 1, cur + 1, next + 1, dst0 + 2, dst1 + 2, width - 2);
+    _scalenx_2x(prev[last], cur[last - 1], cur[last], cur[last], next[last],
+                dst0 + 2 * last, dst1 + 2 * last);
+}
+
+static void
+_scalenx_row3x(SCALE3X_ROW_P row_func, const Uint32 *prev, const Uint32 *cur,
+               const Uint32 *next, Uint32 *dst0, Uint32 *dst1, Uint32 *dst2,
+               int width)
+{
+    int last = width - 1;
+
+    if (width == 1) {
+        _scalenx_3x(prev[0], prev[0], prev[0], cur[0], cur[0], cur[0],
+                    next[0], next[0], next[0], dst0, dst1, dst2);
+        return;
+    }
+    _scalenx_3x(prev[0], prev[0], prev[1], cur[0], cur[0], cur[1], next[0],
+                next[0], next[1], dst0, dst1, dst2);
+    row_func(prev + 1, cur + 1, next + 1, dst0 + 3, dst1 + 3, dst2 + 3,
+             width - 2);
+    _scalenx_3x(prev[last - 1], prev[last], prev[last], cur[last - 1],
+                cur[last], cur[last], next[last - 1], next[last], next[last],
+                dst0 + 3 * last, dst1 + 3 * last, dst2 + 3 * last);
+}
+
+typedef struct {
+    const Uint8 *srcpix;
+    Uint8 *dstpix;
+    int srcpitch;
+    int dstpitch;
+    int width;
+    int height;
+    int bpp;
+    int factor;
+    SCALE2X_ROW_P row2x;
+    SCALE3X_ROW_P row3x;
+    int start; /* the band of source rows */
+    int end;
+    int failed;
+    /* the last source row widened into the ring, and the ring itself */
+    int unpacked;
+    Uint32 *ring[3];
+} pg_ScaleNxBand;
+
+static void
+_scalenx_unpack(pg_ScaleNxBand *band, int upto)
+{
+    upto = MIN(upto, band->height - 1);
+    while (band->unpacked < upto) {
+        int y = ++band->unpacked, x;
+        const Uint8 *src = band->srcpix + (Sint64)y * band->srcpitch;
+        Uint32 *row = band->ring[y % 3];
+
+        switch (band->bpp) {
+            case 1:
+                for (x = 0; x < band->width; ++x) {
+                    row[x] = src[x];
+                }
+                break;
+            case 2:
+                for (x = 0; x < band->width; ++x) {
+                    row[x] = ((const Uint16 *)src)[x];
+                }
+                break;
+            case 3:
+                for (x = 0; x < band->width; ++x) {
+                    row[x] = read_int24(src + 3 * x);
                 }
+                break;
+        }
+    }
+}
+
+/* Source row y, clamped to the surface, after it has been unpacked */
+static const Uint32 *
+_scalenx_row(pg_ScaleNxBand *band, int y)
+{
+    y = MAX(0, MIN(band->height - 1, y));
+    if (band->bpp == 4) {
+        return (const Uint32 *)(band->srcpix + (Sint64)y * band->srcpitch);
+    }
+    return band->ring[y % 3];
+}
+
+/* Where scaled row y of the destination is written */
+static Uint32 *
+_scalenx_out(pg_ScaleNxBand *band, Uint32 *scratch, int y, int i)
+{
+    if (band->bpp == 4) {
+        return (Uint32 *)(band->dstpix + (Sint64)y * band->dstpitch);
+    }
+    return scratch + (Sint64)i * band->width * band->factor;
+}
+
+static void
+_scalenx_pack(pg_ScaleNxBand *band, const Uint32 *row, int y)
+{
+    Uint8 *dst = band->dstpix + (Sint64)y * band->dstpitch;
+    int x, width = band->width * band->factor;
+
+    switch (band->bpp) {
+        case 1:
+            for (x = 0; x < width; ++x) {
+                dst[x] = (Uint8)row[x];
             }
             break;
-        }
-        case 2: {
-            Uint16 E0, E1, E2, E3, B, D, E, F, H;
-            for (looph = 0; looph < height; ++looph) {
-                Uint8 *src_row = srcpix + looph * srcpitch;
-                Uint8 *dst_row0 = dstpix + looph * 2 * dstpitch;
-                Uint8 *dst_row1 = dstpix + (looph * 2 + 1) * dstpitch;
-
-                Uint8 *src_row_prev = srcpix + MAX(0, looph - 1) * srcpitch;
-                Uint8 *src_row_next =
-                    srcpix + MIN(height - 1, looph + 1) * srcpitch;
-
-                for (loopw = 0; loopw < width; ++loopw) {
-                    B = *(Uint16 *)(src_row_prev + 2 * loopw);
-                    D = *(Uint16 *)(src_row + 2 * MAX(0, loopw - 1));
-                    E = *(Uint16 *)(src_row + 2 * loopw);
-                    F = *(Uint16 *)(src_row + 2 * MIN(width - 1, loopw + 1));
-                    H = *(Uint16 *)(src_row_next + 2 * loopw);
-
-                    if (B != H && D != F) {
-                        E0 = (D == B) ? D : E;
-                        E1 = (B == F) ? F : E;
-                        E2 = (D == H) ? D : E;
-                        E3 = (H == F) ? F : E;
-                    }
-                    else {
-                        E0 = E;
-                        E1 = E;
-                        E2 = E;
-                        E3 = E;
-                    }
-
-                    *(Uint16 *)(dst_row0 + loopw * 2 * 2) = E0;
-                    *(Uint16 *)(dst_row0 + (loopw * 2 + 1) * 2) = E1;
-                    *(Uint16 *)(dst_row1 + loopw * 2 * 2) = E2;
-                    *(Uint16 *)(dst_row1 + (loopw * 2 + 1) * 2) = E3;
-                }
+        case 2:
+            for (x = 0; x < width; ++x) {
+                ((Uint16 *)dst)[x] = (Uint16)row[x];
             }
             break;
-        }
-        case 3: {
-            int E0, E1, E2, E3, B, D, E, F, H;
-            for (looph = 0; looph < height; ++looph) {
-                Uint8 *src_row = srcpix + looph * srcpitch;
-                Uint8 *dst_row0 = dstpix + looph * 2 * dstpitch;
-                Uint8 *dst_row1 = dstpix + (looph * 2 + 1) * dstpitch;
-
-                Uint8 *src_row_prev = srcpix + MAX(0, looph - 1) * srcpitch;
-                Uint8 *src_row_next =
-                    srcpix + MIN(height - 1, looph + 1) * srcpitch;
-
-                for (loopw = 0; loopw < width; ++loopw) {
-                    B = read_int24(src_row_prev + (3 * loopw));
-                    D = read_int24(src_row + (3 * MAX(0, loopw - 1)));
-                    E = read_int24(src_row + (3 * loopw));
-                    F = read_int24(src_row + (3 * MIN(width - 1, loopw + 1)));
-                    H = read_int24(src_row_next + (3 * loopw));
-
-                    if (B != H && D != F) {
-                        E0 = (D == B) ? D : E;
-                        E1 = (B == F) ? F : E;
-                        E2 = (D == H) ? D : E;
-                        E3 = (H == F) ? F : E;
-                    }
-                    else {
-                        E0 = E;
-                        E1 = E;
-                        E2 = E;
-                        E3 = E;
-                    }
-
-                    store_int24(dst_row0 + loopw * 2 * 3, E0);
-                    store_int24(dst_row0 + (loopw * 2 + 1) * 3, E1);
-                    store_int24(dst_row1 + loopw * 2 * 3, E2);
-                    store_int24(dst_row1 + (loopw * 2 + 1) * 3, E3);
-                }
+        case 3:
+            for (x = 0; x < width; ++x) {
+                store_int24(dst + 3 * x, row[x]);
             }
             break;
+    }
+}
+
+static void
+_scalenx_band(void *data, int band_index)
+{
+    pg_ScaleNxBand *band = (pg_ScaleNxBand *)data + band_index;
+    const int width = band->width, factor = band->factor;
+    const int packed = band->bpp != 4;
+    size_t size = 0;
+    Uint32 *scratch = NULL, *out, *pairs = NULL, *pair[3], *rows[4];
+    int y, i;
+
+    /* Scale4x is Scale2x twice. The doubled rows of three source rows are
+     * kept, the ones above, at and below the current row. */
+    if (factor == 4) {
+        size += (size_t)6 * 2 * width;
+    }
+    if (packed) {
+        size += (size_t)3 * width + (size_t)factor * factor * width;
+    }
+    if (size) {
+        scratch = (Uint32 *)malloc(size * sizeof(Uint32));
+        if (!scratch) {
+            band->failed = 1;
+            return;
         }
-        default: {
-            Uint32 E0, E1, E2, E3, B, D, E, F, H;
-
-            for (looph = 0; looph < height; ++looph) {
-                Uint8 *src_row = srcpix + looph * srcpitch;
-                Uint8 *dst_row0 = dstpix + looph * 2 * dstpitch;
-                Uint8 *dst_row1 = dstpix + (looph * 2 + 1) * dstpitch;
-
-                Uint8 *src_row_prev = srcpix + MAX(0, looph - 1) * srcpitch;
-                Uint8 *src_row_next =
-                    srcpix + MIN(height - 1, looph + 1) * srcpitch;
-
-                for (loopw = 0; loopw < width; ++loopw) {
-                    B = *(Uint32 *)(src_row_prev + 4 * loopw);
-                    D = *(Uint32 *)(src_row + 4 * MAX(0, loopw - 1));
-                    E = *(Uint32 *)(src_row + 4 * loopw);
-                    F = *(Uint32 *)(src_row + 4 * MIN(width - 1, loopw + 1));
-                    H = *(Uint32 *)(src_row_next + 4 * loopw);
-
-                    if (B != H && D != F) {
-                        E0 = (D == B) ? D : E;
-                        E1 = (B == F) ? F : E;
-                        E2 = (D == H) ? D : E;
-                        E3 = (H == F) ? F : E;
-                    }
-                    else {
-                        E0 = E;
-                        E1 = E;
-                        E2 = E;
-                        E3 = E;
-                    }
-
-                    *(Uint32 *)(dst_row0 + loopw * 2 * 4) = E0;
-                    *(Uint32 *)(dst_row0 + (loopw * 2 + 1) * 4) = E1;
-                    *(Uint32 *)(dst_row1 + loopw * 2 * 4) = E2;
-                    *(Uint32 *)(dst_row1 + (loopw * 2 + 1) * 4) = E3;
-                }
+    }
+    out = scratch;
+    if (factor == 4) {
+        pairs = scratch;
+        out += 6 * 2 * width;
+        for (i = 0; i < 3; ++i) {
+            pair[i] = pairs + (size_t)i * 4 * width;
+        }
+    }
+    if (packed) {
+        for (i = 0; i < 3; ++i) {
+            band->ring[i] = out + (size_t)i * width;
+        }
+        out += 3 * width;
+    }
+
+    band->unpacked = MAX(0, band->start - (factor == 4 ? 2 : 1)) - 1;
+    if (factor == 4) {
+        for (y = MAX(0, band->start - 1); y <= band->start; ++y) {
+            _scalenx_unpack(band, y + 1);
+            _scalenx_row2x(band->row2x, _scalenx_row(band, y - 1),
+                           _scalenx_row(band, y), _scalenx_row(band, y + 1),
+                           pair[y % 3], pair[y % 3] + 2 * width, width);
+        }
+    }
+
+    for (y = band->start; y < band->end; ++y) {
+        for (i = 0; i < factor; ++i) {
+            rows[i] = _scalenx_out(band, out, y * factor + i, i);
+        }
+        if (factor == 4) {
+            /* the doubled rows 2y - 1 to 2y + 2, clamped to the image */
+            const Uint32 *cur = pair[y % 3], *above, *below;
+
+            if (y + 1 < band->height) {
+                _scalenx_unpack(band, y + 2);
+                _scalenx_row2x(band->row2x, _scalenx_row(band, y),
+                               _scalenx_row(band, y + 1),
+                               _scalenx_row(band, y + 2), pair[(y + 1) % 3],
+                               pair[(y + 1) % 3] + 2 * width, width);
+                below = pair[(y + 1) % 3];
+            }
+            else {
+                below = cur + 2 * width;
+            }
+            above = y > 0 ? pair[(y - 1) % 3] + 2 * width : cur;
+            _scalenx_row2x(band->row2x, above, cur, cur + 2 * width, rows[0],
+                           rows[1], 2 * width);
+            _scalenx_row2x(band->row2x, cur, cur + 2 * width, below, rows[2],
+                           rows[3], 2 * width);
+        }
+        else {
+            _scalenx_unpack(band, y + 1);
+            if (factor == 2) {
+                _scalenx_row2x(band->row2x, _scalenx_row(band, y - 1),
+                               _scalenx_row(band, y),
+                               _scalenx_row(band, y + 1), rows[0], rows[1],
+                               width);
+            }
+            else {
+                _scalenx_row3x(band->row3x, _scalenx_row(band, y - 1),
+                               _scalenx_row(band, y),
+                               _scalenx_row(band, y + 1), rows[0], rows[1],
+                               rows[2], width);
+            }
+        }
+        if (packed) {
+            for (i = 0; i < factor; ++i) {
+                _scalenx_pack(band, rows[i], y * factor + i);
             }
-            break;
         }
     }
+
+    free(scratch);
+}
+
+/*
+  this requires a destination surface already setup to be factor times as
+  large as the source, with a factor of 2, 3 or 4. oh, and formats must
+  match too. this will just blindly assume you didn't flounder.
+
+  The rows are split into bands scaled by up to num_threads threads, with
+  the given row kernels for 32 bit pixels. Returns
+  -1 if scratch memory could not be allocated. Must be called without the
+  GIL.
+*/
+int
+scalenx(SDL_Surface *src, SDL_Surface *dst, int factor, int num_threads,
+        SCALE2X_ROW_P row2x, SCALE3X_ROW_P row3x)
+{
+    pg_ScaleNxBand bands[SCALENX_MAX_THREADS];
+    const int height = src->h;
+    int nbands, i, failed = 0;
+
+    if (src->w == 0 || height == 0) {
+        return 0;
+    }
+    nbands = MIN(MIN(num_threads, SCALENX_MAX_THREADS),
+                 height / SCALENX_THREAD_MIN_ROWS);
+    if ((Sint64)dst->w * dst->h < SCALENX_THREAD_MIN_PIXELS) {
+        nbands = 1;
+    }
+    nbands = MAX(nbands, 1);
+
+    for (i = 0; i < nbands; ++i) {
+        bands[i].srcpix = (const Uint8 *)src->pixels;
+        bands[i].dstpix = (Uint8 *)dst->pixels;
+        bands[i].srcpitch = src->pitch;
+        bands[i].dstpitch = dst->pitch;
+        bands[i].width = src->w;
+        bands[i].height = height;
+#if SDL_VERSION_ATLEAST(3, 0, 0)
+        bands[i].bpp = src->format->bytes_per_pixel;
+#else
+        bands[i].bpp = src->format->BytesPerPixel;
+#endif
+        bands[i].factor = factor;
+        bands[i].row2x = row2x;
+        bands[i].row3x = row3x;
+        bands[i].start = (int)((Sint64)height * i / nbands);
+        bands[i].end = (int)((Sint64)height * (i + 1) / nbands);
+        bands[i].failed = 0;
+    }
+
+    pg_run_bands(_scalenx_band, bands, nbands);
+    for (i = 0; i < nbands; ++i) {
+        failed |= bands[i].failed;
+    }
+    return failed ? -1 : 0;
 }
@@ -0,0 +1,50 @@
+#ifndef SIMD_565_H
+#define SIMD_565_H
+
+/* Helpers of the SSE2/NEON kernels for RGB565 and BGR565 surfaces, the
+ * framebuffer format of many small devices. The kernels widen the 5 and 6
+ * bit channels to 8 bits the way SDL_GetRGB() does, blend them like the
+ * scalar code and narrow the results by dropping the low bits, like
+ * CREATE_PIXEL(). The SIMD macros need the intrinsics headers included
+ * first. */
+
+#include "_surface.h"
+
+/* Whether fmt is RGB565 or BGR565, and SDL_GetRGB() widens its channels
+ * like PG_WIDEN_5() and PG_WIDEN_6() */
+int
+pg_has_simd_565_format(SDL_PixelFormat *fmt);
+
+/* floor(v * 255 / 31) and floor(v * 255 / 63) */
+#define PG_WIDEN_5(v) (((v) * 2106) >> 8)
+#define PG_WIDEN_6(v) (((v) << 2) + (((v) * 49) >> 10))
+
+/* The same on the 16 bit lanes of an __m128i */
+#define PG_MM_WIDEN_5(v) \
+    _mm_srli_epi16(_mm_mullo_epi16((v), _mm_set1_epi16(2106)), 8)
+#define PG_MM_WIDEN_6(v)                  \
+    _mm_add_epi16(_mm_slli_epi16((v), 2), \
+                  _mm_srli_epi16(         \
+                      _mm_mullo_epi16((v), _mm_set1_epi16(49)), 10))
+
+/* Splits the 8 pixels in d into their widened channels, one per 16 bit
+ * lane. rshift and bshift hold the R and B shifts in their low 64 bits. */
+#define PG_MM_UNPACK_565(d, r, g, b, rshift, bshift)                      \
+    r = PG_MM_WIDEN_5(                                                    \
+        _mm_and_si128(_mm_srl_epi16(d, rshift), _mm_set1_epi16(0x1F)));  \
+    g = PG_MM_WIDEN_6(                                                    \
+        _mm_and_si128(_mm_srli_epi16(d, 5), _mm_set1_epi16(0x3F)));      \
+    b = PG_MM_WIDEN_5(                                                    \
+        _mm_and_si128(_mm_srl_epi16(d, bshift), _mm_set1_epi16(0x1F)));
+
+/* The 8 pixels of the 8 bit channels r, g and b */
+#define PG_MM_PACK_565(r, g, b, rshift, bshift)                        \
+    _mm_or_si128(                                                      \
+        _mm_or_si128(_mm_sll_epi16(_mm_srli_epi16(r, 3), rshift),     \
+                     _mm_slli_epi16(_mm_srli_epi16(g, 2), 5)),        \
+        _mm_sll_epi16(_mm_srli_epi16(b, 3), bshift))
+
+#define PG_PACK_565(r, g, b, rshift, bshift) \
+    (Uint16)(((r) >> 3) << (rshift) | ((g) >> 2) << 5 | ((b) >> 3) << (bshift))
+
+#endif /* SIMD_565_H */
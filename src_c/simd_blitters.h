@@ -37,6 +37,14 @@ void
 blit_blend_rgb_min_sse2(SDL_BlitInfo *info);
 void
 blit_blend_premultiplied_sse2(SDL_BlitInfo *info);
+void
+blit_blend_custom_sse2(SDL_BlitInfo *info);
+void
+alphablit_solid_sse2_argb(SDL_BlitInfo *info);
+void
+alphablit_colorkey_sse2_argb(SDL_BlitInfo *info);
+void
+alphablit_alpha_sse2_argb_565(SDL_BlitInfo *info);
 #endif /* (defined(__SSE2__) || defined(PG_ENABLE_ARM_NEON)) */
 
 /* Deliberately putting these outside of the preprocessor guards as I want to
@@ -82,4 +90,8 @@ blit_blend_rgb_min_avx2(SDL_BlitInfo *info);
 void
 blit_blend_premultiplied_avx2(SDL_BlitInfo *info);
 void
+alphablit_solid_avx2_argb(SDL_BlitInfo *info);
+void
+alphablit_colorkey_avx2_argb(SDL_BlitInfo *info);
+void
 premul_surf_color_by_alpha_avx2(SDL_Surface *src, SDL_Surface *dst);
@@ -19,7 +19,7 @@ pg_has_avx2()
 {
 #if defined(__AVX2__) && defined(HAVE_IMMINTRIN_H) && \
     !defined(SDL_DISABLE_IMMINTRIN_H)
-    return SDL_HasAVX2();
+    return pg_simd_max_level() >= PG_SIMD_AVX2 && SDL_HasAVX2();
 #else
     return 0;
 #endif /* defined(__AVX2__) && defined(HAVE_IMMINTRIN_H) && \
@@ -93,17 +93,17 @@ pg_avx2_at_runtime_but_uncompiled()
  * Operation: BLITTER_CODE takes pixels_src and pixels_dst and puts processed
  * results into pixels_dst
  */
-#define RUN_AVX2_BLITTER(BLITTER_CODE)                                       \
+#define RUN_AVX2_BLITTER_ROWS(BLITTER_CODE, LOAD, STORE)                     \
     while (height--) {                                                       \
         for (int i = post_8_width; i > 0; i--) {                             \
             /* ==== load 8 pixels into AVX registers ==== */                 \
             pixels_src = _mm256_loadu_si256(srcp256);                        \
-            pixels_dst = _mm256_loadu_si256(dstp256);                        \
+            pixels_dst = LOAD(dstp256);                                      \
                                                                              \
             {BLITTER_CODE}                                                   \
                                                                              \
             /* ==== store 8 pixels from AVX registers ==== */                \
-            _mm256_storeu_si256(dstp256, pixels_dst);                        \
+            STORE(dstp256, pixels_dst);                                      \
                                                                              \
             srcp256++;                                                       \
             dstp256++;                                                       \
@@ -127,6 +127,19 @@ pg_avx2_at_runtime_but_uncompiled()
         dstp256 = (__m256i *)(dstp + dstskip);                               \
     }
 
+/* Destination rows starting at 32 byte boundaries, as surfaces get them
+ * with pygame.surface.set_row_alignment(), take aligned loads and stores.
+ * The source may be anywhere. */
+#define RUN_AVX2_BLITTER(BLITTER_CODE)                                       \
+    if (PG_ROWS_ALIGNED(dstp, info->width * 4 + info->d_skip, 32)) {         \
+        RUN_AVX2_BLITTER_ROWS(BLITTER_CODE, _mm256_load_si256,               \
+                              _mm256_store_si256)                            \
+    }                                                                        \
+    else {                                                                   \
+        RUN_AVX2_BLITTER_ROWS(BLITTER_CODE, _mm256_loadu_si256,              \
+                              _mm256_storeu_si256)                           \
+    }
+
 /* Setup for RUN_16BIT_SHUFFLE_OUT */
 #define SETUP_16BIT_SHUFFLE_OUT                                               \
     __m256i shuff_out_A =                                                     \
@@ -358,12 +371,27 @@ alphablit_alpha_avx2_argb_surf_alpha(SDL_BlitInfo *info)
 
     __m256i modulate_alpha = _mm256_set1_epi16(info->src_blanket_alpha);
 
+    // The color modulation, in the 16 bit lanes of the color channels of a
+    // pixel, and 255 in the one of alpha to leave it alone.
+    int has_tint = info->src_has_tint;
+    __m256i tint = _mm256_set1_epi64x(
+        (Sint64)info->src_tint[0] << (info->src->Rshift * 2) |
+        (Sint64)info->src_tint[1] << (info->src->Gshift * 2) |
+        (Sint64)info->src_tint[2] << (info->src->Bshift * 2) |
+        (Sint64)255 << (info->src->Ashift * 2));
+
     /*
      dstRGB = (((dstRGB << 8) + (srcRGB - dstRGB) * srcA + srcRGB) >> 8)
      dstA = srcA + dstA - ((srcA * dstA) / 255);
      */
 
     RUN_AVX2_BLITTER(RUN_16BIT_SHUFFLE_OUT(
+        // srcRGB = srcRGB * tint / 255
+        if (has_tint) {
+            shuff_src = _mm256_mullo_epi16(shuff_src, tint);
+            shuff_src = DO_AVX2_DIV255_U16(shuff_src);
+        }
+
         src_alpha = _mm256_shuffle_epi8(shuff_src, shuff_out_alpha);
 
         // src_alpha = src_alpha * module_alpha / 255
@@ -1363,10 +1391,8 @@ blit_blend_premultiplied_avx2(SDL_BlitInfo *info)
                         mm_dst = _mm_unpacklo_epi8(mm_dst, mm_zero);
                         /*mm_dst = 0x000000000000000000AA00RR00GG00BB*/
 
-                        mm_alpha = _mm_cvtsi32_si128(alpha);
-                        /* alpha -> mm_alpha (000000000000A000) */
-                        mm_alpha = _mm_srli_si128(mm_alpha, 3);
-                        /* mm_alpha >> ashift -> mm_alpha(000000000000000A) */
+                        mm_alpha = _mm_cvtsi32_si128(alpha >> (8 * a_index));
+                        /* alpha >> ashift -> mm_alpha(000000000000000A) */
                         mm_alpha = _mm_unpacklo_epi16(mm_alpha, mm_alpha);
                         /* 0000000000000A0A -> mm_alpha */
                         mm_alpha = _mm_unpacklo_epi32(mm_alpha, mm_alpha);
@@ -1643,3 +1669,123 @@ premul_surf_color_by_alpha_avx2(SDL_Surface *src, SDL_Surface *dst)
 }
 #endif /* defined(__AVX2__) && defined(HAVE_IMMINTRIN_H) && \
 !defined(SDL_DISABLE_IMMINTRIN_H) */
+
+/* Setup for RUN_AVX2_SOLID_BLEND */
+#define SETUP_AVX2_SOLID_BLEND                                        \
+    const __m256i mm256_zero = _mm256_setzero_si256();                \
+    const __m256i mm256_ff = _mm256_set1_epi16(0x00FF);               \
+    const __m256i mm256_rgb_mask = _mm256_set1_epi32(                 \
+        info->dst->Rmask | info->dst->Gmask | info->dst->Bmask);      \
+    const __m256i mm256_amask = _mm256_set1_epi32(info->dst->Amask);  \
+    const __m128i mm_ashift = _mm_cvtsi32_si128(info->dst->Ashift);   \
+    const __m256i mm256_blanket_alpha =                               \
+        _mm256_set1_epi8((char)info->src_blanket_alpha);              \
+                                                                      \
+    __m256i mm256_alpha, mm256_dst_alpha, mm256_rgb_lo, mm256_rgb_hi, \
+        mm256_a_lo, mm256_a_hi, _sa16, _da16, _s16, _d16, _t16;
+
+#define _AVX2_SOLID_BLEND_HALF(UNPACK, OUT_RGB, OUT_A)                      \
+    _s16 = UNPACK(pixels_src, mm256_zero);                                  \
+    _d16 = UNPACK(pixels_dst, mm256_zero);                                  \
+    _sa16 = UNPACK(mm256_alpha, mm256_zero);                                \
+    _da16 = UNPACK(mm256_dst_alpha, mm256_zero);                            \
+                                                                            \
+    /* dstA = srcA + dstA - ((srcA * dstA) / 255) */                        \
+    _t16 = _mm256_mullo_epi16(_sa16, _da16);                                \
+    _t16 = DO_AVX2_DIV255_U16(_t16);                                        \
+    OUT_A = _mm256_sub_epi16(_mm256_add_epi16(_sa16, _da16), _t16);         \
+                                                                            \
+    /* a destination alpha of 0 takes the source color as it is */          \
+    _sa16 = _mm256_or_si256(                                                \
+        _sa16,                                                              \
+        _mm256_and_si256(_mm256_cmpeq_epi16(_da16, mm256_zero), mm256_ff)); \
+                                                                            \
+    /* dstRGB = ((dstRGB << 8) + (srcRGB - dstRGB) * srcA + srcRGB) >> 8 */ \
+    _t16 = _mm256_mullo_epi16(_mm256_sub_epi16(_s16, _d16), _sa16);         \
+    _t16 = _mm256_add_epi16(_t16, _s16);                                    \
+    _t16 = _mm256_add_epi16(_t16, _mm256_slli_epi16(_d16, 8));              \
+    OUT_RGB = _mm256_srli_epi16(_t16, 8);
+
+/* Interface definition
+ * Definitions needed: MACRO(SETUP_AVX2_BLITTER),
+ *                     MACRO(SETUP_AVX2_SOLID_BLEND)
+ * Input variables: pixels_src, pixels_dst (containing raw pixel data),
+ *                  mm256_alpha (the source alpha of each pixel, repeated in
+ *                  all four of its bytes)
+ * Output variables: pixels_dst (containing blended pixel data)
+ *
+ * Operation: blends a source without per pixel alpha onto the destination
+ * with the same results as ALPHA_BLEND() in surface.h, which is what the
+ * scalar alphablit_solid and alphablit_colorkey use. The source may be any
+ * 32 bit format with the same 8 bit RGB channels as the destination.
+ */
+#define RUN_AVX2_SOLID_BLEND                                               \
+    if (info->dst->Amask) {                                                \
+        mm256_dst_alpha =                                                  \
+            _mm256_and_si256(_mm256_srl_epi32(pixels_dst, mm_ashift),      \
+                             _mm256_set1_epi32(0xFF));                     \
+        mm256_dst_alpha = _mm256_or_si256(                                 \
+            mm256_dst_alpha, _mm256_slli_epi32(mm256_dst_alpha, 8));       \
+        mm256_dst_alpha = _mm256_or_si256(                                 \
+            mm256_dst_alpha, _mm256_slli_epi32(mm256_dst_alpha, 16));      \
+    }                                                                      \
+    else {                                                                 \
+        mm256_dst_alpha = _mm256_set1_epi32(-1);                           \
+    }                                                                      \
+                                                                           \
+    _AVX2_SOLID_BLEND_HALF(_mm256_unpacklo_epi8, mm256_rgb_lo, mm256_a_lo) \
+    _AVX2_SOLID_BLEND_HALF(_mm256_unpackhi_epi8, mm256_rgb_hi, mm256_a_hi) \
+                                                                           \
+    pixels_dst = _mm256_or_si256(                                          \
+        _mm256_and_si256(_mm256_packus_epi16(mm256_rgb_lo, mm256_rgb_hi),  \
+                         mm256_rgb_mask),                                  \
+        _mm256_and_si256(_mm256_packus_epi16(mm256_a_lo, mm256_a_hi),      \
+                         mm256_amask));
+
+#if defined(__AVX2__) && defined(HAVE_IMMINTRIN_H) && \
+    !defined(SDL_DISABLE_IMMINTRIN_H)
+void
+alphablit_solid_avx2_argb(SDL_BlitInfo *info)
+{
+    SETUP_AVX2_BLITTER
+    SETUP_AVX2_SOLID_BLEND
+
+    mm256_alpha = mm256_blanket_alpha;
+
+    RUN_AVX2_BLITTER(RUN_AVX2_SOLID_BLEND)
+}
+#else
+void
+alphablit_solid_avx2_argb(SDL_BlitInfo *info)
+{
+    BAD_AVX2_FUNCTION_CALL;
+}
+#endif /* defined(__AVX2__) && defined(HAVE_IMMINTRIN_H) && \
+          !defined(SDL_DISABLE_IMMINTRIN_H) */
+
+#if defined(__AVX2__) && defined(HAVE_IMMINTRIN_H) && \
+    !defined(SDL_DISABLE_IMMINTRIN_H)
+void
+alphablit_colorkey_avx2_argb(SDL_BlitInfo *info)
+{
+    SETUP_AVX2_BLITTER
+    SETUP_AVX2_SOLID_BLEND
+
+    const __m256i mm256_colorkey = _mm256_set1_epi32(info->src_colorkey);
+
+    RUN_AVX2_BLITTER(
+        /* pixels matching the colorkey are blended with an alpha of 0 */
+        mm256_alpha = _mm256_andnot_si256(
+            _mm256_cmpeq_epi32(pixels_src, mm256_colorkey),
+            mm256_blanket_alpha);
+
+        RUN_AVX2_SOLID_BLEND)
+}
+#else
+void
+alphablit_colorkey_avx2_argb(SDL_BlitInfo *info)
+{
+    BAD_AVX2_FUNCTION_CALL;
+}
+#endif /* defined(__AVX2__) && defined(HAVE_IMMINTRIN_H) && \
+          !defined(SDL_DISABLE_IMMINTRIN_H) */
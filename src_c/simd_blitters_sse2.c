@@ -1,4 +1,5 @@
 #include "simd_blitters.h"
+#include "simd_565.h"
 
 #if PG_ENABLE_ARM_NEON
 // sse2neon.h is from here: https://github.com/DLTcollab/sse2neon
@@ -164,6 +165,15 @@ alphablit_alpha_sse2_argb_surf_alpha(SDL_BlitInfo *info)
 
     Uint32 modulateA = info->src_blanket_alpha;
 
+    /* the color modulation, in the 16 bit lanes of the color channels of a
+     * pixel, and 255 in the one of alpha to leave it alone */
+    int has_tint = info->src_has_tint;
+    Uint64 tint = (Uint64)info->src_tint[0] << (srcfmt->Rshift * 2) |
+                  (Uint64)info->src_tint[1] << (srcfmt->Gshift * 2) |
+                  (Uint64)info->src_tint[2] << (srcfmt->Bshift * 2) |
+                  (Uint64)255 << (srcfmt->Ashift * 2);
+    __m128i mm_tint = _mm_loadl_epi64((const __m128i *)&tint);
+
     Uint64 rgb_mask;
 
     __m128i src1, dst1, sub_dst, mm_src_alpha;
@@ -189,7 +199,8 @@ alphablit_alpha_sse2_argb_surf_alpha(SDL_BlitInfo *info)
     while (height--) {
         LOOP_UNROLLED4(
             {
-                Uint32 src_alpha = (*srcp & src_amask);
+                Uint32 srcpx = *srcp;
+                Uint32 src_alpha = (srcpx & src_amask);
                 Uint32 dst_alpha = (*dstp & dst_amask) + dst_opaque;
                 /* modulate src_alpha - need to do it here for
                    accurate testing */
@@ -197,11 +208,22 @@ alphablit_alpha_sse2_argb_surf_alpha(SDL_BlitInfo *info)
                 src_alpha = (src_alpha * modulateA) / 255;
                 src_alpha = src_alpha << 24;
 
+                if (has_tint) {
+                    /* srcRGB = srcRGB * tint / 255 */
+                    src1 = _mm_unpacklo_epi8(_mm_cvtsi32_si128(srcpx),
+                                             mm_zero);
+                    src1 = _mm_mullo_epi16(src1, mm_tint);
+                    src1 = _mm_srli_epi16(
+                        _mm_mulhi_epu16(src1, _mm_set1_epi16((short)0x8081)),
+                        7);
+                    srcpx = _mm_cvtsi128_si32(_mm_packus_epi16(src1, mm_zero));
+                }
+
                 if ((src_alpha == src_amask) || (dst_alpha == 0)) {
                     /* 255 src alpha or 0 dst alpha
                        So copy src pixel over dst pixel, also copy
                        modulated alpha */
-                    *dstp = (*srcp & 0x00FFFFFF) | src_alpha;
+                    *dstp = (srcpx & 0x00FFFFFF) | src_alpha;
                 }
                 else {
                     /* Do the actual blend */
@@ -241,7 +263,7 @@ alphablit_alpha_sse2_argb_surf_alpha(SDL_BlitInfo *info)
                         _mm_unpacklo_epi32(rgb_src_alpha, rgb_src_alpha);
 
                     /* src(ARGB) -> src1 (000000000000ARGB) */
-                    src1 = _mm_cvtsi32_si128(*srcp);
+                    src1 = _mm_cvtsi32_si128(srcpx);
                     /* 000000000A0R0G0B -> src1 */
                     src1 = _mm_unpacklo_epi8(src1, mm_zero);
 
@@ -709,143 +731,407 @@ alphablit_alpha_sse2_argb_no_surf_alpha_opaque_dst(SDL_BlitInfo *info)
     }
 }
 
+/* sC + dC - ((dC + 1) * sA >> 8) of every channel of one pixel, like the
+ * vector loop below */
+static PG_INLINE Uint32
+_premul_blend_pixel(Uint32 src, Uint32 dst, Uint32 amask, int ashift)
+{
+    Uint32 alpha = (src & amask) >> ashift, out = 0, value;
+    int shift;
+
+    if (!alpha) {
+        return dst;
+    }
+    for (shift = 0; shift < 32; shift += 8) {
+        Uint32 sc = (src >> shift) & 0xFF, dc = (dst >> shift) & 0xFF;
+
+        value = sc + dc - (((dc + 1) * alpha) >> 8);
+        out |= (value > 255 ? 255 : value) << shift;
+    }
+    return out;
+}
+
 void
 blit_blend_premultiplied_sse2(SDL_BlitInfo *info)
 {
-    int n;
-    int width = info->width;
-    int height = info->height;
+    int i, height = info->height;
+    const int width = info->width;
+    const int n_iters_4 = width / 4;
+    const int pxl_excess = width % 4;
     Uint32 *srcp = (Uint32 *)info->s_pixels;
-    int srcskip = info->s_skip >> 2;
+    const int srcskip = info->s_skip >> 2;
     Uint32 *dstp = (Uint32 *)info->d_pixels;
-    int dstskip = info->d_skip >> 2;
-    SDL_PixelFormat *srcfmt = info->src;
-    Uint32 amask = srcfmt->Amask;
-    // Uint64 multmask;
-    Uint64 ones;
+    const int dstskip = info->d_skip >> 2;
+    const Uint32 amask = info->src->Amask;
+    const int ashift = info->src->Ashift;
 
-    // __m128i multmask_128;
-    __m128i src1, dst1, sub_dst, mm_alpha, mm_zero, ones_128;
+    const __m128i mm_amask = _mm_set1_epi32(amask);
+    const __m128i mm_ashift = _mm_cvtsi32_si128(ashift);
+    const __m128i mm_zero = _mm_setzero_si128();
+    const __m128i mm_ones = _mm_set1_epi16(0x0001);
+    __m128i mm_src, mm_dst, mm_alpha, mm_transparent, mm_alpha_lo,
+        mm_alpha_hi, mm_src_lo, mm_src_hi, mm_dst_lo, mm_dst_hi;
 
-    mm_zero = _mm_setzero_si128();
-    // multmask = 0x00FF00FF00FF00FF;  // 0F0F0F0F
-    // multmask_128 = _mm_loadl_epi64((const __m128i *)&multmask);
-    ones = 0x0001000100010001;
-    ones_128 = _mm_loadl_epi64((const __m128i *)&ones);
+    while (height--) {
+        /* 4 pixels at a time */
+        for (i = 0; i < n_iters_4; i++) {
+            mm_src = _mm_loadu_si128((__m128i *)srcp);
+            mm_dst = _mm_loadu_si128((__m128i *)dstp);
+
+            /* the source alpha of each pixel in all 4 of its 16 bit
+             * channels, pixels with none of it keep the destination */
+            mm_alpha = _mm_and_si128(mm_src, mm_amask);
+            mm_transparent = _mm_cmpeq_epi32(mm_alpha, mm_zero);
+            mm_alpha = _mm_srl_epi32(mm_alpha, mm_ashift);
+            mm_alpha = _mm_or_si128(mm_alpha, _mm_slli_epi32(mm_alpha, 16));
+            mm_alpha_lo = _mm_unpacklo_epi32(mm_alpha, mm_alpha);
+            mm_alpha_hi = _mm_unpackhi_epi32(mm_alpha, mm_alpha);
+
+            mm_src_lo = _mm_unpacklo_epi8(mm_src, mm_zero);
+            mm_src_hi = _mm_unpackhi_epi8(mm_src, mm_zero);
+            mm_dst_lo = _mm_unpacklo_epi8(mm_dst, mm_zero);
+            mm_dst_hi = _mm_unpackhi_epi8(mm_dst, mm_zero);
+
+            /* sC + dC - ((dC + 1) * sA >> 8) */
+            mm_src_lo = _mm_sub_epi16(
+                _mm_add_epi16(mm_src_lo, mm_dst_lo),
+                _mm_srli_epi16(_mm_mullo_epi16(
+                                   _mm_add_epi16(mm_dst_lo, mm_ones),
+                                   mm_alpha_lo),
+                               8));
+            mm_src_hi = _mm_sub_epi16(
+                _mm_add_epi16(mm_src_hi, mm_dst_hi),
+                _mm_srli_epi16(_mm_mullo_epi16(
+                                   _mm_add_epi16(mm_dst_hi, mm_ones),
+                                   mm_alpha_hi),
+                               8));
+            mm_src = _mm_packus_epi16(mm_src_lo, mm_src_hi);
+
+            mm_dst = _mm_or_si128(_mm_and_si128(mm_transparent, mm_dst),
+                                  _mm_andnot_si128(mm_transparent, mm_src));
+            _mm_storeu_si128((__m128i *)dstp, mm_dst);
+
+            srcp += 4;
+            dstp += 4;
+        }
+
+        /* up to 3 pixels at a time */
+        for (i = 0; i < pxl_excess; i++, srcp++, dstp++) {
+            *dstp = _premul_blend_pixel(*srcp, *dstp, amask, ashift);
+        }
+
+        srcp += srcskip;
+        dstp += dstskip;
+    }
+}
+
+/* The per blit state of the custom blend kernels below */
+typedef struct {
+    __m128i s_or;     /* sets the alpha byte of sources without alpha */
+    __m128i s_amask;  /* zero when the source has no alpha */
+    __m128i s_ashift;
+    __m128i d_amask;  /* zero when the destination has no alpha */
+    __m128i d_ashift;
+    __m128i keep;     /* the destination bytes written by the blend */
+    __m128i s_opaque; /* the source alpha when it has none, or zero */
+    __m128i d_opaque; /* the destination alpha when it has none, or zero */
+} pg_CustomBlendSSE2;
+
+/* x * factor / 255, rounded, of 8 16 bit channels */
+static PG_INLINE __m128i
+_custom_term_sse2(int factor, __m128i x, __m128i s, __m128i d, __m128i sa,
+                  __m128i da)
+{
+    const __m128i mm_255 = _mm_set1_epi16(0x00FF);
+    __m128i f;
+
+    switch (factor) {
+        case SDL_BLENDFACTOR_ONE:
+            return x;
+        case SDL_BLENDFACTOR_SRC_COLOR:
+            f = s;
+            break;
+        case SDL_BLENDFACTOR_ONE_MINUS_SRC_COLOR:
+            f = _mm_sub_epi16(mm_255, s);
+            break;
+        case SDL_BLENDFACTOR_SRC_ALPHA:
+            f = sa;
+            break;
+        case SDL_BLENDFACTOR_ONE_MINUS_SRC_ALPHA:
+            f = _mm_sub_epi16(mm_255, sa);
+            break;
+        case SDL_BLENDFACTOR_DST_COLOR:
+            f = d;
+            break;
+        case SDL_BLENDFACTOR_ONE_MINUS_DST_COLOR:
+            f = _mm_sub_epi16(mm_255, d);
+            break;
+        case SDL_BLENDFACTOR_DST_ALPHA:
+            f = da;
+            break;
+        case SDL_BLENDFACTOR_ONE_MINUS_DST_ALPHA:
+            f = _mm_sub_epi16(mm_255, da);
+            break;
+        default: /* SDL_BLENDFACTOR_ZERO */
+            return _mm_setzero_si128();
+    }
+    x = _mm_add_epi16(_mm_mullo_epi16(x, f), _mm_set1_epi16(0x0080));
+    return _mm_srli_epi16(_mm_add_epi16(x, _mm_srli_epi16(x, 8)), 8);
+}
+
+/* One blend equation of 8 16 bit channels, left unsaturated for packus */
+static PG_INLINE __m128i
+_custom_equation_sse2(int fsrc, int fdst, int op, __m128i s, __m128i d,
+                      __m128i sa, __m128i da)
+{
+    __m128i a = _custom_term_sse2(fsrc, s, s, d, sa, da);
+    __m128i b = _custom_term_sse2(fdst, d, s, d, sa, da);
+
+    switch (op) {
+        case SDL_BLENDOPERATION_SUBTRACT:
+            return _mm_sub_epi16(a, b);
+        case SDL_BLENDOPERATION_REV_SUBTRACT:
+            return _mm_sub_epi16(b, a);
+        default: /* SDL_BLENDOPERATION_ADD */
+            return _mm_add_epi16(a, b);
+    }
+}
+
+/* One blend equation of 4 pixels. sa and da hold the alpha of each pixel in
+ * its 32 bit lane. Like the GPU, minimum and maximum ignore the factors. */
+static PG_INLINE __m128i
+_custom_equation4_sse2(int fsrc, int fdst, int op, __m128i src, __m128i dst,
+                       __m128i sa, __m128i da)
+{
+    const __m128i mm_zero = _mm_setzero_si128();
+    __m128i lo, hi;
+
+    if (op == SDL_BLENDOPERATION_MINIMUM) {
+        return _mm_min_epu8(src, dst);
+    }
+    if (op == SDL_BLENDOPERATION_MAXIMUM) {
+        return _mm_max_epu8(src, dst);
+    }
+    /* the alpha of each pixel in all 4 of its 16 bit channels */
+    sa = _mm_or_si128(sa, _mm_slli_epi32(sa, 16));
+    da = _mm_or_si128(da, _mm_slli_epi32(da, 16));
+
+    lo = _custom_equation_sse2(
+        fsrc, fdst, op, _mm_unpacklo_epi8(src, mm_zero),
+        _mm_unpacklo_epi8(dst, mm_zero), _mm_unpacklo_epi32(sa, sa),
+        _mm_unpacklo_epi32(da, da));
+    hi = _custom_equation_sse2(
+        fsrc, fdst, op, _mm_unpackhi_epi8(src, mm_zero),
+        _mm_unpackhi_epi8(dst, mm_zero), _mm_unpackhi_epi32(sa, sa),
+        _mm_unpackhi_epi32(da, da));
+    return _mm_packus_epi16(lo, hi);
+}
+
+static PG_INLINE __m128i
+_custom_blend4_sse2(__m128i src, __m128i dst, const pg_CustomBlendSSE2 *k,
+                    int csrc, int cdst, int cop, int asrc, int adst, int aop)
+{
+    __m128i sa, da, out;
+
+    src = _mm_or_si128(src, k->s_or);
+    sa = _mm_srl_epi32(_mm_and_si128(src, k->s_amask), k->s_ashift);
+    sa = _mm_or_si128(sa, k->s_opaque);
+    da = _mm_srl_epi32(_mm_and_si128(dst, k->d_amask), k->d_ashift);
+    da = _mm_or_si128(da, k->d_opaque);
+
+    /* the alpha byte of the colour equation already is the alpha equation
+     * when both are the same */
+    out = _custom_equation4_sse2(csrc, cdst, cop, src, dst, sa, da);
+    if (asrc != csrc || adst != cdst || aop != cop) {
+        __m128i alpha =
+            _custom_equation4_sse2(asrc, adst, aop, src, dst, sa, da);
+        out = _mm_or_si128(_mm_andnot_si128(k->d_amask, out),
+                           _mm_and_si128(k->d_amask, alpha));
+    }
+    return _mm_or_si128(_mm_and_si128(k->keep, out),
+                        _mm_andnot_si128(k->keep, dst));
+}
+
+/* Inlined with constant factors by blit_blend_custom_sse2() for the common
+ * blend equations, so their factor switches are resolved at compile time */
+static PG_INLINE void
+_blit_blend_custom_sse2(SDL_BlitInfo *info, int csrc, int cdst, int cop,
+                        int asrc, int adst, int aop)
+{
+    int i, height = info->height;
+    const int width = info->width;
+    const int n_iters_4 = width / 4;
+    const int pxl_excess = width % 4;
+    Uint32 *srcp = (Uint32 *)info->s_pixels;
+    const int srcskip = info->s_skip >> 2;
+    Uint32 *dstp = (Uint32 *)info->d_pixels;
+    const int dstskip = info->d_skip >> 2;
+    SDL_PixelFormat *srcfmt = info->src;
+    SDL_PixelFormat *dstfmt = info->dst;
+    Uint32 src_buf[4], dst_buf[4];
+    pg_CustomBlendSSE2 k;
+
+    k.s_or = _mm_set1_epi32(srcfmt->Amask ? 0 : dstfmt->Amask);
+    k.s_amask = _mm_set1_epi32(srcfmt->Amask);
+    k.s_ashift = _mm_cvtsi32_si128(srcfmt->Amask ? srcfmt->Ashift : 0);
+    k.d_amask = _mm_set1_epi32(dstfmt->Amask);
+    k.d_ashift = _mm_cvtsi32_si128(dstfmt->Amask ? dstfmt->Ashift : 0);
+    k.keep = _mm_set1_epi32(dstfmt->Rmask | dstfmt->Gmask | dstfmt->Bmask |
+                            dstfmt->Amask);
+    k.s_opaque = _mm_set1_epi32(srcfmt->Amask ? 0 : 0xFF);
+    k.d_opaque = _mm_set1_epi32(dstfmt->Amask ? 0 : 0xFF);
 
     while (height--) {
-        /* *INDENT-OFF* */
-        LOOP_UNROLLED4(
-            {
-                Uint32 alpha = *srcp & amask;
-                if (alpha == 0) {
-                    /* do nothing */
-                }
-                else if (alpha == amask) {
-                    *dstp = *srcp;
-                }
-                else {
-                    src1 = _mm_cvtsi32_si128(
-                        *srcp); /* src(ARGB) -> src1 (000000000000ARGB) */
-                    src1 = _mm_unpacklo_epi8(
-                        src1, mm_zero); /* 000000000A0R0G0B -> src1 */
-
-                    dst1 = _mm_cvtsi32_si128(
-                        *dstp); /* dst(ARGB) -> dst1 (000000000000ARGB) */
-                    dst1 = _mm_unpacklo_epi8(
-                        dst1, mm_zero); /* 000000000A0R0G0B -> dst1 */
-
-                    mm_alpha = _mm_cvtsi32_si128(
-                        alpha); /* alpha -> mm_alpha (000000000000A000) */
-                    mm_alpha = _mm_srli_si128(
-                        mm_alpha, 3); /* mm_alpha >> ashift ->
-                                         mm_alpha(000000000000000A) */
-                    mm_alpha = _mm_unpacklo_epi16(
-                        mm_alpha, mm_alpha); /* 0000000000000A0A -> mm_alpha */
-                    mm_alpha = _mm_unpacklo_epi32(
-                        mm_alpha,
-                        mm_alpha); /* 000000000A0A0A0A -> mm_alpha2 */
-
-                    /* pre-multiplied alpha blend */
-                    sub_dst = _mm_add_epi16(dst1, ones_128);
-                    sub_dst = _mm_mullo_epi16(sub_dst, mm_alpha);
-                    sub_dst = _mm_srli_epi16(sub_dst, 8);
-                    dst1 = _mm_add_epi16(src1, dst1);
-                    dst1 = _mm_sub_epi16(dst1, sub_dst);
-                    dst1 = _mm_packus_epi16(dst1, mm_zero);
+        /* 4 pixels at a time */
+        for (i = 0; i < n_iters_4; i++) {
+            _mm_storeu_si128(
+                (__m128i *)dstp,
+                _custom_blend4_sse2(_mm_loadu_si128((__m128i *)srcp),
+                                    _mm_loadu_si128((__m128i *)dstp), &k,
+                                    csrc, cdst, cop, asrc, adst, aop));
+            srcp += 4;
+            dstp += 4;
+        }
+
+        /* the last up to 3 pixels, through a buffer so they are blended
+         * exactly like the others */
+        if (pxl_excess) {
+            memcpy(src_buf, srcp, pxl_excess * sizeof(Uint32));
+            memcpy(dst_buf, dstp, pxl_excess * sizeof(Uint32));
+            _mm_storeu_si128(
+                (__m128i *)dst_buf,
+                _custom_blend4_sse2(_mm_loadu_si128((__m128i *)src_buf),
+                                    _mm_loadu_si128((__m128i *)dst_buf), &k,
+                                    csrc, cdst, cop, asrc, adst, aop));
+            memcpy(dstp, dst_buf, pxl_excess * sizeof(Uint32));
+            srcp += pxl_excess;
+            dstp += pxl_excess;
+        }
 
-                    *dstp = _mm_cvtsi128_si32(dst1);
-                }
-                ++srcp;
-                ++dstp;
-            },
-            n, width);
-        /* *INDENT-ON* */
         srcp += srcskip;
         dstp += dstskip;
     }
 }
 
+#define _CUSTOM_SSE2_KERNEL(csrc, cdst, cop, asrc, adst, aop)              \
+    case PG_BLEND_CUSTOM(SDL_BLENDFACTOR_##csrc, SDL_BLENDFACTOR_##cdst, \
+                         SDL_BLENDOPERATION_##cop, SDL_BLENDFACTOR_##asrc, \
+                         SDL_BLENDFACTOR_##adst, SDL_BLENDOPERATION_##aop): \
+        _blit_blend_custom_sse2(                                           \
+            info, SDL_BLENDFACTOR_##csrc, SDL_BLENDFACTOR_##cdst,          \
+            SDL_BLENDOPERATION_##cop, SDL_BLENDFACTOR_##asrc,              \
+            SDL_BLENDFACTOR_##adst, SDL_BLENDOPERATION_##aop);             \
+        return;
+
+void
+blit_blend_custom_sse2(SDL_BlitInfo *info)
+{
+    const int mode = (int)info->blend_custom;
+
+    switch (mode) {
+        /* alpha blending, like SDL_BLENDMODE_BLEND */
+        _CUSTOM_SSE2_KERNEL(SRC_ALPHA, ONE_MINUS_SRC_ALPHA, ADD, ONE,
+                            ONE_MINUS_SRC_ALPHA, ADD)
+        _CUSTOM_SSE2_KERNEL(SRC_ALPHA, ONE_MINUS_SRC_ALPHA, ADD, SRC_ALPHA,
+                            ONE_MINUS_SRC_ALPHA, ADD)
+        /* premultiplied alpha blending */
+        _CUSTOM_SSE2_KERNEL(ONE, ONE_MINUS_SRC_ALPHA, ADD, ONE,
+                            ONE_MINUS_SRC_ALPHA, ADD)
+        /* additive, like SDL_BLENDMODE_ADD */
+        _CUSTOM_SSE2_KERNEL(SRC_ALPHA, ONE, ADD, ZERO, ONE, ADD)
+        _CUSTOM_SSE2_KERNEL(ONE, ONE, ADD, ONE, ONE, ADD)
+        /* multiply, like SDL_BLENDMODE_MOD */
+        _CUSTOM_SSE2_KERNEL(DST_COLOR, ZERO, ADD, ZERO, ONE, ADD)
+        _CUSTOM_SSE2_KERNEL(DST_COLOR, ONE_MINUS_SRC_ALPHA, ADD, DST_ALPHA,
+                            ONE_MINUS_SRC_ALPHA, ADD)
+        /* screen */
+        _CUSTOM_SSE2_KERNEL(ONE, ONE_MINUS_SRC_COLOR, ADD, ONE,
+                            ONE_MINUS_SRC_COLOR, ADD)
+        default:
+            _blit_blend_custom_sse2(
+                info, PG_BLEND_CUSTOM_CSRC(mode), PG_BLEND_CUSTOM_CDST(mode),
+                PG_BLEND_CUSTOM_COP(mode), PG_BLEND_CUSTOM_ASRC(mode),
+                PG_BLEND_CUSTOM_ADST(mode), PG_BLEND_CUSTOM_AOP(mode));
+            break;
+    }
+}
+#undef _CUSTOM_SSE2_KERNEL
+
+/* (color + 1) * alpha >> 8 of the color channels of one pixel, like the
+ * vector loop below */
+static PG_INLINE Uint32
+_premul_pixel(Uint32 pixel, Uint32 amask, int ashift)
+{
+    Uint32 alpha = (pixel & amask) >> ashift, out = pixel & amask;
+    int shift;
+
+    for (shift = 0; shift < 32; shift += 8) {
+        if (!((amask >> shift) & 0xFF)) {
+            out |= (((((pixel >> shift) & 0xFF) + 1) * alpha) >> 8) << shift;
+        }
+    }
+    return out;
+}
+
 void
 premul_surf_color_by_alpha_sse2(SDL_Surface *src, SDL_Surface *dst)
 {
-    int n;
-    int width = src->w;
-    int height = src->h;
+    int i, height = src->h;
+    const int width = src->w;
+    const int n_iters_4 = width / 4;
+    const int pxl_excess = width % 4;
+    const int src_skip = src->pitch / 4 - width;
+    const int dst_skip = dst->pitch / 4 - width;
+    const Uint32 amask = src->format->Amask;
+    const int ashift = src->format->Ashift;
     Uint32 *srcp = (Uint32 *)src->pixels;
     Uint32 *dstp = (Uint32 *)dst->pixels;
 
-    SDL_PixelFormat *srcfmt = src->format;
-    Uint32 amask = srcfmt->Amask;
-    Uint64 ones;
+    const __m128i mm_amask = _mm_set1_epi32(amask);
+    const __m128i mm_ashift = _mm_cvtsi32_si128(ashift);
+    const __m128i mm_zero = _mm_setzero_si128();
+    const __m128i mm_ones = _mm_set1_epi16(0x0001);
+    __m128i mm_src, mm_alpha, mm_alpha_lo, mm_alpha_hi, mm_lo, mm_hi;
 
-    __m128i src1, dst1, rgb_mul_src, mm_alpha, mm_alpha_in, mm_zero, ones_128;
+    /* works in place too, every pixel is read before it is written */
+    while (height--) {
+        /* 4 pixels at a time */
+        for (i = 0; i < n_iters_4; i++) {
+            mm_src = _mm_loadu_si128((__m128i *)srcp);
+
+            /* the alpha of each pixel in both of its 16 bit halves, then
+             * in all 4 of its 16 bit channels */
+            mm_alpha =
+                _mm_srl_epi32(_mm_and_si128(mm_src, mm_amask), mm_ashift);
+            mm_alpha = _mm_or_si128(mm_alpha, _mm_slli_epi32(mm_alpha, 16));
+            mm_alpha_lo = _mm_unpacklo_epi32(mm_alpha, mm_alpha);
+            mm_alpha_hi = _mm_unpackhi_epi32(mm_alpha, mm_alpha);
+
+            mm_lo = _mm_unpacklo_epi8(mm_src, mm_zero);
+            mm_hi = _mm_unpackhi_epi8(mm_src, mm_zero);
+            mm_lo = _mm_mullo_epi16(_mm_add_epi16(mm_lo, mm_ones),
+                                    mm_alpha_lo);
+            mm_hi = _mm_mullo_epi16(_mm_add_epi16(mm_hi, mm_ones),
+                                    mm_alpha_hi);
+            mm_lo = _mm_packus_epi16(_mm_srli_epi16(mm_lo, 8),
+                                     _mm_srli_epi16(mm_hi, 8));
+
+            /* restore the original alpha */
+            mm_lo = _mm_or_si128(_mm_andnot_si128(mm_amask, mm_lo),
+                                 _mm_and_si128(mm_src, mm_amask));
+            _mm_storeu_si128((__m128i *)dstp, mm_lo);
+
+            srcp += 4;
+            dstp += 4;
+        }
 
-    mm_zero = _mm_setzero_si128();
-    ones = 0x0001000100010001;
-    ones_128 = _mm_loadl_epi64((const __m128i *)&ones);
+        /* up to 3 pixels at a time */
+        for (i = 0; i < pxl_excess; i++) {
+            *dstp++ = _premul_pixel(*srcp++, amask, ashift);
+        }
 
-    while (height--) {
-        /* *INDENT-OFF* */
-        LOOP_UNROLLED4(
-            {
-                Uint32 alpha = *srcp & amask;
-                if (alpha == amask) {
-                    *dstp = *srcp;
-                }
-                else {
-                    /* extract source pixels */
-                    src1 = _mm_cvtsi32_si128(
-                        *srcp); /* src(ARGB) -> src1 (000000000000ARGB) */
-                    src1 = _mm_unpacklo_epi8(
-                        src1, mm_zero); /* 000000000A0R0G0B -> src1 */
-
-                    /* extract source alpha and copy to r, g, b channels */
-                    mm_alpha_in = _mm_cvtsi32_si128(
-                        alpha); /* alpha -> mm_alpha (000000000000A000) */
-                    mm_alpha = _mm_srli_si128(
-                        mm_alpha_in, 3); /* mm_alpha >> ashift ->
-                                            mm_alpha(000000000000000A) */
-                    mm_alpha = _mm_unpacklo_epi16(
-                        mm_alpha, mm_alpha); /* 0000000000000A0A -> mm_alpha */
-                    mm_alpha = _mm_unpacklo_epi32(
-                        mm_alpha,
-                        mm_alpha); /* 000000000A0A0A0A -> mm_alpha2 */
-
-                    /* rgb alpha multiply */
-                    rgb_mul_src = _mm_add_epi16(src1, ones_128);
-                    rgb_mul_src = _mm_mullo_epi16(rgb_mul_src, mm_alpha);
-                    rgb_mul_src = _mm_srli_epi16(rgb_mul_src, 8);
-                    dst1 = _mm_packus_epi16(rgb_mul_src, mm_zero);
-                    dst1 = _mm_max_epu8(mm_alpha_in,
-                                        dst1); /* restore original alpha */
-
-                    *dstp = _mm_cvtsi128_si32(dst1);
-                }
-                ++srcp;
-                ++dstp;
-            },
-            n, width);
+        srcp += src_skip;
+        dstp += dst_skip;
     }
 }
 
@@ -959,4 +1245,198 @@ blit_blend_rgba_max_sse2(SDL_BlitInfo *info)
     SETUP_SSE2_BLITTER
     RUN_SSE2_BLITTER({ mm128_dst = _mm_max_epu8(mm128_dst, mm128_src); })
 }
+
+/* Setup for RUN_SSE2_SOLID_BLEND */
+#define SETUP_SSE2_SOLID_BLEND                                         \
+    const __m128i mm128_zero = _mm_setzero_si128();                    \
+    const __m128i mm128_ff = _mm_set1_epi16(0x00FF);                   \
+    const __m128i mm128_rgb_mask = _mm_set1_epi32(                     \
+        info->dst->Rmask | info->dst->Gmask | info->dst->Bmask);       \
+    const __m128i mm128_amask = _mm_set1_epi32(info->dst->Amask);      \
+    const __m128i mm128_ashift = _mm_cvtsi32_si128(info->dst->Ashift); \
+    const __m128i mm128_blanket_alpha =                                \
+        _mm_set1_epi8((char)info->src_blanket_alpha);                  \
+                                                                       \
+    __m128i mm128_alpha, mm128_dst_alpha, mm128_rgb_lo, mm128_rgb_hi,  \
+        mm128_a_lo, mm128_a_hi, _sa16, _da16, _s16, _d16, _t16;
+
+#define _SSE2_SOLID_BLEND_HALF(UNPACK, OUT_RGB, OUT_A)                       \
+    _s16 = UNPACK(mm128_src, mm128_zero);                                    \
+    _d16 = UNPACK(mm128_dst, mm128_zero);                                    \
+    _sa16 = UNPACK(mm128_alpha, mm128_zero);                                 \
+    _da16 = UNPACK(mm128_dst_alpha, mm128_zero);                             \
+                                                                             \
+    /* dstA = srcA + dstA - ((srcA * dstA) / 255) */                         \
+    _t16 = _mm_mullo_epi16(_sa16, _da16);                                    \
+    _t16 = _mm_srli_epi16(                                                   \
+        _mm_mulhi_epu16(_t16, _mm_set1_epi16((short)0x8081)), 7);            \
+    OUT_A = _mm_sub_epi16(_mm_add_epi16(_sa16, _da16), _t16);                \
+                                                                             \
+    /* a destination alpha of 0 takes the source color as it is */           \
+    _sa16 = _mm_or_si128(                                                    \
+        _sa16, _mm_and_si128(_mm_cmpeq_epi16(_da16, mm128_zero), mm128_ff)); \
+                                                                             \
+    /* dstRGB = ((dstRGB << 8) + (srcRGB - dstRGB) * srcA + srcRGB) >> 8 */  \
+    _t16 = _mm_mullo_epi16(_mm_sub_epi16(_s16, _d16), _sa16);                \
+    _t16 = _mm_add_epi16(_t16, _s16);                                        \
+    _t16 = _mm_add_epi16(_t16, _mm_slli_epi16(_d16, 8));                     \
+    OUT_RGB = _mm_srli_epi16(_t16, 8);
+
+/* Interface definition
+ * Definitions needed: MACRO(SETUP_SSE2_BLITTER),
+ *                     MACRO(SETUP_SSE2_SOLID_BLEND)
+ * Input variables: mm128_src, mm128_dst (containing raw pixel data),
+ *                  mm128_alpha (the source alpha of each pixel, repeated in
+ *                  all four of its bytes)
+ * Output variables: mm128_dst (containing blended pixel data)
+ *
+ * Operation: blends a source without per pixel alpha onto the destination
+ * with the same results as ALPHA_BLEND() in surface.h, which is what the
+ * scalar alphablit_solid and alphablit_colorkey use. The source may be any
+ * 32 bit format with the same 8 bit RGB channels as the destination.
+ */
+#define RUN_SSE2_SOLID_BLEND                                                \
+    if (info->dst->Amask) {                                                 \
+        mm128_dst_alpha = _mm_and_si128(                                    \
+            _mm_srl_epi32(mm128_dst, mm128_ashift), _mm_set1_epi32(0xFF));  \
+        mm128_dst_alpha = _mm_or_si128(mm128_dst_alpha,                     \
+                                       _mm_slli_epi32(mm128_dst_alpha, 8)); \
+        mm128_dst_alpha = _mm_or_si128(                                     \
+            mm128_dst_alpha, _mm_slli_epi32(mm128_dst_alpha, 16));          \
+    }                                                                       \
+    else {                                                                  \
+        mm128_dst_alpha = _mm_set1_epi32(-1);                               \
+    }                                                                       \
+                                                                            \
+    _SSE2_SOLID_BLEND_HALF(_mm_unpacklo_epi8, mm128_rgb_lo, mm128_a_lo)     \
+    _SSE2_SOLID_BLEND_HALF(_mm_unpackhi_epi8, mm128_rgb_hi, mm128_a_hi)     \
+                                                                            \
+    mm128_dst = _mm_or_si128(                                               \
+        _mm_and_si128(_mm_packus_epi16(mm128_rgb_lo, mm128_rgb_hi),         \
+                      mm128_rgb_mask),                                      \
+        _mm_and_si128(_mm_packus_epi16(mm128_a_lo, mm128_a_hi), mm128_amask));
+
+void
+alphablit_solid_sse2_argb(SDL_BlitInfo *info)
+{
+    SETUP_SSE2_BLITTER
+    SETUP_SSE2_SOLID_BLEND
+
+    mm128_alpha = mm128_blanket_alpha;
+
+    RUN_SSE2_BLITTER(RUN_SSE2_SOLID_BLEND)
+}
+
+void
+alphablit_colorkey_sse2_argb(SDL_BlitInfo *info)
+{
+    SETUP_SSE2_BLITTER
+    SETUP_SSE2_SOLID_BLEND
+
+    const __m128i mm128_colorkey = _mm_set1_epi32(info->src_colorkey);
+
+    RUN_SSE2_BLITTER(
+        /* pixels matching the colorkey are blended with an alpha of 0 */
+        mm128_alpha =
+            _mm_andnot_si128(_mm_cmpeq_epi32(mm128_src, mm128_colorkey),
+                             mm128_blanket_alpha);
+
+        RUN_SSE2_SOLID_BLEND)
+}
+
+/* The 8 bit channel at shift of the 8 pixels in s_lo and s_hi, one per 16
+ * bit lane */
+#define ARGB_CHANNEL_SSE2(shift)                                           \
+    _mm_packs_epi32(_mm_and_si128(_mm_srl_epi32(s_lo, shift), mm128_ff), \
+                    _mm_and_si128(_mm_srl_epi32(s_hi, shift), mm128_ff))
+
+/* ALPHA_BLEND_COMP() of 16 bit lanes. The sum wraps around on its way, but
+ * its final value fits in 16 bits. */
+#define ALPHA_BLEND_COMP_SSE2(sC, dC, sA)                                    \
+    _mm_srli_epi16(                                                          \
+        _mm_add_epi16(                                                       \
+            _mm_add_epi16(_mm_mullo_epi16(_mm_sub_epi16(sC, dC), sA), sC), \
+            _mm_slli_epi16(dC, 8)),                                          \
+        8)
+
+/* Per pixel alpha blits from 32 bit surfaces with byte aligned channels
+ * onto RGB565 or BGR565 ones, 8 pixels at a time. They give the same
+ * results as alphablit_alpha(), which spends most of its time in
+ * SDL_GetRGBA() for these. */
+void
+alphablit_alpha_sse2_argb_565(SDL_BlitInfo *info)
+{
+    int i;
+    int width = info->width;
+    int height = info->height;
+    Uint8 *srcp = info->s_pixels;
+    Uint8 *dstp = info->d_pixels;
+    int srcskip = info->s_skip;
+    int dstskip = info->d_skip;
+    SDL_PixelFormat *srcfmt = info->src;
+    SDL_PixelFormat *dstfmt = info->dst;
+    Uint32 modulate = info->src_blanket_alpha;
+    int drshift = dstfmt->Rshift, dbshift = dstfmt->Bshift;
+    Uint32 s, d, sR, sG, sB, sA, dR, dG, dB;
+
+    const __m128i mm128_ff = _mm_set1_epi32(0xFF);
+    const __m128i mm128_srshift = _mm_cvtsi32_si128(srcfmt->Rshift);
+    const __m128i mm128_sgshift = _mm_cvtsi32_si128(srcfmt->Gshift);
+    const __m128i mm128_sbshift = _mm_cvtsi32_si128(srcfmt->Bshift);
+    const __m128i mm128_sashift = _mm_cvtsi32_si128(srcfmt->Ashift);
+    const __m128i mm128_drshift = _mm_cvtsi32_si128(drshift);
+    const __m128i mm128_dbshift = _mm_cvtsi32_si128(dbshift);
+    const __m128i mm128_modulate = _mm_set1_epi16((short)modulate);
+    const __m128i mm128_div255 = _mm_set1_epi16((short)0x8081);
+    __m128i s_lo, s_hi, mm128_dst;
+    __m128i mm128_sR, mm128_sG, mm128_sB, mm128_sA;
+    __m128i mm128_dR, mm128_dG, mm128_dB;
+
+    while (height--) {
+        for (i = width; i >= 8; i -= 8, srcp += 32, dstp += 16) {
+            s_lo = _mm_loadu_si128((__m128i *)srcp);
+            s_hi = _mm_loadu_si128((__m128i *)(srcp + 16));
+            mm128_dst = _mm_loadu_si128((__m128i *)dstp);
+
+            mm128_sR = ARGB_CHANNEL_SSE2(mm128_srshift);
+            mm128_sG = ARGB_CHANNEL_SSE2(mm128_sgshift);
+            mm128_sB = ARGB_CHANNEL_SSE2(mm128_sbshift);
+            mm128_sA = ARGB_CHANNEL_SSE2(mm128_sashift);
+            if (modulate != 255) {
+                /* sA * modulate / 255 */
+                mm128_sA = _mm_srli_epi16(
+                    _mm_mulhi_epu16(_mm_mullo_epi16(mm128_sA, mm128_modulate),
+                                    mm128_div255),
+                    7);
+            }
+
+            PG_MM_UNPACK_565(mm128_dst, mm128_dR, mm128_dG, mm128_dB,
+                             mm128_drshift, mm128_dbshift)
+            mm128_dR = ALPHA_BLEND_COMP_SSE2(mm128_sR, mm128_dR, mm128_sA);
+            mm128_dG = ALPHA_BLEND_COMP_SSE2(mm128_sG, mm128_dG, mm128_sA);
+            mm128_dB = ALPHA_BLEND_COMP_SSE2(mm128_sB, mm128_dB, mm128_sA);
+
+            _mm_storeu_si128((__m128i *)dstp,
+                             PG_MM_PACK_565(mm128_dR, mm128_dG, mm128_dB,
+                                            mm128_drshift, mm128_dbshift));
+        }
+        for (; i > 0; i--, srcp += 4, dstp += 2) {
+            s = *(Uint32 *)srcp;
+            d = *(Uint16 *)dstp;
+            sR = s >> srcfmt->Rshift & 0xFF;
+            sG = s >> srcfmt->Gshift & 0xFF;
+            sB = s >> srcfmt->Bshift & 0xFF;
+            sA = (s >> srcfmt->Ashift & 0xFF) * modulate / 255;
+            dR = PG_WIDEN_5(d >> drshift & 0x1F);
+            dG = PG_WIDEN_6(d >> 5 & 0x3F);
+            dB = PG_WIDEN_5(d >> dbshift & 0x1F);
+            dR = ((dR << 8) + (sR - dR) * sA + sR) >> 8;
+            dG = ((dG << 8) + (sG - dG) * sA + sG) >> 8;
+            dB = ((dB << 8) + (sB - dB) * sA + sB) >> 8;
+            *(Uint16 *)dstp = PG_PACK_565(dR, dG, dB, drshift, dbshift);
+        }
+        srcp += srcskip;
+        dstp += dstskip;
+    }
+}
 #endif /* __SSE2__ || PG_ENABLE_ARM_NEON*/
@@ -0,0 +1,176 @@
+#define NO_PYGAME_C_API
+#include "_surface.h"
+
+#if !defined(PG_ENABLE_ARM_NEON) && defined(__aarch64__)
+// arm64 has neon optimisations enabled by default, even when fpu=neon is not
+// passed
+#define PG_ENABLE_ARM_NEON 1
+#endif
+
+#if defined(__SSE2__)
+#define PG_ENABLE_SSE_NEON 1
+#elif PG_ENABLE_ARM_NEON
+#define PG_ENABLE_SSE_NEON 1
+#else
+#define PG_ENABLE_SSE_NEON 0
+#endif
+
+int
+_pg_camera_has_avx2();
+
+/* This returns True if either SSE2 or NEON is present at runtime.
+ * Relevant because they use the same codepaths. Only the relevant runtime
+ * SDL cpu feature check is compiled in.*/
+int
+_pg_camera_HasSSE_NEON();
+
+/* Row kernels of the camera colorspace conversions, producing exactly the
+ * same pixels as the scalar loops in _camera.c.
+ * yuv422_row: converts n (even) pixels of packed 4:2:2, YUYV if yoff is 0 or
+ * UYVY if yoff is 1, to RGB.
+ * yuv420_row: converts n (even) pixels of one Y row, sharing every U and V
+ * sample between 2 pixels, to RGB.
+ * For out_bpp 3 both write b, g, r bytes. For out_bpp 4 they write
+ * r << shifts[0] | g << shifts[1] | b << shifts[2], so the shifts must be
+ * multiples of 8.
+ * hsv_row: converts n 4 byte RGB pixels, with the channels at the same
+ * shifts, to HSV pixels with h, s and v at those shifts. src and dst may be
+ * the same. */
+typedef void (*YUV422_ROW_P)(const Uint8 *src, Uint8 *dst, int n, int yoff,
+                             const int *shifts, int out_bpp);
+typedef void (*YUV420_ROW_P)(const Uint8 *y, const Uint8 *u, const Uint8 *v,
+                             Uint8 *dst, int n, const int *shifts,
+                             int out_bpp);
+typedef void (*HSV_ROW_P)(const Uint8 *src, Uint8 *dst, int n,
+                          const int *shifts);
+
+/* The kernels share these to convert the remaining pixels one by one. The
+ * formulas are from libv4l, see yuyv_to_rgb. */
+static PG_INLINE int
+_pg_camera_sat(int c)
+{
+    return c & ~255 ? (c < 0 ? 0 : 255) : c;
+}
+
+static PG_INLINE Uint8 *
+_pg_yuv_pixel(Uint8 *dst, int y, int u, int v, const int *shifts,
+              int out_bpp)
+{
+    int u1 = (((u - 128) << 7) + (u - 128)) >> 6;
+    int rg = (((u - 128) << 1) + (u - 128) + ((v - 128) << 2) +
+              ((v - 128) << 1)) >>
+             3;
+    int v1 = (((v - 128) << 1) + (v - 128)) >> 1;
+    int r = _pg_camera_sat(y + v1);
+    int g = _pg_camera_sat(y - rg);
+    int b = _pg_camera_sat(y + u1);
+    Uint32 pixel;
+
+    if (out_bpp == 3) {
+        *dst++ = (Uint8)b;
+        *dst++ = (Uint8)g;
+        *dst++ = (Uint8)r;
+        return dst;
+    }
+    pixel = ((Uint32)r << shifts[0]) | ((Uint32)g << shifts[1]) |
+            ((Uint32)b << shifts[2]);
+    memcpy(dst, &pixel, 4);
+    return dst + 4;
+}
+
+static PG_INLINE void
+_pg_yuv422_row_finish(const Uint8 *src, Uint8 *dst, int x, int n, int yoff,
+                      const int *shifts, int out_bpp)
+{
+    const int coff = 1 - yoff;
+
+    for (src += x * 2, dst += x * out_bpp; x + 1 < n; x += 2) {
+        dst = _pg_yuv_pixel(dst, src[yoff], src[coff], src[coff + 2], shifts,
+                            out_bpp);
+        dst = _pg_yuv_pixel(dst, src[yoff + 2], src[coff], src[coff + 2],
+                            shifts, out_bpp);
+        src += 4;
+    }
+}
+
+static PG_INLINE void
+_pg_yuv420_row_finish(const Uint8 *y, const Uint8 *u, const Uint8 *v,
+                      Uint8 *dst, int x, int n, const int *shifts,
+                      int out_bpp)
+{
+    for (dst += x * out_bpp; x + 1 < n; x += 2) {
+        dst = _pg_yuv_pixel(dst, y[x], u[x / 2], v[x / 2], shifts, out_bpp);
+        dst = _pg_yuv_pixel(dst, y[x + 1], u[x / 2], v[x / 2], shifts,
+                            out_bpp);
+    }
+}
+
+static PG_INLINE void
+_pg_hsv_row_finish(const Uint8 *src, Uint8 *dst, int x, int n,
+                   const int *shifts)
+{
+    Uint32 pixel;
+    Uint8 r, g, b, h, s, v, max, min, delta;
+
+    for (src += x * 4, dst += x * 4; x < n; x++) {
+        memcpy(&pixel, src, 4);
+        r = (Uint8)(pixel >> shifts[0]);
+        g = (Uint8)(pixel >> shifts[1]);
+        b = (Uint8)(pixel >> shifts[2]);
+        max = MAX(MAX(r, g), b);
+        min = MIN(MIN(r, g), b);
+        delta = max - min;
+        v = max;
+        if (!delta) {
+            s = 0;
+            h = 0;
+        }
+        else {
+            s = 255 * delta / max;
+            if (r == max) {
+                h = 43 * (g - b) / delta;
+            }
+            else if (g == max) {
+                h = 85 + 43 * (b - r) / delta;
+            }
+            else {
+                h = 170 + 43 * (r - g) / delta;
+            }
+        }
+        pixel = ((Uint32)h << shifts[0]) | ((Uint32)s << shifts[1]) |
+                ((Uint32)v << shifts[2]);
+        memcpy(dst, &pixel, 4);
+        src += 4;
+        dst += 4;
+    }
+}
+
+/* the generic versions, used if there is no SIMD support */
+void
+yuv422_row(const Uint8 *src, Uint8 *dst, int n, int yoff, const int *shifts,
+           int out_bpp);
+void
+yuv420_row(const Uint8 *y, const Uint8 *u, const Uint8 *v, Uint8 *dst, int n,
+           const int *shifts, int out_bpp);
+void
+hsv_row(const Uint8 *src, Uint8 *dst, int n, const int *shifts);
+
+// SSE2 functions
+void
+yuv422_row_sse2(const Uint8 *src, Uint8 *dst, int n, int yoff,
+                const int *shifts, int out_bpp);
+void
+yuv420_row_sse2(const Uint8 *y, const Uint8 *u, const Uint8 *v, Uint8 *dst,
+                int n, const int *shifts, int out_bpp);
+void
+hsv_row_sse2(const Uint8 *src, Uint8 *dst, int n, const int *shifts);
+
+// AVX2 functions
+void
+yuv422_row_avx2(const Uint8 *src, Uint8 *dst, int n, int yoff,
+                const int *shifts, int out_bpp);
+void
+yuv420_row_avx2(const Uint8 *y, const Uint8 *u, const Uint8 *v, Uint8 *dst,
+                int n, const int *shifts, int out_bpp);
+void
+hsv_row_avx2(const Uint8 *src, Uint8 *dst, int n, const int *shifts);
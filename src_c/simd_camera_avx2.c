@@ -0,0 +1,246 @@
+#include "simd_camera.h"
+
+#if defined(HAVE_IMMINTRIN_H) && !defined(SDL_DISABLE_IMMINTRIN_H)
+#include <immintrin.h>
+#endif /* defined(HAVE_IMMINTRIN_H) && !defined(SDL_DISABLE_IMMINTRIN_H) */
+
+#define BAD_AVX2_FUNCTION_CALL                                               \
+    printf(                                                                  \
+        "Fatal Error: Attempted calling an AVX2 function when both compile " \
+        "time and runtime support is missing. If you are seeing this "       \
+        "message, you have stumbled across a pygame bug, please report it "  \
+        "to the devs!");                                                     \
+    PG_EXIT(1)
+
+/* helper function that does a runtime check for AVX2. It has the added
+ * functionality of also returning 0 if compile time support is missing */
+int
+_pg_camera_has_avx2()
+{
+#if defined(__AVX2__) && defined(HAVE_IMMINTRIN_H) && \
+    !defined(SDL_DISABLE_IMMINTRIN_H)
+    return pg_simd_max_level() >= PG_SIMD_AVX2 && SDL_HasAVX2();
+#else
+    return 0;
+#endif /* defined(__AVX2__) && defined(HAVE_IMMINTRIN_H) && \
+          !defined(SDL_DISABLE_IMMINTRIN_H) */
+}
+
+#if defined(__AVX2__) && defined(HAVE_IMMINTRIN_H) && \
+    !defined(SDL_DISABLE_IMMINTRIN_H)
+/* Stores 8 pixels of 4 bytes, or their low 3 bytes packed together */
+static PG_INLINE void
+_store8(Uint8 *dst, __m256i out, int out_bpp)
+{
+    const __m256i mm256_shuffle24 = _mm256_setr_epi8(
+        0, 1, 2, 4, 5, 6, 8, 9, 10, 12, 13, 14, -1, -1, -1, -1, 0, 1, 2, 4, 5,
+        6, 8, 9, 10, 12, 13, 14, -1, -1, -1, -1);
+    const __m256i mm256_pack = _mm256_setr_epi32(0, 1, 2, 4, 5, 6, 3, 7);
+    const __m256i mm256_store24 =
+        _mm256_setr_epi32(-1, -1, -1, -1, -1, -1, 0, 0);
+
+    if (out_bpp == 4) {
+        _mm256_storeu_si256((__m256i *)dst, out);
+        return;
+    }
+    out = _mm256_shuffle_epi8(out, mm256_shuffle24);
+    out = _mm256_permutevar8x32_epi32(out, mm256_pack);
+    _mm256_maskstore_epi32((int *)dst, mm256_store24, out);
+}
+
+/* Converts 16 pixels, given in order as 16 bit lanes of y and of the u and v
+ * samples belonging to each pixel. See _yuv_to_rgb_8 in the SSE2 version. */
+static PG_INLINE void
+_yuv_to_rgb_16(__m256i y, __m256i u, __m256i v, Uint8 *dst,
+               const __m128i *mm_shifts, int out_bpp)
+{
+    const __m256i mm256_zero = _mm256_setzero_si256();
+    const __m256i mm256_128 = _mm256_set1_epi16(128);
+    const __m256i mm256_255 = _mm256_set1_epi16(255);
+    __m256i u1, rg, v1, r, g, b, lo, hi;
+
+    u = _mm256_sub_epi16(u, mm256_128);
+    v = _mm256_sub_epi16(v, mm256_128);
+    u1 = _mm256_srai_epi16(_mm256_add_epi16(_mm256_slli_epi16(u, 7), u), 6);
+    rg = _mm256_add_epi16(_mm256_add_epi16(_mm256_slli_epi16(u, 1), u),
+                          _mm256_add_epi16(_mm256_slli_epi16(v, 2),
+                                           _mm256_slli_epi16(v, 1)));
+    rg = _mm256_srai_epi16(rg, 3);
+    v1 = _mm256_srai_epi16(_mm256_add_epi16(_mm256_slli_epi16(v, 1), v), 1);
+
+    r = _mm256_min_epi16(
+        _mm256_max_epi16(_mm256_add_epi16(y, v1), mm256_zero), mm256_255);
+    g = _mm256_min_epi16(
+        _mm256_max_epi16(_mm256_sub_epi16(y, rg), mm256_zero), mm256_255);
+    b = _mm256_min_epi16(
+        _mm256_max_epi16(_mm256_add_epi16(y, u1), mm256_zero), mm256_255);
+
+    /* the unpacks work within the 128 bit halves, lo gets pixels 0-3 and
+     * 8-11, hi gets pixels 4-7 and 12-15 */
+    lo = _mm256_or_si256(
+        _mm256_or_si256(
+            _mm256_sll_epi32(_mm256_unpacklo_epi16(r, mm256_zero),
+                             mm_shifts[0]),
+            _mm256_sll_epi32(_mm256_unpacklo_epi16(g, mm256_zero),
+                             mm_shifts[1])),
+        _mm256_sll_epi32(_mm256_unpacklo_epi16(b, mm256_zero), mm_shifts[2]));
+    hi = _mm256_or_si256(
+        _mm256_or_si256(
+            _mm256_sll_epi32(_mm256_unpackhi_epi16(r, mm256_zero),
+                             mm_shifts[0]),
+            _mm256_sll_epi32(_mm256_unpackhi_epi16(g, mm256_zero),
+                             mm_shifts[1])),
+        _mm256_sll_epi32(_mm256_unpackhi_epi16(b, mm256_zero), mm_shifts[2]));
+
+    _store8(dst, _mm256_permute2x128_si256(lo, hi, 0x20), out_bpp);
+    _store8(dst + 8 * out_bpp, _mm256_permute2x128_si256(lo, hi, 0x31),
+            out_bpp);
+}
+
+/* 3 byte output is built as b | g << 8 | r << 16 and then packed */
+static PG_INLINE void
+_load_shifts(__m128i *mm_shifts, const int *shifts, int out_bpp)
+{
+    mm_shifts[0] = _mm_cvtsi32_si128(out_bpp == 4 ? shifts[0] : 16);
+    mm_shifts[1] = _mm_cvtsi32_si128(out_bpp == 4 ? shifts[1] : 8);
+    mm_shifts[2] = _mm_cvtsi32_si128(out_bpp == 4 ? shifts[2] : 0);
+}
+
+void
+yuv422_row_avx2(const Uint8 *src, Uint8 *dst, int n, int yoff,
+                const int *shifts, int out_bpp)
+{
+    const __m256i mm256_lo8 = _mm256_set1_epi16(0xFF);
+    const __m256i mm256_lo16 = _mm256_set1_epi32(0xFFFF);
+    __m128i mm_shifts[3];
+    __m256i pixels, y, c, u, v;
+    int x;
+
+    _load_shifts(mm_shifts, shifts, out_bpp);
+
+    for (x = 0; x + 16 <= n; x += 16) {
+        pixels = _mm256_loadu_si256((const __m256i *)(src + x * 2));
+        if (yoff) {
+            y = _mm256_srli_epi16(pixels, 8);
+            c = _mm256_and_si256(pixels, mm256_lo8);
+        }
+        else {
+            y = _mm256_and_si256(pixels, mm256_lo8);
+            c = _mm256_srli_epi16(pixels, 8);
+        }
+        u = _mm256_and_si256(c, mm256_lo16);
+        u = _mm256_or_si256(u, _mm256_slli_epi32(u, 16));
+        v = _mm256_srli_epi32(c, 16);
+        v = _mm256_or_si256(v, _mm256_slli_epi32(v, 16));
+        _yuv_to_rgb_16(y, u, v, dst + x * out_bpp, mm_shifts, out_bpp);
+    }
+    _pg_yuv422_row_finish(src, dst, x, n, yoff, shifts, out_bpp);
+}
+
+void
+yuv420_row_avx2(const Uint8 *y, const Uint8 *u, const Uint8 *v, Uint8 *dst,
+                int n, const int *shifts, int out_bpp)
+{
+    __m128i mm_shifts[3];
+    __m128i mm_uv;
+    __m256i mm256_y, mm256_u, mm256_v;
+    int x;
+
+    _load_shifts(mm_shifts, shifts, out_bpp);
+
+    for (x = 0; x + 16 <= n; x += 16) {
+        mm256_y =
+            _mm256_cvtepu8_epi16(_mm_loadu_si128((const __m128i *)(y + x)));
+        mm_uv = _mm_loadl_epi64((const __m128i *)(u + x / 2));
+        mm256_u = _mm256_cvtepu8_epi16(_mm_unpacklo_epi8(mm_uv, mm_uv));
+        mm_uv = _mm_loadl_epi64((const __m128i *)(v + x / 2));
+        mm256_v = _mm256_cvtepu8_epi16(_mm_unpacklo_epi8(mm_uv, mm_uv));
+        _yuv_to_rgb_16(mm256_y, mm256_u, mm256_v, dst + x * out_bpp,
+                       mm_shifts, out_bpp);
+    }
+    _pg_yuv420_row_finish(y, u, v, dst, x, n, shifts, out_bpp);
+}
+
+/* See hsv_row_sse2 for why the float divisions are exact */
+void
+hsv_row_avx2(const Uint8 *src, Uint8 *dst, int n, const int *shifts)
+{
+    const __m256i mm256_ff = _mm256_set1_epi32(0xFF);
+    const __m256i mm256_one = _mm256_set1_epi32(1);
+    const __m256i mm256_85 = _mm256_set1_epi32(85);
+    const __m256i mm256_170 = _mm256_set1_epi32(170);
+    const __m256 mm256_43f = _mm256_set1_ps(43.0f);
+    const __m256 mm256_255f = _mm256_set1_ps(255.0f);
+    __m128i mm_shifts[3];
+    __m256i pixels, r, g, b, max, min, delta, gray, divisor;
+    __m256i is_r, is_g, diff, base, h, s;
+    int x;
+
+    _load_shifts(mm_shifts, shifts, 4);
+
+    for (x = 0; x + 8 <= n; x += 8) {
+        pixels = _mm256_loadu_si256((const __m256i *)(src + x * 4));
+        r = _mm256_and_si256(_mm256_srl_epi32(pixels, mm_shifts[0]),
+                             mm256_ff);
+        g = _mm256_and_si256(_mm256_srl_epi32(pixels, mm_shifts[1]),
+                             mm256_ff);
+        b = _mm256_and_si256(_mm256_srl_epi32(pixels, mm_shifts[2]),
+                             mm256_ff);
+        max = _mm256_max_epi32(_mm256_max_epi32(r, g), b);
+        min = _mm256_min_epi32(_mm256_min_epi32(r, g), b);
+        delta = _mm256_sub_epi32(max, min);
+
+        gray = _mm256_cmpeq_epi32(delta, _mm256_setzero_si256());
+        divisor = _mm256_or_si256(delta, _mm256_and_si256(gray, mm256_one));
+        s = _mm256_cvttps_epi32(_mm256_div_ps(
+            _mm256_mul_ps(_mm256_cvtepi32_ps(delta), mm256_255f),
+            _mm256_cvtepi32_ps(_mm256_or_si256(
+                max, _mm256_and_si256(gray, mm256_one)))));
+
+        is_r = _mm256_cmpeq_epi32(r, max);
+        is_g = _mm256_andnot_si256(is_r, _mm256_cmpeq_epi32(g, max));
+        diff = _mm256_blendv_epi8(
+            _mm256_blendv_epi8(_mm256_sub_epi32(r, g), _mm256_sub_epi32(b, r),
+                               is_g),
+            _mm256_sub_epi32(g, b), is_r);
+        base = _mm256_blendv_epi8(
+            _mm256_blendv_epi8(mm256_170, mm256_85, is_g),
+            _mm256_setzero_si256(), is_r);
+        h = _mm256_add_epi32(
+            base, _mm256_cvttps_epi32(_mm256_div_ps(
+                      _mm256_mul_ps(_mm256_cvtepi32_ps(diff), mm256_43f),
+                      _mm256_cvtepi32_ps(divisor))));
+
+        h = _mm256_andnot_si256(gray, _mm256_and_si256(h, mm256_ff));
+        s = _mm256_andnot_si256(gray, s);
+        _mm256_storeu_si256(
+            (__m256i *)(dst + x * 4),
+            _mm256_or_si256(
+                _mm256_or_si256(_mm256_sll_epi32(h, mm_shifts[0]),
+                                _mm256_sll_epi32(s, mm_shifts[1])),
+                _mm256_sll_epi32(max, mm_shifts[2])));
+    }
+    _pg_hsv_row_finish(src, dst, x, n, shifts);
+}
+#else
+void
+yuv422_row_avx2(const Uint8 *src, Uint8 *dst, int n, int yoff,
+                const int *shifts, int out_bpp)
+{
+    BAD_AVX2_FUNCTION_CALL;
+}
+
+void
+yuv420_row_avx2(const Uint8 *y, const Uint8 *u, const Uint8 *v, Uint8 *dst,
+                int n, const int *shifts, int out_bpp)
+{
+    BAD_AVX2_FUNCTION_CALL;
+}
+
+void
+hsv_row_avx2(const Uint8 *src, Uint8 *dst, int n, const int *shifts)
+{
+    BAD_AVX2_FUNCTION_CALL;
+}
+#endif /* defined(__AVX2__) && defined(HAVE_IMMINTRIN_H) && \
+          !defined(SDL_DISABLE_IMMINTRIN_H) */
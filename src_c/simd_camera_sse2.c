@@ -0,0 +1,246 @@
+#include "simd_camera.h"
+
+#if PG_ENABLE_ARM_NEON
+// sse2neon.h is from here: https://github.com/DLTcollab/sse2neon
+#include "include/sse2neon.h"
+#endif /* PG_ENABLE_ARM_NEON */
+
+#define BAD_SSE2_FUNCTION_CALL                                               \
+    printf(                                                                  \
+        "Fatal Error: Attempted calling an SSE2 function when both compile " \
+        "time and runtime support is missing. If you are seeing this "       \
+        "message, you have stumbled across a pygame bug, please report it "  \
+        "to the devs!");                                                     \
+    PG_EXIT(1)
+
+int
+_pg_camera_HasSSE_NEON()
+{
+#if defined(__SSE2__)
+    return pg_simd_max_level() >= PG_SIMD_SSE2_NEON && SDL_HasSSE2();
+#elif PG_ENABLE_ARM_NEON
+    return pg_simd_max_level() >= PG_SIMD_SSE2_NEON && SDL_HasNEON();
+#else
+    return 0;
+#endif
+}
+
+#if defined(__SSE2__) || defined(PG_ENABLE_ARM_NEON)
+/* Packs the low 3 bytes of the 4 lanes into 12 bytes at dst */
+static PG_INLINE void
+_store24(Uint8 *dst, __m128i out)
+{
+    const __m128i mm_lo64 = _mm_set_epi32(0, -1, 0, -1);
+    const __m128i mm_lane0 = _mm_set_epi32(0, 0, -1, -1);
+    Uint32 last;
+
+    out = _mm_or_si128(_mm_and_si128(out, mm_lo64),
+                       _mm_srli_epi64(_mm_andnot_si128(mm_lo64, out), 8));
+    out = _mm_or_si128(_mm_and_si128(out, mm_lane0),
+                       _mm_srli_si128(_mm_andnot_si128(mm_lane0, out), 2));
+    _mm_storel_epi64((__m128i *)dst, out);
+    last = (Uint32)_mm_cvtsi128_si32(_mm_srli_si128(out, 8));
+    memcpy(dst + 8, &last, 4);
+}
+
+/* Converts 8 pixels, given as 16 bit lanes of y and of the u and v samples
+ * belonging to each pixel. All intermediate values fit in 16 bits, so this
+ * is the scalar integer math 8 times over. */
+static PG_INLINE void
+_yuv_to_rgb_8(__m128i y, __m128i u, __m128i v, Uint8 *dst,
+              const __m128i *mm_shifts, int out_bpp)
+{
+    const __m128i mm_zero = _mm_setzero_si128();
+    const __m128i mm_128 = _mm_set1_epi16(128);
+    const __m128i mm_255 = _mm_set1_epi16(255);
+    __m128i u1, rg, v1, r, g, b, lo, hi;
+
+    u = _mm_sub_epi16(u, mm_128);
+    v = _mm_sub_epi16(v, mm_128);
+    u1 = _mm_srai_epi16(_mm_add_epi16(_mm_slli_epi16(u, 7), u), 6);
+    rg = _mm_add_epi16(_mm_add_epi16(_mm_slli_epi16(u, 1), u),
+                       _mm_add_epi16(_mm_slli_epi16(v, 2),
+                                     _mm_slli_epi16(v, 1)));
+    rg = _mm_srai_epi16(rg, 3);
+    v1 = _mm_srai_epi16(_mm_add_epi16(_mm_slli_epi16(v, 1), v), 1);
+
+    r = _mm_min_epi16(_mm_max_epi16(_mm_add_epi16(y, v1), mm_zero), mm_255);
+    g = _mm_min_epi16(_mm_max_epi16(_mm_sub_epi16(y, rg), mm_zero), mm_255);
+    b = _mm_min_epi16(_mm_max_epi16(_mm_add_epi16(y, u1), mm_zero), mm_255);
+
+    lo = _mm_or_si128(
+        _mm_or_si128(_mm_sll_epi32(_mm_unpacklo_epi16(r, mm_zero),
+                                   mm_shifts[0]),
+                     _mm_sll_epi32(_mm_unpacklo_epi16(g, mm_zero),
+                                   mm_shifts[1])),
+        _mm_sll_epi32(_mm_unpacklo_epi16(b, mm_zero), mm_shifts[2]));
+    hi = _mm_or_si128(
+        _mm_or_si128(_mm_sll_epi32(_mm_unpackhi_epi16(r, mm_zero),
+                                   mm_shifts[0]),
+                     _mm_sll_epi32(_mm_unpackhi_epi16(g, mm_zero),
+                                   mm_shifts[1])),
+        _mm_sll_epi32(_mm_unpackhi_epi16(b, mm_zero), mm_shifts[2]));
+
+    if (out_bpp == 4) {
+        _mm_storeu_si128((__m128i *)dst, lo);
+        _mm_storeu_si128((__m128i *)(dst + 16), hi);
+    }
+    else {
+        _store24(dst, lo);
+        _store24(dst + 12, hi);
+    }
+}
+
+/* 3 byte output is built as b | g << 8 | r << 16 and then packed */
+static PG_INLINE void
+_load_shifts(__m128i *mm_shifts, const int *shifts, int out_bpp)
+{
+    mm_shifts[0] = _mm_cvtsi32_si128(out_bpp == 4 ? shifts[0] : 16);
+    mm_shifts[1] = _mm_cvtsi32_si128(out_bpp == 4 ? shifts[1] : 8);
+    mm_shifts[2] = _mm_cvtsi32_si128(out_bpp == 4 ? shifts[2] : 0);
+}
+
+void
+yuv422_row_sse2(const Uint8 *src, Uint8 *dst, int n, int yoff,
+                const int *shifts, int out_bpp)
+{
+    const __m128i mm_lo8 = _mm_set1_epi16(0xFF);
+    const __m128i mm_lo16 = _mm_set1_epi32(0xFFFF);
+    __m128i mm_shifts[3];
+    __m128i pixels, y, c, u, v;
+    int x;
+
+    _load_shifts(mm_shifts, shifts, out_bpp);
+
+    for (x = 0; x + 8 <= n; x += 8) {
+        pixels = _mm_loadu_si128((const __m128i *)(src + x * 2));
+        if (yoff) {
+            y = _mm_srli_epi16(pixels, 8);
+            c = _mm_and_si128(pixels, mm_lo8);
+        }
+        else {
+            y = _mm_and_si128(pixels, mm_lo8);
+            c = _mm_srli_epi16(pixels, 8);
+        }
+        /* c is u0 v0 u1 v1 ..., give both pixels of a pair their u and v */
+        u = _mm_and_si128(c, mm_lo16);
+        u = _mm_or_si128(u, _mm_slli_epi32(u, 16));
+        v = _mm_srli_epi32(c, 16);
+        v = _mm_or_si128(v, _mm_slli_epi32(v, 16));
+        _yuv_to_rgb_8(y, u, v, dst + x * out_bpp, mm_shifts, out_bpp);
+    }
+    _pg_yuv422_row_finish(src, dst, x, n, yoff, shifts, out_bpp);
+}
+
+void
+yuv420_row_sse2(const Uint8 *y, const Uint8 *u, const Uint8 *v, Uint8 *dst,
+                int n, const int *shifts, int out_bpp)
+{
+    const __m128i mm_zero = _mm_setzero_si128();
+    __m128i mm_shifts[3];
+    __m128i mm_y, mm_u, mm_v;
+    Uint32 uv;
+    int x;
+
+    _load_shifts(mm_shifts, shifts, out_bpp);
+
+    for (x = 0; x + 8 <= n; x += 8) {
+        mm_y = _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i *)(y + x)),
+                                 mm_zero);
+        memcpy(&uv, u + x / 2, 4);
+        mm_u = _mm_unpacklo_epi8(_mm_cvtsi32_si128((int)uv), mm_zero);
+        mm_u = _mm_unpacklo_epi16(mm_u, mm_u);
+        memcpy(&uv, v + x / 2, 4);
+        mm_v = _mm_unpacklo_epi8(_mm_cvtsi32_si128((int)uv), mm_zero);
+        mm_v = _mm_unpacklo_epi16(mm_v, mm_v);
+        _yuv_to_rgb_8(mm_y, mm_u, mm_v, dst + x * out_bpp, mm_shifts,
+                      out_bpp);
+    }
+    _pg_yuv420_row_finish(y, u, v, dst, x, n, shifts, out_bpp);
+}
+
+/* The divisions are done in floats. Both operands are exact integers below
+ * 2^24 and a quotient that isn't whole is at least 1/255 off the next
+ * integer, so truncating gives the same result as integer division. The
+ * channels are at most 255, so 16 bit min and max work on the 32 bit
+ * lanes. */
+void
+hsv_row_sse2(const Uint8 *src, Uint8 *dst, int n, const int *shifts)
+{
+    const __m128i mm_ff = _mm_set1_epi32(0xFF);
+    const __m128i mm_one = _mm_set1_epi32(1);
+    const __m128i mm_85 = _mm_set1_epi32(85);
+    const __m128i mm_170 = _mm_set1_epi32(170);
+    const __m128 mm_43f = _mm_set1_ps(43.0f);
+    const __m128 mm_255f = _mm_set1_ps(255.0f);
+    __m128i mm_shifts[3];
+    __m128i pixels, r, g, b, max, min, delta, gray, divisor;
+    __m128i is_r, is_g, diff, base, h, s;
+    __m128 fdivisor;
+    int x;
+
+    _load_shifts(mm_shifts, shifts, 4);
+
+    for (x = 0; x + 4 <= n; x += 4) {
+        pixels = _mm_loadu_si128((const __m128i *)(src + x * 4));
+        r = _mm_and_si128(_mm_srl_epi32(pixels, mm_shifts[0]), mm_ff);
+        g = _mm_and_si128(_mm_srl_epi32(pixels, mm_shifts[1]), mm_ff);
+        b = _mm_and_si128(_mm_srl_epi32(pixels, mm_shifts[2]), mm_ff);
+        max = _mm_max_epi16(_mm_max_epi16(r, g), b);
+        min = _mm_min_epi16(_mm_min_epi16(r, g), b);
+        delta = _mm_sub_epi32(max, min);
+
+        /* gray pixels get a zero hue and saturation, divide them by 1 */
+        gray = _mm_cmpeq_epi32(delta, _mm_setzero_si128());
+        divisor = _mm_or_si128(delta, _mm_and_si128(gray, mm_one));
+        fdivisor = _mm_cvtepi32_ps(divisor);
+        s = _mm_cvttps_epi32(
+            _mm_div_ps(_mm_mul_ps(_mm_cvtepi32_ps(delta), mm_255f),
+                       _mm_cvtepi32_ps(_mm_or_si128(
+                           max, _mm_and_si128(gray, mm_one)))));
+
+        /* the hue is based on which channel is the max, r before g */
+        is_r = _mm_cmpeq_epi32(r, max);
+        is_g = _mm_andnot_si128(is_r, _mm_cmpeq_epi32(g, max));
+        diff = _mm_or_si128(
+            _mm_or_si128(_mm_and_si128(is_r, _mm_sub_epi32(g, b)),
+                         _mm_and_si128(is_g, _mm_sub_epi32(b, r))),
+            _mm_andnot_si128(_mm_or_si128(is_r, is_g), _mm_sub_epi32(r, g)));
+        base = _mm_or_si128(
+            _mm_and_si128(is_g, mm_85),
+            _mm_andnot_si128(_mm_or_si128(is_r, is_g), mm_170));
+        h = _mm_add_epi32(
+            base, _mm_cvttps_epi32(_mm_div_ps(
+                      _mm_mul_ps(_mm_cvtepi32_ps(diff), mm_43f), fdivisor)));
+
+        h = _mm_andnot_si128(gray, _mm_and_si128(h, mm_ff));
+        s = _mm_andnot_si128(gray, s);
+        _mm_storeu_si128(
+            (__m128i *)(dst + x * 4),
+            _mm_or_si128(_mm_or_si128(_mm_sll_epi32(h, mm_shifts[0]),
+                                      _mm_sll_epi32(s, mm_shifts[1])),
+                         _mm_sll_epi32(max, mm_shifts[2])));
+    }
+    _pg_hsv_row_finish(src, dst, x, n, shifts);
+}
+#else
+void
+yuv422_row_sse2(const Uint8 *src, Uint8 *dst, int n, int yoff,
+                const int *shifts, int out_bpp)
+{
+    BAD_SSE2_FUNCTION_CALL;
+}
+
+void
+yuv420_row_sse2(const Uint8 *y, const Uint8 *u, const Uint8 *v, Uint8 *dst,
+                int n, const int *shifts, int out_bpp)
+{
+    BAD_SSE2_FUNCTION_CALL;
+}
+
+void
+hsv_row_sse2(const Uint8 *src, Uint8 *dst, int n, const int *shifts)
+{
+    BAD_SSE2_FUNCTION_CALL;
+}
+#endif /* defined(__SSE2__) || defined(PG_ENABLE_ARM_NEON) */
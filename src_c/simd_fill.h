@@ -38,6 +38,31 @@ _pg_has_avx2();
 int
 _pg_HasSSE_NEON();
 
+/* Span fills, used for the horizontal lines of the draw module. They fill
+ * nbytes bytes from dst with copies of pattern, which holds
+ * PG_SPAN_PATTERN_SIZE bytes. The pattern size is a multiple of every pixel
+ * size, so any color repeats seamlessly in it. */
+#define PG_SPAN_PATTERN_SIZE 96
+
+void
+surface_fill_span_avx2(Uint8 *dst, size_t nbytes, const Uint8 *pattern);
+void
+surface_fill_span_sse2(Uint8 *dst, size_t nbytes, const Uint8 *pattern);
+
+/* Alpha scans, used by Surface.get_bounding_rect(). They return the index
+ * of the first (or last) of the n 32 bit pixels at row whose 8 bit alpha at
+ * ashift is at least min_alpha, or n (or -1) if there is none. */
+int
+surface_alpha_first_avx2(const Uint32 *row, int n, int ashift,
+                         int min_alpha);
+int
+surface_alpha_last_avx2(const Uint32 *row, int n, int ashift, int min_alpha);
+int
+surface_alpha_first_sse2(const Uint32 *row, int n, int ashift,
+                         int min_alpha);
+int
+surface_alpha_last_sse2(const Uint32 *row, int n, int ashift, int min_alpha);
+
 // AVX2 functions
 int
 surface_fill_blend_add_avx2(SDL_Surface *surface, SDL_Rect *rect,
@@ -101,3 +126,34 @@ surface_fill_blend_max_sse2(SDL_Surface *surface, SDL_Rect *rect,
 int
 surface_fill_blend_rgba_max_sse2(SDL_Surface *surface, SDL_Rect *rect,
                                  Uint32 color);
+// SSE2 functions for RGB565 and BGR565 surfaces
+int
+surface_fill_blend_add_565_sse2(SDL_Surface *surface, SDL_Rect *rect,
+                                Uint32 color);
+int
+surface_fill_blend_rgba_add_565_sse2(SDL_Surface *surface, SDL_Rect *rect,
+                                     Uint32 color);
+int
+surface_fill_blend_sub_565_sse2(SDL_Surface *surface, SDL_Rect *rect,
+                                Uint32 color);
+int
+surface_fill_blend_rgba_sub_565_sse2(SDL_Surface *surface, SDL_Rect *rect,
+                                     Uint32 color);
+int
+surface_fill_blend_mult_565_sse2(SDL_Surface *surface, SDL_Rect *rect,
+                                 Uint32 color);
+int
+surface_fill_blend_rgba_mult_565_sse2(SDL_Surface *surface, SDL_Rect *rect,
+                                      Uint32 color);
+int
+surface_fill_blend_min_565_sse2(SDL_Surface *surface, SDL_Rect *rect,
+                                Uint32 color);
+int
+surface_fill_blend_rgba_min_565_sse2(SDL_Surface *surface, SDL_Rect *rect,
+                                     Uint32 color);
+int
+surface_fill_blend_max_565_sse2(SDL_Surface *surface, SDL_Rect *rect,
+                                Uint32 color);
+int
+surface_fill_blend_rgba_max_565_sse2(SDL_Surface *surface, SDL_Rect *rect,
+                                     Uint32 color);
@@ -0,0 +1,158 @@
+#define NO_PYGAME_C_API
+#ifndef SIMD_GEOMETRY_H
+#define SIMD_GEOMETRY_H
+
+#include <math.h>
+
+#include "pygame.h"
+
+#if !defined(PG_ENABLE_ARM_NEON) && defined(__aarch64__)
+// arm64 has neon optimisations enabled by default, even when fpu=neon is not
+// passed
+#define PG_ENABLE_ARM_NEON 1
+#endif
+
+#if defined(__SSE2__)
+#define PG_ENABLE_SSE_NEON 1
+#elif PG_ENABLE_ARM_NEON
+#define PG_ENABLE_SSE_NEON 1
+#else
+#define PG_ENABLE_SSE_NEON 0
+#endif
+
+int
+_pg_geometry_has_avx2();
+
+/* This returns True if either SSE2 or NEON is present at runtime.
+ * Relevant because they use the same codepaths. Only the relevant runtime
+ * SDL cpu feature check is compiled in.*/
+int
+_pg_geometry_HasSSE_NEON();
+
+/* Batch kernels of Line.raycast(). For each of n shapes they write to t[i]
+ * the fraction of the way from the start to the end of the line where the
+ * line first touches the shape, 0 when it starts inside the shape and
+ * INFINITY when they don't touch. line holds ax, ay, bx, by. The shapes are
+ * given one array per coordinate:
+ * line_hit_segments: segments from (x0, y0) to (x1, y1).
+ * line_hit_rects: normalized rects, x0, y0 is the top left corner and x1, y1
+ * the bottom right one.
+ * line_hit_circles: circles at (x, y) with radius r. */
+typedef void (*LINE_HIT_BOXES_P)(const double *line, const double *x0,
+                                 const double *y0, const double *x1,
+                                 const double *y1, Py_ssize_t n, double *t);
+typedef void (*LINE_HIT_CIRCLES_P)(const double *line, const double *x,
+                                   const double *y, const double *r,
+                                   Py_ssize_t n, double *t);
+
+/* The hit tests of one shape, shared by all the kernels. They only use
+ * selects so they give the same results as the SIMD lanes. */
+static PG_INLINE double
+_pg_line_hit_segment(const double *line, double x0, double y0, double x1,
+                     double y1)
+{
+    const double dx = line[2] - line[0], dy = line[3] - line[1];
+    const double ex = x1 - x0, ey = y1 - y0;
+    const double fx = x0 - line[0], fy = y0 - line[1];
+    const double den = dx * ey - dy * ex;
+    const double cross = fx * dy - fy * dx;
+    const double t = (fx * ey - fy * ex) / den;
+    const double u = cross / den;
+
+    /* parallel segments only touch when they are on the same line, then
+     * the hit is where the overlap of their ranges along line starts */
+    const double len2 = dx * dx + dy * dy;
+    const double t0 = (fx * dx + fy * dy) / len2;
+    const double t1 = ((x1 - line[0]) * dx + (y1 - line[1]) * dy) / len2;
+    const double lo = t0 < t1 ? t0 : t1, hi = t1 > t0 ? t1 : t0;
+    const double olo = lo > 0.0 ? lo : 0.0, ohi = hi < 1.0 ? hi : 1.0;
+    const double collinear = olo <= ohi ? olo : INFINITY;
+
+    const double crossing =
+        (t >= 0.0 && t <= 1.0 && u >= 0.0 && u <= 1.0) ? t : INFINITY;
+    if (den != 0.0) {
+        return crossing;
+    }
+    return (cross == 0.0 && len2 != 0.0) ? collinear : INFINITY;
+}
+
+static PG_INLINE double
+_pg_line_hit_rect(const double *line, double left, double top, double right,
+                  double bottom)
+{
+    const double dx = line[2] - line[0], dy = line[3] - line[1];
+    const double sx = dx != 0.0 ? dx : 1.0, sy = dy != 0.0 ? dy : 1.0;
+    const double tx0 = (left - line[0]) / sx, tx1 = (right - line[0]) / sx;
+    const double ty0 = (top - line[1]) / sy, ty1 = (bottom - line[1]) / sy;
+    /* with no movement on an axis the line is inside the slab or never */
+    const double inx =
+        (line[0] >= left && line[0] <= right) ? INFINITY : -INFINITY;
+    const double iny =
+        (line[1] >= top && line[1] <= bottom) ? INFINITY : -INFINITY;
+    const double xlo = dx != 0.0 ? (tx0 < tx1 ? tx0 : tx1) : -inx;
+    const double xhi = dx != 0.0 ? (tx1 > tx0 ? tx1 : tx0) : inx;
+    const double ylo = dy != 0.0 ? (ty0 < ty1 ? ty0 : ty1) : -iny;
+    const double yhi = dy != 0.0 ? (ty1 > ty0 ? ty1 : ty0) : iny;
+    double lo = xlo > ylo ? xlo : ylo, hi = xhi < yhi ? xhi : yhi;
+
+    lo = lo > 0.0 ? lo : 0.0;
+    hi = hi < 1.0 ? hi : 1.0;
+    return lo <= hi ? lo : INFINITY;
+}
+
+static PG_INLINE double
+_pg_line_hit_circle(const double *line, double cx, double cy, double r)
+{
+    const double dx = line[2] - line[0], dy = line[3] - line[1];
+    const double fx = line[0] - cx, fy = line[1] - cy;
+    const double a = dx * dx + dy * dy;
+    const double b = fx * dx + fy * dy;
+    const double c = fx * fx + fy * fy - r * r;
+    const double disc = b * b - a * c;
+    const double t = (-b - sqrt(disc > 0.0 ? disc : 0.0)) / a;
+
+    if (c <= 0.0) {
+        return 0.0;
+    }
+    return (disc >= 0.0 && t >= 0.0 && t <= 1.0) ? t : INFINITY;
+}
+
+/* the generic versions, used if there is no SIMD support */
+void
+line_hit_segments(const double *line, const double *x0, const double *y0,
+                  const double *x1, const double *y1, Py_ssize_t n,
+                  double *t);
+void
+line_hit_rects(const double *line, const double *x0, const double *y0,
+               const double *x1, const double *y1, Py_ssize_t n, double *t);
+void
+line_hit_circles(const double *line, const double *x, const double *y,
+                 const double *r, Py_ssize_t n, double *t);
+
+// SSE2 functions
+void
+line_hit_segments_sse2(const double *line, const double *x0,
+                       const double *y0, const double *x1, const double *y1,
+                       Py_ssize_t n, double *t);
+void
+line_hit_rects_sse2(const double *line, const double *x0, const double *y0,
+                    const double *x1, const double *y1, Py_ssize_t n,
+                    double *t);
+void
+line_hit_circles_sse2(const double *line, const double *x, const double *y,
+                      const double *r, Py_ssize_t n, double *t);
+
+// AVX2 functions
+void
+line_hit_segments_avx2(const double *line, const double *x0,
+                       const double *y0, const double *x1, const double *y1,
+                       Py_ssize_t n, double *t);
+void
+line_hit_rects_avx2(const double *line, const double *x0, const double *y0,
+                    const double *x1, const double *y1, Py_ssize_t n,
+                    double *t);
+void
+line_hit_circles_avx2(const double *line, const double *x, const double *y,
+                      const double *r, Py_ssize_t n, double *t);
+
+#endif /* SIMD_GEOMETRY_H */
@@ -0,0 +1,207 @@
+#include "simd_geometry.h"
+
+#if defined(HAVE_IMMINTRIN_H) && !defined(SDL_DISABLE_IMMINTRIN_H)
+#include <immintrin.h>
+#endif /* defined(HAVE_IMMINTRIN_H) && !defined(SDL_DISABLE_IMMINTRIN_H) */
+
+#define BAD_AVX2_FUNCTION_CALL                                               \
+    printf(                                                                  \
+        "Fatal Error: Attempted calling an AVX2 function when both compile " \
+        "time and runtime support is missing. If you are seeing this "       \
+        "message, you have stumbled across a pygame bug, please report it "  \
+        "to the devs!");                                                     \
+    PG_EXIT(1)
+
+/* helper function that does a runtime check for AVX2. It has the added
+ * functionality of also returning 0 if compile time support is missing */
+int
+_pg_geometry_has_avx2()
+{
+#if defined(__AVX2__) && defined(HAVE_IMMINTRIN_H) && \
+    !defined(SDL_DISABLE_IMMINTRIN_H)
+    return pg_simd_max_level() >= PG_SIMD_AVX2 && SDL_HasAVX2();
+#else
+    return 0;
+#endif /* defined(__AVX2__) && defined(HAVE_IMMINTRIN_H) && \
+          !defined(SDL_DISABLE_IMMINTRIN_H) */
+}
+
+#if defined(__AVX2__) && defined(HAVE_IMMINTRIN_H) && \
+    !defined(SDL_DISABLE_IMMINTRIN_H)
+/* m ? a : b for each lane, m being the result of a comparison */
+#define _PG_SELECT_AVX2(m, a, b) _mm256_blendv_pd(b, a, m)
+#define _PG_CMP_AVX2(a, op, b) _mm256_cmp_pd(a, b, op)
+
+/* The lanes compute the same selects as _pg_line_hit_segment() and friends.
+ * _mm256_min_pd(a, b) is a < b ? a : b and _mm256_max_pd(a, b) is
+ * a > b ? a : b, also when a value is NaN. The comparisons are ordered like
+ * the C ones, except != which is true for NaN. */
+void
+line_hit_segments_avx2(const double *line, const double *x0,
+                       const double *y0, const double *x1, const double *y1,
+                       Py_ssize_t n, double *t)
+{
+    const double dxs = line[2] - line[0], dys = line[3] - line[1];
+    const __m256d ax = _mm256_set1_pd(line[0]), ay = _mm256_set1_pd(line[1]);
+    const __m256d dx = _mm256_set1_pd(dxs), dy = _mm256_set1_pd(dys);
+    const __m256d len2 = _mm256_set1_pd(dxs * dxs + dys * dys);
+    const __m256d zero = _mm256_setzero_pd(), one = _mm256_set1_pd(1.0);
+    const __m256d inf = _mm256_set1_pd(INFINITY);
+    const __m256d has_len = _PG_CMP_AVX2(len2, _CMP_NEQ_UQ, zero);
+    __m256d px0, py0, px1, py1, ex, ey, fx, fy, den, cross, tt, u, t0, t1;
+    __m256d lo, hi, collinear, crossing, m;
+    Py_ssize_t i;
+
+    for (i = 0; i + 4 <= n; i += 4) {
+        px0 = _mm256_loadu_pd(x0 + i);
+        py0 = _mm256_loadu_pd(y0 + i);
+        px1 = _mm256_loadu_pd(x1 + i);
+        py1 = _mm256_loadu_pd(y1 + i);
+        ex = _mm256_sub_pd(px1, px0);
+        ey = _mm256_sub_pd(py1, py0);
+        fx = _mm256_sub_pd(px0, ax);
+        fy = _mm256_sub_pd(py0, ay);
+        den = _mm256_sub_pd(_mm256_mul_pd(dx, ey), _mm256_mul_pd(dy, ex));
+        cross = _mm256_sub_pd(_mm256_mul_pd(fx, dy), _mm256_mul_pd(fy, dx));
+        tt = _mm256_sub_pd(_mm256_mul_pd(fx, ey), _mm256_mul_pd(fy, ex));
+        tt = _mm256_div_pd(tt, den);
+        u = _mm256_div_pd(cross, den);
+
+        t0 = _mm256_add_pd(_mm256_mul_pd(fx, dx), _mm256_mul_pd(fy, dy));
+        t0 = _mm256_div_pd(t0, len2);
+        t1 = _mm256_add_pd(_mm256_mul_pd(_mm256_sub_pd(px1, ax), dx),
+                           _mm256_mul_pd(_mm256_sub_pd(py1, ay), dy));
+        t1 = _mm256_div_pd(t1, len2);
+        lo = _mm256_max_pd(_mm256_min_pd(t0, t1), zero);
+        hi = _mm256_min_pd(_mm256_max_pd(t1, t0), one);
+        collinear =
+            _PG_SELECT_AVX2(_PG_CMP_AVX2(lo, _CMP_LE_OQ, hi), lo, inf);
+
+        m = _mm256_and_pd(_PG_CMP_AVX2(tt, _CMP_GE_OQ, zero),
+                          _PG_CMP_AVX2(tt, _CMP_LE_OQ, one));
+        m = _mm256_and_pd(m, _mm256_and_pd(_PG_CMP_AVX2(u, _CMP_GE_OQ, zero),
+                                           _PG_CMP_AVX2(u, _CMP_LE_OQ, one)));
+        crossing = _PG_SELECT_AVX2(m, tt, inf);
+        m = _mm256_and_pd(_PG_CMP_AVX2(cross, _CMP_EQ_OQ, zero), has_len);
+        _mm256_storeu_pd(
+            t + i,
+            _PG_SELECT_AVX2(_PG_CMP_AVX2(den, _CMP_NEQ_UQ, zero), crossing,
+                            _PG_SELECT_AVX2(m, collinear, inf)));
+    }
+    for (; i < n; i++) {
+        t[i] = _pg_line_hit_segment(line, x0[i], y0[i], x1[i], y1[i]);
+    }
+}
+
+void
+line_hit_rects_avx2(const double *line, const double *x0, const double *y0,
+                    const double *x1, const double *y1, Py_ssize_t n,
+                    double *t)
+{
+    const double dxs = line[2] - line[0], dys = line[3] - line[1];
+    const __m256d ax = _mm256_set1_pd(line[0]), ay = _mm256_set1_pd(line[1]);
+    const __m256d sx = _mm256_set1_pd(dxs != 0.0 ? dxs : 1.0);
+    const __m256d sy = _mm256_set1_pd(dys != 0.0 ? dys : 1.0);
+    const __m256d zero = _mm256_setzero_pd(), one = _mm256_set1_pd(1.0);
+    const __m256d inf = _mm256_set1_pd(INFINITY);
+    const __m256d neg_inf = _mm256_set1_pd(-INFINITY);
+    const __m256d sign = _mm256_set1_pd(-0.0);
+    const __m256d moves_x =
+        _PG_CMP_AVX2(_mm256_set1_pd(dxs), _CMP_NEQ_UQ, zero);
+    const __m256d moves_y =
+        _PG_CMP_AVX2(_mm256_set1_pd(dys), _CMP_NEQ_UQ, zero);
+    __m256d left, top, right, bottom, tx0, tx1, ty0, ty1, inx, iny;
+    __m256d xlo, xhi, ylo, yhi, lo, hi;
+    Py_ssize_t i;
+
+    for (i = 0; i + 4 <= n; i += 4) {
+        left = _mm256_loadu_pd(x0 + i);
+        top = _mm256_loadu_pd(y0 + i);
+        right = _mm256_loadu_pd(x1 + i);
+        bottom = _mm256_loadu_pd(y1 + i);
+        tx0 = _mm256_div_pd(_mm256_sub_pd(left, ax), sx);
+        tx1 = _mm256_div_pd(_mm256_sub_pd(right, ax), sx);
+        ty0 = _mm256_div_pd(_mm256_sub_pd(top, ay), sy);
+        ty1 = _mm256_div_pd(_mm256_sub_pd(bottom, ay), sy);
+        inx = _mm256_and_pd(_PG_CMP_AVX2(ax, _CMP_GE_OQ, left),
+                            _PG_CMP_AVX2(ax, _CMP_LE_OQ, right));
+        inx = _PG_SELECT_AVX2(inx, inf, neg_inf);
+        iny = _mm256_and_pd(_PG_CMP_AVX2(ay, _CMP_GE_OQ, top),
+                            _PG_CMP_AVX2(ay, _CMP_LE_OQ, bottom));
+        iny = _PG_SELECT_AVX2(iny, inf, neg_inf);
+        xlo = _PG_SELECT_AVX2(moves_x, _mm256_min_pd(tx0, tx1),
+                              _mm256_xor_pd(inx, sign));
+        xhi = _PG_SELECT_AVX2(moves_x, _mm256_max_pd(tx1, tx0), inx);
+        ylo = _PG_SELECT_AVX2(moves_y, _mm256_min_pd(ty0, ty1),
+                              _mm256_xor_pd(iny, sign));
+        yhi = _PG_SELECT_AVX2(moves_y, _mm256_max_pd(ty1, ty0), iny);
+        lo = _mm256_max_pd(_mm256_max_pd(xlo, ylo), zero);
+        hi = _mm256_min_pd(_mm256_min_pd(xhi, yhi), one);
+        _mm256_storeu_pd(
+            t + i, _PG_SELECT_AVX2(_PG_CMP_AVX2(lo, _CMP_LE_OQ, hi), lo, inf));
+    }
+    for (; i < n; i++) {
+        t[i] = _pg_line_hit_rect(line, x0[i], y0[i], x1[i], y1[i]);
+    }
+}
+
+void
+line_hit_circles_avx2(const double *line, const double *x, const double *y,
+                      const double *r, Py_ssize_t n, double *t)
+{
+    const double dxs = line[2] - line[0], dys = line[3] - line[1];
+    const __m256d ax = _mm256_set1_pd(line[0]), ay = _mm256_set1_pd(line[1]);
+    const __m256d dx = _mm256_set1_pd(dxs), dy = _mm256_set1_pd(dys);
+    const __m256d a = _mm256_set1_pd(dxs * dxs + dys * dys);
+    const __m256d zero = _mm256_setzero_pd(), one = _mm256_set1_pd(1.0);
+    const __m256d inf = _mm256_set1_pd(INFINITY);
+    const __m256d sign = _mm256_set1_pd(-0.0);
+    __m256d fx, fy, pr, b, c, disc, tt, hit;
+    Py_ssize_t i;
+
+    for (i = 0; i + 4 <= n; i += 4) {
+        fx = _mm256_sub_pd(ax, _mm256_loadu_pd(x + i));
+        fy = _mm256_sub_pd(ay, _mm256_loadu_pd(y + i));
+        pr = _mm256_loadu_pd(r + i);
+        b = _mm256_add_pd(_mm256_mul_pd(fx, dx), _mm256_mul_pd(fy, dy));
+        c = _mm256_add_pd(_mm256_mul_pd(fx, fx), _mm256_mul_pd(fy, fy));
+        c = _mm256_sub_pd(c, _mm256_mul_pd(pr, pr));
+        disc = _mm256_sub_pd(_mm256_mul_pd(b, b), _mm256_mul_pd(a, c));
+        tt = _mm256_sqrt_pd(_mm256_max_pd(disc, zero));
+        tt = _mm256_div_pd(_mm256_sub_pd(_mm256_xor_pd(b, sign), tt), a);
+        hit = _mm256_and_pd(_PG_CMP_AVX2(tt, _CMP_GE_OQ, zero),
+                            _PG_CMP_AVX2(tt, _CMP_LE_OQ, one));
+        hit = _mm256_and_pd(hit, _PG_CMP_AVX2(disc, _CMP_GE_OQ, zero));
+        _mm256_storeu_pd(
+            t + i, _PG_SELECT_AVX2(_PG_CMP_AVX2(c, _CMP_LE_OQ, zero), zero,
+                                   _PG_SELECT_AVX2(hit, tt, inf)));
+    }
+    for (; i < n; i++) {
+        t[i] = _pg_line_hit_circle(line, x[i], y[i], r[i]);
+    }
+}
+#else
+void
+line_hit_segments_avx2(const double *line, const double *x0,
+                       const double *y0, const double *x1, const double *y1,
+                       Py_ssize_t n, double *t)
+{
+    BAD_AVX2_FUNCTION_CALL;
+}
+
+void
+line_hit_rects_avx2(const double *line, const double *x0, const double *y0,
+                    const double *x1, const double *y1, Py_ssize_t n,
+                    double *t)
+{
+    BAD_AVX2_FUNCTION_CALL;
+}
+
+void
+line_hit_circles_avx2(const double *line, const double *x, const double *y,
+                      const double *r, Py_ssize_t n, double *t)
+{
+    BAD_AVX2_FUNCTION_CALL;
+}
+#endif /* defined(__AVX2__) && defined(HAVE_IMMINTRIN_H) && \
+          !defined(SDL_DISABLE_IMMINTRIN_H) */
@@ -0,0 +1,203 @@
+#include "simd_geometry.h"
+
+#if PG_ENABLE_ARM_NEON
+// sse2neon.h is from here: https://github.com/DLTcollab/sse2neon
+#include "include/sse2neon.h"
+#endif /* PG_ENABLE_ARM_NEON */
+
+#define BAD_SSE2_FUNCTION_CALL                                               \
+    printf(                                                                  \
+        "Fatal Error: Attempted calling an SSE2 function when both compile " \
+        "time and runtime support is missing. If you are seeing this "       \
+        "message, you have stumbled across a pygame bug, please report it "  \
+        "to the devs!");                                                     \
+    PG_EXIT(1)
+
+int
+_pg_geometry_HasSSE_NEON()
+{
+#if defined(__SSE2__)
+    return pg_simd_max_level() >= PG_SIMD_SSE2_NEON && SDL_HasSSE2();
+#elif PG_ENABLE_ARM_NEON
+    return pg_simd_max_level() >= PG_SIMD_SSE2_NEON && SDL_HasNEON();
+#else
+    return 0;
+#endif
+}
+
+#if defined(__SSE2__) || defined(PG_ENABLE_ARM_NEON)
+/* m ? a : b for each lane, m being the all ones or all zeros result of a
+ * comparison */
+#define _PG_SELECT_SSE2(m, a, b) \
+    _mm_or_pd(_mm_and_pd(m, a), _mm_andnot_pd(m, b))
+
+/* The lanes compute the same selects as _pg_line_hit_segment() and friends.
+ * _mm_min_pd(a, b) is a < b ? a : b and _mm_max_pd(a, b) is a > b ? a : b,
+ * also when a value is NaN. */
+void
+line_hit_segments_sse2(const double *line, const double *x0,
+                       const double *y0, const double *x1, const double *y1,
+                       Py_ssize_t n, double *t)
+{
+    const double dxs = line[2] - line[0], dys = line[3] - line[1];
+    const __m128d ax = _mm_set1_pd(line[0]), ay = _mm_set1_pd(line[1]);
+    const __m128d dx = _mm_set1_pd(dxs), dy = _mm_set1_pd(dys);
+    const __m128d len2 = _mm_set1_pd(dxs * dxs + dys * dys);
+    const __m128d zero = _mm_setzero_pd(), one = _mm_set1_pd(1.0);
+    const __m128d inf = _mm_set1_pd(INFINITY);
+    const __m128d has_len = _mm_cmpneq_pd(len2, zero);
+    __m128d px0, py0, px1, py1, ex, ey, fx, fy, den, cross, tt, u, t0, t1;
+    __m128d lo, hi, collinear, crossing, m;
+    Py_ssize_t i;
+
+    for (i = 0; i + 2 <= n; i += 2) {
+        px0 = _mm_loadu_pd(x0 + i);
+        py0 = _mm_loadu_pd(y0 + i);
+        px1 = _mm_loadu_pd(x1 + i);
+        py1 = _mm_loadu_pd(y1 + i);
+        ex = _mm_sub_pd(px1, px0);
+        ey = _mm_sub_pd(py1, py0);
+        fx = _mm_sub_pd(px0, ax);
+        fy = _mm_sub_pd(py0, ay);
+        den = _mm_sub_pd(_mm_mul_pd(dx, ey), _mm_mul_pd(dy, ex));
+        cross = _mm_sub_pd(_mm_mul_pd(fx, dy), _mm_mul_pd(fy, dx));
+        tt = _mm_div_pd(_mm_sub_pd(_mm_mul_pd(fx, ey), _mm_mul_pd(fy, ex)),
+                        den);
+        u = _mm_div_pd(cross, den);
+
+        t0 = _mm_div_pd(_mm_add_pd(_mm_mul_pd(fx, dx), _mm_mul_pd(fy, dy)),
+                        len2);
+        t1 = _mm_div_pd(
+            _mm_add_pd(_mm_mul_pd(_mm_sub_pd(px1, ax), dx),
+                       _mm_mul_pd(_mm_sub_pd(py1, ay), dy)),
+            len2);
+        lo = _mm_max_pd(_mm_min_pd(t0, t1), zero);
+        hi = _mm_min_pd(_mm_max_pd(t1, t0), one);
+        collinear = _PG_SELECT_SSE2(_mm_cmple_pd(lo, hi), lo, inf);
+
+        m = _mm_and_pd(_mm_and_pd(_mm_cmpge_pd(tt, zero),
+                                  _mm_cmple_pd(tt, one)),
+                       _mm_and_pd(_mm_cmpge_pd(u, zero),
+                                  _mm_cmple_pd(u, one)));
+        crossing = _PG_SELECT_SSE2(m, tt, inf);
+        m = _mm_and_pd(_mm_cmpeq_pd(cross, zero), has_len);
+        _mm_storeu_pd(
+            t + i,
+            _PG_SELECT_SSE2(_mm_cmpneq_pd(den, zero), crossing,
+                            _PG_SELECT_SSE2(m, collinear, inf)));
+    }
+    for (; i < n; i++) {
+        t[i] = _pg_line_hit_segment(line, x0[i], y0[i], x1[i], y1[i]);
+    }
+}
+
+void
+line_hit_rects_sse2(const double *line, const double *x0, const double *y0,
+                    const double *x1, const double *y1, Py_ssize_t n,
+                    double *t)
+{
+    const double dxs = line[2] - line[0], dys = line[3] - line[1];
+    const __m128d ax = _mm_set1_pd(line[0]), ay = _mm_set1_pd(line[1]);
+    const __m128d sx = _mm_set1_pd(dxs != 0.0 ? dxs : 1.0);
+    const __m128d sy = _mm_set1_pd(dys != 0.0 ? dys : 1.0);
+    const __m128d zero = _mm_setzero_pd(), one = _mm_set1_pd(1.0);
+    const __m128d inf = _mm_set1_pd(INFINITY);
+    const __m128d neg_inf = _mm_set1_pd(-INFINITY);
+    const __m128d sign = _mm_set1_pd(-0.0);
+    const __m128d moves_x = _mm_cmpneq_pd(_mm_set1_pd(dxs), zero);
+    const __m128d moves_y = _mm_cmpneq_pd(_mm_set1_pd(dys), zero);
+    __m128d left, top, right, bottom, tx0, tx1, ty0, ty1, inx, iny;
+    __m128d xlo, xhi, ylo, yhi, lo, hi;
+    Py_ssize_t i;
+
+    for (i = 0; i + 2 <= n; i += 2) {
+        left = _mm_loadu_pd(x0 + i);
+        top = _mm_loadu_pd(y0 + i);
+        right = _mm_loadu_pd(x1 + i);
+        bottom = _mm_loadu_pd(y1 + i);
+        tx0 = _mm_div_pd(_mm_sub_pd(left, ax), sx);
+        tx1 = _mm_div_pd(_mm_sub_pd(right, ax), sx);
+        ty0 = _mm_div_pd(_mm_sub_pd(top, ay), sy);
+        ty1 = _mm_div_pd(_mm_sub_pd(bottom, ay), sy);
+        inx = _PG_SELECT_SSE2(
+            _mm_and_pd(_mm_cmpge_pd(ax, left), _mm_cmple_pd(ax, right)), inf,
+            neg_inf);
+        iny = _PG_SELECT_SSE2(
+            _mm_and_pd(_mm_cmpge_pd(ay, top), _mm_cmple_pd(ay, bottom)), inf,
+            neg_inf);
+        xlo = _PG_SELECT_SSE2(moves_x, _mm_min_pd(tx0, tx1),
+                              _mm_xor_pd(inx, sign));
+        xhi = _PG_SELECT_SSE2(moves_x, _mm_max_pd(tx1, tx0), inx);
+        ylo = _PG_SELECT_SSE2(moves_y, _mm_min_pd(ty0, ty1),
+                              _mm_xor_pd(iny, sign));
+        yhi = _PG_SELECT_SSE2(moves_y, _mm_max_pd(ty1, ty0), iny);
+        lo = _mm_max_pd(_mm_max_pd(xlo, ylo), zero);
+        hi = _mm_min_pd(_mm_min_pd(xhi, yhi), one);
+        _mm_storeu_pd(t + i,
+                      _PG_SELECT_SSE2(_mm_cmple_pd(lo, hi), lo, inf));
+    }
+    for (; i < n; i++) {
+        t[i] = _pg_line_hit_rect(line, x0[i], y0[i], x1[i], y1[i]);
+    }
+}
+
+void
+line_hit_circles_sse2(const double *line, const double *x, const double *y,
+                      const double *r, Py_ssize_t n, double *t)
+{
+    const double dxs = line[2] - line[0], dys = line[3] - line[1];
+    const __m128d ax = _mm_set1_pd(line[0]), ay = _mm_set1_pd(line[1]);
+    const __m128d dx = _mm_set1_pd(dxs), dy = _mm_set1_pd(dys);
+    const __m128d a = _mm_set1_pd(dxs * dxs + dys * dys);
+    const __m128d zero = _mm_setzero_pd(), one = _mm_set1_pd(1.0);
+    const __m128d inf = _mm_set1_pd(INFINITY);
+    const __m128d sign = _mm_set1_pd(-0.0);
+    __m128d fx, fy, pr, b, c, disc, tt, hit;
+    Py_ssize_t i;
+
+    for (i = 0; i + 2 <= n; i += 2) {
+        fx = _mm_sub_pd(ax, _mm_loadu_pd(x + i));
+        fy = _mm_sub_pd(ay, _mm_loadu_pd(y + i));
+        pr = _mm_loadu_pd(r + i);
+        b = _mm_add_pd(_mm_mul_pd(fx, dx), _mm_mul_pd(fy, dy));
+        c = _mm_sub_pd(_mm_add_pd(_mm_mul_pd(fx, fx), _mm_mul_pd(fy, fy)),
+                       _mm_mul_pd(pr, pr));
+        disc = _mm_sub_pd(_mm_mul_pd(b, b), _mm_mul_pd(a, c));
+        tt = _mm_div_pd(_mm_sub_pd(_mm_xor_pd(b, sign),
+                                   _mm_sqrt_pd(_mm_max_pd(disc, zero))),
+                        a);
+        hit = _mm_and_pd(_mm_cmpge_pd(disc, zero),
+                         _mm_and_pd(_mm_cmpge_pd(tt, zero),
+                                    _mm_cmple_pd(tt, one)));
+        _mm_storeu_pd(t + i,
+                      _PG_SELECT_SSE2(_mm_cmple_pd(c, zero), zero,
+                                      _PG_SELECT_SSE2(hit, tt, inf)));
+    }
+    for (; i < n; i++) {
+        t[i] = _pg_line_hit_circle(line, x[i], y[i], r[i]);
+    }
+}
+#else
+void
+line_hit_segments_sse2(const double *line, const double *x0,
+                       const double *y0, const double *x1, const double *y1,
+                       Py_ssize_t n, double *t)
+{
+    BAD_SSE2_FUNCTION_CALL;
+}
+
+void
+line_hit_rects_sse2(const double *line, const double *x0, const double *y0,
+                    const double *x1, const double *y1, Py_ssize_t n,
+                    double *t)
+{
+    BAD_SSE2_FUNCTION_CALL;
+}
+
+void
+line_hit_circles_sse2(const double *line, const double *x, const double *y,
+                      const double *r, Py_ssize_t n, double *t)
+{
+    BAD_SSE2_FUNCTION_CALL;
+}
+#endif /* defined(__SSE2__) || defined(PG_ENABLE_ARM_NEON) */
@@ -0,0 +1,84 @@
+#define NO_PYGAME_C_API
+#include "_surface.h"
+
+#if !defined(PG_ENABLE_ARM_NEON) && defined(__aarch64__)
+// arm64 has neon optimisations enabled by default, even when fpu=neon is not
+// passed
+#define PG_ENABLE_ARM_NEON 1
+#endif
+
+#if defined(__SSE2__)
+#define PG_ENABLE_SSE_NEON 1
+#elif PG_ENABLE_ARM_NEON
+#define PG_ENABLE_SSE_NEON 1
+#else
+#define PG_ENABLE_SSE_NEON 0
+#endif
+
+int
+_pg_image_has_avx2();
+
+/* This returns True if either SSE2 or NEON is present at runtime.
+ * Relevant because they use the same codepaths. Only the relevant runtime
+ * SDL cpu feature check is compiled in.*/
+int
+_pg_image_HasSSE_NEON();
+
+/* Row kernels of image.tobytes() and image.frombytes().
+ * tobytes_row: converts n 4 byte pixels of src into n pixels of out_bpp
+ * (3 or 4) bytes. Byte j of an output pixel is byte order[j] of the source
+ * pixel in memory, or 0xFF if order[j] is negative.
+ * swap24_row: copies n 3 byte pixels, swapping the first and the last byte
+ * of each. */
+typedef void (*TOBYTES_ROW_P)(const Uint8 *src, Uint8 *dst, int n,
+                              const Sint8 *order, int out_bpp);
+typedef void (*SWAP24_ROW_P)(const Uint8 *src, Uint8 *dst, int n);
+
+/* Shared by the kernels, converts the remaining pixels from x on one by
+ * one */
+static PG_INLINE void
+_pg_tobytes_row_finish(const Uint8 *src, Uint8 *dst, int x, int n,
+                       const Sint8 *order, int out_bpp)
+{
+    int j;
+
+    for (src += x * 4, dst += x * out_bpp; x < n; x++) {
+        for (j = 0; j < out_bpp; j++) {
+            *dst++ = order[j] < 0 ? 0xFF : src[order[j]];
+        }
+        src += 4;
+    }
+}
+
+static PG_INLINE void
+_pg_swap24_row_finish(const Uint8 *src, Uint8 *dst, int x, int n)
+{
+    for (src += x * 3, dst += x * 3; x < n; x++) {
+        dst[0] = src[2];
+        dst[1] = src[1];
+        dst[2] = src[0];
+        src += 3;
+        dst += 3;
+    }
+}
+
+/* the generic versions, used if there is no SIMD support */
+void
+tobytes_row(const Uint8 *src, Uint8 *dst, int n, const Sint8 *order,
+            int out_bpp);
+void
+swap24_row(const Uint8 *src, Uint8 *dst, int n);
+
+// SSE2 functions
+void
+tobytes_row_sse2(const Uint8 *src, Uint8 *dst, int n, const Sint8 *order,
+                 int out_bpp);
+void
+swap24_row_sse2(const Uint8 *src, Uint8 *dst, int n);
+
+// AVX2 functions
+void
+tobytes_row_avx2(const Uint8 *src, Uint8 *dst, int n, const Sint8 *order,
+                 int out_bpp);
+void
+swap24_row_avx2(const Uint8 *src, Uint8 *dst, int n);
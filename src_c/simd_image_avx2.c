@@ -0,0 +1,116 @@
+#include "simd_image.h"
+
+#if defined(HAVE_IMMINTRIN_H) && !defined(SDL_DISABLE_IMMINTRIN_H)
+#include <immintrin.h>
+#endif /* defined(HAVE_IMMINTRIN_H) && !defined(SDL_DISABLE_IMMINTRIN_H) */
+
+#define BAD_AVX2_FUNCTION_CALL                                               \
+    printf(                                                                  \
+        "Fatal Error: Attempted calling an AVX2 function when both compile " \
+        "time and runtime support is missing. If you are seeing this "       \
+        "message, you have stumbled across a pygame bug, please report it "  \
+        "to the devs!");                                                     \
+    PG_EXIT(1)
+
+/* helper function that does a runtime check for AVX2. It has the added
+ * functionality of also returning 0 if compile time support is missing */
+int
+_pg_image_has_avx2()
+{
+#if defined(__AVX2__) && defined(HAVE_IMMINTRIN_H) && \
+    !defined(SDL_DISABLE_IMMINTRIN_H)
+    return pg_simd_max_level() >= PG_SIMD_AVX2 && SDL_HasAVX2();
+#else
+    return 0;
+#endif /* defined(__AVX2__) && defined(HAVE_IMMINTRIN_H) && \
+          !defined(SDL_DISABLE_IMMINTRIN_H) */
+}
+
+#if defined(__AVX2__) && defined(HAVE_IMMINTRIN_H) && \
+    !defined(SDL_DISABLE_IMMINTRIN_H)
+/* One byte shuffle per 8 pixels. The shuffle works within the 128 bit
+ * halves, so for 3 byte output each half holds 12 bytes, which the permute
+ * moves next to each other. */
+void
+tobytes_row_avx2(const Uint8 *src, Uint8 *dst, int n, const Sint8 *order,
+                 int out_bpp)
+{
+    const __m256i mm256_pack = _mm256_setr_epi32(0, 1, 2, 4, 5, 6, 3, 7);
+    const __m256i mm256_store24 =
+        _mm256_setr_epi32(-1, -1, -1, -1, -1, -1, 0, 0);
+    Uint8 shuffle[32], fill[32];
+    __m256i mm256_shuffle, mm256_fill, out;
+    int x, i, p, j;
+
+    memset(shuffle, 0x80, sizeof(shuffle));
+    memset(fill, 0, sizeof(fill));
+    for (i = 0; i < 32; i += 16) {
+        for (p = 0; p < 4; p++) {
+            for (j = 0; j < out_bpp; j++) {
+                if (order[j] < 0) {
+                    fill[i + p * out_bpp + j] = 0xFF;
+                }
+                else {
+                    shuffle[i + p * out_bpp + j] = (Uint8)(p * 4 + order[j]);
+                }
+            }
+        }
+    }
+    mm256_shuffle = _mm256_loadu_si256((const __m256i *)shuffle);
+    mm256_fill = _mm256_loadu_si256((const __m256i *)fill);
+
+    for (x = 0; x + 8 <= n; x += 8) {
+        out = _mm256_shuffle_epi8(
+            _mm256_loadu_si256((const __m256i *)(src + x * 4)),
+            mm256_shuffle);
+        out = _mm256_or_si256(out, mm256_fill);
+        if (out_bpp == 4) {
+            _mm256_storeu_si256((__m256i *)(dst + x * 4), out);
+        }
+        else {
+            out = _mm256_permutevar8x32_epi32(out, mm256_pack);
+            _mm256_maskstore_epi32((int *)(dst + x * 3), mm256_store24, out);
+        }
+    }
+    _pg_tobytes_row_finish(src, dst, x, n, order, out_bpp);
+}
+
+/* 5 pixels per 128 bit half. Each half stores a 16th byte, which the next
+ * store overwrites as long as another pixel follows in the row. */
+void
+swap24_row_avx2(const Uint8 *src, Uint8 *dst, int n)
+{
+    const __m256i mm256_shuffle = _mm256_setr_epi8(
+        2, 1, 0, 5, 4, 3, 8, 7, 6, 11, 10, 9, 14, 13, 12, -128, 2, 1, 0, 5, 4,
+        3, 8, 7, 6, 11, 10, 9, 14, 13, 12, -128);
+    __m256i pixels;
+    int x;
+
+    for (x = 0; x + 11 <= n; x += 10) {
+        pixels = _mm256_inserti128_si256(
+            _mm256_castsi128_si256(
+                _mm_loadu_si128((const __m128i *)(src + x * 3))),
+            _mm_loadu_si128((const __m128i *)(src + x * 3 + 15)), 1);
+        pixels = _mm256_shuffle_epi8(pixels, mm256_shuffle);
+        _mm_storeu_si128((__m128i *)(dst + x * 3),
+                         _mm256_castsi256_si128(pixels));
+        _mm_storeu_si128((__m128i *)(dst + x * 3 + 15),
+                         _mm256_extracti128_si256(pixels, 1));
+    }
+    _pg_swap24_row_finish(src, dst, x, n);
+}
+#else
+void
+tobytes_row_avx2(const Uint8 *src, Uint8 *dst, int n, const Sint8 *order,
+                 int out_bpp)
+{
+    BAD_AVX2_FUNCTION_CALL;
+}
+
+void
+swap24_row_avx2(const Uint8 *src, Uint8 *dst, int n)
+{
+    BAD_AVX2_FUNCTION_CALL;
+}
+#endif /* defined(__AVX2__) && defined(HAVE_IMMINTRIN_H) && \
+          !defined(SDL_DISABLE_IMMINTRIN_H) */
@@ -0,0 +1,120 @@
+#include "simd_image.h"
+
+#if PG_ENABLE_ARM_NEON
+// sse2neon.h is from here: https://github.com/DLTcollab/sse2neon
+#include "include/sse2neon.h"
+#endif /* PG_ENABLE_ARM_NEON */
+
+#define BAD_SSE2_FUNCTION_CALL                                               \
+    printf(                                                                  \
+        "Fatal Error: Attempted calling an SSE2 function when both compile " \
+        "time and runtime support is missing. If you are seeing this "       \
+        "message, you have stumbled across a pygame bug, please report it "  \
+        "to the devs!");                                                     \
+    PG_EXIT(1)
+
+int
+_pg_image_HasSSE_NEON()
+{
+#if defined(__SSE2__)
+    return pg_simd_max_level() >= PG_SIMD_SSE2_NEON && SDL_HasSSE2();
+#elif PG_ENABLE_ARM_NEON
+    return pg_simd_max_level() >= PG_SIMD_SSE2_NEON && SDL_HasNEON();
+#else
+    return 0;
+#endif
+}
+
+#if defined(__SSE2__) || defined(PG_ENABLE_ARM_NEON)
+/* Every output byte j is moved into place with a pair of shifts. A right
+ * shift by 32 clears the lane, so the bytes filled with 0xFF cost no
+ * branches. */
+void
+tobytes_row_sse2(const Uint8 *src, Uint8 *dst, int n, const Sint8 *order,
+                 int out_bpp)
+{
+    const __m128i mm_ff = _mm_set1_epi32(0xFF);
+    const __m128i mm_lo64 = _mm_set_epi32(0, -1, 0, -1);
+    const __m128i mm_lane0 = _mm_set_epi32(0, 0, -1, -1);
+    __m128i mm_shr[4], mm_shl[4];
+    __m128i pixels, out;
+    Uint32 fill = 0, last;
+    int x, j;
+
+    for (j = 0; j < 4; j++) {
+        if (j < out_bpp && order[j] < 0) {
+            fill |= (Uint32)0xFF << (j * 8);
+        }
+        mm_shr[j] = _mm_cvtsi32_si128(j < out_bpp && order[j] >= 0
+                                          ? order[j] * 8
+                                          : 32);
+        mm_shl[j] = _mm_cvtsi32_si128(j * 8);
+    }
+
+    for (x = 0; x + 4 <= n; x += 4) {
+        pixels = _mm_loadu_si128((const __m128i *)(src + x * 4));
+        out = _mm_set1_epi32((int)fill);
+        for (j = 0; j < 4; j++) {
+            out = _mm_or_si128(
+                out,
+                _mm_sll_epi32(
+                    _mm_and_si128(_mm_srl_epi32(pixels, mm_shr[j]), mm_ff),
+                    mm_shl[j]));
+        }
+        if (out_bpp == 4) {
+            _mm_storeu_si128((__m128i *)(dst + x * 4), out);
+            continue;
+        }
+        /* pack the low 3 bytes of the 4 lanes into 12 bytes, first within
+         * each 64 bit half, then the halves together */
+        out = _mm_or_si128(_mm_and_si128(out, mm_lo64),
+                           _mm_srli_epi64(_mm_andnot_si128(mm_lo64, out), 8));
+        out = _mm_or_si128(
+            _mm_and_si128(out, mm_lane0),
+            _mm_srli_si128(_mm_andnot_si128(mm_lane0, out), 2));
+        _mm_storel_epi64((__m128i *)(dst + x * 3), out);
+        last = (Uint32)_mm_cvtsi128_si32(_mm_srli_si128(out, 8));
+        memcpy(dst + x * 3 + 8, &last, 4);
+    }
+    _pg_tobytes_row_finish(src, dst, x, n, order, out_bpp);
+}
+
+/* 5 pixels per 16 bytes. The 16th byte is stored too, which is fine as
+ * long as another pixel follows in the row to overwrite it. */
+void
+swap24_row_sse2(const Uint8 *src, Uint8 *dst, int n)
+{
+    const __m128i mm_first =
+        _mm_setr_epi8(-1, 0, 0, -1, 0, 0, -1, 0, 0, -1, 0, 0, -1, 0, 0, 0);
+    const __m128i mm_middle =
+        _mm_setr_epi8(0, -1, 0, 0, -1, 0, 0, -1, 0, 0, -1, 0, 0, -1, 0, 0);
+    const __m128i mm_last =
+        _mm_setr_epi8(0, 0, -1, 0, 0, -1, 0, 0, -1, 0, 0, -1, 0, 0, -1, 0);
+    __m128i pixels, out;
+    int x;
+
+    for (x = 0; x + 6 <= n; x += 5) {
+        pixels = _mm_loadu_si128((const __m128i *)(src + x * 3));
+        out = _mm_and_si128(pixels, mm_middle);
+        out = _mm_or_si128(
+            out, _mm_and_si128(_mm_srli_si128(pixels, 2), mm_first));
+        out = _mm_or_si128(out,
+                           _mm_and_si128(_mm_slli_si128(pixels, 2), mm_last));
+        _mm_storeu_si128((__m128i *)(dst + x * 3), out);
+    }
+    _pg_swap24_row_finish(src, dst, x, n);
+}
+#else
+void
+tobytes_row_sse2(const Uint8 *src, Uint8 *dst, int n, const Sint8 *order,
+                 int out_bpp)
+{
+    BAD_SSE2_FUNCTION_CALL;
+}
+
+void
+swap24_row_sse2(const Uint8 *src, Uint8 *dst, int n)
+{
+    BAD_SSE2_FUNCTION_CALL;
+}
+#endif /* defined(__SSE2__) || defined(PG_ENABLE_ARM_NEON) */
@@ -0,0 +1,258 @@
+#define NO_PYGAME_C_API
+#include "_surface.h"
+#include "include/bitmask.h"
+
+#if !defined(PG_ENABLE_ARM_NEON) && defined(__aarch64__)
+// arm64 has neon optimisations enabled by default, even when fpu=neon is not
+// passed
+#define PG_ENABLE_ARM_NEON 1
+#endif
+
+#if defined(__SSE2__)
+#define PG_ENABLE_SSE_NEON 1
+#elif PG_ENABLE_ARM_NEON
+#define PG_ENABLE_SSE_NEON 1
+#else
+#define PG_ENABLE_SSE_NEON 0
+#endif
+
+int
+_pg_mask_has_avx2();
+
+/* This returns True if either SSE2 or NEON is present at runtime.
+ * Relevant because they use the same codepaths. Only the relevant runtime
+ * SDL cpu feature check is compiled in.*/
+int
+_pg_mask_HasSSE_NEON();
+
+/* Row kernels of Mask.from_surface() and from_threshold(), for 32 bit
+ * pixels. Bit x of a mask row is bit x % BITMASK_W_LEN of
+ * bits[x / BITMASK_W_LEN * stride], see bitmask.h. Every word of the row is
+ * overwritten, not combined with the old bits.
+ * mask_alpha_row: sets the pixels whose 8 bit alpha at ashift is greater than
+ * threshold.
+ * mask_colorkey_row: sets the pixels that aren't equal to colorkey.
+ * mask_threshold_row: sets the pixels whose 4 bytes each differ by at most
+ * the matching byte of tlimit from the src2 pixel, or from color if src2 is
+ * NULL. */
+typedef void (*MASK_ALPHA_ROW_P)(const Uint32 *src, int n, int ashift,
+                                 int threshold, BITMASK_W *bits, int stride);
+typedef void (*MASK_COLORKEY_ROW_P)(const Uint32 *src, int n, Uint32 colorkey,
+                                    BITMASK_W *bits, int stride);
+typedef void (*MASK_THRESHOLD_ROW_P)(const Uint32 *src, const Uint32 *src2,
+                                     int n, Uint32 color, Uint32 tlimit,
+                                     BITMASK_W *bits, int stride);
+
+/* Row kernel of Mask.to_surface() drawing with colors only, for 32 bit
+ * pixels. Takes the n bits of a mask row from bit x on, laid out as for the
+ * kernels above, and writes setcolor to the matching pixels of dst where a
+ * bit is set if draw_set is non-zero, and unsetcolor where it isn't if
+ * draw_unset is. Other pixels are left as they were. The bits are taken a
+ * word at a time, so rows of all set or all unset bits become fills. */
+typedef void (*MASK_TO_SURFACE_ROW_P)(Uint32 *dst, int n,
+                                      const BITMASK_W *bits, int stride,
+                                      int x, Uint32 setcolor,
+                                      Uint32 unsetcolor, int draw_set,
+                                      int draw_unset);
+
+/* Overlap area kernel of Mask.overlap_area(), counts the bits that are set
+ * in both a[i] and b[i] for 0 <= i < n. */
+typedef unsigned int (*MASK_AND_COUNT_P)(const BITMASK_W *a,
+                                         const BITMASK_W *b, int n);
+
+/* Shared by the kernels. PG_MASK_ROW_ADD adds the bits of a SIMD block of len
+ * pixels starting at x to word, storing it once it is full.
+ * PG_MASK_ROW_FINISH tests the remaining pixels of the row one by one and
+ * stores the last word. */
+#define PG_MASK_ROW_ADD(m, len)                                     \
+    word |= (BITMASK_W)(Uint32)(m) << (x & BITMASK_W_MASK);         \
+    if (((x + (len)) & BITMASK_W_MASK) == 0) {                      \
+        bits[x / BITMASK_W_LEN * stride] = word;                    \
+        word = 0;                                                   \
+    }
+
+#define PG_MASK_ROW_FINISH(test)                                    \
+    for (; x < n; x++) {                                            \
+        if (test) {                                                 \
+            word |= BITMASK_N(x & BITMASK_W_MASK);                  \
+        }                                                           \
+        if ((x & BITMASK_W_MASK) == BITMASK_W_MASK) {               \
+            bits[x / BITMASK_W_LEN * stride] = word;                \
+            word = 0;                                               \
+        }                                                           \
+    }                                                               \
+    if (n & BITMASK_W_MASK) {                                       \
+        bits[n / BITMASK_W_LEN * stride] = word;                    \
+    }
+
+/* the generic versions, used if there is no SIMD support */
+void
+mask_alpha_row(const Uint32 *src, int n, int ashift, int threshold,
+               BITMASK_W *bits, int stride);
+void
+mask_colorkey_row(const Uint32 *src, int n, Uint32 colorkey, BITMASK_W *bits,
+                  int stride);
+void
+mask_threshold_row(const Uint32 *src, const Uint32 *src2, int n, Uint32 color,
+                   Uint32 tlimit, BITMASK_W *bits, int stride);
+
+unsigned int
+mask_and_count(const BITMASK_W *a, const BITMASK_W *b, int n);
+void
+mask_to_surface_row(Uint32 *dst, int n, const BITMASK_W *bits, int stride,
+                    int x, Uint32 setcolor, Uint32 unsetcolor, int draw_set,
+                    int draw_unset);
+
+/* Up to BITMASK_W_LEN bits of a row from bit x on, of which there are n
+ * left. Bit 0 of the result is bit x, bits at n and above are 0. */
+static PG_INLINE BITMASK_W
+_pg_mask_row_word(const BITMASK_W *bits, int stride, int x, int n)
+{
+    int shift = x & BITMASK_W_MASK;
+    const BITMASK_W *p = bits + x / BITMASK_W_LEN * stride;
+    BITMASK_W w = p[0] >> shift;
+
+    if (shift && (int)BITMASK_W_LEN - shift < n) {
+        w |= p[stride] << (BITMASK_W_LEN - shift);
+    }
+    if (n < (int)BITMASK_W_LEN) {
+        w &= BITMASK_N(n) - 1;
+    }
+    return w;
+}
+
+/* Shared by the mask_to_surface_row kernels. If the len bits of w are all
+ * unset or all set, fills the len pixels at dst with the color drawn for
+ * them, if any, and returns 1. Returns 0 otherwise. */
+static PG_INLINE int
+_pg_mask_fill_word(Uint32 *dst, BITMASK_W w, int len, Uint32 setcolor,
+                   Uint32 unsetcolor, int draw_set, int draw_unset)
+{
+    BITMASK_W full =
+        len < (int)BITMASK_W_LEN ? BITMASK_N(len) - 1 : ~(BITMASK_W)0;
+    Uint32 color;
+    int i;
+
+    if (w != 0 && w != full) {
+        return 0;
+    }
+    if (!(w ? draw_set : draw_unset)) {
+        return 1;
+    }
+    color = w ? setcolor : unsetcolor;
+    for (i = 0; i < len; ++i) {
+        dst[i] = color;
+    }
+    return 1;
+}
+
+/* Draws the pixels from start up to len at dst one by one, for bits start
+ * up to len of w. */
+static PG_INLINE void
+_pg_mask_expand_word(Uint32 *dst, BITMASK_W w, int start, int len,
+                     Uint32 setcolor, Uint32 unsetcolor, int draw_set,
+                     int draw_unset)
+{
+    int i;
+
+    for (i = start; i < len; ++i) {
+        if (w & BITMASK_N(i)) {
+            if (draw_set) {
+                dst[i] = setcolor;
+            }
+        }
+        else if (draw_unset) {
+            dst[i] = unsetcolor;
+        }
+    }
+}
+
+/* the number of set bits in w */
+static PG_INLINE unsigned int
+_pg_mask_bitcount(BITMASK_W w)
+{
+    Uint64 n = (Uint64)w;
+
+    n = n - ((n >> 1) & 0x5555555555555555ULL);
+    n = (n & 0x3333333333333333ULL) + ((n >> 2) & 0x3333333333333333ULL);
+    n = (n + (n >> 4)) & 0x0F0F0F0F0F0F0F0FULL;
+    return (unsigned int)((n * 0x0101010101010101ULL) >> 56);
+}
+
+/* w shifted left by shift, or right by -shift if shift is negative */
+static PG_INLINE BITMASK_W
+_pg_mask_shift_word(BITMASK_W w, int shift)
+{
+    return shift >= 0 ? w << shift : w >> -shift;
+}
+
+/* the mask_threshold_row test of one pixel */
+#define PG_MASK_BYTE_DIFF(a, b, shift) \
+    abs((int)(((a) >> (shift)) & 0xFF) - (int)(((b) >> (shift)) & 0xFF))
+#define PG_MASK_THRESHOLD_TEST(a, b, tlimit)                    \
+    (PG_MASK_BYTE_DIFF(a, b, 0) <= (int)((tlimit)&0xFF) &&      \
+     PG_MASK_BYTE_DIFF(a, b, 8) <= (int)((tlimit) >> 8 & 0xFF) && \
+     PG_MASK_BYTE_DIFF(a, b, 16) <= (int)((tlimit) >> 16 & 0xFF) && \
+     PG_MASK_BYTE_DIFF(a, b, 24) <= (int)((tlimit) >> 24))
+
+// SSE2 functions
+void
+mask_alpha_row_sse2(const Uint32 *src, int n, int ashift, int threshold,
+                    BITMASK_W *bits, int stride);
+void
+mask_colorkey_row_sse2(const Uint32 *src, int n, Uint32 colorkey,
+                       BITMASK_W *bits, int stride);
+void
+mask_threshold_row_sse2(const Uint32 *src, const Uint32 *src2, int n,
+                        Uint32 color, Uint32 tlimit, BITMASK_W *bits,
+                        int stride);
+unsigned int
+mask_and_count_sse2(const BITMASK_W *a, const BITMASK_W *b, int n);
+void
+mask_to_surface_row_sse2(Uint32 *dst, int n, const BITMASK_W *bits,
+                         int stride, int x, Uint32 setcolor,
+                         Uint32 unsetcolor, int draw_set, int draw_unset);
+
+/* the bitmask_kernels_t kernels, see bitmask.h */
+unsigned int
+mask_count_words_sse2(const BITMASK_W *w, int n);
+void
+mask_invert_words_sse2(BITMASK_W *w, int n, BITMASK_W mask);
+void
+mask_draw_words_sse2(BITMASK_W *a, const BITMASK_W *b, int n, int shift);
+void
+mask_erase_words_sse2(BITMASK_W *a, const BITMASK_W *b, int n, int shift);
+void
+mask_overlap_words_sse2(BITMASK_W *c, const BITMASK_W *a, const BITMASK_W *b,
+                        int n, int shift, int accumulate);
+
+// AVX2 functions
+void
+mask_alpha_row_avx2(const Uint32 *src, int n, int ashift, int threshold,
+                    BITMASK_W *bits, int stride);
+void
+mask_colorkey_row_avx2(const Uint32 *src, int n, Uint32 colorkey,
+                       BITMASK_W *bits, int stride);
+void
+mask_threshold_row_avx2(const Uint32 *src, const Uint32 *src2, int n,
+                        Uint32 color, Uint32 tlimit, BITMASK_W *bits,
+                        int stride);
+unsigned int
+mask_and_count_avx2(const BITMASK_W *a, const BITMASK_W *b, int n);
+void
+mask_to_surface_row_avx2(Uint32 *dst, int n, const BITMASK_W *bits,
+                         int stride, int x, Uint32 setcolor,
+                         Uint32 unsetcolor, int draw_set, int draw_unset);
+
+/* the bitmask_kernels_t kernels, see bitmask.h */
+unsigned int
+mask_count_words_avx2(const BITMASK_W *w, int n);
+void
+mask_invert_words_avx2(BITMASK_W *w, int n, BITMASK_W mask);
+void
+mask_draw_words_avx2(BITMASK_W *a, const BITMASK_W *b, int n, int shift);
+void
+mask_erase_words_avx2(BITMASK_W *a, const BITMASK_W *b, int n, int shift);
+void
+mask_overlap_words_avx2(BITMASK_W *c, const BITMASK_W *a, const BITMASK_W *b,
+                        int n, int shift, int accumulate);
@@ -0,0 +1,401 @@
+#include "simd_mask.h"
+
+#if defined(HAVE_IMMINTRIN_H) && !defined(SDL_DISABLE_IMMINTRIN_H)
+#include <immintrin.h>
+#endif /* defined(HAVE_IMMINTRIN_H) && !defined(SDL_DISABLE_IMMINTRIN_H) */
+
+#define BAD_AVX2_FUNCTION_CALL                                               \
+    printf(                                                                  \
+        "Fatal Error: Attempted calling an AVX2 function when both compile " \
+        "time and runtime support is missing. If you are seeing this "       \
+        "message, you have stumbled across a pygame bug, please report it "  \
+        "to the devs!");                                                     \
+    PG_EXIT(1)
+
+/* helper function that does a runtime check for AVX2. It has the added
+ * functionality of also returning 0 if compile time support is missing */
+int
+_pg_mask_has_avx2()
+{
+#if defined(__AVX2__) && defined(HAVE_IMMINTRIN_H) && \
+    !defined(SDL_DISABLE_IMMINTRIN_H)
+    return pg_simd_max_level() >= PG_SIMD_AVX2 && SDL_HasAVX2();
+#else
+    return 0;
+#endif /* defined(__AVX2__) && defined(HAVE_IMMINTRIN_H) && \
+          !defined(SDL_DISABLE_IMMINTRIN_H) */
+}
+
+#if defined(__AVX2__) && defined(HAVE_IMMINTRIN_H) && \
+    !defined(SDL_DISABLE_IMMINTRIN_H)
+/* Packs the 32 lane results (0 or -1) of 32 pixels into one bit per pixel.
+ * The packs work within the 128 bit halves, the permute puts the dwords of
+ * 4 pixels each back into pixel order. */
+static PG_INLINE Uint32
+_pack_lanes_avx2(__m256i m0, __m256i m1, __m256i m2, __m256i m3)
+{
+    __m256i m = _mm256_packs_epi16(_mm256_packs_epi32(m0, m1),
+                                   _mm256_packs_epi32(m2, m3));
+
+    m = _mm256_permutevar8x32_epi32(m,
+                                    _mm256_setr_epi32(0, 4, 1, 5, 2, 6, 3, 7));
+    return (Uint32)_mm256_movemask_epi8(m);
+}
+
+void
+mask_alpha_row_avx2(const Uint32 *src, int n, int ashift, int threshold,
+                    BITMASK_W *bits, int stride)
+{
+    const __m128i mm_shift = _mm_cvtsi32_si128(ashift);
+    const __m256i mm256_ff = _mm256_set1_epi32(0xFF);
+    const __m256i mm256_threshold = _mm256_set1_epi32(threshold);
+    const __m256i *p;
+    __m256i m[4];
+    BITMASK_W word = 0;
+    int x, i;
+
+    for (x = 0; x + 32 <= n; x += 32) {
+        p = (const __m256i *)(src + x);
+        for (i = 0; i < 4; i++) {
+            m[i] = _mm256_and_si256(
+                _mm256_srl_epi32(_mm256_loadu_si256(p + i), mm_shift),
+                mm256_ff);
+            m[i] = _mm256_cmpgt_epi32(m[i], mm256_threshold);
+        }
+        PG_MASK_ROW_ADD(_pack_lanes_avx2(m[0], m[1], m[2], m[3]), 32)
+    }
+    PG_MASK_ROW_FINISH((int)(src[x] >> ashift & 0xFF) > threshold)
+}
+
+void
+mask_colorkey_row_avx2(const Uint32 *src, int n, Uint32 colorkey,
+                       BITMASK_W *bits, int stride)
+{
+    const __m256i mm256_colorkey = _mm256_set1_epi32((int)colorkey);
+    const __m256i *p;
+    __m256i m[4];
+    BITMASK_W word = 0;
+    int x, i;
+
+    for (x = 0; x + 32 <= n; x += 32) {
+        p = (const __m256i *)(src + x);
+        for (i = 0; i < 4; i++) {
+            m[i] = _mm256_cmpeq_epi32(_mm256_loadu_si256(p + i),
+                                      mm256_colorkey);
+        }
+        PG_MASK_ROW_ADD(~_pack_lanes_avx2(m[0], m[1], m[2], m[3]), 32)
+    }
+    PG_MASK_ROW_FINISH(src[x] != colorkey)
+}
+
+void
+mask_threshold_row_avx2(const Uint32 *src, const Uint32 *src2, int n,
+                        Uint32 color, Uint32 tlimit, BITMASK_W *bits,
+                        int stride)
+{
+    const __m256i mm256_color = _mm256_set1_epi32((int)color);
+    const __m256i mm256_tlimit = _mm256_set1_epi32((int)tlimit);
+    const __m256i mm256_zero = _mm256_setzero_si256();
+    const __m256i mm256_ones = _mm256_set1_epi32(-1);
+    __m256i m[4], a, b;
+    BITMASK_W word = 0;
+    int x, i;
+
+    for (x = 0; x + 32 <= n; x += 32) {
+        for (i = 0; i < 4; i++) {
+            a = _mm256_loadu_si256((const __m256i *)(src + x) + i);
+            b = src2 ? _mm256_loadu_si256((const __m256i *)(src2 + x) + i)
+                     : mm256_color;
+            /* a byte is within its limit if the limit covers the absolute
+             * difference, the pixel if all 4 of its bytes are */
+            a = _mm256_or_si256(_mm256_subs_epu8(a, b),
+                                _mm256_subs_epu8(b, a));
+            a = _mm256_cmpeq_epi8(_mm256_subs_epu8(a, mm256_tlimit),
+                                  mm256_zero);
+            m[i] = _mm256_cmpeq_epi32(a, mm256_ones);
+        }
+        PG_MASK_ROW_ADD(_pack_lanes_avx2(m[0], m[1], m[2], m[3]), 32)
+    }
+    PG_MASK_ROW_FINISH(
+        PG_MASK_THRESHOLD_TEST(src[x], src2 ? src2[x] : color, tlimit))
+}
+
+/* The number of set bits of v, summed into its four 64 bit lanes. The bits
+ * of each nibble are counted with a lookup table, then the bytes are
+ * summed. */
+static PG_INLINE __m256i
+_popcount_avx2(__m256i v)
+{
+    const __m256i mm256_lut =
+        _mm256_setr_epi8(0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4, 0, 1,
+                         1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+    const __m256i mm256_0f = _mm256_set1_epi8(0x0F);
+    __m256i cnt;
+
+    cnt = _mm256_add_epi8(
+        _mm256_shuffle_epi8(mm256_lut, _mm256_and_si256(v, mm256_0f)),
+        _mm256_shuffle_epi8(
+            mm256_lut, _mm256_and_si256(_mm256_srli_epi16(v, 4), mm256_0f)));
+    return _mm256_sad_epu8(cnt, _mm256_setzero_si256());
+}
+
+static PG_INLINE unsigned int
+_sum_lanes_avx2(__m256i v)
+{
+    Uint64 sums[4];
+
+    _mm256_storeu_si256((__m256i *)sums, v);
+    return (unsigned int)(sums[0] + sums[1] + sums[2] + sums[3]);
+}
+
+/* BITMASK_W is only 32 bits wide on some platforms, e.g. on windows */
+#if ULONG_MAX > 0xFFFFFFFFUL
+#define _pg_set1_words_avx2(w) _mm256_set1_epi64x((long long)(w))
+#define _pg_sll_words_avx2 _mm256_sll_epi64
+#define _pg_srl_words_avx2 _mm256_srl_epi64
+#else
+#define _pg_set1_words_avx2(w) _mm256_set1_epi32((int)(w))
+#define _pg_sll_words_avx2 _mm256_sll_epi32
+#define _pg_srl_words_avx2 _mm256_srl_epi32
+#endif
+
+/* The words of v shifted as by _pg_mask_shift_word(). One of the counts
+ * is always 0, lc holds the left shift and rc the right one. */
+#define _PG_SHIFT_WORDS_AVX2(v, lc, rc) \
+    _pg_sll_words_avx2(_pg_srl_words_avx2(v, rc), lc)
+
+#define _PG_SHIFT_COUNTS_AVX2(shift)                                       \
+    const __m128i mm_lc = _mm_cvtsi32_si128((shift) > 0 ? (shift) : 0);   \
+    const __m128i mm_rc = _mm_cvtsi32_si128((shift) < 0 ? -(shift) : 0)
+
+unsigned int
+mask_and_count_avx2(const BITMASK_W *a, const BITMASK_W *b, int n)
+{
+    const int block = (int)(sizeof(__m256i) / sizeof(BITMASK_W));
+    __m256i mm256_sum = _mm256_setzero_si256();
+    unsigned int count;
+    int i;
+
+    for (i = 0; i + block <= n; i += block) {
+        mm256_sum = _mm256_add_epi64(
+            mm256_sum,
+            _popcount_avx2(_mm256_and_si256(
+                _mm256_loadu_si256((const __m256i *)(a + i)),
+                _mm256_loadu_si256((const __m256i *)(b + i)))));
+    }
+    count = _sum_lanes_avx2(mm256_sum);
+
+    for (; i < n; i++) {
+        count += _pg_mask_bitcount(a[i] & b[i]);
+    }
+    return count;
+}
+
+unsigned int
+mask_count_words_avx2(const BITMASK_W *w, int n)
+{
+    const int block = (int)(sizeof(__m256i) / sizeof(BITMASK_W));
+    __m256i mm256_sum = _mm256_setzero_si256();
+    unsigned int count;
+    int i;
+
+    for (i = 0; i + block <= n; i += block) {
+        mm256_sum = _mm256_add_epi64(
+            mm256_sum,
+            _popcount_avx2(_mm256_loadu_si256((const __m256i *)(w + i))));
+    }
+    count = _sum_lanes_avx2(mm256_sum);
+
+    for (; i < n; i++) {
+        count += _pg_mask_bitcount(w[i]);
+    }
+    return count;
+}
+
+void
+mask_invert_words_avx2(BITMASK_W *w, int n, BITMASK_W mask)
+{
+    const int block = (int)(sizeof(__m256i) / sizeof(BITMASK_W));
+    const __m256i mm256_mask = _pg_set1_words_avx2(mask);
+    __m256i *p;
+    int i;
+
+    for (i = 0; i + block <= n; i += block) {
+        p = (__m256i *)(w + i);
+        _mm256_storeu_si256(
+            p, _mm256_andnot_si256(_mm256_loadu_si256(p), mm256_mask));
+    }
+    for (; i < n; i++) {
+        w[i] = ~w[i] & mask;
+    }
+}
+
+void
+mask_draw_words_avx2(BITMASK_W *a, const BITMASK_W *b, int n, int shift)
+{
+    const int block = (int)(sizeof(__m256i) / sizeof(BITMASK_W));
+    _PG_SHIFT_COUNTS_AVX2(shift);
+    __m256i *p, v;
+    int i;
+
+    for (i = 0; i + block <= n; i += block) {
+        p = (__m256i *)(a + i);
+        v = _PG_SHIFT_WORDS_AVX2(
+            _mm256_loadu_si256((const __m256i *)(b + i)), mm_lc, mm_rc);
+        _mm256_storeu_si256(p, _mm256_or_si256(_mm256_loadu_si256(p), v));
+    }
+    for (; i < n; i++) {
+        a[i] |= _pg_mask_shift_word(b[i], shift);
+    }
+}
+
+void
+mask_erase_words_avx2(BITMASK_W *a, const BITMASK_W *b, int n, int shift)
+{
+    const int block = (int)(sizeof(__m256i) / sizeof(BITMASK_W));
+    _PG_SHIFT_COUNTS_AVX2(shift);
+    __m256i *p, v;
+    int i;
+
+    for (i = 0; i + block <= n; i += block) {
+        p = (__m256i *)(a + i);
+        v = _PG_SHIFT_WORDS_AVX2(
+            _mm256_loadu_si256((const __m256i *)(b + i)), mm_lc, mm_rc);
+        _mm256_storeu_si256(p,
+                            _mm256_andnot_si256(v, _mm256_loadu_si256(p)));
+    }
+    for (; i < n; i++) {
+        a[i] &= ~_pg_mask_shift_word(b[i], shift);
+    }
+}
+
+void
+mask_overlap_words_avx2(BITMASK_W *c, const BITMASK_W *a, const BITMASK_W *b,
+                        int n, int shift, int accumulate)
+{
+    const int block = (int)(sizeof(__m256i) / sizeof(BITMASK_W));
+    const BITMASK_W keep = accumulate ? ~(BITMASK_W)0 : 0;
+    const __m256i mm256_keep = _mm256_set1_epi32(accumulate ? -1 : 0);
+    _PG_SHIFT_COUNTS_AVX2(shift);
+    __m256i *p, v;
+    int i;
+
+    for (i = 0; i + block <= n; i += block) {
+        p = (__m256i *)(c + i);
+        v = _PG_SHIFT_WORDS_AVX2(
+            _mm256_loadu_si256((const __m256i *)(b + i)), mm_lc, mm_rc);
+        v = _mm256_and_si256(_mm256_loadu_si256((const __m256i *)(a + i)), v);
+        _mm256_storeu_si256(
+            p, _mm256_or_si256(
+                   _mm256_and_si256(_mm256_loadu_si256(p), mm256_keep), v));
+    }
+    for (; i < n; i++) {
+        c[i] = (c[i] & keep) | (a[i] & _pg_mask_shift_word(b[i], shift));
+    }
+}
+
+void
+mask_to_surface_row_avx2(Uint32 *dst, int n, const BITMASK_W *bits,
+                         int stride, int x, Uint32 setcolor,
+                         Uint32 unsetcolor, int draw_set, int draw_unset)
+{
+    const __m256i mm_bitsel = _mm256_setr_epi32(1, 2, 4, 8, 16, 32, 64, 128);
+    const __m256i mm_set = _mm256_set1_epi32((int)setcolor);
+    const __m256i mm_unset = _mm256_set1_epi32((int)unsetcolor);
+    __m256i mm_old, m, *p;
+    BITMASK_W w;
+    int i, j, len;
+
+    for (i = 0; i < n; i += len) {
+        len = MIN((int)BITMASK_W_LEN, n - i);
+        w = _pg_mask_row_word(bits, stride, x + i, n - i);
+        if (_pg_mask_fill_word(dst + i, w, len, setcolor, unsetcolor,
+                               draw_set, draw_unset)) {
+            continue;
+        }
+        for (j = 0; j + 8 <= len; j += 8) {
+            /* a lane of all ones for each set bit of the 8 */
+            m = _mm256_and_si256(_mm256_set1_epi32((int)(w >> j & 0xFF)),
+                                 mm_bitsel);
+            m = _mm256_cmpeq_epi32(m, mm_bitsel);
+            p = (__m256i *)(dst + i + j);
+            mm_old = _mm256_loadu_si256(p);
+            _mm256_storeu_si256(
+                p,
+                _mm256_blendv_epi8(draw_unset ? mm_unset : mm_old,
+                                   draw_set ? mm_set : mm_old, m));
+        }
+        _pg_mask_expand_word(dst + i, w, j, len, setcolor, unsetcolor,
+                             draw_set, draw_unset);
+    }
+}
+#else
+void
+mask_alpha_row_avx2(const Uint32 *src, int n, int ashift, int threshold,
+                    BITMASK_W *bits, int stride)
+{
+    BAD_AVX2_FUNCTION_CALL;
+}
+
+void
+mask_colorkey_row_avx2(const Uint32 *src, int n, Uint32 colorkey,
+                       BITMASK_W *bits, int stride)
+{
+    BAD_AVX2_FUNCTION_CALL;
+}
+
+void
+mask_threshold_row_avx2(const Uint32 *src, const Uint32 *src2, int n,
+                        Uint32 color, Uint32 tlimit, BITMASK_W *bits,
+                        int stride)
+{
+    BAD_AVX2_FUNCTION_CALL;
+}
+
+unsigned int
+mask_and_count_avx2(const BITMASK_W *a, const BITMASK_W *b, int n)
+{
+    BAD_AVX2_FUNCTION_CALL;
+    return 0;
+}
+unsigned int
+mask_count_words_avx2(const BITMASK_W *w, int n)
+{
+    BAD_AVX2_FUNCTION_CALL;
+    return 0;
+}
+
+void
+mask_invert_words_avx2(BITMASK_W *w, int n, BITMASK_W mask)
+{
+    BAD_AVX2_FUNCTION_CALL;
+}
+
+void
+mask_draw_words_avx2(BITMASK_W *a, const BITMASK_W *b, int n, int shift)
+{
+    BAD_AVX2_FUNCTION_CALL;
+}
+
+void
+mask_erase_words_avx2(BITMASK_W *a, const BITMASK_W *b, int n, int shift)
+{
+    BAD_AVX2_FUNCTION_CALL;
+}
+
+void
+mask_overlap_words_avx2(BITMASK_W *c, const BITMASK_W *a, const BITMASK_W *b,
+                        int n, int shift, int accumulate)
+{
+    BAD_AVX2_FUNCTION_CALL;
+}
+
+void
+mask_to_surface_row_avx2(Uint32 *dst, int n, const BITMASK_W *bits,
+                         int stride, int x, Uint32 setcolor,
+                         Uint32 unsetcolor, int draw_set, int draw_unset)
+{
+    BAD_AVX2_FUNCTION_CALL;
+}
+#endif /* defined(__AVX2__) && defined(HAVE_IMMINTRIN_H) && \
+          !defined(SDL_DISABLE_IMMINTRIN_H) */
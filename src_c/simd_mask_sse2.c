@@ -0,0 +1,377 @@
+#include "simd_mask.h"
+
+#if PG_ENABLE_ARM_NEON
+// sse2neon.h is from here: https://github.com/DLTcollab/sse2neon
+#include "include/sse2neon.h"
+#endif /* PG_ENABLE_ARM_NEON */
+
+#define BAD_SSE2_FUNCTION_CALL                                               \
+    printf(                                                                  \
+        "Fatal Error: Attempted calling an SSE2 function when both compile " \
+        "time and runtime support is missing. If you are seeing this "       \
+        "message, you have stumbled across a pygame bug, please report it "  \
+        "to the devs!");                                                     \
+    PG_EXIT(1)
+
+int
+_pg_mask_HasSSE_NEON()
+{
+#if defined(__SSE2__)
+    return pg_simd_max_level() >= PG_SIMD_SSE2_NEON && SDL_HasSSE2();
+#elif PG_ENABLE_ARM_NEON
+    return pg_simd_max_level() >= PG_SIMD_SSE2_NEON && SDL_HasNEON();
+#else
+    return 0;
+#endif
+}
+
+#if defined(__SSE2__) || defined(PG_ENABLE_ARM_NEON)
+/* Packs the 16 lane results (0 or -1) of 16 pixels into one bit per pixel */
+static PG_INLINE Uint32
+_pack_lanes_sse2(__m128i m0, __m128i m1, __m128i m2, __m128i m3)
+{
+    return (Uint32)_mm_movemask_epi8(_mm_packs_epi16(
+        _mm_packs_epi32(m0, m1), _mm_packs_epi32(m2, m3)));
+}
+
+void
+mask_alpha_row_sse2(const Uint32 *src, int n, int ashift, int threshold,
+                    BITMASK_W *bits, int stride)
+{
+    const __m128i mm_shift = _mm_cvtsi32_si128(ashift);
+    const __m128i mm_ff = _mm_set1_epi32(0xFF);
+    const __m128i mm_threshold = _mm_set1_epi32(threshold);
+    const __m128i *p;
+    __m128i m[4];
+    BITMASK_W word = 0;
+    int x, i;
+
+    for (x = 0; x + 16 <= n; x += 16) {
+        p = (const __m128i *)(src + x);
+        for (i = 0; i < 4; i++) {
+            m[i] = _mm_and_si128(
+                _mm_srl_epi32(_mm_loadu_si128(p + i), mm_shift), mm_ff);
+            m[i] = _mm_cmpgt_epi32(m[i], mm_threshold);
+        }
+        PG_MASK_ROW_ADD(_pack_lanes_sse2(m[0], m[1], m[2], m[3]), 16)
+    }
+    PG_MASK_ROW_FINISH((int)(src[x] >> ashift & 0xFF) > threshold)
+}
+
+void
+mask_colorkey_row_sse2(const Uint32 *src, int n, Uint32 colorkey,
+                       BITMASK_W *bits, int stride)
+{
+    const __m128i mm_colorkey = _mm_set1_epi32((int)colorkey);
+    const __m128i *p;
+    __m128i m[4];
+    BITMASK_W word = 0;
+    int x, i;
+
+    for (x = 0; x + 16 <= n; x += 16) {
+        p = (const __m128i *)(src + x);
+        for (i = 0; i < 4; i++) {
+            m[i] = _mm_cmpeq_epi32(_mm_loadu_si128(p + i), mm_colorkey);
+        }
+        PG_MASK_ROW_ADD(~_pack_lanes_sse2(m[0], m[1], m[2], m[3]) & 0xFFFF,
+                        16)
+    }
+    PG_MASK_ROW_FINISH(src[x] != colorkey)
+}
+
+void
+mask_threshold_row_sse2(const Uint32 *src, const Uint32 *src2, int n,
+                        Uint32 color, Uint32 tlimit, BITMASK_W *bits,
+                        int stride)
+{
+    const __m128i mm_color = _mm_set1_epi32((int)color);
+    const __m128i mm_tlimit = _mm_set1_epi32((int)tlimit);
+    const __m128i mm_zero = _mm_setzero_si128();
+    const __m128i mm_ones = _mm_set1_epi32(-1);
+    __m128i m[4], a, b;
+    BITMASK_W word = 0;
+    int x, i;
+
+    for (x = 0; x + 16 <= n; x += 16) {
+        for (i = 0; i < 4; i++) {
+            a = _mm_loadu_si128((const __m128i *)(src + x) + i);
+            b = src2 ? _mm_loadu_si128((const __m128i *)(src2 + x) + i)
+                     : mm_color;
+            /* a byte is within its limit if the limit covers the absolute
+             * difference, the pixel if all 4 of its bytes are */
+            a = _mm_or_si128(_mm_subs_epu8(a, b), _mm_subs_epu8(b, a));
+            a = _mm_cmpeq_epi8(_mm_subs_epu8(a, mm_tlimit), mm_zero);
+            m[i] = _mm_cmpeq_epi32(a, mm_ones);
+        }
+        PG_MASK_ROW_ADD(_pack_lanes_sse2(m[0], m[1], m[2], m[3]), 16)
+    }
+    PG_MASK_ROW_FINISH(
+        PG_MASK_THRESHOLD_TEST(src[x], src2 ? src2[x] : color, tlimit))
+}
+
+/* The number of set bits of v, summed into its two 64 bit lanes. The bits
+ * are counted within each byte, then the bytes are summed. */
+static PG_INLINE __m128i
+_popcount_sse2(__m128i v)
+{
+    const __m128i mm_55 = _mm_set1_epi8(0x55);
+    const __m128i mm_33 = _mm_set1_epi8(0x33);
+    const __m128i mm_0f = _mm_set1_epi8(0x0F);
+
+    v = _mm_sub_epi8(v, _mm_and_si128(_mm_srli_epi64(v, 1), mm_55));
+    v = _mm_add_epi8(_mm_and_si128(v, mm_33),
+                     _mm_and_si128(_mm_srli_epi64(v, 2), mm_33));
+    v = _mm_and_si128(_mm_add_epi8(v, _mm_srli_epi64(v, 4)), mm_0f);
+    return _mm_sad_epu8(v, _mm_setzero_si128());
+}
+
+/* BITMASK_W is only 32 bits wide on some platforms, e.g. on windows */
+#if ULONG_MAX > 0xFFFFFFFFUL
+#define _pg_set1_words_sse2(w) _mm_set1_epi64x((long long)(w))
+#define _pg_sll_words_sse2 _mm_sll_epi64
+#define _pg_srl_words_sse2 _mm_srl_epi64
+#else
+#define _pg_set1_words_sse2(w) _mm_set1_epi32((int)(w))
+#define _pg_sll_words_sse2 _mm_sll_epi32
+#define _pg_srl_words_sse2 _mm_srl_epi32
+#endif
+
+/* The words of v shifted as by _pg_mask_shift_word(). One of the counts
+ * is always 0, lc holds the left shift and rc the right one. */
+#define _PG_SHIFT_WORDS_SSE2(v, lc, rc) \
+    _pg_sll_words_sse2(_pg_srl_words_sse2(v, rc), lc)
+
+#define _PG_SHIFT_COUNTS_SSE2(shift)                                       \
+    const __m128i mm_lc = _mm_cvtsi32_si128((shift) > 0 ? (shift) : 0);   \
+    const __m128i mm_rc = _mm_cvtsi32_si128((shift) < 0 ? -(shift) : 0)
+
+unsigned int
+mask_and_count_sse2(const BITMASK_W *a, const BITMASK_W *b, int n)
+{
+    const int block = (int)(sizeof(__m128i) / sizeof(BITMASK_W));
+    __m128i mm_sum = _mm_setzero_si128();
+    Uint64 sums[2];
+    unsigned int count;
+    int i;
+
+    for (i = 0; i + block <= n; i += block) {
+        mm_sum = _mm_add_epi64(
+            mm_sum,
+            _popcount_sse2(
+                _mm_and_si128(_mm_loadu_si128((const __m128i *)(a + i)),
+                              _mm_loadu_si128((const __m128i *)(b + i)))));
+    }
+    _mm_storeu_si128((__m128i *)sums, mm_sum);
+    count = (unsigned int)(sums[0] + sums[1]);
+
+    for (; i < n; i++) {
+        count += _pg_mask_bitcount(a[i] & b[i]);
+    }
+    return count;
+}
+
+unsigned int
+mask_count_words_sse2(const BITMASK_W *w, int n)
+{
+    const int block = (int)(sizeof(__m128i) / sizeof(BITMASK_W));
+    __m128i mm_sum = _mm_setzero_si128();
+    Uint64 sums[2];
+    unsigned int count;
+    int i;
+
+    for (i = 0; i + block <= n; i += block) {
+        mm_sum = _mm_add_epi64(
+            mm_sum, _popcount_sse2(_mm_loadu_si128((const __m128i *)(w + i))));
+    }
+    _mm_storeu_si128((__m128i *)sums, mm_sum);
+    count = (unsigned int)(sums[0] + sums[1]);
+
+    for (; i < n; i++) {
+        count += _pg_mask_bitcount(w[i]);
+    }
+    return count;
+}
+
+void
+mask_invert_words_sse2(BITMASK_W *w, int n, BITMASK_W mask)
+{
+    const int block = (int)(sizeof(__m128i) / sizeof(BITMASK_W));
+    const __m128i mm_mask = _pg_set1_words_sse2(mask);
+    __m128i *p;
+    int i;
+
+    for (i = 0; i + block <= n; i += block) {
+        p = (__m128i *)(w + i);
+        _mm_storeu_si128(p, _mm_andnot_si128(_mm_loadu_si128(p), mm_mask));
+    }
+    for (; i < n; i++) {
+        w[i] = ~w[i] & mask;
+    }
+}
+
+void
+mask_draw_words_sse2(BITMASK_W *a, const BITMASK_W *b, int n, int shift)
+{
+    const int block = (int)(sizeof(__m128i) / sizeof(BITMASK_W));
+    _PG_SHIFT_COUNTS_SSE2(shift);
+    __m128i *p, v;
+    int i;
+
+    for (i = 0; i + block <= n; i += block) {
+        p = (__m128i *)(a + i);
+        v = _PG_SHIFT_WORDS_SSE2(_mm_loadu_si128((const __m128i *)(b + i)),
+                                 mm_lc, mm_rc);
+        _mm_storeu_si128(p, _mm_or_si128(_mm_loadu_si128(p), v));
+    }
+    for (; i < n; i++) {
+        a[i] |= _pg_mask_shift_word(b[i], shift);
+    }
+}
+
+void
+mask_erase_words_sse2(BITMASK_W *a, const BITMASK_W *b, int n, int shift)
+{
+    const int block = (int)(sizeof(__m128i) / sizeof(BITMASK_W));
+    _PG_SHIFT_COUNTS_SSE2(shift);
+    __m128i *p, v;
+    int i;
+
+    for (i = 0; i + block <= n; i += block) {
+        p = (__m128i *)(a + i);
+        v = _PG_SHIFT_WORDS_SSE2(_mm_loadu_si128((const __m128i *)(b + i)),
+                                 mm_lc, mm_rc);
+        _mm_storeu_si128(p, _mm_andnot_si128(v, _mm_loadu_si128(p)));
+    }
+    for (; i < n; i++) {
+        a[i] &= ~_pg_mask_shift_word(b[i], shift);
+    }
+}
+
+void
+mask_overlap_words_sse2(BITMASK_W *c, const BITMASK_W *a, const BITMASK_W *b,
+                        int n, int shift, int accumulate)
+{
+    const int block = (int)(sizeof(__m128i) / sizeof(BITMASK_W));
+    const BITMASK_W keep = accumulate ? ~(BITMASK_W)0 : 0;
+    const __m128i mm_keep = _mm_set1_epi32(accumulate ? -1 : 0);
+    _PG_SHIFT_COUNTS_SSE2(shift);
+    __m128i *p, v;
+    int i;
+
+    for (i = 0; i + block <= n; i += block) {
+        p = (__m128i *)(c + i);
+        v = _PG_SHIFT_WORDS_SSE2(_mm_loadu_si128((const __m128i *)(b + i)),
+                                 mm_lc, mm_rc);
+        v = _mm_and_si128(_mm_loadu_si128((const __m128i *)(a + i)), v);
+        _mm_storeu_si128(
+            p, _mm_or_si128(_mm_and_si128(_mm_loadu_si128(p), mm_keep), v));
+    }
+    for (; i < n; i++) {
+        c[i] = (c[i] & keep) | (a[i] & _pg_mask_shift_word(b[i], shift));
+    }
+}
+
+void
+mask_to_surface_row_sse2(Uint32 *dst, int n, const BITMASK_W *bits,
+                         int stride, int x, Uint32 setcolor,
+                         Uint32 unsetcolor, int draw_set, int draw_unset)
+{
+    const __m128i mm_bitsel = _mm_setr_epi32(1, 2, 4, 8);
+    const __m128i mm_set = _mm_set1_epi32((int)setcolor);
+    const __m128i mm_unset = _mm_set1_epi32((int)unsetcolor);
+    __m128i mm_old, m, *p;
+    BITMASK_W w;
+    int i, j, len;
+
+    for (i = 0; i < n; i += len) {
+        len = MIN((int)BITMASK_W_LEN, n - i);
+        w = _pg_mask_row_word(bits, stride, x + i, n - i);
+        if (_pg_mask_fill_word(dst + i, w, len, setcolor, unsetcolor,
+                               draw_set, draw_unset)) {
+            continue;
+        }
+        for (j = 0; j + 4 <= len; j += 4) {
+            /* a lane of all ones for each set bit of the 4 */
+            m = _mm_and_si128(_mm_set1_epi32((int)(w >> j & 0xF)),
+                              mm_bitsel);
+            m = _mm_cmpeq_epi32(m, mm_bitsel);
+            p = (__m128i *)(dst + i + j);
+            mm_old = _mm_loadu_si128(p);
+            _mm_storeu_si128(
+                p, _mm_or_si128(
+                       _mm_and_si128(m, draw_set ? mm_set : mm_old),
+                       _mm_andnot_si128(m, draw_unset ? mm_unset : mm_old)));
+        }
+        _pg_mask_expand_word(dst + i, w, j, len, setcolor, unsetcolor,
+                             draw_set, draw_unset);
+    }
+}
+#else
+void
+mask_alpha_row_sse2(const Uint32 *src, int n, int ashift, int threshold,
+                    BITMASK_W *bits, int stride)
+{
+    BAD_SSE2_FUNCTION_CALL;
+}
+
+void
+mask_colorkey_row_sse2(const Uint32 *src, int n, Uint32 colorkey,
+                       BITMASK_W *bits, int stride)
+{
+    BAD_SSE2_FUNCTION_CALL;
+}
+
+void
+mask_threshold_row_sse2(const Uint32 *src, const Uint32 *src2, int n,
+                        Uint32 color, Uint32 tlimit, BITMASK_W *bits,
+                        int stride)
+{
+    BAD_SSE2_FUNCTION_CALL;
+}
+
+unsigned int
+mask_and_count_sse2(const BITMASK_W *a, const BITMASK_W *b, int n)
+{
+    BAD_SSE2_FUNCTION_CALL;
+    return 0;
+}
+unsigned int
+mask_count_words_sse2(const BITMASK_W *w, int n)
+{
+    BAD_SSE2_FUNCTION_CALL;
+    return 0;
+}
+
+void
+mask_invert_words_sse2(BITMASK_W *w, int n, BITMASK_W mask)
+{
+    BAD_SSE2_FUNCTION_CALL;
+}
+
+void
+mask_draw_words_sse2(BITMASK_W *a, const BITMASK_W *b, int n, int shift)
+{
+    BAD_SSE2_FUNCTION_CALL;
+}
+
+void
+mask_erase_words_sse2(BITMASK_W *a, const BITMASK_W *b, int n, int shift)
+{
+    BAD_SSE2_FUNCTION_CALL;
+}
+
+void
+mask_overlap_words_sse2(BITMASK_W *c, const BITMASK_W *a, const BITMASK_W *b,
+                        int n, int shift, int accumulate)
+{
+    BAD_SSE2_FUNCTION_CALL;
+}
+
+void
+mask_to_surface_row_sse2(Uint32 *dst, int n, const BITMASK_W *bits,
+                         int stride, int x, Uint32 setcolor,
+                         Uint32 unsetcolor, int draw_set, int draw_unset)
+{
+    BAD_SSE2_FUNCTION_CALL;
+}
+#endif /* defined(__SSE2__) || defined(PG_ENABLE_ARM_NEON) */
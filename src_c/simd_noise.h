@@ -0,0 +1,239 @@
+#define NO_PYGAME_C_API
+#ifndef SIMD_NOISE_H
+#define SIMD_NOISE_H
+
+#include "pygame.h"
+
+#if !defined(PG_ENABLE_ARM_NEON) && defined(__aarch64__)
+// arm64 has neon optimisations enabled by default, even when fpu=neon is not
+// passed
+#define PG_ENABLE_ARM_NEON 1
+#endif
+
+#if defined(__SSE2__)
+#define PG_ENABLE_SSE_NEON 1
+#elif PG_ENABLE_ARM_NEON
+#define PG_ENABLE_SSE_NEON 1
+#else
+#define PG_ENABLE_SSE_NEON 0
+#endif
+
+int
+_pg_noise_has_avx2();
+
+/* This returns True if either SSE2 or NEON is present at runtime.
+ * Relevant because they use the same codepaths. Only the relevant runtime
+ * SDL cpu feature check is compiled in.*/
+int
+_pg_noise_HasSSE_NEON();
+
+#define PG_NOISE_VALUE 0
+#define PG_NOISE_PERLIN 1
+#define PG_NOISE_SIMPLEX 2
+
+#define PG_NOISE_MAX_OCTAVES 16
+
+/* The 2D noise functions of pygame.math.noise(). Every octave samples the
+ * basis noise at freqs[i] times the point, hashing the lattice with
+ * seeds[i], and adds it times amps[i]. The sum is multiplied by scale, the
+ * inverse of the sum of the amplitudes, and clamped to [-1, 1]. */
+typedef struct {
+    int kind;
+    int octaves;
+    Uint32 seeds[PG_NOISE_MAX_OCTAVES];
+    float freqs[PG_NOISE_MAX_OCTAVES];
+    float amps[PG_NOISE_MAX_OCTAVES];
+    float scale;
+} pgNoiseParams;
+
+/* Row kernels. They write the noise at ((x + i + ox) * freq, y) to out[i],
+ * for i from 0 to n - 1. */
+typedef void (*NOISE_ROW_P)(const pgNoiseParams *params, int x, float ox,
+                            float freq, float y, int n, float *out);
+
+/* The multipliers of the lattice hash. The seed is multiplied by the third
+ * one when the parameters are made. */
+#define PG_NOISE_HASH_X 0x8da6b343u
+#define PG_NOISE_HASH_Y 0xd8163841u
+#define PG_NOISE_HASH_SEED 0xcb1ab31fu
+#define PG_NOISE_HASH_MIX 0x5bd1e995u
+
+/* The skew factors of simplex noise, (sqrt(3) - 1) / 2 and
+ * (3 - sqrt(3)) / 6 */
+#define PG_NOISE_F2 0.36602540378f
+#define PG_NOISE_G2 0.21132486540f
+
+/* Scales that bring the basis functions to about [-1, 1] */
+#define PG_NOISE_PERLIN_SCALE 0.63245553f
+#define PG_NOISE_SIMPLEX_SCALE 40.0f
+
+/* The scalar versions of the basis functions. The SIMD kernels do the same
+ * operations in the same order on their lanes, so all backends give the
+ * same values. */
+static PG_INLINE Uint32
+_pg_noise_hash(Sint32 x, Sint32 y, Uint32 seed)
+{
+    Uint32 h = ((Uint32)x * PG_NOISE_HASH_X) ^ ((Uint32)y * PG_NOISE_HASH_Y) ^
+               seed;
+    h ^= h >> 13;
+    h *= PG_NOISE_HASH_MIX;
+    h ^= h >> 15;
+    return h;
+}
+
+/* floor(), with the truncating conversion the SIMD lanes use. v is clamped
+ * to the range of the conversion first, NaN to its bottom. */
+#define PG_NOISE_LIMIT 1073741824.0f
+
+static PG_INLINE Sint32
+_pg_noise_floor(float v)
+{
+    Sint32 i;
+    v = v > -PG_NOISE_LIMIT ? v : -PG_NOISE_LIMIT;
+    v = v < PG_NOISE_LIMIT ? v : PG_NOISE_LIMIT;
+    i = (Sint32)v;
+    return (float)i > v ? i - 1 : i;
+}
+
+static PG_INLINE float
+_pg_noise_fade(float t)
+{
+    return t * t * t * (t * (t * 6.0f - 15.0f) + 10.0f);
+}
+
+static PG_INLINE float
+_pg_noise_lerp(float a, float b, float t)
+{
+    return a + (b - a) * t;
+}
+
+/* One of 8 gradients (+-1, +-2) and (+-2, +-1) dotted with (x, y) */
+static PG_INLINE float
+_pg_noise_grad(Uint32 h, float x, float y)
+{
+    float u = (h & 4) ? y : x;
+    float v = (h & 4) ? x : y;
+    u = (h & 1) ? -u : u;
+    v = v + v;
+    v = (h & 2) ? -v : v;
+    return u + v;
+}
+
+/* A random value in [-1, 1] from the top 24 bits of a hash */
+static PG_INLINE float
+_pg_noise_corner(Uint32 h)
+{
+    return (float)(Sint32)(h >> 8) * (2.0f / 16777215.0f) - 1.0f;
+}
+
+static PG_INLINE float
+_pg_noise_value(float x, float y, Uint32 seed)
+{
+    const Sint32 ix = _pg_noise_floor(x), iy = _pg_noise_floor(y);
+    const float u = _pg_noise_fade(x - (float)ix);
+    const float v = _pg_noise_fade(y - (float)iy);
+    const float n00 = _pg_noise_corner(_pg_noise_hash(ix, iy, seed));
+    const float n10 = _pg_noise_corner(_pg_noise_hash(ix + 1, iy, seed));
+    const float n01 = _pg_noise_corner(_pg_noise_hash(ix, iy + 1, seed));
+    const float n11 = _pg_noise_corner(_pg_noise_hash(ix + 1, iy + 1, seed));
+    return _pg_noise_lerp(_pg_noise_lerp(n00, n10, u),
+                          _pg_noise_lerp(n01, n11, u), v);
+}
+
+static PG_INLINE float
+_pg_noise_perlin(float x, float y, Uint32 seed)
+{
+    const Sint32 ix = _pg_noise_floor(x), iy = _pg_noise_floor(y);
+    const float fx = x - (float)ix, fy = y - (float)iy;
+    const float u = _pg_noise_fade(fx), v = _pg_noise_fade(fy);
+    const float n00 = _pg_noise_grad(_pg_noise_hash(ix, iy, seed), fx, fy);
+    const float n10 =
+        _pg_noise_grad(_pg_noise_hash(ix + 1, iy, seed), fx - 1.0f, fy);
+    const float n01 =
+        _pg_noise_grad(_pg_noise_hash(ix, iy + 1, seed), fx, fy - 1.0f);
+    const float n11 = _pg_noise_grad(_pg_noise_hash(ix + 1, iy + 1, seed),
+                                     fx - 1.0f, fy - 1.0f);
+    return _pg_noise_lerp(_pg_noise_lerp(n00, n10, u),
+                          _pg_noise_lerp(n01, n11, u), v) *
+           PG_NOISE_PERLIN_SCALE;
+}
+
+/* The contribution of a simplex corner at (x, y) from the point */
+static PG_INLINE float
+_pg_noise_simplex_corner(Uint32 h, float x, float y)
+{
+    const float t = 0.5f - x * x - y * y;
+    const float t2 = t * t;
+    return t < 0.0f ? 0.0f : t2 * t2 * _pg_noise_grad(h, x, y);
+}
+
+static PG_INLINE float
+_pg_noise_simplex(float x, float y, Uint32 seed)
+{
+    const float s = (x + y) * PG_NOISE_F2;
+    const Sint32 i = _pg_noise_floor(x + s), j = _pg_noise_floor(y + s);
+    const float t = ((float)i + (float)j) * PG_NOISE_G2;
+    const float x0 = x - ((float)i - t), y0 = y - ((float)j - t);
+    /* the middle corner is along x in the lower triangle, else along y */
+    const Sint32 i1 = x0 > y0 ? 1 : 0, j1 = x0 > y0 ? 0 : 1;
+    const float x1 = x0 - (float)i1 + PG_NOISE_G2;
+    const float y1 = y0 - (float)j1 + PG_NOISE_G2;
+    const float x2 = x0 - 1.0f + 2.0f * PG_NOISE_G2;
+    const float y2 = y0 - 1.0f + 2.0f * PG_NOISE_G2;
+    const float n0 = _pg_noise_simplex_corner(_pg_noise_hash(i, j, seed), x0,
+                                              y0);
+    const float n1 = _pg_noise_simplex_corner(
+        _pg_noise_hash(i + i1, j + j1, seed), x1, y1);
+    const float n2 = _pg_noise_simplex_corner(
+        _pg_noise_hash(i + 1, j + 1, seed), x2, y2);
+    return (n0 + n1 + n2) * PG_NOISE_SIMPLEX_SCALE;
+}
+
+static PG_INLINE float
+_pg_noise_clamp(float v)
+{
+    v = v > -1.0f ? v : -1.0f;
+    return v < 1.0f ? v : 1.0f;
+}
+
+/* The fractal sum of the octaves at (x, y) */
+static PG_INLINE float
+_pg_noise_sample(const pgNoiseParams *params, float x, float y)
+{
+    float sum = 0.0f, n;
+    int o;
+
+    for (o = 0; o < params->octaves; o++) {
+        const float fx = x * params->freqs[o], fy = y * params->freqs[o];
+        switch (params->kind) {
+            case PG_NOISE_VALUE:
+                n = _pg_noise_value(fx, fy, params->seeds[o]);
+                break;
+            case PG_NOISE_PERLIN:
+                n = _pg_noise_perlin(fx, fy, params->seeds[o]);
+                break;
+            default:
+                n = _pg_noise_simplex(fx, fy, params->seeds[o]);
+                break;
+        }
+        sum = sum + n * params->amps[o];
+    }
+    return _pg_noise_clamp(sum * params->scale);
+}
+
+/* the generic version, used if there is no SIMD support */
+void
+noise_row(const pgNoiseParams *params, int x, float ox, float freq, float y,
+          int n, float *out);
+
+// SSE2 functions
+void
+noise_row_sse2(const pgNoiseParams *params, int x, float ox, float freq,
+               float y, int n, float *out);
+
+// AVX2 functions
+void
+noise_row_avx2(const pgNoiseParams *params, int x, float ox, float freq,
+               float y, int n, float *out);
+
+#endif /* SIMD_NOISE_H */
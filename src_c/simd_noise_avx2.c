@@ -0,0 +1,243 @@
+#include "simd_noise.h"
+
+#if defined(HAVE_IMMINTRIN_H) && !defined(SDL_DISABLE_IMMINTRIN_H)
+#include <immintrin.h>
+#endif /* defined(HAVE_IMMINTRIN_H) && !defined(SDL_DISABLE_IMMINTRIN_H) */
+
+#define BAD_AVX2_FUNCTION_CALL                                               \
+    printf(                                                                  \
+        "Fatal Error: Attempted calling an AVX2 function when both compile " \
+        "time and runtime support is missing. If you are seeing this "       \
+        "message, you have stumbled across a pygame bug, please report it "  \
+        "to the devs!");                                                     \
+    PG_EXIT(1)
+
+/* helper function that does a runtime check for AVX2. It has the added
+ * functionality of also returning 0 if compile time support is missing */
+int
+_pg_noise_has_avx2()
+{
+#if defined(__AVX2__) && defined(HAVE_IMMINTRIN_H) && \
+    !defined(SDL_DISABLE_IMMINTRIN_H)
+    return pg_simd_max_level() >= PG_SIMD_AVX2 && SDL_HasAVX2();
+#else
+    return 0;
+#endif /* defined(__AVX2__) && defined(HAVE_IMMINTRIN_H) && \
+          !defined(SDL_DISABLE_IMMINTRIN_H) */
+}
+
+#if defined(__AVX2__) && defined(HAVE_IMMINTRIN_H) && \
+    !defined(SDL_DISABLE_IMMINTRIN_H)
+/* m ? a : b for each lane, m being the result of a comparison */
+#define _PG_SELECT_AVX2(m, a, b) _mm256_blendv_ps(b, a, m)
+
+/* The lanes of _pg_noise_hash() and friends */
+static PG_INLINE __m256i
+_pg_noise_hash_avx2(__m256i x, __m256i y, __m256i seed)
+{
+    __m256i h = _mm256_xor_si256(
+        _mm256_xor_si256(
+            _mm256_mullo_epi32(x, _mm256_set1_epi32((int)PG_NOISE_HASH_X)),
+            _mm256_mullo_epi32(y, _mm256_set1_epi32((int)PG_NOISE_HASH_Y))),
+        seed);
+    h = _mm256_xor_si256(h, _mm256_srli_epi32(h, 13));
+    h = _mm256_mullo_epi32(h, _mm256_set1_epi32((int)PG_NOISE_HASH_MIX));
+    return _mm256_xor_si256(h, _mm256_srli_epi32(h, 15));
+}
+
+static PG_INLINE __m256i
+_pg_noise_floor_avx2(__m256 v)
+{
+    __m256i i;
+    v = _mm256_max_ps(v, _mm256_set1_ps(-PG_NOISE_LIMIT));
+    v = _mm256_min_ps(v, _mm256_set1_ps(PG_NOISE_LIMIT));
+    i = _mm256_cvttps_epi32(v);
+    /* the comparison is all ones, -1, where i is one too big */
+    return _mm256_add_epi32(i, _mm256_castps_si256(_mm256_cmp_ps(
+                                   _mm256_cvtepi32_ps(i), v, _CMP_GT_OQ)));
+}
+
+static PG_INLINE __m256
+_pg_noise_fade_avx2(__m256 t)
+{
+    __m256 p = _mm256_sub_ps(_mm256_mul_ps(t, _mm256_set1_ps(6.0f)),
+                             _mm256_set1_ps(15.0f));
+    p = _mm256_add_ps(_mm256_mul_ps(t, p), _mm256_set1_ps(10.0f));
+    return _mm256_mul_ps(_mm256_mul_ps(_mm256_mul_ps(t, t), t), p);
+}
+
+static PG_INLINE __m256
+_pg_noise_lerp_avx2(__m256 a, __m256 b, __m256 t)
+{
+    return _mm256_add_ps(a, _mm256_mul_ps(_mm256_sub_ps(b, a), t));
+}
+
+static PG_INLINE __m256
+_pg_noise_grad_avx2(__m256i h, __m256 x, __m256 y)
+{
+    const __m256i one = _mm256_set1_epi32(1), two = _mm256_set1_epi32(2);
+    __m256 swap = _mm256_castsi256_ps(_mm256_cmpeq_epi32(
+        _mm256_and_si256(h, _mm256_set1_epi32(4)), _mm256_set1_epi32(4)));
+    __m256 u = _PG_SELECT_AVX2(swap, y, x);
+    __m256 v = _PG_SELECT_AVX2(swap, x, y);
+    /* negating is flipping the sign bit */
+    u = _mm256_xor_ps(u, _mm256_castsi256_ps(_mm256_slli_epi32(
+                             _mm256_and_si256(h, one), 31)));
+    v = _mm256_add_ps(v, v);
+    v = _mm256_xor_ps(v, _mm256_castsi256_ps(_mm256_slli_epi32(
+                             _mm256_and_si256(h, two), 30)));
+    return _mm256_add_ps(u, v);
+}
+
+static PG_INLINE __m256
+_pg_noise_corner_avx2(__m256i h)
+{
+    return _mm256_sub_ps(
+        _mm256_mul_ps(_mm256_cvtepi32_ps(_mm256_srli_epi32(h, 8)),
+                      _mm256_set1_ps(2.0f / 16777215.0f)),
+        _mm256_set1_ps(1.0f));
+}
+
+static PG_INLINE __m256
+_pg_noise_value_avx2(__m256 x, __m256 y, __m256i seed)
+{
+    const __m256i one = _mm256_set1_epi32(1);
+    __m256i ix = _pg_noise_floor_avx2(x), iy = _pg_noise_floor_avx2(y);
+    __m256i ix1 = _mm256_add_epi32(ix, one), iy1 = _mm256_add_epi32(iy, one);
+    __m256 u =
+        _pg_noise_fade_avx2(_mm256_sub_ps(x, _mm256_cvtepi32_ps(ix)));
+    __m256 v =
+        _pg_noise_fade_avx2(_mm256_sub_ps(y, _mm256_cvtepi32_ps(iy)));
+    __m256 n00 = _pg_noise_corner_avx2(_pg_noise_hash_avx2(ix, iy, seed));
+    __m256 n10 = _pg_noise_corner_avx2(_pg_noise_hash_avx2(ix1, iy, seed));
+    __m256 n01 = _pg_noise_corner_avx2(_pg_noise_hash_avx2(ix, iy1, seed));
+    __m256 n11 = _pg_noise_corner_avx2(_pg_noise_hash_avx2(ix1, iy1, seed));
+    return _pg_noise_lerp_avx2(_pg_noise_lerp_avx2(n00, n10, u),
+                               _pg_noise_lerp_avx2(n01, n11, u), v);
+}
+
+static PG_INLINE __m256
+_pg_noise_perlin_avx2(__m256 x, __m256 y, __m256i seed)
+{
+    const __m256i one = _mm256_set1_epi32(1);
+    const __m256 onef = _mm256_set1_ps(1.0f);
+    __m256i ix = _pg_noise_floor_avx2(x), iy = _pg_noise_floor_avx2(y);
+    __m256i ix1 = _mm256_add_epi32(ix, one), iy1 = _mm256_add_epi32(iy, one);
+    __m256 fx = _mm256_sub_ps(x, _mm256_cvtepi32_ps(ix));
+    __m256 fy = _mm256_sub_ps(y, _mm256_cvtepi32_ps(iy));
+    __m256 fx1 = _mm256_sub_ps(fx, onef), fy1 = _mm256_sub_ps(fy, onef);
+    __m256 u = _pg_noise_fade_avx2(fx), v = _pg_noise_fade_avx2(fy);
+    __m256 n00 =
+        _pg_noise_grad_avx2(_pg_noise_hash_avx2(ix, iy, seed), fx, fy);
+    __m256 n10 =
+        _pg_noise_grad_avx2(_pg_noise_hash_avx2(ix1, iy, seed), fx1, fy);
+    __m256 n01 =
+        _pg_noise_grad_avx2(_pg_noise_hash_avx2(ix, iy1, seed), fx, fy1);
+    __m256 n11 =
+        _pg_noise_grad_avx2(_pg_noise_hash_avx2(ix1, iy1, seed), fx1, fy1);
+    return _mm256_mul_ps(
+        _pg_noise_lerp_avx2(_pg_noise_lerp_avx2(n00, n10, u),
+                            _pg_noise_lerp_avx2(n01, n11, u), v),
+        _mm256_set1_ps(PG_NOISE_PERLIN_SCALE));
+}
+
+static PG_INLINE __m256
+_pg_noise_simplex_corner_avx2(__m256i h, __m256 x, __m256 y)
+{
+    __m256 t = _mm256_sub_ps(
+        _mm256_sub_ps(_mm256_set1_ps(0.5f), _mm256_mul_ps(x, x)),
+        _mm256_mul_ps(y, y));
+    __m256 t2 = _mm256_mul_ps(t, t);
+    __m256 n =
+        _mm256_mul_ps(_mm256_mul_ps(t2, t2), _pg_noise_grad_avx2(h, x, y));
+    return _mm256_andnot_ps(
+        _mm256_cmp_ps(t, _mm256_setzero_ps(), _CMP_LT_OQ), n);
+}
+
+static PG_INLINE __m256
+_pg_noise_simplex_avx2(__m256 x, __m256 y, __m256i seed)
+{
+    const __m256i one = _mm256_set1_epi32(1);
+    const __m256 g2 = _mm256_set1_ps(PG_NOISE_G2);
+    __m256 s =
+        _mm256_mul_ps(_mm256_add_ps(x, y), _mm256_set1_ps(PG_NOISE_F2));
+    __m256i i = _pg_noise_floor_avx2(_mm256_add_ps(x, s));
+    __m256i j = _pg_noise_floor_avx2(_mm256_add_ps(y, s));
+    __m256 fi = _mm256_cvtepi32_ps(i), fj = _mm256_cvtepi32_ps(j);
+    __m256 t = _mm256_mul_ps(_mm256_add_ps(fi, fj), g2);
+    __m256 x0 = _mm256_sub_ps(x, _mm256_sub_ps(fi, t));
+    __m256 y0 = _mm256_sub_ps(y, _mm256_sub_ps(fj, t));
+    __m256i lower = _mm256_castps_si256(_mm256_cmp_ps(x0, y0, _CMP_GT_OQ));
+    __m256i i1 = _mm256_srli_epi32(lower, 31);
+    __m256i j1 = _mm256_xor_si256(i1, one);
+    __m256 x1 = _mm256_add_ps(_mm256_sub_ps(x0, _mm256_cvtepi32_ps(i1)), g2);
+    __m256 y1 = _mm256_add_ps(_mm256_sub_ps(y0, _mm256_cvtepi32_ps(j1)), g2);
+    __m256 x2 = _mm256_add_ps(_mm256_sub_ps(x0, _mm256_set1_ps(1.0f)),
+                              _mm256_set1_ps(2.0f * PG_NOISE_G2));
+    __m256 y2 = _mm256_add_ps(_mm256_sub_ps(y0, _mm256_set1_ps(1.0f)),
+                              _mm256_set1_ps(2.0f * PG_NOISE_G2));
+    __m256 n0 = _pg_noise_simplex_corner_avx2(
+        _pg_noise_hash_avx2(i, j, seed), x0, y0);
+    __m256 n1 = _pg_noise_simplex_corner_avx2(
+        _pg_noise_hash_avx2(_mm256_add_epi32(i, i1),
+                            _mm256_add_epi32(j, j1), seed),
+        x1, y1);
+    __m256 n2 = _pg_noise_simplex_corner_avx2(
+        _pg_noise_hash_avx2(_mm256_add_epi32(i, one),
+                            _mm256_add_epi32(j, one), seed),
+        x2, y2);
+    return _mm256_mul_ps(_mm256_add_ps(_mm256_add_ps(n0, n1), n2),
+                         _mm256_set1_ps(PG_NOISE_SIMPLEX_SCALE));
+}
+
+void
+noise_row_avx2(const pgNoiseParams *params, int x, float ox, float freq,
+               float y, int n, float *out)
+{
+    const __m256i lanes = _mm256_set_epi32(7, 6, 5, 4, 3, 2, 1, 0);
+    const __m256 vox = _mm256_set1_ps(ox), vfreq = _mm256_set1_ps(freq);
+    const __m256 vy = _mm256_set1_ps(y), scale = _mm256_set1_ps(params->scale);
+    __m256 px, sum, fx, fy, s, f;
+    __m256i seed;
+    int i, o;
+
+    for (i = 0; i + 8 <= n; i += 8) {
+        px = _mm256_cvtepi32_ps(
+            _mm256_add_epi32(_mm256_set1_epi32(x + i), lanes));
+        px = _mm256_mul_ps(_mm256_add_ps(px, vox), vfreq);
+        sum = _mm256_setzero_ps();
+        for (o = 0; o < params->octaves; o++) {
+            f = _mm256_set1_ps(params->freqs[o]);
+            fx = _mm256_mul_ps(px, f);
+            fy = _mm256_mul_ps(vy, f);
+            seed = _mm256_set1_epi32((int)params->seeds[o]);
+            switch (params->kind) {
+                case PG_NOISE_VALUE:
+                    s = _pg_noise_value_avx2(fx, fy, seed);
+                    break;
+                case PG_NOISE_PERLIN:
+                    s = _pg_noise_perlin_avx2(fx, fy, seed);
+                    break;
+                default:
+                    s = _pg_noise_simplex_avx2(fx, fy, seed);
+                    break;
+            }
+            sum = _mm256_add_ps(
+                sum, _mm256_mul_ps(s, _mm256_set1_ps(params->amps[o])));
+        }
+        sum = _mm256_max_ps(_mm256_mul_ps(sum, scale), _mm256_set1_ps(-1.0f));
+        _mm256_storeu_ps(out + i, _mm256_min_ps(sum, _mm256_set1_ps(1.0f)));
+    }
+    for (; i < n; i++) {
+        out[i] = _pg_noise_sample(params, ((float)(x + i) + ox) * freq, y);
+    }
+}
+#else
+void
+noise_row_avx2(const pgNoiseParams *params, int x, float ox, float freq,
+               float y, int n, float *out)
+{
+    BAD_AVX2_FUNCTION_CALL;
+}
+#endif /* defined(__AVX2__) && defined(HAVE_IMMINTRIN_H) && \
+          !defined(SDL_DISABLE_IMMINTRIN_H) */
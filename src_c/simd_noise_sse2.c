@@ -0,0 +1,243 @@
+#include "simd_noise.h"
+
+#if PG_ENABLE_ARM_NEON
+// sse2neon.h is from here: https://github.com/DLTcollab/sse2neon
+#include "include/sse2neon.h"
+#endif /* PG_ENABLE_ARM_NEON */
+
+#define BAD_SSE2_FUNCTION_CALL                                               \
+    printf(                                                                  \
+        "Fatal Error: Attempted calling an SSE2 function when both compile " \
+        "time and runtime support is missing. If you are seeing this "       \
+        "message, you have stumbled across a pygame bug, please report it "  \
+        "to the devs!");                                                     \
+    PG_EXIT(1)
+
+int
+_pg_noise_HasSSE_NEON()
+{
+#if defined(__SSE2__)
+    return pg_simd_max_level() >= PG_SIMD_SSE2_NEON && SDL_HasSSE2();
+#elif PG_ENABLE_ARM_NEON
+    return pg_simd_max_level() >= PG_SIMD_SSE2_NEON && SDL_HasNEON();
+#else
+    return 0;
+#endif
+}
+
+#if defined(__SSE2__) || defined(PG_ENABLE_ARM_NEON)
+/* m ? a : b for each lane, m being all ones or all zeros */
+#define _PG_SELECT_SSE2(m, a, b) \
+    _mm_or_ps(_mm_and_ps(m, a), _mm_andnot_ps(m, b))
+
+/* The low 32 bits of a * b, which SSE2 has no instruction for */
+static PG_INLINE __m128i
+_pg_mullo_epi32_sse2(__m128i a, __m128i b)
+{
+    __m128i even = _mm_mul_epu32(a, b);
+    __m128i odd = _mm_mul_epu32(_mm_srli_epi64(a, 32), _mm_srli_epi64(b, 32));
+    return _mm_unpacklo_epi32(_mm_shuffle_epi32(even, _MM_SHUFFLE(0, 0, 2, 0)),
+                              _mm_shuffle_epi32(odd, _MM_SHUFFLE(0, 0, 2, 0)));
+}
+
+/* The lanes of _pg_noise_hash() and friends */
+static PG_INLINE __m128i
+_pg_noise_hash_sse2(__m128i x, __m128i y, __m128i seed)
+{
+    __m128i h = _mm_xor_si128(
+        _mm_xor_si128(
+            _pg_mullo_epi32_sse2(x, _mm_set1_epi32((int)PG_NOISE_HASH_X)),
+            _pg_mullo_epi32_sse2(y, _mm_set1_epi32((int)PG_NOISE_HASH_Y))),
+        seed);
+    h = _mm_xor_si128(h, _mm_srli_epi32(h, 13));
+    h = _pg_mullo_epi32_sse2(h, _mm_set1_epi32((int)PG_NOISE_HASH_MIX));
+    return _mm_xor_si128(h, _mm_srli_epi32(h, 15));
+}
+
+static PG_INLINE __m128i
+_pg_noise_floor_sse2(__m128 v)
+{
+    __m128i i;
+    v = _mm_max_ps(v, _mm_set1_ps(-PG_NOISE_LIMIT));
+    v = _mm_min_ps(v, _mm_set1_ps(PG_NOISE_LIMIT));
+    i = _mm_cvttps_epi32(v);
+    /* the comparison is all ones, -1, where i is one too big */
+    return _mm_add_epi32(
+        i, _mm_castps_si128(_mm_cmpgt_ps(_mm_cvtepi32_ps(i), v)));
+}
+
+static PG_INLINE __m128
+_pg_noise_fade_sse2(__m128 t)
+{
+    __m128 p = _mm_sub_ps(_mm_mul_ps(t, _mm_set1_ps(6.0f)),
+                          _mm_set1_ps(15.0f));
+    p = _mm_add_ps(_mm_mul_ps(t, p), _mm_set1_ps(10.0f));
+    return _mm_mul_ps(_mm_mul_ps(_mm_mul_ps(t, t), t), p);
+}
+
+static PG_INLINE __m128
+_pg_noise_lerp_sse2(__m128 a, __m128 b, __m128 t)
+{
+    return _mm_add_ps(a, _mm_mul_ps(_mm_sub_ps(b, a), t));
+}
+
+static PG_INLINE __m128
+_pg_noise_grad_sse2(__m128i h, __m128 x, __m128 y)
+{
+    const __m128i one = _mm_set1_epi32(1), two = _mm_set1_epi32(2);
+    __m128 swap = _mm_castsi128_ps(_mm_cmpeq_epi32(
+        _mm_and_si128(h, _mm_set1_epi32(4)), _mm_set1_epi32(4)));
+    __m128 u = _PG_SELECT_SSE2(swap, y, x);
+    __m128 v = _PG_SELECT_SSE2(swap, x, y);
+    /* negating is flipping the sign bit */
+    u = _mm_xor_ps(u, _mm_castsi128_ps(
+                          _mm_slli_epi32(_mm_and_si128(h, one), 31)));
+    v = _mm_add_ps(v, v);
+    v = _mm_xor_ps(v, _mm_castsi128_ps(
+                          _mm_slli_epi32(_mm_and_si128(h, two), 30)));
+    return _mm_add_ps(u, v);
+}
+
+static PG_INLINE __m128
+_pg_noise_corner_sse2(__m128i h)
+{
+    return _mm_sub_ps(_mm_mul_ps(_mm_cvtepi32_ps(_mm_srli_epi32(h, 8)),
+                                 _mm_set1_ps(2.0f / 16777215.0f)),
+                      _mm_set1_ps(1.0f));
+}
+
+static PG_INLINE __m128
+_pg_noise_value_sse2(__m128 x, __m128 y, __m128i seed)
+{
+    const __m128i one = _mm_set1_epi32(1);
+    __m128i ix = _pg_noise_floor_sse2(x), iy = _pg_noise_floor_sse2(y);
+    __m128i ix1 = _mm_add_epi32(ix, one), iy1 = _mm_add_epi32(iy, one);
+    __m128 u = _pg_noise_fade_sse2(_mm_sub_ps(x, _mm_cvtepi32_ps(ix)));
+    __m128 v = _pg_noise_fade_sse2(_mm_sub_ps(y, _mm_cvtepi32_ps(iy)));
+    __m128 n00 = _pg_noise_corner_sse2(_pg_noise_hash_sse2(ix, iy, seed));
+    __m128 n10 = _pg_noise_corner_sse2(_pg_noise_hash_sse2(ix1, iy, seed));
+    __m128 n01 = _pg_noise_corner_sse2(_pg_noise_hash_sse2(ix, iy1, seed));
+    __m128 n11 = _pg_noise_corner_sse2(_pg_noise_hash_sse2(ix1, iy1, seed));
+    return _pg_noise_lerp_sse2(_pg_noise_lerp_sse2(n00, n10, u),
+                               _pg_noise_lerp_sse2(n01, n11, u), v);
+}
+
+static PG_INLINE __m128
+_pg_noise_perlin_sse2(__m128 x, __m128 y, __m128i seed)
+{
+    const __m128i one = _mm_set1_epi32(1);
+    const __m128 onef = _mm_set1_ps(1.0f);
+    __m128i ix = _pg_noise_floor_sse2(x), iy = _pg_noise_floor_sse2(y);
+    __m128i ix1 = _mm_add_epi32(ix, one), iy1 = _mm_add_epi32(iy, one);
+    __m128 fx = _mm_sub_ps(x, _mm_cvtepi32_ps(ix));
+    __m128 fy = _mm_sub_ps(y, _mm_cvtepi32_ps(iy));
+    __m128 fx1 = _mm_sub_ps(fx, onef), fy1 = _mm_sub_ps(fy, onef);
+    __m128 u = _pg_noise_fade_sse2(fx), v = _pg_noise_fade_sse2(fy);
+    __m128 n00 =
+        _pg_noise_grad_sse2(_pg_noise_hash_sse2(ix, iy, seed), fx, fy);
+    __m128 n10 =
+        _pg_noise_grad_sse2(_pg_noise_hash_sse2(ix1, iy, seed), fx1, fy);
+    __m128 n01 =
+        _pg_noise_grad_sse2(_pg_noise_hash_sse2(ix, iy1, seed), fx, fy1);
+    __m128 n11 =
+        _pg_noise_grad_sse2(_pg_noise_hash_sse2(ix1, iy1, seed), fx1, fy1);
+    return _mm_mul_ps(
+        _pg_noise_lerp_sse2(_pg_noise_lerp_sse2(n00, n10, u),
+                            _pg_noise_lerp_sse2(n01, n11, u), v),
+        _mm_set1_ps(PG_NOISE_PERLIN_SCALE));
+}
+
+static PG_INLINE __m128
+_pg_noise_simplex_corner_sse2(__m128i h, __m128 x, __m128 y)
+{
+    __m128 t = _mm_sub_ps(_mm_sub_ps(_mm_set1_ps(0.5f), _mm_mul_ps(x, x)),
+                          _mm_mul_ps(y, y));
+    __m128 t2 = _mm_mul_ps(t, t);
+    __m128 n = _mm_mul_ps(_mm_mul_ps(t2, t2), _pg_noise_grad_sse2(h, x, y));
+    return _mm_andnot_ps(_mm_cmplt_ps(t, _mm_setzero_ps()), n);
+}
+
+static PG_INLINE __m128
+_pg_noise_simplex_sse2(__m128 x, __m128 y, __m128i seed)
+{
+    const __m128i one = _mm_set1_epi32(1);
+    const __m128 g2 = _mm_set1_ps(PG_NOISE_G2);
+    __m128 s = _mm_mul_ps(_mm_add_ps(x, y), _mm_set1_ps(PG_NOISE_F2));
+    __m128i i = _pg_noise_floor_sse2(_mm_add_ps(x, s));
+    __m128i j = _pg_noise_floor_sse2(_mm_add_ps(y, s));
+    __m128 fi = _mm_cvtepi32_ps(i), fj = _mm_cvtepi32_ps(j);
+    __m128 t = _mm_mul_ps(_mm_add_ps(fi, fj), g2);
+    __m128 x0 = _mm_sub_ps(x, _mm_sub_ps(fi, t));
+    __m128 y0 = _mm_sub_ps(y, _mm_sub_ps(fj, t));
+    __m128i lower = _mm_castps_si128(_mm_cmpgt_ps(x0, y0));
+    __m128i i1 = _mm_srli_epi32(lower, 31);
+    __m128i j1 = _mm_xor_si128(i1, one);
+    __m128 x1 = _mm_add_ps(_mm_sub_ps(x0, _mm_cvtepi32_ps(i1)), g2);
+    __m128 y1 = _mm_add_ps(_mm_sub_ps(y0, _mm_cvtepi32_ps(j1)), g2);
+    __m128 x2 = _mm_add_ps(_mm_sub_ps(x0, _mm_set1_ps(1.0f)),
+                           _mm_set1_ps(2.0f * PG_NOISE_G2));
+    __m128 y2 = _mm_add_ps(_mm_sub_ps(y0, _mm_set1_ps(1.0f)),
+                           _mm_set1_ps(2.0f * PG_NOISE_G2));
+    __m128 n0 = _pg_noise_simplex_corner_sse2(
+        _pg_noise_hash_sse2(i, j, seed), x0, y0);
+    __m128 n1 = _pg_noise_simplex_corner_sse2(
+        _pg_noise_hash_sse2(_mm_add_epi32(i, i1), _mm_add_epi32(j, j1),
+                            seed),
+        x1, y1);
+    __m128 n2 = _pg_noise_simplex_corner_sse2(
+        _pg_noise_hash_sse2(_mm_add_epi32(i, one), _mm_add_epi32(j, one),
+                            seed),
+        x2, y2);
+    return _mm_mul_ps(_mm_add_ps(_mm_add_ps(n0, n1), n2),
+                      _mm_set1_ps(PG_NOISE_SIMPLEX_SCALE));
+}
+
+void
+noise_row_sse2(const pgNoiseParams *params, int x, float ox, float freq,
+               float y, int n, float *out)
+{
+    const __m128i lanes = _mm_set_epi32(3, 2, 1, 0);
+    const __m128 vox = _mm_set1_ps(ox), vfreq = _mm_set1_ps(freq);
+    const __m128 vy = _mm_set1_ps(y), scale = _mm_set1_ps(params->scale);
+    __m128 px, sum, fx, fy, s, f;
+    __m128i seed;
+    int i, o;
+
+    for (i = 0; i + 4 <= n; i += 4) {
+        px = _mm_cvtepi32_ps(_mm_add_epi32(_mm_set1_epi32(x + i), lanes));
+        px = _mm_mul_ps(_mm_add_ps(px, vox), vfreq);
+        sum = _mm_setzero_ps();
+        for (o = 0; o < params->octaves; o++) {
+            f = _mm_set1_ps(params->freqs[o]);
+            fx = _mm_mul_ps(px, f);
+            fy = _mm_mul_ps(vy, f);
+            seed = _mm_set1_epi32((int)params->seeds[o]);
+            switch (params->kind) {
+                case PG_NOISE_VALUE:
+                    s = _pg_noise_value_sse2(fx, fy, seed);
+                    break;
+                case PG_NOISE_PERLIN:
+                    s = _pg_noise_perlin_sse2(fx, fy, seed);
+                    break;
+                default:
+                    s = _pg_noise_simplex_sse2(fx, fy, seed);
+                    break;
+            }
+            sum = _mm_add_ps(sum,
+                             _mm_mul_ps(s, _mm_set1_ps(params->amps[o])));
+        }
+        sum = _mm_max_ps(_mm_mul_ps(sum, scale), _mm_set1_ps(-1.0f));
+        _mm_storeu_ps(out + i, _mm_min_ps(sum, _mm_set1_ps(1.0f)));
+    }
+    for (; i < n; i++) {
+        out[i] = _pg_noise_sample(params, ((float)(x + i) + ox) * freq, y);
+    }
+}
+#else
+void
+noise_row_sse2(const pgNoiseParams *params, int x, float ox, float freq,
+               float y, int n, float *out)
+{
+    BAD_SSE2_FUNCTION_CALL;
+}
+#endif /* defined(__SSE2__) || defined(PG_ENABLE_ARM_NEON) */
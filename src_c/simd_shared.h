@@ -52,9 +52,9 @@ int
 pg_HasSSE_NEON()
 {
 #if defined(__SSE2__)
-    return SDL_HasSSE2();
+    return pg_simd_max_level() >= PG_SIMD_SSE2_NEON && SDL_HasSSE2();
 #elif PG_ENABLE_ARM_NEON
-    return SDL_HasNEON();
+    return pg_simd_max_level() >= PG_SIMD_SSE2_NEON && SDL_HasNEON();
 #else
     return 0;
 #endif
@@ -19,7 +19,7 @@ _pg_has_avx2()
 {
 #if defined(__AVX2__) && defined(HAVE_IMMINTRIN_H) && \
     !defined(SDL_DISABLE_IMMINTRIN_H)
-    return SDL_HasAVX2();
+    return pg_simd_max_level() >= PG_SIMD_AVX2 && SDL_HasAVX2();
 #else
     return 0;
 #endif /* defined(__AVX2__) && defined(HAVE_IMMINTRIN_H) && \
@@ -55,16 +55,16 @@ _pg_has_avx2()
     }                                                                         \
     __m256i mm256_color = _mm256_set1_epi32(color);
 
-#define RUN_AVX2_FILLER(FILL_CODE)                                  \
+#define RUN_AVX2_FILLER_ROWS(FILL_CODE, LOAD, STORE)                \
     while (height--) {                                              \
         for (i = 0; i < n_iters_8; i++) {                           \
             /* load 8 pixels */                                     \
-            mm256_dst = _mm256_loadu_si256((__m256i *)pixels);      \
+            mm256_dst = LOAD((__m256i *)pixels);                    \
                                                                     \
             {FILL_CODE}                                             \
                                                                     \
             /* store 8 pixels */                                    \
-            _mm256_storeu_si256((__m256i *)pixels, mm256_dst);      \
+            STORE((__m256i *)pixels, mm256_dst);                    \
                                                                     \
             pixels += 8;                                            \
         }                                                           \
@@ -84,6 +84,18 @@ _pg_has_avx2()
         pixels += skip;                                             \
     }
 
+/* Rows starting at 32 byte boundaries, as surfaces get them with
+ * pygame.surface.set_row_alignment(), take aligned loads and stores */
+#define RUN_AVX2_FILLER(FILL_CODE)                                          \
+    if (PG_ROWS_ALIGNED(pixels, surface->pitch, 32)) {                      \
+        RUN_AVX2_FILLER_ROWS(FILL_CODE, _mm256_load_si256,                  \
+                             _mm256_store_si256)                            \
+    }                                                                       \
+    else {                                                                  \
+        RUN_AVX2_FILLER_ROWS(FILL_CODE, _mm256_loadu_si256,                 \
+                             _mm256_storeu_si256)                           \
+    }
+
 /* Setup for RUN_16BIT_SHUFFLE_OUT */
 #define SETUP_SHUFFLE                                                      \
     __m256i shuff_dst, _shuff16_temp, mm256_zero = _mm256_setzero_si256(); \
@@ -179,3 +191,112 @@ INVALID_DEFS(max)
 INVALID_DEFS(mult)
 #endif /* defined(__AVX2__) && defined(HAVE_IMMINTRIN_H) && \
  !defined(SDL_DISABLE_IMMINTRIN_H) */
+
+#if defined(__AVX2__) && defined(HAVE_IMMINTRIN_H) && \
+    !defined(SDL_DISABLE_IMMINTRIN_H)
+void
+surface_fill_span_avx2(Uint8 *dst, size_t nbytes, const Uint8 *pattern)
+{
+    /* 96 bytes are three registers */
+    __m256i mm256_pattern0 = _mm256_loadu_si256((const __m256i *)pattern);
+    __m256i mm256_pattern1 =
+        _mm256_loadu_si256((const __m256i *)(pattern + 32));
+    __m256i mm256_pattern2 =
+        _mm256_loadu_si256((const __m256i *)(pattern + 64));
+
+    for (; nbytes >= PG_SPAN_PATTERN_SIZE;
+         nbytes -= PG_SPAN_PATTERN_SIZE, dst += PG_SPAN_PATTERN_SIZE) {
+        _mm256_storeu_si256((__m256i *)dst, mm256_pattern0);
+        _mm256_storeu_si256((__m256i *)(dst + 32), mm256_pattern1);
+        _mm256_storeu_si256((__m256i *)(dst + 64), mm256_pattern2);
+    }
+    memcpy(dst, pattern, nbytes);
+}
+
+/* The alpha of the pixels at p as 32 bit lanes, compared with min_alpha - 1.
+ * The lanes of the pixels with enough alpha are all ones. */
+#define ALPHA_TEST_AVX2(p)                                                \
+    _mm256_cmpgt_epi32(                                                   \
+        _mm256_and_si256(                                                 \
+            _mm256_srl_epi32(_mm256_loadu_si256((const __m256i *)(p)),    \
+                             mm_shift),                                   \
+            mm_ff),                                                       \
+        mm_threshold)
+
+/* 32 pixels are tested at a time, so only the block that has a match is
+ * searched pixel by pixel */
+int
+surface_alpha_first_avx2(const Uint32 *row, int n, int ashift, int min_alpha)
+{
+    const __m128i mm_shift = _mm_cvtsi32_si128(ashift);
+    const __m256i mm_ff = _mm256_set1_epi32(0xFF);
+    const __m256i mm_threshold =
+        _mm256_set1_epi32(MAX(MIN(min_alpha, 256), 0) - 1);
+    __m256i m;
+    int i = 0;
+
+    for (; i + 32 <= n; i += 32) {
+        m = _mm256_or_si256(_mm256_or_si256(ALPHA_TEST_AVX2(row + i),
+                                            ALPHA_TEST_AVX2(row + i + 8)),
+                            _mm256_or_si256(ALPHA_TEST_AVX2(row + i + 16),
+                                            ALPHA_TEST_AVX2(row + i + 24)));
+        if (!_mm256_testz_si256(m, m)) {
+            break;
+        }
+    }
+    for (; i < n; i++) {
+        if ((int)(row[i] >> ashift & 0xFF) >= min_alpha) {
+            return i;
+        }
+    }
+    return n;
+}
+
+int
+surface_alpha_last_avx2(const Uint32 *row, int n, int ashift, int min_alpha)
+{
+    const __m128i mm_shift = _mm_cvtsi32_si128(ashift);
+    const __m256i mm_ff = _mm256_set1_epi32(0xFF);
+    const __m256i mm_threshold =
+        _mm256_set1_epi32(MAX(MIN(min_alpha, 256), 0) - 1);
+    __m256i m;
+    int i = n;
+
+    for (; i >= 32; i -= 32) {
+        m = _mm256_or_si256(_mm256_or_si256(ALPHA_TEST_AVX2(row + i - 32),
+                                            ALPHA_TEST_AVX2(row + i - 24)),
+                            _mm256_or_si256(ALPHA_TEST_AVX2(row + i - 16),
+                                            ALPHA_TEST_AVX2(row + i - 8)));
+        if (!_mm256_testz_si256(m, m)) {
+            break;
+        }
+    }
+    while (i-- > 0) {
+        if ((int)(row[i] >> ashift & 0xFF) >= min_alpha) {
+            return i;
+        }
+    }
+    return -1;
+}
+#else
+void
+surface_fill_span_avx2(Uint8 *dst, size_t nbytes, const Uint8 *pattern)
+{
+    BAD_AVX2_FUNCTION_CALL;
+}
+
+int
+surface_alpha_first_avx2(const Uint32 *row, int n, int ashift, int min_alpha)
+{
+    BAD_AVX2_FUNCTION_CALL;
+    return n;
+}
+
+int
+surface_alpha_last_avx2(const Uint32 *row, int n, int ashift, int min_alpha)
+{
+    BAD_AVX2_FUNCTION_CALL;
+    return -1;
+}
+#endif /* defined(__AVX2__) && defined(HAVE_IMMINTRIN_H) && \
+          !defined(SDL_DISABLE_IMMINTRIN_H) */
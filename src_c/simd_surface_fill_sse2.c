@@ -1,4 +1,5 @@
 #include "simd_fill.h"
+#include "simd_565.h"
 
 #if PG_ENABLE_ARM_NEON
 // sse2neon.h is from here: https://github.com/DLTcollab/sse2neon
@@ -17,9 +18,9 @@ int
 _pg_HasSSE_NEON()
 {
 #if defined(__SSE2__)
-    return SDL_HasSSE2();
+    return pg_simd_max_level() >= PG_SIMD_SSE2_NEON && SDL_HasSSE2();
 #elif PG_ENABLE_ARM_NEON
-    return SDL_HasNEON();
+    return pg_simd_max_level() >= PG_SIMD_SSE2_NEON && SDL_HasNEON();
 #else
     return 0;
 #endif
@@ -49,16 +50,16 @@ _pg_HasSSE_NEON()
     }                                                                         \
     __m128i mm128_color = _mm_set1_epi32(color);
 
-#define RUN_SSE2_FILLER(FILL_CODE)                          \
+#define RUN_SSE2_FILLER_ROWS(FILL_CODE, LOAD, STORE)        \
     while (height--) {                                      \
         for (i = 0; i < n_iters_4; i++) {                   \
             /* load 4 pixels */                             \
-            mm128_dst = _mm_loadu_si128((__m128i *)pixels); \
+            mm128_dst = LOAD((__m128i *)pixels);            \
                                                             \
             {FILL_CODE}                                     \
                                                             \
             /* store 4 pixels */                            \
-            _mm_storeu_si128((__m128i *)pixels, mm128_dst); \
+            STORE((__m128i *)pixels, mm128_dst);            \
                                                             \
             pixels += 4;                                    \
         }                                                   \
@@ -75,6 +76,16 @@ _pg_HasSSE_NEON()
         pixels += skip;                                     \
     }
 
+/* Rows starting at 16 byte boundaries, as surfaces get them with
+ * pygame.surface.set_row_alignment(), take aligned loads and stores */
+#define RUN_SSE2_FILLER(FILL_CODE)                                          \
+    if (PG_ROWS_ALIGNED(pixels, surface->pitch, 16)) {                      \
+        RUN_SSE2_FILLER_ROWS(FILL_CODE, _mm_load_si128, _mm_store_si128)    \
+    }                                                                       \
+    else {                                                                  \
+        RUN_SSE2_FILLER_ROWS(FILL_CODE, _mm_loadu_si128, _mm_storeu_si128)  \
+    }
+
 /* Setup for RUN_16BIT_SHUFFLE_OUT */
 #define SETUP_SHUFFLE                                                   \
     __m128i shuff_dst, _shuff16_temp, mm128_zero = _mm_setzero_si128(); \
@@ -155,16 +166,228 @@ _pg_HasSSE_NEON()
         shuff_dst = _mm_srli_epi16(shuff_dst, 8);                   \
     }
 
+/* Blend fills of RGB565 and BGR565 surfaces, see simd_565.h. They have no
+ * alpha, so the RGBA blends are the RGB ones. OP_CODE and SCALAR_CODE
+ * blend the widened channel d with the channel c of the color. */
+#define FILLERS_565(NAME, OP_CODE, SCALAR_CODE)                               \
+    int surface_fill_blend_##NAME##_565_sse2(SDL_Surface *surface,            \
+                                             SDL_Rect *rect, Uint32 color)    \
+    {                                                                         \
+        int width = rect->w, height = rect->h, i;                             \
+        int skip = surface->pitch / 2 - width;                                \
+        Uint16 *pixels = (Uint16 *)surface->pixels +                          \
+                         rect->y * (surface->pitch / 2) + rect->x;            \
+        int rshift = surface->format->Rshift;                                 \
+        int bshift = surface->format->Bshift;                                 \
+        const __m128i mm128_rshift = _mm_cvtsi32_si128(rshift);               \
+        const __m128i mm128_bshift = _mm_cvtsi32_si128(bshift);               \
+        __m128i mm128_dst, mm128_r, mm128_g, mm128_b, d, c;                   \
+        __m128i mm128_cR, mm128_cG, mm128_cB;                                 \
+        Uint8 cR, cG, cB, cA;                                                 \
+        Uint32 p, dR, dG, dB;                                                 \
+                                                                              \
+        SDL_GetRGBA(color, surface->format, &cR, &cG, &cB, &cA);              \
+        mm128_cR = _mm_set1_epi16(cR);                                        \
+        mm128_cG = _mm_set1_epi16(cG);                                        \
+        mm128_cB = _mm_set1_epi16(cB);                                        \
+                                                                              \
+        while (height--) {                                                    \
+            for (i = width; i >= 8; i -= 8, pixels += 8) {                    \
+                mm128_dst = _mm_loadu_si128((__m128i *)pixels);               \
+                PG_MM_UNPACK_565(mm128_dst, mm128_r, mm128_g, mm128_b,        \
+                                 mm128_rshift, mm128_bshift)                  \
+                d = mm128_r;                                                  \
+                c = mm128_cR;                                                 \
+                mm128_r = OP_CODE;                                            \
+                d = mm128_g;                                                  \
+                c = mm128_cG;                                                 \
+                mm128_g = OP_CODE;                                            \
+                d = mm128_b;                                                  \
+                c = mm128_cB;                                                 \
+                mm128_b = OP_CODE;                                            \
+                _mm_storeu_si128((__m128i *)pixels,                           \
+                                 PG_MM_PACK_565(mm128_r, mm128_g, mm128_b,    \
+                                                mm128_rshift, mm128_bshift)); \
+            }                                                                 \
+            for (; i > 0; i--, pixels++) {                                    \
+                p = *pixels;                                                  \
+                dR = PG_WIDEN_5(p >> rshift & 0x1F);                          \
+                dG = PG_WIDEN_6(p >> 5 & 0x3F);                               \
+                dB = PG_WIDEN_5(p >> bshift & 0x1F);                          \
+                dR = SCALAR_CODE(dR, cR);                                     \
+                dG = SCALAR_CODE(dG, cG);                                     \
+                dB = SCALAR_CODE(dB, cB);                                     \
+                *pixels = PG_PACK_565(dR, dG, dB, rshift, bshift);            \
+            }                                                                 \
+            pixels += skip;                                                   \
+        }                                                                     \
+        return 0;                                                             \
+    }                                                                         \
+    int surface_fill_blend_rgba_##NAME##_565_sse2(                            \
+        SDL_Surface *surface, SDL_Rect *rect, Uint32 color)                   \
+    {                                                                         \
+        return surface_fill_blend_##NAME##_565_sse2(surface, rect, color);    \
+    }
+
+#define INVALID_DEFS_565(NAME)                                          \
+    int surface_fill_blend_##NAME##_565_sse2(SDL_Surface *surface,      \
+                                             SDL_Rect *rect,            \
+                                             Uint32 color)              \
+    {                                                                   \
+        BAD_SSE2_FUNCTION_CALL;                                         \
+        return -1;                                                      \
+    }                                                                   \
+    int surface_fill_blend_rgba_##NAME##_565_sse2(                      \
+        SDL_Surface *surface, SDL_Rect *rect, Uint32 color)             \
+    {                                                                   \
+        BAD_SSE2_FUNCTION_CALL;                                         \
+        return -1;                                                      \
+    }
+
+/* The channels are at most 255 in their 16 bit lanes, so the signed
+ * min and max work, and the products of MULT don't overflow */
+#define ADD_565_CODE _mm_min_epi16(_mm_add_epi16(d, c), _mm_set1_epi16(255))
+#define SUB_565_CODE _mm_subs_epu16(d, c)
+#define MULT_565_CODE                                               \
+    _mm_srli_epi16(_mm_add_epi16(_mm_mullo_epi16(d, c),             \
+                                 _mm_set1_epi16(255)),              \
+                   8)
+#define MIN_565_CODE _mm_min_epi16(d, c)
+#define MAX_565_CODE _mm_max_epi16(d, c)
+
+/* The generic blends of BLEND_ADD() and friends */
+#define ADD_565_SCALAR(d, c) MIN((d) + (c), 255)
+#define SUB_565_SCALAR(d, c) ((d) > (c) ? (d) - (c) : 0)
+#define MULT_565_SCALAR(d, c) (((d) * (c) + 255) >> 8)
+#define MIN_565_SCALAR(d, c) MIN((Uint32)(d), (Uint32)(c))
+#define MAX_565_SCALAR(d, c) MAX((Uint32)(d), (Uint32)(c))
+
 #if defined(__SSE2__) || defined(PG_ENABLE_ARM_NEON)
 FILLERS(add, color &= ~amask;, ADD_CODE)
 FILLERS(sub, color &= ~amask;, SUB_CODE)
 FILLERS(min, color |= amask;, MIN_CODE)
 FILLERS(max, color &= ~amask;, MAX_CODE)
 FILLERS_SHUFF(mult, color |= amask;, MULT_CODE)
+FILLERS_565(add, ADD_565_CODE, ADD_565_SCALAR)
+FILLERS_565(sub, SUB_565_CODE, SUB_565_SCALAR)
+FILLERS_565(mult, MULT_565_CODE, MULT_565_SCALAR)
+FILLERS_565(min, MIN_565_CODE, MIN_565_SCALAR)
+FILLERS_565(max, MAX_565_CODE, MAX_565_SCALAR)
 #else
 INVALID_DEFS(add)
 INVALID_DEFS(sub)
 INVALID_DEFS(min)
 INVALID_DEFS(max)
 INVALID_DEFS(mult)
+INVALID_DEFS_565(add)
+INVALID_DEFS_565(sub)
+INVALID_DEFS_565(min)
+INVALID_DEFS_565(max)
+INVALID_DEFS_565(mult)
+#endif /* defined(__SSE2__) || defined(PG_ENABLE_ARM_NEON) */
+
+#if defined(__SSE2__) || defined(PG_ENABLE_ARM_NEON)
+void
+surface_fill_span_sse2(Uint8 *dst, size_t nbytes, const Uint8 *pattern)
+{
+    /* 96 bytes are six registers */
+    __m128i mm128_pattern[6];
+    int i;
+
+    for (i = 0; i < 6; i++) {
+        mm128_pattern[i] = _mm_loadu_si128((const __m128i *)pattern + i);
+    }
+    for (; nbytes >= PG_SPAN_PATTERN_SIZE;
+         nbytes -= PG_SPAN_PATTERN_SIZE, dst += PG_SPAN_PATTERN_SIZE) {
+        for (i = 0; i < 6; i++) {
+            _mm_storeu_si128((__m128i *)dst + i, mm128_pattern[i]);
+        }
+    }
+    memcpy(dst, pattern, nbytes);
+}
+
+/* The alpha of the pixels at p as 32 bit lanes, compared with min_alpha - 1.
+ * The lanes of the pixels with enough alpha are all ones. */
+#define ALPHA_TEST_SSE2(p)                                                 \
+    _mm_cmpgt_epi32(                                                       \
+        _mm_and_si128(_mm_srl_epi32(_mm_loadu_si128((const __m128i *)(p)), \
+                                    mm_shift),                             \
+                      mm_ff),                                              \
+        mm_threshold)
+
+/* 16 pixels are tested at a time, so only the block that has a match is
+ * searched pixel by pixel */
+int
+surface_alpha_first_sse2(const Uint32 *row, int n, int ashift, int min_alpha)
+{
+    const __m128i mm_shift = _mm_cvtsi32_si128(ashift);
+    const __m128i mm_ff = _mm_set1_epi32(0xFF);
+    const __m128i mm_threshold =
+        _mm_set1_epi32(MAX(MIN(min_alpha, 256), 0) - 1);
+    __m128i m;
+    int i = 0;
+
+    for (; i + 16 <= n; i += 16) {
+        m = _mm_or_si128(_mm_or_si128(ALPHA_TEST_SSE2(row + i),
+                                      ALPHA_TEST_SSE2(row + i + 4)),
+                         _mm_or_si128(ALPHA_TEST_SSE2(row + i + 8),
+                                      ALPHA_TEST_SSE2(row + i + 12)));
+        if (_mm_movemask_epi8(m)) {
+            break;
+        }
+    }
+    for (; i < n; i++) {
+        if ((int)(row[i] >> ashift & 0xFF) >= min_alpha) {
+            return i;
+        }
+    }
+    return n;
+}
+
+int
+surface_alpha_last_sse2(const Uint32 *row, int n, int ashift, int min_alpha)
+{
+    const __m128i mm_shift = _mm_cvtsi32_si128(ashift);
+    const __m128i mm_ff = _mm_set1_epi32(0xFF);
+    const __m128i mm_threshold =
+        _mm_set1_epi32(MAX(MIN(min_alpha, 256), 0) - 1);
+    __m128i m;
+    int i = n;
+
+    for (; i >= 16; i -= 16) {
+        m = _mm_or_si128(_mm_or_si128(ALPHA_TEST_SSE2(row + i - 16),
+                                      ALPHA_TEST_SSE2(row + i - 12)),
+                         _mm_or_si128(ALPHA_TEST_SSE2(row + i - 8),
+                                      ALPHA_TEST_SSE2(row + i - 4)));
+        if (_mm_movemask_epi8(m)) {
+            break;
+        }
+    }
+    while (i-- > 0) {
+        if ((int)(row[i] >> ashift & 0xFF) >= min_alpha) {
+            return i;
+        }
+    }
+    return -1;
+}
+#else
+void
+surface_fill_span_sse2(Uint8 *dst, size_t nbytes, const Uint8 *pattern)
+{
+    BAD_SSE2_FUNCTION_CALL;
+}
+
+int
+surface_alpha_first_sse2(const Uint32 *row, int n, int ashift, int min_alpha)
+{
+    BAD_SSE2_FUNCTION_CALL;
+    return n;
+}
+
+int
+surface_alpha_last_sse2(const Uint32 *row, int n, int ashift, int min_alpha)
+{
+    BAD_SSE2_FUNCTION_CALL;
+    return -1;
+}
 #endif /* defined(__SSE2__) || defined(PG_ENABLE_ARM_NEON) */
@@ -1,4 +1,7 @@
 #define NO_PYGAME_C_API
+#ifndef SIMD_TRANSFORM_H
+#define SIMD_TRANSFORM_H
+
 #include "_surface.h"
 
 /**
@@ -16,6 +19,137 @@
 #define _PG_SIMD_SHUFFLE(fp3, fp2, fp1, fp0) \
     (((fp3) << 6) | ((fp2) << 4) | ((fp1) << 2) | ((fp0)))
 
+/* Rotation row kernels, for 32 bit pixels.
+ * rotate_nearest_row: one row of transform.rotate(), 16.16 fixed point source
+ * coordinates start at (dx, dy) and advance by (icos, isin) every pixel.
+ * Pixels outside of [0, xmaxval] x [0, ymaxval] are set to bgcolor.
+ * rotozoom_smooth_run: bilinear interpolation for rotozoom, every pixel of
+ * the run must have its 2x2 source neighbourhood inside the source. */
+typedef void (*ROTATE_NEAREST_ROW_P)(const Uint8 *srcpix, int srcpitch,
+                                     Uint32 *dstpix, int width, int dx,
+                                     int dy, int icos, int isin, int xmaxval,
+                                     int ymaxval, Uint32 bgcolor);
+typedef void (*ROTOZOOM_SMOOTH_RUN_P)(const Uint8 *srcpix, int srcpitch,
+                                      Uint32 *dstpix, int width, int sdx,
+                                      int sdy, int icos, int isin);
+
+/* the most threads a rotozoom is split across */
+#define ROTOZOOM_MAX_THREADS 64
+
+/* the generic version, used for the remaining pixels of a SIMD run too */
+void
+rotozoom_smooth_run(const Uint8 *srcpix, int srcpitch, Uint32 *dstpix,
+                    int width, int sdx, int sdy, int icos, int isin);
+
+/* Row kernels of threshold() and average_color(), for 32 bit pixels.
+ * threshold_row: counts the pixels whose bytes are all within the bytes of
+ * threshold from the search row (or search_color if search is NULL). If
+ * match isn't NULL, match[i] is set to 0xFF for matching pixels, else 0.
+ * average_color_row: adds the 4 bytes of every pixel to sums[0..3]. Unless
+ * alpha_byte is negative, the other 3 bytes are multiplied by the byte at
+ * alpha_byte first. */
+typedef int (*THRESHOLD_ROW_P)(const Uint32 *src, const Uint32 *search, int n,
+                               Uint32 search_color, Uint32 threshold,
+                               Uint8 *match);
+typedef void (*AVERAGE_COLOR_ROW_P)(const Uint8 *row, int n, int alpha_byte,
+                                    Uint64 *sums);
+
+/* Row kernels of hsl() and color_matrix(), for 32 bit pixels with whole
+ * byte channels.
+ * modify_hsl_row: the red, green and blue bytes are at the given bit shifts.
+ * The amask bits are copied from src, the other bits of dst are kept.
+ * color_matrix_row: matrix has 4 rows of 5 floats, see color_matrix().
+ * shifts holds the red, green, blue and alpha shifts. Without amask the
+ * alpha input is 255 and only the first 3 rows are used. Bits outside of
+ * the channels are copied from src. */
+typedef void (*MODIFY_HSL_ROW_P)(const Uint32 *src, Uint32 *dst, int n,
+                                 int rshift, int gshift, int bshift,
+                                 Uint32 amask, float h, float s, float l);
+typedef void (*COLOR_MATRIX_ROW_P)(const Uint32 *src, Uint32 *dst, int n,
+                                   const int *shifts, Uint32 amask,
+                                   const float *matrix);
+
+/* Row kernels of scale2x(), scale3x() and scale4x(), for 32 bit pixels.
+ * They scale n pixels of the row cur, with prev and next the rows above and
+ * below it, into 2 rows of 2 * n or 3 rows of 3 * n pixels. cur[-1] and
+ * cur[n] must exist, the pixels on the edges of the surface are scaled by
+ * the caller. */
+typedef void (*SCALE2X_ROW_P)(const Uint32 *prev, const Uint32 *cur,
+                              const Uint32 *next, Uint32 *dst0, Uint32 *dst1,
+                              int n);
+typedef void (*SCALE3X_ROW_P)(const Uint32 *prev, const Uint32 *cur,
+                              const Uint32 *next, Uint32 *dst0, Uint32 *dst1,
+                              Uint32 *dst2, int n);
+
+/* Kernels of rotate() by multiples of 90 degrees and flip(), for 32 bit
+ * pixels.
+ * transpose32: writes the w x h pixels at src transposed to dst, so that
+ * row x of dst holds column x of src. The pitches may be negative, to go
+ * through the rows bottom up. The pixels are moved in tiles of
+ * PG_TRANSPOSE_TILE x PG_TRANSPOSE_TILE, which keeps the rows of both
+ * surfaces that a tile touches in the cache.
+ * flip_row32: writes the n pixels of src to dst in reverse order. dst may
+ * be src. */
+#define PG_TRANSPOSE_TILE 16
+typedef void (*TRANSPOSE32_P)(const Uint8 *src, int srcpitch, Uint8 *dst,
+                              int dstpitch, int w, int h);
+typedef void (*FLIP_ROW32_P)(const Uint32 *src, Uint32 *dst, int n);
+
+/* Kernels of transform.LightMap. The light map keeps 4 Uint16 per pixel, in
+ * the byte order of an ARGB8888 pixel, where 255 is the full color of the
+ * scene. The alpha lane is always 255.
+ * lightmap_stamp_row: adds the colors of the n ARGB8888 pixels of src,
+ * times intensity / 255 and times their alpha / 255 if has_alpha, to the
+ * light lanes, saturating at 65535, or keeps the larger of both if max.
+ * Each product is rounded with PG_LIGHTMAP_DIV255 on its own.
+ * lightmap_apply_row: multiplies every byte of the n pixels of dst by its
+ * light lane / 256, rounding up and clamping at 255. */
+typedef void (*LIGHTMAP_STAMP_ROW_P)(Uint16 *light, const Uint32 *src, int n,
+                                     int intensity, int has_alpha, int max);
+typedef void (*LIGHTMAP_APPLY_ROW_P)(Uint32 *dst, const Uint16 *light,
+                                     int n);
+
+/* x / 255 rounded, exact for x up to 255 * 255 */
+#define PG_LIGHTMAP_DIV255(x) (((Uint32)(x) + 128) * 257 >> 16)
+
+/* Transposes the pixels of columns x0 to x1 and rows y0 to y1 (exclusive)
+ * of src one by one, for the edges of the transpose32 tiles */
+static PG_INLINE void
+_pg_transpose32_rect(const Uint8 *src, int srcpitch, Uint8 *dst, int dstpitch,
+                     int x0, int x1, int y0, int y1)
+{
+    int x, y;
+
+    for (y = y0; y < y1; y++) {
+        const Uint32 *srcrow = (const Uint32 *)(src + (Sint64)y * srcpitch);
+
+        for (x = x0; x < x1; x++) {
+            ((Uint32 *)(dst + (Sint64)x * dstpitch))[y] = srcrow[x];
+        }
+    }
+}
+
+/* the generic versions, used for the remaining pixels of SIMD rows too */
+int
+threshold_row(const Uint32 *src, const Uint32 *search, int n,
+              Uint32 search_color, Uint32 threshold, Uint8 *match);
+void
+average_color_row(const Uint8 *row, int n, int alpha_byte, Uint64 *sums);
+void
+color_matrix_row(const Uint32 *src, Uint32 *dst, int n, const int *shifts,
+                 Uint32 amask, const float *matrix);
+void
+scale2x_row(const Uint32 *prev, const Uint32 *cur, const Uint32 *next,
+            Uint32 *dst0, Uint32 *dst1, int n);
+void
+scale3x_row(const Uint32 *prev, const Uint32 *cur, const Uint32 *next,
+            Uint32 *dst0, Uint32 *dst1, Uint32 *dst2, int n);
+void
+lightmap_stamp_row(Uint16 *light, const Uint32 *src, int n, int intensity,
+                   int has_alpha, int max);
+void
+lightmap_apply_row(Uint32 *dst, const Uint16 *light, int n);
+
 #if !defined(PG_ENABLE_ARM_NEON) && defined(__aarch64__)
 // arm64 has neon optimisations enabled by default, even when fpu=neon is not
 // passed
@@ -42,6 +176,53 @@ filter_expand_Y_SSE2(Uint8 *srcpix, Uint8 *dstpix, int width, int srcpitch,
                      int dstpitch, int srcheight, int dstheight);
 void
 invert_sse2(SDL_Surface *src, SDL_Surface *newsurf);
+// gaussian_blur passes
+void
+blur_accumulate_u8_sse2(float *acc, const Uint8 *src, int n, float weight);
+void
+blur_accumulate_f32_sse2(float *acc, const float *src, int n, float weight);
+void
+rotate_nearest_row_sse2(const Uint8 *srcpix, int srcpitch, Uint32 *dstpix,
+                        int width, int dx, int dy, int icos, int isin,
+                        int xmaxval, int ymaxval, Uint32 bgcolor);
+void
+rotozoom_smooth_run_sse2(const Uint8 *srcpix, int srcpitch, Uint32 *dstpix,
+                         int width, int sdx, int sdy, int icos, int isin);
+void
+pyramid_downsample_row_sse2(const Uint8 *row0, const Uint8 *row1,
+                            Uint8 *dstpix, int width);
+void
+accumulator_add_sse2(Uint32 *sums, const Uint8 *src, int n);
+void
+accumulator_average_sse2(Uint8 *dst, const Uint32 *sums, int n, float scale);
+int
+threshold_row_sse2(const Uint32 *src, const Uint32 *search, int n,
+                   Uint32 search_color, Uint32 threshold, Uint8 *match);
+void
+average_color_row_sse2(const Uint8 *row, int n, int alpha_byte, Uint64 *sums);
+void
+modify_hsl_row_sse2(const Uint32 *src, Uint32 *dst, int n, int rshift,
+                    int gshift, int bshift, Uint32 amask, float h, float s,
+                    float l);
+void
+color_matrix_row_sse2(const Uint32 *src, Uint32 *dst, int n,
+                      const int *shifts, Uint32 amask, const float *matrix);
+void
+scale2x_row_sse2(const Uint32 *prev, const Uint32 *cur, const Uint32 *next,
+                 Uint32 *dst0, Uint32 *dst1, int n);
+void
+scale3x_row_sse2(const Uint32 *prev, const Uint32 *cur, const Uint32 *next,
+                 Uint32 *dst0, Uint32 *dst1, Uint32 *dst2, int n);
+void
+transpose32_sse2(const Uint8 *src, int srcpitch, Uint8 *dst, int dstpitch,
+                 int w, int h);
+void
+flip_row32_sse2(const Uint32 *src, Uint32 *dst, int n);
+void
+lightmap_stamp_row_sse2(Uint16 *light, const Uint32 *src, int n,
+                        int intensity, int has_alpha, int max);
+void
+lightmap_apply_row_sse2(Uint32 *dst, const Uint16 *light, int n);
 
 #endif /* (defined(__SSE2__) || defined(PG_ENABLE_ARM_NEON)) */
 
@@ -50,3 +231,55 @@ void
 grayscale_avx2(SDL_Surface *src, SDL_Surface *newsurf);
 void
 invert_avx2(SDL_Surface *src, SDL_Surface *newsurf);
+void
+blur_accumulate_u8_avx2(float *acc, const Uint8 *src, int n, float weight);
+void
+blur_accumulate_f32_avx2(float *acc, const float *src, int n, float weight);
+void
+filter_shrink_Y_AVX2(Uint8 *srcpix, Uint8 *dstpix, int width, int srcpitch,
+                     int dstpitch, int srcheight, int dstheight);
+void
+filter_expand_X_AVX2(Uint8 *srcpix, Uint8 *dstpix, int height, int srcpitch,
+                     int dstpitch, int srcwidth, int dstwidth);
+void
+filter_expand_Y_AVX2(Uint8 *srcpix, Uint8 *dstpix, int width, int srcpitch,
+                     int dstpitch, int srcheight, int dstheight);
+void
+accumulator_add_avx2(Uint32 *sums, const Uint8 *src, int n);
+int
+threshold_row_avx2(const Uint32 *src, const Uint32 *search, int n,
+                   Uint32 search_color, Uint32 threshold, Uint8 *match);
+void
+average_color_row_avx2(const Uint8 *row, int n, int alpha_byte, Uint64 *sums);
+void
+modify_hsl_row_avx2(const Uint32 *src, Uint32 *dst, int n, int rshift,
+                    int gshift, int bshift, Uint32 amask, float h, float s,
+                    float l);
+void
+color_matrix_row_avx2(const Uint32 *src, Uint32 *dst, int n,
+                      const int *shifts, Uint32 amask, const float *matrix);
+void
+rotate_nearest_row_avx2(const Uint8 *srcpix, int srcpitch, Uint32 *dstpix,
+                        int width, int dx, int dy, int icos, int isin,
+                        int xmaxval, int ymaxval, Uint32 bgcolor);
+void
+rotozoom_smooth_run_avx2(const Uint8 *srcpix, int srcpitch, Uint32 *dstpix,
+                         int width, int sdx, int sdy, int icos, int isin);
+void
+scale2x_row_avx2(const Uint32 *prev, const Uint32 *cur, const Uint32 *next,
+                 Uint32 *dst0, Uint32 *dst1, int n);
+void
+scale3x_row_avx2(const Uint32 *prev, const Uint32 *cur, const Uint32 *next,
+                 Uint32 *dst0, Uint32 *dst1, Uint32 *dst2, int n);
+void
+transpose32_avx2(const Uint8 *src, int srcpitch, Uint8 *dst, int dstpitch,
+                 int w, int h);
+void
+flip_row32_avx2(const Uint32 *src, Uint32 *dst, int n);
+void
+lightmap_stamp_row_avx2(Uint16 *light, const Uint32 *src, int n,
+                        int intensity, int has_alpha, int max);
+void
+lightmap_apply_row_avx2(Uint32 *dst, const Uint16 *light, int n);
+
+#endif  // SIMD_TRANSFORM_H
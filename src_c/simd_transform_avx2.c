@@ -19,7 +19,7 @@ pg_has_avx2()
 {
 #if defined(__AVX2__) && defined(HAVE_IMMINTRIN_H) && \
     !defined(SDL_DISABLE_IMMINTRIN_H)
-    return SDL_HasAVX2();
+    return pg_simd_max_level() >= PG_SIMD_AVX2 && SDL_HasAVX2();
 #else
     return 0;
 #endif /* defined(__AVX2__) && defined(HAVE_IMMINTRIN_H) && \
@@ -298,6 +298,1118 @@ invert_avx2(SDL_Surface *src, SDL_Surface *newsurf)
         srcp256 = (__m256i *)srcp;
     }
 }
+
+/* acc[i] += src[i] * weight
+ * No FMA, so the results are exactly the same as the scalar code. */
+void
+blur_accumulate_u8_avx2(float *acc, const Uint8 *src, int n, float weight)
+{
+    int i = 0;
+    __m256 mm256_weight = _mm256_set1_ps(weight);
+    __m256 mm256_src;
+
+    for (; i + 8 <= n; i += 8) {
+        mm256_src = _mm256_cvtepi32_ps(_mm256_cvtepu8_epi32(
+            _mm_loadl_epi64((const __m128i *)(src + i))));
+        mm256_src = _mm256_mul_ps(mm256_src, mm256_weight);
+        _mm256_storeu_ps(acc + i,
+                         _mm256_add_ps(_mm256_loadu_ps(acc + i), mm256_src));
+    }
+    for (; i < n; i++) {
+        acc[i] += (float)src[i] * weight;
+    }
+}
+
+/* acc[i] += src[i] * weight */
+void
+blur_accumulate_f32_avx2(float *acc, const float *src, int n, float weight)
+{
+    int i = 0;
+    __m256 mm256_weight = _mm256_set1_ps(weight);
+    __m256 mm256_src;
+
+    for (; i + 8 <= n; i += 8) {
+        mm256_src = _mm256_mul_ps(_mm256_loadu_ps(src + i), mm256_weight);
+        _mm256_storeu_ps(acc + i,
+                         _mm256_add_ps(_mm256_loadu_ps(acc + i), mm256_src));
+    }
+    for (; i < n; i++) {
+        acc[i] += src[i] * weight;
+    }
+}
+
+#define _pg_loadu_si32_avx2(p) _mm_cvtsi32_si128(*(unsigned int const *)(p))
+#define _pg_storeu_si32_avx2(p, a) (void)(*(int *)(p) = _mm_cvtsi128_si32((a)))
+
+/* The smoothscale filters below give exactly the same results as the SSE2
+ * ones, they only work on more pixels at once. There is no X shrink filter,
+ * it accumulates pixel after pixel along a row and the SSE2 version that
+ * runs 2 rows at once is already as fast as a 4 row one. */
+
+void
+filter_shrink_Y_AVX2(Uint8 *srcpix, Uint8 *dstpix, int width, int srcpitch,
+                     int dstpitch, int srcheight, int dstheight)
+{
+    // Same as filter_shrink_Y_SSE2, with 8 pixels of a row per iteration
+    int srcdiff = srcpitch - (width * 4);
+    int dstdiff = dstpitch - (width * 4);
+    int x, y;
+    __m256i src0, src1, dst0, dst1, mm_yfrac, mm_ycounter;
+    __m128i src, dst, mm_acc;
+
+    int during_8_width = width / 8;
+    int post_8_width = width % 8;
+
+    int yspace = 0x04000 * srcheight / dstheight; /* must be > 1 */
+    __m256i yrecip = _mm256_set1_epi16(0x40000000 / yspace);
+    int ycounter = yspace;
+
+    Uint16 *templine;
+    /* allocate a clear memory area for storing the accumulator line */
+    templine = (Uint16 *)calloc(dstpitch, 2);
+    if (templine == NULL) {
+        return;
+    }
+
+    for (y = 0; y < srcheight; y++) {
+        Uint16 *accumulate = templine;
+        if (ycounter > 0x04000) {
+            for (x = 0; x < during_8_width; x++) {
+                src0 = _mm256_cvtepu8_epi16(
+                    _mm_loadu_si128((const __m128i *)srcpix));
+                src1 = _mm256_cvtepu8_epi16(
+                    _mm_loadu_si128((const __m128i *)(srcpix + 16)));
+                _mm256_storeu_si256(
+                    (__m256i *)accumulate,
+                    _mm256_add_epi16(
+                        _mm256_loadu_si256((const __m256i *)accumulate),
+                        src0));
+                _mm256_storeu_si256(
+                    (__m256i *)(accumulate + 16),
+                    _mm256_add_epi16(
+                        _mm256_loadu_si256((const __m256i *)(accumulate + 16)),
+                        src1));
+                accumulate += 32;  // 32 Uint16s (8 pixels)
+                srcpix += 32;      // 32 bytes (8 pixels)
+            }
+            for (x = 0; x < post_8_width; x++) {
+                src = _mm_unpacklo_epi8(_pg_loadu_si32_avx2(srcpix),
+                                        _mm_setzero_si128());
+                _mm_storel_epi64(
+                    (__m128i *)accumulate,
+                    _mm_add_epi16(_mm_loadl_epi64((const __m128i *)accumulate),
+                                  src));
+                accumulate += 4;  // 4 Uint16s, so 8 bytes
+                srcpix += 4;      // 4 bytes (1 pixel)
+            }
+            ycounter -= 0x04000;
+        }
+        else {
+            int yfrac = 0x04000 - ycounter;
+            mm_yfrac = _mm256_set1_epi16(yfrac);
+            mm_ycounter = _mm256_set1_epi16(ycounter);
+
+            /* write out a destination line */
+            for (x = 0; x < during_8_width; x++) {
+                src0 = _mm256_cvtepu8_epi16(
+                    _mm_loadu_si128((const __m128i *)srcpix));
+                src1 = _mm256_cvtepu8_epi16(
+                    _mm_loadu_si128((const __m128i *)(srcpix + 16)));
+                srcpix += 32;
+
+                src0 = _mm256_slli_epi16(src0, 2);
+                src1 = _mm256_slli_epi16(src1, 2);
+                dst0 = _mm256_add_epi16(
+                    _mm256_mulhi_epu16(src0, mm_ycounter),
+                    _mm256_loadu_si256((const __m256i *)accumulate));
+                dst1 = _mm256_add_epi16(
+                    _mm256_mulhi_epu16(src1, mm_ycounter),
+                    _mm256_loadu_si256((const __m256i *)(accumulate + 16)));
+                _mm256_storeu_si256((__m256i *)accumulate,
+                                    _mm256_mulhi_epu16(src0, mm_yfrac));
+                _mm256_storeu_si256((__m256i *)(accumulate + 16),
+                                    _mm256_mulhi_epu16(src1, mm_yfrac));
+                accumulate += 32;
+
+                dst0 = _mm256_mulhi_epu16(dst0, yrecip);
+                dst1 = _mm256_mulhi_epu16(dst1, yrecip);
+                // packus works within 128 bit lanes, the permute puts the
+                // 8 pixels back in order
+                dst0 = _mm256_permute4x64_epi64(
+                    _mm256_packus_epi16(dst0, dst1), 0xD8);
+                _mm256_storeu_si256((__m256i *)dstpix, dst0);
+                dstpix += 32;
+            }
+            for (x = 0; x < post_8_width; x++) {
+                src = _mm_unpacklo_epi8(_pg_loadu_si32_avx2(srcpix),
+                                        _mm_setzero_si128());
+                srcpix += 4;
+                mm_acc = _mm_loadl_epi64((const __m128i *)accumulate);
+
+                src = _mm_slli_epi16(src, 2);
+                dst = _mm_mulhi_epu16(src, _mm256_castsi256_si128(mm_yfrac));
+                src = _mm_mulhi_epu16(src,
+                                      _mm256_castsi256_si128(mm_ycounter));
+
+                _mm_storel_epi64((__m128i *)accumulate, dst);
+                accumulate += 4;
+
+                dst = _mm_add_epi16(src, mm_acc);
+                dst = _mm_mulhi_epu16(dst, _mm256_castsi256_si128(yrecip));
+                dst = _mm_packus_epi16(dst, _mm_setzero_si128());
+                _pg_storeu_si32_avx2(dstpix, dst);
+                dstpix += 4;
+            }
+            dstpix += dstdiff;
+            ycounter = yspace - yfrac;
+        }
+        srcpix += srcdiff;
+    }
+
+    /* free the temporary memory */
+    free(templine);
+}
+
+/* Destination pixels x to x + 3 from a gather of their source pixel pairs,
+ * the pairs of x and x + 2 end up in the low halves of the two lanes and the
+ * pairs of x + 1 and x + 3 in the high halves. */
+#define _PG_EXPAND_X_4(pairs, xmult, x, out)                                 \
+    lo = _mm256_mullo_epi16(                                                 \
+        _mm256_unpacklo_epi8(pairs, _mm256_setzero_si256()),                 \
+        _mm256_setr_m128i(                                                   \
+            _mm_loadu_si128((const __m128i *)((xmult) + (x) * 8)),           \
+            _mm_loadu_si128((const __m128i *)((xmult) + ((x) + 2) * 8))));   \
+    hi = _mm256_mullo_epi16(                                                 \
+        _mm256_unpackhi_epi8(pairs, _mm256_setzero_si256()),                 \
+        _mm256_setr_m128i(                                                   \
+            _mm_loadu_si128((const __m128i *)((xmult) + ((x) + 1) * 8)),     \
+            _mm_loadu_si128((const __m128i *)((xmult) + ((x) + 3) * 8))));   \
+    lo = _mm256_srli_epi16(_mm256_add_epi16(lo, _mm256_bsrli_epi128(lo, 8)), \
+                           8);                                               \
+    hi = _mm256_srli_epi16(_mm256_add_epi16(hi, _mm256_bsrli_epi128(hi, 8)), \
+                           8);                                               \
+    out = _mm256_unpacklo_epi64(lo, hi)
+
+void
+filter_expand_X_AVX2(Uint8 *srcpix, Uint8 *dstpix, int height, int srcpitch,
+                     int dstpitch, int srcwidth, int dstwidth)
+{
+    // Every destination pixel blends a pair of neighbouring source pixels,
+    // as in filter_expand_X_SSE2. The pairs for 8 destination pixels are
+    // fetched with two gathers.
+    int dstdiff = dstpitch - (dstwidth * 4);
+    int *xidx0;
+    Uint16 *xmult;
+    int x, y, i;
+    __m256i pairs0, pairs1, lo, hi, dst0, dst1;
+    __m128i src;
+
+    /* Allocate memory for factors */
+    xidx0 = malloc(dstwidth * sizeof(int));
+    if (xidx0 == 0)
+        return;
+    // xm0 for the 4 channels of the first pixel of a pair, then xm1 for the
+    // 4 channels of the second one
+    xmult = malloc(dstwidth * 8 * sizeof(Uint16));
+    if (xmult == 0) {
+        free(xidx0);
+        return;
+    }
+
+    /* Create multiplier factors and starting indices and put them in arrays */
+    for (x = 0; x < dstwidth; x++) {
+        int xm1 = 0x100 * ((x * (srcwidth - 1)) % dstwidth) / dstwidth;
+        int xm0 = 0x100 - xm1;
+        xidx0[x] = x * (srcwidth - 1) / dstwidth;
+        for (i = 0; i < 4; i++) {
+            xmult[x * 8 + i] = xm0;
+            xmult[x * 8 + 4 + i] = xm1;
+        }
+    }
+
+    /* Do the scaling in raster order so we don't trash the cache */
+    for (y = 0; y < height; y++) {
+        Uint8 *srcrow0 = srcpix + y * srcpitch;
+        for (x = 0; x + 8 <= dstwidth; x += 8) {
+            pairs0 = _mm256_i32gather_epi64(
+                (const long long *)srcrow0,
+                _mm_loadu_si128((const __m128i *)(xidx0 + x)), 4);
+            pairs1 = _mm256_i32gather_epi64(
+                (const long long *)srcrow0,
+                _mm_loadu_si128((const __m128i *)(xidx0 + x + 4)), 4);
+            _PG_EXPAND_X_4(pairs0, xmult, x, dst0);
+            _PG_EXPAND_X_4(pairs1, xmult, x + 4, dst1);
+
+            // dst0 holds pixels 0 and 1 in its first lane and 2 and 3 in its
+            // second one, dst1 the same for pixels 4 to 7
+            dst0 = _mm256_permute4x64_epi64(_mm256_packus_epi16(dst0, dst1),
+                                            0xD8);
+            _mm256_storeu_si256((__m256i *)dstpix, dst0);
+            dstpix += 32;
+        }
+        for (; x < dstwidth; x++) {
+            src = _mm_unpacklo_epi8(
+                _mm_loadl_epi64((const __m128i *)(srcrow0 + xidx0[x] * 4)),
+                _mm_setzero_si128());
+            src = _mm_mullo_epi16(
+                src, _mm_loadu_si128((const __m128i *)(xmult + x * 8)));
+            src = _mm_add_epi16(src, _mm_bsrli_si128(src, 8));
+            src =
+                _mm_packus_epi16(_mm_srli_epi16(src, 8), _mm_setzero_si128());
+            _pg_storeu_si32_avx2(dstpix, src);
+            dstpix += 4;
+        }
+        dstpix += dstdiff;
+    }
+
+    /* free memory */
+    free(xidx0);
+    free(xmult);
+}
+
+#undef _PG_EXPAND_X_4
+
+void
+filter_expand_Y_AVX2(Uint8 *srcpix, Uint8 *dstpix, int width, int srcpitch,
+                     int dstpitch, int srcheight, int dstheight)
+{
+    // Same as filter_expand_Y_SSE2, with 8 pixels of a row per iteration
+    int x, y;
+    __m256i src0, src1, dst0, dst1, ymult0_mm, ymult1_mm;
+    __m128i src, src_next, dst;
+    int dstdiff = dstpitch - (width * 4);
+
+    int during_8_width = width / 8;
+    int post_8_width = width % 8;
+
+    for (y = 0; y < dstheight; y++) {
+        int yidx0 = y * (srcheight - 1) / dstheight;
+        Uint8 *srcrow0 = srcpix + yidx0 * srcpitch;
+        Uint8 *srcrow1 = srcrow0 + srcpitch;
+        int ymult1 = 0x0100 * ((y * (srcheight - 1)) % dstheight) / dstheight;
+        int ymult0 = 0x0100 - ymult1;
+
+        ymult0_mm = _mm256_set1_epi16(ymult0);
+        ymult1_mm = _mm256_set1_epi16(ymult1);
+
+        for (x = 0; x < during_8_width; x++) {
+            src0 = _mm256_cvtepu8_epi16(
+                _mm_loadu_si128((const __m128i *)srcrow0));
+            src1 = _mm256_cvtepu8_epi16(
+                _mm_loadu_si128((const __m128i *)srcrow1));
+            dst0 = _mm256_srli_epi16(
+                _mm256_add_epi16(_mm256_mullo_epi16(src0, ymult0_mm),
+                                 _mm256_mullo_epi16(src1, ymult1_mm)),
+                8);
+
+            src0 = _mm256_cvtepu8_epi16(
+                _mm_loadu_si128((const __m128i *)(srcrow0 + 16)));
+            src1 = _mm256_cvtepu8_epi16(
+                _mm_loadu_si128((const __m128i *)(srcrow1 + 16)));
+            dst1 = _mm256_srli_epi16(
+                _mm256_add_epi16(_mm256_mullo_epi16(src0, ymult0_mm),
+                                 _mm256_mullo_epi16(src1, ymult1_mm)),
+                8);
+
+            // Pack down and store 8 destination pixels
+            dst0 = _mm256_permute4x64_epi64(_mm256_packus_epi16(dst0, dst1),
+                                            0xD8);
+            _mm256_storeu_si256((__m256i *)dstpix, dst0);
+
+            srcrow0 += 32;  // 32 bytes (8 pixels)
+            srcrow1 += 32;
+            dstpix += 32;
+        }
+        for (x = 0; x < post_8_width; x++) {
+            src = _mm_unpacklo_epi8(_pg_loadu_si32_avx2(srcrow0),
+                                    _mm_setzero_si128());
+            src_next = _mm_unpacklo_epi8(_pg_loadu_si32_avx2(srcrow1),
+                                         _mm_setzero_si128());
+
+            dst = _mm_add_epi16(
+                _mm_mullo_epi16(src, _mm256_castsi256_si128(ymult0_mm)),
+                _mm_mullo_epi16(src_next, _mm256_castsi256_si128(ymult1_mm)));
+            dst = _mm_srli_epi16(dst, 8);
+            dst = _mm_packus_epi16(dst, _mm_setzero_si128());
+            _pg_storeu_si32_avx2(dstpix, dst);
+
+            srcrow0 += 4;  // 4 bytes (1 pixel)
+            srcrow1 += 4;
+            dstpix += 4;
+        }
+        dstpix += dstdiff;
+    }
+}
+
+void
+accumulator_add_avx2(Uint32 *sums, const Uint8 *src, int n)
+{
+    // Widens 32 bytes at a time to 32 bit lanes and adds them to the sums
+    __m256i sum;
+    int i, j;
+
+    for (i = 0; i + 32 <= n; i += 32) {
+        for (j = i; j < i + 32; j += 8) {
+            sum = _mm256_add_epi32(
+                _mm256_loadu_si256((const __m256i *)(sums + j)),
+                _mm256_cvtepu8_epi32(
+                    _mm_loadl_epi64((const __m128i *)(src + j))));
+            _mm256_storeu_si256((__m256i *)(sums + j), sum);
+        }
+    }
+    for (; i < n; i++) {
+        sums[i] += src[i];
+    }
+}
+
+int
+threshold_row_avx2(const Uint32 *src, const Uint32 *search, int n,
+                   Uint32 search_color, Uint32 threshold, Uint8 *match)
+{
+    // Same as threshold_row_sse2(), 8 pixels at a time
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i thr = _mm256_set1_epi32((int)threshold);
+    __m256i ref = _mm256_set1_epi32((int)search_color);
+    __m256i count = zero;
+    __m256i pix, diff, in;
+    Uint32 counts[8];
+    int i, k, total = 0;
+
+    for (i = 0; i + 8 <= n; i += 8) {
+        pix = _mm256_loadu_si256((const __m256i *)(src + i));
+        if (search) {
+            ref = _mm256_loadu_si256((const __m256i *)(search + i));
+        }
+        diff = _mm256_or_si256(_mm256_subs_epu8(pix, ref),
+                               _mm256_subs_epu8(ref, pix));
+        in = _mm256_cmpeq_epi32(_mm256_subs_epu8(diff, thr), zero);
+        count = _mm256_sub_epi32(count, in);
+        if (match) {
+            // the packs work per 128 bit lane, 4 match bytes in each
+            in = _mm256_packs_epi32(in, in);
+            in = _mm256_packs_epi16(in, in);
+            _pg_storeu_si32_avx2(match + i, _mm256_castsi256_si128(in));
+            _pg_storeu_si32_avx2(match + i + 4,
+                                 _mm256_extracti128_si256(in, 1));
+        }
+    }
+    _mm256_storeu_si256((__m256i *)counts, count);
+    for (k = 0; k < 8; k++) {
+        total += (int)counts[k];
+    }
+
+    return total + threshold_row(src + i, search ? search + i : NULL, n - i,
+                                 search_color, threshold,
+                                 match ? match + i : NULL);
+}
+
+void
+average_color_row_avx2(const Uint8 *row, int n, int alpha_byte, Uint64 *sums)
+{
+    // Same as average_color_row_sse2(), 8 pixels at a time. Both 128 bit
+    // lanes of the sums hold the 4 bytes, they are added when flushing.
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i low_byte = _mm256_set1_epi32(0xFF);
+    __m256i amask = zero, aone = zero;
+    __m128i ashift = _mm_setzero_si128();
+    __m256i acc, pix, lo, hi, a, w;
+    Uint32 lanes[8];
+    int i = 0, end, k;
+
+    if (alpha_byte >= 0) {
+        amask = _mm256_set1_epi32((int)(0xFFu << (alpha_byte * 8)));
+        amask = _mm256_unpacklo_epi8(amask, amask);
+        aone = _mm256_and_si256(amask, _mm256_set1_epi16(1));
+        ashift = _mm_cvtsi32_si128(alpha_byte * 8);
+    }
+
+    while (i + 8 <= n) {
+        end = n - i > 4096 ? i + 4096 : i + ((n - i) & ~7);
+        acc = zero;
+        for (; i < end; i += 8) {
+            pix = _mm256_loadu_si256((const __m256i *)(row + i * 4));
+            lo = _mm256_unpacklo_epi8(pix, zero);
+            hi = _mm256_unpackhi_epi8(pix, zero);
+            if (alpha_byte >= 0) {
+                a = _mm256_and_si256(_mm256_srl_epi32(pix, ashift), low_byte);
+                a = _mm256_or_si256(a, _mm256_slli_epi32(a, 16));
+                w = _mm256_andnot_si256(amask, _mm256_unpacklo_epi32(a, a));
+                lo = _mm256_mullo_epi16(lo, _mm256_or_si256(w, aone));
+                w = _mm256_andnot_si256(amask, _mm256_unpackhi_epi32(a, a));
+                hi = _mm256_mullo_epi16(hi, _mm256_or_si256(w, aone));
+            }
+            acc = _mm256_add_epi32(acc, _mm256_unpacklo_epi16(lo, zero));
+            acc = _mm256_add_epi32(acc, _mm256_unpackhi_epi16(lo, zero));
+            acc = _mm256_add_epi32(acc, _mm256_unpacklo_epi16(hi, zero));
+            acc = _mm256_add_epi32(acc, _mm256_unpackhi_epi16(hi, zero));
+        }
+        _mm256_storeu_si256((__m256i *)lanes, acc);
+        for (k = 0; k < 4; k++) {
+            sums[k] += (Uint64)lanes[k] + lanes[k + 4];
+        }
+    }
+
+    average_color_row(row + i * 4, n - i, alpha_byte, sums);
+}
+
+#define _PG_SELECT_PS(mask, a, b) _mm256_blendv_ps((b), (a), (mask))
+#define _PG_CMPLT(a, b) _mm256_cmp_ps((a), (b), _CMP_LT_OQ)
+#define _PG_CMPGT(a, b) _mm256_cmp_ps((a), (b), _CMP_GT_OQ)
+#define _PG_CMPEQ(a, b) _mm256_cmp_ps((a), (b), _CMP_EQ_OQ)
+
+/* hue_to_rgb() of transform.c */
+static PG_FORCEINLINE __m256
+_hue_to_rgb_avx2(__m256 p, __m256 q, __m256 t)
+{
+    const __m256 zero = _mm256_setzero_ps();
+    const __m256 one = _mm256_set1_ps(1.0f);
+    const __m256 six = _mm256_set1_ps(6.0f);
+    const __m256 two_thirds = _mm256_set1_ps(2 / 3.0f);
+    __m256 qp = _mm256_sub_ps(q, p);
+    __m256 res;
+
+    t = _mm256_add_ps(t, _mm256_and_ps(_PG_CMPLT(t, zero), one));
+    t = _mm256_sub_ps(t, _mm256_and_ps(_PG_CMPGT(t, one), one));
+
+    res = _PG_SELECT_PS(
+        _PG_CMPLT(t, two_thirds),
+        _mm256_add_ps(
+            p, _mm256_mul_ps(_mm256_mul_ps(qp, _mm256_sub_ps(two_thirds, t)),
+                             six)),
+        p);
+    res = _PG_SELECT_PS(_PG_CMPLT(t, _mm256_set1_ps(1 / 2.0f)), q, res);
+    res = _PG_SELECT_PS(
+        _PG_CMPLT(t, _mm256_set1_ps(1 / 6.0f)),
+        _mm256_add_ps(p, _mm256_mul_ps(_mm256_mul_ps(qp, six), t)), res);
+    return res;
+}
+
+/* modify_hsl() of transform.c for 8 pixels */
+static PG_FORCEINLINE __m256i
+_modify_hsl_8_avx2(__m256i pix, __m256i old, __m128i rshift, __m128i gshift,
+                   __m128i bshift, __m256i amask, __m256i keep, float h,
+                   float s, float l)
+{
+    const __m256i low_byte = _mm256_set1_epi32(0xFF);
+    const __m256 zero = _mm256_setzero_ps();
+    const __m256 one = _mm256_set1_ps(1.0f);
+    const __m256 half = _mm256_set1_ps(0.5f);
+    const __m256 two = _mm256_set1_ps(2.0f);
+    const __m256 c255 = _mm256_set1_ps(255.0f);
+    __m256 r, g, b, mn, mx, delta, hue, sat, lum, p, q, gray;
+    __m256i out;
+
+    r = _mm256_div_ps(_mm256_cvtepi32_ps(_mm256_and_si256(
+                          _mm256_srl_epi32(pix, rshift), low_byte)),
+                      c255);
+    g = _mm256_div_ps(_mm256_cvtepi32_ps(_mm256_and_si256(
+                          _mm256_srl_epi32(pix, gshift), low_byte)),
+                      c255);
+    b = _mm256_div_ps(_mm256_cvtepi32_ps(_mm256_and_si256(
+                          _mm256_srl_epi32(pix, bshift), low_byte)),
+                      c255);
+
+    // RGB_to_HSL()
+    mn = _mm256_min_ps(_mm256_min_ps(r, g), b);
+    mx = _mm256_max_ps(_mm256_max_ps(r, g), b);
+    delta = _mm256_sub_ps(mx, mn);
+    lum = _mm256_mul_ps(_mm256_add_ps(mx, mn), half);
+    sat = _PG_SELECT_PS(
+        _PG_CMPGT(lum, half),
+        _mm256_div_ps(delta, _mm256_sub_ps(_mm256_sub_ps(two, mx), mn)),
+        _mm256_div_ps(delta, _mm256_add_ps(mx, mn)));
+    hue = _PG_SELECT_PS(
+        _PG_CMPEQ(mx, g),
+        _mm256_add_ps(_mm256_div_ps(_mm256_sub_ps(b, r), delta), two),
+        _mm256_add_ps(_mm256_div_ps(_mm256_sub_ps(r, g), delta),
+                      _mm256_set1_ps(4.0f)));
+    hue = _PG_SELECT_PS(
+        _PG_CMPEQ(mx, r),
+        _mm256_add_ps(
+            _mm256_div_ps(_mm256_sub_ps(g, b), delta),
+            _mm256_and_ps(_PG_CMPLT(g, b), _mm256_set1_ps(6.0f))),
+        hue);
+    hue = _mm256_div_ps(hue, _mm256_set1_ps(6.0f));
+    gray = _PG_CMPEQ(delta, zero);
+    hue = _mm256_andnot_ps(gray, hue);
+    sat = _mm256_andnot_ps(gray, sat);
+
+    if (h) {
+        hue = _mm256_add_ps(hue, _mm256_set1_ps(h));
+        hue = _PG_SELECT_PS(_PG_CMPGT(hue, one), _mm256_sub_ps(hue, one),
+                            _PG_SELECT_PS(_PG_CMPLT(hue, zero),
+                                          _mm256_add_ps(hue, one), hue));
+    }
+    if (s) {
+        sat = _mm256_mul_ps(sat, _mm256_set1_ps(1 + s));
+        sat = _PG_SELECT_PS(_PG_CMPGT(sat, one), one,
+                            _mm256_andnot_ps(_PG_CMPLT(sat, zero), sat));
+    }
+    if (l) {
+        lum = l < 0 ? _mm256_mul_ps(lum, _mm256_set1_ps(1 + l))
+                    : _mm256_add_ps(_mm256_mul_ps(lum, _mm256_set1_ps(1 - l)),
+                                    _mm256_set1_ps(l));
+        lum = _PG_SELECT_PS(_PG_CMPGT(lum, one), one,
+                            _mm256_andnot_ps(_PG_CMPLT(lum, zero), lum));
+    }
+
+    // HSL_to_RGB()
+    gray = _PG_CMPEQ(sat, zero);
+    q = _PG_SELECT_PS(
+        _PG_CMPLT(lum, half), _mm256_mul_ps(lum, _mm256_add_ps(one, sat)),
+        _mm256_sub_ps(_mm256_add_ps(lum, sat), _mm256_mul_ps(lum, sat)));
+    p = _mm256_sub_ps(_mm256_mul_ps(two, lum), q);
+    r = _hue_to_rgb_avx2(p, q, _mm256_add_ps(hue, _mm256_set1_ps(1 / 3.0f)));
+    g = _hue_to_rgb_avx2(p, q, hue);
+    b = _hue_to_rgb_avx2(p, q, _mm256_sub_ps(hue, _mm256_set1_ps(1 / 3.0f)));
+    r = _PG_SELECT_PS(gray, lum, r);
+    g = _PG_SELECT_PS(gray, lum, g);
+    b = _PG_SELECT_PS(gray, lum, b);
+
+    out = _mm256_or_si256(_mm256_and_si256(pix, amask),
+                          _mm256_and_si256(old, keep));
+    out = _mm256_or_si256(
+        out,
+        _mm256_sll_epi32(_mm256_cvttps_epi32(_mm256_mul_ps(r, c255)), rshift));
+    out = _mm256_or_si256(
+        out,
+        _mm256_sll_epi32(_mm256_cvttps_epi32(_mm256_mul_ps(g, c255)), gshift));
+    out = _mm256_or_si256(
+        out,
+        _mm256_sll_epi32(_mm256_cvttps_epi32(_mm256_mul_ps(b, c255)), bshift));
+    return out;
+}
+
+void
+modify_hsl_row_avx2(const Uint32 *src, Uint32 *dst, int n, int rshift,
+                    int gshift, int bshift, Uint32 amask, float h, float s,
+                    float l)
+{
+    // Same as modify_hsl_row_sse2(), 8 pixels at a time
+    const __m128i mm_rshift = _mm_cvtsi32_si128(rshift);
+    const __m128i mm_gshift = _mm_cvtsi32_si128(gshift);
+    const __m128i mm_bshift = _mm_cvtsi32_si128(bshift);
+    const __m256i mm_amask = _mm256_set1_epi32((int)amask);
+    const __m256i keep = _mm256_set1_epi32(
+        (int)~((0xFFu << rshift) | (0xFFu << gshift) | (0xFFu << bshift) |
+               amask));
+    Uint32 srcbuf[8] = {0}, dstbuf[8] = {0};
+    __m256i out;
+    int i;
+
+    for (i = 0; i + 8 <= n; i += 8) {
+        out = _modify_hsl_8_avx2(
+            _mm256_loadu_si256((const __m256i *)(src + i)),
+            _mm256_loadu_si256((const __m256i *)(dst + i)), mm_rshift,
+            mm_gshift, mm_bshift, mm_amask, keep, h, s, l);
+        _mm256_storeu_si256((__m256i *)(dst + i), out);
+    }
+    if (i < n) {
+        memcpy(srcbuf, src + i, (n - i) * sizeof(Uint32));
+        memcpy(dstbuf, dst + i, (n - i) * sizeof(Uint32));
+        out = _modify_hsl_8_avx2(
+            _mm256_loadu_si256((const __m256i *)srcbuf),
+            _mm256_loadu_si256((const __m256i *)dstbuf), mm_rshift,
+            mm_gshift, mm_bshift, mm_amask, keep, h, s, l);
+        _mm256_storeu_si256((__m256i *)dstbuf, out);
+        memcpy(dst + i, dstbuf, (n - i) * sizeof(Uint32));
+    }
+}
+
+void
+color_matrix_row_avx2(const Uint32 *src, Uint32 *dst, int n,
+                      const int *shifts, Uint32 amask, const float *matrix)
+{
+    // Same as color_matrix_row_sse2(), 8 pixels at a time
+    const __m256i low_byte = _mm256_set1_epi32(0xFF);
+    const __m256 zero = _mm256_setzero_ps();
+    const __m256 c255 = _mm256_set1_ps(255.0f);
+    const __m256 half = _mm256_set1_ps(0.5f);
+    const int nout = amask ? 4 : 3;
+    __m128i mm_shifts[4];
+    __m256i keep, pix, out;
+    __m256 m[20], in[4], v;
+    int i, c;
+
+    for (c = 0; c < 20; c++) {
+        m[c] = _mm256_set1_ps(matrix[c]);
+    }
+    for (c = 0; c < 4; c++) {
+        mm_shifts[c] = _mm_cvtsi32_si128(shifts[c]);
+    }
+    keep = _mm256_set1_epi32((int)~((0xFFu << shifts[0]) |
+                                    (0xFFu << shifts[1]) |
+                                    (0xFFu << shifts[2]) | amask));
+    in[3] = c255;
+
+    for (i = 0; i + 8 <= n; i += 8) {
+        pix = _mm256_loadu_si256((const __m256i *)(src + i));
+        for (c = 0; c < nout; c++) {
+            in[c] = _mm256_cvtepi32_ps(_mm256_and_si256(
+                _mm256_srl_epi32(pix, mm_shifts[c]), low_byte));
+        }
+        out = _mm256_and_si256(pix, keep);
+        for (c = 0; c < nout; c++) {
+            v = _mm256_mul_ps(m[c * 5], in[0]);
+            v = _mm256_add_ps(v, _mm256_mul_ps(m[c * 5 + 1], in[1]));
+            v = _mm256_add_ps(v, _mm256_mul_ps(m[c * 5 + 2], in[2]));
+            v = _mm256_add_ps(v, _mm256_mul_ps(m[c * 5 + 3], in[3]));
+            v = _mm256_add_ps(v, m[c * 5 + 4]);
+            v = _mm256_min_ps(_mm256_max_ps(v, zero), c255);
+            out = _mm256_or_si256(
+                out,
+                _mm256_sll_epi32(_mm256_cvttps_epi32(_mm256_add_ps(v, half)),
+                                 mm_shifts[c]));
+        }
+        _mm256_storeu_si256((__m256i *)(dst + i), out);
+    }
+
+    color_matrix_row(src + i, dst + i, n - i, shifts, amask, matrix);
+}
+
+#undef _PG_SELECT_PS
+#undef _PG_CMPLT
+#undef _PG_CMPGT
+#undef _PG_CMPEQ
+
+void
+rotate_nearest_row_avx2(const Uint8 *srcpix, int srcpitch, Uint32 *dstpix,
+                        int width, int dx, int dy, int icos, int isin,
+                        int xmaxval, int ymaxval, Uint32 bgcolor)
+{
+    int x = 0;
+    __m256i mm256_dx = _mm256_add_epi32(
+        _mm256_set1_epi32(dx),
+        _mm256_mullo_epi32(_mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7),
+                           _mm256_set1_epi32(icos)));
+    __m256i mm256_dy = _mm256_add_epi32(
+        _mm256_set1_epi32(dy),
+        _mm256_mullo_epi32(_mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7),
+                           _mm256_set1_epi32(isin)));
+    __m256i mm256_dx_step = _mm256_set1_epi32(8 * icos);
+    __m256i mm256_dy_step = _mm256_set1_epi32(8 * isin);
+    __m256i mm256_xmax = _mm256_set1_epi32(xmaxval);
+    __m256i mm256_ymax = _mm256_set1_epi32(ymaxval);
+    __m256i mm256_pitch = _mm256_set1_epi32(srcpitch);
+    __m256i mm256_bg = _mm256_set1_epi32(bgcolor);
+    __m256i mm256_zero = _mm256_setzero_si256();
+    __m256i mm256_out, mm256_offsets;
+
+    for (; x + 8 <= width; x += 8) {
+        mm256_out = _mm256_or_si256(
+            _mm256_or_si256(_mm256_cmpgt_epi32(mm256_zero, mm256_dx),
+                            _mm256_cmpgt_epi32(mm256_zero, mm256_dy)),
+            _mm256_or_si256(_mm256_cmpgt_epi32(mm256_dx, mm256_xmax),
+                            _mm256_cmpgt_epi32(mm256_dy, mm256_ymax)));
+        mm256_offsets = _mm256_add_epi32(
+            _mm256_mullo_epi32(_mm256_srai_epi32(mm256_dy, 16), mm256_pitch),
+            _mm256_slli_epi32(_mm256_srai_epi32(mm256_dx, 16), 2));
+
+        /* only the lanes inside of the source are loaded, the others keep
+         * the background color */
+        _mm256_storeu_si256(
+            (__m256i *)(dstpix + x),
+            _mm256_mask_i32gather_epi32(
+                mm256_bg, (const int *)srcpix, mm256_offsets,
+                _mm256_xor_si256(mm256_out, _mm256_set1_epi32(-1)), 1));
+
+        mm256_dx = _mm256_add_epi32(mm256_dx, mm256_dx_step);
+        mm256_dy = _mm256_add_epi32(mm256_dy, mm256_dy_step);
+    }
+
+    dx += x * icos;
+    dy += x * isin;
+    for (; x < width; x++) {
+        if (dx < 0 || dy < 0 || dx > xmaxval || dy > ymaxval)
+            dstpix[x] = bgcolor;
+        else
+            dstpix[x] = *(const Uint32 *)(srcpix + ((dy >> 16) * srcpitch) +
+                                          ((long long)dx >> 16 << 2));
+        dx += icos;
+        dy += isin;
+    }
+}
+
+/* a + ((b - a) * e >> 16) for unsigned 16 bit a, b and e, see
+ * _pg_lerp_epu16 in simd_transform_sse2.c */
+static inline __m256i
+_pg_lerp_epu16_avx2(__m256i a, __m256i b, __m256i e)
+{
+    __m256i mm256_sign = _mm256_set1_epi16((short)0x8000);
+    __m256i mm256_borrow = _mm256_cmpgt_epi16(
+        _mm256_xor_si256(_mm256_mullo_epi16(a, e), mm256_sign),
+        _mm256_xor_si256(_mm256_mullo_epi16(b, e), mm256_sign));
+
+    return _mm256_add_epi16(
+        _mm256_sub_epi16(_mm256_add_epi16(a, _mm256_mulhi_epu16(b, e)),
+                         _mm256_mulhi_epu16(a, e)),
+        mm256_borrow);
+}
+
+/* The unpacks work within 128 bit lanes, so _LO gives the weights of pixels
+ * 0, 1, 4 and 5 and _HI the ones of pixels 2, 3, 6 and 7, matching
+ * _mm256_unpacklo/hi_epi8 of the pixels. */
+#define _PG_WEIGHTS_LO_AVX2(w)                    \
+    _mm256_or_si256(_mm256_unpacklo_epi32(w, w), \
+                    _mm256_slli_epi32(_mm256_unpacklo_epi32(w, w), 16))
+#define _PG_WEIGHTS_HI_AVX2(w)                    \
+    _mm256_or_si256(_mm256_unpackhi_epi32(w, w), \
+                    _mm256_slli_epi32(_mm256_unpackhi_epi32(w, w), 16))
+
+void
+rotozoom_smooth_run_avx2(const Uint8 *srcpix, int srcpitch, Uint32 *dstpix,
+                         int width, int sdx, int sdy, int icos, int isin)
+{
+    int x = 0;
+    __m256i mm256_sdx = _mm256_add_epi32(
+        _mm256_set1_epi32(sdx),
+        _mm256_mullo_epi32(_mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7),
+                           _mm256_set1_epi32(icos)));
+    __m256i mm256_sdy = _mm256_add_epi32(
+        _mm256_set1_epi32(sdy),
+        _mm256_mullo_epi32(_mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7),
+                           _mm256_set1_epi32(isin)));
+    __m256i mm256_sdx_step = _mm256_set1_epi32(8 * icos);
+    __m256i mm256_sdy_step = _mm256_set1_epi32(8 * isin);
+    __m256i mm256_pitch = _mm256_set1_epi32(srcpitch);
+    __m256i mm256_mask = _mm256_set1_epi32(0xffff);
+    __m256i mm256_zero = _mm256_setzero_si256();
+    __m256i mm256_offsets, mm256_c00, mm256_c01, mm256_c10, mm256_c11;
+    __m256i mm256_ex, mm256_ey, mm256_lo, mm256_hi;
+
+    for (; x + 8 <= width; x += 8) {
+        mm256_offsets = _mm256_add_epi32(
+            _mm256_mullo_epi32(_mm256_srai_epi32(mm256_sdy, 16), mm256_pitch),
+            _mm256_slli_epi32(_mm256_srai_epi32(mm256_sdx, 16), 2));
+        mm256_c00 = _mm256_i32gather_epi32((const int *)srcpix,
+                                           mm256_offsets, 1);
+        mm256_c01 = _mm256_i32gather_epi32((const int *)(srcpix + 4),
+                                           mm256_offsets, 1);
+        mm256_c10 = _mm256_i32gather_epi32(
+            (const int *)(srcpix + srcpitch), mm256_offsets, 1);
+        mm256_c11 = _mm256_i32gather_epi32(
+            (const int *)(srcpix + srcpitch + 4), mm256_offsets, 1);
+        mm256_ex = _mm256_and_si256(mm256_sdx, mm256_mask);
+        mm256_ey = _mm256_and_si256(mm256_sdy, mm256_mask);
+
+        mm256_lo = _pg_lerp_epu16_avx2(
+            _pg_lerp_epu16_avx2(_mm256_unpacklo_epi8(mm256_c00, mm256_zero),
+                                _mm256_unpacklo_epi8(mm256_c01, mm256_zero),
+                                _PG_WEIGHTS_LO_AVX2(mm256_ex)),
+            _pg_lerp_epu16_avx2(_mm256_unpacklo_epi8(mm256_c10, mm256_zero),
+                                _mm256_unpacklo_epi8(mm256_c11, mm256_zero),
+                                _PG_WEIGHTS_LO_AVX2(mm256_ex)),
+            _PG_WEIGHTS_LO_AVX2(mm256_ey));
+        mm256_hi = _pg_lerp_epu16_avx2(
+            _pg_lerp_epu16_avx2(_mm256_unpackhi_epi8(mm256_c00, mm256_zero),
+                                _mm256_unpackhi_epi8(mm256_c01, mm256_zero),
+                                _PG_WEIGHTS_HI_AVX2(mm256_ex)),
+            _pg_lerp_epu16_avx2(_mm256_unpackhi_epi8(mm256_c10, mm256_zero),
+                                _mm256_unpackhi_epi8(mm256_c11, mm256_zero),
+                                _PG_WEIGHTS_HI_AVX2(mm256_ex)),
+            _PG_WEIGHTS_HI_AVX2(mm256_ey));
+
+        _mm256_storeu_si256((__m256i *)(dstpix + x),
+                            _mm256_packus_epi16(mm256_lo, mm256_hi));
+
+        mm256_sdx = _mm256_add_epi32(mm256_sdx, mm256_sdx_step);
+        mm256_sdy = _mm256_add_epi32(mm256_sdy, mm256_sdy_step);
+    }
+
+    if (x < width) {
+        rotozoom_smooth_run(srcpix, srcpitch, dstpix + x, width - x,
+                            sdx + x * icos, sdy + x * isin, icos, isin);
+    }
+}
+
+#undef _PG_WEIGHTS_LO_AVX2
+#undef _PG_WEIGHTS_HI_AVX2
+
+#define _PG_SELECT_SI256(mask, a, b) _mm256_blendv_epi8((b), (a), (mask))
+
+void
+scale2x_row_avx2(const Uint32 *prev, const Uint32 *cur, const Uint32 *next,
+                 Uint32 *dst0, Uint32 *dst1, int n)
+{
+    // Same as scale2x_row_sse2(), 8 pixels at a time. The unpacks work per
+    // 128 bit lane, so the lane halves are put back in order after.
+    __m256i B, D, E, F, H, same, e0, e1, e2, e3, lo, hi;
+    int x;
+
+    for (x = 0; x + 8 <= n; x += 8) {
+        B = _mm256_loadu_si256((const __m256i *)(prev + x));
+        D = _mm256_loadu_si256((const __m256i *)(cur + x - 1));
+        E = _mm256_loadu_si256((const __m256i *)(cur + x));
+        F = _mm256_loadu_si256((const __m256i *)(cur + x + 1));
+        H = _mm256_loadu_si256((const __m256i *)(next + x));
+
+        same = _mm256_or_si256(_mm256_cmpeq_epi32(B, H),
+                               _mm256_cmpeq_epi32(D, F));
+        e0 = _PG_SELECT_SI256(
+            _mm256_andnot_si256(same, _mm256_cmpeq_epi32(D, B)), D, E);
+        e1 = _PG_SELECT_SI256(
+            _mm256_andnot_si256(same, _mm256_cmpeq_epi32(B, F)), F, E);
+        e2 = _PG_SELECT_SI256(
+            _mm256_andnot_si256(same, _mm256_cmpeq_epi32(D, H)), D, E);
+        e3 = _PG_SELECT_SI256(
+            _mm256_andnot_si256(same, _mm256_cmpeq_epi32(H, F)), F, E);
+
+        lo = _mm256_unpacklo_epi32(e0, e1);
+        hi = _mm256_unpackhi_epi32(e0, e1);
+        _mm256_storeu_si256((__m256i *)(dst0 + 2 * x),
+                            _mm256_permute2x128_si256(lo, hi, 0x20));
+        _mm256_storeu_si256((__m256i *)(dst0 + 2 * x + 8),
+                            _mm256_permute2x128_si256(lo, hi, 0x31));
+        lo = _mm256_unpacklo_epi32(e2, e3);
+        hi = _mm256_unpackhi_epi32(e2, e3);
+        _mm256_storeu_si256((__m256i *)(dst1 + 2 * x),
+                            _mm256_permute2x128_si256(lo, hi, 0x20));
+        _mm256_storeu_si256((__m256i *)(dst1 + 2 * x + 8),
+                            _mm256_permute2x128_si256(lo, hi, 0x31));
+    }
+
+    scale2x_row(prev + x, cur + x, next + x, dst0 + 2 * x, dst1 + 2 * x,
+                n - x);
+}
+
+/* Stores a0 b0 c0 a1 b1 c1 ... a7 b7 c7 to dst. Output pixel i comes from
+ * pixel i / 3 of a, b or c, so each store permutes all three the same way
+ * and blends them together. */
+static PG_FORCEINLINE void
+_pg_store_interleave3_avx2(Uint32 *dst, __m256i a, __m256i b, __m256i c)
+{
+    const __m256i idx0 = _mm256_setr_epi32(0, 0, 0, 1, 1, 1, 2, 2);
+    const __m256i idx1 = _mm256_setr_epi32(2, 3, 3, 3, 4, 4, 4, 5);
+    const __m256i idx2 = _mm256_setr_epi32(5, 5, 6, 6, 6, 7, 7, 7);
+
+    _mm256_storeu_si256(
+        (__m256i *)dst,
+        _mm256_blend_epi32(
+            _mm256_blend_epi32(_mm256_permutevar8x32_epi32(a, idx0),
+                               _mm256_permutevar8x32_epi32(b, idx0), 0x92),
+            _mm256_permutevar8x32_epi32(c, idx0), 0x24));
+    _mm256_storeu_si256(
+        (__m256i *)(dst + 8),
+        _mm256_blend_epi32(
+            _mm256_blend_epi32(_mm256_permutevar8x32_epi32(a, idx1),
+                               _mm256_permutevar8x32_epi32(b, idx1), 0x24),
+            _mm256_permutevar8x32_epi32(c, idx1), 0x49));
+    _mm256_storeu_si256(
+        (__m256i *)(dst + 16),
+        _mm256_blend_epi32(
+            _mm256_blend_epi32(_mm256_permutevar8x32_epi32(a, idx2),
+                               _mm256_permutevar8x32_epi32(b, idx2), 0x49),
+            _mm256_permutevar8x32_epi32(c, idx2), 0x92));
+}
+
+void
+scale3x_row_avx2(const Uint32 *prev, const Uint32 *cur, const Uint32 *next,
+                 Uint32 *dst0, Uint32 *dst1, Uint32 *dst2, int n)
+{
+    // Same as scale3x_row_sse2(), 8 pixels at a time
+    __m256i A, B, C, D, E, F, G, H, I, same, db, bf, dh, hf, m;
+    __m256i e0, e1, e2, e3, e5, e6, e7, e8;
+    int x;
+
+    for (x = 0; x + 8 <= n; x += 8) {
+        A = _mm256_loadu_si256((const __m256i *)(prev + x - 1));
+        B = _mm256_loadu_si256((const __m256i *)(prev + x));
+        C = _mm256_loadu_si256((const __m256i *)(prev + x + 1));
+        D = _mm256_loadu_si256((const __m256i *)(cur + x - 1));
+        E = _mm256_loadu_si256((const __m256i *)(cur + x));
+        F = _mm256_loadu_si256((const __m256i *)(cur + x + 1));
+        G = _mm256_loadu_si256((const __m256i *)(next + x - 1));
+        H = _mm256_loadu_si256((const __m256i *)(next + x));
+        I = _mm256_loadu_si256((const __m256i *)(next + x + 1));
+
+        same = _mm256_or_si256(_mm256_cmpeq_epi32(B, H),
+                               _mm256_cmpeq_epi32(D, F));
+        db = _mm256_andnot_si256(same, _mm256_cmpeq_epi32(D, B));
+        bf = _mm256_andnot_si256(same, _mm256_cmpeq_epi32(B, F));
+        dh = _mm256_andnot_si256(same, _mm256_cmpeq_epi32(D, H));
+        hf = _mm256_andnot_si256(same, _mm256_cmpeq_epi32(H, F));
+
+        e0 = _PG_SELECT_SI256(db, D, E);
+        m = _mm256_or_si256(
+            _mm256_andnot_si256(_mm256_cmpeq_epi32(E, C), db),
+            _mm256_andnot_si256(_mm256_cmpeq_epi32(E, A), bf));
+        e1 = _PG_SELECT_SI256(m, B, E);
+        e2 = _PG_SELECT_SI256(bf, F, E);
+        m = _mm256_or_si256(
+            _mm256_andnot_si256(_mm256_cmpeq_epi32(E, G), db),
+            _mm256_andnot_si256(_mm256_cmpeq_epi32(E, A), dh));
+        e3 = _PG_SELECT_SI256(m, D, E);
+        m = _mm256_or_si256(
+            _mm256_andnot_si256(_mm256_cmpeq_epi32(E, I), bf),
+            _mm256_andnot_si256(_mm256_cmpeq_epi32(E, C), hf));
+        e5 = _PG_SELECT_SI256(m, F, E);
+        e6 = _PG_SELECT_SI256(dh, D, E);
+        m = _mm256_or_si256(
+            _mm256_andnot_si256(_mm256_cmpeq_epi32(E, I), dh),
+            _mm256_andnot_si256(_mm256_cmpeq_epi32(E, G), hf));
+        e7 = _PG_SELECT_SI256(m, H, E);
+        e8 = _PG_SELECT_SI256(hf, F, E);
+
+        _pg_store_interleave3_avx2(dst0 + 3 * x, e0, e1, e2);
+        _pg_store_interleave3_avx2(dst1 + 3 * x, e3, E, e5);
+        _pg_store_interleave3_avx2(dst2 + 3 * x, e6, e7, e8);
+    }
+
+    scale3x_row(prev + x, cur + x, next + x, dst0 + 3 * x, dst1 + 3 * x,
+                dst2 + 3 * x, n - x);
+}
+
+#undef _PG_SELECT_SI256
+
+void
+transpose32_avx2(const Uint8 *src, int srcpitch, Uint8 *dst, int dstpitch,
+                 int w, int h)
+{
+    /* Same as transpose32_sse2(), with blocks of 8 x 8 pixels. The unpacks
+     * transpose the 4 x 4 quarters, the permutes put them in place. */
+    const Uint32 *s[8];
+    __m256i r[8], t[8];
+    Uint8 *dstcol;
+    int tx, ty, x, y, xend, yend, i;
+
+    for (ty = 0; ty < h; ty += PG_TRANSPOSE_TILE) {
+        yend = MIN(ty + PG_TRANSPOSE_TILE, h);
+        for (tx = 0; tx < w; tx += PG_TRANSPOSE_TILE) {
+            xend = MIN(tx + PG_TRANSPOSE_TILE, w);
+            for (y = ty; y + 8 <= yend; y += 8) {
+                for (i = 0; i < 8; i++) {
+                    s[i] = (const Uint32 *)(src + (Sint64)(y + i) * srcpitch);
+                }
+                for (x = tx; x + 8 <= xend; x += 8) {
+                    for (i = 0; i < 8; i++) {
+                        r[i] = _mm256_loadu_si256((const __m256i *)(s[i] + x));
+                    }
+                    for (i = 0; i < 8; i += 4) {
+                        t[i] = _mm256_unpacklo_epi32(r[i], r[i + 1]);
+                        t[i + 1] = _mm256_unpackhi_epi32(r[i], r[i + 1]);
+                        t[i + 2] = _mm256_unpacklo_epi32(r[i + 2], r[i + 3]);
+                        t[i + 3] = _mm256_unpackhi_epi32(r[i + 2], r[i + 3]);
+                        r[i] = _mm256_unpacklo_epi64(t[i], t[i + 2]);
+                        r[i + 1] = _mm256_unpackhi_epi64(t[i], t[i + 2]);
+                        r[i + 2] = _mm256_unpacklo_epi64(t[i + 1], t[i + 3]);
+                        r[i + 3] = _mm256_unpackhi_epi64(t[i + 1], t[i + 3]);
+                    }
+                    dstcol = dst + (Sint64)x * dstpitch + y * 4;
+                    for (i = 0; i < 4; i++) {
+                        _mm256_storeu_si256(
+                            (__m256i *)(dstcol + (Sint64)i * dstpitch),
+                            _mm256_permute2x128_si256(r[i], r[i + 4], 0x20));
+                        _mm256_storeu_si256(
+                            (__m256i *)(dstcol + (Sint64)(i + 4) * dstpitch),
+                            _mm256_permute2x128_si256(r[i], r[i + 4], 0x31));
+                    }
+                }
+                _pg_transpose32_rect(src, srcpitch, dst, dstpitch, x, xend,
+                                     y, y + 8);
+            }
+            _pg_transpose32_rect(src, srcpitch, dst, dstpitch, tx, xend, y,
+                                 yend);
+        }
+    }
+}
+
+void
+flip_row32_avx2(const Uint32 *src, Uint32 *dst, int n)
+{
+    /* Same as flip_row32_sse2(), 8 pixels from each end at a time */
+    const __m256i mm_reverse = _mm256_setr_epi32(7, 6, 5, 4, 3, 2, 1, 0);
+    __m256i left, right;
+    Uint32 tmp;
+    int i = 0, j = n - 8;
+
+    for (; i + 8 <= j; i += 8, j -= 8) {
+        left = _mm256_loadu_si256((const __m256i *)(src + i));
+        right = _mm256_loadu_si256((const __m256i *)(src + j));
+        _mm256_storeu_si256((__m256i *)(dst + i),
+                            _mm256_permutevar8x32_epi32(right, mm_reverse));
+        _mm256_storeu_si256((__m256i *)(dst + j),
+                            _mm256_permutevar8x32_epi32(left, mm_reverse));
+    }
+    for (j += 7; i <= j; i++, j--) {
+        tmp = src[i];
+        dst[i] = src[j];
+        dst[j] = tmp;
+    }
+}
+
+void
+lightmap_stamp_row_avx2(Uint16 *light, const Uint32 *src, int n,
+                        int intensity, int has_alpha, int max)
+{
+    /* Same as lightmap_stamp_row_sse2(), 4 pixels widened at a time */
+    const __m256i mm_intensity = _mm256_set1_epi16((short)intensity);
+    const __m256i mm_128 = _mm256_set1_epi16(128);
+    const __m256i mm_257 = _mm256_set1_epi16(257);
+    const __m256i mm_colors =
+        _mm256_set_epi16(0, -1, -1, -1, 0, -1, -1, -1, 0, -1, -1, -1, 0, -1,
+                         -1, -1);
+    __m256i pix, weight, cur;
+    int i;
+
+    for (i = 0; i + 4 <= n; i += 4) {
+        pix = _mm256_cvtepu8_epi16(
+            _mm_loadu_si128((const __m128i *)(src + i)));
+        weight = mm_intensity;
+        if (has_alpha) {
+            weight = _mm256_shufflelo_epi16(pix, _PG_SIMD_SHUFFLE(3, 3, 3, 3));
+            weight =
+                _mm256_shufflehi_epi16(weight, _PG_SIMD_SHUFFLE(3, 3, 3, 3));
+            weight = _mm256_mullo_epi16(weight, mm_intensity);
+            weight =
+                _mm256_mulhi_epu16(_mm256_add_epi16(weight, mm_128), mm_257);
+        }
+        pix = _mm256_mullo_epi16(pix, weight);
+        pix = _mm256_mulhi_epu16(_mm256_add_epi16(pix, mm_128), mm_257);
+        pix = _mm256_and_si256(pix, mm_colors);
+
+        cur = _mm256_loadu_si256((const __m256i *)(light + 4 * i));
+        cur = max ? _mm256_add_epi16(_mm256_subs_epu16(cur, pix), pix)
+                  : _mm256_adds_epu16(cur, pix);
+        _mm256_storeu_si256((__m256i *)(light + 4 * i), cur);
+    }
+    lightmap_stamp_row(light + 4 * i, src + i, n - i, intensity, has_alpha,
+                       max);
+}
+
+void
+lightmap_apply_row_avx2(Uint32 *dst, const Uint16 *light, int n)
+{
+    /* Same as lightmap_apply_row_sse2(), 8 pixels at a time. The 32 bit
+     * unpacks and packs stay within the 128 bit lanes, which keeps the
+     * pixels of each group of 4 in order, and the final pack interleaves
+     * both groups by pairs, which the permute undoes. */
+    const __m256i mm_255 = _mm256_set1_epi32(255);
+    __m256i pix, lit[2], l, lo, hi;
+    int i, k;
+
+    for (i = 0; i + 8 <= n; i += 8) {
+        for (k = 0; k < 2; k++) {
+            pix = _mm256_cvtepu8_epi16(
+                _mm_loadu_si128((const __m128i *)(dst + i + 4 * k)));
+            l = _mm256_loadu_si256(
+                (const __m256i *)(light + 4 * i + 16 * k));
+            lo = _mm256_mullo_epi16(pix, l);
+            hi = _mm256_mulhi_epu16(pix, l);
+            lit[k] = _mm256_packs_epi32(
+                _mm256_srli_epi32(
+                    _mm256_add_epi32(_mm256_unpacklo_epi16(lo, hi), mm_255),
+                    8),
+                _mm256_srli_epi32(
+                    _mm256_add_epi32(_mm256_unpackhi_epi16(lo, hi), mm_255),
+                    8));
+        }
+        _mm256_storeu_si256(
+            (__m256i *)(dst + i),
+            _mm256_permute4x64_epi64(_mm256_packus_epi16(lit[0], lit[1]),
+                                     _MM_SHUFFLE(3, 1, 2, 0)));
+    }
+    lightmap_apply_row(dst + i, light + 4 * i, n - i);
+}
 #else
 void
 grayscale_avx2(SDL_Surface *src, SDL_Surface *newsurf)
@@ -309,5 +1421,114 @@ invert_avx2(SDL_Surface *src, SDL_Surface *newsurf)
 {
     BAD_AVX2_FUNCTION_CALL;
 }
+void
+blur_accumulate_u8_avx2(float *acc, const Uint8 *src, int n, float weight)
+{
+    BAD_AVX2_FUNCTION_CALL;
+}
+void
+blur_accumulate_f32_avx2(float *acc, const float *src, int n, float weight)
+{
+    BAD_AVX2_FUNCTION_CALL;
+}
+void
+filter_shrink_Y_AVX2(Uint8 *srcpix, Uint8 *dstpix, int width, int srcpitch,
+                     int dstpitch, int srcheight, int dstheight)
+{
+    BAD_AVX2_FUNCTION_CALL;
+}
+void
+filter_expand_X_AVX2(Uint8 *srcpix, Uint8 *dstpix, int height, int srcpitch,
+                     int dstpitch, int srcwidth, int dstwidth)
+{
+    BAD_AVX2_FUNCTION_CALL;
+}
+void
+filter_expand_Y_AVX2(Uint8 *srcpix, Uint8 *dstpix, int width, int srcpitch,
+                     int dstpitch, int srcheight, int dstheight)
+{
+    BAD_AVX2_FUNCTION_CALL;
+}
+void
+accumulator_add_avx2(Uint32 *sums, const Uint8 *src, int n)
+{
+    BAD_AVX2_FUNCTION_CALL;
+}
+int
+threshold_row_avx2(const Uint32 *src, const Uint32 *search, int n,
+                   Uint32 search_color, Uint32 threshold, Uint8 *match)
+{
+    BAD_AVX2_FUNCTION_CALL;
+    return 0;
+}
+void
+average_color_row_avx2(const Uint8 *row, int n, int alpha_byte, Uint64 *sums)
+{
+    BAD_AVX2_FUNCTION_CALL;
+}
+void
+modify_hsl_row_avx2(const Uint32 *src, Uint32 *dst, int n, int rshift,
+                    int gshift, int bshift, Uint32 amask, float h, float s,
+                    float l)
+{
+    BAD_AVX2_FUNCTION_CALL;
+}
+void
+color_matrix_row_avx2(const Uint32 *src, Uint32 *dst, int n,
+                      const int *shifts, Uint32 amask, const float *matrix)
+{
+    BAD_AVX2_FUNCTION_CALL;
+}
+void
+rotate_nearest_row_avx2(const Uint8 *srcpix, int srcpitch, Uint32 *dstpix,
+                        int width, int dx, int dy, int icos, int isin,
+                        int xmaxval, int ymaxval, Uint32 bgcolor)
+{
+    BAD_AVX2_FUNCTION_CALL;
+}
+void
+rotozoom_smooth_run_avx2(const Uint8 *srcpix, int srcpitch, Uint32 *dstpix,
+                         int width, int sdx, int sdy, int icos, int isin)
+{
+    BAD_AVX2_FUNCTION_CALL;
+}
+void
+scale2x_row_avx2(const Uint32 *prev, const Uint32 *cur, const Uint32 *next,
+                 Uint32 *dst0, Uint32 *dst1, int n)
+{
+    BAD_AVX2_FUNCTION_CALL;
+}
+void
+scale3x_row_avx2(const Uint32 *prev, const Uint32 *cur, const Uint32 *next,
+                 Uint32 *dst0, Uint32 *dst1, Uint32 *dst2, int n)
+{
+    BAD_AVX2_FUNCTION_CALL;
+}
+
+void
+transpose32_avx2(const Uint8 *src, int srcpitch, Uint8 *dst, int dstpitch,
+                 int w, int h)
+{
+    BAD_AVX2_FUNCTION_CALL;
+}
+
+void
+flip_row32_avx2(const Uint32 *src, Uint32 *dst, int n)
+{
+    BAD_AVX2_FUNCTION_CALL;
+}
+
+void
+lightmap_stamp_row_avx2(Uint16 *light, const Uint32 *src, int n,
+                        int intensity, int has_alpha, int max)
+{
+    BAD_AVX2_FUNCTION_CALL;
+}
+
+void
+lightmap_apply_row_avx2(Uint32 *dst, const Uint16 *light, int n)
+{
+    BAD_AVX2_FUNCTION_CALL;
+}
 #endif /* defined(__AVX2__) && defined(HAVE_IMMINTRIN_H) && \
           !defined(SDL_DISABLE_IMMINTRIN_H) */
@@ -686,4 +686,893 @@ invert_sse2(SDL_Surface *src, SDL_Surface *newsurf)
     }
 }
 
+/* acc[i] += src[i] * weight
+ * The multiply and the add are separate instructions so the results are
+ * exactly the same as the scalar code. */
+void
+blur_accumulate_u8_sse2(float *acc, const Uint8 *src, int n, float weight)
+{
+    int i = 0;
+    __m128 mm_weight = _mm_set1_ps(weight);
+    __m128i mm_zero = _mm_setzero_si128();
+    __m128i mm_src, mm_lo, mm_hi;
+
+#define _BLUR_ACCUMULATE_4(p, epi32)                                    \
+    _mm_storeu_ps((p), _mm_add_ps(_mm_loadu_ps(p),                      \
+                                  _mm_mul_ps(_mm_cvtepi32_ps(epi32), \
+                                             mm_weight)))
+
+    for (; i + 16 <= n; i += 16) {
+        mm_src = _mm_loadu_si128((const __m128i *)(src + i));
+        mm_lo = _mm_unpacklo_epi8(mm_src, mm_zero);
+        mm_hi = _mm_unpackhi_epi8(mm_src, mm_zero);
+        _BLUR_ACCUMULATE_4(acc + i, _mm_unpacklo_epi16(mm_lo, mm_zero));
+        _BLUR_ACCUMULATE_4(acc + i + 4, _mm_unpackhi_epi16(mm_lo, mm_zero));
+        _BLUR_ACCUMULATE_4(acc + i + 8, _mm_unpacklo_epi16(mm_hi, mm_zero));
+        _BLUR_ACCUMULATE_4(acc + i + 12, _mm_unpackhi_epi16(mm_hi, mm_zero));
+    }
+
+#undef _BLUR_ACCUMULATE_4
+
+    for (; i < n; i++) {
+        acc[i] += (float)src[i] * weight;
+    }
+}
+
+/* acc[i] += src[i] * weight */
+void
+blur_accumulate_f32_sse2(float *acc, const float *src, int n, float weight)
+{
+    int i = 0;
+    __m128 mm_weight = _mm_set1_ps(weight);
+    __m128 mm_lo, mm_hi;
+
+    for (; i + 8 <= n; i += 8) {
+        mm_lo = _mm_mul_ps(_mm_loadu_ps(src + i), mm_weight);
+        mm_hi = _mm_mul_ps(_mm_loadu_ps(src + i + 4), mm_weight);
+        _mm_storeu_ps(acc + i, _mm_add_ps(_mm_loadu_ps(acc + i), mm_lo));
+        _mm_storeu_ps(acc + i + 4,
+                      _mm_add_ps(_mm_loadu_ps(acc + i + 4), mm_hi));
+    }
+    for (; i < n; i++) {
+        acc[i] += src[i] * weight;
+    }
+}
+
+void
+rotate_nearest_row_sse2(const Uint8 *srcpix, int srcpitch, Uint32 *dstpix,
+                        int width, int dx, int dy, int icos, int isin,
+                        int xmaxval, int ymaxval, Uint32 bgcolor)
+{
+    /* There is no gather in SSE2, so the pixels are fetched one by one, but
+     * the range checks and offsets are done 4 pixels at a time and without
+     * branches. Pixels outside of the source read pixel 0 and are then
+     * replaced with bgcolor. */
+    int x = 0;
+    int offsets[4];
+    __m128i mm_dx =
+        _mm_setr_epi32(dx, dx + icos, dx + 2 * icos, dx + 3 * icos);
+    __m128i mm_dy =
+        _mm_setr_epi32(dy, dy + isin, dy + 2 * isin, dy + 3 * isin);
+    __m128i mm_dx_step = _mm_set1_epi32(4 * icos);
+    __m128i mm_dy_step = _mm_set1_epi32(4 * isin);
+    __m128i mm_xmax = _mm_set1_epi32(xmaxval);
+    __m128i mm_ymax = _mm_set1_epi32(ymaxval);
+    __m128i mm_pitch = _mm_set1_epi32(srcpitch);
+    __m128i mm_bg = _mm_set1_epi32(bgcolor);
+    __m128i mm_zero = _mm_setzero_si128();
+    __m128i mm_out, mm_x, mm_y, mm_row_even, mm_row_odd, mm_px;
+
+    for (; x + 4 <= width; x += 4) {
+        mm_out = _mm_or_si128(
+            _mm_or_si128(_mm_cmplt_epi32(mm_dx, mm_zero),
+                         _mm_cmplt_epi32(mm_dy, mm_zero)),
+            _mm_or_si128(_mm_cmpgt_epi32(mm_dx, mm_xmax),
+                         _mm_cmpgt_epi32(mm_dy, mm_ymax)));
+        mm_x = _mm_andnot_si128(mm_out, _mm_srai_epi32(mm_dx, 16));
+        mm_y = _mm_andnot_si128(mm_out, _mm_srai_epi32(mm_dy, 16));
+
+        /* y * srcpitch, _mm_mul_epu32 only multiplies lanes 0 and 2 */
+        mm_row_even = _mm_mul_epu32(mm_y, mm_pitch);
+        mm_row_odd = _mm_mul_epu32(_mm_srli_si128(mm_y, 4), mm_pitch);
+        mm_y = _mm_unpacklo_epi32(
+            _mm_shuffle_epi32(mm_row_even, _PG_SIMD_SHUFFLE(0, 0, 2, 0)),
+            _mm_shuffle_epi32(mm_row_odd, _PG_SIMD_SHUFFLE(0, 0, 2, 0)));
+        _mm_storeu_si128((__m128i *)offsets,
+                         _mm_add_epi32(mm_y, _mm_slli_epi32(mm_x, 2)));
+
+        mm_px = _mm_setr_epi32(*(const int *)(srcpix + offsets[0]),
+                               *(const int *)(srcpix + offsets[1]),
+                               *(const int *)(srcpix + offsets[2]),
+                               *(const int *)(srcpix + offsets[3]));
+        mm_px = _mm_or_si128(_mm_andnot_si128(mm_out, mm_px),
+                             _mm_and_si128(mm_out, mm_bg));
+        _mm_storeu_si128((__m128i *)(dstpix + x), mm_px);
+
+        mm_dx = _mm_add_epi32(mm_dx, mm_dx_step);
+        mm_dy = _mm_add_epi32(mm_dy, mm_dy_step);
+    }
+
+    dx += x * icos;
+    dy += x * isin;
+    for (; x < width; x++) {
+        if (dx < 0 || dy < 0 || dx > xmaxval || dy > ymaxval)
+            dstpix[x] = bgcolor;
+        else
+            dstpix[x] = *(const Uint32 *)(srcpix + ((dy >> 16) * srcpitch) +
+                                          ((long long)dx >> 16 << 2));
+        dx += icos;
+        dy += isin;
+    }
+}
+
+/* a + ((b - a) * e >> 16) for unsigned 16 bit a, b and e, exactly like the
+ * scalar code: (a << 16) + b * e - a * e is computed from the high and low
+ * halves of the products, the low halves only contribute a borrow. */
+static inline __m128i
+_pg_lerp_epu16(__m128i a, __m128i b, __m128i e)
+{
+    __m128i mm_sign = _mm_set1_epi16((short)0x8000);
+    __m128i mm_borrow =
+        _mm_cmpgt_epi16(_mm_xor_si128(_mm_mullo_epi16(a, e), mm_sign),
+                        _mm_xor_si128(_mm_mullo_epi16(b, e), mm_sign));
+
+    return _mm_add_epi16(
+        _mm_sub_epi16(_mm_add_epi16(a, _mm_mulhi_epu16(b, e)),
+                      _mm_mulhi_epu16(a, e)),
+        mm_borrow);
+}
+
+/* Spreads the low 16 bits of 32 bit lanes 0 and 1 (or 2 and 3 with hi) over
+ * the four 16 bit channel lanes of an unpacked pixel */
+#define _PG_WEIGHTS_LO(w)                   \
+    _mm_or_si128(_mm_unpacklo_epi32(w, w), \
+                 _mm_slli_epi32(_mm_unpacklo_epi32(w, w), 16))
+#define _PG_WEIGHTS_HI(w)                   \
+    _mm_or_si128(_mm_unpackhi_epi32(w, w), \
+                 _mm_slli_epi32(_mm_unpackhi_epi32(w, w), 16))
+
+void
+rotozoom_smooth_run_sse2(const Uint8 *srcpix, int srcpitch, Uint32 *dstpix,
+                         int width, int sdx, int sdy, int icos, int isin)
+{
+    int x = 0, i;
+    const Uint8 *sp;
+    Uint32 c00[4], c01[4], c10[4], c11[4];
+    int ex[4], ey[4];
+    __m128i mm_zero = _mm_setzero_si128();
+    __m128i mm_mask = _mm_set1_epi32(0xffff);
+    __m128i mm_c00, mm_c01, mm_c10, mm_c11, mm_ex, mm_ey, mm_lo, mm_hi;
+
+    for (; x + 4 <= width; x += 4) {
+        for (i = 0; i < 4; i++) {
+            sp = srcpix + (sdy >> 16) * srcpitch + (sdx >> 16) * 4;
+            c00[i] = *(const Uint32 *)sp;
+            c01[i] = *(const Uint32 *)(sp + 4);
+            c10[i] = *(const Uint32 *)(sp + srcpitch);
+            c11[i] = *(const Uint32 *)(sp + srcpitch + 4);
+            ex[i] = sdx;
+            ey[i] = sdy;
+            sdx += icos;
+            sdy += isin;
+        }
+        mm_c00 = _mm_loadu_si128((const __m128i *)c00);
+        mm_c01 = _mm_loadu_si128((const __m128i *)c01);
+        mm_c10 = _mm_loadu_si128((const __m128i *)c10);
+        mm_c11 = _mm_loadu_si128((const __m128i *)c11);
+        mm_ex = _mm_and_si128(_mm_loadu_si128((const __m128i *)ex), mm_mask);
+        mm_ey = _mm_and_si128(_mm_loadu_si128((const __m128i *)ey), mm_mask);
+
+        /* pixels 0 and 1 */
+        mm_lo = _pg_lerp_epu16(
+            _pg_lerp_epu16(_mm_unpacklo_epi8(mm_c00, mm_zero),
+                           _mm_unpacklo_epi8(mm_c01, mm_zero),
+                           _PG_WEIGHTS_LO(mm_ex)),
+            _pg_lerp_epu16(_mm_unpacklo_epi8(mm_c10, mm_zero),
+                           _mm_unpacklo_epi8(mm_c11, mm_zero),
+                           _PG_WEIGHTS_LO(mm_ex)),
+            _PG_WEIGHTS_LO(mm_ey));
+        /* pixels 2 and 3 */
+        mm_hi = _pg_lerp_epu16(
+            _pg_lerp_epu16(_mm_unpackhi_epi8(mm_c00, mm_zero),
+                           _mm_unpackhi_epi8(mm_c01, mm_zero),
+                           _PG_WEIGHTS_HI(mm_ex)),
+            _pg_lerp_epu16(_mm_unpackhi_epi8(mm_c10, mm_zero),
+                           _mm_unpackhi_epi8(mm_c11, mm_zero),
+                           _PG_WEIGHTS_HI(mm_ex)),
+            _PG_WEIGHTS_HI(mm_ey));
+
+        _mm_storeu_si128((__m128i *)(dstpix + x),
+                         _mm_packus_epi16(mm_lo, mm_hi));
+    }
+
+    if (x < width) {
+        rotozoom_smooth_run(srcpix, srcpitch, dstpix + x, width - x, sdx, sdy,
+                            icos, isin);
+    }
+}
+
+#undef _PG_WEIGHTS_LO
+#undef _PG_WEIGHTS_HI
+
+void
+pyramid_downsample_row_sse2(const Uint8 *row0, const Uint8 *row1,
+                            Uint8 *dstpix, int width)
+{
+    // Every destination pixel is the rounded average of a 2x2 block, 4
+    // destination pixels per iteration. Shuffling as floats only moves the
+    // bits around, it is just the quickest way to split even and odd
+    // pixels.
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i two = _mm_set1_epi16(2);
+    __m128i ev0, od0, ev1, od1, lo, hi;
+    __m128 a, b;
+    int x, c;
+
+    for (x = 0; x + 4 <= width; x += 4) {
+        a = _mm_castsi128_ps(
+            _mm_loadu_si128((const __m128i *)(row0 + x * 8)));
+        b = _mm_castsi128_ps(
+            _mm_loadu_si128((const __m128i *)(row0 + x * 8 + 16)));
+        ev0 = _mm_castps_si128(_mm_shuffle_ps(a, b, _MM_SHUFFLE(2, 0, 2, 0)));
+        od0 = _mm_castps_si128(_mm_shuffle_ps(a, b, _MM_SHUFFLE(3, 1, 3, 1)));
+        a = _mm_castsi128_ps(
+            _mm_loadu_si128((const __m128i *)(row1 + x * 8)));
+        b = _mm_castsi128_ps(
+            _mm_loadu_si128((const __m128i *)(row1 + x * 8 + 16)));
+        ev1 = _mm_castps_si128(_mm_shuffle_ps(a, b, _MM_SHUFFLE(2, 0, 2, 0)));
+        od1 = _mm_castps_si128(_mm_shuffle_ps(a, b, _MM_SHUFFLE(3, 1, 3, 1)));
+
+        lo = _mm_add_epi16(_mm_add_epi16(_mm_unpacklo_epi8(ev0, zero),
+                                         _mm_unpacklo_epi8(od0, zero)),
+                           _mm_add_epi16(_mm_unpacklo_epi8(ev1, zero),
+                                         _mm_unpacklo_epi8(od1, zero)));
+        hi = _mm_add_epi16(_mm_add_epi16(_mm_unpackhi_epi8(ev0, zero),
+                                         _mm_unpackhi_epi8(od0, zero)),
+                           _mm_add_epi16(_mm_unpackhi_epi8(ev1, zero),
+                                         _mm_unpackhi_epi8(od1, zero)));
+        lo = _mm_srli_epi16(_mm_add_epi16(lo, two), 2);
+        hi = _mm_srli_epi16(_mm_add_epi16(hi, two), 2);
+        _mm_storeu_si128((__m128i *)(dstpix + x * 4),
+                         _mm_packus_epi16(lo, hi));
+    }
+    for (; x < width; x++) {
+        for (c = 0; c < 4; c++) {
+            dstpix[x * 4 + c] =
+                (row0[x * 8 + c] + row0[x * 8 + 4 + c] + row1[x * 8 + c] +
+                 row1[x * 8 + 4 + c] + 2) >>
+                2;
+        }
+    }
+}
+
+void
+accumulator_add_sse2(Uint32 *sums, const Uint8 *src, int n)
+{
+    // Widens 16 bytes at a time to 32 bit lanes and adds them to the sums
+    const __m128i zero = _mm_setzero_si128();
+    __m128i bytes, lo, hi;
+    int i;
+
+    for (i = 0; i + 16 <= n; i += 16) {
+        bytes = _mm_loadu_si128((const __m128i *)(src + i));
+        lo = _mm_unpacklo_epi8(bytes, zero);
+        hi = _mm_unpackhi_epi8(bytes, zero);
+        _mm_storeu_si128(
+            (__m128i *)(sums + i),
+            _mm_add_epi32(_mm_loadu_si128((const __m128i *)(sums + i)),
+                          _mm_unpacklo_epi16(lo, zero)));
+        _mm_storeu_si128(
+            (__m128i *)(sums + i + 4),
+            _mm_add_epi32(_mm_loadu_si128((const __m128i *)(sums + i + 4)),
+                          _mm_unpackhi_epi16(lo, zero)));
+        _mm_storeu_si128(
+            (__m128i *)(sums + i + 8),
+            _mm_add_epi32(_mm_loadu_si128((const __m128i *)(sums + i + 8)),
+                          _mm_unpacklo_epi16(hi, zero)));
+        _mm_storeu_si128(
+            (__m128i *)(sums + i + 12),
+            _mm_add_epi32(_mm_loadu_si128((const __m128i *)(sums + i + 12)),
+                          _mm_unpackhi_epi16(hi, zero)));
+    }
+    for (; i < n; i++) {
+        sums[i] += src[i];
+    }
+}
+
+void
+accumulator_average_sse2(Uint8 *dst, const Uint32 *sums, int n, float scale)
+{
+    // dst[i] = (Uint8)(sums[i] * scale + 0.5f), 16 bytes at a time. The sums
+    // stay below 2 ** 31, so converting them as signed integers is fine.
+    const __m128 mm_scale = _mm_set1_ps(scale);
+    const __m128 half = _mm_set1_ps(0.5f);
+    __m128i a, b, c, d;
+    int i;
+
+#define _PG_AVERAGE_4(i)                                                  \
+    _mm_cvttps_epi32(_mm_add_ps(                                          \
+        _mm_mul_ps(_mm_cvtepi32_ps(                                       \
+                       _mm_loadu_si128((const __m128i *)(sums + (i)))),   \
+                   mm_scale),                                             \
+        half))
+
+    for (i = 0; i + 16 <= n; i += 16) {
+        a = _PG_AVERAGE_4(i);
+        b = _PG_AVERAGE_4(i + 4);
+        c = _PG_AVERAGE_4(i + 8);
+        d = _PG_AVERAGE_4(i + 12);
+        _mm_storeu_si128(
+            (__m128i *)(dst + i),
+            _mm_packus_epi16(_mm_packs_epi32(a, b), _mm_packs_epi32(c, d)));
+    }
+#undef _PG_AVERAGE_4
+    for (; i < n; i++) {
+        dst[i] = (Uint8)(sums[i] * scale + 0.5f);
+    }
+}
+
+int
+threshold_row_sse2(const Uint32 *src, const Uint32 *search, int n,
+                   Uint32 search_color, Uint32 threshold, Uint8 *match)
+{
+    // |src - search| per byte is the OR of both saturated differences, it is
+    // within the threshold if subtracting the threshold saturates to 0.
+    // Matching pixels compare to -1, which counts them when subtracted.
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i thr = _mm_set1_epi32((int)threshold);
+    __m128i ref = _mm_set1_epi32((int)search_color);
+    __m128i count = zero;
+    __m128i pix, diff, in;
+    Uint32 counts[4];
+    int i;
+
+    for (i = 0; i + 4 <= n; i += 4) {
+        pix = _mm_loadu_si128((const __m128i *)(src + i));
+        if (search) {
+            ref = _mm_loadu_si128((const __m128i *)(search + i));
+        }
+        diff = _mm_or_si128(_mm_subs_epu8(pix, ref), _mm_subs_epu8(ref, pix));
+        in = _mm_cmpeq_epi32(_mm_subs_epu8(diff, thr), zero);
+        count = _mm_sub_epi32(count, in);
+        if (match) {
+            in = _mm_packs_epi32(in, in);
+            _pg_storeu_si32(match + i, _mm_packs_epi16(in, in));
+        }
+    }
+    _mm_storeu_si128((__m128i *)counts, count);
+
+    return (int)(counts[0] + counts[1] + counts[2] + counts[3]) +
+           threshold_row(src + i, search ? search + i : NULL, n - i,
+                         search_color, threshold, match ? match + i : NULL);
+}
+
+void
+average_color_row_sse2(const Uint8 *row, int n, int alpha_byte, Uint64 *sums)
+{
+    // The 4 pixels of a load are widened to 16 bit lanes, weighted, and added
+    // up in 32 bit lanes per byte. The 32 bit lanes are flushed every 4096
+    // pixels, so even 4096 * 255 * 255 can't overflow them.
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i low_byte = _mm_set1_epi32(0xFF);
+    __m128i amask = zero, aone = zero, ashift = zero;
+    __m128i acc, pix, lo, hi, a, w;
+    Uint32 lanes[4];
+    int i = 0, end, k;
+
+    if (alpha_byte >= 0) {
+        // amask selects the 16 bit lanes of the alpha bytes, their weight is 1
+        amask = _mm_set1_epi32((int)(0xFFu << (alpha_byte * 8)));
+        amask = _mm_unpacklo_epi8(amask, amask);
+        aone = _mm_and_si128(amask, _mm_set1_epi16(1));
+        ashift = _mm_cvtsi32_si128(alpha_byte * 8);
+    }
+
+    while (i + 4 <= n) {
+        end = n - i > 4096 ? i + 4096 : i + ((n - i) & ~3);
+        acc = zero;
+        for (; i < end; i += 4) {
+            pix = _mm_loadu_si128((const __m128i *)(row + i * 4));
+            lo = _mm_unpacklo_epi8(pix, zero);
+            hi = _mm_unpackhi_epi8(pix, zero);
+            if (alpha_byte >= 0) {
+                // every pixel's alpha in both halves of its 32 bit lane
+                a = _mm_and_si128(_mm_srl_epi32(pix, ashift), low_byte);
+                a = _mm_or_si128(a, _mm_slli_epi32(a, 16));
+                w = _mm_andnot_si128(amask, _mm_unpacklo_epi32(a, a));
+                lo = _mm_mullo_epi16(lo, _mm_or_si128(w, aone));
+                w = _mm_andnot_si128(amask, _mm_unpackhi_epi32(a, a));
+                hi = _mm_mullo_epi16(hi, _mm_or_si128(w, aone));
+            }
+            acc = _mm_add_epi32(acc, _mm_unpacklo_epi16(lo, zero));
+            acc = _mm_add_epi32(acc, _mm_unpackhi_epi16(lo, zero));
+            acc = _mm_add_epi32(acc, _mm_unpacklo_epi16(hi, zero));
+            acc = _mm_add_epi32(acc, _mm_unpackhi_epi16(hi, zero));
+        }
+        _mm_storeu_si128((__m128i *)lanes, acc);
+        for (k = 0; k < 4; k++) {
+            sums[k] += lanes[k];
+        }
+    }
+
+    average_color_row(row + i * 4, n - i, alpha_byte, sums);
+}
+
+#define _PG_SELECT_PS(mask, a, b) \
+    _mm_or_ps(_mm_and_ps((mask), (a)), _mm_andnot_ps((mask), (b)))
+
+/* hue_to_rgb() of transform.c */
+static PG_FORCEINLINE __m128
+_hue_to_rgb_sse2(__m128 p, __m128 q, __m128 t)
+{
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 one = _mm_set1_ps(1.0f);
+    const __m128 six = _mm_set1_ps(6.0f);
+    const __m128 two_thirds = _mm_set1_ps(2 / 3.0f);
+    __m128 qp = _mm_sub_ps(q, p);
+    __m128 res;
+
+    t = _mm_add_ps(t, _mm_and_ps(_mm_cmplt_ps(t, zero), one));
+    t = _mm_sub_ps(t, _mm_and_ps(_mm_cmpgt_ps(t, one), one));
+
+    res = _PG_SELECT_PS(
+        _mm_cmplt_ps(t, two_thirds),
+        _mm_add_ps(p, _mm_mul_ps(_mm_mul_ps(qp, _mm_sub_ps(two_thirds, t)),
+                                 six)),
+        p);
+    res = _PG_SELECT_PS(_mm_cmplt_ps(t, _mm_set1_ps(1 / 2.0f)), q, res);
+    res = _PG_SELECT_PS(_mm_cmplt_ps(t, _mm_set1_ps(1 / 6.0f)),
+                        _mm_add_ps(p, _mm_mul_ps(_mm_mul_ps(qp, six), t)),
+                        res);
+    return res;
+}
+
+/* modify_hsl() of transform.c for 4 pixels */
+static PG_FORCEINLINE __m128i
+_modify_hsl_4_sse2(__m128i pix, __m128i old, __m128i rshift, __m128i gshift,
+                   __m128i bshift, __m128i amask, __m128i keep, float h,
+                   float s, float l)
+{
+    const __m128i low_byte = _mm_set1_epi32(0xFF);
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 one = _mm_set1_ps(1.0f);
+    const __m128 half = _mm_set1_ps(0.5f);
+    const __m128 c255 = _mm_set1_ps(255.0f);
+    __m128 r, g, b, mn, mx, delta, hue, sat, lum, p, q, gray;
+    __m128i out;
+
+    r = _mm_div_ps(
+        _mm_cvtepi32_ps(_mm_and_si128(_mm_srl_epi32(pix, rshift), low_byte)),
+        c255);
+    g = _mm_div_ps(
+        _mm_cvtepi32_ps(_mm_and_si128(_mm_srl_epi32(pix, gshift), low_byte)),
+        c255);
+    b = _mm_div_ps(
+        _mm_cvtepi32_ps(_mm_and_si128(_mm_srl_epi32(pix, bshift), low_byte)),
+        c255);
+
+    // RGB_to_HSL()
+    mn = _mm_min_ps(_mm_min_ps(r, g), b);
+    mx = _mm_max_ps(_mm_max_ps(r, g), b);
+    delta = _mm_sub_ps(mx, mn);
+    lum = _mm_mul_ps(_mm_add_ps(mx, mn), half);
+    sat = _PG_SELECT_PS(
+        _mm_cmpgt_ps(lum, half),
+        _mm_div_ps(delta, _mm_sub_ps(_mm_sub_ps(_mm_set1_ps(2.0f), mx), mn)),
+        _mm_div_ps(delta, _mm_add_ps(mx, mn)));
+    hue = _PG_SELECT_PS(
+        _mm_cmpeq_ps(mx, g),
+        _mm_add_ps(_mm_div_ps(_mm_sub_ps(b, r), delta), _mm_set1_ps(2.0f)),
+        _mm_add_ps(_mm_div_ps(_mm_sub_ps(r, g), delta), _mm_set1_ps(4.0f)));
+    hue = _PG_SELECT_PS(
+        _mm_cmpeq_ps(mx, r),
+        _mm_add_ps(_mm_div_ps(_mm_sub_ps(g, b), delta),
+                   _mm_and_ps(_mm_cmplt_ps(g, b), _mm_set1_ps(6.0f))),
+        hue);
+    hue = _mm_div_ps(hue, _mm_set1_ps(6.0f));
+    gray = _mm_cmpeq_ps(delta, zero);
+    hue = _mm_andnot_ps(gray, hue);
+    sat = _mm_andnot_ps(gray, sat);
+
+    if (h) {
+        hue = _mm_add_ps(hue, _mm_set1_ps(h));
+        hue = _PG_SELECT_PS(
+            _mm_cmpgt_ps(hue, one), _mm_sub_ps(hue, one),
+            _PG_SELECT_PS(_mm_cmplt_ps(hue, zero), _mm_add_ps(hue, one), hue));
+    }
+    if (s) {
+        sat = _mm_mul_ps(sat, _mm_set1_ps(1 + s));
+        sat = _PG_SELECT_PS(_mm_cmpgt_ps(sat, one), one,
+                            _mm_andnot_ps(_mm_cmplt_ps(sat, zero), sat));
+    }
+    if (l) {
+        lum = l < 0 ? _mm_mul_ps(lum, _mm_set1_ps(1 + l))
+                    : _mm_add_ps(_mm_mul_ps(lum, _mm_set1_ps(1 - l)),
+                                 _mm_set1_ps(l));
+        lum = _PG_SELECT_PS(_mm_cmpgt_ps(lum, one), one,
+                            _mm_andnot_ps(_mm_cmplt_ps(lum, zero), lum));
+    }
+
+    // HSL_to_RGB()
+    gray = _mm_cmpeq_ps(sat, zero);
+    q = _PG_SELECT_PS(_mm_cmplt_ps(lum, half),
+                      _mm_mul_ps(lum, _mm_add_ps(one, sat)),
+                      _mm_sub_ps(_mm_add_ps(lum, sat), _mm_mul_ps(lum, sat)));
+    p = _mm_sub_ps(_mm_mul_ps(_mm_set1_ps(2.0f), lum), q);
+    r = _hue_to_rgb_sse2(p, q, _mm_add_ps(hue, _mm_set1_ps(1 / 3.0f)));
+    g = _hue_to_rgb_sse2(p, q, hue);
+    b = _hue_to_rgb_sse2(p, q, _mm_sub_ps(hue, _mm_set1_ps(1 / 3.0f)));
+    r = _PG_SELECT_PS(gray, lum, r);
+    g = _PG_SELECT_PS(gray, lum, g);
+    b = _PG_SELECT_PS(gray, lum, b);
+
+    out = _mm_or_si128(_mm_and_si128(pix, amask), _mm_and_si128(old, keep));
+    out = _mm_or_si128(
+        out, _mm_sll_epi32(_mm_cvttps_epi32(_mm_mul_ps(r, c255)), rshift));
+    out = _mm_or_si128(
+        out, _mm_sll_epi32(_mm_cvttps_epi32(_mm_mul_ps(g, c255)), gshift));
+    out = _mm_or_si128(
+        out, _mm_sll_epi32(_mm_cvttps_epi32(_mm_mul_ps(b, c255)), bshift));
+    return out;
+}
+
+void
+modify_hsl_row_sse2(const Uint32 *src, Uint32 *dst, int n, int rshift,
+                    int gshift, int bshift, Uint32 amask, float h, float s,
+                    float l)
+{
+    // Every branch of the scalar code is a select here, with the same float
+    // operations in the same order, so the results are identical to it. The
+    // last pixels of the row are padded to 4.
+    const __m128i mm_rshift = _mm_cvtsi32_si128(rshift);
+    const __m128i mm_gshift = _mm_cvtsi32_si128(gshift);
+    const __m128i mm_bshift = _mm_cvtsi32_si128(bshift);
+    const __m128i mm_amask = _mm_set1_epi32((int)amask);
+    const __m128i keep = _mm_set1_epi32(
+        (int)~((0xFFu << rshift) | (0xFFu << gshift) | (0xFFu << bshift) |
+               amask));
+    Uint32 srcbuf[4] = {0}, dstbuf[4] = {0};
+    __m128i out;
+    int i;
+
+    for (i = 0; i + 4 <= n; i += 4) {
+        out = _modify_hsl_4_sse2(
+            _mm_loadu_si128((const __m128i *)(src + i)),
+            _mm_loadu_si128((const __m128i *)(dst + i)), mm_rshift, mm_gshift,
+            mm_bshift, mm_amask, keep, h, s, l);
+        _mm_storeu_si128((__m128i *)(dst + i), out);
+    }
+    if (i < n) {
+        memcpy(srcbuf, src + i, (n - i) * sizeof(Uint32));
+        memcpy(dstbuf, dst + i, (n - i) * sizeof(Uint32));
+        out = _modify_hsl_4_sse2(
+            _mm_loadu_si128((const __m128i *)srcbuf),
+            _mm_loadu_si128((const __m128i *)dstbuf), mm_rshift, mm_gshift,
+            mm_bshift, mm_amask, keep, h, s, l);
+        _mm_storeu_si128((__m128i *)dstbuf, out);
+        memcpy(dst + i, dstbuf, (n - i) * sizeof(Uint32));
+    }
+}
+
+void
+color_matrix_row_sse2(const Uint32 *src, Uint32 *dst, int n,
+                      const int *shifts, Uint32 amask, const float *matrix)
+{
+    // The pixels are split into one float vector per channel, every output
+    // channel is then the same sum of products as in color_matrix_row().
+    const __m128i low_byte = _mm_set1_epi32(0xFF);
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 c255 = _mm_set1_ps(255.0f);
+    const __m128 half = _mm_set1_ps(0.5f);
+    const int nout = amask ? 4 : 3;
+    __m128i mm_shifts[4], keep, pix, out;
+    __m128 m[20], in[4], v;
+    int i, c;
+
+    for (c = 0; c < 20; c++) {
+        m[c] = _mm_set1_ps(matrix[c]);
+    }
+    for (c = 0; c < 4; c++) {
+        mm_shifts[c] = _mm_cvtsi32_si128(shifts[c]);
+    }
+    keep = _mm_set1_epi32((int)~((0xFFu << shifts[0]) | (0xFFu << shifts[1]) |
+                                 (0xFFu << shifts[2]) | amask));
+    in[3] = c255;
+
+    for (i = 0; i + 4 <= n; i += 4) {
+        pix = _mm_loadu_si128((const __m128i *)(src + i));
+        for (c = 0; c < nout; c++) {
+            in[c] = _mm_cvtepi32_ps(
+                _mm_and_si128(_mm_srl_epi32(pix, mm_shifts[c]), low_byte));
+        }
+        out = _mm_and_si128(pix, keep);
+        for (c = 0; c < nout; c++) {
+            v = _mm_mul_ps(m[c * 5], in[0]);
+            v = _mm_add_ps(v, _mm_mul_ps(m[c * 5 + 1], in[1]));
+            v = _mm_add_ps(v, _mm_mul_ps(m[c * 5 + 2], in[2]));
+            v = _mm_add_ps(v, _mm_mul_ps(m[c * 5 + 3], in[3]));
+            v = _mm_add_ps(v, m[c * 5 + 4]);
+            v = _mm_min_ps(_mm_max_ps(v, zero), c255);
+            out = _mm_or_si128(
+                out, _mm_sll_epi32(_mm_cvttps_epi32(_mm_add_ps(v, half)),
+                                   mm_shifts[c]));
+        }
+        _mm_storeu_si128((__m128i *)(dst + i), out);
+    }
+
+    color_matrix_row(src + i, dst + i, n - i, shifts, amask, matrix);
+}
+
+#undef _PG_SELECT_PS
+
+#define _PG_SELECT_SI128(mask, a, b) \
+    _mm_or_si128(_mm_and_si128((mask), (a)), _mm_andnot_si128((mask), (b)))
+
+void
+scale2x_row_sse2(const Uint32 *prev, const Uint32 *cur, const Uint32 *next,
+                 Uint32 *dst0, Uint32 *dst1, int n)
+{
+    // The Scale2x rules for 4 pixels at a time. A rule holds where its
+    // pixels compare equal and neither B == H nor D == F. The 2 output
+    // pixels of every rule pair are interleaved into 8 pixels of a row.
+    __m128i B, D, E, F, H, same, e0, e1, e2, e3;
+    int x;
+
+    for (x = 0; x + 4 <= n; x += 4) {
+        B = _mm_loadu_si128((const __m128i *)(prev + x));
+        D = _mm_loadu_si128((const __m128i *)(cur + x - 1));
+        E = _mm_loadu_si128((const __m128i *)(cur + x));
+        F = _mm_loadu_si128((const __m128i *)(cur + x + 1));
+        H = _mm_loadu_si128((const __m128i *)(next + x));
+
+        same = _mm_or_si128(_mm_cmpeq_epi32(B, H), _mm_cmpeq_epi32(D, F));
+        e0 = _PG_SELECT_SI128(_mm_andnot_si128(same, _mm_cmpeq_epi32(D, B)),
+                              D, E);
+        e1 = _PG_SELECT_SI128(_mm_andnot_si128(same, _mm_cmpeq_epi32(B, F)),
+                              F, E);
+        e2 = _PG_SELECT_SI128(_mm_andnot_si128(same, _mm_cmpeq_epi32(D, H)),
+                              D, E);
+        e3 = _PG_SELECT_SI128(_mm_andnot_si128(same, _mm_cmpeq_epi32(H, F)),
+                              F, E);
+
+        _mm_storeu_si128((__m128i *)(dst0 + 2 * x),
+                         _mm_unpacklo_epi32(e0, e1));
+        _mm_storeu_si128((__m128i *)(dst0 + 2 * x + 4),
+                         _mm_unpackhi_epi32(e0, e1));
+        _mm_storeu_si128((__m128i *)(dst1 + 2 * x),
+                         _mm_unpacklo_epi32(e2, e3));
+        _mm_storeu_si128((__m128i *)(dst1 + 2 * x + 4),
+                         _mm_unpackhi_epi32(e2, e3));
+    }
+
+    scale2x_row(prev + x, cur + x, next + x, dst0 + 2 * x, dst1 + 2 * x,
+                n - x);
+}
+
+/* Stores a0 b0 c0 a1 b1 c1 ... a3 b3 c3 to dst */
+static PG_FORCEINLINE void
+_pg_store_interleave3_sse2(Uint32 *dst, __m128i a, __m128i b, __m128i c)
+{
+    __m128 ab = _mm_castsi128_ps(_mm_unpacklo_epi32(a, b));
+    __m128 ca = _mm_castsi128_ps(_mm_unpacklo_epi32(c, a));
+    __m128 bc = _mm_castsi128_ps(_mm_unpacklo_epi32(b, c));
+    __m128 ab_hi = _mm_castsi128_ps(_mm_unpackhi_epi32(a, b));
+    __m128 ca_hi = _mm_castsi128_ps(_mm_unpackhi_epi32(c, a));
+    __m128 bc_hi = _mm_castsi128_ps(_mm_unpackhi_epi32(b, c));
+
+    _mm_storeu_ps((float *)dst,
+                  _mm_shuffle_ps(ab, ca, _PG_SIMD_SHUFFLE(3, 0, 1, 0)));
+    _mm_storeu_ps((float *)(dst + 4),
+                  _mm_shuffle_ps(bc, ab_hi, _PG_SIMD_SHUFFLE(1, 0, 3, 2)));
+    _mm_storeu_ps((float *)(dst + 8),
+                  _mm_shuffle_ps(ca_hi, bc_hi, _PG_SIMD_SHUFFLE(3, 2, 3, 0)));
+}
+
+void
+scale3x_row_sse2(const Uint32 *prev, const Uint32 *cur, const Uint32 *next,
+                 Uint32 *dst0, Uint32 *dst1, Uint32 *dst2, int n)
+{
+    // The Scale3x rules for 4 pixels at a time, see scale2x_row_sse2().
+    // The corner rules also need E to differ from a corner pixel.
+    __m128i A, B, C, D, E, F, G, H, I, same, db, bf, dh, hf, m;
+    __m128i e0, e1, e2, e3, e5, e6, e7, e8;
+    int x;
+
+    for (x = 0; x + 4 <= n; x += 4) {
+        A = _mm_loadu_si128((const __m128i *)(prev + x - 1));
+        B = _mm_loadu_si128((const __m128i *)(prev + x));
+        C = _mm_loadu_si128((const __m128i *)(prev + x + 1));
+        D = _mm_loadu_si128((const __m128i *)(cur + x - 1));
+        E = _mm_loadu_si128((const __m128i *)(cur + x));
+        F = _mm_loadu_si128((const __m128i *)(cur + x + 1));
+        G = _mm_loadu_si128((const __m128i *)(next + x - 1));
+        H = _mm_loadu_si128((const __m128i *)(next + x));
+        I = _mm_loadu_si128((const __m128i *)(next + x + 1));
+
+        same = _mm_or_si128(_mm_cmpeq_epi32(B, H), _mm_cmpeq_epi32(D, F));
+        db = _mm_andnot_si128(same, _mm_cmpeq_epi32(D, B));
+        bf = _mm_andnot_si128(same, _mm_cmpeq_epi32(B, F));
+        dh = _mm_andnot_si128(same, _mm_cmpeq_epi32(D, H));
+        hf = _mm_andnot_si128(same, _mm_cmpeq_epi32(H, F));
+
+        e0 = _PG_SELECT_SI128(db, D, E);
+        m = _mm_or_si128(_mm_andnot_si128(_mm_cmpeq_epi32(E, C), db),
+                         _mm_andnot_si128(_mm_cmpeq_epi32(E, A), bf));
+        e1 = _PG_SELECT_SI128(m, B, E);
+        e2 = _PG_SELECT_SI128(bf, F, E);
+        m = _mm_or_si128(_mm_andnot_si128(_mm_cmpeq_epi32(E, G), db),
+                         _mm_andnot_si128(_mm_cmpeq_epi32(E, A), dh));
+        e3 = _PG_SELECT_SI128(m, D, E);
+        m = _mm_or_si128(_mm_andnot_si128(_mm_cmpeq_epi32(E, I), bf),
+                         _mm_andnot_si128(_mm_cmpeq_epi32(E, C), hf));
+        e5 = _PG_SELECT_SI128(m, F, E);
+        e6 = _PG_SELECT_SI128(dh, D, E);
+        m = _mm_or_si128(_mm_andnot_si128(_mm_cmpeq_epi32(E, I), dh),
+                         _mm_andnot_si128(_mm_cmpeq_epi32(E, G), hf));
+        e7 = _PG_SELECT_SI128(m, H, E);
+        e8 = _PG_SELECT_SI128(hf, F, E);
+
+        _pg_store_interleave3_sse2(dst0 + 3 * x, e0, e1, e2);
+        _pg_store_interleave3_sse2(dst1 + 3 * x, e3, E, e5);
+        _pg_store_interleave3_sse2(dst2 + 3 * x, e6, e7, e8);
+    }
+
+    scale3x_row(prev + x, cur + x, next + x, dst0 + 3 * x, dst1 + 3 * x,
+                dst2 + 3 * x, n - x);
+}
+
+#undef _PG_SELECT_SI128
+
+void
+transpose32_sse2(const Uint8 *src, int srcpitch, Uint8 *dst, int dstpitch,
+                 int w, int h)
+{
+    /* Each tile is moved in blocks of 4 x 4 pixels, a block is transposed
+     * with 2 rounds of unpacks */
+    __m128i r0, r1, r2, r3, t0, t1, t2, t3;
+    int tx, ty, x, y, xend, yend;
+
+    for (ty = 0; ty < h; ty += PG_TRANSPOSE_TILE) {
+        yend = MIN(ty + PG_TRANSPOSE_TILE, h);
+        for (tx = 0; tx < w; tx += PG_TRANSPOSE_TILE) {
+            xend = MIN(tx + PG_TRANSPOSE_TILE, w);
+            for (y = ty; y + 4 <= yend; y += 4) {
+                const Uint32 *s0 =
+                    (const Uint32 *)(src + (Sint64)y * srcpitch);
+                const Uint32 *s1 =
+                    (const Uint32 *)(src + (Sint64)(y + 1) * srcpitch);
+                const Uint32 *s2 =
+                    (const Uint32 *)(src + (Sint64)(y + 2) * srcpitch);
+                const Uint32 *s3 =
+                    (const Uint32 *)(src + (Sint64)(y + 3) * srcpitch);
+
+                for (x = tx; x + 4 <= xend; x += 4) {
+                    Uint8 *dstcol = dst + (Sint64)x * dstpitch + y * 4;
+
+                    r0 = _mm_loadu_si128((const __m128i *)(s0 + x));
+                    r1 = _mm_loadu_si128((const __m128i *)(s1 + x));
+                    r2 = _mm_loadu_si128((const __m128i *)(s2 + x));
+                    r3 = _mm_loadu_si128((const __m128i *)(s3 + x));
+                    t0 = _mm_unpacklo_epi32(r0, r1);
+                    t1 = _mm_unpacklo_epi32(r2, r3);
+                    t2 = _mm_unpackhi_epi32(r0, r1);
+                    t3 = _mm_unpackhi_epi32(r2, r3);
+                    _mm_storeu_si128((__m128i *)dstcol,
+                                     _mm_unpacklo_epi64(t0, t1));
+                    _mm_storeu_si128((__m128i *)(dstcol + dstpitch),
+                                     _mm_unpackhi_epi64(t0, t1));
+                    _mm_storeu_si128((__m128i *)(dstcol + 2 * dstpitch),
+                                     _mm_unpacklo_epi64(t2, t3));
+                    _mm_storeu_si128((__m128i *)(dstcol + 3 * dstpitch),
+                                     _mm_unpackhi_epi64(t2, t3));
+                }
+                _pg_transpose32_rect(src, srcpitch, dst, dstpitch, x, xend,
+                                     y, y + 4);
+            }
+            _pg_transpose32_rect(src, srcpitch, dst, dstpitch, tx, xend, y,
+                                 yend);
+        }
+    }
+}
+
+void
+flip_row32_sse2(const Uint32 *src, Uint32 *dst, int n)
+{
+    /* 4 pixels from each end are swapped at a time, so dst may be src */
+    __m128i left, right;
+    Uint32 tmp;
+    int i = 0, j = n - 4;
+
+    for (; i + 4 <= j; i += 4, j -= 4) {
+        left = _mm_loadu_si128((const __m128i *)(src + i));
+        right = _mm_loadu_si128((const __m128i *)(src + j));
+        _mm_storeu_si128(
+            (__m128i *)(dst + i),
+            _mm_shuffle_epi32(right, _PG_SIMD_SHUFFLE(0, 1, 2, 3)));
+        _mm_storeu_si128(
+            (__m128i *)(dst + j),
+            _mm_shuffle_epi32(left, _PG_SIMD_SHUFFLE(0, 1, 2, 3)));
+    }
+    for (j += 3; i <= j; i++, j--) {
+        tmp = src[i];
+        dst[i] = src[j];
+        dst[j] = tmp;
+    }
+}
+
+void
+lightmap_stamp_row_sse2(Uint16 *light, const Uint32 *src, int n,
+                        int intensity, int has_alpha, int max)
+{
+    // The pixels are widened to 16 bits, 2 per register. The weight of a
+    // pixel is its alpha broadcast to its lanes, times the intensity, and
+    // the alpha lane itself is masked out of the light.
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i mm_intensity = _mm_set1_epi16((short)intensity);
+    const __m128i mm_128 = _mm_set1_epi16(128);
+    const __m128i mm_257 = _mm_set1_epi16(257);
+    const __m128i mm_colors = _mm_set_epi16(0, -1, -1, -1, 0, -1, -1, -1);
+    __m128i pix, halves[2], weight, cur;
+    int i, k;
+
+    for (i = 0; i + 4 <= n; i += 4) {
+        pix = _mm_loadu_si128((const __m128i *)(src + i));
+        halves[0] = _mm_unpacklo_epi8(pix, zero);
+        halves[1] = _mm_unpackhi_epi8(pix, zero);
+        for (k = 0; k < 2; k++) {
+            weight = mm_intensity;
+            if (has_alpha) {
+                weight = _mm_shufflelo_epi16(halves[k],
+                                             _PG_SIMD_SHUFFLE(3, 3, 3, 3));
+                weight = _mm_shufflehi_epi16(weight,
+                                             _PG_SIMD_SHUFFLE(3, 3, 3, 3));
+                weight = _mm_mullo_epi16(weight, mm_intensity);
+                weight = _mm_mulhi_epu16(_mm_add_epi16(weight, mm_128),
+                                         mm_257);
+            }
+            pix = _mm_mullo_epi16(halves[k], weight);
+            pix = _mm_mulhi_epu16(_mm_add_epi16(pix, mm_128), mm_257);
+            pix = _mm_and_si128(pix, mm_colors);
+
+            cur = _mm_loadu_si128((const __m128i *)(light + 4 * i + 8 * k));
+            // max(cur, pix) is the part of cur above pix, plus pix
+            cur = max ? _mm_add_epi16(_mm_subs_epu16(cur, pix), pix)
+                      : _mm_adds_epu16(cur, pix);
+            _mm_storeu_si128((__m128i *)(light + 4 * i + 8 * k), cur);
+        }
+    }
+    lightmap_stamp_row(light + 4 * i, src + i, n - i, intensity, has_alpha,
+                       max);
+}
+
+void
+lightmap_apply_row_sse2(Uint32 *dst, const Uint16 *light, int n)
+{
+    // The 16 x 16 bit products are put together from their low and high
+    // halves, then both packs saturate the overbright bytes to 255.
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i mm_255 = _mm_set1_epi32(255);
+    __m128i pix, lit[2], half, l, lo, hi;
+    int i, k;
+
+    for (i = 0; i + 4 <= n; i += 4) {
+        pix = _mm_loadu_si128((const __m128i *)(dst + i));
+        for (k = 0; k < 2; k++) {
+            half = k ? _mm_unpackhi_epi8(pix, zero)
+                     : _mm_unpacklo_epi8(pix, zero);
+            l = _mm_loadu_si128((const __m128i *)(light + 4 * i + 8 * k));
+            lo = _mm_mullo_epi16(half, l);
+            hi = _mm_mulhi_epu16(half, l);
+            lit[k] = _mm_packs_epi32(
+                _mm_srli_epi32(
+                    _mm_add_epi32(_mm_unpacklo_epi16(lo, hi), mm_255), 8),
+                _mm_srli_epi32(
+                    _mm_add_epi32(_mm_unpackhi_epi16(lo, hi), mm_255), 8));
+        }
+        _mm_storeu_si128((__m128i *)(dst + i),
+                         _mm_packus_epi16(lit[0], lit[1]));
+    }
+    lightmap_apply_row(dst + i, light + 4 * i, n - i);
+}
+
 #endif /* __SSE2__ || PG_ENABLE_ARM_NEON*/
@@ -150,6 +150,9 @@ PyInit_mixer(void);
 PyMODINIT_FUNC
 PyInit_system(void);
 
+PyMODINIT_FUNC
+PyInit_input(void);
+
 PyMODINIT_FUNC
 PyInit_controller_old(void);
 
@@ -285,6 +288,7 @@ PyInit_pygame_static()
     load_submodule("pygame", PyInit_display(), "display");
     load_submodule("pygame", PyInit_surface(), "surface");
     load_submodule("pygame", PyInit_system(), "system");
+    load_submodule("pygame", PyInit_input(), "input");
     load_submodule("pygame", PyInit_key(), "key");
 
     load_submodule("pygame", PyInit_rect(), "rect");
@@ -355,16 +359,23 @@ PyInit_pygame_static()
 #undef pgSurface_New
 #undef pgSurface_Type
 #undef pgSurface_SetSurface
+#undef pgSurface_AddDirtyRect
+#undef pgSurface_GetDirtyRects
+#undef pgSurface_GetVersion
+#undef pgSurface_NewWithOrigin
+#undef pgSurface_CreatePooled
 
 #include "surface.c"
 #include "simd_blitters_avx2.c"
 #include "simd_blitters_sse2.c"
 
+#undef PG_SURFACE_ORIGIN
 #include "window.c"
 
 #undef pgVidInfo_Type
 #undef pgVidInfo_New
 
+#undef PG_SURFACE_ORIGIN
 #include "display.c"
 
 #include "draw.c"
@@ -374,13 +385,16 @@ PyInit_pygame_static()
 #undef pgRWops_IsFileObject
 #undef pgRWops_GetFileExtension
 #undef pgRWops_FromFileObject
+#undef pgRWops_FromBuffer
 #undef pgRWops_FromObject
 
 #include "rwobject.c"
 
 #define pgSurface_New(surface) (pgSurfaceObject *)pgSurface_New2((surface), 1)
+#undef PG_SURFACE_ORIGIN
 #include "image.c"
 
+#undef PG_SURFACE_ORIGIN
 #include "imageext.c"
 
 #include "mask.c"
@@ -402,8 +416,10 @@ PyInit_pygame_static()
 #include "time.c"
 
 #include "system.c"
+#include "input.c"
 #include "geometry.c"
 
+#undef PG_SURFACE_ORIGIN
 #include "_freetype.c"
 #include "freetype/ft_wrap.c"
 #include "freetype/ft_render.c"
@@ -412,6 +428,7 @@ PyInit_pygame_static()
 #include "freetype/ft_layout.c"
 #include "freetype/ft_unicode.c"
 
+#undef PG_SURFACE_ORIGIN
 #include "font.c"
 
 #include "mixer.c"
@@ -429,6 +446,7 @@ PyInit_pygame_static()
 
 #include "_sdl2/controller_old.c"
 #include "_sdl2/touch.c"
+#undef PG_SURFACE_ORIGIN
 #include "transform.c"
 // that remove some warnings
 #undef MAX
@@ -29,6 +29,7 @@
 
 #include "structmember.h"
 #include "pgcompat.h"
+#include "pgarg.h"
 #include "doc/surface_doc.h"
 #include "pgbufferproxy.h"
 
@@ -57,6 +58,7 @@ static char FormatUint8[] = "B";
 static char FormatUint16[] = "=H";
 static char FormatUint24[] = "3x";
 static char FormatUint32[] = "=I";
+static char FormatInt[] = "i";
 
 typedef struct pg_bufferinternal_s {
     PyObject *consumer_ref; /* A weak reference to a bufferproxy object   */
@@ -68,8 +70,14 @@ pgSurface_Blit(pgSurfaceObject *dstobj, pgSurfaceObject *srcobj,
                SDL_Rect *dstrect, SDL_Rect *srcrect, int blend_flags);
 
 /* statics */
+static int
+_surf_blit(pgSurfaceObject *dstobj, pgSurfaceObject *srcobj,
+           SDL_Rect *dstrect, SDL_Rect *srcrect, int blend_flags,
+           pg_BlitQueue *queue);
 static pgSurfaceObject *
 pgSurface_New2(SDL_Surface *info, int owner);
+static pgSurfaceObject *
+pgSurface_NewWithOrigin(SDL_Surface *info, int owner, int origin);
 static PyObject *
 surf_subtype_new(PyTypeObject *type, SDL_Surface *s, int owner);
 static PyObject *
@@ -93,6 +101,10 @@ surf_set_at(PyObject *self, PyObject *const *args, Py_ssize_t nargs);
 static PyObject *
 surf_get_at_mapped(PyObject *self, PyObject *args);
 static PyObject *
+surf_get_at_many(PyObject *self, PyObject *args, PyObject *kwargs);
+static PyObject *
+surf_set_at_many(PyObject *self, PyObject *args, PyObject *kwargs);
+static PyObject *
 surf_map_rgb(PyObject *self, PyObject *args);
 static PyObject *
 surf_unmap_rgb(PyObject *self, PyObject *arg);
@@ -131,17 +143,30 @@ surf_convert(pgSurfaceObject *self, PyObject *args);
 static PyObject *
 surf_convert_alpha(pgSurfaceObject *self, PyObject *args);
 static PyObject *
+surf_convert_many(PyObject *self, PyObject *args, PyObject *kwargs);
+static PyObject *
 surf_set_clip(PyObject *self, PyObject *args);
 static PyObject *
 surf_get_clip(PyObject *self, PyObject *args);
 static PyObject *
-surf_blit(pgSurfaceObject *self, PyObject *args, PyObject *keywds);
+surf_blit(pgSurfaceObject *self, PyObject *const *args, Py_ssize_t nargs,
+          PyObject *kwnames);
 static PyObject *
 surf_blits(pgSurfaceObject *self, PyObject *args, PyObject *keywds);
 static PyObject *
 surf_fblits(pgSurfaceObject *self, PyObject *const *args, Py_ssize_t nargs);
 static PyObject *
-surf_fill(pgSurfaceObject *self, PyObject *args, PyObject *keywds);
+surf_blit_transformed(pgSurfaceObject *self, PyObject *args,
+                      PyObject *kwargs);
+static PyObject *
+surf_blit_tiled(pgSurfaceObject *self, PyObject *args, PyObject *kwargs);
+static PyObject *
+surf_blit_tilemap(pgSurfaceObject *self, PyObject *args, PyObject *kwargs);
+static PyObject *
+surf_fill(pgSurfaceObject *self, PyObject *const *args, Py_ssize_t nargs,
+          PyObject *kwnames);
+static PyObject *
+surf_fill_many(pgSurfaceObject *self, PyObject *args, PyObject *keywds);
 static PyObject *
 surf_scroll(PyObject *self, PyObject *args, PyObject *keywds);
 static PyObject *
@@ -185,15 +210,31 @@ surf_get_parent(PyObject *self, PyObject *args);
 static PyObject *
 surf_subsurface(PyObject *self, PyObject *args);
 static PyObject *
+surf_subsurfaces(PyObject *self, PyObject *args, PyObject *kwargs);
+static PyObject *
+_surf_subsurface(PyObject *self, SDL_Rect *rect);
+static PyObject *
 surf_get_view(PyObject *self, PyObject *args);
 static PyObject *
 surf_get_buffer(PyObject *self, PyObject *args);
 static PyObject *
+surf_from_shared_memory(PyObject *self, PyObject *args, PyObject *kwargs);
+static PyObject *
+surf_to_shared_memory(PyObject *self, PyObject *args, PyObject *kwargs);
+static PyObject *
+surf_from_buffer(PyObject *self, PyObject *args, PyObject *kwargs);
+static PyObject *
 surf_get_bounding_rect(PyObject *self, PyObject *args, PyObject *kwargs);
 static PyObject *
 surf_get_pixels_address(PyObject *self, PyObject *closure);
 static PyObject *
 surf_premul_alpha(pgSurfaceObject *self, PyObject *args);
+static PyObject *
+surf_premul_alpha_ip(pgSurfaceObject *self, PyObject *args);
+static PyObject *
+surf_get_premultiplied(pgSurfaceObject *self, void *closure);
+static int
+surf_set_premultiplied(pgSurfaceObject *self, PyObject *value, void *closure);
 static int
 _view_kind(PyObject *obj, void *view_kind_vptr);
 static int
@@ -216,30 +257,69 @@ static int
 _get_buffer_colorplane(PyObject *obj, Py_buffer *view_p, int flags, char *name,
                        Uint32 mask);
 static int
+_surf_channel_offset(SDL_PixelFormat *format, Uint32 mask);
+static int
 _init_buffer(PyObject *surf, Py_buffer *view_p, int flags);
 static void
 _release_buffer(Py_buffer *view_p);
 static PyObject *
 _raise_get_view_ndim_error(int bitsize, SurfViewKind kind);
 static SDL_Surface *
+_surf_convert_fast(SDL_Surface *surf, Uint32 pfe, int threaded);
+static SDL_Surface *
+_surf_convert_surface(SDL_Surface *surf, SDL_PixelFormat *format,
+                      int threaded);
+static Uint32
+_surf_alpha_format(void);
+static SDL_Surface *
 pg_DisplayFormatAlpha(SDL_Surface *surface);
 static SDL_Surface *
 pg_DisplayFormat(SDL_Surface *surface);
 static int
 _PgSurface_SrcAlpha(SDL_Surface *surf);
 
+static void
+pgSurface_AddDirtyRect(pgSurfaceObject *surfobj, SDL_Rect *rect);
+static PyObject *
+surf_set_dirty_tracking(pgSurfaceObject *self, PyObject *arg);
+static PyObject *
+surf_set_alpha_spans(pgSurfaceObject *self, PyObject *arg);
+static pg_AlphaSpans *
+_surf_alpha_spans(pgSurfaceObject *surfobj);
+static PyObject *
+surf_get_dirty_rects(pgSurfaceObject *self, PyObject *args,
+                     PyObject *kwargs);
+static PyObject *
+surf_get_version(pgSurfaceObject *self, PyObject *_null);
+static PyObject *
+surf_snapshot(pgSurfaceObject *self, PyObject *_null);
+static PyObject *
+surf_restore(pgSurfaceObject *self, PyObject *arg);
+static void
+_history_free(struct pgSurfaceHistory *hist);
+
+static PyTypeObject pgBlitBatch_Type;
+static PyTypeObject pgSurfaceSnapshot_Type;
+static PyTypeObject pgSurfaceView_Type;
+
 static PyGetSetDef surface_getsets[] = {
     {"_pixels_address", (getter)surf_get_pixels_address, NULL,
      "pixel buffer address (readonly)", NULL},
     {"width", (getter)surf_get_width, NULL, DOC_SURFACE_WIDTH, NULL},
     {"height", (getter)surf_get_height, NULL, DOC_SURFACE_HEIGHT, NULL},
     {"size", (getter)surf_get_size, NULL, DOC_SURFACE_SIZE, NULL},
+    {"premultiplied", (getter)surf_get_premultiplied,
+     (setter)surf_set_premultiplied, DOC_SURFACE_PREMULTIPLIED, NULL},
     {NULL, NULL, NULL, NULL, NULL}};
 
 static struct PyMethodDef surface_methods[] = {
     {"get_at", surf_get_at, METH_O, DOC_SURFACE_GETAT},
     {"set_at", (PyCFunction)surf_set_at, METH_FASTCALL, DOC_SURFACE_SETAT},
     {"get_at_mapped", surf_get_at_mapped, METH_O, DOC_SURFACE_GETATMAPPED},
+    {"get_at_many", (PyCFunction)surf_get_at_many,
+     METH_VARARGS | METH_KEYWORDS, DOC_SURFACE_GETATMANY},
+    {"set_at_many", (PyCFunction)surf_set_at_many,
+     METH_VARARGS | METH_KEYWORDS, DOC_SURFACE_SETATMANY},
     {"map_rgb", surf_map_rgb, METH_VARARGS, DOC_SURFACE_MAPRGB},
     {"unmap_rgb", surf_unmap_rgb, METH_O, DOC_SURFACE_UNMAPRGB},
 
@@ -273,17 +353,27 @@ static struct PyMethodDef surface_methods[] = {
     {"convert", (PyCFunction)surf_convert, METH_VARARGS, DOC_SURFACE_CONVERT},
     {"convert_alpha", (PyCFunction)surf_convert_alpha, METH_VARARGS,
      DOC_SURFACE_CONVERTALPHA},
+    {"convert_many", (PyCFunction)surf_convert_many,
+     METH_VARARGS | METH_KEYWORDS | METH_STATIC, DOC_SURFACE_CONVERTMANY},
 
     {"set_clip", surf_set_clip, METH_VARARGS, DOC_SURFACE_SETCLIP},
     {"get_clip", surf_get_clip, METH_NOARGS, DOC_SURFACE_GETCLIP},
 
-    {"fill", (PyCFunction)surf_fill, METH_VARARGS | METH_KEYWORDS,
+    {"fill", (PyCFunction)surf_fill, METH_FASTCALL | METH_KEYWORDS,
      DOC_SURFACE_FILL},
-    {"blit", (PyCFunction)surf_blit, METH_VARARGS | METH_KEYWORDS,
+    {"fill_many", (PyCFunction)surf_fill_many, METH_VARARGS | METH_KEYWORDS,
+     DOC_SURFACE_FILLMANY},
+    {"blit", (PyCFunction)surf_blit, METH_FASTCALL | METH_KEYWORDS,
      DOC_SURFACE_BLIT},
     {"blits", (PyCFunction)surf_blits, METH_VARARGS | METH_KEYWORDS,
      DOC_SURFACE_BLITS},
     {"fblits", (PyCFunction)surf_fblits, METH_FASTCALL, DOC_SURFACE_FBLITS},
+    {"blit_transformed", (PyCFunction)surf_blit_transformed,
+     METH_VARARGS | METH_KEYWORDS, DOC_SURFACE_BLITTRANSFORMED},
+    {"blit_tiled", (PyCFunction)surf_blit_tiled,
+     METH_VARARGS | METH_KEYWORDS, DOC_SURFACE_BLITTILED},
+    {"blit_tilemap", (PyCFunction)surf_blit_tilemap,
+     METH_VARARGS | METH_KEYWORDS, DOC_SURFACE_BLITTILEMAP},
     {"scroll", (PyCFunction)surf_scroll, METH_VARARGS | METH_KEYWORDS,
      DOC_SURFACE_SCROLL},
 
@@ -306,6 +396,8 @@ static struct PyMethodDef surface_methods[] = {
     {"get_losses", surf_get_losses, METH_NOARGS, DOC_SURFACE_GETLOSSES},
 
     {"subsurface", surf_subsurface, METH_VARARGS, DOC_SURFACE_SUBSURFACE},
+    {"subsurfaces", (PyCFunction)surf_subsurfaces,
+     METH_VARARGS | METH_KEYWORDS, DOC_SURFACE_SUBSURFACES},
     {"get_offset", surf_get_offset, METH_NOARGS, DOC_SURFACE_GETOFFSET},
     {"get_abs_offset", surf_get_abs_offset, METH_NOARGS,
      DOC_SURFACE_GETABSOFFSET},
@@ -316,8 +408,28 @@ static struct PyMethodDef surface_methods[] = {
      METH_VARARGS | METH_KEYWORDS, DOC_SURFACE_GETBOUNDINGRECT},
     {"get_view", surf_get_view, METH_VARARGS, DOC_SURFACE_GETVIEW},
     {"get_buffer", surf_get_buffer, METH_NOARGS, DOC_SURFACE_GETBUFFER},
+    {"from_shared_memory", (PyCFunction)surf_from_shared_memory,
+     METH_VARARGS | METH_KEYWORDS | METH_STATIC,
+     DOC_SURFACE_FROMSHAREDMEMORY},
+    {"to_shared_memory", (PyCFunction)surf_to_shared_memory,
+     METH_VARARGS | METH_KEYWORDS, DOC_SURFACE_TOSHAREDMEMORY},
+    {"from_buffer", (PyCFunction)surf_from_buffer,
+     METH_VARARGS | METH_KEYWORDS | METH_STATIC, DOC_SURFACE_FROMBUFFER},
     {"premul_alpha", (PyCFunction)surf_premul_alpha, METH_NOARGS,
      DOC_SURFACE_PREMULALPHA},
+    {"premul_alpha_ip", (PyCFunction)surf_premul_alpha_ip, METH_NOARGS,
+     DOC_SURFACE_PREMULALPHAIP},
+    {"set_alpha_spans", (PyCFunction)surf_set_alpha_spans, METH_O,
+     DOC_SURFACE_SETALPHASPANS},
+    {"set_dirty_tracking", (PyCFunction)surf_set_dirty_tracking, METH_O,
+     DOC_SURFACE_SETDIRTYTRACKING},
+    {"get_dirty_rects", (PyCFunction)surf_get_dirty_rects,
+     METH_VARARGS | METH_KEYWORDS, DOC_SURFACE_GETDIRTYRECTS},
+    {"get_version", (PyCFunction)surf_get_version, METH_NOARGS,
+     DOC_SURFACE_GETVERSION},
+    {"snapshot", (PyCFunction)surf_snapshot, METH_NOARGS,
+     DOC_SURFACE_SNAPSHOT},
+    {"restore", (PyCFunction)surf_restore, METH_O, DOC_SURFACE_RESTORE},
 
     {NULL, NULL, 0, NULL}};
 
@@ -344,6 +456,257 @@ pgSurface_New2(SDL_Surface *s, int owner)
     return (pgSurfaceObject *)surf_subtype_new(&pgSurface_Type, s, owner);
 }
 
+/* surface memory accounting, see pgSurfaceMemStats */
+static void
+_surf_mem_add(pgSurfaceMemCounter *counter, Sint64 count, Sint64 bytes)
+{
+    counter->count += count;
+    counter->bytes += bytes;
+    if (counter->count > counter->peak_count) {
+        counter->peak_count = counter->count;
+    }
+    if (counter->bytes > counter->peak_bytes) {
+        counter->peak_bytes = counter->bytes;
+    }
+}
+
+static pgSurfaceMemCounter *
+_surf_mem_format(pgSurfaceMemStats *stats, Uint32 format)
+{
+    int i;
+
+    for (i = 0; i < stats->num_formats; i++) {
+        if (stats->formats[i] == format) {
+            return stats->by_format + i;
+        }
+    }
+    if (stats->num_formats == PG_SURF_MAX_FORMATS) {
+        return NULL;
+    }
+    stats->formats[stats->num_formats] = format;
+    return stats->by_format + stats->num_formats++;
+}
+
+/* Counts the SDL surface if the object owns it. Surfaces that don't own
+ * their pixels, like subsurfaces, count with 0 bytes. */
+static void
+_surf_mem_track(pgSurfaceObject *self)
+{
+    pgSurfaceMemStats *stats = pg_surface_memory;
+    pgSurfaceMemCounter *counter;
+    SDL_Surface *surf = self->surf;
+
+    if (!surf || !self->owner || self->mem_bytes >= 0) {
+        return;
+    }
+    self->mem_bytes = 0;
+    if (!(surf->flags & SDL_PREALLOC)) {
+        self->mem_bytes = (Sint64)surf->h * surf->pitch;
+    }
+    self->mem_format = surf->format->format;
+
+    pg_LockState(PG_STATE_SURFACE_MEMORY);
+    _surf_mem_add(&stats->total, 1, self->mem_bytes);
+    _surf_mem_add(stats->origins + self->origin, 1, self->mem_bytes);
+    if ((counter = _surf_mem_format(stats, self->mem_format))) {
+        _surf_mem_add(counter, 1, self->mem_bytes);
+    }
+    pg_UnlockState(PG_STATE_SURFACE_MEMORY);
+}
+
+static void
+_surf_mem_untrack(pgSurfaceObject *self)
+{
+    pgSurfaceMemStats *stats = pg_surface_memory;
+    pgSurfaceMemCounter *counter;
+
+    if (self->mem_bytes < 0) {
+        return;
+    }
+    pg_LockState(PG_STATE_SURFACE_MEMORY);
+    _surf_mem_add(&stats->total, -1, -self->mem_bytes);
+    _surf_mem_add(stats->origins + self->origin, -1, -self->mem_bytes);
+    if ((counter = _surf_mem_format(stats, self->mem_format))) {
+        _surf_mem_add(counter, -1, -self->mem_bytes);
+    }
+    pg_UnlockState(PG_STATE_SURFACE_MEMORY);
+    self->mem_bytes = -1;
+}
+
+/* Surfaces freed by transform and font results, recycled by
+ * pgSurface_CreatePooled() for the next result of the same size and format.
+ * Such results are usually thrown away every frame. Off unless
+ * pygame.surface.set_pool_limit() was called. */
+#define PG_SURF_POOL_SIZE 32
+
+static struct {
+    Sint64 limit; /* in bytes, 0 if disabled */
+    Sint64 bytes;
+    int count;
+    Uint64 hits;
+    Uint64 misses;
+    SDL_Surface *entries[PG_SURF_POOL_SIZE]; /* the oldest first */
+    pg_mutex lock; /* held by the functions below that take the pool */
+} surf_pool;
+
+static int surf_pool_quit_registered = 0;
+
+static SDL_Surface *
+_surf_pool_remove(int i)
+{
+    SDL_Surface *surf = surf_pool.entries[i];
+
+    surf_pool.bytes -= (Sint64)surf->h * surf->pitch;
+    surf_pool.count--;
+    memmove(surf_pool.entries + i, surf_pool.entries + i + 1,
+            (surf_pool.count - i) * sizeof(SDL_Surface *));
+    return surf;
+}
+
+/* Frees the oldest surfaces until the pool holds at most bytes */
+static void
+_surf_pool_trim(Sint64 bytes)
+{
+    while (surf_pool.count && surf_pool.bytes > bytes) {
+        SDL_FreeSurface(_surf_pool_remove(0));
+    }
+}
+
+static void
+_surf_pool_quit(void)
+{
+    pg_mutex_lock(&surf_pool.lock);
+    _surf_pool_trim(-1);
+    surf_pool_quit_registered = 0;
+    pg_mutex_unlock(&surf_pool.lock);
+}
+
+/* Takes over the surface of an object being cleaned up. Returns 0 if it
+ * can't be pooled and has to be freed. Indexed and RLE surfaces would need
+ * too much state reset, and someone else may still use a shared one. */
+static int
+_surf_pool_put(pgSurfaceObject *self)
+{
+    SDL_Surface *surf = self->surf;
+    Sint64 bytes = (Sint64)surf->h * surf->pitch;
+    int pooled = 0;
+
+    if ((self->origin != PG_SURF_ORIGIN_TRANSFORM &&
+         self->origin != PG_SURF_ORIGIN_FONT) ||
+        surf->refcount != 1 || (surf->flags & SDL_PREALLOC) ||
+        SDL_ISPIXELFORMAT_INDEXED(surf->format->format) ||
+        PG_SurfaceHasRLE(surf)) {
+        return 0;
+    }
+    pg_mutex_lock(&surf_pool.lock);
+    if (surf_pool.limit && bytes <= surf_pool.limit) {
+        if (surf_pool.count == PG_SURF_POOL_SIZE) {
+            SDL_FreeSurface(_surf_pool_remove(0));
+        }
+        _surf_pool_trim(surf_pool.limit - bytes);
+        surf_pool.entries[surf_pool.count++] = surf;
+        surf_pool.bytes += bytes;
+        pooled = 1;
+    }
+    pg_mutex_unlock(&surf_pool.lock);
+    return pooled;
+}
+
+/* The row alignment of new surfaces, in bytes. Above 4, the SDL default,
+ * Surface() and pgSurface_CreatePooled() pad the pitch to a multiple of it
+ * and allocate SIMD aligned pixels, so that the SIMD kernels can take their
+ * aligned paths. Set by pygame.surface.set_row_alignment(). */
+static int surf_row_alignment = 0;
+
+/* PG_CreateSurface() with the rows aligned to surf_row_alignment */
+static SDL_Surface *
+_surf_create(int width, int height, Uint32 format)
+{
+#if !SDL_VERSION_ATLEAST(3, 0, 0)
+    SDL_Surface *surf;
+    Sint64 pitch, size;
+    void *pixels;
+    int align = surf_row_alignment;
+
+    if (align <= 4 || width <= 0 || height <= 0) {
+        return PG_CreateSurface(width, height, format);
+    }
+    pitch = ((Sint64)width * SDL_BYTESPERPIXEL(format) + align - 1) &
+            ~(Sint64)(align - 1);
+    size = pitch * height;
+    if (pitch > INT_MAX || size > INT_MAX) {
+        /* SDL says it is too large */
+        return PG_CreateSurface(width, height, format);
+    }
+
+#ifdef SDL_SIMD_ALIGNED
+    pixels = SDL_SIMDAlloc((size_t)size);
+#else
+    pixels = SDL_malloc((size_t)size);
+#endif
+    if (!pixels) {
+        SDL_OutOfMemory();
+        return NULL;
+    }
+    memset(pixels, 0, (size_t)size);
+    surf = PG_CreateSurfaceFrom(pixels, width, height, (int)pitch, format);
+    if (!surf) {
+#ifdef SDL_SIMD_ALIGNED
+        SDL_SIMDFree(pixels);
+#else
+        SDL_free(pixels);
+#endif
+        return NULL;
+    }
+    /* SDL frees the pixels with the surface, like the ones it allocates */
+    surf->flags &= ~SDL_PREALLOC;
+#ifdef SDL_SIMD_ALIGNED
+    surf->flags |= SDL_SIMD_ALIGNED;
+#endif
+    return surf;
+#else
+    return PG_CreateSurface(width, height, format);
+#endif
+}
+
+/* PG_CreateSurface(), but reuses a pooled surface if there is one. It comes
+ * back cleared, and with the colorkey, modulation, blend mode and clip of a
+ * new surface. */
+static SDL_Surface *
+pgSurface_CreatePooled(int width, int height, Uint32 format)
+{
+    SDL_Surface *surf = NULL;
+    int i;
+
+    pg_mutex_lock(&surf_pool.lock);
+    for (i = surf_pool.count - 1; i >= 0; i--) {
+        if (surf_pool.entries[i]->w == width &&
+            surf_pool.entries[i]->h == height &&
+            surf_pool.entries[i]->format->format == format) {
+            surf = _surf_pool_remove(i);
+            surf_pool.hits++;
+            break;
+        }
+    }
+    if (!surf && surf_pool.limit) {
+        surf_pool.misses++;
+    }
+    pg_mutex_unlock(&surf_pool.lock);
+
+    if (surf) {
+        SDL_SetColorKey(surf, SDL_FALSE, 0);
+        SDL_SetSurfaceAlphaMod(surf, 255);
+        SDL_SetSurfaceColorMod(surf, 255, 255, 255);
+        SDL_SetSurfaceBlendMode(surf, SDL_ISPIXELFORMAT_ALPHA(format)
+                                          ? SDL_BLENDMODE_BLEND
+                                          : SDL_BLENDMODE_NONE);
+        SDL_SetClipRect(surf, NULL);
+        memset(surf->pixels, 0, (size_t)surf->h * surf->pitch);
+        return surf;
+    }
+    return _surf_create(width, height, format);
+}
+
 static int
 pgSurface_SetSurface(pgSurfaceObject *self, SDL_Surface *s, int owner)
 {
@@ -352,16 +715,45 @@ pgSurface_SetSurface(pgSurfaceObject *self, SDL_Surface *s, int owner)
         return -1;
     }
     if (s == self->surf) {
+        if (!owner) {
+            _surf_mem_untrack(self);
+        }
         self->owner = owner;
+        _surf_mem_track(self);
+        self->version++;
         return 0;
     }
 
     surface_cleanup(self);
     self->surf = s;
     self->owner = owner;
+    _surf_mem_track(self);
     return 0;
 }
 
+static pgSurfaceObject *
+pgSurface_NewWithOrigin(SDL_Surface *s, int owner, int origin)
+{
+    pgSurfaceObject *self;
+
+    if (!s) {
+        return (pgSurfaceObject *)RAISE(pgExc_SDLError, SDL_GetError());
+    }
+    self = (pgSurfaceObject *)pgSurface_Type.tp_new(&pgSurface_Type, NULL,
+                                                     NULL);
+    if (!self) {
+        return NULL;
+    }
+    if (origin >= 0 && origin < PG_SURF_NUM_ORIGINS) {
+        self->origin = origin;
+    }
+    if (pgSurface_SetSurface(self, s, owner)) {
+        Py_DECREF(self);
+        return NULL;
+    }
+    return self;
+}
+
 static PyObject *
 surf_subtype_new(PyTypeObject *type, SDL_Surface *s, int owner)
 {
@@ -391,18 +783,199 @@ surface_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
         self->weakreflist = NULL;
         self->dependency = NULL;
         self->locklist = NULL;
+        self->selflocks = 0;
+        self->dirty = NULL;
+        self->version = 0;
+        self->origin = PG_SURF_ORIGIN_SURFACE;
+        self->mem_bytes = -1;
+        self->mem_format = 0;
+        self->premultiplied = 0;
+        self->alpha_spans = NULL;
+        self->shared = NULL;
+        self->history = NULL;
+        self->accelerated = 0;
+        self->texture = NULL;
+        self->canvas = NULL;
     }
     return (PyObject *)self;
 }
 
+/* Copy-on-write. While on, Surface.copy() gives a surface that reads the
+ * pixels of the original, both marked SDL_PREALLOC so SDL leaves freeing
+ * them to the pgSharedPixels. pgSurface_LockBy() and writes that don't lock
+ * call pgSurface_Unshare() first, which copies the pixels for the surface
+ * or, for the last one left, hands them back to it. The SDL_Surface itself
+ * stays the same, callers may hold on to it across the lock. */
+static int surf_copy_on_write = 0;
+
+static void
+_surf_free_pixels(void *pixels, int simd_aligned)
+{
+#ifdef SDL_SIMD_ALIGNED
+    if (simd_aligned) {
+        SDL_SIMDFree(pixels);
+        return;
+    }
+#endif
+    SDL_free(pixels);
+}
+
+/* Drops a surface's use of the pixels. Returns 1 if it was the last, then
+ * the pixels are freed too, unless free_pixels is 0. */
+static int
+_surf_shared_release(pgSharedPixels *shared, int free_pixels)
+{
+    int last;
+
+    pg_mutex_lock(&shared->lock);
+    last = --shared->count == 0;
+    pg_mutex_unlock(&shared->lock);
+    if (last) {
+        if (free_pixels) {
+            _surf_free_pixels(shared->pixels, shared->simd_aligned);
+        }
+        free(shared);
+    }
+    return last;
+}
+
+#if !SDL_VERSION_ATLEAST(3, 0, 0)
+static int
+_surf_unshare(PyObject *obj)
+{
+    pgSurfaceObject *self = (pgSurfaceObject *)obj;
+    pgSharedPixels *shared = self->shared;
+    SDL_Surface *surf = self->surf;
+    size_t size = (size_t)surf->h * surf->pitch;
+#ifdef SDL_SIMD_ALIGNED
+    int simd_aligned = shared->simd_aligned;
+#endif
+    void *pixels = NULL;
+    int alone;
+
+    pg_mutex_lock(&shared->lock);
+    alone = shared->count == 1;
+    pg_mutex_unlock(&shared->lock);
+    if (!alone) {
+        /* copy before letting go, the others may free them right after */
+        pixels = SDL_malloc(size ? size : 1);
+        if (!pixels) {
+            SDL_OutOfMemory();
+            PyErr_NoMemory();
+            return 0;
+        }
+        memcpy(pixels, surf->pixels, size);
+    }
+
+    _surf_mem_untrack(self);
+    self->shared = NULL;
+    /* if the others left while copying, the old pixels go */
+    _surf_shared_release(shared, pixels != NULL);
+    if (pixels) {
+        surf->pixels = pixels;
+        surf->flags &= ~SDL_PREALLOC;
+#ifdef SDL_SIMD_ALIGNED
+        surf->flags &= ~SDL_SIMD_ALIGNED;
+#endif
+    }
+    else {
+        surf->flags &= ~SDL_PREALLOC;
+#ifdef SDL_SIMD_ALIGNED
+        if (simd_aligned) {
+            surf->flags |= SDL_SIMD_ALIGNED;
+        }
+#endif
+    }
+    _surf_mem_track(self);
+    return 1;
+}
+#endif /* !SDL_VERSION_ATLEAST(3, 0, 0) */
+
+/* Returns a new SDL surface reading the pixels of self, with the same
+ * format, palette, colorkey and blending, or NULL with no error set if
+ * they can't be shared. */
+static SDL_Surface *
+_surf_share(pgSurfaceObject *self)
+{
+#if SDL_VERSION_ATLEAST(3, 0, 0)
+    return NULL;
+#else
+    SDL_Surface *surf = self->surf, *newsurf;
+    pgSharedPixels *shared = self->shared;
+    SDL_BlendMode mode;
+    Uint32 key;
+    Uint8 r, g, b, a;
+
+    /* subsurfaces are written through their owner, locked surfaces by
+     * whoever holds the pixels, and the display surface by the
+     * renderer. SDL moves the pixels of RLE surfaces, and external pixels
+     * have to stay where they are. */
+    if (!surf_copy_on_write || self->subsurface || self->selflocks ||
+        (self->locklist && PyList_GET_SIZE(self->locklist)) ||
+        surf->locked ||
+        (surf->flags & (SDL_DONTFREE | SDL_RLEACCEL | SDL_RLEACCELOK)) ||
+        (!shared && (surf->flags & SDL_PREALLOC))) {
+        return NULL;
+    }
+
+    newsurf = PG_CreateSurfaceFrom(surf->pixels, surf->w, surf->h,
+                                   surf->pitch, surf->format->format);
+    if (!newsurf) {
+        return NULL;
+    }
+    if (surf->format->palette && newsurf->format->palette) {
+        SDL_SetPaletteColors(newsurf->format->palette,
+                             surf->format->palette->colors, 0,
+                             surf->format->palette->ncolors);
+    }
+    if (SDL_GetColorKey(surf, &key) == 0) {
+        SDL_SetColorKey(newsurf, SDL_TRUE, key);
+    }
+    SDL_GetSurfaceColorMod(surf, &r, &g, &b);
+    SDL_SetSurfaceColorMod(newsurf, r, g, b);
+    SDL_GetSurfaceAlphaMod(surf, &a);
+    SDL_SetSurfaceAlphaMod(newsurf, a);
+    SDL_GetSurfaceBlendMode(surf, &mode);
+    SDL_SetSurfaceBlendMode(newsurf, mode);
+
+    if (!shared) {
+        shared = calloc(1, sizeof(pgSharedPixels));
+        if (!shared) {
+            SDL_FreeSurface(newsurf);
+            return NULL;
+        }
+        shared->pixels = surf->pixels;
+        shared->count = 1;
+        shared->unshare = _surf_unshare;
+#ifdef SDL_SIMD_ALIGNED
+        shared->simd_aligned = (surf->flags & SDL_SIMD_ALIGNED) != 0;
+        surf->flags &= ~SDL_SIMD_ALIGNED;
+#endif
+        surf->flags |= SDL_PREALLOC;
+        self->shared = shared;
+    }
+    pg_mutex_lock(&shared->lock);
+    shared->count++;
+    pg_mutex_unlock(&shared->lock);
+    return newsurf;
+#endif
+}
+
 /* surface object internals */
 static void
 surface_cleanup(pgSurfaceObject *self)
 {
+    _surf_mem_untrack(self);
     if (self->surf && self->owner) {
-        SDL_FreeSurface(self->surf);
+        if (!_surf_pool_put(self)) {
+            SDL_FreeSurface(self->surf);
+        }
         self->surf = NULL;
     }
+    if (self->shared) {
+        _surf_shared_release(self->shared, 1);
+        self->shared = NULL;
+    }
     if (self->subsurface) {
         Py_XDECREF(self->subsurface->owner);
         PyMem_Free(self->subsurface);
@@ -417,7 +990,18 @@ surface_cleanup(pgSurfaceObject *self)
         Py_DECREF(self->locklist);
         self->locklist = NULL;
     }
+    self->selflocks = 0;
+    if (self->dirty) {
+        self->dirty->count = 0;
+    }
+    _history_free(self->history);
+    self->history = NULL;
+    if (self->texture) {
+        self->texture->release(self->texture);
+        self->texture = NULL;
+    }
     self->owner = 0;
+    self->version++;
 }
 
 static void
@@ -426,59 +1010,476 @@ surface_dealloc(PyObject *self)
     if (((pgSurfaceObject *)self)->weakreflist)
         PyObject_ClearWeakRefs(self);
     surface_cleanup((pgSurfaceObject *)self);
+    PyMem_Free(((pgSurfaceObject *)self)->dirty);
+    pg_alpha_spans_free(((pgSurfaceObject *)self)->alpha_spans);
     Py_TYPE(self)->tp_free(self);
 }
 
-static PyObject *
-surface_str(PyObject *self)
+/* dirty rect tracking */
+
+/* Returns the area of the smallest rect containing both a and b */
+static Sint64
+_dirty_union_area(const SDL_Rect *a, const SDL_Rect *b)
 {
-    SDL_Surface *surf = pgSurface_AsSurface(self);
+    int x1 = MIN(a->x, b->x);
+    int y1 = MIN(a->y, b->y);
+    int x2 = MAX(a->x + a->w, b->x + b->w);
+    int y2 = MAX(a->y + a->h, b->y + b->h);
 
-    if (!surf) {
-        return PyUnicode_FromString("<Surface(Dead Display)>");
+    return (Sint64)(x2 - x1) * (y2 - y1);
+}
+
+static void
+_dirty_union(SDL_Rect *a, const SDL_Rect *b)
+{
+    int x1 = MIN(a->x, b->x);
+    int y1 = MIN(a->y, b->y);
+    int x2 = MAX(a->x + a->w, b->x + b->w);
+    int y2 = MAX(a->y + a->h, b->y + b->h);
+
+    a->x = x1;
+    a->y = y1;
+    a->w = x2 - x1;
+    a->h = y2 - y1;
+}
+
+/* Adds rect to the tracker, coalescing it with the rects already recorded.
+ * Two rects are merged when their union covers no more pixels than the two
+ * of them separately, which takes care of overlapping, nested and touching
+ * rects without growing the update area. Once the tracker is full, a new
+ * rect is merged into the recorded rect it grows the least. */
+static void
+_dirty_add(pgSurfaceDirtyRects *dirty, SDL_Rect rect)
+{
+    int i, best;
+    Sint64 area, growth, best_growth;
+
+    for (;;) {
+        area = (Sint64)rect.w * rect.h;
+        for (i = 0; i < dirty->count; i++) {
+            SDL_Rect *cur = &dirty->rects[i];
+            if (_dirty_union_area(cur, &rect) <=
+                (Sint64)cur->w * cur->h + area) {
+                break;
+            }
+        }
+        if (i == dirty->count) {
+            break;
+        }
+        /* take the merged rect out, and try to place it again */
+        _dirty_union(&rect, &dirty->rects[i]);
+        dirty->rects[i] = dirty->rects[--dirty->count];
     }
 
-    PyObject *colorkey = surf_get_colorkey((pgSurfaceObject *)self, NULL);
-    if (colorkey == NULL) {
-        return NULL;
+    if (dirty->count < PG_SURF_MAX_DIRTY_RECTS) {
+        dirty->rects[dirty->count++] = rect;
+        return;
     }
-    PyObject *global_alpha = surf_get_alpha((pgSurfaceObject *)self, NULL);
-    if (global_alpha == NULL) {
-        Py_DECREF(colorkey);
-        return NULL;
+
+    best = 0;
+    best_growth = -1;
+    for (i = 0; i < dirty->count; i++) {
+        SDL_Rect *cur = &dirty->rects[i];
+        growth = _dirty_union_area(cur, &rect) - (Sint64)cur->w * cur->h;
+        if (best_growth < 0 || growth < best_growth) {
+            best = i;
+            best_growth = growth;
+        }
     }
+    _dirty_union(&rect, &dirty->rects[best]);
+    dirty->rects[best] = dirty->rects[--dirty->count];
+    _dirty_add(dirty, rect);
+}
 
-    // 49 is max len of format str, plus null terminator
-    char format[50] = "<Surface(%dx%dx%d";
-    if (PyObject_IsTrue(colorkey)) {
-        strcat(format, ", colorkey=%S");
+/* Surface.snapshot() undo history. The pixels are handled in square tiles
+ * of PG_SNAPSHOT_TILE pixels, rows packed. The history keeps a copy of the
+ * whole surface as it was at the latest snapshot, and every older snapshot
+ * the tiles that changed between it and the next one, as they were when it
+ * was taken. Tiles written to since the latest snapshot are found from the
+ * rects pgSurface_AddDirtyRect() gets; any other change of the version
+ * means every tile has to be compared with the copy. */
+#define PG_SNAPSHOT_TILE 64
+
+typedef struct pgSurfaceSnapshotObject {
+    PyObject_HEAD PyObject *surface; /* weakref to the surface */
+    Uint64 history_id;
+    struct pgSurfaceSnapshotObject *next; /* newer snapshot, or NULL */
+    Py_ssize_t count;                     /* tiles stored */
+    int *tiles;                           /* their indices, ascending */
+    size_t *offsets;                      /* their pixels in data */
+    Uint8 *data;
+} pgSurfaceSnapshotObject;
+
+typedef struct pgSurfaceHistory {
+    Uint64 id;
+    int w, h, bpp;
+    Uint32 format;
+    int tiles_x, tiles_y;
+    Uint8 *changed; /* per tile, written to since the latest snapshot */
+    int unknown;    /* pixels written to outside of any rect */
+    Uint64 seen_version;
+    Uint8 *pixels; /* the surface at the latest snapshot */
+    pgSurfaceSnapshotObject *latest;
+} pgSurfaceHistory;
+
+static Uint64 _history_next_id = 0;
+
+/* Copies rows of rowbytes bytes from src to dst */
+static void
+_history_copy_rows(Uint8 *dst, size_t dst_pitch, const Uint8 *src,
+                   size_t src_pitch, size_t rowbytes, int rows)
+{
+    for (; rows > 0; rows--, dst += dst_pitch, src += src_pitch) {
+        memcpy(dst, src, rowbytes);
     }
-    if (PyObject_IsTrue(global_alpha)) {
-        strcat(format, ", global_alpha=%S");
+}
+
+static void
+_history_free(pgSurfaceHistory *hist)
+{
+    if (!hist) {
+        return;
     }
-    strcat(format, ")>");
+    Py_XDECREF(hist->latest);
+    PyMem_Free(hist->changed);
+    PyMem_Free(hist->pixels);
+    PyMem_Free(hist);
+}
 
-    // Because PyUnicode_FromFormat ignores extra args, if we have no colorkey,
-    // but alpha, we can "move up" the global alpha to this spot No need to do
-    // this vice-versa, as it ignores extra args
-    PyObject *formatted_str = PyUnicode_FromFormat(
-        format, surf->w, surf->h, PG_SURF_BitsPerPixel(surf),
-        PyObject_IsTrue(colorkey) ? colorkey : global_alpha, global_alpha);
+static pgSurfaceHistory *
+_history_new(SDL_Surface *surf)
+{
+    pgSurfaceHistory *hist = PyMem_New(pgSurfaceHistory, 1);
+    size_t ntiles;
 
-    Py_DECREF(colorkey);
-    Py_DECREF(global_alpha);
+    if (!hist) {
+        return NULL;
+    }
+    hist->id = ++_history_next_id;
+    hist->w = surf->w;
+    hist->h = surf->h;
+    hist->bpp = PG_SURF_BytesPerPixel(surf);
+    hist->format = surf->format->format;
+    hist->tiles_x = (surf->w + PG_SNAPSHOT_TILE - 1) / PG_SNAPSHOT_TILE;
+    hist->tiles_y = (surf->h + PG_SNAPSHOT_TILE - 1) / PG_SNAPSHOT_TILE;
+    hist->unknown = 0;
+    hist->seen_version = 0;
+    hist->latest = NULL;
+    ntiles = (size_t)hist->tiles_x * hist->tiles_y;
+    hist->changed = PyMem_Calloc(ntiles ? ntiles : 1, 1);
+    hist->pixels =
+        PyMem_Malloc((size_t)surf->w * hist->bpp * surf->h + 1);
+    if (!hist->changed || !hist->pixels) {
+        _history_free(hist);
+        return NULL;
+    }
+    _history_copy_rows(hist->pixels, (size_t)surf->w * hist->bpp,
+                       surf->pixels, surf->pitch,
+                       (size_t)surf->w * hist->bpp, surf->h);
+    return hist;
+}
 
-    return formatted_str;
+/* Whether the history was started on a surface of the same size and
+ * pixel format as surf */
+static int
+_history_matches(pgSurfaceHistory *hist, SDL_Surface *surf)
+{
+    return hist->w == surf->w && hist->h == surf->h &&
+           hist->format == surf->format->format;
 }
 
-static intptr_t
-surface_init(pgSurfaceObject *self, PyObject *args, PyObject *kwds)
+/* Sets r to the area of tile t */
+static void
+_history_tile_rect(pgSurfaceHistory *hist, int t, SDL_Rect *r)
 {
-    Uint32 flags = 0;
-    int width, height;
-    PyObject *depth = NULL, *masks = NULL, *size = NULL;
-    int bpp;
-    Uint32 Rmask, Gmask, Bmask, Amask;
+    r->x = (t % hist->tiles_x) * PG_SNAPSHOT_TILE;
+    r->y = (t / hist->tiles_x) * PG_SNAPSHOT_TILE;
+    r->w = MIN(PG_SNAPSHOT_TILE, hist->w - r->x);
+    r->h = MIN(PG_SNAPSHOT_TILE, hist->h - r->y);
+}
+
+/* Records rect as written to. version is that of the surface after the
+ * write, if it moved by more than one something else changed the pixels
+ * too. */
+static void
+_history_mark(pgSurfaceHistory *hist, Uint64 version, const SDL_Rect *rect)
+{
+    SDL_Rect bounds = {0, 0, hist->w, hist->h}, area;
+    int x, y, x1, y1;
+
+    if (version != hist->seen_version + 1) {
+        hist->unknown = 1;
+    }
+    hist->seen_version = version;
+    if (!SDL_IntersectRect(rect, &bounds, &area)) {
+        return;
+    }
+    x1 = (area.x + area.w - 1) / PG_SNAPSHOT_TILE;
+    y1 = (area.y + area.h - 1) / PG_SNAPSHOT_TILE;
+    for (y = area.y / PG_SNAPSHOT_TILE; y <= y1; y++) {
+        for (x = area.x / PG_SNAPSHOT_TILE; x <= x1; x++) {
+            hist->changed[y * hist->tiles_x + x] = 1;
+        }
+    }
+}
+
+/* Whether tile t of surf differs from the copy in the history */
+static int
+_history_tile_differs(pgSurfaceHistory *hist, SDL_Surface *surf, int t)
+{
+    size_t pitch = (size_t)hist->w * hist->bpp;
+    size_t rowbytes;
+    Uint8 *a, *b;
+    SDL_Rect r;
+    int y;
+
+    if (!hist->changed[t] && !hist->unknown) {
+        return 0;
+    }
+    _history_tile_rect(hist, t, &r);
+    rowbytes = (size_t)r.w * hist->bpp;
+    a = (Uint8 *)surf->pixels + (size_t)r.y * surf->pitch +
+        (size_t)r.x * hist->bpp;
+    b = hist->pixels + r.y * pitch + (size_t)r.x * hist->bpp;
+    for (y = 0; y < r.h; y++, a += surf->pitch, b += pitch) {
+        if (memcmp(a, b, rowbytes)) {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+/* Takes the next snapshot of the locked surf: stores the tiles that changed
+ * since the latest one into it, as they were, and brings the copy in the
+ * history up to date. Returns -1 if out of memory. */
+static int
+_history_save(pgSurfaceHistory *hist, SDL_Surface *surf)
+{
+    pgSurfaceSnapshotObject *snap = hist->latest;
+    size_t pitch = (size_t)hist->w * hist->bpp;
+    int ntiles = hist->tiles_x * hist->tiles_y;
+    size_t size = 0, rowbytes;
+    Uint8 *copy;
+    Py_ssize_t i;
+    SDL_Rect r;
+    int t;
+
+    /* hist->changed becomes the tiles that really differ */
+    for (t = 0; t < ntiles; t++) {
+        hist->changed[t] = (Uint8)_history_tile_differs(hist, surf, t);
+        snap->count += hist->changed[t];
+    }
+    if (snap->count) {
+        snap->tiles = PyMem_New(int, snap->count);
+        snap->offsets = PyMem_New(size_t, snap->count);
+        if (snap->tiles && snap->offsets) {
+            for (i = 0, t = 0; t < ntiles; t++) {
+                if (hist->changed[t]) {
+                    _history_tile_rect(hist, t, &r);
+                    snap->tiles[i] = t;
+                    snap->offsets[i++] = size;
+                    size += (size_t)r.w * r.h * hist->bpp;
+                }
+            }
+            snap->data = PyMem_Malloc(size);
+        }
+        if (!snap->data) {
+            PyMem_Free(snap->tiles);
+            PyMem_Free(snap->offsets);
+            snap->tiles = NULL;
+            snap->offsets = NULL;
+            snap->count = 0;
+            hist->unknown = 1;
+            return -1;
+        }
+    }
+    for (i = 0; i < snap->count; i++) {
+        _history_tile_rect(hist, snap->tiles[i], &r);
+        rowbytes = (size_t)r.w * hist->bpp;
+        copy = hist->pixels + r.y * pitch + (size_t)r.x * hist->bpp;
+        _history_copy_rows(snap->data + snap->offsets[i], rowbytes, copy,
+                           pitch, rowbytes, r.h);
+        _history_copy_rows(copy, pitch,
+                           (Uint8 *)surf->pixels + (size_t)r.y * surf->pitch +
+                               (size_t)r.x * hist->bpp,
+                           surf->pitch, rowbytes, r.h);
+        hist->changed[snap->tiles[i]] = 0;
+    }
+    hist->unknown = 0;
+    return 0;
+}
+
+/* Brings the locked surf back to how it was at snap. Sets *area to the
+ * tiles written to, empty if there were none. Returns -1 if out of
+ * memory. */
+static int
+_history_restore(pgSurfaceHistory *hist, SDL_Surface *surf,
+                 pgSurfaceSnapshotObject *snap, SDL_Rect *area)
+{
+    int ntiles = hist->tiles_x * hist->tiles_y;
+    size_t pitch = (size_t)hist->w * hist->bpp, rowbytes;
+    pgSurfaceSnapshotObject *s;
+    Uint8 **sources, *dst;
+    Py_ssize_t i;
+    SDL_Rect r;
+    int t;
+
+    sources = PyMem_Calloc(ntiles ? ntiles : 1, sizeof(Uint8 *));
+    if (!sources) {
+        return -1;
+    }
+    /* the first copy of a tile stored from snap on is how it was then */
+    for (s = snap; s != hist->latest; s = s->next) {
+        for (i = 0; i < s->count; i++) {
+            if (!sources[s->tiles[i]]) {
+                sources[s->tiles[i]] = s->data + s->offsets[i];
+            }
+        }
+    }
+    area->x = area->y = area->w = area->h = 0;
+    for (t = 0; t < ntiles; t++) {
+        _history_tile_rect(hist, t, &r);
+        rowbytes = (size_t)r.w * hist->bpp;
+        dst = (Uint8 *)surf->pixels + (size_t)r.y * surf->pitch +
+              (size_t)r.x * hist->bpp;
+        if (sources[t]) {
+            _history_copy_rows(dst, surf->pitch, sources[t], rowbytes,
+                               rowbytes, r.h);
+        }
+        else if (_history_tile_differs(hist, surf, t)) {
+            _history_copy_rows(dst, surf->pitch,
+                               hist->pixels + r.y * pitch +
+                                   (size_t)r.x * hist->bpp,
+                               pitch, rowbytes, r.h);
+        }
+        else {
+            continue;
+        }
+        if (area->w) {
+            _dirty_union(area, &r);
+        }
+        else {
+            *area = r;
+        }
+    }
+    PyMem_Free(sources);
+    return 0;
+}
+
+/* Records rect, in the coordinates of surfobj, as changed in the dirty rect
+ * trackers of surfobj and of the surfaces it is a subsurface of. The rect is
+ * clipped to the clip area of each surface first. The version of every
+ * surface in the chain is bumped, tracker or not. */
+static void
+pgSurface_AddDirtyRect(pgSurfaceObject *surfobj, SDL_Rect *rect)
+{
+    SDL_Rect area = *rect, clipped;
+    struct pgSubSurface_Data *subdata;
+
+    while (surfobj && surfobj->surf) {
+        surfobj->version++;
+        if (surfobj->history) {
+            _history_mark(surfobj->history, surfobj->version, &area);
+        }
+        if (surfobj->dirty &&
+            SDL_IntersectRect(&area, &surfobj->surf->clip_rect, &clipped)) {
+            _dirty_add(surfobj->dirty, clipped);
+        }
+        subdata = surfobj->subsurface;
+        if (!subdata) {
+            break;
+        }
+        area.x += subdata->offsetx;
+        area.y += subdata->offsety;
+        surfobj = (pgSurfaceObject *)subdata->owner;
+    }
+}
+
+/* Returns the version of surfobj plus those of the surfaces it is a
+ * subsurface of, as changes to them change the subsurface pixels too */
+static Uint64
+pgSurface_GetVersion(pgSurfaceObject *surfobj)
+{
+    Uint64 version = 0;
+
+    while (surfobj) {
+        version += surfobj->version;
+        surfobj = surfobj->subsurface
+                      ? (pgSurfaceObject *)surfobj->subsurface->owner
+                      : NULL;
+    }
+    return version;
+}
+
+/* Copies up to PG_SURF_MAX_DIRTY_RECTS recorded rects into rects and
+ * returns how many there were, optionally forgetting them. Returns -1 if
+ * dirty rect tracking is not enabled on surfobj. */
+static int
+pgSurface_GetDirtyRects(pgSurfaceObject *surfobj, SDL_Rect *rects, int clear)
+{
+    int count;
+
+    if (!surfobj->dirty) {
+        return -1;
+    }
+    count = surfobj->dirty->count;
+    memcpy(rects, surfobj->dirty->rects, count * sizeof(SDL_Rect));
+    if (clear) {
+        surfobj->dirty->count = 0;
+    }
+    return count;
+}
+
+static PyObject *
+surface_str(PyObject *self)
+{
+    SDL_Surface *surf = pgSurface_AsSurface(self);
+
+    if (!surf) {
+        return PyUnicode_FromString("<Surface(Dead Display)>");
+    }
+
+    PyObject *colorkey = surf_get_colorkey((pgSurfaceObject *)self, NULL);
+    if (colorkey == NULL) {
+        return NULL;
+    }
+    PyObject *global_alpha = surf_get_alpha((pgSurfaceObject *)self, NULL);
+    if (global_alpha == NULL) {
+        Py_DECREF(colorkey);
+        return NULL;
+    }
+
+    // 49 is max len of format str, plus null terminator
+    char format[50] = "<Surface(%dx%dx%d";
+    if (PyObject_IsTrue(colorkey)) {
+        strcat(format, ", colorkey=%S");
+    }
+    if (PyObject_IsTrue(global_alpha)) {
+        strcat(format, ", global_alpha=%S");
+    }
+    strcat(format, ")>");
+
+    // Because PyUnicode_FromFormat ignores extra args, if we have no colorkey,
+    // but alpha, we can "move up" the global alpha to this spot No need to do
+    // this vice-versa, as it ignores extra args
+    PyObject *formatted_str = PyUnicode_FromFormat(
+        format, surf->w, surf->h, PG_SURF_BitsPerPixel(surf),
+        PyObject_IsTrue(colorkey) ? colorkey : global_alpha, global_alpha);
+
+    Py_DECREF(colorkey);
+    Py_DECREF(global_alpha);
+
+    return formatted_str;
+}
+
+static intptr_t
+surface_init(pgSurfaceObject *self, PyObject *args, PyObject *kwds)
+{
+    Uint32 flags = 0;
+    int width, height;
+    PyObject *depth = NULL, *masks = NULL, *size = NULL;
+    int bpp;
+    Uint32 Rmask, Gmask, Bmask, Amask;
     SDL_Surface *surface;
     SDL_PixelFormat default_format;
 
@@ -661,7 +1662,7 @@ surface_init(pgSurfaceObject *self, PyObject *args, PyObject *kwds)
         return -1;
     }
 
-    surface = PG_CreateSurface(width, height, pxformat);
+    surface = _surf_create(width, height, pxformat);
     if (!surface) {
         PyErr_SetString(pgExc_SDLError, SDL_GetError());
         return -1;
@@ -701,6 +1702,8 @@ surface_init(pgSurfaceObject *self, PyObject *args, PyObject *kwds)
         self->surf = surface;
         self->owner = 1;
         self->subsurface = NULL;
+        self->accelerated = (flags & PGS_ACCELERATED) != 0;
+        _surf_mem_track(self);
     }
 
     return 0;
@@ -847,6 +1850,9 @@ surf_set_at(PyObject *self, PyObject *const *args, Py_ssize_t nargs)
     if (!pgSurface_Unlock((pgSurfaceObject *)self))
         return NULL;
 
+    SDL_Rect pixel_rect = {x, y, 1, 1};
+    pgSurface_AddDirtyRect((pgSurfaceObject *)self, &pixel_rect);
+
     Py_RETURN_NONE;
 }
 
@@ -979,7 +1985,7 @@ surf_get_locked(PyObject *self, PyObject *_null)
 
     SURF_INIT_CHECK(surf)
 
-    if (surf->locklist && PyList_Size(surf->locklist) > 0)
+    if (surf->selflocks || (surf->locklist && PyList_Size(surf->locklist) > 0))
         Py_RETURN_TRUE;
     Py_RETURN_FALSE;
 }
@@ -991,11 +1997,9 @@ surf_get_locks(PyObject *self, PyObject *_null)
     Py_ssize_t len, i = 0;
     PyObject *tuple, *tmp;
     SURF_INIT_CHECK(pgSurface_AsSurface(self))
-    if (!surf->locklist)
-        return PyTuple_New(0);
 
-    len = PyList_Size(surf->locklist);
-    tuple = PyTuple_New(len);
+    len = surf->locklist ? PyList_Size(surf->locklist) : 0;
+    tuple = PyTuple_New(len + surf->selflocks);
     if (!tuple)
         return NULL;
 
@@ -1004,6 +2008,11 @@ surf_get_locks(PyObject *self, PyObject *_null)
         Py_INCREF(tmp);
         PyTuple_SetItem(tuple, i, tmp);
     }
+    /* the locks the surface holds on itself are only counted */
+    for (; i < len + surf->selflocks; i++) {
+        Py_INCREF(self);
+        PyTuple_SetItem(tuple, i, self);
+    }
     return tuple;
 }
 
@@ -1134,6 +2143,7 @@ surf_set_palette(PyObject *self, PyObject *seq)
     ecode = SDL_SetPaletteColors(pal, colors, 0, len);
     if (ecode != 0)
         return RAISE(pgExc_SDLError, SDL_GetError());
+    ((pgSurfaceObject *)self)->version++;
     Py_RETURN_NONE;
 }
 
@@ -1175,6 +2185,7 @@ surf_set_palette_at(PyObject *self, PyObject *args)
 
     if (SDL_SetPaletteColors(pal, &color, _index, 1) != 0)
         return RAISE(pgExc_SDLError, SDL_GetError());
+    ((pgSurfaceObject *)self)->version++;
 
     Py_RETURN_NONE;
 }
@@ -1201,6 +2212,10 @@ surf_set_colorkey(pgSurfaceObject *self, PyObject *args)
 
         hascolor = SDL_TRUE;
     }
+    /* SDL would leak shared pixels when it decodes the RLE data */
+    if ((flags & PGS_RLEACCEL) && !pgSurface_Unshare(self)) {
+        return NULL;
+    }
 
     pgSurface_Prep(self);
     result = 0;
@@ -1220,6 +2235,7 @@ surf_set_colorkey(pgSurfaceObject *self, PyObject *args)
 
     if (result == -1)
         return RAISE(pgExc_SDLError, SDL_GetError());
+    self->version++;
 
     Py_RETURN_NONE;
 }
@@ -1293,6 +2309,9 @@ surf_set_alpha(pgSurfaceObject *self, PyObject *args)
         if (SDL_SetSurfaceBlendMode(surf, SDL_BLENDMODE_NONE) != 0)
             return RAISE(pgExc_SDLError, SDL_GetError());
     }
+    if ((flags & PGS_RLEACCEL) && !pgSurface_Unshare(self)) {
+        return NULL;
+    }
     pgSurface_Prep(self);
     result =
         SDL_SetSurfaceRLE(surf, (flags & PGS_RLEACCEL) ? SDL_TRUE : SDL_FALSE);
@@ -1317,6 +2336,7 @@ surf_set_alpha(pgSurfaceObject *self, PyObject *args)
 
     if (result == -1)
         return RAISE(pgExc_SDLError, SDL_GetError());
+    self->version++;
 
     Py_RETURN_NONE;
 }
@@ -1364,13 +2384,32 @@ surf_copy(pgSurfaceObject *self, PyObject *_null)
 
     SURF_INIT_CHECK(surf)
 
+    newsurf = _surf_share(self);
+    if (newsurf) {
+        final = surf_subtype_new(Py_TYPE(self), newsurf, 1);
+        if (!final) {
+            SDL_FreeSurface(newsurf);
+            _surf_shared_release(self->shared, 1);
+            return NULL;
+        }
+        ((pgSurfaceObject *)final)->shared = self->shared;
+        ((pgSurfaceObject *)final)->premultiplied = self->premultiplied;
+        ((pgSurfaceObject *)final)->accelerated = self->accelerated;
+        return final;
+    }
+
     pgSurface_Prep(self);
     newsurf = PG_ConvertSurface(surf, surf->format);
     pgSurface_Unprep(self);
 
     final = surf_subtype_new(Py_TYPE(self), newsurf, 1);
-    if (!final)
+    if (!final) {
         SDL_FreeSurface(newsurf);
+    }
+    else {
+        ((pgSurfaceObject *)final)->premultiplied = self->premultiplied;
+        ((pgSurfaceObject *)final)->accelerated = self->accelerated;
+    }
     return final;
 }
 
@@ -1412,7 +2451,7 @@ surf_convert(pgSurfaceObject *self, PyObject *args)
     if (argobject) {
         if (pgSurface_Check(argobject)) {
             src = pgSurface_AsSurface(argobject);
-            newsurf = PG_ConvertSurface(surf, src->format);
+            newsurf = _surf_convert_surface(surf, src->format, 1);
         }
         else {
             /* will be updated later, initialize to make static analyzer happy
@@ -1538,7 +2577,7 @@ surf_convert(pgSurfaceObject *self, PyObject *args)
                     SDL_SetPixelFormatPalette(&format, palette);
                 }
             }
-            newsurf = PG_ConvertSurface(surf, &format);
+            newsurf = _surf_convert_surface(surf, &format, 1);
             SDL_SetSurfaceBlendMode(newsurf, SDL_BLENDMODE_NONE);
             SDL_FreePalette(palette);
         }
@@ -1570,6 +2609,238 @@ surf_convert(pgSurfaceObject *self, PyObject *args)
     return final;
 }
 
+/* Surface.convert and Surface.convert_alpha hand the common conversions, 24
+ * or 32 bit pixels with 8 bit channels to a differently ordered 32 bit
+ * format, to the loops below instead of the generic SDL blitters. The loops
+ * are written so the compiler can vectorize them. Large surfaces are split
+ * into bands of rows, one per thread.
+ */
+#define SURF_CONVERT_MAX_THREADS 16
+#define SURF_CONVERT_THREAD_MIN_ROWS 16
+#define SURF_CONVERT_THREAD_MIN_PIXELS (1 << 18)
+
+typedef struct {
+    Uint8 *srcpix;
+    Uint8 *dstpix;
+    int srcpitch;
+    int dstpitch;
+    int srcbpp;
+    int width;
+    int rows;
+    /* Per channel: the source shift, or byte offset for 24 bit pixels, the
+     * destination shift and the channel mask, 0 when the channel is dropped
+     */
+    int srcshift[4];
+    int dstshift[4];
+    Uint32 mask[4];
+    Uint32 fill; /* Opaque alpha, for a source without one */
+} _surf_convert_band;
+
+/* The shift of the 8 bit channel with the given mask, or -1 if the mask
+ * isn't a whole byte.
+ */
+static int
+_surf_byte_shift(Uint32 mask)
+{
+    int shift;
+
+    for (shift = 0; shift < 32; shift += 8) {
+        if (mask == 0xffU << shift) {
+            return shift;
+        }
+    }
+    return -1;
+}
+
+static int blit_threads_quit_registered = 0;
+
+static void
+_surf_quit_blit_threads(void)
+{
+    pg_quit_blit_threads();
+    blit_threads_quit_registered = 0;
+}
+
+/* pg_run_bands() for the C API and this module: the blit threads it starts
+ * have to be stopped by pygame.quit() too */
+static void
+_surf_run_bands(pg_BandFunc func, void *data, int nbands)
+{
+    PyGILState_STATE gstate;
+
+    if (nbands > 1 && !blit_threads_quit_registered) {
+        gstate = PyGILState_Ensure();
+        if (!blit_threads_quit_registered) {
+            pg_RegisterQuit(_surf_quit_blit_threads);
+            blit_threads_quit_registered = 1;
+        }
+        PyGILState_Release(gstate);
+    }
+    pg_run_bands(func, data, nbands);
+}
+
+static void
+_surf_convert_band_run(void *data, int i)
+{
+    _surf_convert_band *band = (_surf_convert_band *)data + i;
+    Uint8 *srcrow = band->srcpix;
+    Uint8 *dstrow = band->dstpix;
+    int s0 = band->srcshift[0], s1 = band->srcshift[1];
+    int s2 = band->srcshift[2], s3 = band->srcshift[3];
+    int d0 = band->dstshift[0], d1 = band->dstshift[1];
+    int d2 = band->dstshift[2], d3 = band->dstshift[3];
+    Uint32 m3 = band->mask[3];
+    Uint32 fill = band->fill;
+    int width = band->width;
+    Uint32 *dst;
+    Uint32 pixel;
+    const Uint8 *src;
+    int x, y;
+
+    for (y = 0; y < band->rows; ++y) {
+        dst = (Uint32 *)dstrow;
+        if (band->srcbpp == 4) {
+            const Uint32 *src32 = (const Uint32 *)srcrow;
+
+            for (x = 0; x < width; ++x) {
+                pixel = src32[x];
+                dst[x] = fill | ((pixel >> s0) & 0xFF) << d0 |
+                         ((pixel >> s1) & 0xFF) << d1 |
+                         ((pixel >> s2) & 0xFF) << d2 |
+                         ((pixel >> s3) & m3) << d3;
+            }
+        }
+        else {
+            src = srcrow;
+            for (x = 0; x < width; ++x) {
+                dst[x] = fill | (Uint32)src[s0] << d0 |
+                         (Uint32)src[s1] << d1 | (Uint32)src[s2] << d2;
+                src += 3;
+            }
+        }
+        srcrow += band->srcpitch;
+        dstrow += band->dstpitch;
+    }
+}
+
+/* Converts surf to the 32 bit pixel format pfe, without SDL_ConvertSurface.
+ * Returns NULL, without an error set, when the conversion isn't one handled
+ * here, so the caller can fall back to SDL. If threaded, large surfaces are
+ * split across threads with the GIL released, so the GIL must be held;
+ * otherwise the GIL isn't touched.
+ */
+static SDL_Surface *
+_surf_convert_fast(SDL_Surface *surf, Uint32 pfe, int threaded)
+{
+    SDL_PixelFormat *srcfmt = surf->format;
+    SDL_PixelFormat *dstfmt;
+    SDL_Surface *newsurf;
+    _surf_convert_band bands[SURF_CONVERT_MAX_THREADS];
+    Uint32 srcmasks[4];
+    Uint32 dstmasks[4];
+    int srcbpp = PG_FORMAT_BytesPerPixel(srcfmt);
+    int nbands, i, start, end;
+    int srcshift, dstshift;
+    SDL_BlendMode mode;
+    Uint8 r, g, b, alpha;
+
+    if (pfe == srcfmt->format || SDL_ISPIXELFORMAT_FOURCC(pfe) ||
+        SDL_ISPIXELFORMAT_INDEXED(pfe) || SDL_BYTESPERPIXEL(pfe) != 4 ||
+        (srcbpp != 3 && srcbpp != 4) || srcfmt->palette ||
+        SDL_MUSTLOCK(surf) || SDL_HasColorKey(surf) || !surf->w ||
+        !surf->h) {
+        return NULL;
+    }
+    srcmasks[0] = srcfmt->Rmask;
+    srcmasks[1] = srcfmt->Gmask;
+    srcmasks[2] = srcfmt->Bmask;
+    srcmasks[3] = srcbpp == 4 ? srcfmt->Amask : 0;
+    newsurf = PG_CreateSurface(surf->w, surf->h, pfe);
+    if (!newsurf) {
+        return NULL;
+    }
+    dstfmt = newsurf->format;
+    dstmasks[0] = dstfmt->Rmask;
+    dstmasks[1] = dstfmt->Gmask;
+    dstmasks[2] = dstfmt->Bmask;
+    dstmasks[3] = dstfmt->Amask;
+
+    memset(&bands[0], 0, sizeof(bands[0]));
+    for (i = 0; i < 4; ++i) {
+        if (srcbpp == 3 && i < 3) {
+            srcshift = _surf_channel_offset(srcfmt, srcmasks[i]);
+        }
+        else {
+            srcshift = srcmasks[i] ? _surf_byte_shift(srcmasks[i]) : 0;
+        }
+        dstshift = dstmasks[i] ? _surf_byte_shift(dstmasks[i]) : 0;
+        if (srcshift < 0 || dstshift < 0 || (i < 3 && !dstmasks[i])) {
+            SDL_FreeSurface(newsurf);
+            return NULL;
+        }
+        bands[0].srcshift[i] = srcshift;
+        bands[0].dstshift[i] = dstshift;
+        bands[0].mask[i] = dstmasks[i] && srcmasks[i] ? 0xFF : 0;
+    }
+    if (dstmasks[3] && !srcmasks[3]) {
+        bands[0].fill = dstmasks[3];
+    }
+    bands[0].srcbpp = srcbpp;
+    bands[0].width = surf->w;
+    bands[0].srcpitch = surf->pitch;
+    bands[0].dstpitch = newsurf->pitch;
+
+    nbands = 1;
+    if (threaded &&
+        (Sint64)surf->w * surf->h >= SURF_CONVERT_THREAD_MIN_PIXELS) {
+        nbands = SDL_GetCPUCount();
+        nbands = MIN(nbands, SURF_CONVERT_MAX_THREADS);
+        nbands = MIN(nbands, surf->h / SURF_CONVERT_THREAD_MIN_ROWS);
+        nbands = MAX(nbands, 1);
+    }
+    for (i = 0; i < nbands; ++i) {
+        start = (int)((Sint64)surf->h * i / nbands);
+        end = (int)((Sint64)surf->h * (i + 1) / nbands);
+        bands[i] = bands[0];
+        bands[i].srcpix = (Uint8 *)surf->pixels + (Sint64)start * surf->pitch;
+        bands[i].dstpix =
+            (Uint8 *)newsurf->pixels + (Sint64)start * newsurf->pitch;
+        bands[i].rows = end - start;
+    }
+
+    _surf_run_bands(_surf_convert_band_run, bands, nbands);
+
+    /* Carry over the modulation and blend mode, as SDL_ConvertSurface does */
+    SDL_GetSurfaceColorMod(surf, &r, &g, &b);
+    SDL_SetSurfaceColorMod(newsurf, r, g, b);
+    SDL_GetSurfaceAlphaMod(surf, &alpha);
+    SDL_SetSurfaceAlphaMod(newsurf, alpha);
+    SDL_GetSurfaceBlendMode(surf, &mode);
+    if ((srcmasks[3] && dstmasks[3]) || alpha != 255) {
+        mode = SDL_BLENDMODE_BLEND;
+    }
+    SDL_SetSurfaceBlendMode(newsurf, mode);
+    return newsurf;
+}
+
+/* SDL_ConvertSurface, trying _surf_convert_fast first */
+static SDL_Surface *
+_surf_convert_surface(SDL_Surface *surf, SDL_PixelFormat *format,
+                      int threaded)
+{
+    SDL_Surface *newsurf = NULL;
+    Uint32 pfe;
+
+    if (PG_FORMAT_BytesPerPixel(format) == 4 && !format->palette) {
+        pfe = SDL_MasksToPixelFormatEnum(32, format->Rmask, format->Gmask,
+                                         format->Bmask, format->Amask);
+        if (pfe != SDL_PIXELFORMAT_UNKNOWN) {
+            newsurf = _surf_convert_fast(surf, pfe, threaded);
+        }
+    }
+    return newsurf ? newsurf : PG_ConvertSurface(surf, format);
+}
+
 static SDL_Surface *
 pg_DisplayFormat(SDL_Surface *surface)
 {
@@ -1580,11 +2851,14 @@ pg_DisplayFormat(SDL_Surface *surface)
             " or Window.get_surface().");
         return NULL;
     }
-    return PG_ConvertSurface(surface, default_format);
+    return _surf_convert_surface(surface, default_format, 1);
 }
 
-static SDL_Surface *
-pg_DisplayFormatAlpha(SDL_Surface *surface)
+/* The convert_alpha() pixel format for the default convert format, or
+ * SDL_PIXELFORMAT_UNKNOWN with an SDL error set.
+ */
+static Uint32
+_surf_alpha_format(void)
 {
     SDL_PixelFormat *dformat;
     Uint32 pfe;
@@ -1598,7 +2872,7 @@ pg_DisplayFormatAlpha(SDL_Surface *surface)
         SDL_SetError(
             "No convert format has been set, try display.set_mode()"
             " or Window.get_surface().");
-        return NULL;
+        return SDL_PIXELFORMAT_UNKNOWN;
     }
 
     switch (PG_FORMAT_BytesPerPixel(dformat)) {
@@ -1631,9 +2905,21 @@ pg_DisplayFormatAlpha(SDL_Surface *surface)
     pfe = SDL_MasksToPixelFormatEnum(32, rmask, gmask, bmask, amask);
     if (pfe == SDL_PIXELFORMAT_UNKNOWN) {
         SDL_SetError("unknown pixel format");
+    }
+    return pfe;
+}
+
+static SDL_Surface *
+pg_DisplayFormatAlpha(SDL_Surface *surface)
+{
+    SDL_Surface *newsurf;
+    Uint32 pfe = _surf_alpha_format();
+
+    if (pfe == SDL_PIXELFORMAT_UNKNOWN) {
         return NULL;
     }
-    return PG_ConvertSurfaceFormat(surface, pfe);
+    newsurf = _surf_convert_fast(surface, pfe, 1);
+    return newsurf ? newsurf : PG_ConvertSurfaceFormat(surface, pfe);
 }
 
 static PyObject *
@@ -1671,67 +2957,281 @@ surf_convert_alpha(pgSurfaceObject *self, PyObject *args)
     return final;
 }
 
-static PyObject *
-surf_set_clip(PyObject *self, PyObject *args)
-{
-    SDL_Surface *surf = pgSurface_AsSurface(self);
-    PyObject *item;
-    SDL_Rect *rect = NULL, temp;
-    SDL_Rect sdlrect;
-    int result;
+/* One surface of a Surface.convert_many batch */
+typedef struct {
+    SDL_Surface *src;
+    SDL_Surface *dst;
+    char *error;
+    int first; /* Index of the first job with the same src */
+} _surf_convert_job;
+
+typedef struct {
+    _surf_convert_job *jobs;
+    int count;
+    SDL_atomic_t next;
+    SDL_PixelFormat *format; /* The convert() format, NULL for alpha */
+    Uint32 alpha_pfe;
+} _surf_convert_batch;
 
-    SURF_INIT_CHECK(surf)
-    if (PyTuple_Size(args)) {
-        item = PyTuple_GET_ITEM(args, 0);
-        if (item == Py_None && PyTuple_Size(args) == 1) {
-            result = SDL_SetClipRect(surf, NULL);
-        }
-        else {
-            rect = pgRect_FromObject(args, &temp);
-            if (!rect)
-                return RAISE(PyExc_ValueError, "invalid rectstyle object");
-            sdlrect.x = rect->x;
-            sdlrect.y = rect->y;
-            sdlrect.h = rect->h;
-            sdlrect.w = rect->w;
-            result = SDL_SetClipRect(surf, &sdlrect);
-        }
+static void
+_surf_convert_one(_surf_convert_batch *batch, _surf_convert_job *job)
+{
+    if (batch->format) {
+        job->dst = _surf_convert_surface(job->src, batch->format, 0);
     }
     else {
-        result = SDL_SetClipRect(surf, NULL);
+        job->dst = _surf_convert_fast(job->src, batch->alpha_pfe, 0);
+        if (!job->dst) {
+            job->dst = PG_ConvertSurfaceFormat(job->src, batch->alpha_pfe);
+        }
     }
-
-    if (result == -1) {
-        return RAISE(pgExc_SDLError, SDL_GetError());
+    if (!job->dst) {
+        /* SDL keeps the error message per thread */
+        job->error = SDL_strdup(SDL_GetError());
     }
-
-    Py_RETURN_NONE;
 }
 
-static PyObject *
-surf_get_clip(PyObject *self, PyObject *_null)
+/* Each band takes the jobs that are left one at a time */
+static void
+_surf_convert_many_band(void *data, int band)
 {
-    SDL_Surface *surf = pgSurface_AsSurface(self);
+    _surf_convert_batch *batch = (_surf_convert_batch *)data;
+    int i;
 
-    SURF_INIT_CHECK(surf)
-    return pgRect_New(&surf->clip_rect);
+    while ((i = SDL_AtomicAdd(&batch->next, 1)) < batch->count) {
+        /* SDL_ConvertSurface changes the source's blit map while it runs,
+         * so a surface listed twice is only converted once at a time */
+        if (batch->jobs[i].src && batch->jobs[i].first == i) {
+            _surf_convert_one(batch, batch->jobs + i);
+        }
+    }
 }
 
 static PyObject *
-surf_fill(pgSurfaceObject *self, PyObject *args, PyObject *keywds)
+surf_convert_many(PyObject *self, PyObject *args, PyObject *kwargs)
 {
-    SDL_Surface *surf = pgSurface_AsSurface(self);
-    SDL_Rect *rect, temp;
-    PyObject *r = NULL;
-    Uint32 color;
+    PyObject *surfaces, *seq, *item, *ret = NULL;
+    _surf_convert_batch batch;
+    _surf_convert_job *job;
+    Py_ssize_t count;
+    int alpha = 1, threads, i;
+    Uint32 colorkey;
+    Uint8 key_r, key_g, key_b, key_a;
+    static char *kwids[] = {"surfaces", "alpha", NULL};
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "O|p", kwids, &surfaces,
+                                     &alpha)) {
+        return NULL;
+    }
+    if (!SDL_WasInit(SDL_INIT_VIDEO)) {
+        return RAISE(pgExc_SDLError,
+                     "cannot convert without pygame.display initialized");
+    }
+    if (!(seq = PySequence_Fast(surfaces, "surfaces must be a sequence"))) {
+        return NULL;
+    }
+    count = PySequence_Fast_GET_SIZE(seq);
+    if (count > INT_MAX) {
+        Py_DECREF(seq);
+        return RAISE(PyExc_OverflowError, "too many surfaces");
+    }
+
+    memset(&batch, 0, sizeof(batch));
+    batch.count = (int)count;
+    if (alpha) {
+        batch.alpha_pfe = _surf_alpha_format();
+        if (batch.alpha_pfe == SDL_PIXELFORMAT_UNKNOWN) {
+            Py_DECREF(seq);
+            return RAISE(pgExc_SDLError, SDL_GetError());
+        }
+    }
+    else if (!(batch.format = pg_GetDefaultConvertFormat())) {
+        Py_DECREF(seq);
+        return RAISE(pgExc_SDLError,
+                     "No convert format has been set, try display.set_mode()"
+                     " or Window.get_surface().");
+    }
+    if (!(batch.jobs = PyMem_New(_surf_convert_job, count ? count : 1))) {
+        Py_DECREF(seq);
+        return PyErr_NoMemory();
+    }
+    for (i = 0; i < batch.count; ++i) {
+        item = PySequence_Fast_GET_ITEM(seq, i);
+        job = batch.jobs + i;
+        job->src = NULL;
+        job->dst = NULL;
+        job->error = NULL;
+        job->first = i;
+        if (item == Py_None) {
+            continue; /* a failed image.load_many entry, passed through */
+        }
+        if (!pgSurface_Check(item)) {
+            PyErr_Format(PyExc_TypeError,
+                         "surfaces must be Surface objects or None, got %s",
+                         Py_TYPE(item)->tp_name);
+            batch.count = i;
+            goto end;
+        }
+        job->src = pgSurface_AsSurface(item);
+        if (!job->src) {
+            PyErr_SetString(pgExc_SDLError, "Surface is not initialized");
+            batch.count = i;
+            goto end;
+        }
+        job->first = 0;
+        while (batch.jobs[job->first].src != job->src) {
+            ++job->first;
+        }
+        pgSurface_Prep((pgSurfaceObject *)item);
+    }
+
+    threads = SDL_GetCPUCount();
+    threads = MIN(threads, batch.count);
+
+    Py_BEGIN_ALLOW_THREADS;
+    _surf_run_bands(_surf_convert_many_band, &batch, threads);
+    for (i = 0; i < batch.count; ++i) {
+        if (batch.jobs[i].src && batch.jobs[i].first != i) {
+            _surf_convert_one(&batch, batch.jobs + i);
+        }
+    }
+    Py_END_ALLOW_THREADS;
+
+    for (i = 0; i < batch.count; ++i) {
+        if (batch.jobs[i].error) {
+            PyErr_SetString(pgExc_SDLError, batch.jobs[i].error);
+            goto end;
+        }
+    }
+
+    /* build the Surface objects in input order, set up like the ones
+     * convert() and convert_alpha() return */
+    if (!(ret = PyList_New(count))) {
+        goto end;
+    }
+    for (i = 0; i < batch.count; ++i) {
+        job = batch.jobs + i;
+        if (!job->src) {
+            Py_INCREF(Py_None);
+            PyList_SET_ITEM(ret, i, Py_None);
+            continue;
+        }
+        if (alpha) {
+            SDL_SetSurfaceBlendMode(job->dst, SDL_BLENDMODE_BLEND);
+        }
+        else {
+            SDL_SetSurfaceBlendMode(job->dst, SDL_BLENDMODE_NONE);
+            if (SDL_HasColorKey(job->src)) {
+                key_a = 255;
+                SDL_GetColorKey(job->src, &colorkey);
+                if (SDL_ISPIXELFORMAT_ALPHA(job->src->format->format))
+                    SDL_GetRGBA(colorkey, job->src->format, &key_r, &key_g,
+                                &key_b, &key_a);
+                else
+                    SDL_GetRGB(colorkey, job->src->format, &key_r, &key_g,
+                               &key_b);
+                colorkey = SDL_MapRGBA(job->dst->format, key_r, key_g, key_b,
+                                       key_a);
+                if (SDL_SetColorKey(job->dst, SDL_TRUE, colorkey) != 0) {
+                    PyErr_SetString(pgExc_SDLError, SDL_GetError());
+                    Py_CLEAR(ret);
+                    goto end;
+                }
+            }
+        }
+        item = surf_subtype_new(Py_TYPE(PySequence_Fast_GET_ITEM(seq, i)),
+                                job->dst, 1);
+        if (!item) {
+            Py_CLEAR(ret);
+            goto end;
+        }
+        job->dst = NULL; /* owned by the Surface now */
+        PyList_SET_ITEM(ret, i, item);
+    }
+
+end:
+    for (i = 0; i < batch.count; ++i) {
+        if (batch.jobs[i].src) {
+            pgSurface_Unprep(
+                (pgSurfaceObject *)PySequence_Fast_GET_ITEM(seq, i));
+        }
+        if (batch.jobs[i].dst) {
+            SDL_FreeSurface(batch.jobs[i].dst);
+        }
+        SDL_free(batch.jobs[i].error);
+    }
+    PyMem_Free(batch.jobs);
+    Py_DECREF(seq);
+    return ret;
+}
+
+static PyObject *
+surf_set_clip(PyObject *self, PyObject *args)
+{
+    SDL_Surface *surf = pgSurface_AsSurface(self);
+    PyObject *item;
+    SDL_Rect *rect = NULL, temp;
+    SDL_Rect sdlrect;
+    int result;
+
+    SURF_INIT_CHECK(surf)
+    if (PyTuple_Size(args)) {
+        item = PyTuple_GET_ITEM(args, 0);
+        if (item == Py_None && PyTuple_Size(args) == 1) {
+            result = SDL_SetClipRect(surf, NULL);
+        }
+        else {
+            rect = pgRect_FromObject(args, &temp);
+            if (!rect)
+                return RAISE(PyExc_ValueError, "invalid rectstyle object");
+            sdlrect.x = rect->x;
+            sdlrect.y = rect->y;
+            sdlrect.h = rect->h;
+            sdlrect.w = rect->w;
+            result = SDL_SetClipRect(surf, &sdlrect);
+        }
+    }
+    else {
+        result = SDL_SetClipRect(surf, NULL);
+    }
+
+    if (result == -1) {
+        return RAISE(pgExc_SDLError, SDL_GetError());
+    }
+
+    Py_RETURN_NONE;
+}
+
+static PyObject *
+surf_get_clip(PyObject *self, PyObject *_null)
+{
+    SDL_Surface *surf = pgSurface_AsSurface(self);
+
+    SURF_INIT_CHECK(surf)
+    return pgRect_New(&surf->clip_rect);
+}
+
+static PyObject *
+surf_fill(pgSurfaceObject *self, PyObject *const *args, Py_ssize_t nargs,
+          PyObject *kwnames)
+{
+    SDL_Surface *surf = pgSurface_AsSurface(self);
+    SDL_Rect *rect, temp;
+    PyObject *r;
+    Uint32 color;
     int result;
+    pg_NoGIL nogil;
     PyObject *rgba_obj;
     SDL_Rect sdlrect;
     int blendargs = 0;
 
     static char *kwids[] = {"color", "rect", "special_flags", NULL};
-    if (!PyArg_ParseTupleAndKeywords(args, keywds, "O|Oi", kwids, &rgba_obj,
-                                     &r, &blendargs))
+    PyObject *parsed[3] = {NULL, NULL, NULL};
+    if (!pg_ParseFastcallArgs("fill", args, nargs, kwnames, kwids, 1, parsed))
+        return NULL;
+    rgba_obj = parsed[0];
+    r = parsed[1];
+    if (parsed[2] && !pg_IntFromFastcallArg(parsed[2], &blendargs))
         return NULL;
     SURF_INIT_CHECK(surf)
 
@@ -1768,316 +3268,1960 @@ surf_fill(pgSurfaceObject *self, PyObject *args, PyObject *keywds)
         return pgRect_New(&sdlrect);
     }
 
+    PG_PERF_START(perf_start);
     if (blendargs != 0) {
+        if (!pgSurface_Unshare(self)) {
+            return NULL;
+        }
+        pg_nogil_begin(&nogil, (pgSurfaceObject *)self, NULL);
         result = surface_fill_blend(surf, &sdlrect, color, blendargs);
+        pg_nogil_end(&nogil);
+    }
+    else if (self->canvas &&
+             self->canvas->fill((PyObject *)self, &sdlrect, color)) {
+        result = 0;
     }
     else {
         pgSurface_Prep(self);
         pgSurface_Lock((pgSurfaceObject *)self);
+        pg_nogil_begin(&nogil, (pgSurfaceObject *)self, NULL);
         result = SDL_FillRect(surf, &sdlrect, color);
+        pg_nogil_end(&nogil);
         pgSurface_Unlock((pgSurfaceObject *)self);
         pgSurface_Unprep(self);
     }
+    PG_PERF_STOP(perf_start, PG_PERF_FILL, (Uint64)sdlrect.w * sdlrect.h);
     if (result == -1)
         return RAISE(pgExc_SDLError, SDL_GetError());
 
+    pgSurface_AddDirtyRect(self, &sdlrect);
     return pgRect_New(&sdlrect);
 }
 
-static PyObject *
-surf_blit(pgSurfaceObject *self, PyObject *args, PyObject *keywds)
+/* Gets a C contiguous buffer of 32 bit integers, returning 0 if obj has
+ * no buffer and -1 with an exception set if the buffer has the wrong format.
+ * Without a name, a buffer with the wrong format returns 0 too.
+ */
+static int
+_surf_int32_buffer(PyObject *obj, Py_buffer *view, const char *name)
 {
-    SDL_Surface *src, *dest = pgSurface_AsSurface(self);
-    SDL_Rect *src_rect, temp;
-    PyObject *argpos, *argrect = NULL;
-    pgSurfaceObject *srcobject;
-    int dx, dy, result;
-    SDL_Rect dest_rect;
-    int sx, sy;
-    int blend_flags = 0;
-
-    static char *kwids[] = {"source", "dest", "area", "special_flags", NULL};
-    if (!PyArg_ParseTupleAndKeywords(args, keywds, "O!O|Oi", kwids,
-                                     &pgSurface_Type, &srcobject, &argpos,
-                                     &argrect, &blend_flags))
-        return NULL;
-
-    src = pgSurface_AsSurface(srcobject);
-    SURF_INIT_CHECK(src)
-    SURF_INIT_CHECK(dest)
+    const char *fmt;
 
-    if ((src_rect = pgRect_FromObject(argpos, &temp))) {
-        dx = src_rect->x;
-        dy = src_rect->y;
+    if (!PyObject_CheckBuffer(obj)) {
+        return 0;
     }
-    else if (pg_TwoIntsFromObj(argpos, &sx, &sy)) {
-        dx = sx;
-        dy = sy;
+    if (PyObject_GetBuffer(obj, view, PyBUF_C_CONTIGUOUS | PyBUF_FORMAT)) {
+        if (!name) {
+            PyErr_Clear();
+            return 0;
+        }
+        return -1;
     }
-    else
-        return RAISE(PyExc_TypeError, "invalid destination position for blit");
-
-    if (argrect && argrect != Py_None) {
-        if (!(src_rect = pgRect_FromObject(argrect, &temp)))
-            return RAISE(PyExc_TypeError, "Invalid rectstyle argument");
+    fmt = view->format ? view->format : "B";
+    if (*fmt == '@' || *fmt == '=') {
+        ++fmt;
     }
-    else {
-        temp.x = temp.y = 0;
-        temp.w = src->w;
-        temp.h = src->h;
-        src_rect = &temp;
+    if (view->itemsize != 4 || (strcmp(fmt, "i") && strcmp(fmt, "I") &&
+                                strcmp(fmt, "l") && strcmp(fmt, "L"))) {
+        PyBuffer_Release(view);
+        if (!name) {
+            return 0;
+        }
+        PyErr_Format(PyExc_ValueError,
+                     "%s buffer must hold native 32 bit integers", name);
+        return -1;
     }
-
-    dest_rect.x = dx;
-    dest_rect.y = dy;
-    dest_rect.w = src_rect->w;
-    dest_rect.h = src_rect->h;
-
-    if (!blend_flags)
-        blend_flags = 0;
-
-    result =
-        pgSurface_Blit(self, srcobject, &dest_rect, src_rect, blend_flags);
-
-    if (result != 0)
-        return NULL;
-
-    return pgRect_New(&dest_rect);
+    return 1;
 }
 
-#define BLITS_ERR_SEQUENCE_REQUIRED 1
-#define BLITS_ERR_DISPLAY_SURF_QUIT 2
-#define BLITS_ERR_SEQUENCE_SURF 3
-#define BLITS_ERR_NO_OPENGL_SURF 4
-#define BLITS_ERR_INVALID_DESTINATION 5
-#define BLITS_ERR_INVALID_RECT_STYLE 6
-#define BLITS_ERR_MUST_ASSIGN_NUMERIC 7
-#define BLITS_ERR_BLIT_FAIL 8
-#define BLITS_ERR_PY_EXCEPTION_RAISED 9
-#define BLITS_ERR_SOURCE_NOT_SURFACE 10
-
 static PyObject *
-surf_blits(pgSurfaceObject *self, PyObject *args, PyObject *keywds)
+surf_fill_many(pgSurfaceObject *self, PyObject *args, PyObject *keywds)
 {
-    SDL_Surface *src, *dest = pgSurface_AsSurface(self);
-    SDL_Rect *src_rect, temp;
-    PyObject *srcobject = NULL, *argpos = NULL, *argrect = NULL;
-    int dx, dy, result;
-    SDL_Rect dest_rect;
-    int sx, sy;
-    int blend_flags = 0;
-
-    PyObject *blitsequence;
-    PyObject *iterator = NULL;
-    PyObject *item = NULL;
-    PyObject *special_flags = NULL;
-    PyObject *ret = NULL;
-    PyObject *retrect = NULL;
-    Py_ssize_t itemlength, sequencelength, curriter = 0;
-    int doreturn = 1;
-    int bliterrornum = 0;
-    int issequence = 0;
+    SDL_Surface *surf = pgSurface_AsSurface(self);
+    SDL_Rect surfrect, *rects = NULL, *rect, temp;
+    Uint32 color, *colors = NULL;
+    PyObject *rects_obj, *colors_obj, *item;
+    Py_buffer view;
+    Py_ssize_t count, i, n = 0;
+    int blendargs = 0, single, has_view, result = 0;
+    pg_NoGIL nogil;
+
+    static char *kwids[] = {"rects", "colors", "special_flags", NULL};
+    if (!PyArg_ParseTupleAndKeywords(args, keywds, "OO|i", kwids, &rects_obj,
+                                     &colors_obj, &blendargs))
+        return NULL;
+    SURF_INIT_CHECK(surf)
 
-    static char *kwids[] = {"blit_sequence", "doreturn", NULL};
+    surfrect.x = surfrect.y = 0;
+    surfrect.w = surf->w;
+    surfrect.h = surf->h;
 
-    SURF_INIT_CHECK(dest)
-    if (!PyArg_ParseTupleAndKeywords(args, keywds, "O|i", kwids, &blitsequence,
-                                     &doreturn))
+    /* the rects, as a sequence of rect-likes or a buffer of x, y, w, h */
+    if ((has_view = _surf_int32_buffer(rects_obj, &view, "rects")) < 0) {
         return NULL;
-
-    if (!PyIter_Check(blitsequence) &&
-        !(issequence = PySequence_Check(blitsequence))) {
-        bliterrornum = BLITS_ERR_SEQUENCE_REQUIRED;
-        goto bliterror;
     }
+    if (has_view) {
+        const int *values = (const int *)view.buf;
 
-    if (doreturn) {
-        /* If the sequence is countable, meaning not a generator, we can get
-         * faster rect appending to the list by pre allocating it
-         * to later call the more efficient SET_ITEM*/
-        if (issequence) {
-            sequencelength = PySequence_Size(blitsequence);
-            if (sequencelength == -1) {
-                bliterrornum = BLITS_ERR_PY_EXCEPTION_RAISED;
-                goto bliterror;
+        if (view.len % (4 * sizeof(int))) {
+            PyBuffer_Release(&view);
+            return RAISE(PyExc_ValueError,
+                         "rects buffer length must be a multiple of 4");
+        }
+        count = view.len / (4 * sizeof(int));
+        if (!(rects = PyMem_New(SDL_Rect, count ? count : 1))) {
+            PyBuffer_Release(&view);
+            return PyErr_NoMemory();
+        }
+        for (i = 0; i < count; ++i, values += 4) {
+            temp.x = values[0];
+            temp.y = values[1];
+            temp.w = values[2];
+            temp.h = values[3];
+            if (!SDL_IntersectRect(&temp, &surfrect, &rects[i])) {
+                rects[i].w = rects[i].h = 0;
+            }
+        }
+        PyBuffer_Release(&view);
+    }
+    else {
+        if (!PySequence_Check(rects_obj)) {
+            return RAISE(PyExc_TypeError,
+                         "rects must be a sequence of rects or a buffer");
+        }
+        if ((count = PySequence_Size(rects_obj)) < 0) {
+            return NULL;
+        }
+        if (!(rects = PyMem_New(SDL_Rect, count ? count : 1))) {
+            return PyErr_NoMemory();
+        }
+        for (i = 0; i < count; ++i) {
+            if (!(item = PySequence_GetItem(rects_obj, i))) {
+                goto error;
+            }
+            /* rect may point into item */
+            rect = pgRect_FromObject(item, &temp);
+            if (!rect) {
+                Py_DECREF(item);
+                PyErr_Format(PyExc_ValueError,
+                             "invalid rectstyle object at index %zd", i);
+                goto error;
             }
+            if (!SDL_IntersectRect(rect, &surfrect, &rects[i])) {
+                rects[i].w = rects[i].h = 0;
+            }
+            Py_DECREF(item);
+        }
+    }
 
-            ret = PyList_New(sequencelength);
+    /* the colors, a buffer of mapped colors, one color for every rect or a
+     * sequence of colors. Colors export byte buffers, so a buffer of another
+     * format is tried as a color. Anything that is a color is taken as one,
+     * so (1, 2, 3) fills all the rects with that color even if there are
+     * three of them. */
+    has_view = _surf_int32_buffer(colors_obj, &view, NULL);
+    single = !has_view && pg_MappedColorFromObj(colors_obj, surf->format,
+                                                &color, PG_COLOR_HANDLE_ALL);
+    if (!single) {
+        PyErr_Clear();
+        if (has_view) {
+            if (view.len % 4 || view.len / 4 != count) {
+                PyBuffer_Release(&view);
+                PyErr_SetString(PyExc_ValueError,
+                                "colors must have one color for every rect");
+                goto error;
+            }
+            if (!(colors = PyMem_New(Uint32, count ? count : 1))) {
+                PyBuffer_Release(&view);
+                PyErr_NoMemory();
+                goto error;
+            }
+            memcpy(colors, view.buf, count * sizeof(Uint32));
+            PyBuffer_Release(&view);
         }
         else {
-            ret = PyList_New(0);
+            if (!PySequence_Check(colors_obj)) {
+                PyErr_SetString(PyExc_TypeError,
+                                "colors must be a color or a sequence of "
+                                "colors");
+                goto error;
+            }
+            if (PySequence_Size(colors_obj) != count) {
+                if (!PyErr_Occurred()) {
+                    PyErr_SetString(
+                        PyExc_ValueError,
+                        "colors must have one color for every rect");
+                }
+                goto error;
+            }
+            if (!(colors = PyMem_New(Uint32, count ? count : 1))) {
+                PyErr_NoMemory();
+                goto error;
+            }
+            for (i = 0; i < count; ++i) {
+                if (!(item = PySequence_GetItem(colors_obj, i))) {
+                    goto error;
+                }
+                result = pg_MappedColorFromObj(item, surf->format, &colors[i],
+                                               PG_COLOR_HANDLE_ALL);
+                Py_DECREF(item);
+                if (!result) {
+                    goto error;
+                }
+            }
+            result = 0;
         }
-        if (!ret)
-            return NULL;
     }
 
-    iterator = PyObject_GetIter(blitsequence);
-    if (!iterator) {
-        Py_XDECREF(ret);
-        return NULL;
+    /* drop the rects that are outside of the surface */
+    for (i = 0; i < count; ++i) {
+        if (rects[i].w > 0 && rects[i].h > 0) {
+            rects[n] = rects[i];
+            if (colors) {
+                colors[n] = colors[i];
+            }
+            ++n;
+        }
     }
 
-    while ((item = PyIter_Next(iterator))) {
-        if (PySequence_Check(item)) {
-            itemlength = PySequence_Length(item);
-            if (itemlength > 4 || itemlength < 2) {
-                bliterrornum = BLITS_ERR_SEQUENCE_REQUIRED;
-                goto bliterror;
+    if (n) {
+        Uint64 area = 0;
+        PG_PERF_START(perf_start);
+
+        if (!pgSurface_Unshare(self)) {
+            goto error;
+        }
+        pgSurface_Prep(self);
+        if (!pgSurface_Lock(self)) {
+            pgSurface_Unprep(self);
+            PyErr_SetString(PyExc_RuntimeError, "error locking surface");
+            goto error;
+        }
+        pg_nogil_begin(&nogil, self, NULL);
+        if (blendargs != 0) {
+            for (i = 0; i < n && result != -1; ++i) {
+                result = surface_fill_blend(
+                    surf, &rects[i], colors ? colors[i] : color, blendargs);
             }
         }
+        else if (!colors) {
+            result = SDL_FillRects(surf, rects, (int)n, color);
+        }
         else {
-            bliterrornum = BLITS_ERR_SEQUENCE_REQUIRED;
-            goto bliterror;
+            for (i = 0; i < n && result != -1; ++i) {
+                result = SDL_FillRect(surf, &rects[i], colors[i]);
+            }
         }
-        argrect = NULL;
-        special_flags = NULL;
-        blend_flags = 0;
+        pg_nogil_end(&nogil);
+        pgSurface_Unlock(self);
+        pgSurface_Unprep(self);
+        for (i = 0; i < n; ++i) {
+            area += (Uint64)rects[i].w * rects[i].h;
+        }
+        PG_PERF_STOP(perf_start, PG_PERF_FILL, area);
+        if (result == -1) {
+            PyErr_SetString(pgExc_SDLError, SDL_GetError());
+            goto error;
+        }
+        for (i = 0; i < n; ++i) {
+            pgSurface_AddDirtyRect(self, &rects[i]);
+        }
+    }
 
-        /* We know that there will be at least two items due to the
-           conditional at the start of the loop */
-        assert(itemlength >= 2);
+    PyMem_Free(rects);
+    PyMem_Free(colors);
+    Py_RETURN_NONE;
 
-        /* (Surface, dest) */
-        srcobject = PySequence_ITEM(item, 0);
-        argpos = PySequence_ITEM(item, 1);
+error:
+    PyMem_Free(rects);
+    PyMem_Free(colors);
+    return NULL;
+}
 
-        if (itemlength >= 3) {
-            /* (Surface, dest, area) */
-            argrect = PySequence_ITEM(item, 2);
+/* Gets the points for get_at_many() and set_at_many(), from a buffer of
+ * x, y pairs of 32 bit integers or a sequence of points, as a new array of
+ * 2 * count ints. Returns NULL with an exception set on error.
+ */
+static int *
+_surf_points_from_obj(PyObject *obj, Py_ssize_t *count)
+{
+    Py_buffer view;
+    PyObject *item;
+    Py_ssize_t i;
+    int has_view, ok, *points;
+
+    if ((has_view = _surf_int32_buffer(obj, &view, "points")) < 0) {
+        return NULL;
+    }
+    if (has_view) {
+        if (view.len % (2 * sizeof(int))) {
+            PyBuffer_Release(&view);
+            return RAISE(PyExc_ValueError,
+                         "points buffer length must be a multiple of 2");
         }
-        if (itemlength == 4) {
-            /* (Surface, dest, area, special_flags) */
-            special_flags = PySequence_ITEM(item, 3);
+        *count = view.len / (2 * sizeof(int));
+        if (!(points = PyMem_New(int, *count ? 2 * *count : 1))) {
+            PyBuffer_Release(&view);
+            return (int *)PyErr_NoMemory();
+        }
+        memcpy(points, view.buf, view.len);
+        PyBuffer_Release(&view);
+        return points;
+    }
+
+    if (!PySequence_Check(obj)) {
+        return RAISE(PyExc_TypeError,
+                     "points must be a sequence of points or a buffer");
+    }
+    if ((*count = PySequence_Size(obj)) < 0) {
+        return NULL;
+    }
+    if (!(points = PyMem_New(int, *count ? 2 * *count : 1))) {
+        return (int *)PyErr_NoMemory();
+    }
+    for (i = 0; i < *count; ++i) {
+        if (!(item = PySequence_GetItem(obj, i))) {
+            PyMem_Free(points);
+            return NULL;
         }
+        ok = pg_TwoIntsFromObj(item, &points[2 * i], &points[2 * i + 1]);
         Py_DECREF(item);
-        /* Clear item to avoid double deref on errors */
-        item = NULL;
+        if (!ok) {
+            PyMem_Free(points);
+            return (int *)PyErr_Format(PyExc_TypeError,
+                                       "invalid point at index %zd", i);
+        }
+    }
+    return points;
+}
 
-        if (!pgSurface_Check(srcobject)) {
-            bliterrornum = BLITS_ERR_SOURCE_NOT_SURFACE;
-            goto bliterror;
+static PyObject *
+surf_get_at_many(PyObject *self, PyObject *args, PyObject *kwargs)
+{
+    SDL_Surface *surf = pgSurface_AsSurface(self);
+    PyObject *points_obj, *out = Py_None, *bytes = NULL, *ret;
+    Py_buffer view;
+    Py_ssize_t count, i, bad = -1;
+    Uint32 *colors;
+    Uint8 *pixels, *pix;
+    int *points, x, y, bpp, pitch;
+
+    static char *kwids[] = {"points", "out", NULL};
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "O|O", kwids, &points_obj,
+                                     &out)) {
+        return NULL;
+    }
+    SURF_INIT_CHECK(surf)
+
+    bpp = PG_SURF_BytesPerPixel(surf);
+    if (bpp < 1 || bpp > 4) {
+        return RAISE(PyExc_RuntimeError, "invalid color depth for surface");
+    }
+    if (!(points = _surf_points_from_obj(points_obj, &count))) {
+        return NULL;
+    }
+
+    /* the colors go to out or to a new bytearray, viewed as 32 bit ints */
+    if (out == Py_None) {
+        out = bytes = PyByteArray_FromStringAndSize(NULL, count * 4);
+        if (!bytes) {
+            PyMem_Free(points);
+            return NULL;
         }
+    }
+    if (PyObject_GetBuffer(out, &view, PyBUF_C_CONTIGUOUS | PyBUF_WRITABLE)) {
+        PyMem_Free(points);
+        Py_XDECREF(bytes);
+        return NULL;
+    }
+    if (view.len != count * 4) {
+        PyBuffer_Release(&view);
+        PyMem_Free(points);
+        Py_XDECREF(bytes);
+        return RAISE(PyExc_ValueError,
+                     "out must have 4 bytes for every point");
+    }
 
-        src = pgSurface_AsSurface(srcobject);
-        if (!dest) {
-            bliterrornum = BLITS_ERR_DISPLAY_SURF_QUIT;
-            goto bliterror;
+    if (!pgSurface_Lock((pgSurfaceObject *)self)) {
+        PyBuffer_Release(&view);
+        PyMem_Free(points);
+        Py_XDECREF(bytes);
+        return NULL;
+    }
+    colors = (Uint32 *)view.buf;
+    pixels = (Uint8 *)surf->pixels;
+    pitch = surf->pitch;
+    Py_BEGIN_ALLOW_THREADS;
+    for (i = 0; i < count; ++i) {
+        x = points[2 * i];
+        y = points[2 * i + 1];
+        if (x < 0 || x >= surf->w || y < 0 || y >= surf->h) {
+            bad = i;
+            break;
         }
-        if (!src) {
-            bliterrornum = BLITS_ERR_SEQUENCE_SURF;
-            goto bliterror;
+        pix = pixels + (size_t)y * pitch + (size_t)x * bpp;
+        switch (bpp) {
+            case 1:
+                colors[i] = *pix;
+                break;
+            case 2:
+                colors[i] = *(Uint16 *)pix;
+                break;
+            case 3:
+#if SDL_BYTEORDER == SDL_LIL_ENDIAN
+                colors[i] = pix[0] + (pix[1] << 8) + (pix[2] << 16);
+#else
+                colors[i] = pix[2] + (pix[1] << 8) + (pix[0] << 16);
+#endif
+                break;
+            default: /* case 4: */
+                colors[i] = *(Uint32 *)pix;
+                break;
         }
+    }
+    Py_END_ALLOW_THREADS;
+    PyBuffer_Release(&view);
+    PyMem_Free(points);
 
-        if ((src_rect = pgRect_FromObject(argpos, &temp))) {
-            dx = src_rect->x;
-            dy = src_rect->y;
-        }
-        else if (pg_TwoIntsFromObj(argpos, &sx, &sy)) {
-            dx = sx;
-            dy = sy;
+    if (!pgSurface_Unlock((pgSurfaceObject *)self)) {
+        Py_XDECREF(bytes);
+        return NULL;
+    }
+    if (bad >= 0) {
+        Py_XDECREF(bytes);
+        return PyErr_Format(PyExc_IndexError,
+                            "pixel index out of range at index %zd", bad);
+    }
+    if (!bytes) {
+        Py_INCREF(out);
+        return out;
+    }
+
+    /* cast the bytearray to a view of unsigned 32 bit ints */
+    if (!(ret = PyMemoryView_FromObject(bytes))) {
+        Py_DECREF(bytes);
+        return NULL;
+    }
+    Py_DECREF(bytes);
+    Py_SETREF(ret, PyObject_CallMethod(ret, "cast", "s", "I"));
+    return ret;
+}
+
+static PyObject *
+surf_set_at_many(PyObject *self, PyObject *args, PyObject *kwargs)
+{
+    SDL_Surface *surf = pgSurface_AsSurface(self);
+    SDL_PixelFormat *format;
+    SDL_Rect clip, dirty;
+    PyObject *points_obj, *colors_obj, *item;
+    Py_buffer view;
+    Py_ssize_t count, i;
+    Uint32 color = 0, *colors = NULL;
+    Uint8 *pixels, *pix;
+    int *points, x, y, bpp, pitch, has_view, result;
+    int x0 = INT_MAX, y0 = INT_MAX, x1 = INT_MIN, y1 = INT_MIN;
+
+    static char *kwids[] = {"points", "colors", NULL};
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "OO", kwids, &points_obj,
+                                     &colors_obj)) {
+        return NULL;
+    }
+    SURF_INIT_CHECK(surf)
+
+    format = surf->format;
+    bpp = PG_FORMAT_BytesPerPixel(format);
+    if (bpp < 1 || bpp > 4) {
+        return RAISE(PyExc_RuntimeError, "invalid color depth for surface");
+    }
+    if (!(points = _surf_points_from_obj(points_obj, &count))) {
+        return NULL;
+    }
+
+    /* the colors, like for fill_many(): a buffer of mapped colors, a color
+     * for all the points or a sequence of colors */
+    has_view = _surf_int32_buffer(colors_obj, &view, NULL);
+    if (has_view || !pg_MappedColorFromObj(colors_obj, format, &color,
+                                           PG_COLOR_HANDLE_ALL)) {
+        PyErr_Clear();
+        if (has_view) {
+            if (view.len / 4 != count) {
+                PyBuffer_Release(&view);
+                PyErr_SetString(PyExc_ValueError,
+                                "colors must have one color for every point");
+                goto error;
+            }
+            if (!(colors = PyMem_New(Uint32, count ? count : 1))) {
+                PyBuffer_Release(&view);
+                PyErr_NoMemory();
+                goto error;
+            }
+            memcpy(colors, view.buf, count * sizeof(Uint32));
+            PyBuffer_Release(&view);
         }
         else {
-            bliterrornum = BLITS_ERR_INVALID_DESTINATION;
-            goto bliterror;
-        }
-        if (argrect && argrect != Py_None) {
-            if (!(src_rect = pgRect_FromObject(argrect, &temp))) {
-                bliterrornum = BLITS_ERR_INVALID_RECT_STYLE;
-                goto bliterror;
+            if (!PySequence_Check(colors_obj)) {
+                PyErr_SetString(PyExc_TypeError,
+                                "colors must be a color or a sequence of "
+                                "colors");
+                goto error;
+            }
+            if (PySequence_Size(colors_obj) != count) {
+                if (!PyErr_Occurred()) {
+                    PyErr_SetString(
+                        PyExc_ValueError,
+                        "colors must have one color for every point");
+                }
+                goto error;
+            }
+            if (!(colors = PyMem_New(Uint32, count ? count : 1))) {
+                PyErr_NoMemory();
+                goto error;
+            }
+            for (i = 0; i < count; ++i) {
+                if (!(item = PySequence_GetItem(colors_obj, i))) {
+                    goto error;
+                }
+                result = pg_MappedColorFromObj(item, format, &colors[i],
+                                               PG_COLOR_HANDLE_ALL);
+                Py_DECREF(item);
+                if (!result) {
+                    goto error;
+                }
             }
         }
-        else {
-            temp.x = temp.y = 0;
-            temp.w = src->w;
-            temp.h = src->h;
-            src_rect = &temp;
+    }
+
+    if (!pgSurface_Lock((pgSurfaceObject *)self)) {
+        goto error;
+    }
+    clip = surf->clip_rect;
+    pixels = (Uint8 *)surf->pixels;
+    pitch = surf->pitch;
+    Py_BEGIN_ALLOW_THREADS;
+    for (i = 0; i < count; ++i) {
+        x = points[2 * i];
+        y = points[2 * i + 1];
+        if (x < clip.x || x >= clip.x + clip.w || y < clip.y ||
+            y >= clip.y + clip.h) {
+            /* out of clip area */
+            continue;
+        }
+        if (colors) {
+            color = colors[i];
+        }
+        pix = pixels + (size_t)y * pitch + (size_t)x * bpp;
+        switch (bpp) {
+            case 1:
+                *pix = (Uint8)color;
+                break;
+            case 2:
+                *(Uint16 *)pix = (Uint16)color;
+                break;
+            case 3:
+#if SDL_BYTEORDER == SDL_LIL_ENDIAN
+                pix[format->Rshift >> 3] = (Uint8)(color >> format->Rshift);
+                pix[format->Gshift >> 3] = (Uint8)(color >> format->Gshift);
+                pix[format->Bshift >> 3] = (Uint8)(color >> format->Bshift);
+#else
+                pix[2 - (format->Rshift >> 3)] =
+                    (Uint8)(color >> format->Rshift);
+                pix[2 - (format->Gshift >> 3)] =
+                    (Uint8)(color >> format->Gshift);
+                pix[2 - (format->Bshift >> 3)] =
+                    (Uint8)(color >> format->Bshift);
+#endif
+                break;
+            default: /* case 4: */
+                *(Uint32 *)pix = color;
+                break;
+        }
+        x0 = MIN(x0, x);
+        y0 = MIN(y0, y);
+        x1 = MAX(x1, x);
+        y1 = MAX(y1, y);
+    }
+    Py_END_ALLOW_THREADS;
+    PyMem_Free(points);
+    PyMem_Free(colors);
+
+    if (!pgSurface_Unlock((pgSurfaceObject *)self)) {
+        return NULL;
+    }
+    if (x0 <= x1) {
+        dirty.x = x0;
+        dirty.y = y0;
+        dirty.w = x1 - x0 + 1;
+        dirty.h = y1 - y0 + 1;
+        pgSurface_AddDirtyRect((pgSurfaceObject *)self, &dirty);
+    }
+    Py_RETURN_NONE;
+
+error:
+    PyMem_Free(points);
+    PyMem_Free(colors);
+    return NULL;
+}
+
+/* SurfaceView: a rectangle of a surface that blit() and fblits() take as a
+ * source, blitting that area of the surface. Unlike a subsurface it has no
+ * SDL_Surface of its own, just a reference to the surface and the rect. */
+typedef struct {
+    PyObject_HEAD pgSurfaceObject *surface;
+    SDL_Rect rect;
+} pgSurfaceViewObject;
+
+#define pgSurfaceView_Check(x) (PyObject_TypeCheck((x), &pgSurfaceView_Type))
+
+/* Sets src to the area of the view's surface to blit, for the area of the
+ * view (NULL for all of it). Like SDL does for a source rect and its surface,
+ * the area is clipped to the view, moving dest along. Returns the surface to
+ * blit, or NULL with an exception if the view no longer fits inside it. */
+static pgSurfaceObject *
+_surfview_blit_area(pgSurfaceViewObject *view, SDL_Rect *area, SDL_Rect *src,
+                    SDL_Rect *dest)
+{
+    SDL_Surface *surf = pgSurface_AsSurface(view->surface);
+    SDL_Rect r;
+
+    if (!surf) {
+        PyErr_SetString(pgExc_SDLError, "Surface is not initialized");
+        return NULL;
+    }
+    if (view->rect.x + view->rect.w > surf->w ||
+        view->rect.y + view->rect.h > surf->h) {
+        PyErr_SetString(PyExc_ValueError,
+                        "SurfaceView rectangle outside surface area");
+        return NULL;
+    }
+
+    if (area) {
+        r = *area;
+    }
+    else {
+        r.x = r.y = 0;
+        r.w = view->rect.w;
+        r.h = view->rect.h;
+    }
+    if (r.x < 0) {
+        r.w += r.x;
+        dest->x -= r.x;
+        r.x = 0;
+    }
+    if (r.y < 0) {
+        r.h += r.y;
+        dest->y -= r.y;
+        r.y = 0;
+    }
+    src->x = view->rect.x + r.x;
+    src->y = view->rect.y + r.y;
+    src->w = MAX(0, MIN(r.w, view->rect.w - r.x));
+    src->h = MAX(0, MIN(r.h, view->rect.h - r.y));
+    dest->w = src->w;
+    dest->h = src->h;
+    return view->surface;
+}
+
+/* blit() with a SurfaceView as the source */
+static PyObject *
+_surf_blit_view(pgSurfaceObject *self, pgSurfaceViewObject *view,
+                PyObject *argpos, PyObject *argrect, PyObject *argflags)
+{
+    SDL_Rect *rect, temp, area, src_rect, dest_rect;
+    pgSurfaceObject *srcobject;
+    int blend_flags = 0;
+
+    if (argflags && !pg_IntFromFastcallArg(argflags, &blend_flags))
+        return NULL;
+    SURF_INIT_CHECK(pgSurface_AsSurface(self))
+
+    if (pg_TwoIntsFromFastObj(argpos, &dest_rect.x, &dest_rect.y)) {
+    }
+    else if ((rect = pgRect_FromObject(argpos, &temp))) {
+        dest_rect.x = rect->x;
+        dest_rect.y = rect->y;
+    }
+    else
+        return RAISE(PyExc_TypeError, "invalid destination position for blit");
+
+    rect = NULL;
+    if (argrect && argrect != Py_None) {
+        if (!(rect = pgRect_FromObject(argrect, &area)))
+            return RAISE(PyExc_TypeError, "Invalid rectstyle argument");
+    }
+    if (!(srcobject = _surfview_blit_area(view, rect, &src_rect, &dest_rect)))
+        return NULL;
+
+    if (pgSurface_Blit(self, srcobject, &dest_rect, &src_rect, blend_flags))
+        return NULL;
+    return pgRect_New(&dest_rect);
+}
+
+static PyObject *
+surf_blit(pgSurfaceObject *self, PyObject *const *args, Py_ssize_t nargs,
+          PyObject *kwnames)
+{
+    SDL_Surface *src, *dest = pgSurface_AsSurface(self);
+    SDL_Rect *src_rect, temp;
+    PyObject *argpos, *argrect;
+    pgSurfaceObject *srcobject;
+    int dx, dy, result;
+    SDL_Rect dest_rect;
+    int sx, sy;
+    int blend_flags = 0;
+
+    static char *kwids[] = {"source", "dest", "area", "special_flags", NULL};
+    PyObject *parsed[4] = {NULL, NULL, NULL, NULL};
+    if (!pg_ParseFastcallArgs("blit", args, nargs, kwnames, kwids, 2,
+                              parsed))
+        return NULL;
+    if (pgSurfaceView_Check(parsed[0])) {
+        return _surf_blit_view(self, (pgSurfaceViewObject *)parsed[0],
+                               parsed[1], parsed[2], parsed[3]);
+    }
+    if (!PyObject_TypeCheck(parsed[0], &pgSurface_Type)) {
+        return PyErr_Format(PyExc_TypeError,
+                            "blit() argument 1 must be pygame.surface.Surface,"
+                            " not %s",
+                            Py_TYPE(parsed[0])->tp_name);
+    }
+    srcobject = (pgSurfaceObject *)parsed[0];
+    argpos = parsed[1];
+    argrect = parsed[2];
+    if (parsed[3] && !pg_IntFromFastcallArg(parsed[3], &blend_flags))
+        return NULL;
+
+    src = pgSurface_AsSurface(srcobject);
+    SURF_INIT_CHECK(src)
+    SURF_INIT_CHECK(dest)
+
+    /* positions are checked first, they are far more common than rects */
+    if (pg_TwoIntsFromFastObj(argpos, &sx, &sy)) {
+        dx = sx;
+        dy = sy;
+    }
+    else if ((src_rect = pgRect_FromObject(argpos, &temp))) {
+        dx = src_rect->x;
+        dy = src_rect->y;
+    }
+    else
+        return RAISE(PyExc_TypeError, "invalid destination position for blit");
+
+    if (argrect && argrect != Py_None) {
+        if (!(src_rect = pgRect_FromObject(argrect, &temp)))
+            return RAISE(PyExc_TypeError, "Invalid rectstyle argument");
+    }
+    else {
+        temp.x = temp.y = 0;
+        temp.w = src->w;
+        temp.h = src->h;
+        src_rect = &temp;
+    }
+
+    dest_rect.x = dx;
+    dest_rect.y = dy;
+    dest_rect.w = src_rect->w;
+    dest_rect.h = src_rect->h;
+
+    if (!blend_flags)
+        blend_flags = 0;
+
+    result =
+        pgSurface_Blit(self, srcobject, &dest_rect, src_rect, blend_flags);
+
+    if (result != 0)
+        return NULL;
+
+    return pgRect_New(&dest_rect);
+}
+
+#define BLITS_ERR_SEQUENCE_REQUIRED 1
+#define BLITS_ERR_DISPLAY_SURF_QUIT 2
+#define BLITS_ERR_SEQUENCE_SURF 3
+#define BLITS_ERR_NO_OPENGL_SURF 4
+#define BLITS_ERR_INVALID_DESTINATION 5
+#define BLITS_ERR_INVALID_RECT_STYLE 6
+#define BLITS_ERR_MUST_ASSIGN_NUMERIC 7
+#define BLITS_ERR_BLIT_FAIL 8
+#define BLITS_ERR_PY_EXCEPTION_RAISED 9
+#define BLITS_ERR_SOURCE_NOT_SURFACE 10
+
+static PyObject *
+surf_blits(pgSurfaceObject *self, PyObject *args, PyObject *keywds)
+{
+    SDL_Surface *src, *dest = pgSurface_AsSurface(self);
+    SDL_Rect *src_rect, temp;
+    PyObject *srcobject = NULL, *argpos = NULL, *argrect = NULL;
+    int dx, dy, result;
+    SDL_Rect dest_rect;
+    int sx, sy;
+    int blend_flags = 0;
+
+    PyObject *blitsequence;
+    PyObject *iterator = NULL;
+    PyObject *item = NULL;
+    PyObject *special_flags = NULL;
+    PyObject *ret = NULL;
+    PyObject *retrect = NULL;
+    PyObject *items = NULL;
+    Py_ssize_t itemlength, sequencelength, curriter = 0;
+    int doreturn = 1;
+    int bliterrornum = 0;
+    int issequence = 0;
+    int parallel = 0;
+    pg_BlitQueue *queue = NULL;
+
+    static char *kwids[] = {"blit_sequence", "doreturn", "parallel", NULL};
+
+    SURF_INIT_CHECK(dest)
+    if (!PyArg_ParseTupleAndKeywords(args, keywds, "O|ip", kwids,
+                                     &blitsequence, &doreturn, &parallel))
+        return NULL;
+
+    if (!PyIter_Check(blitsequence) &&
+        !(issequence = PySequence_Check(blitsequence))) {
+        bliterrornum = BLITS_ERR_SEQUENCE_REQUIRED;
+        goto bliterror;
+    }
+
+    /* Queued blits read their sources later, see surf_fblits() */
+    if (parallel && pg_get_blit_threads() > 1) {
+        if (!pgSequenceFast_Check(blitsequence)) {
+            if (!(items = PySequence_List(blitsequence))) {
+                return NULL;
+            }
+            blitsequence = items;
+            issequence = 1;
+        }
+        queue = pg_blit_queue_new();
+    }
+
+    if (doreturn) {
+        /* If the sequence is countable, meaning not a generator, we can get
+         * faster rect appending to the list by pre allocating it
+         * to later call the more efficient SET_ITEM*/
+        if (issequence) {
+            sequencelength = PySequence_Size(blitsequence);
+            if (sequencelength == -1) {
+                bliterrornum = BLITS_ERR_PY_EXCEPTION_RAISED;
+                goto bliterror;
+            }
+
+            ret = PyList_New(sequencelength);
+        }
+        else {
+            ret = PyList_New(0);
+        }
+        if (!ret) {
+            bliterrornum = BLITS_ERR_PY_EXCEPTION_RAISED;
+            goto bliterror;
+        }
+    }
+
+    iterator = PyObject_GetIter(blitsequence);
+    if (!iterator) {
+        bliterrornum = BLITS_ERR_PY_EXCEPTION_RAISED;
+        goto bliterror;
+    }
+
+    while ((item = PyIter_Next(iterator))) {
+        if (PySequence_Check(item)) {
+            itemlength = PySequence_Length(item);
+            if (itemlength > 4 || itemlength < 2) {
+                bliterrornum = BLITS_ERR_SEQUENCE_REQUIRED;
+                goto bliterror;
+            }
+        }
+        else {
+            bliterrornum = BLITS_ERR_SEQUENCE_REQUIRED;
+            goto bliterror;
+        }
+        argrect = NULL;
+        special_flags = NULL;
+        blend_flags = 0;
+
+        /* We know that there will be at least two items due to the
+           conditional at the start of the loop */
+        assert(itemlength >= 2);
+
+        /* (Surface, dest) */
+        srcobject = PySequence_ITEM(item, 0);
+        argpos = PySequence_ITEM(item, 1);
+
+        if (itemlength >= 3) {
+            /* (Surface, dest, area) */
+            argrect = PySequence_ITEM(item, 2);
+        }
+        if (itemlength == 4) {
+            /* (Surface, dest, area, special_flags) */
+            special_flags = PySequence_ITEM(item, 3);
+        }
+        Py_DECREF(item);
+        /* Clear item to avoid double deref on errors */
+        item = NULL;
+
+        if (!pgSurface_Check(srcobject)) {
+            bliterrornum = BLITS_ERR_SOURCE_NOT_SURFACE;
+            goto bliterror;
+        }
+
+        src = pgSurface_AsSurface(srcobject);
+        if (!dest) {
+            bliterrornum = BLITS_ERR_DISPLAY_SURF_QUIT;
+            goto bliterror;
+        }
+        if (!src) {
+            bliterrornum = BLITS_ERR_SEQUENCE_SURF;
+            goto bliterror;
+        }
+
+        if ((src_rect = pgRect_FromObject(argpos, &temp))) {
+            dx = src_rect->x;
+            dy = src_rect->y;
+        }
+        else if (pg_TwoIntsFromObj(argpos, &sx, &sy)) {
+            dx = sx;
+            dy = sy;
+        }
+        else {
+            bliterrornum = BLITS_ERR_INVALID_DESTINATION;
+            goto bliterror;
+        }
+        if (argrect && argrect != Py_None) {
+            if (!(src_rect = pgRect_FromObject(argrect, &temp))) {
+                bliterrornum = BLITS_ERR_INVALID_RECT_STYLE;
+                goto bliterror;
+            }
+        }
+        else {
+            temp.x = temp.y = 0;
+            temp.w = src->w;
+            temp.h = src->h;
+            src_rect = &temp;
+        }
+
+        dest_rect.x = dx;
+        dest_rect.y = dy;
+        dest_rect.w = src_rect->w;
+        dest_rect.h = src_rect->h;
+
+        if (special_flags) {
+            if (!pg_IntFromObj(special_flags, &blend_flags)) {
+                bliterrornum = BLITS_ERR_MUST_ASSIGN_NUMERIC;
+                goto bliterror;
+            }
+        }
+
+        result = _surf_blit(self, (pgSurfaceObject *)srcobject, &dest_rect,
+                            src_rect, blend_flags, queue);
+
+        if (result != 0) {
+            bliterrornum = BLITS_ERR_BLIT_FAIL;
+            goto bliterror;
+        }
+
+        if (doreturn) {
+            retrect = NULL;
+            retrect = pgRect_New(&dest_rect);
+
+            /* If the sequence is countable, we already pre allocated a list
+             * of matching size. Now we can use the efficient PyList_SET_ITEM
+             * to add elements to the list */
+            if (issequence) {
+                PyList_SET_ITEM(ret, curriter++, retrect);
+            }
+            else if (PyList_Append(ret, retrect) != -1) {
+                Py_DECREF(retrect);
+            }
+            else {
+                Py_DECREF(retrect);
+                retrect = NULL;
+                bliterrornum = BLITS_ERR_PY_EXCEPTION_RAISED;
+                goto bliterror;
+            }
+            retrect = NULL; /* Clear to avoid double deref on errors */
+        }
+        Py_DECREF(srcobject);
+        Py_DECREF(argpos);
+        Py_XDECREF(argrect);
+        Py_XDECREF(special_flags);
+        /* Clear to avoid double deref on errors */
+        srcobject = NULL;
+        argpos = NULL;
+        argrect = NULL;
+        special_flags = NULL;
+    }
+
+    Py_DECREF(iterator);
+    pg_blit_queue_free(queue);
+    Py_XDECREF(items);
+    if (PyErr_Occurred()) {
+        Py_XDECREF(ret);
+        return NULL;
+    }
+
+    if (doreturn) {
+        return ret;
+    }
+    else {
+        Py_RETURN_NONE;
+    }
+
+bliterror:
+    /* the blits before the failing item are drawn, as without the queue */
+    pg_blit_queue_free(queue);
+    Py_XDECREF(items);
+    Py_XDECREF(srcobject);
+    Py_XDECREF(argpos);
+    Py_XDECREF(argrect);
+    Py_XDECREF(retrect);
+    Py_XDECREF(special_flags);
+    Py_XDECREF(iterator);
+    Py_XDECREF(item);
+    Py_XDECREF(ret);
+
+    switch (bliterrornum) {
+        case BLITS_ERR_SEQUENCE_REQUIRED:
+            return RAISE(
+                PyExc_ValueError,
+                "blit_sequence should be iterator of (Surface, dest)");
+        case BLITS_ERR_DISPLAY_SURF_QUIT:
+            return RAISE(pgExc_SDLError, "display Surface quit");
+        case BLITS_ERR_SEQUENCE_SURF:
+            return RAISE(PyExc_TypeError,
+                         "First element of blit_list needs to be Surface.");
+        case BLITS_ERR_INVALID_DESTINATION:
+            return RAISE(PyExc_TypeError,
+                         "invalid destination position for blit");
+        case BLITS_ERR_INVALID_RECT_STYLE:
+            return RAISE(PyExc_TypeError, "Invalid rectstyle argument");
+        case BLITS_ERR_MUST_ASSIGN_NUMERIC:
+            return RAISE(PyExc_TypeError, "Must assign numeric values");
+        case BLITS_ERR_BLIT_FAIL:
+            return RAISE(PyExc_TypeError, "Blit failed");
+        case BLITS_ERR_PY_EXCEPTION_RAISED:
+            return NULL; /* Raising a previously set exception */
+        case BLITS_ERR_SOURCE_NOT_SURFACE:
+            return RAISE(PyExc_TypeError, "Source objects must be a surface");
+    }
+    return RAISE(PyExc_TypeError, "Unknown error");
+}
+
+#define FBLITS_ERR_TUPLE_REQUIRED 11
+#define FBLITS_ERR_INCORRECT_ARGS_NUM 12
+#define FBLITS_ERR_FLAG_NOT_NUMERIC 13
+#define FBLITS_ERR_ALPHA_NOT_NUMERIC 14
+
+/* BlitBatch: a reusable, pre-validated list of (Surface, dest) pairs for
+ * Surface.fblits(). Sources are kept as strong references in one array and
+ * destinations as contiguous (x, y) int pairs, so that blitting a batch needs
+ * no per-item Python object handling. The positions are exported through the
+ * buffer protocol so they can be updated in place. */
+typedef struct {
+    PyObject_HEAD Py_ssize_t length;
+    Py_ssize_t capacity;
+    pgSurfaceObject **sources;
+    int *positions;
+    Py_ssize_t exports; /* number of live buffer exports of positions */
+    PyObject *weakreflist;
+} pgBlitBatchObject;
+
+#define pgBlitBatch_Check(x) (PyObject_TypeCheck((x), &pgBlitBatch_Type))
+
+static int
+_blitbatch_reserve(pgBlitBatchObject *self, Py_ssize_t size)
+{
+    Py_ssize_t new_capacity;
+    pgSurfaceObject **new_sources;
+    int *new_positions;
+
+    if (self->exports > 0) {
+        PyErr_SetString(PyExc_BufferError,
+                        "cannot resize a BlitBatch while its positions "
+                        "buffer is exported");
+        return -1;
+    }
+    if (size <= self->capacity) {
+        return 0;
+    }
+
+    new_capacity = self->capacity ? self->capacity : 8;
+    while (new_capacity < size) {
+        new_capacity *= 2;
+    }
+
+    new_sources =
+        PyMem_Realloc(self->sources, sizeof(pgSurfaceObject *) * new_capacity);
+    if (!new_sources) {
+        PyErr_NoMemory();
+        return -1;
+    }
+    self->sources = new_sources;
+
+    new_positions =
+        PyMem_Realloc(self->positions, sizeof(int) * 2 * new_capacity);
+    if (!new_positions) {
+        PyErr_NoMemory();
+        return -1;
+    }
+    self->positions = new_positions;
+    self->capacity = new_capacity;
+    return 0;
+}
+
+/* Validates a (Surface, dest) pair. Returns a borrowed reference to the
+ * Surface and fills in x and y, or sets an exception and returns NULL. */
+static pgSurfaceObject *
+_blitbatch_parse_item(PyObject *source, PyObject *dest, int *x, int *y)
+{
+    SDL_Rect *rect, temp;
+
+    if (!pgSurface_Check(source)) {
+        return (pgSurfaceObject *)RAISE(PyExc_TypeError,
+                                        "Source objects must be a Surface");
+    }
+    if (pg_TwoIntsFromObj(dest, x, y)) {
+        return (pgSurfaceObject *)source;
+    }
+    if ((rect = pgRect_FromObject(dest, &temp))) {
+        *x = rect->x;
+        *y = rect->y;
+        return (pgSurfaceObject *)source;
+    }
+    return (pgSurfaceObject *)RAISE(PyExc_TypeError,
+                                    "invalid destination position for blit");
+}
+
+static int
+_blitbatch_append(pgBlitBatchObject *self, PyObject *source, PyObject *dest)
+{
+    int x, y;
+    pgSurfaceObject *surf = _blitbatch_parse_item(source, dest, &x, &y);
+
+    if (!surf || _blitbatch_reserve(self, self->length + 1)) {
+        return -1;
+    }
+
+    Py_INCREF(surf);
+    self->sources[self->length] = surf;
+    self->positions[2 * self->length] = x;
+    self->positions[2 * self->length + 1] = y;
+    self->length++;
+    return 0;
+}
+
+static int
+_blitbatch_extend(pgBlitBatchObject *self, PyObject *sequence)
+{
+    PyObject *fast, *item;
+    Py_ssize_t i, size;
+
+    fast = PySequence_Fast(
+        sequence, "blit_sequence should be iterator of (Surface, dest)");
+    if (!fast) {
+        return -1;
+    }
+    size = PySequence_Fast_GET_SIZE(fast);
+    if (_blitbatch_reserve(self, self->length + size)) {
+        Py_DECREF(fast);
+        return -1;
+    }
+    for (i = 0; i < size; i++) {
+        item = PySequence_Fast_GET_ITEM(fast, i);
+        if (!PyTuple_Check(item) || PyTuple_GET_SIZE(item) != 2) {
+            Py_DECREF(fast);
+            PyErr_SetString(
+                PyExc_ValueError,
+                "Blit_sequence item should be a tuple of (Surface, dest)");
+            return -1;
+        }
+        if (_blitbatch_append(self, PyTuple_GET_ITEM(item, 0),
+                              PyTuple_GET_ITEM(item, 1))) {
+            Py_DECREF(fast);
+            return -1;
+        }
+    }
+    Py_DECREF(fast);
+    return 0;
+}
+
+static void
+_blitbatch_clear(pgBlitBatchObject *self)
+{
+    Py_ssize_t i, length = self->length;
+
+    /* Reset the length first, in case a source dealloc re-enters us */
+    self->length = 0;
+    for (i = 0; i < length; i++) {
+        Py_DECREF(self->sources[i]);
+    }
+}
+
+static PyObject *
+blitbatch_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
+{
+    pgBlitBatchObject *self = (pgBlitBatchObject *)type->tp_alloc(type, 0);
+
+    if (self) {
+        self->length = self->capacity = 0;
+        self->sources = NULL;
+        self->positions = NULL;
+        self->exports = 0;
+        self->weakreflist = NULL;
+    }
+    return (PyObject *)self;
+}
+
+static int
+blitbatch_init(pgBlitBatchObject *self, PyObject *args, PyObject *kwds)
+{
+    PyObject *sequence = NULL;
+    static char *kwids[] = {"blit_sequence", NULL};
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "|O", kwids, &sequence)) {
+        return -1;
+    }
+    if (self->exports > 0) {
+        PyErr_SetString(PyExc_BufferError,
+                        "cannot resize a BlitBatch while its positions "
+                        "buffer is exported");
+        return -1;
+    }
+    _blitbatch_clear(self);
+    if (sequence && _blitbatch_extend(self, sequence)) {
+        return -1;
+    }
+    return 0;
+}
+
+static int
+blitbatch_traverse(pgBlitBatchObject *self, visitproc visit, void *arg)
+{
+    Py_ssize_t i;
+
+    for (i = 0; i < self->length; i++) {
+        Py_VISIT(self->sources[i]);
+    }
+    return 0;
+}
+
+static int
+blitbatch_tp_clear(pgBlitBatchObject *self)
+{
+    _blitbatch_clear(self);
+    return 0;
+}
+
+static void
+blitbatch_dealloc(pgBlitBatchObject *self)
+{
+    PyObject_GC_UnTrack(self);
+    if (self->weakreflist) {
+        PyObject_ClearWeakRefs((PyObject *)self);
+    }
+    _blitbatch_clear(self);
+    PyMem_Free(self->sources);
+    PyMem_Free(self->positions);
+    Py_TYPE(self)->tp_free((PyObject *)self);
+}
+
+static PyObject *
+blitbatch_append(pgBlitBatchObject *self, PyObject *const *args,
+                 Py_ssize_t nargs)
+{
+    if (nargs != 2) {
+        return RAISE(PyExc_TypeError,
+                     "append requires a source Surface and a destination");
+    }
+    if (_blitbatch_append(self, args[0], args[1])) {
+        return NULL;
+    }
+    Py_RETURN_NONE;
+}
+
+static PyObject *
+blitbatch_extend(pgBlitBatchObject *self, PyObject *sequence)
+{
+    if (_blitbatch_extend(self, sequence)) {
+        return NULL;
+    }
+    Py_RETURN_NONE;
+}
+
+static PyObject *
+blitbatch_clear(pgBlitBatchObject *self, PyObject *_null)
+{
+    if (self->exports > 0) {
+        return RAISE(PyExc_BufferError,
+                     "cannot resize a BlitBatch while its positions "
+                     "buffer is exported");
+    }
+    _blitbatch_clear(self);
+    Py_RETURN_NONE;
+}
+
+static Py_ssize_t
+blitbatch_length(pgBlitBatchObject *self)
+{
+    return self->length;
+}
+
+static PyObject *
+blitbatch_item(pgBlitBatchObject *self, Py_ssize_t index)
+{
+    PyObject *pos;
+
+    if (index < 0 || index >= self->length) {
+        return RAISE(PyExc_IndexError, "BlitBatch index out of range");
+    }
+    pos = pg_tuple_couple_from_values_int(self->positions[2 * index],
+                                          self->positions[2 * index + 1]);
+    if (!pos) {
+        return NULL;
+    }
+    return Py_BuildValue("(ON)", (PyObject *)self->sources[index], pos);
+}
+
+static int
+blitbatch_ass_item(pgBlitBatchObject *self, Py_ssize_t index, PyObject *value)
+{
+    int x, y;
+    pgSurfaceObject *surf, *old;
+
+    if (index < 0 || index >= self->length) {
+        PyErr_SetString(PyExc_IndexError,
+                        "BlitBatch assignment index out of range");
+        return -1;
+    }
+    if (!value) {
+        PyErr_SetString(PyExc_TypeError,
+                        "BlitBatch does not support item deletion");
+        return -1;
+    }
+    if (!PyTuple_Check(value) || PyTuple_GET_SIZE(value) != 2) {
+        PyErr_SetString(PyExc_ValueError,
+                        "BlitBatch item should be a tuple of (Surface, dest)");
+        return -1;
+    }
+    surf = _blitbatch_parse_item(PyTuple_GET_ITEM(value, 0),
+                                 PyTuple_GET_ITEM(value, 1), &x, &y);
+    if (!surf) {
+        return -1;
+    }
+
+    old = self->sources[index];
+    Py_INCREF(surf);
+    self->sources[index] = surf;
+    self->positions[2 * index] = x;
+    self->positions[2 * index + 1] = y;
+    Py_DECREF(old);
+    return 0;
+}
+
+static int
+blitbatch_getbuffer(pgBlitBatchObject *self, Py_buffer *view, int flags)
+{
+    Py_ssize_t *shape_strides;
+
+    shape_strides = PyMem_New(Py_ssize_t, 4);
+    if (!shape_strides) {
+        PyErr_NoMemory();
+        return -1;
+    }
+    shape_strides[0] = self->length;
+    shape_strides[1] = 2;
+    shape_strides[2] = 2 * sizeof(int);
+    shape_strides[3] = sizeof(int);
+
+    Py_INCREF(self);
+    view->obj = (PyObject *)self;
+    view->buf = self->positions;
+    view->len = self->length * 2 * sizeof(int);
+    view->readonly = 0;
+    view->itemsize = sizeof(int);
+    view->format = PyBUF_HAS_FLAG(flags, PyBUF_FORMAT) ? FormatInt : NULL;
+    view->ndim = PyBUF_HAS_FLAG(flags, PyBUF_ND) ? 2 : 1;
+    view->shape = PyBUF_HAS_FLAG(flags, PyBUF_ND) ? shape_strides : NULL;
+    view->strides =
+        PyBUF_HAS_FLAG(flags, PyBUF_STRIDES) ? shape_strides + 2 : NULL;
+    view->suboffsets = NULL;
+    view->internal = shape_strides;
+    self->exports++;
+    return 0;
+}
+
+static void
+blitbatch_releasebuffer(pgBlitBatchObject *self, Py_buffer *view)
+{
+    PyMem_Free(view->internal);
+    self->exports--;
+}
+
+static PyMethodDef blitbatch_methods[] = {
+    {"append", (PyCFunction)blitbatch_append, METH_FASTCALL,
+     DOC_BLITBATCH_APPEND},
+    {"extend", (PyCFunction)blitbatch_extend, METH_O, DOC_BLITBATCH_EXTEND},
+    {"clear", (PyCFunction)blitbatch_clear, METH_NOARGS, DOC_BLITBATCH_CLEAR},
+    {NULL, NULL, 0, NULL}};
+
+static PySequenceMethods blitbatch_as_sequence = {
+    .sq_length = (lenfunc)blitbatch_length,
+    .sq_item = (ssizeargfunc)blitbatch_item,
+    .sq_ass_item = (ssizeobjargproc)blitbatch_ass_item,
+};
+
+static PyBufferProcs blitbatch_as_buffer = {
+    (getbufferproc)blitbatch_getbuffer,
+    (releasebufferproc)blitbatch_releasebuffer};
+
+static PyTypeObject pgBlitBatch_Type = {
+    PyVarObject_HEAD_INIT(NULL, 0).tp_name = "pygame.surface.BlitBatch",
+    .tp_basicsize = sizeof(pgBlitBatchObject),
+    .tp_dealloc = (destructor)blitbatch_dealloc,
+    .tp_as_sequence = &blitbatch_as_sequence,
+    .tp_as_buffer = &blitbatch_as_buffer,
+    .tp_flags = Py_TPFLAGS_DEFAULT | Py_TPFLAGS_BASETYPE | Py_TPFLAGS_HAVE_GC,
+    .tp_doc = DOC_BLITBATCH,
+    .tp_traverse = (traverseproc)blitbatch_traverse,
+    .tp_clear = (inquiry)blitbatch_tp_clear,
+    .tp_weaklistoffset = offsetof(pgBlitBatchObject, weakreflist),
+    .tp_methods = blitbatch_methods,
+    .tp_init = (initproc)blitbatch_init,
+    .tp_new = blitbatch_new,
+};
+
+/* BlendMode: a custom blend equation usable as the special_flags of the blit
+ * methods. It is an int holding PYGAME_BLEND_CUSTOM flags, so every flag
+ * parser takes it as is and the blitters find the equation in the value. */
+static PyObject *
+blendmode_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
+{
+    PyObject *objs[6] = {NULL, NULL, NULL, NULL, NULL, NULL};
+    PyObject *value, *new_args, *self;
+    long fields[6];
+    int i;
+    static char *kwids[] = {"src_factor",       "dst_factor",
+                            "operation",        "alpha_src_factor",
+                            "alpha_dst_factor", "alpha_operation",
+                            NULL};
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "OOO|OOO", kwids, &objs[0],
+                                     &objs[1], &objs[2], &objs[3], &objs[4],
+                                     &objs[5])) {
+        return NULL;
+    }
+    for (i = 0; i < 6; i++) {
+        long last = (i % 3 == 2) ? SDL_BLENDOPERATION_MAXIMUM
+                                 : SDL_BLENDFACTOR_ONE_MINUS_DST_ALPHA;
+
+        /* the alpha equation defaults to the colour one */
+        if (objs[i] == NULL || objs[i] == Py_None) {
+            fields[i] = fields[i - 3];
+            continue;
+        }
+        fields[i] = PyLong_AsLong(objs[i]);
+        if (fields[i] == -1 && PyErr_Occurred()) {
+            return NULL;
+        }
+        if (fields[i] < 1 || fields[i] > last) {
+            return RAISE(PyExc_ValueError,
+                         (i % 3 == 2) ? "invalid blend operation"
+                                      : "invalid blend factor");
+        }
+    }
+
+    value = PyLong_FromLong(PG_BLEND_CUSTOM(fields[0], fields[1], fields[2],
+                                            fields[3], fields[4], fields[5]));
+    if (!value) {
+        return NULL;
+    }
+    new_args = PyTuple_Pack(1, value);
+    Py_DECREF(value);
+    if (!new_args) {
+        return NULL;
+    }
+    self = PyLong_Type.tp_new(type, new_args, NULL);
+    Py_DECREF(new_args);
+    return self;
+}
+
+static PyObject *
+blendmode_repr(PyObject *self)
+{
+    long mode = PyLong_AsLong(self);
+
+    if (mode == -1 && PyErr_Occurred()) {
+        return NULL;
+    }
+    return PyUnicode_FromFormat(
+        "BlendMode(%d, %d, %d, %d, %d, %d)", (int)PG_BLEND_CUSTOM_CSRC(mode),
+        (int)PG_BLEND_CUSTOM_CDST(mode), (int)PG_BLEND_CUSTOM_COP(mode),
+        (int)PG_BLEND_CUSTOM_ASRC(mode), (int)PG_BLEND_CUSTOM_ADST(mode),
+        (int)PG_BLEND_CUSTOM_AOP(mode));
+}
+
+static PyObject *
+blendmode_get_field(PyObject *self, void *closure)
+{
+    long mode = PyLong_AsLong(self);
+
+    if (mode == -1 && PyErr_Occurred()) {
+        return NULL;
+    }
+    return PyLong_FromLong(PG_BLEND_CUSTOM_FIELD(mode, (intptr_t)closure));
+}
+
+static PyGetSetDef blendmode_getsets[] = {
+    {"src_factor", (getter)blendmode_get_field, NULL,
+     DOC_BLENDMODE_SRCFACTOR, (void *)0},
+    {"dst_factor", (getter)blendmode_get_field, NULL,
+     DOC_BLENDMODE_DSTFACTOR, (void *)1},
+    {"operation", (getter)blendmode_get_field, NULL, DOC_BLENDMODE_OPERATION,
+     (void *)2},
+    {"alpha_src_factor", (getter)blendmode_get_field, NULL,
+     DOC_BLENDMODE_ALPHASRCFACTOR, (void *)3},
+    {"alpha_dst_factor", (getter)blendmode_get_field, NULL,
+     DOC_BLENDMODE_ALPHADSTFACTOR, (void *)4},
+    {"alpha_operation", (getter)blendmode_get_field, NULL,
+     DOC_BLENDMODE_ALPHAOPERATION, (void *)5},
+    {NULL, NULL, NULL, NULL, NULL}};
+
+static PyTypeObject pgBlendMode_Type = {
+    PyVarObject_HEAD_INIT(NULL, 0).tp_name = "pygame.surface.BlendMode",
+    .tp_basicsize = 0, /* inherited from int */
+    .tp_repr = (reprfunc)blendmode_repr,
+    .tp_flags = Py_TPFLAGS_DEFAULT,
+    .tp_doc = DOC_BLENDMODE,
+    .tp_getset = blendmode_getsets,
+    .tp_new = blendmode_new,
+};
+
+static PyObject *
+_surfview_new(PyTypeObject *type, PyObject *surfobj, PyObject *rectobj)
+{
+    SDL_Surface *surf = pgSurface_AsSurface(surfobj);
+    SDL_Rect *rect, temp;
+    pgSurfaceViewObject *self;
+
+    SURF_INIT_CHECK(surf)
+
+    if (!(rect = pgRect_FromObject(rectobj, &temp)))
+        return RAISE(PyExc_ValueError, "invalid rectstyle argument");
+    if (rect->x < 0 || rect->y < 0 || rect->w < 0 || rect->h < 0 ||
+        rect->x + rect->w > surf->w || rect->y + rect->h > surf->h)
+        return RAISE(PyExc_ValueError,
+                     "SurfaceView rectangle outside surface area");
+
+    self = (pgSurfaceViewObject *)type->tp_alloc(type, 0);
+    if (!self) {
+        return NULL;
+    }
+    Py_INCREF(surfobj);
+    self->surface = (pgSurfaceObject *)surfobj;
+    self->rect = *rect;
+    return (PyObject *)self;
+}
+
+static PyObject *
+surfview_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
+{
+    PyObject *surfobj, *rectobj;
+    static char *kwids[] = {"surface", "rect", NULL};
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "O!O", kwids,
+                                     &pgSurface_Type, &surfobj, &rectobj)) {
+        return NULL;
+    }
+    return _surfview_new(type, surfobj, rectobj);
+}
+
+static int
+surfview_traverse(pgSurfaceViewObject *self, visitproc visit, void *arg)
+{
+    Py_VISIT(self->surface);
+    return 0;
+}
+
+static int
+surfview_tp_clear(pgSurfaceViewObject *self)
+{
+    Py_CLEAR(self->surface);
+    return 0;
+}
+
+static void
+surfview_dealloc(pgSurfaceViewObject *self)
+{
+    PyObject_GC_UnTrack(self);
+    Py_CLEAR(self->surface);
+    Py_TYPE(self)->tp_free((PyObject *)self);
+}
+
+static PyObject *
+surfview_repr(pgSurfaceViewObject *self)
+{
+    return PyUnicode_FromFormat("<SurfaceView(%d, %d, %d, %d) of %R>",
+                                self->rect.x, self->rect.y, self->rect.w,
+                                self->rect.h, (PyObject *)self->surface);
+}
+
+static PyObject *
+surfview_get_surface(pgSurfaceViewObject *self, void *closure)
+{
+    Py_INCREF(self->surface);
+    return (PyObject *)self->surface;
+}
+
+static PyObject *
+surfview_get_rect(pgSurfaceViewObject *self, void *closure)
+{
+    return pgRect_New(&self->rect);
+}
+
+static PyObject *
+surfview_get_size(pgSurfaceViewObject *self, PyObject *_null)
+{
+    return pg_tuple_couple_from_values_int(self->rect.w, self->rect.h);
+}
+
+static PyObject *
+surfview_subsurface(pgSurfaceViewObject *self, PyObject *_null)
+{
+    SURF_INIT_CHECK(pgSurface_AsSurface(self->surface))
+    return _surf_subsurface((PyObject *)self->surface, &self->rect);
+}
+
+static PyGetSetDef surfview_getsets[] = {
+    {"surface", (getter)surfview_get_surface, NULL, DOC_SURFACEVIEW_SURFACE,
+     NULL},
+    {"rect", (getter)surfview_get_rect, NULL, DOC_SURFACEVIEW_RECT, NULL},
+    {NULL, NULL, NULL, NULL, NULL}};
+
+static PyMethodDef surfview_methods[] = {
+    {"get_size", (PyCFunction)surfview_get_size, METH_NOARGS,
+     DOC_SURFACEVIEW_GETSIZE},
+    {"subsurface", (PyCFunction)surfview_subsurface, METH_NOARGS,
+     DOC_SURFACEVIEW_SUBSURFACE},
+    {NULL, NULL, 0, NULL}};
+
+static PyTypeObject pgSurfaceView_Type = {
+    PyVarObject_HEAD_INIT(NULL, 0).tp_name = "pygame.surface.SurfaceView",
+    .tp_basicsize = sizeof(pgSurfaceViewObject),
+    .tp_dealloc = (destructor)surfview_dealloc,
+    .tp_repr = (reprfunc)surfview_repr,
+    .tp_flags = Py_TPFLAGS_DEFAULT | Py_TPFLAGS_HAVE_GC,
+    .tp_doc = DOC_SURFACEVIEW,
+    .tp_traverse = (traverseproc)surfview_traverse,
+    .tp_clear = (inquiry)surfview_tp_clear,
+    .tp_methods = surfview_methods,
+    .tp_getset = surfview_getsets,
+    .tp_new = surfview_new,
+};
+
+static int
+_surf_fblits_batch(pgSurfaceObject *self, pgBlitBatchObject *batch,
+                   int blend_flags, pg_BlitQueue *queue)
+{
+    Py_ssize_t i;
+    SDL_Surface *src;
+    SDL_Rect dest_rect;
+    const int *pos = batch->positions;
+
+    for (i = 0; i < batch->length; i++, pos += 2) {
+        if (!(src = pgSurface_AsSurface(batch->sources[i]))) {
+            return BLITS_ERR_SEQUENCE_SURF;
+        }
+        dest_rect.x = pos[0];
+        dest_rect.y = pos[1];
+        dest_rect.w = src->w;
+        dest_rect.h = src->h;
+
+        if (_surf_blit(self, batch->sources[i], &dest_rect, NULL, blend_flags,
+                       queue)) {
+            return BLITS_ERR_BLIT_FAIL;
+        }
+    }
+    return 0;
+}
+
+/* Whether SDL_SetSurfaceColorMod() tinted surf */
+static int
+_surf_has_color_mod(SDL_Surface *surf)
+{
+    Uint8 r, g, b;
+
+    return SDL_GetSurfaceColorMod(surf, &r, &g, &b) == 0 &&
+           (r & g & b) != 255;
+}
+
+/* Blits srcobj with its alpha and color mods multiplied by alpha and tint
+ * for the duration of the blit, so the blend kernels and SDL modulate the
+ * pixels as they go instead of a modulated copy being made. A negative
+ * alpha and a NULL tint leave the source as it is. */
+static int
+_surf_fblits_modulated(pgSurfaceObject *self, pgSurfaceObject *srcobj,
+                       SDL_Rect *dest_rect, SDL_Rect *src_rect,
+                       int blend_flags, int alpha, const Uint8 *tint,
+                       pg_BlitQueue *queue)
+{
+    SDL_Surface *src = pgSurface_AsSurface(srcobj);
+    SDL_BlendMode mode;
+    Uint8 old_alpha, r, g, b;
+    int result, blend;
+
+    if (alpha < 0 && !tint) {
+        return _surf_blit(self, srcobj, dest_rect, src_rect, blend_flags,
+                          queue);
+    }
+
+    if (SDL_GetSurfaceAlphaMod(src, &old_alpha) ||
+        SDL_GetSurfaceColorMod(src, &r, &g, &b) ||
+        SDL_GetSurfaceBlendMode(src, &mode)) {
+        PyErr_SetString(pgExc_SDLError, SDL_GetError());
+        return 1;
+    }
+    /* like set_alpha(), a translucent source is blended. That changes how
+     * the alpha spans of the source are found, which queued blits may be
+     * using, so they run first and this one can't wait. */
+    blend = alpha >= 0 && alpha != 255 && mode == SDL_BLENDMODE_NONE;
+    if (blend) {
+        pg_blit_queue_flush(queue);
+        SDL_SetSurfaceBlendMode(src, SDL_BLENDMODE_BLEND);
+    }
+    if (alpha >= 0) {
+        SDL_SetSurfaceAlphaMod(src, (Uint8)(old_alpha * alpha / 255));
+    }
+    if (tint) {
+        SDL_SetSurfaceColorMod(src, (Uint8)(r * tint[0] / 255),
+                               (Uint8)(g * tint[1] / 255),
+                               (Uint8)(b * tint[2] / 255));
+    }
+
+    result = _surf_blit(self, srcobj, dest_rect, src_rect, blend_flags,
+                        blend ? NULL : queue);
+
+    SDL_SetSurfaceColorMod(src, r, g, b);
+    SDL_SetSurfaceAlphaMod(src, old_alpha);
+    SDL_SetSurfaceBlendMode(src, mode);
+    return result;
+}
+
+static int
+_surf_fblits_view(pgSurfaceObject *self, pgSurfaceViewObject *view,
+                  PyObject *blit_pos, int blend_flags, int alpha,
+                  const Uint8 *tint, pg_BlitQueue *queue)
+{
+    pgSurfaceObject *srcobject;
+    SDL_Rect *rect, temp, src_rect, dest_rect;
+
+    if (pg_TwoIntsFromObj(blit_pos, &dest_rect.x, &dest_rect.y)) {
+    }
+    else if ((rect = pgRect_FromObject(blit_pos, &temp))) {
+        dest_rect.x = rect->x;
+        dest_rect.y = rect->y;
+    }
+    else {
+        return BLITS_ERR_INVALID_DESTINATION;
+    }
+
+    if (!(srcobject = _surfview_blit_area(view, NULL, &src_rect, &dest_rect)))
+        return BLITS_ERR_PY_EXCEPTION_RAISED;
+    if (_surf_fblits_modulated(self, srcobject, &dest_rect, &src_rect,
+                               blend_flags, alpha, tint, queue)) {
+        return BLITS_ERR_BLIT_FAIL;
+    }
+    return 0;
+}
+
+int
+_surf_fblits_item_check_and_blit(pgSurfaceObject *self, PyObject *item,
+                                 int blend_flags, pg_BlitQueue *queue)
+{
+    PyObject *src_surf, *blit_pos, *obj;
+    SDL_Surface *src;
+    SDL_Rect *src_rect, temp, dest_rect;
+    Py_ssize_t size;
+    long value;
+    int alpha = -1;
+    Uint8 tint[4], *tintp = NULL;
+
+    /* Check that the item is a (Surface, dest[, alpha[, tint]]) tuple */
+    if (!PyTuple_Check(item) || (size = PyTuple_GET_SIZE(item)) < 2 ||
+        size > 4) {
+        return FBLITS_ERR_TUPLE_REQUIRED;
+    }
+
+    /* Extract the Surface and destination objects from the tuple */
+    src_surf = PyTuple_GET_ITEM(item, 0);
+    blit_pos = PyTuple_GET_ITEM(item, 1);
+
+    /* The optional alpha and tint, None meaning none */
+    if (size > 2 && (obj = PyTuple_GET_ITEM(item, 2)) != Py_None) {
+        if (!PyLong_Check(obj)) {
+            return FBLITS_ERR_ALPHA_NOT_NUMERIC;
+        }
+        value = PyLong_AsLong(obj);
+        if (value == -1 && PyErr_Occurred()) {
+            return BLITS_ERR_PY_EXCEPTION_RAISED;
+        }
+        alpha = value < 0 ? 0 : (value > 255 ? 255 : (int)value);
+    }
+    if (size > 3 && (obj = PyTuple_GET_ITEM(item, 3)) != Py_None) {
+        if (!pg_RGBAFromObjEx(obj, tint, PG_COLOR_HANDLE_STR)) {
+            return BLITS_ERR_PY_EXCEPTION_RAISED;
         }
+        tintp = tint;
+    }
 
-        dest_rect.x = dx;
-        dest_rect.y = dy;
-        dest_rect.w = src_rect->w;
-        dest_rect.h = src_rect->h;
+    /* Check that the source is a Surface or SurfaceView */
+    if (pgSurfaceView_Check(src_surf)) {
+        return _surf_fblits_view(self, (pgSurfaceViewObject *)src_surf,
+                                 blit_pos, blend_flags, alpha, tintp, queue);
+    }
+    if (!pgSurface_Check(src_surf)) {
+        return BLITS_ERR_SOURCE_NOT_SURFACE;
+    }
+    if (!(src = pgSurface_AsSurface(src_surf))) {
+        return BLITS_ERR_SEQUENCE_SURF;
+    }
 
-        if (special_flags) {
-            if (!pg_IntFromObj(special_flags, &blend_flags)) {
-                bliterrornum = BLITS_ERR_MUST_ASSIGN_NUMERIC;
-                goto bliterror;
-            }
-        }
+    /* Try to extract a valid blit position */
+    if (pg_TwoIntsFromObj(blit_pos, &dest_rect.x, &dest_rect.y)) {
+    }
+    else if ((src_rect = pgRect_FromObject(blit_pos, &temp))) {
+        dest_rect.x = src_rect->x;
+        dest_rect.y = src_rect->y;
+    }
+    else {
+        return BLITS_ERR_INVALID_DESTINATION;
+    }
 
-        result = pgSurface_Blit(self, (pgSurfaceObject *)srcobject, &dest_rect,
-                                src_rect, blend_flags);
+    dest_rect.w = src->w;
+    dest_rect.h = src->h;
 
-        if (result != 0) {
-            bliterrornum = BLITS_ERR_BLIT_FAIL;
-            goto bliterror;
+    /* Perform the blit */
+    if (_surf_fblits_modulated(self, (pgSurfaceObject *)src_surf, &dest_rect,
+                               NULL, blend_flags, alpha, tintp, queue)) {
+        return BLITS_ERR_BLIT_FAIL;
+    }
+
+    return 0;
+}
+
+static PyObject *
+surf_fblits(pgSurfaceObject *self, PyObject *const *args, Py_ssize_t nargs)
+{
+    SDL_Surface *dest = pgSurface_AsSurface(self);
+    SURF_INIT_CHECK(dest)
+
+    PyObject *blit_sequence, *item = NULL, *items = NULL;
+    int blend_flags = 0; /* Default flag is 0, opaque */
+    int error = 0;
+    int is_generator = 0;
+    int parallel = 0;
+    pg_BlitQueue *queue = NULL;
+
+    if (nargs == 0 || nargs > 3) {
+        error = FBLITS_ERR_INCORRECT_ARGS_NUM;
+        goto on_error;
+    }
+    /* Get the blend flags if they are passed */
+    if (nargs >= 2) {
+        if (!PyLong_Check(args[1])) {
+            error = FBLITS_ERR_FLAG_NOT_NUMERIC;
+            goto on_error;
+        }
+        blend_flags = PyLong_AsLong(args[1]);
+        if (PyErr_Occurred()) {
+            return NULL;
         }
+    }
+    if (nargs == 3 && (parallel = PyObject_IsTrue(args[2])) == -1) {
+        return NULL;
+    }
 
-        if (doreturn) {
-            retrect = NULL;
-            retrect = pgRect_New(&dest_rect);
+    blit_sequence = args[0];
 
-            /* If the sequence is countable, we already pre allocated a list
-             * of matching size. Now we can use the efficient PyList_SET_ITEM
-             * to add elements to the list */
-            if (issequence) {
-                PyList_SET_ITEM(ret, curriter++, retrect);
-            }
-            else if (PyList_Append(ret, retrect) != -1) {
-                Py_DECREF(retrect);
+    /* Queued blits read their sources later, so the sources are kept
+     * alive by a list or tuple, and a generator can't draw in between */
+    if (parallel && pg_get_blit_threads() > 1) {
+        if (!pgBlitBatch_Check(blit_sequence) &&
+            !pgSequenceFast_Check(blit_sequence)) {
+            if (!PyIter_Check(blit_sequence)) {
+                error = BLITS_ERR_SEQUENCE_REQUIRED;
+                goto on_error;
             }
-            else {
-                Py_DECREF(retrect);
-                retrect = NULL;
-                bliterrornum = BLITS_ERR_PY_EXCEPTION_RAISED;
-                goto bliterror;
+            items = PySequence_List(blit_sequence);
+            if (!items) {
+                return NULL;
             }
-            retrect = NULL; /* Clear to avoid double deref on errors */
+            blit_sequence = items;
         }
-        Py_DECREF(srcobject);
-        Py_DECREF(argpos);
-        Py_XDECREF(argrect);
-        Py_XDECREF(special_flags);
-        /* Clear to avoid double deref on errors */
-        srcobject = NULL;
-        argpos = NULL;
-        argrect = NULL;
-        special_flags = NULL;
+        queue = pg_blit_queue_new();
     }
 
-    Py_DECREF(iterator);
-    if (PyErr_Occurred()) {
-        Py_XDECREF(ret);
-        return NULL;
+    /* Fastest path for pre-validated BlitBatch objects */
+    if (pgBlitBatch_Check(blit_sequence)) {
+        error = _surf_fblits_batch(self, (pgBlitBatchObject *)blit_sequence,
+                                   blend_flags, queue);
+        if (error) {
+            goto on_error;
+        }
+    }
+    /* Fast path for Lists or Tuples */
+    else if (pgSequenceFast_Check(blit_sequence)) {
+        Py_ssize_t i;
+        PyObject **sequence_items = PySequence_Fast_ITEMS(blit_sequence);
+        for (i = 0; i < PySequence_Fast_GET_SIZE(blit_sequence); i++) {
+            error = _surf_fblits_item_check_and_blit(self, sequence_items[i],
+                                                     blend_flags, queue);
+            if (error) {
+                goto on_error;
+            }
+        }
     }
+    /* Generator path */
+    else if (PyIter_Check(blit_sequence)) {
+        is_generator = 1;
+        while ((item = PyIter_Next(blit_sequence))) {
+            error = _surf_fblits_item_check_and_blit(self, item, blend_flags,
+                                                     NULL);
+            if (error) {
+                goto on_error;
+            }
+            Py_DECREF(item);
+        }
 
-    if (doreturn) {
-        return ret;
+        /* If the generator raises an exception */
+        if (PyErr_Occurred()) {
+            return NULL;
+        }
     }
     else {
-        Py_RETURN_NONE;
+        error = BLITS_ERR_SEQUENCE_REQUIRED;
+        goto on_error;
     }
 
-bliterror:
-    Py_XDECREF(srcobject);
-    Py_XDECREF(argpos);
-    Py_XDECREF(argrect);
-    Py_XDECREF(retrect);
-    Py_XDECREF(special_flags);
-    Py_XDECREF(iterator);
-    Py_XDECREF(item);
-    Py_XDECREF(ret);
+    pg_blit_queue_free(queue);
+    Py_XDECREF(items);
+    Py_RETURN_NONE;
 
-    switch (bliterrornum) {
+on_error:
+    /* the blits before the failing item are drawn, as without the queue */
+    pg_blit_queue_free(queue);
+    Py_XDECREF(items);
+    if (is_generator) {
+        Py_XDECREF(item);
+    }
+    switch (error) {
         case BLITS_ERR_SEQUENCE_REQUIRED:
             return RAISE(
                 PyExc_ValueError,
                 "blit_sequence should be iterator of (Surface, dest)");
-        case BLITS_ERR_DISPLAY_SURF_QUIT:
-            return RAISE(pgExc_SDLError, "display Surface quit");
         case BLITS_ERR_SEQUENCE_SURF:
-            return RAISE(PyExc_TypeError,
-                         "First element of blit_list needs to be Surface.");
+            return RAISE(
+                PyExc_TypeError,
+                "First element of pairs (Surface, dest) in blit_sequence "
+                "must be a Surface.");
         case BLITS_ERR_INVALID_DESTINATION:
             return RAISE(PyExc_TypeError,
                          "invalid destination position for blit");
@@ -2086,174 +5230,376 @@ bliterror:
         case BLITS_ERR_MUST_ASSIGN_NUMERIC:
             return RAISE(PyExc_TypeError, "Must assign numeric values");
         case BLITS_ERR_BLIT_FAIL:
-            return RAISE(PyExc_TypeError, "Blit failed");
+            return RAISE(
+                PyExc_TypeError,
+                "Blit failed (probably the flag used does not exist)");
         case BLITS_ERR_PY_EXCEPTION_RAISED:
             return NULL; /* Raising a previously set exception */
         case BLITS_ERR_SOURCE_NOT_SURFACE:
-            return RAISE(PyExc_TypeError, "Source objects must be a surface");
+            return RAISE(PyExc_TypeError, "Source objects must be a Surface");
+        case FBLITS_ERR_TUPLE_REQUIRED:
+            return RAISE(
+                PyExc_ValueError,
+                "Blit_sequence item should be a tuple of (Surface, dest), "
+                "(Surface, dest, alpha) or (Surface, dest, alpha, tint)");
+        case FBLITS_ERR_INCORRECT_ARGS_NUM:
+            return RAISE(PyExc_ValueError,
+                         "Incorrect number of parameters passed: need at "
+                         "least one, 3 at max");
+        case FBLITS_ERR_FLAG_NOT_NUMERIC:
+            return RAISE(PyExc_TypeError,
+                         "The special_flags parameter must be an int");
+        case FBLITS_ERR_ALPHA_NOT_NUMERIC:
+            return RAISE(PyExc_TypeError,
+                         "The alpha of a blit_sequence item must be an int "
+                         "or None");
     }
     return RAISE(PyExc_TypeError, "Unknown error");
 }
 
-#define FBLITS_ERR_TUPLE_REQUIRED 11
-#define FBLITS_ERR_INCORRECT_ARGS_NUM 12
-#define FBLITS_ERR_FLAG_NOT_NUMERIC 13
-
-int
-_surf_fblits_item_check_and_blit(pgSurfaceObject *self, PyObject *item,
-                                 int blend_flags)
+/* Blits of premultiplied sources without special flags blend them as
+ * premultiplied */
+static int
+_surf_blend_flags(pgSurfaceObject *srcobj, int blend_flags)
 {
-    PyObject *src_surf, *blit_pos;
-    SDL_Surface *src;
-    SDL_Rect *src_rect, temp, dest_rect;
+    SDL_Surface *src = pgSurface_AsSurface(srcobj);
 
-    /* Check that the item is a tuple of length 2 */
-    if (!PyTuple_Check(item) || PyTuple_GET_SIZE(item) != 2) {
-        return FBLITS_ERR_TUPLE_REQUIRED;
+    if (!blend_flags && srcobj->premultiplied &&
+        SDL_ISPIXELFORMAT_ALPHA(src->format->format)) {
+        return PYGAME_BLEND_PREMULTIPLIED;
     }
+    return blend_flags;
+}
 
-    /* Extract the Surface and destination objects from the
-     * (Surface, dest) tuple */
-    src_surf = PyTuple_GET_ITEM(item, 0);
-    blit_pos = PyTuple_GET_ITEM(item, 1);
+static PyObject *
+surf_blit_transformed(pgSurfaceObject *self, PyObject *args,
+                      PyObject *kwargs)
+{
+    SDL_Surface *src, *dest = pgSurface_AsSurface(self);
+    pgSurfaceObject *srcobj;
+    PyObject *posobj, *scaleobj = NULL, *originobj = Py_None;
+    pg_BlitTransform xf;
+    SDL_Rect affected;
+    int result, blend_flags = 0;
+    PG_PERF_START(perf_start);
+
+    static char *kwids[] = {"source", "pos",    "angle",
+                            "scale",  "flip_x", "flip_y",
+                            "origin", "smooth", "special_flags",
+                            NULL};
+
+    xf.angle = 0.0;
+    xf.flip_x = xf.flip_y = xf.smooth = 0;
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "O!O|dOppOpi", kwids,
+                                     &pgSurface_Type, &srcobj, &posobj,
+                                     &xf.angle, &scaleobj, &xf.flip_x,
+                                     &xf.flip_y, &originobj, &xf.smooth,
+                                     &blend_flags)) {
+        return NULL;
+    }
+    src = pgSurface_AsSurface(srcobj);
+    SURF_INIT_CHECK(src)
+    SURF_INIT_CHECK(dest)
+    if (src == dest) {
+        return RAISE(PyExc_ValueError,
+                     "source can't be the destination surface");
+    }
 
-    /* Check that the source is a Surface */
-    if (!pgSurface_Check(src_surf)) {
-        return BLITS_ERR_SOURCE_NOT_SURFACE;
+    if (!pg_TwoDoublesFromObj(posobj, &xf.pos_x, &xf.pos_y)) {
+        return RAISE(PyExc_TypeError, "pos must be a pair of numbers");
     }
-    if (!(src = pgSurface_AsSurface(src_surf))) {
-        return BLITS_ERR_SEQUENCE_SURF;
+    if (!scaleobj) {
+        xf.scale_x = xf.scale_y = 1.0;
+    }
+    else if (pg_DoubleFromObj(scaleobj, &xf.scale_x)) {
+        xf.scale_y = xf.scale_x;
+    }
+    else if (!pg_TwoDoublesFromObj(scaleobj, &xf.scale_x, &xf.scale_y)) {
+        return RAISE(PyExc_TypeError,
+                     "scale must be a number or a pair of numbers");
+    }
+    if (xf.scale_x < 0.0 || xf.scale_y < 0.0) {
+        return RAISE(PyExc_ValueError, "scale can't be negative");
+    }
+    if (originobj == Py_None) {
+        xf.origin_x = src->w / 2.0;
+        xf.origin_y = src->h / 2.0;
+    }
+    else if (!pg_TwoDoublesFromObj(originobj, &xf.origin_x,
+                                   &xf.origin_y)) {
+        return RAISE(PyExc_TypeError, "origin must be a pair of numbers");
     }
 
-    /* Try to extract a valid blit position */
-    if (pg_TwoIntsFromObj(blit_pos, &dest_rect.x, &dest_rect.y)) {
+    if (!pgSurface_Unshare(self)) {
+        return NULL;
     }
-    else if ((src_rect = pgRect_FromObject(blit_pos, &temp))) {
-        dest_rect.x = src_rect->x;
-        dest_rect.y = src_rect->y;
+    pgSurface_Prep(self);
+    pgSurface_Prep(srcobj);
+    blend_flags = _surf_blend_flags(srcobj, blend_flags);
+    result = pygame_BlitTransformed(src, dest, &xf, blend_flags, &affected);
+    pgSurface_Unprep(srcobj);
+    pgSurface_Unprep(self);
+    PG_PERF_STOP(perf_start, PG_PERF_BLIT,
+                 result == 0 ? (Uint64)affected.w * affected.h : 0);
+
+    if (result) {
+        return RAISE(pgExc_SDLError, SDL_GetError());
     }
-    else {
-        return BLITS_ERR_INVALID_DESTINATION;
+    pgSurface_AddDirtyRect(self, &affected);
+    return pgRect_New(&affected);
+}
+
+static PyObject *
+surf_blit_tiled(pgSurfaceObject *self, PyObject *args, PyObject *kwargs)
+{
+    SDL_Surface *src, *dest = pgSurface_AsSurface(self);
+    pgSurfaceObject *srcobj;
+    PyObject *rectobj, *offsetobj = NULL;
+    SDL_Rect *rect, temp, area, orig_clip, dstrect;
+    int ox = 0, oy = 0, x, y, x0, y0, result = 0, blend_flags = 0;
+    pg_AlphaSpans *spans;
+    PG_PERF_START(perf_start);
+
+    static char *kwids[] = {"source", "rect", "offset", "special_flags",
+                            NULL};
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "O!O|Oi", kwids,
+                                     &pgSurface_Type, &srcobj, &rectobj,
+                                     &offsetobj, &blend_flags)) {
+        return NULL;
+    }
+    src = pgSurface_AsSurface(srcobj);
+    SURF_INIT_CHECK(src)
+    SURF_INIT_CHECK(dest)
+    if (src == dest) {
+        return RAISE(PyExc_ValueError,
+                     "source can't be the destination surface");
+    }
+    if (!(rect = pgRect_FromObject(rectobj, &temp))) {
+        return RAISE(PyExc_TypeError, "Invalid rectstyle argument");
+    }
+    if (offsetobj && !pg_TwoIntsFromObj(offsetobj, &ox, &oy)) {
+        return RAISE(PyExc_TypeError, "offset must be a pair of integers");
     }
 
-    dest_rect.w = src->w;
-    dest_rect.h = src->h;
+    SDL_GetClipRect(dest, &orig_clip);
+    if (!src->w || !src->h || !SDL_IntersectRect(rect, &orig_clip, &area)) {
+        area.x = rect->x;
+        area.y = rect->y;
+        area.w = area.h = 0;
+        return pgRect_New(&area);
+    }
 
-    /* Perform the blit */
-    if (pgSurface_Blit(self, (pgSurfaceObject *)src_surf, &dest_rect, NULL,
-                       blend_flags)) {
-        return BLITS_ERR_BLIT_FAIL;
+    /* the first tile starts at or before the clipped area, offset moves
+     * the pattern by that many source pixels */
+    x0 = area.x - ((area.x - rect->x + ox) % src->w + src->w) % src->w;
+    y0 = area.y - ((area.y - rect->y + oy) % src->h + src->h) % src->h;
+
+    if (!pgSurface_Unshare(self)) {
+        return NULL;
+    }
+    blend_flags = _surf_blend_flags(srcobj, blend_flags);
+    pgSurface_Prep(self);
+    pgSurface_Prep(srcobj);
+    spans = _surf_alpha_spans(srcobj);
+    /* pygame_Blit() clips each tile to the area */
+    SDL_SetClipRect(dest, &area);
+    for (y = y0; y < area.y + area.h && !result; y += src->h) {
+        for (x = x0; x < area.x + area.w; x += src->w) {
+            dstrect.x = x;
+            dstrect.y = y;
+            if ((result = pygame_BlitSpans(src, NULL, dest, &dstrect,
+                                           blend_flags, spans))) {
+                break;
+            }
+        }
     }
+    SDL_SetClipRect(dest, &orig_clip);
+    pgSurface_Unprep(srcobj);
+    pgSurface_Unprep(self);
+    PG_PERF_STOP(perf_start, PG_PERF_BLIT,
+                 result == 0 ? (Uint64)area.w * area.h : 0);
 
-    return 0;
+    if (result) {
+        return RAISE(pgExc_SDLError, SDL_GetError());
+    }
+    pgSurface_AddDirtyRect(self, &area);
+    return pgRect_New(&area);
+}
+
+/* The range of cells [*first, *last) of a tile row or column of the given
+ * size and count starting at pos, which overlap [lo, hi) */
+static void
+_tilemap_visible(int pos, int size, Py_ssize_t count, int lo, int hi,
+                 Py_ssize_t *first, Py_ssize_t *last)
+{
+    *first = lo - pos <= 0 ? 0 : (lo - pos) / size;
+    *last = hi - pos <= 0 ? 0 : (hi - pos + size - 1) / size;
+    *last = MIN(*last, count);
 }
 
 static PyObject *
-surf_fblits(pgSurfaceObject *self, PyObject *const *args, Py_ssize_t nargs)
+surf_blit_tilemap(pgSurfaceObject *self, PyObject *args, PyObject *kwargs)
 {
-    SDL_Surface *dest = pgSurface_AsSurface(self);
+    SDL_Surface *tiles, *dest = pgSurface_AsSurface(self);
+    pgSurfaceObject *tilesobj;
+    PyObject *indicesobj, *sizeobj, *originobj = NULL;
+    PyObject *seq = NULL, *rowseq = NULL;
+    Py_buffer view;
+    SDL_Rect clip, srcrect, dstrect, area;
+    Py_ssize_t rows, cols = 0, r, c, r0, r1, c0, c1;
+    long index, count;
+    int tw, th, ox = 0, oy = 0, columns, has_view, blend_flags = 0;
+    int x1, y1, result = 0;
+    Uint64 pixels = 0;
+    pg_AlphaSpans *spans;
+    PG_PERF_START(perf_start);
+
+    static char *kwids[] = {"tileset", "indices", "tile_size", "origin",
+                            "special_flags", NULL};
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "O!OO|Oi", kwids,
+                                     &pgSurface_Type, &tilesobj, &indicesobj,
+                                     &sizeobj, &originobj, &blend_flags)) {
+        return NULL;
+    }
+    tiles = pgSurface_AsSurface(tilesobj);
+    SURF_INIT_CHECK(tiles)
     SURF_INIT_CHECK(dest)
+    if (tiles == dest) {
+        return RAISE(PyExc_ValueError,
+                     "tileset can't be the destination surface");
+    }
+    if (!pg_TwoIntsFromObj(sizeobj, &tw, &th)) {
+        return RAISE(PyExc_TypeError, "tile_size must be a pair of integers");
+    }
+    if (tw <= 0 || th <= 0) {
+        return RAISE(PyExc_ValueError, "tile_size must be positive");
+    }
+    if (originobj && !pg_TwoIntsFromObj(originobj, &ox, &oy)) {
+        return RAISE(PyExc_TypeError, "origin must be a pair of integers");
+    }
+    columns = tiles->w / tw;
+    count = (long)columns * (tiles->h / th);
+    if (!count) {
+        return RAISE(PyExc_ValueError, "tileset is smaller than one tile");
+    }
 
-    PyObject *blit_sequence, *item;
-    int blend_flags = 0; /* Default flag is 0, opaque */
-    int error = 0;
-    int is_generator = 0;
-
-    if (nargs == 0 || nargs > 2) {
-        error = FBLITS_ERR_INCORRECT_ARGS_NUM;
-        goto on_error;
+    /* the indices, as a 2D buffer of ints or a sequence of rows */
+    if ((has_view = _surf_int32_buffer(indicesobj, &view, "indices")) < 0) {
+        return NULL;
     }
-    /* Get the blend flags if they are passed */
-    else if (nargs == 2) {
-        if (!PyLong_Check(args[1])) {
-            error = FBLITS_ERR_FLAG_NOT_NUMERIC;
-            goto on_error;
+    if (has_view) {
+        if (view.ndim != 2) {
+            PyBuffer_Release(&view);
+            return RAISE(PyExc_ValueError,
+                         "indices buffer must be 2 dimensional");
         }
-        blend_flags = PyLong_AsLong(args[1]);
-        if (PyErr_Occurred()) {
+        rows = view.shape[0];
+        cols = view.shape[1];
+    }
+    else {
+        seq = PySequence_Fast(indicesobj,
+                              "indices must be a 2 dimensional buffer or a "
+                              "sequence of sequences");
+        if (!seq) {
             return NULL;
         }
+        rows = PySequence_Fast_GET_SIZE(seq);
     }
 
-    blit_sequence = args[0];
+    /* only the cells inside of the clip area are looked at */
+    SDL_GetClipRect(dest, &clip);
+    area.x = clip.x + clip.w;
+    area.y = clip.y + clip.h;
+    x1 = y1 = INT_MIN;
+    _tilemap_visible(oy, th, rows, clip.y, clip.y + clip.h, &r0, &r1);
 
-    /* Fast path for Lists or Tuples */
-    if (pgSequenceFast_Check(blit_sequence)) {
-        Py_ssize_t i;
-        PyObject **sequence_items = PySequence_Fast_ITEMS(blit_sequence);
-        for (i = 0; i < PySequence_Fast_GET_SIZE(blit_sequence); i++) {
-            item = sequence_items[i];
-            error = _surf_fblits_item_check_and_blit(self, item, blend_flags);
-            if (error) {
-                goto on_error;
+    if (!pgSurface_Unshare(self)) {
+        return NULL;
+    }
+    blend_flags = _surf_blend_flags(tilesobj, blend_flags);
+    pgSurface_Prep(self);
+    pgSurface_Prep(tilesobj);
+    spans = _surf_alpha_spans(tilesobj);
+    for (r = r0; r < r1 && !result; r++) {
+        if (!has_view) {
+            rowseq = PySequence_Fast(PySequence_Fast_GET_ITEM(seq, r),
+                                     "indices rows must be sequences");
+            if (!rowseq) {
+                result = -2;
+                break;
             }
+            cols = PySequence_Fast_GET_SIZE(rowseq);
         }
-    }
-    /* Generator path */
-    else if (PyIter_Check(blit_sequence)) {
-        is_generator = 1;
-        while ((item = PyIter_Next(blit_sequence))) {
-            error = _surf_fblits_item_check_and_blit(self, item, blend_flags);
-            if (error) {
-                goto on_error;
+        _tilemap_visible(ox, tw, cols, clip.x, clip.x + clip.w, &c0, &c1);
+        for (c = c0; c < c1; c++) {
+            if (has_view) {
+                index = ((const int *)view.buf)[r * cols + c];
+            }
+            else {
+                index = PyLong_AsLong(PySequence_Fast_GET_ITEM(rowseq, c));
+                if (index == -1 && PyErr_Occurred()) {
+                    result = -2;
+                    break;
+                }
+            }
+            /* negative indices are empty cells */
+            if (index < 0) {
+                continue;
+            }
+            if (index >= count) {
+                PyErr_Format(PyExc_IndexError,
+                             "tile index %ld out of range, the tileset has "
+                             "%ld tiles",
+                             index, count);
+                result = -2;
+                break;
+            }
+            srcrect.x = (int)(index % columns) * tw;
+            srcrect.y = (int)(index / columns) * th;
+            srcrect.w = tw;
+            srcrect.h = th;
+            dstrect.x = ox + (int)c * tw;
+            dstrect.y = oy + (int)r * th;
+            if ((result = pygame_BlitSpans(tiles, &srcrect, dest, &dstrect,
+                                           blend_flags, spans))) {
+                break;
+            }
+            if (dstrect.w && dstrect.h) {
+                area.x = MIN(area.x, dstrect.x);
+                area.y = MIN(area.y, dstrect.y);
+                x1 = MAX(x1, dstrect.x + dstrect.w);
+                y1 = MAX(y1, dstrect.y + dstrect.h);
+                pixels += (Uint64)dstrect.w * dstrect.h;
             }
-            Py_DECREF(item);
         }
+        Py_XDECREF(rowseq);
+        rowseq = NULL;
+    }
+    pgSurface_Unprep(tilesobj);
+    pgSurface_Unprep(self);
+    PG_PERF_STOP(perf_start, PG_PERF_BLIT, result == 0 ? pixels : 0);
 
-        /* If the generator raises an exception */
-        if (PyErr_Occurred()) {
-            return NULL;
-        }
+    if (has_view) {
+        PyBuffer_Release(&view);
     }
-    else {
-        error = BLITS_ERR_SEQUENCE_REQUIRED;
-        goto on_error;
+    Py_XDECREF(seq);
+    if (result == -1) {
+        return RAISE(pgExc_SDLError, SDL_GetError());
     }
-
-    Py_RETURN_NONE;
-
-on_error:
-    if (is_generator) {
-        Py_XDECREF(item);
+    if (result) {
+        return NULL;
     }
-    switch (error) {
-        case BLITS_ERR_SEQUENCE_REQUIRED:
-            return RAISE(
-                PyExc_ValueError,
-                "blit_sequence should be iterator of (Surface, dest)");
-        case BLITS_ERR_SEQUENCE_SURF:
-            return RAISE(
-                PyExc_TypeError,
-                "First element of pairs (Surface, dest) in blit_sequence "
-                "must be a Surface.");
-        case BLITS_ERR_INVALID_DESTINATION:
-            return RAISE(PyExc_TypeError,
-                         "invalid destination position for blit");
-        case BLITS_ERR_INVALID_RECT_STYLE:
-            return RAISE(PyExc_TypeError, "Invalid rectstyle argument");
-        case BLITS_ERR_MUST_ASSIGN_NUMERIC:
-            return RAISE(PyExc_TypeError, "Must assign numeric values");
-        case BLITS_ERR_BLIT_FAIL:
-            return RAISE(
-                PyExc_TypeError,
-                "Blit failed (probably the flag used does not exist)");
-        case BLITS_ERR_PY_EXCEPTION_RAISED:
-            return NULL; /* Raising a previously set exception */
-        case BLITS_ERR_SOURCE_NOT_SURFACE:
-            return RAISE(PyExc_TypeError, "Source objects must be a Surface");
-        case FBLITS_ERR_TUPLE_REQUIRED:
-            return RAISE(
-                PyExc_ValueError,
-                "Blit_sequence item should be a tuple of (Surface, dest)");
-        case FBLITS_ERR_INCORRECT_ARGS_NUM:
-            return RAISE(PyExc_ValueError,
-                         "Incorrect number of parameters passed: need at "
-                         "least one, 2 at max");
-        case FBLITS_ERR_FLAG_NOT_NUMERIC:
-            return RAISE(PyExc_TypeError,
-                         "The special_flags parameter must be an int");
+
+    if (x1 == INT_MIN) {
+        area.x = ox;
+        area.y = oy;
+        area.w = area.h = 0;
+        return pgRect_New(&area);
     }
-    return RAISE(PyExc_TypeError, "Unknown error");
+    area.w = x1 - area.x;
+    area.h = y1 - area.y;
+    pgSurface_AddDirtyRect(self, &area);
+    return pgRect_New(&area);
 }
 
 static PyObject *
@@ -2318,12 +5664,15 @@ surf_scroll(PyObject *self, PyObject *args, PyObject *keywds)
             src -= dy * pitch + dx * bpp;
         }
     }
+    Py_BEGIN_ALLOW_THREADS;
     surface_move(src, dst, h, w * bpp, pitch, pitch);
+    Py_END_ALLOW_THREADS;
 
     if (!pgSurface_Unlock((pgSurfaceObject *)self)) {
         return NULL;
     }
 
+    pgSurface_AddDirtyRect((pgSurfaceObject *)self, clip_rect);
     Py_RETURN_NONE;
 }
 
@@ -2372,6 +5721,8 @@ surf_get_flags(PyObject *self, PyObject *_null)
         flags |= PGS_RLEACCELOK;
     if ((sdl_flags & SDL_RLEACCEL))
         flags |= PGS_RLEACCEL;
+    if (((pgSurfaceObject *)self)->accelerated)
+        flags |= PGS_ACCELERATED;
     if (is_window_surf) {
         if (window_flags & PG_WINDOW_FULLSCREEN_INCLUSIVE)
             flags |= PGS_FULLSCREEN;
@@ -2532,12 +5883,12 @@ surf_get_losses(PyObject *self, PyObject *_null)
                          surf->format->Bloss, surf->format->Aloss);
 }
 
+/* The subsurface of self for rect, self must be initialized */
 static PyObject *
-surf_subsurface(PyObject *self, PyObject *args)
+_surf_subsurface(PyObject *self, SDL_Rect *rect)
 {
     SDL_Surface *surf = pgSurface_AsSurface(self);
-    SDL_PixelFormat *format;
-    SDL_Rect *rect, temp;
+    SDL_PixelFormat *format = surf->format;
     SDL_Surface *sub;
     PyObject *subobj;
     int pixeloffset;
@@ -2546,11 +5897,6 @@ surf_subsurface(PyObject *self, PyObject *args)
     Uint8 alpha;
     Uint32 colorkey;
 
-    SURF_INIT_CHECK(surf)
-
-    format = surf->format;
-    if (!(rect = pgRect_FromObject(args, &temp)))
-        return RAISE(PyExc_ValueError, "invalid rectstyle argument");
     if (rect->x < 0 || rect->y < 0 || rect->x + rect->w > surf->w ||
         rect->y + rect->h > surf->h)
         return RAISE(PyExc_ValueError,
@@ -2626,6 +5972,8 @@ surf_subsurface(PyObject *self, PyObject *args)
         PyMem_Free(data);
         return NULL;
     }
+    ((pgSurfaceObject *)subobj)->premultiplied =
+        ((pgSurfaceObject *)self)->premultiplied;
     Py_INCREF(self);
     data->owner = self;
     data->pixeloffset = pixeloffset;
@@ -2636,6 +5984,67 @@ surf_subsurface(PyObject *self, PyObject *args)
     return subobj;
 }
 
+static PyObject *
+surf_subsurface(PyObject *self, PyObject *args)
+{
+    SDL_Surface *surf = pgSurface_AsSurface(self);
+    SDL_Rect *rect, temp;
+
+    SURF_INIT_CHECK(surf)
+
+    if (!(rect = pgRect_FromObject(args, &temp)))
+        return RAISE(PyExc_ValueError, "invalid rectstyle argument");
+    return _surf_subsurface(self, rect);
+}
+
+static PyObject *
+surf_subsurfaces(PyObject *self, PyObject *args, PyObject *kwargs)
+{
+    SDL_Surface *surf = pgSurface_AsSurface(self);
+    SDL_Rect *rect, temp;
+    PyObject *rects, *seq, *list, *item;
+    Py_ssize_t i, n;
+    int views = 0;
+    static char *kwids[] = {"rects", "views", NULL};
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "O|p", kwids, &rects,
+                                     &views)) {
+        return NULL;
+    }
+    SURF_INIT_CHECK(surf)
+
+    seq = PySequence_Fast(rects, "rects must be a sequence of rectangles");
+    if (!seq) {
+        return NULL;
+    }
+    n = PySequence_Fast_GET_SIZE(seq);
+    list = PyList_New(n);
+    if (!list) {
+        Py_DECREF(seq);
+        return NULL;
+    }
+    for (i = 0; i < n; i++) {
+        item = PySequence_Fast_GET_ITEM(seq, i);
+        if (views) {
+            item = _surfview_new(&pgSurfaceView_Type, self, item);
+        }
+        else if ((rect = pgRect_FromObject(item, &temp))) {
+            item = _surf_subsurface(self, rect);
+        }
+        else {
+            item = RAISE(PyExc_ValueError, "invalid rectstyle argument");
+        }
+        if (!item) {
+            Py_DECREF(list);
+            Py_DECREF(seq);
+            return NULL;
+        }
+        PyList_SET_ITEM(list, i, item);
+    }
+    Py_DECREF(seq);
+    return list;
+}
+
 static PyObject *
 surf_get_offset(PyObject *self, PyObject *_null)
 {
@@ -2721,8 +6130,10 @@ surf_get_abs_parent(PyObject *self, PyObject *_null)
     return owner;
 }
 
-static PyObject *
-surf_get_bounding_rect(PyObject *self, PyObject *args, PyObject *kwargs)
+/* Finds the bounding rect of Surface.get_bounding_rect() on a locked
+ * surface. Doesn't need the GIL. */
+static void
+_surf_bounding_rect(SDL_Surface *surf, int min_alpha, SDL_Rect *rect)
 {
 #if SDL_BYTEORDER == SDL_LIL_ENDIAN
     const int BYTE0 = 0;
@@ -2733,14 +6144,11 @@ surf_get_bounding_rect(PyObject *self, PyObject *args, PyObject *kwargs)
     const int BYTE1 = 1;
     const int BYTE2 = 0;
 #endif
-    PyObject *rect;
-    SDL_Surface *surf = pgSurface_AsSurface(self);
     SDL_PixelFormat *format = NULL;
     Uint8 *pixels = NULL;
     Uint8 *pixel;
     int x, y;
     int min_x, min_y, max_x, max_y;
-    int min_alpha = 1;
     int found_alpha = 0;
     Uint32 value;
     Uint8 r, g, b, a;
@@ -2748,16 +6156,10 @@ surf_get_bounding_rect(PyObject *self, PyObject *args, PyObject *kwargs)
     Uint32 colorkey;
     Uint8 keyr, keyg, keyb;
 
-    char *kwids[] = {"min_alpha", NULL};
-    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "|i", kwids, &min_alpha))
-        return RAISE(PyExc_ValueError,
-                     "get_bounding_rect only accepts a single optional "
-                     "min_alpha argument");
-
-    SURF_INIT_CHECK(surf)
-
-    if (!pgSurface_Lock((pgSurfaceObject *)self))
-        return RAISE(pgExc_SDLError, "could not lock surface");
+    /* 32 bit surfaces with an alpha channel are scanned with SIMD */
+    if (surface_alpha_bounds(surf, min_alpha, rect)) {
+        return;
+    }
 
     format = surf->format;
 
@@ -2904,11 +6306,36 @@ surf_get_bounding_rect(PyObject *self, PyObject *args, PyObject *kwargs)
             break;
         }
     }
+    rect->x = min_x;
+    rect->y = min_y;
+    rect->w = max_x - min_x;
+    rect->h = max_y - min_y;
+}
+
+static PyObject *
+surf_get_bounding_rect(PyObject *self, PyObject *args, PyObject *kwargs)
+{
+    SDL_Surface *surf = pgSurface_AsSurface(self);
+    SDL_Rect rect;
+    int min_alpha = 1;
+
+    char *kwids[] = {"min_alpha", NULL};
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "|i", kwids, &min_alpha))
+        return RAISE(PyExc_ValueError,
+                     "get_bounding_rect only accepts a single optional "
+                     "min_alpha argument");
+
+    SURF_INIT_CHECK(surf)
+
+    if (!pgSurface_Lock((pgSurfaceObject *)self))
+        return RAISE(pgExc_SDLError, "could not lock surface");
+
+    _surf_bounding_rect(surf, min_alpha, &rect);
+
     if (!pgSurface_Unlock((pgSurfaceObject *)self))
         return RAISE(pgExc_SDLError, "could not unlock surface");
 
-    rect = pgRect_New4(min_x, min_y, max_x - min_x, max_y - min_y);
-    return rect;
+    return pgRect_New(&rect);
 }
 
 static PyObject *
@@ -2969,6 +6396,7 @@ surf_get_view(PyObject *self, PyObject *args)
     SDL_Surface *surface = pgSurface_AsSurface(self);
     SDL_PixelFormat *format;
     Uint32 mask = 0;
+    int red, green, blue;
     SurfViewKind view_kind = VIEWKIND_2D;
     getbufferproc get_buffer = 0;
 
@@ -3009,9 +6437,13 @@ surf_get_view(PyObject *self, PyObject *args)
                 return _raise_get_view_ndim_error(
                     PG_FORMAT_BytesPerPixel(format) * 8, view_kind);
             }
-            if (format->Gmask != 0x00ff00 &&
-                (PG_FORMAT_BytesPerPixel(format) != 4 ||
-                 format->Gmask != 0xff0000)) {
+            /* The red, green and blue bytes must be evenly spaced, in
+             * either order, for a single stride to step through them. */
+            red = _surf_channel_offset(format, format->Rmask);
+            green = _surf_channel_offset(format, format->Gmask);
+            blue = _surf_channel_offset(format, format->Bmask);
+            if (red < 0 || green < 0 || blue < 0 || green == red ||
+                green - red != blue - green) {
                 return RAISE(PyExc_ValueError,
                              "unsupported colormasks for 3D reference array");
             }
@@ -3019,8 +6451,7 @@ surf_get_view(PyObject *self, PyObject *args)
             break;
         case VIEWKIND_RED:
             mask = format->Rmask;
-            if (mask != 0x000000ffU && mask != 0x0000ff00U &&
-                mask != 0x00ff0000U && mask != 0xff000000U) {
+            if (_surf_channel_offset(format, mask) < 0) {
                 return RAISE(PyExc_ValueError,
                              "unsupported colormasks for red reference array");
             }
@@ -3028,8 +6459,7 @@ surf_get_view(PyObject *self, PyObject *args)
             break;
         case VIEWKIND_GREEN:
             mask = format->Gmask;
-            if (mask != 0x000000ffU && mask != 0x0000ff00U &&
-                mask != 0x00ff0000U && mask != 0xff000000U) {
+            if (_surf_channel_offset(format, mask) < 0) {
                 return RAISE(
                     PyExc_ValueError,
                     "unsupported colormasks for green reference array");
@@ -3038,8 +6468,7 @@ surf_get_view(PyObject *self, PyObject *args)
             break;
         case VIEWKIND_BLUE:
             mask = format->Bmask;
-            if (mask != 0x000000ffU && mask != 0x0000ff00U &&
-                mask != 0x00ff0000U && mask != 0xff000000U) {
+            if (_surf_channel_offset(format, mask) < 0) {
                 return RAISE(
                     PyExc_ValueError,
                     "unsupported colormasks for blue reference array");
@@ -3048,8 +6477,7 @@ surf_get_view(PyObject *self, PyObject *args)
             break;
         case VIEWKIND_ALPHA:
             mask = format->Amask;
-            if (mask != 0x000000ffU && mask != 0x0000ff00U &&
-                mask != 0x00ff0000U && mask != 0xff000000U) {
+            if (_surf_channel_offset(format, mask) < 0) {
                 return RAISE(
                     PyExc_ValueError,
                     "unsupported colormasks for alpha reference array");
@@ -3068,26 +6496,328 @@ surf_get_view(PyObject *self, PyObject *args)
             return 0;
 #endif
     }
-    assert(get_buffer);
-    return pgBufproxy_New(self, get_buffer);
+    assert(get_buffer);
+    return pgBufproxy_New(self, get_buffer);
+}
+
+static PyObject *
+surf_get_buffer(PyObject *self, PyObject *_null)
+{
+    SDL_Surface *surface = pgSurface_AsSurface(self);
+    PyObject *proxy_obj;
+
+    SURF_INIT_CHECK(surface)
+
+    proxy_obj = pgBufproxy_New(self, _get_buffer_0D);
+    if (proxy_obj) {
+        if (pgBufproxy_Trip(proxy_obj)) {
+            Py_DECREF(proxy_obj);
+            proxy_obj = 0;
+        }
+    }
+    return proxy_obj;
+}
+
+/* Pixel layouts a shared memory block can hold, named like the formats of
+ * pygame.image.tobytes(). Returns 0 for an unknown name. */
+static Uint32
+_shm_pixel_format(const char *name, int *bpp)
+{
+    static const struct {
+        const char *name;
+        Uint32 format;
+        int bpp;
+    } formats[] = {
+        {"RGBA", SDL_PIXELFORMAT_RGBA32, 4},
+        {"RGBX", PG_PIXELFORMAT_RGBX32, 4},
+        {"ARGB", SDL_PIXELFORMAT_ARGB32, 4},
+        {"BGRA", SDL_PIXELFORMAT_BGRA32, 4},
+        {"RGB", SDL_PIXELFORMAT_RGB24, 3},
+        {"BGR", SDL_PIXELFORMAT_BGR24, 3},
+    };
+    size_t i;
+
+    for (i = 0; i < SDL_arraysize(formats); i++) {
+        if (!strcmp(name, formats[i].name)) {
+            *bpp = formats[i].bpp;
+            return formats[i].format;
+        }
+    }
+    return 0;
+}
+
+/* Calls multiprocessing.shared_memory.SharedMemory(*args, **kwargs) */
+static PyObject *
+_shm_open(PyObject *args, PyObject *kwargs)
+{
+    PyObject *module, *shm_type, *shm;
+
+    module = PyImport_ImportModule("multiprocessing.shared_memory");
+    if (!module) {
+        return NULL;
+    }
+    shm_type = PyObject_GetAttrString(module, "SharedMemory");
+    Py_DECREF(module);
+    if (!shm_type) {
+        return NULL;
+    }
+    shm = PyObject_Call(shm_type, args, kwargs);
+    Py_DECREF(shm_type);
+    return shm;
+}
+
+/* Unlinks a block this module created, keeping the pending exception */
+static void
+_shm_discard(PyObject *shm)
+{
+    PyObject *type, *value, *traceback, *ret;
+
+    PyErr_Fetch(&type, &value, &traceback);
+    ret = PyObject_CallMethod(shm, "unlink", NULL);
+    Py_XDECREF(ret);
+    PyErr_Clear();
+    PyErr_Restore(type, value, traceback);
+    Py_DECREF(shm);
+}
+
+static PyObject *
+surf_from_shared_memory(PyObject *self, PyObject *args, PyObject *kwargs)
+{
+    static char *kwids[] = {"name", "size", "format", NULL};
+    PyObject *name, *size, *shm, *buf, *view, *dependency;
+    const char *format;
+    Py_buffer *pybuf;
+    SDL_Surface *surf;
+    pgSurfaceObject *surfobj;
+    Uint32 pfe;
+    int w, h, bpp;
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "UOs", kwids, &name,
+                                     &size, &format)) {
+        return NULL;
+    }
+    if (!pg_TwoIntsFromObj(size, &w, &h)) {
+        return RAISE(PyExc_TypeError, "size must be two numbers");
+    }
+    if (w < 0 || h < 0) {
+        return RAISE(pgExc_SDLError, "Invalid resolution for Surface");
+    }
+    pfe = _shm_pixel_format(format, &bpp);
+    if (!pfe) {
+        return RAISE(PyExc_ValueError, "Unrecognized type of format");
+    }
+
+    args = PyTuple_Pack(1, name);
+    if (!args) {
+        return NULL;
+    }
+    shm = _shm_open(args, NULL);
+    Py_DECREF(args);
+    if (!shm) {
+        return NULL;
+    }
+    buf = PyObject_GetAttrString(shm, "buf");
+    if (!buf) {
+        Py_DECREF(shm);
+        return NULL;
+    }
+    /* a view of our own, shm.close() can't pull the memory from under it */
+    view = PyMemoryView_FromObject(buf);
+    Py_DECREF(buf);
+    if (!view) {
+        Py_DECREF(shm);
+        return NULL;
+    }
+    pybuf = PyMemoryView_GET_BUFFER(view);
+    if (pybuf->readonly || pybuf->len < (Py_ssize_t)w * h * bpp) {
+        Py_DECREF(view);
+        Py_DECREF(shm);
+        return RAISE(PyExc_ValueError,
+                     "Shared memory is too small for the size and format");
+    }
+    /* the tuple drops the view before the SharedMemory, which closes
+     * the block when it goes */
+    dependency = PyTuple_Pack(2, shm, view);
+    Py_DECREF(view);
+    Py_DECREF(shm);
+    if (!dependency) {
+        return NULL;
+    }
+
+    surf = PG_CreateSurfaceFrom(pybuf->buf, w, h, w * bpp, pfe);
+    if (!surf) {
+        Py_DECREF(dependency);
+        return RAISE(pgExc_SDLError, SDL_GetError());
+    }
+    surfobj = pgSurface_New2(surf, 1);
+    if (!surfobj) {
+        SDL_FreeSurface(surf);
+        Py_DECREF(dependency);
+        return NULL;
+    }
+    surfobj->dependency = dependency;
+    return (PyObject *)surfobj;
 }
 
 static PyObject *
-surf_get_buffer(PyObject *self, PyObject *_null)
+surf_to_shared_memory(PyObject *self, PyObject *args, PyObject *kwargs)
 {
-    SDL_Surface *surface = pgSurface_AsSurface(self);
-    PyObject *proxy_obj;
+    static char *kwids[] = {"format", NULL};
+    SDL_Surface *surf = pgSurface_AsSurface(self);
+    SDL_Surface *conv;
+    const char *format = "RGBA";
+    PyObject *shm_kwargs, *shm, *buf;
+    Py_buffer view;
+    Py_ssize_t nbytes;
+    Uint32 pfe;
+    Uint8 *dst;
+    int bpp, y;
 
-    SURF_INIT_CHECK(surface)
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "|s", kwids, &format)) {
+        return NULL;
+    }
+    SURF_INIT_CHECK(surf)
+    pfe = _shm_pixel_format(format, &bpp);
+    if (!pfe) {
+        return RAISE(PyExc_ValueError, "Unrecognized type of format");
+    }
 
-    proxy_obj = pgBufproxy_New(self, _get_buffer_0D);
-    if (proxy_obj) {
-        if (pgBufproxy_Trip(proxy_obj)) {
-            Py_DECREF(proxy_obj);
-            proxy_obj = 0;
+    pgSurface_Prep((pgSurfaceObject *)self);
+    conv = PG_ConvertSurfaceFormat(surf, pfe);
+    pgSurface_Unprep((pgSurfaceObject *)self);
+    if (!conv) {
+        return RAISE(pgExc_SDLError, SDL_GetError());
+    }
+
+    /* a zero sized block is an error, keep at least one byte */
+    nbytes = (Py_ssize_t)conv->w * conv->h * bpp;
+    shm_kwargs = Py_BuildValue("{sOsn}", "create", Py_True, "size",
+                               nbytes ? nbytes : (Py_ssize_t)1);
+    if (!shm_kwargs) {
+        SDL_FreeSurface(conv);
+        return NULL;
+    }
+    args = PyTuple_New(0);
+    shm = args ? _shm_open(args, shm_kwargs) : NULL;
+    Py_XDECREF(args);
+    Py_DECREF(shm_kwargs);
+    if (!shm) {
+        SDL_FreeSurface(conv);
+        return NULL;
+    }
+    buf = PyObject_GetAttrString(shm, "buf");
+    if (!buf || PyObject_GetBuffer(buf, &view, PyBUF_WRITABLE)) {
+        Py_XDECREF(buf);
+        SDL_FreeSurface(conv);
+        _shm_discard(shm);
+        return NULL;
+    }
+    Py_DECREF(buf);
+
+    /* rows are packed, with no padding, in the block */
+    dst = (Uint8 *)view.buf;
+    for (y = 0; y < conv->h; y++) {
+        memcpy(dst, (Uint8 *)conv->pixels + (size_t)y * conv->pitch,
+               (size_t)conv->w * bpp);
+        dst += (size_t)conv->w * bpp;
+    }
+    PyBuffer_Release(&view);
+    SDL_FreeSurface(conv);
+    return shm;
+}
+
+static PyObject *
+surf_from_buffer(PyObject *self, PyObject *args, PyObject *kwargs)
+{
+    static char *kwids[] = {"buffer", "size", "pitch", "masks", "depth",
+                            NULL};
+    PyObject *buffer, *size, *masks = Py_None, *view;
+    Py_buffer *pybuf;
+    SDL_Surface *surf;
+    pgSurfaceObject *surfobj;
+    Uint32 Rmask = 0xFF << 16, Gmask = 0xFF << 8, Bmask = 0xFF,
+           Amask = 0xFFu << 24;
+    Uint32 pxformat;
+    int w, h, pitch = 0, bpp = 32, bytes;
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "OO|iOi", kwids, &buffer,
+                                     &size, &pitch, &masks, &bpp)) {
+        return NULL;
+    }
+    if (!pg_TwoIntsFromObj(size, &w, &h)) {
+        return RAISE(PyExc_ValueError,
+                     "size needs to be (number width, number height)");
+    }
+    if (w < 0 || h < 0) {
+        return RAISE(pgExc_SDLError, "Invalid resolution for Surface");
+    }
+    if (masks != Py_None) {
+        if (!PySequence_Check(masks) || PySequence_Length(masks) != 4) {
+            return RAISE(PyExc_ValueError,
+                         "masks argument must be sequence of four numbers");
+        }
+        if (!pg_UintFromObjIndex(masks, 0, &Rmask) ||
+            !pg_UintFromObjIndex(masks, 1, &Gmask) ||
+            !pg_UintFromObjIndex(masks, 2, &Bmask) ||
+            !pg_UintFromObjIndex(masks, 3, &Amask)) {
+            return RAISE(PyExc_ValueError,
+                         "invalid mask values in masks sequence");
         }
     }
-    return proxy_obj;
+    pxformat = SDL_MasksToPixelFormatEnum(bpp, Rmask, Gmask, Bmask, Amask);
+    if (pxformat == SDL_PIXELFORMAT_UNKNOWN ||
+        SDL_ISPIXELFORMAT_INDEXED(pxformat)) {
+        return RAISE(PyExc_ValueError, "Invalid mask values");
+    }
+    bytes = SDL_BYTESPERPIXEL(pxformat);
+    if (!pitch) {
+        pitch = w * bytes;
+    }
+    else if (pitch < w * bytes) {
+        return RAISE(PyExc_ValueError,
+                     "Pitch must be greater than or equal to the width * "
+                     "the bytes per pixel");
+    }
+
+    /* the memoryview holds the export, keeping the exporter alive and its
+     * memory in place for as long as the Surface exists */
+    view = PyMemoryView_FromObject(buffer);
+    if (!view) {
+        return NULL;
+    }
+    pybuf = PyMemoryView_GET_BUFFER(view);
+    if (pybuf->readonly) {
+        Py_DECREF(view);
+        return RAISE(PyExc_ValueError, "buffer must be writable");
+    }
+    if (!PyBuffer_IsContiguous(pybuf, 'A')) {
+        Py_DECREF(view);
+        return RAISE(PyExc_ValueError, "buffer must be contiguous");
+    }
+    if (h &&
+        pybuf->len < (Py_ssize_t)pitch * (h - 1) + (Py_ssize_t)w * bytes) {
+        Py_DECREF(view);
+        return RAISE(PyExc_ValueError,
+                     "Buffer is too small for the size and pitch");
+    }
+
+    surf = PG_CreateSurfaceFrom(pybuf->buf, w, h, pitch, pxformat);
+    if (!surf) {
+        Py_DECREF(view);
+        return RAISE(pgExc_SDLError, SDL_GetError());
+    }
+    if (!Amask) {
+        /* like Surface(), only blend surfaces with an alpha channel */
+        SDL_SetSurfaceBlendMode(surf, SDL_BLENDMODE_NONE);
+    }
+    surfobj = pgSurface_New2(surf, 1);
+    if (!surfobj) {
+        SDL_FreeSurface(surf);
+        Py_DECREF(view);
+        return NULL;
+    }
+    surfobj->dependency = view;
+    return (PyObject *)surfobj;
 }
 
 static PyObject *
@@ -3120,6 +6850,342 @@ surf_premul_alpha(pgSurfaceObject *self, PyObject *_null)
     return final;
 }
 
+static PyObject *
+surf_premul_alpha_ip(pgSurfaceObject *self, PyObject *_null)
+{
+    SDL_Surface *surf = pgSurface_AsSurface(self);
+
+    SURF_INIT_CHECK(surf)
+
+    if (!surf->format->Amask) {
+        return RAISE(PyExc_ValueError,
+                     "source surface to be alpha pre-multiplied must have "
+                     "alpha channel");
+    }
+    if (surf->w > 0 && surf->h > 0) {
+        SDL_Rect all = {0, 0, surf->w, surf->h};
+
+        if (!pgSurface_Unshare(self)) {
+            return NULL;
+        }
+        pgSurface_Prep(self);
+        premul_surf_color_by_alpha(surf, surf);
+        pgSurface_Unprep(self);
+        pgSurface_AddDirtyRect(self, &all);
+    }
+    self->premultiplied = 1;
+
+    Py_INCREF(self);
+    return (PyObject *)self;
+}
+
+static PyObject *
+surf_get_premultiplied(pgSurfaceObject *self, void *closure)
+{
+    return PyBool_FromLong(self->premultiplied);
+}
+
+static int
+surf_set_premultiplied(pgSurfaceObject *self, PyObject *value, void *closure)
+{
+    int premultiplied;
+
+    DEL_ATTR_NOT_SUPPORTED_CHECK_NO_NAME(value);
+    if ((premultiplied = PyObject_IsTrue(value)) == -1) {
+        return -1;
+    }
+    self->premultiplied = premultiplied;
+    return 0;
+}
+
+/* The alpha spans of surfobj, found again if it changed since they were
+ * last found. NULL if they aren't enabled or can't be found right now. */
+static pg_AlphaSpans *
+_surf_alpha_spans(pgSurfaceObject *surfobj)
+{
+    SDL_Surface *surf = pgSurface_AsSurface(surfobj);
+    Uint64 version = pgSurface_GetVersion(surfobj);
+    pg_AlphaSpans *spans = surfobj->alpha_spans;
+    Uint32 key;
+    int keyed;
+
+    if (!spans) {
+        return NULL;
+    }
+    /* set_colorkey() and set_alpha() don't count as changes of the pixels
+     * but change how the runs are found */
+    keyed = pg_alpha_spans_keyed(surf, &key);
+    if (spans->version == version && spans->w == surf->w &&
+        spans->h == surf->h && spans->keyed == keyed &&
+        spans->colorkey == key) {
+        return spans;
+    }
+    if (SDL_MUSTLOCK(surf)) {
+        return NULL;
+    }
+    spans = pg_alpha_spans_new(surf);
+    if (!spans) {
+        return NULL;
+    }
+    spans->version = version;
+    pg_alpha_spans_free(surfobj->alpha_spans);
+    surfobj->alpha_spans = spans;
+    return spans;
+}
+
+static PyObject *
+surf_set_alpha_spans(pgSurfaceObject *self, PyObject *arg)
+{
+    SDL_Surface *surf = pgSurface_AsSurface(self);
+    pg_AlphaSpans *spans;
+    int enable = PyObject_IsTrue(arg);
+
+    SURF_INIT_CHECK(surf)
+
+    if (enable == -1) {
+        return NULL;
+    }
+    if (!enable) {
+        pg_alpha_spans_free(self->alpha_spans);
+        self->alpha_spans = NULL;
+        Py_RETURN_NONE;
+    }
+    if (PG_SURF_BytesPerPixel(surf) < 2) {
+        return RAISE(PyExc_ValueError,
+                     "alpha spans need a Surface of 16 bits or more");
+    }
+    if (self->alpha_spans) {
+        Py_RETURN_NONE;
+    }
+
+    /* found now, and again on the first blit after the Surface changes */
+    if (!pgSurface_Lock(self)) {
+        return NULL;
+    }
+    spans = pg_alpha_spans_new(surf);
+    if (!pgSurface_Unlock(self)) {
+        pg_alpha_spans_free(spans);
+        return NULL;
+    }
+    if (!spans) {
+        return PyErr_NoMemory();
+    }
+    spans->version = pgSurface_GetVersion(self);
+    self->alpha_spans = spans;
+    Py_RETURN_NONE;
+}
+
+static PyObject *
+surf_set_dirty_tracking(pgSurfaceObject *self, PyObject *arg)
+{
+    int enable = PyObject_IsTrue(arg);
+
+    if (enable == -1) {
+        return NULL;
+    }
+    if (enable && !self->dirty) {
+        self->dirty = PyMem_New(pgSurfaceDirtyRects, 1);
+        if (!self->dirty) {
+            return PyErr_NoMemory();
+        }
+        self->dirty->count = 0;
+    }
+    else if (!enable && self->dirty) {
+        PyMem_Free(self->dirty);
+        self->dirty = NULL;
+    }
+    Py_RETURN_NONE;
+}
+
+static PyObject *
+surf_get_dirty_rects(pgSurfaceObject *self, PyObject *args, PyObject *kwargs)
+{
+    SDL_Rect rects[PG_SURF_MAX_DIRTY_RECTS];
+    PyObject *list, *rect;
+    int clear = 1;
+    int i, count;
+
+    static char *kwids[] = {"clear", NULL};
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "|p", kwids, &clear)) {
+        return NULL;
+    }
+
+    count = pgSurface_GetDirtyRects(self, rects, clear);
+    if (count < 0) {
+        return RAISE(pgExc_SDLError,
+                     "dirty rect tracking is not enabled for this Surface");
+    }
+
+    list = PyList_New(count);
+    if (!list) {
+        return NULL;
+    }
+    for (i = 0; i < count; i++) {
+        rect = pgRect_New(&rects[i]);
+        if (!rect) {
+            Py_DECREF(list);
+            return NULL;
+        }
+        PyList_SET_ITEM(list, i, rect);
+    }
+    return list;
+}
+
+static void
+snapshot_dealloc(pgSurfaceSnapshotObject *self)
+{
+    pgSurfaceSnapshotObject *next = self->next, *after;
+
+    /* newer snapshots nothing else holds go too, without recursing */
+    while (next && Py_REFCNT(next) == 1) {
+        after = next->next;
+        next->next = NULL;
+        Py_DECREF(next);
+        next = after;
+    }
+    Py_XDECREF(next);
+    Py_XDECREF(self->surface);
+    PyMem_Free(self->tiles);
+    PyMem_Free(self->offsets);
+    PyMem_Free(self->data);
+    Py_TYPE(self)->tp_free((PyObject *)self);
+}
+
+static PyTypeObject pgSurfaceSnapshot_Type = {
+    PyVarObject_HEAD_INIT(NULL, 0).tp_name = "pygame.surface.SurfaceSnapshot",
+    .tp_basicsize = sizeof(pgSurfaceSnapshotObject),
+    .tp_dealloc = (destructor)snapshot_dealloc,
+    .tp_flags = Py_TPFLAGS_DEFAULT,
+    .tp_doc = DOC_SURFACESNAPSHOT,
+};
+
+static PyObject *
+surf_snapshot(pgSurfaceObject *self, PyObject *_null)
+{
+    SDL_Surface *surf = pgSurface_AsSurface(self);
+    pgSurfaceHistory *hist = self->history;
+    pgSurfaceSnapshotObject *snap, *prev;
+    int error;
+
+    SURF_INIT_CHECK(surf)
+
+    if (self->subsurface) {
+        return RAISE(PyExc_ValueError,
+                     "cannot take snapshots of a subsurface");
+    }
+    snap = PyObject_New(pgSurfaceSnapshotObject, &pgSurfaceSnapshot_Type);
+    if (!snap) {
+        return NULL;
+    }
+    snap->next = NULL;
+    snap->count = 0;
+    snap->tiles = NULL;
+    snap->offsets = NULL;
+    snap->data = NULL;
+    snap->surface = PyWeakref_NewRef((PyObject *)self, NULL);
+    if (!snap->surface) {
+        Py_DECREF(snap);
+        return NULL;
+    }
+
+    /* a resized or converted surface starts a new history */
+    if (hist && !_history_matches(hist, surf)) {
+        _history_free(hist);
+        self->history = hist = NULL;
+    }
+    if (!pgSurface_Lock(self)) {
+        Py_DECREF(snap);
+        return NULL;
+    }
+    if (hist) {
+        if (self->version != hist->seen_version) {
+            hist->unknown = 1;
+        }
+        error = _history_save(hist, surf);
+    }
+    else {
+        hist = self->history = _history_new(surf);
+        error = !hist;
+    }
+    if (!pgSurface_Unlock(self)) {
+        Py_DECREF(snap);
+        return NULL;
+    }
+    if (error) {
+        Py_DECREF(snap);
+        return PyErr_NoMemory();
+    }
+
+    hist->seen_version = self->version;
+    snap->history_id = hist->id;
+    prev = hist->latest;
+    Py_INCREF(snap);
+    hist->latest = snap;
+    if (prev) {
+        Py_INCREF(snap);
+        prev->next = snap;
+        Py_DECREF(prev);
+    }
+    return (PyObject *)snap;
+}
+
+static PyObject *
+surf_restore(pgSurfaceObject *self, PyObject *arg)
+{
+    SDL_Surface *surf = pgSurface_AsSurface(self);
+    pgSurfaceHistory *hist = self->history;
+    pgSurfaceSnapshotObject *snap;
+    SDL_Rect area;
+    int error;
+
+    SURF_INIT_CHECK(surf)
+
+    if (!PyObject_TypeCheck(arg, &pgSurfaceSnapshot_Type)) {
+        return RAISE(PyExc_TypeError,
+                     "restore() argument must be a SurfaceSnapshot");
+    }
+    snap = (pgSurfaceSnapshotObject *)arg;
+    if (PyWeakref_GetObject(snap->surface) != (PyObject *)self) {
+        return RAISE(PyExc_ValueError,
+                     "the snapshot was taken of another Surface");
+    }
+    if (!hist || hist->id != snap->history_id ||
+        !_history_matches(hist, surf)) {
+        return RAISE(PyExc_ValueError,
+                     "the Surface changed size or format since the "
+                     "snapshot was taken");
+    }
+
+    if (self->version != hist->seen_version) {
+        hist->unknown = 1;
+    }
+    if (!pgSurface_Lock(self)) {
+        return NULL;
+    }
+    error = _history_restore(hist, surf, snap, &area);
+    if (!pgSurface_Unlock(self)) {
+        return NULL;
+    }
+    if (error) {
+        return PyErr_NoMemory();
+    }
+
+    /* every tile written to is marked as changed below, the rest are the
+     * same as at the latest snapshot */
+    hist->unknown = 0;
+    hist->seen_version = self->version;
+    if (area.w) {
+        pgSurface_AddDirtyRect(self, &area);
+    }
+    Py_RETURN_NONE;
+}
+
+static PyObject *
+surf_get_version(pgSurfaceObject *self, PyObject *_null)
+{
+    return PyLong_FromUnsignedLongLong(pgSurface_GetVersion(self));
+}
+
 static int
 _get_buffer_0D(PyObject *obj, Py_buffer *view_p, int flags)
 {
@@ -3298,6 +7364,7 @@ _get_buffer_3D(PyObject *obj, Py_buffer *view_p, int flags)
     SDL_Surface *surface = pgSurface_AsSurface(obj);
     int pixelsize = PG_SURF_BytesPerPixel(surface);
     char *startpixel = (char *)surface->pixels;
+    int red, green;
 
     view_p->obj = 0;
     if (!PyBUF_HAS_FLAG(flags, PyBUF_STRIDES)) {
@@ -3327,43 +7394,11 @@ _get_buffer_3D(PyObject *obj, Py_buffer *view_p, int flags)
     view_p->shape[2] = 3;
     view_p->strides[0] = pixelsize;
     view_p->strides[1] = surface->pitch;
-    switch (surface->format->Rmask) {
-#if SDL_BYTEORDER == SDL_LIL_ENDIAN
-        case 0xffU:
-            view_p->strides[2] = 1;
-            break;
-        case 0xff00U:
-            assert(pixelsize == 4);
-            view_p->strides[2] = 1;
-            startpixel += 1;
-            break;
-        case 0xff0000U:
-            view_p->strides[2] = -1;
-            startpixel += 2;
-            break;
-        default: /* 0xff000000U */
-            assert(pixelsize == 4);
-            view_p->strides[2] = -1;
-            startpixel += 3;
-#else  /* SDL_BYTEORDER != SDL_LIL_ENDIAN */
-        case 0xffU:
-            view_p->strides[2] = -1;
-            startpixel += pixelsize - 1;
-            break;
-        case 0xff00U:
-            assert(pixelsize == 4);
-            view_p->strides[2] = -1;
-            startpixel += pixelsize - 2;
-            break;
-        case 0xff0000U:
-            view_p->strides[2] = 1;
-            startpixel += pixelsize - 3;
-            break;
-        default: /* 0xff000000U */
-            assert(pixelsize == 4);
-            view_p->strides[2] = 1;
-#endif /* SDL_BYTEORDER != SDL_LIL_ENDIAN */
-    }
+    /* surf_get_view checked the bytes are evenly spaced */
+    red = _surf_channel_offset(surface->format, surface->format->Rmask);
+    green = _surf_channel_offset(surface->format, surface->format->Gmask);
+    view_p->strides[2] = green - red;
+    startpixel += red;
     view_p->buf = startpixel;
     Py_INCREF(obj);
     view_p->obj = obj;
@@ -3420,47 +7455,7 @@ _get_buffer_colorplane(PyObject *obj, Py_buffer *view_p, int flags, char *name,
                         "A surface color plane view is not contiguous");
         return -1;
     }
-    switch (mask) {
-        /* This switch statement is exhaustive over possible mask value,
-           the allowable masks for 24 bit and 32 bit surfaces */
-
-#if SDL_BYTEORDER == SDL_LIL_ENDIAN
-        case 0x000000ffU:
-            break;
-        case 0x0000ff00U:
-            startpixel += 1;
-            break;
-        case 0x00ff0000U:
-            startpixel += 2;
-            break;
-        case 0xff000000U:
-            startpixel += 3;
-            break;
-#else  /* SDL_BYTEORDER != SDL_LIL_ENDIAN */
-        case 0x000000ffU:
-            startpixel += pixelsize - 1;
-            break;
-        case 0x0000ff00U:
-            startpixel += pixelsize - 2;
-            break;
-        case 0x00ff0000U:
-            startpixel += pixelsize - 3;
-            break;
-        case 0xff000000U:
-            break;
-#endif /* SDL_BYTEORDER != SDL_LIL_ENDIAN */
-
-#ifndef NDEBUG
-            /* Assert this switch statement is exhaustive */
-        default:
-            /* Should not be here */
-            PyErr_Format(PyExc_SystemError,
-                         "Pygame bug caught at line %i in file %s: "
-                         "unknown mask value %p. Please report",
-                         (int)__LINE__, __FILE__, (void *)mask);
-            return -1;
-#endif
-    }
+    startpixel += _surf_channel_offset(surface->format, mask);
     if (_init_buffer(obj, view_p, flags)) {
         return -1;
     }
@@ -3481,6 +7476,27 @@ _get_buffer_colorplane(PyObject *obj, Py_buffer *view_p, int flags, char *name,
     return 0;
 }
 
+/* The byte offset within a pixel of the 8 bit channel with the given mask,
+ * or -1 if the mask isn't a whole byte of the pixel.
+ */
+static int
+_surf_channel_offset(SDL_PixelFormat *format, Uint32 mask)
+{
+    int pixelsize = PG_FORMAT_BytesPerPixel(format);
+    int byte;
+
+    for (byte = 0; byte < pixelsize; ++byte) {
+        if (mask == 0xffU << (byte * 8)) {
+#if SDL_BYTEORDER == SDL_LIL_ENDIAN
+            return byte;
+#else
+            return pixelsize - 1 - byte;
+#endif
+        }
+    }
+    return -1;
+}
+
 static int
 _init_buffer(PyObject *surf, Py_buffer *view_p, int flags)
 {
@@ -3634,6 +7650,10 @@ surf_get_pixels_address(PyObject *self, PyObject *closure)
     if (!surface->pixels) {
         return PyLong_FromLong(0L);
     }
+    /* the address may be written to */
+    if (!pgSurface_Unshare((pgSurfaceObject *)self)) {
+        return NULL;
+    }
     address = surface->pixels;
 #if SIZEOF_VOID_P > SIZEOF_LONG
     return PyLong_FromUnsignedLongLong((unsigned PY_LONG_LONG)address);
@@ -3646,6 +7666,11 @@ static void
 surface_move(Uint8 *src, Uint8 *dst, int h, int span, int srcpitch,
              int dstpitch)
 {
+    if (span == srcpitch && span == dstpitch) {
+        /* No gaps between the rows, so move them all at once */
+        memmove(dst, src, (size_t)h * span);
+        return;
+    }
     if (src < dst) {
         src += (h - 1) * srcpitch;
         dst += (h - 1) * dstpitch;
@@ -3741,10 +7766,110 @@ surface_do_overlap(SDL_Surface *src, SDL_Rect *srcrect, SDL_Surface *dst,
     return dstoffset < span || dstoffset > src->pitch - span;
 }
 
+/* Blit tracing. While enabled, every blit through pgSurface_Blit() is
+ * accounted to its (source format, destination format, blend flags, kernel)
+ * entry, and the first large blit of an entry that ran on one of the generic
+ * per pixel kernels raises a RuntimeWarning. */
+#define PG_BLIT_TRACE_MAX_ENTRIES 64
+#define PG_BLIT_TRACE_WARN_PIXELS (1 << 16)
+
+typedef struct {
+    Uint32 src_format;
+    Uint32 dst_format;
+    int blend_flags;
+    const char *kernel;
+    Uint64 calls;
+    Uint64 pixels;
+    Uint64 ticks;
+    int warned;
+} pg_BlitTraceEntry;
+
+static struct {
+    int enabled;
+    int num_entries;
+    pg_BlitTraceEntry entries[PG_BLIT_TRACE_MAX_ENTRIES];
+    pg_mutex lock; /* of the entries */
+} blit_trace;
+
+static const char *
+_blit_trace_format_name(Uint32 format)
+{
+    const char *name = SDL_GetPixelFormatName(format);
+
+    if (!strncmp(name, "SDL_PIXELFORMAT_", 16)) {
+        return name + 16;
+    }
+    return name;
+}
+
+/* New combinations are dropped once the table is full. On error, returns -1
+ * with python error set, which happens if the warning is an exception. */
+static int
+_blit_trace_record(Uint32 src_format, Uint32 dst_format, int blend_flags,
+                   const char *kernel, int generic, Uint64 pixels,
+                   Uint64 ticks)
+{
+    pg_BlitTraceEntry *entry = NULL;
+    int i, warn = 0;
+
+    pg_mutex_lock(&blit_trace.lock);
+    for (i = 0; i < blit_trace.num_entries; i++) {
+        entry = &blit_trace.entries[i];
+        if (entry->src_format == src_format &&
+            entry->dst_format == dst_format &&
+            entry->blend_flags == blend_flags && entry->kernel == kernel) {
+            break;
+        }
+    }
+    if (i == blit_trace.num_entries) {
+        entry = NULL;
+        if (i < PG_BLIT_TRACE_MAX_ENTRIES) {
+            entry = &blit_trace.entries[blit_trace.num_entries++];
+            memset(entry, 0, sizeof(*entry));
+            entry->src_format = src_format;
+            entry->dst_format = dst_format;
+            entry->blend_flags = blend_flags;
+            entry->kernel = kernel;
+        }
+    }
+    if (entry) {
+        entry->calls++;
+        entry->pixels += pixels;
+        entry->ticks += ticks;
+        if (generic && pixels >= PG_BLIT_TRACE_WARN_PIXELS &&
+            !entry->warned) {
+            entry->warned = warn = 1;
+        }
+    }
+    pg_mutex_unlock(&blit_trace.lock);
+
+    if (warn) {
+        return PyErr_WarnFormat(
+            PyExc_RuntimeWarning, 1,
+            "blit of %llu pixels from %s to %s ran on the generic per pixel "
+            "path (%s), converting the source surface with convert() or "
+            "convert_alpha() may be faster",
+            (unsigned long long)pixels, _blit_trace_format_name(src_format),
+            _blit_trace_format_name(dst_format), kernel);
+    }
+    return 0;
+}
+
 /*this internal blit function is accessible through the C api*/
 int
 pgSurface_Blit(pgSurfaceObject *dstobj, pgSurfaceObject *srcobj,
                SDL_Rect *dstrect, SDL_Rect *srcrect, int blend_flags)
+{
+    return _surf_blit(dstobj, srcobj, dstrect, srcrect, blend_flags, NULL);
+}
+
+/* pgSurface_Blit(), queueing the blits done by pygame's own kernels in
+ * queue if it isn't NULL. The others flush the queue first, so that the
+ * blits still land in order. */
+static int
+_surf_blit(pgSurfaceObject *dstobj, pgSurfaceObject *srcobj,
+           SDL_Rect *dstrect, SDL_Rect *srcrect, int blend_flags,
+           pg_BlitQueue *queue)
 {
     SDL_Surface *src = pgSurface_AsSurface(srcobj);
     SDL_Surface *dst = pgSurface_AsSurface(dstobj);
@@ -3752,6 +7877,32 @@ pgSurface_Blit(pgSurfaceObject *dstobj, pgSurfaceObject *srcobj,
     int result, suboffsetx = 0, suboffsety = 0;
     SDL_Rect orig_clip, sub_clip;
     Uint8 alpha;
+    /* pygame_BlitQueued() tells which of its kernels ran, anything else is
+     * SDL. The kernel is only named for blit tracing. */
+    const char *kernel = "SDL_BlitSurface";
+    pg_BlitKernel used = NULL;
+    int simd = 0, generic = 0, from_pygame = 0;
+    pg_NoGIL nogil;
+    Uint32 src_format = src->format->format;
+    Uint64 trace_start = blit_trace.enabled ? SDL_GetPerformanceCounter() : 0;
+    PG_PERF_START(perf_start);
+
+    blend_flags = _surf_blend_flags(srcobj, blend_flags);
+
+    /* the display renderer draws ACCELERATED surfaces */
+    if (dstobj->canvas &&
+        dstobj->canvas->accepts((PyObject *)dstobj, (PyObject *)srcobj,
+                                blend_flags)) {
+        pg_blit_queue_flush(queue);
+        result = dstobj->canvas->blit((PyObject *)dstobj, (PyObject *)srcobj,
+                                      dstrect, srcrect);
+        if (result == 0) {
+            pgSurface_AddDirtyRect(dstobj, dstrect);
+        }
+        PG_PERF_STOP(perf_start, PG_PERF_BLIT,
+                     result == 0 ? (Uint64)dstrect->w * dstrect->h : 0);
+        return result != 0;
+    }
 
     /* passthrough blits to the real surface */
     if (((pgSurfaceObject *)dstobj)->subsurface) {
@@ -3771,6 +7922,10 @@ pgSurface_Blit(pgSurfaceObject *dstobj, pgSurfaceObject *srcobj,
             suboffsetx += subdata->offsetx;
             suboffsety += subdata->offsety;
         }
+        /* the owner is written to without being locked */
+        if (!pgSurface_Unshare((pgSurfaceObject *)owner)) {
+            return 1;
+        }
 
         SDL_GetClipRect(subsurface, &orig_clip);
         SDL_GetClipRect(dst, &sub_clip);
@@ -3782,6 +7937,9 @@ pgSurface_Blit(pgSurfaceObject *dstobj, pgSurfaceObject *srcobj,
         dst = subsurface;
     }
     else {
+        if (!pgSurface_Unshare(dstobj)) {
+            return 1;
+        }
         pgSurface_Prep(dstobj);
         subsurface = NULL;
     }
@@ -3797,17 +7955,27 @@ pgSurface_Blit(pgSurfaceObject *dstobj, pgSurfaceObject *srcobj,
             */
          dst->pixels == src->pixels && srcrect != NULL &&
          surface_do_overlap(src, srcrect, dst, dstrect))) {
-        /* Py_BEGIN_ALLOW_THREADS */
-        result = pygame_Blit(src, srcrect, dst, dstrect, blend_flags);
-        /* Py_END_ALLOW_THREADS */
+        /* the runs of a source blitted onto itself go stale as it goes */
+        const pg_AlphaSpans *spans =
+            dst->pixels != src->pixels ? _surf_alpha_spans(srcobj) : NULL;
+
+        pg_nogil_begin(&nogil, dstobj, srcobj);
+        result = pygame_BlitQueued(src, srcrect, dst, dstrect, blend_flags,
+                                   spans, queue, &used);
+        pg_nogil_end(&nogil);
+        from_pygame = 1;
     }
     /* can't blit alpha to 8bit, crashes SDL */
     else if (PG_SURF_BytesPerPixel(dst) == 1 &&
              (SDL_ISPIXELFORMAT_ALPHA(src->format->format) ||
               ((SDL_GetSurfaceAlphaMod(src, &alpha) == 0 && alpha != 255)))) {
-        /* Py_BEGIN_ALLOW_THREADS */
+        pg_blit_queue_flush(queue);
         if (PG_SURF_BytesPerPixel(src) == 1) {
-            result = pygame_Blit(src, srcrect, dst, dstrect, 0);
+            pg_nogil_begin(&nogil, dstobj, srcobj);
+            result = pygame_BlitQueued(src, srcrect, dst, dstrect, 0, NULL,
+                                       NULL, &used);
+            pg_nogil_end(&nogil);
+            from_pygame = 1;
         }
         else {
             SDL_PixelFormat *fmt = src->format;
@@ -3842,7 +8010,6 @@ pgSurface_Blit(pgSurfaceObject *dstobj, pgSurfaceObject *srcobj,
                 result = -1;
             }
         }
-        /* Py_END_ALLOW_THREADS */
     }
     else if (blend_flags != PYGAME_BLEND_ALPHA_SDL2 &&
              !(pg_EnvShouldBlendAlphaSDL2()) && !SDL_HasColorKey(src) &&
@@ -3855,12 +8022,68 @@ pgSurface_Blit(pgSurfaceObject *dstobj, pgSurfaceObject *srcobj,
         /* If we have a 32bit source surface with per pixel alpha
            and no RLE we'll use pygame_Blit so we can mimic how SDL1
             behaved */
-        result = pygame_Blit(src, srcrect, dst, dstrect, blend_flags);
+        const pg_AlphaSpans *spans = _surf_alpha_spans(srcobj);
+
+        pg_nogil_begin(&nogil, dstobj, srcobj);
+        result = pygame_BlitQueued(src, srcrect, dst, dstrect, blend_flags,
+                                   spans, queue, &used);
+        pg_nogil_end(&nogil);
+        from_pygame = 1;
+    }
+    else if (srcobj->alpha_spans && blend_flags == 0 &&
+             SDL_HasColorKey(src) && !src->format->Amask &&
+             src->format->format == dst->format->format &&
+             SDL_GetSurfaceAlphaMod(src, &alpha) == 0 && alpha == 255 &&
+             !_surf_has_color_mod(src) && !(src->flags & SDL_RLEACCEL) &&
+             !(dst->flags & SDL_RLEACCEL)) {
+        /* Colorkey blits between surfaces of the same format copy the
+           pixels SDL would, using the runs to skip the keyed ones */
+        const pg_AlphaSpans *spans = _surf_alpha_spans(srcobj);
+
+        pg_nogil_begin(&nogil, dstobj, srcobj);
+        result = pygame_BlitQueued(src, srcrect, dst, dstrect, 0, spans,
+                                   queue, &used);
+        pg_nogil_end(&nogil);
+        from_pygame = 1;
+    }
+    else if (blend_flags == 0 && !SDL_HasColorKey(src) &&
+             !src->format->Amask && PG_SURF_BytesPerPixel(src) == 4 &&
+             src->format->format == dst->format->format &&
+             SDL_GetSurfaceAlphaMod(src, &alpha) == 0 && alpha == 255 &&
+             !_surf_has_color_mod(src) && dst->pixels != src->pixels &&
+             !(src->flags & SDL_RLEACCEL) &&
+             !(dst->flags & SDL_RLEACCEL) &&
+             pg_surface_is_private(dstobj) && pg_surface_is_private(srcobj)) {
+        /* SDL_BlitSurface() updates the blit map of the source, which
+           other threads may be using, so copies that could run without
+           the GIL go through pygame_Blit(), which copies the rows as they
+           are like SDL does */
+        pg_nogil_begin(&nogil, dstobj, srcobj);
+        result = pygame_BlitQueued(src, srcrect, dst, dstrect, 0, NULL,
+                                   queue, &used);
+        pg_nogil_end(&nogil);
+        from_pygame = 1;
+    }
+    else if (blend_flags == 0 && SDL_HasColorKey(src) &&
+             !src->format->Amask && PG_SURF_BytesPerPixel(src) == 4 &&
+             src->format->format == dst->format->format &&
+             SDL_GetSurfaceAlphaMod(src, &alpha) == 0 && alpha == 255 &&
+             !_surf_has_color_mod(src) && dst->pixels != src->pixels &&
+             !PG_SurfaceHasRLE(src) && !PG_SurfaceHasRLE(dst) &&
+             !(src->flags & SDL_RLEACCEL) && !(dst->flags & SDL_RLEACCEL)) {
+        /* Without surface alpha the colorkey blitters copy the pixels that
+           aren't the colorkey as they are and leave the others, like SDL,
+           so colorkey blits of the same 32 bit format can use the SIMD
+           ones */
+        pg_nogil_begin(&nogil, dstobj, srcobj);
+        result = pygame_BlitQueued(src, srcrect, dst, dstrect, 0, NULL,
+                                   queue, &used);
+        pg_nogil_end(&nogil);
+        from_pygame = 1;
     }
     else {
-        /* Py_BEGIN_ALLOW_THREADS */
+        pg_blit_queue_flush(queue);
         result = SDL_BlitSurface(src, srcrect, dst, dstrect);
-        /* Py_END_ALLOW_THREADS */
     }
 
     if (subsurface) {
@@ -3872,15 +8095,485 @@ pgSurface_Blit(pgSurfaceObject *dstobj, pgSurfaceObject *srcobj,
         pgSurface_Unprep(dstobj);
     pgSurface_Unprep(srcobj);
 
+    if (result == 0)
+        pgSurface_AddDirtyRect(dstobj, dstrect);
     if (result == -1)
         PyErr_SetString(pgExc_SDLError, SDL_GetError());
     if (result == -2)
         PyErr_SetString(pgExc_SDLError, "Surface was lost");
 
+    if (blit_trace.enabled && from_pygame) {
+        kernel = pg_blit_kernel_name(used, &simd);
+        generic = !simd;
+    }
+    if (blit_trace.enabled && result == 0 && kernel && dstrect->w &&
+        dstrect->h &&
+        _blit_trace_record(src_format, dst->format->format, blend_flags,
+                           kernel, generic, (Uint64)dstrect->w * dstrect->h,
+                           SDL_GetPerformanceCounter() - trace_start)) {
+        result = 1;
+    }
+
+    /* SDL_BlitSurface() leaves the clipped area in dstrect */
+    PG_PERF_STOP(perf_start, PG_PERF_BLIT,
+                 result == 0 ? (Uint64)dstrect->w * dstrect->h : 0);
     return result != 0;
 }
 
-static PyMethodDef _surface_methods[] = {{NULL, NULL, 0, NULL}};
+static PyObject *
+surf_set_blit_threads(PyObject *self, PyObject *arg)
+{
+    long num_threads = PyLong_AsLong(arg);
+
+    if (num_threads == -1 && PyErr_Occurred()) {
+        return NULL;
+    }
+    if (num_threads < 0) {
+        return RAISE(PyExc_ValueError,
+                     "the number of blit threads must not be negative");
+    }
+    if (num_threads > INT_MAX) {
+        num_threads = INT_MAX;
+    }
+
+    if (pg_set_blit_threads((int)num_threads) < 0) {
+        return RAISE(pgExc_SDLError, SDL_GetError());
+    }
+    if (pg_get_blit_threads() > 1 && !blit_threads_quit_registered) {
+        pg_RegisterQuit(_surf_quit_blit_threads);
+        blit_threads_quit_registered = 1;
+    }
+    Py_RETURN_NONE;
+}
+
+static PyObject *
+surf_get_blit_threads(PyObject *self, PyObject *_null)
+{
+    return PyLong_FromLong(pg_get_blit_threads());
+}
+
+static PyObject *
+surf_set_blit_trace(PyObject *self, PyObject *arg)
+{
+    int enabled = PyObject_IsTrue(arg);
+
+    if (enabled == -1) {
+        return NULL;
+    }
+    pg_mutex_lock(&blit_trace.lock);
+    if (enabled && !blit_trace.enabled) {
+        blit_trace.num_entries = 0;
+    }
+    blit_trace.enabled = enabled;
+    pg_mutex_unlock(&blit_trace.lock);
+    Py_RETURN_NONE;
+}
+
+static PyObject *
+surf_get_blit_trace(PyObject *self, PyObject *_null)
+{
+    const Uint64 freq = SDL_GetPerformanceFrequency();
+    pg_BlitTraceEntry *entry;
+    PyObject *list, *item;
+    int i;
+
+    pg_mutex_lock(&blit_trace.lock);
+    if (!(list = PyList_New(blit_trace.num_entries))) {
+        pg_mutex_unlock(&blit_trace.lock);
+        return NULL;
+    }
+    for (i = 0; i < blit_trace.num_entries; i++) {
+        entry = &blit_trace.entries[i];
+        /* split up so that the ticks don't overflow when scaled */
+        item = Py_BuildValue(
+            "{sssssisssKsKsK}", "src_format",
+            _blit_trace_format_name(entry->src_format), "dst_format",
+            _blit_trace_format_name(entry->dst_format), "special_flags",
+            entry->blend_flags, "kernel", entry->kernel, "calls",
+            (unsigned long long)entry->calls, "pixels",
+            (unsigned long long)entry->pixels, "ns",
+            (unsigned long long)(entry->ticks / freq * 1000000000 +
+                                 entry->ticks % freq * 1000000000 / freq));
+        if (!item) {
+            Py_CLEAR(list);
+            break;
+        }
+        PyList_SET_ITEM(list, i, item);
+    }
+    pg_mutex_unlock(&blit_trace.lock);
+    return list;
+}
+
+static PyObject *
+surf_set_copy_on_write(PyObject *self, PyObject *arg)
+{
+    int enabled = PyObject_IsTrue(arg);
+
+    if (enabled == -1) {
+        return NULL;
+    }
+    /* surfaces already sharing their pixels keep doing so */
+    surf_copy_on_write = enabled;
+    Py_RETURN_NONE;
+}
+
+static PyObject *
+surf_get_copy_on_write(PyObject *self, PyObject *_null)
+{
+    return PyBool_FromLong(surf_copy_on_write);
+}
+
+static PyObject *
+surf_set_pool_limit(PyObject *self, PyObject *arg)
+{
+    long long limit = PyLong_AsLongLong(arg);
+
+    if (limit == -1 && PyErr_Occurred()) {
+        return NULL;
+    }
+    if (limit < 0) {
+        return RAISE(PyExc_ValueError, "the pool limit can't be negative");
+    }
+    pg_mutex_lock(&surf_pool.lock);
+    surf_pool.limit = (Sint64)limit;
+    _surf_pool_trim(surf_pool.limit);
+    if (limit && !surf_pool_quit_registered) {
+        pg_RegisterQuit(_surf_pool_quit);
+        surf_pool_quit_registered = 1;
+    }
+    pg_mutex_unlock(&surf_pool.lock);
+    Py_RETURN_NONE;
+}
+
+static PyObject *
+surf_get_pool_stats(PyObject *self, PyObject *_null)
+{
+    PyObject *stats;
+
+    pg_mutex_lock(&surf_pool.lock);
+    stats = Py_BuildValue("{sLsLsisKsK}", "limit", (long long)surf_pool.limit,
+                          "bytes", (long long)surf_pool.bytes, "count",
+                          surf_pool.count, "hits",
+                          (unsigned long long)surf_pool.hits, "misses",
+                          (unsigned long long)surf_pool.misses);
+    pg_mutex_unlock(&surf_pool.lock);
+    return stats;
+}
+
+static PyObject *
+surf_set_row_alignment(PyObject *self, PyObject *arg)
+{
+    long align = PyLong_AsLong(arg);
+
+    if (align == -1 && PyErr_Occurred()) {
+        return NULL;
+    }
+    if (align < 0 || align > 256 || (align & (align - 1))) {
+        return RAISE(PyExc_ValueError,
+                     "the row alignment must be 0 or a power of two up to "
+                     "256");
+    }
+    /* surfaces that exist keep their rows */
+    surf_row_alignment = (int)align;
+    Py_RETURN_NONE;
+}
+
+static PyObject *
+surf_get_row_alignment(PyObject *self, PyObject *_null)
+{
+    return PyLong_FromLong(surf_row_alignment);
+}
+
+/* Helpers of pygame.sprite.AbstractGroup.draw and update. They walk the
+ * list of sprites in C, so that large groups don't pay for a Python loop,
+ * a generator and a tuple per sprite. */
+static PyObject *_surf_image_str = NULL;
+static PyObject *_surf_rect_str = NULL;
+static PyObject *_surf_update_str = NULL;
+
+static int
+_surf_draw_sprite(pgSurfaceObject *self, PyObject *sprite,
+                  PyObject *spritedict)
+{
+    PyObject *image, *rect, *retrect;
+    SDL_Surface *src;
+    SDL_Rect dest_rect, temp, *rectptr;
+    int result;
+
+    if (!(image = PyObject_GetAttr(sprite, _surf_image_str))) {
+        return -1;
+    }
+    if (!(rect = PyObject_GetAttr(sprite, _surf_rect_str))) {
+        Py_DECREF(image);
+        return -1;
+    }
+
+    if (!pgSurface_Check(image)) {
+        PyErr_SetString(PyExc_TypeError, "Source objects must be a surface");
+        goto error;
+    }
+    if (!(src = pgSurface_AsSurface(image))) {
+        PyErr_SetString(pgExc_SDLError, "Surface is not initialized");
+        goto error;
+    }
+    if ((rectptr = pgRect_FromObject(rect, &temp))) {
+        dest_rect.x = rectptr->x;
+        dest_rect.y = rectptr->y;
+    }
+    else if (!pg_TwoIntsFromObj(rect, &dest_rect.x, &dest_rect.y)) {
+        PyErr_SetString(PyExc_TypeError,
+                        "invalid destination position for blit");
+        goto error;
+    }
+    dest_rect.w = src->w;
+    dest_rect.h = src->h;
+
+    if (pgSurface_Blit(self, (pgSurfaceObject *)image, &dest_rect, NULL, 0)) {
+        if (!PyErr_Occurred()) {
+            PyErr_SetString(PyExc_TypeError, "Blit failed");
+        }
+        goto error;
+    }
+    Py_DECREF(image);
+    Py_DECREF(rect);
+
+    if (!(retrect = pgRect_New(&dest_rect))) {
+        return -1;
+    }
+    result = PyDict_SetItem(spritedict, sprite, retrect);
+    Py_DECREF(retrect);
+    return result;
+
+error:
+    Py_DECREF(image);
+    Py_DECREF(rect);
+    return -1;
+}
+
+static PyObject *
+surf_draw_sprites(PyObject *module, PyObject *const *args, Py_ssize_t nargs)
+{
+    PyObject *sprites, *spritedict, *sprite;
+    Py_ssize_t i;
+    int result;
+
+    if (nargs != 3 || !pgSurface_Check(args[0]) || !PyDict_Check(args[2])) {
+        return RAISE(PyExc_TypeError,
+                     "_draw_sprites expects a Surface, sprites and a dict");
+    }
+    SURF_INIT_CHECK(pgSurface_AsSurface(args[0]))
+    spritedict = args[2];
+    if (!(sprites = PySequence_Fast(args[1], "sprites must be a sequence"))) {
+        return NULL;
+    }
+
+    /* the attributes may be properties that change a list, so check the
+     * size every time and hold on to the sprite being drawn */
+    for (i = 0; i < PySequence_Fast_GET_SIZE(sprites); i++) {
+        sprite = PySequence_Fast_GET_ITEM(sprites, i);
+        Py_INCREF(sprite);
+        result = _surf_draw_sprite((pgSurfaceObject *)args[0], sprite,
+                                   spritedict);
+        Py_DECREF(sprite);
+        if (result) {
+            Py_DECREF(sprites);
+            return NULL;
+        }
+    }
+    Py_DECREF(sprites);
+    Py_RETURN_NONE;
+}
+
+static PyObject *
+surf_update_sprites(PyObject *module, PyObject *args)
+{
+    PyObject *sprites, *update_args, *kwargs, *sprite, *update, *result;
+    Py_ssize_t i;
+
+    if (!PyArg_ParseTuple(args, "OO!O!", &sprites, &PyTuple_Type,
+                          &update_args, &PyDict_Type, &kwargs)) {
+        return NULL;
+    }
+    if (!PyDict_GET_SIZE(kwargs)) {
+        kwargs = NULL;
+    }
+    if (!(sprites = PySequence_Fast(sprites, "sprites must be a sequence"))) {
+        return NULL;
+    }
+
+    for (i = 0; i < PySequence_Fast_GET_SIZE(sprites); i++) {
+        sprite = PySequence_Fast_GET_ITEM(sprites, i);
+        Py_INCREF(sprite);
+        update = PyObject_GetAttr(sprite, _surf_update_str);
+        Py_DECREF(sprite);
+        if (!update) {
+            Py_DECREF(sprites);
+            return NULL;
+        }
+        result = PyObject_Call(update, update_args, kwargs);
+        Py_DECREF(update);
+        if (!result) {
+            Py_DECREF(sprites);
+            return NULL;
+        }
+        Py_DECREF(result);
+    }
+    Py_DECREF(sprites);
+    Py_RETURN_NONE;
+}
+
+/* The surfaces of get_bounding_rects(), shared by its threads */
+typedef struct {
+    SDL_Surface **surfs;
+    SDL_Rect *rects;
+    int count;
+    int min_alpha;
+    SDL_atomic_t next;
+} _surf_bounds_batch;
+
+/* Below this many pixels in all, get_bounding_rects() runs on one thread */
+#define SURF_BOUNDS_THREAD_MIN_PIXELS (1 << 16)
+
+/* Each band takes the surfaces that are left one at a time */
+static void
+_surf_bounds_band(void *data, int band)
+{
+    _surf_bounds_batch *batch = (_surf_bounds_batch *)data;
+    int i;
+
+    while ((i = SDL_AtomicAdd(&batch->next, 1)) < batch->count) {
+        _surf_bounding_rect(batch->surfs[i], batch->min_alpha,
+                            batch->rects + i);
+    }
+}
+
+static PyObject *
+surf_get_bounding_rects(PyObject *module, PyObject *args, PyObject *kwargs)
+{
+    PyObject *surfaces, *seq, *item, *ret = NULL;
+    _surf_bounds_batch batch;
+    Sint64 pixels = 0;
+    Py_ssize_t count;
+    int threads = 0, nlocked = 0, i;
+    static char *kwids[] = {"surfaces", "min_alpha", "threads", NULL};
+
+    memset(&batch, 0, sizeof(batch));
+    batch.min_alpha = 1;
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "O|ii", kwids, &surfaces,
+                                     &batch.min_alpha, &threads)) {
+        return NULL;
+    }
+    if (threads < 0) {
+        return RAISE(PyExc_ValueError, "threads must not be negative");
+    }
+    if (!(seq = PySequence_Fast(surfaces, "surfaces must be a sequence"))) {
+        return NULL;
+    }
+    count = PySequence_Fast_GET_SIZE(seq);
+    if (count > INT_MAX) {
+        Py_DECREF(seq);
+        return RAISE(PyExc_OverflowError, "too many surfaces");
+    }
+    batch.count = (int)count;
+    batch.surfs = PyMem_New(SDL_Surface *, count ? count : 1);
+    batch.rects = PyMem_New(SDL_Rect, count ? count : 1);
+    if (!batch.surfs || !batch.rects) {
+        PyErr_NoMemory();
+        goto end;
+    }
+
+    for (; nlocked < batch.count; ++nlocked) {
+        item = PySequence_Fast_GET_ITEM(seq, nlocked);
+        if (!pgSurface_Check(item)) {
+            PyErr_Format(PyExc_TypeError,
+                         "surfaces must be Surface objects, got %s",
+                         Py_TYPE(item)->tp_name);
+            goto end;
+        }
+        if (!(batch.surfs[nlocked] = pgSurface_AsSurface(item))) {
+            PyErr_SetString(pgExc_SDLError, "Surface is not initialized");
+            goto end;
+        }
+        if (!pgSurface_Lock((pgSurfaceObject *)item)) {
+            PyErr_SetString(pgExc_SDLError, "could not lock surface");
+            goto end;
+        }
+        pixels += (Sint64)batch.surfs[nlocked]->w * batch.surfs[nlocked]->h;
+    }
+
+    if (!threads) {
+        threads = SDL_GetCPUCount();
+    }
+    if (pixels < SURF_BOUNDS_THREAD_MIN_PIXELS) {
+        threads = 1;
+    }
+    threads = MIN(threads, batch.count);
+
+    Py_BEGIN_ALLOW_THREADS;
+    _surf_run_bands(_surf_bounds_band, &batch, threads);
+    Py_END_ALLOW_THREADS;
+
+    if (!(ret = PyList_New(count))) {
+        goto end;
+    }
+    for (i = 0; i < batch.count; ++i) {
+        if (!(item = pgRect_New(batch.rects + i))) {
+            Py_CLEAR(ret);
+            goto end;
+        }
+        PyList_SET_ITEM(ret, i, item);
+    }
+
+end:
+    for (i = 0; i < nlocked; ++i) {
+        item = PySequence_Fast_GET_ITEM(seq, i);
+        if (!pgSurface_Unlock((pgSurfaceObject *)item) && ret) {
+            Py_CLEAR(ret);
+            PyErr_SetString(pgExc_SDLError, "could not unlock surface");
+        }
+    }
+    PyMem_Free(batch.surfs);
+    PyMem_Free(batch.rects);
+    Py_DECREF(seq);
+    return ret;
+}
+
+static PyMethodDef _surface_methods[] = {
+    {"set_blit_threads", surf_set_blit_threads, METH_O,
+     DOC_SURFACE_SETBLITTHREADS},
+    {"get_blit_threads", surf_get_blit_threads, METH_NOARGS,
+     DOC_SURFACE_GETBLITTHREADS},
+    {"set_blit_trace", surf_set_blit_trace, METH_O, DOC_SURFACE_SETBLITTRACE},
+    {"get_blit_trace", surf_get_blit_trace, METH_NOARGS,
+     DOC_SURFACE_GETBLITTRACE},
+    {"set_copy_on_write", surf_set_copy_on_write, METH_O,
+     DOC_SURFACE_SETCOPYONWRITE},
+    {"get_copy_on_write", surf_get_copy_on_write, METH_NOARGS,
+     DOC_SURFACE_GETCOPYONWRITE},
+    {"set_pool_limit", surf_set_pool_limit, METH_O, DOC_SURFACE_SETPOOLLIMIT},
+    {"get_pool_stats", surf_get_pool_stats, METH_NOARGS,
+     DOC_SURFACE_GETPOOLSTATS},
+    {"set_row_alignment", surf_set_row_alignment, METH_O,
+     DOC_SURFACE_SETROWALIGNMENT},
+    {"get_row_alignment", surf_get_row_alignment, METH_NOARGS,
+     DOC_SURFACE_GETROWALIGNMENT},
+    {"get_bounding_rects", (PyCFunction)surf_get_bounding_rects,
+     METH_VARARGS | METH_KEYWORDS, DOC_SURFACE_GETBOUNDINGRECTS},
+    {"_draw_sprites", (PyCFunction)surf_draw_sprites, METH_FASTCALL, NULL},
+    {"_update_sprites", surf_update_sprites, METH_VARARGS, NULL},
+    {NULL, NULL, 0, NULL}};
+
+/* All the kinds of kernels are picked on every call */
+static int
+_surf_simd_dispatch(PyObject *dispatch)
+{
+    if (pg_blit_simd_dispatch(dispatch) ||
+        surface_fill_simd_dispatch(dispatch) ||
+        surface_alpha_bounds_simd_dispatch(dispatch)) {
+        return -1;
+    }
+    return 0;
+}
 
 MODINIT_DEFINE(surface)
 {
@@ -3916,6 +8609,10 @@ MODINIT_DEFINE(surface)
     if (PyErr_Occurred()) {
         return NULL;
     }
+    import_pygame_math();
+    if (PyErr_Occurred()) {
+        return NULL;
+    }
     _IMPORT_PYGAME_MODULE(surflock);
     if (PyErr_Occurred()) {
         return NULL;
@@ -3925,16 +8622,44 @@ MODINIT_DEFINE(surface)
     if (PyType_Ready(&pgSurface_Type) < 0) {
         return NULL;
     }
+    if (PyType_Ready(&pgBlitBatch_Type) < 0) {
+        return NULL;
+    }
+    if (PyType_Ready(&pgSurfaceSnapshot_Type) < 0) {
+        return NULL;
+    }
+    if (PyType_Ready(&pgSurfaceView_Type) < 0) {
+        return NULL;
+    }
+    pgBlendMode_Type.tp_base = &PyLong_Type;
+    if (PyType_Ready(&pgBlendMode_Type) < 0) {
+        return NULL;
+    }
+
+    /* attribute names looked up on every sprite by the sprite helpers */
+    if (!_surf_image_str) {
+        _surf_image_str = PyUnicode_InternFromString("image");
+        _surf_rect_str = PyUnicode_InternFromString("rect");
+        _surf_update_str = PyUnicode_InternFromString("update");
+        if (!_surf_image_str || !_surf_rect_str || !_surf_update_str) {
+            Py_CLEAR(_surf_image_str);
+            Py_CLEAR(_surf_rect_str);
+            Py_CLEAR(_surf_update_str);
+            return NULL;
+        }
+    }
 
     /* create the module */
     module = PyModule_Create(&_module);
     if (module == NULL) {
         return NULL;
     }
-    if (pg_warn_simd_at_runtime_but_uncompiled() < 0) {
+    if (PG_GIL_NOT_USED(module) ||
+        pg_warn_simd_at_runtime_but_uncompiled() < 0) {
         Py_DECREF(module);
         return NULL;
     }
+    pg_RegisterSIMDDispatch(_surf_simd_dispatch);
     Py_INCREF(&pgSurface_Type);
     if (PyModule_AddObject(module, "SurfaceType",
                            (PyObject *)&pgSurface_Type)) {
@@ -3950,11 +8675,49 @@ MODINIT_DEFINE(surface)
         return NULL;
     }
 
+    Py_INCREF(&pgBlitBatch_Type);
+    if (PyModule_AddObject(module, "BlitBatch",
+                           (PyObject *)&pgBlitBatch_Type)) {
+        Py_DECREF(&pgBlitBatch_Type);
+        Py_DECREF(module);
+        return NULL;
+    }
+
+    Py_INCREF(&pgSurfaceSnapshot_Type);
+    if (PyModule_AddObject(module, "SurfaceSnapshot",
+                           (PyObject *)&pgSurfaceSnapshot_Type)) {
+        Py_DECREF(&pgSurfaceSnapshot_Type);
+        Py_DECREF(module);
+        return NULL;
+    }
+
+    Py_INCREF(&pgBlendMode_Type);
+    if (PyModule_AddObject(module, "BlendMode",
+                           (PyObject *)&pgBlendMode_Type)) {
+        Py_DECREF(&pgBlendMode_Type);
+        Py_DECREF(module);
+        return NULL;
+    }
+
+    Py_INCREF(&pgSurfaceView_Type);
+    if (PyModule_AddObject(module, "SurfaceView",
+                           (PyObject *)&pgSurfaceView_Type)) {
+        Py_DECREF(&pgSurfaceView_Type);
+        Py_DECREF(module);
+        return NULL;
+    }
+
     /* export the c api */
     c_api[0] = &pgSurface_Type;
     c_api[1] = pgSurface_New2;
     c_api[2] = pgSurface_Blit;
     c_api[3] = pgSurface_SetSurface;
+    c_api[4] = pgSurface_AddDirtyRect;
+    c_api[5] = pgSurface_GetDirtyRects;
+    c_api[6] = pgSurface_GetVersion;
+    c_api[7] = pgSurface_NewWithOrigin;
+    c_api[8] = pgSurface_CreatePooled;
+    c_api[9] = _surf_run_bands;
     apiobj = encapsulate_api(c_api, "surface");
     if (PyModule_AddObject(module, PYGAMEAPI_LOCAL_ENTRY, apiobj)) {
         Py_XDECREF(apiobj);
@@ -53,6 +53,22 @@
 #define PYGAME_BLEND_PREMULTIPLIED 0x11
 #define PYGAME_BLEND_ALPHA_SDL2 0x12
 
+/* Custom blend equations made by pygame.BlendMode. The low 24 bits hold the
+ * SDL_BLENDFACTOR_* and SDL_BLENDOPERATION_* values of the colour and alpha
+ * equations, four bits each, in the order of SDL_ComposeCustomBlendMode. */
+#define PYGAME_BLEND_CUSTOM 0x40000000
+#define PYGAME_BLEND_CUSTOM_MASK 0x00FFFFFF
+#define PG_BLEND_CUSTOM(csrc, cdst, cop, asrc, adst, aop)                   \
+    (PYGAME_BLEND_CUSTOM | (csrc) | ((cdst) << 4) | ((cop) << 8) |         \
+     ((asrc) << 12) | ((adst) << 16) | ((aop) << 20))
+#define PG_BLEND_CUSTOM_FIELD(mode, n) (((mode) >> (4 * (n))) & 0xF)
+#define PG_BLEND_CUSTOM_CSRC(mode) PG_BLEND_CUSTOM_FIELD(mode, 0)
+#define PG_BLEND_CUSTOM_CDST(mode) PG_BLEND_CUSTOM_FIELD(mode, 1)
+#define PG_BLEND_CUSTOM_COP(mode) PG_BLEND_CUSTOM_FIELD(mode, 2)
+#define PG_BLEND_CUSTOM_ASRC(mode) PG_BLEND_CUSTOM_FIELD(mode, 3)
+#define PG_BLEND_CUSTOM_ADST(mode) PG_BLEND_CUSTOM_FIELD(mode, 4)
+#define PG_BLEND_CUSTOM_AOP(mode) PG_BLEND_CUSTOM_FIELD(mode, 5)
+
 #if SDL_BYTEORDER == SDL_LIL_ENDIAN
 #define GET_PIXEL_24(b) (b[0] + (b[1] << 8) + (b[2] << 16))
 #else
@@ -169,6 +185,12 @@
             } while (--n > 0);         \
     }
 
+/* Whether rows of pixels starting at p, pitch bytes apart, all start at a
+ * multiple of align bytes, so the SIMD kernels can use aligned loads and
+ * stores. Surfaces get such rows from pygame.surface.set_row_alignment(). */
+#define PG_ROWS_ALIGNED(p, pitch, align) \
+    (!(((uintptr_t)(p) | (uintptr_t)(pitch)) & ((uintptr_t)(align) - 1)))
+
 /* Used in the srcbpp == dstbpp == 1 blend functions */
 #define REPEAT_3(code) \
     code;              \
@@ -341,6 +363,15 @@ int
 surface_fill_blend(SDL_Surface *surface, SDL_Rect *rect, Uint32 color,
                    int blendargs);
 
+int
+surface_fill_simd_dispatch(PyObject *dispatch);
+
+int
+surface_alpha_bounds(SDL_Surface *surf, int min_alpha, SDL_Rect *rect);
+
+int
+surface_alpha_bounds_simd_dispatch(PyObject *dispatch);
+
 void
 surface_respect_clip_rect(SDL_Surface *surface, SDL_Rect *rect);
 
@@ -352,9 +383,137 @@ int
 pygame_Blit(SDL_Surface *src, SDL_Rect *srcrect, SDL_Surface *dst,
             SDL_Rect *dstrect, int blend_flags);
 
+/* Runs of transparent and opaque pixels in the rows of a surface of 16 bits
+ * or more, pygame's run-length encoding of it, which blits skip and copy
+ * instead of blending them. Pixels are told apart by the colorkey when the
+ * surface is keyed and by their alpha otherwise. Each run holds its
+ * PG_SPAN_* kind in the top 2 bits, PG_SPAN_ZERO if all its pixels are 0,
+ * which leaves the destination alone in the additive blend modes, and its
+ * length in the others. The runs of row y are runs[rows[y]] up to
+ * runs[rows[y + 1]]. Runs too short to be worth it are counted as mixed. */
+#define PG_SPAN_MIXED 0
+#define PG_SPAN_TRANSPARENT 1
+#define PG_SPAN_OPAQUE 2
+#define PG_SPAN_ZERO 0x20000000
+#define PG_SPAN_KIND(run) ((run) >> 30)
+#define PG_SPAN_LENGTH(run) ((int)((run) & 0x1FFFFFFF))
+
+typedef struct pg_AlphaSpans {
+    int w, h;
+    Uint64 version;  /* of the surface when the spans were found */
+    int keyed;       /* found with the colorkey rather than the alpha */
+    Uint32 colorkey;
+    Sint64 skipped;  /* pixels in transparent and opaque runs */
+    Sint64 zeros;    /* pixels in PG_SPAN_ZERO runs */
+    int *rows;
+    Uint32 *runs;
+} pg_AlphaSpans;
+
+/* Returns NULL with an SDL error if surf has fewer than 16 bits per pixel
+ * or memory runs out. surf must be locked if needed. */
+pg_AlphaSpans *
+pg_alpha_spans_new(SDL_Surface *surf);
+
+void
+pg_alpha_spans_free(pg_AlphaSpans *spans);
+
+/* Whether the spans of surf would be found with its colorkey, which is
+ * put in key. Keyed surfaces with blended per pixel alpha use the alpha,
+ * like their blits do. */
+int
+pg_alpha_spans_keyed(SDL_Surface *surf, Uint32 *key);
+
+/* pygame_Blit() using the alpha spans of src, which may be NULL */
+int
+pygame_BlitSpans(SDL_Surface *src, SDL_Rect *srcrect, SDL_Surface *dst,
+                 SDL_Rect *dstrect, int blend_flags,
+                 const pg_AlphaSpans *spans);
+
+/* A queue of blits onto one surface, which are run later by the blit
+ * threads (see pg_set_blit_threads()), several at once where their
+ * destination rects don't overlap. Blits that overlap run in the order
+ * they were queued. The queued blits read the source pixels when they
+ * run, so the sources must not change until the queue is flushed. */
+typedef struct pg_BlitQueue pg_BlitQueue;
+
+/* Returns NULL if memory runs out */
+pg_BlitQueue *
+pg_blit_queue_new(void);
+
+/* Runs the queued blits, releasing the GIL if the caller holds it. queue
+ * may be NULL. */
+void
+pg_blit_queue_flush(pg_BlitQueue *queue);
+
+/* Flushes the queue and frees it */
+void
+pg_blit_queue_free(pg_BlitQueue *queue);
+
+/* The function a blit runs on the pixels, see pg_blit_kernel_name() */
+struct pg_BlitInfo;
+typedef void (*pg_BlitKernel)(struct pg_BlitInfo *info);
+
+/* pygame_BlitSpans() queueing the kernel in queue, if it isn't NULL. Blits
+ * that can't wait, like ones reading the destination pixels, flush the
+ * queue and run right away. If kernel isn't NULL it is set to the kernel
+ * that was picked, or NULL if there was none. */
+int
+pygame_BlitQueued(SDL_Surface *src, SDL_Rect *srcrect, SDL_Surface *dst,
+                  SDL_Rect *dstrect, int blend_flags,
+                  const pg_AlphaSpans *spans, pg_BlitQueue *queue,
+                  pg_BlitKernel *kernel);
+
+/* Where pygame_BlitTransformed() puts the source: it is flipped, scaled
+ * and rotated counterclockwise by angle degrees around its point origin,
+ * which lands on pos of the destination. smooth picks bilinear sampling,
+ * which is only done for 32 bit sources without a colorkey. */
+typedef struct {
+    double pos_x, pos_y;
+    double origin_x, origin_y;
+    double angle;
+    double scale_x, scale_y;
+    int flip_x, flip_y;
+    int smooth;
+} pg_BlitTransform;
+
+/* Blits src transformed by xf, sampling it while blending instead of
+ * making a transformed copy. affected is set to the clipped destination
+ * area. */
+int
+pygame_BlitTransformed(SDL_Surface *src, SDL_Surface *dst,
+                       const pg_BlitTransform *xf, int blend_flags,
+                       SDL_Rect *affected);
+
 int
 premul_surf_color_by_alpha(SDL_Surface *src, SDL_Surface *dst);
 
+int
+pg_set_blit_threads(int num_threads);
+
+int
+pg_get_blit_threads(void);
+
+void
+pg_quit_blit_threads(void);
+
+#ifdef PYGAMEAPI_SURFACE_INTERNAL
+/* Runs func(data, band) for each band from 0 to nbands - 1, on up to
+ * nbands threads of the blit pool including the calling one. Returns once
+ * they are all done, releasing the GIL meanwhile if the caller holds it. If
+ * the pool is busy with another call the bands all run on this thread.
+ * Other modules get it from the surface C API. */
+void
+pg_run_bands(pg_BandFunc func, void *data, int nbands);
+#endif /* PYGAMEAPI_SURFACE_INTERNAL */
+
+/* The name of a kernel pygame_BlitQueued() passed back, or NULL if it isn't
+ * one of pygame's own. simd is set to whether it is a SIMD kernel. */
+const char *
+pg_blit_kernel_name(pg_BlitKernel kernel, int *simd);
+
+int
+pg_blit_simd_dispatch(PyObject *dispatch);
+
 int
 pg_warn_simd_at_runtime_but_uncompiled();
 
@@ -20,6 +20,7 @@
 #define NO_PYGAME_C_API
 
 #include "simd_fill.h"
+#include "simd_565.h"
 
 /*
  * Changes SDL_Rect to respect any clipping rect defined on the surface.
@@ -849,13 +850,92 @@ surface_fill_blend_rgba_max(SDL_Surface *surface, SDL_Rect *rect, Uint32 color)
     return result;
 }
 
+typedef int (*pg_FillBlendFunc)(SDL_Surface *, SDL_Rect *, Uint32);
+
+/* The kernels of each blend mode: the generic one, the SSE2/NEON and
+ * AVX2 ones for 32 bit surfaces and the SSE2/NEON one for RGB565 and
+ * BGR565 surfaces */
+typedef struct {
+    int blendargs;
+    pg_FillBlendFunc generic;
+    pg_FillBlendFunc sse2;
+    pg_FillBlendFunc avx2;
+    pg_FillBlendFunc sse2_565;
+} pg_FillBlendKernels;
+
+#if !defined(__EMSCRIPTEN__) && SDL_BYTEORDER == SDL_LIL_ENDIAN
+#define FILL_BLEND_SIMD 1
+#define FILL_BLEND_KERNELS(FLAG, NAME)                                  \
+    {FLAG, surface_fill_blend_##NAME, surface_fill_blend_##NAME##_sse2, \
+     surface_fill_blend_##NAME##_avx2, surface_fill_blend_##NAME##_565_sse2}
+#else
+#define FILL_BLEND_SIMD 0
+#define FILL_BLEND_KERNELS(FLAG, NAME) \
+    {FLAG, surface_fill_blend_##NAME, NULL, NULL, NULL}
+#endif /* !defined(__EMSCRIPTEN__) && SDL_BYTEORDER == SDL_LIL_ENDIAN */
+
+static const pg_FillBlendKernels fill_blend_kernels[] = {
+    FILL_BLEND_KERNELS(PYGAME_BLEND_ADD, add),
+    FILL_BLEND_KERNELS(PYGAME_BLEND_SUB, sub),
+    FILL_BLEND_KERNELS(PYGAME_BLEND_MULT, mult),
+    FILL_BLEND_KERNELS(PYGAME_BLEND_MIN, min),
+    FILL_BLEND_KERNELS(PYGAME_BLEND_MAX, max),
+    FILL_BLEND_KERNELS(PYGAME_BLEND_RGBA_ADD, rgba_add),
+    FILL_BLEND_KERNELS(PYGAME_BLEND_RGBA_SUB, rgba_sub),
+    FILL_BLEND_KERNELS(PYGAME_BLEND_RGBA_MULT, rgba_mult),
+    FILL_BLEND_KERNELS(PYGAME_BLEND_RGBA_MIN, rgba_min),
+    FILL_BLEND_KERNELS(PYGAME_BLEND_RGBA_MAX, rgba_max),
+};
+
+/* Picks the fastest kernel this CPU runs for the blend mode, or NULL */
+static pg_FillBlendFunc
+surface_fill_blend_kernel(SDL_Surface *surface, int blendargs)
+{
+    const pg_FillBlendKernels *kernels = NULL;
+    size_t i;
+
+    for (i = 0; i < SDL_arraysize(fill_blend_kernels); ++i) {
+        if (fill_blend_kernels[i].blendargs == blendargs) {
+            kernels = fill_blend_kernels + i;
+            break;
+        }
+    }
+    if (!kernels) {
+        return NULL;
+    }
+#if FILL_BLEND_SIMD
+    if (PG_SURF_BytesPerPixel(surface) == 4) {
+        if (_pg_has_avx2()) {
+            return kernels->avx2;
+        }
+#if PG_ENABLE_SSE_NEON
+        if (_pg_HasSSE_NEON()) {
+            return kernels->sse2;
+        }
+#endif /* PG_ENABLE_SSE_NEON */
+    }
+#if PG_ENABLE_SSE_NEON
+    else if (PG_SURF_BytesPerPixel(surface) == 2 && _pg_HasSSE_NEON() &&
+             pg_has_simd_565_format(surface->format)) {
+        return kernels->sse2_565;
+    }
+#endif /* PG_ENABLE_SSE_NEON */
+#endif /* FILL_BLEND_SIMD */
+    return kernels->generic;
+}
+
 int
 surface_fill_blend(SDL_Surface *surface, SDL_Rect *rect, Uint32 color,
                    int blendargs)
 {
-    int result = -1;
+    pg_FillBlendFunc kernel = surface_fill_blend_kernel(surface, blendargs);
+    int result;
     int locked = 0;
 
+    if (!kernel) {
+        return SDL_SetError("invalid blend flag for this operation");
+    }
+
     surface_respect_clip_rect(surface, rect);
 
     /* Lock the surface, if needed */
@@ -865,229 +945,157 @@ surface_fill_blend(SDL_Surface *surface, SDL_Rect *rect, Uint32 color,
         locked = 1;
     }
 
-    switch (blendargs) {
-        case PYGAME_BLEND_ADD: {
-#if !defined(__EMSCRIPTEN__)
-#if SDL_BYTEORDER == SDL_LIL_ENDIAN
-            if (PG_SURF_BytesPerPixel(surface) == 4) {
-                if (_pg_has_avx2()) {
-                    result = surface_fill_blend_add_avx2(surface, rect, color);
-                    break;
-                }
-#if PG_ENABLE_SSE_NEON
-                if (_pg_HasSSE_NEON()) {
-                    result = surface_fill_blend_add_sse2(surface, rect, color);
-                    break;
-                }
-#endif /* PG_ENABLE_SSE_NEON */
-            }
-#endif /* SDL_BYTEORDER == SDL_LIL_ENDIAN */
-#endif /* __EMSCRIPTEN__ */
-            result = surface_fill_blend_add(surface, rect, color);
-            break;
-        }
-        case PYGAME_BLEND_SUB: {
-#if !defined(__EMSCRIPTEN__)
-#if SDL_BYTEORDER == SDL_LIL_ENDIAN
-            if (PG_SURF_BytesPerPixel(surface) == 4) {
-                if (_pg_has_avx2()) {
-                    result = surface_fill_blend_sub_avx2(surface, rect, color);
-                    break;
-                }
-#if PG_ENABLE_SSE_NEON
-                if (_pg_HasSSE_NEON()) {
-                    result = surface_fill_blend_sub_sse2(surface, rect, color);
-                    break;
-                }
-#endif /* PG_ENABLE_SSE_NEON */
-            }
-#endif /* SDL_BYTEORDER == SDL_LIL_ENDIAN */
-#endif /* __EMSCRIPTEN__ */
-            result = surface_fill_blend_sub(surface, rect, color);
-            break;
-        }
-        case PYGAME_BLEND_MULT: {
-#if !defined(__EMSCRIPTEN__)
-#if SDL_BYTEORDER == SDL_LIL_ENDIAN
-            if (PG_SURF_BytesPerPixel(surface) == 4) {
-                if (_pg_has_avx2()) {
-                    result =
-                        surface_fill_blend_mult_avx2(surface, rect, color);
-                    break;
-                }
-#if PG_ENABLE_SSE_NEON
-                if (_pg_HasSSE_NEON()) {
-                    result =
-                        surface_fill_blend_mult_sse2(surface, rect, color);
-                    break;
-                }
-#endif /* PG_ENABLE_SSE_NEON */
-            }
-#endif /* SDL_BYTEORDER == SDL_LIL_ENDIAN */
-#endif /* __EMSCRIPTEN__ */
-            result = surface_fill_blend_mult(surface, rect, color);
-            break;
-        }
-        case PYGAME_BLEND_MIN: {
-#if !defined(__EMSCRIPTEN__)
-#if SDL_BYTEORDER == SDL_LIL_ENDIAN
-            if (PG_SURF_BytesPerPixel(surface) == 4) {
-                if (_pg_has_avx2()) {
-                    result = surface_fill_blend_min_avx2(surface, rect, color);
-                    break;
-                }
-#if PG_ENABLE_SSE_NEON
-                if (_pg_HasSSE_NEON()) {
-                    result = surface_fill_blend_min_sse2(surface, rect, color);
-                    break;
-                }
-#endif /* PG_ENABLE_SSE_NEON */
-            }
-#endif /* SDL_BYTEORDER == SDL_LIL_ENDIAN */
-#endif /* __EMSCRIPTEN__ */
-            result = surface_fill_blend_min(surface, rect, color);
-            break;
-        }
-        case PYGAME_BLEND_MAX: {
-#if !defined(__EMSCRIPTEN__)
-#if SDL_BYTEORDER == SDL_LIL_ENDIAN
-            if (PG_SURF_BytesPerPixel(surface) == 4) {
-                if (_pg_has_avx2()) {
-                    result = surface_fill_blend_max_avx2(surface, rect, color);
-                    break;
-                }
-#if PG_ENABLE_SSE_NEON
-                if (_pg_HasSSE_NEON()) {
-                    result = surface_fill_blend_max_sse2(surface, rect, color);
-                    break;
-                }
-#endif /* PG_ENABLE_SSE_NEON */
-            }
-#endif /* SDL_BYTEORDER == SDL_LIL_ENDIAN */
-#endif /* __EMSCRIPTEN__ */
-            result = surface_fill_blend_max(surface, rect, color);
-            break;
-        }
+    result = kernel(surface, rect, color);
 
-        case PYGAME_BLEND_RGBA_ADD: {
-#if !defined(__EMSCRIPTEN__)
-#if SDL_BYTEORDER == SDL_LIL_ENDIAN
-            if (PG_SURF_BytesPerPixel(surface) == 4) {
-                if (_pg_has_avx2()) {
-                    result =
-                        surface_fill_blend_rgba_add_avx2(surface, rect, color);
-                    break;
-                }
-#if PG_ENABLE_SSE_NEON
-                if (_pg_HasSSE_NEON()) {
-                    result =
-                        surface_fill_blend_rgba_add_sse2(surface, rect, color);
-                    break;
-                }
-#endif /* PG_ENABLE_SSE_NEON */
-            }
-#endif /* SDL_BYTEORDER == SDL_LIL_ENDIAN */
-#endif /* __EMSCRIPTEN__ */
-            result = surface_fill_blend_rgba_add(surface, rect, color);
-            break;
-        }
-        case PYGAME_BLEND_RGBA_SUB: {
-#if !defined(__EMSCRIPTEN__)
-#if SDL_BYTEORDER == SDL_LIL_ENDIAN
-            if (PG_SURF_BytesPerPixel(surface) == 4) {
-                if (_pg_has_avx2()) {
-                    result =
-                        surface_fill_blend_rgba_sub_avx2(surface, rect, color);
-                    break;
-                }
-#if PG_ENABLE_SSE_NEON
-                if (_pg_HasSSE_NEON()) {
-                    result =
-                        surface_fill_blend_rgba_sub_sse2(surface, rect, color);
-                    break;
-                }
-#endif /* PG_ENABLE_SSE_NEON */
-            }
-#endif /* SDL_BYTEORDER == SDL_LIL_ENDIAN */
-#endif /* __EMSCRIPTEN__ */
-            result = surface_fill_blend_rgba_sub(surface, rect, color);
-            break;
-        }
-        case PYGAME_BLEND_RGBA_MULT: {
-#if !defined(__EMSCRIPTEN__)
-#if SDL_BYTEORDER == SDL_LIL_ENDIAN
-            if (PG_SURF_BytesPerPixel(surface) == 4) {
-                if (_pg_has_avx2()) {
-                    result = surface_fill_blend_rgba_mult_avx2(surface, rect,
-                                                               color);
-                    break;
-                }
+    if (locked) {
+        SDL_UnlockSurface(surface);
+    }
+    return result;
+}
+
+/* Adds the backend of the 32 bit blend fills for
+ * pygame.system.get_simd_dispatch() */
+int
+surface_fill_simd_dispatch(PyObject *dispatch)
+{
+    int has_avx2 = 0, has_sse2_neon = 0;
+
+#if FILL_BLEND_SIMD
+    has_avx2 = _pg_has_avx2();
 #if PG_ENABLE_SSE_NEON
-                if (_pg_HasSSE_NEON()) {
-                    result = surface_fill_blend_rgba_mult_sse2(surface, rect,
-                                                               color);
-                    break;
-                }
+    has_sse2_neon = _pg_HasSSE_NEON();
 #endif /* PG_ENABLE_SSE_NEON */
-            }
-#endif /* SDL_BYTEORDER == SDL_LIL_ENDIAN */
-#endif /* __EMSCRIPTEN__ */
-            result = surface_fill_blend_rgba_mult(surface, rect, color);
-            break;
+#endif /* FILL_BLEND_SIMD */
+    return pg_simd_report(dispatch, "fill",
+                          pg_simd_backend_name(has_avx2, has_sse2_neon));
+}
+
+typedef int (*pg_AlphaScanFunc)(const Uint32 *row, int n, int ashift,
+                                int min_alpha);
+
+/* The generic alpha scans, see simd_fill.h */
+static int
+surface_alpha_first(const Uint32 *row, int n, int ashift, int min_alpha)
+{
+    int i;
+
+    for (i = 0; i < n; i++) {
+        if ((int)(row[i] >> ashift & 0xFF) >= min_alpha) {
+            return i;
         }
-        case PYGAME_BLEND_RGBA_MIN: {
-#if !defined(__EMSCRIPTEN__)
-#if SDL_BYTEORDER == SDL_LIL_ENDIAN
-            if (PG_SURF_BytesPerPixel(surface) == 4) {
-                if (_pg_has_avx2()) {
-                    result =
-                        surface_fill_blend_rgba_min_avx2(surface, rect, color);
-                    break;
-                }
-#if PG_ENABLE_SSE_NEON
-                if (_pg_HasSSE_NEON()) {
-                    result =
-                        surface_fill_blend_rgba_min_sse2(surface, rect, color);
-                    break;
-                }
-#endif /* PG_ENABLE_SSE_NEON */
-            }
-#endif /* SDL_BYTEORDER == SDL_LIL_ENDIAN */
-#endif /* __EMSCRIPTEN__ */
-            result = surface_fill_blend_rgba_min(surface, rect, color);
-            break;
+    }
+    return n;
+}
+
+static int
+surface_alpha_last(const Uint32 *row, int n, int ashift, int min_alpha)
+{
+    int i = n;
+
+    while (i-- > 0) {
+        if ((int)(row[i] >> ashift & 0xFF) >= min_alpha) {
+            return i;
         }
-        case PYGAME_BLEND_RGBA_MAX: {
+    }
+    return -1;
+}
+
+/* The fastest alpha scans the CPU supports */
+static void
+surface_alpha_scans(pg_AlphaScanFunc *first, pg_AlphaScanFunc *last)
+{
+    *first = surface_alpha_first;
+    *last = surface_alpha_last;
 #if !defined(__EMSCRIPTEN__)
-#if SDL_BYTEORDER == SDL_LIL_ENDIAN
-            if (PG_SURF_BytesPerPixel(surface) == 4) {
-                if (_pg_has_avx2()) {
-                    result =
-                        surface_fill_blend_rgba_max_avx2(surface, rect, color);
-                    break;
-                }
+    if (_pg_has_avx2()) {
+        *first = surface_alpha_first_avx2;
+        *last = surface_alpha_last_avx2;
+    }
 #if PG_ENABLE_SSE_NEON
-                if (_pg_HasSSE_NEON()) {
-                    result =
-                        surface_fill_blend_rgba_max_sse2(surface, rect, color);
-                    break;
-                }
+    else if (_pg_HasSSE_NEON()) {
+        *first = surface_alpha_first_sse2;
+        *last = surface_alpha_last_sse2;
+    }
 #endif /* PG_ENABLE_SSE_NEON */
-            }
-#endif /* SDL_BYTEORDER == SDL_LIL_ENDIAN */
-#endif /* __EMSCRIPTEN__ */
-            result = surface_fill_blend_rgba_max(surface, rect, color);
-            break;
-        }
+#endif /* !defined(__EMSCRIPTEN__) */
+}
 
-        default: {
-            result = SDL_SetError("invalid blend flag for this operation");
+/*
+ * The bounding rect of the pixels of a locked 32 bit surface with an 8 bit
+ * alpha channel whose alpha is at least min_alpha, or an empty rect at
+ * (0, 0) if there are none. Scans whole rows: the bottom and top edges stop
+ * at the first row with a match, and the rows between them are only
+ * searched left of the left edge and right of the right edge found so far.
+ * Returns 0 without touching rect for surfaces of other formats, or with a
+ * colorkey. Doesn't need the GIL.
+ */
+int
+surface_alpha_bounds(SDL_Surface *surf, int min_alpha, SDL_Rect *rect)
+{
+    SDL_PixelFormat *format = surf->format;
+    pg_AlphaScanFunc first, last;
+    const Uint8 *pixels = (const Uint8 *)surf->pixels;
+    const Uint32 *row;
+    int x, y, min_x, max_x, min_y, max_y;
+
+    if (PG_FORMAT_BytesPerPixel(format) != 4 || !format->Amask ||
+        format->Amask != (Uint32)0xFF << format->Ashift ||
+        SDL_HasColorKey(surf)) {
+        return 0;
+    }
+    surface_alpha_scans(&first, &last);
+
+#define ALPHA_ROW(y) ((const Uint32 *)(pixels + (Sint64)(y)*surf->pitch))
+    for (y = surf->h - 1; y >= 0; --y) {
+        if (first(ALPHA_ROW(y), surf->w, format->Ashift, min_alpha) <
+            surf->w) {
             break;
         }
     }
+    if (y < 0) {
+        rect->x = rect->y = rect->w = rect->h = 0;
+        return 1;
+    }
+    max_y = y + 1;
+    min_y = 0;
+    while (first(ALPHA_ROW(min_y), surf->w, format->Ashift, min_alpha) ==
+           surf->w) {
+        ++min_y;
+    }
 
-    if (locked) {
-        SDL_UnlockSurface(surface);
+    min_x = surf->w;
+    max_x = 0;
+    for (y = min_y; y < max_y && (min_x > 0 || max_x < surf->w); ++y) {
+        row = ALPHA_ROW(y);
+        x = first(row, min_x, format->Ashift, min_alpha);
+        min_x = MIN(min_x, x);
+        x = last(row + max_x, surf->w - max_x, format->Ashift, min_alpha);
+        if (x >= 0) {
+            max_x += x + 1;
+        }
     }
-    return result;
+#undef ALPHA_ROW
+
+    rect->x = min_x;
+    rect->y = min_y;
+    rect->w = max_x - min_x;
+    rect->h = max_y - min_y;
+    return 1;
+}
+
+/* Adds the backend of surface_alpha_bounds for
+ * pygame.system.get_simd_dispatch() */
+int
+surface_alpha_bounds_simd_dispatch(PyObject *dispatch)
+{
+    int has_avx2 = 0, has_sse2_neon = 0;
+
+#if !defined(__EMSCRIPTEN__)
+    has_avx2 = _pg_has_avx2();
+#if PG_ENABLE_SSE_NEON
+    has_sse2_neon = _pg_HasSSE_NEON();
+#endif /* PG_ENABLE_SSE_NEON */
+#endif /* !defined(__EMSCRIPTEN__) */
+    return pg_simd_report(dispatch, "bounding_rect",
+                          pg_simd_backend_name(has_avx2, has_sse2_neon));
 }
@@ -39,6 +39,9 @@ pgSurface_LockBy(pgSurfaceObject *, PyObject *);
 static int
 pgSurface_UnlockBy(pgSurfaceObject *, PyObject *);
 
+static int
+_unlock_by(pgSurfaceObject *, PyObject *);
+
 static void
 _lifelock_dealloc(PyObject *);
 
@@ -46,10 +49,19 @@ static void
 pgSurface_Prep(pgSurfaceObject *surfobj)
 {
     struct pgSubSurface_Data *data = ((pgSurfaceObject *)surfobj)->subsurface;
+
+    /* the pixels are about to be read */
+    pgSurface_Sync(surfobj);
     if (data != NULL) {
         SDL_Surface *surf = pgSurface_AsSurface(surfobj);
         SDL_Surface *owner = pgSurface_AsSurface(data->owner);
-        pgSurface_LockBy((pgSurfaceObject *)data->owner, (PyObject *)surfobj);
+        pgSurfaceObject *ownerobj = (pgSurfaceObject *)data->owner;
+        Uint64 version = ownerobj->version;
+
+        pgSurface_LockBy(ownerobj, (PyObject *)surfobj);
+        /* Locking on behalf of a subsurface is not a write to the owner,
+         * writes through the subsurface are reported on their own */
+        ownerobj->version = version;
         surf->pixels = ((char *)owner->pixels) + data->pixeloffset;
     }
 }
@@ -59,8 +71,11 @@ pgSurface_Unprep(pgSurfaceObject *surfobj)
 {
     struct pgSubSurface_Data *data = ((pgSurfaceObject *)surfobj)->subsurface;
     if (data != NULL) {
-        pgSurface_UnlockBy((pgSurfaceObject *)data->owner,
-                           (PyObject *)surfobj);
+        pgSurfaceObject *ownerobj = (pgSurfaceObject *)data->owner;
+        Uint64 version = ownerobj->version;
+
+        pgSurface_UnlockBy(ownerobj, (PyObject *)surfobj);
+        ownerobj->version = version;
     }
 }
 
@@ -76,12 +91,64 @@ pgSurface_Unlock(pgSurfaceObject *surfobj)
     return pgSurface_UnlockBy(surfobj, (PyObject *)surfobj);
 }
 
+/* Locks a surface holds on itself are only counted, the draw functions and
+ * Surface methods take and release them far too often to create a weak
+ * reference each time. Other objects go in the locklist, so get_locks() can
+ * tell who holds them and locks of objects that died can be released. */
 static int
-pgSurface_LockBy(pgSurfaceObject *surfobj, PyObject *lockobj)
+_lock_self(pgSurfaceObject *surf)
+{
+    if (surf->subsurface != NULL) {
+        pgSurface_Prep(surf);
+    }
+    if (SDL_LockSurface(surf->surf) == -1) {
+        if (surf->subsurface != NULL) {
+            pgSurface_Unprep(surf);
+        }
+        PyErr_SetString(PyExc_RuntimeError, "error locking surface");
+        return 0;
+    }
+    surf->selflocks++;
+    return 1;
+}
+
+static int
+_unlock_self(pgSurfaceObject *surf)
+{
+    if (surf->selflocks == 0) {
+        return 1;
+    }
+    surf->selflocks--;
+    if (surf->surf != NULL) {
+        SDL_UnlockSurface(surf->surf);
+    }
+    if (surf->subsurface != NULL) {
+        pgSurface_Unprep(surf);
+    }
+    /* Release the locks of lock objects that died like unlocking by any
+     * other object does, None matches their cleared references only */
+    if (surf->locklist != NULL && PyList_GET_SIZE(surf->locklist) > 0) {
+        return _unlock_by(surf, Py_None);
+    }
+    return 1;
+}
+
+/* _lock_by() and _unlock_by() run in a critical section on the surface,
+ * which is its mutex in free-threaded builds, so that threads sharing a
+ * Surface keep its lock counts, locklist and version consistent */
+static int
+_lock_by(pgSurfaceObject *surfobj, PyObject *lockobj)
 {
     PyObject *ref;
     pgSurfaceObject *surf = (pgSurfaceObject *)surfobj;
 
+    /* whoever locks may write, copy-on-write pixels get copied first */
+    if (!pgSurface_Unshare(surf)) {
+        return 0;
+    }
+    if (lockobj == (PyObject *)surfobj) {
+        return _lock_self(surf);
+    }
     if (surf->locklist == NULL) {
         surf->locklist = PyList_New(0);
         if (surf->locklist == NULL) {
@@ -109,16 +176,24 @@ pgSurface_LockBy(pgSurfaceObject *surfobj, PyObject *lockobj)
         PyErr_SetString(PyExc_RuntimeError, "error locking surface");
         return 0;
     }
+    /* Other objects holding a lock (PixelArray, arrays and buffer views)
+     * may write to the pixels, so the version is bumped both when they take
+     * the lock and when they release it. Surface methods lock the surface by
+     * itself and report their writes with pgSurface_AddDirtyRect. */
+    surf->version++;
     return 1;
 }
 
 static int
-pgSurface_UnlockBy(pgSurfaceObject *surfobj, PyObject *lockobj)
+_unlock_by(pgSurfaceObject *surfobj, PyObject *lockobj)
 {
     pgSurfaceObject *surf = (pgSurfaceObject *)surfobj;
     int found = 0;
     int noerror = 1;
 
+    if (lockobj == (PyObject *)surfobj) {
+        return _unlock_self(surf);
+    }
     if (surf->locklist != NULL) {
         PyObject *item, *ref;
         Py_ssize_t len = PyList_Size(surf->locklist);
@@ -154,6 +229,7 @@ pgSurface_UnlockBy(pgSurfaceObject *surfobj, PyObject *lockobj)
     if (!found) {
         return noerror;
     }
+    surf->version++;
 
     /* Release all found locks. */
     while (found > 0) {
@@ -169,6 +245,28 @@ pgSurface_UnlockBy(pgSurfaceObject *surfobj, PyObject *lockobj)
     return noerror;
 }
 
+static int
+pgSurface_LockBy(pgSurfaceObject *surfobj, PyObject *lockobj)
+{
+    int result;
+
+    Py_BEGIN_CRITICAL_SECTION(surfobj);
+    result = _lock_by(surfobj, lockobj);
+    Py_END_CRITICAL_SECTION();
+    return result;
+}
+
+static int
+pgSurface_UnlockBy(pgSurfaceObject *surfobj, PyObject *lockobj)
+{
+    int result;
+
+    Py_BEGIN_CRITICAL_SECTION(surfobj);
+    result = _unlock_by(surfobj, lockobj);
+    Py_END_CRITICAL_SECTION();
+    return result;
+}
+
 static PyTypeObject pgLifetimeLock_Type = {
     PyVarObject_HEAD_INIT(NULL, 0).tp_name = "pygame.surflock.SurfLifeLock",
     .tp_basicsize = sizeof(pgLifetimeLockObject),
@@ -243,6 +341,10 @@ MODINIT_DEFINE(surflock)
     if (module == NULL) {
         return NULL;
     }
+    if (PG_GIL_NOT_USED(module)) {
+        Py_DECREF(module);
+        return NULL;
+    }
 
     /* export the c api */
     c_api[0] = &pgLifetimeLock_Type;
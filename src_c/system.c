@@ -229,6 +229,248 @@ pg_system_get_power_state(PyObject *self, PyObject *_null)
     return PyObject_Call(PowerState_class, return_args, return_kwargs);
 }
 
+static PyObject *
+pg_system_get_freelist_stats(PyObject *self, PyObject *_null)
+{
+    static const char *const modules[] = {"pygame.math", "pygame.rect", NULL};
+    PyObject *stats, *module, *module_stats;
+    int i, result;
+
+    stats = PyDict_New();
+    if (!stats) {
+        return NULL;
+    }
+
+    for (i = 0; modules[i]; i++) {
+        module = PyImport_ImportModule(modules[i]);
+        if (!module) {
+            goto error;
+        }
+        module_stats = PyObject_CallMethod(module, "_freelist_stats", NULL);
+        Py_DECREF(module);
+        if (!module_stats) {
+            goto error;
+        }
+        result = PyDict_Update(stats, module_stats);
+        Py_DECREF(module_stats);
+        if (result) {
+            goto error;
+        }
+    }
+
+    return stats;
+
+error:
+    Py_DECREF(stats);
+    return NULL;
+}
+
+static PyObject *
+pg_system_get_perf_counters(PyObject *self, PyObject *_null)
+{
+    PyObject *counters = PyDict_New();
+#ifndef PG_NO_PERF_COUNTERS
+    static const char *const names[PG_PERF_NUM_COUNTERS] = {
+        "blit", "fill", "transform", "text", "event", "flip"};
+    const Uint64 freq = SDL_GetPerformanceFrequency();
+    PyObject *counter;
+    pgPerfCounter copy;
+    Uint64 ticks;
+    int i, result;
+
+    if (!counters) {
+        return NULL;
+    }
+
+    for (i = 0; i < PG_PERF_NUM_COUNTERS; i++) {
+        pg_LockState(PG_STATE_PERF + i);
+        copy = pg_perf_counters[i];
+        pg_UnlockState(PG_STATE_PERF + i);
+        ticks = copy.ticks;
+        /* split up so that the ticks don't overflow when scaled */
+        counter = Py_BuildValue(
+            "{sKsKsK}", "calls", (unsigned long long)copy.calls, "pixels",
+            (unsigned long long)copy.pixels, "ns",
+            (unsigned long long)(ticks / freq * 1000000000 +
+                                 ticks % freq * 1000000000 / freq));
+        if (!counter) {
+            Py_DECREF(counters);
+            return NULL;
+        }
+        result = PyDict_SetItemString(counters, names[i], counter);
+        Py_DECREF(counter);
+        if (result) {
+            Py_DECREF(counters);
+            return NULL;
+        }
+    }
+#endif /* ~PG_NO_PERF_COUNTERS */
+
+    return counters;
+}
+
+static PyObject *
+pg_system_reset_perf_counters(PyObject *self, PyObject *_null)
+{
+#ifndef PG_NO_PERF_COUNTERS
+    int i;
+
+    for (i = 0; i < PG_PERF_NUM_COUNTERS; i++) {
+        pg_LockState(PG_STATE_PERF + i);
+        memset(pg_perf_counters + i, 0, sizeof(pgPerfCounter));
+        pg_UnlockState(PG_STATE_PERF + i);
+    }
+#endif /* ~PG_NO_PERF_COUNTERS */
+    Py_RETURN_NONE;
+}
+
+static PyObject *
+pg_system_set_simd_level(PyObject *self, PyObject *arg)
+{
+    static const char *const levels[] = {"scalar", "sse2", "neon", "avx2"};
+    pgSIMDDispatchTable *table = pg_simd_dispatch_table;
+    const char *level;
+    size_t i;
+    int j;
+
+    level = PyUnicode_AsUTF8(arg);
+    if (!level) {
+        return NULL;
+    }
+    for (i = 0; i < SDL_arraysize(levels); i++) {
+        if (!strcmp(level, levels[i])) {
+            break;
+        }
+    }
+    if (i == SDL_arraysize(levels)) {
+        return RAISE(PyExc_ValueError,
+                     "level must be 'scalar', 'sse2', 'neon' or 'avx2'");
+    }
+
+    /* overrides the PYGAME_SIMD environment variable too */
+    if (!SDL_SetHintWithPriority(PG_SIMD_HINT, level, SDL_HINT_OVERRIDE)) {
+        return RAISE(pgExc_SDLError, SDL_GetError());
+    }
+    for (j = 0; j < table->count; j++) {
+        if (table->funcs[j](NULL)) {
+            return NULL;
+        }
+    }
+    Py_RETURN_NONE;
+}
+
+static PyObject *
+pg_system_get_simd_dispatch(PyObject *self, PyObject *_null)
+{
+    pgSIMDDispatchTable *table = pg_simd_dispatch_table;
+    PyObject *dispatch = PyDict_New();
+    int i;
+
+    if (!dispatch) {
+        return NULL;
+    }
+    for (i = 0; i < table->count; i++) {
+        if (table->funcs[i](dispatch)) {
+            Py_DECREF(dispatch);
+            return NULL;
+        }
+    }
+    return dispatch;
+}
+
+static PyObject *
+_surface_memory_counter(const pgSurfaceMemCounter *counter)
+{
+    return Py_BuildValue("{sLsLsLsL}", "count", (long long)counter->count,
+                         "bytes", (long long)counter->bytes, "peak_count",
+                         (long long)counter->peak_count, "peak_bytes",
+                         (long long)counter->peak_bytes);
+}
+
+/* steals a reference to value */
+static int
+_dict_set_stolen(PyObject *dict, const char *key, PyObject *value)
+{
+    int result;
+
+    if (!value) {
+        return -1;
+    }
+    result = PyDict_SetItemString(dict, key, value);
+    Py_DECREF(value);
+    return result;
+}
+
+static PyObject *
+pg_system_get_surface_memory(PyObject *self, PyObject *_null)
+{
+    static const char *const origins[PG_SURF_NUM_ORIGINS] = {
+        "surface", "transform", "image", "font", "display", "other"};
+    pgSurfaceMemStats *stats = pg_surface_memory;
+    PyObject *result = NULL, *by_origin = NULL, *by_format = NULL;
+    const char *name;
+    int i;
+
+    if (!(result = PyDict_New()) || !(by_origin = PyDict_New()) ||
+        !(by_format = PyDict_New())) {
+        goto error;
+    }
+    for (i = 0; i < PG_SURF_NUM_ORIGINS; i++) {
+        if (_dict_set_stolen(by_origin, origins[i],
+                             _surface_memory_counter(stats->origins + i))) {
+            goto error;
+        }
+    }
+    for (i = 0; i < stats->num_formats; i++) {
+        name = SDL_GetPixelFormatName(stats->formats[i]);
+        if (!strncmp(name, "SDL_PIXELFORMAT_", 16)) {
+            name += 16;
+        }
+        if (_dict_set_stolen(by_format, name,
+                             _surface_memory_counter(stats->by_format + i))) {
+            goto error;
+        }
+    }
+    if (_dict_set_stolen(result, "total",
+                         _surface_memory_counter(&stats->total)) ||
+        PyDict_SetItemString(result, "origins", by_origin) ||
+        PyDict_SetItemString(result, "formats", by_format)) {
+        goto error;
+    }
+    Py_DECREF(by_origin);
+    Py_DECREF(by_format);
+    return result;
+
+error:
+    Py_XDECREF(result);
+    Py_XDECREF(by_origin);
+    Py_XDECREF(by_format);
+    return NULL;
+}
+
+static void
+_reset_surface_memory_peak(pgSurfaceMemCounter *counter)
+{
+    counter->peak_count = counter->count;
+    counter->peak_bytes = counter->bytes;
+}
+
+static PyObject *
+pg_system_reset_surface_memory_peaks(PyObject *self, PyObject *_null)
+{
+    pgSurfaceMemStats *stats = pg_surface_memory;
+    int i;
+
+    _reset_surface_memory_peak(&stats->total);
+    for (i = 0; i < PG_SURF_NUM_ORIGINS; i++) {
+        _reset_surface_memory_peak(stats->origins + i);
+    }
+    for (i = 0; i < stats->num_formats; i++) {
+        _reset_surface_memory_peak(stats->by_format + i);
+    }
+    Py_RETURN_NONE;
+}
+
 static PyMethodDef _system_methods[] = {
     {"get_cpu_instruction_sets", pg_system_get_cpu_instruction_sets,
      METH_NOARGS, DOC_SYSTEM_GETCPUINSTRUCTIONSETS},
@@ -240,6 +482,20 @@ static PyMethodDef _system_methods[] = {
      DOC_SYSTEM_GETPREFLOCALES},
     {"get_power_state", pg_system_get_power_state, METH_NOARGS,
      DOC_SYSTEM_GETPOWERSTATE},
+    {"get_freelist_stats", pg_system_get_freelist_stats, METH_NOARGS,
+     DOC_SYSTEM_GETFREELISTSTATS},
+    {"get_perf_counters", pg_system_get_perf_counters, METH_NOARGS,
+     DOC_SYSTEM_GETPERFCOUNTERS},
+    {"reset_perf_counters", pg_system_reset_perf_counters, METH_NOARGS,
+     DOC_SYSTEM_RESETPERFCOUNTERS},
+    {"set_simd_level", pg_system_set_simd_level, METH_O,
+     DOC_SYSTEM_SETSIMDLEVEL},
+    {"get_simd_dispatch", pg_system_get_simd_dispatch, METH_NOARGS,
+     DOC_SYSTEM_GETSIMDDISPATCH},
+    {"get_surface_memory", pg_system_get_surface_memory, METH_NOARGS,
+     DOC_SYSTEM_GETSURFACEMEMORY},
+    {"reset_surface_memory_peaks", pg_system_reset_surface_memory_peaks,
+     METH_NOARGS, DOC_SYSTEM_RESETSURFACEMEMORYPEAKS},
     {NULL, NULL, 0, NULL}};
 
 MODINIT_DEFINE(system)
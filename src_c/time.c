@@ -28,6 +28,13 @@
 
 #define WORST_CLOCK_ACCURACY 12
 
+/* Minimum time in milliseconds that tick_precise spins for instead of
+ * sleeping, the measured oversleep of SDL_Delay can raise it */
+#define PRECISE_SPIN_MS 1.0
+
+/* Number of frame times kept by each Clock for get_frame_stats() */
+#define CLOCK_FRAME_SAMPLES 512
+
 /* Enum containing some error codes used by timer related functions */
 typedef enum {
     PG_TIMER_NO_ERROR,
@@ -35,21 +42,19 @@ typedef enum {
     PG_TIMER_MEMORY_ERROR,
 } pgSetTimerErr;
 
-/* This is a doubly linked list of event timers. Access to this linked list
- * must be protected with an SDL mutex.
+/* Event timers are kept in a binary min-heap ordered by deadline, and one
+ * scheduler thread sleeps until the earliest of them is due. Access to the
+ * heap must be protected with an SDL mutex.
  * An SDL mutex would be redundant if python GIL was unconditionally held in
- * the C callback function. But acquiring GIL can be costlier than acquiring a
+ * the scheduler thread. But acquiring GIL can be costlier than acquiring a
  * dedicated mutex for event timers, because the GIL is usually held more
  * often.
  */
 typedef struct pgEventTimer {
-    /* Linked list attributes */
-    struct pgEventTimer *prev;
-    struct pgEventTimer *next;
-
-    /* The unique ID of a timer. This helps the callback get the correct timer
-     * instance from the linked list */
-    intptr_t timer_id;
+    /* When the next event is due and the time between events, both in
+     * performance counter units */
+    Uint64 deadline;
+    Uint64 interval;
 
     /* A dictproxy instance */
     pgEventDictProxy *dict_proxy;
@@ -63,11 +68,18 @@ typedef struct pgEventTimer {
     int repeat;
 } pgEventTimer;
 
-/* Pointer to head of timers linked list */
-static pgEventTimer *pg_event_timer = NULL;
+/* The heap of timers, the earliest deadline is at index 0 */
+static pgEventTimer **pg_timer_heap = NULL;
+static int pg_timer_heap_len = 0;
+static int pg_timer_heap_cap = 0;
 
-/* Timer ID incrementer */
-static intptr_t pg_timer_id = 0;
+#ifndef __EMSCRIPTEN__
+/* The scheduler thread, started by the first set_timer call and stopped on
+ * quit. It waits on the condition variable, which is signalled whenever the
+ * heap changes. */
+static SDL_Thread *pg_timer_thread = NULL;
+static int pg_timer_thread_quit = 0;
+#endif /* not on emscripten */
 
 #ifdef __EMSCRIPTEN__
 /* emscripten does not allow multithreading for now and SDL_CreateMutex fails.
@@ -83,6 +95,7 @@ static intptr_t pg_timer_id = 0;
  * threads trying to use it. Since it's a singleton we don't need to worry
  * about memory leaks */
 static SDL_mutex *pg_timer_mutex = NULL;
+static SDL_cond *pg_timer_cond = NULL;
 
 /* these macros are intended for use where python exceptions cannot be raised
  * easily */
@@ -112,29 +125,54 @@ static SDL_mutex *pg_timer_mutex = NULL;
 
 #endif /* not on emscripten */
 
-/* Free a timer instance from linked list. Needs timer mutex held for data
- * safety. This function call does not need GIL held, but can conditionally
- * internally hold GIL if needed */
+/* The heap helpers below need the timer mutex held */
 static void
-_pg_timer_free(pgEventTimer *timer)
+_pg_timer_heap_swap(int a, int b)
 {
-    if (!timer) {
-        return;
+    pgEventTimer *tmp = pg_timer_heap[a];
+    pg_timer_heap[a] = pg_timer_heap[b];
+    pg_timer_heap[b] = tmp;
+}
+
+static void
+_pg_timer_heap_up(int i)
+{
+    while (i > 0 && pg_timer_heap[(i - 1) / 2]->deadline >
+                        pg_timer_heap[i]->deadline) {
+        _pg_timer_heap_swap(i, (i - 1) / 2);
+        i = (i - 1) / 2;
     }
+}
 
-    /* remove reference to current timer from linked list */
-    if (timer->prev) {
-        timer->prev->next = timer->next;
-        if (timer->next) {
-            timer->next->prev = timer->prev;
-        }
+static void
+_pg_timer_heap_down(int i)
+{
+    int child;
+    while ((child = 2 * i + 1) < pg_timer_heap_len) {
+        if (child + 1 < pg_timer_heap_len &&
+            pg_timer_heap[child + 1]->deadline <
+                pg_timer_heap[child]->deadline)
+            child++;
+        if (pg_timer_heap[i]->deadline <= pg_timer_heap[child]->deadline)
+            break;
+        _pg_timer_heap_swap(i, child);
+        i = child;
     }
-    else {
-        /* current timer is head of the queue, replace head */
-        pg_event_timer = timer->next;
-        if (pg_event_timer) {
-            pg_event_timer->prev = NULL;
-        }
+}
+
+/* Remove the timer at 'index' from the heap and free it. Needs timer mutex
+ * held for data safety. This function call does not need GIL held, but can
+ * conditionally internally hold GIL if needed */
+static void
+_pg_timer_free(int index)
+{
+    pgEventTimer *timer = pg_timer_heap[index];
+
+    pg_timer_heap_len--;
+    if (index != pg_timer_heap_len) {
+        pg_timer_heap[index] = pg_timer_heap[pg_timer_heap_len];
+        _pg_timer_heap_up(index);
+        _pg_timer_heap_down(index);
     }
 
     if (timer->dict_proxy) {
@@ -165,15 +203,35 @@ _pg_timer_free(pgEventTimer *timer)
 static PyObject *
 pg_time_autoquit(PyObject *self, PyObject *_null)
 {
+#ifndef __EMSCRIPTEN__
+    SDL_Thread *thread;
+#endif
+
     /* release GIL during quit because python GIL and pg_timer_mutex should
      * not deadlock waiting for each other */
     Py_BEGIN_ALLOW_THREADS;
     PG_LOCK_TIMER_MUTEX
-    while (pg_event_timer) {
+    while (pg_timer_heap_len) {
         /* Keep freeing till all are freed */
-        _pg_timer_free(pg_event_timer);
+        _pg_timer_free(pg_timer_heap_len - 1);
     }
+    free(pg_timer_heap);
+    pg_timer_heap = NULL;
+    pg_timer_heap_cap = 0;
+
+#ifndef __EMSCRIPTEN__
+    thread = pg_timer_thread;
+    pg_timer_thread = NULL;
+    pg_timer_thread_quit = 1;
+    if (pg_timer_cond)
+        SDL_CondSignal(pg_timer_cond);
+#endif
     PG_UNLOCK_TIMER_MUTEX
+
+#ifndef __EMSCRIPTEN__
+    if (thread)
+        SDL_WaitThread(thread, NULL);
+#endif
     Py_END_ALLOW_THREADS;
     Py_RETURN_NONE;
 }
@@ -188,18 +246,38 @@ pg_time_autoinit(PyObject *self, PyObject *_null)
         if (!pg_timer_mutex)
             return RAISE(pgExc_SDLError, SDL_GetError());
     }
+    /* immortal like the mutex */
+    if (!pg_timer_cond) {
+        pg_timer_cond = SDL_CreateCond();
+        if (!pg_timer_cond)
+            return RAISE(pgExc_SDLError, SDL_GetError());
+    }
 #endif
     Py_RETURN_NONE;
 }
 
-/* Add a new timer in the timer linked list at the first index. Needs timer
- * mutex held for data safety. The caller of this function need not hold GIL,
- * but this function can internally hold GIL if needed.
+/* Add a new timer to the heap, due 'interval' performance counter units from
+ * now. Needs timer mutex held for data safety. The caller of this function
+ * need not hold GIL, but this function can internally hold GIL if needed.
  * Returns pgSetTimerErr error codes */
 static pgSetTimerErr
-_pg_add_event_timer(int ev_type, PyObject *ev_dict, int repeat)
+_pg_add_event_timer(int ev_type, PyObject *ev_dict, int repeat,
+                    Uint64 interval)
 {
-    pgEventTimer *new = (pgEventTimer *)malloc(sizeof(pgEventTimer));
+    pgEventTimer *new;
+
+    if (pg_timer_heap_len == pg_timer_heap_cap) {
+        int cap = pg_timer_heap_cap ? pg_timer_heap_cap * 2 : 16;
+        pgEventTimer **heap = (pgEventTimer **)realloc(
+            pg_timer_heap, sizeof(pgEventTimer *) * cap);
+        if (!heap) {
+            return PG_TIMER_MEMORY_ERROR;
+        }
+        pg_timer_heap = heap;
+        pg_timer_heap_cap = cap;
+    }
+
+    new = (pgEventTimer *)malloc(sizeof(pgEventTimer));
     if (!new) {
         return PG_TIMER_MEMORY_ERROR;
     }
@@ -222,41 +300,16 @@ _pg_add_event_timer(int ev_type, PyObject *ev_dict, int repeat)
         new->dict_proxy = NULL;
     }
 
-    /* insert the timer into the doubly linked list at the first index */
-    new->prev = NULL;
-    new->next = pg_event_timer;
-
-    pg_timer_id++;
-    new->timer_id = pg_timer_id;
     new->event_type = ev_type;
     new->repeat = repeat;
+    new->interval = interval;
+    new->deadline = SDL_GetPerformanceCounter() + interval;
 
-    if (pg_event_timer) {
-        pg_event_timer->prev = new;
-    }
-    pg_event_timer = new;
+    pg_timer_heap[pg_timer_heap_len] = new;
+    _pg_timer_heap_up(pg_timer_heap_len++);
     return PG_TIMER_NO_ERROR;
 }
 
-/* Get event on timer queue. Needs timer mutex held for data safety. Does not
- * need GIL held. Decrements repeat count of timer being returned.
- * Returns NULL if timer is not found. */
-static pgEventTimer *
-_pg_get_event_on_timer(intptr_t timer_id)
-{
-    pgEventTimer *hunt = pg_event_timer;
-    while (hunt) {
-        if (hunt->timer_id == timer_id) {
-            if (hunt->repeat >= 0) {
-                hunt->repeat--;
-            }
-            break;
-        }
-        hunt = hunt->next;
-    }
-    return hunt;
-}
-
 /* Clear event timer by type. Needs timer mutex held for data safety, but the
  * caller need not hold GIL.
  * Does not do anything if ev_type does not exist already.
@@ -264,45 +317,92 @@ _pg_get_event_on_timer(intptr_t timer_id)
 static void
 _pg_clear_event_timer_type(int ev_type)
 {
-    pgEventTimer *hunt = pg_event_timer;
-    while (hunt) {
-        if (hunt->event_type == ev_type) {
-            _pg_timer_free(hunt);
+    int i;
+    for (i = 0; i < pg_timer_heap_len; i++) {
+        if (pg_timer_heap[i]->event_type == ev_type) {
+            _pg_timer_free(i);
             return;
         }
-        hunt = hunt->next;
     }
 }
 
-/* Timer callback function
+#ifndef __EMSCRIPTEN__
+/* Post the events of every timer that is due at 'now', in deadline order.
+ * Timers that fell behind by several intervals post once and skip the
+ * missed ones, instead of flooding the queue. Needs timer mutex held.
  * TODO: This needs better error handling and a way to report to the user */
-static Uint32
-timer_callback(Uint32 interval, void *param)
+static void
+_pg_fire_timers(Uint64 now)
 {
-    pgEventTimer *evtimer;
-    PG_LOCK_TIMER_MUTEX
-    evtimer = _pg_get_event_on_timer((intptr_t)param);
-    if (!evtimer) {
-        interval = 0;
-    }
-    else {
+    pgEventTimer *timer;
+
+    while (pg_timer_heap_len && pg_timer_heap[0]->deadline <= now) {
+        timer = pg_timer_heap[0];
+        if (timer->repeat >= 0) {
+            timer->repeat--;
+        }
+
         if (SDL_WasInit(SDL_INIT_VIDEO)) {
-            pg_post_event_dictproxy((Uint32)evtimer->event_type,
-                                    evtimer->dict_proxy);
+            pg_post_event_dictproxy((Uint32)timer->event_type,
+                                    timer->dict_proxy);
         }
         else {
-            evtimer->repeat = 0;
+            timer->repeat = 0;
         }
 
-        if (!evtimer->repeat) {
+        if (!timer->repeat) {
             /* This does memory cleanup */
-            _pg_timer_free(evtimer);
-            interval = 0;
+            _pg_timer_free(0);
+            continue;
+        }
+
+        timer->deadline +=
+            ((now - timer->deadline) / timer->interval + 1) * timer->interval;
+        _pg_timer_heap_down(0);
+    }
+}
+
+/* Scheduler thread. Sleeps on the condition variable until the earliest
+ * deadline. Timers of a millisecond or more sleep through their last
+ * millisecond too, so they may be late by up to the resolution of the OS
+ * timer like SDL_AddTimer() timers. Only sub-millisecond timers spin with
+ * yields through it, keeping this thread busy while they run. */
+static int SDLCALL
+_pg_timer_thread_func(void *_)
+{
+    Uint64 freq = SDL_GetPerformanceFrequency(), now, wait;
+    Uint64 millisecond = freq / 1000;
+
+    PG_LOCK_TIMER_MUTEX
+    while (!pg_timer_thread_quit) {
+        if (!pg_timer_heap_len) {
+            SDL_CondWait(pg_timer_cond, pg_timer_mutex);
+            continue;
+        }
+
+        now = SDL_GetPerformanceCounter();
+        if (pg_timer_heap[0]->deadline <= now) {
+            _pg_fire_timers(now);
+            continue;
+        }
+
+        wait = (pg_timer_heap[0]->deadline - now) * 1000 / freq;
+        if (!wait && pg_timer_heap[0]->interval >= millisecond) {
+            wait = 1;
+        }
+        if (wait) {
+            SDL_CondWaitTimeout(pg_timer_cond, pg_timer_mutex, (Uint32)wait);
+        }
+        else {
+            PG_UNLOCK_TIMER_MUTEX
+            SDL_Delay(0); /* yield */
+            PG_LOCK_TIMER_MUTEX
         }
     }
     PG_UNLOCK_TIMER_MUTEX
-    return interval;
+    return 0;
 }
+#endif /* not on emscripten */
 
 static Uint64
 accurate_delay(Sint64 ticks)
@@ -392,7 +492,8 @@ time_wait(PyObject *self, PyObject *arg)
 static PyObject *
 time_set_timer(PyObject *self, PyObject *args, PyObject *kwargs)
 {
-    int ticks, loops = 0;
+    int loops = 0;
+    double millis;
     PyObject *obj, *ev_dict = NULL;
     int ev_type;
     pgEventObject *e;
@@ -407,8 +508,8 @@ time_set_timer(PyObject *self, PyObject *args, PyObject *kwargs)
                  "set_timer is not implemented on WASM yet");
 #endif
 
-    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "Oi|i", kwids, &obj, &ticks,
-                                     &loops))
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "Od|i", kwids, &obj,
+                                     &millis, &loops))
         return NULL;
 
     if (PyLong_Check(obj)) {
@@ -424,7 +525,12 @@ time_set_timer(PyObject *self, PyObject *args, PyObject *kwargs)
     else if (pgEvent_Check(obj)) {
         e = (pgEventObject *)obj;
         ev_type = e->type;
-        ev_dict = e->dict;
+        /* go through the attribute so a lazily built dict gets created, the
+         * event keeps it alive for the rest of this call */
+        ev_dict = PyObject_GetAttrString(obj, "__dict__");
+        if (!ev_dict)
+            return NULL;
+        Py_DECREF(ev_dict);
     }
     else {
         return RAISE(PyExc_TypeError,
@@ -436,6 +542,14 @@ time_set_timer(PyObject *self, PyObject *args, PyObject *kwargs)
         return RAISE(pgExc_SDLError, "pygame is not initialized");
 #endif /* emscripten */
 
+    /* just doublecheck that timer is initialized, this also raises the
+     * resolution of the OS timer the scheduler thread sleeps with */
+    if (!SDL_WasInit(SDL_INIT_TIMER)) {
+        if (SDL_InitSubSystem(SDL_INIT_TIMER)) {
+            return RAISE(pgExc_SDLError, SDL_GetError());
+        }
+    }
+
     /* release GIL because python GIL and pg_timer_mutex should not
      * deadlock waiting for each other */
     Py_BEGIN_ALLOW_THREADS;
@@ -451,27 +565,30 @@ time_set_timer(PyObject *self, PyObject *args, PyObject *kwargs)
     _pg_clear_event_timer_type(ev_type);
 
     /* This means that the user only wanted to remove an existing timer */
-    if (ticks <= 0) {
+    if (millis <= 0) {
         goto end;
     }
 
-    /* just doublecheck that timer is initialized */
-    if (!SDL_WasInit(SDL_INIT_TIMER)) {
-        if (SDL_InitSubSystem(SDL_INIT_TIMER)) {
-            ecode = PG_TIMER_SDL_ERROR;
-            goto end;
-        }
-    }
-
-    ecode = _pg_add_event_timer(ev_type, ev_dict, loops);
+    ecode = _pg_add_event_timer(
+        ev_type, ev_dict, loops,
+        (Uint64)(millis * SDL_GetPerformanceFrequency() / 1000.0) + 1);
     if (ecode != PG_TIMER_NO_ERROR) {
         goto end;
     }
 
-    if (!SDL_AddTimer(ticks, timer_callback, (void *)pg_timer_id)) {
-        _pg_timer_free(pg_event_timer); /* Does cleanup */
-        ecode = PG_TIMER_SDL_ERROR;
+#ifndef __EMSCRIPTEN__
+    if (!pg_timer_thread) {
+        pg_timer_thread_quit = 0;
+        pg_timer_thread =
+            SDL_CreateThread(_pg_timer_thread_func, "pygame_timers", NULL);
+        if (!pg_timer_thread) {
+            _pg_clear_event_timer_type(ev_type); /* Does cleanup */
+            ecode = PG_TIMER_SDL_ERROR;
+            goto end;
+        }
     }
+    SDL_CondSignal(pg_timer_cond);
+#endif
 
 end:
 #ifndef __EMSCRIPTEN__
@@ -505,8 +622,47 @@ typedef struct {
     PyObject_HEAD Uint64 last_tick, fps_count, fps_tick;
     float fps;
     Uint64 timepassed, rawpassed;
+    /* tick_precise state, in performance counter units */
+    Uint64 precise_deadline, precise_last;
+    double oversleep;
+    /* ring buffer of frame times in milliseconds, measured with the
+     * performance counter on every tick */
+    Uint64 frame_last;
+    int frame_index, frame_count;
+    float frame_times[CLOCK_FRAME_SAMPLES];
 } pgClockObject;
 
+static void
+clock_update_fps(pgClockObject *self, Uint64 nowtime)
+{
+    Uint64 counter = SDL_GetPerformanceCounter();
+
+    /* the first tick has no previous frame to measure against */
+    if (self->frame_last) {
+        self->frame_times[self->frame_index] =
+            (float)((counter - self->frame_last) * 1000.0 /
+                    SDL_GetPerformanceFrequency());
+        self->frame_index = (self->frame_index + 1) % CLOCK_FRAME_SAMPLES;
+        if (self->frame_count < CLOCK_FRAME_SAMPLES)
+            self->frame_count++;
+    }
+    self->frame_last = counter;
+
+    self->timepassed = nowtime - self->last_tick;
+    self->fps_count += 1;
+    self->last_tick = nowtime;
+
+    if (!self->fps_tick) {
+        self->fps_count = 0;
+        self->fps_tick = nowtime;
+    }
+    else if (self->fps_count >= 10) {
+        self->fps = self->fps_count / ((nowtime - self->fps_tick) / 1000.0f);
+        self->fps_count = 0;
+        self->fps_tick = nowtime;
+    }
+}
+
 // to be called by the other tick functions.
 static PyObject *
 clock_tick_base(pgClockObject *self, PyObject *arg, int use_accurate_delay)
@@ -546,22 +702,102 @@ clock_tick_base(pgClockObject *self, PyObject *arg, int use_accurate_delay)
     }
 
     nowtime = PG_GetTicks();
-    self->timepassed = nowtime - self->last_tick;
-    self->fps_count += 1;
-    self->last_tick = nowtime;
+    clock_update_fps(self, nowtime);
     if (!framerate)
         self->rawpassed = self->timepassed;
+    return PyLong_FromUnsignedLongLong(self->timepassed);
+}
 
-    if (!self->fps_tick) {
-        self->fps_count = 0;
-        self->fps_tick = nowtime;
+/* Waits until the performance counter reaches 'target'. Sleeps while more
+ * than the spin margin is left, then spins, yielding the CPU between checks.
+ * Tracks how far SDL_Delay overshoots so the margin fits the platform. Must
+ * be called without the GIL. */
+static void
+precise_wait(pgClockObject *self, Uint64 target, Uint64 freq)
+{
+    Uint64 now = SDL_GetPerformanceCounter(), before;
+    double per_ms = freq / 1000.0, margin, slept;
+    Uint32 ms;
+
+    margin = PRECISE_SPIN_MS * per_ms;
+    if (margin < self->oversleep * 2.0)
+        margin = self->oversleep * 2.0;
+
+    while (now < target && (double)(target - now) > margin) {
+        ms = (Uint32)(((double)(target - now) - margin) / per_ms);
+        if (!ms)
+            break;
+        before = now;
+        SDL_Delay(ms);
+        now = SDL_GetPerformanceCounter();
+
+        /* moving average of how much longer than asked each sleep took */
+        slept = (double)(now - before) - ms * per_ms;
+        if (slept < 0.0)
+            slept = 0.0;
+        self->oversleep += (slept - self->oversleep) * 0.125;
     }
-    else if (self->fps_count >= 10) {
-        self->fps = self->fps_count / ((nowtime - self->fps_tick) / 1000.0f);
-        self->fps_count = 0;
-        self->fps_tick = nowtime;
+
+    while (now < target) {
+        SDL_Delay(0); /* yield */
+        now = SDL_GetPerformanceCounter();
     }
-    return PyLong_FromUnsignedLongLong(self->timepassed);
+}
+
+static PyObject *
+clock_tick_precise(pgClockObject *self, PyObject *arg)
+{
+    double framerate = 0.0, passed;
+    Uint64 freq, now, period, target;
+
+    if (!PyArg_ParseTuple(arg, "|d", &framerate))
+        return NULL;
+
+    if (framerate < 0.0)
+        return RAISE(PyExc_ValueError, "framerate must not be negative");
+
+    /*just doublecheck that timer is initialized*/
+    if (!SDL_WasInit(SDL_INIT_TIMER)) {
+        if (SDL_InitSubSystem(SDL_INIT_TIMER)) {
+            return RAISE(pgExc_SDLError, SDL_GetError());
+        }
+    }
+
+    freq = SDL_GetPerformanceFrequency();
+    now = SDL_GetPerformanceCounter();
+    if (!self->precise_last)
+        self->precise_last = now;
+    self->rawpassed = PG_GetTicks() - self->last_tick;
+
+    if (framerate > 0.0) {
+        period = (Uint64)(freq / framerate);
+
+        /* Frames are scheduled from the previous deadline rather than from
+         * now, so that rounding and wake up latency do not add up into a
+         * lower framerate. After a stall longer than a frame the schedule
+         * restarts instead of rushing frames to catch up. */
+        if (!self->precise_deadline || now > self->precise_deadline + period)
+            self->precise_deadline = now;
+        target = self->precise_deadline + period;
+
+        Py_BEGIN_ALLOW_THREADS;
+        precise_wait(self, target, freq);
+        Py_END_ALLOW_THREADS;
+
+        self->precise_deadline = target;
+        now = SDL_GetPerformanceCounter();
+    }
+    else {
+        self->precise_deadline = 0;
+    }
+
+    passed = (now - self->precise_last) * 1000.0 / freq;
+    self->precise_last = now;
+
+    clock_update_fps(self, PG_GetTicks());
+    if (framerate <= 0.0)
+        self->rawpassed = self->timepassed;
+    return PyFloat_FromDouble(passed);
 }
 
 static PyObject *
@@ -594,6 +830,62 @@ clock_get_rawtime(pgClockObject *self, PyObject *_null)
     return PyLong_FromUnsignedLongLong(self->rawpassed);
 }
 
+static int
+compare_float(const void *a, const void *b)
+{
+    float fa = *(const float *)a, fb = *(const float *)b;
+    return (fa > fb) - (fa < fb);
+}
+
+/* nearest rank percentile of 'n' sorted samples */
+static double
+frame_percentile(const float *sorted, int n, double p)
+{
+    int rank;
+    if (!n)
+        return 0.0;
+    rank = (int)SDL_ceil(p * n) - 1;
+    return sorted[rank < 0 ? 0 : rank];
+}
+
+static PyObject *
+clock_get_frame_stats(pgClockObject *self, PyObject *_null)
+{
+    float sorted[CLOCK_FRAME_SAMPLES], ordered[CLOCK_FRAME_SAMPLES];
+    int i, n = self->frame_count, start;
+    double total = 0.0;
+    PyObject *raw, *view, *samples;
+
+    /* oldest first */
+    start =
+        (self->frame_index - n + CLOCK_FRAME_SAMPLES) % CLOCK_FRAME_SAMPLES;
+    for (i = 0; i < n; i++) {
+        ordered[i] = self->frame_times[(start + i) % CLOCK_FRAME_SAMPLES];
+        total += ordered[i];
+    }
+    memcpy(sorted, ordered, sizeof(float) * n);
+    qsort(sorted, n, sizeof(float), compare_float);
+
+    raw = PyBytes_FromStringAndSize((char *)ordered, sizeof(float) * n);
+    if (!raw)
+        return NULL;
+    view = PyMemoryView_FromObject(raw);
+    Py_DECREF(raw);
+    if (!view)
+        return NULL;
+    samples = PyObject_CallMethod(view, "cast", "s", "f");
+    Py_DECREF(view);
+    if (!samples)
+        return NULL;
+
+    return Py_BuildValue("{s:i,s:d,s:d,s:d,s:d,s:d,s:N}", "count", n, "mean",
+                         n ? total / n : 0.0, "p50",
+                         frame_percentile(sorted, n, 0.50), "p95",
+                         frame_percentile(sorted, n, 0.95), "p99",
+                         frame_percentile(sorted, n, 0.99), "max",
+                         frame_percentile(sorted, n, 1.0), "samples", samples);
+}
+
 /* clock object internals */
 
 static struct PyMethodDef clock_methods[] = {
@@ -606,6 +898,10 @@ static struct PyMethodDef clock_methods[] = {
      DOC_TIME_CLOCK_GETRAWTIME},
     {"tick_busy_loop", (PyCFunction)clock_tick_busy_loop, METH_VARARGS,
      DOC_TIME_CLOCK_TICKBUSYLOOP},
+    {"tick_precise", (PyCFunction)clock_tick_precise, METH_VARARGS,
+     DOC_TIME_CLOCK_TICKPRECISE},
+    {"get_frame_stats", (PyCFunction)clock_get_frame_stats, METH_NOARGS,
+     DOC_TIME_CLOCK_GETFRAMESTATS},
     {NULL, NULL, 0, NULL}};
 
 static void
@@ -652,6 +948,12 @@ clock_new(PyTypeObject *type, PyObject *args, PyObject *kwargs)
     self->last_tick = PG_GetTicks();
     self->fps = 0.0f;
     self->fps_count = 0;
+    self->precise_deadline = 0;
+    self->precise_last = SDL_GetPerformanceCounter();
+    self->oversleep = 0.0;
+    self->frame_last = 0;
+    self->frame_index = 0;
+    self->frame_count = 0;
 
     return (PyObject *)self;
 }
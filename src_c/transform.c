@@ -24,12 +24,15 @@
 /*
  *  surface transformations for pygame
  */
+#define PG_SURFACE_ORIGIN PG_SURF_ORIGIN_TRANSFORM
 #include "pygame.h"
 
 #include "pgcompat.h"
 
 #include "doc/transform_doc.h"
 
+#include "surface.h"
+
 #include <math.h>
 #include <string.h>
 
@@ -39,12 +42,41 @@
 
 typedef void (*SMOOTHSCALE_FILTER_P)(Uint8 *, Uint8 *, int, int, int, int,
                                      int);
+typedef void (*BLUR_ACCUMULATE_U8_P)(float *, const Uint8 *, int, float);
+typedef void (*BLUR_ACCUMULATE_F32_P)(float *, const float *, int, float);
+
+#define GAUSSIAN_KERNEL_CACHE_SIZE 8
+
 struct _module_state {
     const char *filter_type;
     SMOOTHSCALE_FILTER_P filter_shrink_X;
     SMOOTHSCALE_FILTER_P filter_shrink_Y;
     SMOOTHSCALE_FILTER_P filter_expand_X;
     SMOOTHSCALE_FILTER_P filter_expand_Y;
+    int smoothscale_threads;
+    BLUR_ACCUMULATE_U8_P blur_accumulate_u8;
+    BLUR_ACCUMULATE_F32_P blur_accumulate_f32;
+    int blur_threads;
+    int average_color_threads;
+    /* normalized half kernels of recently used gaussian_blur sigmas */
+    int gaussian_sigmas[GAUSSIAN_KERNEL_CACHE_SIZE];
+    float *gaussian_kernels[GAUSSIAN_KERNEL_CACHE_SIZE];
+    int gaussian_next;
+    const char *rotate_backend;
+    ROTATE_NEAREST_ROW_P rotate_nearest_row;
+    ROTOZOOM_SMOOTH_RUN_P rotozoom_smooth_run;
+    int rotozoom_threads;
+    TRANSPOSE32_P transpose32;
+    FLIP_ROW32_P flip_row32;
+    /* rotate and rotozoom results, see enable_cache() */
+    PyObject *cache; /* key -> entry, least recently used first */
+    Py_ssize_t cache_max_bytes;
+    Py_ssize_t cache_bytes;
+    Py_ssize_t cache_hits;
+    Py_ssize_t cache_misses;
+    Py_ssize_t cache_evictions;
+    /* of the smoothscale kernels, the gaussian kernels and the results */
+    pg_mutex lock;
 };
 
 #define GETSTATE(m) ((struct _module_state *)PyModule_GetState(m))
@@ -53,10 +85,16 @@ struct _module_state {
 #include <SDL_cpuinfo.h>
 #endif /* SCALE_MMX_SUPPORT */
 
-void
-scale2x(SDL_Surface *src, SDL_Surface *dst);
+int
+scalenx(SDL_Surface *src, SDL_Surface *dst, int factor, int num_threads,
+        SCALE2X_ROW_P row2x, SCALE3X_ROW_P row3x);
 extern SDL_Surface *
-rotozoomSurface(SDL_Surface *src, double angle, double zoom, int smooth);
+rotozoomSurface(SDL_Surface *src, double angle, double zoom, int smooth,
+                ROTOZOOM_SMOOTH_RUN_P smooth_run, int num_threads,
+                SDL_Surface *dst);
+extern void
+rotozoomSurfaceResultSize(int width, int height, double angle, double zoom,
+                          int *dstwidth, int *dstheight);
 
 static int
 _get_factor(PyObject *factorobj, float *x, float *y)
@@ -129,7 +167,7 @@ newsurf_fromsurf(SDL_Surface *surf, int width, int height)
         return (SDL_Surface *)(RAISE(
             PyExc_ValueError, "unsupported Surface bit depth for transform"));
 
-    newsurf = PG_CreateSurface(width, height, surf->format->format);
+    newsurf = pgSurface_CreatePooled(width, height, surf->format->format);
     if (!newsurf)
         return (SDL_Surface *)(RAISE(pgExc_SDLError, SDL_GetError()));
 
@@ -196,12 +234,110 @@ newsurf_fromsurf(SDL_Surface *surf, int width, int height)
     return newsurf;
 }
 
+/* Checks the dest_surface of a transform that can't write over its source.
+ * It needs the size and the pixel format of the surface the transform would
+ * return, but only its pixels are written, it keeps its own colorkey and
+ * alpha. */
+static int
+_check_dest(SDL_Surface *dst, SDL_Surface *src, Uint32 format, int width,
+            int height)
+{
+    if (!dst) {
+        PyErr_SetString(pgExc_SDLError, "display Surface quit");
+        return -1;
+    }
+    if (dst == src) {
+        PyErr_SetString(PyExc_ValueError,
+                        "dest_surface can't be the source surface");
+        return -1;
+    }
+    if (dst->w != width || dst->h != height) {
+        PyErr_Format(PyExc_ValueError, "Destination surface must be %dx%d.",
+                     width, height);
+        return -1;
+    }
+    if (dst->format->format != format) {
+        PyErr_SetString(
+            PyExc_ValueError,
+            "Source and destination surfaces need the same format.");
+        return -1;
+    }
+    return 0;
+}
+
+/* The generic versions of the 32 bit rotate90() and flip() kernels, see
+ * simd_transform.h */
+static void
+transpose32(const Uint8 *src, int srcpitch, Uint8 *dst, int dstpitch, int w,
+            int h)
+{
+    int tx, ty;
+
+    for (ty = 0; ty < h; ty += PG_TRANSPOSE_TILE) {
+        for (tx = 0; tx < w; tx += PG_TRANSPOSE_TILE) {
+            _pg_transpose32_rect(src, srcpitch, dst, dstpitch, tx,
+                                 MIN(tx + PG_TRANSPOSE_TILE, w), ty,
+                                 MIN(ty + PG_TRANSPOSE_TILE, h));
+        }
+    }
+}
+
+static void
+flip_row32(const Uint32 *src, Uint32 *dst, int n)
+{
+    Uint32 tmp;
+    int i, j;
+
+    for (i = 0, j = n - 1; i <= j; i++, j--) {
+        tmp = src[i];
+        dst[i] = src[j];
+        dst[j] = tmp;
+    }
+}
+
+/* rotate90() of 32 bit surfaces. The quarter turns are transposes, going
+ * through the rows of src or dst bottom up, and the half turn flips the
+ * rows. */
+static void
+rotate90_32(SDL_Surface *src, SDL_Surface *dst, int numturns,
+            TRANSPOSE32_P transpose, FLIP_ROW32_P flip_row)
+{
+    Uint8 *srcpix = (Uint8 *)src->pixels;
+    Uint8 *dstpix = (Uint8 *)dst->pixels;
+    int y;
+
+    switch (numturns) {
+        case 0:
+            for (y = 0; y < src->h; ++y) {
+                memcpy(dstpix + (Sint64)y * dst->pitch,
+                       srcpix + (Sint64)y * src->pitch, src->w * 4);
+            }
+            break;
+        case 1:
+            transpose(srcpix, src->pitch,
+                      dstpix + (Sint64)(dst->h - 1) * dst->pitch,
+                      -dst->pitch, src->w, src->h);
+            break;
+        case 2:
+            for (y = 0; y < src->h; ++y) {
+                flip_row(
+                    (Uint32 *)(srcpix + (Sint64)(src->h - 1 - y) * src->pitch),
+                    (Uint32 *)(dstpix + (Sint64)y * dst->pitch), src->w);
+            }
+            break;
+        case 3:
+            transpose(srcpix + (Sint64)(src->h - 1) * src->pitch, -src->pitch,
+                      dstpix, dst->pitch, src->w, src->h);
+            break;
+    }
+}
+
 static SDL_Surface *
-rotate90(SDL_Surface *src, int angle)
+rotate90(SDL_Surface *src, SDL_Surface *dst, int angle,
+         TRANSPOSE32_P transpose, FLIP_ROW32_P flip_row)
 {
     int numturns = (angle / 90) % 4;
     int dstwidth, dstheight;
-    SDL_Surface *dst;
     char *srcpix, *dstpix, *srcrow, *dstrow;
     int srcstepx, srcstepy, dststepx, dststepy;
     int loopx, loopy;
@@ -217,9 +353,15 @@ rotate90(SDL_Surface *src, int angle)
         dstheight = src->w;
     }
 
-    dst = newsurf_fromsurf(src, dstwidth, dstheight);
-    if (!dst)
+    if (!dst) {
+        dst = newsurf_fromsurf(src, dstwidth, dstheight);
+        if (!dst)
+            return NULL;
+    }
+    else if (_check_dest(dst, src, src->format->format, dstwidth,
+                         dstheight)) {
         return NULL;
+    }
 
     Py_BEGIN_ALLOW_THREADS;
     SDL_LockSurface(dst);
@@ -289,17 +431,7 @@ rotate90(SDL_Surface *src, int angle)
             }
             break;
         case 4:
-            for (loopy = 0; loopy < dstheight; ++loopy) {
-                dstpix = dstrow;
-                srcpix = srcrow;
-                for (loopx = 0; loopx < dstwidth; ++loopx) {
-                    *(Uint32 *)dstpix = *(Uint32 *)srcpix;
-                    srcpix += srcstepx;
-                    dstpix += dststepx;
-                }
-                dstrow += dststepy;
-                srcrow += srcstepy;
-            }
+            rotate90_32(src, dst, numturns, transpose, flip_row);
             break;
     }
     SDL_UnlockSurface(dst);
@@ -307,9 +439,29 @@ rotate90(SDL_Surface *src, int angle)
     return dst;
 }
 
+/* One row of a 32 bit rotate(), the SIMD versions of this are in
+ * simd_transform_*.c */
+static void
+rotate_nearest_row(const Uint8 *srcpix, int srcpitch, Uint32 *dstpix,
+                   int width, int dx, int dy, int icos, int isin, int xmaxval,
+                   int ymaxval, Uint32 bgcolor)
+{
+    int x;
+
+    for (x = 0; x < width; x++) {
+        if (dx < 0 || dy < 0 || dx > xmaxval || dy > ymaxval)
+            *dstpix++ = bgcolor;
+        else
+            *dstpix++ = *(Uint32 *)(srcpix + ((dy >> 16) * srcpitch) +
+                                    ((long long)dx >> 16 << 2));
+        dx += icos;
+        dy += isin;
+    }
+}
+
 static void
 rotate(SDL_Surface *src, SDL_Surface *dst, Uint32 bgcolor, double sangle,
-       double cangle)
+       double cangle, ROTATE_NEAREST_ROW_P nearest_row)
 {
     int x, y, dx, dy;
 
@@ -372,19 +524,10 @@ rotate(SDL_Surface *src, SDL_Surface *dst, Uint32 bgcolor, double sangle,
             break;
         case 4:
             for (y = 0; y < dst->h; y++) {
-                Uint32 *dstpos = (Uint32 *)dstrow;
                 dx = (ax + (isin * (cy - y))) + xd;
                 dy = (ay - (icos * (cy - y))) + yd;
-                for (x = 0; x < dst->w; x++) {
-                    if (dx < 0 || dy < 0 || dx > xmaxval || dy > ymaxval)
-                        *dstpos++ = bgcolor;
-                    else
-                        *dstpos++ =
-                            *(Uint32 *)(srcpix + ((dy >> 16) * srcpitch) +
-                                        ((long long)dx >> 16 << 2));
-                    dx += icos;
-                    dy += isin;
-                }
+                nearest_row(srcpix, srcpitch, (Uint32 *)dstrow, dst->w, dx,
+                            dy, icos, isin, xmaxval, ymaxval, bgcolor);
                 dstrow += dstpitch;
             }
             break;
@@ -414,6 +557,144 @@ rotate(SDL_Surface *src, SDL_Surface *dst, Uint32 bgcolor, double sangle,
     }
 }
 
+#if SDL_VERSION_ATLEAST(2, 0, 16)
+/* Larger sizes are left to SDL_SoftStretch, which overflows its 16.16
+ * positions for them */
+#define SCALE_NEAREST_MAX_SIZE 32767
+
+/* Source column of every destination column of a nearest neighbour scale,
+ * sampled at the pixel centers the way SDL_SoftStretch does. Rows use the
+ * same sampling. Returns NULL if out of memory. */
+static int *
+_scale_nearest_columns(int src_w, int dst_w)
+{
+    int *columns = (int *)malloc(dst_w * sizeof(int));
+    Uint32 inc = ((Uint32)src_w << 16) / dst_w;
+    Uint32 pos = inc / 2;
+    int i;
+
+    if (!columns) {
+        return NULL;
+    }
+    for (i = 0; i < dst_w; i++) {
+        columns[i] = (int)(pos >> 16);
+        pos += inc;
+    }
+    return columns;
+}
+
+/* Every source pixel of a 32 bit row repeated factor times */
+static void
+_scale_nearest_repeat32(const Uint32 *src, Uint32 *dst, int n, int factor)
+{
+    int x;
+
+    switch (factor) {
+        case 2:
+            for (x = 0; x < n; x++) {
+                dst[2 * x] = dst[2 * x + 1] = src[x];
+            }
+            break;
+        case 3:
+            for (x = 0; x < n; x++) {
+                dst[3 * x] = dst[3 * x + 1] = dst[3 * x + 2] = src[x];
+            }
+            break;
+        case 4:
+            for (x = 0; x < n; x++) {
+                dst[4 * x] = dst[4 * x + 1] = dst[4 * x + 2] =
+                    dst[4 * x + 3] = src[x];
+            }
+            break;
+    }
+}
+
+/* Nearest neighbour scale of src into dst, giving the same pixels as
+ * SDL_SoftStretch. The source columns are looked up in a table instead of
+ * being stepped through for every row. A destination row showing the same
+ * source row as the one above it is a copy of that row, and integer factor
+ * upscales of 32 bit rows repeat pixels without the table. The formats must
+ * have the same bytes per pixel. Returns -1 if out of memory. Must be called
+ * without the GIL. */
+static int
+_scale_nearest(SDL_Surface *src, SDL_Surface *dst)
+{
+    const int bpp = PG_SURF_BytesPerPixel(src);
+    const int src_w = src->w, dst_w = dst->w;
+    const size_t rowlen = (size_t)dst_w * bpp;
+    Uint8 *srcpix = (Uint8 *)src->pixels, *dstrow = (Uint8 *)dst->pixels;
+    Uint32 inc = ((Uint32)src->h << 16) / dst->h;
+    Uint32 pos = inc / 2;
+    int *columns = _scale_nearest_columns(src_w, dst_w);
+    int factor = 0, x, y, srcy, prevy = -1;
+
+    if (!columns) {
+        return -1;
+    }
+
+    /* an integer factor the table agrees with */
+    if (dst_w % src_w == 0 && dst_w / src_w <= 4) {
+        factor = dst_w / src_w;
+        for (x = 0; x < dst_w; x++) {
+            if (columns[x] != x / factor) {
+                factor = 0;
+                break;
+            }
+        }
+    }
+
+    for (y = 0; y < dst->h; y++, dstrow += dst->pitch) {
+        Uint8 *srcrow;
+
+        srcy = (int)(pos >> 16);
+        pos += inc;
+        if (srcy == prevy) {
+            memcpy(dstrow, dstrow - dst->pitch, rowlen);
+            continue;
+        }
+        prevy = srcy;
+        srcrow = srcpix + (size_t)srcy * src->pitch;
+
+        if (factor == 1) {
+            memcpy(dstrow, srcrow, rowlen);
+        }
+        else if (factor && bpp == 4) {
+            _scale_nearest_repeat32((Uint32 *)srcrow, (Uint32 *)dstrow, src_w,
+                                    factor);
+        }
+        else {
+            switch (bpp) {
+                case 1:
+                    for (x = 0; x < dst_w; x++) {
+                        dstrow[x] = srcrow[columns[x]];
+                    }
+                    break;
+                case 2:
+                    for (x = 0; x < dst_w; x++) {
+                        ((Uint16 *)dstrow)[x] =
+                            ((Uint16 *)srcrow)[columns[x]];
+                    }
+                    break;
+                case 3:
+                    for (x = 0; x < dst_w; x++) {
+                        memcpy(dstrow + 3 * x, srcrow + 3 * columns[x], 3);
+                    }
+                    break;
+                default:
+                    for (x = 0; x < dst_w; x++) {
+                        ((Uint32 *)dstrow)[x] =
+                            ((Uint32 *)srcrow)[columns[x]];
+                    }
+                    break;
+            }
+        }
+    }
+
+    free(columns);
+    return 0;
+}
+#endif /* SDL_VERSION_ATLEAST(2, 0, 16) */
+
 static SDL_Surface *
 scale_to(pgSurfaceObject *srcobj, pgSurfaceObject *dstobj, int width,
          int height)
@@ -469,7 +750,20 @@ scale_to(pgSurfaceObject *srcobj, pgSurfaceObject *dstobj, int width,
         pgSurface_Lock(srcobj);
         Py_BEGIN_ALLOW_THREADS;
 
-        stretch_result_num = PG_SoftStretchNearest(src, NULL, modsurf, NULL);
+#if SDL_VERSION_ATLEAST(2, 0, 16)
+        if (!SDL_MUSTLOCK(modsurf) && src->w <= SCALE_NEAREST_MAX_SIZE &&
+            src->h <= SCALE_NEAREST_MAX_SIZE &&
+            width <= SCALE_NEAREST_MAX_SIZE &&
+            height <= SCALE_NEAREST_MAX_SIZE) {
+            stretch_result_num = _scale_nearest(src, modsurf);
+            if (stretch_result_num < 0) {
+                SDL_OutOfMemory();
+            }
+        }
+        else
+#endif /* SDL_VERSION_ATLEAST(2, 0, 16) */
+            stretch_result_num =
+                PG_SoftStretchNearest(src, NULL, modsurf, NULL);
 
         Py_END_ALLOW_THREADS;
         pgSurface_Unlock(srcobj);
@@ -556,12 +850,16 @@ surf_scale_by(PyObject *self, PyObject *args, PyObject *kwargs)
         return (PyObject *)pgSurface_New(newsurf);
 }
 
+/* Scales by 2, 3 or 4 with the AdvanceMAME ScaleNx rules */
 static PyObject *
-surf_scale2x(PyObject *self, PyObject *args, PyObject *kwargs)
+_scale_nx(PyObject *args, PyObject *kwargs, int factor)
 {
     PyObject *surfobj, *surfobj2 = NULL;
     SDL_Surface *surf;
     SDL_Surface *newsurf;
+    SCALE2X_ROW_P row2x = scale2x_row;
+    SCALE3X_ROW_P row3x = scale3x_row;
+    int result;
     static char *keywords[] = {"surface", "dest_surface", NULL};
 
     if (!PyArg_ParseTupleAndKeywords(args, kwargs, "O!|O!", keywords,
@@ -575,8 +873,8 @@ surf_scale2x(PyObject *self, PyObject *args, PyObject *kwargs)
     /* if the second surface is not there, then make a new one. */
 
     if (!surfobj2) {
-        int width = surf->w * 2;
-        int height = surf->h * 2;
+        int width = surf->w * factor;
+        int height = surf->h * factor;
 
         newsurf = newsurf_fromsurf(surf, width, height);
 
@@ -586,25 +884,47 @@ surf_scale2x(PyObject *self, PyObject *args, PyObject *kwargs)
     else
         newsurf = pgSurface_AsSurface(surfobj2);
 
-    /* check to see if the size is twice as big. */
-    if (newsurf->w != (surf->w * 2) || newsurf->h != (surf->h * 2))
-        return RAISE(PyExc_ValueError, "Destination surface not 2x bigger.");
+    /* check to see if the size is factor times as big. */
+    if (newsurf->w != (surf->w * factor) ||
+        newsurf->h != (surf->h * factor))
+        return PyErr_Format(PyExc_ValueError,
+                            "Destination surface not %dx bigger.", factor);
 
     /* check to see if the format of the surface is the same. */
     if (PG_SURF_BytesPerPixel(surf) != PG_SURF_BytesPerPixel(newsurf))
         return RAISE(PyExc_ValueError,
                      "Source and destination surfaces need the same format.");
 
+#if !defined(__EMSCRIPTEN__)
+    if (pg_has_avx2()) {
+        row2x = scale2x_row_avx2;
+        row3x = scale3x_row_avx2;
+    }
+#if PG_ENABLE_SSE_NEON
+    else if (pg_HasSSE_NEON()) {
+        row2x = scale2x_row_sse2;
+        row3x = scale3x_row_sse2;
+    }
+#endif /* PG_ENABLE_SSE_NEON */
+#endif /* !__EMSCRIPTEN__ */
+
     SDL_LockSurface(newsurf);
     SDL_LockSurface(surf);
 
     Py_BEGIN_ALLOW_THREADS;
-    scale2x(surf, newsurf);
+    result = scalenx(surf, newsurf, factor, SDL_GetCPUCount(), row2x, row3x);
     Py_END_ALLOW_THREADS;
 
     SDL_UnlockSurface(surf);
     SDL_UnlockSurface(newsurf);
 
+    if (result < 0) {
+        if (!surfobj2) {
+            SDL_FreeSurface(newsurf);
+        }
+        return PyErr_NoMemory();
+    }
+
     if (surfobj2) {
         Py_INCREF(surfobj2);
         return surfobj2;
@@ -614,140 +934,536 @@ surf_scale2x(PyObject *self, PyObject *args, PyObject *kwargs)
 }
 
 static PyObject *
-surf_rotate(PyObject *self, PyObject *args, PyObject *kwargs)
+surf_scale2x(PyObject *self, PyObject *args, PyObject *kwargs)
 {
-    pgSurfaceObject *surfobj;
-    SDL_Surface *surf, *newsurf;
-    float angle;
+    return _scale_nx(args, kwargs, 2);
+}
 
-    double radangle, sangle, cangle;
-    double x, y, cx, cy, sx, sy;
-    int nxmax, nymax;
-    Uint32 bgcolor;
-    static char *keywords[] = {"surface", "angle", NULL};
+static PyObject *
+surf_scale3x(PyObject *self, PyObject *args, PyObject *kwargs)
+{
+    return _scale_nx(args, kwargs, 3);
+}
 
-    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "O!f", keywords,
-                                     &pgSurface_Type, &surfobj, &angle))
-        return NULL;
-    surf = pgSurface_AsSurface(surfobj);
-    SURF_INIT_CHECK(surf)
+static PyObject *
+surf_scale4x(PyObject *self, PyObject *args, PyObject *kwargs)
+{
+    return _scale_nx(args, kwargs, 4);
+}
 
-    if (surf->w < 1 || surf->h < 1) {
-        Py_INCREF(surfobj);
-        return (PyObject *)surfobj;
-    }
+/* Result cache
+ *
+ * Keys are (source address, transform, angle, scale) tuples. Entries are
+ * (weakref to source, source version, result, result version, size)
+ * tuples, so an entry is only used while the source is the same object and
+ * neither the source (or the surfaces it is a subsurface of) nor the shared
+ * result have been changed since. Locked surfaces are never cached, their
+ * pixels may be changing through an array or buffer view.
+ */
+#define CACHE_ROTATE 0
+#define CACHE_ROTOZOOM 1
 
-    if (PG_SURF_BytesPerPixel(surf) == 0 || PG_SURF_BytesPerPixel(surf) > 4)
-        return RAISE(PyExc_ValueError,
-                     "unsupported Surface bit depth for transform");
+/* Returns pgSurface_GetVersion(surfobj) + 1, or 0 if surfobj or any of the
+ * surfaces it is a subsurface of is locked */
+static Uint64
+_cache_version(pgSurfaceObject *surfobj)
+{
+    pgSurfaceObject *cur = surfobj;
 
-    if (!(fmod((double)angle, (double)90.0f))) {
-        pgSurface_Lock(surfobj);
+    while (cur) {
+        if (!cur->surf || cur->surf->locked) {
+            return 0;
+        }
+        cur = cur->subsurface ? (pgSurfaceObject *)cur->subsurface->owner
+                              : NULL;
+    }
+    return pgSurface_GetVersion(surfobj) + 1;
+}
 
-        /* The function releases GIL internally, don't release here */
-        newsurf = rotate90(surf, (int)angle);
+static int
+_cache_remove(struct _module_state *st, PyObject *key, PyObject *entry)
+{
+    st->cache_bytes -= PyLong_AsSsize_t(PyTuple_GET_ITEM(entry, 4));
+    return PyDict_DelItem(st->cache, key);
+}
 
-        pgSurface_Unlock(surfobj);
-        if (!newsurf)
-            return NULL;
-        return (PyObject *)pgSurface_New(newsurf);
+/* Removes least recently used entries until there is room for nbytes */
+static int
+_cache_evict(struct _module_state *st, Py_ssize_t nbytes)
+{
+    PyObject *key, *entry;
+    Py_ssize_t pos;
+    int result;
+
+    while (st->cache_bytes + nbytes > st->cache_max_bytes &&
+           PyDict_Size(st->cache) > 0) {
+        pos = 0;
+        PyDict_Next(st->cache, &pos, &key, &entry);
+        Py_INCREF(key);
+        result = _cache_remove(st, key, entry);
+        Py_DECREF(key);
+        if (result) {
+            return -1;
+        }
+        st->cache_evictions++;
     }
+    return 0;
+}
 
-    radangle = angle * .01745329251994329;
-    sangle = sin(radangle);
-    cangle = cos(radangle);
-
-    x = surf->w;
-    y = surf->h;
-    cx = cangle * x;
-    cy = cangle * y;
-    sx = sangle * x;
-    sy = sangle * y;
-    nxmax = (int)(MAX(MAX(MAX(fabs(cx + sy), fabs(cx - sy)), fabs(-cx + sy)),
-                      fabs(-cx - sy)));
-    nymax = (int)(MAX(MAX(MAX(fabs(sx + cy), fabs(sx - cy)), fabs(-sx + cy)),
-                      fabs(-sx - cy)));
+/* Looks up a cached result. Returns 1 with a new reference in *result on a
+ * hit, 0 on a miss and -1 on error. On a miss, *key is set to the key the
+ * result should be stored under with _cache_store, or NULL if it should not
+ * be cached. Called with st->lock held. */
+static int
+_cache_lookup_locked(struct _module_state *st, pgSurfaceObject *surfobj,
+                     int kind, double angle, double scale, PyObject **key,
+                     PyObject **result)
+{
+    PyObject *entry, *cached;
+    Uint64 version;
 
-    newsurf = newsurf_fromsurf(surf, nxmax, nymax);
-    if (!newsurf)
-        return NULL;
+    *key = NULL;
+    if (!st->cache) {
+        return 0;
+    }
+    version = _cache_version(surfobj);
+    if (!version) {
+        return 0;
+    }
 
-    /* get the background color */
-    if (!SDL_HasColorKey(surf)) {
-        SDL_LockSurface(surf);
-        switch (PG_SURF_BytesPerPixel(surf)) {
-            case 1:
-                bgcolor = *(Uint8 *)surf->pixels;
-                break;
-            case 2:
-                bgcolor = *(Uint16 *)surf->pixels;
-                break;
-            case 4:
-                bgcolor = *(Uint32 *)surf->pixels;
-                break;
-            default: /*case 3:*/
-#if SDL_BYTEORDER == SDL_LIL_ENDIAN
-                bgcolor = (((Uint8 *)surf->pixels)[0]) +
-                          (((Uint8 *)surf->pixels)[1] << 8) +
-                          (((Uint8 *)surf->pixels)[2] << 16);
-#else
-                bgcolor = (((Uint8 *)surf->pixels)[2]) +
-                          (((Uint8 *)surf->pixels)[1] << 8) +
-                          (((Uint8 *)surf->pixels)[0] << 16);
-#endif
-        }
-        SDL_UnlockSurface(surf);
-        bgcolor &= ~surf->format->Amask;
+    *key = Py_BuildValue("(Nidd)", PyLong_FromVoidPtr(surfobj), kind, angle,
+                         scale);
+    if (!*key) {
+        return -1;
     }
-    else {
-        SDL_GetColorKey(surf, &bgcolor);
+    entry = PyDict_GetItemWithError(st->cache, *key);
+    if (!entry) {
+        if (PyErr_Occurred()) {
+            Py_CLEAR(*key);
+            return -1;
+        }
+        st->cache_misses++;
+        return 0;
     }
 
-    SDL_LockSurface(newsurf);
-    pgSurface_Lock(surfobj);
+    cached = PyTuple_GET_ITEM(entry, 2);
+    if (PyWeakref_GetObject(PyTuple_GET_ITEM(entry, 0)) !=
+            (PyObject *)surfobj ||
+        PyLong_AsUnsignedLongLong(PyTuple_GET_ITEM(entry, 1)) != version ||
+        PyLong_AsUnsignedLongLong(PyTuple_GET_ITEM(entry, 3)) !=
+            _cache_version((pgSurfaceObject *)cached)) {
+        /* stale, the surface or the shared result have been changed, or the
+         * address belongs to a new surface */
+        if (_cache_remove(st, *key, entry)) {
+            Py_CLEAR(*key);
+            return -1;
+        }
+        st->cache_misses++;
+        return 0;
+    }
 
-    Py_BEGIN_ALLOW_THREADS;
-    rotate(surf, newsurf, bgcolor, sangle, cangle);
-    Py_END_ALLOW_THREADS;
+    /* move to the most recently used end */
+    Py_INCREF(entry);
+    if (PyDict_DelItem(st->cache, *key) ||
+        PyDict_SetItem(st->cache, *key, entry)) {
+        Py_DECREF(entry);
+        Py_CLEAR(*key);
+        return -1;
+    }
+    Py_DECREF(entry);
+    Py_CLEAR(*key);
 
-    pgSurface_Unlock(surfobj);
-    SDL_UnlockSurface(newsurf);
+    st->cache_hits++;
+    Py_INCREF(cached);
+    *result = cached;
+    return 1;
+}
 
-    return (PyObject *)pgSurface_New(newsurf);
+static int
+_cache_lookup(struct _module_state *st, pgSurfaceObject *surfobj, int kind,
+              double angle, double scale, PyObject **key, PyObject **result)
+{
+    int ret;
+
+    pg_mutex_lock(&st->lock);
+    ret = _cache_lookup_locked(st, surfobj, kind, angle, scale, key, result);
+    pg_mutex_unlock(&st->lock);
+    return ret;
+}
+
+/* Stores result under the key from _cache_lookup, stealing the key.
+ * Returns -1 on error. Called with st->lock held. */
+static int
+_cache_store_locked(struct _module_state *st, PyObject *key,
+                    pgSurfaceObject *surfobj, PyObject *result)
+{
+    SDL_Surface *surf = pgSurface_AsSurface(result);
+    Py_ssize_t nbytes = (Py_ssize_t)surf->h * surf->pitch;
+    Uint64 version, result_version;
+    PyObject *entry;
+
+    version = _cache_version(surfobj);
+    result_version = _cache_version((pgSurfaceObject *)result);
+    if (!st->cache || !version || !result_version ||
+        nbytes > st->cache_max_bytes) {
+        Py_DECREF(key);
+        return 0;
+    }
+    if (_cache_evict(st, nbytes)) {
+        Py_DECREF(key);
+        return -1;
+    }
+
+    entry = Py_BuildValue("(NKOKn)", PyWeakref_NewRef((PyObject *)surfobj,
+                                                      NULL),
+                          (unsigned long long)version, result,
+                          (unsigned long long)result_version, nbytes);
+    if (!entry || PyDict_SetItem(st->cache, key, entry)) {
+        Py_XDECREF(entry);
+        Py_DECREF(key);
+        return -1;
+    }
+    Py_DECREF(entry);
+    Py_DECREF(key);
+    st->cache_bytes += nbytes;
+    return 0;
+}
+
+static int
+_cache_store(struct _module_state *st, PyObject *key,
+             pgSurfaceObject *surfobj, PyObject *result)
+{
+    int ret;
+
+    pg_mutex_lock(&st->lock);
+    ret = _cache_store_locked(st, key, surfobj, result);
+    pg_mutex_unlock(&st->lock);
+    return ret;
 }
 
+/* Wraps newsurf in a Surface and, when key is set, stores it in the cache */
 static PyObject *
-surf_flip(PyObject *self, PyObject *args, PyObject *kwargs)
+_cache_result(struct _module_state *st, PyObject *key,
+              pgSurfaceObject *surfobj, SDL_Surface *newsurf)
 {
-    pgSurfaceObject *surfobj;
-    SDL_Surface *surf, *newsurf;
-    int xaxis, yaxis;
-    int loopx, loopy;
-    int srcpitch, dstpitch;
-    Uint8 *srcpix, *dstpix;
-    static char *keywords[] = {"surface", "flip_x", "flip_y", NULL};
+    PyObject *result = (PyObject *)pgSurface_New(newsurf);
 
-    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "O!ii", keywords,
-                                     &pgSurface_Type, &surfobj, &xaxis,
-                                     &yaxis))
+    if (!key) {
+        return result;
+    }
+    if (!result) {
+        Py_DECREF(key);
+        return NULL;
+    }
+    if (_cache_store(st, key, surfobj, result)) {
+        Py_DECREF(result);
+        return NULL;
+    }
+    return result;
+}
+
+static PyObject *
+surf_enable_cache(PyObject *self, PyObject *arg)
+{
+    struct _module_state *st = GETSTATE(self);
+    Py_ssize_t max_bytes = PyLong_AsSsize_t(arg);
+
+    if (max_bytes == -1 && PyErr_Occurred()) {
+        return NULL;
+    }
+    if (max_bytes <= 0) {
+        return RAISE(PyExc_ValueError, "max_bytes must be positive");
+    }
+    pg_mutex_lock(&st->lock);
+    if (!st->cache) {
+        st->cache = PyDict_New();
+        if (!st->cache) {
+            pg_mutex_unlock(&st->lock);
+            return NULL;
+        }
+        st->cache_bytes = 0;
+    }
+    st->cache_max_bytes = max_bytes;
+    st->cache_hits = st->cache_misses = st->cache_evictions = 0;
+    if (_cache_evict(st, 0)) {
+        pg_mutex_unlock(&st->lock);
+        return NULL;
+    }
+    pg_mutex_unlock(&st->lock);
+    Py_RETURN_NONE;
+}
+
+static PyObject *
+surf_disable_cache(PyObject *self, PyObject *_null)
+{
+    struct _module_state *st = GETSTATE(self);
+    PyObject *cache;
+
+    pg_mutex_lock(&st->lock);
+    cache = st->cache;
+    st->cache = NULL;
+    st->cache_bytes = 0;
+    st->cache_max_bytes = 0;
+    pg_mutex_unlock(&st->lock);
+    /* the results may take a while to free, do it outside of the lock */
+    Py_XDECREF(cache);
+    Py_RETURN_NONE;
+}
+
+static PyObject *
+surf_clear_cache(PyObject *self, PyObject *_null)
+{
+    struct _module_state *st = GETSTATE(self);
+
+    pg_mutex_lock(&st->lock);
+    if (st->cache) {
+        PyDict_Clear(st->cache);
+        st->cache_bytes = 0;
+    }
+    pg_mutex_unlock(&st->lock);
+    Py_RETURN_NONE;
+}
+
+static PyObject *
+surf_get_cache_stats(PyObject *self, PyObject *_null)
+{
+    struct _module_state *st = GETSTATE(self);
+    PyObject *stats;
+
+    pg_mutex_lock(&st->lock);
+    stats = Py_BuildValue(
+        "{snsnsnsnsnsn}", "hits", st->cache_hits, "misses", st->cache_misses,
+        "evictions", st->cache_evictions, "entries",
+        st->cache ? PyDict_Size(st->cache) : (Py_ssize_t)0, "bytes",
+        st->cache_bytes, "max_bytes", st->cache_max_bytes);
+    pg_mutex_unlock(&st->lock);
+    return stats;
+}
+
+static PyObject *
+surf_rotate(PyObject *self, PyObject *args, PyObject *kwargs)
+{
+    struct _module_state *st = GETSTATE(self);
+    pgSurfaceObject *surfobj, *dstobj = NULL;
+    SDL_Surface *surf, *newsurf, *dst = NULL;
+    PyObject *key = NULL, *result;
+    float angle;
+
+    double radangle, sangle, cangle;
+    double x, y, cx, cy, sx, sy;
+    int nxmax, nymax;
+    Uint32 bgcolor;
+    static char *keywords[] = {"surface", "angle", "dest_surface", NULL};
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "O!f|O!", keywords,
+                                     &pgSurface_Type, &surfobj, &angle,
+                                     &pgSurface_Type, &dstobj))
         return NULL;
     surf = pgSurface_AsSurface(surfobj);
     SURF_INIT_CHECK(surf)
+    if (dstobj) {
+        dst = pgSurface_AsSurface(dstobj);
+    }
 
-    newsurf = newsurf_fromsurf(surf, surf->w, surf->h);
-    if (!newsurf)
+    if (surf->w < 1 || surf->h < 1) {
+        if (dstobj) {
+            if (_check_dest(dst, surf, surf->format->format, surf->w,
+                            surf->h)) {
+                return NULL;
+            }
+            surfobj = dstobj;
+        }
+        Py_INCREF(surfobj);
+        return (PyObject *)surfobj;
+    }
+
+    if (PG_SURF_BytesPerPixel(surf) == 0 || PG_SURF_BytesPerPixel(surf) > 4)
+        return RAISE(PyExc_ValueError,
+                     "unsupported Surface bit depth for transform");
+
+    /* results written into a dest_surface aren't cached */
+    if (!dstobj) {
+        switch (_cache_lookup(st, surfobj, CACHE_ROTATE, angle, 0.0, &key,
+                              &result)) {
+            case 1:
+                return result;
+            case -1:
+                return NULL;
+        }
+    }
+
+    if (!(fmod((double)angle, (double)90.0f))) {
+        pgSurface_Lock(surfobj);
+
+        /* The function releases GIL internally, don't release here */
+        newsurf = rotate90(surf, dst, (int)angle, st->transpose32,
+                           st->flip_row32);
+
+        pgSurface_Unlock(surfobj);
+        if (!newsurf) {
+            Py_XDECREF(key);
+            return NULL;
+        }
+        if (dstobj) {
+            Py_INCREF(dstobj);
+            return (PyObject *)dstobj;
+        }
+        return _cache_result(st, key, surfobj, newsurf);
+    }
+
+    radangle = angle * .01745329251994329;
+    sangle = sin(radangle);
+    cangle = cos(radangle);
+
+    x = surf->w;
+    y = surf->h;
+    cx = cangle * x;
+    cy = cangle * y;
+    sx = sangle * x;
+    sy = sangle * y;
+    nxmax = (int)(MAX(MAX(MAX(fabs(cx + sy), fabs(cx - sy)), fabs(-cx + sy)),
+                      fabs(-cx - sy)));
+    nymax = (int)(MAX(MAX(MAX(fabs(sx + cy), fabs(sx - cy)), fabs(-sx + cy)),
+                      fabs(-sx - cy)));
+
+    if (dst) {
+        if (_check_dest(dst, surf, surf->format->format, nxmax, nymax)) {
+            return NULL;
+        }
+        newsurf = dst;
+    }
+    else if (!(newsurf = newsurf_fromsurf(surf, nxmax, nymax))) {
+        Py_XDECREF(key);
         return NULL;
+    }
 
-    srcpitch = surf->pitch;
-    dstpitch = newsurf->pitch;
+    /* get the background color */
+    if (!SDL_HasColorKey(surf)) {
+        SDL_LockSurface(surf);
+        switch (PG_SURF_BytesPerPixel(surf)) {
+            case 1:
+                bgcolor = *(Uint8 *)surf->pixels;
+                break;
+            case 2:
+                bgcolor = *(Uint16 *)surf->pixels;
+                break;
+            case 4:
+                bgcolor = *(Uint32 *)surf->pixels;
+                break;
+            default: /*case 3:*/
+#if SDL_BYTEORDER == SDL_LIL_ENDIAN
+                bgcolor = (((Uint8 *)surf->pixels)[0]) +
+                          (((Uint8 *)surf->pixels)[1] << 8) +
+                          (((Uint8 *)surf->pixels)[2] << 16);
+#else
+                bgcolor = (((Uint8 *)surf->pixels)[2]) +
+                          (((Uint8 *)surf->pixels)[1] << 8) +
+                          (((Uint8 *)surf->pixels)[0] << 16);
+#endif
+        }
+        SDL_UnlockSurface(surf);
+        bgcolor &= ~surf->format->Amask;
+    }
+    else {
+        SDL_GetColorKey(surf, &bgcolor);
+    }
 
     SDL_LockSurface(newsurf);
     pgSurface_Lock(surfobj);
 
-    srcpix = (Uint8 *)surf->pixels;
-    dstpix = (Uint8 *)newsurf->pixels;
-
     Py_BEGIN_ALLOW_THREADS;
+    rotate(surf, newsurf, bgcolor, sangle, cangle, st->rotate_nearest_row);
+    Py_END_ALLOW_THREADS;
+
+    pgSurface_Unlock(surfobj);
+    SDL_UnlockSurface(newsurf);
+
+    if (dstobj) {
+        Py_INCREF(dstobj);
+        return (PyObject *)dstobj;
+    }
+    return _cache_result(st, key, surfobj, newsurf);
+}
+
+/* Swaps the rows, and the pixels within the rows, of a surface */
+#define FLIP_ROWS_IP(type)                                                  \
+    for (loopy = 0; loopy < surf->h; ++loopy) {                             \
+        type *left = (type *)((Uint8 *)surf->pixels + loopy * surf->pitch); \
+        type *right = left + surf->w - 1;                                   \
+        for (; left < right; ++left, --right) {                             \
+            type tmp = *left;                                               \
+            *left = *right;                                                 \
+            *right = tmp;                                                   \
+        }                                                                   \
+    }
+
+static void
+flip_ip(SDL_Surface *surf, int xaxis, int yaxis, FLIP_ROW32_P flip_row)
+{
+    const int bpp = PG_SURF_BytesPerPixel(surf);
+    Uint8 tmp[256], *top, *bottom, *left, *right;
+    int loopy, n, chunk;
+
+    if (yaxis) {
+        for (loopy = 0; loopy < surf->h / 2; ++loopy) {
+            top = (Uint8 *)surf->pixels + loopy * surf->pitch;
+            bottom = (Uint8 *)surf->pixels +
+                     (surf->h - 1 - loopy) * surf->pitch;
+            for (n = surf->w * bpp; n > 0; n -= chunk) {
+                chunk = MIN(n, (int)sizeof(tmp));
+                memcpy(tmp, top, chunk);
+                memcpy(top, bottom, chunk);
+                memcpy(bottom, tmp, chunk);
+                top += chunk;
+                bottom += chunk;
+            }
+        }
+    }
+    if (!xaxis) {
+        return;
+    }
+    switch (bpp) {
+        case 1:
+            FLIP_ROWS_IP(Uint8)
+            break;
+        case 2:
+            FLIP_ROWS_IP(Uint16)
+            break;
+        case 4:
+            for (loopy = 0; loopy < surf->h; ++loopy) {
+                Uint32 *row =
+                    (Uint32 *)((Uint8 *)surf->pixels + loopy * surf->pitch);
+                flip_row(row, row, surf->w);
+            }
+            break;
+        case 3:
+            for (loopy = 0; loopy < surf->h; ++loopy) {
+                left = (Uint8 *)surf->pixels + loopy * surf->pitch;
+                right = left + surf->w * 3 - 3;
+                for (; left < right; left += 3, right -= 3) {
+                    memcpy(tmp, left, 3);
+                    memcpy(left, right, 3);
+                    memcpy(right, tmp, 3);
+                }
+            }
+            break;
+    }
+}
+
+/* Writes the flipped surf into newsurf, which may be surf itself */
+static void
+flip(SDL_Surface *surf, SDL_Surface *newsurf, int xaxis, int yaxis,
+     FLIP_ROW32_P flip_row)
+{
+    int loopx, loopy;
+    int srcpitch = surf->pitch, dstpitch = newsurf->pitch;
+    Uint8 *srcpix = (Uint8 *)surf->pixels;
+    Uint8 *dstpix = (Uint8 *)newsurf->pixels;
+
+    if (surf == newsurf) {
+        flip_ip(surf, xaxis, yaxis, flip_row);
+        return;
+    }
 
     if (!xaxis) {
         if (!yaxis) {
@@ -789,15 +1505,11 @@ surf_flip(PyObject *self, PyObject *args, PyObject *kwargs)
                     }
                     break;
                 case 4:
-                    for (loopy = 0; loopy < surf->h; ++loopy) {
-                        Uint32 *dst = (Uint32 *)(dstpix + loopy * dstpitch);
-                        Uint32 *src =
-                            ((Uint32 *)(srcpix +
-                                        (surf->h - 1 - loopy) * srcpitch)) +
-                            surf->w - 1;
-                        for (loopx = 0; loopx < surf->w; ++loopx)
-                            *dst++ = *src--;
-                    }
+                    for (loopy = 0; loopy < surf->h; ++loopy)
+                        flip_row((Uint32 *)(srcpix + (surf->h - 1 - loopy) *
+                                                         srcpitch),
+                                 (Uint32 *)(dstpix + loopy * dstpitch),
+                                 surf->w);
                     break;
                 case 3:
                     for (loopy = 0; loopy < surf->h; ++loopy) {
@@ -836,13 +1548,10 @@ surf_flip(PyObject *self, PyObject *args, PyObject *kwargs)
                     }
                     break;
                 case 4:
-                    for (loopy = 0; loopy < surf->h; ++loopy) {
-                        Uint32 *dst = (Uint32 *)(dstpix + loopy * dstpitch);
-                        Uint32 *src = ((Uint32 *)(srcpix + loopy * srcpitch)) +
-                                      surf->w - 1;
-                        for (loopx = 0; loopx < surf->w; ++loopx)
-                            *dst++ = *src--;
-                    }
+                    for (loopy = 0; loopy < surf->h; ++loopy)
+                        flip_row((Uint32 *)(srcpix + loopy * srcpitch),
+                                 (Uint32 *)(dstpix + loopy * dstpitch),
+                                 surf->w);
                     break;
                 case 3:
                     for (loopy = 0; loopy < surf->h; ++loopy) {
@@ -859,48 +1568,152 @@ surf_flip(PyObject *self, PyObject *args, PyObject *kwargs)
             }
         }
     }
-    Py_END_ALLOW_THREADS;
-
-    pgSurface_Unlock(surfobj);
-    SDL_UnlockSurface(newsurf);
-    return (PyObject *)pgSurface_New(newsurf);
 }
 
 static PyObject *
-surf_rotozoom(PyObject *self, PyObject *args, PyObject *kwargs)
+surf_flip(PyObject *self, PyObject *args, PyObject *kwargs)
 {
-    pgSurfaceObject *surfobj;
-    SDL_Surface *surf, *newsurf, *surf32;
-    float scale, angle;
-    static char *keywords[] = {"surface", "angle", "scale", NULL};
+    pgSurfaceObject *surfobj, *dstobj = NULL;
+    SDL_Surface *surf, *newsurf;
+    int xaxis, yaxis;
+    static char *keywords[] = {"surface", "flip_x", "flip_y", "dest_surface",
+                               NULL};
 
-    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "O!ff", keywords,
-                                     &pgSurface_Type, &surfobj, &angle,
-                                     &scale))
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "O!ii|O!", keywords,
+                                     &pgSurface_Type, &surfobj, &xaxis,
+                                     &yaxis, &pgSurface_Type, &dstobj))
         return NULL;
     surf = pgSurface_AsSurface(surfobj);
     SURF_INIT_CHECK(surf)
 
-    if (scale == 0.0 || surf->w == 0 || surf->h == 0) {
-        newsurf = newsurf_fromsurf(surf, 0, 0);
-        return (PyObject *)pgSurface_New(newsurf);
-    }
-
-    if (PG_SURF_BitsPerPixel(surf) == 32) {
-        surf32 = surf;
-        pgSurface_Lock(surfobj);
+    if (!dstobj) {
+        newsurf = newsurf_fromsurf(surf, surf->w, surf->h);
+        if (!newsurf)
+            return NULL;
     }
     else {
-        Py_BEGIN_ALLOW_THREADS;
-        surf32 = PG_CreateSurface(surf->w, surf->h, SDL_PIXELFORMAT_ABGR8888);
-        SDL_BlitSurface(surf, NULL, surf32, NULL);
+        newsurf = pgSurface_AsSurface(dstobj);
+        SURF_INIT_CHECK(newsurf)
+        /* the only transform that can be done in place */
+        if (newsurf != surf &&
+            _check_dest(newsurf, surf, surf->format->format, surf->w,
+                        surf->h)) {
+            return NULL;
+        }
+    }
+
+    SDL_LockSurface(newsurf);
+    pgSurface_Lock(surfobj);
+    Py_BEGIN_ALLOW_THREADS;
+    flip(surf, newsurf, xaxis, yaxis, GETSTATE(self)->flip_row32);
+    Py_END_ALLOW_THREADS;
+    pgSurface_Unlock(surfobj);
+    SDL_UnlockSurface(newsurf);
+
+    if (dstobj) {
+        Py_INCREF(dstobj);
+        return (PyObject *)dstobj;
+    }
+    return (PyObject *)pgSurface_New(newsurf);
+}
+
+static PyObject *
+surf_flip_ip(PyObject *self, PyObject *args, PyObject *kwargs)
+{
+    pgSurfaceObject *surfobj;
+    SDL_Surface *surf;
+    int xaxis, yaxis;
+    static char *keywords[] = {"surface", "flip_x", "flip_y", NULL};
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "O!ii", keywords,
+                                     &pgSurface_Type, &surfobj, &xaxis,
+                                     &yaxis))
+        return NULL;
+    surf = pgSurface_AsSurface(surfobj);
+    SURF_INIT_CHECK(surf)
+
+    pgSurface_Lock(surfobj);
+    Py_BEGIN_ALLOW_THREADS;
+    flip_ip(surf, xaxis, yaxis, GETSTATE(self)->flip_row32);
+    Py_END_ALLOW_THREADS;
+    pgSurface_Unlock(surfobj);
+    Py_RETURN_NONE;
+}
+
+static PyObject *
+surf_rotozoom(PyObject *self, PyObject *args, PyObject *kwargs)
+{
+    struct _module_state *st = GETSTATE(self);
+    pgSurfaceObject *surfobj, *dstobj = NULL;
+    SDL_Surface *surf, *newsurf, *surf32, *dst = NULL;
+    PyObject *key = NULL, *result;
+    float scale, angle;
+    int width, height;
+    static char *keywords[] = {"surface", "angle", "scale", "dest_surface",
+                               NULL};
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "O!ff|O!", keywords,
+                                     &pgSurface_Type, &surfobj, &angle,
+                                     &scale, &pgSurface_Type, &dstobj))
+        return NULL;
+    surf = pgSurface_AsSurface(surfobj);
+    SURF_INIT_CHECK(surf)
+
+    if (scale == 0.0 || surf->w == 0 || surf->h == 0) {
+        if (dstobj) {
+            if (_check_dest(pgSurface_AsSurface(dstobj), surf,
+                            surf->format->format, 0, 0)) {
+                return NULL;
+            }
+            Py_INCREF(dstobj);
+            return (PyObject *)dstobj;
+        }
+        newsurf = newsurf_fromsurf(surf, 0, 0);
+        return (PyObject *)pgSurface_New(newsurf);
+    }
+
+    /* results written into a dest_surface aren't cached */
+    if (dstobj) {
+        dst = pgSurface_AsSurface(dstobj);
+        rotozoomSurfaceResultSize(surf->w, surf->h, angle, scale, &width,
+                                  &height);
+        /* other depths are rotated as ABGR8888 */
+        if (_check_dest(dst, surf,
+                        PG_SURF_BitsPerPixel(surf) == 32
+                            ? surf->format->format
+                            : SDL_PIXELFORMAT_ABGR8888,
+                        width, height)) {
+            return NULL;
+        }
+    }
+    else {
+        switch (_cache_lookup(st, surfobj, CACHE_ROTOZOOM, angle, scale,
+                              &key, &result)) {
+            case 1:
+                return result;
+            case -1:
+                return NULL;
+        }
+    }
+
+    if (PG_SURF_BitsPerPixel(surf) == 32) {
+        surf32 = surf;
+        pgSurface_Lock(surfobj);
+    }
+    else {
+        Py_BEGIN_ALLOW_THREADS;
+        surf32 = PG_CreateSurface(surf->w, surf->h, SDL_PIXELFORMAT_ABGR8888);
+        SDL_BlitSurface(surf, NULL, surf32, NULL);
         Py_END_ALLOW_THREADS;
     }
 
     Py_BEGIN_ALLOW_THREADS;
-    newsurf = rotozoomSurface(surf32, angle, scale, 1);
+    newsurf = rotozoomSurface(surf32, angle, scale, 1,
+                              st->rotozoom_smooth_run, st->rotozoom_threads,
+                              dst);
     Py_END_ALLOW_THREADS;
     if (newsurf == NULL) {
+        Py_XDECREF(key);
         PyErr_SetString(pgExc_SDLError, SDL_GetError());
         return NULL;
     }
@@ -909,13 +1722,42 @@ surf_rotozoom(PyObject *self, PyObject *args, PyObject *kwargs)
         pgSurface_Unlock(surfobj);
     else
         SDL_FreeSurface(surf32);
-    return (PyObject *)pgSurface_New(newsurf);
+    if (dstobj) {
+        Py_INCREF(dstobj);
+        return (PyObject *)dstobj;
+    }
+    return _cache_result(st, key, surfobj, newsurf);
+}
+
+static PyObject *
+surf_set_rotozoom_threads(PyObject *self, PyObject *arg)
+{
+    long num_threads = PyLong_AsLong(arg);
+
+    if (num_threads == -1 && PyErr_Occurred()) {
+        return NULL;
+    }
+    if (num_threads < 0) {
+        return RAISE(PyExc_ValueError,
+                     "the number of rotozoom threads must not be negative");
+    }
+    if (num_threads == 0) {
+        num_threads = SDL_GetCPUCount();
+    }
+    GETSTATE(self)->rotozoom_threads =
+        (int)MIN(num_threads, ROTOZOOM_MAX_THREADS);
+    Py_RETURN_NONE;
+}
+
+static PyObject *
+surf_get_rotozoom_threads(PyObject *self, PyObject *_null)
+{
+    return PyLong_FromLong(GETSTATE(self)->rotozoom_threads);
 }
 
 static SDL_Surface *
-chop(SDL_Surface *src, int x, int y, int width, int height)
+chop(SDL_Surface *src, SDL_Surface *dst, int x, int y, int width, int height)
 {
-    SDL_Surface *dst;
     int dstwidth, dstheight;
     char *srcpix, *dstpix, *srcrow, *dstrow;
     int srcstepx, srcstepy, dststepx, dststepy;
@@ -937,9 +1779,15 @@ chop(SDL_Surface *src, int x, int y, int width, int height)
     dstwidth = src->w - width;
     dstheight = src->h - height;
 
-    dst = newsurf_fromsurf(src, dstwidth, dstheight);
-    if (!dst)
+    if (!dst) {
+        dst = newsurf_fromsurf(src, dstwidth, dstheight);
+        if (!dst)
+            return NULL;
+    }
+    else if (_check_dest(dst, src, src->format->format, dstwidth,
+                         dstheight)) {
         return NULL;
+    }
 
     Py_BEGIN_ALLOW_THREADS;
     SDL_LockSurface(dst);
@@ -986,13 +1834,14 @@ chop(SDL_Surface *src, int x, int y, int width, int height)
 static PyObject *
 surf_chop(PyObject *self, PyObject *args, PyObject *kwargs)
 {
-    PyObject *surfobj, *rectobj;
+    PyObject *surfobj, *rectobj, *dstobj = NULL;
     SDL_Surface *surf, *newsurf;
     SDL_Rect *rect, temp;
-    static char *keywords[] = {"surface", "rect", NULL};
+    static char *keywords[] = {"surface", "rect", "dest_surface", NULL};
 
-    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "O!O", keywords,
-                                     &pgSurface_Type, &surfobj, &rectobj))
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "O!O|O!", keywords,
+                                     &pgSurface_Type, &surfobj, &rectobj,
+                                     &pgSurface_Type, &dstobj))
         return NULL;
 
     if (!(rect = pgRect_FromObject(rectobj, &temp)))
@@ -1002,8 +1851,15 @@ surf_chop(PyObject *self, PyObject *args, PyObject *kwargs)
     SURF_INIT_CHECK(surf)
 
     /* The function releases GIL internally, don't release here */
-    newsurf = chop(surf, rect->x, rect->y, rect->w, rect->h);
-
+    newsurf = chop(surf, dstobj ? pgSurface_AsSurface(dstobj) : NULL,
+                   rect->x, rect->y, rect->w, rect->h);
+    if (!newsurf) {
+        return NULL;
+    }
+    if (dstobj) {
+        Py_INCREF(dstobj);
+        return dstobj;
+    }
     return (PyObject *)pgSurface_New(newsurf);
 }
 
@@ -1202,6 +2058,7 @@ static void
 filter_expand_Y_ONLYC(Uint8 *srcpix, Uint8 *dstpix, int width, int srcpitch,
                       int dstpitch, int srcheight, int dstheight)
 {
+    int dstdiff = dstpitch - (width * 4);
     int x, y;
 
     for (y = 0; y < dstheight; y++) {
@@ -1220,6 +2077,7 @@ filter_expand_Y_ONLYC(Uint8 *srcpix, Uint8 *dstpix, int width, int srcpitch,
             *dstpix++ =
                 (Uint8)(((*srcrow0++ * ymult0) + (*srcrow1++ * ymult1)) >> 16);
         }
+        dstpix += dstdiff;
     }
 }
 
@@ -1230,9 +2088,20 @@ smoothscale_init(struct _module_state *st)
         return;
     }
 
+    st->smoothscale_threads = 1;
+
 #if !defined(__EMSCRIPTEN__)
 #if PG_ENABLE_SSE_NEON
-    if (SDL_HasSSE2()) {
+    /* The AVX2 backend shares the X shrink filter with SSE2 */
+    if (pg_has_avx2()) {
+        st->filter_type = "AVX2";
+        st->filter_shrink_X = filter_shrink_X_SSE2;
+        st->filter_shrink_Y = filter_shrink_Y_AVX2;
+        st->filter_expand_X = filter_expand_X_AVX2;
+        st->filter_expand_Y = filter_expand_Y_AVX2;
+        return;
+    }
+    if (pg_HasSSE_NEON() && SDL_HasSSE2()) {
         st->filter_type = "SSE2";
         st->filter_shrink_X = filter_shrink_X_SSE2;
         st->filter_shrink_Y = filter_shrink_Y_SSE2;
@@ -1240,7 +2109,7 @@ smoothscale_init(struct _module_state *st)
         st->filter_expand_Y = filter_expand_Y_SSE2;
         return;
     }
-    if (SDL_HasNEON()) {
+    if (pg_HasSSE_NEON() && SDL_HasNEON()) {
         st->filter_type = "NEON";
         st->filter_shrink_X = filter_shrink_X_SSE2;
         st->filter_shrink_Y = filter_shrink_Y_SSE2;
@@ -1251,7 +2120,8 @@ smoothscale_init(struct _module_state *st)
 #endif /* PG_ENABLE_SSE_NEON */
 #endif /* !__EMSCRIPTEN__ */
 #ifdef SCALE_MMX_SUPPORT
-    if (SDL_HasSSE()) {
+    /* set_simd_level("scalar") rules these out too */
+    if (pg_simd_max_level() > PG_SIMD_NONE && SDL_HasSSE()) {
         st->filter_type = "SSE";
         st->filter_shrink_X = filter_shrink_X_SSE;
         st->filter_shrink_Y = filter_shrink_Y_SSE;
@@ -1259,7 +2129,7 @@ smoothscale_init(struct _module_state *st)
         st->filter_expand_Y = filter_expand_Y_SSE;
         return;
     }
-    if (SDL_HasMMX()) {
+    if (pg_simd_max_level() > PG_SIMD_NONE && SDL_HasMMX()) {
         st->filter_type = "MMX";
         st->filter_shrink_X = filter_shrink_X_MMX;
         st->filter_shrink_Y = filter_shrink_Y_MMX;
@@ -1317,6 +2187,72 @@ convert_32_24(Uint8 *srcpix, int srcpitch, Uint8 *dstpix, int dstpitch,
     }
 }
 
+#define SMOOTHSCALE_MAX_THREADS 64
+#define SMOOTHSCALE_THREAD_MIN_LINES 16
+#define SMOOTHSCALE_THREAD_MIN_PIXELS (1 << 16)
+
+typedef struct {
+    SMOOTHSCALE_FILTER_P filter;
+    Uint8 *srcpix;
+    Uint8 *dstpix;
+    int lines; /* rows for an X filter, columns for a Y filter */
+    int srcpitch;
+    int dstpitch;
+    int srclen;
+    int dstlen;
+} pg_ScaleBand;
+
+static void
+_smoothscale_band(void *data, int i)
+{
+    pg_ScaleBand *band = (pg_ScaleBand *)data + i;
+    band->filter(band->srcpix, band->dstpix, band->lines, band->srcpitch,
+                 band->dstpitch, band->srclen, band->dstlen);
+}
+
+/* Runs one filter pass, split across up to num_threads threads. The X
+ * filters scale every row on its own, so they are split into bands of rows,
+ * the Y filters likewise into bands of columns. Column bands are a multiple
+ * of 16 pixels wide so no two threads write to the same cache line. Every
+ * pixel is computed the same way as without threads. Must be called without
+ * the GIL. */
+static void
+_smoothscale_run(SMOOTHSCALE_FILTER_P filter, SDL_bool rows, Uint8 *srcpix,
+                 Uint8 *dstpix, int lines, int srcpitch, int dstpitch,
+                 int srclen, int dstlen, int num_threads)
+{
+    pg_ScaleBand bands[SMOOTHSCALE_MAX_THREADS];
+    int nbands = MIN(num_threads, lines / SMOOTHSCALE_THREAD_MIN_LINES);
+    int i, start, end;
+
+    if (nbands < 2 || (Sint64)MAX(srclen, dstlen) * lines <
+                          SMOOTHSCALE_THREAD_MIN_PIXELS) {
+        filter(srcpix, dstpix, lines, srcpitch, dstpitch, srclen, dstlen);
+        return;
+    }
+
+    for (i = 0; i < nbands; i++) {
+        start = (int)((Sint64)lines * i / nbands);
+        end = (int)((Sint64)lines * (i + 1) / nbands);
+        if (!rows) {
+            start &= ~15;
+            if (i < nbands - 1) {
+                end &= ~15;
+            }
+        }
+        bands[i].filter = filter;
+        bands[i].srcpix = srcpix + (Sint64)start * (rows ? srcpitch : 4);
+        bands[i].dstpix = dstpix + (Sint64)start * (rows ? dstpitch : 4);
+        bands[i].lines = end - start;
+        bands[i].srcpitch = srcpitch;
+        bands[i].dstpitch = dstpitch;
+        bands[i].srclen = srclen;
+        bands[i].dstlen = dstlen;
+    }
+
+    pg_run_bands(_smoothscale_band, bands, nbands);
+}
+
 static void
 scalesmooth(SDL_Surface *src, SDL_Surface *dst, struct _module_state *st)
 {
@@ -1335,6 +2271,16 @@ scalesmooth(SDL_Surface *src, SDL_Surface *dst, struct _module_state *st)
 
     Uint8 *temppix = NULL;
     int tempwidth = 0, temppitch = 0;
+    int nthreads = st->smoothscale_threads;
+    SMOOTHSCALE_FILTER_P shrink_X, shrink_Y, expand_X, expand_Y;
+
+    /* set_smoothscale_backend() may swap them meanwhile */
+    pg_mutex_lock(&st->lock);
+    shrink_X = st->filter_shrink_X;
+    shrink_Y = st->filter_shrink_Y;
+    expand_X = st->filter_expand_X;
+    expand_Y = st->filter_expand_Y;
+    pg_mutex_unlock(&st->lock);
 
     /* convert to 32-bit if necessary */
     if (bpp == 3) {
@@ -1374,39 +2320,47 @@ scalesmooth(SDL_Surface *src, SDL_Surface *dst, struct _module_state *st)
     if (dstwidth < srcwidth) /* shrink */
     {
         if (srcheight != dstheight)
-            st->filter_shrink_X(srcpix, temppix, srcheight, srcpitch,
-                                temppitch, srcwidth, dstwidth);
+            _smoothscale_run(shrink_X, SDL_TRUE, srcpix, temppix,
+                             srcheight, srcpitch, temppitch, srcwidth,
+                             dstwidth, nthreads);
         else
-            st->filter_shrink_X(srcpix, dstpix, srcheight, srcpitch, dstpitch,
-                                srcwidth, dstwidth);
+            _smoothscale_run(shrink_X, SDL_TRUE, srcpix, dstpix,
+                             srcheight, srcpitch, dstpitch, srcwidth,
+                             dstwidth, nthreads);
     }
     else if (dstwidth > srcwidth) /* expand */
     {
         if (srcheight != dstheight)
-            st->filter_expand_X(srcpix, temppix, srcheight, srcpitch,
-                                temppitch, srcwidth, dstwidth);
+            _smoothscale_run(expand_X, SDL_TRUE, srcpix, temppix,
+                             srcheight, srcpitch, temppitch, srcwidth,
+                             dstwidth, nthreads);
         else
-            st->filter_expand_X(srcpix, dstpix, srcheight, srcpitch, dstpitch,
-                                srcwidth, dstwidth);
+            _smoothscale_run(expand_X, SDL_TRUE, srcpix, dstpix,
+                             srcheight, srcpitch, dstpitch, srcwidth,
+                             dstwidth, nthreads);
     }
     /* Now do the Y scale */
     if (dstheight < srcheight) /* shrink */
     {
         if (srcwidth != dstwidth)
-            st->filter_shrink_Y(temppix, dstpix, tempwidth, temppitch,
-                                dstpitch, srcheight, dstheight);
+            _smoothscale_run(shrink_Y, SDL_FALSE, temppix, dstpix,
+                             tempwidth, temppitch, dstpitch, srcheight,
+                             dstheight, nthreads);
         else
-            st->filter_shrink_Y(srcpix, dstpix, srcwidth, srcpitch, dstpitch,
-                                srcheight, dstheight);
+            _smoothscale_run(shrink_Y, SDL_FALSE, srcpix, dstpix,
+                             srcwidth, srcpitch, dstpitch, srcheight,
+                             dstheight, nthreads);
     }
     else if (dstheight > srcheight) /* expand */
     {
         if (srcwidth != dstwidth)
-            st->filter_expand_Y(temppix, dstpix, tempwidth, temppitch,
-                                dstpitch, srcheight, dstheight);
+            _smoothscale_run(expand_Y, SDL_FALSE, temppix, dstpix,
+                             tempwidth, temppitch, dstpitch, srcheight,
+                             dstheight, nthreads);
         else
-            st->filter_expand_Y(srcpix, dstpix, srcwidth, srcpitch, dstpitch,
-                                srcheight, dstheight);
+            _smoothscale_run(expand_Y, SDL_FALSE, srcpix, dstpix,
+                             srcwidth, srcpitch, dstpitch, srcheight,
+                             dstheight, nthreads);
     }
 
     /* Convert back to 24-bit if necessary */
@@ -1488,6 +2442,46 @@ smoothscale_to(PyObject *self, pgSurfaceObject *srcobj,
     return retsurf;
 }
 
+/* Returns a new reference to the smallest of surfobj and the surfaces in
+ * pyramid that is at least width x height, the best place to start a
+ * smoothscale down to that size from. */
+static PyObject *
+_pyramid_pick_level(PyObject *pyramid, pgSurfaceObject *surfobj, int width,
+                    int height)
+{
+    PyObject *seq, *item;
+    PyObject *best = (PyObject *)surfobj;
+    SDL_Surface *surf = pgSurface_AsSurface(surfobj);
+    Sint64 best_area = (Sint64)surf->w * surf->h;
+    Py_ssize_t i;
+
+    seq = PySequence_Fast(pyramid, "pyramid must be a sequence of surfaces");
+    if (!seq) {
+        return NULL;
+    }
+    for (i = 0; i < PySequence_Fast_GET_SIZE(seq); i++) {
+        item = PySequence_Fast_GET_ITEM(seq, i);
+        if (!pgSurface_Check(item)) {
+            Py_DECREF(seq);
+            return RAISE(PyExc_TypeError,
+                         "pyramid must be a sequence of surfaces");
+        }
+        surf = pgSurface_AsSurface(item);
+        if (!surf) {
+            Py_DECREF(seq);
+            return RAISE(pgExc_SDLError, "display Surface quit");
+        }
+        if (surf->w >= width && surf->h >= height &&
+            (Sint64)surf->w * surf->h < best_area) {
+            best = item;
+            best_area = (Sint64)surf->w * surf->h;
+        }
+    }
+    Py_INCREF(best);
+    Py_DECREF(seq);
+    return best;
+}
+
 static PyObject *
 surf_scalesmooth(PyObject *self, PyObject *args, PyObject *kwargs)
 {
@@ -1495,13 +2489,15 @@ surf_scalesmooth(PyObject *self, PyObject *args, PyObject *kwargs)
     pgSurfaceObject *surfobj2 = NULL;
     SDL_Surface *surf;
     PyObject *size;
+    PyObject *pyramid = NULL;
     SDL_Surface *newsurf;
     int width, height;
-    static char *keywords[] = {"surface", "size", "dest_surface", NULL};
+    static char *keywords[] = {"surface", "size", "dest_surface", "pyramid",
+                               NULL};
 
-    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "O!O|O!", keywords,
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "O!O|O!O", keywords,
                                      &pgSurface_Type, &surfobj, &size,
-                                     &pgSurface_Type, &surfobj2))
+                                     &pgSurface_Type, &surfobj2, &pyramid))
         return NULL;
 
     surf = pgSurface_AsSurface(surfobj);
@@ -1510,7 +2506,18 @@ surf_scalesmooth(PyObject *self, PyObject *args, PyObject *kwargs)
     if (!pg_TwoIntsFromObj(size, &width, &height))
         return RAISE(PyExc_TypeError, "size must be two numbers");
 
-    newsurf = smoothscale_to(self, surfobj, surfobj2, width, height);
+    if (pyramid && pyramid != Py_None) {
+        pyramid = _pyramid_pick_level(pyramid, surfobj, width, height);
+        if (!pyramid) {
+            return NULL;
+        }
+        newsurf = smoothscale_to(self, (pgSurfaceObject *)pyramid, surfobj2,
+                                 width, height);
+        Py_DECREF(pyramid);
+    }
+    else {
+        newsurf = smoothscale_to(self, surfobj, surfobj2, width, height);
+    }
     if (!newsurf) {
         return NULL;
     }
@@ -1559,6 +2566,124 @@ surf_scalesmooth_by(PyObject *self, PyObject *args, PyObject *kwargs)
         return (PyObject *)pgSurface_New(newsurf);
 }
 
+static void
+pyramid_downsample_row(const Uint8 *row0, const Uint8 *row1, Uint8 *dstpix,
+                       int width, int bpp)
+{
+    int x, c;
+
+    for (x = 0; x < width; x++) {
+        for (c = 0; c < bpp; c++) {
+            dstpix[c] = (row0[c] + row0[bpp + c] + row1[c] + row1[bpp + c] +
+                         2) >>
+                        2;
+        }
+        row0 += 2 * bpp;
+        row1 += 2 * bpp;
+        dstpix += bpp;
+    }
+}
+
+/* Fills dst with src halved in both dimensions, every pixel is the rounded
+ * average of a 2x2 block. */
+static void
+pyramid_downsample(SDL_Surface *src, SDL_Surface *dst)
+{
+    int bpp = PG_SURF_BytesPerPixel(src);
+    Uint8 *row0;
+    Uint8 *dstpix;
+    int y;
+
+    for (y = 0; y < dst->h; y++) {
+        row0 = (Uint8 *)src->pixels + (Sint64)2 * y * src->pitch;
+        dstpix = (Uint8 *)dst->pixels + (Sint64)y * dst->pitch;
+#if !defined(__EMSCRIPTEN__)
+#if PG_ENABLE_SSE_NEON
+        if (bpp == 4 && pg_HasSSE_NEON()) {
+            pyramid_downsample_row_sse2(row0, row0 + src->pitch, dstpix,
+                                        dst->w);
+            continue;
+        }
+#endif /* PG_ENABLE_SSE_NEON */
+#endif /* !__EMSCRIPTEN__ */
+        pyramid_downsample_row(row0, row0 + src->pitch, dstpix, dst->w, bpp);
+    }
+}
+
+static PyObject *
+surf_build_pyramid(PyObject *self, PyObject *args, PyObject *kwargs)
+{
+    pgSurfaceObject *surfobj;
+    SDL_Surface *surf, *prev, *newsurf;
+    PyObject *levelobj, *list;
+    int levels, i, bpp;
+    static char *keywords[] = {"surface", "levels", NULL};
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "O!i", keywords,
+                                     &pgSurface_Type, &surfobj, &levels))
+        return NULL;
+
+    surf = pgSurface_AsSurface(surfobj);
+    SURF_INIT_CHECK(surf)
+
+    if (levels < 0) {
+        return RAISE(PyExc_ValueError, "levels must not be negative");
+    }
+    bpp = PG_SURF_BytesPerPixel(surf);
+    if (bpp < 3 || bpp > 4) {
+        return RAISE(PyExc_ValueError,
+                     "Only 24-bit or 32-bit surfaces can be used to build a "
+                     "pyramid");
+    }
+
+    list = PyList_New(0);
+    if (!list) {
+        return NULL;
+    }
+
+    prev = surf;
+    for (i = 0; i < levels && prev->w >= 2 && prev->h >= 2; i++) {
+        newsurf = newsurf_fromsurf(prev, prev->w / 2, prev->h / 2);
+        if (!newsurf) {
+            Py_DECREF(list);
+            return NULL;
+        }
+
+        if (prev == surf) {
+            pgSurface_Lock(surfobj);
+        }
+        else {
+            SDL_LockSurface(prev);
+        }
+        SDL_LockSurface(newsurf);
+        Py_BEGIN_ALLOW_THREADS;
+        pyramid_downsample(prev, newsurf);
+        Py_END_ALLOW_THREADS;
+        SDL_UnlockSurface(newsurf);
+        if (prev == surf) {
+            pgSurface_Unlock(surfobj);
+        }
+        else {
+            SDL_UnlockSurface(prev);
+        }
+
+        levelobj = (PyObject *)pgSurface_New(newsurf);
+        if (!levelobj) {
+            SDL_FreeSurface(newsurf);
+            Py_DECREF(list);
+            return NULL;
+        }
+        if (PyList_Append(list, levelobj)) {
+            Py_DECREF(levelobj);
+            Py_DECREF(list);
+            return NULL;
+        }
+        Py_DECREF(levelobj);
+        prev = newsurf;
+    }
+    return list;
+}
+
 static PyObject *
 surf_get_smoothscale_backend(PyObject *self, PyObject *_null)
 {
@@ -1570,7 +2695,8 @@ surf_set_smoothscale_backend(PyObject *self, PyObject *args, PyObject *kwargs)
 {
     struct _module_state *st = GETSTATE(self);
     char *keywords[] = {"backend", NULL};
-    const char *type;
+    const char *type, *filter_type;
+    SMOOTHSCALE_FILTER_P shrink_X, shrink_Y, expand_X, expand_Y;
 
 #ifdef _MSC_VER
     /* MSVC static analyzer false alarm: assure type is NULL-terminated by
@@ -1582,11 +2708,11 @@ surf_set_smoothscale_backend(PyObject *self, PyObject *args, PyObject *kwargs)
         return NULL;
 
     if (strcmp(type, "GENERIC") == 0) {
-        st->filter_type = "GENERIC";
-        st->filter_shrink_X = filter_shrink_X_ONLYC;
-        st->filter_shrink_Y = filter_shrink_Y_ONLYC;
-        st->filter_expand_X = filter_expand_X_ONLYC;
-        st->filter_expand_Y = filter_expand_Y_ONLYC;
+        filter_type = "GENERIC";
+        shrink_X = filter_shrink_X_ONLYC;
+        shrink_Y = filter_shrink_Y_ONLYC;
+        expand_X = filter_expand_X_ONLYC;
+        expand_Y = filter_expand_Y_ONLYC;
     }
 #if defined(SCALE_MMX_SUPPORT)
     else if (strcmp(type, "MMX") == 0) {
@@ -1600,11 +2726,11 @@ surf_set_smoothscale_backend(PyObject *self, PyObject *args, PyObject *kwargs)
                 1) == -1) {
             return NULL;
         }
-        st->filter_type = "MMX";
-        st->filter_shrink_X = filter_shrink_X_MMX;
-        st->filter_shrink_Y = filter_shrink_Y_MMX;
-        st->filter_expand_X = filter_expand_X_MMX;
-        st->filter_expand_Y = filter_expand_Y_MMX;
+        filter_type = "MMX";
+        shrink_X = filter_shrink_X_MMX;
+        shrink_Y = filter_shrink_Y_MMX;
+        expand_X = filter_expand_X_MMX;
+        expand_Y = filter_expand_Y_MMX;
     }
     else if (strcmp(type, "SSE") == 0) {
         if (!SDL_HasSSE()) {
@@ -1617,11 +2743,11 @@ surf_set_smoothscale_backend(PyObject *self, PyObject *args, PyObject *kwargs)
                 1) == -1) {
             return NULL;
         }
-        st->filter_type = "SSE";
-        st->filter_shrink_X = filter_shrink_X_SSE;
-        st->filter_shrink_Y = filter_shrink_Y_SSE;
-        st->filter_expand_X = filter_expand_X_SSE;
-        st->filter_expand_Y = filter_expand_Y_SSE;
+        filter_type = "SSE";
+        shrink_X = filter_shrink_X_SSE;
+        shrink_Y = filter_shrink_Y_SSE;
+        expand_X = filter_expand_X_SSE;
+        expand_Y = filter_expand_Y_SSE;
     }
 #else
     else if (strcmp(st->filter_type, "MMX") == 0 ||
@@ -1632,16 +2758,27 @@ surf_set_smoothscale_backend(PyObject *self, PyObject *args, PyObject *kwargs)
 #endif /* ~defined(SCALE_MMX_SUPPORT) */
 #if !defined(__EMSCRIPTEN__)
 #if PG_ENABLE_SSE_NEON
+    else if (strcmp(type, "AVX2") == 0) {
+        if (!pg_has_avx2()) {
+            return RAISE(PyExc_ValueError,
+                         "AVX2 not supported on this machine");
+        }
+        filter_type = "AVX2";
+        shrink_X = filter_shrink_X_SSE2;
+        shrink_Y = filter_shrink_Y_AVX2;
+        expand_X = filter_expand_X_AVX2;
+        expand_Y = filter_expand_Y_AVX2;
+    }
     else if (strcmp(type, "SSE2") == 0) {
         if (!SDL_HasSSE2()) {
             return RAISE(PyExc_ValueError,
                          "SSE2 not supported on this machine");
         }
-        st->filter_type = "SSE2";
-        st->filter_shrink_X = filter_shrink_X_SSE2;
-        st->filter_shrink_Y = filter_shrink_Y_SSE2;
-        st->filter_expand_X = filter_expand_X_SSE2;
-        st->filter_expand_Y = filter_expand_Y_SSE2;
+        filter_type = "SSE2";
+        shrink_X = filter_shrink_X_SSE2;
+        shrink_Y = filter_shrink_Y_SSE2;
+        expand_X = filter_expand_X_SSE2;
+        expand_Y = filter_expand_Y_SSE2;
     }
 
     else if (strcmp(type, "NEON") == 0) {
@@ -1649,20 +2786,55 @@ surf_set_smoothscale_backend(PyObject *self, PyObject *args, PyObject *kwargs)
             return RAISE(PyExc_ValueError,
                          "NEON not supported on this machine");
         }
-        st->filter_type = "NEON";
-        st->filter_shrink_X = filter_shrink_X_SSE2;
-        st->filter_shrink_Y = filter_shrink_Y_SSE2;
-        st->filter_expand_X = filter_expand_X_SSE2;
-        st->filter_expand_Y = filter_expand_Y_SSE2;
+        filter_type = "NEON";
+        shrink_X = filter_shrink_X_SSE2;
+        shrink_Y = filter_shrink_Y_SSE2;
+        expand_X = filter_expand_X_SSE2;
+        expand_Y = filter_expand_Y_SSE2;
     }
 #endif /* PG_ENABLE_SSE_NEON */
 #endif /* !__EMSCRIPTEN__ */
     else {
         return PyErr_Format(PyExc_ValueError, "Unknown backend type %s", type);
     }
+
+    /* smoothscale() snapshots the filters under the same lock */
+    pg_mutex_lock(&st->lock);
+    st->filter_type = filter_type;
+    st->filter_shrink_X = shrink_X;
+    st->filter_shrink_Y = shrink_Y;
+    st->filter_expand_X = expand_X;
+    st->filter_expand_Y = expand_Y;
+    pg_mutex_unlock(&st->lock);
+    Py_RETURN_NONE;
+}
+
+static PyObject *
+surf_set_smoothscale_threads(PyObject *self, PyObject *arg)
+{
+    long num_threads = PyLong_AsLong(arg);
+
+    if (num_threads == -1 && PyErr_Occurred()) {
+        return NULL;
+    }
+    if (num_threads < 0) {
+        return RAISE(PyExc_ValueError,
+                     "the number of smoothscale threads must not be negative");
+    }
+    if (num_threads == 0) {
+        num_threads = SDL_GetCPUCount();
+    }
+    GETSTATE(self)->smoothscale_threads =
+        (int)MIN(num_threads, SMOOTHSCALE_MAX_THREADS);
     Py_RETURN_NONE;
 }
 
+static PyObject *
+surf_get_smoothscale_threads(PyObject *self, PyObject *_null)
+{
+    return PyLong_FromLong(GETSTATE(self)->smoothscale_threads);
+}
+
 /* _get_color_move_pixels is for iterating over pixels in a Surface.
 
     bpp - bytes per pixel
@@ -1736,23 +2908,140 @@ _set_at_pixels(int x, int y, Uint8 *pixels, SDL_PixelFormat *format,
     }
 }
 
+/* Whether every channel of a 32 bit format is a whole byte */
 static int
-get_threshold(SDL_Surface *dest_surf, SDL_Surface *surf,
-              Uint32 color_search_color, Uint32 color_threshold,
-              Uint32 color_set_color, int set_behavior,
-              SDL_Surface *search_surf, int inverse_set)
+_byte_channels_format(SDL_PixelFormat *format)
 {
-    int x, y, similar;
-    Uint8 *pixels, *destpixels = NULL, *pixels2 = NULL;
-    SDL_PixelFormat *format;
-    Uint32 the_color, the_color2, dest_set_color;
-    Uint8 search_color_r, search_color_g, search_color_b;
-    Uint8 surf_r, surf_g, surf_b;
-    Uint8 threshold_r, threshold_g, threshold_b;
-    Uint8 search_surf_r, search_surf_g, search_surf_b;
+    return PG_FORMAT_BytesPerPixel(format) == 4 && format->Rloss == 0 &&
+           format->Gloss == 0 && format->Bloss == 0 &&
+           !(format->Rshift & 7) && !(format->Gshift & 7) &&
+           !(format->Bshift & 7) &&
+           (!format->Amask || (format->Aloss == 0 && !(format->Ashift & 7)));
+}
+
+/* Index of the byte holding the channel at shift in a 32 bit pixel */
+#if SDL_BYTEORDER == SDL_LIL_ENDIAN
+#define _PG_BYTE_INDEX(shift) ((shift) >> 3)
+#else
+#define _PG_BYTE_INDEX(shift) (3 - ((shift) >> 3))
+#endif
+
+int
+threshold_row(const Uint32 *src, const Uint32 *search, int n,
+              Uint32 search_color, Uint32 threshold, Uint8 *match)
+{
+    Uint32 pix, ref;
+    int i, k, within, count = 0;
+
+    for (i = 0; i < n; i++) {
+        pix = src[i];
+        ref = search ? search[i] : search_color;
+        within = 1;
+        for (k = 0; k < 32; k += 8) {
+            if (abs((int)((pix >> k) & 0xFF) - (int)((ref >> k) & 0xFF)) >
+                (int)((threshold >> k) & 0xFF)) {
+                within = 0;
+            }
+        }
+        count += within;
+        if (match) {
+            match[i] = within ? 0xFF : 0;
+        }
+    }
+    return count;
+}
+
+/* get_threshold() for 32 bit surfaces with whole byte channels, which are
+ * compared straight from the pixels. The matches of a row are found first,
+ * then the destination pixels are set. Returns -1 if out of memory. */
+static int
+_get_threshold_32(SDL_Surface *dest_surf, SDL_Surface *surf,
+                  Uint32 color_search_color, Uint32 color_threshold,
+                  Uint32 color_set_color, int set_behavior,
+                  SDL_Surface *search_surf, int inverse_set)
+{
+    SDL_PixelFormat *format = surf->format;
+    Uint32 rgbmask = format->Rmask | format->Gmask | format->Bmask;
+    THRESHOLD_ROW_P row_func = threshold_row;
+    Uint32 *src, *search = NULL;
+    Uint8 *match = NULL;
+    int x, y, similar = 0;
+
+    if (set_behavior) {
+        match = (Uint8 *)malloc(surf->w + 1);
+        if (!match) {
+            return -1;
+        }
+    }
+
+    /* alpha and unused bytes always match */
+    color_threshold = (color_threshold & rgbmask) | ~rgbmask;
+
+#if !defined(__EMSCRIPTEN__)
+    if (pg_has_avx2()) {
+        row_func = threshold_row_avx2;
+    }
+#if PG_ENABLE_SSE_NEON
+    else if (pg_HasSSE_NEON()) {
+        row_func = threshold_row_sse2;
+    }
+#endif /* PG_ENABLE_SSE_NEON */
+#endif /* !__EMSCRIPTEN__ */
+
+    for (y = 0; y < surf->h; y++) {
+        src = (Uint32 *)((Uint8 *)surf->pixels + y * surf->pitch);
+        if (search_surf) {
+            search = (Uint32 *)((Uint8 *)search_surf->pixels +
+                                y * search_surf->pitch);
+        }
+        similar += row_func(src, search, surf->w, color_search_color,
+                            color_threshold, match);
+        if (!set_behavior) {
+            continue;
+        }
+        for (x = 0; x < surf->w; x++) {
+            if ((match[x] != 0) == (inverse_set != 0)) {
+                _set_at_pixels(x, y, (Uint8 *)dest_surf->pixels,
+                               dest_surf->format, dest_surf->pitch,
+                               set_behavior == 2
+                                   ? (search ? search[x] : src[x])
+                                   : color_set_color);
+            }
+        }
+    }
+
+    free(match);
+    return similar;
+}
+
+static int
+get_threshold(SDL_Surface *dest_surf, SDL_Surface *surf,
+              Uint32 color_search_color, Uint32 color_threshold,
+              Uint32 color_set_color, int set_behavior,
+              SDL_Surface *search_surf, int inverse_set)
+{
+    int x, y, similar;
+    Uint8 *pixels, *destpixels = NULL, *pixels2 = NULL;
+    SDL_PixelFormat *format;
+    Uint32 the_color, the_color2, dest_set_color;
+    Uint8 search_color_r, search_color_g, search_color_b;
+    Uint8 surf_r, surf_g, surf_b;
+    Uint8 threshold_r, threshold_g, threshold_b;
+    Uint8 search_surf_r, search_surf_g, search_surf_b;
 
     int within_threshold;
 
+    if (_byte_channels_format(surf->format) &&
+        (!search_surf ||
+         search_surf->format->format == surf->format->format)) {
+        similar = _get_threshold_32(dest_surf, surf, color_search_color,
+                                    color_threshold, color_set_color,
+                                    set_behavior, search_surf, inverse_set);
+        if (similar >= 0) {
+            return similar;
+        }
+    }
+
     similar = 0;
     format = surf->format;
 
@@ -2215,6 +3504,24 @@ surf_grayscale(PyObject *self, PyObject *args, PyObject *kwargs)
     }
 }
 
+static PyObject *
+surf_grayscale_ip(PyObject *self, PyObject *args, PyObject *kwargs)
+{
+    pgSurfaceObject *surfobj;
+
+    static char *keywords[] = {"surface", NULL};
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "O!", keywords,
+                                     &pgSurface_Type, &surfobj))
+        return NULL;
+    SURF_INIT_CHECK(pgSurface_AsSurface(surfobj))
+
+    if (!grayscale(surfobj, surfobj)) {
+        return NULL;
+    }
+    Py_RETURN_NONE;
+}
+
 #define MIN3(a, b, c) MIN(MIN(a, b), c)
 #define MAX3(a, b, c) MAX(MAX(a, b), c)
 
@@ -2308,9 +3615,28 @@ modify_hsl(SDL_Surface *surf, SDL_Surface *dst, float h, float s, float l)
     SDL_PixelFormat *fmt = surf->format;
     Uint8 *srcp8 = (Uint8 *)surf->pixels;
     Uint8 *dstp8 = (Uint8 *)dst->pixels;
+    MODIFY_HSL_ROW_P hsl_row = NULL;
+
+#if !defined(__EMSCRIPTEN__)
+    if (pg_has_avx2()) {
+        hsl_row = modify_hsl_row_avx2;
+    }
+#if PG_ENABLE_SSE_NEON
+    else if (pg_HasSSE_NEON()) {
+        hsl_row = modify_hsl_row_sse2;
+    }
+#endif /* PG_ENABLE_SSE_NEON */
+#endif /* !__EMSCRIPTEN__ */
 
-    if (PG_FORMAT_BytesPerPixel(fmt) == 4 ||
-        PG_FORMAT_BytesPerPixel(fmt) == 3) {
+    if (hsl_row && _byte_channels_format(fmt)) {
+        for (y = 0; y < surf->h; y++) {
+            hsl_row((Uint32 *)(srcp8 + y * surf->pitch),
+                    (Uint32 *)(dstp8 + y * dst->pitch), surf->w, fmt->Rshift,
+                    fmt->Gshift, fmt->Bshift, fmt->Amask, h, s, l);
+        }
+    }
+    else if (PG_FORMAT_BytesPerPixel(fmt) == 4 ||
+             PG_FORMAT_BytesPerPixel(fmt) == 3) {
         const int src_skip =
             surf->pitch - surf->w * PG_FORMAT_BytesPerPixel(fmt);
         const int dst_skip =
@@ -2405,21 +3731,12 @@ modify_hsl(SDL_Surface *surf, SDL_Surface *dst, float h, float s, float l)
     }
 }
 
+/* hsl() and hsl_ip(), which passes the surface as surfobj2 */
 static PyObject *
-surf_hsl(PyObject *self, PyObject *args, PyObject *kwargs)
+hsl(pgSurfaceObject *surfobj, pgSurfaceObject *surfobj2, float h, float s,
+    float l)
 {
-    pgSurfaceObject *surfobj;
-    pgSurfaceObject *surfobj2 = NULL;
     SDL_Surface *dst, *src;
-    float h = 0, s = 0, l = 0;
-
-    static char *keywords[] = {"surface",   "hue",          "saturation",
-                               "lightness", "dest_surface", NULL};
-    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "O!|fffO!", keywords,
-                                     &pgSurface_Type, &surfobj, &h, &s, &l,
-                                     &pgSurface_Type, &surfobj2)) {
-        return NULL;
-    }
 
     if (s < -1 || s > 1) {
         PyObject *value = PyFloat_FromDouble((double)s);
@@ -2456,6 +3773,7 @@ surf_hsl(PyObject *self, PyObject *args, PyObject *kwargs)
     }
     else {
         dst = pgSurface_AsSurface(surfobj2);
+        SURF_INIT_CHECK(dst);
     }
 
     if (dst->w != src->w || dst->h != src->h) {
@@ -2485,6 +3803,220 @@ surf_hsl(PyObject *self, PyObject *args, PyObject *kwargs)
     }
 }
 
+static PyObject *
+surf_hsl(PyObject *self, PyObject *args, PyObject *kwargs)
+{
+    pgSurfaceObject *surfobj;
+    pgSurfaceObject *surfobj2 = NULL;
+    float h = 0, s = 0, l = 0;
+
+    static char *keywords[] = {"surface",   "hue",          "saturation",
+                               "lightness", "dest_surface", NULL};
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "O!|fffO!", keywords,
+                                     &pgSurface_Type, &surfobj, &h, &s, &l,
+                                     &pgSurface_Type, &surfobj2)) {
+        return NULL;
+    }
+    return hsl(surfobj, surfobj2, h, s, l);
+}
+
+static PyObject *
+surf_hsl_ip(PyObject *self, PyObject *args, PyObject *kwargs)
+{
+    pgSurfaceObject *surfobj;
+    PyObject *result;
+    float h = 0, s = 0, l = 0;
+
+    static char *keywords[] = {"surface", "hue", "saturation", "lightness",
+                               NULL};
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "O!|fff", keywords,
+                                     &pgSurface_Type, &surfobj, &h, &s,
+                                     &l)) {
+        return NULL;
+    }
+    if (!(result = hsl(surfobj, surfobj, h, s, l))) {
+        return NULL;
+    }
+    Py_DECREF(result);
+    Py_RETURN_NONE;
+}
+
+/* Rounds and clamps the first nout rows of matrix applied to in */
+static PG_FORCEINLINE void
+_color_matrix_apply(const float *matrix, const float *in, int nout,
+                    Uint8 *out)
+{
+    float v;
+    int c;
+
+    /* the same operations as in the SIMD versions, NaN becomes 0 */
+    for (c = 0; c < nout; c++, matrix += 5) {
+        v = matrix[0] * in[0];
+        v += matrix[1] * in[1];
+        v += matrix[2] * in[2];
+        v += matrix[3] * in[3];
+        v += matrix[4];
+        v = v > 0 ? v : 0;
+        v = v < 255 ? v : 255;
+        out[c] = (Uint8)(v + 0.5f);
+    }
+}
+
+void
+color_matrix_row(const Uint32 *src, Uint32 *dst, int n, const int *shifts,
+                 Uint32 amask, const float *matrix)
+{
+    const int nout = amask ? 4 : 3;
+    const Uint32 keep = ~((0xFFu << shifts[0]) | (0xFFu << shifts[1]) |
+                          (0xFFu << shifts[2]) | amask);
+    float in[4] = {0, 0, 0, 255};
+    Uint8 out[4];
+    Uint32 pix;
+    int i, c;
+
+    for (i = 0; i < n; i++) {
+        pix = src[i];
+        for (c = 0; c < nout; c++) {
+            in[c] = (float)((pix >> shifts[c]) & 0xFF);
+        }
+        _color_matrix_apply(matrix, in, nout, out);
+        pix &= keep;
+        for (c = 0; c < nout; c++) {
+            pix |= (Uint32)out[c] << shifts[c];
+        }
+        dst[i] = pix;
+    }
+}
+
+static void
+color_matrix(SDL_Surface *src, SDL_Surface *dst, const float *matrix)
+{
+    SDL_PixelFormat *fmt = src->format;
+    Uint8 *srcpixels = (Uint8 *)src->pixels;
+    Uint8 *dstpixels = (Uint8 *)dst->pixels;
+    COLOR_MATRIX_ROW_P row_func = color_matrix_row;
+    int shifts[4] = {fmt->Rshift, fmt->Gshift, fmt->Bshift, fmt->Ashift};
+    float in[4];
+    Uint8 out[4], r, g, b, a;
+    Uint8 *pix;
+    Uint32 pixel;
+    int x, y;
+
+    if (_byte_channels_format(fmt)) {
+#if !defined(__EMSCRIPTEN__)
+        if (pg_has_avx2()) {
+            row_func = color_matrix_row_avx2;
+        }
+#if PG_ENABLE_SSE_NEON
+        else if (pg_HasSSE_NEON()) {
+            row_func = color_matrix_row_sse2;
+        }
+#endif /* PG_ENABLE_SSE_NEON */
+#endif /* !__EMSCRIPTEN__ */
+        for (y = 0; y < src->h; y++) {
+            row_func((Uint32 *)(srcpixels + y * src->pitch),
+                     (Uint32 *)(dstpixels + y * dst->pitch), src->w, shifts,
+                     fmt->Amask, matrix);
+        }
+        return;
+    }
+
+    for (y = 0; y < src->h; y++) {
+        for (x = 0; x < src->w; x++) {
+            SURF_GET_AT(pixel, src, x, y, srcpixels, fmt, pix);
+            SDL_GetRGBA(pixel, fmt, &r, &g, &b, &a);
+            in[0] = r;
+            in[1] = g;
+            in[2] = b;
+            in[3] = a;
+            _color_matrix_apply(matrix, in, 4, out);
+            pixel = SDL_MapRGBA(fmt, out[0], out[1], out[2], out[3]);
+            SURF_SET_AT(pixel, dst, x, y, dstpixels, fmt, pix);
+        }
+    }
+}
+
+static PyObject *
+surf_color_matrix(PyObject *self, PyObject *args, PyObject *kwargs)
+{
+    pgSurfaceObject *surfobj;
+    pgSurfaceObject *surfobj2 = NULL;
+    PyObject *matrixobj, *row;
+    SDL_Surface *src, *dst;
+    float matrix[20];
+    int i, j;
+    static char *keywords[] = {"surface", "matrix", "dest_surface", NULL};
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "O!O|O!", keywords,
+                                     &pgSurface_Type, &surfobj, &matrixobj,
+                                     &pgSurface_Type, &surfobj2)) {
+        return NULL;
+    }
+
+    if (!PySequence_Check(matrixobj)) {
+        return RAISE(PyExc_TypeError, "matrix must be a sequence");
+    }
+    if (PySequence_Size(matrixobj) != 4) {
+        return RAISE(PyExc_ValueError, "matrix must have 4 rows of 5 values");
+    }
+    for (i = 0; i < 4; i++) {
+        row = PySequence_GetItem(matrixobj, i);
+        if (!row) {
+            return NULL;
+        }
+        if (!PySequence_Check(row) || PySequence_Size(row) != 5) {
+            Py_DECREF(row);
+            return RAISE(PyExc_ValueError,
+                         "matrix must have 4 rows of 5 values");
+        }
+        for (j = 0; j < 5; j++) {
+            if (!pg_FloatFromObjIndex(row, j, &matrix[i * 5 + j])) {
+                Py_DECREF(row);
+                return RAISE(PyExc_TypeError, "matrix values must be numbers");
+            }
+        }
+        Py_DECREF(row);
+    }
+
+    src = pgSurface_AsSurface(surfobj);
+    SURF_INIT_CHECK(src);
+
+    if (surfobj2) {
+        dst = pgSurface_AsSurface(surfobj2);
+        SURF_INIT_CHECK(dst);
+        if (dst->w != src->w || dst->h != src->h) {
+            return RAISE(PyExc_ValueError,
+                         "Destination surface must be the same size as "
+                         "source surface.");
+        }
+        if (dst->format->format != src->format->format) {
+            return RAISE(
+                PyExc_ValueError,
+                "Source and destination surfaces need the same format.");
+        }
+        pgSurface_Lock(surfobj2);
+    }
+    else {
+        dst = newsurf_fromsurf(src, src->w, src->h);
+        if (!dst) {
+            return NULL;
+        }
+    }
+    pgSurface_Lock(surfobj);
+
+    Py_BEGIN_ALLOW_THREADS;
+    color_matrix(src, dst, matrix);
+    Py_END_ALLOW_THREADS;
+
+    pgSurface_Unlock(surfobj);
+    if (surfobj2) {
+        pgSurface_Unlock(surfobj2);
+        Py_INCREF(surfobj2);
+        return (PyObject *)surfobj2;
+    }
+    return (PyObject *)pgSurface_New(dst);
+}
+
 /*
 number to use for missing samples
 */
@@ -3039,41 +4571,1010 @@ surf_average_surfaces(PyObject *self, PyObject *args, PyObject *kwargs)
         Py_DECREF(obj);
     }
 
-    loop_up_to = loop;
-
-    if (!an_error) {
-        /* Process images, get average surface. */
+    loop_up_to = loop;
+
+    if (!an_error) {
+        /* Process images, get average surface. */
+
+        SDL_LockSurface(newsurf);
+
+        Py_BEGIN_ALLOW_THREADS;
+        average_surfaces(surfaces, size, newsurf, palette_colors);
+        Py_END_ALLOW_THREADS;
+
+        SDL_UnlockSurface(newsurf);
+
+        if (surfobj2) {
+            Py_INCREF(surfobj2);
+            ret = surfobj2;
+        }
+        else {
+            ret = (PyObject *)pgSurface_New(newsurf);
+        }
+    }
+
+    /* cleanup */
+
+    /* unlock the surfaces we got up to. */
+
+    for (loop = 0; loop < loop_up_to; loop++) {
+        if (surfaces[loop]) {
+            SDL_UnlockSurface(surfaces[loop]);
+        }
+    }
+
+    free(surfaces);
+
+    return ret;
+}
+
+/* Accumulator, a running sum of surfaces that can be averaged at any time.
+
+   The sums are kept per byte of a 32 bit pixel in the layout of the first
+   added surface, so surfaces of that format are summed straight from their
+   pixels. Other surfaces are converted pixel by pixel first. */
+
+/* the sums must stay below 2 ** 31 for the SIMD average */
+#define ACCUMULATOR_MAX_COUNT (0x7FFFFFFF / 255)
+
+typedef struct {
+    PyObject_HEAD int w;
+    int h;
+    Uint32 *sums;            /* 4 per pixel */
+    Uint32 count;            /* number of surfaces added */
+    SDL_PixelFormat *layout; /* format of the sums, NULL until the first add */
+    int busy;                /* set while the GIL is released */
+} pgAccumulatorObject;
+
+static void
+accumulator_add(Uint32 *sums, const Uint8 *src, int n)
+{
+    int i;
+    for (i = 0; i < n; i++) {
+        sums[i] += src[i];
+    }
+}
+
+static void
+accumulator_average(Uint8 *dst, const Uint32 *sums, int n, float scale)
+{
+    int i;
+    for (i = 0; i < n; i++) {
+        dst[i] = (Uint8)(sums[i] * scale + 0.5f);
+    }
+}
+
+static void
+_accumulator_add_surface(pgAccumulatorObject *self, SDL_Surface *surf)
+{
+    int n = self->w * 4;
+    Uint32 *sums = self->sums;
+    Uint8 *pixels = (Uint8 *)surf->pixels;
+    Uint8 *pix;
+    Uint32 color, mapped;
+    Uint8 r, g, b, a;
+    int x, y;
+    void (*add_row)(Uint32 *, const Uint8 *, int) = accumulator_add;
+
+    if (surf->format->format != self->layout->format) {
+        for (y = 0; y < self->h; y++) {
+            for (x = 0; x < self->w; x++) {
+                SURF_GET_AT(color, surf, x, y, pixels, surf->format, pix);
+                SDL_GetRGBA(color, surf->format, &r, &g, &b, &a);
+                mapped = SDL_MapRGBA(self->layout, r, g, b, a);
+                pix = (Uint8 *)&mapped;
+                sums[0] += pix[0];
+                sums[1] += pix[1];
+                sums[2] += pix[2];
+                sums[3] += pix[3];
+                sums += 4;
+            }
+        }
+        return;
+    }
+
+#if !defined(__EMSCRIPTEN__)
+    if (pg_has_avx2()) {
+        add_row = accumulator_add_avx2;
+    }
+#if PG_ENABLE_SSE_NEON
+    else if (pg_HasSSE_NEON()) {
+        add_row = accumulator_add_sse2;
+    }
+#endif /* PG_ENABLE_SSE_NEON */
+#endif /* !__EMSCRIPTEN__ */
+    for (y = 0; y < self->h; y++) {
+        add_row(sums + (size_t)y * n, pixels + (size_t)y * surf->pitch, n);
+    }
+}
+
+static void
+_accumulator_average_surface(pgAccumulatorObject *self, SDL_Surface *surf)
+{
+    int n = self->w * 4;
+    float scale = (float)(1.0L / self->count);
+    const Uint32 *sums = self->sums;
+    Uint8 *pixels = (Uint8 *)surf->pixels;
+    Uint8 *byte_buf;
+    Uint8 avg[4];
+    Uint32 color;
+    Uint8 r, g, b, a;
+    int x, y;
+    void (*average_row)(Uint8 *, const Uint32 *, int, float) =
+        accumulator_average;
+
+    if (surf->format->format != self->layout->format) {
+        for (y = 0; y < self->h; y++) {
+            for (x = 0; x < self->w; x++) {
+                accumulator_average(avg, sums, 4, scale);
+                memcpy(&color, avg, 4);
+                SDL_GetRGBA(color, self->layout, &r, &g, &b, &a);
+                color = SDL_MapRGBA(surf->format, r, g, b, a);
+                SURF_SET_AT(color, surf, x, y, pixels, surf->format,
+                            byte_buf);
+                sums += 4;
+            }
+        }
+        return;
+    }
+
+#if !defined(__EMSCRIPTEN__)
+#if PG_ENABLE_SSE_NEON
+    if (pg_HasSSE_NEON()) {
+        average_row = accumulator_average_sse2;
+    }
+#endif /* PG_ENABLE_SSE_NEON */
+#endif /* !__EMSCRIPTEN__ */
+    for (y = 0; y < self->h; y++) {
+        average_row(pixels + (size_t)y * surf->pitch, sums + (size_t)y * n, n,
+                    scale);
+    }
+}
+
+static int
+_accumulator_check_idle(pgAccumulatorObject *self)
+{
+    if (self->busy) {
+        PyErr_SetString(PyExc_RuntimeError,
+                        "Accumulator is in use by another thread");
+        return 0;
+    }
+    return 1;
+}
+
+static PyObject *
+accumulator_new(PyTypeObject *type, PyObject *args, PyObject *kwargs)
+{
+    pgAccumulatorObject *self =
+        (pgAccumulatorObject *)type->tp_alloc(type, 0);
+
+    if (self) {
+        self->w = 0;
+        self->h = 0;
+        self->sums = NULL;
+        self->count = 0;
+        self->layout = NULL;
+        self->busy = 0;
+    }
+    return (PyObject *)self;
+}
+
+static int
+accumulator_init(pgAccumulatorObject *self, PyObject *args, PyObject *kwargs)
+{
+    PyObject *size;
+    Uint32 *sums;
+    int w, h;
+    static char *keywords[] = {"size", NULL};
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "O", keywords, &size)) {
+        return -1;
+    }
+    if (!pg_TwoIntsFromObj(size, &w, &h)) {
+        PyErr_SetString(PyExc_TypeError, "size must be two numbers");
+        return -1;
+    }
+    if (w < 0 || h < 0) {
+        PyErr_SetString(PyExc_ValueError,
+                        "cannot create an Accumulator with negative size");
+        return -1;
+    }
+    if (!_accumulator_check_idle(self)) {
+        return -1;
+    }
+
+    /* 1 for empty accumulators, calloc(0) may return NULL */
+    sums = (Uint32 *)calloc((size_t)w * h * 4 + 1, sizeof(Uint32));
+    if (!sums) {
+        PyErr_NoMemory();
+        return -1;
+    }
+    free(self->sums);
+    if (self->layout) {
+        SDL_FreeFormat(self->layout);
+    }
+    self->w = w;
+    self->h = h;
+    self->sums = sums;
+    self->count = 0;
+    self->layout = NULL;
+    return 0;
+}
+
+static void
+accumulator_dealloc(pgAccumulatorObject *self)
+{
+    free(self->sums);
+    if (self->layout) {
+        SDL_FreeFormat(self->layout);
+    }
+    Py_TYPE(self)->tp_free((PyObject *)self);
+}
+
+static PyObject *
+accumulator_add_method(pgAccumulatorObject *self, PyObject *arg)
+{
+    SDL_Surface *surf;
+
+    if (!pgSurface_Check(arg)) {
+        return RAISE(PyExc_TypeError, "argument must be a Surface");
+    }
+    surf = pgSurface_AsSurface(arg);
+    SURF_INIT_CHECK(surf)
+
+    if (!self->sums) {
+        return RAISE(PyExc_RuntimeError, "Accumulator is not initialized");
+    }
+    if (!_accumulator_check_idle(self)) {
+        return NULL;
+    }
+    if (surf->w != self->w || surf->h != self->h) {
+        return RAISE(PyExc_ValueError,
+                     "Surface must be the same size as the Accumulator");
+    }
+    if (self->count >= ACCUMULATOR_MAX_COUNT) {
+        return RAISE(PyExc_OverflowError,
+                     "too many surfaces added to the Accumulator");
+    }
+
+    if (!self->layout) {
+        self->layout = SDL_AllocFormat(_byte_channels_format(surf->format)
+                                           ? surf->format->format
+                                           : SDL_PIXELFORMAT_ARGB8888);
+        if (!self->layout) {
+            return RAISE(pgExc_SDLError, SDL_GetError());
+        }
+    }
+
+    self->busy = 1;
+    pgSurface_Lock((pgSurfaceObject *)arg);
+    Py_BEGIN_ALLOW_THREADS;
+    _accumulator_add_surface(self, surf);
+    Py_END_ALLOW_THREADS;
+    pgSurface_Unlock((pgSurfaceObject *)arg);
+    self->busy = 0;
+
+    self->count++;
+    Py_RETURN_NONE;
+}
+
+static PyObject *
+accumulator_get_average(pgAccumulatorObject *self, PyObject *args,
+                        PyObject *kwargs)
+{
+    pgSurfaceObject *surfobj = NULL;
+    SDL_Surface *surf;
+    static char *keywords[] = {"dest_surface", NULL};
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "|O!", keywords,
+                                     &pgSurface_Type, &surfobj)) {
+        return NULL;
+    }
+    if (!_accumulator_check_idle(self)) {
+        return NULL;
+    }
+    if (!self->count) {
+        return RAISE(PyExc_ValueError,
+                     "no surfaces have been added to the Accumulator");
+    }
+
+    if (surfobj) {
+        surf = pgSurface_AsSurface(surfobj);
+        SURF_INIT_CHECK(surf)
+        if (surf->w != self->w || surf->h != self->h) {
+            return RAISE(PyExc_ValueError,
+                         "Destination surface not the same size.");
+        }
+        Py_INCREF(surfobj);
+    }
+    else {
+        surf = PG_CreateSurface(self->w, self->h, self->layout->format);
+        if (!surf) {
+            return RAISE(pgExc_SDLError, SDL_GetError());
+        }
+        surfobj = pgSurface_New(surf);
+        if (!surfobj) {
+            SDL_FreeSurface(surf);
+            return NULL;
+        }
+    }
+
+    self->busy = 1;
+    pgSurface_Lock(surfobj);
+    Py_BEGIN_ALLOW_THREADS;
+    _accumulator_average_surface(self, surf);
+    Py_END_ALLOW_THREADS;
+    pgSurface_Unlock(surfobj);
+    self->busy = 0;
+
+    return (PyObject *)surfobj;
+}
+
+static PyObject *
+accumulator_clear(pgAccumulatorObject *self, PyObject *_null)
+{
+    if (!_accumulator_check_idle(self)) {
+        return NULL;
+    }
+    if (self->sums) {
+        memset(self->sums, 0, (size_t)self->w * self->h * 4 * sizeof(Uint32));
+    }
+    self->count = 0;
+    Py_RETURN_NONE;
+}
+
+static PyObject *
+accumulator_get_count(pgAccumulatorObject *self, void *closure)
+{
+    return PyLong_FromUnsignedLong(self->count);
+}
+
+static PyObject *
+accumulator_get_size(pgAccumulatorObject *self, void *closure)
+{
+    return Py_BuildValue("(ii)", self->w, self->h);
+}
+
+static PyMethodDef accumulator_methods[] = {
+    {"add", (PyCFunction)accumulator_add_method, METH_O,
+     DOC_TRANSFORM_ACCUMULATOR_ADD},
+    {"get_average", (PyCFunction)accumulator_get_average,
+     METH_VARARGS | METH_KEYWORDS, DOC_TRANSFORM_ACCUMULATOR_GETAVERAGE},
+    {"clear", (PyCFunction)accumulator_clear, METH_NOARGS,
+     DOC_TRANSFORM_ACCUMULATOR_CLEAR},
+    {NULL, NULL, 0, NULL}};
+
+static PyGetSetDef accumulator_getsets[] = {
+    {"count", (getter)accumulator_get_count, NULL,
+     DOC_TRANSFORM_ACCUMULATOR_COUNT, NULL},
+    {"size", (getter)accumulator_get_size, NULL,
+     DOC_TRANSFORM_ACCUMULATOR_SIZE, NULL},
+    {NULL, 0, NULL, NULL, NULL}};
+
+static PyTypeObject pgAccumulator_Type = {
+    PyVarObject_HEAD_INIT(NULL, 0).tp_name = "pygame.transform.Accumulator",
+    .tp_basicsize = sizeof(pgAccumulatorObject),
+    .tp_dealloc = (destructor)accumulator_dealloc,
+    .tp_flags = Py_TPFLAGS_DEFAULT | Py_TPFLAGS_BASETYPE,
+    .tp_doc = DOC_TRANSFORM_ACCUMULATOR,
+    .tp_methods = accumulator_methods,
+    .tp_getset = accumulator_getsets,
+    .tp_init = (initproc)accumulator_init,
+    .tp_new = accumulator_new,
+};
+
+/* LightMap, a light layer that is multiplied onto a scene in one pass.
+
+   Lights are added to a buffer of 4 Uint16 per pixel, laid out like the
+   bytes of an ARGB8888 pixel, so they can go past full brightness without
+   clipping. apply() then multiplies the surface by the buffer, fusing the
+   darkness fill, the light blits and the BLEND_RGB_MULT blit of the usual
+   light layer Surface into one pass over the scene. */
+
+#define LIGHTMAP_B _PG_BYTE_INDEX(0)
+#define LIGHTMAP_G _PG_BYTE_INDEX(8)
+#define LIGHTMAP_R _PG_BYTE_INDEX(16)
+#define LIGHTMAP_A _PG_BYTE_INDEX(24)
+
+typedef struct {
+    PyObject_HEAD int w;
+    int h;
+    Uint16 *light;    /* 4 per pixel */
+    Uint8 ambient[3]; /* the light after a clear(), as r, g, b */
+    int busy;         /* set while the GIL is released */
+} pgLightMapObject;
+
+void
+lightmap_stamp_row(Uint16 *light, const Uint32 *src, int n, int intensity,
+                   int has_alpha, int max)
+{
+    const Uint8 *pix = (const Uint8 *)src;
+    Uint32 weight, v;
+    int i, k;
+
+    for (i = 0; i < n; i++, pix += 4, light += 4) {
+        weight = has_alpha ? PG_LIGHTMAP_DIV255(pix[LIGHTMAP_A] * intensity)
+                           : (Uint32)intensity;
+        for (k = 0; k < 4; k++) {
+            if (k == LIGHTMAP_A) {
+                continue;
+            }
+            v = PG_LIGHTMAP_DIV255(pix[k] * weight);
+            if (max) {
+                light[k] = v > light[k] ? (Uint16)v : light[k];
+            }
+            else {
+                v += light[k];
+                light[k] = v > 0xFFFF ? 0xFFFF : (Uint16)v;
+            }
+        }
+    }
+}
+
+static PG_INLINE Uint8
+_lightmap_mul(Uint8 c, Uint16 l)
+{
+    Uint32 v = ((Uint32)c * l + 255) >> 8;
+    return v > 255 ? 255 : (Uint8)v;
+}
+
+void
+lightmap_apply_row(Uint32 *dst, const Uint16 *light, int n)
+{
+    Uint8 *pix = (Uint8 *)dst;
+    int i;
+
+    for (i = 0; i < n * 4; i++) {
+        pix[i] = _lightmap_mul(pix[i], light[i]);
+    }
+}
+
+/* Whether the 32 bit format has the color bytes of ARGB8888, with or
+ * without alpha, which the row kernels work on directly */
+static int
+_lightmap_argb_format(SDL_PixelFormat *format)
+{
+    return PG_FORMAT_BytesPerPixel(format) == 4 &&
+           format->Rmask == 0x00FF0000 && format->Gmask == 0x0000FF00 &&
+           format->Bmask == 0x000000FF &&
+           (!format->Amask || format->Amask == 0xFF000000);
+}
+
+static void
+_lightmap_fill(pgLightMapObject *self, const Uint8 *rgb)
+{
+    Uint16 pixel[4];
+    size_t i, n = (size_t)self->w * self->h;
+
+    pixel[LIGHTMAP_R] = rgb[0];
+    pixel[LIGHTMAP_G] = rgb[1];
+    pixel[LIGHTMAP_B] = rgb[2];
+    pixel[LIGHTMAP_A] = 255;
+    for (i = 0; i < n; i++) {
+        memcpy(self->light + i * 4, pixel, sizeof(pixel));
+    }
+}
+
+/* Adds the w x h pixels of surf at (sx, sy) to the light at (x, y). row is
+ * room for w pixels, for surfaces that are converted to ARGB8888 first. */
+static void
+_lightmap_stamp(pgLightMapObject *self, SDL_Surface *surf, int sx, int sy,
+                int x, int y, int w, int h, Uint32 *row, int intensity,
+                int max)
+{
+    SDL_PixelFormat *format = surf->format;
+    Uint8 *pixels = (Uint8 *)surf->pixels;
+    Uint8 *pix;
+    Uint32 color;
+    Uint8 r, g, b, a;
+    const Uint32 *src;
+    int has_alpha = format->Amask != 0;
+    int i, j;
+    LIGHTMAP_STAMP_ROW_P stamp_row = lightmap_stamp_row;
+
+    /* the SIMD kernels take the alpha from the last byte of the pixels */
+#if SDL_BYTEORDER == SDL_LIL_ENDIAN
+#if !defined(__EMSCRIPTEN__)
+    if (pg_has_avx2()) {
+        stamp_row = lightmap_stamp_row_avx2;
+    }
+#if PG_ENABLE_SSE_NEON
+    else if (pg_HasSSE_NEON()) {
+        stamp_row = lightmap_stamp_row_sse2;
+    }
+#endif /* PG_ENABLE_SSE_NEON */
+#endif /* !__EMSCRIPTEN__ */
+#endif /* SDL_BYTEORDER == SDL_LIL_ENDIAN */
+
+    for (j = 0; j < h; j++) {
+        if (row) {
+            for (i = 0; i < w; i++) {
+                SURF_GET_AT(color, surf, sx + i, sy + j, pixels, format,
+                            pix);
+                SDL_GetRGBA(color, format, &r, &g, &b, &a);
+                row[i] = ((Uint32)a << 24) | ((Uint32)r << 16) |
+                         ((Uint32)g << 8) | b;
+            }
+            src = row;
+        }
+        else {
+            src = (const Uint32 *)(pixels + (size_t)(sy + j) * surf->pitch) +
+                  sx;
+        }
+        stamp_row(self->light + ((size_t)(y + j) * self->w + x) * 4, src, w,
+                  intensity, has_alpha, max);
+    }
+}
+
+/* Multiplies the w x h pixels of surf at (x, y) by the light at (lx, ly) */
+static void
+_lightmap_apply(pgLightMapObject *self, SDL_Surface *surf, int x, int y,
+                int lx, int ly, int w, int h)
+{
+    SDL_PixelFormat *format = surf->format;
+    Uint8 *pixels = (Uint8 *)surf->pixels;
+    Uint8 *pix;
+    const Uint16 *light;
+    Uint32 color;
+    Uint8 r, g, b, a;
+    int i, j;
+    LIGHTMAP_APPLY_ROW_P apply_row = lightmap_apply_row;
+
+    if (_lightmap_argb_format(format)) {
+#if !defined(__EMSCRIPTEN__)
+        if (pg_has_avx2()) {
+            apply_row = lightmap_apply_row_avx2;
+        }
+#if PG_ENABLE_SSE_NEON
+        else if (pg_HasSSE_NEON()) {
+            apply_row = lightmap_apply_row_sse2;
+        }
+#endif /* PG_ENABLE_SSE_NEON */
+#endif /* !__EMSCRIPTEN__ */
+        for (j = 0; j < h; j++) {
+            apply_row(
+                (Uint32 *)(pixels + (size_t)(y + j) * surf->pitch) + x,
+                self->light + ((size_t)(ly + j) * self->w + lx) * 4, w);
+        }
+    }
+    else if (_byte_channels_format(format)) {
+        const int ri = _PG_BYTE_INDEX(format->Rshift);
+        const int gi = _PG_BYTE_INDEX(format->Gshift);
+        const int bi = _PG_BYTE_INDEX(format->Bshift);
+
+        for (j = 0; j < h; j++) {
+            pix = pixels + (size_t)(y + j) * surf->pitch + (size_t)x * 4;
+            light = self->light + ((size_t)(ly + j) * self->w + lx) * 4;
+            for (i = 0; i < w; i++, pix += 4, light += 4) {
+                pix[ri] = _lightmap_mul(pix[ri], light[LIGHTMAP_R]);
+                pix[gi] = _lightmap_mul(pix[gi], light[LIGHTMAP_G]);
+                pix[bi] = _lightmap_mul(pix[bi], light[LIGHTMAP_B]);
+            }
+        }
+    }
+    else {
+        for (j = 0; j < h; j++) {
+            light = self->light + ((size_t)(ly + j) * self->w + lx) * 4;
+            for (i = 0; i < w; i++, light += 4) {
+                SURF_GET_AT(color, surf, x + i, y + j, pixels, format, pix);
+                SDL_GetRGBA(color, format, &r, &g, &b, &a);
+                color = SDL_MapRGBA(
+                    format, _lightmap_mul(r, light[LIGHTMAP_R]),
+                    _lightmap_mul(g, light[LIGHTMAP_G]),
+                    _lightmap_mul(b, light[LIGHTMAP_B]), a);
+                SURF_SET_AT(color, surf, x + i, y + j, pixels, format, pix);
+            }
+        }
+    }
+}
+
+static int
+_lightmap_check_idle(pgLightMapObject *self)
+{
+    if (self->busy) {
+        PyErr_SetString(PyExc_RuntimeError,
+                        "LightMap is in use by another thread");
+        return 0;
+    }
+    return 1;
+}
+
+/* Reads a position, or the topleft of a rect */
+static int
+_lightmap_position(PyObject *obj, int *x, int *y)
+{
+    SDL_Rect temp, *rect;
+
+    if (pg_TwoIntsFromObj(obj, x, y)) {
+        return 1;
+    }
+    if ((rect = pgRect_FromObject(obj, &temp))) {
+        *x = rect->x;
+        *y = rect->y;
+        return 1;
+    }
+    PyErr_SetString(PyExc_TypeError, "invalid destination position");
+    return 0;
+}
+
+static PyObject *
+lightmap_new(PyTypeObject *type, PyObject *args, PyObject *kwargs)
+{
+    pgLightMapObject *self = (pgLightMapObject *)type->tp_alloc(type, 0);
+
+    if (self) {
+        self->w = 0;
+        self->h = 0;
+        self->light = NULL;
+        memset(self->ambient, 0, sizeof(self->ambient));
+        self->busy = 0;
+    }
+    return (PyObject *)self;
+}
+
+static int
+lightmap_init(pgLightMapObject *self, PyObject *args, PyObject *kwargs)
+{
+    PyObject *size, *ambientobj = NULL;
+    Uint16 *light;
+    Uint8 rgba[4] = {0, 0, 0, 255};
+    int w, h;
+    static char *keywords[] = {"size", "ambient", NULL};
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "O|O", keywords, &size,
+                                     &ambientobj)) {
+        return -1;
+    }
+    if (!pg_TwoIntsFromObj(size, &w, &h)) {
+        PyErr_SetString(PyExc_TypeError, "size must be two numbers");
+        return -1;
+    }
+    if (w < 0 || h < 0) {
+        PyErr_SetString(PyExc_ValueError,
+                        "cannot create a LightMap with negative size");
+        return -1;
+    }
+    if (ambientobj &&
+        !pg_RGBAFromObjEx(ambientobj, rgba, PG_COLOR_HANDLE_ALL)) {
+        return -1;
+    }
+    if (!_lightmap_check_idle(self)) {
+        return -1;
+    }
+
+    /* 1 for empty light maps, malloc(0) may return NULL */
+    light = (Uint16 *)malloc(((size_t)w * h * 4 + 1) * sizeof(Uint16));
+    if (!light) {
+        PyErr_NoMemory();
+        return -1;
+    }
+    free(self->light);
+    self->w = w;
+    self->h = h;
+    self->light = light;
+    memcpy(self->ambient, rgba, sizeof(self->ambient));
+    _lightmap_fill(self, self->ambient);
+    return 0;
+}
+
+static void
+lightmap_dealloc(pgLightMapObject *self)
+{
+    free(self->light);
+    Py_TYPE(self)->tp_free((PyObject *)self);
+}
+
+static PyObject *
+lightmap_add(pgLightMapObject *self, PyObject *args, PyObject *kwargs)
+{
+    pgSurfaceObject *surfobj;
+    PyObject *dest;
+    SDL_Surface *surf;
+    Uint32 *row = NULL;
+    int x, y, sx = 0, sy = 0, w, h, intensity = 255, flags = 0, max;
+    static char *keywords[] = {"light", "dest", "intensity", "special_flags",
+                               NULL};
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "O!O|ii", keywords,
+                                     &pgSurface_Type, &surfobj, &dest,
+                                     &intensity, &flags)) {
+        return NULL;
+    }
+    surf = pgSurface_AsSurface(surfobj);
+    SURF_INIT_CHECK(surf)
+
+    if (!self->light) {
+        return RAISE(PyExc_RuntimeError, "LightMap is not initialized");
+    }
+    if (!_lightmap_check_idle(self)) {
+        return NULL;
+    }
+    if (!_lightmap_position(dest, &x, &y)) {
+        return NULL;
+    }
+    if (intensity < 0 || intensity > 255) {
+        return RAISE(PyExc_ValueError,
+                     "intensity must be between 0 and 255");
+    }
+    switch (flags) {
+        case 0:
+        case PYGAME_BLEND_RGB_ADD:
+        case PYGAME_BLEND_RGBA_ADD:
+            max = 0;
+            break;
+        case PYGAME_BLEND_RGB_MAX:
+        case PYGAME_BLEND_RGBA_MAX:
+            max = 1;
+            break;
+        default:
+            return RAISE(PyExc_ValueError,
+                         "special_flags must be 0, BLEND_ADD or BLEND_MAX");
+    }
+
+    /* clip the light to the map */
+    w = surf->w;
+    h = surf->h;
+    if (x < 0) {
+        sx = -x;
+        w += x;
+        x = 0;
+    }
+    if (y < 0) {
+        sy = -y;
+        h += y;
+        y = 0;
+    }
+    w = MIN(w, self->w - x);
+    h = MIN(h, self->h - y);
+    if (w <= 0 || h <= 0) {
+        Py_RETURN_NONE;
+    }
+
+    if (!_lightmap_argb_format(surf->format)) {
+        row = (Uint32 *)malloc((size_t)w * sizeof(Uint32));
+        if (!row) {
+            return PyErr_NoMemory();
+        }
+    }
+
+    self->busy = 1;
+    pgSurface_Lock(surfobj);
+    Py_BEGIN_ALLOW_THREADS;
+    _lightmap_stamp(self, surf, sx, sy, x, y, w, h, row, intensity, max);
+    Py_END_ALLOW_THREADS;
+    pgSurface_Unlock(surfobj);
+    self->busy = 0;
+
+    free(row);
+    Py_RETURN_NONE;
+}
+
+static PyObject *
+lightmap_apply(pgLightMapObject *self, PyObject *args, PyObject *kwargs)
+{
+    pgSurfaceObject *surfobj;
+    PyObject *dest = NULL;
+    SDL_Surface *surf;
+    SDL_Rect clip;
+    int x = 0, y = 0, lx = 0, ly = 0, w, h;
+    static char *keywords[] = {"surface", "dest", NULL};
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "O!|O", keywords,
+                                     &pgSurface_Type, &surfobj, &dest)) {
+        return NULL;
+    }
+    surf = pgSurface_AsSurface(surfobj);
+    SURF_INIT_CHECK(surf)
+
+    if (!self->light) {
+        return RAISE(PyExc_RuntimeError, "LightMap is not initialized");
+    }
+    if (!_lightmap_check_idle(self)) {
+        return NULL;
+    }
+    if (dest && !_lightmap_position(dest, &x, &y)) {
+        return NULL;
+    }
+
+    /* clip the map to the clip rect of the surface */
+    SDL_GetClipRect(surf, &clip);
+    w = self->w;
+    h = self->h;
+    if (x < clip.x) {
+        lx = clip.x - x;
+        w -= lx;
+        x = clip.x;
+    }
+    if (y < clip.y) {
+        ly = clip.y - y;
+        h -= ly;
+        y = clip.y;
+    }
+    w = MIN(w, clip.x + clip.w - x);
+    h = MIN(h, clip.y + clip.h - y);
+    if (w <= 0 || h <= 0) {
+        return pgRect_New4(x, y, 0, 0);
+    }
+
+    self->busy = 1;
+    pgSurface_Lock(surfobj);
+    Py_BEGIN_ALLOW_THREADS;
+    _lightmap_apply(self, surf, x, y, lx, ly, w, h);
+    Py_END_ALLOW_THREADS;
+    pgSurface_Unlock(surfobj);
+    self->busy = 0;
+
+    return pgRect_New4(x, y, w, h);
+}
+
+static PyObject *
+lightmap_clear(pgLightMapObject *self, PyObject *args, PyObject *kwargs)
+{
+    PyObject *ambientobj = Py_None;
+    Uint8 rgba[4];
+    static char *keywords[] = {"ambient", NULL};
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "|O", keywords,
+                                     &ambientobj)) {
+        return NULL;
+    }
+    if (!_lightmap_check_idle(self)) {
+        return NULL;
+    }
+    if (ambientobj != Py_None) {
+        if (!pg_RGBAFromObjEx(ambientobj, rgba, PG_COLOR_HANDLE_ALL)) {
+            return NULL;
+        }
+        memcpy(self->ambient, rgba, sizeof(self->ambient));
+    }
+    if (self->light) {
+        _lightmap_fill(self, self->ambient);
+    }
+    Py_RETURN_NONE;
+}
+
+static PyObject *
+lightmap_get_size(pgLightMapObject *self, void *closure)
+{
+    return Py_BuildValue("(ii)", self->w, self->h);
+}
+
+static PyObject *
+lightmap_get_ambient(pgLightMapObject *self, void *closure)
+{
+    return Py_BuildValue("(iii)", self->ambient[0], self->ambient[1],
+                         self->ambient[2]);
+}
+
+static PyMethodDef lightmap_methods[] = {
+    {"add", (PyCFunction)lightmap_add, METH_VARARGS | METH_KEYWORDS,
+     DOC_TRANSFORM_LIGHTMAP_ADD},
+    {"apply", (PyCFunction)lightmap_apply, METH_VARARGS | METH_KEYWORDS,
+     DOC_TRANSFORM_LIGHTMAP_APPLY},
+    {"clear", (PyCFunction)lightmap_clear, METH_VARARGS | METH_KEYWORDS,
+     DOC_TRANSFORM_LIGHTMAP_CLEAR},
+    {NULL, NULL, 0, NULL}};
+
+static PyGetSetDef lightmap_getsets[] = {
+    {"size", (getter)lightmap_get_size, NULL, DOC_TRANSFORM_LIGHTMAP_SIZE,
+     NULL},
+    {"ambient", (getter)lightmap_get_ambient, NULL,
+     DOC_TRANSFORM_LIGHTMAP_AMBIENT, NULL},
+    {NULL, 0, NULL, NULL, NULL}};
+
+static PyTypeObject pgLightMap_Type = {
+    PyVarObject_HEAD_INIT(NULL, 0).tp_name = "pygame.transform.LightMap",
+    .tp_basicsize = sizeof(pgLightMapObject),
+    .tp_dealloc = (destructor)lightmap_dealloc,
+    .tp_flags = Py_TPFLAGS_DEFAULT | Py_TPFLAGS_BASETYPE,
+    .tp_doc = DOC_TRANSFORM_LIGHTMAP,
+    .tp_methods = lightmap_methods,
+    .tp_getset = lightmap_getsets,
+    .tp_init = (initproc)lightmap_init,
+    .tp_new = lightmap_new,
+};
+
+/* average_color() of large regions is split into bands of rows, which are
+ * summed up on separate threads and added together at the end. */
+#define AVERAGE_COLOR_MAX_THREADS 64
+#define AVERAGE_COLOR_THREAD_MIN_ROWS 16
+#define AVERAGE_COLOR_THREAD_MIN_PIXELS (1 << 16)
+
+typedef struct {
+    SDL_Surface *surf;
+    AVERAGE_COLOR_ROW_P row_func;
+    int x;
+    int width;
+    int alpha_byte;
+    int y_start;
+    int y_end;
+    Uint64 sums[4];
+} pg_AverageColorBand;
+
+void
+average_color_row(const Uint8 *row, int n, int alpha_byte, Uint64 *sums)
+{
+    Uint64 totals[4] = {0, 0, 0, 0}, alpha_total = 0;
+    Uint32 alpha = 1;
+    int i, k;
+
+    for (i = 0; i < n; i++, row += 4) {
+        if (alpha_byte >= 0) {
+            alpha = row[alpha_byte];
+            alpha_total += alpha;
+        }
+        totals[0] += row[0] * alpha;
+        totals[1] += row[1] * alpha;
+        totals[2] += row[2] * alpha;
+        totals[3] += row[3] * alpha;
+    }
+    if (alpha_byte >= 0) {
+        totals[alpha_byte] = alpha_total;
+    }
+    for (k = 0; k < 4; k++) {
+        sums[k] += totals[k];
+    }
+}
+
+static void
+_average_color_band(void *data, int i)
+{
+    pg_AverageColorBand *band = (pg_AverageColorBand *)data + i;
+    SDL_Surface *surf = band->surf;
+    int y;
 
-        SDL_LockSurface(newsurf);
+    for (y = band->y_start; y < band->y_end; y++) {
+        band->row_func((Uint8 *)surf->pixels + (size_t)y * surf->pitch +
+                           band->x * 4,
+                       band->width, band->alpha_byte, band->sums);
+    }
+}
 
-        Py_BEGIN_ALLOW_THREADS;
-        average_surfaces(surfaces, size, newsurf, palette_colors);
-        Py_END_ALLOW_THREADS;
+/* Adds up the bytes of the pixels of a region of a 32 bit surface into
+ * sums[0..3], see average_color_row(). Must be called without the GIL. */
+static void
+_average_color_sums(SDL_Surface *surf, int x, int y, int width, int height,
+                    int alpha_byte, int num_threads, Uint64 *sums)
+{
+    pg_AverageColorBand bands[AVERAGE_COLOR_MAX_THREADS];
+    AVERAGE_COLOR_ROW_P row_func = average_color_row;
+    int nbands = MIN(num_threads, height / AVERAGE_COLOR_THREAD_MIN_ROWS);
+    int i, k;
 
-        SDL_UnlockSurface(newsurf);
+#if !defined(__EMSCRIPTEN__)
+    if (pg_has_avx2()) {
+        row_func = average_color_row_avx2;
+    }
+#if PG_ENABLE_SSE_NEON
+    else if (pg_HasSSE_NEON()) {
+        row_func = average_color_row_sse2;
+    }
+#endif /* PG_ENABLE_SSE_NEON */
+#endif /* !__EMSCRIPTEN__ */
 
-        if (surfobj2) {
-            Py_INCREF(surfobj2);
-            ret = surfobj2;
-        }
-        else {
-            ret = (PyObject *)pgSurface_New(newsurf);
-        }
+    if (nbands < 2 || width * height < AVERAGE_COLOR_THREAD_MIN_PIXELS) {
+        nbands = 1;
     }
 
-    /* cleanup */
+    for (i = 0; i < nbands; i++) {
+        bands[i].surf = surf;
+        bands[i].row_func = row_func;
+        bands[i].x = x;
+        bands[i].width = width;
+        bands[i].alpha_byte = alpha_byte;
+        bands[i].y_start = y + (int)((Sint64)height * i / nbands);
+        bands[i].y_end = y + (int)((Sint64)height * (i + 1) / nbands);
+        memset(bands[i].sums, 0, sizeof(bands[i].sums));
+    }
 
-    /* unlock the surfaces we got up to. */
+    pg_run_bands(_average_color_band, bands, nbands);
 
-    for (loop = 0; loop < loop_up_to; loop++) {
-        if (surfaces[loop]) {
-            SDL_UnlockSurface(surfaces[loop]);
+    memset(sums, 0, 4 * sizeof(Uint64));
+    for (i = 0; i < nbands; i++) {
+        for (k = 0; k < 4; k++) {
+            sums[k] += bands[i].sums[k];
         }
     }
-
-    free(surfaces);
-
-    return ret;
 }
 
 /* VS 2015 crashes when compiling this function, turning off optimisations to
@@ -3093,7 +5594,8 @@ surf_average_surfaces(PyObject *self, PyObject *args, PyObject *kwargs)
 
 void
 average_color(SDL_Surface *surf, int x, int y, int width, int height, Uint8 *r,
-              Uint8 *g, Uint8 *b, Uint8 *a, SDL_bool consider_alpha)
+              Uint8 *g, Uint8 *b, Uint8 *a, SDL_bool consider_alpha,
+              int num_threads)
 {
     Uint32 color, rmask, gmask, bmask, amask;
     Uint8 *pixels;
@@ -3133,6 +5635,27 @@ average_color(SDL_Surface *surf, int x, int y, int width, int height, Uint8 *r,
         y = 0;
     }
 
+    /* Whole byte channels are summed straight from the pixels, with 64 bit
+     * totals. Which also keeps the weighted totals of big regions from
+     * overflowing. */
+    if (_byte_channels_format(format) && width > 0 && height > 0 &&
+        (amask || !consider_alpha)) {
+        Uint64 sums[4];
+        Uint64 count = (Uint64)width * height, total = count;
+
+        _average_color_sums(surf, x, y, width, height,
+                            consider_alpha ? _PG_BYTE_INDEX(ashift) : -1,
+                            num_threads, sums);
+        *a = amask ? (Uint8)(sums[_PG_BYTE_INDEX(ashift)] / count) : 0;
+        if (consider_alpha && sums[_PG_BYTE_INDEX(ashift)]) {
+            total = sums[_PG_BYTE_INDEX(ashift)];
+        }
+        *r = (Uint8)(sums[_PG_BYTE_INDEX(rshift)] / total);
+        *g = (Uint8)(sums[_PG_BYTE_INDEX(gshift)] / total);
+        *b = (Uint8)(sums[_PG_BYTE_INDEX(bshift)] / total);
+        return;
+    }
+
     size = width * height;
     width_and_x = width + x;
     height_and_y = height + y;
@@ -3311,6 +5834,7 @@ surf_average_color(PyObject *self, PyObject *args, PyObject *kwargs)
     int x, y, w, h;
     static char *keywords[] = {"surface", "rect", "consider_alpha", NULL};
     SDL_bool consider_alpha = SDL_FALSE;
+    int num_threads = GETSTATE(self)->average_color_threads;
 
     if (!PyArg_ParseTupleAndKeywords(args, kwargs, "O!|Op", keywords,
                                      &pgSurface_Type, &surfobj, &rectobj,
@@ -3336,57 +5860,155 @@ surf_average_color(PyObject *self, PyObject *args, PyObject *kwargs)
     }
 
     Py_BEGIN_ALLOW_THREADS;
-    average_color(surf, x, y, w, h, &r, &g, &b, &a, consider_alpha);
+    average_color(surf, x, y, w, h, &r, &g, &b, &a, consider_alpha,
+                  num_threads);
     Py_END_ALLOW_THREADS;
 
     pgSurface_Unlock(surfobj);
     return Py_BuildValue("(bbbb)", r, g, b, a);
 }
 
+static PyObject *
+surf_set_average_color_threads(PyObject *self, PyObject *arg)
+{
+    long num_threads = PyLong_AsLong(arg);
+
+    if (num_threads == -1 && PyErr_Occurred()) {
+        return NULL;
+    }
+    if (num_threads < 0) {
+        return RAISE(
+            PyExc_ValueError,
+            "the number of average_color threads must not be negative");
+    }
+    if (num_threads == 0) {
+        num_threads = SDL_GetCPUCount();
+    }
+    GETSTATE(self)->average_color_threads =
+        (int)MIN(num_threads, AVERAGE_COLOR_MAX_THREADS);
+    Py_RETURN_NONE;
+}
+
+static PyObject *
+surf_get_average_color_threads(PyObject *self, PyObject *_null)
+{
+    return PyLong_FromLong(GETSTATE(self)->average_color_threads);
+}
+
+/* Blurs are split into bands of rows that can run on separate threads, every
+ * band only reads the source surface and writes its own destination rows. */
+#define BLUR_MAX_THREADS 64
+#define BLUR_THREAD_MIN_ROWS 16
+#define BLUR_THREAD_MIN_PIXELS (1 << 16)
+/* keeps 255 * (radius + 1) ** 2 within a Uint32 */
+#define STACK_BLUR_MAX_RADIUS 4095
+
+typedef struct pg_BlurBand pg_BlurBand;
+
+struct pg_BlurBand {
+    int (*func)(pg_BlurBand *band);
+    SDL_Surface *src;
+    SDL_Surface *dst;
+    int radius;       /* box radius, or gaussian kernel radius */
+    const float *lut; /* gaussian half kernel, lut[0] is the center */
+    BLUR_ACCUMULATE_U8_P accumulate_u8;
+    BLUR_ACCUMULATE_F32_P accumulate_f32;
+    SDL_bool repeat;
+    /* convolve: kernel_h rows of kernel_w weights, or for separable kernels
+     * kernel_h column weights followed by kernel_w row weights */
+    const float *kernel;
+    int kernel_w;
+    int kernel_h;
+    int alpha_index; /* byte kept from the source, or -1 */
+    int y_start;
+    int y_end;
+    int result;
+};
+
+/* Returns source row y, the nearest edge row if y is out of bounds and edge
+ * pixels are repeated, or NULL if it contributes nothing. */
+static Uint8 *
+_blur_src_row(SDL_Surface *src, int y, SDL_bool repeat)
+{
+    if (y < 0) {
+        return repeat ? (Uint8 *)src->pixels : NULL;
+    }
+    if (y >= src->h) {
+        y = src->h - 1;
+        if (!repeat) {
+            return NULL;
+        }
+    }
+    return (Uint8 *)src->pixels + y * src->pitch;
+}
+
+static void
+blur_accumulate_u8(float *acc, const Uint8 *src, int n, float weight)
+{
+    int i;
+    for (i = 0; i < n; i++) {
+        acc[i] += (float)src[i] * weight;
+    }
+}
+
 static void
-box_blur(SDL_Surface *src, SDL_Surface *dst, int radius, SDL_bool repeat)
+blur_accumulate_f32(float *acc, const float *src, int n, float weight)
+{
+    int i;
+    for (i = 0; i < n; i++) {
+        acc[i] += src[i] * weight;
+    }
+}
+
+static int
+box_blur(pg_BlurBand *band)
 {
     // Reference : https://blog.csdn.net/blogshinelee/article/details/80997324
 
-    Uint8 *srcpx = (Uint8 *)src->pixels;
+    SDL_Surface *src = band->src;
+    SDL_Surface *dst = band->dst;
     Uint8 *dstpx = (Uint8 *)dst->pixels;
     Uint8 nb = PG_SURF_BytesPerPixel(src);
-    int w = dst->w, h = dst->h;
+    int w = dst->w;
+    int row_len = w * nb;
     int dst_pitch = dst->pitch;
-    int src_pitch = src->pitch;
+    int radius = band->radius;
+    SDL_bool repeat = band->repeat;
     int i, x, y, color;
-    Uint32 *buf = malloc(dst_pitch * sizeof(Uint32));
-    Uint32 *sum_v = malloc(dst_pitch * sizeof(Uint32));
-    Uint32 *sum_h = malloc(nb * sizeof(Uint32));
+    Uint8 *row, *row_out, *row_in;
+    Uint32 sum_h[4];
+    Uint32 *buf = malloc(row_len * sizeof(Uint32));
+    Uint32 *sum_v = calloc(row_len, sizeof(Uint32));
+    /* stands in for rows outside of the surface without repeat */
+    Uint8 *zeros = calloc(row_len, 1);
+
+    if (!buf || !sum_v || !zeros) {
+        free(buf);
+        free(sum_v);
+        free(zeros);
+        return -1;
+    }
 
-    memset(sum_v, 0, dst_pitch * sizeof(Uint32));
-    for (y = 0; y <= radius; y++) {  // y-pre
-        for (i = 0; i < dst_pitch; i++) {
-            sum_v[i] += srcpx[src_pitch * y + i];
+    // y-pre: vertical sums of the rows around the first row of the band
+    for (y = band->y_start - radius; y <= band->y_start + radius; y++) {
+        if ((row = _blur_src_row(src, y, repeat))) {
+            for (i = 0; i < row_len; i++) {
+                sum_v[i] += row[i];
+            }
         }
     }
-    if (repeat) {
-        for (i = 0; i < dst_pitch; i++) {
-            sum_v[i] += srcpx[i] * radius;
+    for (y = band->y_start; y < band->y_end; y++) {  // y
+        if (!(row_out = _blur_src_row(src, y - radius, repeat))) {
+            row_out = zeros;
         }
-    }
-    for (y = 0; y < h; y++) {  // y
-        for (i = 0; i < dst_pitch; i++) {
+        if (!(row_in = _blur_src_row(src, y + radius + 1, repeat))) {
+            row_in = zeros;
+        }
+        for (i = 0; i < row_len; i++) {
             buf[i] = sum_v[i] / (radius * 2 + 1);
 
             // update vertical sum
-            if (y - radius >= 0) {
-                sum_v[i] -= srcpx[src_pitch * (y - radius) + i];
-            }
-            else if (repeat) {
-                sum_v[i] -= srcpx[i];
-            }
-            if (y + radius + 1 < h) {
-                sum_v[i] += srcpx[src_pitch * (y + radius + 1) + i];
-            }
-            else if (repeat) {
-                sum_v[i] += srcpx[src_pitch * (h - 1) + i];
-            }
+            sum_v[i] += row_in[i] - row_out[i];
         }
 
         memset(sum_h, 0, nb * sizeof(Uint32));
@@ -3424,24 +6046,262 @@ box_blur(SDL_Surface *src, SDL_Surface *dst, int radius, SDL_bool repeat)
 
     free(buf);
     free(sum_v);
-    free(sum_h);
+    free(zeros);
+    return 0;
 }
 
-static void
-gaussian_blur(SDL_Surface *src, SDL_Surface *dst, int sigma, SDL_bool repeat)
+static int
+gaussian_blur(pg_BlurBand *band)
+{
+    SDL_Surface *src = band->src;
+    SDL_Surface *dst = band->dst;
+    Uint8 *dstpx = (Uint8 *)dst->pixels;
+    Uint8 nb = PG_SURF_BytesPerPixel(src);
+    int w = dst->w;
+    int row_len = w * nb;
+    int dst_pitch = dst->pitch;
+    int kernel_radius = band->radius;
+    const float *lut = band->lut;
+    SDL_bool repeat = band->repeat;
+    int i, j, x, y, color, start, end;
+    Uint8 *row;
+    float *buf = malloc(row_len * sizeof(float));
+    float *buf2 = malloc(row_len * sizeof(float));
+
+    if (!buf || !buf2) {
+        free(buf);
+        free(buf2);
+        return -1;
+    }
+
+    /* Both passes add one kernel tap at a time to whole rows, in the same
+     * order as a per pixel loop would, so the SIMD and scalar versions of
+     * the accumulate functions give identical results. */
+    for (y = band->y_start; y < band->y_end; y++) {
+        memset(buf, 0, row_len * sizeof(float));
+        memset(buf2, 0, row_len * sizeof(float));
+
+        for (j = -kernel_radius; j <= kernel_radius; j++) {
+            if ((row = _blur_src_row(src, y + j, repeat))) {
+                band->accumulate_u8(buf, row, row_len, lut[abs(j)]);
+            }
+        }
+
+        for (j = -kernel_radius; j <= kernel_radius; j++) {
+            /* pixels x for which x + j is inside the row */
+            start = MAX(0, -j);
+            end = MIN(w, w - j);
+            if (start < end) {
+                band->accumulate_f32(buf2 + nb * start, buf + nb * (start + j),
+                                     nb * (end - start), lut[abs(j)]);
+            }
+            if (!repeat) {
+                continue;
+            }
+            for (x = 0; x < MIN(start, w); x++) {
+                for (color = 0; color < nb; color++) {
+                    buf2[nb * x + color] += buf[color] * lut[abs(j)];
+                }
+            }
+            for (x = MAX(end, 0); x < w; x++) {
+                for (color = 0; color < nb; color++) {
+                    buf2[nb * x + color] +=
+                        buf[nb * (w - 1) + color] * lut[abs(j)];
+                }
+            }
+        }
+        for (i = 0; i < row_len; i++) {
+            dstpx[dst_pitch * y + i] = (Uint8)buf2[i];
+        }
+    }
+
+    free(buf);
+    free(buf2);
+    return 0;
+}
+
+/* Channel c of pixel x of a row of w pixels, with the edge handling of the
+ * blur functions */
+#define _BLUR_ROW_VALUE(row, x, c, w, nb, repeat)              \
+    ((x) < 0      ? ((repeat) ? (row)[c] : 0)                  \
+     : (x) >= (w) ? ((repeat) ? (row)[((w) - 1) * (nb) + (c)] : 0) \
+                  : (row)[(x) * (nb) + (c)])
+
+/* Stack blur, see https://underdestruction.com/2004/02/25/stackblur-2004/
+ * Pixels are weighted with a triangular kernel, the weight of a pixel at
+ * distance d is radius + 1 - d. As x moves, the weighted sum is updated from
+ * the sums of the pixels leaving (sum_out) and entering (sum_in) the left
+ * and right half of the kernel, so every pixel costs the same at any radius.
+ */
+static int
+stack_blur(pg_BlurBand *band)
 {
-    Uint8 *srcpx = (Uint8 *)src->pixels;
+    SDL_Surface *src = band->src;
+    SDL_Surface *dst = band->dst;
     Uint8 *dstpx = (Uint8 *)dst->pixels;
     Uint8 nb = PG_SURF_BytesPerPixel(src);
-    int w = dst->w, h = dst->h;
+    int w = dst->w;
+    int row_len = w * nb;
     int dst_pitch = dst->pitch;
-    int src_pitch = src->pitch;
-    int i, j, x, y, color;
+    int radius = band->radius;
+    Uint32 div = (Uint32)(radius + 1) * (radius + 1);
+    SDL_bool repeat = band->repeat;
+    int i, k, x, y, c;
+    Uint8 *row, *row_a, *row_b, *row_c;
+    Uint32 sum_h[4], sum_in_h[4], sum_out_h[4], v_in;
+    Uint32 *buf = malloc(row_len * sizeof(Uint32));
+    /* sum, sum_in, sum_out of every column */
+    Uint32 *sum_v = calloc(3 * row_len, sizeof(Uint32));
+    Uint32 *sum_in_v = sum_v + row_len;
+    Uint32 *sum_out_v = sum_v + 2 * row_len;
+    /* stands in for rows outside of the surface without repeat */
+    Uint8 *zeros = calloc(row_len, 1);
+
+    if (!buf || !sum_v || !zeros) {
+        free(buf);
+        free(sum_v);
+        free(zeros);
+        return -1;
+    }
+
+    // y-pre: sums of the rows around the first row of the band
+    y = band->y_start;
+    for (k = -radius; k <= radius + 1; k++) {
+        if (!(row = _blur_src_row(src, y + k, repeat))) {
+            continue;
+        }
+        for (i = 0; i < row_len; i++) {
+            if (k <= radius) {
+                sum_v[i] += (radius + 1 - abs(k)) * row[i];
+            }
+            if (k <= 0) {
+                sum_out_v[i] += row[i];
+            }
+            else {
+                sum_in_v[i] += row[i];
+            }
+        }
+    }
+
+    for (y = band->y_start; y < band->y_end; y++) {  // y
+        if (!(row_a = _blur_src_row(src, y - radius, repeat))) {
+            row_a = zeros;
+        }
+        if (!(row_b = _blur_src_row(src, y + 1, repeat))) {
+            row_b = zeros;
+        }
+        if (!(row_c = _blur_src_row(src, y + radius + 2, repeat))) {
+            row_c = zeros;
+        }
+        for (i = 0; i < row_len; i++) {
+            buf[i] = sum_v[i] / div;
+
+            // move the kernel one row down
+            sum_v[i] += sum_in_v[i] - sum_out_v[i];
+            sum_out_v[i] += row_b[i] - row_a[i];
+            sum_in_v[i] += row_c[i] - row_b[i];
+        }
+
+        // x-pre
+        memset(sum_h, 0, sizeof(sum_h));
+        memset(sum_in_h, 0, sizeof(sum_in_h));
+        memset(sum_out_h, 0, sizeof(sum_out_h));
+        for (k = -radius; k <= radius + 1; k++) {
+            for (c = 0; c < nb; c++) {
+                Uint32 v = _BLUR_ROW_VALUE(buf, k, c, w, nb, repeat);
+                if (k <= radius) {
+                    sum_h[c] += (radius + 1 - abs(k)) * v;
+                }
+                if (k <= 0) {
+                    sum_out_h[c] += v;
+                }
+                else {
+                    sum_in_h[c] += v;
+                }
+            }
+        }
+        for (x = 0; x < w; x++) {  // x
+            for (c = 0; c < nb; c++) {
+                dstpx[dst_pitch * y + nb * x + c] = sum_h[c] / div;
+
+                // move the kernel one pixel right
+                sum_h[c] += sum_in_h[c] - sum_out_h[c];
+                v_in = _BLUR_ROW_VALUE(buf, x + 1, c, w, nb, repeat);
+                sum_out_h[c] +=
+                    v_in - _BLUR_ROW_VALUE(buf, x - radius, c, w, nb, repeat);
+                sum_in_h[c] +=
+                    _BLUR_ROW_VALUE(buf, x + radius + 2, c, w, nb, repeat) -
+                    v_in;
+            }
+        }
+    }
+
+    free(buf);
+    free(sum_v);
+    free(zeros);
+    return 0;
+}
+
+#undef _BLUR_ROW_VALUE
+
+static void
+_blur_band(void *data, int i)
+{
+    pg_BlurBand *band = (pg_BlurBand *)data + i;
+    band->result = band->func(band);
+}
+
+/* Runs the blur described by proto over all rows of proto->dst, split across
+ * up to num_threads threads. Must be called without the GIL. Returns -1 if a
+ * band ran out of memory. */
+static int
+_blur_run(pg_BlurBand *proto, int num_threads)
+{
+    pg_BlurBand bands[BLUR_MAX_THREADS];
+    int h = proto->dst->h;
+    int nbands = MIN(num_threads, h / BLUR_THREAD_MIN_ROWS);
+    int i, result = 0;
+
+    if (nbands < 2 || proto->dst->w * h < BLUR_THREAD_MIN_PIXELS) {
+        nbands = 1;
+    }
+
+    for (i = 0; i < nbands; i++) {
+        bands[i] = *proto;
+        bands[i].y_start = (int)((Sint64)h * i / nbands);
+        bands[i].y_end = (int)((Sint64)h * (i + 1) / nbands);
+        bands[i].result = 0;
+    }
+
+    pg_run_bands(_blur_band, bands, nbands);
+
+    for (i = 0; i < nbands; i++) {
+        if (bands[i].result) {
+            result = -1;
+        }
+    }
+    return result;
+}
+
+/* Copies the normalized half kernel for sigma into lut, which must hold
+ * 2 * sigma + 1 floats. Kernels of the last few sigmas are cached. */
+static void
+_gaussian_kernel(struct _module_state *st, int sigma, float *lut)
+{
     int kernel_radius = sigma * 2;
-    float *buf = malloc(dst_pitch * sizeof(float));
-    float *buf2 = malloc(dst_pitch * sizeof(float));
-    float *lut = malloc((kernel_radius + 1) * sizeof(float));
+    size_t size = (kernel_radius + 1) * sizeof(float);
     float lut_sum = 0.0;
+    int i;
+
+    pg_mutex_lock(&st->lock);
+    for (i = 0; i < GAUSSIAN_KERNEL_CACHE_SIZE; i++) {
+        if (st->gaussian_kernels[i] && st->gaussian_sigmas[i] == sigma) {
+            memcpy(lut, st->gaussian_kernels[i], size);
+            pg_mutex_unlock(&st->lock);
+            return;
+        }
+    }
+    pg_mutex_unlock(&st->lock);
 
     for (i = 0; i <= kernel_radius; i++) {  // init gaussian lut
         // Gaussian function
@@ -3454,67 +6314,147 @@ gaussian_blur(SDL_Surface *src, SDL_Surface *dst, int sigma, SDL_bool repeat)
         lut[i] /= lut_sum;
     }
 
-    for (i = 0; i < dst_pitch; i++) {
-        buf[i] = 0.0;
-        buf2[i] = 0.0;
+    pg_mutex_lock(&st->lock);
+    i = st->gaussian_next;
+    free(st->gaussian_kernels[i]);
+    st->gaussian_kernels[i] = malloc(size);
+    if (st->gaussian_kernels[i]) {
+        memcpy(st->gaussian_kernels[i], lut, size);
+        st->gaussian_sigmas[i] = sigma;
+        st->gaussian_next = (i + 1) % GAUSSIAN_KERNEL_CACHE_SIZE;
     }
+    pg_mutex_unlock(&st->lock);
+}
 
-    for (y = 0; y < h; y++) {
-        for (j = -kernel_radius; j <= kernel_radius; j++) {
-            for (i = 0; i < dst_pitch; i++) {
-                if (y + j >= 0 && y + j < h) {
-                    buf[i] +=
-                        (float)srcpx[src_pitch * (y + j) + i] * lut[abs(j)];
-                }
-                else if (repeat) {
-                    if (y + j < 0) {
-                        buf[i] += (float)srcpx[i] * lut[abs(j)];
-                    }
-                    else {
-                        buf[i] += (float)srcpx[src_pitch * (h - 1) + i] *
-                                  lut[abs(j)];
-                    }
-                }
-            }
-        }
+static void
+blur_init(struct _module_state *st)
+{
+    st->blur_threads = 1;
+    st->blur_accumulate_u8 = blur_accumulate_u8;
+    st->blur_accumulate_f32 = blur_accumulate_f32;
+#if !defined(__EMSCRIPTEN__)
+    if (pg_has_avx2()) {
+        st->blur_accumulate_u8 = blur_accumulate_u8_avx2;
+        st->blur_accumulate_f32 = blur_accumulate_f32_avx2;
+    }
+#if PG_ENABLE_SSE_NEON
+    else if (pg_HasSSE_NEON()) {
+        st->blur_accumulate_u8 = blur_accumulate_u8_sse2;
+        st->blur_accumulate_f32 = blur_accumulate_f32_sse2;
+    }
+#endif /* PG_ENABLE_SSE_NEON */
+#endif /* !__EMSCRIPTEN__ */
+}
 
-        for (x = 0; x < w; x++) {
-            for (j = -kernel_radius; j <= kernel_radius; j++) {
-                for (color = 0; color < nb; color++) {
-                    if (x + j >= 0 && x + j < w) {
-                        buf2[nb * x + color] +=
-                            buf[nb * (x + j) + color] * lut[abs(j)];
-                    }
-                    else if (repeat) {
-                        if (x + j < 0) {
-                            buf2[nb * x + color] += buf[color] * lut[abs(j)];
-                        }
-                        else {
-                            buf2[nb * x + color] +=
-                                buf[nb * (w - 1) + color] * lut[abs(j)];
-                        }
-                    }
-                }
-            }
+static void
+rotate_init(struct _module_state *st)
+{
+    st->rotate_backend = "GENERIC";
+    st->rotate_nearest_row = rotate_nearest_row;
+    st->rotozoom_smooth_run = rotozoom_smooth_run;
+    st->transpose32 = transpose32;
+    st->flip_row32 = flip_row32;
+#if !defined(__EMSCRIPTEN__)
+    if (pg_has_avx2()) {
+        st->rotate_backend = "AVX2";
+        st->rotate_nearest_row = rotate_nearest_row_avx2;
+        st->rotozoom_smooth_run = rotozoom_smooth_run_avx2;
+        st->transpose32 = transpose32_avx2;
+        st->flip_row32 = flip_row32_avx2;
+    }
+#if PG_ENABLE_SSE_NEON
+    else if (pg_HasSSE_NEON()) {
+        st->rotate_backend = SDL_HasSSE2() ? "SSE2" : "NEON";
+        st->rotate_nearest_row = rotate_nearest_row_sse2;
+        st->rotozoom_smooth_run = rotozoom_smooth_run_sse2;
+        st->transpose32 = transpose32_sse2;
+        st->flip_row32 = flip_row32_sse2;
+    }
+#endif /* PG_ENABLE_SSE_NEON */
+#endif /* !__EMSCRIPTEN__ */
+}
+
+static PyObject *
+surf_get_rotate_backend(PyObject *self, PyObject *_null)
+{
+    return PyUnicode_FromString(GETSTATE(self)->rotate_backend);
+}
+
+static PyObject *
+surf_set_rotate_backend(PyObject *self, PyObject *args, PyObject *kwargs)
+{
+    struct _module_state *st = GETSTATE(self);
+    char *keywords[] = {"backend", NULL};
+    const char *type;
+
+#ifdef _MSC_VER
+    /* MSVC static analyzer false alarm: assure type is NULL-terminated by
+     * making analyzer assume it was initialised */
+    __analysis_assume(type = "inited");
+#endif
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "s", keywords, &type))
+        return NULL;
+
+    if (strcmp(type, "GENERIC") == 0) {
+        st->rotate_backend = "GENERIC";
+        st->rotate_nearest_row = rotate_nearest_row;
+        st->rotozoom_smooth_run = rotozoom_smooth_run;
+        st->transpose32 = transpose32;
+        st->flip_row32 = flip_row32;
+    }
+#if !defined(__EMSCRIPTEN__)
+    else if (strcmp(type, "AVX2") == 0) {
+        if (!pg_has_avx2()) {
+            return RAISE(PyExc_ValueError,
+                         "AVX2 not supported on this machine");
         }
-        for (i = 0; i < dst_pitch; i++) {
-            dstpx[dst_pitch * y + i] = (Uint8)buf2[i];
-            buf[i] = 0.0;
-            buf2[i] = 0.0;
+        st->rotate_backend = "AVX2";
+        st->rotate_nearest_row = rotate_nearest_row_avx2;
+        st->rotozoom_smooth_run = rotozoom_smooth_run_avx2;
+        st->transpose32 = transpose32_avx2;
+        st->flip_row32 = flip_row32_avx2;
+    }
+#if PG_ENABLE_SSE_NEON
+    else if (strcmp(type, "SSE2") == 0) {
+        if (!SDL_HasSSE2()) {
+            return RAISE(PyExc_ValueError,
+                         "SSE2 not supported on this machine");
+        }
+        st->rotate_backend = "SSE2";
+        st->rotate_nearest_row = rotate_nearest_row_sse2;
+        st->rotozoom_smooth_run = rotozoom_smooth_run_sse2;
+        st->transpose32 = transpose32_sse2;
+        st->flip_row32 = flip_row32_sse2;
+    }
+    else if (strcmp(type, "NEON") == 0) {
+        if (!SDL_HasNEON()) {
+            return RAISE(PyExc_ValueError,
+                         "NEON not supported on this machine");
         }
+        st->rotate_backend = "NEON";
+        st->rotate_nearest_row = rotate_nearest_row_sse2;
+        st->rotozoom_smooth_run = rotozoom_smooth_run_sse2;
+        st->transpose32 = transpose32_sse2;
+        st->flip_row32 = flip_row32_sse2;
     }
-
-    free(buf);
-    free(buf2);
-    free(lut);
+#endif /* PG_ENABLE_SSE_NEON */
+#endif /* !__EMSCRIPTEN__ */
+    else {
+        return PyErr_Format(PyExc_ValueError, "Unknown backend type %s", type);
+    }
+    Py_RETURN_NONE;
 }
 
 static SDL_Surface *
-blur(pgSurfaceObject *srcobj, pgSurfaceObject *dstobj, int radius,
-     SDL_bool repeat, char algorithm)
+blur(struct _module_state *st, pgSurfaceObject *srcobj,
+     pgSurfaceObject *dstobj, int radius, SDL_bool repeat, char algorithm)
 {
     SDL_Surface *src = NULL;
     SDL_Surface *retsurf = NULL;
+    pg_BlurBand band;
+    float *lut = NULL;
+    int result;
 
     if (radius < 0) {
         return RAISE(PyExc_ValueError,
@@ -3568,26 +6508,78 @@ blur(pgSurfaceObject *srcobj, pgSurfaceObject *dstobj, int radius,
         radius = MIN(src->w, src->h) - 1;
     }
 
+    band.src = src;
+    band.dst = retsurf;
+    band.repeat = repeat;
+    band.accumulate_u8 = st->blur_accumulate_u8;
+    band.accumulate_f32 = st->blur_accumulate_f32;
+    if (algorithm == 'g') {
+        lut = malloc((radius * 2 + 1) * sizeof(float));
+        if (!lut) {
+            return (SDL_Surface *)PyErr_NoMemory();
+        }
+        _gaussian_kernel(st, radius, lut);
+        band.func = gaussian_blur;
+        band.radius = radius * 2;
+        band.lut = lut;
+    }
+    else if (algorithm == 's') {
+        band.func = stack_blur;
+        band.radius = MIN(radius, STACK_BLUR_MAX_RADIUS);
+        band.lut = NULL;
+    }
+    else {
+        /* the running sums need the whole window inside the surface */
+        if (radius == MIN(src->w, src->h)) {
+            radius--;
+        }
+        band.func = box_blur;
+        band.radius = radius;
+        band.lut = NULL;
+    }
+
     SDL_LockSurface(retsurf);
     pgSurface_Lock(srcobj);
 
     Py_BEGIN_ALLOW_THREADS;
-
-    if (algorithm == 'b') {
-        box_blur(src, retsurf, radius, repeat);
-    }
-    else if (algorithm == 'g') {
-        gaussian_blur(src, retsurf, radius, repeat);
-    }
-
+    result = _blur_run(&band, st->blur_threads);
     Py_END_ALLOW_THREADS;
 
     pgSurface_Unlock(srcobj);
     SDL_UnlockSurface(retsurf);
+    free(lut);
 
+    if (result) {
+        return (SDL_Surface *)PyErr_NoMemory();
+    }
     return retsurf;
 }
 
+static PyObject *
+surf_set_blur_threads(PyObject *self, PyObject *arg)
+{
+    long num_threads = PyLong_AsLong(arg);
+
+    if (num_threads == -1 && PyErr_Occurred()) {
+        return NULL;
+    }
+    if (num_threads < 0) {
+        return RAISE(PyExc_ValueError,
+                     "the number of blur threads must not be negative");
+    }
+    if (num_threads == 0) {
+        num_threads = SDL_GetCPUCount();
+    }
+    GETSTATE(self)->blur_threads = (int)MIN(num_threads, BLUR_MAX_THREADS);
+    Py_RETURN_NONE;
+}
+
+static PyObject *
+surf_get_blur_threads(PyObject *self, PyObject *_null)
+{
+    return PyLong_FromLong(GETSTATE(self)->blur_threads);
+}
+
 static PyObject *
 surf_box_blur(PyObject *self, PyObject *args, PyObject *kwargs)
 {
@@ -3606,8 +6598,8 @@ surf_box_blur(PyObject *self, PyObject *args, PyObject *kwargs)
             &radius, &repeat_edge_pixels, &pgSurface_Type, &dst_surf_obj))
         return NULL;
 
-    new_surf =
-        blur(src_surf_obj, dst_surf_obj, radius, repeat_edge_pixels, 'b');
+    new_surf = blur(GETSTATE(self), src_surf_obj, dst_surf_obj, radius,
+                    repeat_edge_pixels, 'b');
     if (!new_surf) {
         return NULL;
     }
@@ -3638,8 +6630,40 @@ surf_gaussian_blur(PyObject *self, PyObject *args, PyObject *kwargs)
             &radius, &repeat_edge_pixels, &pgSurface_Type, &dst_surf_obj))
         return NULL;
 
-    new_surf =
-        blur(src_surf_obj, dst_surf_obj, radius, repeat_edge_pixels, 'g');
+    new_surf = blur(GETSTATE(self), src_surf_obj, dst_surf_obj, radius,
+                    repeat_edge_pixels, 'g');
+    if (!new_surf) {
+        return NULL;
+    }
+
+    if (dst_surf_obj) {
+        Py_INCREF(dst_surf_obj);
+        return (PyObject *)dst_surf_obj;
+    }
+
+    return (PyObject *)pgSurface_New(new_surf);
+}
+
+static PyObject *
+surf_stack_blur(PyObject *self, PyObject *args, PyObject *kwargs)
+{
+    pgSurfaceObject *dst_surf_obj = NULL;
+    pgSurfaceObject *src_surf_obj;
+    SDL_Surface *new_surf = NULL;
+    SDL_bool repeat_edge_pixels = SDL_TRUE;
+
+    int radius;
+
+    static char *kwlist[] = {"surface", "radius", "repeat_edge_pixels",
+                             "dest_surface", 0};
+
+    if (!PyArg_ParseTupleAndKeywords(
+            args, kwargs, "O!i|pO!", kwlist, &pgSurface_Type, &src_surf_obj,
+            &radius, &repeat_edge_pixels, &pgSurface_Type, &dst_surf_obj))
+        return NULL;
+
+    new_surf = blur(GETSTATE(self), src_surf_obj, dst_surf_obj, radius,
+                    repeat_edge_pixels, 's');
     if (!new_surf) {
         return NULL;
     }
@@ -3652,6 +6676,372 @@ surf_gaussian_blur(PyObject *self, PyObject *args, PyObject *kwargs)
     return (PyObject *)pgSurface_New(new_surf);
 }
 
+/* Kernels of convolve() have an odd number of rows and columns, at most
+ * CONVOLVE_MAX_SIZE each */
+#define CONVOLVE_MAX_SIZE 7
+
+/* Copies a row of w pixels to out with its first and last pixel repeated
+ * pad times on either side */
+static void
+_convolve_pad_row(Uint8 *out, const Uint8 *row, int w, int nb, int pad)
+{
+    int i;
+
+    for (i = 0; i < pad; i++) {
+        memcpy(out + i * nb, row, nb);
+        memcpy(out + (pad + w + i) * nb, row + (w - 1) * nb, nb);
+    }
+    memcpy(out + pad * nb, row, w * nb);
+}
+
+/* Rounds and clamps a row of sums into dst, keeping the alpha byte of src */
+static void
+_convolve_store_row(const float *acc, const Uint8 *src, Uint8 *dst,
+                    int row_len, int nb, int alpha_index)
+{
+    float v;
+    int i;
+
+    for (i = 0; i < row_len; i++) {
+        v = acc[i];
+        v = v > 0 ? v : 0;
+        v = v < 255 ? v : 255;
+        dst[i] = (Uint8)(v + 0.5f);
+    }
+    if (alpha_index >= 0) {
+        for (i = alpha_index; i < row_len; i += nb) {
+            dst[i] = src[i];
+        }
+    }
+}
+
+static int
+convolve_full(pg_BlurBand *band)
+{
+    SDL_Surface *src = band->src;
+    SDL_Surface *dst = band->dst;
+    Uint8 nb = PG_SURF_BytesPerPixel(src);
+    int w = dst->w;
+    int row_len = w * nb;
+    int kw = band->kernel_w;
+    int kh = band->kernel_h;
+    int padded_len = (w + kw - 1) * nb;
+    const float *kernel = band->kernel;
+    int tags[CONVOLVE_MAX_SIZE];
+    int i, j, y, sy, slot;
+    Uint8 *padrow;
+    Uint8 *padded = malloc((size_t)kh * padded_len);
+    float *acc = malloc(row_len * sizeof(float));
+
+    if (!padded || !acc) {
+        free(padded);
+        free(acc);
+        return -1;
+    }
+    for (j = 0; j < kh; j++) {
+        tags[j] = -1;
+    }
+
+    /* The kernel_h source rows around y are distinct modulo kernel_h once
+     * clamped to the surface, so each padded row is made only once. */
+    for (y = band->y_start; y < band->y_end; y++) {
+        memset(acc, 0, row_len * sizeof(float));
+        for (j = 0; j < kh; j++) {
+            sy = MIN(MAX(y + j - kh / 2, 0), src->h - 1);
+            slot = sy % kh;
+            padrow = padded + slot * padded_len;
+            if (tags[slot] != sy) {
+                _convolve_pad_row(padrow,
+                                  (Uint8 *)src->pixels + sy * src->pitch, w,
+                                  nb, kw / 2);
+                tags[slot] = sy;
+            }
+            for (i = 0; i < kw; i++) {
+                if (kernel[j * kw + i] != 0.0f) {
+                    band->accumulate_u8(acc, padrow + i * nb, row_len,
+                                    kernel[j * kw + i]);
+                }
+            }
+        }
+        _convolve_store_row(acc, (Uint8 *)src->pixels + y * src->pitch,
+                            (Uint8 *)dst->pixels + y * dst->pitch, row_len,
+                            nb, band->alpha_index);
+    }
+
+    free(padded);
+    free(acc);
+    return 0;
+}
+
+static int
+convolve_separable(pg_BlurBand *band)
+{
+    SDL_Surface *src = band->src;
+    SDL_Surface *dst = band->dst;
+    Uint8 nb = PG_SURF_BytesPerPixel(src);
+    int w = dst->w;
+    int row_len = w * nb;
+    int kw = band->kernel_w;
+    int kh = band->kernel_h;
+    int pad = kw / 2;
+    const float *col = band->kernel;
+    const float *row = band->kernel + kh;
+    int i, j, y, sy;
+    float *vsum = malloc((w + kw - 1) * nb * sizeof(float));
+    float *acc = malloc(row_len * sizeof(float));
+
+    if (!vsum || !acc) {
+        free(vsum);
+        free(acc);
+        return -1;
+    }
+
+    for (y = band->y_start; y < band->y_end; y++) {
+        /* vertical pass into the middle of vsum, then repeat its edges */
+        memset(vsum + pad * nb, 0, row_len * sizeof(float));
+        for (j = 0; j < kh; j++) {
+            sy = MIN(MAX(y + j - kh / 2, 0), src->h - 1);
+            if (col[j] != 0.0f) {
+                band->accumulate_u8(vsum + pad * nb,
+                                    (Uint8 *)src->pixels + sy * src->pitch,
+                                    row_len, col[j]);
+            }
+        }
+        for (i = 0; i < pad; i++) {
+            memcpy(vsum + i * nb, vsum + pad * nb, nb * sizeof(float));
+            memcpy(vsum + (pad + w + i) * nb, vsum + (pad + w - 1) * nb,
+                   nb * sizeof(float));
+        }
+
+        memset(acc, 0, row_len * sizeof(float));
+        for (i = 0; i < kw; i++) {
+            if (row[i] != 0.0f) {
+                band->accumulate_f32(acc, vsum + i * nb, row_len, row[i]);
+            }
+        }
+        _convolve_store_row(acc, (Uint8 *)src->pixels + y * src->pitch,
+                            (Uint8 *)dst->pixels + y * dst->pitch, row_len,
+                            nb, band->alpha_index);
+    }
+
+    free(vsum);
+    free(acc);
+    return 0;
+}
+
+/* If kernel is the outer product of a column and a row of weights, stores
+ * the kh column weights followed by the kw row weights in out and returns 1.
+ */
+static int
+_convolve_separate(const float *kernel, int kw, int kh, float *out)
+{
+    float largest = 0.0f, pivot, tolerance;
+    int p = 0, q = 0;
+    int i, j;
+
+    for (j = 0; j < kh; j++) {
+        for (i = 0; i < kw; i++) {
+            if (fabsf(kernel[j * kw + i]) > largest) {
+                largest = fabsf(kernel[j * kw + i]);
+                p = j;
+                q = i;
+            }
+        }
+    }
+    if (largest == 0.0f) {
+        return 0;
+    }
+
+    pivot = kernel[p * kw + q];
+    tolerance = largest * 1e-5f;
+    for (j = 0; j < kh; j++) {
+        out[j] = kernel[j * kw + q];
+    }
+    for (i = 0; i < kw; i++) {
+        out[kh + i] = kernel[p * kw + i] / pivot;
+    }
+    for (j = 0; j < kh; j++) {
+        for (i = 0; i < kw; i++) {
+            if (fabsf(kernel[j * kw + i] - out[j] * out[kh + i]) >
+                tolerance) {
+                return 0;
+            }
+        }
+    }
+    return 1;
+}
+
+/* Reads a kernel of at most CONVOLVE_MAX_SIZE x CONVOLVE_MAX_SIZE numbers
+ * into kernel. Returns 0 with an exception set on failure. */
+static int
+_convolve_parse_kernel(PyObject *obj, float *kernel, int *kw, int *kh)
+{
+    PyObject *row;
+    Py_ssize_t nrows, ncols = 0;
+    int i, j;
+
+    if (!PySequence_Check(obj)) {
+        PyErr_SetString(PyExc_TypeError, "kernel must be a sequence of rows");
+        return 0;
+    }
+    nrows = PySequence_Size(obj);
+    if (nrows < 1 || nrows > CONVOLVE_MAX_SIZE || nrows % 2 == 0) {
+        PyErr_SetString(PyExc_ValueError,
+                        "kernel must have an odd number of rows, at most 7");
+        return 0;
+    }
+    for (j = 0; j < nrows; j++) {
+        row = PySequence_GetItem(obj, j);
+        if (!row) {
+            return 0;
+        }
+        if (!PySequence_Check(row)) {
+            Py_DECREF(row);
+            PyErr_SetString(PyExc_TypeError,
+                            "kernel must be a sequence of rows");
+            return 0;
+        }
+        if (j == 0) {
+            ncols = PySequence_Size(row);
+            if (ncols < 1 || ncols > CONVOLVE_MAX_SIZE || ncols % 2 == 0) {
+                Py_DECREF(row);
+                PyErr_SetString(
+                    PyExc_ValueError,
+                    "kernel must have an odd number of columns, at most 7");
+                return 0;
+            }
+        }
+        else if (PySequence_Size(row) != ncols) {
+            Py_DECREF(row);
+            PyErr_SetString(PyExc_ValueError,
+                            "kernel rows must all have the same length");
+            return 0;
+        }
+        for (i = 0; i < ncols; i++) {
+            if (!pg_FloatFromObjIndex(row, i, &kernel[j * ncols + i])) {
+                Py_DECREF(row);
+                PyErr_SetString(PyExc_TypeError,
+                                "kernel values must be numbers");
+                return 0;
+            }
+        }
+        Py_DECREF(row);
+    }
+    *kw = (int)ncols;
+    *kh = (int)nrows;
+    return 1;
+}
+
+static PyObject *
+surf_convolve(PyObject *self, PyObject *args, PyObject *kwargs)
+{
+    struct _module_state *st = GETSTATE(self);
+    pgSurfaceObject *srcobj;
+    pgSurfaceObject *dstobj = NULL;
+    PyObject *kernelobj;
+    SDL_Surface *src, *dst;
+    pg_BlurBand band;
+    float kernel[CONVOLVE_MAX_SIZE * CONVOLVE_MAX_SIZE];
+    float separated[CONVOLVE_MAX_SIZE * 2];
+    Uint8 *src_start, *src_end, *dst_start, *dst_end;
+    int kw, kh, result;
+    static char *keywords[] = {"surface", "kernel", "dest_surface", NULL};
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "O!O|O!", keywords,
+                                     &pgSurface_Type, &srcobj, &kernelobj,
+                                     &pgSurface_Type, &dstobj)) {
+        return NULL;
+    }
+    if (!_convolve_parse_kernel(kernelobj, kernel, &kw, &kh)) {
+        return NULL;
+    }
+
+    src = pgSurface_AsSurface(srcobj);
+    SURF_INIT_CHECK(src);
+    if (PG_SURF_BytesPerPixel(src) != 3 &&
+        !_byte_channels_format(src->format)) {
+        return RAISE(PyExc_ValueError,
+                     "Only 24 and 32 bit surfaces can be convolved.");
+    }
+
+    if (dstobj) {
+        dst = pgSurface_AsSurface(dstobj);
+        SURF_INIT_CHECK(dst);
+        if (dst->w != src->w || dst->h != src->h) {
+            return RAISE(PyExc_ValueError,
+                         "Destination surface not the same size.");
+        }
+        if (dst->format->format != src->format->format) {
+            return RAISE(
+                PyExc_ValueError,
+                "Source and destination surfaces need the same format.");
+        }
+        dst_start = (Uint8 *)dst->pixels;
+        dst_end = dst_start + dst->h * dst->pitch;
+        src_start = (Uint8 *)src->pixels;
+        src_end = src_start + src->h * src->pitch;
+        if (dst->w && dst->h && dst_start < src_end && src_start < dst_end) {
+            return RAISE(PyExc_ValueError,
+                         "convolve does not support a dest_surface that "
+                         "shares pixels with the source surface.");
+        }
+    }
+    else {
+        dst = newsurf_fromsurf(src, src->w, src->h);
+        if (!dst) {
+            return NULL;
+        }
+    }
+
+    band.src = src;
+    band.dst = dst;
+    band.accumulate_u8 = st->blur_accumulate_u8;
+    band.accumulate_f32 = st->blur_accumulate_f32;
+    band.kernel_w = kw;
+    band.kernel_h = kh;
+    band.alpha_index = -1;
+    if (PG_SURF_BytesPerPixel(src) == 4 && src->format->Amask) {
+        band.alpha_index = _PG_BYTE_INDEX(src->format->Ashift);
+    }
+    if (_convolve_separate(kernel, kw, kh, separated)) {
+        band.func = convolve_separable;
+        band.kernel = separated;
+    }
+    else {
+        band.func = convolve_full;
+        band.kernel = kernel;
+    }
+
+    result = 0;
+    if (src->w && src->h) {
+        if (dstobj) {
+            pgSurface_Lock(dstobj);
+        }
+        pgSurface_Lock(srcobj);
+
+        Py_BEGIN_ALLOW_THREADS;
+        result = _blur_run(&band, st->blur_threads);
+        Py_END_ALLOW_THREADS;
+
+        pgSurface_Unlock(srcobj);
+        if (dstobj) {
+            pgSurface_Unlock(dstobj);
+        }
+    }
+
+    if (result) {
+        if (!dstobj) {
+            SDL_FreeSurface(dst);
+        }
+        return PyErr_NoMemory();
+    }
+    if (dstobj) {
+        Py_INCREF(dstobj);
+        return (PyObject *)dstobj;
+    }
+    return (PyObject *)pgSurface_New(dst);
+}
+
 void
 invert_non_simd(SDL_Surface *src, SDL_Surface *newsurf)
 {
@@ -3754,49 +7144,218 @@ surf_invert(PyObject *self, PyObject *args, PyObject *kwargs)
     return (PyObject *)pgSurface_New(newsurf);
 }
 
+static PyObject *
+surf_invert_ip(PyObject *self, PyObject *args, PyObject *kwargs)
+{
+    pgSurfaceObject *surfobj;
+
+    static char *keywords[] = {"surface", NULL};
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "O!", keywords,
+                                     &pgSurface_Type, &surfobj))
+        return NULL;
+    SURF_INIT_CHECK(pgSurface_AsSurface(surfobj))
+
+    if (!invert(surfobj, surfobj)) {
+        return NULL;
+    }
+    Py_RETURN_NONE;
+}
+
+/* The entry points returning a surface are counted in the perf counters by
+ * a wrapper each, which covers all of their return paths. */
+static PyObject *
+_transform_perf_done(PyObject *result, Uint64 start)
+{
+    SDL_Surface *surf = NULL;
+
+    if (result && pgSurface_Check(result)) {
+        surf = pgSurface_AsSurface(result);
+    }
+    PG_PERF_STOP(start, PG_PERF_TRANSFORM,
+                 surf ? (Uint64)surf->w * surf->h : 0);
+    return result;
+}
+
+#define TRANSFORM_COUNTED(func)                                          \
+    static PyObject *func##_counted(PyObject *self, PyObject *args,      \
+                                    PyObject *kwargs)                    \
+    {                                                                    \
+        PG_PERF_START(start);                                            \
+        return _transform_perf_done(func(self, args, kwargs), start);    \
+    }
+
+TRANSFORM_COUNTED(surf_scale)
+TRANSFORM_COUNTED(surf_scale_by)
+TRANSFORM_COUNTED(surf_rotate)
+TRANSFORM_COUNTED(surf_flip)
+TRANSFORM_COUNTED(surf_rotozoom)
+TRANSFORM_COUNTED(surf_chop)
+TRANSFORM_COUNTED(surf_scale2x)
+TRANSFORM_COUNTED(surf_scale3x)
+TRANSFORM_COUNTED(surf_scale4x)
+TRANSFORM_COUNTED(surf_scalesmooth)
+TRANSFORM_COUNTED(surf_scalesmooth_by)
+TRANSFORM_COUNTED(surf_laplacian)
+TRANSFORM_COUNTED(surf_average_surfaces)
+TRANSFORM_COUNTED(surf_box_blur)
+TRANSFORM_COUNTED(surf_gaussian_blur)
+TRANSFORM_COUNTED(surf_stack_blur)
+TRANSFORM_COUNTED(surf_convolve)
+TRANSFORM_COUNTED(surf_invert)
+TRANSFORM_COUNTED(surf_grayscale)
+TRANSFORM_COUNTED(surf_hsl)
+TRANSFORM_COUNTED(surf_color_matrix)
+TRANSFORM_COUNTED(surf_flip_ip)
+TRANSFORM_COUNTED(surf_grayscale_ip)
+TRANSFORM_COUNTED(surf_invert_ip)
+TRANSFORM_COUNTED(surf_hsl_ip)
+
 static PyMethodDef _transform_methods[] = {
-    {"scale", (PyCFunction)surf_scale, METH_VARARGS | METH_KEYWORDS,
+    {"scale", (PyCFunction)surf_scale_counted, METH_VARARGS | METH_KEYWORDS,
      DOC_TRANSFORM_SCALE},
-    {"scale_by", (PyCFunction)surf_scale_by, METH_VARARGS | METH_KEYWORDS,
-     DOC_TRANSFORM_SCALEBY},
-    {"rotate", (PyCFunction)surf_rotate, METH_VARARGS | METH_KEYWORDS,
+    {"scale_by", (PyCFunction)surf_scale_by_counted,
+     METH_VARARGS | METH_KEYWORDS, DOC_TRANSFORM_SCALEBY},
+    {"rotate", (PyCFunction)surf_rotate_counted, METH_VARARGS | METH_KEYWORDS,
      DOC_TRANSFORM_ROTATE},
-    {"flip", (PyCFunction)surf_flip, METH_VARARGS | METH_KEYWORDS,
+    {"flip", (PyCFunction)surf_flip_counted, METH_VARARGS | METH_KEYWORDS,
      DOC_TRANSFORM_FLIP},
-    {"rotozoom", (PyCFunction)surf_rotozoom, METH_VARARGS | METH_KEYWORDS,
-     DOC_TRANSFORM_ROTOZOOM},
-    {"chop", (PyCFunction)surf_chop, METH_VARARGS | METH_KEYWORDS,
+    {"flip_ip", (PyCFunction)surf_flip_ip_counted,
+     METH_VARARGS | METH_KEYWORDS, DOC_TRANSFORM_FLIPIP},
+    {"rotozoom", (PyCFunction)surf_rotozoom_counted,
+     METH_VARARGS | METH_KEYWORDS, DOC_TRANSFORM_ROTOZOOM},
+    {"chop", (PyCFunction)surf_chop_counted, METH_VARARGS | METH_KEYWORDS,
      DOC_TRANSFORM_CHOP},
-    {"scale2x", (PyCFunction)surf_scale2x, METH_VARARGS | METH_KEYWORDS,
-     DOC_TRANSFORM_SCALE2X},
-    {"smoothscale", (PyCFunction)surf_scalesmooth,
+    {"scale2x", (PyCFunction)surf_scale2x_counted,
+     METH_VARARGS | METH_KEYWORDS, DOC_TRANSFORM_SCALE2X},
+    {"scale3x", (PyCFunction)surf_scale3x_counted,
+     METH_VARARGS | METH_KEYWORDS, DOC_TRANSFORM_SCALE3X},
+    {"scale4x", (PyCFunction)surf_scale4x_counted,
+     METH_VARARGS | METH_KEYWORDS, DOC_TRANSFORM_SCALE4X},
+    {"smoothscale", (PyCFunction)surf_scalesmooth_counted,
      METH_VARARGS | METH_KEYWORDS, DOC_TRANSFORM_SMOOTHSCALE},
-    {"smoothscale_by", (PyCFunction)surf_scalesmooth_by,
+    {"smoothscale_by", (PyCFunction)surf_scalesmooth_by_counted,
      METH_VARARGS | METH_KEYWORDS, DOC_TRANSFORM_SMOOTHSCALEBY},
+    {"build_pyramid", (PyCFunction)surf_build_pyramid,
+     METH_VARARGS | METH_KEYWORDS, DOC_TRANSFORM_BUILDPYRAMID},
     {"get_smoothscale_backend", surf_get_smoothscale_backend, METH_NOARGS,
      DOC_TRANSFORM_GETSMOOTHSCALEBACKEND},
     {"set_smoothscale_backend", (PyCFunction)surf_set_smoothscale_backend,
      METH_VARARGS | METH_KEYWORDS, DOC_TRANSFORM_SETSMOOTHSCALEBACKEND},
+    {"set_smoothscale_threads", surf_set_smoothscale_threads, METH_O,
+     DOC_TRANSFORM_SETSMOOTHSCALETHREADS},
+    {"get_smoothscale_threads", surf_get_smoothscale_threads, METH_NOARGS,
+     DOC_TRANSFORM_GETSMOOTHSCALETHREADS},
+    {"get_rotate_backend", surf_get_rotate_backend, METH_NOARGS,
+     DOC_TRANSFORM_GETROTATEBACKEND},
+    {"set_rotate_backend", (PyCFunction)surf_set_rotate_backend,
+     METH_VARARGS | METH_KEYWORDS, DOC_TRANSFORM_SETROTATEBACKEND},
+    {"set_rotozoom_threads", surf_set_rotozoom_threads, METH_O,
+     DOC_TRANSFORM_SETROTOZOOMTHREADS},
+    {"get_rotozoom_threads", surf_get_rotozoom_threads, METH_NOARGS,
+     DOC_TRANSFORM_GETROTOZOOMTHREADS},
+    {"enable_cache", surf_enable_cache, METH_O, DOC_TRANSFORM_ENABLECACHE},
+    {"disable_cache", surf_disable_cache, METH_NOARGS,
+     DOC_TRANSFORM_DISABLECACHE},
+    {"clear_cache", surf_clear_cache, METH_NOARGS, DOC_TRANSFORM_CLEARCACHE},
+    {"get_cache_stats", surf_get_cache_stats, METH_NOARGS,
+     DOC_TRANSFORM_GETCACHESTATS},
     {"threshold", (PyCFunction)surf_threshold, METH_VARARGS | METH_KEYWORDS,
      DOC_TRANSFORM_THRESHOLD},
-    {"laplacian", (PyCFunction)surf_laplacian, METH_VARARGS | METH_KEYWORDS,
-     DOC_TRANSFORM_THRESHOLD},
-    {"average_surfaces", (PyCFunction)surf_average_surfaces,
+    {"laplacian", (PyCFunction)surf_laplacian_counted,
+     METH_VARARGS | METH_KEYWORDS, DOC_TRANSFORM_THRESHOLD},
+    {"average_surfaces", (PyCFunction)surf_average_surfaces_counted,
      METH_VARARGS | METH_KEYWORDS, DOC_TRANSFORM_AVERAGESURFACES},
     {"average_color", (PyCFunction)surf_average_color,
      METH_VARARGS | METH_KEYWORDS, DOC_TRANSFORM_AVERAGECOLOR},
-    {"box_blur", (PyCFunction)surf_box_blur, METH_VARARGS | METH_KEYWORDS,
-     DOC_TRANSFORM_BOXBLUR},
-    {"gaussian_blur", (PyCFunction)surf_gaussian_blur,
+    {"set_average_color_threads", surf_set_average_color_threads, METH_O,
+     DOC_TRANSFORM_SETAVERAGECOLORTHREADS},
+    {"get_average_color_threads", surf_get_average_color_threads,
+     METH_NOARGS, DOC_TRANSFORM_GETAVERAGECOLORTHREADS},
+    {"box_blur", (PyCFunction)surf_box_blur_counted,
+     METH_VARARGS | METH_KEYWORDS, DOC_TRANSFORM_BOXBLUR},
+    {"gaussian_blur", (PyCFunction)surf_gaussian_blur_counted,
      METH_VARARGS | METH_KEYWORDS, DOC_TRANSFORM_GAUSSIANBLUR},
-    {"invert", (PyCFunction)surf_invert, METH_VARARGS | METH_KEYWORDS,
+    {"stack_blur", (PyCFunction)surf_stack_blur_counted,
+     METH_VARARGS | METH_KEYWORDS, DOC_TRANSFORM_STACKBLUR},
+    {"convolve", (PyCFunction)surf_convolve_counted,
+     METH_VARARGS | METH_KEYWORDS, DOC_TRANSFORM_CONVOLVE},
+    {"set_blur_threads", surf_set_blur_threads, METH_O,
+     DOC_TRANSFORM_SETBLURTHREADS},
+    {"get_blur_threads", surf_get_blur_threads, METH_NOARGS,
+     DOC_TRANSFORM_GETBLURTHREADS},
+    {"invert", (PyCFunction)surf_invert_counted, METH_VARARGS | METH_KEYWORDS,
      DOC_TRANSFORM_INVERT},
-    {"grayscale", (PyCFunction)surf_grayscale, METH_VARARGS | METH_KEYWORDS,
-     DOC_TRANSFORM_GRAYSCALE},
-    {"hsl", (PyCFunction)surf_hsl, METH_VARARGS | METH_KEYWORDS,
+    {"invert_ip", (PyCFunction)surf_invert_ip_counted,
+     METH_VARARGS | METH_KEYWORDS, DOC_TRANSFORM_INVERTIP},
+    {"grayscale", (PyCFunction)surf_grayscale_counted,
+     METH_VARARGS | METH_KEYWORDS, DOC_TRANSFORM_GRAYSCALE},
+    {"grayscale_ip", (PyCFunction)surf_grayscale_ip_counted,
+     METH_VARARGS | METH_KEYWORDS, DOC_TRANSFORM_GRAYSCALEIP},
+    {"hsl", (PyCFunction)surf_hsl_counted, METH_VARARGS | METH_KEYWORDS,
      DOC_TRANSFORM_HSL},
+    {"hsl_ip", (PyCFunction)surf_hsl_ip_counted, METH_VARARGS | METH_KEYWORDS,
+     DOC_TRANSFORM_HSLIP},
+    {"color_matrix", (PyCFunction)surf_color_matrix_counted,
+     METH_VARARGS | METH_KEYWORDS, DOC_TRANSFORM_COLORMATRIX},
     {NULL, NULL, 0, NULL}};
 
+/* The state of the module, whose kernels set_simd_level() picks again */
+static struct _module_state *simd_state = NULL;
+
+static int
+_transform_simd_report(PyObject *dispatch, const char *op,
+                       const char *backend)
+{
+    char name[16];
+    size_t i;
+
+    if (!strcmp(backend, "GENERIC")) {
+        return pg_simd_report(dispatch, op, "scalar");
+    }
+    for (i = 0; backend[i] && i < sizeof(name) - 1; i++) {
+        name[i] = (char)SDL_tolower(backend[i]);
+    }
+    name[i] = '\0';
+    return pg_simd_report(dispatch, op, name);
+}
+
+/* smoothscale, blur and rotate keep their kernels in the module state, the
+ * others are picked on every call */
+static int
+_transform_simd_dispatch(PyObject *dispatch)
+{
+    struct _module_state *st = simd_state;
+    int smoothscale_threads, blur_threads;
+    int has_avx2 = 0, has_sse2_neon = 0;
+
+    if (!dispatch) {
+        smoothscale_threads = st->smoothscale_threads;
+        blur_threads = st->blur_threads;
+        st->filter_shrink_X = NULL;
+        smoothscale_init(st);
+        blur_init(st);
+        rotate_init(st);
+        st->smoothscale_threads = smoothscale_threads;
+        st->blur_threads = blur_threads;
+        return 0;
+    }
+
+#if !defined(__EMSCRIPTEN__)
+    has_avx2 = pg_has_avx2();
+#if PG_ENABLE_SSE_NEON
+    has_sse2_neon = pg_HasSSE_NEON();
+#endif /* PG_ENABLE_SSE_NEON */
+#endif /* __EMSCRIPTEN__ */
+    if (_transform_simd_report(dispatch, "smoothscale", st->filter_type) ||
+        _transform_simd_report(dispatch, "rotate", st->rotate_backend) ||
+        pg_simd_report(dispatch, "transform",
+                       pg_simd_backend_name(has_avx2, has_sse2_neon))) {
+        return -1;
+    }
+    return 0;
+}
+
 MODINIT_DEFINE(transform)
 {
     PyObject *module;
@@ -3832,16 +7391,56 @@ MODINIT_DEFINE(transform)
         return NULL;
     }
 
+    if (PyType_Ready(&pgAccumulator_Type) < 0) {
+        return NULL;
+    }
+    if (PyType_Ready(&pgLightMap_Type) < 0) {
+        return NULL;
+    }
+
     /* create the module */
     module = PyModule_Create(&_module);
 
     if (module == 0) {
         return NULL;
     }
+    if (PG_GIL_NOT_USED(module)) {
+        Py_DECREF(module);
+        return NULL;
+    }
+
+    Py_INCREF(&pgAccumulator_Type);
+    if (PyModule_AddObject(module, "Accumulator",
+                           (PyObject *)&pgAccumulator_Type)) {
+        Py_DECREF(&pgAccumulator_Type);
+        Py_DECREF(module);
+        return NULL;
+    }
+    Py_INCREF(&pgLightMap_Type);
+    if (PyModule_AddObject(module, "LightMap",
+                           (PyObject *)&pgLightMap_Type)) {
+        Py_DECREF(&pgLightMap_Type);
+        Py_DECREF(module);
+        return NULL;
+    }
 
     st = GETSTATE(module);
     if (st->filter_type == 0) {
         smoothscale_init(st);
     }
+    if (st->blur_threads == 0) {
+        blur_init(st);
+    }
+    if (st->rotate_backend == 0) {
+        rotate_init(st);
+    }
+    if (st->average_color_threads == 0) {
+        st->average_color_threads = 1;
+    }
+    if (st->rotozoom_threads == 0) {
+        st->rotozoom_threads = 1;
+    }
+    simd_state = st;
+    pg_RegisterSIMDDispatch(_transform_simd_dispatch);
     return module;
 }
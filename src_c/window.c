@@ -1,3 +1,4 @@
+#define PG_SURFACE_ORIGIN PG_SURF_ORIGIN_DISPLAY
 #define PYGAMEAPI_WINDOW_INTERNAL
 
 #include "pygame.h"
@@ -211,6 +212,193 @@ window_flip(pgWindowObject *self, PyObject *_null)
     Py_RETURN_NONE;
 }
 
+/* One window of a Window.flip_all call. rects is NULL to update the whole
+ * window. */
+typedef struct {
+    SDL_Window *win;
+    SDL_Rect *rects;
+    int count;
+    SDL_bool gl;
+    int result;
+    char error[128];
+} pgWindowFlip;
+
+static int SDLCALL
+_window_flip_run(void *data)
+{
+    pgWindowFlip *flip = (pgWindowFlip *)data;
+
+    if (flip->gl) {
+        SDL_GL_SwapWindow(flip->win);
+        flip->result = 0;
+    }
+    else if (flip->rects) {
+        flip->result =
+            flip->count ? SDL_UpdateWindowSurfaceRects(flip->win, flip->rects,
+                                                       flip->count)
+                        : 0;
+    }
+    else {
+        flip->result = SDL_UpdateWindowSurface(flip->win);
+    }
+    if (flip->result) {
+        /* the error is per thread */
+        SDL_strlcpy(flip->error, SDL_GetError(), sizeof(flip->error));
+    }
+    return 0;
+}
+
+/* Fills flip from a Window or a (Window, rects) pair. Returns -1 with an
+ * exception set on error. */
+static int
+_window_flip_parse(PyObject *item, pgWindowFlip *flip)
+{
+    pgWindowObject *window;
+    PyObject *rects = NULL, *seq, *obj;
+    SDL_Rect temp, *rect, bounds = {0};
+    Py_ssize_t i, len;
+
+    if (PyTuple_Check(item) && PyTuple_GET_SIZE(item) == 2) {
+        rects = PyTuple_GET_ITEM(item, 1);
+        item = PyTuple_GET_ITEM(item, 0);
+    }
+    if (!pgWindow_Check(item)) {
+        PyErr_SetString(PyExc_TypeError,
+                        "expected Window objects or (Window, rects) pairs");
+        return -1;
+    }
+    window = (pgWindowObject *)item;
+    if (!window->_win) {
+        PyErr_SetString(pgExc_SDLError, "the Window has been destroyed");
+        return -1;
+    }
+    flip->win = window->_win;
+    flip->gl = window->context != NULL;
+    if (flip->gl) {
+        /* a GL buffer swap presents the whole window */
+        return 0;
+    }
+    if (!window->surf || !window->surf->surf) {
+        PyErr_SetString(pgExc_SDLError,
+                        "the Window has no surface associated with it, did "
+                        "you forget to call Window.get_surface()");
+        return -1;
+    }
+    if (rects == NULL || rects == Py_None) {
+        return 0;
+    }
+
+    seq = PySequence_Fast(rects, "rects must be a sequence of rects");
+    if (!seq) {
+        return -1;
+    }
+    len = PySequence_Fast_GET_SIZE(seq);
+    flip->rects = PyMem_New(SDL_Rect, len ? len : 1);
+    if (!flip->rects) {
+        Py_DECREF(seq);
+        PyErr_NoMemory();
+        return -1;
+    }
+    bounds.w = window->surf->surf->w;
+    bounds.h = window->surf->surf->h;
+    for (i = 0; i < len; i++) {
+        obj = PySequence_Fast_GET_ITEM(seq, i);
+        if (obj == Py_None) {
+            continue;
+        }
+        rect = pgRect_FromObject(obj, &temp);
+        if (!rect) {
+            Py_DECREF(seq);
+            PyErr_SetString(PyExc_TypeError,
+                            "rects must be a sequence of rects");
+            return -1;
+        }
+        if (SDL_IntersectRect(rect, &bounds, &flip->rects[flip->count])) {
+            flip->count++;
+        }
+    }
+    Py_DECREF(seq);
+    return 0;
+}
+
+static PyObject *
+window_flip_all(PyObject *cls, PyObject *arg)
+{
+    PyObject *seq;
+    pgWindowFlip *flips;
+    SDL_Thread **threads;
+    SDL_bool parallel;
+    Py_ssize_t i, len;
+    int status = -1;
+
+    seq = PySequence_Fast(arg, "expected a sequence of windows");
+    if (!seq) {
+        return NULL;
+    }
+    len = PySequence_Fast_GET_SIZE(seq);
+    flips = PyMem_New(pgWindowFlip, len ? len : 1);
+    threads = PyMem_New(SDL_Thread *, len ? len : 1);
+    if (!flips || !threads) {
+        PyMem_Free(flips);
+        PyMem_Free(threads);
+        Py_DECREF(seq);
+        return PyErr_NoMemory();
+    }
+    memset(flips, 0, sizeof(pgWindowFlip) * (len ? len : 1));
+    memset(threads, 0, sizeof(SDL_Thread *) * (len ? len : 1));
+
+    for (i = 0; i < len; i++) {
+        if (_window_flip_parse(PySequence_Fast_GET_ITEM(seq, i), &flips[i])) {
+            goto end;
+        }
+    }
+
+    /* Windows are updated with plain GDI blits, which are fine to do for
+     * several windows at once. Elsewhere the updates may go through one
+     * display connection or have to happen on the main thread, and GL
+     * swaps need their context, so those are done one after another. */
+    parallel = SDL_strcmp(SDL_GetCurrentVideoDriver(), "windows") == 0;
+
+    Py_BEGIN_ALLOW_THREADS;
+    for (i = 1; parallel && i < len; i++) {
+        if (!flips[i].gl) {
+            threads[i] = SDL_CreateThread(_window_flip_run,
+                                          "pygame window flip", &flips[i]);
+        }
+    }
+    for (i = 0; i < len; i++) {
+        if (!threads[i]) {
+            _window_flip_run(&flips[i]);
+        }
+    }
+    for (i = 1; i < len; i++) {
+        if (threads[i]) {
+            SDL_WaitThread(threads[i], NULL);
+        }
+    }
+    Py_END_ALLOW_THREADS;
+
+    for (i = 0; i < len; i++) {
+        if (flips[i].result) {
+            PyErr_SetString(pgExc_SDLError, flips[i].error);
+            goto end;
+        }
+    }
+    status = 0;
+
+end:
+    for (i = 0; i < len; i++) {
+        PyMem_Free(flips[i].rects);
+    }
+    PyMem_Free(flips);
+    PyMem_Free(threads);
+    Py_DECREF(seq);
+    if (status) {
+        return NULL;
+    }
+    Py_RETURN_NONE;
+}
+
 // Callback function for surface auto resize
 static int SDLCALL
 _resize_event_watch(void *userdata, SDL_Event *event)
@@ -1097,6 +1285,8 @@ static PyMethodDef window_methods[] = {
      DOC_WINDOW_SETMODALFOR},
     {"set_icon", (PyCFunction)window_set_icon, METH_O, DOC_WINDOW_SETICON},
     {"flip", (PyCFunction)window_flip, METH_NOARGS, DOC_WINDOW_FLIP},
+    {"flip_all", (PyCFunction)window_flip_all, METH_STATIC | METH_O,
+     DOC_WINDOW_FLIPALL},
     {"get_surface", (PyCFunction)window_get_surface, METH_NOARGS,
      DOC_WINDOW_GETSURFACE},
     {"from_display_module", (PyCFunction)window_from_display_module,
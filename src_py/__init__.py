@@ -105,6 +105,7 @@ if sys.platform in ("wasi", "emscripten"):
         Rect = pygame.rect.Rect
 
         BufferProxy = pygame.bufferproxy.BufferProxy
+        BufferArray = pygame.bufferproxy.BufferArray
 
         # cython modules use multiphase initialisation when not in builtin Inittab.
 
@@ -127,7 +128,7 @@ if sys.platform in ("wasi", "emscripten"):
 from pygame.base import *  # pylint: disable=wildcard-import; lgtm[py/polluting-import]
 from pygame.constants import *  # now has __all__ pylint: disable=wildcard-import; lgtm[py/polluting-import]
 from pygame.version import *  # pylint: disable=wildcard-import; lgtm[py/polluting-import]
-from pygame.rect import Rect, FRect
+from pygame.rect import Rect, FRect, RectArray, FRectArray
 from pygame.rwobject import encode_string, encode_file_path
 import pygame.surflock
 import pygame.color
@@ -136,6 +137,7 @@ Color = pygame.color.Color
 import pygame.bufferproxy
 
 BufferProxy = pygame.bufferproxy.BufferProxy
+BufferArray = pygame.bufferproxy.BufferArray
 import pygame.math
 
 Vector2 = pygame.math.Vector2
@@ -145,185 +147,354 @@ from pygame.base import __version__
 
 # next, the "standard" modules
 # we still allow them to be missing for stripped down pygame distributions
-try:
-    import pygame.display
-except (ImportError, OSError):
-    display = MissingModule("display", urgent=1)
+# PYGAME_LAZY_IMPORT leaves them and the "optional" ones to __getattr__()
+_lazy_import = "PYGAME_LAZY_IMPORT" in os.environ
 
-try:
-    import pygame.draw
-except (ImportError, OSError):
-    draw = MissingModule("draw", urgent=1)
+if not _lazy_import:
+    try:
+        import pygame.display
+    except (ImportError, OSError):
+        display = MissingModule("display", urgent=1)
 
-try:
-    import pygame.event
-    from pygame.event import Event
-except (ImportError, OSError):
-    event = MissingModule("event", urgent=1)
+    try:
+        import pygame.draw
+    except (ImportError, OSError):
+        draw = MissingModule("draw", urgent=1)
 
-try:
-    import pygame.image
-except (ImportError, OSError):
-    image = MissingModule("image", urgent=1)
+    try:
+        import pygame.event
+        from pygame.event import Event
+    except (ImportError, OSError):
+        event = MissingModule("event", urgent=1)
 
-try:
-    import pygame.joystick
-    from pygame.joystick import Joystick
-except (ImportError, OSError):
-    joystick = MissingModule("joystick", urgent=1)
+    try:
+        import pygame.image
+    except (ImportError, OSError):
+        image = MissingModule("image", urgent=1)
 
-try:
-    import pygame.key
-except (ImportError, OSError):
-    key = MissingModule("key", urgent=1)
+    try:
+        import pygame.joystick
+        from pygame.joystick import Joystick
+    except (ImportError, OSError):
+        joystick = MissingModule("joystick", urgent=1)
 
-try:
-    import pygame.mouse
-except (ImportError, OSError):
-    mouse = MissingModule("mouse", urgent=1)
+    try:
+        import pygame.key
+    except (ImportError, OSError):
+        key = MissingModule("key", urgent=1)
 
-try:
-    import pygame.cursors
-    from pygame.cursors import Cursor
-except (ImportError, OSError):
-    cursors = MissingModule("cursors", urgent=1)
+    try:
+        import pygame.mouse
+    except (ImportError, OSError):
+        mouse = MissingModule("mouse", urgent=1)
 
-    def Cursor(*args):  # pylint: disable=unused-argument
-        _attribute_undefined("pygame.Cursor")
+    try:
+        import pygame.input
+    except (ImportError, OSError):
+        input = MissingModule("input", urgent=0)
 
+    try:
+        import pygame.cursors
+        from pygame.cursors import Cursor
+    except (ImportError, OSError):
+        cursors = MissingModule("cursors", urgent=1)
 
-try:
-    import pygame.sprite
-except (ImportError, OSError):
-    sprite = MissingModule("sprite", urgent=1)
+        def Cursor(*args):  # pylint: disable=unused-argument
+            _attribute_undefined("pygame.Cursor")
 
+    try:
+        import pygame.sprite
+    except (ImportError, OSError):
+        sprite = MissingModule("sprite", urgent=1)
 
-try:
-    import pygame.pixelcopy
-except (ImportError, OSError):
-    pixelcopy = MissingModule("pixelcopy", urgent=1)
+    try:
+        import pygame.pixelcopy
+    except (ImportError, OSError):
+        pixelcopy = MissingModule("pixelcopy", urgent=1)
 
+    try:
+        from pygame.surface import (
+            Surface,
+            SurfaceType,
+            BlitBatch,
+            BlendMode,
+            SurfaceView,
+        )
+    except (ImportError, OSError):
 
-try:
-    from pygame.surface import Surface, SurfaceType
-except (ImportError, OSError):
+        def Surface(size, flags, depth, masks):  # pylint: disable=unused-argument
+            _attribute_undefined("pygame.Surface")
 
-    def Surface(size, flags, depth, masks):  # pylint: disable=unused-argument
-        _attribute_undefined("pygame.Surface")
+        SurfaceType = Surface
 
-    SurfaceType = Surface
+        def BlitBatch(blit_sequence=()):  # pylint: disable=unused-argument
+            _attribute_undefined("pygame.BlitBatch")
 
-try:
-    import pygame.mask
-    from pygame.mask import Mask
-except (ImportError, OSError):
-    mask = MissingModule("mask", urgent=0)
+        def BlendMode(*args, **kwargs):  # pylint: disable=unused-argument
+            _attribute_undefined("pygame.BlendMode")
 
-    def Mask(size, fill):  # pylint: disable=unused-argument
-        _attribute_undefined("pygame.Mask")
+        def SurfaceView(surface, rect):  # pylint: disable=unused-argument
+            _attribute_undefined("pygame.SurfaceView")
 
+    try:
+        import pygame.mask
+        from pygame.mask import Mask
+    except (ImportError, OSError):
+        mask = MissingModule("mask", urgent=0)
 
-try:
-    from pygame.pixelarray import PixelArray
-except (ImportError, OSError):
+        def Mask(size, fill):  # pylint: disable=unused-argument
+            _attribute_undefined("pygame.Mask")
 
-    def PixelArray(surface):  # pylint: disable=unused-argument
-        _attribute_undefined("pygame.PixelArray")
+    try:
+        from pygame.pixelarray import PixelArray
+    except (ImportError, OSError):
 
+        def PixelArray(surface):  # pylint: disable=unused-argument
+            _attribute_undefined("pygame.PixelArray")
 
-try:
-    import pygame.time
-    from pygame.time import Clock
-except (ImportError, OSError):
-    time = MissingModule("time", urgent=1)
+    try:
+        import pygame.time
+        from pygame.time import Clock
+    except (ImportError, OSError):
+        time = MissingModule("time", urgent=1)
 
-try:
-    import pygame.transform
-except (ImportError, OSError):
-    transform = MissingModule("transform", urgent=1)
+    try:
+        import pygame.transform
+    except (ImportError, OSError):
+        transform = MissingModule("transform", urgent=1)
+
+    # lastly, the "optional" pygame modules
+    if "PYGAME_FREETYPE" in os.environ:
+        try:
+            import pygame.ftfont as font
+
+            sys.modules["pygame.font"] = font
+        except (ImportError, OSError):
+            pass
+    try:
+        import pygame.font
+        import pygame.sysfont
+
+        from pygame.font import Font
+
+        pygame.font.SysFont = pygame.sysfont.SysFont
+        pygame.font.get_fonts = pygame.sysfont.get_fonts
+        pygame.font.match_font = pygame.sysfont.match_font
+    except (ImportError, OSError):
+        font = MissingModule("font", urgent=0)
 
-# lastly, the "optional" pygame modules
-if "PYGAME_FREETYPE" in os.environ:
+    # try to load pygame.mixer_music before mixer, for py2app...
     try:
-        import pygame.ftfont as font
+        import pygame.mixer_music
 
-        sys.modules["pygame.font"] = font
+        # del pygame.mixer_music
+        # print("NOTE2: failed importing pygame.mixer_music in lib/__init__.py")
     except (ImportError, OSError):
         pass
-try:
-    import pygame.font
-    import pygame.sysfont
 
-    from pygame.font import Font
+    try:
+        import pygame.mixer
+        from pygame.mixer import Channel
+    except (ImportError, OSError):
+        mixer = MissingModule("mixer", urgent=0)
 
-    pygame.font.SysFont = pygame.sysfont.SysFont
-    pygame.font.get_fonts = pygame.sysfont.get_fonts
-    pygame.font.match_font = pygame.sysfont.match_font
-except (ImportError, OSError):
-    font = MissingModule("font", urgent=0)
+    try:
+        import pygame.scrap
+    except (ImportError, OSError):
+        scrap = MissingModule("scrap", urgent=0)
 
-# try to load pygame.mixer_music before mixer, for py2app...
-try:
-    import pygame.mixer_music
+    try:
+        import pygame.surfarray
+    except (ImportError, OSError):
+        surfarray = MissingModule("surfarray", urgent=0)
 
-    # del pygame.mixer_music
-    # print("NOTE2: failed importing pygame.mixer_music in lib/__init__.py")
-except (ImportError, OSError):
-    pass
+    try:
+        import pygame.sndarray
+    except (ImportError, OSError):
+        sndarray = MissingModule("sndarray", urgent=0)
 
-try:
-    import pygame.mixer
-    from pygame.mixer import Channel
-except (ImportError, OSError):
-    mixer = MissingModule("mixer", urgent=0)
+    try:
+        import pygame._debug
+        from pygame._debug import print_debug_info
+    except (ImportError, OSError):
+        debug = MissingModule("_debug", urgent=0)
 
-try:
-    import pygame.scrap
-except (ImportError, OSError):
-    scrap = MissingModule("scrap", urgent=0)
+    try:
+        import pygame.system
+        from pygame._data_classes import PowerState as power_state
 
-try:
-    import pygame.surfarray
-except (ImportError, OSError):
-    surfarray = MissingModule("surfarray", urgent=0)
+        power_state.__module__ = "pygame.system"
+        del power_state
+    except (ImportError, OSError):
+        system = MissingModule("system", urgent=0)
 
-try:
-    import pygame.sndarray
-except (ImportError, OSError):
-    sndarray = MissingModule("sndarray", urgent=0)
+    try:
+        from pygame.window import Window
+    except (ImportError, OSError):
 
-try:
-    import pygame._debug
-    from pygame._debug import print_debug_info
-except (ImportError, OSError):
-    debug = MissingModule("_debug", urgent=0)
+        def Window(title="pygame window", size=(640, 480), position=None, **kwargs):  # pylint: disable=unused-argument
+            _attribute_undefined("pygame.Window")
 
-try:
-    import pygame.system
-    from pygame._data_classes import PowerState as power_state
+    # there's also a couple "internal" modules not needed
+    # by users, but putting them here helps "dependency finder"
+    # programs get everything they need (like py2exe)
+    try:
+        import pygame.imageext
 
-    power_state.__module__ = "pygame.system"
-    del power_state
-except (ImportError, OSError):
-    system = MissingModule("system", urgent=0)
+        del pygame.imageext
+    except (ImportError, OSError):
+        pass
 
-try:
-    from pygame.window import Window
-except (ImportError, OSError):
+else:
+    # pygame.<name> -> the submodule it comes from, for the classes and
+    # functions the imports above put in the pygame namespace
+    _LAZY_NAMES = {
+        "Event": "event",
+        "Joystick": "joystick",
+        "Cursor": "cursors",
+        "Surface": "surface",
+        "SurfaceType": "surface",
+        "BlitBatch": "surface",
+        "SurfaceView": "surface",
+        "BlendMode": "surface",
+        "Mask": "mask",
+        "PixelArray": "pixelarray",
+        "Clock": "time",
+        "Font": "font",
+        "Channel": "mixer",
+        "print_debug_info": "_debug",
+        "Window": "window",
+    }
+    _LAZY_MODULES = {
+        "display",
+        "draw",
+        "event",
+        "image",
+        "joystick",
+        "key",
+        "mouse",
+        "input",
+        "cursors",
+        "sprite",
+        "pixelcopy",
+        "surface",
+        "mask",
+        "pixelarray",
+        "time",
+        "transform",
+        "font",
+        "sysfont",
+        "mixer",
+        "mixer_music",
+        "scrap",
+        "surfarray",
+        "sndarray",
+        "_debug",
+        "system",
+        "window",
+    }
+
+    def _autoinit(module):
+        """Inits module like pygame.init() does, if it was called"""
+        init = getattr(module, "_internal_mod_init", None)
+        init = init or getattr(module, "init", None)
+        if init is not None and get_init():
+            try:
+                init()
+            except error:
+                pass  # like pygame.init(), which only counts failures
+
+    class _AutoinitLoader:
+        """Loads a module pygame.init() inits, then inits it"""
+
+        def __init__(self, loader):
+            self.loader = loader
+
+        def __getattr__(self, name):
+            return getattr(self.loader, name)
+
+        def create_module(self, spec):
+            return self.loader.create_module(spec)
+
+        def exec_module(self, module):
+            self.loader.exec_module(module)
+            _autoinit(module)
+
+    class _AutoinitFinder:
+        """Has the modules pygame.init() leaves alone until they are imported
+        inited as they are, whether by pygame.__getattr__() or anything else"""
+
+        modules = (
+            "pygame.display",
+            "pygame.joystick",
+            "pygame.font",
+            "pygame.freetype",
+            "pygame.mixer",
+        )
+
+        @classmethod
+        def find_spec(cls, fullname, path=None, target=None):
+            if fullname not in cls.modules:
+                return None
+            import importlib.machinery
+
+            spec = importlib.machinery.PathFinder.find_spec(fullname, path, target)
+            if spec is not None and spec.loader is not None:
+                spec.loader = _AutoinitLoader(spec.loader)
+            return spec
+
+    sys.meta_path.insert(0, _AutoinitFinder)
+
+    def _import_lazy(modname):
+        """Imports pygame.<modname> the way the eager imports do"""
+        import importlib
+        import os
+        import sys
+
+        if modname == "font" and "PYGAME_FREETYPE" in os.environ:
+            try:
+                ftfont = importlib.import_module("pygame.ftfont")
+            except (ImportError, OSError):
+                pass
+            else:
+                sys.modules["pygame.font"] = ftfont
+                _autoinit(ftfont)
+        module = importlib.import_module(f"pygame.{modname}")
+        if modname == "font":
+            sysfont = importlib.import_module("pygame.sysfont")
+            module.SysFont = sysfont.SysFont
+            module.get_fonts = sysfont.get_fonts
+            module.match_font = sysfont.match_font
+        elif modname == "system":
+            from pygame._data_classes import PowerState
+
+            PowerState.__module__ = "pygame.system"
+        return module
+
+    def __getattr__(name):
+        """Imports the submodules and classes PYGAME_LAZY_IMPORT left out on
+        first use (PEP 562)"""
+        modname = _LAZY_NAMES.get(name, name)
+        if modname not in _LAZY_MODULES:
+            raise AttributeError(f"module 'pygame' has no attribute '{name}'")
+        try:
+            module = _import_lazy(modname)
+        except (ImportError, OSError):
+            if name == modname:
+                value = MissingModule(modname, urgent=0)
+            else:
 
-    def Window(title="pygame window", size=(640, 480), position=None, **kwargs):  # pylint: disable=unused-argument
-        _attribute_undefined("pygame.Window")
+                def value(*args, **kwargs):  # pylint: disable=unused-argument
+                    _attribute_undefined(f"pygame.{name}")
 
+        else:
+            value = module if name == modname else getattr(module, name)
+        globals()[name] = value
+        return value
 
-# there's also a couple "internal" modules not needed
-# by users, but putting them here helps "dependency finder"
-# programs get everything they need (like py2exe)
-try:
-    import pygame.imageext
+    def __dir__():
+        return sorted(set(globals()) | _LAZY_MODULES | set(_LAZY_NAMES))
 
-    del pygame.imageext
-except (ImportError, OSError):
-    pass
 
 # this internal module needs to be included for dependency
 # finders, but can't be deleted, as some tests need it
@@ -379,4 +550,6 @@ if "PYGAME_HIDE_SUPPORT_PROMPT" not in os.environ:
     )
 
 # cleanup namespace
-del pygame, os, sys, platform, MissingModule, copyreg, packager_imports
+if not _lazy_import:
+    del MissingModule
+del pygame, os, sys, platform, copyreg, packager_imports, _lazy_import
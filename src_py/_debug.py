@@ -4,11 +4,14 @@ import platform
 import sys
 import traceback
 import importlib
+from array import array
+from contextlib import contextmanager
+from time import perf_counter_ns
 from typing import Tuple, Optional, Callable
 from os import environ
 
 from pygame.version import ver
-from pygame.system import get_cpu_instruction_sets
+from pygame.system import get_cpu_instruction_sets, get_perf_counters
 
 ImportResult = Tuple[str, bool, Optional[Callable]]
 
@@ -183,3 +186,172 @@ def print_debug_info(filename=None):
     else:
         with open(filename, "w", encoding="utf8") as debugfile:
             debugfile.write(debug_str)
+
+
+# the pygame.system.get_perf_counters() kinds a frame is broken down into
+_PERF_KINDS = ("event", "blit", "fill", "transform", "text", "flip")
+
+
+class FrameProfiler:
+    """Times every frame of a game, and what the time went to
+
+    Each frame runs from one call of tick() to the next. Its breakdown holds
+    the time spent in each of pygame's hot paths (see
+    pygame.system.get_perf_counters()), in each section of the game's own
+    code timed with section(), and waiting in Clock.tick(). Sections include
+    the pygame calls made inside of them, e.g. the blits of a "draw" section
+    are counted by both.
+
+    The last history frames are kept in a flat array of doubles used as a
+    ring buffer, so that recording a frame stays cheap next to the frame.
+
+    Args:
+        clock: the pygame.time.Clock to tick, a new one if None
+        history: the number of frames to keep
+        sections: the names that can be passed to section()
+    """
+
+    def __init__(self, clock=None, history=120, sections=("update", "draw")):
+        if history < 1:
+            raise ValueError("history must be at least 1")
+        if clock is None:
+            from pygame.time import Clock
+
+            clock = Clock()
+        self.clock = clock
+        self.history = history
+        self.fields = ("frame", "wait") + _PERF_KINDS + tuple(sections)
+        self._columns = {name: i for i, name in enumerate(self.fields)}
+        self._frames = array("d", bytes(8 * history * len(self.fields)))
+        self._count = 0
+        self._current = [0.0] * len(self.fields)
+        self._start = perf_counter_ns()
+        self._perf = self._perf_ns()
+
+    @staticmethod
+    def _perf_ns():
+        counters = get_perf_counters()
+        return [counters[kind]["ns"] if counters else 0 for kind in _PERF_KINDS]
+
+    @contextmanager
+    def section(self, name):
+        """Adds the time spent in the with block to the section of the frame
+
+        Args:
+            name: one of the sections given to the constructor
+        """
+        column = self._columns[name]
+        start = perf_counter_ns()
+        try:
+            yield
+        finally:
+            self._current[column] += (perf_counter_ns() - start) / 1e6
+
+    def tick(self, framerate=0):
+        """Ticks the clock and ends the frame
+
+        Args:
+            framerate: passed on to Clock.tick()
+
+        Returns:
+            int: what Clock.tick() returned
+        """
+        wait_start = perf_counter_ns()
+        ret = self.clock.tick(framerate)
+        end = perf_counter_ns()
+
+        current = self._current
+        current[0] = (end - self._start) / 1e6
+        current[1] = (end - wait_start) / 1e6
+        perf = self._perf_ns()
+        for i, (now, before) in enumerate(zip(perf, self._perf)):
+            current[2 + i] = (now - before) / 1e6
+
+        offset = self._count % self.history * len(current)
+        for i, value in enumerate(current):
+            self._frames[offset + i] = value
+            current[i] = 0.0
+        self._count += 1
+
+        self._start = end
+        self._perf = perf
+        return ret
+
+    def get_frames(self):
+        """Returns the recorded frames, oldest first
+
+        Returns:
+            list[dict[str, float]]: the breakdown of each frame, in
+            milliseconds
+        """
+        width = len(self.fields)
+        count = min(self._count, self.history)
+        first = self._count - count
+        frames = []
+        for n in range(first, self._count):
+            offset = n % self.history * width
+            values = self._frames[offset : offset + width]
+            frames.append(dict(zip(self.fields, values)))
+        return frames
+
+    def get_average(self):
+        """Returns the average breakdown of the recorded frames
+
+        Returns:
+            dict[str, float]: milliseconds, all 0 if no frame was recorded
+        """
+        frames = self.get_frames()
+        return {
+            name: sum(frame[name] for frame in frames) / max(len(frames), 1)
+            for name in self.fields
+        }
+
+    def draw(self, surface, pos=(0, 0), size=(120, 40), scale=None):
+        """Draws a graph of the recorded frames
+
+        There is one column per frame, the newest on the right. Its lower
+        part is the time the frame was busy, the upper part the time it
+        waited in Clock.tick().
+
+        Args:
+            surface: the Surface to draw on
+            pos: the top left corner of the graph
+            size: the size of the graph
+            scale: the frame time in milliseconds that fills the height,
+                twice the average frame time if None
+
+        Returns:
+            Rect: the area drawn on
+        """
+        from pygame.draw import line, rect
+        from pygame.rect import Rect
+
+        area = Rect(pos, size)
+        rect(surface, (0, 0, 0), area)
+        frames = self.get_frames()[-area.width :]
+        if not frames:
+            return area
+        if scale is None:
+            scale = 2 * sum(frame["frame"] for frame in frames) / len(frames)
+        scale = area.height / max(scale, 1e-3)
+
+        x = area.right - len(frames)
+        for frame in frames:
+            busy = min(int((frame["frame"] - frame["wait"]) * scale), area.height)
+            total = min(int(frame["frame"] * scale), area.height)
+            if total > busy:
+                line(
+                    surface,
+                    (60, 90, 160),
+                    (x, area.bottom - total),
+                    (x, area.bottom - busy - 1),
+                )
+            if busy > 0:
+                line(
+                    surface,
+                    (230, 160, 40),
+                    (x, area.bottom - busy),
+                    (x, area.bottom - 1),
+                )
+            x += 1
+        return area
@@ -79,9 +79,13 @@ try:
     from pygame import _camera
 
     colorspace = _camera.colorspace
+    set_conversion_threads = _camera.set_conversion_threads
+    get_conversion_threads = _camera.get_conversion_threads
 except ImportError:
     # Should not happen in most cases
     colorspace = _colorspace_not_available
+    set_conversion_threads = _colorspace_not_available
+    get_conversion_threads = _colorspace_not_available
 
 
 def _setup_backend(backend):
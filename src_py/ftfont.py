@@ -17,6 +17,7 @@ from pygame._freetype import _internal_mod_init
 from pygame.sysfont import match_font, get_fonts, SysFont as _SysFont
 from pygame import encode_file_path
 from pygame import draw
+from array import array
 
 
 class Font(_Font):
@@ -179,6 +180,17 @@ class Font(_Font):
 
         return self.get_rect(text).size
 
+    def size_many(self, strings):
+        """size_many(strings) -> memoryview
+        determine the sizes of many texts at once"""
+
+        sizes = array("i")
+        for text in strings:
+            sizes.extend(self.get_rect(text).size)
+        if not sizes:
+            return memoryview(b"").cast("i")
+        return memoryview(sizes).cast("B").cast("i", (len(sizes) // 2, 2))
+
 
 FontType = Font
 
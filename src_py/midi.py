@@ -18,12 +18,11 @@ New in pygame 1.9.0.
 # TODO: finish writing tests.
 #        - likely as interactive tests... so you'd need to plug in
 #          a midi device.
-# TODO: create a background thread version for input threads.
-#        - that can automatically inject input into the event queue
-#          once the input object is running.  Like joysticks.
 
 import math
 import atexit
+import threading
+from array import array
 
 import pygame
 import pygame.locals
@@ -56,6 +55,9 @@ __all__ = [
 
 __theclasses__ = ["Input", "Output"]
 
+# the Input objects posting events from a thread, stopped on quit()
+_posting_inputs = set()
+
 
 def _module_init(state=None):
     # this is a sneaky dodge to store module level state in a non-public
@@ -96,6 +98,8 @@ def quit():  # pylint: disable=redefined-builtin
     """
     if _module_init():
         # TODO: find all Input and Output classes and close them first?
+        for midi_input in list(_posting_inputs):
+            midi_input.stop_posting()
         _pypm.Terminate()
         _module_init(False)
 
@@ -259,6 +263,9 @@ class Input:
         The buffer_size specifies the number of input events to be buffered
         waiting to be read using Input.read().
         """
+        self._input = None
+        self._post_thread = None
+        self._post_stop = None
         _check_init()
 
         if device_id == -1:
@@ -307,6 +314,7 @@ class Input:
         exits -- this is particularly difficult under Windows.
         """
         _check_init()
+        self.stop_posting()
         if self._input is not None:
             self._input.Close()
         self._input = None
@@ -323,6 +331,68 @@ class Input:
         self._check_open()
         return self._input.Read(num_events)
 
+    def read_into(self, buffer):
+        """reads midi events into a buffer of 32 bit integers.
+        Input.read_into(buffer): return num_events
+
+        Fills the writable buffer with as many events as fit, without
+        making Python objects for them and with the GIL released.
+        [timestamp, message, timestamp, message, ...]
+        with status, data1, data2 and data3 as the bytes of message, the
+        status in the lowest byte.
+        """
+        _check_init()
+        self._check_open()
+        return self._input.read_into(buffer)
+
+    def start_posting(self, interval=1):
+        """posts the midi input to the event queue from a thread.
+        Input.start_posting(interval=1): return None
+
+        A thread reads the input, and posts MIDIIN events like the ones of
+        midis2events(). It checks the input every interval milliseconds.
+        """
+        _check_init()
+        self._check_open()
+        self.stop_posting()
+
+        self._post_stop = threading.Event()
+        self._post_thread = threading.Thread(
+            target=self._post_events,
+            args=(self._post_stop, interval / 1000.0),
+            daemon=True,
+        )
+        _posting_inputs.add(self)
+        self._post_thread.start()
+
+    def stop_posting(self):
+        """stops the thread of start_posting().
+        Input.stop_posting(): return None
+        """
+        if self._post_thread is None:
+            return
+        self._post_stop.set()
+        self._post_thread.join()
+        self._post_thread = None
+        self._post_stop = None
+        _posting_inputs.discard(self)
+
+    def _post_events(self, stop, interval):
+        buffer = array("i", bytes(4 * 2 * 256))
+        while not stop.is_set():
+            count = self._input.read_into(buffer)
+            if not count:
+                stop.wait(interval)
+                continue
+
+            midis = []
+            for i in range(0, 2 * count, 2):
+                message = buffer[i + 1]
+                data = [(message >> shift) & 0xFF for shift in (0, 8, 16, 24)]
+                midis.append([data, buffer[i]])
+            for event in midis2events(midis, self.device_id):
+                pygame.event.post(event)
+
     def poll(self):
         """returns true if there's data, or false if not.
         Input.poll(): return Bool
@@ -496,6 +566,19 @@ class Output:
 
         self._output.Write(data)
 
+    def write_from(self, buffer):
+        """writes midi events from a buffer of 32 bit integers.
+        Output.write_from(buffer)
+
+        Writes the events packed like Input.read_into() reads them,
+        [timestamp, message, timestamp, message, ...]
+        without a limit on their number, and with the GIL released.
+        """
+        _check_init()
+        self._check_open()
+
+        self._output.write_from(buffer)
+
     def write_short(self, status, data1=0, data2=0):
         """write_short(status <, data1><, data2>)
         Output.write_short(status)
@@ -84,12 +84,16 @@ Sprites are not thread safe, so lock them yourself if using threads.
 # specific ones that aren't quite so general but fit into common
 # specialized cases.
 
+from bisect import bisect_left, insort
 from warnings import warn
+from weakref import WeakKeyDictionary
 from typing import Optional
 
 import pygame
 
-from pygame.rect import Rect
+from pygame.geometry import RectIndex
+from pygame.rect import Rect, _merge_dirty
+from pygame.surface import Surface, _draw_sprites, _update_sprites
 from pygame.time import get_ticks
 from pygame.mask import from_surface
 
@@ -550,8 +554,7 @@ class AbstractGroup:
         were passed to this method are passed to the Sprite update function.
 
         """
-        for sprite in self.sprites():
-            sprite.update(*args, **kwargs)
+        _update_sprites(self.sprites(), args, kwargs)
 
     def draw(self, surface):
         """draw all sprites onto the surface
@@ -562,7 +565,9 @@ class AbstractGroup:
 
         """
         sprites = self.sprites()
-        if hasattr(surface, "blits"):
+        if type(surface) is Surface:  # pylint: disable=unidiomatic-typecheck
+            _draw_sprites(surface, sprites, self.spritedict)
+        elif hasattr(surface, "blits"):
             self.spritedict.update(
                 zip(sprites, surface.blits((spr.image, spr.rect) for spr in sprites))
             )
@@ -741,7 +746,11 @@ class LayeredUpdates(AbstractGroup):
 
         """
         self._spritelayers = {}
-        self._spritelist = []
+        # the sprites of every layer in the order they were added, the
+        # sorted layers and the draw order built from them when needed
+        self._layer_sprites = {}
+        self._layer_order = []
+        self._sprite_order = []
         AbstractGroup.__init__(self)
         self._default_layer = kwargs.get("default_layer", 0)
 
@@ -764,25 +773,35 @@ class LayeredUpdates(AbstractGroup):
         elif hasattr(sprite, "_layer"):
             setattr(sprite, "_layer", layer)
 
-        sprites = self._spritelist  # speedup
-        sprites_layers = self._spritelayers
-        sprites_layers[sprite] = layer
-
-        # add the sprite at the right position
-        # bisect algorithmus
-        leng = len(sprites)
-        low = mid = 0
-        high = leng - 1
-        while low <= high:
-            mid = low + (high - low) // 2
-            if sprites_layers[sprites[mid]] <= layer:
-                low = mid + 1
-            else:
-                high = mid - 1
-        # linear search to find final position
-        while mid < leng and sprites_layers[sprites[mid]] <= layer:
-            mid += 1
-        sprites.insert(mid, sprite)
+        self._spritelayers[sprite] = layer
+        self._add_to_layer(sprite, layer)
+
+    def _add_to_layer(self, sprite, layer):
+        # the sprite goes on top of the sprites already in its layer
+        layer_sprites = self._layer_sprites.get(layer)
+        if layer_sprites is None:
+            layer_sprites = self._layer_sprites[layer] = {}
+            insort(self._layer_order, layer)
+        layer_sprites[sprite] = None
+        self._sprite_order = None
+
+    def _remove_from_layer(self, sprite, layer):
+        layer_sprites = self._layer_sprites[layer]
+        del layer_sprites[sprite]
+        if not layer_sprites:
+            del self._layer_sprites[layer]
+            del self._layer_order[bisect_left(self._layer_order, layer)]
+        self._sprite_order = None
+
+    @property
+    def _spritelist(self):
+        """all sprites ordered by layer (first back, last top)"""
+        if self._sprite_order is None:
+            layer_sprites = self._layer_sprites
+            self._sprite_order = [
+                spr for layer in self._layer_order for spr in layer_sprites[layer]
+            ]
+        return self._sprite_order
 
     def add(self, *sprites, **kwargs):
         """add a sprite or sequence of sprites to a group
@@ -833,7 +852,7 @@ class LayeredUpdates(AbstractGroup):
         The group uses it to add a sprite.
 
         """
-        self._spritelist.remove(sprite)
+        self._remove_from_layer(sprite, self._spritelayers[sprite])
         # these dirty rects are suboptimal for one frame
         old_rect = self.spritedict[sprite]
         if old_rect is not self._init_rect:
@@ -918,7 +937,7 @@ class LayeredUpdates(AbstractGroup):
         LayeredUpdates.layers(): return layers
 
         """
-        return sorted(set(self._spritelayers.values()))
+        return self._layer_order.copy()
 
     def change_layer(self, sprite, new_layer):
         """change the layer of the sprite
@@ -929,27 +948,10 @@ class LayeredUpdates(AbstractGroup):
         checked.
 
         """
-        sprites = self._spritelist  # speedup
         sprites_layers = self._spritelayers  # speedup
 
-        sprites.remove(sprite)
-        sprites_layers.pop(sprite)
-
-        # add the sprite at the right position
-        # bisect algorithmus
-        leng = len(sprites)
-        low = mid = 0
-        high = leng - 1
-        while low <= high:
-            mid = low + (high - low) // 2
-            if sprites_layers[sprites[mid]] <= new_layer:
-                low = mid + 1
-            else:
-                high = mid - 1
-        # linear search to find final position
-        while mid < leng and sprites_layers[sprites[mid]] <= new_layer:
-            mid += 1
-        sprites.insert(mid, sprite)
+        self._remove_from_layer(sprite, sprites_layers[sprite])
+        self._add_to_layer(sprite, new_layer)
         if hasattr(sprite, "_layer"):
             setattr(sprite, "_layer", new_layer)
 
@@ -970,7 +972,7 @@ class LayeredUpdates(AbstractGroup):
         LayeredUpdates.get_top_layer(): return layer
 
         """
-        return self._spritelayers[self._spritelist[-1]]
+        return self._layer_order[-1]
 
     def get_bottom_layer(self):
         """return the bottom layer
@@ -978,7 +980,7 @@ class LayeredUpdates(AbstractGroup):
         LayeredUpdates.get_bottom_layer(): return layer
 
         """
-        return self._spritelayers[self._spritelist[0]]
+        return self._layer_order[0]
 
     def move_to_front(self, sprite):
         """bring the sprite to front layer
@@ -1009,7 +1011,7 @@ class LayeredUpdates(AbstractGroup):
         LayeredUpdates.get_top_sprite(): return Sprite
 
         """
-        return self._spritelist[-1]
+        return next(reversed(self._layer_sprites[self._layer_order[-1]]))
 
     def get_sprites_from_layer(self, layer):
         """return all sprites from a layer ordered as they were added
@@ -1021,17 +1023,7 @@ class LayeredUpdates(AbstractGroup):
         layer).
 
         """
-        sprites = []
-        sprites_append = sprites.append
-        sprite_layers = self._spritelayers
-        for spr in self._spritelist:
-            if sprite_layers[spr] == layer:
-                sprites_append(spr)
-            elif sprite_layers[spr] > layer:
-                # break after because no other will
-                # follow with same layer
-                break
-        return sprites
+        return list(self._layer_sprites.get(layer, ()))
 
     def switch_layer(self, layer1_nr, layer2_nr):
         """switch the sprites from layer1_nr to layer2_nr
@@ -1171,8 +1163,9 @@ class LayeredDirty(LayeredUpdates):
 
             # clear using background
             if local_bgd is not None:
-                for rec in local_update:
-                    surf_blit_func(local_bgd, rec, rec)
+                surface.blits(
+                    [(local_bgd, rec, rec) for rec in local_update], doreturn=False
+                )
 
             # 2. draw
             self._draw_dirty_internal(
@@ -1250,33 +1243,20 @@ class LayeredDirty(LayeredUpdates):
     def _find_dirty_area(
         _clip, _old_rect, _rect, _sprites, _update, _update_append, init_rect
     ):
+        # _merge_dirty grows the rect by the update rects it collides with,
+        # takes them out of _update and appends the result clipped to _clip
         for spr in _sprites:
             if spr.dirty > 0:
                 # chose the right rect
                 if spr.source_rect:
-                    _union_rect = _rect(spr.rect.topleft, spr.source_rect.size)
+                    _merge_dirty(
+                        _update, _rect(spr.rect.topleft, spr.source_rect.size), _clip
+                    )
                 else:
-                    _union_rect = _rect(spr.rect)
-
-                _union_rect_collidelist = _union_rect.collidelist
-                _union_rect_union_ip = _union_rect.union_ip
-                i = _union_rect_collidelist(_update)
-                while i > -1:
-                    _union_rect_union_ip(_update[i])
-                    del _update[i]
-                    i = _union_rect_collidelist(_update)
-                _update_append(_union_rect.clip(_clip))
+                    _merge_dirty(_update, spr.rect, _clip)
 
                 if _old_rect[spr] is not init_rect:
-                    _union_rect = _rect(_old_rect[spr])
-                    _union_rect_collidelist = _union_rect.collidelist
-                    _union_rect_union_ip = _union_rect.union_ip
-                    i = _union_rect_collidelist(_update)
-                    while i > -1:
-                        _union_rect_union_ip(_update[i])
-                        del _update[i]
-                        i = _union_rect_collidelist(_update)
-                    _update_append(_union_rect.clip(_clip))
+                    _merge_dirty(_update, _old_rect[spr], _clip)
 
     def clear(self, surface, bgd):
         """use to set background
@@ -1656,14 +1636,30 @@ def collide_mask(left, right):
     try:
         leftmask = left.mask
     except AttributeError:
-        leftmask = from_surface(left.image)
+        leftmask = _image_mask(left.image)
     try:
         rightmask = right.mask
     except AttributeError:
-        rightmask = from_surface(right.image)
+        rightmask = _image_mask(right.image)
     return leftmask.overlap(rightmask, (xoffset, yoffset))
 
 
+# the masks collide_mask made from sprite images, with the image versions
+# they were made from
+_image_masks = WeakKeyDictionary()
+
+
+def _image_mask(image):
+    """the mask of an image, only made again once the image changed"""
+    if not isinstance(image, Surface):
+        return from_surface(image)
+    version = image.get_version()
+    cached = _image_masks.get(image)
+    if cached is None or cached[0] != version:
+        cached = _image_masks[image] = (version, from_surface(image))
+    return cached[1]
+
+
 def spritecollide(sprite, group, dokill, collided=None):
     """find Sprites in a Group that intersect another Sprite
 
@@ -1684,36 +1680,102 @@ def spritecollide(sprite, group, dokill, collided=None):
     which will be used to calculate the collision.
 
     """
-    # pull the default collision function in as a local variable outside
-    # the loop as this makes the loop run faster
-    default_sprite_collide_func = sprite.rect.colliderect
+    if collided is None or collided is collide_rect:
+        # Rect.collidelistall tests all the rects without leaving C
+        group_sprites = list(group)
+        crashed = [
+            group_sprites[i]
+            for i in sprite.rect.collidelistall(
+                [group_sprite.rect for group_sprite in group_sprites]
+            )
+        ]
+        if dokill:
+            for group_sprite in crashed:
+                group_sprite.kill()
+        return crashed
 
     if dokill:
         crashed = []
         append = crashed.append
 
         for group_sprite in group.sprites():
-            if collided is not None:
-                if collided(sprite, group_sprite):
-                    group_sprite.kill()
-                    append(group_sprite)
-            else:
-                if default_sprite_collide_func(group_sprite.rect):
-                    group_sprite.kill()
-                    append(group_sprite)
+            if collided(sprite, group_sprite):
+                group_sprite.kill()
+                append(group_sprite)
 
         return crashed
 
-    if collided is not None:
-        return [
-            group_sprite for group_sprite in group if collided(sprite, group_sprite)
-        ]
+    return [group_sprite for group_sprite in group if collided(sprite, group_sprite)]
 
-    return [
-        group_sprite
-        for group_sprite in group
-        if default_sprite_collide_func(group_sprite.rect)
-    ]
+
+# groupcollide puts a RectIndex in front of the rect and circle tests once
+# the groups could form this many pairs
+_BROAD_PHASE_MIN_PAIRS = 1024
+
+
+def _circle_bounds(spr):
+    """the rect around the circle collide_circle uses for the sprite"""
+    rect = spr.rect
+    try:
+        radius = spr.radius
+    except AttributeError:
+        radius = 0.5 * ((rect.width**2 + rect.height**2) ** 0.5)
+        spr.radius = radius
+    # grown by a pixel, so that circles which just touch still overlap
+    return (
+        rect.centerx - radius - 1,
+        rect.centery - radius - 1,
+        2 * radius + 2,
+        2 * radius + 2,
+    )
+
+
+def _groupcollide_indexed(groupa, groupb, dokilla, dokillb, collided):
+    """groupcollide testing only the sprites whose bounding rects overlap"""
+    sprites_b = groupb.sprites()
+    order = {spr: i for i, spr in enumerate(sprites_b)}
+    if collided is collide_circle:
+        bounds = [_circle_bounds(spr) for spr in sprites_b]
+    else:
+        bounds = [spr.rect for spr in sprites_b]
+    size = sum(abs(rect[2]) + abs(rect[3]) for rect in bounds) / len(bounds)
+    index = RectIndex(max(size, 16.0))
+    for spr, rect in zip(sprites_b, bounds):
+        index.insert(spr, rect)
+
+    crashed = {}
+    for group_a_sprite in groupa.sprites() if dokilla else groupa:
+        if collided is collide_circle:
+            candidates = index.colliderect(_circle_bounds(group_a_sprite))
+        else:
+            candidates = index.colliderect(group_a_sprite.rect)
+        if not candidates:
+            continue
+        candidates.sort(key=order.__getitem__)
+        if collided is collide_circle:
+            collision = [
+                spr for spr in candidates if collide_circle(group_a_sprite, spr)
+            ]
+        else:
+            collision = [
+                candidates[i]
+                for i in group_a_sprite.rect.collidelistall(
+                    [spr.rect for spr in candidates]
+                )
+            ]
+        if not collision:
+            continue
+
+        crashed[group_a_sprite] = collision
+        if dokillb:
+            for spr in collision:
+                index.remove(spr)
+                spr.kill()
+        if dokilla:
+            if group_a_sprite in index:
+                index.remove(group_a_sprite)
+            group_a_sprite.kill()
+    return crashed
 
 
 def groupcollide(groupa, groupb, dokilla, dokillb, collided=None):
@@ -1734,6 +1796,11 @@ def groupcollide(groupa, groupb, dokilla, dokillb, collided=None):
     that will be used to calculate the collision.
 
     """
+    if (
+        collided is None or collided is collide_rect or collided is collide_circle
+    ) and len(groupa) * len(groupb) >= _BROAD_PHASE_MIN_PAIRS:
+        return _groupcollide_indexed(groupa, groupb, dokilla, dokillb, collided)
+
     crashed = {}
     # pull the collision function in as a local variable outside
     # the loop as this makes the loop run faster
@@ -1,3 +1,5 @@
+import os
+import subprocess
 import sys
 import unittest
 
@@ -596,6 +598,25 @@ class BaseModuleTest(unittest.TestCase):
         self.assertGreaterEqual(passes, expected_min_passes)
         self.assertEqual(fails, expected_fails)
 
+    def test_init__subsystems(self):
+        """Ensures init() only inits the subsystems asked for"""
+        passes, fails = pygame.init(subsystems=("display",))
+
+        self.assertEqual((passes, fails), (1, 0))
+        self.assertTrue(pygame.display.get_init())
+        self.assertFalse(pygame.joystick.get_init())
+        self.assertFalse(pygame.mixer.get_init())
+
+        pygame.quit()
+        self.assertEqual(pygame.init(subsystems=()), (0, 0))
+        self.assertTrue(pygame.get_init())
+        self.assertFalse(pygame.display.get_init())
+
+        with self.assertRaises(ValueError):
+            pygame.init(subsystems=("display", "camera"))
+        with self.assertRaises(TypeError):
+            pygame.init(subsystems="display")
+
     def test_get_init(self):
         # Test if get_init() gets the init state.
         self.assertFalse(pygame.get_init())
@@ -613,6 +634,37 @@ class BaseModuleTest(unittest.TestCase):
 
         self.assertFalse(pygame.get_init())
 
+    def test_lazy_import(self):
+        """Ensures PYGAME_LAZY_IMPORT imports and inits modules on first use"""
+        code = "\n".join(
+            (
+                "import sys, pygame",
+                "assert 'pygame.mixer' not in sys.modules",
+                "assert 'pygame.display' not in sys.modules",
+                "pygame.init()",
+                "assert pygame.display.get_init()",
+                "surf = pygame.Surface((4, 4))",
+                "assert pygame.Surface is pygame.surface.Surface",
+                "assert 'mixer' in dir(pygame)",
+                "try:",
+                "    pygame.no_such_module",
+                "except AttributeError:",
+                "    pass",
+                "else:",
+                "    raise AssertionError('no AttributeError')",
+            )
+        )
+        env = dict(
+            os.environ,
+            PYGAME_LAZY_IMPORT="1",
+            PYGAME_HIDE_SUPPORT_PROMPT="1",
+            SDL_VIDEODRIVER="dummy",
+        )
+        result = subprocess.run(
+            [sys.executable, "-c", code], env=env, capture_output=True, text=True
+        )
+        self.assertEqual(result.returncode, 0, result.stderr)
+
 
 if __name__ == "__main__":
     unittest.main()
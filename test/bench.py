@@ -0,0 +1,372 @@
+"""Scene benchmarks of pygame, modelled on pygame.examples
+
+python -m pygame.tests.bench [--frames N] [--size WxH] [--seed N] [--json]
+                             [scene ...]
+
+Each scene draws a typical game frame headless, on the dummy video driver,
+as fast as it can: "sprites" (aliens), "text" (fonty), "transform" (chimp
+and scaletest), "draw" (stars) and "blend" (blend_fill and blit_blends).
+The scenes are seeded, so every run draws the same frames, which makes the
+results of two pygame builds on the same machine comparable.
+
+For every scene the frames per second are reported, with the average time a
+frame spent in each of pygame's hot paths, as counted by
+pygame.system.get_perf_counters(), and in the scene's own update code. With
+--json one line of JSON is printed per scene instead of a table.
+"""
+
+import argparse
+import json
+import math
+import os
+import random
+import sys
+
+if __package__ == "pygame.tests":
+    from pygame.tests.test_utils import example_path
+else:
+    from test.test_utils import example_path
+
+import pygame
+from pygame._debug import FrameProfiler
+
+# the frames every scene draws before it is timed
+WARMUP_FRAMES = 10
+
+
+class Scene:
+    """A benchmark scene
+
+    setup() loads what the scene needs, then update() and draw() are called
+    once per frame, update() being timed as its own section.
+    """
+
+    name = ""
+
+    def __init__(self, screen, rng):
+        self.screen = screen
+        self.rng = rng
+        self.width, self.height = screen.get_size()
+        self.setup()
+
+    def setup(self):
+        pass
+
+    def update(self):
+        pass
+
+    def draw(self):
+        raise NotImplementedError
+
+
+class Alien(pygame.sprite.Sprite):
+    def __init__(self, image, pos, speed):
+        super().__init__()
+        self.image = image
+        self.rect = image.get_rect(center=pos)
+        self.speed = list(speed)
+
+    def update(self, bounds):
+        self.rect.move_ip(self.speed)
+        if self.rect.left < bounds.left or self.rect.right > bounds.right:
+            self.speed[0] = -self.speed[0]
+        if self.rect.top < bounds.top or self.rect.bottom > bounds.bottom:
+            self.speed[1] = -self.speed[1]
+        self.rect.clamp_ip(bounds)
+
+
+class SpritesScene(Scene):
+    """Hundreds of alpha sprites over a tiled background, like aliens"""
+
+    name = "sprites"
+
+    def setup(self):
+        tile = pygame.image.load(example_path("data/background.gif")).convert()
+        self.background = pygame.Surface(self.screen.get_size()).convert()
+        for x in range(0, self.width, tile.get_width()):
+            for y in range(0, self.height, tile.get_height()):
+                self.background.blit(tile, (x, y))
+        images = [
+            pygame.image.load(example_path(f"data/alien{i}.png")).convert_alpha()
+            for i in (1, 2, 3)
+        ]
+        self.sprites = pygame.sprite.Group()
+        for _ in range(600):
+            pos = (self.rng.randrange(self.width), self.rng.randrange(self.height))
+            speed = (self.rng.randint(-4, 4) or 1, self.rng.randint(-4, 4) or 1)
+            self.sprites.add(Alien(self.rng.choice(images), pos, speed))
+
+    def update(self):
+        self.sprites.update(self.screen.get_rect())
+
+    def draw(self):
+        self.screen.blit(self.background, (0, 0))
+        self.sprites.draw(self.screen)
+
+
+class TextScene(Scene):
+    """Lines of changing text in a few sizes, like a HUD or a chat log"""
+
+    name = "text"
+
+    def setup(self):
+        self.fonts = [pygame.font.Font(None, size) for size in (16, 24, 36)]
+        self.frame = 0
+
+    def update(self):
+        self.frame += 1
+
+    def draw(self):
+        self.screen.fill((20, 20, 40))
+        y = 0
+        line = 0
+        while y < self.height:
+            font = self.fonts[line % len(self.fonts)]
+            text = f"line {line}: score {self.frame * 37 + line * 101} hp 93%"
+            color = (255, 255 - line * 5 % 200, 100)
+            surf = font.render(text, line % 4 != 3, color)
+            self.screen.blit(surf, (line * 13 % 40, y))
+            y += font.get_linesize()
+            line += 1
+
+
+class TransformScene(Scene):
+    """Rotated, zoomed, scaled and flipped images, like chimp and scaletest"""
+
+    name = "transform"
+
+    def setup(self):
+        self.image = pygame.image.load(example_path("data/chimp.png")).convert()
+        self.image.set_colorkey(self.image.get_at((0, 0)))
+        self.alpha = pygame.image.load(example_path("data/alien1.png"))
+        self.alpha = self.alpha.convert_alpha()
+        self.spots = [
+            (self.rng.randrange(self.width), self.rng.randrange(self.height))
+            for _ in range(40)
+        ]
+        self.angle = 0
+
+    def update(self):
+        self.angle = (self.angle + 3) % 360
+
+    def draw(self):
+        transform = pygame.transform
+        self.screen.fill((170, 238, 187))
+        for i, pos in enumerate(self.spots):
+            zoom = 0.5 + (i % 5) * 0.25
+            if i % 4 == 0:
+                surf = transform.rotozoom(self.alpha, self.angle + i * 9, zoom)
+            elif i % 4 == 1:
+                surf = transform.rotate(self.image, self.angle + i * 9)
+            elif i % 4 == 2:
+                size = self.alpha.get_size()
+                size = (int(size[0] * zoom * 2), int(size[1] * zoom * 2))
+                surf = transform.smoothscale(self.alpha, size)
+            else:
+                surf = transform.flip(transform.scale_by(self.image, zoom), 1, 0)
+            self.screen.blit(surf, surf.get_rect(center=pos))
+
+
+class DrawScene(Scene):
+    """A moving star field and shapes drawn with pygame.draw, like stars"""
+
+    name = "draw"
+
+    def setup(self):
+        self.center = (self.width // 2, self.height // 2)
+        self.stars = [self.new_star() for _ in range(1500)]
+        self.shapes = [
+            [self.rng.uniform(0, math.tau), self.rng.randint(10, 60)]
+            for _ in range(60)
+        ]
+
+    def new_star(self):
+        angle = self.rng.uniform(0, math.tau)
+        speed = self.rng.uniform(0.5, 4)
+        return [list(self.center), (math.cos(angle) * speed, math.sin(angle) * speed)]
+
+    def update(self):
+        bounds = self.screen.get_rect()
+        for i, (pos, vel) in enumerate(self.stars):
+            pos[0] += vel[0]
+            pos[1] += vel[1]
+            if not bounds.collidepoint(pos):
+                self.stars[i] = self.new_star()
+        for shape in self.shapes:
+            shape[0] += 0.02
+
+    def draw(self):
+        draw = pygame.draw
+        self.screen.fill((0, 0, 0))
+        for pos, vel in self.stars:
+            end = (pos[0] - vel[0] * 3, pos[1] - vel[1] * 3)
+            draw.line(self.screen, (255, 240, 200), pos, end)
+        for i, (angle, size) in enumerate(self.shapes):
+            x = self.center[0] + math.cos(angle + i) * self.width / 3
+            y = self.center[1] + math.sin(angle * 1.3 + i) * self.height / 3
+            color = (i * 40 % 256, 255 - i * 20 % 256, 128)
+            if i % 3 == 0:
+                draw.circle(self.screen, color, (x, y), size, 3)
+            elif i % 3 == 1:
+                points = []
+                for k in range(5):
+                    corner = angle + k * math.tau / 5
+                    offset = (math.cos(corner) * size, math.sin(corner) * size)
+                    points.append((x + offset[0], y + offset[1]))
+                draw.polygon(self.screen, color, points)
+            else:
+                draw.aacircle(self.screen, color, (x, y), size)
+
+
+class BlendScene(Scene):
+    """Blend mode fills and blits, like blend_fill and blit_blends"""
+
+    name = "blend"
+
+    def setup(self):
+        self.background = pygame.image.load(example_path("data/city.png"))
+        self.background = pygame.transform.scale(
+            self.background.convert(), self.screen.get_size()
+        )
+        self.light = pygame.Surface((160, 160), pygame.SRCALPHA)
+        for r in range(80, 0, -4):
+            value = 255 - r * 3
+            pygame.draw.circle(self.light, (value, value, value, 255), (80, 80), r)
+        self.modes = [
+            pygame.BLEND_RGB_ADD,
+            pygame.BLEND_RGB_SUB,
+            pygame.BLEND_RGB_MULT,
+            pygame.BLEND_RGBA_MULT,
+            pygame.BLEND_RGB_MAX,
+            pygame.BLEND_PREMULTIPLIED,
+            0,
+        ]
+        self.spots = [
+            [self.rng.randrange(self.width), self.rng.randrange(self.height)]
+            for _ in range(50)
+        ]
+        self.frame = 0
+
+    def update(self):
+        self.frame += 1
+        for i, spot in enumerate(self.spots):
+            spot[0] = (spot[0] + i % 7 - 3) % self.width
+            spot[1] = (spot[1] + i % 5 - 2) % self.height
+
+    def draw(self):
+        self.screen.blit(self.background, (0, 0))
+        shade = 40 + self.frame % 40
+        self.screen.fill((shade, shade, shade), special_flags=pygame.BLEND_RGB_SUB)
+        for i, spot in enumerate(self.spots):
+            mode = self.modes[i % len(self.modes)]
+            self.screen.blit(self.light, self.light.get_rect(center=spot), None, mode)
+        self.screen.fill(
+            (20, 10, 0), (0, 0, self.width, self.height // 4), pygame.BLEND_RGB_ADD
+        )
+
+
+SCENES = {
+    scene.name: scene
+    for scene in (SpritesScene, TextScene, TransformScene, DrawScene, BlendScene)
+}
+
+
+def run_scene(scene_type, size, frames, seed):
+    """Runs one scene and returns its results
+
+    Returns:
+        dict: the scene, the frames per second, and the average milliseconds
+        of a frame, both in total and in each part of the frame
+    """
+    screen = pygame.display.set_mode(size)
+    scene = scene_type(screen, random.Random(seed))
+    for _ in range(WARMUP_FRAMES):
+        scene.update()
+        scene.draw()
+        pygame.display.flip()
+
+    profiler = FrameProfiler(history=frames, sections=("update",))
+    for _ in range(frames):
+        pygame.event.pump()
+        with profiler.section("update"):
+            scene.update()
+        scene.draw()
+        pygame.display.flip()
+        profiler.tick()
+
+    average = profiler.get_average()
+    frame_ms = average.pop("frame")
+    average.pop("wait")
+    return {
+        "scene": scene.name,
+        "width": size[0],
+        "height": size[1],
+        "frames": frames,
+        "seed": seed,
+        "fps": 1000 / frame_ms if frame_ms else 0.0,
+        "ms_per_frame": frame_ms,
+        "ms": average,
+    }
+
+
+def print_table(results):
+    parts = list(results[0]["ms"])
+    print(f"pygame-ce {pygame.version.ver}, SDL {pygame.version.SDL}")
+    print(f"{'scene':<10}{'fps':>9}{'ms':>8}" + "".join(f"{p:>10}" for p in parts))
+    for result in results:
+        line = f"{result['scene']:<10}{result['fps']:9.1f}"
+        line += f"{result['ms_per_frame']:8.3f}"
+        line += "".join(f"{result['ms'][p]:10.3f}" for p in parts)
+        print(line)
+
+
+def main(args=None):
+    parser = argparse.ArgumentParser(
+        prog="python -m pygame.tests.bench",
+        description="Times headless scenes modelled on pygame.examples.",
+    )
+    parser.add_argument(
+        "scenes",
+        nargs="*",
+        help=f"the scenes to run, all of them if none are given: {', '.join(SCENES)}",
+    )
+    parser.add_argument("--frames", type=int, default=300)
+    parser.add_argument("--size", default="800x600", help="WIDTHxHEIGHT")
+    parser.add_argument("--seed", type=int, default=0)
+    parser.add_argument("--json", action="store_true", help="print JSON lines")
+    options = parser.parse_args(args)
+
+    for name in options.scenes:
+        if name not in SCENES:
+            parser.error(f"unknown scene {name!r}")
+    if options.frames < 1:
+        parser.error("--frames must be at least 1")
+    try:
+        size = tuple(int(v) for v in options.size.lower().split("x"))
+    except ValueError:
+        size = ()
+    if len(size) != 2 or min(size) < 1:
+        parser.error("--size must be like 800x600")
+
+    # the scenes must run the same everywhere, whatever the display
+    os.environ["SDL_VIDEODRIVER"] = "dummy"
+    pygame.display.init()
+    pygame.font.init()
+    try:
+        results = []
+        for name in options.scenes or SCENES:
+            result = run_scene(SCENES[name], size, options.frames, options.seed)
+            if options.json:
+                result["version"] = pygame.version.ver
+                print(json.dumps(result))
+            results.append(result)
+    finally:
+        pygame.quit()
+
+    if not options.json:
+        print_table(results)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -198,6 +198,39 @@ class BlitTest(unittest.TestCase):
         if PRINT_TIMING:
             print(f"Surface.fblits generator: {t1 - t0}")
 
+    def test_fblits_alpha_tint(self):
+        """Items can carry an alpha and a tint that modulate their source"""
+        dst = pygame.Surface((20, 10), SRCALPHA, 32)
+        src = pygame.Surface((10, 10), SRCALPHA, 32)
+        src.fill((200, 100, 50, 255))
+        opaque = pygame.Surface((10, 10), 0, 32)
+        opaque.fill((200, 100, 50))
+
+        def check(pos, expected):
+            for got, want in zip(dst.get_at(pos), expected):
+                self.assertAlmostEqual(got, want, delta=2)
+
+        dst.fill((0, 0, 0, 255))
+        dst.fblits([(src, (0, 0), 128, (255, 128, 0)), (opaque, (10, 0), 128)])
+        check((5, 5), (100, 25, 0, 255))
+        check((15, 5), (100, 50, 25, 255))
+
+        # None leaves the source as it is, and so does every modulated blit
+        dst.fblits([(src, (0, 0), None, None), (opaque, (10, 0), None)])
+        check((5, 5), (200, 100, 50, 255))
+        check((15, 5), (200, 100, 50, 255))
+        self.assertEqual(opaque.get_alpha(), None)
+        self.assertEqual(src.get_alpha(), 255)
+
+        dst.fill((0, 0, 0, 255))
+        dst.fblits([(src, (0, 0), 255, "white"), (opaque, (10, 0), 0, "red")])
+        check((5, 5), (200, 100, 50, 255))
+        check((15, 5), (0, 0, 0, 255))
+
+        self.assertRaises(TypeError, dst.fblits, [(src, (0, 0), 1.5)])
+        self.assertRaises(ValueError, dst.fblits, [(src, (0, 0), 255, None, 0)])
+        self.assertRaises(ValueError, dst.fblits, [(src, (0, 0), 255, "nocolor")])
+
     def test_fblits_not_sequence(self):
         dst = pygame.Surface((100, 10), SRCALPHA, 32)
         self.assertRaises(ValueError, dst.fblits, None)
@@ -228,6 +261,348 @@ class BlitTest(unittest.TestCase):
 
         self.assertRaises(exc_type, dst.fblits, generate_exception())
 
+    def test_fblits_blit_batch(self):
+        NUM_SURFS = 64
+        blit_list = self.make_blit_list(NUM_SURFS)
+        batch = pygame.BlitBatch(blit_list)
+
+        self.assertEqual(len(batch), NUM_SURFS)
+        self.assertIs(batch[3][0], blit_list[3][0])
+        self.assertEqual(batch[3][1], blit_list[3][1])
+
+        dst1 = pygame.Surface((NUM_SURFS * 10, 10), SRCALPHA, 32)
+        dst2 = pygame.Surface((NUM_SURFS * 10, 10), SRCALPHA, 32)
+        for flags in (0, BLEND_ADD, BLEND_RGBA_MULT):
+            dst1.fill((230, 100, 30, 200))
+            dst2.fill((230, 100, 30, 200))
+            dst1.fblits(blit_list, flags)
+            self.assertIsNone(dst2.fblits(batch, flags))
+            self.assertEqual(dst1.get_at((155, 5)), dst2.get_at((155, 5)))
+            self.assertEqual(
+                pygame.image.tobytes(dst1, "RGBA"), pygame.image.tobytes(dst2, "RGBA")
+            )
+
+    def test_blit_batch_modify(self):
+        red = pygame.Surface((2, 2))
+        red.fill((255, 0, 0))
+        green = pygame.Surface((2, 2))
+        green.fill((0, 255, 0))
+
+        batch = pygame.BlitBatch()
+        self.assertEqual(len(batch), 0)
+        batch.append(red, (0, 0))
+        batch.append(red, pygame.Rect(4, 0, 1, 1))
+        batch.extend([(green, (0, 4))])
+        self.assertEqual(len(batch), 3)
+        self.assertEqual(batch[1], (red, (4, 0)))
+
+        batch[0] = (green, [2, 2])
+        self.assertEqual(batch[0], (green, (2, 2)))
+
+        dst = pygame.Surface((8, 8))
+        dst.fblits(batch)
+        self.assertEqual(dst.get_at((2, 2)), (0, 255, 0, 255))
+        self.assertEqual(dst.get_at((4, 0)), (255, 0, 0, 255))
+        self.assertEqual(dst.get_at((0, 4)), (0, 255, 0, 255))
+        self.assertEqual(dst.get_at((0, 0)), (0, 0, 0, 255))
+
+        self.assertRaises(IndexError, lambda: batch[3])
+        self.assertRaises(TypeError, batch.append, None, (0, 0))
+        self.assertRaises(TypeError, batch.append, red, None)
+        self.assertRaises(ValueError, batch.extend, [red])
+
+        batch.clear()
+        self.assertEqual(len(batch), 0)
+        dst.fill((0, 0, 0))
+        dst.fblits(batch)
+        self.assertEqual(dst.get_at((2, 2)), (0, 0, 0, 255))
+
+    def test_blit_batch_buffer(self):
+        surf = pygame.Surface((1, 1))
+        surf.fill((255, 255, 255))
+        batch = pygame.BlitBatch([(surf, (0, 0)), (surf, (1, 1))])
+
+        view = memoryview(batch)
+        self.assertEqual(view.shape, (2, 2))
+        self.assertEqual(view.format, "i")
+        self.assertEqual(view.tolist(), [[0, 0], [1, 1]])
+
+        view[1, 0] = 3
+        self.assertEqual(batch[1], (surf, (3, 1)))
+
+        # the batch can't grow while the buffer is exported
+        self.assertRaises(BufferError, batch.append, surf, (0, 0))
+        view.release()
+        batch.append(surf, (0, 0))
+        self.assertEqual(len(batch), 3)
+
+        dst = pygame.Surface((4, 4))
+        dst.fblits(batch)
+        self.assertEqual(dst.get_at((3, 1)), (255, 255, 255, 255))
+        self.assertEqual(dst.get_at((1, 1)), (0, 0, 0, 255))
+
+    def test_set_blit_threads(self):
+        """Checks threaded blits give the same result as single threaded"""
+        old_threads = pygame.surface.get_blit_threads()
+        self.assertRaises(ValueError, pygame.surface.set_blit_threads, -1)
+        self.assertRaises(TypeError, pygame.surface.set_blit_threads, "2")
+
+        def make_surface(size, flags, depth, seed):
+            surf = pygame.Surface(size, flags, depth)
+            for y in range(size[1]):
+                color = (
+                    (y * 7 + seed) % 256,
+                    (y * 13 + seed * 3) % 256,
+                    (y * 29 + seed * 5) % 256,
+                    (y * 3 + seed * 7) % 256,
+                )
+                surf.fill(color, (0, y, size[0], 1))
+            return surf
+
+        blend_flags = [
+            0,
+            BLEND_ADD,
+            BLEND_SUB,
+            BLEND_MULT,
+            BLEND_MIN,
+            BLEND_MAX,
+            BLEND_RGBA_ADD,
+            BLEND_RGBA_SUB,
+            BLEND_RGBA_MULT,
+            BLEND_RGBA_MIN,
+            BLEND_RGBA_MAX,
+            BLEND_PREMULTIPLIED,
+        ]
+        formats = [(SRCALPHA, 32), (0, 32), (0, 24), (0, 16)]
+
+        try:
+            for src_flags, src_depth in formats:
+                src = make_surface((300, 301), src_flags, src_depth, 1)
+                for dst_flags, dst_depth in formats:
+                    dst = make_surface((320, 340), dst_flags, dst_depth, 2)
+                    for flag in blend_flags:
+                        results = []
+                        for threads in (1, 4):
+                            pygame.surface.set_blit_threads(threads)
+                            self.assertEqual(
+                                pygame.surface.get_blit_threads(), threads
+                            )
+                            target = dst.copy()
+                            target.blit(src, (7, 11), special_flags=flag)
+                            results.append(pygame.image.tobytes(target, "RGBA"))
+                        self.assertEqual(
+                            results[0],
+                            results[1],
+                            f"{src_flags, src_depth} -> "
+                            f"{dst_flags, dst_depth}, flag {flag}",
+                        )
+
+            # overlapping self blits are never split between threads
+            pygame.surface.set_blit_threads(4)
+            surf = make_surface((300, 300), SRCALPHA, 32, 3)
+            expected = make_surface((300, 300), SRCALPHA, 32, 3)
+            pygame.surface.set_blit_threads(1)
+            expected.blit(expected, (5, 9), special_flags=BLEND_RGBA_ADD)
+            pygame.surface.set_blit_threads(4)
+            surf.blit(surf, (5, 9), special_flags=BLEND_RGBA_ADD)
+            self.assertEqual(
+                pygame.image.tobytes(surf, "RGBA"),
+                pygame.image.tobytes(expected, "RGBA"),
+            )
+
+            pygame.surface.set_blit_threads(0)
+            self.assertGreaterEqual(pygame.surface.get_blit_threads(), 1)
+        finally:
+            pygame.surface.set_blit_threads(old_threads)
+
+    def test_parallel_blits(self):
+        """Checks parallel blits and fblits draw like serial ones"""
+        old_threads = pygame.surface.get_blit_threads()
+        sprites = []
+        for i in range(12):
+            sprite = pygame.Surface((20 + i * 7, 15 + i * 5), SRCALPHA, 32)
+            sprite.fill((i * 20, 255 - i * 20, i * 9, 40 + i * 17))
+            sprites.append(sprite)
+        keyed = pygame.Surface((30, 30), 0, 32)
+        keyed.fill((200, 10, 10))
+        keyed.fill((0, 0, 0), (10, 10, 10, 10))
+        keyed.set_colorkey((0, 0, 0))
+        paletted = pygame.Surface((25, 25), 0, 8)
+        paletted.fill((10, 200, 10))
+
+        def draw(parallel, special_flags=0):
+            dst = pygame.Surface((400, 300), SRCALPHA, 32)
+            dst.fill((30, 60, 90, 255))
+            items = [
+                (sprites[i % len(sprites)], ((i * 37) % 380, (i * 23) % 280))
+                for i in range(150)
+            ]
+            items[40:40] = [(keyed, (50, 50)), (paletted, (60, 60))]
+            items.append((dst.subsurface((0, 0, 40, 40)), (20, 20)))
+            rects = dst.blits(
+                [(s, p, None, special_flags) for s, p in items], parallel=parallel
+            )
+            dst.fblits(iter(items), special_flags, parallel)
+            return rects, pygame.image.tobytes(dst, "RGBA")
+
+        try:
+            pygame.surface.set_blit_threads(4)
+            for flag in (0, BLEND_ADD, BLEND_RGBA_MULT):
+                self.assertEqual(draw(True, flag), draw(False, flag), flag)
+            pygame.surface.set_blit_threads(1)
+            self.assertEqual(draw(True), draw(False))
+        finally:
+            pygame.surface.set_blit_threads(old_threads)
+
+        self.assertRaises(ValueError, sprites[0].fblits, [], 0, False, 1)
+
+    def test_blit_trace(self):
+        """Checks the blit kernels get recorded while tracing"""
+        pygame.surface.set_blit_trace(True)
+        try:
+            src = pygame.Surface((300, 300), SRCALPHA, 32)
+            dst = pygame.Surface((300, 300), 0, 16)
+            with self.assertWarns(RuntimeWarning):
+                dst.blit(src, (0, 0))
+            dst.blit(src, (0, 0))
+
+            small = pygame.Surface((10, 20), 0, 32)
+            target = pygame.Surface((10, 20), 0, 32)
+            target.blit(small, (0, 0), special_flags=BLEND_ADD)
+            target.blit(small, (5, 0), special_flags=BLEND_ADD)
+        finally:
+            pygame.surface.set_blit_trace(False)
+
+        trace = pygame.surface.get_blit_trace()
+        self.assertEqual(len(trace), 2)
+        self.assertEqual(trace[0]["src_format"], "ARGB8888")
+        self.assertEqual(trace[0]["dst_format"], "RGB565")
+        self.assertEqual(trace[0]["special_flags"], 0)
+        self.assertEqual(trace[0]["kernel"], "alphablit_alpha")
+        self.assertEqual(trace[0]["calls"], 2)
+        self.assertEqual(trace[0]["pixels"], 2 * 300 * 300)
+        self.assertGreaterEqual(trace[0]["ns"], 0)
+        self.assertEqual(trace[1]["special_flags"], BLEND_ADD)
+        self.assertIn("blend", trace[1]["kernel"])
+        self.assertEqual(trace[1]["calls"], 2)
+        self.assertEqual(trace[1]["pixels"], 10 * 20 + 5 * 20)
+
+        # the records survive disabling, and are cleared by enabling
+        dst.blit(src, (0, 0))
+        self.assertEqual(pygame.surface.get_blit_trace(), trace)
+        pygame.surface.set_blit_trace(True)
+        pygame.surface.set_blit_trace(False)
+        self.assertEqual(pygame.surface.get_blit_trace(), [])
+
+    def test_blit_opaque_copy(self):
+        """Checks opaque blits of the same format copy the pixels as they are"""
+        src = pygame.Surface((40, 30), 0, 32)
+        dst = pygame.Surface((50, 40), 0, 32)
+        src.get_buffer().write(bytes(i % 251 for i in range(40 * 30 * 4)))
+
+        pygame.surface.set_blit_trace(True)
+        try:
+            dst.blit(src, (5, 6))
+        finally:
+            pygame.surface.set_blit_trace(False)
+
+        trace = pygame.surface.get_blit_trace()
+        self.assertEqual(trace[0]["kernel"], "alphablit_copy")
+        # the unused byte of the pixels is copied too, like SDL does
+        src_raw = src.get_buffer().raw
+        dst_raw = dst.get_buffer().raw
+        for y in range(30):
+            row = src_raw[y * src.get_pitch() :][: 40 * 4]
+            start = (y + 6) * dst.get_pitch() + 5 * 4
+            self.assertEqual(dst_raw[start : start + 40 * 4], row)
+
+    def test_overlapping_self_blit_alpha_colorkey(self):
+        """Checks overlapping self blits with surface alpha and/or colorkey
+
+        These go through pygame's own (possibly SIMD) blitters, so check them
+        against the blending equation used by the scalar code.
+        """
+        key = (10, 20, 30)
+
+        def blend(s, d, alpha):
+            return [(((sc - dc) * alpha + sc) >> 8) + dc for sc, dc in zip(s, d)]
+
+        for width in (2, 3, 4, 7, 8, 9, 16, 17, 33):
+            for alpha, colorkey in ((100, None), (255, key), (100, key)):
+                surf = pygame.Surface((width + 1, 6), 0, 32)
+                for y in range(6):
+                    for x in range(width + 1):
+                        if (x + y) % 3 == 0:
+                            surf.set_at((x, y), key)
+                        else:
+                            surf.set_at(
+                                (x, y), ((x * 37) % 256, (y * 61) % 256, x * y)
+                            )
+                surf.set_alpha(alpha)
+                surf.set_colorkey(colorkey)
+                before = [
+                    [tuple(surf.get_at((x, y)))[:3] for x in range(width + 1)]
+                    for y in range(6)
+                ]
+
+                surf.blit(surf, (0, 0), (1, 2, width, 4))
+
+                for y in range(4):
+                    for x in range(width):
+                        s = before[y + 2][x + 1]
+                        d = before[y][x]
+                        a = 0 if colorkey is not None and s == key else alpha
+                        self.assertEqual(
+                            tuple(surf.get_at((x, y)))[:3],
+                            tuple(blend(s, d, a)),
+                            f"width {width}, alpha {alpha}, colorkey "
+                            f"{colorkey} at {x, y}",
+                        )
+
+    def test_blit_colorkey_same_format(self):
+        """Checks colorkey blits of the same 32 bit format match SDL
+
+        These use pygame's (possibly SIMD) colorkey blitters, which copy the
+        pixels as SDL does. Surface alpha blits are left to SDL.
+        """
+        key = (10, 20, 30)
+
+        for width in (3, 8, 17, 33):
+            src = pygame.Surface((width, 4), 0, 32)
+            dst = pygame.Surface((width, 4), 0, 32)
+            for y in range(4):
+                for x in range(width):
+                    if (x + y) % 3 == 0:
+                        src.set_at((x, y), key)
+                    else:
+                        src.set_at((x, y), ((x * 37) % 256, y * 61, x * y))
+                    dst.set_at((x, y), (y * 50, (x * 11) % 256, 200))
+            src.set_colorkey(key)
+            expected = dst.copy()
+            expected.blit(src, (0, 0), special_flags=pygame.BLEND_ALPHA_SDL2)
+
+            pygame.surface.set_blit_trace(True)
+            try:
+                dst.blit(src, (0, 0))
+            finally:
+                pygame.surface.set_blit_trace(False)
+
+            trace = pygame.surface.get_blit_trace()
+            self.assertEqual(len(trace), 1)
+            self.assertTrue(trace[0]["kernel"].startswith("alphablit_colorkey"))
+            self.assertEqual(
+                dst.get_buffer().raw, expected.get_buffer().raw, f"width {width}"
+            )
+
+            src.set_alpha(100)
+            pygame.surface.set_blit_trace(True)
+            try:
+                dst.blit(src, (0, 0))
+            finally:
+                pygame.surface.set_blit_trace(False)
+            trace = pygame.surface.get_blit_trace()
+            self.assertEqual(trace[0]["kernel"], "SDL_BlitSurface")
+
     def test_blits_not_sequence(self):
         dst = pygame.Surface((100, 10), SRCALPHA, 32)
         self.assertRaises(ValueError, dst.blits, None)
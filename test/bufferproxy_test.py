@@ -1,3 +1,4 @@
+import array
 import re
 import weakref
 import gc
@@ -499,5 +500,84 @@ class BufferProxyLegacyTest(unittest.TestCase):
             gc.collect()
 
 
+class BufferArrayTest(unittest.TestCase):
+    def test_index_and_slice(self):
+        data = bytearray(range(24))
+        a = pygame.BufferArray(memoryview(data).cast("B", (4, 6)))
+        self.assertEqual(a.shape, (4, 6))
+        self.assertEqual(a.strides, (6, 1))
+        self.assertEqual((a.ndim, a.itemsize, a.format), (2, 1, "B"))
+        self.assertFalse(a.readonly)
+        self.assertEqual(len(a), 4)
+        self.assertEqual(a[1, 2], 8)
+        self.assertEqual(a[-1][-1], 23)
+        self.assertRaises(IndexError, a.__getitem__, 4)
+        self.assertRaises(IndexError, a.__getitem__, (0, 0, 0))
+
+        view = a[1:3, ::2]
+        self.assertIsInstance(view, pygame.BufferArray)
+        self.assertEqual(view.shape, (2, 3))
+        self.assertEqual(view.strides, (6, 2))
+        self.assertEqual(memoryview(view).tolist(), [[6, 8, 10], [12, 14, 16]])
+
+        view[:] = 0
+        a[:, 5] = 1
+        self.assertEqual(data[6:12], bytearray([0, 7, 0, 9, 0, 1]))
+        self.assertEqual(data[5], 1)
+
+    def test_arithmetic(self):
+        data = bytearray([10, 100, 200, 250])
+        a = pygame.BufferArray(data)
+        a += 10
+        self.assertEqual(list(data), [20, 110, 210, 255])
+        a -= bytes([30, 10, 10, 5])
+        self.assertEqual(list(data), [0, 100, 200, 250])
+
+        doubled = a * 2
+        self.assertEqual(bytes(doubled), bytes([0, 200, 255, 255]))
+        self.assertEqual(list(data), [0, 100, 200, 250])
+        self.assertEqual(bytes(2 * a), bytes(doubled))
+        self.assertEqual(bytes(a & 0x0F), bytes([0, 4, 8, 10]))
+        self.assertRaises(TypeError, lambda: 1 - a)
+        self.assertRaises(ValueError, a.__iadd__, b"12")
+
+        samples = array.array("h", [100, -100, 30000, -30000])
+        b = pygame.BufferArray(samples)
+        b *= 2
+        self.assertEqual(samples.tolist(), [200, -200, 32767, -32768])
+        b *= 0.5
+        self.assertEqual(samples.tolist(), [100, -100, 16383, -16384])
+
+        floats = array.array("d", [1.0, 2.0])
+        c = pygame.BufferArray(floats)
+        c *= 2.5
+        self.assertEqual(floats.tolist(), [2.5, 5.0])
+        self.assertRaises(TypeError, c.__ior__, 1)
+
+    def test_readonly(self):
+        a = pygame.BufferArray(b"abc")
+        self.assertTrue(a.readonly)
+        self.assertRaises(TypeError, a.__iadd__, 1)
+        self.assertRaises(TypeError, a.fill, 1)
+        self.assertEqual(bytes(a + 1), b"bcd")
+
+    def test_surface_view(self):
+        surf = pygame.Surface((4, 3), depth=32)
+        surf.fill((10, 20, 30))
+        pixels = pygame.BufferArray(surf.get_view("3"))
+        self.assertEqual(pixels.shape, (4, 3, 3))
+        pixels[1:3, :, 0] += 250
+        pixels[:, 2] = 0
+        del pixels
+        gc.collect()
+        self.assertFalse(surf.get_locked())
+        self.assertEqual(surf.get_at((0, 0)), (10, 20, 30, 255))
+        self.assertEqual(surf.get_at((2, 1)), (255, 20, 30, 255))
+        self.assertEqual(surf.get_at((2, 2)), (0, 0, 0, 255))
+
+    def test_unsupported_format(self):
+        self.assertRaises(ValueError, pygame.BufferArray, memoryview(b"ab").cast("c"))
+
+
 if __name__ == "__main__":
     unittest.main()
@@ -1,5 +1,66 @@
 import unittest
 
+import pygame
+import pygame.camera
+
+
+def _hsv(r, g, b):
+    """The integer formulas of the camera module's HSV conversion"""
+
+    def div(a, b):
+        return abs(a) // b * (1 if a >= 0 else -1)
+
+    v = max(r, g, b)
+    delta = v - min(r, g, b)
+    if not delta:
+        return 0, 0, v
+    if r == v:
+        h = div(43 * (g - b), delta)
+    elif g == v:
+        h = 85 + div(43 * (b - r), delta)
+    else:
+        h = 170 + div(43 * (r - g), delta)
+    return h % 256, 255 * delta // v, v
+
 
 class CameraModuleTest(unittest.TestCase):
-    pass
+    def setUp(self):
+        try:
+            self.threads = pygame.camera.get_conversion_threads()
+        except RuntimeError:
+            self.skipTest("pygame is not built with colorspace support")
+
+    def tearDown(self):
+        pygame.camera.set_conversion_threads(self.threads)
+
+    def test_colorspace_hsv_threads(self):
+        """colorspace gives the same pixels with and without threads"""
+        w, h = 300, 300
+        surf = pygame.Surface((w, h), depth=32)
+        for y in range(h):
+            for x in range(w):
+                surf.set_at((x, y), ((x * 7) % 256, (y * 5) % 256, (x ^ y) % 256))
+
+        pygame.camera.set_conversion_threads(1)
+        self.assertEqual(pygame.camera.get_conversion_threads(), 1)
+        single = pygame.camera.colorspace(surf, "HSV")
+        pygame.camera.set_conversion_threads(4)
+        self.assertEqual(pygame.camera.get_conversion_threads(), 4)
+        threaded = pygame.camera.colorspace(surf, "HSV")
+
+        self.assertEqual(
+            pygame.image.tobytes(single, "RGB"), pygame.image.tobytes(threaded, "RGB")
+        )
+        for pos in ((0, 0), (1, 2), (37, 250), (299, 299), (150, 17)):
+            self.assertEqual(
+                tuple(single.get_at(pos))[:3], _hsv(*surf.get_at(pos)[:3])
+            )
+
+    def test_set_conversion_threads(self):
+        pygame.camera.set_conversion_threads(0)
+        self.assertGreaterEqual(pygame.camera.get_conversion_threads(), 1)
+        self.assertRaises(ValueError, pygame.camera.set_conversion_threads, -1)
+
+
+if __name__ == "__main__":
+    unittest.main()
@@ -1282,6 +1282,48 @@ class ColorTypeTest(unittest.TestCase):
         self.assertRaises(ValueError, lambda: color0.lerp((0, 0, 0, 256), 0.5))
         self.assertRaises(TypeError, lambda: color0.lerp(0.2, 0.5))
 
+    def test_lerp_many(self):
+        Color = pygame.color.Color
+
+        colors = [Color(0, 0, 0, 0), (128, 128, 128, 128), "red", 0x11223344]
+        target = Color(100, 150, 200, 250)
+        for amount in (0, 0.01, 0.5, 0.99, 1):
+            result = Color.lerp_many(colors, target, amount)
+            self.assertIsInstance(result, list)
+            self.assertEqual(
+                result, [Color(c).lerp(target, amount) for c in colors]
+            )
+
+        class SubColor(Color):
+            pass
+
+        result = SubColor.lerp_many(colors, "blue", 0.5)
+        self.assertTrue(all(type(c) is SubColor for c in result))
+        self.assertEqual(Color.lerp_many([], target, 0.5), [])
+        self.assertEqual(
+            Color.lerp_many(colors=colors[:1], color=target, amount=1), [target]
+        )
+
+        self.assertRaises(ValueError, Color.lerp_many, colors, target, 1.5)
+        self.assertRaises(ValueError, Color.lerp_many, [(256, 0, 0)], target, 0)
+        self.assertRaises(TypeError, Color.lerp_many, 5, target, 0.5)
+        self.assertRaises(TypeError, Color.lerp_many, [0.2], target, 0.5)
+
+    def test_color_name_cache(self):
+        """Ensures changes to THECOLORS are seen by already parsed names."""
+        THECOLORS = pygame.color.THECOLORS
+        self.assertEqual(pygame.Color("Orange Red"), THECOLORS["orangered"])
+
+        original = THECOLORS["orangered"]
+        try:
+            THECOLORS["orangered"] = (1, 2, 3, 4)
+            self.assertEqual(pygame.Color("Orange Red"), (1, 2, 3, 4))
+            del THECOLORS["orangered"]
+            self.assertRaises(ValueError, pygame.Color, "Orange Red")
+        finally:
+            THECOLORS["orangered"] = original
+        self.assertEqual(pygame.Color("Orange Red"), original)
+
     def test_swizzle_get(self):
         c = pygame.color.Color(10, 20, 30, 40)
 
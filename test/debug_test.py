@@ -21,3 +21,34 @@ class DebugTest(unittest.TestCase):
         self.assert_stdout(text + "\n")
 
         os.remove("temp_file.txt")
+
+    def test_frame_profiler(self):
+        from pygame._debug import FrameProfiler
+
+        profiler = FrameProfiler(history=3)
+        surf = pygame.Surface((10, 10))
+        self.assertEqual(profiler.get_frames(), [])
+        self.assertEqual(profiler.draw(surf), pygame.Rect(0, 0, 120, 40))
+
+        for _ in range(5):
+            with profiler.section("draw"):
+                surf.fill("red")
+            profiler.tick()
+
+        frames = profiler.get_frames()
+        self.assertEqual(len(frames), 3)
+        for frame in frames:
+            self.assertEqual(set(frame), set(profiler.fields))
+            self.assertGreaterEqual(frame["frame"], frame["wait"])
+            self.assertGreaterEqual(frame["frame"], frame["draw"])
+            self.assertEqual(frame["update"], 0.0)
+        self.assertEqual(set(profiler.get_average()), set(profiler.fields))
+
+        with self.assertRaises(KeyError):
+            with profiler.section("physics"):
+                pass
+
+        screen = pygame.Surface((200, 100))
+        self.assertEqual(
+            profiler.draw(screen, (10, 10), (50, 20)), pygame.Rect(10, 10, 50, 20)
+        )
@@ -597,6 +597,55 @@ class DisplayModuleTest(unittest.TestCase):
         screen = pygame.display.set_mode((200, 200))
         self.assertEqual(screen.get_size(), (200, 200))
 
+    def test_set_mode_pipelined(self):
+        """Ensures PIPELINED displays keep what was drawn on them."""
+        screen = pygame.display.set_mode((100, 100), pygame.SCALED | pygame.PIPELINED)
+        self.assertEqual(screen.get_size(), (100, 100))
+
+        for i in range(3):
+            screen.fill((i, 20, 30))
+            pygame.display.flip()
+            pygame.display.update(pygame.Rect(10, 10, 20, 20))
+            pygame.display.update([])
+            self.assertEqual(screen.get_at((50, 50)), (i, 20, 30))
+
+        screen = pygame.display.set_mode((50, 50))
+        self.assertEqual(screen.get_size(), (50, 50))
+
+    def test_set_mode_streamed(self):
+        """Ensures STREAMED displays keep what was drawn on them."""
+        screen = pygame.display.set_mode((100, 100), pygame.SCALED | pygame.STREAMED)
+        self.assertEqual(screen.get_size(), (100, 100))
+
+        for i in range(3):
+            screen.set_at((99, 99), (0, 0, 255))
+            screen.fill((i, 20, 30), (0, 0, 60, 60))
+            pygame.display.flip()
+            pygame.display.update(pygame.Rect(10, 10, 20, 20))
+            self.assertEqual(screen.get_at((50, 50)), (i, 20, 30))
+            self.assertEqual(screen.get_at((99, 99)), (0, 0, 255))
+
+        screen = pygame.display.set_mode((50, 50))
+        self.assertEqual(screen.get_size(), (50, 50))
+        self.assertEqual(screen.get_at((0, 0)), (0, 0, 0))
+
+    def test_set_mode_accelerated_blits(self):
+        """Ensures ACCELERATED surfaces drawn by the renderer of a SCALED
+        display are read back into its pixels."""
+        screen = pygame.display.set_mode((100, 100), pygame.SCALED)
+        image = pygame.Surface((20, 20), pygame.ACCELERATED)
+        self.assertTrue(image.get_flags() & pygame.ACCELERATED)
+
+        for i in range(3):
+            image.fill((10 * i, 200, 30))
+            screen.fill((i, 20, 30))
+            screen.blit(image, (10 * i, 10))
+            screen.fill((0, 0, 255), (90, 90, 20, 20))
+            pygame.display.flip()
+            self.assertEqual(screen.get_at((10 * i + 5, 15)), (10 * i, 200, 30))
+            self.assertEqual(screen.get_at((50, 50)), (i, 20, 30))
+            self.assertEqual(screen.get_at((95, 95)), (0, 0, 255))
+
     def test_screensaver_support(self):
         pygame.display.set_allow_screensaver(True)
         self.assertTrue(pygame.display.get_allow_screensaver())
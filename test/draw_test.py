@@ -1,3 +1,4 @@
+import array
 import math
 import unittest
 import sys
@@ -168,12 +169,17 @@ class DrawTestCase(unittest.TestCase):
     draw_polygon = staticmethod(draw.polygon)
     draw_circle = staticmethod(draw.circle)
     draw_aacircle = staticmethod(draw.aacircle)
+    circle_stamp = staticmethod(draw.circle_stamp)
     draw_ellipse = staticmethod(draw.ellipse)
     draw_arc = staticmethod(draw.arc)
     draw_line = staticmethod(draw.line)
     draw_lines = staticmethod(draw.lines)
     draw_aaline = staticmethod(draw.aaline)
     draw_aalines = staticmethod(draw.aalines)
+    draw_aapolygon = staticmethod(draw.aapolygon)
+    draw_rects = staticmethod(draw.rects)
+    draw_circles = staticmethod(draw.circles)
+    draw_lines_batch = staticmethod(draw.lines_batch)
 
 
 ### Ellipse Testing ###########################################################
@@ -2903,6 +2909,28 @@ class DrawAALineTest(AALineMixin, DrawTestCase):
     class to add any draw.aaline specific tests to.
     """
 
+    def test_aaline__width(self):
+        """Ensures a wide aaline is drawn as a rectangle with antialiased
+        edges.
+        """
+        surface = pygame.Surface((40, 20))
+        rect = self.draw_aaline(surface, (255, 0, 0), (10, 10), (30, 10), width=4)
+
+        self.assertEqual(rect, pygame.Rect(10, 8, 21, 5))
+        for x in range(11, 30):
+            for y in range(9, 12):
+                self.assertEqual(surface.get_at((x, y)), (255, 0, 0), (x, y))
+            for y in (8, 12):
+                self.assertTrue(120 <= surface.get_at((x, y)).r <= 135, (x, y))
+
+    def test_aaline__width_less_than_1(self):
+        """Ensures nothing is drawn for widths < 1."""
+        surface = pygame.Surface((10, 10))
+        rect = self.draw_aaline(surface, RED, (2.5, 3), (8, 8), width=0)
+
+        self.assertEqual(rect, pygame.Rect(2, 3, 0, 0))
+        self.assertEqual(surface.get_bounding_rect(), pygame.Rect(0, 0, 0, 0))
+
     def test_aaline_endianness(self):
         """test color component order"""
         for depth in (24, 32):
@@ -3646,6 +3674,94 @@ class DrawAALinesTest(AALinesMixin, DrawTestCase):
     class to add any draw.aalines specific tests to.
     """
 
+    @staticmethod
+    def _coverage(surface):
+        """Returns the summed red channel of a surface, in pixels."""
+        width, height = surface.get_size()
+        total = sum(
+            surface.get_at((x, y)).r for x in range(width) for y in range(height)
+        )
+        return total / 255
+
+    def test_aalines__width(self):
+        """Ensures wide aalines cover their area, with half covered pixels on
+        the edges.
+        """
+        surface = pygame.Surface((60, 40))
+        rect = self.draw_aalines(
+            surface, (255, 0, 0), False, [(10, 20), (30, 20), (50, 20)], width=6
+        )
+
+        self.assertEqual(rect, pygame.Rect(10, 17, 41, 7))
+        for x in range(11, 50):
+            for y in range(18, 23):
+                self.assertEqual(surface.get_at((x, y)), (255, 0, 0), (x, y))
+            for y in (17, 23):
+                self.assertTrue(120 <= surface.get_at((x, y)).r <= 135, (x, y))
+        self.assertAlmostEqual(self._coverage(surface), 40 * 6, delta=1)
+
+    def test_aalines__width_joints(self):
+        """Ensures each joint adds the expected area to a right angle."""
+        points = [(10, 10), (50, 10), (50, 50)]
+        # The segments overlap in a 3 x 3 square, the joints fill the outer
+        # corner.
+        corners = {"miter": 9, "round": 9 * math.pi / 4, "bevel": 4.5}
+
+        for joint, corner in corners.items():
+            surface = pygame.Surface((60, 60))
+            self.draw_aalines(
+                surface, (255, 0, 0), False, points, width=6, joint=joint
+            )
+
+            self.assertAlmostEqual(
+                self._coverage(surface), 2 * 40 * 6 - 9 + corner, delta=1.5
+            )
+            self.assertEqual(surface.get_at((50, 10)), (255, 0, 0))
+
+    def test_aalines__width_no_overdraw(self):
+        """Ensures closed wide aalines draw every pixel once, so the edges of
+        overlapping segments are not blended twice.
+        """
+        surface = pygame.Surface((40, 40))
+        points = [(10.3, 10.3), (30.3, 10.3), (30.3, 30.3), (10.3, 30.3)]
+        self.draw_aalines(surface, (255, 0, 0), True, points, width=4)
+
+        self.assertAlmostEqual(self._coverage(surface), 24 * 24 - 16 * 16, delta=1)
+
+    def test_aalines__width_default(self):
+        """Ensures a width of 1 draws the same thin lines as the default."""
+        points = [(3, 4), (20.5, 6), (15, 18.2), (5, 12)]
+        surface = pygame.Surface((25, 25))
+        expected = pygame.Surface((25, 25))
+
+        self.draw_aalines(surface, GREEN, True, points, width=1)
+        self.draw_aalines(expected, GREEN, True, points)
+
+        for x in range(25):
+            for y in range(25):
+                self.assertEqual(surface.get_at((x, y)), expected.get_at((x, y)))
+
+    def test_aalines__width_less_than_1(self):
+        """Ensures nothing is drawn for widths < 1."""
+        surface = pygame.Surface((10, 10))
+
+        for width in (0, -1):
+            rect = self.draw_aalines(
+                surface, RED, False, [(2.5, 3), (8, 8)], width=width
+            )
+
+            self.assertEqual(rect, pygame.Rect(2, 3, 0, 0))
+        self.assertEqual(surface.get_bounding_rect(), pygame.Rect(0, 0, 0, 0))
+
+    def test_aalines__invalid_joint(self):
+        """Ensures draw aalines rejects unknown joints."""
+        surface = pygame.Surface((10, 10))
+
+        with self.assertRaises(ValueError):
+            self.draw_aalines(surface, RED, False, [(1, 1), (5, 5)], joint="sharp")
+        with self.assertRaises(TypeError):
+            self.draw_aalines(surface, RED, False, [(1, 1), (5, 5)], joint=1)
+
 
 ### Polygon Testing ###########################################################
 
@@ -4265,6 +4381,37 @@ class DrawPolygonMixin:
         for x, y in key_polygon_points:
             self.assertEqual(self.surface.get_at((x, y)), GREEN, msg=str((x, y)))
 
+    def test_polygon__many_vertices_clipped(self):
+        """Ensures a polygon with many vertices is filled the same way inside
+        any clip area.
+        """
+        points = [
+            (
+                40 + 35 * math.cos(i * math.tau / 500),
+                40 + 30 * math.sin(i * math.tau / 500 * 3),
+            )
+            for i in range(500)
+        ]
+        surface = pygame.Surface((80, 80))
+        expected = pygame.Surface((80, 80))
+        self.draw_polygon(expected, GREEN, points)
+        self.assertEqual(expected.get_at((40, 40)), GREEN)
+        self.assertEqual(expected.get_at((2, 40)), (0, 0, 0))
+
+        for clip in ((0, 0, 80, 80), (35, 0, 1, 80), (10, 20, 30, 15)):
+            surface.fill((0, 0, 0))
+            surface.set_clip(clip)
+            self.draw_polygon(surface, GREEN, points)
+            surface.set_clip(None)
+
+            for x in range(80):
+                for y in range(80):
+                    pos = (x, y)
+                    if pygame.Rect(clip).collidepoint(pos):
+                        self.assertEqual(surface.get_at(pos), expected.get_at(pos), pos)
+                    else:
+                        self.assertEqual(surface.get_at(pos), (0, 0, 0), pos)
+
 
 class DrawPolygonTest(DrawPolygonMixin, DrawTestCase):
     """Test draw module function polygon.
@@ -4274,6 +4421,126 @@ class DrawPolygonTest(DrawPolygonMixin, DrawTestCase):
     """
 
 
+### AAPolygon Testing #########################################################
+
+
+class DrawAAPolygonMixin:
+    """Mixin tests for drawing antialiased polygons.
+
+    This class contains all the general antialiased polygon drawing tests.
+    """
+
+    SQUARE = ((2, 2), (6, 2), (6, 6), (2, 6))
+
+    def test_aapolygon__filled_square(self):
+        """Ensures a filled square covers its inner pixels completely and
+        blends the pixels on its border.
+        """
+        surface = pygame.Surface((10, 10))
+        rect = self.draw_aapolygon(surface, (255, 255, 255), self.SQUARE)
+
+        self.assertEqual(rect, pygame.Rect(2, 2, 5, 5))
+        for x in range(3, 6):
+            for y in range(3, 6):
+                self.assertEqual(surface.get_at((x, y)), (255, 255, 255))
+        for pos in ((2, 4), (6, 4), (4, 2), (4, 6)):
+            self.assertTrue(
+                120 <= surface.get_at(pos).r <= 135, (pos, surface.get_at(pos))
+            )
+        for pos in ((2, 2), (6, 6)):
+            self.assertTrue(
+                55 <= surface.get_at(pos).r <= 70, (pos, surface.get_at(pos))
+            )
+        for pos in ((1, 4), (7, 4), (4, 1), (4, 7)):
+            self.assertEqual(surface.get_at(pos), (0, 0, 0), pos)
+
+    def test_aapolygon__total_coverage(self):
+        """Ensures the coverage of all pixels adds up to the polygon area."""
+        surface = pygame.Surface((30, 30))
+        points = [(3.3, 2.7), (25.1, 8.4), (14.6, 26.2)]
+        self.draw_aapolygon(surface, (255, 0, 0), points)
+
+        total = sum(surface.get_at((x, y)).r for x in range(30) for y in range(30))
+        area = 0.5 * abs(
+            (points[1][0] - points[0][0]) * (points[2][1] - points[0][1])
+            - (points[2][0] - points[0][0]) * (points[1][1] - points[0][1])
+        )
+        self.assertAlmostEqual(total / 255, area, delta=area * 0.01)
+
+    def test_aapolygon__outline(self):
+        """Ensures an unfilled aapolygon draws closed aalines."""
+        points = [(3, 4), (20.5, 6), (15, 18.2), (5, 12)]
+        surface = pygame.Surface((25, 25))
+        expected = pygame.Surface((25, 25))
+
+        rect = self.draw_aapolygon(surface, GREEN, points, filled=False)
+        expected_rect = self.draw_aalines(expected, GREEN, True, points)
+
+        self.assertEqual(rect, expected_rect)
+        for x in range(25):
+            for y in range(25):
+                self.assertEqual(surface.get_at((x, y)), expected.get_at((x, y)))
+
+    def test_aapolygon__clipped(self):
+        """Ensures a clipped aapolygon only changes pixels in the clip area
+        and matches the unclipped polygon there.
+        """
+        surface = pygame.Surface((20, 20))
+        expected = pygame.Surface((20, 20))
+        points = [(-5, 3.5), (24, 7.25), (9, 24)]
+        clip = pygame.Rect(4, 5, 7, 9)
+
+        self.draw_aapolygon(expected, RED, points)
+        surface.set_clip(clip)
+        rect = self.draw_aapolygon(surface, RED, points)
+        surface.set_clip(None)
+
+        self.assertTrue(clip.contains(rect))
+        for x in range(20):
+            for y in range(20):
+                if clip.collidepoint(x, y):
+                    self.assertEqual(surface.get_at((x, y)), expected.get_at((x, y)))
+                else:
+                    self.assertEqual(surface.get_at((x, y)), (0, 0, 0))
+
+    def test_aapolygon__nothing_drawn(self):
+        """Ensures a polygon outside of the surface returns a rect at its first
+        point.
+        """
+        surface = pygame.Surface((10, 10))
+        rect = self.draw_aapolygon(surface, RED, [(20.7, 3), (30, 3), (25, 8)])
+
+        self.assertEqual(rect, pygame.Rect(20, 3, 0, 0))
+
+    def test_aapolygon__kwargs(self):
+        """Ensures draw aapolygon accepts keyword arguments."""
+        surface = pygame.Surface((10, 10))
+        rect = self.draw_aapolygon(
+            surface=surface, color=RED, points=self.SQUARE, filled=True
+        )
+
+        self.assertIsInstance(rect, pygame.Rect)
+
+    def test_aapolygon__invalid_points(self):
+        """Ensures draw aapolygon rejects invalid points."""
+        surface = pygame.Surface((10, 10))
+
+        with self.assertRaises(ValueError):
+            self.draw_aapolygon(surface, RED, [(1, 2), (3, 4)])
+        with self.assertRaises(TypeError):
+            self.draw_aapolygon(surface, RED, [(1, 2), (3, 4), (5,)])
+        with self.assertRaises(TypeError):
+            self.draw_aapolygon(surface, RED, 42)
+
+
+class DrawAAPolygonTest(DrawAAPolygonMixin, DrawTestCase):
+    """Test draw module function aapolygon.
+
+    This class inherits the general tests from DrawAAPolygonMixin. It is also
+    the class to add any draw.aapolygon specific tests to.
+    """
+
+
 ### Rect Testing ##############################################################
 
 
@@ -6503,6 +6770,105 @@ class DrawAACircleTest(DrawAACircleMixin, DrawTestCase):
     the class to add any draw.aacircle specific tests to."""
 
 
+### Circle Stamp Testing ######################################################
+
+
+class DrawCircleStampMixin:
+    """Mixin tests for cached circle stamps.
+
+    This class contains all the general circle stamp tests.
+    """
+
+    def _blit_stamp(self, size, center, radius, color, width=0, aa=False):
+        """Returns a black surface with a stamp blitted on it."""
+        surface = pygame.Surface(size)
+        stamp = self.circle_stamp(radius, color, width, aa)
+        surface.blit(stamp, stamp.get_rect(center=center))
+        return surface
+
+    def test_circle_stamp__surface(self):
+        """Ensures a stamp is a transparent surface with the circle in its
+        middle.
+        """
+        stamp = self.circle_stamp(5, (255, 0, 0))
+
+        self.assertEqual(stamp.get_size(), (12, 12))
+        self.assertTrue(stamp.get_flags() & SRCALPHA)
+        self.assertEqual(stamp.get_at((6, 6)), (255, 0, 0, 255))
+        self.assertEqual(stamp.get_at((0, 0)).a, 0)
+
+    def test_circle_stamp__matches_circle(self):
+        """Ensures blitting a stamp draws the same pixels as circle()."""
+        for radius, width in ((1, 0), (7, 0), (7, 1), (12, 3), (12, 20)):
+            expected = pygame.Surface((40, 40))
+            self.draw_circle(expected, GREEN, (20, 19), radius, width)
+
+            surface = self._blit_stamp((40, 40), (20, 19), radius, GREEN, width)
+
+            for x in range(40):
+                for y in range(40):
+                    self.assertEqual(
+                        surface.get_at((x, y)),
+                        expected.get_at((x, y)),
+                        (radius, width, x, y),
+                    )
+
+    def test_circle_stamp__matches_aacircle(self):
+        """Ensures blitting an antialiased stamp matches aacircle() on an
+        opaque background.
+        """
+        for width in (0, 1, 4):
+            expected = pygame.Surface((40, 40))
+            self.draw_aacircle(expected, (255, 200, 100), (20, 20), 10, width)
+
+            surface = self._blit_stamp(
+                (40, 40), (20, 20), 10, (255, 200, 100), width, aa=True
+            )
+
+            for x in range(40):
+                for y in range(40):
+                    color = surface.get_at((x, y))
+                    expected_color = expected.get_at((x, y))
+                    for i in range(3):
+                        self.assertAlmostEqual(
+                            color[i], expected_color[i], delta=3, msg=(width, x, y)
+                        )
+
+    def test_circle_stamp__cached(self):
+        """Ensures the same stamp is returned for the same arguments."""
+        stamp = self.circle_stamp(6, "red", 2, True)
+
+        self.assertIs(self.circle_stamp(6, pygame.Color("red"), 2, aa=True), stamp)
+        self.assertIsNot(self.circle_stamp(6, "blue", 2, True), stamp)
+        self.assertIsNot(self.circle_stamp(6, "red", 2, False), stamp)
+        self.assertIsNot(self.circle_stamp(6, "red", 3, True), stamp)
+
+    def test_circle_stamp__many_radii(self):
+        """Ensures the cache keeps working when old stamps are dropped."""
+        for radius in range(1, 400, 3):
+            stamp = self.circle_stamp(radius, "red")
+            self.assertEqual(stamp.get_size(), (2 * radius + 2,) * 2)
+
+    def test_circle_stamp__invalid_args(self):
+        """Ensures circle_stamp rejects invalid arguments."""
+        with self.assertRaises(ValueError):
+            self.circle_stamp(0, "red")
+        with self.assertRaises(ValueError):
+            self.circle_stamp(5, "red", -1)
+        with self.assertRaises(TypeError):
+            self.circle_stamp(5, object())
+        with self.assertRaises(TypeError):
+            self.circle_stamp(5.5, "red")
+
+
+class DrawCircleStampTest(DrawCircleStampMixin, DrawTestCase):
+    """Test draw module function circle_stamp.
+
+    This class inherits the general tests from DrawCircleStampMixin. It is
+    also the class to add any draw.circle_stamp specific tests to.
+    """
+
+
 ### Arc Testing ###############################################################
 
 
@@ -7075,12 +7441,215 @@ class DrawArcTest(DrawArcMixin, DrawTestCase):
     """
 
 
+### Batch Testing #############################################################
+
+
+class DrawBatchMixin:
+    """Mixin tests for drawing many shapes at once.
+
+    This class contains all the general batch drawing tests. Each batch must
+    match drawing its shapes one at a time.
+    """
+
+    RECTS = [(2, 3, 10, 6), (-4, 20, 12, 9), (30, 30, 20, 20), (5, 5, 0, 4)]
+    CENTERS = [(10, 10), (0, 30), (35, 12), (80, 80), (20, 38)]
+    RADII = [6, 8, 3, 5, 0]
+    LINES = [(0, 0, 39, 39), (5, 30, 45, 2), (-3, 10, 20, 10), (60, 0, 70, 9)]
+    COLORS = [
+        (255, 0, 0),
+        (0, 255, 0, 128),
+        (0, 0, 255),
+        "yellow",
+        pygame.Color(10, 20, 30),
+    ]
+
+    def _draw_one_by_one(self, draw_func, shapes, colors, *extra):
+        """Returns the surface and the union of the returned rects for drawing
+        every shape separately."""
+        surface = pygame.Surface((40, 40), SRCALPHA)
+        bounds = None
+        for shape, color in zip(shapes, colors):
+            rect = draw_func(surface, color, *shape, *extra)
+            if rect.size != (0, 0):
+                bounds = rect if bounds is None else bounds.union(rect)
+        return surface, bounds
+
+    def _assert_same_pixels(self, surface1, surface2):
+        self.assertEqual(
+            pygame.image.tobytes(surface1, "RGBA"),
+            pygame.image.tobytes(surface2, "RGBA"),
+        )
+
+    def test_rects(self):
+        """Ensures rects() draws like rect() called for every rect."""
+        for width in (0, 1, 3):
+            expected, bounds = self._draw_one_by_one(
+                self.draw_rect, [(r,) for r in self.RECTS], self.COLORS, width
+            )
+            surface = pygame.Surface((40, 40), SRCALPHA)
+            rect = self.draw_rects(surface, self.COLORS[:4], self.RECTS, width)
+
+            self._assert_same_pixels(surface, expected)
+            self.assertEqual(rect, bounds)
+
+    def test_circles(self):
+        """Ensures circles() draws like circle() called for every circle."""
+        shapes = list(zip(self.CENTERS, self.RADII))
+        for width in (0, 1, 2):
+            expected, bounds = self._draw_one_by_one(
+                self.draw_circle, shapes, self.COLORS, width
+            )
+            surface = pygame.Surface((40, 40), SRCALPHA)
+            rect = self.draw_circles(
+                surface, self.COLORS, self.CENTERS, self.RADII, width
+            )
+
+            self._assert_same_pixels(surface, expected)
+            self.assertEqual(rect, bounds)
+
+        # one radius for all circles
+        expected, bounds = self._draw_one_by_one(
+            self.draw_circle, [(c, 4) for c in self.CENTERS], [RED] * 5
+        )
+        surface = pygame.Surface((40, 40), SRCALPHA)
+        rect = self.draw_circles(surface, RED, self.CENTERS, 4)
+        self._assert_same_pixels(surface, expected)
+        self.assertEqual(rect, bounds)
+
+    def test_lines_batch(self):
+        """Ensures lines_batch() draws like line() called for every line."""
+        shapes = [((x1, y1), (x2, y2)) for x1, y1, x2, y2 in self.LINES]
+        for width in (1, 4):
+            expected, bounds = self._draw_one_by_one(
+                self.draw_line, shapes, self.COLORS, width
+            )
+            surface = pygame.Surface((40, 40), SRCALPHA)
+            rect = self.draw_lines_batch(surface, self.COLORS[:4], self.LINES, width)
+
+            self._assert_same_pixels(surface, expected)
+            self.assertEqual(rect, bounds)
+
+    def test_batch__buffers(self):
+        """Ensures coordinates, radii and colors can be passed as buffers."""
+        surface = pygame.Surface((40, 40), SRCALPHA)
+        expected = pygame.Surface((40, 40), SRCALPHA)
+        colors = [(1, 2, 3, 255), (40, 50, 60, 70), (7, 8, 9, 10)]
+        color_buffer = memoryview(bytearray(sum(colors, ()))).cast("B", (3, 4))
+
+        for typecode in ("i", "h", "d", "f"):
+            centers = array.array(typecode, [5, 5, 20, 20, 39, 0])
+            radii = array.array(typecode, [3, 6, 2])
+            self.draw_circles(surface, color_buffer, centers, radii)
+            self.draw_circles(expected, colors, [(5, 5), (20, 20), (39, 0)], radii)
+            self._assert_same_pixels(surface, expected)
+
+            rects = array.array(typecode, [1, 1, 5, 5, 10, 20, 8, 3])
+            self.draw_rects(surface, GREEN, rects, 1)
+            self.draw_rects(expected, GREEN, [(1, 1, 5, 5), (10, 20, 8, 3)], 1)
+            self._assert_same_pixels(surface, expected)
+
+        vectors = pygame.math.Vector2Array([(3, 4), (30, 33)])
+        rect = self.draw_circles(surface, RED, vectors, 2)
+        bounds = self.draw_circle(expected, RED, (3, 4), 2)
+        bounds.union_ip(self.draw_circle(expected, RED, (30, 33), 2))
+        self.assertEqual(rect, bounds)
+        self._assert_same_pixels(surface, expected)
+
+        rgb = memoryview(bytearray([9, 8, 7] * 2)).cast("B", (2, 3))
+        self.draw_lines_batch(surface, rgb, [(0, 39, 39, 39), (0, 38, 9, 38)])
+        self.assertEqual(surface.get_at((20, 39)), (9, 8, 7, 255))
+
+    def test_batch__nothing_drawn(self):
+        """Ensures the returned rect has no size when nothing is drawn."""
+        surface = pygame.Surface((20, 20))
+
+        self.assertEqual(self.draw_rects(surface, RED, []), pygame.Rect(0, 0, 0, 0))
+        self.assertEqual(
+            self.draw_rects(surface, RED, [(30, 40, 5, 5)]), pygame.Rect(30, 40, 0, 0)
+        )
+        self.assertEqual(
+            self.draw_circles(surface, RED, [(3, 4)], 0), pygame.Rect(3, 4, 0, 0)
+        )
+        self.assertEqual(
+            self.draw_lines_batch(surface, RED, [(1, 2, 3, 4)], 0),
+            pygame.Rect(1, 2, 0, 0),
+        )
+        self.assertEqual(
+            self.draw_rects(surface, RED, [(1, 2, 3, 4)], -1), pygame.Rect(1, 2, 0, 0)
+        )
+
+    def test_batch__invalid_args(self):
+        """Ensures invalid batches raise an exception."""
+        surface = pygame.Surface((20, 20))
+
+        for shapes in (None, 5, [(1, 2, 3)], [(1, 2, 3, "x")], [1, 2, 3, 4]):
+            with self.assertRaises(TypeError):
+                self.draw_rects(surface, RED, shapes)
+            with self.assertRaises(TypeError):
+                self.draw_lines_batch(surface, RED, shapes)
+        with self.assertRaises(TypeError):
+            self.draw_circles(surface, RED, [(1, 2, 3)], 2)
+        with self.assertRaises(TypeError):
+            self.draw_circles(surface, RED, [(1, 2)], ["x"])
+
+        # buffers with the wrong number of values per shape
+        with self.assertRaises(ValueError):
+            self.draw_rects(surface, RED, array.array("i", [1, 2, 3]))
+        with self.assertRaises(ValueError):
+            self.draw_circles(surface, RED, memoryview(b"abcd").cast("B", (1, 4)), 1)
+
+        # the number of colors and radii must match the number of shapes
+        with self.assertRaises(ValueError):
+            self.draw_rects(surface, [RED, GREEN], [(1, 2, 3, 4)])
+        with self.assertRaises(ValueError):
+            self.draw_circles(surface, RED, [(1, 2), (3, 4)], [1, 2, 3])
+        with self.assertRaises(ValueError):
+            colors = memoryview(bytearray(10)).cast("B", (2, 5))
+            self.draw_lines_batch(surface, colors, [(1, 2, 3, 4)] * 2)
+        with self.assertRaises(ValueError):
+            self.draw_lines_batch(surface, "not a color name", [(1, 2, 3, 4)] * 2)
+
+
+class DrawBatchTest(DrawBatchMixin, DrawTestCase):
+    """Test draw module functions rects, circles and lines_batch.
+
+    This class inherits the general tests from DrawBatchMixin. It is also
+    the class to add any batch specific tests to.
+    """
+
+
 ### Draw Module Testing #######################################################
 
 
 class DrawModuleTest(unittest.TestCase):
     """General draw module tests."""
 
+    def test_position_types(self):
+        """Ensures positions are read the same from every kind of pair."""
+        surf = pygame.Surface((6, 6))
+        line_rect = draw.line(surf, RED, (2, 3), (4, 3))
+        circle_rect = draw.circle(surf, RED, (2, 3), 1)
+        self.assertEqual(line_rect, (2, 3, 3, 1))
+
+        for pos in ([2, 3], pygame.Vector2(2.7, 3.2), (2.0, 3.9)):
+            surf = pygame.Surface((6, 6))
+            self.assertEqual(draw.line(surf, RED, pos, (4, 3)), line_rect)
+            self.assertEqual(draw.circle(surf, RED, pos, 1), circle_rect)
+            self.assertEqual(surf.get_at((2, 3)), RED)
+
+    def test_argument_errors(self):
+        """Ensures the draw functions reject arguments like they always did."""
+        surf = pygame.Surface((6, 6))
+        self.assertRaises(TypeError, draw.line, surf, RED, (0, 0), (1, 1), 1, 2)
+        self.assertRaises(TypeError, draw.line, surf, RED, (0, 0), end=(1, 1))
+        self.assertRaises(TypeError, draw.line, surf, RED, (0, 0), (1, 1), wide=2)
+        self.assertRaises(TypeError, draw.line, surf, RED, (0, 0), (1, 1), 1.5)
+        self.assertRaises(
+            TypeError, draw.circle, surf, RED, (0, 0), 1, surface=surf
+        )
+        self.assertRaises(TypeError, draw.rect, "surf", RED, (0, 0, 1, 1))
+        self.assertRaises(OverflowError, draw.rect, surf, RED, (0, 0, 1, 1), 2**40)
+
     def test_path_data_validation(self):
         """Test validation of multipoint drawing methods.
 
@@ -7176,6 +7745,29 @@ class DrawModuleTest(unittest.TestCase):
             with self.assertRaises(TypeError):
                 draw.polygon(surf, col, points, 0)
 
+    def test_long_spans(self):
+        """Ensures long horizontal spans are filled exactly on every pixel
+        size, with and without an offset from the row start.
+        """
+        color = pygame.Color(10, 120, 230)
+        for depth in (8, 16, 24, 32):
+            surf = pygame.Surface((700, 4), depth=depth)
+            expected = surf.unmap_rgb(surf.map_rgb(color))
+            for start in range(4):
+                for end in (start + 97, 500, 698):
+                    surf.fill((0, 0, 0))
+                    draw.line(surf, color, (start, 1), (end, 1))
+
+                    for x in range(700):
+                        self.assertEqual(surf.get_at((x, 0)), (0, 0, 0))
+                        inside = start <= x <= end
+                        self.assertEqual(
+                            surf.get_at((x, 1)) == expected,
+                            inside,
+                            (depth, start, end, x),
+                        )
+                        self.assertEqual(surf.get_at((x, 2)), (0, 0, 0))
+
 
 ###############################################################################
 
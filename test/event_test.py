@@ -1,5 +1,8 @@
 import collections
+import io
 import os
+import struct
+import threading
 import time
 import unittest
 
@@ -210,6 +213,53 @@ results. Try running the test again.
 """
 
 
+class ChannelTest(unittest.TestCase):
+    def test_push_drain(self):
+        channel = pygame.event.Channel(capacity=4, item_size=8)
+        self.assertEqual(len(channel), 0)
+        self.assertEqual(channel.drain(), [])
+
+        for payload in (b"a", bytearray(b"bc"), memoryview(b"12345678"), b""):
+            self.assertTrue(channel.push(payload))
+        self.assertFalse(channel.push(b"full"))
+        self.assertEqual(len(channel), 4)
+        self.assertRaises(ValueError, channel.push, b"123456789")
+
+        self.assertEqual(channel.drain(max=1), [b"a"])
+        self.assertEqual(channel.drain(), [b"bc", b"12345678", b""])
+        self.assertEqual(len(channel), 0)
+
+        # the ring wraps around
+        for i in range(10):
+            self.assertTrue(channel.push(bytes([i])))
+            self.assertEqual(channel.drain(), [bytes([i])])
+
+    def test_threads(self):
+        channel = pygame.event.Channel(capacity=64)
+        count = 2000
+        received = []
+
+        def producer():
+            for i in range(count):
+                data = i.to_bytes(4, "little")
+                while not channel.push(data):
+                    time.sleep(0)
+
+        thread = threading.Thread(target=producer)
+        thread.start()
+        while len(received) < count:
+            received.extend(channel.drain())
+        thread.join()
+        self.assertEqual(
+            [int.from_bytes(d, "little") for d in received], list(range(count))
+        )
+
+    def test_args(self):
+        self.assertRaises(ValueError, pygame.event.Channel, 0)
+        self.assertRaises(ValueError, pygame.event.Channel, 8, 0)
+        self.assertRaises(ValueError, pygame.event.Channel, 8, 8, -1)
+
+
 class EventModuleArgsTest(unittest.TestCase):
     def setUp(self):
         pygame.display.init()
@@ -617,6 +667,49 @@ class EventModuleTest(unittest.TestCase):
 
         self._assertExpectedEvents(expected=expected_events, got=retrieved_events)
 
+    def test_get_into(self):
+        """Ensure get_into() writes records and leaves the overflow queued."""
+        pygame.event.clear()
+        record = struct.Struct("=IIiiiiiiiIiI")
+        self.assertEqual(record.size, 48)
+
+        for _ in range(5):
+            pygame.event.post(pygame.event.Event(pygame.USEREVENT, a=1))
+
+        buf = bytearray(record.size * 3)
+        self.assertEqual(pygame.event.get_into(buf), 3)
+        for fields in record.iter_unpack(buf):
+            self.assertEqual(fields[0], pygame.USEREVENT)
+            self.assertEqual(fields[2:], (0,) * 10)
+
+        # the two events that did not fit are still on the queue
+        self.assertEqual(pygame.event.get_into(buf, pump=False), 2)
+        self.assertEqual(pygame.event.get_into(buf), 0)
+
+        # a buffer smaller than one record takes nothing
+        pygame.event.post(pygame.event.Event(pygame.USEREVENT))
+        self.assertEqual(pygame.event.get_into(bytearray(10)), 0)
+        self.assertEqual(len(pygame.event.get()), 1)
+
+        self.assertRaises(TypeError, pygame.event.get_into, b"read only")
+
+    def test_get__queue_order(self):
+        """Ensure filtered get() keeps queue order and leaves other events."""
+        pygame.event.clear()
+        for etype in (pygame.KEYUP, pygame.USEREVENT, pygame.KEYDOWN, pygame.KEYUP):
+            pygame.event.post(pygame.event.Event(etype))
+
+        types = [e.type for e in pygame.event.get([pygame.KEYDOWN, pygame.KEYUP])]
+        self.assertEqual(types, [pygame.KEYUP, pygame.KEYDOWN, pygame.KEYUP])
+        self.assertEqual([e.type for e in pygame.event.get()], [pygame.USEREVENT])
+
+        for etype in (pygame.KEYUP, pygame.USEREVENT, pygame.KEYDOWN):
+            pygame.event.post(pygame.event.Event(etype))
+
+        types = [e.type for e in pygame.event.get(exclude=pygame.USEREVENT)]
+        self.assertEqual(types, [pygame.KEYUP, pygame.KEYDOWN])
+        self.assertEqual([e.type for e in pygame.event.get()], [pygame.USEREVENT])
+
     def test_get_clears_queue(self):
         """Ensure get() clears the event queue after a call"""
         pygame.event.get()  # should clear the queue completely by getting all events
@@ -899,6 +992,57 @@ class EventModuleTest(unittest.TestCase):
             pygame.event.set_grab(i % 2)
             self.assertEqual(pygame.event.get_grab(), i % 2)
 
+    def test_set_coalesce(self):
+        """Ensure set_coalesce() accepts only motion types and keeps order"""
+        self.assertRaises(ValueError, pygame.event.set_coalesce, pygame.KEYDOWN)
+
+        pygame.event.set_coalesce(pygame.MOUSEMOTION, True, keep_samples=True)
+        pygame.event.set_coalesce(pygame.FINGERMOTION)
+        try:
+            pygame.event.clear()
+            # posted events never merge, whatever their type
+            for _ in range(3):
+                pygame.event.post(pygame.event.Event(pygame.MOUSEMOTION))
+            pygame.event.post(pygame.event.Event(pygame.USEREVENT))
+
+            types = [e.type for e in pygame.event.get()]
+            self.assertEqual(types, [pygame.MOUSEMOTION] * 3 + [pygame.USEREVENT])
+            self.assertIsInstance(pygame.event.get_samples(), list)
+            self.assertEqual(pygame.event.get_samples(), [])
+        finally:
+            pygame.event.set_coalesce(pygame.MOUSEMOTION, False)
+            pygame.event.set_coalesce(pygame.FINGERMOTION, False)
+
+    def test_record_replay(self):
+        """Ensure record() writes a log that replay() reads back"""
+        self.assertRaises(TypeError, pygame.event.record, 42)
+
+        log = io.BytesIO()
+        pygame.event.record(log)
+        try:
+            # posted events are no input, they are not logged
+            pygame.event.post(pygame.event.Event(pygame.KEYDOWN))
+            for _ in range(3):
+                pygame.event.get()
+        finally:
+            pygame.event.record(None)
+
+        data = log.getvalue()
+        self.assertEqual(data[:4], b"PGEV")
+        self.assertEqual(len(data), 16)
+        self.assertEqual(int.from_bytes(data[12:16], "little"), 3)
+
+        pygame.event.replay(io.BytesIO(data))
+        try:
+            self.assertRaises(pygame.error, pygame.event.record, io.BytesIO())
+            pygame.event.get()
+        finally:
+            pygame.event.replay(None)
+
+        self.assertRaises(
+            pygame.error, pygame.event.replay, io.BytesIO(b"not a log at all")
+        )
+
     def test_poll(self):
         """Ensure poll() works as expected"""
         pygame.event.clear()
@@ -490,6 +490,104 @@ class FontTypeTest(unittest.TestCase):
             ucs_4 = "\U00010000"
             s = f.render(ucs_4, False, [0, 0, 0], [255, 255, 255])
 
+    def test_render_to(self):
+        f = pygame_font.Font(None, 20)
+        surf = pygame.Surface((200, 100), pygame.SRCALPHA)
+
+        rect = f.render_to(surf, (10, 20), "foo bar", True, "red")
+        self.assertIsInstance(rect, pygame.Rect)
+        self.assertEqual(rect.topleft, (10, 20))
+        self.assertEqual(rect.height, f.get_height())
+        self.assertGreater(rect.width, 0)
+        self.assertTrue(rect.contains(surf.get_bounding_rect()))
+        self.assertEqual(surf.get_at(rect.move(0, -1).topleft), (0, 0, 0, 0))
+
+        # glyphs are reused from the atlas and drawn the same way again
+        again = pygame.Surface((200, 100), pygame.SRCALPHA)
+        again_rect = f.render_to(
+            again, pygame.Rect(10, 20, 1, 1), b"foo bar", True, "red"
+        )
+        self.assertEqual(again_rect, rect)
+        self.assertTrue(equal_images(surf, again))
+
+        colors = {surf.get_at((x, y))[:3] for x in range(200) for y in range(100)}
+        self.assertIn((255, 0, 0), colors)
+
+        rect = f.render_to(surf, (0, 0), "a\nb", False, "blue")
+        self.assertEqual(rect.height, f.get_linesize() + f.get_height())
+        empty = f.render_to(surf, (5, 5), "", True, "red")
+        self.assertEqual(empty.size, (0, f.get_height()))
+        self.assertEqual(f.render_to(surf, (5, 5), None, True, "red").width, 0)
+
+        self.assertRaises(TypeError, f.render_to, surf, (0, 0), 1, True, "red")
+        self.assertRaises(TypeError, f.render_to, surf, "ab", "x", True, "red")
+        self.assertRaises(ValueError, f.render_to, surf, (0, 0), "a\x00b", 1, "red")
+
+    @unittest.skipIf(
+        pygame_font.__name__ == "pygame.ftfont", "ftfont has a different render"
+    )
+    def test_render_async(self):
+        f = pygame_font.Font(None, 20)
+        future = f.render_async("foo bar", True, "red", wraplength=100)
+        surf = future.result(timeout=10)
+        self.assertIsInstance(surf, pygame.Surface)
+        self.assertTrue(equal_images(surf, f.render("foo bar", True, "red")))
+
+        # run in order, on another thread
+        futures = [f.render_async(str(i), False, "blue", "white") for i in range(20)]
+        for i, future in enumerate(futures):
+            expected = f.render(str(i), False, "blue", "white")
+            self.assertTrue(equal_images(future.result(timeout=10), expected))
+
+        self.assertRaises(TypeError, f.render_async("foo", True).result, 10)
+
+    def test_render_cache(self):
+        f = pygame_font.Font(None, 20)
+        self.assertEqual(f.get_cache_stats()["max_bytes"], 0)
+        self.assertIsNot(f.render("foo", True, "red"), f.render("foo", True, "red"))
+
+        f.enable_cache(1 << 20)
+        first = f.render("foo", True, "red")
+        self.assertIs(f.render("foo", True, "red"), first)
+        self.assertIsNot(f.render("foo", True, "blue"), first)
+        self.assertIsNot(f.render("foo", False, "red"), first)
+        self.assertIsNot(f.render("foo", True, "red", "black"), first)
+        self.assertIsNot(f.render(b"foo", True, "red"), first)
+        f.bold = True
+        bold = f.render("foo", True, "red")
+        self.assertIsNot(bold, first)
+        f.bold = False
+        self.assertIs(f.render("foo", True, "red"), first)
+
+        stats = f.get_cache_stats()
+        self.assertEqual(stats["hits"], 2)
+        self.assertEqual(stats["misses"], 6)
+        self.assertEqual(stats["entries"], 6)
+        self.assertEqual(stats["max_bytes"], 1 << 20)
+        self.assertGreater(stats["bytes"], 0)
+
+        # changing the shared surface renders the text again
+        first.fill((0, 0, 0, 0))
+        second = f.render("foo", True, "red")
+        self.assertIsNot(second, first)
+        self.assertFalse(equal_images(second, first))
+
+        # least recently used entries are dropped to make room
+        f.clear_cache()
+        self.assertEqual(f.get_cache_stats()["entries"], 0)
+        second = f.render("foo", True, "red")
+        f.enable_cache(f.get_cache_stats()["bytes"])
+        f.render("foo", True, "green")  # same size
+        stats = f.get_cache_stats()
+        self.assertEqual((stats["evictions"], stats["entries"]), (1, 1))
+        self.assertIsNot(f.render("foo", True, "red"), second)
+
+        self.assertRaises(ValueError, f.enable_cache, 0)
+
+        f.disable_cache()
+        stats = f.get_cache_stats()
+        self.assertEqual((stats["entries"], stats["max_bytes"]), (0, 0))
+
     def test_set_bold(self):
         f = pygame_font.Font(None, 20)
         self.assertFalse(f.get_bold())
@@ -593,6 +691,25 @@ class FontTypeTest(unittest.TestCase):
 
         self.assertNotEqual(size, bsize)
 
+    def test_size_many(self):
+        f = pygame_font.Font(None, 20)
+        texts = ["Xg", b"Xg", "wrap", "Xg", ""]
+        sizes = f.size_many(texts)
+
+        self.assertEqual(sizes.format, "i")
+        self.assertEqual(sizes.shape, (5, 2))
+        expected = [f.size(t) for t in texts]
+        self.assertEqual([tuple(row) for row in sizes.tolist()], expected)
+        self.assertEqual(len(f.size_many([])), 0)
+        self.assertRaises(TypeError, f.size_many, ["Xg", 1])
+
+        # cached sizes follow changes to the style
+        plain = f.size("wrap")
+        f.bold = True
+        self.assertNotEqual(f.size("wrap"), plain)
+        f.bold = False
+        self.assertEqual(f.size("wrap"), plain)
+
     def test_point_size_property(self):
         if pygame_font.__name__ == "pygame.ftfont":
             return  # not a pygame.ftfont feature
@@ -738,6 +738,92 @@ class FreeTypeFontTest(unittest.TestCase):
             size=24,
         )
 
+    def test_freetype_Font_render_many(self):
+        font = self._TEST_FONTS["sans"]
+        items = [
+            ("Foo", (10, 10)),
+            ("bar", pygame.Rect(100, 40, 1, 1), (255, 0, 0)),
+            ("Foo", (10, 80), None, (0, 0, 255)),
+            ("", (5, 5)),
+            (b"Baz", (200, 200), "green", None),
+            ("Foo", (300, 10), (0, 255, 0, 128)),
+        ]
+
+        # Same pixels and rects as one render_to call per item
+        expected = pygame.Surface((400, 300))
+        rects = [
+            font.render_to(expected, dest, text, *colors, size=24)
+            for text, dest, *colors in items
+        ]
+        surf = pygame.Surface((400, 300))
+        self.assertEqual(font.render_many(surf, items, size=24), rects)
+        self.assertEqual(
+            pygame.image.tobytes(surf, "RGB"), pygame.image.tobytes(expected, "RGB")
+        )
+        self.assertFalse(font.render_many(surf, [("", (0, 0))], size=24)[0])
+        self.assertEqual(font.render_many(surf, (), size=24), [])
+        self.assertEqual(
+            font.render_many(surf, [("Foo", (0, 0))], size=12),
+            [font.render_to(surf, (0, 0), "Foo", size=12)],
+        )
+
+        for bad_items in [
+            None,
+            ["Foo"],
+            [("Foo",)],
+            [["Foo", (0, 0)]],
+            [(None, (0, 0))],
+            [("Foo", "a")],
+            [("Foo", (0, 0), "not a color name")],
+        ]:
+            with self.assertRaises((TypeError, ValueError)):
+                font.render_many(surf, bad_items, size=24)
+
+        # no size given, and no default size in the font
+        self.assertRaises(ValueError, font.render_many, surf, [("Foo", (0, 0))])
+        self.assertRaises(TypeError, font.render_many, "not a surface", [])
+
+    def test_freetype_Font_render_to_blending(self):
+        # The 32 bit glyph blitters (SIMD versions included) blend the glyph
+        # coverage into each pixel as the reference ALPHA_BLEND does.
+        font = self._TEST_FONTS["sans"]
+        coverage, size = font.render_raw("@", size=48)
+        w, h = size
+
+        def blend(s, d, a):
+            return (((s - d) * a + s) >> 8) + d
+
+        for flags, bg in [
+            (pygame.SRCALPHA, (10, 200, 30, 128)),
+            (pygame.SRCALPHA, (0, 0, 0, 0)),
+            (0, (240, 10, 90)),
+        ]:
+            for fg in [(250, 20, 120, 200), (5, 250, 60, 255), (90, 90, 90, 7)]:
+                surf = pygame.Surface((w + 10, h + 10), flags, 32)
+                surf.fill(bg)
+                bg_color = surf.get_at((0, 0))
+                rect = font.render_to(surf, (3, 4), "@", fg, size=48)
+                self.assertEqual(rect.size, size)
+
+                for y in range(h):
+                    for x in range(w):
+                        a = coverage[y * w + x] * fg[3] // 255
+                        if a == 255:
+                            expected = pygame.Color(*fg[:3], 255)
+                        elif a == 0:
+                            expected = bg_color
+                        elif bg_color.a:
+                            expected = pygame.Color(
+                                *(blend(fg[i], bg_color[i], a) for i in range(3)),
+                                a + bg_color.a - a * bg_color.a // 255,
+                            )
+                        else:
+                            expected = pygame.Color(*fg[:3], a)
+                        if not flags:
+                            expected.a = 255
+                        pos = (rect.x + x, rect.y + y)
+                        self.assertEqual(surf.get_at(pos), expected, (flags, fg, pos))
+
     def test_freetype_Font_render(self):
         font = self._TEST_FONTS["sans"]
 
@@ -1453,6 +1539,7 @@ class FreeTypeFontTest(unittest.TestCase):
             (ccount + cdelete_count, caccess, chit, cmiss), (count, access, hit, miss)
         )
         # Trigger a cleanup for sure.
+        f.set_cache_budget(16384)
         count += 2 * mglen
         access += 2 * mglen
         miss += 2 * mglen
@@ -1469,6 +1556,163 @@ class FreeTypeFontTest(unittest.TestCase):
     except AttributeError:
         del test_freetype_Font_cache
 
+    def test_freetype_Font_get_cache_stats(self):
+        f = ft.Font(self._sans_path, size=24)
+        stats = f.get_cache_stats()
+        self.assertEqual(
+            stats,
+            {
+                "hits": 0,
+                "misses": 0,
+                "evictions": 0,
+                "entries": 0,
+                "bytes": 0,
+                "max_bytes": 2 << 20,
+                "fonts": 1,
+                "sdf_glyphs": 0,
+                "sdf_bytes": 0,
+            },
+        )
+
+        f.render_raw("abcab")
+        stats = f.get_cache_stats()
+        self.assertEqual((stats["hits"], stats["misses"]), (2, 3))
+        self.assertEqual(stats["entries"], 3)
+        self.assertGreater(stats["bytes"], 0)
+
+        # A new size is a miss for every glyph
+        f.render_raw("abc", size=12)
+        stats = f.get_cache_stats()
+        self.assertEqual((stats["hits"], stats["misses"]), (2, 6))
+        self.assertEqual(stats["entries"], 6)
+
+        with self.assertRaises(RuntimeError):
+            ft.Font.__new__(ft.Font).get_cache_stats()
+
+    def test_freetype_Font_sdf(self):
+        f = ft.Font(self._sans_path, size=24)
+        self.assertFalse(f.sdf)
+        plain, plain_size = f.render_raw("Ab")
+
+        f.sdf = True
+        self.assertTrue(f.sdf)
+        if ft.get_version() < (2, 10, 0):
+            self.skipTest("distance fields need FreeType 2.10")
+        sdf, sdf_size = f.render_raw("Ab")
+        self.assertNotEqual(sdf, plain)
+        self.assertGreater(max(sdf), 200)
+        self.assertAlmostEqual(sdf_size[0], plain_size[0], delta=3)
+        self.assertAlmostEqual(sdf_size[1], plain_size[1], delta=3)
+
+        # One field per glyph serves every size
+        stats = f.get_cache_stats()
+        self.assertEqual(stats["sdf_glyphs"], 2)
+        self.assertGreater(stats["sdf_bytes"], 0)
+        small, small_size = f.render_raw("Ab", size=12)
+        large, large_size = f.render_raw("Ab", size=96)
+        self.assertEqual(f.get_cache_stats()["sdf_glyphs"], 2)
+        self.assertLess(small_size[0], sdf_size[0])
+        self.assertGreater(large_size[0], sdf_size[0])
+
+        # Strong thresholds outward
+        strong, strong_size = f.render_raw("Ab", style=ft.STYLE_STRONG)
+        self.assertGreater(sum(strong), sum(sdf))
+
+    def test_freetype_Font_render_async(self):
+        f = ft.Font(self._sans_path, size=24)
+        future = f.render_async("Hello", "black", size=48)
+        surf, rect = future.result(timeout=10)
+        expected, expected_rect = f.render("Hello", "black", size=48)
+        self.assertEqual(rect, expected_rect)
+        self.assertEqual(
+            pygame.image.tobytes(surf, "RGBA"),
+            pygame.image.tobytes(expected, "RGBA"),
+        )
+
+        # The main thread can use fonts while others render
+        futures = [f.render_async(str(i) * 20, size=32 + i) for i in range(10)]
+        other = ft.Font(self._sans_path, size=24)
+        for i in range(10):
+            other.render_raw("main thread")
+            f.get_rect("abc")
+        for i, future in enumerate(futures):
+            surf, rect = future.result(timeout=10)
+            self.assertEqual(rect, f.get_rect(str(i) * 20, size=32 + i))
+
+        self.assertRaises(TypeError, f.render_async(1).result, 10)
+
+    def test_freetype_Font_set_cache_budget(self):
+        f = ft.Font(self._sans_path, size=24)
+        f.set_cache_budget(1000000)
+        self.assertEqual(f.get_cache_stats()["max_bytes"], 1000000)
+
+        # The glyphs of the current text are kept, whatever the budget
+        f.set_cache_budget(0)
+        f.render_raw("abcdef")
+        stats = f.get_cache_stats()
+        self.assertEqual((stats["entries"], stats["evictions"]), (6, 0))
+        other = ft.Font(self._sans_path, size=24)
+        self.assertEqual(f.render_raw(None), other.render_raw("abcdef"))
+
+        # but go once the font moves on to other text
+        f.render_raw("xyz")
+        stats = f.get_cache_stats()
+        self.assertEqual((stats["entries"], stats["evictions"]), (3, 6))
+
+        f.set_cache_budget(1000000)
+        f.render_raw("abcdef")
+        f.render_raw("xyz")
+        self.assertEqual(f.get_cache_stats()["entries"], 9)
+
+        with self.assertRaises(ValueError):
+            f.set_cache_budget(-1)
+        with self.assertRaises(TypeError):
+            f.set_cache_budget("1000")
+
+    def test_freetype_Font_share_cache(self):
+        a = ft.Font(self._sans_path, size=24, share_cache=True)
+        b = ft.Font(self._sans_path, size=24, share_cache=True)
+        private = ft.Font(self._sans_path, size=24)
+        other_resolution = ft.Font(
+            self._sans_path, size=24, resolution=144, share_cache=True
+        )
+        self.assertEqual(a.get_cache_stats()["fonts"], 2)
+        self.assertEqual(private.get_cache_stats()["fonts"], 1)
+        self.assertEqual(other_resolution.get_cache_stats()["fonts"], 1)
+
+        # Glyphs loaded by one font are hits for the other
+        a.render_raw("abc")
+        b.render_raw("abc")
+        stats = b.get_cache_stats()
+        self.assertEqual((stats["hits"], stats["misses"]), (3, 3))
+        self.assertEqual(private.get_cache_stats()["entries"], 0)
+        self.assertEqual(a.render("abc")[0].get_size(), b.render("abc")[0].get_size())
+
+        # One font can't evict the glyphs another font still lays out
+        b.set_cache_budget(0)
+        b.render_raw("xyz")
+        self.assertEqual(a.get_cache_stats()["entries"], 6)
+        self.assertEqual(a.render_raw(None), private.render_raw("abc"))
+
+        del a
+        self.assertEqual(b.get_cache_stats()["fonts"], 1)
+        c = ft.Font(self._sans_path, size=24, share_cache=True)
+        self.assertEqual(c.get_cache_stats()["fonts"], 2)
+
+    def test_freetype_Font_shared_face(self):
+        fonts = [ft.Font(self._sans_path, size=s) for s in range(8, 32, 2)]
+        expected = [f.get_rect("abc").size for f in fonts]
+        late = ft.Font(self._sans_path, size=8)
+        self.assertEqual(late.name, fonts[0].name)
+
+        # The face outlives any one of the fonts using it
+        del fonts[::2]
+        self.assertEqual([f.get_rect("abc").size for f in fonts], expected[1::2])
+        fonts[0].__init__(self._sans_path, size=10, font_index=0)
+        self.assertEqual(fonts[0].get_rect("abc").size, expected[1])
+        del fonts[:]
+        self.assertEqual(late.get_rect("abc").size, expected[0])
+
     def test_undefined_character_code(self):
         # To be consistent with pygame.font.Font, undefined codes
         # are rendered as the undefined character, and has metrics
@@ -1,9 +1,10 @@
+import array
 import math
 import unittest
 from math import sqrt
 
 from pygame import Vector2, Vector3, Rect, FRect
-from pygame.geometry import Circle
+from pygame.geometry import Circle, Line, Polygon, RectIndex, circle_overlaps
 
 
 def float_range(a, b, step):
@@ -682,6 +683,72 @@ class CircleTypeTest(unittest.TestCase):
         self.assertTrue(c.collideswith(p))
         self.assertFalse(c.collideswith(p2))
 
+    def test_collidelist(self):
+        """Ensures collidelist returns the index of the first colliding shape"""
+        c = Circle(0, 0, 5)
+        shapes = [Circle(100, 100, 1), Rect(50, 0, 10, 10), (0, 3), FRect(0, 0, 1, 1)]
+
+        self.assertEqual(c.collidelist(shapes), 2)
+        self.assertEqual(c.collidelist(shapes[:2]), -1)
+        self.assertEqual(c.collidelist(()), -1)
+        self.assertEqual(c.collidelist([Vector2(4, 0)]), 0)
+
+        with self.assertRaises(TypeError):
+            c.collidelist(5)
+        with self.assertRaises(TypeError):
+            c.collidelist([None])
+        # shapes after the first colliding one are not looked at
+        self.assertEqual(c.collidelist([(0, 0), None]), 0)
+
+    def test_collidelistall(self):
+        """Ensures collidelistall returns the indices of all colliding shapes"""
+        c = Circle(0, 0, 5)
+        shapes = [Circle(0, 10, 15), Rect(50, 0, 10, 10), (0, 3), FRect(0, 0, 1, 1)]
+
+        self.assertEqual(c.collidelistall(shapes), [0, 2, 3])
+        expected = [i for i, s in enumerate(shapes) if c.collideswith(s)]
+        self.assertEqual(c.collidelistall(shapes), expected)
+        self.assertEqual(c.collidelistall([]), [])
+
+        with self.assertRaises(TypeError):
+            c.collidelistall(5)
+        with self.assertRaises(TypeError):
+            c.collidelistall([(0, 0), None])
+
+    def test_circle_overlaps(self):
+        """Ensures circle_overlaps agrees with collideswith for every circle"""
+        circles = [Circle(x * 7 % 23, x * 11 % 19, x % 5) for x in range(40)]
+        centers = array.array("d", [v for c in circles for v in c.center])
+        radii = array.array("d", [c.r for c in circles])
+
+        for query in (
+            Circle(10, 10, 3),
+            Circle(-50, 0, 1),
+            Rect(5, 5, 4, 2),
+            FRect(0.5, 0.5, 0.0, 10.0),
+            (12, 9),
+            Vector2(3.5, 4.25),
+        ):
+            expected = [i for i, c in enumerate(circles) if c.collideswith(query)]
+            self.assertEqual(circle_overlaps(centers, radii, query), expected)
+
+        view = memoryview(centers).cast("B").cast("d")
+        self.assertEqual(
+            circle_overlaps(centers=view, radii=radii, query=(0, 0)),
+            [i for i, c in enumerate(circles) if c.collideswith((0, 0))],
+        )
+        empty = array.array("d")
+        self.assertEqual(circle_overlaps(empty, empty, (0, 0)), [])
+
+        with self.assertRaises(ValueError):
+            circle_overlaps(centers, radii[:-1], (0, 0))
+        with self.assertRaises(ValueError):
+            circle_overlaps(array.array("f", centers), radii, (0, 0))
+        with self.assertRaises(TypeError):
+            circle_overlaps([0.0, 0.0], [1.0], (0, 0))
+        with self.assertRaises(TypeError):
+            circle_overlaps(centers, radii, None)
+
     def test_update(self):
         """Ensures that updating the circle position
         and dimension correctly updates position and dimension"""
@@ -1296,5 +1363,189 @@ class CircleTypeTest(unittest.TestCase):
         self.assertTrue(c.contains(fr_edge))
 
 
+class RectIndexTypeTest(unittest.TestCase):
+    def test_construction(self):
+        index = RectIndex()
+        self.assertEqual(index.cell_size, 64.0)
+        self.assertEqual(len(index), 0)
+        self.assertEqual(RectIndex(cell_size=10).cell_size, 10.0)
+
+        for value in (0, -1, float("inf"), float("nan")):
+            self.assertRaises(ValueError, RectIndex, value)
+        self.assertRaises(TypeError, RectIndex, "1")
+
+    def test_insert_move_remove(self):
+        index = RectIndex(10)
+        index.insert("a", Rect(0, 0, 5, 5))
+        index.insert("b", (100, 100, 20, -20))
+
+        self.assertEqual(len(index), 2)
+        self.assertIn("a", index)
+        self.assertNotIn("c", index)
+        self.assertEqual(index.get_rect("b"), FRect(100, 80, 20, 20))
+        self.assertRaises(KeyError, index.insert, "a", (0, 0, 1, 1))
+        self.assertRaises(TypeError, index.insert, "c", "not a rect")
+
+        index.move("a", (200, 200, 5, 5))
+        self.assertEqual(index.collidepoint(1, 1), [])
+        self.assertEqual(index.collidepoint((201, 201)), ["a"])
+        self.assertRaises(KeyError, index.move, "c", (0, 0, 1, 1))
+
+        index.remove("a")
+        self.assertNotIn("a", index)
+        self.assertEqual(index.collidepoint(201, 201), [])
+        self.assertRaises(KeyError, index.remove, "a")
+
+        index.clear()
+        self.assertEqual(len(index), 0)
+        self.assertEqual(index.colliderect((0, 0, 1000, 1000)), [])
+
+    def test_collidepoint(self):
+        index = RectIndex(16)
+        index.insert(0, (0, 0, 10, 10))
+        index.insert(1, (5, 5, 10, 10))
+        index.insert(2, (-1000, -1000, 5000, 5000))
+        index.insert(3, (0, 0, 0, 10))
+
+        self.assertEqual(sorted(index.collidepoint(7, 7)), [0, 1, 2])
+        self.assertEqual(sorted(index.collidepoint(Vector2(10, 10))), [1, 2])
+        self.assertEqual(index.collidepoint(-2000, 0), [])
+        self.assertRaises(TypeError, index.collidepoint, "1", 2)
+
+    def test_colliderect_matches_rect(self):
+        rects = [Rect(x * 7 % 300, x * 13 % 300, x % 40, x % 25) for x in range(200)]
+        index = RectIndex(20)
+        for i, r in enumerate(rects):
+            index.insert(i, r)
+
+        for query in (Rect(0, 0, 50, 50), Rect(100, 40, 200, 10), Rect(-5, -5, 400, 400)):
+            self.assertEqual(
+                sorted(index.colliderect(query)), sorted(query.collidelistall(rects))
+            )
+
+    def test_collidepairs(self):
+        rects = [Rect(x * 7 % 300, x * 13 % 300, x % 40, x % 25) for x in range(200)]
+        rects.append(Rect(-100, -100, 1000, 20))
+        index = RectIndex(20)
+        for i, r in enumerate(rects):
+            index.insert(i, r)
+
+        expected = [
+            (i, j)
+            for i in range(len(rects))
+            for j in range(i + 1, len(rects))
+            if rects[i].colliderect(rects[j])
+        ]
+        pairs = sorted(tuple(sorted(pair)) for pair in index.collidepairs())
+        self.assertEqual(pairs, expected)
+
+
+class LineTypeTest(unittest.TestCase):
+    def test_construction(self):
+        line = Line(1, 2, 3, 4)
+        self.assertEqual((line.ax, line.ay, line.bx, line.by), (1, 2, 3, 4))
+        self.assertEqual(Line((1, 2), (3, 4)), line)
+        self.assertEqual(Line([(1, 2), (3, 4)]), line)
+        self.assertEqual(Line(line), line)
+        self.assertEqual(line.a, (1.0, 2.0))
+        self.assertEqual(line.b, (3.0, 4.0))
+        self.assertEqual(Line(0, 0, 3, 4).length, 5.0)
+
+        for args in ((1, 2, 3), ("1", 2, 3, 4), ((1, 2), None), ()):
+            self.assertRaises(TypeError, Line, *args)
+
+    def test_move(self):
+        line = Line(0, 0, 10, 0)
+        self.assertEqual(line.move(1, 2), Line(1, 2, 11, 2))
+        self.assertEqual(line, Line(0, 0, 10, 0))
+        line.move_ip((1, 2))
+        self.assertEqual(line, Line(1, 2, 11, 2))
+        line.update((0, 0), (5, 5))
+        self.assertEqual(line, Line(0, 0, 5, 5))
+
+    def test_collideswith(self):
+        line = Line(0, 0, 10, 0)
+        self.assertTrue(line.collideswith(Rect(4, -1, 2, 2)))
+        self.assertTrue(line.collideswith(FRect(-1, -1, 2, 2)))
+        self.assertFalse(line.collideswith(Rect(4, 1, 2, 2)))
+        self.assertTrue(line.collideswith(Circle(12, 0, 2)))
+        self.assertFalse(line.collideswith(Circle(12, 0, 1.5)))
+        self.assertTrue(line.collideswith(Line(5, -1, 5, 1)))
+        self.assertTrue(line.collideswith(Line(8, 0, 20, 0)))
+        self.assertFalse(line.collideswith(Line(0, 1, 10, 1)))
+        self.assertTrue(line.collideswith(Polygon([(4, -1), (6, -1), (5, 1)])))
+        self.assertRaises(TypeError, line.collideswith, (1, 2))
+
+    def test_raycast(self):
+        line = Line(0, 0, 10, 0)
+        self.assertIsNone(line.raycast([]))
+        self.assertIsNone(line.raycast([Rect(0, 5, 2, 2), Circle(5, 5, 1)]))
+        self.assertEqual(line.raycast([Rect(5, -1, 2, 2)]), (5.0, 0.0))
+        self.assertEqual(line.raycast([Rect(7, 1, -2, -2)]), (5.0, 0.0))
+        self.assertEqual(line.raycast([Circle(5, 0, 1)]), (4.0, 0.0))
+        self.assertEqual(line.raycast([Line(3, -1, 3, 1)]), (3.0, 0.0))
+        self.assertEqual(line.raycast([Line(12, 0, 2, 0)]), (2.0, 0.0))
+        self.assertEqual(line.raycast([Polygon([(6, -1), (6, 1), (8, 0)])]), (6.0, 0.0))
+
+        # starting inside a shape hits at the start
+        self.assertEqual(line.raycast([Circle(0, 0, 1)]), (0.0, 0.0))
+        self.assertEqual(line.raycast([FRect(-1, -1, 2, 2)]), (0.0, 0.0))
+
+        shapes = [Circle(9, 0, 0.5), Rect(7, -1, 1, 2), Line(6, -1, 6, 1)]
+        self.assertEqual(line.raycast(shapes), (6.0, 0.0))
+        self.assertRaises(TypeError, line.raycast, [Rect(0, 0, 1, 1), 1])
+        self.assertRaises(TypeError, line.raycast, 1)
+
+    def test_raycast_matches_single_shapes(self):
+        """The batch kernels give the nearest of the single shape hits"""
+        shapes = []
+        for i in range(41):
+            x, y = i * 7 % 60 - 30, i * 13 % 60 - 30
+            shapes.append(Rect(x, y, i % 5 - 2, i % 7 - 3))
+            shapes.append(Circle(y, x, i % 4))
+            shapes.append(Line(x, y, y, -x))
+        for i in range(40):
+            ray = Line(i - 20, -35, 20 - i, 35)
+            hits = [ray.raycast([shape]) for shape in shapes]
+            hits = [hit for hit in hits if hit is not None]
+            hit = ray.raycast(shapes)
+            if not hits:
+                self.assertIsNone(hit)
+                continue
+            nearest = min(hits, key=lambda h: math.dist(ray.a, h))
+            self.assertAlmostEqual(hit[0], nearest[0])
+            self.assertAlmostEqual(hit[1], nearest[1])
+
+
+class PolygonTypeTest(unittest.TestCase):
+    def test_construction(self):
+        polygon = Polygon([(0, 0), (4, 0), (4, 4), (0, 4)])
+        self.assertEqual(polygon.verts_num, 4)
+        self.assertEqual(polygon.vertices, [(0, 0), (4, 0), (4, 4), (0, 4)])
+        self.assertEqual(Polygon(polygon).vertices, polygon.vertices)
+        self.assertEqual(polygon.center, (2.0, 2.0))
+
+        self.assertRaises(ValueError, Polygon, [(0, 0), (1, 1)])
+        self.assertRaises(TypeError, Polygon, [(0, 0), (1, 1), "ab"])
+        self.assertRaises(TypeError, Polygon, 1)
+
+    def test_move_and_center(self):
+        polygon = Polygon([(0, 0), (4, 0), (4, 4), (0, 4)])
+        self.assertEqual(polygon.move(1, 1).vertices, [(1, 1), (5, 1), (5, 5), (1, 5)])
+        polygon.move_ip(-2, -2)
+        self.assertEqual(polygon.center, (0.0, 0.0))
+        polygon.center = (10, 10)
+        self.assertEqual(polygon.vertices, [(8, 8), (12, 8), (12, 12), (8, 12)])
+        polygon.vertices = [(0, 0), (1, 0), (0, 1)]
+        self.assertEqual(polygon.verts_num, 3)
+
+    def test_collidepoint(self):
+        polygon = Polygon([(0, 0), (4, 0), (4, 4), (2, 1), (0, 4)])
+        self.assertTrue(polygon.collidepoint(1, 1))
+        self.assertTrue(polygon.collidepoint((3, 2)))
+        self.assertFalse(polygon.collidepoint(2, 3))
+        self.assertFalse(polygon.collidepoint(5, 1))
+
+
 if __name__ == "__main__":
     unittest.main()
@@ -850,6 +850,29 @@ class GfxdrawDefaultTest(unittest.TestCase):
             0,
         )
 
+    def test_textured_polygon__copied_spans(self):
+        """Spans copied straight from a texture match blitted ones"""
+        texture = pygame.Surface((13, 7), 0, 32)
+        for x in range(13):
+            for y in range(7):
+                texture.set_at((x, y), (x * 19, y * 36, (x + y) * 12))
+        # the color key isn't in the texture, but forces blits
+        keyed = texture.copy()
+        keyed.set_colorkey((1, 2, 3))
+        points = [(-5, 3), (40, -8), (70, 30), (22, 55), (3, 60)]
+
+        for clip in (None, pygame.Rect(6, 4, 40, 30)):
+            copied = pygame.Surface((64, 48), 0, 32)
+            blitted = pygame.Surface((64, 48), 0, 32)
+            copied.set_clip(clip)
+            blitted.set_clip(clip)
+            pygame.gfxdraw.textured_polygon(copied, points, texture, 3, -5)
+            pygame.gfxdraw.textured_polygon(blitted, points, keyed, 3, -5)
+            self.assertEqual(
+                pygame.image.tobytes(copied, "RGB"),
+                pygame.image.tobytes(blitted, "RGB"),
+            )
+
     def test_bezier(self):
         """bezier(surface, points, steps, color): return None"""
         fg = self.foreground_color
@@ -872,5 +895,87 @@ class GfxdrawDefaultTest(unittest.TestCase):
                 self.check_at(surf, posn, bg_adjusted)
 
 
+    def test_batch(self):
+        """Ensure a batch draws the same pixels as the module functions."""
+        fg = pygame.Color("red")
+        points = [(10, 50), (25, 15), (60, 80), (92, 30)]
+        # (function name, arguments without the surface)
+        calls = [
+            ("pixel", (2, 2, fg)),
+            ("hline", (5, 40, 3, fg)),
+            ("vline", (4, 5, 40, fg)),
+            ("line", (0, 0, 90, 60, fg)),
+            ("rectangle", ((10, 10, 30, 20), fg)),
+            ("box", ((50, 50, 20, 10), fg)),
+            ("circle", (40, 40, 15, fg)),
+            ("aacircle", (40, 40, 20, fg)),
+            ("filled_circle", (70, 20, 8, fg)),
+            ("ellipse", (30, 60, 20, 10, fg)),
+            ("aaellipse", (30, 60, 25, 12, fg)),
+            ("filled_ellipse", (80, 70, 10, 5, fg)),
+            ("arc", (50, 50, 30, 0, 120, fg)),
+            ("pie", (50, 50, 25, 180, 270, fg)),
+            ("trigon", (5, 90, 20, 70, 35, 95, fg)),
+            ("aatrigon", (50, 90, 65, 70, 80, 95, fg)),
+            ("filled_trigon", (60, 5, 90, 10, 75, 30, fg)),
+            ("polygon", (points, fg)),
+            ("aapolygon", (points[::-1], fg)),
+            ("filled_polygon", ([(0, 99), (20, 80), (40, 99)], fg)),
+            ("bezier", (points, 30, fg)),
+        ]
+        for surf in self.surfaces:
+            expected = surf.copy()
+            for name, args in calls:
+                getattr(pygame.gfxdraw, name)(expected, *args)
+
+            with pygame.gfxdraw.batch(surf) as batch:
+                for name, args in calls:
+                    getattr(batch, name)(*args)
+                self.assertEqual(batch.queued, len(calls))
+                # Nothing is drawn before the with block ends.
+                self.assertEqual(surf.get_at((2, 2)), expected.get_at((99, 0)))
+            self.assertEqual(batch.queued, 0)
+
+            for y in range(surf.get_height()):
+                for x in range(surf.get_width()):
+                    self.assertEqual(
+                        surf.get_at((x, y)), expected.get_at((x, y)), (x, y)
+                    )
+
+    def test_batch__exception(self):
+        """Ensure a batch draws nothing if its with block raises."""
+        surf = self.surfaces[2]
+        with self.assertRaises(ZeroDivisionError):
+            with pygame.gfxdraw.batch(surf) as batch:
+                batch.box((0, 0, 10, 10), (255, 0, 0))
+                1 / 0
+        self.assertEqual(batch.queued, 0)
+        self.assertEqual(surf.get_at((5, 5)), surf.get_at((99, 0)))
+
+    def test_batch__invalid_use(self):
+        """Ensure a batch checks its arguments and when it is used."""
+        surf = self.surfaces[2]
+        batch = pygame.gfxdraw.batch(surf)
+        with self.assertRaises(RuntimeError):
+            batch.pixel(0, 0, (255, 0, 0))
+
+        with batch:
+            with self.assertRaises(RuntimeError):
+                with batch:
+                    pass
+            with self.assertRaises(ValueError):
+                batch.polygon([(0, 0), (1, 1)], (255, 0, 0))
+            with self.assertRaises(ValueError):
+                batch.bezier([(0, 0), (1, 1), (2, 0)], 1, (255, 0, 0))
+            with self.assertRaises(TypeError):
+                batch.box("not a rect", (255, 0, 0))
+            with self.assertRaises(TypeError):
+                batch.pixel(0, 0)
+            self.assertEqual(batch.queued, 0)
+
+        with self.assertRaises(TypeError):
+            pygame.gfxdraw.batch("not a surface")
+
+
 if __name__ == "__main__":
     unittest.main()
@@ -3,6 +3,7 @@ import binascii
 import io
 import os
 import tempfile
+import threading
 import unittest
 import glob
 import pathlib
@@ -717,6 +718,48 @@ class ImageModuleTest(unittest.TestCase):
             f'tobytes/frombytes functions are not symmetric using pitch with "{fmt}" format',
         )
 
+    def test_tobytes_formats_and_into(self):
+        """Test every format of tobytes against get_at, for the surface
+        formats with fast paths and odd widths, and writing into a buffer"""
+        size = (37, 5)
+        surfaces = [
+            pygame.Surface(size, pygame.SRCALPHA, 32),
+            pygame.Surface(size, 0, 32),
+            pygame.Surface(size, 0, 24),
+            pygame.Surface(
+                size, pygame.SRCALPHA, 32, (0xFF00, 0xFF0000, 0xFF000000, 0xFF)
+            ),
+        ]
+        for surf in surfaces:
+            for y in range(size[1]):
+                for x in range(size[0]):
+                    surf.set_at((x, y), (x * 7, y * 50, 255 - x, x * 3 + y))
+            for fmt in ("RGB", "RGBA", "ARGB", "BGRA", "ABGR"):
+                data = pygame.image.tobytes(surf, fmt)
+                for y in range(size[1]):
+                    for x in range(size[0]):
+                        color = surf.get_at((x, y))
+                        offset = (y * size[0] + x) * len(fmt)
+                        expected = bytes(color["RGBA".index(c)] for c in fmt)
+                        self.assertEqual(
+                            data[offset : offset + len(fmt)], expected, fmt
+                        )
+
+                into = bytearray(len(data) * 2)
+                self.assertIs(pygame.image.tobytes(surf, fmt, into=into), into)
+                self.assertEqual(into[: len(data)], data)
+                flipped = pygame.image.tobytes(surf, fmt, True, into=memoryview(into))
+                self.assertEqual(flipped, into)
+                self.assertEqual(
+                    into[: len(data)], pygame.image.tobytes(surf, fmt, True)
+                )
+
+        surf = surfaces[0]
+        with self.assertRaises(ValueError):
+            pygame.image.tobytes(surf, "RGBA", into=bytearray(10))
+        with self.assertRaises(TypeError):
+            pygame.image.tobytes(surf, "RGBA", into=bytes(37 * 5 * 4))
+
     def test_from_to_bytes_deprecation(self):
         test_surface = pygame.Surface((64, 256), flags=pygame.SRCALPHA, depth=32)
         with self.assertWarns(DeprecationWarning):
@@ -1316,12 +1359,290 @@ class ImageModuleTest(unittest.TestCase):
                     value_error_size,
                 )
 
+    @unittest.skipIf(
+        pygame.image.get_sdl_image_version() < (2, 6, 0),
+        "load_sized_svg requires SDL_image 2.6.0+",
+    )
+    def test_load_sized_svg_sizes_and_cache(self):
+        path = example_path("data/teal.svg")
+        sizes = [(10, 10), (20, 20), (40, 40)]
+        surfs = pygame.image.load_sized_svg(path, sizes)
+        self.assertEqual([s.get_size() for s in surfs], sizes)
+        self.assertEqual(pygame.image.load_sized_svg(path, []), [])
+
+        pygame.image.set_svg_cache_limit(2)
+        self.addCleanup(pygame.image.set_svg_cache_limit, 0)
+        first = pygame.image.load_sized_svg(path, (30, 30))
+        first.fill("red")
+        # a cache hit is a copy of the Surface as loaded
+        second = pygame.image.load_sized_svg(path, (30, 30))
+        self.assertIsNot(second, first)
+        self.assertEqual(second.get_at((0, 0)), (0, 128, 128, 255))
+        self.assertEqual(
+            [s.get_size() for s in pygame.image.load_sized_svg(path, sizes)], sizes
+        )
+        self.assertRaises(ValueError, pygame.image.set_svg_cache_limit, -1)
+
+    @unittest.skipIf(
+        pygame.image.get_sdl_image_version() < (2, 6, 0),
+        "load_animation requires SDL_image 2.6.0+",
+    )
+    def test_load_animation(self):
+        path = example_path("data/blue.gif")
+        image = pygame.image.load(path)
+
+        frames = pygame.image.load_animation(path)
+        self.assertGreaterEqual(len(frames), 1)
+        for surf, duration in frames:
+            self.assertEqual(surf.get_size(), image.get_size())
+            self.assertIsInstance(duration, int)
+
+        atlas, rects = pygame.image.load_animation(path, atlas=True)
+        self.assertEqual(len(rects), len(frames))
+        for (rect, duration), (surf, frame_duration) in zip(rects, frames):
+            self.assertEqual(rect.size, image.get_size())
+            self.assertTrue(atlas.get_rect().contains(rect))
+            self.assertEqual(duration, frame_duration)
+            self.assertEqual(atlas.get_at(rect.topleft), surf.get_at((0, 0)))
+
     def test_load_pathlib(self):
         """works loading using a Path argument."""
         path = pathlib.Path(example_path("data/asprite.bmp"))
         surf = pygame.image.load_extended(path)
         self.assertEqual(surf.get_at((0, 0)), (255, 255, 255, 255))
 
+    def test_load_many(self):
+        """Ensure load_many returns surfaces in order and reports failures."""
+        names = ["data/asprite.bmp", "data/alien1.png", "data/alien1.jpg"]
+        paths = [example_path(name) for name in names]
+        paths.insert(1, example_path("data/does_not_exist.png"))
+        paths.append(pathlib.Path(paths[0]))
+
+        for threads in (0, 1, 3):
+            surfaces, errors = pygame.image.load_many(paths, threads=threads)
+
+            self.assertEqual(len(surfaces), len(paths))
+            self.assertEqual(list(errors), [1])
+            self.assertIsInstance(errors[1], str)
+            self.assertIsNone(surfaces[1])
+            for i in (0, 2, 3, 4):
+                expected = pygame.image.load(paths[i])
+                self.assertEqual(surfaces[i].get_size(), expected.get_size())
+                self.assertEqual(surfaces[i].get_at((0, 0)), expected.get_at((0, 0)))
+
+        self.assertEqual(pygame.image.load_many([]), ([], {}))
+        with self.assertRaises(TypeError):
+            pygame.image.load_many([io.BytesIO()])
+        with self.assertRaises(ValueError):
+            pygame.image.load_many(paths, threads=-1)
+
+    def test_save_load_qoi(self):
+        """Ensure QOI images round trip losslessly through save and load."""
+        opaque = pygame.image.load(example_path("data/asprite.bmp"))
+        alpha = pygame.Surface((40, 30), pygame.SRCALPHA)
+        for x in range(40):
+            alpha.fill((x * 6, 255 - x * 5, x % 7 * 30, x * 6), (x, 0, 1, 30))
+        alpha.fill((0, 0, 0, 0), (5, 5, 10, 10))
+        keyed = opaque.copy()
+        keyed.set_colorkey(opaque.get_at((0, 0)))
+
+        for source in (opaque, alpha, keyed):
+            stream = io.BytesIO()
+            pygame.image.save(source, stream, "qoi")
+            self.assertEqual(stream.getvalue()[:4], b"qoif")
+            stream.seek(0)
+            loaded = pygame.image.load(stream, "qoi")
+
+            self.assertEqual(loaded.get_size(), source.get_size())
+            for pos in ((0, 0), (3, 5), (source.get_width() - 1, 7)):
+                expected = source.get_at(pos)
+                if source.get_colorkey() == expected:
+                    expected.a = 0
+                self.assertEqual(loaded.get_at(pos), expected)
+
+        with tempfile.TemporaryDirectory() as tmpdir:
+            path = os.path.join(tmpdir, "capture.qoi")
+            pygame.image.save(alpha, path)
+            loaded = pygame.image.load(path)
+            self.assertEqual(
+                pygame.image.tobytes(loaded, "RGBA"),
+                pygame.image.tobytes(alpha, "RGBA"),
+            )
+
+        data = stream.getvalue()
+        with self.assertRaises(pygame.error):
+            pygame.image.load(io.BytesIO(data[: len(data) // 2]), "qoi")
+
+    def test_recorder(self):
+        """Ensure Recorder writes the captured frames in order and drops
+        frames instead of waiting for a writer that fell behind."""
+        surf = pygame.Surface((7, 3), 0, 32)
+        stream = io.BytesIO()
+        expected = b""
+        with pygame.image.Recorder(stream, buffers=3) as recorder:
+            for i in range(3):
+                surf.fill((i * 50, 20, 30))
+                expected += surf.get_buffer().raw
+                self.assertTrue(recorder.capture(surf))
+        self.assertEqual(stream.getvalue(), expected)
+        self.assertEqual((recorder.captured, recorder.dropped), (3, 0))
+        with self.assertRaises(ValueError):
+            recorder.capture(surf)
+
+        class SlowFile:
+            def __init__(self):
+                self.go = threading.Event()
+                self.data = b""
+
+            def write(self, data):
+                self.go.wait()
+                self.data += data
+
+        slow = SlowFile()
+        recorder = pygame.image.Recorder(slow, "raw", buffers=1)
+        self.assertTrue(recorder.capture(surf))
+        self.assertFalse(recorder.capture(surf))
+        self.assertEqual((recorder.dropped, recorder.pending), (1, 1))
+        slow.go.set()
+        recorder.close()
+        self.assertEqual(recorder.pending, 0)
+        self.assertEqual(slow.data, surf.get_buffer().raw)
+
+        with tempfile.TemporaryDirectory() as tmpdir:
+            pattern = pathlib.Path(tmpdir, "frame%02d.qoi")
+            with pygame.image.Recorder(pattern) as recorder:
+                for i in range(2):
+                    surf.fill((0, i * 90, 9))
+                    recorder.capture(surf)
+            for i in range(2):
+                loaded = pygame.image.load(os.path.join(tmpdir, f"frame{i:02d}.qoi"))
+                self.assertEqual(loaded.get_at((6, 2)), (0, i * 90, 9))
+
+        with self.assertRaises(ValueError):
+            pygame.image.Recorder(io.BytesIO(), "png")
+        with self.assertRaises(ValueError):
+            pygame.image.Recorder(io.BytesIO(), buffers=0)
+
+    def test_save_load_raw(self):
+        """Ensure save_raw/load_raw round trip pixels and surface state."""
+        surf = pygame.Surface((37, 21), pygame.SRCALPHA)
+        surf.fill((10, 20, 30, 40))
+        surf.fill((200, 100, 0, 255), (5, 5, 10, 3))
+        surf.set_at((36, 20), (1, 2, 3, 4))
+        noise = pygame.image.frombytes(os.urandom(64 * 64 * 3), (64, 64), "RGB")
+        noise.set_colorkey((1, 2, 3))
+        noise.set_alpha(99)
+        indexed = pygame.Surface((13, 7), depth=8)
+        indexed.set_palette_at(3, (9, 8, 7))
+        indexed.fill(3)
+
+        for source in (surf, noise, indexed, surf.subsurface((3, 2, 20, 9))):
+            for compress in ("lz4", None):
+                stream = io.BytesIO()
+                pygame.image.save_raw(source, stream, compress=compress)
+                loaded = pygame.image.load_raw(io.BytesIO(stream.getvalue()))
+
+                self.assertEqual(loaded.get_size(), source.get_size())
+                self.assertEqual(loaded.get_bitsize(), source.get_bitsize())
+                self.assertEqual(loaded.get_colorkey(), source.get_colorkey())
+                self.assertEqual(loaded.get_alpha(), source.get_alpha())
+                self.assertEqual(
+                    pygame.image.tobytes(loaded, "RGBA"),
+                    pygame.image.tobytes(source, "RGBA"),
+                )
+
+        stream = io.BytesIO()
+        pygame.image.save_raw(surf, stream)
+        self.assertLess(len(stream.getvalue()), 37 * 21 * 4)
+
+        with tempfile.TemporaryDirectory() as tmpdir:
+            path = os.path.join(tmpdir, "surf.pgraw")
+            pygame.image.save_raw(surf, path)
+            loaded = pygame.image.load_raw(pathlib.Path(path))
+            self.assertEqual(loaded.get_at((36, 20)), (1, 2, 3, 4))
+
+        data = stream.getvalue()
+        with self.assertRaises(pygame.error):
+            pygame.image.load_raw(io.BytesIO(data[: len(data) - 5]))
+        with self.assertRaises(pygame.error):
+            pygame.image.load_raw(io.BytesIO(b"PGRX" + data[4:]))
+        with self.assertRaises(ValueError):
+            pygame.image.save_raw(surf, io.BytesIO(), compress="zip")
+
+    def test_load_from_buffer(self):
+        """Ensure buffer objects are read as image file contents."""
+        path = example_path("data/alien1.png")
+        expected = pygame.image.load(path)
+        with open(path, "rb") as f:
+            data = f.read()
+
+        for obj in (bytearray(data), memoryview(data)):
+            surf = pygame.image.load(obj, "png")
+            self.assertEqual(surf.get_size(), expected.get_size())
+            self.assertEqual(surf.get_at((5, 5)), expected.get_at((5, 5)))
+
+        with self.assertRaises(pygame.error):
+            pygame.image.load(bytearray(b"not an image"), "png")
+
+    def test_load_async(self):
+        """Ensure load_async resolves to the same surface as load."""
+        path = example_path("data/alien1.png")
+        futures = [pygame.image.load_async(path) for _ in range(8)]
+        expected = pygame.image.load(path)
+
+        for future in futures:
+            surf = future.result(timeout=10)
+            self.assertEqual(surf.get_size(), expected.get_size())
+            self.assertEqual(surf.get_at((0, 0)), expected.get_at((0, 0)))
+
+        with open(path, "rb") as f:
+            future = pygame.image.load_async(f, "png")
+            self.assertEqual(future.result(timeout=10).get_size(), expected.get_size())
+
+        future = pygame.image.load_async(io.BytesIO(b"not an image"), "png")
+        self.assertIsInstance(future.exception(timeout=10), pygame.error)
+
+        with self.assertRaises(FileNotFoundError):
+            pygame.image.load_async(example_path("data/does_not_exist.png"))
+        with self.assertRaises(ValueError):
+            pygame.image.load_async(path, convert=True, convert_alpha=True)
+
+    def test_save_async(self):
+        """Ensure save_async writes what the surface held when it was called."""
+        surf = pygame.Surface((16, 12), pygame.SRCALPHA)
+        surf.fill((200, 100, 50, 255))
+        tmpdir = tempfile.mkdtemp()
+        try:
+            futures = {}
+            for ext in ("png", "bmp", "tga", "qoi"):
+                path = os.path.join(tmpdir, f"snapshot.{ext}")
+                futures[path] = pygame.image.save_async(surf, path)
+            # drawing after the call must not show up in the files
+            surf.fill((0, 0, 0, 0))
+
+            for path, future in futures.items():
+                self.assertIsNone(future.result(timeout=10))
+                loaded = pygame.image.load(path)
+                self.assertEqual(loaded.get_size(), (16, 12))
+                self.assertEqual(loaded.get_at((3, 3))[:3], (200, 100, 50))
+
+            path = os.path.join(tmpdir, "snapshot.jpg")
+            future = pygame.image.save_async(surf, path, quality=10)
+            self.assertIsNone(future.result(timeout=10))
+            self.assertEqual(pygame.image.load(path).get_size(), (16, 12))
+
+            with self.assertRaises(ValueError):
+                pygame.image.save_async(surf, path, quality=101)
+            with self.assertRaises(TypeError):
+                pygame.image.save_async(surf, io.BytesIO(), "png")
+            with self.assertRaises(pygame.error):
+                missing = os.path.join(tmpdir, "missing", "snapshot.png")
+                pygame.image.save_async(surf, missing)
+        finally:
+            for name in os.listdir(tmpdir):
+                os.remove(os.path.join(tmpdir, name))
+            os.rmdir(tmpdir)
+
     def test_save_extended(self):
         surf = pygame.Surface((5, 5))
         surf.fill((23, 23, 23))
@@ -0,0 +1,65 @@
+import unittest
+
+import pygame
+import pygame.input
+
+
+class InputModuleTest(unittest.TestCase):
+    def setUp(self):
+        pygame.display.init()
+
+    def tearDown(self):
+        pygame.display.quit()
+
+    def test_snapshot(self):
+        state = pygame.input.snapshot()
+        self.assertIsInstance(state, pygame.input.InputState)
+        self.assertFalse(state.key_pressed(pygame.K_RIGHT))
+        self.assertEqual(state.mods, pygame.key.get_mods())
+        self.assertEqual(state.mouse_pos, pygame.mouse.get_pos())
+        self.assertEqual(
+            [state.mouse_pressed(i) for i in range(5)],
+            list(pygame.mouse.get_pressed(num_buttons=5)),
+        )
+        self.assertIsInstance(state.joystick_ids, tuple)
+
+    def test_snapshot_into(self):
+        state = pygame.input.InputState()
+        self.assertIs(pygame.input.snapshot(into=state), state)
+        self.assertIs(pygame.input.snapshot(state), state)
+
+        with self.assertRaises(TypeError):
+            pygame.input.snapshot(into=bytearray(1024))
+
+    def test_snapshot_mods(self):
+        pygame.key.set_mods(pygame.KMOD_LSHIFT)
+        state = pygame.input.snapshot()
+        self.assertEqual(state.mods, pygame.KMOD_LSHIFT)
+        pygame.key.set_mods(pygame.KMOD_NONE)
+        pygame.input.snapshot(into=state)
+        self.assertEqual(state.mods, pygame.KMOD_NONE)
+
+    def test_empty_state(self):
+        state = pygame.input.InputState()
+        self.assertFalse(state.key_pressed(pygame.K_a))
+        self.assertFalse(state.mouse_pressed(0))
+        self.assertEqual(state.mods, 0)
+        self.assertEqual(state.joystick_ids, ())
+
+    def test_errors(self):
+        state = pygame.input.snapshot()
+        with self.assertRaises(ValueError):
+            state.mouse_pressed(5)
+        with self.assertRaises(TypeError):
+            state.key_pressed("a")
+        for method in (state.get_axis, state.get_button, state.get_hat):
+            with self.assertRaises(pygame.error):
+                method(-1, 0)
+
+        pygame.display.quit()
+        with self.assertRaises(pygame.error):
+            pygame.input.snapshot()
+
+
+if __name__ == "__main__":
+    unittest.main()
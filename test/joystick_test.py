@@ -35,6 +35,37 @@ class JoystickTypeTest(unittest.TestCase):
         """Check if pygame.Joystick is present and the correct type."""
         self.assertIs(pygame.Joystick, pygame.joystick.Joystick)
 
+    def test_sampling(self):
+        """Check the samples recorded by start_sampling()."""
+        pygame.joystick.init()
+        try:
+            if not pygame.joystick.get_count():
+                self.skipTest("no joystick connected")
+            joy = pygame.joystick.Joystick(0)
+
+            self.assertEqual(joy.get_samples(), [])
+            self.assertRaises(ValueError, joy.start_sampling, 0)
+            self.assertRaises(ValueError, joy.start_sampling, 1000, 0)
+
+            start = pygame.time.get_ticks()
+            joy.start_sampling(1000, 8)
+            pygame.time.wait(50)
+            samples = joy.get_samples()
+            joy.stop_sampling()
+
+            # the ring keeps the newest samples
+            self.assertTrue(0 < len(samples) <= 8)
+            times = [t for t, _ in samples]
+            self.assertEqual(times, sorted(times))
+            self.assertGreaterEqual(times[0], start - 1)
+            for _, axes in samples:
+                self.assertEqual(len(axes), joy.get_numaxes())
+                for value in axes:
+                    self.assertTrue(-1.0 <= value <= 1.0)
+            self.assertEqual(joy.get_samples(), [])
+        finally:
+            pygame.joystick.quit()
+
 
 class JoystickModuleTest(unittest.TestCase):
     def test_get_init(self):
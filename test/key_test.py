@@ -244,6 +244,30 @@ class KeyModuleTest(unittest.TestCase):
         released_keys = pygame.key.get_just_released()
         self.assertEqual(released_keys[pygame.K_RIGHT], 0)
 
+    def test_get_pressed_view(self):
+        for func in (
+            pygame.key.get_pressed_view,
+            pygame.key.get_just_pressed_view,
+            pygame.key.get_just_released_view,
+        ):
+            view = func()
+            self.assertTrue(view.readonly)
+            self.assertEqual(view.format, "B")
+            self.assertEqual(len(view), len(pygame.key.get_just_pressed()))
+            self.assertEqual(view[pygame.KSCAN_RIGHT], 0)
+            with self.assertRaises(TypeError):
+                view[pygame.KSCAN_RIGHT] = 1
+
+    def test_get_pressed_view_matches(self):
+        pressed = pygame.key.get_pressed()
+        view = pygame.key.get_pressed_view()
+        for key, scancode in (
+            (pygame.K_a, pygame.KSCAN_A),
+            (pygame.K_RIGHT, pygame.KSCAN_RIGHT),
+            (pygame.K_SPACE, pygame.KSCAN_SPACE),
+        ):
+            self.assertEqual(bool(view[scancode]), pressed[key])
+
     def test_get_pressed_not_iter(self):
         states = pygame.key.get_pressed()
         with self.assertRaises(TypeError):
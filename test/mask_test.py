@@ -1,4 +1,5 @@
 from collections import OrderedDict
+import array
 import copy
 import platform
 import random
@@ -1135,6 +1136,115 @@ class MaskTypeTest(unittest.TestCase):
         with self.assertRaises(TypeError):
             overlap_mask = mask1.overlap_mask(mask2, offset)
 
+    def test_overlap_many(self):
+        """Ensures overlap_many gives the same results as overlap and
+        overlap_area for each offset."""
+        mask = pygame.Mask((40, 30))
+        mask.draw(pygame.Mask((10, 6), fill=True), (15, 12))
+        single = pygame.Mask((5, 5))
+        single.set_at((2, 3))
+        others = [random_mask((w, w)) for w in (1, 8, 33, 50)] * 4
+        offsets = [(x, y) for x in (-60, -10, 5, 18) for y in (-3, 14, 29, 90)]
+        flat = array.array("i", [v for offset in offsets for v in offset])
+
+        for masks in (single, others):
+            if masks is single:
+                pairs = [(single, offset) for offset in offsets]
+            else:
+                pairs = list(zip(others, offsets))
+            expected = [mask.overlap(m, o) or (-1, -1) for m, o in pairs]
+            expected_area = [mask.overlap_area(m, o) for m, o in pairs]
+
+            for offs in (offsets, flat):
+                points = mask.overlap_many(masks, offs)
+                areas = mask.overlap_many(masks, offs, area=True)
+
+                self.assertEqual(points.shape, (len(offsets), 2))
+                self.assertEqual([tuple(p) for p in points.tolist()], expected)
+                self.assertEqual(areas.shape, (len(offsets),))
+                self.assertEqual(areas.tolist(), expected_area)
+
+        self.assertEqual(mask.overlap_many(single, []).shape, (0, 2))
+        with self.assertRaises(ValueError):
+            mask.overlap_many(others[:3], offsets)
+        with self.assertRaises(ValueError):
+            mask.overlap_many(single, array.array("i", [1, 2, 3]))
+        with self.assertRaises(TypeError):
+            mask.overlap_many([single, None], [(0, 0), (1, 1)])
+        with self.assertRaises(TypeError):
+            mask.overlap_many(single, [(0, 0), "(1, 1)"])
+
+    def test_overlap__large_sparse_masks(self):
+        """Ensures the overlap methods are correct for large sparse masks.
+
+        Large masks skip their empty areas, these tests check that the
+        skipped areas stay correct when the masks change.
+        """
+        random.seed(1)
+        size1, size2 = (1000, 900), (700, 1100)
+        mask1 = pygame.mask.Mask(size1)
+        mask2 = pygame.mask.Mask(size2)
+        points1 = set()
+        points2 = set()
+
+        def add_points(mask, points, count):
+            width, height = mask.get_size()
+            for _ in range(count):
+                pos = (random.randrange(width), random.randrange(height))
+                mask.set_at(pos)
+                points.add(pos)
+
+        def check(msg):
+            for offset in ((0, 0), (5, -3), (-77, 130), (300, 41), (-640, -256)):
+                expected = {
+                    (x + offset[0], y + offset[1]) for x, y in points2
+                } & points1
+                overlap_mask = mask1.overlap_mask(mask2, offset)
+                pos = mask1.overlap(mask2, offset)
+
+                self.assertEqual(mask1.count(), len(points1), msg)
+                self.assertEqual(mask1.overlap_area(mask2, offset), len(expected), msg)
+                self.assertEqual(overlap_mask.count(), len(expected), msg)
+                if expected:
+                    self.assertIn(pos, expected, msg)
+                else:
+                    self.assertIsNone(pos, msg)
+
+        add_points(mask1, points1, 3000)
+        add_points(mask2, points2, 3000)
+        check("set_at")
+
+        # Overlap some of the points for sure.
+        mask2.draw(mask1, (-5, 3))
+        points2 |= {(x - 5, y + 3) for x, y in points1}
+        points2 = {(x, y) for x, y in points2 if 0 <= x < 700 and 0 <= y < 1100}
+        check("draw")
+
+        for pos in list(points1)[::2]:
+            mask1.set_at(pos, 0)
+            points1.remove(pos)
+        check("set_at value=0")
+
+        mask1.erase(mask2, (5, -3))
+        points1 -= {(x + 5, y - 3) for x, y in points2}
+        check("erase")
+
+        mask1.clear()
+        points1.clear()
+        check("clear")
+
+        add_points(mask1, points1, 100)
+        check("set_at after clear")
+
+        mask1.invert()
+        points1 = {(x, y) for x in range(size1[0]) for y in range(size1[1])} - points1
+        check("invert")
+
+        mask1.clear()
+        mask1.fill()
+        points1 = {(x, y) for x in range(size1[0]) for y in range(size1[1])}
+        check("fill")
+
     def test_mask_access(self):
         """do the set_at, and get_at parts work correctly?"""
         m = pygame.Mask((10, 10))
@@ -1292,6 +1402,73 @@ class MaskTypeTest(unittest.TestCase):
                         f"fill={fill}, size=({width}, {height})",
                     )
 
+    def test_prepare_shifts(self):
+        """Ensures prepared masks give the same overlaps as unprepared ones.
+
+        Tests negative, positive and word aligned offsets, with the shifted
+        copies prepared on either mask.
+        """
+        random.seed(0)
+        mask1 = random_mask((150, 13))
+        mask2 = random_mask((70, 20))
+        mask2.erase(random_mask((70, 20)), (0, 0))
+        plain1 = mask1.copy()
+        plain2 = mask2.copy()
+
+        for prepared in ((mask1,), (mask2,), (mask1, mask2)):
+            for mask in prepared:
+                mask.prepare_shifts()
+            mask1_used = mask1 if mask1 in prepared else plain1
+            mask2_used = mask2 if mask2 in prepared else plain2
+
+            for x in range(-80, 170, 3):
+                for y in range(-21, 15, 5):
+                    for offset in ((x, y), (x - x % 64, y)):
+                        msg = f"prepared={len(prepared)}, offset={offset}"
+
+                        self.assertEqual(
+                            mask1_used.overlap(mask2_used, offset),
+                            plain1.overlap(plain2, offset),
+                            msg,
+                        )
+                        self.assertEqual(
+                            mask1_used.overlap_area(mask2_used, offset),
+                            plain1.overlap_area(plain2, offset),
+                            msg,
+                        )
+
+    def test_prepare_shifts__dropped_on_change(self):
+        """Ensures the shifted copies are not used after the mask changes."""
+        mask = pygame.mask.Mask((100, 10))
+        other = pygame.mask.Mask((10, 10), fill=True)
+        offset = (35, 0)
+
+        mask.prepare_shifts()
+        mask.prepare_shifts()  # Calling it again is allowed.
+        self.assertIsNone(other.overlap(mask, (-offset[0], 0)))
+
+        for change, expected_area in (
+            (lambda: mask.set_at((40, 5)), 1),
+            (lambda: mask.draw(other, offset), 100),
+            (mask.invert, 0),
+            (mask.fill, 100),
+            (mask.clear, 0),
+        ):
+            mask.prepare_shifts()
+            change()
+
+            self.assertEqual(other.overlap_area(mask, (-offset[0], 0)), expected_area)
+
+    def test_prepare_shifts__exported_buffer(self):
+        """Ensures the shifts can't be prepared while the buffer is exported."""
+        mask = pygame.mask.Mask((100, 10))
+
+        with memoryview(mask):
+            with self.assertRaises(BufferError):
+                mask.prepare_shifts()
+
+        mask.prepare_shifts()
+
     @unittest.skipIf(IS_PYPY, "Segfaults on pypy")
     def test_scale(self):
         """Ensure a mask can be scaled."""
@@ -1791,6 +1968,49 @@ class MaskTypeTest(unittest.TestCase):
         self.assertEqual(count, expected_count)
         self.assertEqual(mask.get_size(), expected_size)
 
+    def test_bulk_operations__tall_masks(self):
+        """Ensures draw, erase, overlap_mask, invert and count work on masks
+        tall enough to be processed many rows at a time.
+        """
+        size = (70, 37)
+        offsets = ((0, 0), (3, 5), (-35, -2), (64, 1), (-1, 30), (33, -30))
+
+        for offset in offsets:
+            msg = f"offset={offset}"
+            mask1 = random_mask(size)
+            mask2 = random_mask(size)
+            pixels1 = {
+                (x, y)
+                for x in range(size[0])
+                for y in range(size[1])
+                if mask1.get_at((x, y))
+            }
+            pixels2 = {
+                (x + offset[0], y + offset[1])
+                for x in range(size[0])
+                for y in range(size[1])
+                if mask2.get_at((x, y))
+            }
+            inside = {(x, y) for x in range(size[0]) for y in range(size[1])}
+
+            drawn = mask1.copy()
+            drawn.draw(mask2, offset)
+            erased = mask1.copy()
+            erased.erase(mask2, offset)
+            overlap = mask1.overlap_mask(mask2, offset)
+
+            for mask, expected in (
+                (drawn, (pixels1 | pixels2) & inside),
+                (erased, pixels1 - pixels2),
+                (overlap, pixels1 & pixels2),
+            ):
+                self.assertEqual(mask.count(), len(expected), msg)
+                for x, y in expected:
+                    self.assertEqual(mask.get_at((x, y)), 1, msg)
+
+            drawn.invert()
+            self.assertEqual(drawn.count(), len(inside - pixels1 - pixels2), msg)
+
     def test_centroid(self):
         """Ensure a filled mask's centroid is correctly calculated."""
         mask = pygame.mask.Mask((5, 7), fill=True)
@@ -1936,6 +2156,32 @@ class MaskTypeTest(unittest.TestCase):
         self.assertAlmostEqual(angle, expected_angle)
         self.assertEqual(mask.get_size(), expected_size)
 
+    def test_moments(self):
+        """Ensures moments matches the sums over the set bits."""
+        mask = pygame.mask.Mask((150, 7))
+        for x in range(150):
+            for y in range(7):
+                if (x * 7 + y * 13) % 5 < 2 or 64 <= x < 100:
+                    mask.set_at((x, y))
+        points = [
+            (x, y) for x in range(150) for y in range(7) if mask.get_at((x, y))
+        ]
+        expected_moments = (
+            len(points),
+            sum(x for x, y in points),
+            sum(y for x, y in points),
+            sum(x * x for x, y in points),
+            sum(x * y for x, y in points),
+            sum(y * y for x, y in points),
+        )
+
+        self.assertEqual(mask.moments(), expected_moments)
+        self.assertEqual(
+            mask.centroid(),
+            (expected_moments[1] // len(points), expected_moments[2] // len(points)),
+        )
+        self.assertEqual(pygame.mask.Mask((3, 4)).moments(), (0,) * 6)
+
     def test_drawing(self):
         """Test fill, clear, invert, draw, erase"""
         m = pygame.Mask((100, 100))
@@ -1977,6 +2223,59 @@ class MaskTypeTest(unittest.TestCase):
 
         # TODO: Test more corner case outlines.
 
+    def test_outline__epsilon(self):
+        """Ensures outline simplifies straight edges away."""
+        mask = pygame.Mask((40, 10))
+        mask.fill()
+
+        outline = mask.outline()
+        simplified = mask.outline(epsilon=0.5)
+
+        self.assertEqual(len(outline), 2 * (40 + 10) - 3)
+        self.assertEqual(simplified, [(0, 0), (39, 0), (39, 9), (0, 9), (0, 0)])
+        self.assertEqual(mask.outline(epsilon=0), outline)
+
+        for point in mask.outline(every=3, epsilon=2):
+            self.assertIn(point, outline[::3])
+
+        with self.assertRaises(ValueError):
+            mask.outline(epsilon=-1)
+
+    def test_outline__cached(self):
+        """Ensures a cached outline follows changes to the mask."""
+        mask = pygame.Mask((20, 20))
+        mask.set_at((10, 10))
+        self.assertEqual(mask.outline(), [(10, 10)])
+
+        for change, expected in (
+            (lambda: mask.set_at((11, 10)), [(10, 10), (11, 10), (10, 10)]),
+            (lambda: mask.draw(pygame.Mask((1, 1), fill=True), (0, 0)), [(0, 0)]),
+            (mask.invert, [(1, 0), (2, 0)]),
+            (mask.clear, []),
+        ):
+            change()
+            self.assertEqual(mask.outline()[:2], expected[:2])
+
+    def test_outline_points(self):
+        """Ensures outline_points returns the outline as an (n, 2) buffer."""
+        mask = pygame.Mask((20, 20))
+        points = mask.outline_points()
+
+        self.assertIsInstance(points, memoryview)
+        self.assertEqual(points.shape, (0, 2))
+
+        for pos in ((10, 10), (10, 12), (11, 11), (12, 11)):
+            mask.set_at(pos)
+
+        for kwargs in ({}, {"every": 2}, {"epsilon": 1}):
+            points = mask.outline_points(**kwargs)
+            expected = mask.outline(**kwargs)
+
+            self.assertEqual(points.format, "i")
+            self.assertEqual(points.shape, (len(expected), 2))
+            self.assertFalse(points.readonly)
+            self.assertEqual([tuple(p) for p in points.tolist()], expected)
+
     def test_convolve__size(self):
         sizes = [(1, 1), (31, 31), (32, 32), (100, 100)]
         for s1 in sizes:
@@ -2568,6 +2867,65 @@ class MaskTypeTest(unittest.TestCase):
             )
 
     @unittest.skipIf(IS_PYPY, "Segfaults on pypy")
+    def test_connected_components__random_masks(self):
+        """Ensures the components of random masks match a flood fill.
+
+        The masks are 1 to 3 words wide, so runs of set bits cross word
+        boundaries, and the components are ordered by their first bit.
+        """
+        random.seed(2)
+
+        for size in ((5, 5), (63, 7), (65, 9), (129, 16), (130, 40)):
+            for density in (0.2, 0.5, 0.8):
+                mask = pygame.mask.Mask(size)
+                points = set()
+                for y in range(size[1]):
+                    for x in range(size[0]):
+                        if random.random() < density:
+                            mask.set_at((x, y))
+                            points.add((x, y))
+
+                # Flood fill the points that are left, top to bottom.
+                components = []
+                for start in sorted(points, key=lambda pos: (pos[1], pos[0])):
+                    if start not in points:
+                        continue
+                    points.remove(start)
+                    component, todo = {start}, [start]
+                    while todo:
+                        x, y = todo.pop()
+                        for dx in (-1, 0, 1):
+                            for dy in (-1, 0, 1):
+                                if (x + dx, y + dy) in points:
+                                    points.remove((x + dx, y + dy))
+                                    component.add((x + dx, y + dy))
+                                    todo.append((x + dx, y + dy))
+                    components.append(component)
+
+                msg = f"size={size}, density={density}"
+                expected_rects = []
+                for component in components:
+                    xs = [x for x, _ in component]
+                    ys = [y for _, y in component]
+                    left, top = min(xs), min(ys)
+                    expected_rects.append(
+                        pygame.Rect(left, top, max(xs) - left + 1, max(ys) - top + 1)
+                    )
+                largest = max(components, key=len, default=())
+
+                self.assertEqual(mask.get_bounding_rects(), expected_rects, msg)
+                self.assertEqual(
+                    [m.count() for m in mask.connected_components()],
+                    [len(c) for c in components],
+                    msg,
+                )
+                self.assertEqual(mask.connected_component().count(), len(largest), msg)
+                for component in components[:3]:
+                    pos = min(component, key=lambda pos: (pos[1], pos[0]))
+                    cc_mask = mask.connected_component(pos)
+                    self.assertEqual(cc_mask.count(), len(component), msg)
+                    self.assertTrue(all(cc_mask.get_at(p) for p in component), msg)
+
     def test_to_surface(self):
         """Ensures empty and full masks can be drawn onto surfaces."""
         expected_ref_count = 3
@@ -5316,6 +5674,48 @@ class MaskTypeTest(unittest.TestCase):
         self.assertEqual(to_surface.get_size(), mask_size)
         assertSurfaceFilled(self, to_surface, expected_color)
 
+    def test_to_surface__colors_word_at_a_time(self):
+        """Ensures drawing with colors matches the mask bits at any offset.
+
+        Covers rows with runs of set and unset bits longer than a mask word
+        as well as mixed words, drawn at offsets that split the words.
+        """
+        setcolor = pygame.Color(10, 20, 30, 40)
+        unsetcolor = pygame.Color(50, 60, 70, 80)
+        fillcolor = pygame.Color(1, 2, 3, 4)
+        mask = pygame.mask.Mask((150, 3))
+        for x in range(150):
+            if x % 3 == 0:
+                mask.set_at((x, 0))
+            if 40 <= x < 110:
+                mask.set_at((x, 1))
+            if x % 70 > 7:
+                mask.set_at((x, 2))
+
+        for dest in ((0, 0), (5, 1), (-37, 0), (-1, -1)):
+            for draw_unset in (True, False):
+                msg = f"dest={dest}, draw_unset={draw_unset}"
+                surface = pygame.Surface((140, 3), SRCALPHA, 32)
+                surface.fill(fillcolor)
+
+                mask.to_surface(
+                    surface,
+                    setcolor=setcolor,
+                    unsetcolor=unsetcolor if draw_unset else None,
+                    dest=dest,
+                )
+
+                for y in range(3):
+                    for x in range(140):
+                        pos = (x - dest[0], y - dest[1])
+                        if not (0 <= pos[0] < 150 and 0 <= pos[1] < 3):
+                            expected = fillcolor
+                        elif mask.get_at(pos):
+                            expected = setcolor
+                        else:
+                            expected = unsetcolor if draw_unset else fillcolor
+                        self.assertEqual(surface.get_at((x, y)), expected, msg)
+
     def test_zero_mask(self):
         """Ensures masks can be created with zero sizes."""
         for size in ((100, 0), (0, 100), (0, 0)):
@@ -6322,6 +6722,118 @@ class MaskModuleTest(unittest.TestCase):
                 mask.overlap_area(expected_mask, offset), expected_count, msg
             )
 
+    def test_from_surface__wide_surfaces(self):
+        """Ensures from_surface sets the correct bits for surfaces that span
+        several mask words per row, with and without a colorkey.
+        """
+        rng = random.Random(27)
+        size = (203, 5)
+        colorkey = (50, 60, 70)
+
+        for depth in (16, 24, 32):
+            for use_colorkey in (False, True):
+                msg = f"depth={depth}, colorkey={use_colorkey}"
+                flags = 0 if use_colorkey or depth == 24 else SRCALPHA
+                surface = pygame.Surface(size, flags, depth)
+                for y in range(size[1]):
+                    for x in range(size[0]):
+                        if use_colorkey and rng.random() < 0.5:
+                            color = colorkey
+                        else:
+                            color = [rng.randrange(256) for _ in range(4)]
+                        surface.set_at((x, y), color)
+                if use_colorkey:
+                    surface.set_colorkey(colorkey)
+                    key = surface.get_colorkey()
+
+                mask = pygame.mask.from_surface(surface, 100)
+
+                for y in range(size[1]):
+                    for x in range(size[0]):
+                        color = surface.get_at((x, y))
+                        if use_colorkey:
+                            expected = int(color != key)
+                        else:
+                            expected = int(color.a > 100)
+                        self.assertEqual(mask.get_at((x, y)), expected, msg)
+
+    def test_from_surface__rect(self):
+        """Ensures from_surface with a rect creates the same mask as from the
+        subsurface of that rect.
+        """
+        rng = random.Random(2)
+        size = (150, 20)
+        rects = ((0, 0, 150, 20), (3, 2, 100, 7), (65, 0, 70, 20), (9, 9, 0, 4))
+
+        for depth in (8, 16, 32):
+            flags = SRCALPHA if depth == 32 else 0
+            surface = pygame.Surface(size, flags, depth)
+            for y in range(size[1]):
+                for x in range(size[0]):
+                    color = [rng.randrange(256) for _ in range(4)]
+                    surface.set_at((x, y), color)
+            if depth != 32:
+                surface.set_colorkey(surface.get_at((0, 0)))
+
+            for rect in rects:
+                msg = f"depth={depth}, rect={rect}"
+                expected_mask = pygame.mask.from_surface(surface.subsurface(rect))
+
+                mask = pygame.mask.from_surface(surface, rect=pygame.Rect(rect))
+
+                self.assertEqual(mask.get_size(), expected_mask.get_size(), msg)
+                self.assertEqual(mask.count(), expected_mask.count(), msg)
+                self.assertEqual(
+                    mask.overlap_area(expected_mask, (0, 0)), mask.count(), msg
+                )
+
+    def test_from_surface__invalid_rect(self):
+        """Ensures from_surface rejects rects outside of the surface."""
+        surface = pygame.Surface((10, 10), SRCALPHA, 32)
+
+        for rect in ((-1, 0, 5, 5), (6, 0, 5, 5), (0, 6, 5, 5), (0, 0, 11, 1)):
+            with self.assertRaises(ValueError):
+                pygame.mask.from_surface(surface, rect=rect)
+
+        with self.assertRaises(ValueError):
+            pygame.mask.from_surface(surface, rect=(5, 5, -1, 2))
+
+        with self.assertRaises(TypeError):
+            pygame.mask.from_surface(surface, rect="rect")
+
+    def test_from_threshold__wide_surfaces(self):
+        """Ensures from_threshold sets the correct bits for surfaces that span
+        several mask words per row.
+        """
+        rng = random.Random(3)
+        size = (197, 4)
+        color = (100, 50, 200)
+        threshold = (30, 40, 50, 255)
+
+        # Only depths without channel loss, so get_at() returns the values
+        # that are compared.
+        for depth in (24, 32):
+            surface = pygame.Surface(size, 0, depth)
+            othersurface = pygame.Surface(size, 0, depth)
+            for y in range(size[1]):
+                for x in range(size[0]):
+                    near = [max(0, min(255, c + rng.randrange(-60, 61))) for c in color]
+                    surface.set_at((x, y), near)
+                    near = [max(0, min(255, c + rng.randrange(-60, 61))) for c in color]
+                    othersurface.set_at((x, y), near)
+
+            for other in (None, othersurface):
+                msg = f"depth={depth}, othersurface={other is not None}"
+                mask = pygame.mask.from_threshold(surface, color, threshold, other)
+
+                for y in range(size[1]):
+                    for x in range(size[0]):
+                        pixel = surface.get_at((x, y))
+                        base = color if other is None else other.get_at((x, y))
+                        diffs = [abs(pixel[i] - base[i]) for i in range(3)]
+                        expected = int(all(d < t for d, t in zip(diffs, threshold)))
+                        self.assertEqual(mask.get_at((x, y)), expected, msg)
+
     def test_from_threshold(self):
         """Does mask.from_threshold() work correctly?"""
 
@@ -6356,6 +6868,43 @@ class MaskModuleTest(unittest.TestCase):
             self.assertEqual(mask.count(), 100)
             self.assertEqual(mask.get_bounding_rects(), [pygame.Rect((40, 40, 10, 10))])
 
+    def test_connected_components_threads(self):
+        """Threaded labelling gives the same components as single threaded"""
+        random.seed(3)
+        mask = pygame.mask.Mask((700, 650))
+        for _ in range(3000):
+            mask.draw(
+                random_mask((random.randint(1, 9), random.randint(1, 9))),
+                (random.randrange(700), random.randrange(650)),
+            )
+        old_threads = pygame.mask.get_connected_components_threads()
+        self.assertEqual(old_threads, 1)
+
+        results = []
+        try:
+            for threads in (1, 3, 4):
+                pygame.mask.set_connected_components_threads(threads)
+                self.assertEqual(
+                    pygame.mask.get_connected_components_threads(), threads
+                )
+                components = mask.connected_components()
+                results.append(
+                    (
+                        mask.get_bounding_rects(),
+                        [(c.count(), c.get_bounding_rects()) for c in components],
+                        mask.connected_component().get_bounding_rects(),
+                    )
+                )
+                self.assertEqual(results[-1], results[0])
+
+            pygame.mask.set_connected_components_threads(0)
+            self.assertGreaterEqual(pygame.mask.get_connected_components_threads(), 1)
+        finally:
+            pygame.mask.set_connected_components_threads(old_threads)
+
+        self.assertRaises(ValueError, pygame.mask.set_connected_components_threads, -1)
+        self.assertRaises(TypeError, pygame.mask.set_connected_components_threads, "2")
+
     def test_zero_size_from_surface(self):
         """Ensures from_surface can create masks from zero sized surfaces."""
         for size in ((100, 0), (0, 100), (0, 0)):
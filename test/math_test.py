@@ -1,10 +1,11 @@
+import array
 import math
 import platform
 import unittest
 from collections.abc import Collection, Sequence
 
 import pygame.math
-from pygame.math import Vector2, Vector3
+from pygame.math import Vector2, Vector2Array, Vector3
 
 IS_PYPY = "PyPy" == platform.python_implementation()
 
@@ -200,6 +201,58 @@ class MathModuleTest(unittest.TestCase):
         b = 10.0
         self.assertEqual(pygame.math.smoothstep(a, b, 0.5), 0.0)
 
+    def test_noise(self):
+        for kind in ("value", "perlin", "simplex"):
+            values = [
+                pygame.math.noise(x * 0.37, y * 0.29, kind=kind, octaves=3)
+                for x in range(-20, 20)
+                for y in range(-20, 20)
+            ]
+            self.assertTrue(all(-1.0 <= v <= 1.0 for v in values))
+            self.assertGreater(max(values) - min(values), 0.5)
+            self.assertEqual(
+                pygame.math.noise(1.25, 2.5, kind=kind, seed=3),
+                pygame.math.noise(1.25, 2.5, kind=kind, seed=3),
+            )
+            self.assertNotEqual(
+                pygame.math.noise(1.25, 2.5, kind=kind, seed=3),
+                pygame.math.noise(1.25, 2.5, kind=kind, seed=4),
+            )
+
+        with self.assertRaises(ValueError):
+            pygame.math.noise(0, 0, kind="cellular")
+        with self.assertRaises(ValueError):
+            pygame.math.noise(0, 0, octaves=0)
+
+    def test_noise_fill(self):
+        width, height = 37, 23
+        values = array.array("f", bytes(4 * width * height))
+        dest = memoryview(values).cast("B").cast("f", (height, width))
+        pygame.math.noise_fill(
+            dest, kind="simplex", frequency=0.1, offset=(5, -3), octaves=2
+        )
+        for y in range(height):
+            for x in range(width):
+                expected = pygame.math.noise(
+                    (x + 5) * 0.1, (y - 3) * 0.1, kind="simplex", octaves=2
+                )
+                self.assertAlmostEqual(values[y * width + x], expected, 4)
+
+        surf = pygame.Surface((width, height), 0, 32)
+        surf.fill((1, 2, 3, 4))
+        pygame.math.noise_fill(surf, channel=1, frequency=0.1, offset=(5, -3))
+        pygame.math.noise_fill(dest, frequency=0.1, offset=(5, -3))
+        for y in range(height):
+            for x in range(width):
+                r, g, b, _ = surf.get_at((x, y))
+                self.assertEqual((r, b), (1, 3))
+                self.assertEqual(g, int((values[y * width + x] + 1) * 127.5 + 0.5))
+
+        with self.assertRaises(ValueError):
+            pygame.math.noise_fill(dest, channel=0)
+        with self.assertRaises(ValueError):
+            pygame.math.noise_fill(memoryview(bytearray(8)))
+
 
 class Vector2TypeTest(unittest.TestCase):
     def setUp(self):
@@ -2778,6 +2831,22 @@ class Vector3TypeTest(unittest.TestCase):
         with self.assertRaises(AttributeError):
             v.xyz
 
+    def test_swizzle_like_attributes(self):
+        """Names that only start like a swizzle are plain attributes."""
+
+        class Vector(Vector2):
+            pass
+
+        v = Vector(7, 6)
+        v.xylophone = 1
+        v.wx = 2
+        v.x_ü = 3
+        self.assertEqual((v.xylophone, v.wx, v.x_ü), (1, 2, 3))
+        self.assertEqual(v.yx, Vector2(6, 7))
+        self.assertEqual(v.length_squared(), 85)
+        with self.assertRaises(AttributeError):
+            v.xyq
+
     @unittest.skipIf(IS_PYPY, "known pypy failure")
     def test_swizzle_set_oob(self):
         """An out-of-bounds swizzle set raises an AttributeError."""
@@ -3073,5 +3142,169 @@ class Vector3TypeTest(unittest.TestCase):
         self.assertRaises(TypeError, origin.move_towards_ip, "d", 3)
 
 
+class Vector2ArrayTypeTest(unittest.TestCase):
+    def setUp(self):
+        self.a = Vector2Array([(1, 2), Vector2(3, 4), [-5, 6]])
+
+    def test_construction(self):
+        self.assertEqual(len(Vector2Array()), 0)
+
+        zeros = Vector2Array(4)
+        self.assertEqual(len(zeros), 4)
+        self.assertEqual(list(zeros), [Vector2()] * 4)
+
+        self.assertEqual(list(self.a), [Vector2(1, 2), (3, 4), (-5, 6)])
+
+        copy = Vector2Array(self.a)
+        self.assertEqual(copy, self.a)
+        copy[0] = (0, 0)
+        self.assertNotEqual(copy, self.a)
+
+        self.assertRaises(ValueError, Vector2Array, -1)
+        self.assertRaises(TypeError, Vector2Array, [(1, 2, 3)])
+        self.assertRaises(TypeError, Vector2Array, [1, 2])
+        self.assertRaises(TypeError, Vector2Array, "ab")
+
+    def test_buffer_construction(self):
+        flat = memoryview(bytearray(32)).cast("d")
+        flat[0], flat[1], flat[2], flat[3] = 1.0, 2.0, 3.0, 4.0
+        self.assertEqual(list(Vector2Array(flat)), [(1, 2), (3, 4)])
+
+        shaped = flat.cast("B").cast("d", (2, 2))
+        self.assertEqual(list(Vector2Array(shaped)), [(1, 2), (3, 4)])
+
+        odd = memoryview(bytearray(24)).cast("d")
+        self.assertRaises(ValueError, Vector2Array, odd)
+
+    def test_getitem(self):
+        self.assertIsInstance(self.a[0], Vector2)
+        self.assertEqual(self.a[1], (3, 4))
+        self.assertEqual(self.a[-1], (-5, 6))
+        self.assertRaises(IndexError, lambda: self.a[3])
+
+        # items are copies
+        v = self.a[0]
+        v.x = 10
+        self.assertEqual(self.a[0], (1, 2))
+
+        sliced = self.a[::2]
+        self.assertIsInstance(sliced, Vector2Array)
+        self.assertEqual(list(sliced), [(1, 2), (-5, 6)])
+
+    def test_setitem(self):
+        self.a[0] = Vector2(7, 8)
+        self.assertEqual(self.a[0], (7, 8))
+        self.a[-1] = (1, 1)
+        self.assertEqual(self.a[2], (1, 1))
+
+        self.a[:2] = (0, 0)
+        self.assertEqual(list(self.a), [(0, 0), (0, 0), (1, 1)])
+
+        self.a[1:] = [(2, 3), (4, 5)]
+        self.assertEqual(list(self.a), [(0, 0), (2, 3), (4, 5)])
+
+        self.a[:] = Vector2Array(3)
+        self.assertEqual(list(self.a), [(0, 0)] * 3)
+
+        def set_item(index, value):
+            self.a[index] = value
+
+        self.assertRaises(IndexError, set_item, 3, (0, 0))
+        self.assertRaises(TypeError, set_item, 0, (1, 2, 3))
+        self.assertRaises(ValueError, set_item, slice(0, 2), [(1, 1)])
+
+        def del_item():
+            del self.a[0]
+
+        self.assertRaises(TypeError, del_item)
+
+    def test_arithmetic(self):
+        b = Vector2Array([(1, 1), (2, 2), (3, 3)])
+
+        self.assertEqual(list(self.a + b), [(2, 3), (5, 6), (-2, 9)])
+        self.assertEqual(list(self.a - b), [(0, 1), (1, 2), (-8, 3)])
+        self.assertEqual(list(self.a + (1, 0)), [(2, 2), (4, 4), (-4, 6)])
+        self.assertEqual(list((1, 0) + self.a), [(2, 2), (4, 4), (-4, 6)])
+        self.assertEqual(list((0, 0) - self.a), [(-1, -2), (-3, -4), (5, -6)])
+        self.assertEqual(list(self.a * 2), [(2, 4), (6, 8), (-10, 12)])
+        self.assertEqual(list(2 * self.a), [(2, 4), (6, 8), (-10, 12)])
+        self.assertEqual(list(self.a / 2), [(0.5, 1), (1.5, 2), (-2.5, 3)])
+        self.assertEqual(-self.a, self.a * -1)
+        self.assertEqual(+self.a, self.a)
+
+        self.assertRaises(ValueError, lambda: self.a + Vector2Array(2))
+        self.assertRaises(TypeError, lambda: self.a * self.a)
+        self.assertRaises(ZeroDivisionError, lambda: self.a / 0)
+
+    def test_inplace_arithmetic(self):
+        a = self.a
+        a += Vector2(1, 1)
+        a *= 2
+        a -= Vector2Array([(2, 2)] * 3)
+        a /= 4
+        self.assertIs(a, self.a)
+        self.assertEqual(list(a), [(0.5, 1), (1.5, 2), (-2.5, 3)])
+
+    def test_length(self):
+        a = Vector2Array([(3, 4), (0, 0), (-6, 8)])
+        self.assertEqual(a.length(), [5, 0, 10])
+        self.assertEqual(a.length_squared(), [25, 0, 100])
+
+    def test_dot_and_distance(self):
+        self.assertEqual(self.a.dot((1, 0)), [1, 3, -5])
+        self.assertEqual(self.a.dot(self.a), [5, 25, 61])
+        self.assertEqual(self.a.distance_squared_to((1, 2)), [0, 8, 52])
+        self.assertEqual(self.a.distance_to(self.a), [0, 0, 0])
+        self.assertRaises(ValueError, self.a.dot, Vector2Array(1))
+
+    def test_normalize(self):
+        a = Vector2Array([(3, 4), (0, -2)])
+        normalized = a.normalize()
+        self.assertEqual(list(a), [(3, 4), (0, -2)])
+        for v, expected in zip(normalized, [(0.6, 0.8), (0, -1)]):
+            self.assertAlmostEqual(v.x, expected[0])
+            self.assertAlmostEqual(v.y, expected[1])
+
+        a.normalize_ip()
+        self.assertEqual(a, normalized)
+
+        zero = Vector2Array([(1, 0), (0, 0)])
+        self.assertRaises(ValueError, zero.normalize)
+        self.assertRaises(ValueError, zero.normalize_ip)
+        self.assertEqual(list(zero), [(1, 0), (0, 0)])
+
+    def test_rotate(self):
+        rotated = self.a.rotate(33)
+        for v, r in zip(self.a, rotated):
+            expected = v.rotate(33)
+            self.assertAlmostEqual(r.x, expected.x)
+            self.assertAlmostEqual(r.y, expected.y)
+
+        self.a.rotate_ip(90)
+        self.assertEqual(list(self.a), [(-2, 1), (-4, 3), (-6, -5)])
+
+    def test_lerp(self):
+        b = Vector2Array([(3, 4), (3, 4), (3, 4)])
+        self.assertEqual(list(self.a.lerp(b, 0)), list(self.a))
+        self.assertEqual(list(self.a.lerp((3, 4), 1)), [(3, 4)] * 3)
+        self.assertEqual(list(self.a.lerp(b, 0.5)), [(2, 3), (3, 4), (-1, 5)])
+        self.assertRaises(ValueError, self.a.lerp, b, 1.5)
+
+    def test_buffer(self):
+        view = memoryview(self.a)
+        self.assertEqual(view.format, "d")
+        self.assertEqual(view.shape, (3, 2))
+        self.assertEqual(view.strides, (16, 8))
+        self.assertEqual(view.tolist(), [[1, 2], [3, 4], [-5, 6]])
+
+        view[1, 0] = 10.0
+        self.assertEqual(self.a[1], (10, 4))
+
+        self.assertRaises(BufferError, self.a.__init__, 2)
+        view.release()
+        self.a.__init__(2)
+        self.assertEqual(len(self.a), 2)
+
+
 if __name__ == "__main__":
     unittest.main()
@@ -1,4 +1,5 @@
 import unittest
+from array import array
 
 
 import pygame
@@ -62,6 +63,33 @@ class MidiInputTest(unittest.TestCase):
         # set midi_input to None to avoid error in tearDown
         self.midi_input = None
 
+    def test_read_into(self):
+        if not self.midi_input:
+            self.skipTest("No midi Input device")
+
+        buffer = array("i", [-1] * 10)
+        self.assertEqual(self.midi_input.read_into(buffer), 0)
+        self.assertEqual(list(buffer), [-1] * 10)
+        self.assertRaises(ValueError, self.midi_input.read_into, array("i", [0]))
+        self.assertRaises(TypeError, self.midi_input.read_into, bytes(8))
+
+    def test_start_posting(self):
+        if not self.midi_input:
+            self.skipTest("No midi Input device")
+
+        self.midi_input.start_posting(interval=1)
+        # restarting replaces the thread
+        self.midi_input.start_posting(interval=5)
+        pygame.time.wait(20)
+        self.midi_input.stop_posting()
+        self.midi_input.stop_posting()
+
+        # close() and quit() stop the thread too
+        self.midi_input.start_posting()
+        self.midi_input.close()
+        self.assertIsNone(self.midi_input._post_thread)
+        self.midi_input = None
+
     def test_close(self):
         if not self.midi_input:
             self.skipTest("No midi Input device")
@@ -176,6 +204,20 @@ class MidiOutputTest(unittest.TestCase):
             out.write(["Hey what's that?"])
         self.assertEqual(str(cm.exception), error_msg)
 
+    def test_write_from(self):
+        if not self.midi_output:
+            self.skipTest("No midi device")
+
+        out = self.midi_output
+        # program change, then a note on and off 500 ms apart
+        out.write_from(array("i", [20000, 0x00C0, 20000, 0x644190, 20500, 0x644180]))
+        # read only buffers and more than 1024 events work
+        out.write_from(bytes(array("i", [20000, 0x00C0] * 2000)))
+        out.write_from(array("i"))
+
+        self.assertRaises(ValueError, out.write_from, array("i", [20000]))
+        self.assertRaises(TypeError, out.write_from, array("d", [20000, 0xC0]))
+
     def test_write_short(self):
         if not self.midi_output:
             self.skipTest("No midi device")
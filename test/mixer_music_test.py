@@ -262,6 +262,22 @@ class MixerMusicModuleTest(unittest.TestCase):
         pygame.mixer.music.queue(wav_file, "")
         pygame.mixer.music.queue(wav_file, "", 2)
 
+    def test_queue__fade_ms(self):
+        """Ensures queue() takes fade_ms and survives replacing a track
+        that is still being read ahead."""
+        ogg_file = example_path(os.path.join("data", "house_lo.ogg"))
+        wav_file = example_path(os.path.join("data", "house_lo.wav"))
+
+        pygame.mixer.music.load(wav_file)
+        pygame.mixer.music.play()
+        pygame.mixer.music.queue(ogg_file, fade_ms=200)
+        pygame.mixer.music.queue(wav_file, "", 0, 200)
+        time.sleep(0.1)
+        self.assertTrue(pygame.mixer.music.get_busy())
+        pygame.mixer.music.stop()
+        pygame.mixer.music.queue(ogg_file, fade_ms=-1)
+        pygame.mixer.music.unload()
+
     def test_queue__no_file(self):
         """Ensures queue() correctly handles missing the file argument."""
         with self.assertRaises(TypeError):
@@ -406,6 +406,25 @@ class MixerModuleTest(unittest.TestCase):
         self.assertEqual(d["strides"], (2,))
         self.assertEqual(d["data"], (snd._samples_address, False))
 
+    def test_array_keyword__float(self):
+        """Float samples are scaled to the mixer format."""
+        import array
+        import struct
+
+        mixer.init(22050, -16, 1, allowedchanges=0)
+        samples = array.array("f", [0.0, 0.5, -0.5, 1.0, -1.0, 2.0, -2.0])
+        raw = mixer.Sound(array=samples).get_raw()
+        self.assertEqual(
+            struct.unpack("=7h", raw), (0, 16383, -16383, 32767, -32767, 32767, -32768)
+        )
+        raw = mixer.Sound(array=array.array("d", samples)).get_raw()
+        self.assertEqual(struct.unpack("=7h", raw)[:3], (0, 16383, -16383))
+        mixer.quit()
+
+        mixer.init(22050, 32, 1, allowedchanges=0)
+        raw = mixer.Sound(array=array.array("h", [0, 16384, -32768])).get_raw()
+        self.assertEqual(struct.unpack("=3f", raw), (0.0, 0.5, -1.0))
+
     @unittest.skipIf(IS_PYPY, "pypy no likey")
     def test_newbuf__one_channel(self):
         mixer.init(22050, -16, 1)
@@ -784,6 +803,61 @@ class ChannelTypeTest(unittest.TestCase):
         """Ensure an active channel's busy state is correct."""
         self.fail()
 
+    def test_set_dsp(self):
+        """Ensure a channel effect chain can be set, updated and removed."""
+        channel = mixer.Channel(0)
+        sound = mixer.Sound(buffer=b"\x00\x40" * 4096)
+
+        channel.set_dsp(gain=0.5, ramp_ms=10, filter="lowpass", cutoff=2000)
+        channel.set_dsp(threshold=-6.0, ratio=2.0, reverb=0.3)
+        channel.play(sound)
+        channel.set_dsp(filter=None, threshold=None)
+        channel.stop()
+        channel.reset_dsp()
+        channel.reset_dsp()
+
+        with self.assertRaises(ValueError):
+            channel.set_dsp(filter="bandpass")
+        with self.assertRaises(ValueError):
+            channel.set_dsp(reverb=2.0)
+        with self.assertRaises(TypeError):
+            channel.set_dsp(0.5)
+
+    def test_set_output_callback(self):
+        """Ensure the output tap accepts buffers, callables and None."""
+        frames, ticks = mixer.get_output_position()
+        self.assertIsInstance(frames, int)
+        self.assertIsInstance(ticks, float)
+        self.assertGreaterEqual(frames, 0)
+
+        freq, fmt, channels = mixer.get_init()
+        frame_size = abs(fmt) // 8 * channels
+        ring = bytearray(frame_size * 1024)
+        mixer.set_output_callback(ring)
+        with self.assertRaises(BufferError):
+            ring.append(0)  # locked while installed
+        mixer.set_output_callback(lambda block, frame: None)
+        ring.append(0)
+        mixer.set_output_callback(None)
+
+        self.assertGreaterEqual(mixer.get_output_position()[0], frames)
+
+        with self.assertRaises(ValueError):
+            mixer.set_output_callback(bytearray(frame_size + 1))
+        with self.assertRaises(TypeError):
+            mixer.set_output_callback(b"read only")
+        with self.assertRaises(TypeError):
+            mixer.set_output_callback(1)
+
+    def test_set_dsp__master(self):
+        """Ensure the master bus effect chain can be set and removed."""
+        mixer.set_dsp(gain=0.8, filter="highpass", cutoff=80)
+        mixer.set_dsp(reverb=0.1)
+        mixer.reset_dsp()
+
+        with self.assertRaises(ValueError):
+            mixer.set_dsp(ratio=0.5)
+
     def todo_test_get_endevent(self):
         # __doc__ (as of 2008-08-02) for pygame.mixer.Channel.get_endevent:
 
@@ -1179,6 +1253,38 @@ class SoundTypeTest(unittest.TestCase):
             with self.assertRaisesRegex(pygame.error, "mixer not initialized"):
                 sound.get_num_channels()
 
+    def test_play_voice_limits(self):
+        """Tests priorities, instance limits and culling of Sound.play."""
+        try:
+            filename = example_path(os.path.join("data", "house_lo.wav"))
+            sound = mixer.Sound(file=filename)
+            other = mixer.Sound(file=filename)
+            mixer.set_num_channels(4)
+
+            self.assertEqual(sound.get_max_instances(), 0)
+            sound.set_max_instances(2)
+            self.assertEqual(sound.get_max_instances(), 2)
+            for _ in range(3):
+                self.assertIsNotNone(sound.play(loops=-1, priority=1))
+            self.assertEqual(sound.get_num_channels(), 2)
+
+            # the two free channels, then no lower priority left to take over
+            self.assertIsNotNone(other.play(loops=-1, priority=1))
+            self.assertIsNotNone(other.play(loops=-1, priority=1))
+            self.assertIsNone(other.play(loops=-1, priority=1))
+            self.assertIsNotNone(other.play(loops=-1, priority=2))
+            self.assertEqual(sound.get_num_channels(), 1)
+
+            mixer.stop()
+            mixer.set_cull_distance(200)
+            self.assertIsNone(other.play(distance=210))
+            self.assertIsNotNone(other.play(distance=100))
+            mixer.set_cull_distance(None)
+            self.assertRaises(ValueError, other.play, distance=300)
+            self.assertRaises(ValueError, sound.set_max_instances, -1)
+        finally:
+            pygame.mixer.quit()
+
     def test_get_volume(self):
         """Ensure a sound's volume can be retrieved."""
         try:
@@ -1298,6 +1404,68 @@ class SoundTypeTest(unittest.TestCase):
             with self.assertRaisesRegex(pygame.error, "mixer not initialized"):
                 snd.get_raw()
 
+    def test_buffer_no_copy(self):
+        """Ensure Sound(buffer=..., copy=False) shares the exporter's memory."""
+        samples = bytearray(b"abcdefgh")  # keep byte size a multiple of 4
+        snd = mixer.Sound(buffer=samples, copy=False)
+        self.assertEqual(snd.get_raw(), bytes(samples))
+
+        samples[0:4] = b"\x00\x00\x00\x00"
+        self.assertEqual(snd.get_raw(), bytes(samples))
+
+        # The Sound holds the bytearray's buffer, so it cannot be resized.
+        with self.assertRaises(BufferError):
+            samples.extend(b"ijkl")
+
+        del snd
+        samples.extend(b"ijkl")
+
+        ro = mixer.Sound(buffer=b"abcdefgh", copy=False)
+        self.assertTrue(memoryview(ro).readonly)
+
+        with self.assertRaises(ValueError):
+            mixer.Sound(buffer=b"abc", copy=False)
+        with self.assertRaises(ValueError):
+            mixer.Sound(array=ro, copy=False)
+        with self.assertRaises(TypeError):
+            mixer.Sound(buffer=b"abcd", copy=False, unknown=1)
+
+    def test_sound_mmap(self):
+        """Ensure Sound(file, mmap=True) plays matching WAVs from the file."""
+        import tempfile
+        import wave
+
+        freq, fmt, channels = mixer.get_init()
+        if fmt != -16:
+            self.skipTest("mixer is not in a 16 bit format")
+        frames = bytes(range(256)) * 4
+        with tempfile.TemporaryDirectory() as tmpdir:
+            path = os.path.join(tmpdir, "mapped.wav")
+            with wave.open(path, "wb") as w:
+                w.setnchannels(channels)
+                w.setsampwidth(2)
+                w.setframerate(freq)
+                w.writeframes(frames)
+
+            snd = mixer.Sound(path, mmap=True)
+            self.assertEqual(snd.get_raw(), frames)
+            self.assertTrue(memoryview(snd).readonly)
+            del snd
+
+            # other formats are decoded as usual
+            other = os.path.join(tmpdir, "other.wav")
+            with wave.open(other, "wb") as w:
+                w.setnchannels(channels)
+                w.setsampwidth(1)
+                w.setframerate(freq)
+                w.writeframes(frames)
+            snd = mixer.Sound(file=pathlib.Path(other), mmap=True)
+            self.assertFalse(memoryview(snd).readonly)
+            del snd
+
+        with self.assertRaises(ValueError):
+            mixer.Sound(buffer=frames, mmap=True)
+
     def test_correct_subclassing(self):
         class CorrectSublass(mixer.Sound):
             def __init__(self, file):
@@ -990,6 +990,24 @@ class PixelArrayTypeTest(unittest.TestCase, TestMixin):
         self.assertEqual(w2, w)
         self.assertEqual(h2, h_slice)
 
+    def test_make_surface__views(self):
+        """Ensures make_surface copies transposed and flipped views of the
+        whole surface as they are seen through the array."""
+        for bpp in (8, 16, 24, 32):
+            sf = pygame.Surface((37, 37), 0, bpp)
+            ar = pygame.PixelArray(sf)
+            for x in range(37):
+                for y in range(37):
+                    ar[x, y] = sf.map_rgb(((x * 7) % 256, (y * 5) % 256, 0))
+
+            for view in (ar.transpose(), ar[::-1, :], ar[:, ::-1], ar[:, 3:]):
+                newsf = view.make_surface()
+                w, h = view.shape
+                self.assertEqual(newsf.get_size(), (w, h))
+                for x in range(w):
+                    for y in range(h):
+                        self.assertEqual(newsf.get_at_mapped((x, y)), view[x, y])
+
     def test_make_surface__subclassed_surface(self):
         """Ensure make_surface can handle subclassed surfaces."""
         expected_size = (3, 5)
@@ -1072,6 +1090,55 @@ class PixelArrayTypeTest(unittest.TestCase, TestMixin):
             self.assertEqual(newar[9][9], black)
         # print("extract end")
 
+    def test_exact_color_32bpp_rows(self):
+        """Exact matches on 32 bit rows, contiguous or not"""
+        sf = pygame.Surface((70, 4), 0, 32)
+        sf.fill((0, 0, 255))
+        for x in (0, 33, 69):
+            sf.set_at((x, 1), (255, 0, 0))
+        red = sf.map_rgb((255, 0, 0))
+        blue = sf.map_rgb((0, 0, 255))
+        green = sf.map_rgb((0, 255, 0))
+        white = sf.map_rgb((255, 255, 255))
+        black = sf.map_rgb((0, 0, 0))
+
+        ar = pygame.PixelArray(sf)
+        self.assertTrue((255, 0, 0) in ar)
+        self.assertTrue((255, 0, 0) in ar[60:, 1:2])
+        self.assertFalse((255, 0, 0) in ar[34:69])
+        self.assertFalse((255, 0, 0) in ar[2::2])
+        self.assertTrue((255, 0, 0) in ar[1::2])
+        self.assertTrue((255, 0, 0) in ar[::3])
+
+        other = sf.copy()
+        other.set_at((33, 1), (0, 0, 255))
+        extracted = ar.extract((255, 0, 0))
+        compared = ar.compare(pygame.PixelArray(other))
+        for x in range(70):
+            for y in range(4):
+                is_red = ar[x, y] == red
+                self.assertEqual(extracted[x, y], white if is_red else black)
+                changed = (x, y) == (33, 1)
+                self.assertEqual(compared[x, y], black if changed else white)
+        del extracted, compared
+
+        ar[::2].replace((255, 0, 0), (0, 255, 0))
+        self.assertEqual(ar[0, 1], green)
+        self.assertEqual(ar[69, 1], red)
+        ar.replace((255, 0, 0), (0, 255, 0))
+        self.assertEqual(ar[33, 1], green)
+        self.assertEqual(ar[69, 1], green)
+        self.assertEqual(ar[5, 1], blue)
+
+        ar[10:13] = [(1, 2, 3), (4, 5, 6), (7, 8, 9)]
+        ar[13:10:-1] = [red, green, blue]
+        for y in range(4):
+            self.assertEqual(ar[10, y], sf.map_rgb((1, 2, 3)))
+            self.assertEqual(ar[12, y], green)
+            self.assertEqual(ar[13, y], red)
+            self.assertEqual(ar[11, y], blue)
+        ar.close()
+
     def test_2dslice_assignment(self):
         w = 2 * 5 * 8
         h = 3 * 5 * 9
@@ -532,6 +532,41 @@ class PixelCopyTestWithArrayNumpy(unittest.TestCase):
                     % (r_arr, r_surf, surf.get_flags(), surf.get_bitsize(), posn),
                 )
 
+    def test_surface_to_array_32bit_layouts(self):
+        """32 bit surfaces into uint8 and uint32 arrays of either axis order"""
+        try:
+            from numpy import empty, uint8, uint32
+        except ImportError:
+            return
+
+        w, h = 37, 41
+        for flags in (0, SRCALPHA):
+            surf = pygame.Surface((w, h), flags, 32)
+            for x in range(w):
+                for y in range(h):
+                    surf.set_at((x, y), (x * 7 % 256, y * 5 % 256, x ^ y, x + y))
+
+            rgb = empty((w, h, 3), uint8)
+            rgb_t = empty((h, w, 3), uint8).transpose(1, 0, 2)
+            mapped = empty((w, h), uint32)
+            mapped_t = empty((h, w), uint32).T
+            red = empty((w, h), uint8)
+            alpha = empty((w, h), uint8)
+            for dst in (rgb, rgb_t, mapped, mapped_t):
+                surface_to_array(dst, surf)
+            surface_to_array(red, surf, "R")
+            surface_to_array(alpha, surf, "A")
+
+            for x in range(w):
+                for y in range(h):
+                    color = surf.get_at((x, y))
+                    self.assertEqual(tuple(rgb[x, y]), tuple(color)[:3])
+                    self.assertEqual(tuple(rgb_t[x, y]), tuple(color)[:3])
+                    self.assertEqual(mapped[x, y], surf.get_at_mapped((x, y)))
+                    self.assertEqual(mapped_t[x, y], mapped[x, y])
+                    self.assertEqual(red[x, y], color.r)
+                    self.assertEqual(alpha[x, y], color.a if flags else 255)
+
     def test_map_array(self):
         try:
             from numpy import array, zeros, uint8, int32, all as np_all
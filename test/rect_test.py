@@ -2,7 +2,7 @@ import math
 import unittest
 from collections.abc import Collection, Sequence
 
-from pygame import Vector2, FRect, Rect as IRect
+from pygame import Vector2, FRect, FRectArray, Rect as IRect, RectArray
 from pygame.tests import test_utils
 
 Rect = IRect
@@ -2248,6 +2248,61 @@ class RectTypeTest(unittest.TestCase):
         except TypeError as e:
             self.fail(f"collidedictall raised a TypeError with traceback:\n{e}")
 
+    def test_collide_all_pairs(self):
+        """Ensures collide_all_pairs finds the same pairs as colliderect."""
+        rects = [
+            Rect(x * 7 % 100, x * 13 % 100, x % 20 - 5, x % 15 - 4) for x in range(150)
+        ]
+        expected = [
+            (i, j)
+            for i in range(len(rects))
+            for j in range(i + 1, len(rects))
+            if rects[i].colliderect(rects[j])
+        ]
+
+        self.assertEqual(sorted(Rect.collide_all_pairs(rects)), expected)
+        self.assertEqual(sorted(Rect(0, 0, 1, 1).collide_all_pairs(rects)), expected)
+        self.assertEqual(
+            sorted(Rect.collide_all_pairs([tuple(r) for r in rects])), expected
+        )
+
+    def test_collide_all_pairs__fresh_items(self):
+        """Ensures collide_all_pairs reads rects a sequence creates on access."""
+
+        class Rects:
+            def __len__(self):
+                return 3
+
+            def __getitem__(self, i):
+                if not 0 <= i < 3:
+                    raise IndexError(i)
+                return Rect(i * 5, 0, 8, 8)
+
+        self.assertEqual(sorted(Rect.collide_all_pairs(Rects())), [(0, 1), (1, 2)])
+
+    def test_collide_all_pairs__buffer(self):
+        """Ensures collide_all_pairs accepts buffers of numbers."""
+        import array
+
+        values = [0, 0, 10, 10, 5, 5, 10, 10, 20, 20, 5, 5, 9, 9, 0, 4]
+        for typecode in "ilfd":
+            buf = array.array(typecode, values)
+            self.assertEqual(Rect.collide_all_pairs(buf), [(0, 1)])
+
+        self.assertEqual(Rect.collide_all_pairs(array.array("i")), [])
+        with self.assertRaises(ValueError):
+            Rect.collide_all_pairs(array.array("i", [1, 2, 3]))
+        with self.assertRaises(TypeError):
+            Rect.collide_all_pairs(array.array("u", "abcd"))
+
+    def test_collide_all_pairs__invalid_args(self):
+        """Ensures collide_all_pairs rejects invalid arguments."""
+        self.assertEqual(Rect.collide_all_pairs([]), [])
+        with self.assertRaises(TypeError):
+            Rect.collide_all_pairs(1)
+        with self.assertRaises(TypeError):
+            Rect.collide_all_pairs([(0, 0, 1, 1), "not a rect"])
+
     def test_collidelist(self):
         # __doc__ (as of 2008-08-02) for pygame.rect.Rect.collidelist:
 
@@ -3388,5 +3443,145 @@ class SubclassTest(unittest.TestCase):
         self.assertEqual(mr.h, 0)
 
 
+class RectArrayTest(unittest.TestCase):
+    array_type = RectArray
+    rect_type = IRect
+    buffer_format = "i"
+    rects = [
+        (0, 0, 10, 10),
+        (5, 5, 10, 10),
+        (20, -5, 3, 30),
+        (-4, 7, 0, 5),
+        (8, 2, -6, 4),
+        (-30, -30, 100, 100),
+        (12, 14, 7, 1),
+        (40, 40, 5, 5),
+        (1, 1, 1, 1),
+    ]
+
+    def _rects(self):
+        return [self.rect_type(r) for r in self.rects]
+
+    def test_construction(self):
+        """Ensures the array holds the rects it is created with."""
+        array = self.array_type(self.rects)
+        self.assertEqual(len(array), len(self.rects))
+        self.assertEqual(list(array), self._rects())
+        self.assertIsInstance(array[0], self.rect_type)
+        self.assertEqual(array[-1], self.rect_type(self.rects[-1]))
+        self.assertEqual(list(self.array_type(iter(self._rects()))), self._rects())
+        self.assertEqual(list(self.array_type(array)), self._rects())
+        self.assertEqual(list(array.copy()), self._rects())
+        self.assertEqual(len(self.array_type()), 0)
+
+        with self.assertRaises(TypeError):
+            self.array_type([(0, 0, 1, 1), "not a rect"])
+        with self.assertRaises(TypeError):
+            self.array_type(1)
+
+    def test_append_and_setitem(self):
+        """Ensures rects can be added and replaced."""
+        array = self.array_type()
+        for r in self.rects * 3:
+            array.append(r)
+        self.assertEqual(list(array), self._rects() * 3)
+
+        array[1] = (7, 8, 9, 10)
+        self.assertEqual(array[1], self.rect_type(7, 8, 9, 10))
+        array[1][0] = 100  # a copy, the array doesn't change
+        self.assertEqual(array[1], self.rect_type(7, 8, 9, 10))
+
+        with self.assertRaises(IndexError):
+            array[len(array)]
+        with self.assertRaises(IndexError):
+            array[len(array)] = (0, 0, 1, 1)
+        with self.assertRaises(TypeError):
+            del array[0]
+        with self.assertRaises(TypeError):
+            array.append("not a rect")
+
+    def test_move_ip(self):
+        """Ensures move_ip moves every rect like Rect.move_ip."""
+        array = self.array_type(self.rects)
+        array.move_ip(3, -7)
+        self.assertEqual(list(array), [r.move(3, -7) for r in self._rects()])
+        array.move_ip((-3, 7))
+        self.assertEqual(list(array), self._rects())
+
+    def test_clamp_ip(self):
+        """Ensures clamp_ip moves every rect like Rect.clamp_ip."""
+        for clamp_rect in [(0, 0, 20, 20), (-5, 3, 9, 11), (10, 10, 0, 0)]:
+            array = self.array_type(self.rects)
+            array.clamp_ip(clamp_rect)
+            expected = [r.clamp(clamp_rect) for r in self._rects()]
+            self.assertEqual(list(array), expected, clamp_rect)
+
+        with self.assertRaises(TypeError):
+            array.clamp_ip("not a rect")
+
+    def test_collidepoint(self):
+        """Ensures collidepoint tests every rect like Rect.collidepoint."""
+        array = self.array_type(self.rects)
+        for x in range(-10, 30, 3):
+            for y in range(-10, 30, 4):
+                expected = bytes(r.collidepoint(x, y) for r in self._rects())
+                self.assertEqual(array.collidepoint(x, y), expected)
+                self.assertEqual(array.collidepoint((x, y)), expected)
+
+    def test_colliderect(self):
+        """Ensures colliderect tests every rect like Rect.colliderect."""
+        array = self.array_type(self.rects)
+        for other in [(2, 2, 5, 5), (9, 9, -4, -3), (0, 0, 0, 10), (45, 45, 1, 1)]:
+            expected = bytes(r.colliderect(other) for r in self._rects())
+            self.assertEqual(array.colliderect(other), expected)
+
+        self.assertEqual(self.array_type().colliderect((0, 0, 1, 1)), b"")
+
+    def test_union(self):
+        """Ensures union returns the same rect as Rect.unionall."""
+        rects = self._rects()
+        self.assertEqual(
+            self.array_type(rects).union(), rects[0].unionall(rects[1:])
+        )
+        self.assertEqual(self.array_type(rects[:1]).union(), rects[0])
+
+        with self.assertRaises(ValueError):
+            self.array_type().union()
+
+    def test_buffer(self):
+        """Ensures the buffer holds the x, y, w and h rows of the rects."""
+        array = self.array_type()
+        for r in self.rects:
+            array.append(r)
+
+        with memoryview(array) as view:
+            self.assertEqual(view.format, self.buffer_format)
+            self.assertEqual(view.shape, (4, len(self.rects)))
+            self.assertTrue(view.c_contiguous)
+            self.assertEqual(view.tolist(), [list(col) for col in zip(*self.rects)])
+
+            view[0, 0] = 42
+            self.assertEqual(array[0].x, 42)
+            # the block can't move while it's exported
+            with self.assertRaises(BufferError):
+                array.append((0, 0, 1, 1))
+
+        array.append((0, 0, 1, 1))
+        self.assertEqual(len(array), len(self.rects) + 1)
+
+    def test_collide_all_pairs(self):
+        """Ensures collide_all_pairs accepts an array."""
+        expected = sorted(self.rect_type.collide_all_pairs(self._rects()))
+        array = self.array_type(self.rects)
+        self.assertEqual(sorted(self.rect_type.collide_all_pairs(array)), expected)
+
+
+class FRectArrayTest(RectArrayTest):
+    array_type = FRectArray
+    rect_type = FRect
+    buffer_format = "f"
+    rects = RectArrayTest.rects + [(0.5, 1.5, 2.25, 3.75), (-2.5, 4.0, 8.5, 0.5)]
+
+
 if __name__ == "__main__":
     unittest.main()
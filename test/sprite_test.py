@@ -228,6 +228,18 @@ class SpriteCollideTest(unittest.TestCase):
             [self.s2],
         )
 
+    def test_collide_mask__image_changed(self):
+        # masks made from images follow later changes to the images.
+        self.s1.image.fill((255, 255, 255, 255))
+        self.s2.image.fill((255, 255, 255, 0))
+        self.assertFalse(sprite.collide_mask(self.s1, self.s2))
+
+        self.s2.image.fill((255, 255, 255, 255), (0, 0, 5, 5))
+        self.assertTrue(sprite.collide_mask(self.s1, self.s2))
+
+        self.s1.image.fill((255, 255, 255, 0), (40, 0, 5, 5))
+        self.assertFalse(sprite.collide_mask(self.s1, self.s2))
+
     def test_collide_mask__transparent(self):
         # make some sprites that are fully transparent, so they won't collide.
         self.s1.image.fill((255, 255, 255, 0))
@@ -386,6 +398,35 @@ class SpriteCollideTest(unittest.TestCase):
 
         self.assertDictEqual(expected_dict, crashed)
 
+    def test_groupcollide__large_groups(self):
+        """Groups big enough for the broad phase find the same collisions"""
+        group_a = sprite.Group()
+        group_b = sprite.Group()
+        for i in range(80):
+            spr = sprite.Sprite(group_a if i % 2 else group_b)
+            spr.rect = pygame.Rect((i * 37) % 200, (i * 53) % 200, 10 + i % 25, 12)
+            if i % 3 == 0:
+                spr.radius = 4 + i % 9
+
+        for collided in (None, sprite.collide_rect, sprite.collide_circle):
+            check = collided or sprite.collide_rect
+            expected = {}
+            for spr_a in group_a:
+                hits = [spr_b for spr_b in group_b if check(spr_a, spr_b)]
+                if hits:
+                    expected[spr_a] = hits
+            crashed = sprite.groupcollide(group_a, group_b, False, False, collided)
+            self.assertTrue(expected)
+            self.assertDictEqual(expected, crashed)
+
+        sprites_b = group_b.sprites()
+        crashed = sprite.groupcollide(group_a, group_b, False, True)
+        killed = [spr for hits in crashed.values() for spr in hits]
+        self.assertEqual(len(killed), len(set(killed)))
+        self.assertEqual(
+            group_b.sprites(), [spr for spr in sprites_b if spr not in killed]
+        )
+
     def test_groupcollide__with_collided_callback(self):
         collided_callback_true = lambda spr_a, spr_b: True
         collided_callback_false = lambda spr_a, spr_b: False
@@ -584,6 +625,15 @@ class AbstractGroupTypeTest(unittest.TestCase):
         self.assertEqual(self.ag.spritedict[self.s1], pygame.Rect(0, 0, 10, 10))
         self.assertEqual(self.ag.spritedict[self.s2], pygame.Rect(10, 0, 10, 10))
 
+    def test_draw_clipped_and_invalid(self):
+        self.s2.rect = (15, 5)
+        self.ag.draw(self.scr)
+        self.assertEqual((0, 255, 0, 255), self.scr.get_at((19, 14)))
+        self.assertEqual(self.ag.spritedict[self.s2], pygame.Rect(15, 5, 5, 10))
+
+        self.s2.image = None
+        self.assertRaises(TypeError, self.ag.draw, self.scr)
+
     def test_empty(self):
         self.ag.empty()
         self.assertFalse(self.s1 in self.ag)
@@ -909,6 +959,30 @@ class LayeredGroupBase:
 
         self.assertEqual(spr2.layer, expected_layer)
 
+    def test_change_layer_order(self):
+        sprites = [self.sprite() for _ in range(4)]
+        for i, spr in enumerate(sprites):
+            self.LG.add(spr, layer=i % 2)
+
+        self.LG.change_layer(sprites[0], 1)
+        self.assertEqual(self.LG.layers(), [0, 1])
+        self.assertEqual(
+            self.LG.sprites(), [sprites[2], sprites[1], sprites[3], sprites[0]]
+        )
+
+        self.LG.change_layer(sprites[2], 1)
+        self.assertEqual(self.LG.layers(), [1])
+        self.assertEqual(
+            self.LG.sprites(), [sprites[1], sprites[3], sprites[0], sprites[2]]
+        )
+
+        self.LG.change_layer(sprites[3], -1)
+        self.LG.remove(sprites[1])
+        self.assertEqual(self.LG.layers(), [-1, 1])
+        self.assertEqual(self.LG.sprites(), [sprites[3], sprites[0], sprites[2]])
+        self.assertEqual(self.LG.get_sprites_from_layer(1), [sprites[0], sprites[2]])
+        self.assertEqual(self.LG.get_top_sprite(), sprites[2])
+
     def test_get_sprites_at(self):
         sprites = []
         expected_sprites = []
@@ -1111,6 +1185,34 @@ class LayeredDirtyTypeTest__DirtySprite(LayeredGroupBase, unittest.TestCase):
         group.repaint_rect(pygame.Rect(0, 0, 100, 100))
         group.draw(surface)
 
+    def test_draw_merges_dirty_rects(self):
+        group = self.LG
+        surface = pygame.Surface((100, 100))
+        bgd = pygame.Surface((100, 100))
+        bgd.fill((0, 0, 255))
+        for rect in ((10, 10, 20, 20), (20, 20, 20, 20), (70, 70, 40, 10)):
+            spr = self.sprite(group)
+            spr.image = pygame.Surface(rect[2:])
+            spr.image.fill((255, 0, 0))
+            spr.rect = pygame.Rect(rect)
+
+        # the first draw redraws everything, the next ones only dirty areas
+        self.assertEqual(group.draw(surface, bgd), [pygame.Rect(0, 0, 100, 100)])
+        self.assertEqual(
+            group.draw(surface),
+            [pygame.Rect(10, 10, 30, 30), pygame.Rect(70, 70, 30, 10)],
+        )
+
+        group.sprites()[0].rect.move_ip(50, 0)
+        group.sprites()[0].dirty = 1
+        self.assertEqual(
+            group.draw(surface),
+            [pygame.Rect(60, 10, 20, 20), pygame.Rect(10, 10, 20, 20)],
+        )
+        self.assertEqual(surface.get_at((15, 15)), (0, 0, 255, 255))
+        self.assertEqual(surface.get_at((65, 15)), (255, 0, 0, 255))
+        self.assertEqual(surface.get_at((25, 25)), (255, 0, 0, 255))
+
     def _nondirty_intersections_redrawn(self, use_source_rect=False):
         # Helper method to ensure non-dirty sprites are redrawn correctly.
         #
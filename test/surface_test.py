@@ -1,3 +1,4 @@
+import array
 import os
 import unittest
 from pygame.tests import test_utils
@@ -242,6 +243,47 @@ class SurfaceTypeTest(unittest.TestCase):
         finally:
             pygame.display.quit()
 
+    def test_get_bounding_rect__wide_alpha(self):
+        """Ensure the bounds are exact when pixels straddle SIMD blocks."""
+        surf = pygame.Surface((100, 9), SRCALPHA, 32)
+        surf.fill((10, 20, 30, 0))
+        self.assertEqual(surf.get_bounding_rect(), (0, 0, 0, 0))
+        self.assertEqual(surf.get_bounding_rect(min_alpha=0), (0, 0, 100, 9))
+
+        surf.set_at((33, 7), (0, 0, 0, 200))
+        surf.set_at((95, 2), (0, 0, 0, 50))
+        surf.set_at((15, 4), (0, 0, 0, 255))
+        self.assertEqual(surf.get_bounding_rect(), (15, 2, 81, 6))
+        self.assertEqual(surf.get_bounding_rect(min_alpha=51), (15, 4, 19, 4))
+        self.assertEqual(surf.get_bounding_rect(min_alpha=256), (0, 0, 0, 0))
+
+    def test_get_bounding_rects(self):
+        """Ensure get_bounding_rects matches get_bounding_rect."""
+        surfaces = []
+        for i in range(12):
+            surf = pygame.Surface((64 + i, 40), SRCALPHA, 32)
+            surf.fill((0, 0, 0, 0))
+            surf.fill((255, 0, 0, 100), (i, i * 2, 5 + i * 3, 3))
+            surfaces.append(surf)
+        surf = pygame.Surface((30, 30), 0, 24)
+        surf.set_colorkey((0, 0, 0))
+        surf.fill((0, 0, 0))
+        surf.set_at((4, 5), (1, 2, 3))
+        surfaces.append(surf)
+
+        for threads in (0, 1, 3):
+            rects = pygame.surface.get_bounding_rects(
+                surfaces, min_alpha=50, threads=threads
+            )
+            self.assertEqual(
+                rects, [s.get_bounding_rect(min_alpha=50) for s in surfaces]
+            )
+        self.assertEqual(pygame.surface.get_bounding_rects([]), [])
+        with self.assertRaises(TypeError):
+            pygame.surface.get_bounding_rects([surfaces[0], None])
+        with self.assertRaises(ValueError):
+            pygame.surface.get_bounding_rects(surfaces, threads=-1)
+
     def test_copy(self):
         """Ensure a surface can be copied."""
         color = (25, 25, 25, 25)
@@ -256,6 +298,39 @@ class SurfaceTypeTest(unittest.TestCase):
         self.assertEqual(s1rect.size, s2rect.size)
         self.assertEqual(s2.get_at((10, 10)), color)
 
+    def test_copy_on_write(self):
+        """Ensure shared copies get their own pixels when changed."""
+        self.assertFalse(pygame.surface.get_copy_on_write())
+        pygame.surface.set_copy_on_write(True)
+        try:
+            self.assertTrue(pygame.surface.get_copy_on_write())
+            s1 = pygame.Surface((8, 8), pygame.SRCALPHA, 32)
+            s1.fill((1, 2, 3, 4))
+            s2 = s1.copy()
+            s3 = s2.copy()
+            self.assertEqual(s3.get_at((7, 7)), (1, 2, 3, 4))
+
+            # writes through fill, blits and locks only change one surface
+            s2.fill((5, 6, 7, 8))
+            pygame.Surface((4, 4)).blit(s3, (0, 0))
+            s3.blit(pygame.Surface((2, 2)), (0, 0))
+            with pygame.PixelArray(s1) as pixels:
+                pixels[7, 7] = (9, 9, 9, 9)
+
+            self.assertEqual(s1.get_at((0, 0)), (1, 2, 3, 4))
+            self.assertEqual(s1.get_at((7, 7)), (9, 9, 9, 9))
+            self.assertEqual(s2.get_at((7, 7)), (5, 6, 7, 8))
+            self.assertEqual(s3.get_at((0, 0)), (0, 0, 0, 255))
+            self.assertEqual(s3.get_at((7, 7)), (1, 2, 3, 4))
+
+            # the last surface left takes the pixels back
+            s4 = s3.copy()
+            del s3
+            s4.set_at((1, 1), (0, 0, 0, 0))
+            self.assertEqual(s4.get_at((1, 1)), (0, 0, 0, 0))
+        finally:
+            pygame.surface.set_copy_on_write(False)
+
     def test_deepcopy(self):
         """Ensure a surface can be copied."""
         color = (25, 25, 25, 25)
@@ -496,6 +571,53 @@ class SurfaceTypeTest(unittest.TestCase):
         self.assertEqual(s1.get_at((0, 0)), (0, 0, 0, 255))
         self.assertEqual(s1.get_at((1, 1)), color)
 
+    def test_fill_many(self):
+        """Ensure fill_many() fills like repeated fill() calls."""
+        rects = [(0, 0, 4, 4), (6, 2, 3, 5), (-2, 10, 5, 20), (40, 40, 5, 5)]
+        colors = ["red", (0, 255, 0), pygame.Color(1, 2, 3), "white"]
+
+        for flags in (0, pygame.BLEND_ADD, pygame.BLEND_RGBA_MULT):
+            expected = pygame.Surface((16, 16), pygame.SRCALPHA, 32)
+            expected.fill((50, 60, 70, 80))
+            surf = expected.copy()
+            for rect, color in zip(rects, colors):
+                expected.fill(color, rect, flags)
+            self.assertIsNone(surf.fill_many(rects, colors, special_flags=flags))
+            self.assertEqual(surf.get_buffer().raw, expected.get_buffer().raw)
+
+            expected.fill((50, 60, 70, 80))
+            surf.fill((50, 60, 70, 80))
+            for rect in rects:
+                expected.fill("orange", rect, flags)
+            buffer = array.array("i", [v for rect in rects for v in rect])
+            surf.fill_many(buffer, "orange", flags)
+            self.assertEqual(surf.get_buffer().raw, expected.get_buffer().raw)
+
+        surf = pygame.Surface((8, 8), 0, 32)
+        mapped = array.array("I", [surf.map_rgb("blue"), surf.map_rgb("gray")])
+        surf.fill_many(rects=[(0, 0, 2, 2), (4, 4, 2, 2)], colors=mapped)
+        self.assertEqual(surf.get_at((1, 1)), pygame.Color("blue"))
+        self.assertEqual(surf.get_at((5, 5)), pygame.Color("gray"))
+        surf.fill_many([], [])
+
+        # a sequence that is a color is one color, even for as many rects
+        surf.fill_many([(0, 0, 1, 1), (1, 0, 1, 1), (2, 0, 1, 1)], [1, 2, 3])
+        for x in range(3):
+            self.assertEqual(surf.get_at((x, 0)), (1, 2, 3, 255))
+
+        self.assertRaises(ValueError, surf.fill_many, [(0, 0, 1, 1)], ["red"] * 2)
+        self.assertRaises(ValueError, surf.fill_many, [0], "red")
+        self.assertRaises(ValueError, surf.fill_many, array.array("i", [1]), "red")
+        self.assertRaises(ValueError, surf.fill_many, array.array("d", [1]), "red")
+        self.assertRaises(TypeError, surf.fill_many, 5, "red")
+        self.assertRaises(
+            pygame.error,
+            surf.fill_many,
+            [(0, 0, 1, 1)],
+            "red",
+            special_flags=pygame.BLEND_PREMULTIPLIED,
+        )
+
     ########################################################################
 
     def test_get_alpha(self):
@@ -865,6 +987,62 @@ class SurfaceTypeTest(unittest.TestCase):
         gc.collect()
         self.assertFalse(s.get_locked())
 
+    def test_shared_memory(self):
+        """Ensure surfaces from the same shared memory share their pixels."""
+        surf = pygame.Surface((6, 4), pygame.SRCALPHA, 32)
+        surf.fill((10, 20, 30, 40))
+        shm = surf.to_shared_memory()
+        try:
+            self.assertEqual(bytes(shm.buf[:4]), bytes((10, 20, 30, 40)))
+
+            first = pygame.Surface.from_shared_memory(shm.name, (6, 4), "RGBA")
+            second = pygame.Surface.from_shared_memory(shm.name, (6, 4), "RGBA")
+            self.assertEqual(first.get_at((5, 3)), (10, 20, 30, 40))
+
+            second.subsurface((3, 0, 3, 4)).fill((1, 2, 3, 4))
+            self.assertEqual(first.get_at((0, 0)), (10, 20, 30, 40))
+            self.assertEqual(first.get_at((5, 3)), (1, 2, 3, 4))
+
+            with self.assertRaises(ValueError):
+                pygame.Surface.from_shared_memory(shm.name, (600, 400), "RGBA")
+            with self.assertRaises(ValueError):
+                pygame.Surface.from_shared_memory(shm.name, (6, 4), "XYZ")
+            del first, second
+        finally:
+            shm.close()
+            shm.unlink()
+
+    def test_from_buffer(self):
+        """Ensure from_buffer draws to the buffer's memory with its pitch."""
+        buf = bytearray(3 * 10)
+        masks = (0xFF, 0xFF00, 0xFF0000, 0xFF000000)
+        if pygame.get_sdl_byteorder() == pygame.BIG_ENDIAN:
+            masks = (0xFF000000, 0xFF0000, 0xFF00, 0xFF)
+
+        surf = pygame.Surface.from_buffer(buf, (2, 3), 10, masks)
+        self.assertEqual(surf.get_size(), (2, 3))
+        self.assertEqual(surf.get_pitch(), 10)
+        surf.fill((1, 2, 3, 4))
+        self.assertEqual(buf[10:18], bytearray((1, 2, 3, 4) * 2))
+        self.assertEqual(buf[18:20], bytearray(2))
+
+        buf[0:4] = bytes((5, 6, 7, 8))
+        self.assertEqual(surf.get_at((0, 0)), (5, 6, 7, 8))
+
+        # the surface keeps the buffer exported
+        with self.assertRaises(BufferError):
+            buf.extend(b"x")
+        del surf
+        gc.collect()
+        buf.extend(b"x")
+
+        with self.assertRaises(ValueError):
+            pygame.Surface.from_buffer(bytearray(8), (2, 2))
+        with self.assertRaises(ValueError):
+            pygame.Surface.from_buffer(bytes(16), (2, 2))
+        with self.assertRaises(ValueError):
+            pygame.Surface.from_buffer(bytearray(16), (2, 2), 4)
+
     OLDBUF = hasattr(pygame.bufferproxy, "get_segcount")
 
     @unittest.skipIf(not OLDBUF, "old buffer not available")
@@ -931,6 +1109,32 @@ class SurfaceTypeTest(unittest.TestCase):
         self.assertEqual(s1.get_at((0, 0)), (0, 0, 0, 255))
         self.assertEqual(s1.get_at((1, 1)), color)
 
+    def test_blit_fill_argument_errors(self):
+        """Ensures blit and fill reject arguments like they always did."""
+        s1 = pygame.Surface((4, 4), 0, 32)
+        s2 = pygame.Surface((2, 2), 0, 32)
+        s2.fill((1, 2, 3))
+
+        for dest in ((1, 1), [1, 1], pygame.Vector2(1.5, 1.5), (1.0, 1), (1, 1, 2, 2)):
+            s1.fill((0, 0, 0))
+            self.assertEqual(s1.blit(s2, dest), (1, 1, 2, 2))
+            self.assertEqual(s1.get_at((1, 1)), (1, 2, 3, 255))
+            self.assertEqual(s1.get_at((0, 0)), (0, 0, 0, 255))
+
+        self.assertRaises(TypeError, s1.blit)
+        self.assertRaises(TypeError, s1.blit, s2)
+        self.assertRaises(TypeError, s1.blit, 5, (0, 0))
+        self.assertRaises(TypeError, s1.blit, s2, (0, 0), None, 0, 1)
+        self.assertRaises(TypeError, s1.blit, s2, (0, 0), source=s2)
+        self.assertRaises(TypeError, s1.blit, s2, (0, 0), flags=0)
+        self.assertRaises(TypeError, s1.blit, s2, (0, 0), None, 1.5)
+
+        self.assertRaises(TypeError, s1.fill)
+        self.assertRaises(TypeError, s1.fill, (1, 2, 3), color=(1, 2, 3))
+        self.assertRaises(TypeError, s1.fill, (1, 2, 3), special_flags="x")
+        self.assertEqual(s1.fill(rect=(1, 1, 1, 1), color=(9, 9, 9)), (1, 1, 1, 1))
+        self.assertEqual(s1.get_at((1, 1)), (9, 9, 9, 255))
+
     def test_blit_big_rects(self):
         """SDL2 can have more than 16 bits for x, y, width, height."""
         big_surf = pygame.Surface((100, 68000), 0, 32)
@@ -1203,6 +1407,111 @@ class TestSurfaceBlit(unittest.TestCase):
             # +3 gets the "alpha channel" in this pixel format
             assert surf1_bytes[i * 4 + 3] == 0
 
+    def test_blit_transformed(self):
+        """blit_transformed() matches blitting a transformed copy"""
+        source = pygame.Surface((4, 2), 0, 32)
+        for x in range(4):
+            for y in range(2):
+                source.set_at((x, y), (x * 60, y * 200, 30))
+
+        def compare(expected_surf, expected_pos, **kwargs):
+            expected = pygame.Surface((8, 8), 0, 32)
+            expected.blit(expected_surf, expected_pos)
+            result = pygame.Surface((8, 8), 0, 32)
+            rect = result.blit_transformed(source, (4, 4), **kwargs)
+            self.assertEqual(rect, expected_surf.get_rect(topleft=expected_pos))
+            for x in range(8):
+                for y in range(8):
+                    self.assertEqual(
+                        result.get_at((x, y)), expected.get_at((x, y)), (x, y)
+                    )
+
+        compare(source, (2, 3))
+        compare(source, (4, 4), origin=(0, 0))
+        compare(pygame.transform.rotate(source, 90), (3, 2), angle=90)
+        compare(pygame.transform.rotate(source, -90), (3, 2), angle=270)
+        compare(pygame.transform.rotate(source, 180), (2, 3), angle=180)
+        compare(pygame.transform.flip(source, True, False), (2, 3), flip_x=True)
+        compare(pygame.transform.flip(source, False, True), (2, 3), flip_y=True)
+        compare(pygame.transform.scale_by(source, 2), (0, 2), scale=2)
+        compare(pygame.transform.scale(source, (4, 4)), (2, 2), scale=(1, 2))
+
+    def test_blit_transformed__clip_and_errors(self):
+        source = pygame.Surface((10, 10), pygame.SRCALPHA, 32)
+        source.fill((255, 0, 0, 255))
+        target = pygame.Surface((20, 20), pygame.SRCALPHA, 32)
+        target.set_clip((0, 0, 10, 20))
+
+        rect = target.blit_transformed(source, (10, 10), angle=45, smooth=True)
+        self.assertEqual(rect.right, 10)
+        self.assertEqual(target.get_at((9, 10)), (255, 0, 0, 255))
+        self.assertEqual(target.get_at((12, 10)), (0, 0, 0, 0))
+
+        rect = target.blit_transformed(source, (50, 50))
+        self.assertEqual(rect.size, (0, 0))
+        rect = target.blit_transformed(source, (5, 5), scale=0)
+        self.assertEqual(rect.size, (0, 0))
+
+        with self.assertRaises(ValueError):
+            target.blit_transformed(target, (0, 0))
+        with self.assertRaises(ValueError):
+            target.blit_transformed(source, (0, 0), scale=-1)
+        with self.assertRaises(TypeError):
+            target.blit_transformed(source, "pos")
+
+    def test_blit_tiled(self):
+        colors = [(255, 0, 0), (0, 255, 0), (0, 0, 255), (255, 255, 0)]
+        source = pygame.Surface((2, 2))
+        for i, color in enumerate(colors):
+            source.set_at((i % 2, i // 2), color)
+        target = pygame.Surface((7, 5))
+
+        rect = target.blit_tiled(source, (1, 1, 5, 3), offset=(1, 0))
+        self.assertEqual(rect, (1, 1, 5, 3))
+        for x in range(7):
+            for y in range(5):
+                if rect.collidepoint(x, y):
+                    expected = colors[x % 2 + (y - 1) % 2 * 2]
+                else:
+                    expected = (0, 0, 0)
+                self.assertEqual(target.get_at((x, y)), expected, (x, y))
+
+        target.set_clip((0, 0, 3, 3))
+        self.assertEqual(target.blit_tiled(source, (1, 1, 5, 3)), (1, 1, 2, 2))
+        self.assertEqual(target.blit_tiled(source, (4, 4, 2, 2)).size, (0, 0))
+        with self.assertRaises(ValueError):
+            target.blit_tiled(target, (0, 0, 2, 2))
+
+    def test_blit_tilemap(self):
+        colors = [(255, 0, 0), (0, 255, 0), (0, 0, 255), (255, 255, 0)]
+        tileset = pygame.Surface((4, 2))
+        for i, color in enumerate(colors):
+            tileset.fill(color, ((i % 2) * 2, i // 2, 2, 1))
+        rows = [[0, 1, -1], [3, 2, 0]]
+        buffer = memoryview(array.array("i", rows[0] + rows[1]))
+        buffer = buffer.cast("B").cast("i", (2, 3))
+
+        for indices in (rows, buffer):
+            target = pygame.Surface((10, 10))
+            rect = target.blit_tilemap(tileset, indices, (2, 1), origin=(1, 1))
+            self.assertEqual(rect, (1, 1, 6, 2))
+            for r, row in enumerate(rows):
+                for c, index in enumerate(row):
+                    pos = (1 + c * 2 + 1, 1 + r)
+                    expected = colors[index] if index >= 0 else (0, 0, 0)
+                    self.assertEqual(target.get_at(pos), expected, pos)
+
+        # cells outside of the clip area aren't looked at
+        target.set_clip((0, 0, 3, 2))
+        rect = target.blit_tilemap(tileset, [[0, 9], [9, 9]], (2, 1), (1, 1))
+        self.assertEqual(rect, (1, 1, 2, 1))
+        with self.assertRaises(IndexError):
+            target.blit_tilemap(tileset, [[4]], (2, 1))
+        with self.assertRaises(ValueError):
+            target.blit_tilemap(tileset, [[0]], (5, 1))
+        with self.assertRaises(ValueError):
+            target.blit_tilemap(tileset, array.array("i", [0]), (2, 1))
+
 
 class GeneralSurfaceTests(unittest.TestCase):
     @unittest.skipIf(
@@ -1818,6 +2127,68 @@ class GeneralSurfaceTests(unittest.TestCase):
         finally:
             pygame.display.quit()
 
+    def test_convert__32bit_channel_orders(self):
+        """Ensure converting 24 and 32 bit surfaces to other 32 bit
+        channel orders keeps every color, for small and large surfaces."""
+        colors = [(255, 0, 0, 255), (0, 255, 0, 128), (1, 2, 3, 4), (0, 0, 0, 0)]
+        targets = [
+            (0xFF, 0xFF00, 0xFF0000, 0xFF000000),
+            (0xFF000000, 0xFF0000, 0xFF00, 0xFF),
+            (0xFF00, 0xFF0000, 0xFF000000, 0),
+        ]
+        for size in ((7, 5), (640, 480)):
+            w, h = size
+            for depth, flags in ((24, 0), (32, 0), (32, SRCALPHA)):
+                source = pygame.Surface(size, flags, depth)
+                for i, color in enumerate(colors):
+                    source.fill(color, (0, i * h // 4, w, h // 4 + 1))
+                source.set_at((w - 1, h - 1), (9, 8, 7, 6))
+                points = [(0, 0), (w // 2, h // 3), (1, h // 2), (w - 1, h - 1)]
+                points += [(x, i * h // 4) for i in range(4) for x in (0, w - 1)]
+
+                for masks in targets:
+                    result = source.convert(masks)
+                    self.assertEqual(result.get_masks(), masks)
+                    for pos in points:
+                        expected = source.get_at(pos)
+                        if not masks[3]:
+                            expected.a = 255
+                        self.assertEqual(result.get_at(pos), expected)
+
+    def test_convert_many(self):
+        """Ensure convert_many matches convert and convert_alpha."""
+        pygame.display.init()
+        try:
+            pygame.display.set_mode((40, 40))
+            surfaces = []
+            for i, depth in enumerate((8, 16, 24, 32, 32)):
+                surf = SurfaceSubclass((30 + i, 20), 0, depth)
+                surf.fill((200, 100, 50), (0, 0, 10, 10))
+                surfaces.append(surf)
+            surfaces[1].set_colorkey((0, 0, 0))
+            surfaces.append(surfaces[2])
+            surfaces.append(None)
+
+            for alpha in (True, False):
+                results = pygame.Surface.convert_many(surfaces, alpha=alpha)
+                self.assertEqual(len(results), len(surfaces))
+                self.assertIsNone(results[-1])
+                for surf, result in zip(surfaces[:-1], results):
+                    expected = surf.convert_alpha() if alpha else surf.convert()
+                    self.assertIsInstance(result, SurfaceSubclass)
+                    self.assertEqual(result.get_size(), surf.get_size())
+                    self.assertEqual(result.get_masks(), expected.get_masks())
+                    self.assertEqual(result.get_colorkey(), expected.get_colorkey())
+                    self.assertEqual(result.get_blendmode(), expected.get_blendmode())
+                    for pos in ((0, 0), (9, 9), (10, 10)):
+                        self.assertEqual(result.get_at(pos), expected.get_at(pos))
+                self.assertIsNot(results[2], results[5])
+
+            self.assertEqual(pygame.Surface.convert_many(()), [])
+            self.assertRaises(TypeError, pygame.Surface.convert_many, [1])
+        finally:
+            pygame.display.quit()
+
     def test_convert_alpha_argument_deprecation(self):
         pygame.display.init()
         pygame.display.set_mode((640, 480))
@@ -2005,6 +2376,48 @@ class GeneralSurfaceTests(unittest.TestCase):
                 "%i != %i, bitsize: %i" % (pixel, surf.map_rgb(color), bitsize),
             )
 
+    def test_get_set_at_many(self):
+        """Ensure get_at_many() and set_at_many() match get_at_mapped() and
+        set_at()."""
+        points = [(x, (x * 7) % 5) for x in range(8)]
+        flat = array.array("i", [v for p in points for v in p])
+        colors = [(x * 30, 255 - x * 30, x * 10, 255) for x in range(8)]
+        for bitsize in [8, 16, 24, 32]:
+            expected = pygame.Surface((8, 5), 0, bitsize)
+            surf = pygame.Surface((8, 5), 0, bitsize)
+            for point, color in zip(points, colors):
+                expected.set_at(point, color)
+            surf.set_at_many(flat, colors)
+            mapped = [expected.get_at_mapped(p) for p in points]
+
+            self.assertEqual(surf.get_at_many(flat).tolist(), mapped, bitsize)
+            self.assertEqual(surf.get_at_many(points).tolist(), mapped, bitsize)
+            out = array.array("I", [0] * 8)
+            self.assertIs(surf.get_at_many(flat, out=out), out)
+            self.assertEqual(out.tolist(), mapped, bitsize)
+
+            surf.fill(0)
+            surf.set_at_many(points, out)
+            self.assertEqual(surf.get_at_many(flat).tolist(), mapped, bitsize)
+
+            surf.set_at_many(flat, "red")
+            red = surf.map_rgb("red")
+            self.assertEqual(surf.get_at_many(flat).tolist(), [red] * 8, bitsize)
+
+        surf = pygame.Surface((4, 4))
+        surf.set_clip((0, 0, 2, 2))
+        surf.set_at_many([(1, 1), (3, 3), (-1, 0)], "white")
+        self.assertEqual(surf.get_at((1, 1)), pygame.Color("white"))
+        self.assertEqual(surf.get_at((3, 3)), pygame.Color("black"))
+
+        self.assertEqual(len(surf.get_at_many([])), 0)
+        self.assertRaises(IndexError, surf.get_at_many, [(0, 0), (4, 0)])
+        self.assertRaises(ValueError, surf.get_at_many, array.array("i", [1]))
+        self.assertRaises(ValueError, surf.get_at_many, [(0, 0)], bytearray(8))
+        self.assertRaises(ValueError, surf.set_at_many, [(0, 0)], ["red"] * 2)
+        self.assertRaises(TypeError, surf.get_at_many, [(0, "a")])
+        self.assertRaises(TypeError, surf.get_at_many, 5)
+
     def test_get_bitsize(self):
         pygame.display.init()
         try:
@@ -2186,6 +2599,71 @@ class GeneralSurfaceTests(unittest.TestCase):
         surface.unlock()
         self.assertEqual(surface.get_locks(), ())
 
+    def test_get_locks__nested(self):
+        """Ensure counted self locks and lock objects are kept apart"""
+        surface = pygame.Surface((20, 20))
+        sub = surface.subsurface((5, 5, 10, 10))
+
+        surface.lock()
+        pxarray = pygame.PixelArray(surface)
+        pygame.draw.line(surface, (255, 0, 0), (0, 0), (19, 19))
+        locks = surface.get_locks()
+        self.assertEqual(len(locks), 2)
+        self.assertIn(surface, locks)
+        self.assertTrue(any(lock is pxarray for lock in locks))
+
+        # a subsurface locks its owner on its own behalf
+        sub.lock()
+        self.assertIn(sub, surface.get_locks())
+        sub.unlock()
+        self.assertNotIn(sub, surface.get_locks())
+
+        pxarray.close()
+        self.assertEqual(surface.get_locks(), (surface,))
+        surface.unlock()
+        surface.unlock()  # unbalanced unlocks are ignored
+        self.assertFalse(surface.get_locked())
+
+    def test_threaded_rendering(self):
+        """Ensure threads rendering to surfaces of their own, which run
+        without the GIL, draw what a single thread would"""
+        import threading
+
+        source = pygame.Surface((40, 40), SRCALPHA)
+        source.fill((0, 0, 255, 128))
+        opaque = pygame.Surface((40, 40))
+        opaque.fill((0, 255, 0))
+
+        def render(results, index):
+            surface = pygame.Surface((100, 100))
+            for i in range(20):
+                surface.fill((index, i, 0))
+                pygame.draw.circle(surface, (255, 255, 0), (50, 50), 30)
+                pygame.draw.line(surface, (255, 0, 0), (0, 0), (99, 99), 3)
+                surface.blit(opaque, (10, 10))
+                surface.blit(source, (30, 30))
+            results[index] = surface
+
+        results = [None] * 4
+        threads = [
+            threading.Thread(target=render, args=(results, i)) for i in range(4)
+        ]
+        for thread in threads:
+            thread.start()
+        for thread in threads:
+            thread.join()
+
+        expected = [None] * 4
+        for i in range(4):
+            render(expected, i)
+            self.assertEqual(
+                pygame.image.tobytes(results[i], "RGB"),
+                pygame.image.tobytes(expected[i], "RGB"),
+            )
+        # the sources were only read
+        self.assertEqual(source.get_at((0, 0)), (0, 0, 255, 128))
+        self.assertEqual(opaque.get_locks(), ())
+
     def test_get_losses(self):
         """Ensure a surface's losses can be retrieved"""
         pygame.display.init()
@@ -2609,6 +3087,56 @@ class GeneralSurfaceTests(unittest.TestCase):
         surf = pygame.Surface.__new__(pygame.Surface)
         self.assertRaises(pygame.error, surf.subsurface, (0, 0, 0, 0))
 
+    def test_subsurfaces(self):
+        sheet = pygame.Surface((32, 16), pygame.SRCALPHA)
+        for y in range(16):
+            for x in range(32):
+                sheet.set_at((x, y), (x * 8, y * 16, 100, 200))
+        rects = [(x, 0, 8, 16) for x in range(0, 32, 8)] + [pygame.Rect(4, 4, 8, 8)]
+
+        subs = sheet.subsurfaces(rects)
+        views = sheet.subsurfaces(rects, views=True)
+        self.assertEqual(len(subs), len(rects))
+        self.assertEqual(len(views), len(rects))
+        for rect, sub, view in zip(rects, subs, views):
+            self.assertIsInstance(view, pygame.SurfaceView)
+            self.assertIs(sub.get_parent(), sheet)
+            self.assertIs(view.surface, sheet)
+            self.assertEqual(sub.get_offset(), tuple(rect[:2]))
+            self.assertEqual(view.rect, pygame.Rect(rect))
+            self.assertEqual(view.get_size(), sub.get_size())
+            self.assertEqual(view.subsurface().get_offset(), sub.get_offset())
+
+        for area in (None, (2, 3, 4, 5), (-2, -3, 6, 20)):
+            for i, (sub, view) in enumerate(zip(subs, views)):
+                expected = pygame.Surface((20, 20), pygame.SRCALPHA)
+                actual = pygame.Surface((20, 20), pygame.SRCALPHA)
+                self.assertEqual(
+                    actual.blit(view, (3, 2), area), expected.blit(sub, (3, 2), area)
+                )
+                self.assertEqual(
+                    pygame.image.tobytes(actual, "RGBA"),
+                    pygame.image.tobytes(expected, "RGBA"),
+                    (i, area),
+                )
+
+        expected = pygame.Surface((40, 40), pygame.SRCALPHA)
+        actual = pygame.Surface((40, 40), pygame.SRCALPHA)
+        positions = [(i * 9, i * 5) for i in range(len(rects))]
+        expected.fblits(list(zip(subs, positions)))
+        actual.fblits(list(zip(views, positions)))
+        self.assertEqual(
+            pygame.image.tobytes(actual, "RGBA"), pygame.image.tobytes(expected, "RGBA")
+        )
+
+        self.assertEqual(sheet.subsurfaces([]), [])
+        self.assertRaises(ValueError, sheet.subsurfaces, [(30, 0, 8, 8)])
+        self.assertRaises(ValueError, sheet.subsurfaces, [(28, 0, 8, 8)], views=True)
+        self.assertRaises(ValueError, sheet.subsurfaces, [(-1, 0, 8, 8)], views=True)
+        self.assertRaises(ValueError, pygame.SurfaceView, sheet, (0, 10, 8, 8))
+        self.assertRaises(ValueError, sheet.subsurfaces, [(0, 0)])
+        self.assertRaises(TypeError, sheet.subsurfaces, 5)
+
     def test_unlock(self):
         # Basic
         surf = pygame.Surface((100, 100))
@@ -2683,6 +3211,9 @@ class GeneralSurfaceTests(unittest.TestCase):
             (32, 0, -11),
             (32, -11, 2),
             (32, 2, -11),
+            (32, 0, 3),
+            (32, 0, -3),
+            (24, 0, 3),
         ]
         for bitsize, dx, dy in scrolls:
             surf = pygame.Surface((10, 10), 0, bitsize)
@@ -2735,6 +3266,20 @@ class GeneralSurfaceTests(unittest.TestCase):
         surf.scroll(dx=-3, dy=-3)
         self.assertEqual(surf.get_at((0, 0)), spot_color)
 
+    def test_scroll__subsurface(self):
+        """Ensure scrolling a subsurface leaves the rest of its parent alone,
+        though the rows of the subsurface aren't contiguous."""
+        parent = pygame.Surface((16, 12), 0, 32)
+        for y in range(12):
+            parent.fill((y * 20, 0, 255), (0, y, 16, 1))
+        comp = parent.copy()
+        sub = parent.subsurface((0, 2, 8, 8))
+        comp.blit(parent, (0, 3), (0, 2, 8, 7))
+        sub.scroll(0, 1)
+        for x in range(16):
+            for y in range(12):
+                self.assertEqual(parent.get_at((x, y)), comp.get_at((x, y)))
+
 
 class SurfaceSubtypeTest(unittest.TestCase):
     """pygame-ce issue #295: Methods that return a new Surface preserve subclasses"""
@@ -3854,6 +4399,181 @@ class SurfaceBlendTest(unittest.TestCase):
 
         self.assertEqual(bgra_surf_a.get_at((0, 0)), pygame.Color(32, 64, 64, 192))
 
+    def test_blit_blend_premultiplied_alpha_layouts(self):
+        """Ensure premultiplied blits match the formula for every alpha position"""
+        layouts = {
+            "ARGB": (0xFF0000, 0xFF00, 0xFF, 0xFF000000),
+            "ABGR": (0xFF, 0xFF00, 0xFF0000, 0xFF000000),
+            "RGBA": (0xFF000000, 0xFF0000, 0xFF00, 0xFF),
+            "BGRA": (0xFF00, 0xFF0000, 0xFF000000, 0xFF),
+        }
+
+        def blend(s, d, alpha):
+            return d if not alpha else min(255, s + d - ((d + 1) * alpha >> 8))
+
+        for name, masks in layouts.items():
+            # odd widths run the vector loops and their remainders
+            for w in (1, 3, 4, 9, 17):
+                with self.subTest(layout=name, width=w):
+                    src = pygame.Surface((w, 2), pygame.SRCALPHA, 32, masks)
+                    dst = pygame.Surface((w, 2), pygame.SRCALPHA, 32, masks)
+                    for x in range(w):
+                        # premultiplied colors never exceed their alpha
+                        a = (x * 53) % 256
+                        src.set_at((x, 0), (a * 3 // 4, a // 2, a // 5, a))
+                        src.set_at((x, 1), (a, a // 3, 0, a))
+                        dst.set_at((x, 0), (200, 100, 50, 255))
+                        dst.set_at((x, 1), (x * 9 % 256, 40, 250, 128))
+                    expected = []
+                    for y in range(2):
+                        for x in range(w):
+                            s_col, d_col = src.get_at((x, y)), dst.get_at((x, y))
+                            expected.append(
+                                [blend(s, d, s_col.a) for s, d in zip(s_col, d_col)]
+                            )
+
+                    dst.blit(src, (0, 0), special_flags=pygame.BLEND_PREMULTIPLIED)
+                    result = [
+                        list(dst.get_at((x, y))) for y in range(2) for x in range(w)
+                    ]
+                    self.assertEqual(result, expected)
+
+    def test_blend_mode(self):
+        """Ensure BlendMode keeps its equations and rejects unknown values"""
+        mode = pygame.BlendMode(
+            pygame.BLENDFACTOR_SRC_ALPHA,
+            pygame.BLENDFACTOR_ONE_MINUS_SRC_ALPHA,
+            pygame.BLENDOPERATION_ADD,
+            alpha_src_factor=pygame.BLENDFACTOR_ONE,
+        )
+        self.assertIsInstance(mode, int)
+        self.assertEqual(mode.src_factor, pygame.BLENDFACTOR_SRC_ALPHA)
+        self.assertEqual(mode.dst_factor, pygame.BLENDFACTOR_ONE_MINUS_SRC_ALPHA)
+        self.assertEqual(mode.operation, pygame.BLENDOPERATION_ADD)
+        self.assertEqual(mode.alpha_src_factor, pygame.BLENDFACTOR_ONE)
+        # the rest of the alpha equation defaults to the colour one
+        self.assertEqual(mode.alpha_dst_factor, mode.dst_factor)
+        self.assertEqual(mode.alpha_operation, mode.operation)
+        self.assertTrue(repr(mode).startswith("BlendMode("))
+        self.assertEqual(
+            mode,
+            pygame.BlendMode(
+                pygame.BLENDFACTOR_SRC_ALPHA,
+                pygame.BLENDFACTOR_ONE_MINUS_SRC_ALPHA,
+                pygame.BLENDOPERATION_ADD,
+                pygame.BLENDFACTOR_ONE,
+            ),
+        )
+
+        with self.assertRaises(ValueError):
+            pygame.BlendMode(0, pygame.BLENDFACTOR_ONE, pygame.BLENDOPERATION_ADD)
+        with self.assertRaises(ValueError):
+            pygame.BlendMode(pygame.BLENDFACTOR_ONE, pygame.BLENDFACTOR_ONE, 6)
+        with self.assertRaises(TypeError):
+            pygame.BlendMode(pygame.BLENDFACTOR_ONE, pygame.BLENDFACTOR_ONE)
+
+    def test_blit_blend_custom(self):
+        """Ensure BlendMode blits match their equations in every format"""
+        def factor(f, s, d, sa, da):
+            return {
+                pygame.BLENDFACTOR_ZERO: 0,
+                pygame.BLENDFACTOR_ONE: 255,
+                pygame.BLENDFACTOR_SRC_COLOR: s,
+                pygame.BLENDFACTOR_ONE_MINUS_SRC_COLOR: 255 - s,
+                pygame.BLENDFACTOR_SRC_ALPHA: sa,
+                pygame.BLENDFACTOR_ONE_MINUS_SRC_ALPHA: 255 - sa,
+                pygame.BLENDFACTOR_DST_COLOR: d,
+                pygame.BLENDFACTOR_ONE_MINUS_DST_COLOR: 255 - d,
+                pygame.BLENDFACTOR_DST_ALPHA: da,
+                pygame.BLENDFACTOR_ONE_MINUS_DST_ALPHA: 255 - da,
+            }[f]
+
+        def equation(fsrc, fdst, op, s, d, sa, da):
+            if op == pygame.BLENDOPERATION_MINIMUM:
+                return min(s, d)
+            if op == pygame.BLENDOPERATION_MAXIMUM:
+                return max(s, d)
+            a = round(s * factor(fsrc, s, d, sa, da) / 255)
+            b = round(d * factor(fdst, s, d, sa, da) / 255)
+            value = {
+                pygame.BLENDOPERATION_ADD: a + b,
+                pygame.BLENDOPERATION_SUBTRACT: a - b,
+                pygame.BLENDOPERATION_REV_SUBTRACT: b - a,
+            }[op]
+            return max(0, min(255, value))
+
+        def expected(mode, s_col, d_col):
+            sa, da = s_col.a, d_col.a
+            color = [
+                equation(
+                    mode.src_factor, mode.dst_factor, mode.operation, s, d, sa, da
+                )
+                for s, d in zip(s_col[:3], d_col[:3])
+            ]
+            alpha = equation(
+                mode.alpha_src_factor,
+                mode.alpha_dst_factor,
+                mode.alpha_operation,
+                sa,
+                da,
+                sa,
+                da,
+            )
+            return color + [alpha]
+
+        modes = [
+            # screen
+            pygame.BlendMode(
+                pygame.BLENDFACTOR_ONE,
+                pygame.BLENDFACTOR_ONE_MINUS_SRC_COLOR,
+                pygame.BLENDOPERATION_ADD,
+            ),
+            # alpha blending
+            pygame.BlendMode(
+                pygame.BLENDFACTOR_SRC_ALPHA,
+                pygame.BLENDFACTOR_ONE_MINUS_SRC_ALPHA,
+                pygame.BLENDOPERATION_ADD,
+                pygame.BLENDFACTOR_ONE,
+                pygame.BLENDFACTOR_ONE_MINUS_SRC_ALPHA,
+                pygame.BLENDOPERATION_ADD,
+            ),
+            pygame.BlendMode(
+                pygame.BLENDFACTOR_DST_ALPHA,
+                pygame.BLENDFACTOR_SRC_COLOR,
+                pygame.BLENDOPERATION_REV_SUBTRACT,
+                pygame.BLENDFACTOR_ONE_MINUS_DST_COLOR,
+                pygame.BLENDFACTOR_ZERO,
+                pygame.BLENDOPERATION_MAXIMUM,
+            ),
+        ]
+        for mode in modes:
+            # 32 bit surfaces use the SIMD kernels, odd widths their
+            # remainders, and the 24 bit destination the generic one
+            for w, depth in ((1, 32), (7, 32), (16, 32), (5, 24)):
+                with self.subTest(mode=mode, width=w, depth=depth):
+                    src = pygame.Surface((w, 2), pygame.SRCALPHA, 32)
+                    flags = pygame.SRCALPHA if depth == 32 else 0
+                    dst = pygame.Surface((w, 2), flags, depth)
+                    for x in range(w):
+                        src.set_at((x, 0), (x * 37 % 256, 200, 30, x * 53 % 256))
+                        src.set_at((x, 1), (255, x * 11 % 256, 90, 255))
+                        dst.set_at((x, 0), (100, x * 29 % 256, 250, 128))
+                        dst.set_at((x, 1), (0, 60, x * 71 % 256, 255))
+                    want = []
+                    for y in range(2):
+                        for x in range(w):
+                            s_col, d_col = src.get_at((x, y)), dst.get_at((x, y))
+                            value = expected(mode, s_col, d_col)
+                            if depth == 24:
+                                value[3] = 255
+                            want.append(value)
+
+                    dst.blit(src, (0, 0), special_flags=mode)
+                    result = [
+                        list(dst.get_at((x, y))) for y in range(2) for x in range(w)
+                    ]
+                    self.assertEqual(result, want)
+
     def test_blit_blend_big_rect(self):
         """test that an oversized rect works ok."""
         color = (1, 2, 3, 255)
@@ -3895,6 +4615,41 @@ class SurfaceBlendTest(unittest.TestCase):
         dst.blit(src, (0, 0), special_flags=BLEND_RGBA_ADD)
         self.assertEqual(dst.get_at((0, 0)), (0, 0, 0, 255))
 
+    def test_blit_alpha_16bit(self):
+        # Per pixel alpha blits onto RGB565 and BGR565 surfaces, wide enough
+        # for the SIMD kernels to run and leave a tail
+        size = (21, 3)
+        src = pygame.Surface(size, SRCALPHA, 32)
+        for x in range(size[0]):
+            for y in range(size[1]):
+                src.set_at((x, y), (x * 12, 255 - x * 9, y * 80, x * 40 % 256))
+
+        for masks in [(0xF800, 0x7E0, 0x1F, 0), (0x1F, 0x7E0, 0xF800, 0)]:
+            for surf_alpha in [None, 170]:
+                src.set_alpha(surf_alpha)
+                dst = pygame.Surface(size, 0, 16, masks)
+                dst.fill((200, 60, 10))
+                dst.fill((30, 140, 250), (0, 1, 21, 2))
+                expected = []
+                for x in range(size[0]):
+                    for y in range(size[1]):
+                        s = src.get_at((x, y))
+                        d = dst.get_at((x, y))
+                        a = s.a if surf_alpha is None else s.a * surf_alpha // 255
+                        c = [
+                            ((d[i] << 8) + (s[i] - d[i]) * a + s[i]) >> 8
+                            for i in range(3)
+                        ]
+                        expected.append(dst.unmap_rgb(dst.map_rgb(c)))
+
+                dst.blit(src, (0, 0))
+                result = [
+                    dst.get_at((x, y)) for x in range(size[0]) for y in range(size[1])
+                ]
+                self.assertEqual(
+                    result, expected, f"masks: {masks}, alpha: {surf_alpha}"
+                )
+
     def test_fill_blend(self):
         destinations = [
             self._make_surface(8),
@@ -4029,6 +4784,154 @@ class SurfaceBlendTest(unittest.TestCase):
                         ),
                     )
 
+    def test_surface_premul_alpha_ip(self):
+        """Ensure that .premul_alpha_ip() matches .premul_alpha() in place"""
+        # odd widths run the vector loops and their remainders
+        for w in (1, 3, 4, 7, 13, 33):
+            for format_args in ((pygame.SRCALPHA, 32), (pygame.SRCALPHA, 16)):
+                with self.subTest(w=w, format_args=format_args):
+                    surf = pygame.Surface((w, 5), *format_args)
+                    for x in range(w):
+                        for y in range(5):
+                            surf.set_at(
+                                (x, y), (x * 7 % 256, 200, y * 40, x * 19 % 256)
+                            )
+                    expected = surf.premul_alpha()
+                    self.assertFalse(expected.premultiplied)
+
+                    self.assertIs(surf.premul_alpha_ip(), surf)
+                    self.assertTrue(surf.premultiplied)
+                    for x in range(w):
+                        for y in range(5):
+                            self.assertEqual(
+                                surf.get_at((x, y)), expected.get_at((x, y))
+                            )
+
+        # only the area of a subsurface changes
+        surf = pygame.Surface((10, 10), pygame.SRCALPHA)
+        surf.fill((255, 255, 255, 100))
+        surf.subsurface((2, 2, 5, 5)).premul_alpha_ip()
+        self.assertEqual(surf.get_at((1, 1)), (255, 255, 255, 100))
+        self.assertEqual(surf.get_at((2, 2)), (100, 100, 100, 100))
+        self.assertEqual(surf.get_at((6, 6)), (100, 100, 100, 100))
+        self.assertEqual(surf.get_at((7, 7)), (255, 255, 255, 100))
+
+        with self.assertRaises(ValueError):
+            pygame.Surface((10, 10), 0, 32).premul_alpha_ip()
+
+    def test_premultiplied_blits(self):
+        """Ensure that premultiplied surfaces blend as premultiplied by default"""
+        src = pygame.Surface((8, 8), pygame.SRCALPHA)
+        src.fill((200, 100, 50, 128))
+        src.premul_alpha_ip()
+
+        tagged = pygame.Surface((8, 8))
+        tagged.fill((10, 20, 30))
+        explicit = tagged.copy()
+        tagged.blit(src, (0, 0))
+        explicit.blit(src, (0, 0), special_flags=pygame.BLEND_PREMULTIPLIED)
+        self.assertEqual(tagged.get_at((3, 3)), explicit.get_at((3, 3)))
+
+        # the tag is kept by copies and subsurfaces, and can be cleared
+        self.assertTrue(src.copy().premultiplied)
+        self.assertTrue(src.subsurface((0, 0, 2, 2)).premultiplied)
+        src.premultiplied = False
+        self.assertFalse(src.premultiplied)
+        plain = pygame.Surface((8, 8))
+        plain.fill((10, 20, 30))
+        plain.blit(src, (0, 0))
+        self.assertNotEqual(plain.get_at((3, 3)), explicit.get_at((3, 3)))
+
+        # explicit flags still win
+        src.premultiplied = True
+        added = pygame.Surface((8, 8))
+        added.blit(src, (0, 0), special_flags=pygame.BLEND_ADD)
+        self.assertEqual(added.get_at((3, 3))[:3], src.get_at((3, 3))[:3])
+
+    def test_set_alpha_spans(self):
+        """Ensure blits using the alpha span index match plain alpha blits"""
+        src = pygame.Surface((40, 12), pygame.SRCALPHA)
+        src.fill((200, 100, 50, 255), (10, 0, 20, 12))
+        src.fill((20, 40, 60, 128), (16, 3, 3, 6))
+        src.fill((90, 90, 90, 40), (34, 0, 4, 12))
+        plain = src.copy()
+        src.set_alpha_spans(True)
+
+        def check(dst_flags, dst_depth, pos):
+            dst = pygame.Surface((37, 15), dst_flags, dst_depth)
+            dst.fill((30, 60, 90, 200))
+            expected = dst.copy()
+            dst.blit(src, pos)
+            expected.blit(plain, pos)
+            for y in range(dst.get_height()):
+                for x in range(dst.get_width()):
+                    self.assertEqual(dst.get_at((x, y)), expected.get_at((x, y)))
+
+        for pos in ((0, 0), (3, 2), (-5, -1), (1, 7)):
+            check(pygame.SRCALPHA, 32, pos)
+            check(0, 32, pos)
+            check(0, 24, pos)
+
+        # changes to the source are picked up on the next blit
+        src.fill((0, 0, 0, 0), (10, 0, 20, 12))
+        plain.fill((0, 0, 0, 0), (10, 0, 20, 12))
+        check(pygame.SRCALPHA, 32, (2, 1))
+
+        src.set_alpha_spans(False)
+        check(0, 32, (2, 1))
+        with self.assertRaises(ValueError):
+            pygame.Surface((10, 10), 0, 8).set_alpha_spans(True)
+
+    def test_set_alpha_spans_colorkey_and_blend_flags(self):
+        """Ensure colorkey and blend mode blits using the spans match"""
+
+        def check(src, plain, dst, pos, flags=0):
+            expected = dst.copy()
+            dst.blit(src, pos, special_flags=flags)
+            expected.blit(plain, pos, special_flags=flags)
+            for y in range(dst.get_height()):
+                for x in range(dst.get_width()):
+                    self.assertEqual(dst.get_at((x, y)), expected.get_at((x, y)))
+
+        for depth in (16, 24, 32):
+            src = pygame.Surface((40, 10), 0, depth)
+            src.fill((255, 0, 255))
+            src.fill((10, 200, 30), (12, 0, 16, 10))
+            src.fill((0, 0, 0), (30, 2, 9, 5))
+            src.set_colorkey((255, 0, 255))
+            plain = src.copy()
+            src.set_alpha_spans(True)
+            for pos in ((0, 0), (-3, 4), (5, -2)):
+                dst = pygame.Surface((36, 12), 0, depth)
+                dst.fill((40, 80, 120))
+                check(src, plain, dst, pos)
+
+            # a new colorkey finds the runs again
+            src.set_colorkey((10, 200, 30))
+            plain.set_colorkey((10, 200, 30))
+            dst = pygame.Surface((36, 12), 0, depth)
+            check(src, plain, dst, (1, 1))
+
+        src = pygame.Surface((40, 10), pygame.SRCALPHA)
+        src.fill((60, 70, 80, 90), (10, 0, 12, 10))
+        src.fill((5, 250, 5, 255), (25, 3, 10, 4))
+        plain = src.copy()
+        src.set_alpha_spans(True)
+        for flags in (
+            pygame.BLEND_ADD,
+            pygame.BLEND_SUB,
+            pygame.BLEND_MAX,
+            pygame.BLEND_MULT,
+            pygame.BLEND_RGBA_ADD,
+            pygame.BLEND_RGBA_SUB,
+            pygame.BLEND_RGBA_MAX,
+            pygame.BLEND_PREMULTIPLIED,
+        ):
+            for dst_flags in (0, pygame.SRCALPHA):
+                dst = pygame.Surface((36, 12), dst_flags, 32)
+                dst.fill((100, 110, 120, 130))
+                check(src, plain, dst, (-2, 1), flags)
+
 
 class SurfaceSelfBlitTest(unittest.TestCase):
     """Blit to self tests.
@@ -4301,5 +5204,237 @@ class SurfaceFillTest(unittest.TestCase):
                 )
 
 
+class SurfaceDirtyRectTest(unittest.TestCase):
+    def test_dirty_rects_not_enabled(self):
+        surf = pygame.Surface((10, 10))
+        self.assertRaises(pygame.error, surf.get_dirty_rects)
+
+        surf.set_dirty_tracking(True)
+        surf.set_dirty_tracking(False)
+        self.assertRaises(pygame.error, surf.get_dirty_rects)
+
+    def test_dirty_rects_fill_and_set_at(self):
+        surf = pygame.Surface((100, 100))
+        surf.set_dirty_tracking(True)
+        self.assertEqual(surf.get_dirty_rects(), [])
+
+        surf.fill("red", (10, 10, 20, 20))
+        surf.set_at((80, 80), "blue")
+        self.assertEqual(
+            sorted(surf.get_dirty_rects()),
+            [pygame.Rect(10, 10, 20, 20), pygame.Rect(80, 80, 1, 1)],
+        )
+        # cleared by default
+        self.assertEqual(surf.get_dirty_rects(), [])
+
+    def test_dirty_rects_clip_and_merge(self):
+        surf = pygame.Surface((100, 100))
+        surf.set_dirty_tracking(True)
+
+        surf.fill("red", (-10, -10, 30, 30))
+        surf.fill("red", (5, 5, 20, 20))
+        self.assertEqual(surf.get_dirty_rects(clear=False), [pygame.Rect(0, 0, 25, 25)])
+        self.assertEqual(surf.get_dirty_rects(), [pygame.Rect(0, 0, 25, 25)])
+
+        # many small rects never exceed the tracker capacity
+        for i in range(100):
+            surf.set_at((i, (i * 37) % 100), "white")
+        rects = surf.get_dirty_rects()
+        self.assertLessEqual(len(rects), 32)
+        for i in range(100):
+            self.assertTrue(any(r.collidepoint(i, (i * 37) % 100) for r in rects))
+
+    def test_dirty_rects_blit_and_draw(self):
+        surf = pygame.Surface((100, 100))
+        surf.set_dirty_tracking(True)
+
+        surf.blit(pygame.Surface((10, 10)), (90, 90))
+        self.assertEqual(surf.get_dirty_rects(), [pygame.Rect(90, 90, 10, 10)])
+
+        drawn = pygame.draw.line(surf, "white", (0, 50), (20, 50))
+        self.assertEqual(surf.get_dirty_rects(), [drawn])
+
+        drawn = pygame.draw.rect(surf, "white", (40, 40, 10, 10))
+        self.assertEqual(surf.get_dirty_rects(), [drawn])
+
+    def test_dirty_rects_subsurface(self):
+        surf = pygame.Surface((100, 100))
+        surf.set_dirty_tracking(True)
+        sub = surf.subsurface((20, 30, 40, 40))
+
+        sub.fill("red", (5, 5, 10, 10))
+        self.assertEqual(surf.get_dirty_rects(), [pygame.Rect(25, 35, 10, 10)])
+        self.assertRaises(pygame.error, sub.get_dirty_rects)
+
+
+class SurfaceVersionTest(unittest.TestCase):
+    def test_get_version_writes(self):
+        surf = pygame.Surface((20, 20))
+        last = surf.get_version()
+
+        def changed():
+            nonlocal last
+            version = surf.get_version()
+            result = version > last
+            last = version
+            return result
+
+        surf.fill("red")
+        self.assertTrue(changed())
+        surf.set_at((1, 1), "blue")
+        self.assertTrue(changed())
+        surf.blit(pygame.Surface((5, 5)), (0, 0))
+        self.assertTrue(changed())
+        pygame.draw.circle(surf, "white", (10, 10), 5)
+        self.assertTrue(changed())
+        surf.set_colorkey((0, 0, 0))
+        self.assertTrue(changed())
+        surf.set_alpha(100)
+        self.assertTrue(changed())
+
+        pixels = pygame.PixelArray(surf)
+        self.assertTrue(changed())
+        pixels[0, 0] = 0x123456
+        del pixels
+        self.assertTrue(changed())
+
+    def test_get_version_reads(self):
+        surf = pygame.Surface((20, 20))
+        surf.fill("red")
+        version = surf.get_version()
+
+        surf.get_at((1, 1))
+        surf.copy()
+        pygame.Surface((20, 20)).blit(surf, (0, 0))
+        pygame.transform.rotate(surf, 30)
+        surf.lock()
+        surf.unlock()
+        self.assertEqual(surf.get_version(), version)
+
+    def test_get_version_subsurface(self):
+        surf = pygame.Surface((20, 20))
+        sub = surf.subsurface((5, 5, 10, 10))
+        version, sub_version = surf.get_version(), sub.get_version()
+
+        # reading through a subsurface does not change the parent
+        pygame.Surface((10, 10)).blit(sub, (0, 0))
+        self.assertEqual(surf.get_version(), version)
+
+        # writes through the subsurface are seen on the parent
+        sub.fill("red")
+        self.assertGreater(surf.get_version(), version)
+        self.assertGreater(sub.get_version(), sub_version)
+
+        # and writes to the parent are seen on the subsurface
+        sub_version = sub.get_version()
+        surf.set_at((0, 0), "blue")
+        self.assertGreater(sub.get_version(), sub_version)
+
+    def test_snapshot_restore(self):
+        surf = pygame.Surface((200, 150))
+        surf.fill("white")
+        first = surf.snapshot()
+        self.assertIsInstance(first, pygame.surface.SurfaceSnapshot)
+
+        pygame.draw.line(surf, "red", (0, 0), (199, 149), 3)
+        second = surf.snapshot()
+        surf.fill("blue", (100, 100, 20, 20))
+        with pygame.PixelArray(surf) as pixels:
+            pixels[5, 140] = 0x00FF00
+
+        surf.restore(second)
+        self.assertEqual(surf.get_at((110, 110)), pygame.Color("white"))
+        self.assertEqual(surf.get_at((5, 140)), pygame.Color("white"))
+        self.assertEqual(surf.get_at((100, 75)), pygame.Color("red"))
+
+        # undo and redo
+        surf.restore(first)
+        self.assertEqual(surf.get_at((100, 75)), pygame.Color("white"))
+        surf.restore(second)
+        self.assertEqual(surf.get_at((100, 75)), pygame.Color("red"))
+
+        self.assertRaises(ValueError, pygame.Surface((200, 150)).restore, first)
+        self.assertRaises(ValueError, surf.subsurface((0, 0, 8, 8)).snapshot)
+        self.assertRaises(TypeError, surf.restore, None)
+
+
+class SurfacePoolTest(unittest.TestCase):
+    def tearDown(self):
+        pygame.surface.set_pool_limit(0)
+
+    def test_pool(self):
+        surf = pygame.Surface((20, 10), pygame.SRCALPHA)
+        surf.fill((10, 20, 30, 40))
+        stats = pygame.surface.get_pool_stats()
+        self.assertEqual(stats["limit"], 0)
+        self.assertEqual(stats["count"], 0)
+
+        pygame.surface.set_pool_limit(1 << 20)
+        flipped = pygame.transform.flip(surf, True, False)
+        flipped.set_colorkey((1, 2, 3))
+        flipped.set_alpha(100)
+        del flipped
+        stats = pygame.surface.get_pool_stats()
+        self.assertEqual(stats["limit"], 1 << 20)
+        self.assertEqual(stats["count"], 1)
+        self.assertEqual(stats["bytes"], 20 * 10 * 4)
+
+        # reused, without the state set on the old result
+        hits = stats["hits"]
+        flipped = pygame.transform.flip(surf, False, True)
+        stats = pygame.surface.get_pool_stats()
+        self.assertEqual(stats["hits"], hits + 1)
+        self.assertEqual(stats["count"], 0)
+        self.assertIsNone(flipped.get_colorkey())
+        self.assertEqual(flipped.get_alpha(), 255)
+        self.assertEqual(flipped.get_at((5, 5)), (10, 20, 30, 40))
+
+        # surfaces created by the user are never pooled
+        del surf
+        self.assertEqual(pygame.surface.get_pool_stats()["count"], 0)
+
+        del flipped
+        pygame.surface.set_pool_limit(0)
+        self.assertEqual(pygame.surface.get_pool_stats()["count"], 0)
+        self.assertRaises(ValueError, pygame.surface.set_pool_limit, -1)
+
+
+class SurfaceRowAlignmentTest(unittest.TestCase):
+    def tearDown(self):
+        pygame.surface.set_row_alignment(0)
+
+    def test_row_alignment(self):
+        self.assertEqual(pygame.surface.get_row_alignment(), 0)
+        plain = pygame.Surface((13, 7), pygame.SRCALPHA)
+        self.assertEqual(plain.get_pitch(), 13 * 4)
+
+        pygame.surface.set_row_alignment(64)
+        self.assertEqual(pygame.surface.get_row_alignment(), 64)
+        for depth in (8, 16, 24, 32):
+            surf = pygame.Surface((13, 7), 0, depth)
+            self.assertEqual(surf.get_pitch() % 64, 0, depth)
+            self.assertEqual(surf.get_at((12, 6)), surf.get_at((0, 0)), depth)
+        aligned = pygame.Surface((13, 7), pygame.SRCALPHA)
+        self.assertEqual(aligned.get_pitch(), 64)
+        self.assertEqual(pygame.transform.flip(plain, True, False).get_pitch(), 64)
+
+        # the aligned paths of fills and blits give the same pixels
+        src = pygame.Surface((13, 7), pygame.SRCALPHA)
+        for y in range(7):
+            for x in range(13):
+                src.set_at((x, y), (x * 19, y * 36, 200, x * y * 3))
+        for surf in (plain, aligned):
+            surf.fill((40, 80, 120, 255))
+            surf.fill((30, 20, 10, 0), special_flags=pygame.BLEND_RGBA_ADD)
+            surf.blit(src, (0, 0), special_flags=pygame.BLEND_RGBA_MULT)
+            surf.blit(src, (0, 0))
+        self.assertEqual(
+            pygame.image.tobytes(aligned, "RGBA"), pygame.image.tobytes(plain, "RGBA")
+        )
+
+        for bad in (-1, 3, 48, 512):
+            self.assertRaises(ValueError, pygame.surface.set_row_alignment, bad)
+
+
 if __name__ == "__main__":
     unittest.main()
@@ -617,6 +617,38 @@ class SurfarrayModuleTest(unittest.TestCase):
         self.assertRaises(ValueError, do_pixels3d, self._make_surface(8))
         self.assertRaises(ValueError, do_pixels3d, self._make_surface(16))
 
+    def test_pixels3d__channel_orders(self):
+        """pixels3d and pixels_alpha reference any byte aligned layout"""
+        layouts = [
+            (32, (0xFF, 0xFF00, 0xFF0000, 0xFF000000)),
+            (32, (0xFF0000, 0xFF00, 0xFF, 0xFF000000)),
+            (32, (0xFF000000, 0xFF0000, 0xFF00, 0xFF)),
+            (32, (0xFF00, 0xFF0000, 0xFF000000, 0xFF)),
+            (24, (0xFF, 0xFF00, 0xFF0000, 0)),
+            (24, (0xFF0000, 0xFF00, 0xFF, 0)),
+        ]
+        for depth, masks in layouts:
+            flags = SRCALPHA if masks[3] else 0
+            surf = pygame.Surface((5, 3), flags, depth, masks)
+            surf.fill((10, 20, 30, 40))
+            surf.set_at((4, 2), (50, 60, 70, 80))
+
+            arr = pygame.surfarray.pixels3d(surf)
+            self.assertEqual(tuple(arr[0, 0]), (10, 20, 30))
+            self.assertEqual(tuple(arr[4, 2]), (50, 60, 70))
+            arr[1, 1] = (1, 2, 3)
+            del arr
+            self.assertEqual(surf.get_at((1, 1))[:3], (1, 2, 3))
+            if masks[3]:
+                alpha = pygame.surfarray.pixels_alpha(surf)
+                self.assertEqual(alpha[4, 2], 80)
+                del alpha
+
+        # the color bytes are not evenly spaced
+        surf = pygame.Surface((5, 3), 0, 32, (0xFF, 0xFF0000, 0xFF00, 0))
+        self.assertRaises(ValueError, pygame.surfarray.pixels3d, surf)
+        self.assertEqual(pygame.surfarray.pixels_red(surf).shape, (5, 3))
+
     def test_pixels_alpha(self):
         palette = [
             (0, 0, 0, 0),
@@ -118,6 +118,142 @@ class SystemModuleTest(unittest.TestCase):
                 1,
             )
 
+    def test_get_freelist_stats(self):
+        keys = {"hits", "misses", "size", "max_size", "hit_rate"}
+        stats = pygame.system.get_freelist_stats()
+        self.assertEqual(set(stats), {"Vector2", "Vector3", "Rect", "FRect"})
+        for type_stats in stats.values():
+            self.assertEqual(set(type_stats), keys)
+            self.assertGreaterEqual(type_stats["size"], 0)
+            self.assertLessEqual(type_stats["size"], type_stats["max_size"])
+            self.assertGreaterEqual(type_stats["hit_rate"], 0.0)
+            self.assertLessEqual(type_stats["hit_rate"], 1.0)
+
+        before = stats["Vector2"]
+        a = pygame.Vector2(1, 2)
+        for _ in range(100):
+            a = a + a * 0.5
+        after = pygame.system.get_freelist_stats()["Vector2"]
+        self.assertGreater(
+            after["hits"] + after["misses"], before["hits"] + before["misses"]
+        )
+        self.assertGreater(after["hits"], before["hits"])
+
+        # temporaries should be reused, and subclasses are never cached
+        class SubRect(pygame.Rect):
+            pass
+
+        before = pygame.system.get_freelist_stats()["Rect"]
+        for _ in range(10):
+            SubRect(1, 2, 3, 4).move(1, 1)
+        after = pygame.system.get_freelist_stats()["Rect"]
+        self.assertEqual(after["hits"], before["hits"])
+        self.assertEqual(after["misses"], before["misses"])
+
+        self.assertRaises(TypeError, pygame.system.get_freelist_stats, 1)
+
+    def test_get_perf_counters(self):
+        counters = pygame.system.get_perf_counters()
+        if not counters:
+            self.skipTest("built without perf counters")
+        self.assertEqual(
+            set(counters), {"blit", "fill", "transform", "text", "event", "flip"}
+        )
+        for counter in counters.values():
+            self.assertEqual(set(counter), {"calls", "pixels", "ns"})
+
+        pygame.system.reset_perf_counters()
+        counters = pygame.system.get_perf_counters()
+        for counter in counters.values():
+            self.assertEqual(counter, {"calls": 0, "pixels": 0, "ns": 0})
+
+        surf = pygame.Surface((10, 20))
+        surf.fill("red")
+        surf.blit(pygame.Surface((5, 5)), (0, 0))
+        pygame.transform.flip(surf, True, False)
+
+        counters = pygame.system.get_perf_counters()
+        self.assertEqual(counters["fill"]["calls"], 1)
+        self.assertEqual(counters["fill"]["pixels"], 200)
+        self.assertEqual(counters["blit"]["calls"], 1)
+        self.assertEqual(counters["blit"]["pixels"], 25)
+        self.assertEqual(counters["transform"]["calls"], 1)
+        self.assertEqual(counters["transform"]["pixels"], 200)
+
+    def test_simd_dispatch(self):
+        import pygame.mask
+        import pygame.transform
+
+        self.addCleanup(pygame.system.set_simd_level, "avx2")
+        backends = ("avx2", "sse2", "neon", "scalar", "sse", "mmx")
+        dispatch = pygame.system.get_simd_dispatch()
+        for op in ("blit", "fill", "transform", "smoothscale", "mask", "noise"):
+            self.assertIn(dispatch[op], backends)
+        try:
+            import pygame.freetype
+        except ImportError:
+            pass
+        else:
+            self.assertIn(
+                pygame.system.get_simd_dispatch()["freetype"], backends
+            )
+
+        src = pygame.Surface((37, 5), pygame.SRCALPHA)
+        src.fill((200, 100, 50, 128))
+        results = []
+        for level in ("avx2", "scalar"):
+            pygame.system.set_simd_level(level)
+            dst = pygame.Surface((37, 5))
+            dst.fill((10, 20, 30))
+            dst.blit(src, (0, 0), special_flags=pygame.BLEND_RGBA_ADD)
+            results.append(pygame.image.tobytes(dst, "RGBA"))
+
+        self.assertEqual(
+            set(pygame.system.get_simd_dispatch().values()), {"scalar"}
+        )
+        self.assertEqual(results[0], results[1])
+
+        with self.assertRaises(ValueError):
+            pygame.system.set_simd_level("avx512")
+
+    def test_surface_memory(self):
+        def counters():
+            memory = pygame.system.get_surface_memory()
+            return (
+                memory["total"],
+                memory["origins"]["surface"],
+                memory["origins"]["transform"],
+                memory["formats"].get("ARGB8888"),
+            )
+
+        pygame.system.reset_surface_memory_peaks()
+        before = counters()
+
+        surf = pygame.Surface((16, 8), pygame.SRCALPHA, 32)
+        scaled = pygame.transform.scale(surf, (32, 8))
+        sub = surf.subsurface((0, 0, 4, 4))
+        total, surface, transform, argb = counters()
+        self.assertEqual(total["count"], before[0]["count"] + 3)
+        self.assertEqual(surface["count"], before[1]["count"] + 2)
+        self.assertEqual(surface["bytes"], before[1]["bytes"] + surf.get_pitch() * 8)
+        self.assertEqual(transform["count"], before[2]["count"] + 1)
+        self.assertEqual(
+            transform["bytes"], before[2]["bytes"] + scaled.get_pitch() * 8
+        )
+        self.assertGreaterEqual(argb["count"], 3)
+        self.assertGreaterEqual(total["peak_bytes"], total["bytes"])
+
+        del surf, scaled, sub
+        total, surface, transform, _ = counters()
+        self.assertEqual(total["count"], before[0]["count"])
+        self.assertEqual(total["bytes"], before[0]["bytes"])
+        self.assertGreater(total["peak_bytes"], total["bytes"])
+
+        pygame.system.reset_surface_memory_peaks()
+        total = pygame.system.get_surface_memory()["total"]
+        self.assertEqual(total["peak_bytes"], total["bytes"])
+        self.assertEqual(total["peak_count"], total["count"])
+
 
 if __name__ == "__main__":
     unittest.main()
@@ -239,6 +239,49 @@ class ClockTypeTest(unittest.TestCase):
             c.tick_busy_loop(bool_fps), (second_length / bool_fps) - shortfall_tolerance
         )
 
+    def test_get_frame_stats(self):
+        """Test get_frame_stats summarises the recorded frame times"""
+        c = Clock()
+        stats = c.get_frame_stats()
+        self.assertEqual(stats["count"], 0)
+        self.assertEqual(len(stats["samples"]), 0)
+
+        c.tick()
+        for _ in range(20):
+            pygame.time.delay(2)
+            c.tick()
+
+        stats = c.get_frame_stats()
+        self.assertEqual(stats["count"], 20)
+        samples = stats["samples"]
+        self.assertEqual(samples.format, "f")
+        self.assertEqual(len(samples), 20)
+        self.assertAlmostEqual(stats["max"], max(samples), places=5)
+        self.assertAlmostEqual(stats["mean"], sum(samples) / 20, places=3)
+        self.assertLessEqual(stats["p50"], stats["p95"])
+        self.assertLessEqual(stats["p95"], stats["p99"])
+        self.assertLessEqual(stats["p99"], stats["max"])
+        self.assertGreaterEqual(stats["p50"], 1.5)
+
+    def test_tick_precise(self):
+        """Test tick_precise keeps an accurate average framerate"""
+        c = Clock()
+        self.assertIsInstance(c.tick_precise(), float)
+        self.assertRaises(ValueError, c.tick_precise, -1)
+
+        fps = 240
+        frames = 48
+        c.tick_precise(fps)
+        start = time.perf_counter()
+        times = [c.tick_precise(fps) for _ in range(frames)]
+        elapsed = time.perf_counter() - start
+
+        # frames are scheduled back to back, so the total does not drift
+        self.assertAlmostEqual(elapsed, frames / fps, delta=0.02)
+        self.assertAlmostEqual(sum(times) / 1000, elapsed, delta=0.005)
+        for t in times:
+            self.assertGreater(t, 0.0)
+
 
 class TimeModuleTest(unittest.TestCase):
     __tags__ = ["timing"]
@@ -465,6 +508,41 @@ class TimeModuleTest(unittest.TestCase):
             self.assertEqual(pygame.event.get().count(e), repeat)
         pygame.quit()
 
+    def test_set_timer_sub_millisecond(self):
+        """Tests that set_timer accepts fractional milliseconds"""
+        pygame.init()
+        TIMER_EVENT_TYPE = pygame.event.custom_type()
+        timer_event = pygame.event.Event(TIMER_EVENT_TYPE)
+        pygame.event.clear()
+
+        pygame.time.set_timer(TIMER_EVENT_TYPE, 0.5, loops=20)
+        pygame.time.delay(100)
+        self.assertEqual(pygame.event.get().count(timer_event), 20)
+
+        # the timer is gone after its loops ran out
+        pygame.time.delay(20)
+        self.assertNotIn(timer_event, pygame.event.get())
+        pygame.quit()
+
+    def test_set_timer_cpu_use(self):
+        """Tests that a millisecond timer sleeps between its events"""
+        pygame.init()
+        TIMER_EVENT_TYPE = pygame.event.custom_type()
+        timer_event = pygame.event.Event(TIMER_EVENT_TYPE)
+        pygame.event.clear()
+
+        start_cpu = time.process_time()
+        start = time.perf_counter()
+        pygame.time.set_timer(TIMER_EVENT_TYPE, 16, loops=20)
+        pygame.time.wait(400)
+        cpu = time.process_time() - start_cpu
+        wall = time.perf_counter() - start
+
+        self.assertEqual(pygame.event.get().count(timer_event), 20)
+        # a spinning scheduler thread would use about as much as the wall time
+        self.assertLess(cpu, wall / 2)
+        pygame.quit()
+
     def test_wait(self):
         """Tests time.wait() function."""
         millis = 100  # millisecond to wait on each iteration
@@ -133,6 +133,47 @@ def hsl_to_rgb(hsl):
     return int(r * 255), int(g * 255), int(b * 255)
 
 
+def scale_nx(surf, factor):
+    """The AdvanceMAME Scale2x and Scale3x rules, returns rows of mapped pixels"""
+    w, h = surf.get_size()
+
+    def get(x, y):
+        x = min(max(x, 0), w - 1)
+        y = min(max(y, 0), h - 1)
+        return surf.get_at_mapped((x, y))
+
+    out = [[0] * (w * factor) for _ in range(h * factor)]
+    for y in range(h):
+        for x in range(w):
+            A, B, C = get(x - 1, y - 1), get(x, y - 1), get(x + 1, y - 1)
+            D, E, F = get(x - 1, y), get(x, y), get(x + 1, y)
+            G, H, I = get(x - 1, y + 1), get(x, y + 1), get(x + 1, y + 1)
+            block = [E] * (factor * factor)
+            if B != H and D != F:
+                if factor == 2:
+                    block = [
+                        D if D == B else E,
+                        F if B == F else E,
+                        D if D == H else E,
+                        F if H == F else E,
+                    ]
+                else:
+                    block = [
+                        D if D == B else E,
+                        B if (D == B and E != C) or (B == F and E != A) else E,
+                        F if B == F else E,
+                        D if (D == B and E != G) or (D == H and E != A) else E,
+                        E,
+                        F if (B == F and E != I) or (H == F and E != C) else E,
+                        D if D == H else E,
+                        H if (D == H and E != I) or (H == F and E != G) else E,
+                        F if H == F else E,
+                    ]
+            for i, pixel in enumerate(block):
+                out[y * factor + i // factor][x * factor + i % factor] = pixel
+    return out
+
+
 def modify_hsl(h, s, l, dh, ds, dl):
     if dh:
         h += dh
@@ -218,6 +259,29 @@ class TransformModuleTest(unittest.TestCase):
         self.assertEqual((64, 64), s2.get_size())
         self.assertEqual((64, 64), s3.get_size())
 
+    def test_scale__nearest_pixels(self):
+        """scale() samples the source pixel under every destination center"""
+        w, h = 13, 7
+        for depth in (8, 16, 24, 32):
+            surf = pygame.Surface((w, h), 0, depth)
+            for y in range(h):
+                for x in range(w):
+                    surf.set_at((x, y), ((x * 19) % 256, (y * 37) % 256, 0))
+
+            for size in ((26, 14), (39, 7), (52, 28), (13, 7), (20, 5), (9, 30)):
+                scaled = pygame.transform.scale(surf, size)
+                incx = (w << 16) // size[0]
+                incy = (h << 16) // size[1]
+                for y in range(size[1]):
+                    sy = (incy // 2 + y * incy) >> 16
+                    for x in range(size[0]):
+                        sx = (incx // 2 + x * incx) >> 16
+                        self.assertEqual(
+                            scaled.get_at((x, y)),
+                            surf.get_at((sx, sy)),
+                            (depth, size, x, y),
+                        )
+
     def test_scale__zero_surface_transform(self):
         tmp_surface = pygame.transform.scale(pygame.Surface((128, 128)), (0, 0))
         self.assertEqual(tmp_surface.get_size(), (0, 0))
@@ -494,6 +558,108 @@ class TransformModuleTest(unittest.TestCase):
                             self.assertAlmostEqual(v1, v2, delta=1)
                         self.assertEqual(c_a, actual_color.a)
 
+    def test_hsl__32_bit_matches_24_bit(self):
+        """Ensure the 32 bit fast path gives the same pixels as 24 bit."""
+        size = (29, 13)
+        surfaces = []
+        for depth in (24, 32):
+            surf = pygame.Surface(size, 0, depth)
+            for x in range(size[0]):
+                for y in range(size[1]):
+                    color = ((x * 9) % 256, (y * 20) % 256, (x * y * 3) % 256)
+                    surf.set_at((x, y), color)
+            surfaces.append(surf)
+
+        for h, s, l in ((30, 0.2, -0.1), (-170, -0.5, 0.4), (0, 1, 0), (90, 0, -1)):
+            results = [
+                pygame.image.tobytes(pygame.transform.hsl(surf, h, s, l), "RGB")
+                for surf in surfaces
+            ]
+            self.assertEqual(results[0], results[1])
+
+    def test_color_matrix(self):
+        """Ensure color_matrix() applies the matrix to every pixel."""
+        identity = [
+            (1, 0, 0, 0, 0),
+            (0, 1, 0, 0, 0),
+            (0, 0, 1, 0, 0),
+            (0, 0, 0, 1, 0),
+        ]
+        swap_and_tint = [
+            (0, 0, 1, 0, 10),
+            (0, 1, 0, 0, -20),
+            (0.5, 0, 0, 0.5, 0),
+            (0, 0, 0, 0.25, 0),
+        ]
+        for flags, depth in ((pygame.SRCALPHA, 32), (0, 32), (0, 24), (0, 16)):
+            surf = pygame.Surface((19, 5), flags, depth)
+            surf.fill((200, 100, 40, 128))
+            color = surf.get_at((0, 0))
+
+            result = pygame.transform.color_matrix(surf, identity)
+            self.assertIsNot(result, surf)
+            self.assertEqual(result.get_size(), surf.get_size())
+            self.assertEqual(result.get_bitsize(), surf.get_bitsize())
+            self.assertEqual(result.get_at((18, 4)), color)
+
+            result = pygame.transform.color_matrix(surf, swap_and_tint)
+            expected = (
+                color.b + 10,
+                color.g - 20,
+                int(color.r * 0.5 + color.a * 0.5 + 0.5),
+                int(color.a * 0.25 + 0.5) if flags else 255,
+            )
+            expected = result.unmap_rgb(result.map_rgb(expected))
+            self.assertEqual(result.get_at((18, 4)), expected)
+
+    def test_color_matrix__clamp(self):
+        """Ensure color_matrix() clamps the results to 0 to 255."""
+        surf = pygame.Surface((9, 9), pygame.SRCALPHA, 32)
+        surf.fill((100, 150, 200, 250))
+        matrix = [
+            (2, 0, 0, 0, 0),
+            (0, -1, 0, 0, 0),
+            (0, 0, 1, 0, 100),
+            (0, 0, 0, 1, -300),
+        ]
+        result = pygame.transform.color_matrix(surf, matrix)
+        self.assertEqual(result.get_at((8, 8)), (200, 0, 255, 0))
+
+    def test_color_matrix__dest_surface(self):
+        """Ensure color_matrix() writes into the destination surface."""
+        surf = pygame.Surface((40, 3), pygame.SRCALPHA, 32)
+        surf.fill((10, 20, 30, 40))
+        dest = pygame.Surface((40, 3), pygame.SRCALPHA, 32)
+        matrix = [(0, 0, 0, 0, 1), (0, 0, 0, 0, 2), (0, 0, 0, 0, 3), (0, 0, 0, 0, 4)]
+
+        result = pygame.transform.color_matrix(surf, matrix, dest_surface=dest)
+        self.assertIs(result, dest)
+        self.assertEqual(dest.get_at((39, 2)), (1, 2, 3, 4))
+
+        # in place
+        result = pygame.transform.color_matrix(surf, matrix, surf)
+        self.assertIs(result, surf)
+        self.assertEqual(surf.get_at((0, 0)), (1, 2, 3, 4))
+
+        with self.assertRaises(ValueError):
+            pygame.transform.color_matrix(surf, matrix, pygame.Surface((40, 4)))
+        with self.assertRaises(ValueError):
+            pygame.transform.color_matrix(
+                surf, matrix, pygame.Surface((40, 3), 0, 24)
+            )
+
+    def test_color_matrix__invalid_matrix(self):
+        """Ensure color_matrix() rejects matrices of the wrong shape."""
+        surf = pygame.Surface((4, 4))
+        row = (1, 0, 0, 0, 0)
+
+        for matrix in ([row] * 3, [row] * 5, [row] * 3 + [(1, 0, 0, 0)], [row, 1]):
+            with self.assertRaises(ValueError):
+                pygame.transform.color_matrix(surf, matrix)
+        for matrix in (None, 1, [row] * 3 + [(1, 0, 0, 0, "x")]):
+            with self.assertRaises(TypeError):
+                pygame.transform.color_matrix(surf, matrix)
+
     def test_grayscale_simd_assumptions(self):
         # The grayscale SIMD algorithm relies on the destination surface pitch
         # being exactly width * 4 (4 bytes per pixel), for maximum speed.
@@ -1078,6 +1244,40 @@ class TransformModuleTest(unittest.TestCase):
         )
         self.assertEqual(num_threshold_pixels, 0)
 
+    def test_threshold__32_bit_matches_24_bit(self):
+        """Ensure 32 bit surfaces give the same results as 24 bit ones."""
+        size = (37, 23)
+        surfaces = {}
+        for depth in (24, 32):
+            surf = pygame.Surface(size, 0, depth)
+            for x in range(size[0]):
+                for y in range(size[1]):
+                    surf.set_at((x, y), ((x * 7) % 256, (y * 11) % 256, x * y % 256))
+            surfaces[depth] = surf
+
+        for search_surf in (False, True):
+            results = []
+            for depth in (24, 32):
+                dest = pygame.Surface(size, 0, depth)
+                dest.fill((1, 2, 3))
+                if search_surf:
+                    search = pygame.Surface(size, 0, depth)
+                    search.fill((100, 100, 100))
+                    args = {"search_color": None, "search_surf": search}
+                else:
+                    args = {"search_color": (100, 100, 100)}
+                num = pygame.transform.threshold(
+                    dest,
+                    surfaces[depth],
+                    threshold=(60, 70, 80),
+                    set_color=(255, 0, 0),
+                    **args,
+                )
+                data = pygame.image.tobytes(dest, "RGB")
+                results.append((num, data))
+            self.assertEqual(results[0], results[1])
+            self.assertNotEqual(results[0][0], 0)
+
     def test_threshold__subclassed_surface(self):
         """Ensure threshold accepts subclassed surfaces."""
         expected_size = (13, 11)
@@ -1308,6 +1508,197 @@ class TransformModuleTest(unittest.TestCase):
         self.assertEqual(dest_surface.get_size(), expected_size)
         self.assertEqual(dest_surface.get_flags(), expected_flags)
 
+    def test_accumulator(self):
+        """Ensure Accumulator averages surfaces like average_surfaces."""
+        size = (19, 7)
+        colors = ((10, 10, 70), (10, 20, 70), (10, 130, 10))
+        surfaces = []
+        for color in colors:
+            s = pygame.Surface(size, 0, 32)
+            s.fill(color)
+            surfaces.append(s)
+
+        acc = pygame.transform.Accumulator(size)
+        self.assertEqual(acc.size, size)
+        self.assertEqual(acc.count, 0)
+        self.assertRaises(ValueError, acc.get_average)
+
+        for s in surfaces:
+            acc.add(s)
+        self.assertEqual(acc.count, 3)
+
+        expected = pygame.transform.average_surfaces(surfaces)
+        average = acc.get_average()
+        self.assertIsInstance(average, pygame.Surface)
+        self.assertEqual(average.get_size(), size)
+        self.assertEqual(average.get_masks(), surfaces[0].get_masks())
+        for pos in ((0, 0), (18, 6), (9, 3)):
+            self.assertEqual(average.get_at(pos), expected.get_at(pos))
+
+        acc.clear()
+        self.assertEqual(acc.count, 0)
+        self.assertEqual(acc.size, size)
+        acc.add(surfaces[0])
+        self.assertEqual(acc.get_average().get_at((0, 0)), (10, 10, 70, 255))
+
+    def test_accumulator__rounding(self):
+        """Ensure Accumulator rounds each channel to the nearest value."""
+        acc = pygame.transform.Accumulator((4, 4))
+        for color in ((0, 1, 2, 255), (1, 1, 3, 255), (1, 2, 3, 255)):
+            s = pygame.Surface((4, 4), pygame.SRCALPHA, 32)
+            s.fill(color)
+            acc.add(s)
+        self.assertEqual(acc.get_average().get_at((3, 3)), (1, 1, 3, 255))
+
+    def test_accumulator__alpha(self):
+        """Ensure Accumulator averages the alpha channel too."""
+        acc = pygame.transform.Accumulator((5, 3))
+        for color in ((100, 0, 0, 0), (0, 100, 0, 200)):
+            s = pygame.Surface((5, 3), pygame.SRCALPHA, 32)
+            s.fill(color)
+            acc.add(s)
+        self.assertEqual(acc.get_average().get_at((4, 2)), (50, 50, 0, 100))
+
+    def test_accumulator__mixed_formats(self):
+        """Ensure Accumulator converts surfaces of other formats."""
+        size = (11, 5)
+        s32 = pygame.Surface(size, 0, 32)
+        s32.fill((10, 20, 30))
+        s24 = pygame.Surface(size, 0, 24)
+        s24.fill((30, 40, 50))
+        s8 = pygame.Surface(size, 0, 8)
+        s8.set_palette_at(1, (50, 60, 70))
+        s8.fill(1)
+
+        acc = pygame.transform.Accumulator(size)
+        for s in (s32, s24, s8):
+            acc.add(s)
+        average = acc.get_average()
+        self.assertEqual(average.get_bitsize(), 32)
+        self.assertEqual(average.get_at((10, 4)), (30, 40, 50, 255))
+
+        acc = pygame.transform.Accumulator(size)
+        acc.add(s24)
+        acc.add(s24)
+        self.assertEqual(acc.get_average().get_at((0, 0)), (30, 40, 50, 255))
+
+    def test_accumulator__dest_surface(self):
+        """Ensure Accumulator writes into a given destination surface."""
+        size = (8, 6)
+        acc = pygame.transform.Accumulator(size)
+        for color in ((10, 10, 20), (20, 20, 10)):
+            s = pygame.Surface(size, 0, 32)
+            s.fill(color)
+            acc.add(s)
+
+        for depth in (32, 24, 16):
+            dest = pygame.Surface(size, 0, depth)
+            result = acc.get_average(dest_surface=dest)
+            self.assertIs(result, dest)
+            expected = dest.unmap_rgb(dest.map_rgb((15, 15, 15)))
+            self.assertEqual(dest.get_at((7, 5)), expected)
+
+        self.assertRaises(ValueError, acc.get_average, pygame.Surface((8, 7), 0, 32))
+        self.assertRaises(TypeError, acc.get_average, 1)
+
+    def test_accumulator__errors(self):
+        """Ensure Accumulator rejects bad sizes and surfaces."""
+        self.assertRaises(TypeError, pygame.transform.Accumulator, 1)
+        self.assertRaises(ValueError, pygame.transform.Accumulator, (-1, 4))
+
+        acc = pygame.transform.Accumulator((4, 4))
+        self.assertRaises(TypeError, acc.add, 1)
+        self.assertRaises(TypeError, acc.add, None)
+        self.assertRaises(ValueError, acc.add, pygame.Surface((4, 5)))
+        self.assertEqual(acc.count, 0)
+
+    def test_lightmap(self):
+        """Ensure LightMap multiplies a surface by the ambient and added light."""
+        lights = pygame.transform.LightMap((10, 10), (64, 64, 64))
+        self.assertEqual(lights.size, (10, 10))
+        self.assertEqual(lights.ambient, (64, 64, 64))
+        light = pygame.Surface((4, 4), 0, 32)
+        light.fill((191, 191, 191))
+        lights.add(light, (2, 2))
+
+        scene = pygame.Surface((12, 12), pygame.SRCALPHA, 32)
+        scene.fill((200, 100, 50, 77))
+        self.assertEqual(lights.apply(scene), (0, 0, 10, 10))
+        # a light of 255 keeps the color, the alpha is never changed
+        self.assertEqual(scene.get_at((2, 5)), (200, 100, 50, 77))
+        self.assertEqual(scene.get_at((6, 6)), (50, 25, 13, 77))
+        self.assertEqual(scene.get_at((10, 10)), (200, 100, 50, 77))
+
+        # the light adds up past full brightness
+        lights.add(light, pygame.Rect(2, 2, 1, 1))
+        scene.fill((200, 100, 50, 77))
+        lights.apply(scene)
+        self.assertEqual(scene.get_at((5, 5)), (255, 175, 88, 77))
+
+        lights.clear()
+        scene.fill((200, 100, 50, 77))
+        lights.apply(scene)
+        self.assertEqual(scene.get_at((5, 5)), (50, 25, 13, 77))
+
+    def test_lightmap__add(self):
+        """Ensure LightMap.add scales, clips and blends the lights."""
+        lights = pygame.transform.LightMap((6, 6))
+        light = pygame.Surface((4, 4), pygame.SRCALPHA, 32)
+        light.fill((255, 255, 255, 128))
+        lights.add(light, (-2, -2))
+        light.fill((191, 191, 191, 255))
+        lights.add(light, (4, 4), special_flags=pygame.BLEND_MAX)
+        lights.add(light, (4, 4), special_flags=pygame.BLEND_RGBA_MAX)
+        light.fill((255, 255, 255))
+        lights.add(light, (0, 4), intensity=128)
+
+        scene = pygame.Surface((6, 6), 0, 32)
+        scene.fill((200, 200, 200))
+        lights.apply(scene)
+        self.assertEqual(scene.get_at((1, 1)), (100, 100, 100, 255))
+        self.assertEqual(scene.get_at((2, 2)), (0, 0, 0, 255))
+        self.assertEqual(scene.get_at((5, 5)), (150, 150, 150, 255))
+        self.assertEqual(scene.get_at((0, 5)), (100, 100, 100, 255))
+
+    def test_lightmap__formats(self):
+        """Ensure LightMap lights and applies to surfaces of any format."""
+        lights = pygame.transform.LightMap((5, 5), "gray25")
+        light = pygame.Surface((5, 5), 0, 24)
+        light.fill((127, 0, 191))
+        lights.add(light, (0, 0))
+
+        masks = (0xFF, 0xFF00, 0xFF0000, 0)
+        for scene in (
+            pygame.Surface((5, 5), 0, 32, masks),
+            pygame.Surface((5, 5), 0, 24),
+            pygame.Surface((5, 5), 0, 16),
+        ):
+            with self.subTest(depth=scene.get_bitsize()):
+                scene.fill((128, 128, 128))
+                before = scene.get_at((4, 4))
+                rect = lights.apply(scene, (1, 2))
+                self.assertEqual(rect, (1, 2, 4, 3))
+                self.assertEqual(scene.get_at((0, 0)), before)
+                lit = [(c * l + 255) >> 8 for c, l in zip(before, (191, 64, 255))]
+                expected = scene.unmap_rgb(scene.map_rgb(lit))
+                self.assertEqual(scene.get_at((4, 4)), expected)
+
+    def test_lightmap__errors(self):
+        """Ensure LightMap rejects bad sizes and arguments."""
+        self.assertRaises(TypeError, pygame.transform.LightMap, 1)
+        self.assertRaises(ValueError, pygame.transform.LightMap, (-1, 4))
+        self.assertRaises(ValueError, pygame.transform.LightMap, (4, 4), "nocolor")
+
+        lights = pygame.transform.LightMap((4, 4))
+        light = pygame.Surface((2, 2))
+        self.assertRaises(TypeError, lights.add, None, (0, 0))
+        self.assertRaises(TypeError, lights.add, light, "here")
+        self.assertRaises(ValueError, lights.add, light, (0, 0), 256)
+        self.assertRaises(
+            ValueError, lights.add, light, (0, 0), special_flags=pygame.BLEND_MULT
+        )
+        self.assertRaises(TypeError, lights.apply, None)
+
     def test_average_color(self):
         """ """
         for i in (24, 32):
@@ -1360,6 +1751,47 @@ class TransformModuleTest(unittest.TestCase):
         )
         self.assertEqual(avg_color, (10, 50, 100, 128))
 
+    def test_average_color__large_region(self):
+        """Ensure the totals of large regions don't overflow."""
+        s = pygame.Surface((512, 300), pygame.SRCALPHA, 32)
+        s.fill((200, 150, 100, 255))
+        self.assertEqual(
+            pygame.transform.average_color(s, consider_alpha=True),
+            (200, 150, 100, 255),
+        )
+        self.assertEqual(pygame.transform.average_color(s), (200, 150, 100, 255))
+
+    def test_average_color_threads(self):
+        """Threaded averages give the same result as single threaded ones."""
+        s = pygame.Surface((517, 301), pygame.SRCALPHA, 32)
+        for i in range(0, 301, 7):
+            color = ((i * 3) % 256, (i * 5) % 256, 255 - i % 256, i % 256)
+            s.fill(color, (0, i, 517, 7))
+        old_threads = pygame.transform.get_average_color_threads()
+        self.assertEqual(old_threads, 1)
+
+        cases = [(None, False), (None, True), ((13, 9, 400, 250), True)]
+        expected = [
+            pygame.transform.average_color(s, rect, alpha) for rect, alpha in cases
+        ]
+        try:
+            for threads in (2, 3, 4):
+                pygame.transform.set_average_color_threads(threads)
+                self.assertEqual(
+                    pygame.transform.get_average_color_threads(), threads
+                )
+                for (rect, alpha), color in zip(cases, expected):
+                    self.assertEqual(
+                        pygame.transform.average_color(s, rect, alpha), color
+                    )
+
+            pygame.transform.set_average_color_threads(0)
+            self.assertGreaterEqual(pygame.transform.get_average_color_threads(), 1)
+        finally:
+            pygame.transform.set_average_color_threads(old_threads)
+
+        self.assertRaises(ValueError, pygame.transform.set_average_color_threads, -1)
+
     def test_rotate(self):
         # setting colors and canvas
         blue = (0, 0, 255, 255)
@@ -1428,6 +1860,58 @@ class TransformModuleTest(unittest.TestCase):
         self.assertEqual(s1.get_rect().size, (64, 64))
         self.assertEqual(s2.get_rect().size, (64, 64))
 
+    def test_scale2x_scale3x_rules(self):
+        """scale2x() and scale3x() follow the AdvanceMAME rules for all depths"""
+        colors = [(255, 0, 0), (0, 0, 255), (0, 255, 0)]
+        for size in ((1, 1), (2, 3), (21, 7), (37, 40)):
+            for depth in (8, 16, 24, 32):
+                surf = pygame.Surface(size, 0, depth)
+                for y in range(size[1]):
+                    for x in range(size[0]):
+                        surf.set_at((x, y), colors[(x * 7 + y * y + x * y) % 3])
+
+                for factor, func in (
+                    (2, pygame.transform.scale2x),
+                    (3, pygame.transform.scale3x),
+                ):
+                    scaled = func(surf)
+                    width, height = scaled.get_size()
+                    rows = [
+                        [scaled.get_at_mapped((x, y)) for x in range(width)]
+                        for y in range(height)
+                    ]
+                    self.assertEqual(rows, scale_nx(surf, factor), (size, depth))
+
+    def test_scale4x(self):
+        """scale4x() is scale2x() twice, with and without threads"""
+        colors = [(255, 0, 0), (0, 0, 255), (0, 255, 0)]
+        for size in ((1, 1), (5, 3), (150, 90)):
+            for depth in (8, 32):
+                surf = pygame.Surface(size, 0, depth)
+                for y in range(size[1]):
+                    for x in range(size[0]):
+                        surf.set_at((x, y), colors[(x * 7 + y * y + x * y) % 3])
+
+                chained = pygame.transform.scale2x(pygame.transform.scale2x(surf))
+                scaled = pygame.transform.scale4x(surf)
+                self.assertEqual(scaled.get_size(), (size[0] * 4, size[1] * 4))
+                self.assertEqual(
+                    pygame.image.tobytes(scaled, "RGB"),
+                    pygame.image.tobytes(chained, "RGB"),
+                )
+
+                dest = pygame.Surface(scaled.get_size(), 0, depth)
+                self.assertIs(pygame.transform.scale4x(surf, dest_surface=dest), dest)
+                self.assertEqual(
+                    pygame.image.tobytes(dest, "RGB"),
+                    pygame.image.tobytes(chained, "RGB"),
+                )
+
+        surf = pygame.Surface((4, 4), 0, 32)
+        for func in (pygame.transform.scale3x, pygame.transform.scale4x):
+            self.assertRaises(ValueError, func, surf, pygame.Surface((8, 8), 0, 32))
+            self.assertRaises(ValueError, func, surf, pygame.Surface((16, 16), 0, 8))
+
     def test_scale2xraw(self):
         # Even though transform.scale no longer has a special
         # case for 2x upscaling, this test validates that the behavior
@@ -1447,9 +1931,93 @@ class TransformModuleTest(unittest.TestCase):
         for pt in test_utils.rect_area_pts(s2_2.get_rect()):
             self.assertEqual(s2_2.get_at(pt), s4.get_at(pt))
 
+    def test_build_pyramid(self):
+        """Every pyramid level is the rounded 2x2 average of the one before"""
+        for depth in (24, 32):
+            surf = pygame.Surface((23, 13), 0, depth)
+            for y in range(13):
+                for x in range(23):
+                    surf.set_at((x, y), ((x * 37) % 256, (y * 59) % 256, x * y % 256))
+
+            levels = pygame.transform.build_pyramid(surf, 5)
+            self.assertEqual(
+                [level.get_size() for level in levels], [(11, 6), (5, 3), (2, 1)]
+            )
+
+            prev = surf
+            for level in levels:
+                self.assertEqual(level.get_bitsize(), depth)
+                for y in range(level.get_height()):
+                    for x in range(level.get_width()):
+                        block = [
+                            prev.get_at((2 * x + dx, 2 * y + dy))
+                            for dx in (0, 1)
+                            for dy in (0, 1)
+                        ]
+                        expected = tuple(
+                            (sum(c[i] for c in block) + 2) // 4 for i in range(3)
+                        )
+                        self.assertEqual(tuple(level.get_at((x, y)))[:3], expected)
+                prev = level
+
+        self.assertEqual(pygame.transform.build_pyramid(surf, 0), [])
+        self.assertEqual(len(pygame.transform.build_pyramid(surf, 1)), 1)
+        self.assertRaises(ValueError, pygame.transform.build_pyramid, surf, -1)
+        self.assertRaises(
+            ValueError,
+            pygame.transform.build_pyramid,
+            pygame.Surface((8, 8), 0, 8),
+            2,
+        )
+
+    def test_smoothscale_pyramid(self):
+        """smoothscale starts from the smallest large enough pyramid level"""
+        surf = pygame.Surface((64, 48), pygame.SRCALPHA)
+        for y in range(48):
+            for x in range(64):
+                surf.set_at((x, y), ((x * 4) % 256, (y * 5) % 256, x ^ y, 128 + y))
+        pyramid = pygame.transform.build_pyramid(surf, 4)
+
+        def tobytes(s):
+            return pygame.image.tobytes(s, "RGBA")
+
+        for size, source in (
+            ((30, 20), pyramid[0]),
+            ((32, 24), pyramid[0]),
+            ((33, 10), surf),
+            ((7, 5), pyramid[2]),
+            ((1, 1), pyramid[3]),
+            ((100, 80), surf),
+        ):
+            self.assertEqual(
+                tobytes(pygame.transform.smoothscale(surf, size, pyramid=pyramid)),
+                tobytes(pygame.transform.smoothscale(source, size)),
+                size,
+            )
+
+        dest = pygame.Surface((9, 7), pygame.SRCALPHA)
+        result = pygame.transform.smoothscale(surf, (9, 7), dest, pyramid[::-1])
+        self.assertIs(result, dest)
+        self.assertEqual(
+            tobytes(dest), tobytes(pygame.transform.smoothscale(pyramid[1], (9, 7)))
+        )
+        self.assertEqual(
+            tobytes(pygame.transform.smoothscale(surf, (9, 7), pyramid=None)),
+            tobytes(pygame.transform.smoothscale(surf, (9, 7))),
+        )
+
+        self.assertRaises(
+            TypeError, pygame.transform.smoothscale, surf, (9, 7), pyramid=1
+        )
+        self.assertRaises(
+            TypeError, pygame.transform.smoothscale, surf, (9, 7), pyramid=[1]
+        )
+
     def test_get_smoothscale_backend(self):
         filter_type = pygame.transform.get_smoothscale_backend()
-        self.assertTrue(filter_type in ["GENERIC", "MMX", "SSE", "SSE2", "NEON"])
+        self.assertTrue(
+            filter_type in ["GENERIC", "MMX", "SSE", "SSE2", "NEON", "AVX2"]
+        )
         # It would be nice to test if a non-generic type corresponds to an x86
         # processor. But there is no simple test for this. platform.machine()
         # returns process version specific information, like 'i686'.
@@ -1501,6 +2069,239 @@ class TransformModuleTest(unittest.TestCase):
         except ValueError:
             pass  # Backends not supported on this CPU, also valid
 
+    def test_smoothscale_avx2_matches_sse2(self):
+        """The AVX2 smoothscale filters give the same pixels as SSE2"""
+        original_type = pygame.transform.get_smoothscale_backend()
+        surf = pygame.Surface((61, 37), pygame.SRCALPHA)
+        for y in range(37):
+            for x in range(61):
+                surf.set_at((x, y), ((x * 7) % 256, (y * 13) % 256, x ^ y, 200))
+
+        def results():
+            return [
+                pygame.image.tobytes(pygame.transform.smoothscale(surf, size), "RGBA")
+                for size in ((17, 9), (130, 75), (23, 90), (200, 11))
+            ]
+
+        try:
+            try:
+                pygame.transform.set_smoothscale_backend("SSE2")
+                expected = results()
+                pygame.transform.set_smoothscale_backend("AVX2")
+            except ValueError:
+                self.skipTest("SSE2 or AVX2 not supported on this machine")
+            self.assertEqual(results(), expected)
+        finally:
+            pygame.transform.set_smoothscale_backend(original_type)
+
+    def test_smoothscale_threads(self):
+        """Threaded smoothscales give the same result as single threaded ones"""
+        sf = pygame.image.load(example_path("data/peppers3.tif")).convert()
+        sf_24 = sf.convert(24)
+        old_threads = pygame.transform.get_smoothscale_threads()
+        self.assertEqual(old_threads, 1)
+
+        results = {}
+        try:
+            for threads in (1, 3, 4):
+                pygame.transform.set_smoothscale_threads(threads)
+                self.assertEqual(pygame.transform.get_smoothscale_threads(), threads)
+                for surf in (sf, sf_24):
+                    for size in ((100, 90), (700, 600), (1000, 200), (257, 1000)):
+                        scaled = pygame.transform.smoothscale(surf, size)
+                        key = (surf.get_bitsize(), size)
+                        data = pygame.image.tobytes(scaled, "RGB")
+                        if key in results:
+                            self.assertEqual(results[key], data)
+                        else:
+                            results[key] = data
+
+            pygame.transform.set_smoothscale_threads(0)
+            self.assertGreaterEqual(pygame.transform.get_smoothscale_threads(), 1)
+        finally:
+            pygame.transform.set_smoothscale_threads(old_threads)
+
+        self.assertRaises(ValueError, pygame.transform.set_smoothscale_threads, -1)
+        self.assertRaises(TypeError, pygame.transform.set_smoothscale_threads, "2")
+
+    def test_smoothscale_dest_pitch(self):
+        """Every backend respects the pitch of a destination subsurface"""
+        original_type = pygame.transform.get_smoothscale_backend()
+        surf = pygame.Surface((20, 10), 0, 32)
+        for y in range(10):
+            for x in range(20):
+                surf.set_at((x, y), ((x * 12) % 256, y * 25, x ^ y))
+        parent = pygame.Surface((60, 40), 0, surf)
+
+        try:
+            for backend in ("GENERIC", "SSE2", "NEON", "AVX2"):
+                try:
+                    pygame.transform.set_smoothscale_backend(backend)
+                except ValueError:
+                    continue  # not supported on this machine
+                for size in ((20, 30), (50, 10), (45, 35)):
+                    dest = parent.subsurface((5, 2, *size))
+                    pygame.transform.smoothscale(surf, size, dest)
+                    self.assertEqual(
+                        pygame.image.tobytes(dest.copy(), "RGB"),
+                        pygame.image.tobytes(
+                            pygame.transform.smoothscale(surf, size), "RGB"
+                        ),
+                        (backend, size),
+                    )
+        finally:
+            pygame.transform.set_smoothscale_backend(original_type)
+
+    def test_get_rotate_backend(self):
+        backend = pygame.transform.get_rotate_backend()
+        self.assertIn(backend, ["GENERIC", "SSE2", "NEON", "AVX2"])
+
+    def test_set_rotate_backend(self):
+        original_type = pygame.transform.get_rotate_backend()
+        pygame.transform.set_rotate_backend("GENERIC")
+        self.assertEqual(pygame.transform.get_rotate_backend(), "GENERIC")
+        pygame.transform.set_rotate_backend(backend=original_type)
+        self.assertEqual(pygame.transform.get_rotate_backend(), original_type)
+
+        self.assertRaises(ValueError, pygame.transform.set_rotate_backend, "sse2")
+        self.assertRaises(TypeError, pygame.transform.set_rotate_backend, 1)
+        self.assertRaises(
+            TypeError, pygame.transform.set_rotate_backend, t="GENERIC"
+        )
+
+    def test_rotate_backends_match(self):
+        """Every rotate backend gives exactly the same pixels"""
+        original_type = pygame.transform.get_rotate_backend()
+        surf = pygame.Surface((61, 37), pygame.SRCALPHA)
+        for y in range(37):
+            for x in range(61):
+                surf.set_at((x, y), ((x * 7) % 256, (y * 13) % 256, x ^ y, 200))
+
+        def results():
+            return [
+                (
+                    pygame.image.tobytes(pygame.transform.rotate(surf, angle), "RGBA"),
+                    pygame.image.tobytes(
+                        pygame.transform.rotozoom(surf, angle, scale), "RGBA"
+                    ),
+                )
+                for angle, scale in ((13, 1.0), (-71.5, 2.3), (200, 0.6))
+            ]
+
+        try:
+            pygame.transform.set_rotate_backend("GENERIC")
+            expected = results()
+            for backend in ("SSE2", "NEON", "AVX2"):
+                try:
+                    pygame.transform.set_rotate_backend(backend)
+                except ValueError:
+                    continue  # not supported on this machine
+                self.assertEqual(results(), expected, backend)
+        finally:
+            pygame.transform.set_rotate_backend(original_type)
+
+    def test_rotate90_flip_backends(self):
+        """Quarter turns and flips of 32 bit surfaces move the right pixels"""
+        original_type = pygame.transform.get_rotate_backend()
+        w, h = 37, 21
+        surf = pygame.Surface((w, h), pygame.SRCALPHA)
+        for y in range(h):
+            for x in range(w):
+                surf.set_at((x, y), (x, y, x ^ y, 255))
+        expected = {
+            90: lambda x, y: (w - 1 - y, x),
+            180: lambda x, y: (w - 1 - x, h - 1 - y),
+            270: lambda x, y: (y, h - 1 - x),
+        }
+
+        try:
+            for backend in ("GENERIC", "SSE2", "NEON", "AVX2"):
+                try:
+                    pygame.transform.set_rotate_backend(backend)
+                except ValueError:
+                    continue  # not supported on this machine
+                for angle, source in expected.items():
+                    rotated = pygame.transform.rotate(surf, angle)
+                    for y in range(rotated.get_height()):
+                        for x in range(rotated.get_width()):
+                            self.assertEqual(
+                                rotated.get_at((x, y)),
+                                surf.get_at(source(x, y)),
+                                (backend, angle, x, y),
+                            )
+
+                flipped = pygame.transform.flip(surf, True, True)
+                flipped_ip = surf.copy()
+                pygame.transform.flip_ip(flipped_ip, True, False)
+                for y in range(h):
+                    for x in range(w):
+                        self.assertEqual(
+                            flipped.get_at((x, y)),
+                            surf.get_at((w - 1 - x, h - 1 - y)),
+                        )
+                        self.assertEqual(
+                            flipped_ip.get_at((x, y)), surf.get_at((w - 1 - x, y))
+                        )
+        finally:
+            pygame.transform.set_rotate_backend(original_type)
+
+    def test_cache(self):
+        surf = pygame.Surface((20, 10), pygame.SRCALPHA)
+        surf.fill((10, 20, 30, 255))
+        self.assertEqual(pygame.transform.get_cache_stats()["max_bytes"], 0)
+
+        pygame.transform.enable_cache(1 << 20)
+        try:
+            first = pygame.transform.rotate(surf, 30)
+            self.assertIs(pygame.transform.rotate(surf, 30), first)
+            self.assertIsNot(pygame.transform.rotate(surf, 31), first)
+            zoomed = pygame.transform.rotozoom(surf, 30, 2)
+            self.assertIsNot(zoomed, first)
+            self.assertIs(pygame.transform.rotozoom(surf, 30, 2), zoomed)
+
+            stats = pygame.transform.get_cache_stats()
+            self.assertEqual(stats["hits"], 2)
+            self.assertEqual(stats["misses"], 3)
+            self.assertEqual(stats["entries"], 3)
+            self.assertEqual(stats["max_bytes"], 1 << 20)
+            self.assertGreater(stats["bytes"], 0)
+
+            # changing the source or the shared result invalidates the entry
+            surf.fill((200, 0, 0, 255))
+            second = pygame.transform.rotate(surf, 30)
+            self.assertIsNot(second, first)
+            center = second.get_rect().center
+            self.assertEqual(second.get_at(center)[:3], (200, 0, 0))
+            pygame.draw.line(second, (0, 0, 0), (0, 0), (5, 5))
+            self.assertIsNot(pygame.transform.rotate(surf, 30), second)
+
+            # as does a write through a PixelArray
+            third = pygame.transform.rotozoom(surf, 30, 2)
+            pixels = pygame.PixelArray(surf)
+            del pixels
+            self.assertIsNot(pygame.transform.rotozoom(surf, 30, 2), third)
+
+            # least recently used entries are dropped to make room
+            pygame.transform.clear_cache()
+            big = pygame.transform.rotate(surf, 45)
+            nbytes = pygame.transform.get_cache_stats()["bytes"]
+            pygame.transform.enable_cache(nbytes)
+            pygame.transform.rotate(surf, -45)  # same size
+            stats = pygame.transform.get_cache_stats()
+            self.assertEqual(stats["evictions"], 1)
+            self.assertEqual(stats["entries"], 1)
+            self.assertIsNot(pygame.transform.rotate(surf, 45), big)
+
+            self.assertRaises(ValueError, pygame.transform.enable_cache, 0)
+        finally:
+            pygame.transform.disable_cache()
+
+        stats = pygame.transform.get_cache_stats()
+        self.assertEqual((stats["entries"], stats["max_bytes"]), (0, 0))
+        self.assertIsNot(
+            pygame.transform.rotate(surf, 30), pygame.transform.rotate(surf, 30)
+        )
+
     def test_chop(self):
         original_surface = pygame.Surface((20, 20))
         pygame.draw.rect(original_surface, (255, 0, 0), (0, 0, 10, 10))
@@ -1596,6 +2397,34 @@ class TransformModuleTest(unittest.TestCase):
         with_rot = pygame.transform.rotozoom(image, 5, 1.1)
         self.assertEqual(image.get_colorkey(), with_rot.get_colorkey())
 
+    def test_rotozoom_threads(self):
+        """Threaded rotozooms give the same result as single threaded ones"""
+        sf = pygame.image.load(example_path("data/peppers3.tif")).convert_alpha()
+        old_threads = pygame.transform.get_rotozoom_threads()
+        self.assertEqual(old_threads, 1)
+
+        results = {}
+        try:
+            for threads in (1, 3, 4):
+                pygame.transform.set_rotozoom_threads(threads)
+                self.assertEqual(pygame.transform.get_rotozoom_threads(), threads)
+                for angle, scale in ((0, 1.7), (0, 0.3), (30, 1.2), (-75, 0.5)):
+                    result = pygame.transform.rotozoom(sf, angle, scale)
+                    data = pygame.image.tobytes(result, "RGBA")
+                    key = (angle, scale)
+                    if key in results:
+                        self.assertEqual(results[key], data)
+                    else:
+                        results[key] = data
+
+            pygame.transform.set_rotozoom_threads(0)
+            self.assertGreaterEqual(pygame.transform.get_rotozoom_threads(), 1)
+        finally:
+            pygame.transform.set_rotozoom_threads(old_threads)
+
+        self.assertRaises(ValueError, pygame.transform.set_rotozoom_threads, -1)
+        self.assertRaises(TypeError, pygame.transform.set_rotozoom_threads, "2")
+
     def test_invert(self):
         surface = pygame.Surface((10, 10), depth=32)
 
@@ -1656,6 +2485,68 @@ class TransformModuleTest(unittest.TestCase):
             pygame.Surface((10, 10), depth=8),
         )
 
+    def test_dest_surface(self):
+        surf = pygame.Surface((8, 6), pygame.SRCALPHA)
+        surf.fill((255, 0, 0, 255))
+        surf.fill((0, 0, 255, 255), (0, 0, 2, 2))
+
+        calls = [
+            (pygame.transform.flip, (surf, True, True)),
+            (pygame.transform.rotate, (surf, 90)),
+            (pygame.transform.rotate, (surf, 30)),
+            (pygame.transform.rotozoom, (surf, 30, 1.5)),
+            (pygame.transform.rotozoom, (surf, 0, 0.5)),
+            (pygame.transform.chop, (surf, (2, 2, 3, 3))),
+        ]
+        for func, args in calls:
+            expected = func(*args)
+            dest = pygame.Surface(expected.get_size(), pygame.SRCALPHA)
+            dest.fill((1, 2, 3, 4))
+            self.assertIs(func(*args, dest_surface=dest), dest)
+            for pos in [(x, y) for x in range(dest.get_width()) for y in range(2)]:
+                self.assertEqual(dest.get_at(pos), expected.get_at(pos))
+
+            wrong_size = pygame.Surface((50, 50), pygame.SRCALPHA)
+            self.assertRaises(ValueError, func, *args, dest_surface=wrong_size)
+            wrong_format = pygame.Surface(expected.get_size(), depth=24)
+            self.assertRaises(ValueError, func, *args, wrong_format)
+
+        # only flip can be done in place
+        self.assertRaises(ValueError, pygame.transform.rotate, surf, 180, surf)
+        flipped = pygame.transform.flip(surf, True, False)
+        self.assertIs(pygame.transform.flip(surf, True, False, surf), surf)
+        self.assertEqual(surf.get_at((7, 0)), (0, 0, 255, 255))
+        self.assertEqual(
+            pygame.image.tobytes(surf, "RGBA"), pygame.image.tobytes(flipped, "RGBA")
+        )
+
+    def test_ip_transforms(self):
+        for depth in (8, 16, 24, 32):
+            surf = pygame.Surface((5, 3), depth=depth)
+            surf.fill((255, 255, 255))
+            surf.set_at((0, 0), (0, 0, 0))
+            expected = pygame.transform.flip(surf, True, True)
+            self.assertIsNone(pygame.transform.flip_ip(surf, True, True))
+            self.assertEqual(
+                pygame.image.tobytes(surf, "RGB"), pygame.image.tobytes(expected, "RGB")
+            )
+
+        surf = pygame.Surface((10, 10), depth=32)
+        surf.fill((200, 0, 45))
+        expected = pygame.transform.invert(surf)
+        self.assertIsNone(pygame.transform.invert_ip(surf))
+        self.assertEqual(surf.get_at((4, 4)), expected.get_at((4, 4)))
+
+        expected = pygame.transform.grayscale(surf)
+        self.assertIsNone(pygame.transform.grayscale_ip(surf))
+        self.assertEqual(surf.get_at((4, 4)), expected.get_at((4, 4)))
+
+        surf.fill((200, 50, 45))
+        expected = pygame.transform.hsl(surf, 30, 0.2, -0.1)
+        self.assertIsNone(pygame.transform.hsl_ip(surf, 30, 0.2, -0.1))
+        self.assertEqual(surf.get_at((4, 4)), expected.get_at((4, 4)))
+        self.assertRaises(ValueError, pygame.transform.hsl_ip, surf, 0, 2)
+
     def test_smoothscale(self):
         """Tests the stated boundaries, sizing, and color blending of smoothscale function"""
         # __doc__ (as of 2008-08-02) for pygame.transform.smoothscale:
@@ -1855,10 +2746,214 @@ class TransformDisplayModuleTest(unittest.TestCase):
         for pos in data2:
             self.assertTrue(sf_b2.get_at(pos) == data2[pos])
 
+    def test_blur_threads(self):
+        """Threaded blurs give the same result as single threaded ones."""
+        sf = pygame.image.load(example_path("data/peppers3.tif")).convert()
+        old_threads = pygame.transform.get_blur_threads()
+        self.assertEqual(old_threads, 1)
+
+        results = {}
+        try:
+            for threads in (1, 3, 4):
+                pygame.transform.set_blur_threads(threads)
+                self.assertEqual(pygame.transform.get_blur_threads(), threads)
+                for blur in (
+                    pygame.transform.box_blur,
+                    pygame.transform.gaussian_blur,
+                    pygame.transform.stack_blur,
+                ):
+                    for repeat in (True, False):
+                        blurred = blur(sf, 7, repeat)
+                        key = (blur, repeat)
+                        data = pygame.image.tobytes(blurred, "RGBA")
+                        if key in results:
+                            self.assertEqual(results[key], data)
+                        else:
+                            results[key] = data
+
+            pygame.transform.set_blur_threads(0)
+            self.assertGreaterEqual(pygame.transform.get_blur_threads(), 1)
+        finally:
+            pygame.transform.set_blur_threads(old_threads)
+
+        self.assertRaises(ValueError, pygame.transform.set_blur_threads, -1)
+        self.assertRaises(TypeError, pygame.transform.set_blur_threads, "2")
+
+    def test_gaussian_blur_sigma_cache(self):
+        """Repeated and interleaved sigmas give consistent results."""
+        sf = pygame.Surface((40, 30))
+        sf.fill((255, 255, 255), (10, 10, 20, 10))
+
+        first = {}
+        for radius in (1, 2, 3, 1, 5, 2, 9, 10, 11, 12, 13, 14, 15, 16, 1, 3):
+            data = pygame.image.tobytes(
+                pygame.transform.gaussian_blur(sf, radius), "RGB"
+            )
+            self.assertEqual(first.setdefault(radius, data), data)
+
+    def test_stack_blur(self):
+        sf = pygame.Surface((9, 9), 0, 32)
+        sf.fill((0, 0, 0))
+        sf.set_at((4, 4), (255, 144, 0))
+
+        # weights fall off linearly: with radius 2 the kernel is 1 2 3 2 1
+        blurred = pygame.transform.stack_blur(sf, 2)
+        self.assertEqual(blurred.get_size(), sf.get_size())
+        self.assertEqual(blurred.get_at((4, 4)), (28, 16, 0, 255))
+        self.assertEqual(blurred.get_at((4, 4)).r, 255 * 3 // 9 * 3 // 9)
+        self.assertEqual(blurred.get_at((3, 4)).g, 144 * 3 // 9 * 2 // 9)
+        self.assertEqual(blurred.get_at((2, 2)).g, 144 * 1 // 9 * 1 // 9)
+        self.assertEqual(blurred.get_at((1, 4)), (0, 0, 0, 255))
+
+        # radius 0 is a copy
+        sf_copy = pygame.transform.stack_blur(sf, 0)
+        self.assertEqual(
+            pygame.image.tobytes(sf_copy, "RGB"), pygame.image.tobytes(sf, "RGB")
+        )
+
+        # a uniform surface stays uniform when edge pixels are repeated, and
+        # darkens towards the edges otherwise
+        sf.fill((200, 100, 50))
+        blurred = pygame.transform.stack_blur(sf, 4)
+        for pos in ((0, 0), (4, 4), (8, 3)):
+            self.assertEqual(blurred.get_at(pos), (200, 100, 50, 255))
+        blurred = pygame.transform.stack_blur(sf, 4, repeat_edge_pixels=False)
+        self.assertEqual(blurred.get_at((4, 4)), (200, 100, 50, 255))
+        self.assertLess(blurred.get_at((0, 0)).r, 200)
+
+        dest = pygame.Surface((9, 9), 0, 32)
+        self.assertIs(pygame.transform.stack_blur(sf, 2, dest_surface=dest), dest)
+        self.assertRaises(ValueError, pygame.transform.stack_blur, sf, -1)
+        self.assertRaises(
+            ValueError,
+            pygame.transform.stack_blur,
+            sf,
+            2,
+            dest_surface=pygame.Surface((8, 9), 0, 32),
+        )
+
+    def test_convolve(self):
+        """Ensure convolve() weights the pixels around each pixel."""
+        sf = pygame.Surface((9, 7), pygame.SRCALPHA, 32)
+        sf.fill((0, 0, 0, 200))
+        sf.set_at((4, 3), (100, 40, 10, 50))
+
+        # the identity kernel and a 1x1 kernel of 1 copy the surface
+        for kernel in ([[0, 0, 0], [0, 1, 0], [0, 0, 0]], [[1]]):
+            result = pygame.transform.convolve(sf, kernel)
+            self.assertEqual(result.get_size(), sf.get_size())
+            self.assertEqual(
+                pygame.image.tobytes(result, "RGBA"), pygame.image.tobytes(sf, "RGBA")
+            )
+
+        # the kernel is not flipped, and alpha is kept from the source
+        kernel = [[0, 0, 0], [0, 0, 0.5], [0, 0, 0]]
+        result = pygame.transform.convolve(sf, kernel)
+        self.assertEqual(result.get_at((3, 3)), (50, 20, 5, 200))
+        self.assertEqual(result.get_at((4, 3)), (0, 0, 0, 50))
+
+        # results are rounded and clamped
+        sharpen = [[0, -1, 0], [-1, 5, -1], [0, -1, 0]]
+        result = pygame.transform.convolve(sf, sharpen)
+        self.assertEqual(result.get_at((4, 3)), (255, 200, 50, 50))
+        self.assertEqual(result.get_at((4, 2)), (0, 0, 0, 200))
+        result = pygame.transform.convolve(sf, [[0.25, 0.5, 0]])
+        self.assertEqual(result.get_at((5, 3)), (25, 10, 3, 200))
+        self.assertEqual(result.get_at((4, 3)), (50, 20, 5, 50))
+
+        # edge pixels are repeated, so uniform surfaces stay uniform
+        sf = pygame.Surface((6, 5), 0, 24)
+        sf.fill((200, 100, 50))
+        kernel = [[1 / 49] * 7] * 7
+        result = pygame.transform.convolve(sf, kernel)
+        self.assertEqual(result.get_bitsize(), 24)
+        for pos in ((0, 0), (2, 3), (5, 4)):
+            self.assertEqual(result.get_at(pos), (200, 100, 50, 255))
+
+    def test_convolve__separable(self):
+        """Separable kernels give the same result as the two dimensional sum."""
+        sf = pygame.image.load(example_path("data/peppers3.tif")).convert()
+        sf = sf.subsurface((0, 0, 40, 30)).copy()
+        weights = [1, 4, 6, 4, 1]
+        gaussian = [[a * b / 256 for b in weights] for a in weights]
+        # not separable any more, but only by a fraction of a color value
+        nudged = [row[:] for row in gaussian]
+        nudged[0][0] += 0.0005
+
+        separable = pygame.transform.convolve(sf, gaussian)
+        full = pygame.transform.convolve(sf, nudged)
+        for x in range(sf.get_width()):
+            for y in range(sf.get_height()):
+                for a, b in zip(separable.get_at((x, y)), full.get_at((x, y))):
+                    self.assertLessEqual(abs(a - b), 1)
+
+    def test_convolve__threads(self):
+        """Threaded convolutions give the same result as single threaded ones."""
+        sf = pygame.image.load(example_path("data/peppers3.tif")).convert()
+        old_threads = pygame.transform.get_blur_threads()
+        emboss = [[-2, -1, 0], [-1, 1, 1], [0, 1, 2]]
+        box = [[1 / 25] * 5] * 5
+
+        results = {}
+        try:
+            for threads in (1, 3, 4):
+                pygame.transform.set_blur_threads(threads)
+                for kernel in (emboss, box):
+                    result = pygame.transform.convolve(sf, kernel)
+                    data = pygame.image.tobytes(result, "RGBA")
+                    self.assertEqual(results.setdefault(id(kernel), data), data)
+        finally:
+            pygame.transform.set_blur_threads(old_threads)
+
+    def test_convolve__dest_surface(self):
+        """Ensure convolve() writes into the destination surface."""
+        sf = pygame.Surface((20, 20), 0, 32)
+        sf.fill((10, 20, 30))
+        dest = pygame.Surface((20, 20), 0, 32)
+        kernel = [[0, 0, 0], [0, 2, 0], [0, 0, 0]]
+
+        result = pygame.transform.convolve(sf, kernel, dest_surface=dest)
+        self.assertIs(result, dest)
+        self.assertEqual(dest.get_at((19, 19)), (20, 40, 60, 255))
+
+        for bad_dest in (
+            pygame.Surface((20, 19), 0, 32),
+            pygame.Surface((20, 20), 0, 24),
+            sf,
+            sf.subsurface((5, 5, 10, 10)),
+        ):
+            with self.assertRaises(ValueError):
+                pygame.transform.convolve(sf, kernel, bad_dest)
+
+        result = pygame.transform.convolve(pygame.Surface((0, 5), 0, 32), kernel)
+        self.assertEqual(result.get_size(), (0, 5))
+
+    def test_convolve__invalid_kernel(self):
+        """Ensure convolve() rejects kernels and surfaces it can't handle."""
+        sf = pygame.Surface((4, 4), 0, 32)
+
+        for kernel in (
+            [],
+            [[1, 0]],
+            [[1]] * 2,
+            [[1] * 9],
+            [[1] * 3, [1] * 3, [1] * 2],
+        ):
+            with self.assertRaises(ValueError):
+                pygame.transform.convolve(sf, kernel)
+        for kernel in (None, 1, [1, 2, 3], [[1, 0, "x"]]):
+            with self.assertRaises(TypeError):
+                pygame.transform.convolve(sf, kernel)
+
+        for depth in (8, 16):
+            with self.assertRaises(ValueError):
+                pygame.transform.convolve(pygame.Surface((4, 4), 0, depth), [[1]])
+
     def test_blur_zero_size_surface(self):
         surface = pygame.Surface((0, 0))
         self.assertEqual(pygame.transform.box_blur(surface, 3).get_size(), (0, 0))
         self.assertEqual(pygame.transform.gaussian_blur(surface, 3).get_size(), (0, 0))
+        self.assertEqual(pygame.transform.stack_blur(surface, 3).get_size(), (0, 0))
 
         surface = pygame.Surface((20, 0))
         self.assertEqual(pygame.transform.box_blur(surface, 3).get_size(), (20, 0))
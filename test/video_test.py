@@ -1,5 +1,6 @@
 import platform
 import unittest
+from array import array
 import sys
 import pygame
 
@@ -37,6 +38,213 @@ class VideoModuleTest(unittest.TestCase):
         self.assertEqual(sys.getrefcount(renderer.to_surface()), 1)
         self.assertEqual(sys.getrefcount(renderer.to_surface(surface=surface)), 2)
 
+    def test_renderer_read_pixels(self):
+        """reads the same pixels as to_surface into a reused buffer."""
+        window = video.Window(title=self.default_caption, size=(40, 30))
+        renderer = video.Renderer(window=window)
+        renderer.draw_color = (10, 20, 30, 255)
+        renderer.clear()
+        renderer.draw_color = (200, 100, 50, 255)
+        renderer.fill_rect((5, 6, 10, 8))
+
+        pixels = renderer.read_pixels()
+        self.assertIsInstance(pixels, bytearray)
+        self.assertEqual(len(pixels), 4 * 40 * 30)
+        surf = pygame.image.frombuffer(pixels, (40, 30), "BGRA")
+        self.assertEqual(surf.get_at((0, 0))[:3], (10, 20, 30))
+        self.assertEqual(surf.get_at((7, 9))[:3], (200, 100, 50))
+
+        buffer = bytearray(4 * 10 * 8)
+        self.assertIs(renderer.read_pixels(buffer, (5, 6, 10, 8)), buffer)
+        self.assertEqual(bytes(buffer[:3]), bytes((50, 100, 200)))
+        self.assertRaises(ValueError, renderer.read_pixels, bytearray(4), None)
+        self.assertRaises(BufferError, renderer.read_pixels, bytes(4 * 40 * 30))
+
+    def test_texture_atlas(self):
+        """packs surfaces without overlap and copies their pixels."""
+        window = video.Window(title=self.default_caption, size=(100, 100))
+        renderer = video.Renderer(window=window)
+        atlas = video.TextureAtlas(renderer, size=(64, 64), padding=1)
+
+        surfaces = []
+        for i in range(40):
+            surf = pygame.Surface((3 + i % 7, 2 + i % 11), pygame.SRCALPHA)
+            surf.fill((i * 6, 255 - i * 6, 128, 255))
+            surfaces.append(surf)
+        images = atlas.add_all(surfaces)
+
+        self.assertEqual(len(images), len(surfaces))
+        self.assertEqual(len(atlas.textures), 1)
+        rects = [image.srcrect for image in images]
+        for surf, rect in zip(surfaces, rects):
+            self.assertEqual(rect.size, surf.get_size())
+            self.assertTrue(pygame.Rect(0, 0, 64, 64).contains(rect))
+        for i, rect in enumerate(rects):
+            self.assertEqual(rect.inflate(1, 1).collidelist(rects[i + 1 :]), -1)
+
+        image = images[5]
+        renderer.draw_color = (0, 0, 0, 255)
+        renderer.clear()
+        image.draw(dstrect=(0, 0))
+        self.assertEqual(
+            renderer.to_surface().get_at((0, 0)), surfaces[5].get_at((0, 0))
+        )
+
+        big = atlas.add(pygame.Surface((60, 60)))
+        self.assertEqual(len(atlas.textures), 2)
+        self.assertIs(big.texture, atlas.textures[1])
+        self.assertRaises(ValueError, atlas.add, pygame.Surface((64, 64)))
+        self.assertRaises(TypeError, atlas.add, "not a surface")
+
+    def test_texture_lock(self):
+        """writes pixels through the locked buffer."""
+        window = video.Window(title=self.default_caption, size=(100, 100))
+        renderer = video.Renderer(window=window)
+        texture = video.Texture(renderer, (8, 4), streaming=True)
+
+        with texture.lock() as lock:
+            self.assertTrue(lock.locked)
+            self.assertIs(lock.texture, texture)
+            view = memoryview(lock)
+            self.assertEqual(view.shape, (4, 32))
+            self.assertFalse(view.readonly)
+            self.assertRaises(BufferError, lock.unlock)
+            for y in range(4):
+                for x in range(32):
+                    view[y, x] = (0, 0, 255, 255)[x % 4]
+            view.release()
+        self.assertFalse(lock.locked)
+        self.assertRaises(BufferError, memoryview, lock)
+        lock.unlock()
+
+        renderer.draw_color = (0, 0, 0, 255)
+        renderer.clear()
+        texture.draw(dstrect=(0, 0))
+        self.assertEqual(renderer.to_surface().get_at((3, 2)), (255, 0, 0))
+
+        self.assertRaises(ValueError, texture.lock, (4, 0, 8, 4))
+        static = video.Texture(renderer, (8, 4))
+        self.assertRaises(pygame.error, static.lock)
+
+    def test_texture_update_from_buffer(self):
+        """uploads raw pixels, with and without a pitch."""
+        window = video.Window(title=self.default_caption, size=(100, 100))
+        renderer = video.Renderer(window=window)
+        texture = video.Texture(renderer, (4, 4))
+
+        texture.update_from_buffer(bytes((255, 0, 0, 255)) * 16)
+        texture.update_from_buffer(
+            (bytes((0, 255, 0, 255)) * 2 + bytes(8)) * 2, area=(1, 1, 2, 2), pitch=16
+        )
+        renderer.draw_color = (0, 0, 0, 255)
+        renderer.clear()
+        texture.draw(dstrect=(0, 0))
+        result = renderer.to_surface()
+        self.assertEqual(result.get_at((0, 0)), (0, 0, 255))
+        self.assertEqual(result.get_at((1, 1)), (0, 255, 0))
+
+        self.assertRaises(ValueError, texture.update_from_buffer, bytes(15))
+        self.assertRaises(
+            ValueError, texture.update_from_buffer, bytes(64), None, 8
+        )
+
+    def test_renderer_queue_update(self):
+        """uploads queued updates over the next presents."""
+        window = video.Window(title=self.default_caption, size=(100, 100))
+        renderer = video.Renderer(window=window)
+        texture = video.Texture(renderer, (64, 2048))
+        surf = pygame.Surface((64, 2048))
+        surf.fill((255, 0, 0))
+
+        renderer.queue_update(texture, surf)
+        surf.fill((0, 0, 255))
+        renderer.queue_update(texture, surf, (0, 2000, 64, 48))
+        self.assertEqual(renderer.pending_uploads, 2)
+
+        # one 256 KiB slice per present without budget, 1024 rows of 64 pixels
+        renderer.upload_budget = 0
+        renderer.present()
+        self.assertEqual(renderer.pending_uploads, 2)
+        renderer.upload_budget = 1000
+        renderer.present()
+        self.assertEqual(renderer.pending_uploads, 0)
+
+        renderer.draw_color = (0, 0, 0, 255)
+        renderer.clear()
+        texture.draw(dstrect=(0, 0), srcrect=(0, 1990, 64, 20))
+        result = renderer.to_surface()
+        self.assertEqual(result.get_at((5, 5)), (255, 0, 0))
+        self.assertEqual(result.get_at((5, 15)), (0, 0, 255))
+
+        renderer.queue_update(texture, surf)
+        renderer.flush_uploads()
+        self.assertEqual(renderer.pending_uploads, 0)
+
+        other = video.Renderer(video.Window(title=self.default_caption))
+        self.assertRaises(ValueError, other.queue_update, texture, surf)
+        self.assertRaises(TypeError, renderer.queue_update, texture, None)
+
+    def test_renderer_batched_primitives(self):
+        """draws every primitive of the buffers."""
+        window = video.Window(title=self.default_caption, size=(100, 100))
+        renderer = video.Renderer(window=window)
+        renderer.draw_color = (0, 0, 0, 255)
+        renderer.clear()
+
+        renderer.draw_color = (255, 0, 0, 255)
+        renderer.fill_rects(array("f", (0, 0, 10, 10, 50, 50, 10, 10)))
+        renderer.draw_color = (0, 255, 0, 255)
+        renderer.draw_rects(array("f", (20, 20, 10, 10)))
+        renderer.draw_color = (0, 0, 255, 255)
+        renderer.draw_points(array("f", (80, 80, 90, 90)))
+        renderer.draw_lines(array("f", (70, 0, 70, 10, 80, 10)))
+
+        result = renderer.to_surface()
+        self.assertEqual(result.get_at((5, 5)), (255, 0, 0))
+        self.assertEqual(result.get_at((55, 55)), (255, 0, 0))
+        self.assertEqual(result.get_at((20, 25)), (0, 255, 0))
+        self.assertEqual(result.get_at((25, 25)), (0, 0, 0))
+        self.assertEqual(result.get_at((80, 80)), (0, 0, 255))
+        self.assertEqual(result.get_at((90, 90)), (0, 0, 255))
+        self.assertEqual(result.get_at((70, 5)), (0, 0, 255))
+        self.assertEqual(result.get_at((75, 10)), (0, 0, 255))
+
+        renderer.fill_rects(array("f"))
+        self.assertRaises(ValueError, renderer.fill_rects, array("f", [1, 2]))
+        self.assertRaises(ValueError, renderer.draw_points, array("f", [1]))
+
+    @unittest.skipIf(
+        pygame.get_sdl_version() < (2, 0, 18), "requires SDL 2.0.18 or newer"
+    )
+    def test_renderer_draw_batch(self):
+        """draws every record of the buffer from the texture."""
+        window = video.Window(title=self.default_caption, size=(100, 100))
+        renderer = video.Renderer(window=window)
+        surf = pygame.Surface((20, 10))
+        surf.fill((255, 0, 0), (0, 0, 10, 10))
+        surf.fill((0, 0, 255), (10, 0, 10, 10))
+        texture = video.Texture.from_surface(renderer, surf)
+
+        records = array(
+            "f",
+            (10, 10, 10, 10, 0, 0, 10, 10, 0, 255, 255, 255, 255)
+            + (50, 50, 20, 20, 10, 0, 10, 10, 0, 255, 255, 255, 255)
+            + (70, 10, 10, 10, 10, 0, 10, 10, 90, 255, 255, 0, 255),
+        )
+        self.assertEqual(len(records), 3 * video.BATCH_RECORD_SIZE)
+
+        renderer.draw_color = (0, 0, 0, 255)
+        renderer.clear()
+        renderer.draw_batch(texture, records)
+        result = renderer.to_surface()
+        self.assertEqual(result.get_at((15, 15)), (255, 0, 0))
+        self.assertEqual(result.get_at((60, 60)), (0, 0, 255))
+        self.assertEqual(result.get_at((75, 15)), (0, 0, 0))
+        self.assertEqual(result.get_at((5, 5)), (0, 0, 0))
+
+        renderer.draw_batch(texture, array("f"))
+        self.assertRaises(ValueError, renderer.draw_batch, texture, array("f", [1]))
+
 
 if __name__ == "__main__":
     unittest.main()
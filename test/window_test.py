@@ -313,6 +313,25 @@ class WindowTypeTest(unittest.TestCase):
         pygame.display.quit()
         pygame.init()
 
+    def test_event_window_after_destroy(self):
+        pygame.event.clear()
+        win = Window("awa")
+        win.hide()
+        win.show()
+        events = [
+            e
+            for e in pygame.event.get()
+            if pygame.WINDOWSHOWN <= e.type <= pygame.WINDOWDISPLAYCHANGED
+        ]
+        win.destroy()
+        if not events:
+            self.skipTest("the video driver sent no window events")
+
+        # the window is looked up when the event is fetched, not when the
+        # attributes are first read
+        for e in events:
+            self.assertIs(e.window, win)
+
     def test_from_display_module(self):
         pygame.display.set_mode((640, 480))
 
@@ -375,6 +394,32 @@ class WindowTypeTest(unittest.TestCase):
         )
         win.destroy()
 
+    def test_window_flip_all(self):
+        win1 = Window(size=(64, 48))
+        win2 = Window(size=(32, 32))
+        win1.get_surface().fill((255, 0, 0))
+        win2.get_surface().fill((0, 255, 0))
+
+        self.assertIs(Window.flip_all([win1, win2]), None)
+        self.assertIs(Window.flip_all([]), None)
+        Window.flip_all(
+            [(win1, [pygame.Rect(0, 0, 10, 10), None, (-5, -5, 100, 100)]), win2]
+        )
+        Window.flip_all([(win2, [])])
+        self.assertEqual(win1.get_surface().get_at((0, 0)), (255, 0, 0))
+
+        self.assertRaises(TypeError, Window.flip_all, [win1, "not a window"])
+        self.assertRaises(TypeError, Window.flip_all, [(win1, ["not a rect"])])
+
+        win3 = Window(size=(16, 16))
+        self.assertRaisesRegex(
+            pygame.error, "no surface associated", Window.flip_all, [win1, win3]
+        )
+        win2.destroy()
+        self.assertRaises(pygame.error, Window.flip_all, [win2])
+        win1.destroy()
+        win3.destroy()
+
     @unittest.skipIf(
         os.environ.get("SDL_VIDEODRIVER") == pygame.NULL_VIDEODRIVER,
         "OpenGL requires a non-null SDL_VIDEODRIVER",